@@ -0,0 +1,296 @@
+// core/async_predictor.cpp
+#include "core/async_predictor.hpp"
+
+#include "core/log_names.hpp"
+#include "core/logging.hpp"
+#include "core/wait_notify.hpp"
+#include "core/log_macros.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <system_error>
+
+namespace bullseye_pred
+{
+namespace
+{
+
+std::int64_t steady_now_ns() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+} // namespace
+
+ChiefState AsyncTickPipeline::ReplayChief::get(double t0) noexcept
+{
+    const AsyncTickInput* in = p_.current_;
+    if (in == nullptr || !(in->t0 == t0))
+    {
+        ChiefState out{};
+        out.status.code = ProviderCode::kTimeMissing;
+        return out;
+    }
+    return in->chief;
+}
+
+VehicleState AsyncTickPipeline::ReplayVehicles::get(VehicleIndexMap::VehicleId id,
+                                                    double t0) noexcept
+{
+    VehicleState out{};
+    const AsyncTickInput* in = p_.current_;
+    if (in == nullptr || !(in->t0 == t0))
+    {
+        out.status.code = ProviderCode::kTimeMissing;
+        return out;
+    }
+    // Requests arrive in capture (row) order, so the hint almost always hits first.
+    for (std::size_t n = 0; n < in->count; ++n)
+    {
+        const std::size_t k = (hint_ + n) % in->count;
+        if (in->ids[k] == id)
+        {
+            hint_ = k + 1;
+            return in->states[k];
+        }
+    }
+    out.status.code = ProviderCode::kNotAvailable;
+    return out;
+}
+
+AdoptedRicFrame AsyncTickPipeline::ReplayFrame::get(double t0) noexcept
+{
+    const AsyncTickInput* in = p_.current_;
+    if (in == nullptr || !in->has_adopted || !(in->t0 == t0))
+    {
+        AdoptedRicFrame out{};
+        out.status.code = ProviderCode::kTimeMissing;
+        return out;
+    }
+    return in->adopted;
+}
+
+AsyncTickPipeline::AsyncTickPipeline(VehicleIndexMap& map,
+                                     IChiefStateProvider& chief_provider,
+                                     IVehicleStateProvider& vehicle_provider,
+                                     IBullseyeFrameProvider* adopted_provider) noexcept
+    : map_(map), chief_(chief_provider), veh_(vehicle_provider), adopted_(adopted_provider)
+{
+    ok_ = true;
+    for (auto& s : slots_)
+    {
+        s.reset(new (std::nothrow) AsyncTickInput(map.capacity()));
+        ok_ = ok_ && s && s->map.capacity() == map.capacity();
+    }
+    if (!ok_)
+    {
+        BULLSEYE_LOG_ERRORF(logname::kCoreAsyncPredictor,
+                            "init: input slot allocation failed (map capacity=%zu)",
+                            map.capacity());
+        return;
+    }
+    BULLSEYE_LOG_INFOF(logname::kCoreAsyncPredictor, "init: slots=%zu map_capacity=%zu adopted=%d",
+                       kSlots, map.capacity(), adopted_ != nullptr ? 1 : 0);
+}
+
+AsyncTickPipeline::~AsyncTickPipeline()
+{
+    stop();
+}
+
+bool AsyncTickPipeline::start(TickFn fn, void* ctx) noexcept
+{
+    if (!ok_ || running_ || fn == nullptr)
+    {
+        return false;
+    }
+    fn_ = fn;
+    ctx_ = ctx;
+    ready_.fetch_and(~kStop, std::memory_order_acq_rel);
+    try
+    {
+        thread_ = std::thread(&AsyncTickPipeline::thread_main_, this);
+    }
+    catch (const std::system_error&)
+    {
+        BULLSEYE_LOG_ERRORF(logname::kCoreAsyncPredictor,
+                            "start: predictor thread could not be started");
+        return false;
+    }
+    running_ = true;
+    return true;
+}
+
+void AsyncTickPipeline::stop() noexcept
+{
+    if (!running_)
+    {
+        return;
+    }
+    ready_.fetch_or(kStop, std::memory_order_acq_rel);
+    detail::wake_word_all(ready_);
+    thread_.join();
+    running_ = false;
+}
+
+AsyncTickInput* AsyncTickPipeline::capture_(double t0) noexcept
+{
+    if (!running_)
+    {
+        return nullptr;
+    }
+    AsyncTickInput& in = *slots_[write_];
+    in.t0 = t0;
+    in.grid = nullptr;
+    in.chief = chief_.get(t0);
+    in.has_adopted = (adopted_ != nullptr);
+    if (in.has_adopted)
+    {
+        in.adopted = adopted_->get(t0);
+    }
+
+    (void)in.map.copy_from(map_);
+    const std::size_t rows = std::min<std::size_t>(in.map.slot_count(), MAX_VEHICLES);
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        if (const auto vid = in.map.id_at(i))
+        {
+            in.ids[n++] = *vid;
+        }
+    }
+    in.count = n;
+    (void)veh_.get_many(Span<const VehicleIndexMap::VehicleId>{in.ids.data(), n}, t0,
+                        Span<VehicleState>{in.states.data(), n}, Span<Vec3>{}, Span<Vec3>{});
+    return &in;
+}
+
+void AsyncTickPipeline::publish_(AsyncTickInput& in) noexcept
+{
+    in.submit_ns = steady_now_ns();
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+
+    // Swap our slot in as the ready one (keeping a pending stop flag); take the old one back.
+    std::uint32_t prev = ready_.load(std::memory_order_relaxed);
+    while (!ready_.compare_exchange_weak(prev, write_ | kFresh | (prev & kStop),
+                                         std::memory_order_acq_rel, std::memory_order_relaxed))
+    {
+    }
+    write_ = prev & kIndexMask;
+    if ((prev & kFresh) != 0u)
+    {
+        superseded_.fetch_add(1, std::memory_order_relaxed);
+        completed_.fetch_add(1u, std::memory_order_release);
+        detail::wake_word_all(completed_);
+    }
+    detail::wake_word_all(ready_);
+}
+
+bool AsyncTickPipeline::submit(double t0, double horizon_sec, double cadence_sec) noexcept
+{
+    AsyncTickInput* in = capture_(t0);
+    if (in == nullptr)
+    {
+        return false;
+    }
+    in->horizon_sec = horizon_sec;
+    in->cadence_sec = cadence_sec;
+    publish_(*in);
+    return true;
+}
+
+bool AsyncTickPipeline::submit(double t0, const TimeGrid& grid) noexcept
+{
+    AsyncTickInput* in = capture_(t0);
+    if (in == nullptr)
+    {
+        return false;
+    }
+    in->grid = &grid;
+    publish_(*in);
+    return true;
+}
+
+void AsyncTickPipeline::thread_main_() noexcept
+{
+    for (;;)
+    {
+        // Take the ready slot once it holds a fresh input; leave our old slot in its place.
+        std::uint32_t r = ready_.load(std::memory_order_acquire);
+        for (;;)
+        {
+            if ((r & kStop) != 0u)
+            {
+                return;
+            }
+            if ((r & kFresh) == 0u)
+            {
+                detail::wait_word(ready_, r, std::numeric_limits<double>::infinity());
+                r = ready_.load(std::memory_order_acquire);
+                continue;
+            }
+            if (ready_.compare_exchange_weak(r, read_, std::memory_order_acq_rel,
+                                             std::memory_order_acquire))
+            {
+                break;
+            }
+        }
+        read_ = r & kIndexMask;
+
+        const AsyncTickInput& in = *slots_[read_];
+        current_ = &in;
+        fn_(ctx_, in);
+        current_ = nullptr;
+
+        const std::int64_t latency = steady_now_ns() - in.submit_ns;
+        last_latency_ns_.store(latency, std::memory_order_relaxed);
+        if (latency > max_latency_ns_.load(std::memory_order_relaxed))
+        {
+            max_latency_ns_.store(latency, std::memory_order_relaxed);
+        }
+        processed_.fetch_add(1, std::memory_order_relaxed);
+        completed_.fetch_add(1u, std::memory_order_release);
+        detail::wake_word_all(completed_);
+    }
+}
+
+bool AsyncTickPipeline::wait_idle(double timeout_sec) const noexcept
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (;;)
+    {
+        const std::uint32_t c = completed_.load(std::memory_order_acquire);
+        const std::uint64_t done = processed_.load(std::memory_order_relaxed) +
+                                   superseded_.load(std::memory_order_relaxed);
+        if (done >= submitted_.load(std::memory_order_relaxed))
+        {
+            return true;
+        }
+        const double elapsed =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (!running_ || (std::isfinite(timeout_sec) && elapsed >= timeout_sec))
+        {
+            return false;
+        }
+        detail::wait_word(completed_, c,
+                          std::isfinite(timeout_sec) ? timeout_sec - elapsed : timeout_sec);
+    }
+}
+
+AsyncPredictorStats AsyncTickPipeline::stats() const noexcept
+{
+    AsyncPredictorStats s{};
+    s.submitted = submitted_.load(std::memory_order_relaxed);
+    s.processed = processed_.load(std::memory_order_relaxed);
+    s.superseded = superseded_.load(std::memory_order_relaxed);
+    s.last_latency_sec = 1.0e-9 * static_cast<double>(last_latency_ns_.load());
+    s.max_latency_sec = 1.0e-9 * static_cast<double>(max_latency_ns_.load());
+    return s;
+}
+
+} // namespace bullseye_pred
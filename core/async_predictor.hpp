@@ -0,0 +1,312 @@
+// core/async_predictor.hpp
+#pragma once
+/**
+ * @file async_predictor.hpp
+ * @brief Two-stage asynchronous predictor: the sim thread captures tick inputs, a dedicated
+ *        predictor thread computes and publishes.
+ *
+ * Stage 1 (caller / sim thread): submit(t0, ...) queries the chief, the adopted frame (if
+ * any) and every registered deputy at t0, and snapshots the vehicle registration, into a
+ * preallocated input slot. It never waits for the predictor thread.
+ *
+ * Stage 2 (predictor thread): takes the newest submitted input and runs an ordinary
+ * BasicRelativePredictor over it through replay providers, then publishes as usual.
+ *
+ * Latest-wins: three input slots (one being written, one ready, one being predicted). If a
+ * new input is submitted before the previous one was taken, the older one is dropped and
+ * counted in AsyncPredictorStats::superseded; that count is the backpressure signal. The
+ * output for a given input is the same as a synchronous step() on the same provider data;
+ * which inputs are skipped depends on timing.
+ *
+ * Everything is allocated at construction; submit() and the predictor thread do no heap
+ * allocation.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "core/bullseye_frame.hpp"
+#include "core/bullseye_frame_provider.hpp"
+#include "core/chief_state_provider.hpp"
+#include "core/constants.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/time_grid.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Everything a tick needs, captured on the sim thread at t0.
+ */
+struct AsyncTickInput final
+{
+    double t0{0.0};
+
+    // Uniform grid (horizon_sec, cadence_sec), or *grid when non-null.
+    double horizon_sec{0.0};
+    double cadence_sec{0.0};
+    const TimeGrid* grid{nullptr};
+
+    ChiefState chief{};
+    bool has_adopted{false};
+    AdoptedRicFrame adopted{};
+
+    // Registration at capture time, and the deputy states of its occupied rows (row order).
+    VehicleIndexMap map;
+    std::size_t count{0};
+    std::array<VehicleIndexMap::VehicleId, MAX_VEHICLES> ids{};
+    std::array<VehicleState, MAX_VEHICLES> states{};
+
+    // Capture time (steady clock) for latency accounting.
+    std::int64_t submit_ns{0};
+
+    explicit AsyncTickInput(std::size_t map_capacity) noexcept : map(map_capacity) {}
+};
+
+/**
+ * @brief Pipeline counters (read from any thread; values are individually atomic).
+ */
+struct AsyncPredictorStats final
+{
+    /** @brief Inputs captured by submit(). */
+    std::uint64_t submitted{0};
+
+    /** @brief Inputs run by the predictor thread (published or failed fast). */
+    std::uint64_t processed{0};
+
+    /** @brief Inputs replaced by a newer one before the predictor thread took them. */
+    std::uint64_t superseded{0};
+
+    /** @brief submit() to end of the tick for the last processed input [s]. */
+    double last_latency_sec{0.0};
+
+    /** @brief Largest latency seen [s]. */
+    double max_latency_sec{0.0};
+};
+
+/**
+ * @brief Input slots, the predictor thread and the replay providers (model-independent part).
+ */
+class AsyncTickPipeline final
+{
+  public:
+    /** @brief Called on the predictor thread for every taken input. */
+    using TickFn = void (*)(void* ctx, const AsyncTickInput& in) noexcept;
+
+    /**
+     * @param map Sim-side registration (read by submit() only).
+     * @param chief_provider Sim-side chief provider (queried by submit() only).
+     * @param vehicle_provider Sim-side deputy provider (queried by submit() only).
+     * @param adopted_provider Sim-side adopted frame provider, or nullptr.
+     */
+    AsyncTickPipeline(VehicleIndexMap& map,
+                      IChiefStateProvider& chief_provider,
+                      IVehicleStateProvider& vehicle_provider,
+                      IBullseyeFrameProvider* adopted_provider) noexcept;
+    ~AsyncTickPipeline();
+
+    AsyncTickPipeline(const AsyncTickPipeline&) = delete;
+    AsyncTickPipeline& operator=(const AsyncTickPipeline&) = delete;
+
+    /** @brief Start the predictor thread; false if already running or setup failed. */
+    bool start(TickFn fn, void* ctx) noexcept;
+
+    /** @brief Stop and join the predictor thread (an input not yet taken is dropped). */
+    void stop() noexcept;
+
+    [[nodiscard]] bool running() const noexcept { return running_; }
+
+    /** @brief Capture inputs for a uniform grid; false if the pipeline is not running. */
+    bool submit(double t0, double horizon_sec, double cadence_sec) noexcept;
+
+    /** @brief Capture inputs for @p grid (must stay unchanged while the pipeline runs). */
+    bool submit(double t0, const TimeGrid& grid) noexcept;
+
+    /**
+     * @brief Wait until every submitted input was processed or superseded.
+     * @return false on timeout.
+     */
+    bool wait_idle(double timeout_sec) const noexcept;
+
+    [[nodiscard]] AsyncPredictorStats stats() const noexcept;
+
+    // Providers serving the input being predicted (predictor thread only).
+    [[nodiscard]] IChiefStateProvider& replay_chief() noexcept { return replay_chief_; }
+    [[nodiscard]] IVehicleStateProvider& replay_vehicles() noexcept { return replay_veh_; }
+    [[nodiscard]] IBullseyeFrameProvider* replay_frame() noexcept
+    {
+        return (adopted_ != nullptr) ? &replay_frame_ : nullptr;
+    }
+
+  private:
+    class ReplayChief final : public IChiefStateProvider
+    {
+      public:
+        explicit ReplayChief(const AsyncTickPipeline& p) noexcept : p_(p) {}
+        [[nodiscard]] ChiefState get(double t0) noexcept override;
+
+      private:
+        const AsyncTickPipeline& p_;
+    };
+
+    class ReplayVehicles final : public IVehicleStateProvider
+    {
+      public:
+        explicit ReplayVehicles(const AsyncTickPipeline& p) noexcept : p_(p) {}
+        [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override;
+
+      private:
+        const AsyncTickPipeline& p_;
+        std::size_t hint_{0};
+    };
+
+    class ReplayFrame final : public IBullseyeFrameProvider
+    {
+      public:
+        explicit ReplayFrame(const AsyncTickPipeline& p) noexcept : p_(p) {}
+        [[nodiscard]] AdoptedRicFrame get(double t0) noexcept override;
+
+      private:
+        const AsyncTickPipeline& p_;
+    };
+
+    // ready_ word: slot index in the low bits, plus the flags below.
+    static constexpr std::uint32_t kIndexMask = 0x3u;
+    static constexpr std::uint32_t kFresh = 0x4u;
+    static constexpr std::uint32_t kStop = 0x8u;
+    static constexpr std::size_t kSlots = 3;
+
+    AsyncTickInput* capture_(double t0) noexcept;
+    void publish_(AsyncTickInput& in) noexcept;
+    void thread_main_() noexcept;
+
+    VehicleIndexMap& map_;
+    IChiefStateProvider& chief_;
+    IVehicleStateProvider& veh_;
+    IBullseyeFrameProvider* adopted_{nullptr};
+
+    std::array<std::unique_ptr<AsyncTickInput>, kSlots> slots_{};
+    bool ok_{false};
+    std::uint32_t write_{0}; // sim thread
+    std::uint32_t read_{2};  // predictor thread
+    const AsyncTickInput* current_{nullptr};
+
+    ReplayChief replay_chief_{*this};
+    ReplayVehicles replay_veh_{*this};
+    ReplayFrame replay_frame_{*this};
+
+    TickFn fn_{nullptr};
+    void* ctx_{nullptr};
+    std::thread thread_{};
+    bool running_{false};
+
+    // Futex words: the ready slot (predictor waits), and completions (wait_idle() waits).
+    std::atomic<std::uint32_t> ready_{1};
+    std::atomic<std::uint32_t> completed_{0};
+
+    std::atomic<std::uint64_t> submitted_{0};
+    std::atomic<std::uint64_t> processed_{0};
+    std::atomic<std::uint64_t> superseded_{0};
+    std::atomic<std::int64_t> last_latency_ns_{0};
+    std::atomic<std::int64_t> max_latency_ns_{0};
+};
+
+/**
+ * @brief BasicRelativePredictor running on its own thread behind an AsyncTickPipeline.
+ *
+ * Replaces a synchronous step() call in the sim job with submit(); the snapshot appears in the
+ * publisher when the predictor thread is done, and readers use the publisher as before.
+ * Configure the wrapped predictor (predictor()) before the first submit().
+ */
+template <typename ModelPolicy>
+class BasicAsyncRelativePredictor final
+{
+  public:
+    /**
+     * @param publisher Output publisher (written by the predictor thread only).
+     * @param vehicle_map Sim-side registration; may change between submit() calls.
+     * @param chief_provider Sim-side chief provider.
+     * @param vehicle_provider Sim-side deputy provider.
+     * @param adopted_provider Sim-side adopted frame provider, or nullptr.
+     * @param mode Bullseye frame policy (as BullseyeFrame).
+     * @param policy_args Forwarded to the ModelPolicy constructor.
+     */
+    template <typename... PolicyArgs>
+    BasicAsyncRelativePredictor(Publisher& publisher,
+                                VehicleIndexMap& vehicle_map,
+                                IChiefStateProvider& chief_provider,
+                                IVehicleStateProvider& vehicle_provider,
+                                IBullseyeFrameProvider* adopted_provider,
+                                BullseyeFrameMode mode,
+                                PolicyArgs&&... policy_args) noexcept
+        : pipeline_(vehicle_map, chief_provider, vehicle_provider, adopted_provider),
+          map_(vehicle_map.capacity()),
+          bullseye_(pipeline_.replay_chief(), pipeline_.replay_frame(), mode),
+          predictor_(publisher, map_, pipeline_.replay_chief(), pipeline_.replay_vehicles(),
+                     bullseye_, std::forward<PolicyArgs>(policy_args)...)
+    {
+        (void)pipeline_.start(&BasicAsyncRelativePredictor::tick_, this);
+    }
+
+    ~BasicAsyncRelativePredictor() { pipeline_.stop(); }
+
+    BasicAsyncRelativePredictor(const BasicAsyncRelativePredictor&) = delete;
+    BasicAsyncRelativePredictor& operator=(const BasicAsyncRelativePredictor&) = delete;
+
+    /** @brief True if the predictor thread is running. */
+    [[nodiscard]] bool running() const noexcept { return pipeline_.running(); }
+
+    /** @brief Capture t0 inputs and hand them to the predictor thread (never waits). */
+    bool submit(double t0, double horizon_sec, double cadence_sec) noexcept
+    {
+        return pipeline_.submit(t0, horizon_sec, cadence_sec);
+    }
+
+    /** @brief As above on a caller-supplied grid (must stay unchanged while running). */
+    bool submit(double t0, const TimeGrid& grid) noexcept { return pipeline_.submit(t0, grid); }
+
+    /** @brief Wait until every submitted input was processed or superseded. */
+    bool wait_idle(double timeout_sec) const noexcept { return pipeline_.wait_idle(timeout_sec); }
+
+    [[nodiscard]] AsyncPredictorStats stats() const noexcept { return pipeline_.stats(); }
+
+    /** @brief Wrapped predictor; configure it before the first submit(). */
+    [[nodiscard]] BasicRelativePredictor<ModelPolicy>& predictor() noexcept { return predictor_; }
+
+  private:
+    static void tick_(void* ctx, const AsyncTickInput& in) noexcept
+    {
+        auto& self = *static_cast<BasicAsyncRelativePredictor*>(ctx);
+        (void)self.map_.copy_from(in.map);
+        if (in.grid != nullptr)
+        {
+            self.predictor_.step(in.t0, *in.grid);
+        }
+        else
+        {
+            self.predictor_.step(in.t0, in.horizon_sec, in.cadence_sec);
+        }
+    }
+
+    // Declared first: the replay providers it owns back the members below.
+    AsyncTickPipeline pipeline_;
+    VehicleIndexMap map_;
+    BullseyeFrame bullseye_;
+    BasicRelativePredictor<ModelPolicy> predictor_;
+};
+
+/** @brief Runtime-configured asynchronous predictor. */
+using AsyncRelativePredictor = BasicAsyncRelativePredictor<DynamicModelPolicy>;
+
+/** @brief Statically dispatched asynchronous HCW / YA/TH predictors. */
+using AsyncHcwRelativePredictor = BasicAsyncRelativePredictor<HcwPolicy>;
+using AsyncYaRelativePredictor = BasicAsyncRelativePredictor<YaStmPolicy>;
+
+} // namespace bullseye_pred
@@ -1,6 +1,7 @@
 // core/bullseye_frame.cpp
 
 #include "core/bullseye_frame.hpp"
+#include "core/tick_trace.hpp"
 
 namespace bullseye_pred
 {
@@ -20,6 +21,7 @@ static BullseyeFrameSnapshot from_constructed(const ChiefState& chief,
     out.frame_kind = c.frame_kind;
     out.axis_order = c.axis_order;
     out.inertial_frame_id = chief.frame_id;
+    out.inertial_frame = chief.frame;
     out.used_adopted = false;
     out.degraded = degraded;
     out.status = c.status;
@@ -38,6 +40,7 @@ static BullseyeFrameSnapshot from_adopted(const ChiefState& chief, const Adopted
     out.frame_kind = f.frame_kind;
     out.axis_order = f.axis_order;
     out.inertial_frame_id = chief.frame_id;
+    out.inertial_frame = chief.frame;
     out.adopted_frame_source_id = f.frame_source_id;
     out.used_adopted = true;
     out.degraded = contracts::Adopted::DegradeReason::kNone;
@@ -46,10 +49,14 @@ static BullseyeFrameSnapshot from_adopted(const ChiefState& chief, const Adopted
 }
 
 BullseyeFrameSnapshot BullseyeFrame::update(double t0) noexcept
+{
+    return update(t0, chief_.get(t0));
+}
+
+BullseyeFrameSnapshot BullseyeFrame::update(double t0, const ChiefState& chief) noexcept
 {
     BullseyeFrameSnapshot out;
 
-    const ChiefState chief = chief_.get(t0);
     if (!chief.status.ok() || chief.frame_id == nullptr)
     {
         out.status.code = chief.status.ok() ? ProviderCode::kInvalidInput : chief.status.code;
@@ -60,8 +67,10 @@ BullseyeFrameSnapshot BullseyeFrame::update(double t0) noexcept
     {
         const AdoptedRicFrame frame = adopted_->get(t0);
 
+        StageTrace trace(TraceStage::kValidate);
         const FrameValidationResult v =
             validate_adopted_bullseye_ric_frame(t0, chief, frame, tol_);
+        trace.end();
 
         if (v.status.ok())
         {
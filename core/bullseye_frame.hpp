@@ -44,6 +44,7 @@ struct BullseyeFrameSnapshot final
     AxisOrder axis_order{AxisOrder::kRIC};
 
     const char* inertial_frame_id{nullptr};
+    FrameHandle inertial_frame{FrameHandle::kNone}; // interned inertial_frame_id
     const char* adopted_frame_source_id{nullptr};
 
     bool used_adopted{false};
@@ -61,8 +62,25 @@ class BullseyeFrame final
     {
     }
 
+    /** @brief Fetch the chief at @p t0 and build the snapshot from it. */
     [[nodiscard]] BullseyeFrameSnapshot update(double t0) noexcept;
 
+    /**
+     * @brief Build the snapshot from a chief state already fetched for @p t0.
+     *
+     * Callers that need the chief themselves (the predictor) fetch it once per tick and pass it
+     * here, so the chief provider is not queried twice for the same t0.
+     */
+    [[nodiscard]] BullseyeFrameSnapshot update(double t0, const ChiefState& chief) noexcept;
+
+    /**
+     * @brief Switch the frame mode between updates (a source transition for the predictor,
+     *        see source_transition.hpp).
+     */
+    void set_mode(BullseyeFrameMode mode) noexcept { mode_ = mode; }
+
+    [[nodiscard]] BullseyeFrameMode mode() const noexcept { return mode_; }
+
   private:
     IChiefStateProvider& chief_;
     IBullseyeFrameProvider* adopted_{nullptr};
@@ -7,11 +7,6 @@
 namespace bullseye_pred
 {
 
-static inline bool is_finite_vec(const Vec3& v) noexcept
-{
-    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
-}
-
 static inline Vec3 unit_or_fail(const Vec3& v, double n, bool& ok) noexcept
 {
     if (!(n > 0.0) || !std::isfinite(n))
@@ -34,7 +29,7 @@ ConstructedRicFrame construct_ric_from_chief(const ChiefState& chief) noexcept
         out.status.code = ProviderCode::kNotAvailable;
         return out;
     }
-    if (!is_finite_vec(chief.r_i) || !is_finite_vec(chief.v_i))
+    if (!finite3(chief.r_i) || !finite3(chief.v_i))
     {
         out.status.code = ProviderCode::kInvalidInput;
         return out;
@@ -81,7 +76,7 @@ ConstructedRicFrame construct_ric_from_chief(const ChiefState& chief) noexcept
     const double i_norm = norm(i_i);
     eI_i = unit_or_fail(i_i, i_norm, ok);
 
-    if (!ok || !is_finite_vec(eR_i) || !is_finite_vec(eI_i) || !is_finite_vec(eC_i))
+    if (!ok || !finite3(eR_i) || !finite3(eI_i) || !finite3(eC_i))
     {
         out.status.code = ProviderCode::kInternalError;
         return out;
@@ -9,11 +9,6 @@ namespace bullseye_pred
 namespace
 {
 
-inline bool finite_vec(const Vec3& v) noexcept
-{
-    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
-}
-
 inline bool finite_mat(const Mat3& C) noexcept
 {
     for (int r = 0; r < 3; ++r)
@@ -56,6 +51,19 @@ inline double center_bound(const Vec3& chief_r_i, double abs_m, double rel) noex
 
 } // namespace
 
+AdoptedPoseMetrics compute_adopted_pose_metrics(const Mat3& C_from_ric_to_inertial) noexcept
+{
+    AdoptedPoseMetrics out{};
+    if (!finite_mat(C_from_ric_to_inertial))
+    {
+        return out;
+    }
+    out.ortho_max_abs = max_abs_CCt_minus_I(C_from_ric_to_inertial);
+    out.det = det(C_from_ric_to_inertial);
+    out.valid = true;
+    return out;
+}
+
 FrameValidationResult
 validate_adopted_bullseye_ric_frame(double t0, const ChiefState& chief,
                                     const AdoptedRicFrame& frame,
@@ -79,8 +87,8 @@ validate_adopted_bullseye_ric_frame(double t0, const ChiefState& chief,
 
     // Finite checks up front to avoid NaN comparisons producing false negatives silently.
     if (!std::isfinite(t0) || !std::isfinite(chief.time_tag) || !std::isfinite(frame.time_tag) ||
-        !finite_vec(chief.r_i) || !finite_vec(chief.v_i) || !finite_vec(frame.origin_i) ||
-        !finite_mat(frame.C_from_ric_to_inertial))
+        !finite3(chief.r_i) || !finite3(chief.v_i) || !finite3(frame.origin_i) ||
+        (!frame.pose_metrics.valid && !finite_mat(frame.C_from_ric_to_inertial)))
     {
         out.status.code = ProviderCode::kInvalidInput;
         out.reason = FrameValidationReason::kNonFinite;
@@ -88,7 +96,7 @@ validate_adopted_bullseye_ric_frame(double t0, const ChiefState& chief,
     }
     if (frame.has_omega)
     {
-        if (!finite_vec(frame.omega_ric))
+        if (!finite3(frame.omega_ric))
         {
             out.status.code = ProviderCode::kInvalidInput;
             out.reason = FrameValidationReason::kNonFinite;
@@ -132,7 +140,9 @@ validate_adopted_bullseye_ric_frame(double t0, const ChiefState& chief,
     }
 
     // Orthonormality check (FR-1b.3 + NFR-5).
-    const double ortho = max_abs_CCt_minus_I(frame.C_from_ric_to_inertial);
+    const AdoptedPoseMetrics& pm = frame.pose_metrics;
+    const double ortho =
+        pm.valid ? pm.ortho_max_abs : max_abs_CCt_minus_I(frame.C_from_ric_to_inertial);
     if (!(ortho <= tol.ortho_max_abs))
     {
         out.status.code = ProviderCode::kInvalidInput;
@@ -141,7 +151,7 @@ validate_adopted_bullseye_ric_frame(double t0, const ChiefState& chief,
     }
 
     // Right-handedness check via determinant close to +1.
-    const double dC = det(frame.C_from_ric_to_inertial);
+    const double dC = pm.valid ? pm.det : det(frame.C_from_ric_to_inertial);
     if (!std::isfinite(dC) || !(std::fabs(dC - 1.0) <= tol.det_one_abs))
     {
         out.status.code = ProviderCode::kInvalidInput;
@@ -67,10 +67,22 @@ struct FrameValidationResult final
  * - DCM orthonormality: max|C*C^T - I| <= ortho_max_abs
  * - right-handedness: |det(C) - 1| <= det_one_abs
  * - ω declaration: if has_omega, omega_coords must be kOmegaRIC and finite
+ *
+ * If frame.pose_metrics.valid, the stored orthonormality/determinant values are compared
+ * instead of being recomputed (and C is known finite); the verdict is the same.
  */
 [[nodiscard]] FrameValidationResult
 validate_adopted_bullseye_ric_frame(double t0, const ChiefState& chief,
                                     const AdoptedRicFrame& frame,
                                     const FrameValidationTolerances& tol) noexcept;
 
+/**
+ * @brief Compute the DCM-only metrics used by validate_adopted_bullseye_ric_frame().
+ *
+ * Intended for providers that validate samples once at ingest. Returns valid == false if any
+ * element of @p C_from_ric_to_inertial is not finite.
+ */
+[[nodiscard]] AdoptedPoseMetrics
+compute_adopted_pose_metrics(const Mat3& C_from_ric_to_inertial) noexcept;
+
 } // namespace bullseye_pred
@@ -0,0 +1,208 @@
+// core/chebyshev_series.cpp
+#include "core/chebyshev_series.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace bullseye_pred
+{
+
+namespace
+{
+
+// A fitted value reproduces a sample if within tolerance, or both are the same non-finite.
+bool reproduces(double fit, double sample, double tolerance) noexcept
+{
+    if (std::isnan(sample))
+    {
+        return std::isnan(fit);
+    }
+    return fit == sample || std::fabs(fit - sample) <= tolerance;
+}
+
+} // namespace
+
+std::size_t ChebyshevEncoder::encode(Span<const double> tau,
+                                     const double* const* series,
+                                     std::size_t components,
+                                     const ChebyshevFitConfig& config,
+                                     std::vector<unsigned char>& out)
+{
+    if (tau.size == 0u || series == nullptr || components == 0u ||
+        components > kChebyshevMaxComponents || !(config.tolerance >= 0.0))
+    {
+        return 0;
+    }
+    components_ = components;
+    tolerance_ = config.tolerance;
+    max_degree_ = std::min(config.max_degree, kChebyshevMaxDegree);
+    return fit_(tau, series, 0u, tau.size - 1u, out);
+}
+
+std::size_t ChebyshevEncoder::fit_(Span<const double> tau,
+                                   const double* const* series,
+                                   std::size_t first,
+                                   std::size_t last,
+                                   std::vector<unsigned char>& out)
+{
+    ChebyshevSegment seg{};
+    if (!solve_(tau, series, first, last, seg))
+    {
+        // Halves share their boundary step; a two-step range splits into single steps, which
+        // always fit (degree 0), so bisection terminates.
+        if (last - first == 1u)
+        {
+            return fit_(tau, series, first, first, out) + fit_(tau, series, last, last, out);
+        }
+        const std::size_t mid = first + (last - first) / 2u;
+        return fit_(tau, series, first, mid, out) + fit_(tau, series, mid, last, out);
+    }
+
+    const std::size_t at = out.size();
+    const std::size_t n = seg.degree + 1u;
+    out.resize(at + chebyshev_segment_bytes(seg.degree, components_));
+    std::memcpy(out.data() + at, &seg, sizeof(seg));
+    for (std::size_t c = 0; c < components_; ++c)
+    {
+        std::memcpy(out.data() + at + sizeof(seg) + c * n * sizeof(double), coef_[c],
+                    n * sizeof(double));
+    }
+    return 1;
+}
+
+bool ChebyshevEncoder::solve_(Span<const double> tau,
+                              const double* const* series,
+                              std::size_t first,
+                              std::size_t last,
+                              ChebyshevSegment& seg)
+{
+    const std::size_t m = last - first + 1u;
+    seg = ChebyshevSegment{};
+    seg.tau_begin = tau[first];
+    seg.tau_end = tau[last];
+    seg.first_step = static_cast<std::uint32_t>(first);
+    seg.last_step = static_cast<std::uint32_t>(last);
+    seg.components = static_cast<std::uint32_t>(components_);
+    if (m == 1u)
+    {
+        // Stored verbatim, so non-finite samples round-trip too.
+        for (std::size_t c = 0; c < components_; ++c)
+        {
+            coef_[c][0] = series[c][first];
+        }
+        return true;
+    }
+    // Equal end offsets collapse the segment to x = 0: only a constant is meaningful.
+    const std::size_t top =
+        (seg.tau_end > seg.tau_begin) ? std::min(max_degree_, m - 1u) : std::size_t{0};
+    const std::size_t cols = top + 1u;
+
+    x_.resize(m);
+    a_.resize(m * cols);
+    rhs_.resize(m * components_);
+    v_.resize(m);
+    for (std::size_t k = 0; k < m; ++k)
+    {
+        const double x = chebyshev_segment_x(seg, tau[first + k]);
+        x_[k] = x;
+        // T_0 = 1, T_1 = x, T_{j+1} = 2x T_j - T_{j-1}.
+        a_[k] = 1.0;
+        if (cols > 1u)
+        {
+            a_[m + k] = x;
+        }
+        for (std::size_t j = 2; j < cols; ++j)
+        {
+            a_[j * m + k] = 2.0 * x * a_[(j - 1u) * m + k] - a_[(j - 2u) * m + k];
+        }
+        for (std::size_t c = 0; c < components_; ++c)
+        {
+            rhs_[c * m + k] = series[c][first + k];
+        }
+    }
+
+    // Householder QR of A, applied to the samples as it goes. The leading (d+1) columns of R
+    // and of Q^T y are the QR solution for degree d, so one factorization serves every degree.
+    for (std::size_t j = 0; j < cols; ++j)
+    {
+        double* aj = a_.data() + j * m;
+        double norm2 = 0.0;
+        for (std::size_t i = j; i < m; ++i)
+        {
+            norm2 += aj[i] * aj[i];
+        }
+        if (norm2 == 0.0)
+        {
+            continue;
+        }
+        const double norm = std::sqrt(norm2);
+        const double alpha = (aj[j] > 0.0) ? -norm : norm;
+        for (std::size_t i = j; i < m; ++i)
+        {
+            v_[i] = aj[i];
+        }
+        v_[j] -= alpha;
+        const double vv = norm2 - aj[j] * aj[j] + v_[j] * v_[j];
+        const auto reflect = [&](double* col) noexcept
+        {
+            double s = 0.0;
+            for (std::size_t i = j; i < m; ++i)
+            {
+                s += v_[i] * col[i];
+            }
+            s = 2.0 * s / vv;
+            for (std::size_t i = j; i < m; ++i)
+            {
+                col[i] -= s * v_[i];
+            }
+        };
+        for (std::size_t jj = j + 1u; jj < cols; ++jj)
+        {
+            reflect(a_.data() + jj * m);
+        }
+        for (std::size_t c = 0; c < components_; ++c)
+        {
+            reflect(rhs_.data() + c * m);
+        }
+        aj[j] = alpha;
+    }
+
+    for (std::size_t d = 0; d <= top; ++d)
+    {
+        bool ok = true;
+        for (std::size_t c = 0; c < components_ && ok; ++c)
+        {
+            // Back substitution R[0..d][0..d] coef = (Q^T y)[0..d].
+            double* coef = coef_[c];
+            for (std::size_t r = d + 1u; r-- > 0u;)
+            {
+                double s = rhs_[c * m + r];
+                for (std::size_t jj = r + 1u; jj <= d; ++jj)
+                {
+                    s -= a_[jj * m + r] * coef[jj];
+                }
+                const double diag = a_[r * m + r];
+                if (diag == 0.0)
+                {
+                    ok = false;
+                    break;
+                }
+                coef[r] = s / diag;
+            }
+            for (std::size_t k = 0; k < m && ok; ++k)
+            {
+                ok = reproduces(chebyshev_clenshaw(coef, d, x_[k]), series[c][first + k],
+                                tolerance_);
+            }
+        }
+        if (ok)
+        {
+            seg.degree = static_cast<std::uint32_t>(d);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,279 @@
+// core/chebyshev_series.hpp
+#pragma once
+
+/**
+ * @file chebyshev_series.hpp
+ * @brief Piecewise Chebyshev compression of sampled rows under an error bound, and the
+ *        header-only evaluator.
+ *
+ * ChebyshevEncoder fits one series (e.g. a row's x/y/z over a snapshot's grid tau) with
+ * piecewise Chebyshev polynomials so that every input sample is reproduced within a declared
+ * absolute tolerance. Segments are the lowest degree (<= max_degree) that meets the bound;
+ * a segment that needs more is bisected. An encoded series is a plain byte string (native byte
+ * order, 8-byte aligned):
+ *
+ *   repeated: ChebyshevSegment, then components x (degree + 1) coefficients (double)
+ *
+ * Consecutive segments share their boundary step, so together they cover
+ * [tau[0], tau[steps - 1]] without gaps. A smooth 600-step row typically needs one or two
+ * segments of degree 10-14 at millimetre tolerance: 30-50x fewer bytes than its samples.
+ *
+ * Consumers evaluate without decoding the whole row: chebyshev_series_eval() serves any tau
+ * (a Clenshaw recurrence per component), chebyshev_series_decode() rebuilds the samples on the
+ * grid. Both read the encoding in place and never allocate.
+ *
+ * Non-finite samples are reproduced exactly (the encoder splits down to constant one-step
+ * segments around them), so an all-NaN row costs a single segment.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/// Highest polynomial degree the format allows.
+inline constexpr std::size_t kChebyshevMaxDegree = 15;
+
+/// Most components per segment (x, y, z).
+inline constexpr std::size_t kChebyshevMaxComponents = 3;
+
+/**
+ * @brief Header of one segment; its coefficients follow, component-major.
+ */
+struct ChebyshevSegment final
+{
+    /// Offsets [s] mapped to -1 and +1 (tau[first_step], tau[last_step]).
+    double tau_begin{0.0};
+    double tau_end{0.0};
+
+    /// Grid steps covered (inclusive).
+    std::uint32_t first_step{0};
+    std::uint32_t last_step{0};
+
+    std::uint32_t degree{0};
+    std::uint32_t components{0};
+};
+
+/** @brief Encoded size of one segment (header and coefficients). */
+[[nodiscard]] inline constexpr std::size_t chebyshev_segment_bytes(std::size_t degree,
+                                                                   std::size_t components) noexcept
+{
+    return sizeof(ChebyshevSegment) + components * (degree + 1u) * sizeof(double);
+}
+
+/** @brief sum_j c[j] T_j(x) for j = 0..degree (Clenshaw). */
+[[nodiscard]] inline double chebyshev_clenshaw(const double* c,
+                                               std::size_t degree,
+                                               double x) noexcept
+{
+    double b1 = 0.0;
+    double b2 = 0.0;
+    const double x2 = 2.0 * x;
+    for (std::size_t j = degree; j >= 1u; --j)
+    {
+        const double b0 = x2 * b1 - b2 + c[j];
+        b2 = b1;
+        b1 = b0;
+    }
+    return x * b1 - b2 + c[0];
+}
+
+/** @brief Segment coordinate of offset @p tau (0 for a single-step segment). */
+[[nodiscard]] inline double chebyshev_segment_x(const ChebyshevSegment& s, double tau) noexcept
+{
+    const double h = s.tau_end - s.tau_begin;
+    return (h > 0.0) ? (2.0 * tau - (s.tau_begin + s.tau_end)) / h : 0.0;
+}
+
+/**
+ * @brief Segment at byte @p offset of an encoded series.
+ *
+ * @return nullptr at the end of the series or if the segment is malformed or truncated.
+ */
+[[nodiscard]] inline const ChebyshevSegment* chebyshev_segment_at(const unsigned char* data,
+                                                                  std::size_t bytes,
+                                                                  std::size_t offset) noexcept
+{
+    if (offset > bytes || bytes - offset < sizeof(ChebyshevSegment))
+    {
+        return nullptr;
+    }
+    const auto* s = reinterpret_cast<const ChebyshevSegment*>(data + offset);
+    if (s->degree > kChebyshevMaxDegree || s->components == 0u ||
+        s->components > kChebyshevMaxComponents || s->last_step < s->first_step ||
+        chebyshev_segment_bytes(s->degree, s->components) > bytes - offset)
+    {
+        return nullptr;
+    }
+    return s;
+}
+
+/** @brief Coefficients of component @p c of segment @p s. */
+[[nodiscard]] inline const double* chebyshev_coefficients(const ChebyshevSegment& s,
+                                                          std::size_t c) noexcept
+{
+    return reinterpret_cast<const double*>(&s + 1) + c * (s.degree + 1u);
+}
+
+/**
+ * @brief Evaluate an encoded series at offset @p tau.
+ *
+ * Uses the last segment starting at or before tau (the first one before the series start), so
+ * offsets outside [tau[0], tau[steps - 1]] are extrapolated.
+ *
+ * @param data Encoded series (8-byte aligned).
+ * @param out components values.
+ * @return false (out unchanged) for an empty or malformed series or a component mismatch.
+ */
+[[nodiscard]] inline bool chebyshev_series_eval(const unsigned char* data,
+                                                std::size_t bytes,
+                                                double tau,
+                                                double* out,
+                                                std::size_t components) noexcept
+{
+    const ChebyshevSegment* pick = nullptr;
+    std::size_t off = 0;
+    while (off < bytes)
+    {
+        const ChebyshevSegment* s = chebyshev_segment_at(data, bytes, off);
+        if (s == nullptr || s->components != components)
+        {
+            return false;
+        }
+        if (pick != nullptr && s->tau_begin > tau)
+        {
+            break;
+        }
+        pick = s;
+        off += chebyshev_segment_bytes(s->degree, s->components);
+    }
+    if (pick == nullptr)
+    {
+        return false;
+    }
+    const double x = chebyshev_segment_x(*pick, tau);
+    for (std::size_t c = 0; c < components; ++c)
+    {
+        out[c] = chebyshev_clenshaw(chebyshev_coefficients(*pick, c), pick->degree, x);
+    }
+    return true;
+}
+
+/** @brief Position of a 3-component series at offset @p tau (see chebyshev_series_eval()). */
+[[nodiscard]] inline bool chebyshev_series_eval(const unsigned char* data,
+                                                std::size_t bytes,
+                                                double tau,
+                                                Vec3& out) noexcept
+{
+    double v[3];
+    if (!chebyshev_series_eval(data, bytes, tau, v, 3u))
+    {
+        return false;
+    }
+    out = Vec3{v[0], v[1], v[2]};
+    return true;
+}
+
+/**
+ * @brief Rebuild a series' samples on its grid.
+ *
+ * @param tau Grid offsets the series was encoded on (steps entries).
+ * @param out components pointers, each receiving tau.size samples.
+ * @return false if the series is malformed or does not cover exactly steps 0..tau.size - 1.
+ */
+[[nodiscard]] inline bool chebyshev_series_decode(const unsigned char* data,
+                                                  std::size_t bytes,
+                                                  Span<const double> tau,
+                                                  double* const* out,
+                                                  std::size_t components) noexcept
+{
+    std::size_t next = 0; // first step not yet written
+    std::size_t off = 0;
+    while (off < bytes)
+    {
+        const ChebyshevSegment* s = chebyshev_segment_at(data, bytes, off);
+        if (s == nullptr || s->components != components || s->last_step >= tau.size ||
+            s->first_step > next || (next > 0u && s->first_step + 1u < next))
+        {
+            return false;
+        }
+        for (std::size_t k = s->first_step; k <= s->last_step; ++k)
+        {
+            const double x = chebyshev_segment_x(*s, tau[k]);
+            for (std::size_t c = 0; c < components; ++c)
+            {
+                out[c][k] = chebyshev_clenshaw(chebyshev_coefficients(*s, c), s->degree, x);
+            }
+        }
+        next = s->last_step + 1u;
+        off += chebyshev_segment_bytes(s->degree, s->components);
+    }
+    return next == tau.size;
+}
+
+/**
+ * @brief Fit options.
+ */
+struct ChebyshevFitConfig final
+{
+    /** @brief Largest allowed |fit - sample| at every input sample (>= 0). */
+    double tolerance{1.0e-3};
+
+    /** @brief Highest degree tried before a segment is bisected (<= kChebyshevMaxDegree). */
+    std::size_t max_degree{12};
+};
+
+/**
+ * @brief Least-squares piecewise Chebyshev encoder (one instance per thread; reuses scratch).
+ */
+class ChebyshevEncoder final
+{
+  public:
+    /**
+     * @brief Append the encoding of one series to @p out.
+     *
+     * @param tau Grid offsets [s] (non-decreasing).
+     * @param series components pointers, each with tau.size samples.
+     * @param components 1..kChebyshevMaxComponents (all share one segmentation).
+     * @return Segments appended (0 for an empty grid or invalid arguments).
+     * @throws std::bad_alloc when @p out or the scratch cannot grow.
+     */
+    std::size_t encode(Span<const double> tau,
+                       const double* const* series,
+                       std::size_t components,
+                       const ChebyshevFitConfig& config,
+                       std::vector<unsigned char>& out);
+
+  private:
+    std::size_t fit_(Span<const double> tau,
+                     const double* const* series,
+                     std::size_t first,
+                     std::size_t last,
+                     std::vector<unsigned char>& out);
+
+    // Lowest degree <= max_degree_ reproducing [first, last] within tolerance_; false if none.
+    bool solve_(Span<const double> tau,
+                const double* const* series,
+                std::size_t first,
+                std::size_t last,
+                ChebyshevSegment& seg);
+
+    std::size_t components_{0};
+    double tolerance_{0.0};
+    std::size_t max_degree_{0};
+
+    // Householder QR scratch: A is m x (degree + 1) column-major, rhs is m x components.
+    std::vector<double> x_{};
+    std::vector<double> a_{};
+    std::vector<double> rhs_{};
+    std::vector<double> v_{};
+    double coef_[kChebyshevMaxComponents][kChebyshevMaxDegree + 1u]{};
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,259 @@
+#include "core/checkpoint.hpp"
+
+#include "core/constants.hpp"
+#include "core/prediction_buffer.hpp"
+
+#include <cstdio>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BULLSEYE_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bullseye_pred
+{
+
+namespace
+{
+
+constexpr std::uint64_t align64(std::uint64_t bytes) noexcept
+{
+    return (bytes + 63u) / 64u * 64u;
+}
+
+bool write_zeros(std::FILE* f, std::uint64_t n) noexcept
+{
+    static const unsigned char zeros[64] = {};
+    while (n > 0u)
+    {
+        const std::size_t chunk = (n < sizeof(zeros)) ? static_cast<std::size_t>(n) : sizeof(zeros);
+        if (std::fwrite(zeros, 1, chunk, f) != chunk)
+        {
+            return false;
+        }
+        n -= chunk;
+    }
+    return true;
+}
+
+} // namespace
+
+void CheckpointWriter::begin_section(CheckpointSection tag, std::uint32_t instance)
+{
+    sections_.push_back(Pending{tag, instance, {}});
+}
+
+void CheckpointWriter::append(const void* data, std::size_t bytes)
+{
+    if (sections_.empty() || bytes == 0u)
+    {
+        return;
+    }
+    const auto* p = static_cast<const unsigned char*>(data);
+    std::vector<unsigned char>& out = sections_.back().bytes;
+    out.insert(out.end(), p, p + bytes);
+}
+
+CheckpointCode CheckpointWriter::write(const char* path) const
+{
+    if (path == nullptr)
+    {
+        return CheckpointCode::kInvalidInput;
+    }
+
+    CheckpointFileHeader hdr{};
+    hdr.magic = kCheckpointMagic;
+    hdr.format_version = kCheckpointFormatVersion;
+    hdr.header_bytes = sizeof(CheckpointFileHeader);
+    hdr.max_vehicles = static_cast<std::uint32_t>(MAX_VEHICLES);
+    hdr.max_steps = static_cast<std::uint32_t>(MAX_STEPS);
+    hdr.prediction_buffer_bytes = sizeof(PredictionBuffer);
+    hdr.section_count = sections_.size();
+    hdr.directory_offset = align64(sizeof(CheckpointFileHeader));
+
+    std::vector<CheckpointSectionEntry> dir(sections_.size());
+    std::uint64_t offset =
+        align64(hdr.directory_offset + dir.size() * sizeof(CheckpointSectionEntry));
+    for (std::size_t i = 0; i < sections_.size(); ++i)
+    {
+        dir[i].tag = static_cast<std::uint32_t>(sections_[i].tag);
+        dir[i].instance = sections_[i].instance;
+        dir[i].offset = offset;
+        dir[i].bytes = sections_[i].bytes.size();
+        offset = align64(offset + dir[i].bytes);
+    }
+    hdr.file_bytes = offset;
+
+    const std::string tmp = std::string(path) + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (f == nullptr)
+    {
+        return CheckpointCode::kOpenFailed;
+    }
+    std::uint64_t pos = sizeof(hdr);
+    bool ok = std::fwrite(&hdr, sizeof(hdr), 1, f) == 1u &&
+              write_zeros(f, hdr.directory_offset - pos);
+    pos = hdr.directory_offset;
+    if (ok && !dir.empty())
+    {
+        ok = std::fwrite(dir.data(), sizeof(CheckpointSectionEntry), dir.size(), f) == dir.size();
+        pos += dir.size() * sizeof(CheckpointSectionEntry);
+    }
+    for (std::size_t i = 0; ok && i < sections_.size(); ++i)
+    {
+        const std::vector<unsigned char>& bytes = sections_[i].bytes;
+        ok = write_zeros(f, dir[i].offset - pos) &&
+             (bytes.empty() || std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size());
+        pos = dir[i].offset + bytes.size();
+    }
+    ok = ok && write_zeros(f, hdr.file_bytes - pos);
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok || std::rename(tmp.c_str(), path) != 0)
+    {
+        (void)std::remove(tmp.c_str());
+        return CheckpointCode::kWriteFailed;
+    }
+    return CheckpointCode::kOk;
+}
+
+CheckpointFile::~CheckpointFile()
+{
+    close();
+}
+
+#if defined(BULLSEYE_HAVE_MMAP)
+
+CheckpointCode CheckpointFile::open(const char* path) noexcept
+{
+    close();
+    if (path == nullptr)
+    {
+        return CheckpointCode::kInvalidInput;
+    }
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return CheckpointCode::kOpenFailed;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(CheckpointFileHeader)))
+    {
+        ::close(fd);
+        return CheckpointCode::kLayoutMismatch;
+    }
+    const auto bytes = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+    {
+        return CheckpointCode::kMapFailed;
+    }
+    base_ = p;
+    bytes_ = bytes;
+
+    const auto* hdr = static_cast<const CheckpointFileHeader*>(p);
+    CheckpointCode code = CheckpointCode::kOk;
+    if (hdr->magic != kCheckpointMagic)
+    {
+        code = CheckpointCode::kBadMagic;
+    }
+    else if (hdr->format_version != kCheckpointFormatVersion)
+    {
+        code = CheckpointCode::kVersionMismatch;
+    }
+    else if (hdr->header_bytes != sizeof(CheckpointFileHeader) ||
+             hdr->max_vehicles != MAX_VEHICLES || hdr->max_steps != MAX_STEPS ||
+             hdr->prediction_buffer_bytes != sizeof(PredictionBuffer) ||
+             hdr->directory_offset != align64(sizeof(CheckpointFileHeader)) ||
+             hdr->section_count > bytes / sizeof(CheckpointSectionEntry) ||
+             hdr->file_bytes != bytes)
+    {
+        code = CheckpointCode::kLayoutMismatch;
+    }
+    else
+    {
+        // Directory: every block inside the file, after the directory, 64-byte aligned.
+        const auto* dir = reinterpret_cast<const CheckpointSectionEntry*>(
+            static_cast<const unsigned char*>(p) + hdr->directory_offset);
+        const std::uint64_t first =
+            align64(hdr->directory_offset + hdr->section_count * sizeof(CheckpointSectionEntry));
+        for (std::uint64_t i = 0; i < hdr->section_count && code == CheckpointCode::kOk; ++i)
+        {
+            if (dir[i].offset < first || dir[i].offset % 64u != 0u ||
+                dir[i].offset > hdr->file_bytes || dir[i].bytes > hdr->file_bytes - dir[i].offset)
+            {
+                code = CheckpointCode::kLayoutMismatch;
+            }
+        }
+        hdr_ = hdr;
+        dir_ = dir;
+    }
+
+    if (code != CheckpointCode::kOk)
+    {
+        close();
+    }
+    return code;
+}
+
+void CheckpointFile::close() noexcept
+{
+    if (base_ != nullptr)
+    {
+        (void)::munmap(base_, bytes_);
+    }
+    base_ = nullptr;
+    bytes_ = 0;
+    hdr_ = nullptr;
+    dir_ = nullptr;
+}
+
+#else
+
+CheckpointCode CheckpointFile::open(const char*) noexcept
+{
+    close();
+    return CheckpointCode::kUnsupported;
+}
+
+void CheckpointFile::close() noexcept
+{
+    base_ = nullptr;
+    bytes_ = 0;
+    hdr_ = nullptr;
+    dir_ = nullptr;
+}
+
+#endif
+
+Span<const unsigned char> CheckpointFile::section(CheckpointSection tag,
+                                                  std::uint32_t instance) const noexcept
+{
+    for (std::size_t i = 0; i < section_count(); ++i)
+    {
+        if (dir_[i].tag == static_cast<std::uint32_t>(tag) && dir_[i].instance == instance)
+        {
+            return {static_cast<const unsigned char*>(base_) + dir_[i].offset,
+                    static_cast<std::size_t>(dir_[i].bytes)};
+        }
+    }
+    return {};
+}
+
+bool CheckpointFile::has_section(CheckpointSection tag, std::uint32_t instance) const noexcept
+{
+    for (std::size_t i = 0; i < section_count(); ++i)
+    {
+        if (dir_[i].tag == static_cast<std::uint32_t>(tag) && dir_[i].instance == instance)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace bullseye_pred
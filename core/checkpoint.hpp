@@ -0,0 +1,290 @@
+#pragma once
+/**
+ * @file checkpoint.hpp
+ * @brief Versioned binary checkpoint of predictor run state, restored by bulk copy.
+ *
+ * @details
+ * File layout (native byte order; offsets from the file start, blocks 64-byte aligned):
+ *
+ *   [0]                  CheckpointFileHeader: magic, format version, build capacities
+ *   [directory_offset]   section_count x CheckpointSectionEntry
+ *   [entry.offset]       one raw block per section
+ *
+ * Each component writes its state as one section (tag + instance, so several chiefs or
+ * publishers share a file) of fixed-size prefix structs followed by its arrays verbatim:
+ * VehicleIndexMap, Publisher (every slot and plane, seqno, front), BasicRelativePredictor
+ * (reuse history, budget state, model cache), CartesianChiefProvider (samples, cursor).
+ * Restore maps the file and copies each block back, so restart cost is a memcpy of the
+ * state and the next tick is bitwise identical to an uninterrupted run.
+ *
+ * A checkpoint carries run state, not configuration: rebuild the same objects with the same
+ * configuration (capacities, publisher planes, grid profiles, model config), then restore.
+ * A component whose configuration differs from the saved one rejects its section with
+ * kLayoutMismatch and is left unchanged. Per-tick caches (tick context, chief ephemeris over
+ * the grid) are recomputed by every step() and are not stored.
+ *
+ * Save and restore are configuration-time calls: not on the tick path, and not concurrent
+ * with step() or begin_write()/publish().
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/// "BEYECKP1" as a little-endian integer.
+inline constexpr std::uint64_t kCheckpointMagic = 0x31504B4345594542ull;
+
+/// Bumped whenever the header, directory, or any section layout changes shape.
+inline constexpr std::uint32_t kCheckpointFormatVersion = 7;
+
+enum class CheckpointSection : std::uint32_t
+{
+    kVehicleMap = 1,
+    kPublisher,
+    kPredictor,
+    kModelCache,
+    kChiefSamples,
+};
+
+enum class CheckpointCode : std::uint8_t
+{
+    kOk = 0,
+
+    /** @brief Null path, or the component cannot be checkpointed in its current state. */
+    kInvalidInput,
+
+    /** @brief No mmap() on this platform. */
+    kUnsupported,
+
+    /** @brief The file could not be opened (reader) or created (writer). */
+    kOpenFailed,
+
+    /** @brief mmap() failed. */
+    kMapFailed,
+
+    /** @brief Not a checkpoint file. */
+    kBadMagic,
+
+    /** @brief Format version differs from this build. */
+    kVersionMismatch,
+
+    /** @brief Build capacities, directory, or a section's configuration differ from this one. */
+    kLayoutMismatch,
+
+    /** @brief The file has no section with the requested tag and instance. */
+    kMissingSection,
+
+    /** @brief Short write. */
+    kWriteFailed,
+};
+
+struct CheckpointFileHeader final
+{
+    std::uint64_t magic{0};
+    std::uint32_t format_version{0};
+    std::uint32_t header_bytes{0};
+
+    // Build capacities; a checkpoint only restores into the same build shape.
+    std::uint32_t max_vehicles{0};
+    std::uint32_t max_steps{0};
+    std::uint64_t prediction_buffer_bytes{0};
+
+    std::uint64_t section_count{0};
+    std::uint64_t directory_offset{0};
+    std::uint64_t file_bytes{0};
+};
+
+struct CheckpointSectionEntry final
+{
+    /// CheckpointSection of the block.
+    std::uint32_t tag{0};
+
+    /// Caller-chosen instance (e.g. chief index); 0 for a single instance.
+    std::uint32_t instance{0};
+    std::uint64_t offset{0};
+    std::uint64_t bytes{0};
+};
+
+/**
+ * @brief Collects sections in memory, then writes them as one checkpoint file.
+ */
+class CheckpointWriter final
+{
+  public:
+    /**
+     * @brief Start a new section; later append() calls add to it.
+     *
+     * A second section with the same tag and instance replaces nothing: the reader returns
+     * the first one.
+     */
+    void begin_section(CheckpointSection tag, std::uint32_t instance = 0);
+
+    /// @brief Append @p bytes raw bytes to the current section (requires begin_section()).
+    void append(const void* data, std::size_t bytes);
+
+    /// @brief Append a trivially copyable value verbatim.
+    template <class T>
+    void append_value(const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint blocks are raw copies");
+        append(&value, sizeof(T));
+    }
+
+    /// @brief Append @p count trivially copyable elements verbatim.
+    template <class T>
+    void append_array(const T* data, std::size_t count)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint blocks are raw copies");
+        append(data, count * sizeof(T));
+    }
+
+    [[nodiscard]] std::size_t section_count() const noexcept { return sections_.size(); }
+
+    /**
+     * @brief Write every section to @p path.
+     *
+     * Writes "<path>.tmp" and renames it over @p path, so a crash mid-write keeps the previous
+     * checkpoint.
+     */
+    [[nodiscard]] CheckpointCode write(const char* path) const;
+
+  private:
+    struct Pending final
+    {
+        CheckpointSection tag{CheckpointSection::kVehicleMap};
+        std::uint32_t instance{0};
+        std::vector<unsigned char> bytes{};
+    };
+
+    std::vector<Pending> sections_{};
+};
+
+/**
+ * @brief Sequential reader over one section's block.
+ */
+class CheckpointCursor final
+{
+  public:
+    CheckpointCursor() = default;
+    explicit CheckpointCursor(Span<const unsigned char> block) noexcept : block_(block) {}
+
+    /// @return pointer to the next @p bytes bytes and advance, or nullptr if the block is short.
+    [[nodiscard]] const unsigned char* take(std::size_t bytes) noexcept
+    {
+        if (bytes > block_.size - pos_)
+        {
+            pos_ = block_.size;
+            ok_ = false;
+            return nullptr;
+        }
+        const unsigned char* p = block_.data + pos_;
+        pos_ += bytes;
+        return p;
+    }
+
+    /// @brief Copy the next value out; false (value unchanged) if the block is short.
+    template <class T>
+    bool read_value(T& out) noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint blocks are raw copies");
+        const unsigned char* p = take(sizeof(T));
+        if (p != nullptr)
+        {
+            std::memcpy(&out, p, sizeof(T));
+        }
+        return p != nullptr;
+    }
+
+    /// @brief Copy the next @p count elements out; false (out unchanged) if the block is short.
+    template <class T>
+    bool read_array(T* out, std::size_t count) noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "checkpoint blocks are raw copies");
+        if (count > static_cast<std::size_t>(-1) / sizeof(T))
+        {
+            ok_ = false;
+            return false;
+        }
+        const unsigned char* p = take(count * sizeof(T));
+        if (p != nullptr && count > 0u)
+        {
+            std::memcpy(out, p, count * sizeof(T));
+        }
+        return p != nullptr;
+    }
+
+    /// @return true if every read so far succeeded.
+    [[nodiscard]] bool ok() const noexcept { return ok_; }
+
+    /// @return true if the whole block has been consumed.
+    [[nodiscard]] bool at_end() const noexcept { return pos_ == block_.size; }
+
+    /// @return bytes left in the block (check before copying into live state).
+    [[nodiscard]] std::size_t remaining() const noexcept { return block_.size - pos_; }
+
+  private:
+    Span<const unsigned char> block_{};
+    std::size_t pos_{0};
+    bool ok_{true};
+};
+
+/**
+ * @brief Read-only mapping of one checkpoint file.
+ *
+ * open() checks the header and directory only; section blocks fault in when restored.
+ */
+class CheckpointFile final
+{
+  public:
+    CheckpointFile() = default;
+    ~CheckpointFile();
+
+    CheckpointFile(const CheckpointFile&) = delete;
+    CheckpointFile& operator=(const CheckpointFile&) = delete;
+
+    /**
+     * @brief Map @p path and check its header, build capacities and directory.
+     *
+     * @return kOk or the first failed check; on failure the file is closed.
+     */
+    [[nodiscard]] CheckpointCode open(const char* path) noexcept;
+
+    /// @brief Unmap (idempotent).
+    void close() noexcept;
+
+    [[nodiscard]] bool is_open() const noexcept { return hdr_ != nullptr; }
+
+    [[nodiscard]] std::size_t section_count() const noexcept
+    {
+        return hdr_ ? static_cast<std::size_t>(hdr_->section_count) : 0u;
+    }
+
+    /// @return the block of section (@p tag, @p instance), or an empty span if absent.
+    [[nodiscard]] Span<const unsigned char> section(CheckpointSection tag,
+                                                    std::uint32_t instance = 0) const noexcept;
+
+    /// @return a cursor over section (@p tag, @p instance) (empty if absent).
+    [[nodiscard]] CheckpointCursor cursor(CheckpointSection tag,
+                                          std::uint32_t instance = 0) const noexcept
+    {
+        return CheckpointCursor{section(tag, instance)};
+    }
+
+    /// @return true if the file holds section (@p tag, @p instance).
+    [[nodiscard]] bool has_section(CheckpointSection tag, std::uint32_t instance = 0) const noexcept;
+
+  private:
+    void* base_{nullptr};
+    std::size_t bytes_{0};
+    const CheckpointFileHeader* hdr_{nullptr};
+    const CheckpointSectionEntry* dir_{nullptr};
+};
+
+} // namespace bullseye_pred
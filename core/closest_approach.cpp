@@ -0,0 +1,216 @@
+// core/closest_approach.cpp
+#include "core/closest_approach.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bullseye_pred
+{
+namespace
+{
+
+// Bisection steps per root; halves the bracket to ~1e-15 of a sample interval.
+constexpr int kBisectIters = 50;
+
+// Position and velocity on one sample interval: cubic Hermite (velocities), else linear.
+struct Segment final
+{
+    double t0{0.0};
+    double h{0.0};
+    Vec3 p0{};
+    Vec3 p1{};
+    Vec3 v0{};
+    Vec3 v1{};
+    bool hermite{false};
+
+    [[nodiscard]] Vec3 pos(double s) const noexcept
+    {
+        if (!hermite)
+        {
+            return p0 + (p1 - p0) * s;
+        }
+        const double s2 = s * s;
+        const double s3 = s2 * s;
+        return p0 * (2.0 * s3 - 3.0 * s2 + 1.0) + v0 * (h * (s3 - 2.0 * s2 + s)) +
+               p1 * (3.0 * s2 - 2.0 * s3) + v1 * (h * (s3 - s2));
+    }
+
+    [[nodiscard]] Vec3 vel(double s) const noexcept
+    {
+        if (!hermite)
+        {
+            return (p1 - p0) * (1.0 / h);
+        }
+        const double s2 = s * s;
+        return p0 * ((6.0 * s2 - 6.0 * s) / h) + v0 * (3.0 * s2 - 4.0 * s + 1.0) +
+               p1 * ((6.0 * s - 6.0 * s2) / h) + v1 * (3.0 * s2 - 2.0 * s);
+    }
+};
+
+Segment segment(Span<const double> tau,
+                Span<const Vec3> r,
+                Span<const Vec3> v,
+                std::size_t k) noexcept
+{
+    Segment g{};
+    g.t0 = tau[k];
+    g.h = tau[k + 1] - tau[k];
+    g.p0 = r[k];
+    g.p1 = r[k + 1];
+    g.hermite = (v.size != 0);
+    if (g.hermite)
+    {
+        g.v0 = v[k];
+        g.v1 = v[k + 1];
+    }
+    return g;
+}
+
+// Root of f on [lo, hi] given f(lo) and f(hi) of opposite sign (or f(hi) == 0).
+template <typename F>
+double bisect(F&& f, double lo, double hi, bool lo_negative) noexcept
+{
+    for (int it = 0; it < kBisectIters; ++it)
+    {
+        const double mid = 0.5 * (lo + hi);
+        if ((f(mid) < 0.0) == lo_negative)
+        {
+            lo = mid;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
+} // namespace
+
+ClosestApproach summarize_closest_approach(Span<const double> tau,
+                                           Span<const Vec3> r,
+                                           Span<const Vec3> v,
+                                           Span<const double> keep_out_radius_m) noexcept
+{
+    constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+    ClosestApproach out{};
+    out.keep_out_entry_tau.fill(kNaN);
+    const std::size_t n = std::min(tau.size, r.size);
+    if (n == 0 || (v.size != 0 && v.size < n))
+    {
+        return out;
+    }
+    out.valid = true;
+    out.hermite = (v.size != 0);
+
+    // Sampled minimum (first one on ties).
+    std::size_t kmin = 0;
+    double d2min = dot(r[0], r[0]);
+    for (std::size_t k = 1; k < n; ++k)
+    {
+        const double d2 = dot(r[k], r[k]);
+        if (d2 < d2min)
+        {
+            d2min = d2;
+            kmin = k;
+        }
+    }
+    out.min_range_m = std::sqrt(d2min);
+    out.tca_tau = tau[kmin];
+    out.r_tca = r[kmin];
+
+    // Refine on the interval where the range rate turns from negative to positive.
+    std::size_t seg_tca = n; // interval holding the refined TCA (n: at a sample)
+    double s_tca = 0.0;
+    if (out.hermite)
+    {
+        const double g = dot(r[kmin], v[kmin]);
+        std::size_t k = n;
+        if (g > 0.0 && kmin > 0 && dot(r[kmin - 1], v[kmin - 1]) < 0.0)
+        {
+            k = kmin - 1;
+        }
+        else if (g < 0.0 && kmin + 1 < n && dot(r[kmin + 1], v[kmin + 1]) > 0.0)
+        {
+            k = kmin;
+        }
+        if (k < n)
+        {
+            const Segment seg = segment(tau, r, v, k);
+            const double s = bisect(
+                [&seg](double x) noexcept { return dot(seg.pos(x), seg.vel(x)); }, 0.0, 1.0,
+                true);
+            const Vec3 p = seg.pos(s);
+            const double d = norm(p);
+            if (d < out.min_range_m)
+            {
+                out.min_range_m = d;
+                out.tca_tau = seg.t0 + s * seg.h;
+                out.r_tca = p;
+                seg_tca = k;
+                s_tca = s;
+            }
+        }
+    }
+    else if (kmin > 0 && kmin + 1 < n)
+    {
+        // Parabola through (tau, |r|^2) at kmin - 1, kmin, kmin + 1 (non-uniform spacing).
+        const double t0 = tau[kmin - 1];
+        const double t1 = tau[kmin];
+        const double t2 = tau[kmin + 1];
+        const double y0 = dot(r[kmin - 1], r[kmin - 1]);
+        const double y2 = dot(r[kmin + 1], r[kmin + 1]);
+        const double d01 = (d2min - y0) / (t1 - t0);
+        const double d12 = (y2 - d2min) / (t2 - t1);
+        const double a = (d12 - d01) / (t2 - t0);
+        if (a > 0.0)
+        {
+            const double tv = 0.5 * (t0 + t1) - d01 / (2.0 * a);
+            const double tc = std::min(std::max(tv, t0), t2);
+            const double yv = d2min + (tc - t1) * (d01 + a * (tc - t0));
+            if (yv < d2min)
+            {
+                const std::size_t k = (tc < t1) ? kmin - 1 : kmin;
+                const Segment seg = segment(tau, r, v, k);
+                out.min_range_m = std::sqrt(std::max(yv, 0.0));
+                out.tca_tau = tc;
+                out.r_tca = seg.pos((tc - seg.t0) / seg.h);
+                seg_tca = k;
+                s_tca = (tc - seg.t0) / seg.h;
+            }
+        }
+    }
+
+    // Keep-out spheres: first interval whose end is inside, or that holds a refined dip inside.
+    const std::size_t spheres = std::min(keep_out_radius_m.size, MAX_KEEP_OUT_SPHERES);
+    for (std::size_t j = 0; j < spheres; ++j)
+    {
+        const double R = keep_out_radius_m[j];
+        const double R2 = R * R;
+        if (dot(r[0], r[0]) <= R2)
+        {
+            out.keep_out_entry_tau[j] = tau[0];
+            continue;
+        }
+        for (std::size_t k = 0; k + 1 < n; ++k)
+        {
+            const bool end_inside = dot(r[k + 1], r[k + 1]) <= R2;
+            const bool dip_inside = (k == seg_tca) && out.min_range_m <= R;
+            if (!end_inside && !dip_inside)
+            {
+                continue;
+            }
+            // A dip inside comes first within its interval (the range is below R at s_tca).
+            const Segment seg = segment(tau, r, v, k);
+            const double hi = dip_inside ? s_tca : 1.0;
+            const double s = bisect(
+                [&seg, R2](double x) noexcept { return R2 - dot(seg.pos(x), seg.pos(x)); }, 0.0,
+                hi, true);
+            out.keep_out_entry_tau[j] = seg.t0 + s * seg.h;
+            break;
+        }
+    }
+    return out;
+}
+
+} // namespace bullseye_pred
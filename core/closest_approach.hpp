@@ -0,0 +1,90 @@
+// core/closest_approach.hpp
+#pragma once
+/**
+ * @file closest_approach.hpp
+ * @brief Per-row closest-approach summary (minimum range, TCA, keep-out sphere entries).
+ *
+ * @details
+ * Range is measured from the RIC origin (the chief). The sampled minimum is refined between
+ * samples:
+ * - with velocities, on the cubic Hermite interpolant of the positions (exact endpoint
+ *   positions and velocities), by bisection on the range rate r . dr/dt;
+ * - without, on the parabola through |r|^2 at the minimum sample and its neighbours.
+ *
+ * Keep-out entry times are the first crossing of |r| = R on the same interpolant, including
+ * a dip below R that only the refined minimum shows. Everything is a fixed number of
+ * iterations per row: no allocation, deterministic.
+ */
+
+#include <array>
+#include <cstddef>
+#include <limits>
+
+#include "core/constants.hpp"
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Closest-approach summary of one trajectory row (offsets relative to its t0).
+ */
+struct ClosestApproach final
+{
+    /** @brief True if the row had a trajectory to summarize. */
+    bool valid{false};
+
+    /** @brief True if refined on the Hermite interpolant (velocities available). */
+    bool hermite{false};
+
+    /** @brief Minimum range [m]. */
+    double min_range_m{std::numeric_limits<double>::quiet_NaN()};
+
+    /** @brief Time of closest approach, offset from t0 [s]. */
+    double tca_tau{std::numeric_limits<double>::quiet_NaN()};
+
+    /** @brief RIC position at TCA [m]. */
+    Vec3 r_tca{};
+
+    /**
+     * @brief First entry into keep-out sphere j, offset from t0 [s]; tau[0] if inside at the
+     *        first sample, NaN if never inside over the grid (or no such sphere).
+     */
+    std::array<double, MAX_KEEP_OUT_SPHERES> keep_out_entry_tau{};
+};
+
+/**
+ * @brief Bound on how far the cubic Hermite interpolant of one sample interval strays from
+ *        its chord [m].
+ *
+ * With d = (p1 - p0) / h the chord velocity, the interpolant stays within
+ * h/4 * max(|v0 - d|, |v1 - d|) of the chord, so a box around the samples grown by this
+ * covers the whole interval.
+ */
+[[nodiscard]] inline double hermite_chord_bulge(
+    double h, const Vec3& p0, const Vec3& p1, const Vec3& v0, const Vec3& v1) noexcept
+{
+    const Vec3 d = (p1 - p0) * (1.0 / h);
+    const double e0 = norm(v0 - d);
+    const double e1 = norm(v1 - d);
+    return 0.25 * h * ((e0 > e1) ? e0 : e1);
+}
+
+/**
+ * @brief Summarize one trajectory.
+ *
+ * @param tau Sample offsets (increasing).
+ * @param r RIC positions at tau.
+ * @param v RIC velocities at tau, or empty (parabolic refinement).
+ * @param keep_out_radius_m Sphere radii (at most MAX_KEEP_OUT_SPHERES are used).
+ * @return summary over min(tau.size, r.size) samples (valid == false if there are none, or
+ *         v is non-empty but shorter).
+ */
+[[nodiscard]] ClosestApproach summarize_closest_approach(
+    Span<const double> tau,
+    Span<const Vec3> r,
+    Span<const Vec3> v,
+    Span<const double> keep_out_radius_m) noexcept;
+
+} // namespace bullseye_pred
@@ -0,0 +1,389 @@
+// core/conjunction_screen.cpp
+#include "core/conjunction_screen.hpp"
+
+#include "core/closest_approach.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <new>
+
+namespace bullseye_pred
+{
+namespace
+{
+
+// splitmix64 finalizer (as VehicleIndexMap): fixed probe order for the pair index.
+constexpr std::uint64_t mix_pair(std::uint64_t x) noexcept
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+constexpr double component(const Vec3& v, int axis) noexcept
+{
+    return (axis == 0) ? v.x : (axis == 1) ? v.y : v.z;
+}
+
+bool finite(const Vec3& v) noexcept
+{
+    return std::isfinite(v.x + v.y + v.z);
+}
+
+Vec3 min3(const Vec3& a, const Vec3& b) noexcept
+{
+    return Vec3{std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)};
+}
+
+Vec3 max3(const Vec3& a, const Vec3& b) noexcept
+{
+    return Vec3{std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)};
+}
+
+} // namespace
+
+ConjunctionScreener::ConjunctionScreener(std::size_t max_rows,
+                                         const ConjunctionScreenConfig& config) noexcept
+    : config_(config)
+{
+    if (max_rows == 0u || max_rows > 0xFFFFFFFFu || config.slice_steps == 0u ||
+        config.max_candidates == 0u || config.max_candidates > 0x7FFFFFFFu)
+    {
+        return;
+    }
+    std::size_t table_size = 8;
+    while (table_size < 2u * config.max_candidates)
+    {
+        table_size *= 2u;
+    }
+    // A slice's samples plus one on each side (see test_pair_()).
+    const std::size_t slice_samples = config.slice_steps + 3u;
+
+    rows_.reset(new (std::nothrow) std::uint32_t[max_rows]());
+    order_.reset(new (std::nothrow) std::uint32_t[max_rows]());
+    lo_.reset(new (std::nothrow) Vec3[max_rows]());
+    hi_.reset(new (std::nothrow) Vec3[max_rows]());
+    rel_r_.reset(new (std::nothrow) Vec3[slice_samples]());
+    rel_v_.reset(new (std::nothrow) Vec3[slice_samples]());
+    found_.reset(new (std::nothrow) ConjunctionCandidate[config.max_candidates]());
+    found_pos_.reset(new (std::nothrow) std::size_t[config.max_candidates]());
+    table_.reset(new (std::nothrow) std::uint32_t[table_size]());
+    if (!rows_ || !order_ || !lo_ || !hi_ || !rel_r_ || !rel_v_ || !found_ || !found_pos_ ||
+        !table_)
+    {
+        return;
+    }
+    max_rows_ = max_rows;
+    table_mask_ = table_size - 1u;
+}
+
+void ConjunctionScreener::reset_() noexcept
+{
+    stats_ = ConjunctionScreenStats{};
+    found_count_ = 0;
+}
+
+std::size_t ConjunctionScreener::screen(Span<const double> tau,
+                                        Span2D<const Vec3> r,
+                                        Span2D<const Vec3> v,
+                                        Span<const std::uint32_t> rows,
+                                        Span<ConjunctionCandidate> out) noexcept
+{
+    reset_();
+    if (!valid())
+    {
+        return 0;
+    }
+    const std::size_t n = std::min(tau.size, r.cols);
+    std::size_t count = 0;
+    for (std::size_t g = 0; g < rows.size && count < max_rows_; ++g)
+    {
+        if (rows[g] < r.rows)
+        {
+            rows_[count++] = rows[g];
+        }
+    }
+    const bool hermite = v.data != nullptr && v.rows >= r.rows && v.cols >= n;
+    screen_group_(Span<const double>{tau.data, n}, r, hermite ? v : Span2D<const Vec3>{}, count);
+    return finish_(out);
+}
+
+std::size_t ConjunctionScreener::screen(const PredictionBuffer& buf,
+                                        Span<ConjunctionCandidate> out) noexcept
+{
+    reset_();
+    if (!valid())
+    {
+        return 0;
+    }
+    // One group per (grid profile, row_t0): only those rows share sample times.
+    RowMask pending = buf.valid_rows;
+    while (pending != 0u)
+    {
+        std::size_t first = 0;
+        while (((pending >> first) & 1u) == 0u)
+        {
+            ++first;
+        }
+        std::size_t count = 0;
+        for (std::size_t i = first; i < MAX_VEHICLES; ++i)
+        {
+            if (((pending >> i) & 1u) != 0u && buf.row_grid[i] == buf.row_grid[first] &&
+                buf.row_t0[i] == buf.row_t0[first])
+            {
+                pending &= ~(RowMask{1} << i);
+                if (count < max_rows_)
+                {
+                    rows_[count++] = static_cast<std::uint32_t>(i);
+                }
+            }
+        }
+        const Span<const double> tau = buf.row_tau(first);
+        const Span2D<const Vec3> r{buf.positions[0].data(), MAX_VEHICLES, tau.size, MAX_STEPS};
+        const Span2D<const Vec3> v =
+            buf.has_velocities()
+                ? Span2D<const Vec3>{(*buf.velocities)[0].data(), MAX_VEHICLES, tau.size,
+                                     MAX_STEPS}
+                : Span2D<const Vec3>{};
+        screen_group_(tau, r, v, count);
+    }
+    return finish_(out);
+}
+
+std::size_t ConjunctionScreener::screen(const SizedPredictionBuffer& buf,
+                                        Span<ConjunctionCandidate> out) noexcept
+{
+    reset_();
+    if (!valid())
+    {
+        return 0;
+    }
+    const std::size_t count = std::min(buf.positions.rows, max_rows_);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        rows_[i] = static_cast<std::uint32_t>(i);
+    }
+    const std::size_t n = std::min(buf.steps, buf.positions.cols);
+    const Span2D<const Vec3> r{buf.positions.data, buf.positions.rows, n,
+                               buf.positions.row_stride};
+    const Span2D<const Vec3> v =
+        buf.has_velocities() ? Span2D<const Vec3>{buf.velocities.data, buf.velocities.rows, n,
+                                                  buf.velocities.row_stride}
+                             : Span2D<const Vec3>{};
+    screen_group_(Span<const double>{buf.tau.data, n}, r, v, count);
+    return finish_(out);
+}
+
+void ConjunctionScreener::screen_group_(Span<const double> tau,
+                                        Span2D<const Vec3> r,
+                                        Span2D<const Vec3> v,
+                                        std::size_t count) noexcept
+{
+    constexpr double kInf = std::numeric_limits<double>::infinity();
+    const std::size_t n = tau.size;
+    if (n == 0 || count < 2)
+    {
+        return;
+    }
+    const bool hermite = v.data != nullptr;
+    const double half = 0.5 * config_.screen_distance_m;
+    for (std::size_t g = 0; g < count; ++g)
+    {
+        order_[g] = static_cast<std::uint32_t>(g);
+    }
+
+    int axis = 0;
+    for (std::size_t k0 = 0;; k0 += config_.slice_steps)
+    {
+        const std::size_t k1 = std::min(k0 + config_.slice_steps, n - 1);
+
+        // Slice boxes: sample hull, grown by the Hermite bulge and half the screen distance.
+        std::size_t screened = 0;
+        for (std::size_t g = 0; g < count; ++g)
+        {
+            const Vec3* p = r.row(rows_[g]).data;
+            const Vec3* pv = hermite ? v.row(rows_[g]).data : nullptr;
+            Vec3 lo = p[k0];
+            Vec3 hi = p[k0];
+            bool ok = finite(p[k0]) && (!hermite || finite(pv[k0]));
+            double bulge = 0.0;
+            for (std::size_t k = k0 + 1; k <= k1; ++k)
+            {
+                lo = min3(lo, p[k]);
+                hi = max3(hi, p[k]);
+                ok = ok && finite(p[k]);
+                if (hermite)
+                {
+                    bulge = std::max(bulge, hermite_chord_bulge(tau[k] - tau[k - 1], p[k - 1],
+                                                                p[k], pv[k - 1], pv[k]));
+                    ok = ok && finite(pv[k]) && std::isfinite(bulge);
+                }
+            }
+            if (!ok)
+            {
+                lo_[g] = Vec3{kInf, kInf, kInf};
+                hi_[g] = Vec3{-kInf, -kInf, -kInf};
+                continue;
+            }
+            const double grow = half + bulge;
+            lo_[g] = lo - Vec3{grow, grow, grow};
+            hi_[g] = hi + Vec3{grow, grow, grow};
+            ++screened;
+        }
+        if (k0 == 0)
+        {
+            stats_.rows += screened;
+
+            // Sweep along the axis the boxes are most spread over (fixed for the group so the
+            // order carries from slice to slice).
+            Vec3 cmin{kInf, kInf, kInf};
+            Vec3 cmax{-kInf, -kInf, -kInf};
+            for (std::size_t g = 0; g < count; ++g)
+            {
+                if (lo_[g].x <= hi_[g].x)
+                {
+                    const Vec3 c = (lo_[g] + hi_[g]) * 0.5;
+                    cmin = min3(cmin, c);
+                    cmax = max3(cmax, c);
+                }
+            }
+            const Vec3 spread = cmax - cmin;
+            axis = (spread.y > spread.x) ? 1 : 0;
+            axis = (spread.z > component(spread, axis)) ? 2 : axis;
+        }
+
+        // Insertion sort on the box start: nearly sorted after the first slice.
+        for (std::size_t a = 1; a < count; ++a)
+        {
+            const std::uint32_t g = order_[a];
+            const double key = component(lo_[g], axis);
+            std::size_t b = a;
+            for (; b > 0 && component(lo_[order_[b - 1]], axis) > key; --b)
+            {
+                order_[b] = order_[b - 1];
+            }
+            order_[b] = g;
+        }
+
+        const int ax1 = (axis + 1) % 3;
+        const int ax2 = (axis + 2) % 3;
+        for (std::size_t a = 0; a < count; ++a)
+        {
+            const std::uint32_t ga = order_[a];
+            if (!(lo_[ga].x <= hi_[ga].x))
+            {
+                break; // empty boxes sort last
+            }
+            const double end = component(hi_[ga], axis);
+            for (std::size_t b = a + 1; b < count; ++b)
+            {
+                const std::uint32_t gb = order_[b];
+                if (!(component(lo_[gb], axis) <= end))
+                {
+                    break;
+                }
+                if (component(lo_[gb], ax1) <= component(hi_[ga], ax1) &&
+                    component(lo_[ga], ax1) <= component(hi_[gb], ax1) &&
+                    component(lo_[gb], ax2) <= component(hi_[ga], ax2) &&
+                    component(lo_[ga], ax2) <= component(hi_[gb], ax2))
+                {
+                    test_pair_(tau, r, v, rows_[ga], rows_[gb], k0, k1);
+                }
+            }
+        }
+        ++stats_.slices;
+        if (k1 + 1 >= n)
+        {
+            break;
+        }
+    }
+}
+
+void ConjunctionScreener::test_pair_(Span<const double> tau,
+                                     Span2D<const Vec3> r,
+                                     Span2D<const Vec3> v,
+                                     std::uint32_t a,
+                                     std::uint32_t b,
+                                     std::size_t k0,
+                                     std::size_t k1) noexcept
+{
+    const std::uint32_t ra = std::min(a, b);
+    const std::uint32_t rb = std::max(a, b);
+    const bool hermite = v.data != nullptr;
+
+    // One neighbour sample past each end, so a minimum at a slice boundary is refined on the
+    // interval beyond it too.
+    k0 = (k0 > 0) ? k0 - 1 : 0;
+    k1 = std::min(k1 + 1, tau.size - 1);
+    const std::size_t count = k1 - k0 + 1;
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        rel_r_[k] = r.row(rb)[k0 + k] - r.row(ra)[k0 + k];
+        if (hermite)
+        {
+            rel_v_[k] = v.row(rb)[k0 + k] - v.row(ra)[k0 + k];
+        }
+    }
+    ++stats_.pair_tests;
+    const ClosestApproach ca = summarize_closest_approach(
+        Span<const double>{tau.data + k0, count}, Span<const Vec3>{rel_r_.get(), count},
+        hermite ? Span<const Vec3>{rel_v_.get(), count} : Span<const Vec3>{},
+        Span<const double>{});
+    if (!ca.valid || !(ca.min_range_m < config_.screen_distance_m))
+    {
+        return;
+    }
+
+    const std::uint64_t key = (static_cast<std::uint64_t>(ra) << 32) | rb;
+    std::size_t pos = static_cast<std::size_t>(mix_pair(key)) & table_mask_;
+    for (; table_[pos] != 0u; pos = (pos + 1u) & table_mask_)
+    {
+        ConjunctionCandidate& c = found_[table_[pos] - 1u];
+        if (c.row_a == ra && c.row_b == rb)
+        {
+            if (ca.min_range_m < c.miss_m)
+            {
+                c.miss_m = ca.min_range_m;
+                c.tca_tau = ca.tca_tau;
+                c.dr_tca = ca.r_tca;
+            }
+            return;
+        }
+    }
+    if (found_count_ >= config_.max_candidates)
+    {
+        ++stats_.dropped;
+        return;
+    }
+    found_[found_count_] = ConjunctionCandidate{ra, rb, ca.min_range_m, ca.tca_tau, ca.r_tca};
+    found_pos_[found_count_] = pos;
+    table_[pos] = static_cast<std::uint32_t>(++found_count_);
+}
+
+std::size_t ConjunctionScreener::finish_(Span<ConjunctionCandidate> out) noexcept
+{
+    for (std::size_t c = 0; c < found_count_; ++c)
+    {
+        table_[found_pos_[c]] = 0u;
+    }
+    std::sort(found_.get(), found_.get() + found_count_,
+              [](const ConjunctionCandidate& x, const ConjunctionCandidate& y) noexcept
+              {
+                  if (x.miss_m != y.miss_m)
+                  {
+                      return x.miss_m < y.miss_m;
+                  }
+                  return (x.row_a != y.row_a) ? x.row_a < y.row_a : x.row_b < y.row_b;
+              });
+    const std::size_t written = std::min(found_count_, out.size);
+    std::copy_n(found_.get(), written, out.data);
+    stats_.candidates = found_count_;
+    stats_.dropped += found_count_ - written;
+    return written;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,184 @@
+// core/conjunction_screen.hpp
+#pragma once
+/**
+ * @file conjunction_screen.hpp
+ * @brief Deputy-to-deputy conjunction screening over published RIC trajectories.
+ *
+ * @details
+ * Pairs of rows sampled on the same grid are screened for relative range below
+ * ConjunctionScreenConfig::screen_distance_m. Instead of comparing every pair at every sample,
+ * the grid is cut into time slices of slice_steps intervals (adjacent slices share their
+ * boundary sample) and, per slice:
+ *
+ * 1. broad phase: each row gets an axis-aligned box around its samples in the slice,
+ *    grown by half the screen distance plus a bound on how far the Hermite interpolant bulges
+ *    past its samples; boxes are sorted along one axis and swept (sweep-and-prune), so only
+ *    pairs whose boxes overlap in all three axes go on. The sort order is kept from slice to
+ *    slice, so re-sorting a coherent set is close to linear;
+ * 2. narrow phase: the relative trajectory of each surviving pair in the slice goes through
+ *    summarize_closest_approach() (Hermite refinement with velocities, parabolic without).
+ *
+ * A pair's candidate is the smallest miss over its slices. Candidates are returned closest
+ * first (ties by row pair), so a short output span keeps the most severe ones.
+ *
+ * All scratch is allocated at construction for a fixed row capacity; screen() does no heap
+ * allocation and is deterministic. One screen() at a time per screener.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "core/prediction_buffer.hpp"
+#include "core/sized_publisher.hpp"
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Screening thresholds and scratch sizes (fixed at construction).
+ */
+struct ConjunctionScreenConfig final
+{
+    /** @brief Pairs whose refined miss distance is below this are candidates [m]. */
+    double screen_distance_m{1000.0};
+
+    /** @brief Sample intervals per time slice (>= 1); smaller slices give tighter boxes. */
+    std::size_t slice_steps{8};
+
+    /** @brief Distinct candidate pairs held per screen(); further pairs are dropped. */
+    std::size_t max_candidates{1024};
+};
+
+/**
+ * @brief One screened pair at its closest approach.
+ */
+struct ConjunctionCandidate final
+{
+    /** @brief Row indices, row_a < row_b. */
+    std::uint32_t row_a{0};
+    std::uint32_t row_b{0};
+
+    /** @brief Miss distance [m]. */
+    double miss_m{0.0};
+
+    /** @brief Time of closest approach, offset from the rows' t0 [s]. */
+    double tca_tau{0.0};
+
+    /** @brief Relative position r_b - r_a at TCA (RIC) [m]. */
+    Vec3 dr_tca{};
+};
+
+/**
+ * @brief Work done by the last screen().
+ */
+struct ConjunctionScreenStats final
+{
+    /** @brief Rows screened (valid, finite, within capacity). */
+    std::size_t rows{0};
+
+    /** @brief Time slices swept (summed over grid groups). */
+    std::size_t slices{0};
+
+    /** @brief Pair-slices that reached the narrow phase. */
+    std::size_t pair_tests{0};
+
+    /** @brief Distinct pairs below the screen distance. */
+    std::size_t candidates{0};
+
+    /**
+     * @brief Candidates not returned: cut by a short output span, or (counted per pair-slice)
+     *        found with the candidate table full.
+     */
+    std::size_t dropped{0};
+};
+
+class ConjunctionScreener final
+{
+  public:
+    /**
+     * @param max_rows Largest number of rows screened together.
+     * @param config Thresholds and scratch sizes.
+     *
+     * On allocation failure (or a zero size) valid() is false and screen() returns 0.
+     */
+    explicit ConjunctionScreener(std::size_t max_rows = MAX_VEHICLES,
+                                 const ConjunctionScreenConfig& config = {}) noexcept;
+
+    ConjunctionScreener(const ConjunctionScreener&) = delete;
+    ConjunctionScreener& operator=(const ConjunctionScreener&) = delete;
+
+    [[nodiscard]] bool valid() const noexcept { return max_rows_ != 0; }
+    [[nodiscard]] const ConjunctionScreenConfig& config() const noexcept { return config_; }
+
+    /**
+     * @brief Screen rows @p rows of one trajectory set sampled on @p tau.
+     *
+     * @param tau Sample offsets (increasing); tau.size samples of every row are used.
+     * @param r Positions, r.row(i)[k] at tau[k].
+     * @param v Velocities of the same shape, or empty (parabolic refinement).
+     * @param rows Row indices to screen (< r.rows; at most max_rows are used).
+     * @param out Candidates, closest first.
+     * @return candidates written to @p out.
+     */
+    std::size_t screen(Span<const double> tau,
+                       Span2D<const Vec3> r,
+                       Span2D<const Vec3> v,
+                       Span<const std::uint32_t> rows,
+                       Span<ConjunctionCandidate> out) noexcept;
+
+    /**
+     * @brief Screen the valid rows of a snapshot.
+     *
+     * Rows are paired only with rows on the same grid profile and row_t0; rows carried with an
+     * older t0 or sampled on another grid are screened among themselves. Uses the velocity
+     * plane when the snapshot carries one.
+     */
+    std::size_t screen(const PredictionBuffer& buf, Span<ConjunctionCandidate> out) noexcept;
+
+    /** @brief Screen every row of a runtime-sized snapshot. */
+    std::size_t screen(const SizedPredictionBuffer& buf, Span<ConjunctionCandidate> out) noexcept;
+
+    /** @brief Counters of the last screen(). */
+    [[nodiscard]] const ConjunctionScreenStats& stats() const noexcept { return stats_; }
+
+  private:
+    void reset_() noexcept;
+    void screen_group_(Span<const double> tau,
+                       Span2D<const Vec3> r,
+                       Span2D<const Vec3> v,
+                       std::size_t count) noexcept;
+    void test_pair_(Span<const double> tau,
+                    Span2D<const Vec3> r,
+                    Span2D<const Vec3> v,
+                    std::uint32_t a,
+                    std::uint32_t b,
+                    std::size_t k0,
+                    std::size_t k1) noexcept;
+    std::size_t finish_(Span<ConjunctionCandidate> out) noexcept;
+
+    ConjunctionScreenConfig config_{};
+    std::size_t max_rows_{0};
+    std::size_t table_mask_{0};
+    ConjunctionScreenStats stats_{};
+
+    // Per-group rows and their slice boxes (indexed by group position).
+    std::unique_ptr<std::uint32_t[]> rows_{};
+    std::unique_ptr<std::uint32_t[]> order_{};
+    std::unique_ptr<Vec3[]> lo_{};
+    std::unique_ptr<Vec3[]> hi_{};
+
+    // Relative trajectory of one pair over one slice.
+    std::unique_ptr<Vec3[]> rel_r_{};
+    std::unique_ptr<Vec3[]> rel_v_{};
+
+    // Candidates, and an open-addressing index on their row pair (entry: candidate + 1).
+    std::unique_ptr<ConjunctionCandidate[]> found_{};
+    std::unique_ptr<std::size_t[]> found_pos_{};
+    std::unique_ptr<std::uint32_t[]> table_{};
+    std::size_t found_count_{0};
+};
+
+} // namespace bullseye_pred
@@ -8,8 +8,38 @@
 
 namespace bullseye_pred {
 
-// Capacity / sizing constants (v1 fixed-size design).
-inline constexpr std::size_t MAX_VEHICLES = 32;
-inline constexpr std::size_t MAX_STEPS = 600;
+// Capacity / sizing constants (v1 fixed-size design). Every snapshot, map and plane is sized
+// from these at compile time; a build picks them with BULLSEYE_MAX_VEHICLES / BULLSEYE_MAX_STEPS
+// (CMake cache variables of the same names). Small builds get small buffers and loops the
+// compiler can unroll; binary files (checkpoint, recording, shm segment, ephemeris) record the
+// capacities and are rejected by a build with different ones.
+#ifndef BULLSEYE_MAX_VEHICLES
+#define BULLSEYE_MAX_VEHICLES 32
+#endif
+#ifndef BULLSEYE_MAX_STEPS
+#define BULLSEYE_MAX_STEPS 600
+#endif
+
+inline constexpr std::size_t MAX_VEHICLES = BULLSEYE_MAX_VEHICLES;
+inline constexpr std::size_t MAX_STEPS = BULLSEYE_MAX_STEPS;
+
+// Row masks are 64-bit; the network wire format counts steps in 16 bits.
+static_assert(MAX_VEHICLES >= 1 && MAX_VEHICLES <= 64, "BULLSEYE_MAX_VEHICLES must be 1..64");
+static_assert(MAX_STEPS >= 2 && MAX_STEPS <= 65535, "BULLSEYE_MAX_STEPS must be 2..65535");
+
+// Grid profiles per snapshot: 0 is the step() grid, 1.. are per-vehicle profiles
+// (VehicleIndexMap::set_grid_profile).
+inline constexpr std::size_t MAX_GRID_PROFILES = 4;
+
+// Keep-out spheres per closest-approach summary (ClosestApproach::keep_out_entry_tau).
+inline constexpr std::size_t MAX_KEEP_OUT_SPHERES = 4;
+
+// Planned impulsive burns per vehicle (BasicRelativePredictor::set_planned_burns).
+inline constexpr std::size_t MAX_PLANNED_BURNS = 8;
+
+// Per-tick chief ephemeris capacity (YA RK4 stage samples; 2 per substep + 1 per interval).
+// Covers MAX_STEPS intervals of up to 6 RK4 substeps each; larger schedules fall back to
+// per-deputy chief propagation.
+inline constexpr std::size_t MAX_CHIEF_EPHEMERIS_SAMPLES = MAX_STEPS * 13;
 
 }  // namespace bullseye_pred
@@ -186,6 +186,7 @@ enum class DegradeReason : std::uint32_t
     kAdoptedInvalid = 1u << 0,
     kDegenerateChief = 1u << 1,
     kProviderJitter = 1u << 2,
+    kSourceTransition = 1u << 3, // FR-9: within kTransitionDegradedTicks of a large jump
 };
 
 inline constexpr DegradeReason operator|(DegradeReason a, DegradeReason b) noexcept
@@ -211,6 +212,8 @@ namespace Grav
 {
 inline constexpr double kMuM3PerS2 = 3.986004418e14;   // Earth placeholder
 inline constexpr const char* kCentralBodyId = "EARTH"; // placeholder (JEOD uses body string)
+inline constexpr double kJ2 = 1.08262668e-3;            // Earth J2 (Schweighart-Sedwick model)
+inline constexpr double kREqM = 6378137.0;              // Earth equatorial radius [m]
 } // namespace Grav
 
 // ---------------------------------
@@ -0,0 +1,122 @@
+// core/dispersion.cpp
+
+#include "core/dispersion.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bullseye_pred
+{
+namespace
+{
+
+constexpr std::uint64_t kGolden = 0x9E3779B97F4A7C15ull;
+
+inline std::uint64_t splitmix64(std::uint64_t z) noexcept
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// (0, 1] from the top 53 bits, so log() below never sees 0.
+inline double unit_open0(std::uint64_t h) noexcept
+{
+    return static_cast<double>((h >> 11) + 1u) * 0x1.0p-53;
+}
+
+} // namespace
+
+std::uint64_t counter_hash(std::uint64_t seed, std::uint64_t stream, std::uint64_t counter) noexcept
+{
+    const std::uint64_t key = splitmix64(seed + kGolden) ^ splitmix64(stream + 2u * kGolden);
+    return splitmix64(key + counter * kGolden);
+}
+
+double counter_normal(std::uint64_t seed, std::uint64_t stream, std::uint64_t counter) noexcept
+{
+    constexpr double kTwoPi = 6.283185307179586476925286766559;
+    const double u1 = unit_open0(counter_hash(seed, stream, 2u * counter));
+    const double u2 = unit_open0(counter_hash(seed, stream, 2u * counter + 1u));
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(kTwoPi * u2);
+}
+
+bool covariance_factor(const StateCovariance& P, CovarianceFactor& out) noexcept
+{
+    double max_diag = 0.0;
+    for (int i = 0; i < 6; ++i)
+    {
+        for (int j = 0; j < 6; ++j)
+        {
+            if (!std::isfinite(P.m[i][j]))
+            {
+                return false;
+            }
+        }
+        max_diag = std::max(max_diag, P.m[i][i]);
+    }
+    const double tiny = 1e-12 * max_diag;
+
+    CovarianceFactor L{};
+    for (int j = 0; j < 6; ++j)
+    {
+        double d = P.m[j][j];
+        for (int k = 0; k < j; ++k)
+        {
+            d -= L[j][k] * L[j][k];
+        }
+        if (d < -tiny)
+        {
+            return false;
+        }
+        if (d <= tiny)
+        {
+            continue; // zero pivot: this direction carries no variance
+        }
+        const double ljj = std::sqrt(d);
+        L[j][j] = ljj;
+        for (int i = j + 1; i < 6; ++i)
+        {
+            double s = P.m[i][j];
+            for (int k = 0; k < j; ++k)
+            {
+                s -= L[i][k] * L[j][k];
+            }
+            L[i][j] = s / ljj;
+        }
+    }
+    out = L;
+    return true;
+}
+
+void dispersion_states(const RelStateRic& x0,
+                       const CovarianceFactor& L,
+                       std::uint64_t seed,
+                       std::uint64_t stream,
+                       std::size_t first,
+                       Span<RelStateRic> out) noexcept
+{
+    for (std::size_t s = 0; s < out.size; ++s)
+    {
+        const std::uint64_t base = static_cast<std::uint64_t>(first + s) * 6u;
+        double z[6];
+        for (std::size_t c = 0; c < 6; ++c)
+        {
+            z[c] = counter_normal(seed, stream, base + c);
+        }
+        double dx[6];
+        for (std::size_t r = 0; r < 6; ++r)
+        {
+            double acc = 0.0;
+            for (std::size_t c = 0; c <= r; ++c)
+            {
+                acc += L[r][c] * z[c];
+            }
+            dx[r] = acc;
+        }
+        out[s].r_ric = x0.r_ric + Vec3{dx[0], dx[1], dx[2]};
+        out[s].v_ric = x0.v_ric + Vec3{dx[3], dx[4], dx[5]};
+    }
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,109 @@
+// core/dispersion.hpp
+#pragma once
+
+/**
+ * @file dispersion.hpp
+ * @brief Monte Carlo dispersions of deputy initial states with counter-based random streams.
+ *
+ * A dispersion evaluates K perturbed copies of a deputy's RIC initial state,
+ *
+ *   x0_s = x0 + L z_s,   L L^T = P (RIC state covariance),   z_s ~ N(0, I6)
+ *
+ * through the same model and grid as the nominal row. The predictor runs every sample of a
+ * row in batched model calls on the tick's prepared policy (chief ephemeris, frame, STM
+ * tables), so K samples cost K model rows, not K ticks (see
+ * BasicRelativePredictor::configure_dispersion()).
+ *
+ * Draws come from a counter-based generator: normal number c of stream s under seed k is a
+ * pure function of (k, s, c). Streams are vehicle ids and counters are sample * 6 + component,
+ * so a sample does not depend on the vehicle's row, the sample count, the chunking of the
+ * batch or the number of threads.
+ *
+ * Design constraints:
+ * - No logging.
+ * - No heap allocations.
+ * - Deterministic: identical inputs give bitwise identical samples on every run.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/prediction_buffer.hpp"
+#include "core/state_covariance.hpp"
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/** @brief Lower-triangular factor L of a StateCovariance (L L^T = P). */
+using CovarianceFactor = std::array<std::array<double, 6>, 6>;
+
+/**
+ * @brief Dispersion run by the predictor after every tick (off by default).
+ */
+struct DispersionConfig final
+{
+    /** @brief Samples per dispersed row (K); 0 disables dispersion. */
+    std::size_t samples{0};
+
+    /** @brief Seed of the counter-based streams; same seed, same samples. */
+    std::uint64_t seed{0};
+
+    /** @brief RIC initial-state covariance of the perturbation (symmetric PSD). */
+    StateCovariance covariance{};
+
+    /** @brief Rows to disperse (bit i = row i); rows not predicted this tick are skipped. */
+    RowMask rows{kAllRows};
+};
+
+/**
+ * @brief Outcome of the last tick's dispersion pass.
+ */
+struct DispersionStats final
+{
+    /** @brief Rows whose samples were written this tick. */
+    RowMask rows{0};
+
+    /** @brief Samples whose model call succeeded / failed. */
+    std::size_t samples_ok{0};
+    std::size_t samples_failed{0};
+};
+
+/**
+ * @brief Counter-based 64-bit hash of (seed, stream, counter) (SplitMix64 rounds).
+ */
+[[nodiscard]] std::uint64_t counter_hash(std::uint64_t seed,
+                                         std::uint64_t stream,
+                                         std::uint64_t counter) noexcept;
+
+/**
+ * @brief Standard normal draw number @p counter of stream @p stream (Box-Muller on two
+ *        counter_hash() uniforms in (0, 1]).
+ */
+[[nodiscard]] double counter_normal(std::uint64_t seed,
+                                    std::uint64_t stream,
+                                    std::uint64_t counter) noexcept;
+
+/**
+ * @brief Cholesky factor of a symmetric positive semidefinite covariance.
+ *
+ * Pivots below 1e-12 times the largest diagonal are treated as zero (the column of L is
+ * zero), so singular covariances (e.g. position-only) are accepted.
+ *
+ * @return false (out unchanged) if @p P is non-finite or not positive semidefinite.
+ */
+[[nodiscard]] bool covariance_factor(const StateCovariance& P, CovarianceFactor& out) noexcept;
+
+/**
+ * @brief out[j] = x0 + L z for samples first .. first + out.size - 1 of stream @p stream.
+ */
+void dispersion_states(const RelStateRic& x0,
+                       const CovarianceFactor& L,
+                       std::uint64_t seed,
+                       std::uint64_t stream,
+                       std::size_t first,
+                       Span<RelStateRic> out) noexcept;
+
+} // namespace bullseye_pred
@@ -2,22 +2,22 @@
 
 #include "core/log_names.hpp"
 #include "core/logging.hpp"
-#include "logger/log_macros.hpp"
+#include "core/log_macros.hpp"
 
-#include <algorithm> // std::min
+#include <algorithm> // std::min, std::copy_n
+#include <cstddef>
 
 namespace bullseye_pred
 {
 
 void DummyPredictor::step(double t0, double horizon_sec, double cadence_sec) noexcept
 {
-    static auto log = bullseye_pred::logging::get(bullseye_pred::logname::kCoreDummyPredictor);
-
-    const auto grid = make_time_grid(horizon_sec, cadence_sec);
+    const TimeGrid& grid = grid_cache_.get(horizon_sec, cadence_sec);
     if (grid.tau.empty())
     {
-        LOG_WARNF(log, "step: empty grid (t0=%.17g horizon=%.17g cadence=%.17g)", t0, horizon_sec,
-                  cadence_sec);
+        BULLSEYE_LOG_WARNF(logname::kCoreDummyPredictor,
+                           "step: empty grid (t0=%.17g horizon=%.17g cadence=%.17g)", t0,
+                           horizon_sec, cadence_sec);
         return;
     }
 
@@ -26,17 +26,21 @@ void DummyPredictor::step(double t0, double horizon_sec, double cadence_sec) noe
     // Determine how many steps we can write without exceeding MAX_STEPS.
     const std::size_t steps = std::min<std::size_t>(grid.tau.size(), MAX_STEPS);
 
-    // For Sprint 1: fill only registered vehicles [0..map_.size()).
-    const std::size_t nveh = std::min<std::size_t>(map_.size(), MAX_VEHICLES);
+    // For Sprint 1: fill only registered vehicles [0..map_.slot_count()), skipping free slots.
+    const std::size_t nveh = std::min<std::size_t>(map_.slot_count(), MAX_VEHICLES);
 
     // Deterministic fill function:
     //   pos.x = i + 0.001*k
     //   pos.y = k + 0.01*i
     //   pos.z = tau[k]
     //
-    // Note: tau[k] itself is deterministic from make_time_grid().
+    // Note: tau[k] itself is deterministic from make_time_grid() (cached by TimeGridCache).
     for (std::size_t i = 0; i < nveh; ++i)
     {
+        if (!map_.id_at(i).has_value())
+        {
+            continue;
+        }
         for (std::size_t k = 0; k < steps; ++k)
         {
             const double tau = grid.tau[k];
@@ -45,13 +49,28 @@ void DummyPredictor::step(double t0, double horizon_sec, double cadence_sec) noe
         }
     }
 
+    buf.steps = steps;
+    std::copy_n(grid.tau.data(), steps, buf.tau.data());
+    buf.vehicles = nveh;
+    buf.valid_rows = 0;
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        const bool used = (i < nveh) && map_.id_at(i).has_value();
+        buf.row_status[i] = used ? RowStatus::kOk : RowStatus::kEmpty;
+        if (used)
+        {
+            buf.valid_rows |= RowMask{1} << i;
+        }
+    }
+
     // Optional: if you want deterministic "unused" region behavior, you can zero it here.
     // Not required yet; leaving stale values is fine as long as consumers gate on step count.
 
     const auto seq = pub_.publish(t0);
 
-    LOG_DEBUGF(log, "step: published seqno=%llu t0=%.17g nveh=%zu steps=%zu",
-               static_cast<unsigned long long>(seq), t0, nveh, steps);
+    BULLSEYE_LOG_DEBUGF(logname::kCoreDummyPredictor,
+                        "step: published seqno=%llu t0=%.17g nveh=%zu steps=%zu",
+                        static_cast<unsigned long long>(seq), t0, nveh, steps);
 }
 
 } // namespace bullseye_pred
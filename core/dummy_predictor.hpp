@@ -2,6 +2,7 @@
 
 #include <cstddef>
 
+#include "core/constants.hpp"
 #include "core/publisher.hpp"
 #include "core/time_grid.hpp"
 #include "core/vehicle_index_map.hpp"
@@ -41,6 +42,7 @@ class DummyPredictor final
   private:
     Publisher& pub_;
     VehicleIndexMap& map_;
+    TimeGridCache grid_cache_{MAX_STEPS};
 };
 
 } // namespace bullseye_pred
@@ -0,0 +1,354 @@
+#include "core/ephemeris_file.hpp"
+
+#include "core/time_series_cursor.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BULLSEYE_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bullseye_pred
+{
+
+namespace
+{
+
+constexpr std::uint64_t align64(std::uint64_t bytes) noexcept
+{
+    return (bytes + 63u) / 64u * 64u;
+}
+
+constexpr std::uint32_t record_bytes_for(EphemerisKind kind) noexcept
+{
+    switch (kind)
+    {
+    case EphemerisKind::kChief:
+        return sizeof(ChiefEphemerisRecord);
+    case EphemerisKind::kVehicle:
+        return sizeof(VehicleEphemerisRecord);
+    case EphemerisKind::kFrame:
+        return sizeof(FrameEphemerisRecord);
+    }
+    return 0u;
+}
+
+template <class Record>
+bool series_times_valid(const Record* r, std::size_t n, std::uint64_t id) noexcept
+{
+    if (!detail::strictly_increasing_times(r, n))
+    {
+        return false;
+    }
+    if constexpr (std::is_same<Record, VehicleEphemerisRecord>::value)
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (r[i].id != id)
+            {
+                return false;
+            }
+        }
+    }
+    else
+    {
+        (void)id;
+    }
+    return true;
+}
+
+bool write_zeros(std::FILE* f, std::uint64_t n) noexcept
+{
+    static const unsigned char zeros[64] = {};
+    while (n > 0u)
+    {
+        const std::size_t chunk = (n < sizeof(zeros)) ? static_cast<std::size_t>(n) : sizeof(zeros);
+        if (std::fwrite(zeros, 1, chunk, f) != chunk)
+        {
+            return false;
+        }
+        n -= chunk;
+    }
+    return true;
+}
+
+// Writes to "<path>.tmp" and renames it over @p path, so processes that still map the old file
+// keep reading consistent (old) pages.
+EphemerisCode write_file(const char* path, EphemerisKind kind, const void* records,
+                         std::size_t record_count, const std::vector<EphemerisSeries>& series)
+{
+    EphemerisFileHeader hdr{};
+    hdr.magic = kEphemerisMagic;
+    hdr.format_version = kEphemerisFormatVersion;
+    hdr.kind = static_cast<std::uint32_t>(kind);
+    hdr.header_bytes = sizeof(EphemerisFileHeader);
+    hdr.record_bytes = record_bytes_for(kind);
+    hdr.series_count = series.size();
+    hdr.series_offset = align64(sizeof(EphemerisFileHeader));
+    hdr.record_count = record_count;
+    hdr.records_offset = align64(hdr.series_offset + series.size() * sizeof(EphemerisSeries));
+    hdr.file_bytes = hdr.records_offset + record_count * std::uint64_t{hdr.record_bytes};
+
+    const std::string tmp = std::string(path) + ".tmp";
+    std::FILE* f = std::fopen(tmp.c_str(), "wb");
+    if (f == nullptr)
+    {
+        return EphemerisCode::kOpenFailed;
+    }
+    const std::size_t data_bytes = record_count * hdr.record_bytes;
+    bool ok = std::fwrite(&hdr, sizeof(hdr), 1, f) == 1u &&
+              write_zeros(f, hdr.series_offset - sizeof(hdr)) &&
+              (series.empty() ||
+               std::fwrite(series.data(), sizeof(EphemerisSeries), series.size(), f) ==
+                   series.size()) &&
+              write_zeros(f, hdr.records_offset - hdr.series_offset -
+                                 series.size() * sizeof(EphemerisSeries)) &&
+              (data_bytes == 0u || std::fwrite(records, 1, data_bytes, f) == data_bytes);
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok || std::rename(tmp.c_str(), path) != 0)
+    {
+        (void)std::remove(tmp.c_str());
+        return EphemerisCode::kWriteFailed;
+    }
+    return EphemerisCode::kOk;
+}
+
+template <class Record>
+EphemerisCode write_single_series(const char* path, EphemerisKind kind, Span<const Record> records)
+{
+    if (path == nullptr || !detail::strictly_increasing_times(records.data, records.size))
+    {
+        return EphemerisCode::kInvalidInput;
+    }
+    std::vector<EphemerisSeries> series;
+    if (records.size > 0u)
+    {
+        series.push_back(EphemerisSeries{0u, 0u, records.size});
+    }
+    return write_file(path, kind, records.data, records.size, series);
+}
+
+} // namespace
+
+EphemerisFile::~EphemerisFile()
+{
+    close();
+}
+
+#if defined(BULLSEYE_HAVE_MMAP)
+
+EphemerisCode EphemerisFile::open(const char* path, EphemerisKind kind,
+                                  bool verify_times) noexcept
+{
+    close();
+    if (path == nullptr)
+    {
+        return EphemerisCode::kInvalidInput;
+    }
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return EphemerisCode::kOpenFailed;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(EphemerisFileHeader)))
+    {
+        ::close(fd);
+        return EphemerisCode::kLayoutMismatch;
+    }
+    const auto bytes = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+    {
+        return EphemerisCode::kMapFailed;
+    }
+    base_ = p;
+    bytes_ = bytes;
+
+    const auto* hdr = static_cast<const EphemerisFileHeader*>(p);
+    const std::uint32_t rec_bytes = record_bytes_for(kind);
+    EphemerisCode code = EphemerisCode::kOk;
+    if (hdr->magic != kEphemerisMagic)
+    {
+        code = EphemerisCode::kBadMagic;
+    }
+    else if (hdr->format_version != kEphemerisFormatVersion)
+    {
+        code = EphemerisCode::kVersionMismatch;
+    }
+    else if (hdr->kind != static_cast<std::uint32_t>(kind) ||
+             hdr->header_bytes != sizeof(EphemerisFileHeader) || hdr->record_bytes != rec_bytes ||
+             hdr->series_count > bytes / sizeof(EphemerisSeries) ||
+             hdr->record_count > bytes / rec_bytes ||
+             (kind != EphemerisKind::kVehicle && hdr->series_count > 1u) ||
+             hdr->series_offset != align64(sizeof(EphemerisFileHeader)) ||
+             hdr->records_offset !=
+                 align64(hdr->series_offset + hdr->series_count * sizeof(EphemerisSeries)) ||
+             hdr->file_bytes != hdr->records_offset + hdr->record_count * rec_bytes ||
+             hdr->file_bytes > bytes)
+    {
+        code = EphemerisCode::kLayoutMismatch;
+    }
+    else
+    {
+        // Directory: contiguous, non-empty runs covering every record, ids strictly increasing.
+        const auto* series = reinterpret_cast<const EphemerisSeries*>(
+            static_cast<const unsigned char*>(p) + hdr->series_offset);
+        std::uint64_t next = 0;
+        for (std::uint64_t i = 0; i < hdr->series_count && code == EphemerisCode::kOk; ++i)
+        {
+            if (series[i].first != next || series[i].count == 0u ||
+                series[i].count > hdr->record_count - next)
+            {
+                code = EphemerisCode::kLayoutMismatch;
+            }
+            else if ((i > 0u && !(series[i - 1u].id < series[i].id)) ||
+                     (kind != EphemerisKind::kVehicle && series[i].id != 0u))
+            {
+                code = EphemerisCode::kUnsorted;
+            }
+            next += series[i].count;
+        }
+        if (code == EphemerisCode::kOk && next != hdr->record_count)
+        {
+            code = EphemerisCode::kLayoutMismatch;
+        }
+        hdr_ = hdr;
+        series_ = series;
+    }
+
+    for (std::size_t i = 0; verify_times && code == EphemerisCode::kOk && i < series_count(); ++i)
+    {
+        bool ok = false;
+        switch (kind)
+        {
+        case EphemerisKind::kChief:
+        {
+            const auto r = records<ChiefEphemerisRecord>(i);
+            ok = series_times_valid(r.data, r.size, series_[i].id);
+            break;
+        }
+        case EphemerisKind::kVehicle:
+        {
+            const auto r = records<VehicleEphemerisRecord>(i);
+            ok = series_times_valid(r.data, r.size, series_[i].id);
+            break;
+        }
+        case EphemerisKind::kFrame:
+        {
+            const auto r = records<FrameEphemerisRecord>(i);
+            ok = series_times_valid(r.data, r.size, series_[i].id);
+            break;
+        }
+        }
+        code = ok ? EphemerisCode::kOk : EphemerisCode::kUnsorted;
+    }
+
+    if (code != EphemerisCode::kOk)
+    {
+        close();
+    }
+    return code;
+}
+
+void EphemerisFile::close() noexcept
+{
+    if (base_ != nullptr)
+    {
+        (void)::munmap(base_, bytes_);
+    }
+    base_ = nullptr;
+    bytes_ = 0;
+    hdr_ = nullptr;
+    series_ = nullptr;
+}
+
+#else
+
+EphemerisCode EphemerisFile::open(const char*, EphemerisKind, bool) noexcept
+{
+    close();
+    return EphemerisCode::kUnsupported;
+}
+
+void EphemerisFile::close() noexcept
+{
+    base_ = nullptr;
+    bytes_ = 0;
+    hdr_ = nullptr;
+    series_ = nullptr;
+}
+
+#endif
+
+std::size_t EphemerisFile::find_series(std::uint64_t id) const noexcept
+{
+    std::size_t lo = 0;
+    std::size_t hi = series_count();
+    while (lo < hi)
+    {
+        const std::size_t mid = lo + (hi - lo) / 2u;
+        if (series_[mid].id < id)
+        {
+            lo = mid + 1u;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return (lo < series_count() && series_[lo].id == id) ? lo : series_count();
+}
+
+EphemerisCode write_chief_ephemeris(const char* path, Span<const ChiefEphemerisRecord> records)
+{
+    return write_single_series(path, EphemerisKind::kChief, records);
+}
+
+EphemerisCode write_frame_ephemeris(const char* path, Span<const FrameEphemerisRecord> records)
+{
+    return write_single_series(path, EphemerisKind::kFrame, records);
+}
+
+EphemerisCode write_vehicle_ephemeris(const char* path,
+                                      Span<const VehicleEphemerisRecord> records)
+{
+    if (path == nullptr)
+    {
+        return EphemerisCode::kInvalidInput;
+    }
+    std::vector<EphemerisSeries> series;
+    for (std::size_t i = 0; i < records.size; ++i)
+    {
+        const VehicleEphemerisRecord& r = records[i];
+        if (!std::isfinite(r.t))
+        {
+            return EphemerisCode::kInvalidInput;
+        }
+        if (series.empty() || series.back().id != r.id)
+        {
+            if (!series.empty() && !(series.back().id < r.id))
+            {
+                return EphemerisCode::kInvalidInput;
+            }
+            series.push_back(EphemerisSeries{r.id, i, 0u});
+        }
+        else if (!(records[i - 1u].t < r.t))
+        {
+            return EphemerisCode::kInvalidInput;
+        }
+        ++series.back().count;
+    }
+    return write_file(path, EphemerisKind::kVehicle, records.data, records.size, series);
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,222 @@
+#pragma once
+/**
+ * @file ephemeris_file.hpp
+ * @brief Fixed-record binary ephemeris files, memory-mapped read-only by the ephemeris providers.
+ *
+ * @details
+ * File layout (native byte order; offsets from the file start, blocks 64-byte aligned):
+ *
+ *   [0]               EphemerisFileHeader: magic, format version, record kind and size, counts
+ *   [series_offset]   series_count x EphemerisSeries, sorted by strictly increasing id
+ *   [records_offset]  record_count x record; each series is a contiguous run of records with
+ *                     strictly increasing t
+ *
+ * Chief and frame files hold one series (id 0); vehicle files hold one series per vehicle id.
+ * open() checks the header and directory only, so startup cost does not depend on the file
+ * length: record pages fault in on first use, and every process mapping the same file shares
+ * them through the page cache. The write_*_ephemeris() functions (and the
+ * bullseye_ephemeris_convert tool) produce files that satisfy the ordering contract.
+ *
+ * On platforms without mmap() open() fails with EphemerisCode::kUnsupported.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/// "BEYEPHM1" as a little-endian integer.
+inline constexpr std::uint64_t kEphemerisMagic = 0x314D485045594542ull;
+
+/// Bumped whenever the header, directory, or a record type changes shape.
+inline constexpr std::uint32_t kEphemerisFormatVersion = 1;
+
+enum class EphemerisKind : std::uint32_t
+{
+    kChief = 1,
+    kVehicle,
+    kFrame,
+};
+
+enum class EphemerisCode : std::uint8_t
+{
+    kOk = 0,
+
+    /** @brief Null path, or records violating the ordering contract (writer). */
+    kInvalidInput,
+
+    /** @brief No mmap() on this platform. */
+    kUnsupported,
+
+    /** @brief The file could not be opened (reader) or created (writer). */
+    kOpenFailed,
+
+    /** @brief mmap() failed. */
+    kMapFailed,
+
+    /** @brief Not an ephemeris file. */
+    kBadMagic,
+
+    /** @brief Format version differs from this build. */
+    kVersionMismatch,
+
+    /** @brief Wrong record kind or size, or offsets/counts inconsistent with the file size. */
+    kLayoutMismatch,
+
+    /** @brief Directory or series times not strictly increasing (verify-on-open only). */
+    kUnsorted,
+
+    /** @brief Short write. */
+    kWriteFailed,
+};
+
+struct ChiefEphemerisRecord final
+{
+    double t{0.0};
+    Vec3 r_i{};
+    Vec3 v_i{};
+};
+
+struct VehicleEphemerisRecord final
+{
+    std::uint64_t id{0};
+    double t{0.0};
+    Vec3 r_i{};
+    Vec3 v_i{};
+};
+
+struct FrameEphemerisRecord final
+{
+    double t{0.0};
+    Vec3 origin_i{};
+    Mat3 C_from_ric_to_inertial{Mat3::identity()};
+
+    /// omega_ric is meaningful only if has_omega != 0.
+    std::uint64_t has_omega{0};
+    Vec3 omega_ric{};
+};
+
+static_assert(sizeof(ChiefEphemerisRecord) == 7 * sizeof(double) &&
+                  sizeof(VehicleEphemerisRecord) == 8 * sizeof(double) &&
+                  sizeof(FrameEphemerisRecord) == 17 * sizeof(double),
+              "ephemeris records are read in place and must not contain padding");
+static_assert(std::is_trivially_copyable<ChiefEphemerisRecord>::value &&
+                  std::is_trivially_copyable<VehicleEphemerisRecord>::value &&
+                  std::is_trivially_copyable<FrameEphemerisRecord>::value,
+              "ephemeris records are read in place");
+
+struct EphemerisFileHeader final
+{
+    std::uint64_t magic{0};
+    std::uint32_t format_version{0};
+
+    /// EphemerisKind of every record.
+    std::uint32_t kind{0};
+    std::uint32_t header_bytes{0};
+    std::uint32_t record_bytes{0};
+    std::uint64_t series_count{0};
+    std::uint64_t series_offset{0};
+    std::uint64_t record_count{0};
+    std::uint64_t records_offset{0};
+    std::uint64_t file_bytes{0};
+};
+
+/// One vehicle (or the single chief/frame series): records [first, first + count).
+struct EphemerisSeries final
+{
+    std::uint64_t id{0};
+    std::uint64_t first{0};
+    std::uint64_t count{0};
+};
+
+/**
+ * @brief Read-only mapping of one ephemeris file.
+ *
+ * Mapping happens once in open(); lookups only read the mapped pages.
+ */
+class EphemerisFile final
+{
+  public:
+    EphemerisFile() = default;
+    ~EphemerisFile();
+
+    EphemerisFile(const EphemerisFile&) = delete;
+    EphemerisFile& operator=(const EphemerisFile&) = delete;
+
+    /**
+     * @brief Map @p path and check its header and directory against @p kind.
+     *
+     * @param verify_times Also check that every series is strictly increasing in t. This reads
+     *        the whole file; leave it off for files produced by the writer functions.
+     * @return kOk or the first failed check; on failure the file is closed.
+     */
+    [[nodiscard]] EphemerisCode open(const char* path, EphemerisKind kind,
+                                     bool verify_times = false) noexcept;
+
+    /// @brief Unmap (idempotent).
+    void close() noexcept;
+
+    [[nodiscard]] bool is_open() const noexcept { return hdr_ != nullptr; }
+
+    [[nodiscard]] std::size_t series_count() const noexcept
+    {
+        return hdr_ ? static_cast<std::size_t>(hdr_->series_count) : 0u;
+    }
+    [[nodiscard]] std::size_t record_count() const noexcept
+    {
+        return hdr_ ? static_cast<std::size_t>(hdr_->record_count) : 0u;
+    }
+
+    /// @return directory entry @p i (i < series_count()).
+    [[nodiscard]] const EphemerisSeries& series(std::size_t i) const noexcept
+    {
+        return series_[i];
+    }
+
+    /// @return index of the series for @p id, or series_count() if absent (binary search).
+    [[nodiscard]] std::size_t find_series(std::uint64_t id) const noexcept;
+
+    /**
+     * @brief Records of series @p i; @p Record must match the kind passed to open().
+     */
+    template <class Record>
+    [[nodiscard]] Span<const Record> records(std::size_t i) const noexcept
+    {
+        if (hdr_ == nullptr || i >= series_count() || hdr_->record_bytes != sizeof(Record))
+        {
+            return {};
+        }
+        const auto* base = reinterpret_cast<const Record*>(
+            static_cast<const unsigned char*>(base_) + hdr_->records_offset);
+        return {base + series_[i].first, static_cast<std::size_t>(series_[i].count)};
+    }
+
+  private:
+    void* base_{nullptr};
+    std::size_t bytes_{0};
+    const EphemerisFileHeader* hdr_{nullptr};
+    const EphemerisSeries* series_{nullptr};
+};
+
+/**
+ * @brief Write a chief ephemeris file (records strictly increasing in t).
+ *
+ * Configuration/tool-time helpers: they buffer through stdio and are not for the tick path.
+ */
+[[nodiscard]] EphemerisCode write_chief_ephemeris(const char* path,
+                                                  Span<const ChiefEphemerisRecord> records);
+
+/// @brief Write a vehicle ephemeris file (records sorted by id, then strictly increasing t).
+[[nodiscard]] EphemerisCode write_vehicle_ephemeris(const char* path,
+                                                    Span<const VehicleEphemerisRecord> records);
+
+/// @brief Write an adopted-frame ephemeris file (records strictly increasing in t).
+[[nodiscard]] EphemerisCode write_frame_ephemeris(const char* path,
+                                                  Span<const FrameEphemerisRecord> records);
+
+} // namespace bullseye_pred
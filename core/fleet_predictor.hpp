@@ -0,0 +1,278 @@
+// core/fleet_predictor.hpp
+#pragma once
+/**
+ * @file fleet_predictor.hpp
+ * @brief Several formations (one chief each) stepped together on one shared worker pool.
+ *
+ * Each formation keeps what a standalone predictor has: its own VehicleIndexMap, deputy
+ * provider, BullseyeFrame and Publisher (caller-owned, reused every tick), and its own
+ * BasicRelativePredictor (owned here, allocated once in add_formation()). One fleet step():
+ *
+ * 1. fetches every batched chief (batch_chief()) with one get_many() call on the fleet chief
+ *    source, e.g. a TwoBodyVehicleProvider, which solves all chiefs in one SoA pass;
+ * 2. runs every formation's step() as one task on the pool, largest formation first, so
+ *    20 formations on 16 cores keep every core busy without one thread per formation;
+ * 3. returns when every formation has published (or failed fast, as step() does).
+ *
+ * A formation's snapshot is the same as a standalone predictor on the same inputs; which
+ * thread computes it does not matter. Providers of different formations are called
+ * concurrently and must not share unsynchronized state. Do not attach the fleet's pool to a
+ * formation's predictor (one run() at a time per pool).
+ */
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include "core/bullseye_frame.hpp"
+#include "core/bullseye_frame_provider.hpp"
+#include "core/chief_state_provider.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/time_grid.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "core/worker_pool.hpp"
+
+namespace bullseye_pred
+{
+
+template <typename ModelPolicy>
+class BasicFleetPredictor final
+{
+  public:
+    /// Formations held at most.
+    static constexpr std::size_t kMaxFormations = 64;
+
+    /**
+     * @param pool Shared pool (nullptr: formations run serially on the caller).
+     * @param chief_source Batched chief source for batch_chief() formations, or nullptr.
+     */
+    explicit BasicFleetPredictor(WorkerPool* pool = nullptr,
+                                 IVehicleStateProvider* chief_source = nullptr) noexcept
+        : pool_(pool), chief_source_(chief_source)
+    {
+    }
+
+    BasicFleetPredictor(const BasicFleetPredictor&) = delete;
+    BasicFleetPredictor& operator=(const BasicFleetPredictor&) = delete;
+
+    /**
+     * @brief Add a formation (configuration-time).
+     *
+     * Arguments as BasicRelativePredictor plus the adopted frame provider and frame mode; all
+     * references must outlive the fleet.
+     *
+     * @return formation index, or std::nullopt if the fleet is full or allocation failed.
+     */
+    template <typename... PolicyArgs>
+    std::optional<std::size_t> add_formation(Publisher& publisher,
+                                             VehicleIndexMap& vehicle_map,
+                                             IChiefStateProvider& chief_provider,
+                                             IVehicleStateProvider& vehicle_provider,
+                                             IBullseyeFrameProvider* adopted_provider,
+                                             BullseyeFrameMode mode,
+                                             PolicyArgs&&... policy_args) noexcept
+    {
+        if (count_ >= kMaxFormations)
+        {
+            return std::nullopt;
+        }
+        formations_[count_].reset(new (std::nothrow) Formation(
+            publisher, vehicle_map, chief_provider, vehicle_provider, adopted_provider, mode,
+            std::forward<PolicyArgs>(policy_args)...));
+        if (!formations_[count_])
+        {
+            return std::nullopt;
+        }
+        return count_++;
+    }
+
+    /**
+     * @brief Serve formation @p index's chief from the fleet chief source as vehicle @p id
+     *        (fetched with every other batched chief in one call per tick).
+     *
+     * @return false if there is no chief source or no such formation.
+     */
+    bool batch_chief(std::size_t index, VehicleIndexMap::VehicleId id) noexcept
+    {
+        if (chief_source_ == nullptr || index >= count_)
+        {
+            return false;
+        }
+        formations_[index]->chief.batched = true;
+        formations_[index]->chief_id = id;
+        return true;
+    }
+
+    [[nodiscard]] std::size_t formation_count() const noexcept { return count_; }
+
+    /** @brief Formation @p index's predictor (configure before the first step()). */
+    [[nodiscard]] BasicRelativePredictor<ModelPolicy>& formation(std::size_t index) noexcept
+    {
+        return formations_[index]->predictor;
+    }
+
+    /** @brief Step every formation at @p t0 on a uniform grid. */
+    void step(double t0, double horizon_sec, double cadence_sec) noexcept
+    {
+        run_(t0, nullptr, horizon_sec, cadence_sec);
+    }
+
+    /** @brief Step every formation at @p t0 on @p grid (shared, read-only). */
+    void step(double t0, const TimeGrid& grid) noexcept { run_(t0, &grid, 0.0, 0.0); }
+
+  private:
+    // Chief for one formation: its own provider, or the state batched by the fleet.
+    class ChiefSource final : public IChiefStateProvider
+    {
+      public:
+        explicit ChiefSource(IChiefStateProvider& own) noexcept : own_(own) {}
+
+        [[nodiscard]] ChiefState get(double t0) noexcept override
+        {
+            if (!batched)
+            {
+                return own_.get(t0);
+            }
+            if (!(state_t0 == t0))
+            {
+                ChiefState out{};
+                out.status.code = ProviderCode::kTimeMissing;
+                return out;
+            }
+            return state;
+        }
+
+        bool batched{false};
+        double state_t0{0.0};
+        ChiefState state{};
+
+      private:
+        IChiefStateProvider& own_;
+    };
+
+    struct Formation final
+    {
+        template <typename... PolicyArgs>
+        Formation(Publisher& publisher,
+                  VehicleIndexMap& vehicle_map,
+                  IChiefStateProvider& chief_provider,
+                  IVehicleStateProvider& vehicle_provider,
+                  IBullseyeFrameProvider* adopted_provider,
+                  BullseyeFrameMode mode,
+                  PolicyArgs&&... policy_args) noexcept
+            : map(vehicle_map), chief(chief_provider), bullseye(chief, adopted_provider, mode),
+              predictor(publisher, vehicle_map, chief, vehicle_provider, bullseye,
+                        std::forward<PolicyArgs>(policy_args)...)
+        {
+        }
+
+        VehicleIndexMap& map;
+        ChiefSource chief;
+        BullseyeFrame bullseye;
+        BasicRelativePredictor<ModelPolicy> predictor;
+        VehicleIndexMap::VehicleId chief_id{0};
+    };
+
+    void run_(double t0, const TimeGrid* grid, double horizon_sec, double cadence_sec) noexcept
+    {
+        fetch_chiefs_(t0);
+
+        // Largest formations first, so the last tasks claimed are the short ones (stable
+        // insertion sort: no allocation, ties keep formation order).
+        for (std::size_t f = 0; f < count_; ++f)
+        {
+            const std::size_t cost = formations_[f]->map.size();
+            std::size_t k = f;
+            for (; k > 0 && cost_[k - 1] < cost; --k)
+            {
+                order_[k] = order_[k - 1];
+                cost_[k] = cost_[k - 1];
+            }
+            order_[k] = f;
+            cost_[k] = cost;
+        }
+
+        auto task = [this, t0, grid, horizon_sec, cadence_sec](std::size_t k) noexcept
+        {
+            Formation& fm = *formations_[order_[k]];
+            if (grid != nullptr)
+            {
+                fm.predictor.step(t0, *grid);
+            }
+            else
+            {
+                fm.predictor.step(t0, horizon_sec, cadence_sec);
+            }
+        };
+        if (pool_ != nullptr)
+        {
+            pool_->run(count_, task);
+        }
+        else
+        {
+            for (std::size_t k = 0; k < count_; ++k)
+            {
+                task(k);
+            }
+        }
+    }
+
+    void fetch_chiefs_(double t0) noexcept
+    {
+        std::size_t n = 0;
+        for (std::size_t f = 0; f < count_; ++f)
+        {
+            if (formations_[f]->chief.batched)
+            {
+                chief_ids_[n] = formations_[f]->chief_id;
+                chief_rows_[n++] = f;
+            }
+        }
+        if (n == 0)
+        {
+            return;
+        }
+        (void)chief_source_->get_many(Span<const VehicleIndexMap::VehicleId>{chief_ids_.data(), n},
+                                      t0, Span<VehicleState>{chief_states_.data(), n},
+                                      Span<Vec3>{}, Span<Vec3>{});
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            const VehicleState& s = chief_states_[k];
+            ChiefSource& src = formations_[chief_rows_[k]]->chief;
+            src.state_t0 = t0;
+            src.state.time_tag = s.time_tag;
+            src.state.r_i = s.r_i;
+            src.state.v_i = s.v_i;
+            src.state.frame_id = s.frame_id;
+            src.state.frame = s.frame;
+            src.state.status = s.status;
+        }
+    }
+
+    WorkerPool* pool_{nullptr};
+    IVehicleStateProvider* chief_source_{nullptr};
+
+    std::array<std::unique_ptr<Formation>, kMaxFormations> formations_{};
+    std::size_t count_{0};
+
+    // Per-tick scratch (no allocation in step()).
+    std::array<std::size_t, kMaxFormations> order_{};
+    std::array<std::size_t, kMaxFormations> cost_{};
+    std::array<VehicleIndexMap::VehicleId, kMaxFormations> chief_ids_{};
+    std::array<std::size_t, kMaxFormations> chief_rows_{};
+    std::array<VehicleState, kMaxFormations> chief_states_{};
+};
+
+/** @brief Runtime-configured fleet (HCW, YA/TH, or injected model per formation). */
+using FleetRelativePredictor = BasicFleetPredictor<DynamicModelPolicy>;
+
+/** @brief Statically dispatched HCW / YA/TH fleets. */
+using HcwFleetPredictor = BasicFleetPredictor<HcwPolicy>;
+using YaFleetPredictor = BasicFleetPredictor<YaStmPolicy>;
+
+} // namespace bullseye_pred
@@ -0,0 +1,66 @@
+#include "core/frame_id_registry.hpp"
+
+#include <new>
+
+namespace bullseye_pred
+{
+
+FrameIdRegistry& FrameIdRegistry::global() noexcept
+{
+    static FrameIdRegistry registry;
+    return registry;
+}
+
+FrameHandle FrameIdRegistry::find_(const char* name, std::size_t n) const noexcept
+{
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        if (names_[k] == name)
+        {
+            return static_cast<FrameHandle>(k + 1u);
+        }
+    }
+    return FrameHandle::kNone;
+}
+
+FrameHandle FrameIdRegistry::intern(const char* name) noexcept
+{
+    if (name == nullptr || name[0] == '\0')
+    {
+        return FrameHandle::kNone;
+    }
+    const std::lock_guard<std::mutex> lock(mutex_);
+    const std::size_t n = size_.load(std::memory_order_relaxed);
+    const FrameHandle found = find_(name, n);
+    if (found != FrameHandle::kNone || n == kCapacity)
+    {
+        return found;
+    }
+    try
+    {
+        names_[n] = name;
+    }
+    catch (const std::bad_alloc&)
+    {
+        return FrameHandle::kNone;
+    }
+    size_.store(n + 1u, std::memory_order_release);
+    return static_cast<FrameHandle>(n + 1u);
+}
+
+FrameHandle FrameIdRegistry::find(const char* name) const noexcept
+{
+    if (name == nullptr || name[0] == '\0')
+    {
+        return FrameHandle::kNone;
+    }
+    return find_(name, size());
+}
+
+const char* FrameIdRegistry::name(FrameHandle h) const noexcept
+{
+    const auto k = static_cast<std::size_t>(h);
+    return (k == 0u || k > size()) ? nullptr : names_[k - 1u].c_str();
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,101 @@
+#pragma once
+
+/**
+ * @file frame_id_registry.hpp
+ * @brief Process-wide interning of inertial frame names into small integer handles.
+ *
+ * @details
+ * Providers identify the inertial frame of their states by name (ChiefState::frame_id,
+ * VehicleState::frame_id). Different providers configured from different strings hand out
+ * distinct pointers to equal names, so a pointer compare rejects valid vehicles and a strcmp
+ * per vehicle per tick is wasted work. Instead, each provider interns its name once at
+ * construction and stamps the handle into every state it returns; the predictor then checks
+ * frame identity with one integer compare (same_frame()).
+ *
+ * - intern() is configuration-time: it takes a lock and compares against the names registered
+ *   so far (at most kCapacity). name() and size() are lock-free.
+ * - Names are copied, so the caller's string need not outlive the registry.
+ * - Handles are stable for the life of the process but are not portable across processes:
+ *   shared-memory readers and checkpoints must re-intern by name.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <string>
+
+#include "core/types.hpp"
+
+namespace bullseye_pred
+{
+
+class FrameIdRegistry final
+{
+  public:
+    /// Distinct frame names held at most.
+    static constexpr std::size_t kCapacity = 64;
+
+    FrameIdRegistry() = default;
+    FrameIdRegistry(const FrameIdRegistry&) = delete;
+    FrameIdRegistry& operator=(const FrameIdRegistry&) = delete;
+
+    /** @brief The registry providers intern into. */
+    static FrameIdRegistry& global() noexcept;
+
+    /**
+     * @brief Handle of @p name, registering it on first use.
+     *
+     * @return FrameHandle::kNone for a null or empty name, or if the registry is full.
+     */
+    FrameHandle intern(const char* name) noexcept;
+
+    /** @brief Handle of an already interned @p name (kNone if unknown); does not register. */
+    [[nodiscard]] FrameHandle find(const char* name) const noexcept;
+
+    /** @brief Canonical name of @p h, or nullptr for kNone / unknown handles. */
+    [[nodiscard]] const char* name(FrameHandle h) const noexcept;
+
+    /** @brief Names registered. */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return size_.load(std::memory_order_acquire);
+    }
+
+  private:
+    [[nodiscard]] FrameHandle find_(const char* name, std::size_t n) const noexcept;
+
+    std::mutex mutex_{};
+
+    // Entry h - 1 is handle h; written once under mutex_, before size_ is released.
+    std::array<std::string, kCapacity> names_{};
+    std::atomic<std::size_t> size_{0};
+};
+
+/** @brief FrameIdRegistry::global().intern(@p name). */
+inline FrameHandle intern_frame_id(const char* name) noexcept
+{
+    return FrameIdRegistry::global().intern(name);
+}
+
+/**
+ * @brief Frame identity of two states.
+ *
+ * Constant time when both carry a handle; a state without one (a provider that does not
+ * intern) falls back to comparing the names.
+ */
+[[nodiscard]] inline bool same_frame(FrameHandle a,
+                                     const char* a_name,
+                                     FrameHandle b,
+                                     const char* b_name) noexcept
+{
+    if (a != FrameHandle::kNone && b != FrameHandle::kNone)
+    {
+        return a == b;
+    }
+    return a_name == b_name ||
+           (a_name != nullptr && b_name != nullptr && std::strcmp(a_name, b_name) == 0);
+}
+
+} // namespace bullseye_pred
@@ -1,101 +1,155 @@
 // core/frame_provider_cartesian.cpp
 #include "core/frame_provider_cartesian.hpp"
 
+#include "core/bullseye_frame_validator.hpp"
 #include "core/log_names.hpp"
 #include "core/logging.hpp"
-#include "logger/log_macros.hpp"
+#include "core/time_series_cursor.hpp"
+#include "core/log_macros.hpp"
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
 namespace bullseye_pred
 {
 
 CartesianBullseyeFrameProvider::CartesianBullseyeFrameProvider(const char* frame_source_id,
-                                                               Mode mode, double warn_period_sec)
-    : frame_source_id_(frame_source_id), mode_(mode), warn_period_sec_(warn_period_sec)
+                                                               Mode mode, double warn_period_sec,
+                                                               std::pmr::memory_resource* memory)
+    : frame_source_id_(frame_source_id),
+      mode_(mode),
+      warn_period_sec_(warn_period_sec),
+      samples_(memory),
+      ring_(memory)
 {
-    static auto log =
-        bullseye_pred::logging::get(bullseye_pred::logname::kCoreFrameProviderCartesian);
-
     current_.t = std::numeric_limits<double>::quiet_NaN();
 
-    LOG_INFOF(log, "init: mode=%s frame_source_id=%s warn_period_sec=%.17g",
-              (mode_ == Mode::kCurrent) ? "current" : "timeseries",
-              frame_source_id_ ? frame_source_id_ : "(null)", warn_period_sec_);
+    BULLSEYE_LOG_INFOF(
+        logname::kCoreFrameProviderCartesian,
+        "init: mode=%s frame_source_id=%s warn_period_sec=%.17g",
+        (mode_ == Mode::kCurrent)      ? "current"
+        : (mode_ == Mode::kTimeSeries) ? "timeseries"
+                                       : "streaming",
+        frame_source_id_ ? frame_source_id_ : "(null)", warn_period_sec_);
+}
+
+CartesianBullseyeFrameProvider::Sample
+CartesianBullseyeFrameProvider::make_sample_(double t, const Vec3& origin_i, const Mat3& C,
+                                             bool has_omega, const Vec3& omega_ric) noexcept
+{
+    return Sample{t, origin_i, C, has_omega, has_omega ? omega_ric : Vec3{},
+                  compute_adopted_pose_metrics(C)};
 }
 
 void CartesianBullseyeFrameProvider::set_current(double t, const Vec3& origin_i,
                                                  const Mat3& C_from_ric_to_inertial) noexcept
 {
-    static auto log =
-        bullseye_pred::logging::get(bullseye_pred::logname::kCoreFrameProviderCartesian);
-
     current_.t = t;
     current_.origin_i = origin_i;
     current_.C_from_ric_to_inertial = C_from_ric_to_inertial;
+    current_.pose = compute_adopted_pose_metrics(C_from_ric_to_inertial);
     // Do not implicitly set ω; keep prior setting as-is.
-    LOG_DEBUGF(log, "set_current: t=%.17g", t);
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderCartesian, "set_current: t=%.17g", t);
 }
 
 void CartesianBullseyeFrameProvider::set_current_omega_ric(const Vec3& omega_ric) noexcept
 {
-    static auto log =
-        bullseye_pred::logging::get(bullseye_pred::logname::kCoreFrameProviderCartesian);
-
     current_.has_omega = true;
     current_.omega_ric = omega_ric;
-    LOG_DEBUGF(log, "set_current_omega_ric");
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderCartesian, "set_current_omega_ric");
 }
 
 void CartesianBullseyeFrameProvider::clear_current_omega() noexcept
 {
-    static auto log =
-        bullseye_pred::logging::get(bullseye_pred::logname::kCoreFrameProviderCartesian);
-
     current_.has_omega = false;
     current_.omega_ric = Vec3{};
-    LOG_DEBUGF(log, "clear_current_omega");
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderCartesian, "clear_current_omega");
 }
 
 void CartesianBullseyeFrameProvider::add_sample(double t, const Vec3& origin_i,
                                                 const Mat3& C_from_ric_to_inertial)
 {
-    static auto log =
-        bullseye_pred::logging::get(bullseye_pred::logname::kCoreFrameProviderCartesian);
+    sorted_ = sorted_ && (samples_.empty() || samples_.back().t < t);
+    samples_.push_back(make_sample_(t, origin_i, C_from_ric_to_inertial, false, Vec3{}));
 
-    samples_.push_back(Sample{t, origin_i, C_from_ric_to_inertial, false, Vec3{}});
-    sorted_ = false;
-
-    LOG_DEBUGF(log, "add_sample: t=%.17g count=%zu", t, samples_.size());
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderCartesian, "add_sample: t=%.17g count=%zu", t,
+                        samples_.size());
 }
 
 void CartesianBullseyeFrameProvider::set_last_sample_omega_ric(const Vec3& omega_ric)
 {
-    static auto log =
-        bullseye_pred::logging::get(bullseye_pred::logname::kCoreFrameProviderCartesian);
-
     if (samples_.empty())
     {
         // Configuration mistake; treat as invalid input at use time, but log here to aid debugging.
-        LOG_WARNF(log, "set_last_sample_omega_ric: no samples present");
+        BULLSEYE_LOG_WARNF(logname::kCoreFrameProviderCartesian,
+                           "set_last_sample_omega_ric: no samples present");
         return;
     }
     samples_.back().has_omega = true;
     samples_.back().omega_ric = omega_ric;
-    LOG_DEBUGF(log, "set_last_sample_omega_ric");
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderCartesian, "set_last_sample_omega_ric");
 }
 
-void CartesianBullseyeFrameProvider::clear_samples() noexcept
+bool CartesianBullseyeFrameProvider::load_presorted(Span<const Sample> samples)
 {
-    static auto log =
-        bullseye_pred::logging::get(bullseye_pred::logname::kCoreFrameProviderCartesian);
+    if (!detail::strictly_increasing_times(samples.data, samples.size))
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreFrameProviderCartesian,
+                           "load_presorted: rejected, times not strictly increasing count=%zu",
+                           samples.size);
+        return false;
+    }
+    samples_.assign(samples.data, samples.data + samples.size);
+    for (Sample& s : samples_)
+    {
+        s.pose = compute_adopted_pose_metrics(s.C_from_ric_to_inertial);
+    }
+    sorted_ = true;
+    cursor_ = 0;
+
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderCartesian, "load_presorted: count=%zu",
+                        samples_.size());
+    return true;
+}
 
+void CartesianBullseyeFrameProvider::clear_samples() noexcept
+{
     samples_.clear();
     samples_.shrink_to_fit(); // configuration-time
     sorted_ = true;
+    cursor_ = 0;
 
-    LOG_DEBUGF(log, "clear_samples");
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderCartesian, "clear_samples");
+}
+
+bool CartesianBullseyeFrameProvider::configure_streaming(std::size_t capacity,
+                                                         double retention_sec)
+{
+    if (mode_ != Mode::kStreaming || !std::isfinite(retention_sec) || retention_sec < 0.0 ||
+        !ring_.init(capacity))
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreFrameProviderCartesian,
+                           "configure_streaming: rejected capacity=%zu retention_sec=%.17g",
+                           capacity, retention_sec);
+        return false;
+    }
+    retention_sec_ = retention_sec;
+    cursor_ = 0;
+
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderCartesian,
+                        "configure_streaming: capacity=%zu retention_sec=%.17g", capacity,
+                        retention_sec);
+    return true;
+}
+
+bool CartesianBullseyeFrameProvider::push_sample(double t, const Vec3& origin_i,
+                                                 const Mat3& C_from_ric_to_inertial,
+                                                 bool has_omega, const Vec3& omega_ric) noexcept
+{
+    // Producer thread: no logging here; rejections are counted by the ring. The pose metrics
+    // are computed here too, so get() does not.
+    return ring_.push(make_sample_(t, origin_i, C_from_ric_to_inertial, has_omega, omega_ric));
 }
 
 void CartesianBullseyeFrameProvider::ensure_sorted_() noexcept
@@ -107,6 +161,7 @@ void CartesianBullseyeFrameProvider::ensure_sorted_() noexcept
     std::sort(samples_.begin(), samples_.end(),
               [](const Sample& a, const Sample& b) { return a.t < b.t; });
     sorted_ = true;
+    cursor_ = 0;
 }
 
 bool CartesianBullseyeFrameProvider::should_warn_time_missing_(double t0) noexcept
@@ -130,9 +185,7 @@ void CartesianBullseyeFrameProvider::log_invalid_input_once_(const char* why) no
         return;
     }
     invalid_logged_ = true;
-    static auto log =
-        bullseye_pred::logging::get(bullseye_pred::logname::kCoreFrameProviderCartesian);
-    LOG_ERRORF(log, "invalid configuration: %s", why);
+    BULLSEYE_LOG_ERRORF(logname::kCoreFrameProviderCartesian, "invalid configuration: %s", why);
 }
 
 AdoptedRicFrame CartesianBullseyeFrameProvider::get(double t0) noexcept
@@ -168,10 +221,9 @@ AdoptedRicFrame CartesianBullseyeFrameProvider::get(double t0) noexcept
             out.status.code = ProviderCode::kTimeMissing;
             if (should_warn_time_missing_(t0))
             {
-                static auto log = bullseye_pred::logging::get(
-                    bullseye_pred::logname::kCoreFrameProviderCartesian);
-                LOG_WARNF(log, "get: time missing (mode=current) t0=%.17g current_t=%.17g", t0,
-                          current_.t);
+                BULLSEYE_LOG_WARNF(logname::kCoreFrameProviderCartesian,
+                                   "get: time missing (mode=current) t0=%.17g current_t=%.17g", t0,
+                                   current_.t);
             }
             return out;
         }
@@ -179,6 +231,7 @@ AdoptedRicFrame CartesianBullseyeFrameProvider::get(double t0) noexcept
         out.time_tag = current_.t;
         out.origin_i = current_.origin_i;
         out.C_from_ric_to_inertial = current_.C_from_ric_to_inertial;
+        out.pose_metrics = current_.pose;
 
         out.has_omega = current_.has_omega;
         if (out.has_omega)
@@ -191,24 +244,29 @@ AdoptedRicFrame CartesianBullseyeFrameProvider::get(double t0) noexcept
         return out;
     }
 
+    if (mode_ == Mode::kStreaming)
+    {
+        return get_streaming_(t0, out);
+    }
+
     // TimeSeries mode.
     ensure_sorted_();
 
-    auto it = std::lower_bound(samples_.begin(), samples_.end(), t0,
-                               [](const Sample& s, double t) { return s.t < t; });
+    const std::size_t idx = detail::cursor_lower_bound(samples_.data(), samples_.size(), t0,
+                                                       cursor_, lookup_fallbacks_);
+    const auto it = samples_.begin() + static_cast<std::ptrdiff_t>(idx);
 
     if (it == samples_.end() || !(it->t == t0))
     {
         out.status.code = ProviderCode::kTimeMissing;
         if (should_warn_time_missing_(t0))
         {
-            static auto log =
-                bullseye_pred::logging::get(bullseye_pred::logname::kCoreFrameProviderCartesian);
             const double found_t =
                 (it == samples_.end()) ? std::numeric_limits<double>::quiet_NaN() : it->t;
-            LOG_WARNF(log,
-                      "get: time missing (mode=timeseries) t0=%.17g next_sample_t=%.17g count=%zu",
-                      t0, found_t, samples_.size());
+            BULLSEYE_LOG_WARNF(
+                logname::kCoreFrameProviderCartesian,
+                "get: time missing (mode=timeseries) t0=%.17g next_sample_t=%.17g count=%zu", t0,
+                found_t, samples_.size());
         }
         return out;
     }
@@ -216,6 +274,7 @@ AdoptedRicFrame CartesianBullseyeFrameProvider::get(double t0) noexcept
     out.time_tag = it->t;
     out.origin_i = it->origin_i;
     out.C_from_ric_to_inertial = it->C_from_ric_to_inertial;
+    out.pose_metrics = it->pose;
 
     out.has_omega = it->has_omega;
     if (out.has_omega)
@@ -228,4 +287,50 @@ AdoptedRicFrame CartesianBullseyeFrameProvider::get(double t0) noexcept
     return out;
 }
 
+AdoptedRicFrame CartesianBullseyeFrameProvider::get_streaming_(double t0,
+                                                               AdoptedRicFrame out) noexcept
+{
+    // Take in everything pushed so far, then drop what fell out of the retention window.
+    ring_.refresh();
+    const std::size_t evicted = ring_.evict_before(t0 - retention_sec_);
+    cursor_ -= std::min(cursor_, evicted);
+
+    const auto window = ring_.view();
+    const std::size_t n = ring_.size();
+    const std::size_t idx =
+        detail::cursor_lower_bound(window, n, t0, cursor_, lookup_fallbacks_);
+
+    if (idx == n || !(window[idx].t == t0))
+    {
+        out.status.code = ProviderCode::kTimeMissing;
+        if (should_warn_time_missing_(t0))
+        {
+            const double found_t =
+                (idx == n) ? std::numeric_limits<double>::quiet_NaN() : window[idx].t;
+            BULLSEYE_LOG_WARNF(
+                logname::kCoreFrameProviderCartesian,
+                "get: time missing (mode=streaming) t0=%.17g next_sample_t=%.17g "
+                "count=%zu dropped=%llu",
+                t0, found_t, n, static_cast<unsigned long long>(ring_.dropped()));
+        }
+        return out;
+    }
+
+    const Sample& s = window[idx];
+    out.time_tag = s.t;
+    out.origin_i = s.origin_i;
+    out.C_from_ric_to_inertial = s.C_from_ric_to_inertial;
+    out.pose_metrics = s.pose;
+
+    out.has_omega = s.has_omega;
+    if (out.has_omega)
+    {
+        out.omega_ric = s.omega_ric;
+        out.omega_coords = OmegaCoords::kOmegaRIC;
+    }
+
+    out.status.code = ProviderCode::kOk;
+    return out;
+}
+
 } // namespace bullseye_pred
@@ -8,6 +8,12 @@
  * Policy
  * - **FR-14a exact-time only**: no interpolation, no nearest-time.
  * - Provider is a pass-through for pose/ω declarations; correctness is enforced by the validator.
+ * - The DCM-only validator checks (orthonormality, handedness) are computed once when a sample
+ *   is ingested and returned as AdoptedRicFrame::pose_metrics, so replaying a series does not
+ *   redo them on every tick; only the t0-dependent checks remain per tick.
+ * - Mode::kStreaming keeps a bounded window: configure_streaming() preallocates a ring, a
+ *   producer thread appends with push_sample(), and get(t0) evicts samples older than
+ *   t0 - retention_sec (constant memory, no reallocation after configuration).
  *
  * Logging (sim-logger)
  * - INFO on init (frame_source_id, warn_period_sec)
@@ -19,10 +25,13 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory_resource>
 #include <vector>
 
 #include "core/bullseye_frame_provider.hpp"
+#include "core/sample_ring.hpp"
 #include "core/types.hpp"
+#include "models/relative_model.hpp"
 
 namespace bullseye_pred
 {
@@ -33,16 +42,32 @@ class CartesianBullseyeFrameProvider final : public IBullseyeFrameProvider
     enum class Mode : std::uint8_t
     {
         kCurrent = 0,
-        kTimeSeries
+        kTimeSeries,
+        kStreaming
+    };
+
+    struct Sample final
+    {
+        double t{0.0};
+        Vec3 origin_i{};
+        Mat3 C_from_ric_to_inertial{Mat3::identity()};
+        bool has_omega{false};
+        Vec3 omega_ric{};
+
+        // Filled by the provider at ingest; any caller-supplied value is overwritten.
+        AdoptedPoseMetrics pose{};
     };
 
     /**
      * @param frame_source_id Optional provenance string (must outlive this provider).
-     * @param mode Current vs TimeSeries.
+     * @param mode Current, TimeSeries, or Streaming.
      * @param warn_period_sec Rate-limit period for repeated kTimeMissing warnings (based on t0).
+     * @param memory Source of the sample storage (series and streaming window); must outlive
+     *        this provider. See memory_resource.hpp.
      */
-    explicit CartesianBullseyeFrameProvider(const char* frame_source_id, Mode mode = Mode::kCurrent,
-                                            double warn_period_sec = 1.0);
+    explicit CartesianBullseyeFrameProvider(
+        const char* frame_source_id, Mode mode = Mode::kCurrent, double warn_period_sec = 1.0,
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource());
 
     /**
      * Set the current adopted frame sample (Mode::kCurrent).
@@ -72,24 +97,61 @@ class CartesianBullseyeFrameProvider final : public IBullseyeFrameProvider
     /** Optionally set ω_RIC for the most recently added sample (Mode::kTimeSeries). */
     void set_last_sample_omega_ric(const Vec3& omega_ric);
 
+    /**
+     * Replace all samples with an already sorted series (Mode::kTimeSeries); no sort is done.
+     *
+     * @return false (samples unchanged) unless times are finite and strictly increasing.
+     */
+    [[nodiscard]] bool load_presorted(Span<const Sample> samples);
+
     void clear_samples() noexcept;
+
+    /**
+     * Preallocate the streaming window (Mode::kStreaming; configuration-time, drops samples).
+     *
+     * @param capacity Samples retained at most.
+     * @param retention_sec Samples with t < t0 - retention_sec are evicted by get(t0).
+     * @return false if not in Mode::kStreaming, capacity is 0, retention_sec is negative or not
+     *         finite, or allocation fails.
+     */
+    [[nodiscard]] bool configure_streaming(std::size_t capacity, double retention_sec = 0.0);
+
+    /**
+     * Append a sample from the (single) producer thread (Mode::kStreaming); ω is declared as
+     * ω_RIC when @p has_omega.
+     *
+     * @return false (sample dropped, see streaming_dropped()) if the window is full, streaming
+     *         is not configured, or t is not finite or not after the previous pushed sample.
+     */
+    [[nodiscard]] bool push_sample(double t, const Vec3& origin_i,
+                                   const Mat3& C_from_ric_to_inertial, bool has_omega = false,
+                                   const Vec3& omega_ric = Vec3{}) noexcept;
+
+    /** Samples rejected by push_sample() (any thread). */
+    [[nodiscard]] std::uint64_t streaming_dropped() const noexcept
+    {
+        return ring_.dropped();
+    }
+
+    /** Stored samples; in Mode::kStreaming, the window as of the last get(). */
     [[nodiscard]] std::size_t sample_count() const noexcept
     {
-        return samples_.size();
+        return (mode_ == Mode::kStreaming) ? ring_.size() : samples_.size();
+    }
+
+    /** Time-series lookups that fell back to a binary search (see time_series_cursor.hpp). */
+    [[nodiscard]] std::uint64_t lookup_fallbacks() const noexcept
+    {
+        return lookup_fallbacks_;
     }
 
     [[nodiscard]] AdoptedRicFrame get(double t0) noexcept override;
 
   private:
-    struct Sample final
-    {
-        double t{0.0};
-        Vec3 origin_i{};
-        Mat3 C_from_ric_to_inertial{Mat3::identity()};
-        bool has_omega{false};
-        Vec3 omega_ric{};
-    };
+    [[nodiscard]] static Sample make_sample_(double t, const Vec3& origin_i, const Mat3& C,
+                                             bool has_omega, const Vec3& omega_ric) noexcept;
     void ensure_sorted_() noexcept;
+    [[nodiscard]] AdoptedRicFrame get_streaming_(double t0, AdoptedRicFrame out) noexcept;
     bool should_warn_time_missing_(double t0) noexcept;
     void log_invalid_input_once_(const char* why) noexcept;
 
@@ -101,8 +163,15 @@ class CartesianBullseyeFrameProvider final : public IBullseyeFrameProvider
     bool invalid_logged_{false};
 
     Sample current_{};
-    std::vector<Sample> samples_{};
+    std::pmr::vector<Sample> samples_;
     bool sorted_{true};
+
+    std::size_t cursor_{0};
+    std::uint64_t lookup_fallbacks_{0};
+
+    // Streaming window (Mode::kStreaming); cursor_ indexes its retained samples.
+    detail::SampleRing<Sample> ring_;
+    double retention_sec_{0.0};
 };
 
 } // namespace bullseye_pred
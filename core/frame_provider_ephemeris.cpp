@@ -0,0 +1,121 @@
+// core/frame_provider_ephemeris.cpp
+#include "core/frame_provider_ephemeris.hpp"
+
+#include "core/log_names.hpp"
+#include "core/logging.hpp"
+#include "core/time_series_cursor.hpp"
+#include "core/log_macros.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace bullseye_pred
+{
+
+EphemerisBullseyeFrameProvider::EphemerisBullseyeFrameProvider(const char* frame_source_id,
+                                                               double warn_period_sec)
+    : frame_source_id_(frame_source_id), warn_period_sec_(warn_period_sec)
+{
+}
+
+EphemerisCode EphemerisBullseyeFrameProvider::open(const char* path, bool verify_times) noexcept
+{
+    cursor_ = 0;
+    const EphemerisCode code = file_.open(path, EphemerisKind::kFrame, verify_times);
+    if (code != EphemerisCode::kOk)
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreFrameProviderEphemeris, "open: failed path=%s code=%u",
+                           path ? path : "(null)", static_cast<unsigned>(code));
+        return code;
+    }
+    BULLSEYE_LOG_INFOF(logname::kCoreFrameProviderEphemeris,
+                       "open: path=%s frame_source_id=%s samples=%zu", path,
+                       frame_source_id_ ? frame_source_id_ : "(null)", file_.record_count());
+    return code;
+}
+
+bool EphemerisBullseyeFrameProvider::should_warn_time_missing_(double t0) noexcept
+{
+    if (warn_period_sec_ <= 0.0)
+    {
+        return true;
+    }
+    if ((t0 - last_warn_t0_) >= warn_period_sec_)
+    {
+        last_warn_t0_ = t0;
+        return true;
+    }
+    return false;
+}
+
+void EphemerisBullseyeFrameProvider::log_invalid_input_once_(const char* why) noexcept
+{
+    if (invalid_logged_)
+    {
+        return;
+    }
+    invalid_logged_ = true;
+    BULLSEYE_LOG_ERRORF(logname::kCoreFrameProviderEphemeris, "invalid configuration: %s", why);
+}
+
+AdoptedRicFrame EphemerisBullseyeFrameProvider::get(double t0) noexcept
+{
+    AdoptedRicFrame out{};
+    out.frame_source_id = frame_source_id_;
+
+    if (frame_source_id_ == nullptr)
+    {
+        out.status.code = ProviderCode::kInvalidInput;
+        log_invalid_input_once_("frame_source_id is null");
+        return out;
+    }
+    if (!std::isfinite(t0))
+    {
+        out.status.code = ProviderCode::kInvalidInput;
+        log_invalid_input_once_("t0 is not finite");
+        return out;
+    }
+    if (!file_.is_open())
+    {
+        out.status.code = ProviderCode::kNotAvailable;
+        log_invalid_input_once_("no ephemeris file open");
+        return out;
+    }
+
+    out.frame_kind = FrameKind::kBullseyeRIC;
+    out.axis_order = AxisOrder::kRIC;
+    out.omega_coords = OmegaCoords::kUnspecified;
+
+    const Span<const FrameEphemerisRecord> r = file_.records<FrameEphemerisRecord>(0);
+    const std::size_t i = detail::cursor_lower_bound(r.data, r.size, t0, cursor_,
+                                                     lookup_fallbacks_);
+    if (i == r.size || !(r[i].t == t0))
+    {
+        out.status.code = ProviderCode::kTimeMissing;
+        if (should_warn_time_missing_(t0))
+        {
+            const double found_t =
+                (i == r.size) ? std::numeric_limits<double>::quiet_NaN() : r[i].t;
+            BULLSEYE_LOG_WARNF(logname::kCoreFrameProviderEphemeris,
+                               "get: time missing t0=%.17g next_sample_t=%.17g count=%zu", t0,
+                               found_t, r.size);
+        }
+        return out;
+    }
+
+    out.time_tag = r[i].t;
+    out.origin_i = r[i].origin_i;
+    out.C_from_ric_to_inertial = r[i].C_from_ric_to_inertial;
+
+    out.has_omega = r[i].has_omega != 0u;
+    if (out.has_omega)
+    {
+        out.omega_ric = r[i].omega_ric;
+        out.omega_coords = OmegaCoords::kOmegaRIC;
+    }
+
+    out.status.code = ProviderCode::kOk;
+    return out;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,71 @@
+// core/frame_provider_ephemeris.hpp
+#pragma once
+
+/**
+ * @file frame_provider_ephemeris.hpp
+ * @brief Adopted Bullseye-compatible RIC frame provider backed by a memory-mapped ephemeris file.
+ *
+ * Policy
+ * - **FR-14a exact-time only**, as CartesianBullseyeFrameProvider in Mode::kTimeSeries; the
+ *   samples live in a frame ephemeris file (ephemeris_file.hpp) mapped by open().
+ * - Records with has_omega != 0 declare ω as ω_RIC; correctness is enforced by the validator.
+ *
+ * Logging (sim-logger)
+ * - INFO on open; WARN on a failed open
+ * - get(t0): no log on success
+ *   - ERROR on invalid configuration or no open file (logged once)
+ *   - WARN on missing time, rate-limited by tick time
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/bullseye_frame_provider.hpp"
+#include "core/ephemeris_file.hpp"
+#include "core/types.hpp"
+
+namespace bullseye_pred
+{
+
+class EphemerisBullseyeFrameProvider final : public IBullseyeFrameProvider
+{
+  public:
+    /**
+     * @param frame_source_id Provenance string (must outlive this provider).
+     * @param warn_period_sec Rate-limit period for repeated kTimeMissing warnings (based on t0).
+     */
+    explicit EphemerisBullseyeFrameProvider(const char* frame_source_id,
+                                            double warn_period_sec = 1.0);
+
+    /**
+     * @brief Map a frame ephemeris file, replacing any file opened before.
+     *
+     * @param verify_times See EphemerisFile::open().
+     */
+    [[nodiscard]] EphemerisCode open(const char* path, bool verify_times = false) noexcept;
+
+    [[nodiscard]] std::size_t sample_count() const noexcept { return file_.record_count(); }
+
+    /** Lookups that fell back to a binary search (see time_series_cursor.hpp). */
+    [[nodiscard]] std::uint64_t lookup_fallbacks() const noexcept
+    {
+        return lookup_fallbacks_;
+    }
+
+    [[nodiscard]] AdoptedRicFrame get(double t0) noexcept override;
+
+  private:
+    bool should_warn_time_missing_(double t0) noexcept;
+    void log_invalid_input_once_(const char* why) noexcept;
+
+    const char* frame_source_id_{nullptr};
+    double warn_period_sec_{1.0};
+    double last_warn_t0_{-1.0e300};
+    bool invalid_logged_{false};
+
+    EphemerisFile file_{};
+    std::size_t cursor_{0};
+    std::uint64_t lookup_fallbacks_{0};
+};
+
+} // namespace bullseye_pred
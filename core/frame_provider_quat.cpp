@@ -0,0 +1,209 @@
+// core/frame_provider_quat.cpp
+#include "core/frame_provider_quat.hpp"
+
+#include "core/bullseye_frame_validator.hpp"
+#include "core/log_names.hpp"
+#include "core/logging.hpp"
+#include "core/time_series_cursor.hpp"
+#include "core/log_macros.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace bullseye_pred
+{
+
+QuaternionBullseyeFrameProvider::QuaternionBullseyeFrameProvider(const char* frame_source_id,
+                                                                 double warn_period_sec)
+    : frame_source_id_(frame_source_id), warn_period_sec_(warn_period_sec)
+{
+    BULLSEYE_LOG_INFOF(logname::kCoreFrameProviderQuat,
+                       "init: frame_source_id=%s warn_period_sec=%.17g",
+                       frame_source_id_ ? frame_source_id_ : "(null)", warn_period_sec_);
+}
+
+bool QuaternionBullseyeFrameProvider::prepare_(Sample& s) noexcept
+{
+    math::Quat& q = s.q_from_ric_to_inertial;
+    if (!math::quat_finite(q) ||
+        !(std::fabs(math::quat_dot(q, q) - 1.0) <= kUnitNormTolerance) ||
+        !math::quat_normalize(q))
+    {
+        return false;
+    }
+    // Metrics of exactly the DCM get() will materialize.
+    s.pose = compute_adopted_pose_metrics(math::dcm_from_quat(q));
+    if (!s.has_omega)
+    {
+        s.omega_ric = Vec3{};
+    }
+    return true;
+}
+
+bool QuaternionBullseyeFrameProvider::add_sample(double t, const Vec3& origin_i,
+                                                 const math::Quat& q_from_ric_to_inertial)
+{
+    Sample s{t, origin_i, q_from_ric_to_inertial, false, Vec3{}, AdoptedPoseMetrics{}};
+    if (!prepare_(s))
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreFrameProviderQuat,
+                           "add_sample: rejected t=%.17g (quaternion not finite or not unit)", t);
+        return false;
+    }
+    sorted_ = sorted_ && (samples_.empty() || samples_.back().t < t);
+    samples_.push_back(s);
+
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderQuat, "add_sample: t=%.17g count=%zu", t,
+                        samples_.size());
+    return true;
+}
+
+void QuaternionBullseyeFrameProvider::set_last_sample_omega_ric(const Vec3& omega_ric)
+{
+    if (samples_.empty())
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreFrameProviderQuat,
+                           "set_last_sample_omega_ric: no samples present");
+        return;
+    }
+    samples_.back().has_omega = true;
+    samples_.back().omega_ric = omega_ric;
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderQuat, "set_last_sample_omega_ric");
+}
+
+bool QuaternionBullseyeFrameProvider::load_presorted(Span<const Sample> samples)
+{
+    if (!detail::strictly_increasing_times(samples.data, samples.size))
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreFrameProviderQuat,
+                           "load_presorted: rejected, times not strictly increasing count=%zu",
+                           samples.size);
+        return false;
+    }
+    std::vector<Sample> loaded(samples.data, samples.data + samples.size);
+    for (std::size_t i = 0; i < loaded.size(); ++i)
+    {
+        if (!prepare_(loaded[i]))
+        {
+            BULLSEYE_LOG_WARNF(
+                logname::kCoreFrameProviderQuat,
+                "load_presorted: rejected, quaternion not unit at index=%zu t=%.17g", i,
+                loaded[i].t);
+            return false;
+        }
+    }
+    samples_.swap(loaded);
+    sorted_ = true;
+    cursor_ = 0;
+
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderQuat, "load_presorted: count=%zu",
+                        samples_.size());
+    return true;
+}
+
+void QuaternionBullseyeFrameProvider::clear_samples() noexcept
+{
+    samples_.clear();
+    samples_.shrink_to_fit(); // configuration-time
+    sorted_ = true;
+    cursor_ = 0;
+
+    BULLSEYE_LOG_DEBUGF(logname::kCoreFrameProviderQuat, "clear_samples");
+}
+
+void QuaternionBullseyeFrameProvider::ensure_sorted_() noexcept
+{
+    if (sorted_)
+    {
+        return;
+    }
+    std::sort(samples_.begin(), samples_.end(),
+              [](const Sample& a, const Sample& b) { return a.t < b.t; });
+    sorted_ = true;
+    cursor_ = 0;
+}
+
+bool QuaternionBullseyeFrameProvider::should_warn_time_missing_(double t0) noexcept
+{
+    if (warn_period_sec_ <= 0.0)
+    {
+        return true;
+    }
+    if ((t0 - last_warn_t0_) >= warn_period_sec_)
+    {
+        last_warn_t0_ = t0;
+        return true;
+    }
+    return false;
+}
+
+void QuaternionBullseyeFrameProvider::log_invalid_input_once_(const char* why) noexcept
+{
+    if (invalid_logged_)
+    {
+        return;
+    }
+    invalid_logged_ = true;
+    BULLSEYE_LOG_ERRORF(logname::kCoreFrameProviderQuat, "invalid configuration: %s", why);
+}
+
+AdoptedRicFrame QuaternionBullseyeFrameProvider::get(double t0) noexcept
+{
+    AdoptedRicFrame out{};
+    out.frame_source_id = frame_source_id_;
+
+    if (frame_source_id_ == nullptr)
+    {
+        out.status.code = ProviderCode::kInvalidInput;
+        log_invalid_input_once_("frame_source_id is null");
+        return out;
+    }
+    if (!std::isfinite(t0))
+    {
+        out.status.code = ProviderCode::kInvalidInput;
+        log_invalid_input_once_("t0 is not finite");
+        return out;
+    }
+
+    out.frame_kind = FrameKind::kBullseyeRIC;
+    out.axis_order = AxisOrder::kRIC;
+    out.omega_coords = OmegaCoords::kUnspecified;
+
+    ensure_sorted_();
+
+    const std::size_t idx = detail::cursor_lower_bound(samples_.data(), samples_.size(), t0,
+                                                       cursor_, lookup_fallbacks_);
+    if (idx == samples_.size() || !(samples_[idx].t == t0))
+    { // exact compare by contract
+        out.status.code = ProviderCode::kTimeMissing;
+        if (should_warn_time_missing_(t0))
+        {
+            const double found_t = (idx == samples_.size())
+                                       ? std::numeric_limits<double>::quiet_NaN()
+                                       : samples_[idx].t;
+            BULLSEYE_LOG_WARNF(logname::kCoreFrameProviderQuat,
+                               "get: time missing t0=%.17g next_sample_t=%.17g count=%zu", t0,
+                               found_t, samples_.size());
+        }
+        return out;
+    }
+
+    const Sample& s = samples_[idx];
+    out.time_tag = s.t;
+    out.origin_i = s.origin_i;
+    out.C_from_ric_to_inertial = math::dcm_from_quat(s.q_from_ric_to_inertial);
+    out.pose_metrics = s.pose;
+
+    out.has_omega = s.has_omega;
+    if (out.has_omega)
+    {
+        out.omega_ric = s.omega_ric;
+        out.omega_coords = OmegaCoords::kOmegaRIC;
+    }
+
+    out.status.code = ProviderCode::kOk;
+    return out;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,113 @@
+// core/frame_provider_quat.hpp
+#pragma once
+
+/**
+ * @file frame_provider_quat.hpp
+ * @brief Adopted Bullseye-compatible RIC frame provider with quaternion sample storage.
+ *
+ * Policy
+ * - **FR-14a exact-time only**, as CartesianBullseyeFrameProvider in Mode::kTimeSeries.
+ * - Orientation is stored as a unit quaternion q_from_ric_to_inertial (math/quaternion.hpp):
+ *   4 doubles per sample instead of a 9-double DCM. The DCM is materialized only in get(),
+ *   for the frame that is actually served; the DCM-only validator metrics are computed once
+ *   at ingest (AdoptedRicFrame::pose_metrics).
+ * - Quaternions are normalized at ingest; ones whose |q|^2 differs from 1 by more than
+ *   kUnitNormTolerance are rejected rather than silently rescaled.
+ *
+ * Logging (sim-logger)
+ * - INFO on init
+ * - DEBUG on add_sample/load_presorted/clear_samples; WARN on a rejected sample
+ * - get(t0): no log on success
+ *   - ERROR on invalid configuration (logged once)
+ *   - WARN on missing time, rate-limited by tick time
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/bullseye_frame_provider.hpp"
+#include "core/math/quaternion.hpp"
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+class QuaternionBullseyeFrameProvider final : public IBullseyeFrameProvider
+{
+  public:
+    /// Largest accepted | |q|^2 - 1 | of an ingested quaternion.
+    static constexpr double kUnitNormTolerance = 1.0e-9;
+
+    struct Sample final
+    {
+        double t{0.0};
+        Vec3 origin_i{};
+        math::Quat q_from_ric_to_inertial{};
+        bool has_omega{false};
+        Vec3 omega_ric{};
+
+        // Filled by the provider at ingest; any caller-supplied value is overwritten.
+        AdoptedPoseMetrics pose{};
+    };
+
+    /**
+     * @param frame_source_id Provenance string (must outlive this provider).
+     * @param warn_period_sec Rate-limit period for repeated kTimeMissing warnings (based on t0).
+     */
+    explicit QuaternionBullseyeFrameProvider(const char* frame_source_id,
+                                             double warn_period_sec = 1.0);
+
+    /**
+     * Add a time-tagged sample; samples may be added in any order (sorted deterministically).
+     *
+     * @return false (sample not added) if q is not finite or not unit within
+     *         kUnitNormTolerance.
+     */
+    [[nodiscard]] bool add_sample(double t, const Vec3& origin_i,
+                                  const math::Quat& q_from_ric_to_inertial);
+
+    /** Optionally set ω_RIC for the most recently added sample. */
+    void set_last_sample_omega_ric(const Vec3& omega_ric);
+
+    /**
+     * Replace all samples with an already sorted series; no sort is done.
+     *
+     * @return false (samples unchanged) unless times are finite and strictly increasing and
+     *         every quaternion passes the add_sample() check.
+     */
+    [[nodiscard]] bool load_presorted(Span<const Sample> samples);
+
+    void clear_samples() noexcept;
+
+    [[nodiscard]] std::size_t sample_count() const noexcept { return samples_.size(); }
+
+    /** Lookups that fell back to a binary search (see time_series_cursor.hpp). */
+    [[nodiscard]] std::uint64_t lookup_fallbacks() const noexcept
+    {
+        return lookup_fallbacks_;
+    }
+
+    [[nodiscard]] AdoptedRicFrame get(double t0) noexcept override;
+
+  private:
+    // Normalize s.q_from_ric_to_inertial and fill s.pose; false if q is rejected.
+    [[nodiscard]] static bool prepare_(Sample& s) noexcept;
+    void ensure_sorted_() noexcept;
+    bool should_warn_time_missing_(double t0) noexcept;
+    void log_invalid_input_once_(const char* why) noexcept;
+
+    const char* frame_source_id_{nullptr};
+    double warn_period_sec_{1.0};
+    double last_warn_t0_{-1.0e300};
+    bool invalid_logged_{false};
+
+    std::vector<Sample> samples_{};
+    bool sorted_{true};
+
+    std::size_t cursor_{0};
+    std::uint64_t lookup_fallbacks_{0};
+};
+
+} // namespace bullseye_pred
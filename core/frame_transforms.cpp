@@ -2,6 +2,10 @@
 
 #include "core/frame_transforms.hpp"
 
+#include <algorithm>
+
+#include "core/math/vec3a.hpp"
+
 namespace bullseye_pred
 {
 
@@ -18,6 +22,33 @@ RelState inertial_to_ric_relative(const Vec3& veh_r_i, const Vec3& veh_v_i,
     return RelState{r_ric, v_ric};
 }
 
+void inertial_to_ric_relative_batch(Span<const Vec3> veh_r_i, Span<const Vec3> veh_v_i,
+                                    const Vec3& chief_r_i, const Vec3& chief_v_i,
+                                    const Mat3& C_from_inertial_to_ric, const Vec3& omega_ric,
+                                    Span<RelStateRic> out) noexcept
+{
+    const std::size_t n = std::min({veh_r_i.size, veh_v_i.size, out.size});
+
+    // Hoisted once per batch. The DCM is held as padded columns so each product is three
+    // lane-wise multiply-adds; every lane keeps the operand order of mul()/cross(), so results
+    // match inertial_to_ric_relative() exactly.
+    const math::Mat3a C(C_from_inertial_to_ric);
+    const math::Vec3a w(omega_ric);
+    const math::Vec3a cr(chief_r_i);
+    const math::Vec3a cv(chief_v_i);
+
+    const Vec3* const r = veh_r_i.data;
+    const Vec3* const v = veh_v_i.data;
+    RelStateRic* const o = out.data;
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        const math::Vec3a r_ric = math::mul(C, math::Vec3a(r[k]) - cr);
+        const math::Vec3a v_ric = math::mul(C, math::Vec3a(v[k]) - cv) - math::cross(w, r_ric);
+        o[k].r_ric = r_ric.vec3();
+        o[k].v_ric = v_ric.vec3();
+    }
+}
+
 RelState ric_to_inertial_relative(const Vec3& rel_r_ric, const Vec3& rel_v_ric,
                                  const Vec3& chief_r_i, const Vec3& chief_v_i,
                                  const Mat3& C_from_ric_to_inertial,
@@ -31,4 +62,21 @@ RelState ric_to_inertial_relative(const Vec3& rel_r_ric, const Vec3& rel_v_ric,
     return RelState{r_i, v_i};
 }
 
+void ric_to_inertial_positions_series(Span<const Vec3> rel_r_ric, Span<const Vec3> chief_r_i,
+                                      Span<const Mat3> C_from_ric_to_inertial,
+                                      Span<Vec3> out_r_i) noexcept
+{
+    const std::size_t n =
+        std::min({rel_r_ric.size, chief_r_i.size, C_from_ric_to_inertial.size, out_r_i.size});
+
+    const Vec3* const rel = rel_r_ric.data;
+    const Vec3* const cr = chief_r_i.data;
+    const Mat3* const C = C_from_ric_to_inertial.data;
+    Vec3* const o = out_r_i.data;
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        o[k] = cr[k] + mul(C[k], rel[k]);
+    }
+}
+
 } // namespace bullseye_pred
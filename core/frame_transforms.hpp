@@ -12,6 +12,7 @@
  */
 
 #include "core/types.hpp"
+#include "models/relative_model.hpp"
 
 namespace bullseye_pred
 {
@@ -27,9 +28,34 @@ struct RelState final
                                                const Mat3& C_from_inertial_to_ric,
                                                const Vec3& omega_ric) noexcept;
 
+/**
+ * @brief inertial_to_ric_relative() for many deputies against one chief/frame snapshot.
+ *
+ * Deputy positions and velocities come as separate planes (as filled by
+ * IVehicleStateProvider::get_many()); out[k] is the RIC initial condition of deputy k. The
+ * DCM (as padded math::Mat3a columns), ω and chief state are loaded once, and the loop body is
+ * branch-free lane-wise arithmetic. Each out[k] is bit-identical to the scalar transform.
+ * Writes min(veh_r_i.size, veh_v_i.size, out.size) entries.
+ */
+void inertial_to_ric_relative_batch(Span<const Vec3> veh_r_i, Span<const Vec3> veh_v_i,
+                                    const Vec3& chief_r_i, const Vec3& chief_v_i,
+                                    const Mat3& C_from_inertial_to_ric, const Vec3& omega_ric,
+                                    Span<RelStateRic> out) noexcept;
+
 [[nodiscard]] RelState ric_to_inertial_relative(const Vec3& rel_r_ric, const Vec3& rel_v_ric,
                                                const Vec3& chief_r_i, const Vec3& chief_v_i,
                                                const Mat3& C_from_ric_to_inertial,
                                                const Vec3& omega_ric) noexcept;
 
+/**
+ * @brief Inertial positions of one deputy along a predicted RIC trajectory.
+ *
+ * out_r_i[k] = chief_r_i[k] + C_from_ric_to_inertial[k] * rel_r_ric[k], i.e. the position half
+ * of ric_to_inertial_relative() with a per-sample chief state and frame; each entry is
+ * bit-identical to it. Writes the minimum of the four sizes.
+ */
+void ric_to_inertial_positions_series(Span<const Vec3> rel_r_ric, Span<const Vec3> chief_r_i,
+                                      Span<const Mat3> C_from_ric_to_inertial,
+                                      Span<Vec3> out_r_i) noexcept;
+
 } // namespace bullseye_pred
@@ -0,0 +1,288 @@
+#pragma once
+/**
+ * @file log_macros.hpp
+ * @brief Bullseye log macros: compile-time level elision and deferred formatting.
+ *
+ * @details
+ * BULLSEYE_LOG_DEBUGF / _INFOF / _WARNF / _ERRORF(component, fmt, ...) take a logname::
+ * component and printf-style arguments. Each call site resolves its component logger once,
+ * on its first execution, so functions no longer hold a logger guard of their own.
+ *
+ * Compile-time elision: a call site below BULLSEYE_LOG_COMPILE_LEVEL (CMake cache variable
+ * of the same name: TRACE, DEBUG, INFO, WARN, ERROR or OFF; default TRACE) compiles to nothing.
+ * Its arguments appear only in an unevaluated operand, and the logger is never resolved.
+ *
+ * Deferred mode (logging::start_deferred()): an enabled call site checks the logger level,
+ * copies the format pointer and raw arguments into a preallocated ring slot and returns; a
+ * background thread formats the records and writes them to the sinks. The calling thread
+ * never runs snprintf or sink I/O. Without deferred mode the record is formatted and written
+ * on the calling thread. Either way the arguments are evaluated exactly once.
+ *
+ * Deferred arguments must be arithmetic, enums, pointers or C strings. C strings are copied
+ * into the slot (truncated to the slot's free space), so they may be temporaries; the format
+ * string must be a literal. A record that does not fit a full ring is dropped and counted
+ * (logging::deferred_dropped()).
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "core/log_names.hpp"
+#include "core/logging.hpp"
+#include "logger/level.hpp"
+#include "logger/logger.hpp"
+
+#define BULLSEYE_LOG_LEVEL_TRACE 0
+#define BULLSEYE_LOG_LEVEL_DEBUG 1
+#define BULLSEYE_LOG_LEVEL_INFO 2
+#define BULLSEYE_LOG_LEVEL_WARN 3
+#define BULLSEYE_LOG_LEVEL_ERROR 4
+#define BULLSEYE_LOG_LEVEL_OFF 6
+
+#ifndef BULLSEYE_LOG_COMPILE_LEVEL
+#define BULLSEYE_LOG_COMPILE_LEVEL BULLSEYE_LOG_LEVEL_TRACE
+#endif
+
+namespace bullseye_pred::logging
+{
+
+/// Argument bytes per deferred record (C strings included, with their terminators).
+inline constexpr std::size_t kDeferredArgBytes = 192;
+
+/// Longest formatted line; longer records are truncated.
+inline constexpr std::size_t kLogLineBytes = 1024;
+
+namespace detail
+{
+
+/// Formats a deferred record's arguments with its format string into out.
+using DeferredFormatFn = void (*)(const unsigned char* args, const char* fmt, char* out,
+                                  std::size_t out_size) noexcept;
+
+/// True while deferred mode is running (relaxed load on every enabled call site).
+extern std::atomic<bool> g_deferred_active;
+
+/** @brief One deferred record (a ring slot). */
+struct DeferredSlot final
+{
+    std::atomic<std::uint64_t> seq{0};
+    std::uint64_t pos{0};
+    sim_logger::Logger* logger{nullptr};
+    DeferredFormatFn format{nullptr};
+    const char* fmt{nullptr};
+    sim_logger::Level level{sim_logger::Level::Info};
+    alignas(8) unsigned char args[kDeferredArgBytes]{};
+};
+
+/**
+ * @brief Claim a ring slot for one record; nullptr if the ring is full (record dropped).
+ *
+ * Fill the slot's args, then commit_deferred() it.
+ */
+DeferredSlot* claim_deferred() noexcept;
+
+/** @brief Publish a slot returned by claim_deferred() to the formatting thread. */
+void commit_deferred(DeferredSlot* slot) noexcept;
+
+template <typename T>
+inline constexpr bool is_c_string_v =
+    std::is_same_v<T, const char*> || std::is_same_v<T, char*>;
+
+template <typename T>
+inline constexpr bool is_deferrable_v = std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+                                        std::is_pointer_v<T> || std::is_null_pointer_v<T>;
+
+// Fixed-size values are stored with memcpy; C strings inline with their terminator.
+template <typename T>
+std::size_t encode_arg(unsigned char* p, std::size_t room, const T& value) noexcept
+{
+    if constexpr (is_c_string_v<T>)
+    {
+        const char* s = (value != nullptr) ? value : "(null)";
+        const std::size_t n = std::min(std::strlen(s), room - 1);
+        std::memcpy(p, s, n);
+        p[n] = '\0';
+        return n + 1;
+    }
+    else
+    {
+        std::memcpy(p, &value, sizeof(T));
+        return sizeof(T);
+    }
+}
+
+template <typename T>
+T decode_arg(const unsigned char*& p) noexcept
+{
+    if constexpr (is_c_string_v<T>)
+    {
+        const char* s = reinterpret_cast<const char*>(p);
+        p += std::strlen(s) + 1;
+        return const_cast<T>(s);
+    }
+    else
+    {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return value;
+    }
+}
+
+// snprintf's %s does not accept nullptr.
+template <typename T>
+auto printable_arg(T value) noexcept
+{
+    if constexpr (is_c_string_v<T>)
+    {
+        return (value != nullptr) ? static_cast<const char*>(value) : "(null)";
+    }
+    else
+    {
+        return value;
+    }
+}
+
+template <typename... A>
+void format_line(char* out, std::size_t out_size, const char* fmt, const A&... args) noexcept
+{
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wformat-nonliteral"
+#pragma GCC diagnostic ignored "-Wformat-security"
+#endif
+    std::snprintf(out, out_size, fmt, printable_arg(args)...);
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+}
+
+template <typename... A>
+void format_deferred(const unsigned char* args, const char* fmt, char* out,
+                     std::size_t out_size) noexcept
+{
+    const unsigned char* p = args;
+    // Braced initialization decodes the arguments left to right.
+    const std::tuple<A...> values{decode_arg<A>(p)...};
+    (void)p; // no arguments
+    std::apply([&](const A&... a) { format_line(out, out_size, fmt, a...); }, values);
+}
+
+/**
+ * @brief Log one record: enqueue it in deferred mode, else format and write it now.
+ *
+ * Arguments are evaluated once, by the call site.
+ */
+template <typename... A>
+void logf(const std::shared_ptr<sim_logger::Logger>& logger, sim_logger::Level level,
+                const char* fmt, const A&... args) noexcept
+{
+    constexpr std::size_t kStrings = (std::size_t{is_c_string_v<std::decay_t<A>>} + ... + 0);
+    constexpr std::size_t kFixed =
+        ((is_c_string_v<std::decay_t<A>> ? 0 : sizeof(std::decay_t<A>)) + ... + 0);
+    static_assert((is_deferrable_v<std::decay_t<A>> && ...),
+                  "deferred log arguments must be arithmetic, enums, pointers or C strings");
+    static_assert(kFixed + kStrings <= kDeferredArgBytes,
+                  "deferred log arguments exceed kDeferredArgBytes");
+    if (!logger || !logger->should_log(level))
+    {
+        return;
+    }
+    if (!g_deferred_active.load(std::memory_order_relaxed))
+    {
+        char line[kLogLineBytes];
+        format_line(line, sizeof(line), fmt, static_cast<std::decay_t<A>>(args)...);
+        logger->log(level, line);
+        return;
+    }
+    DeferredSlot* const slot = claim_deferred();
+    if (slot == nullptr)
+    {
+        return;
+    }
+    slot->logger = logger.get();
+    slot->format = &format_deferred<std::decay_t<A>...>;
+    slot->fmt = fmt;
+    slot->level = level;
+
+    // Fixed-size arguments are reserved up front and each string keeps at least its
+    // terminator, so a long early string only truncates itself and later strings.
+    std::size_t used = 0;
+    std::size_t string_room = kDeferredArgBytes - kFixed;
+    std::size_t strings_left = kStrings;
+    auto put = [&](const auto& value) noexcept
+    {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (is_c_string_v<T>)
+        {
+            const std::size_t room = string_room - (strings_left - 1);
+            const std::size_t n = encode_arg<T>(slot->args + used, room, value);
+            string_room -= n;
+            --strings_left;
+            used += n;
+        }
+        else
+        {
+            used += encode_arg<T>(slot->args + used, sizeof(T), value);
+        }
+    };
+    (put(static_cast<std::decay_t<A>>(args)), ...);
+    (void)put; // no arguments
+    commit_deferred(slot);
+}
+
+/// Elided call sites name their arguments only in this unevaluated call (never defined).
+template <typename... A>
+int elided_logf(const A&... args) noexcept;
+
+} // namespace detail
+
+} // namespace bullseye_pred::logging
+
+// One static logger per call site, resolved on the site's first execution.
+#define BULLSEYE_LOG_IMPL_(level, component, ...)                                              \
+    do                                                                                         \
+    {                                                                                          \
+        static const auto bullseye_site_log_ = ::bullseye_pred::logging::get(component);     \
+        ::bullseye_pred::logging::detail::logf(bullseye_site_log_, level, __VA_ARGS__);        \
+    } while (0)
+
+// Compiled out: nothing is evaluated, but the arguments still count as used.
+#define BULLSEYE_LOG_ELIDED_(component, ...)                                                   \
+    ((void)sizeof(::bullseye_pred::logging::detail::elided_logf(component, __VA_ARGS__)))
+
+#if BULLSEYE_LOG_COMPILE_LEVEL <= BULLSEYE_LOG_LEVEL_DEBUG
+#define BULLSEYE_LOG_DEBUGF(component, ...)                                                    \
+    BULLSEYE_LOG_IMPL_(::sim_logger::Level::Debug, component, __VA_ARGS__)
+#else
+#define BULLSEYE_LOG_DEBUGF(component, ...) BULLSEYE_LOG_ELIDED_(component, __VA_ARGS__)
+#endif
+
+#if BULLSEYE_LOG_COMPILE_LEVEL <= BULLSEYE_LOG_LEVEL_INFO
+#define BULLSEYE_LOG_INFOF(component, ...)                                                     \
+    BULLSEYE_LOG_IMPL_(::sim_logger::Level::Info, component, __VA_ARGS__)
+#else
+#define BULLSEYE_LOG_INFOF(component, ...) BULLSEYE_LOG_ELIDED_(component, __VA_ARGS__)
+#endif
+
+#if BULLSEYE_LOG_COMPILE_LEVEL <= BULLSEYE_LOG_LEVEL_WARN
+#define BULLSEYE_LOG_WARNF(component, ...)                                                     \
+    BULLSEYE_LOG_IMPL_(::sim_logger::Level::Warn, component, __VA_ARGS__)
+#else
+#define BULLSEYE_LOG_WARNF(component, ...) BULLSEYE_LOG_ELIDED_(component, __VA_ARGS__)
+#endif
+
+#if BULLSEYE_LOG_COMPILE_LEVEL <= BULLSEYE_LOG_LEVEL_ERROR
+#define BULLSEYE_LOG_ERRORF(component, ...)                                                    \
+    BULLSEYE_LOG_IMPL_(::sim_logger::Level::Error, component, __VA_ARGS__)
+#else
+#define BULLSEYE_LOG_ERRORF(component, ...) BULLSEYE_LOG_ELIDED_(component, __VA_ARGS__)
+#endif
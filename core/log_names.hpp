@@ -15,5 +15,14 @@ inline constexpr const char* kCoreDummyPredictor = "core.dummy_predictor";
 inline constexpr const char* kCoreProviderCartesian = "core.provider_cartesian";
 inline constexpr const char* kCoreProviderTwoBody = "core.provider_twobody";
 inline constexpr const char* kCoreFrameProviderCartesian = "core.frame_provider_cartesian";
+inline constexpr const char* kCoreProviderEphemeris = "core.provider_ephemeris";
+inline constexpr const char* kCoreFrameProviderEphemeris = "core.frame_provider_ephemeris";
+inline constexpr const char* kCoreFrameProviderQuat = "core.frame_provider_quat";
+inline constexpr const char* kCoreWorkerPool = "core.worker_pool";
+inline constexpr const char* kCoreAsyncPredictor = "core.async_predictor";
+
+// Integration
+inline constexpr const char* kIntegrationProviderJeod = "integration.provider_jeod";
+inline constexpr const char* kIntegrationFrameProviderJeod = "integration.frame_provider_jeod";
 
 } // namespace bullseye_pred::logname
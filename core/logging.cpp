@@ -1,5 +1,7 @@
 #include "core/logging.hpp"
+#include "core/log_macros.hpp"
 #include "core/log_names.hpp"
+#include "core/wait_notify.hpp"
 
 #include "logger/console_sink.hpp"
 #include "logger/file_sink.hpp"
@@ -7,8 +9,13 @@
 #include "logger/logger_registry.hpp"
 #include "logger/pattern_formatter.hpp"
 
+#include <atomic>
+#include <initializer_list>
 #include <memory>
+#include <mutex>
+#include <new>
 #include <string>
+#include <thread>
 
 namespace bullseye_pred::logging
 {
@@ -49,4 +56,219 @@ std::shared_ptr<sim_logger::Logger> get(std::string_view component)
     return LoggerRegistry::instance().get_logger(name);
 }
 
+void preload()
+{
+    namespace n = bullseye_pred::logname;
+    for (const char* component :
+         {n::kCoreTimeGrid, n::kCoreVehicleIndexMap, n::kCorePublisher, n::kCorePredictionBuf,
+          n::kCoreDummyPredictor, n::kCoreProviderCartesian, n::kCoreProviderTwoBody,
+          n::kCoreFrameProviderCartesian, n::kCoreProviderEphemeris,
+          n::kCoreFrameProviderEphemeris, n::kCoreFrameProviderQuat, n::kCoreWorkerPool,
+          n::kCoreAsyncPredictor})
+    {
+        (void)get(component);
+    }
+}
+
+// ------------------------------
+// Deferred mode
+// ------------------------------
+
+namespace detail
+{
+
+std::atomic<bool> g_deferred_active{false};
+
+} // namespace detail
+
+namespace
+{
+
+// Bounded multi-producer ring (per-slot sequence numbers), drained by one thread.
+struct DeferredRing final
+{
+    explicit DeferredRing(std::size_t n) : capacity(n), slots(new detail::DeferredSlot[n])
+    {
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    const std::size_t capacity;
+    const std::unique_ptr<detail::DeferredSlot[]> slots;
+    alignas(64) std::atomic<std::uint64_t> enqueue_pos{0};
+    alignas(64) std::atomic<std::uint64_t> dequeue_pos{0}; // written by the drain only
+    std::atomic<std::uint64_t> dropped{0};
+};
+
+struct DeferredState final
+{
+    std::mutex control; // start / stop / flush
+    DeferredRing* ring{nullptr}; // never freed: call sites may race a stop
+    std::thread thread{};
+    DeferredConfig cfg{};
+    std::atomic<bool> running{false};
+    std::atomic<std::uint32_t> wake{0};
+};
+
+DeferredState& deferred_state()
+{
+    static DeferredState* const s = new DeferredState();
+    return *s;
+}
+
+// Format and write every committed record; returns the number written.
+std::size_t drain_deferred(DeferredState& st, char* line)
+{
+    DeferredRing& ring = *st.ring;
+    std::size_t written = 0;
+    for (;;)
+    {
+        const std::uint64_t pos = ring.dequeue_pos.load(std::memory_order_relaxed);
+        detail::DeferredSlot& slot = ring.slots[pos & (ring.capacity - 1)];
+        if (slot.seq.load(std::memory_order_acquire) != pos + 1)
+        {
+            return written; // empty, or the next record is not committed yet
+        }
+        slot.format(slot.args, slot.fmt, line, kLogLineBytes);
+        if (st.cfg.writer != nullptr)
+        {
+            st.cfg.writer(st.cfg.writer_ctx, slot.level, *slot.logger, line);
+        }
+        else
+        {
+            slot.logger->log(slot.level, line);
+        }
+        slot.seq.store(pos + ring.capacity, std::memory_order_release);
+        ring.dequeue_pos.store(pos + 1, std::memory_order_release);
+        ++written;
+    }
+}
+
+void deferred_main(DeferredState& st)
+{
+    std::unique_ptr<char[]> line(new char[kLogLineBytes]);
+    while (st.running.load(std::memory_order_acquire))
+    {
+        const std::uint32_t seen = st.wake.load(std::memory_order_acquire);
+        if (drain_deferred(st, line.get()) == 0)
+        {
+            bullseye_pred::detail::wait_word(st.wake, seen, st.cfg.drain_interval_sec);
+        }
+    }
+    (void)drain_deferred(st, line.get());
+}
+
+} // namespace
+
+namespace detail
+{
+
+DeferredSlot* claim_deferred() noexcept
+{
+    DeferredRing& ring = *deferred_state().ring; // set before g_deferred_active
+    std::uint64_t pos = ring.enqueue_pos.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        DeferredSlot& slot = ring.slots[pos & (ring.capacity - 1)];
+        const std::uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq == pos)
+        {
+            if (ring.enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                slot.pos = pos;
+                return &slot;
+            }
+        }
+        else if (seq < pos)
+        {
+            ring.dropped.fetch_add(1, std::memory_order_relaxed); // full
+            return nullptr;
+        }
+        else
+        {
+            pos = ring.enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void commit_deferred(DeferredSlot* slot) noexcept
+{
+    slot->seq.store(slot->pos + 1, std::memory_order_release);
+}
+
+} // namespace detail
+
+bool start_deferred(const DeferredConfig& cfg)
+{
+    DeferredState& st = deferred_state();
+    const std::lock_guard<std::mutex> lock(st.control);
+    const std::size_t n = cfg.capacity;
+    if (st.running.load(std::memory_order_relaxed) || n == 0 || (n & (n - 1)) != 0 ||
+        (st.ring != nullptr && st.ring->capacity != n))
+    {
+        return false;
+    }
+    if (st.ring == nullptr)
+    {
+        st.ring = new (std::nothrow) DeferredRing(n);
+        if (st.ring == nullptr)
+        {
+            return false;
+        }
+    }
+    st.cfg = cfg;
+    st.running.store(true, std::memory_order_release);
+    try
+    {
+        st.thread = std::thread([&st]() { deferred_main(st); });
+    }
+    catch (...)
+    {
+        st.running.store(false, std::memory_order_relaxed);
+        return false;
+    }
+    detail::g_deferred_active.store(true, std::memory_order_release);
+    return true;
+}
+
+void stop_deferred()
+{
+    DeferredState& st = deferred_state();
+    const std::lock_guard<std::mutex> lock(st.control);
+    if (!st.running.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    detail::g_deferred_active.store(false, std::memory_order_release);
+    st.running.store(false, std::memory_order_release);
+    st.wake.fetch_add(1, std::memory_order_release);
+    bullseye_pred::detail::wake_word_all(st.wake);
+    st.thread.join();
+}
+
+void flush_deferred()
+{
+    DeferredState& st = deferred_state();
+    const std::lock_guard<std::mutex> lock(st.control);
+    if (!st.running.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    const std::uint64_t target = st.ring->enqueue_pos.load(std::memory_order_acquire);
+    while (st.ring->dequeue_pos.load(std::memory_order_acquire) < target)
+    {
+        st.wake.fetch_add(1, std::memory_order_release);
+        bullseye_pred::detail::wake_word_all(st.wake);
+        std::this_thread::yield();
+    }
+}
+
+std::uint64_t deferred_dropped() noexcept
+{
+    const DeferredRing* ring = deferred_state().ring;
+    return (ring != nullptr) ? ring->dropped.load(std::memory_order_relaxed) : 0;
+}
+
 } // namespace bullseye_pred::logging
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -54,4 +56,60 @@ void init(const Config& cfg);
  */
 std::shared_ptr<sim_logger::Logger> get(std::string_view component);
 
+/**
+ * @brief Create every component logger named in log_names.hpp.
+ *
+ * @details
+ * A BULLSEYE_LOG_*F call site resolves its logger on its first execution; after preload()
+ * that is a registry lookup instead of a creation. Safe to call repeatedly.
+ */
+void preload();
+
+/**
+ * @brief Writes one formatted deferred record (formatting thread only).
+ *
+ * Replaces the default, which hands the line to the record's logger sinks.
+ */
+using DeferredWriter = void (*)(void* ctx, sim_logger::Level level, sim_logger::Logger& logger,
+                                const char* line) noexcept;
+
+/**
+ * @brief Deferred-mode configuration (see core/log_macros.hpp).
+ */
+struct DeferredConfig
+{
+    /// Ring slots (power of two). The ring is allocated by the first start_deferred() and kept
+    /// for the life of the process; later starts must request the same capacity.
+    std::size_t capacity{4096};
+
+    /// Longest sleep of the formatting thread between drains [s].
+    double drain_interval_sec{0.005};
+
+    /// Optional writer for formatted records (nullptr: the record's logger).
+    DeferredWriter writer{nullptr};
+    void* writer_ctx{nullptr};
+};
+
+/**
+ * @brief Start deferred mode: BULLSEYE_LOG_*F call sites enqueue, one thread formats.
+ *
+ * @return false if already running, the capacity is not a power of two or differs from the
+ *         existing ring, or the ring or thread could not be created.
+ */
+bool start_deferred(const DeferredConfig& cfg);
+
+/**
+ * @brief Write every record enqueued so far, then stop the formatting thread.
+ *
+ * Call sites racing the stop may still enqueue; those records are written by the next
+ * start_deferred() (or never).
+ */
+void stop_deferred();
+
+/** @brief Block until the records enqueued before this call are written (deferred mode). */
+void flush_deferred();
+
+/** @brief Records dropped because the ring was full, since process start. */
+std::uint64_t deferred_dropped() noexcept;
+
 } // namespace bullseye_pred::logging
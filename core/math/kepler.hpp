@@ -0,0 +1,109 @@
+// core/math/kepler.hpp
+#pragma once
+
+#include <cmath>
+
+namespace bullseye_pred::math {
+
+/**
+ * @brief Solve Kepler's equation M = E - e sin(E) for an elliptic orbit (0 <= e < 1).
+ *
+ * Deterministic policy (GCR-6):
+ * - Fixed Newton iteration count (no early exit).
+ * - Deterministic starter (Danby): E0 = M + 0.85 e sign(sin M), robust for all 0 <= e < 1.
+ * - A vanishing derivative leaves E unchanged for that iteration.
+ *
+ * @param M Mean anomaly [rad]. Any finite value; no range reduction is applied.
+ * @param e Eccentricity, expected in [0, 1).
+ * @param iters Fixed Newton iteration count.
+ * @return Eccentric anomaly E [rad].
+ */
+[[nodiscard]] inline double solve_kepler_elliptic(double M, double e, int iters) noexcept
+{
+    const double sM = std::sin(M);
+    double E = M + 0.85 * e * ((sM > 0.0) ? 1.0 : ((sM < 0.0) ? -1.0 : 0.0));
+
+    for (int iter = 0; iter < iters; ++iter)
+    {
+        const double F = E - e * std::sin(E) - M;
+        const double dF = 1.0 - e * std::cos(E);
+        if (!(dF != 0.0) || !std::isfinite(dF) || !std::isfinite(F))
+        {
+            continue;
+        }
+        E = E - F / dF;
+    }
+    return E;
+}
+
+/** @brief Steps of solve_kepler_elliptic_quartic() below this rotate sin E / cos E [rad]. */
+inline constexpr double kRotateStep = 1e-2;
+
+/**
+ * @brief Eccentric anomaly with its sine and cosine (see solve_kepler_elliptic_quartic()).
+ */
+struct EllipticAnomaly
+{
+    double E{0.0};
+    double sin_E{0.0};
+    double cos_E{1.0};
+};
+
+/**
+ * @brief Solve Kepler's equation on a reduced mean anomaly with Danby's quartic update.
+ *
+ * Deterministic policy (GCR-6):
+ * - Danby's starter, as solve_kepler_elliptic() (sign(sin M) == sign(M) on [-pi, pi]).
+ * - Fixed iteration count of the quartic-convergent update (Danby 1987). Three iterations
+ *   reach a few ulp of M for e <= 0.95, four for e <= 0.99.
+ * - sin E and cos E are carried along: a step below kRotateStep rotates them by its
+ *   Taylor-series sine and cosine (truncation below 1e-18), a larger one recomputes them. In
+ *   practice only the starter and the first step call libm.
+ * - A vanishing denominator leaves E unchanged for that iteration.
+ *
+ * @param M Mean anomaly [rad], reduced to [-pi, pi] (e.g. std::remainder(M, 2 pi)).
+ * @param e Eccentricity, expected in [0, 1).
+ * @param iters Fixed iteration count.
+ */
+[[nodiscard]] inline EllipticAnomaly solve_kepler_elliptic_quartic(double M, double e,
+                                                                   int iters) noexcept
+{
+    EllipticAnomaly a{};
+    a.E = M + 0.85 * e * ((M > 0.0) ? 1.0 : ((M < 0.0) ? -1.0 : 0.0));
+    a.sin_E = std::sin(a.E);
+    a.cos_E = std::cos(a.E);
+
+    for (int iter = 0; iter < iters; ++iter)
+    {
+        const double f0 = a.E - e * a.sin_E - M;
+        const double f1 = 1.0 - e * a.cos_E;
+        const double f2 = e * a.sin_E;
+        const double f3 = e * a.cos_E;
+        const double d1 = -f0 / f1;
+        const double d2 = -f0 / (f1 + 0.5 * d1 * f2);
+        const double den = f1 + 0.5 * d2 * f2 + d2 * d2 * f3 * (1.0 / 6.0);
+        const double d3 = -f0 / den;
+        if (!(den != 0.0) || !std::isfinite(d3))
+        {
+            continue;
+        }
+        a.E += d3;
+        if (std::fabs(d3) < kRotateStep)
+        {
+            const double dd = d3 * d3;
+            const double sd = d3 * (1.0 - dd / 6.0 * (1.0 - dd / 20.0 * (1.0 - dd / 42.0)));
+            const double cd = 1.0 - dd / 2.0 * (1.0 - dd / 12.0 * (1.0 - dd / 30.0));
+            const double s = a.sin_E * cd + a.cos_E * sd;
+            a.cos_E = a.cos_E * cd - a.sin_E * sd;
+            a.sin_E = s;
+        }
+        else
+        {
+            a.sin_E = std::sin(a.E);
+            a.cos_E = std::cos(a.E);
+        }
+    }
+    return a;
+}
+
+} // namespace bullseye_pred::math
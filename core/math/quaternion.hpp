@@ -0,0 +1,182 @@
+// core/math/quaternion.hpp
+#pragma once
+
+#include <cmath>
+
+#include "core/types.hpp"
+
+namespace bullseye_pred::math {
+
+/**
+ * @brief Unit quaternion, scalar first (Hamilton convention).
+ *
+ * Frames store q_from_ric_to_inertial, the rotation whose DCM is C_from_ric_to_inertial
+ * (x_i = C * x_ric, see dcm_from_quat()). Four doubles instead of nine, and blending
+ * (slerp/nlerp) stays on the rotation manifold instead of drifting off it as a DCM blend does.
+ */
+struct Quat final
+{
+    double w{1.0};
+    double x{0.0};
+    double y{0.0};
+    double z{0.0};
+};
+
+[[nodiscard]] inline double quat_dot(const Quat& a, const Quat& b) noexcept
+{
+    return a.w * b.w + a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+[[nodiscard]] inline bool quat_finite(const Quat& q) noexcept
+{
+    return std::isfinite(q.w) && std::isfinite(q.x) && std::isfinite(q.y) && std::isfinite(q.z);
+}
+
+/**
+ * @brief Normalize @p q in place.
+ * @return false (q unchanged) if q is not finite or has zero norm.
+ */
+[[nodiscard]] inline bool quat_normalize(Quat& q) noexcept
+{
+    const double n = std::sqrt(quat_dot(q, q));
+    if (!quat_finite(q) || !(n > 0.0) || !std::isfinite(n))
+    {
+        return false;
+    }
+    const double inv = 1.0 / n;
+    q = Quat{q.w * inv, q.x * inv, q.y * inv, q.z * inv};
+    return true;
+}
+
+/**
+ * @brief Materialize the DCM of unit quaternion @p q (x_i = C * x_ric for q_from_ric_to_inertial).
+ */
+[[nodiscard]] inline Mat3 dcm_from_quat(const Quat& q) noexcept
+{
+    const double ww = q.w * q.w, xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const double xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const double wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    Mat3 C;
+    C(0, 0) = ww + xx - yy - zz;
+    C(0, 1) = 2.0 * (xy - wz);
+    C(0, 2) = 2.0 * (xz + wy);
+    C(1, 0) = 2.0 * (xy + wz);
+    C(1, 1) = ww - xx + yy - zz;
+    C(1, 2) = 2.0 * (yz - wx);
+    C(2, 0) = 2.0 * (xz - wy);
+    C(2, 1) = 2.0 * (yz + wx);
+    C(2, 2) = ww - xx - yy + zz;
+    return C;
+}
+
+/**
+ * @brief Unit quaternion of a proper rotation matrix (Shepperd's method).
+ *
+ * The largest of trace(C) and the diagonal picks the branch, so the square root is always of a
+ * value >= 1. The result is normalized and has w >= 0. @p C is assumed orthonormal with
+ * det(C) = +1; validate it first (validate_adopted_bullseye_ric_frame()).
+ */
+[[nodiscard]] inline Quat quat_from_dcm(const Mat3& C) noexcept
+{
+    const double tr = C(0, 0) + C(1, 1) + C(2, 2);
+    Quat q{};
+    if (tr >= C(0, 0) && tr >= C(1, 1) && tr >= C(2, 2))
+    {
+        const double s = 2.0 * std::sqrt(1.0 + tr); // 4w
+        q = Quat{0.25 * s, (C(2, 1) - C(1, 2)) / s, (C(0, 2) - C(2, 0)) / s,
+                 (C(1, 0) - C(0, 1)) / s};
+    }
+    else if (C(0, 0) >= C(1, 1) && C(0, 0) >= C(2, 2))
+    {
+        const double s = 2.0 * std::sqrt(1.0 + C(0, 0) - C(1, 1) - C(2, 2)); // 4x
+        q = Quat{(C(2, 1) - C(1, 2)) / s, 0.25 * s, (C(0, 1) + C(1, 0)) / s,
+                 (C(0, 2) + C(2, 0)) / s};
+    }
+    else if (C(1, 1) >= C(2, 2))
+    {
+        const double s = 2.0 * std::sqrt(1.0 - C(0, 0) + C(1, 1) - C(2, 2)); // 4y
+        q = Quat{(C(0, 2) - C(2, 0)) / s, (C(0, 1) + C(1, 0)) / s, 0.25 * s,
+                 (C(1, 2) + C(2, 1)) / s};
+    }
+    else
+    {
+        const double s = 2.0 * std::sqrt(1.0 - C(0, 0) - C(1, 1) + C(2, 2)); // 4z
+        q = Quat{(C(1, 0) - C(0, 1)) / s, (C(0, 2) + C(2, 0)) / s, (C(1, 2) + C(2, 1)) / s,
+                 0.25 * s};
+    }
+    if (q.w < 0.0)
+    {
+        q = Quat{-q.w, -q.x, -q.y, -q.z};
+    }
+    (void)quat_normalize(q);
+    return q;
+}
+
+/**
+ * @brief Rotate @p v by unit quaternion @p q without materializing the DCM
+ *        (equals mul(dcm_from_quat(q), v) up to rounding).
+ */
+[[nodiscard]] inline Vec3 quat_rotate(const Quat& q, const Vec3& v) noexcept
+{
+    // v' = v + 2 u x (u x v + w v), u = (x, y, z)
+    const Vec3 u{q.x, q.y, q.z};
+    const Vec3 t = cross(u, v) + q.w * v;
+    return v + 2.0 * cross(u, t);
+}
+
+/**
+ * @brief Rotation angle [rad] between unit quaternions @p a and @p b, in [0, pi].
+ *
+ * Uses atan2 of the relative rotation conj(a)*b, which stays accurate for small angles (an
+ * acos of the dot product does not).
+ */
+[[nodiscard]] inline double quat_angle_between(const Quat& a, const Quat& b) noexcept
+{
+    const double w = quat_dot(a, b);
+    const Vec3 av{a.x, a.y, a.z};
+    const Vec3 bv{b.x, b.y, b.z};
+    const Vec3 v = a.w * bv - b.w * av - cross(av, bv);
+    return 2.0 * std::atan2(norm(v), std::fabs(w));
+}
+
+/**
+ * @brief Normalized linear blend from @p a (s = 0) to @p b (s = 1) along the shorter arc.
+ *
+ * Cheaper than quat_slerp(); the angle is not uniform in s, which is acceptable for short
+ * blends.
+ */
+[[nodiscard]] inline Quat quat_nlerp(const Quat& a, const Quat& b, double s) noexcept
+{
+    const double sb = (quat_dot(a, b) < 0.0) ? -s : s;
+    const double sa = 1.0 - s;
+    Quat q{sa * a.w + sb * b.w, sa * a.x + sb * b.x, sa * a.y + sb * b.y, sa * a.z + sb * b.z};
+    (void)quat_normalize(q);
+    return q;
+}
+
+/// Above this |a.b| quat_slerp() falls back to quat_nlerp() (angle below ~2 deg).
+inline constexpr double kSlerpNlerpDot = 0.9995;
+
+/**
+ * @brief Constant-angular-rate blend from @p a (s = 0) to @p b (s = 1) along the shorter arc.
+ */
+[[nodiscard]] inline Quat quat_slerp(const Quat& a, const Quat& b, double s) noexcept
+{
+    double d = quat_dot(a, b);
+    const double sign = (d < 0.0) ? -1.0 : 1.0;
+    d *= sign;
+    if (d > kSlerpNlerpDot)
+    {
+        return quat_nlerp(a, b, s);
+    }
+    const double theta = std::acos(d);
+    const double inv_sin = 1.0 / std::sin(theta);
+    const double sa = std::sin((1.0 - s) * theta) * inv_sin;
+    const double sb = sign * std::sin(s * theta) * inv_sin;
+    Quat q{sa * a.w + sb * b.w, sa * a.x + sb * b.x, sa * a.y + sb * b.y, sa * a.z + sb * b.z};
+    (void)quat_normalize(q);
+    return q;
+}
+
+} // namespace bullseye_pred::math
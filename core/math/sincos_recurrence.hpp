@@ -0,0 +1,87 @@
+// core/math/sincos_recurrence.hpp
+#pragma once
+
+#include <cfloat>
+#include <cmath>
+#include <cstddef>
+
+namespace bullseye_pred::math {
+
+/**
+ * @brief Absolute error bound on sin/cos produced by UniformSinCos.
+ *
+ * Each rotation step adds at most ~4 eps (rounding of the two products and sum, plus the
+ * rounded step rotation). The anchor itself is within ~1 eps of the true value.
+ *
+ * @param reanchor_interval Steps between libm re-anchors (>= 1).
+ * @return Bound on |sin_k - sin(theta_k)| and |cos_k - cos(theta_k)|.
+ */
+[[nodiscard]] inline constexpr double sincos_recurrence_error_bound(
+    std::size_t reanchor_interval) noexcept
+{
+    return (4.0 * static_cast<double>(reanchor_interval) + 1.0) * DBL_EPSILON;
+}
+
+/**
+ * @brief Streaming sin/cos over uniformly spaced angles theta_k = theta_0 + k * dtheta.
+ *
+ * Uses the rotation recurrence
+ *   s_{k+1} = s_k cos(dtheta) + c_k sin(dtheta)
+ *   c_{k+1} = c_k cos(dtheta) - s_k sin(dtheta)
+ * and re-anchors with libm every reanchor_interval steps (k % interval == 0) to bound drift
+ * (see sincos_recurrence_error_bound()).
+ *
+ * Deterministic: results depend only on (dtheta, interval, the anchor angles) and on k.
+ */
+class UniformSinCos final
+{
+  public:
+    /**
+     * @param dtheta Angle step [rad].
+     * @param reanchor_interval Steps between libm anchors; 0 or 1 means libm for every step.
+     */
+    UniformSinCos(double dtheta, std::size_t reanchor_interval) noexcept
+        : sd_(std::sin(dtheta)),
+          cd_(std::cos(dtheta)),
+          interval_(reanchor_interval > 0 ? reanchor_interval : 1)
+    {
+    }
+
+    /**
+     * @brief Advance to step k (called for k = 0, 1, 2, ... in order).
+     *
+     * @param theta_k Exact angle of step k, used only when k is an anchor.
+     */
+    void next(double theta_k) noexcept
+    {
+        if (k_ % interval_ == 0)
+        {
+            s_ = std::sin(theta_k);
+            c_ = std::cos(theta_k);
+        }
+        else
+        {
+            const double s = s_ * cd_ + c_ * sd_;
+            const double c = c_ * cd_ - s_ * sd_;
+            s_ = s;
+            c_ = c;
+        }
+        ++k_;
+    }
+
+    /** @brief sin(theta_k) of the last step. */
+    [[nodiscard]] double sin() const noexcept { return s_; }
+
+    /** @brief cos(theta_k) of the last step. */
+    [[nodiscard]] double cos() const noexcept { return c_; }
+
+  private:
+    double sd_{0.0};
+    double cd_{1.0};
+    std::size_t interval_{1};
+    std::size_t k_{0};
+    double s_{0.0};
+    double c_{1.0};
+};
+
+} // namespace bullseye_pred::math
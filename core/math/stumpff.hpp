@@ -70,4 +70,35 @@ inline constexpr double kStumpffSeriesThreshold = 1e-8;
     return (shs - s) / (s * s * s);
 }
 
+/**
+ * @brief Stumpff C and S evaluated together.
+ *
+ * Bit-identical to stumpff_C(z) / stumpff_S(z); the sqrt and the sin/cos (or sinh/cosh) of
+ * sqrt(|z|) are computed once for both.
+ */
+struct StumpffCS final {
+    double C;
+    double S;
+};
+
+[[nodiscard]] inline StumpffCS stumpff_CS(double z) noexcept
+{
+    const double az = std::fabs(z);
+
+    if (az < kStumpffSeriesThreshold) {
+        const double z2 = z * z;
+        return StumpffCS{0.5 - z / 24.0 + z2 / 720.0 - (z2 * z) / 40320.0,
+                         (1.0 / 6.0) - z / 120.0 + z2 / 5040.0 - (z2 * z) / 362880.0};
+    }
+
+    if (z > 0.0) {
+        const double s = std::sqrt(z);
+        return StumpffCS{(1.0 - std::cos(s)) / z, (s - std::sin(s)) / (s * s * s)};
+    }
+
+    // z < 0
+    const double s = std::sqrt(-z);
+    return StumpffCS{(std::cosh(s) - 1.0) / (-z), (std::sinh(s) - s) / (s * s * s)};
+}
+
 } // namespace ob::math
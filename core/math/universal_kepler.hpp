@@ -0,0 +1,166 @@
+// core/math/universal_kepler.hpp
+#pragma once
+
+#include <cmath>
+
+#include "core/math/stumpff.hpp"
+#include "core/types.hpp"
+
+namespace bullseye_pred::math {
+
+/**
+ * @brief Relative step tolerance that terminates the universal-variable Newton solve.
+ *
+ * The solve stops once |dchi| <= kUniversalChiRelTol * (1 + |chi|). Newton converges
+ * quadratically, so the state after that step is already at working precision.
+ */
+inline constexpr double kUniversalChiRelTol = 1.0e-14;
+
+/**
+ * @brief Result of one universal-variable two-body propagation.
+ */
+struct UniversalPropagation final
+{
+    Vec3 r_i{};
+    Vec3 v_i{};
+
+    /** @brief Solved universal anomaly of the arc [sqrt(m)]. */
+    double chi{0.0};
+
+    /** @brief Newton iterations performed (<= the cap). */
+    int iterations{0};
+
+    /** @brief True if the step tolerance was met before the cap. */
+    bool converged{false};
+};
+
+/**
+ * @brief Deterministic starter for the universal anomaly over dt from (r0, v0).
+ *
+ * @param alpha Reciprocal semi-major axis 2/r0 - v0^2/mu [1/m].
+ * @param sqrt_mu sqrt(mu).
+ * @param r0n |r0| [m].
+ * @param dt Propagation interval [s].
+ */
+[[nodiscard]] inline double universal_initial_guess(double alpha,
+                                                    double sqrt_mu,
+                                                    double r0n,
+                                                    double dt) noexcept
+{
+    const double abs_alpha = std::fabs(alpha);
+    if (abs_alpha > 1e-8)
+    {
+        return sqrt_mu * abs_alpha * dt;
+    }
+    // Near-parabolic fallback.
+    return sqrt_mu * dt / r0n;
+}
+
+/**
+ * @brief Propagate (r0, v0) by dt with the universal-variable f-g solution.
+ *
+ * Deterministic policy (GCR-6):
+ * - Newton iterations stop on a step tolerance that depends only on the inputs
+ *   (kUniversalChiRelTol), or after max_iters; the same inputs always take the same path.
+ * - A vanishing or non-finite derivative leaves chi unchanged for that iteration.
+ *
+ * @param r0_i Initial position [m] (finite, nonzero).
+ * @param v0_i Initial velocity [m/s] (finite).
+ * @param mu Gravitational parameter [m^3/s^2] (finite, > 0).
+ * @param dt Propagation interval [s] (finite).
+ * @param chi0 Initial guess for the universal anomaly (see universal_initial_guess()).
+ * @param max_iters Newton iteration cap.
+ * @param out Propagated state (written only on success).
+ * @return false on invalid inputs or non-finite/degenerate results.
+ */
+[[nodiscard]] inline bool universal_propagate(const Vec3& r0_i,
+                                              const Vec3& v0_i,
+                                              double mu,
+                                              double dt,
+                                              double chi0,
+                                              int max_iters,
+                                              UniversalPropagation& out) noexcept
+{
+    if (!(mu > 0.0) || !std::isfinite(mu) || !std::isfinite(dt) || !std::isfinite(chi0))
+    {
+        return false;
+    }
+
+    const double r0n = norm(r0_i);
+    if (!(r0n > 0.0) || !std::isfinite(r0n))
+    {
+        return false;
+    }
+
+    const double sqrt_mu = std::sqrt(mu);
+    const double alpha = 2.0 / r0n - dot(v0_i, v0_i) / mu; // reciprocal semi-major axis
+    const double r0dotv0_over_sqrtmu = dot(r0_i, v0_i) / sqrt_mu;
+    const double one_minus_alpha_r0 = 1.0 - alpha * r0n;
+
+    double x = chi0;
+    int iters = 0;
+    bool converged = false;
+    while (iters < max_iters)
+    {
+        ++iters;
+
+        const double x2 = x * x;
+        const double z = alpha * x2;
+        const StumpffCS cs = stumpff_CS(z);
+
+        // F(x) = r0·v0/sqrt(mu) * x^2*C + (1 - alpha*r0) * x^3*S + r0*x - sqrt(mu)*dt
+        const double F = r0dotv0_over_sqrtmu * x2 * cs.C + one_minus_alpha_r0 * x2 * x * cs.S +
+                         r0n * x - sqrt_mu * dt;
+
+        // F'(x) = r0·v0/sqrt(mu) * x*(1 - z*S) + (1 - alpha*r0) * x^2*C + r0
+        const double dF =
+            r0dotv0_over_sqrtmu * x * (1.0 - z * cs.S) + one_minus_alpha_r0 * x2 * cs.C + r0n;
+
+        if (!(dF != 0.0) || !std::isfinite(dF) || !std::isfinite(F))
+        {
+            continue;
+        }
+
+        const double dx = F / dF;
+        x = x - dx;
+        if (std::fabs(dx) <= kUniversalChiRelTol * (1.0 + std::fabs(x)))
+        {
+            converged = true;
+            break;
+        }
+    }
+
+    const double x2 = x * x;
+    const double z = alpha * x2;
+    const StumpffCS cs = stumpff_CS(z);
+
+    const double f = 1.0 - (x2 / r0n) * cs.C;
+    const double g = dt - (x2 * x / sqrt_mu) * cs.S;
+
+    const Vec3 r = f * r0_i + g * v0_i;
+    const double rn = norm(r);
+    if (!(rn > 0.0) || !std::isfinite(rn))
+    {
+        return false;
+    }
+
+    // fdot = sqrt(mu)/(r0*rn) * (z*S - 1) * x ; gdot = 1 - x^2/rn * C
+    const double fdot = (sqrt_mu / (r0n * rn)) * (z * cs.S - 1.0) * x;
+    const double gdot = 1.0 - (x2 / rn) * cs.C;
+    const Vec3 v = fdot * r0_i + gdot * v0_i;
+
+    if (!std::isfinite(r.x) || !std::isfinite(r.y) || !std::isfinite(r.z) ||
+        !std::isfinite(v.x) || !std::isfinite(v.y) || !std::isfinite(v.z) || !std::isfinite(x))
+    {
+        return false;
+    }
+
+    out.r_i = r;
+    out.v_i = v;
+    out.chi = x;
+    out.iterations = iters;
+    out.converged = converged;
+    return true;
+}
+
+} // namespace bullseye_pred::math
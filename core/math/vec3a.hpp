@@ -0,0 +1,227 @@
+// core/math/vec3a.hpp
+#pragma once
+
+/**
+ * @file vec3a.hpp
+ * @brief Padded, 32-byte aligned 3-vectors and 3x3 matrices for SIMD-friendly inner loops.
+ *
+ * Vec3a holds {x, y, z, pad} in one 4-lane group, so a sum or product is one vector
+ * operation (one AVX or two SSE2 instructions) instead of three scalar ones. Mat3a stores the
+ * three *columns* of a matrix padded the same way, which turns A*v into a lane-wise
+ * multiply-add of columns:
+ *
+ *   A*v = col0*v.x + col1*v.y + col2*v.z
+ *
+ * Each lane evaluates the same products in the same order as the scalar mul() /
+ * mul_transpose() in types.hpp, so converting back to Vec3 is bitwise identical to the scalar
+ * path (the pad lane is never read). Mat3a::transposed(C) loads the columns of C^T straight
+ * from the rows of C: a per-batch C_from_inertial_to_ric never needs transpose() of the tick's
+ * C_from_ric_to_inertial.
+ *
+ * These are working types for hot loops, not storage types: snapshots, providers and the
+ * public API keep Vec3 / Mat3.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred::math {
+
+namespace detail {
+
+#if defined(__GNUC__) || defined(__clang__)
+// Generic vector extension: lowered to AVX when enabled, to SSE2 pairs otherwise.
+typedef double Lanes4 __attribute__((vector_size(4 * sizeof(double))));
+#else
+struct alignas(32) Lanes4 final
+{
+    double v[4]{};
+
+    Lanes4() = default;
+    Lanes4(double a, double b, double c, double d) noexcept : v{a, b, c, d} {}
+
+    [[nodiscard]] double operator[](int i) const noexcept
+    {
+        return v[i];
+    }
+};
+
+[[nodiscard]] inline Lanes4 operator+(const Lanes4& a, const Lanes4& b) noexcept
+{
+    return Lanes4{a[0] + b[0], a[1] + b[1], a[2] + b[2], a[3] + b[3]};
+}
+[[nodiscard]] inline Lanes4 operator-(const Lanes4& a, const Lanes4& b) noexcept
+{
+    return Lanes4{a[0] - b[0], a[1] - b[1], a[2] - b[2], a[3] - b[3]};
+}
+[[nodiscard]] inline Lanes4 operator*(const Lanes4& a, const Lanes4& b) noexcept
+{
+    return Lanes4{a[0] * b[0], a[1] * b[1], a[2] * b[2], a[3] * b[3]};
+}
+#endif
+
+} // namespace detail
+
+struct alignas(32) Vec3a final
+{
+    detail::Lanes4 l{}; // {x, y, z, pad}
+
+    Vec3a() = default;
+    explicit Vec3a(const detail::Lanes4& lanes) noexcept : l(lanes) {}
+    explicit Vec3a(const Vec3& v) noexcept : l(detail::Lanes4{v.x, v.y, v.z, 0.0}) {}
+
+    [[nodiscard]] double x() const noexcept
+    {
+        return l[0];
+    }
+    [[nodiscard]] double y() const noexcept
+    {
+        return l[1];
+    }
+    [[nodiscard]] double z() const noexcept
+    {
+        return l[2];
+    }
+    [[nodiscard]] Vec3 vec3() const noexcept
+    {
+        return Vec3{l[0], l[1], l[2]};
+    }
+};
+
+static_assert(sizeof(Vec3a) == 32 && alignof(Vec3a) == 32, "Vec3a must be one 32-byte lane group");
+
+[[nodiscard]] inline Vec3a operator+(const Vec3a& a, const Vec3a& b) noexcept
+{
+    return Vec3a{a.l + b.l};
+}
+[[nodiscard]] inline Vec3a operator-(const Vec3a& a, const Vec3a& b) noexcept
+{
+    return Vec3a{a.l - b.l};
+}
+[[nodiscard]] inline Vec3a operator*(double s, const Vec3a& v) noexcept
+{
+    return Vec3a{detail::Lanes4{s, s, s, s} * v.l};
+}
+
+/** @brief Same summation order as dot(Vec3, Vec3). */
+[[nodiscard]] inline double dot(const Vec3a& a, const Vec3a& b) noexcept
+{
+    const detail::Lanes4 p = a.l * b.l;
+    return p[0] + p[1] + p[2];
+}
+
+/** @brief Same operand order as cross(Vec3, Vec3). */
+[[nodiscard]] inline Vec3a cross(const Vec3a& a, const Vec3a& b) noexcept
+{
+    return Vec3a{detail::Lanes4{a.l[1] * b.l[2] - a.l[2] * b.l[1],
+                                a.l[2] * b.l[0] - a.l[0] * b.l[2],
+                                a.l[0] * b.l[1] - a.l[1] * b.l[0], 0.0}};
+}
+
+/** @brief true if x, y and z are finite (x - x is 0 for finite x, NaN otherwise). */
+[[nodiscard]] inline bool finite3(const Vec3a& v) noexcept
+{
+    const detail::Lanes4 z = v.l - v.l;
+    return (z[0] + z[1] + z[2]) == 0.0;
+}
+
+/**
+ * @brief 3x3 matrix held as three padded columns.
+ */
+struct alignas(32) Mat3a final
+{
+    detail::Lanes4 col[3]{};
+
+    Mat3a() = default;
+    explicit Mat3a(const Mat3& A) noexcept
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            col[c] = detail::Lanes4{A(0, c), A(1, c), A(2, c), 0.0};
+        }
+    }
+
+    /** @brief Mat3a of A^T, read from the rows of @p A (no Mat3 transpose is formed). */
+    [[nodiscard]] static Mat3a transposed(const Mat3& A) noexcept
+    {
+        Mat3a R;
+        for (int c = 0; c < 3; ++c)
+        {
+            R.col[c] = detail::Lanes4{A(c, 0), A(c, 1), A(c, 2), 0.0};
+        }
+        return R;
+    }
+
+    [[nodiscard]] Mat3 mat3() const noexcept
+    {
+        Mat3 A;
+        for (int r = 0; r < 3; ++r)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                A(r, c) = col[c][r];
+            }
+        }
+        return A;
+    }
+};
+
+/** @brief A*v; bitwise identical to mul(Mat3, Vec3). */
+[[nodiscard]] inline Vec3a mul(const Mat3a& A, const Vec3a& v) noexcept
+{
+    const double x = v.l[0], y = v.l[1], z = v.l[2];
+    return Vec3a{A.col[0] * detail::Lanes4{x, x, x, x} + A.col[1] * detail::Lanes4{y, y, y, y} +
+                 A.col[2] * detail::Lanes4{z, z, z, z}};
+}
+
+/** @brief A^T*v without forming A^T; bitwise identical to mul_transpose(Mat3, Vec3). */
+[[nodiscard]] inline Vec3a mul_transpose(const Mat3a& A, const Vec3a& v) noexcept
+{
+    return Vec3a{detail::Lanes4{dot(Vec3a{A.col[0]}, v), dot(Vec3a{A.col[1]}, v),
+                                dot(Vec3a{A.col[2]}, v), 0.0}};
+}
+
+// -----------------------------
+// Batched helpers over Vec3 planes
+// -----------------------------
+
+/** @brief out[k] = dot(a[k], b[k]); writes min(a.size, b.size, out.size) entries. */
+inline void dot3(Span<const Vec3> a, Span<const Vec3> b, Span<double> out) noexcept
+{
+    const std::size_t n = std::min({a.size, b.size, out.size});
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        out[k] = a[k].x * b[k].x + a[k].y * b[k].y + a[k].z * b[k].z;
+    }
+}
+
+/** @brief out[k] = cross(a[k], b[k]); writes min(a.size, b.size, out.size) entries. */
+inline void cross3(Span<const Vec3> a, Span<const Vec3> b, Span<Vec3> out) noexcept
+{
+    const std::size_t n = std::min({a.size, b.size, out.size});
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        out[k] = Vec3{a[k].y * b[k].z - a[k].z * b[k].y, a[k].z * b[k].x - a[k].x * b[k].z,
+                      a[k].x * b[k].y - a[k].y * b[k].x};
+    }
+}
+
+/**
+ * @brief true if every component of every entry is finite. Branch-free: the x - x terms are
+ * accumulated and tested once, so one bad entry costs nothing extra and the loop vectorizes.
+ */
+[[nodiscard]] inline bool all_finite3(Span<const Vec3> v) noexcept
+{
+    double acc = 0.0;
+    for (std::size_t k = 0; k < v.size; ++k)
+    {
+        acc += (v[k].x - v[k].x) + (v[k].y - v[k].y) + (v[k].z - v[k].z);
+    }
+    return acc == 0.0;
+}
+
+} // namespace bullseye_pred::math
@@ -0,0 +1,52 @@
+#include "core/memory_resource.hpp"
+
+namespace bullseye_pred
+{
+
+RunArena::RunArena(std::size_t initial_bytes, std::pmr::memory_resource* upstream)
+    : upstream_(upstream), arena_((initial_bytes > 0u) ? initial_bytes : 1u, &upstream_)
+{
+}
+
+void RunArena::release() noexcept
+{
+    arena_.release();
+    bytes_allocated_ = 0;
+}
+
+void* RunArena::do_allocate(std::size_t bytes, std::size_t align)
+{
+    void* const p = arena_.allocate(bytes, align);
+    bytes_allocated_ += bytes;
+    return p;
+}
+
+void RunArena::do_deallocate(void* /*p*/, std::size_t /*bytes*/, std::size_t /*align*/)
+{
+    // Monotonic: storage comes back only with release().
+}
+
+bool RunArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void* RunArena::Upstream::do_allocate(std::size_t bytes, std::size_t align)
+{
+    void* const p = next_->allocate(bytes, align);
+    ++regions;
+    return p;
+}
+
+void RunArena::Upstream::do_deallocate(void* p, std::size_t bytes, std::size_t align)
+{
+    next_->deallocate(p, bytes, align);
+    --regions;
+}
+
+bool RunArena::Upstream::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+} // namespace bullseye_pred
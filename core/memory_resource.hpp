@@ -0,0 +1,105 @@
+#pragma once
+/**
+ * @file memory_resource.hpp
+ * @brief Per-run memory resources for provider samples and time grids.
+ *
+ * @details
+ * CartesianChiefProvider, CartesianBullseyeFrameProvider (series and streaming window) and
+ * TimeGrid / TimeGridCache take a std::pmr::memory_resource at construction; the default is
+ * the global heap. A batch job that runs many scenarios, possibly one per thread, gives each
+ * run its own resource instead, so runs neither fragment the shared heap nor contend on its
+ * locks:
+ *
+ * - RunArena: monotonic. Every allocation of the run is carved from one upstream region
+ *   (sized by initial_bytes; further regions only if it overflows), nothing is freed
+ *   individually, and release() or destruction drops the whole run in O(1).
+ * - PooledResource: size-class pools for storage that is cleared and refilled within a run
+ *   (clear_samples() / load_presorted() cycles). Freed blocks are reused; put it on a
+ *   RunArena to keep the O(1) teardown.
+ *
+ * Neither is thread-safe: one run, one thread. Every container using a resource must be
+ * destroyed before the resource is released or destroyed.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Monotonic per-run arena (std::pmr::monotonic_buffer_resource with counters).
+ */
+class RunArena final : public std::pmr::memory_resource
+{
+  public:
+    /**
+     * @param initial_bytes Size of the first upstream region (allocated on first use); size it
+     *        for a whole run so regions() stays 1.
+     * @param upstream Source of the regions; must outlive the arena.
+     */
+    explicit RunArena(std::size_t initial_bytes,
+                      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+    RunArena(const RunArena&) = delete;
+    RunArena& operator=(const RunArena&) = delete;
+
+    /** @brief Return every region to upstream at once; the arena can be reused. */
+    void release() noexcept;
+
+    /** @brief Bytes handed out since construction or the last release(). */
+    [[nodiscard]] std::size_t bytes_allocated() const noexcept { return bytes_allocated_; }
+
+    /** @brief Upstream regions currently held. */
+    [[nodiscard]] std::size_t regions() const noexcept { return upstream_.regions; }
+
+  private:
+    // Counts the regions the monotonic resource takes from upstream.
+    class Upstream final : public std::pmr::memory_resource
+    {
+      public:
+        explicit Upstream(std::pmr::memory_resource* next) noexcept : next_(next) {}
+
+        std::size_t regions{0};
+
+      private:
+        void* do_allocate(std::size_t bytes, std::size_t align) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t align) override;
+        [[nodiscard]] bool do_is_equal(
+            const std::pmr::memory_resource& other) const noexcept override;
+
+        std::pmr::memory_resource* next_;
+    };
+
+    void* do_allocate(std::size_t bytes, std::size_t align) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    Upstream upstream_;
+    std::pmr::monotonic_buffer_resource arena_;
+    std::size_t bytes_allocated_{0};
+};
+
+/**
+ * @brief Pooled resource for storage that shrinks and regrows within a run (single thread).
+ *
+ * std::pmr::unsynchronized_pool_resource with pools up to largest_block_bytes, so whole sample
+ * series are pooled too; larger blocks go straight to upstream and back.
+ */
+class PooledResource final : public std::pmr::unsynchronized_pool_resource
+{
+  public:
+    /// Default largest pooled block (1 MiB: about 18000 chief samples).
+    static constexpr std::size_t kDefaultLargestBlock = std::size_t{1} << 20;
+
+    /** @param upstream Source of the pools; must outlive this resource. */
+    explicit PooledResource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource(),
+                            std::size_t largest_block_bytes = kDefaultLargestBlock)
+        : std::pmr::unsynchronized_pool_resource(
+              std::pmr::pool_options{0, largest_block_bytes}, upstream)
+    {
+    }
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,759 @@
+#include "core/net_publisher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BULLSEYE_HAVE_SOCKETS 1
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace bullseye_pred
+{
+
+namespace
+{
+
+constexpr std::size_t kMinDatagramBytes = 256;
+
+// Largest UDP payload over IPv4.
+constexpr std::size_t kMaxDatagramBytes = 65507;
+
+std::size_t sample_bytes(NetPrecision p) noexcept
+{
+    switch (p)
+    {
+    case NetPrecision::kFloat32:
+        return sizeof(Vec3f);
+    case NetPrecision::kFixed32:
+        return sizeof(Vec3q);
+    case NetPrecision::kFloat64:
+    default:
+        return sizeof(Vec3);
+    }
+}
+
+} // namespace
+
+SnapshotDeltaEncoder::SnapshotDeltaEncoder(const NetEncoderConfig& config) : config_(config)
+{
+    config_.max_datagram_bytes =
+        std::min(std::max(config_.max_datagram_bytes, kMinDatagramBytes), kMaxDatagramBytes);
+    config_.keyframe_interval = std::max<std::size_t>(config_.keyframe_interval, 1u);
+    last_tau_.assign(MAX_STEPS, 0.0);
+
+    // A keyframe of every row at full precision in the smallest datagrams bounds the counts.
+    const std::size_t per_frame = (kMinDatagramBytes - sizeof(NetDatagramHeader) -
+                                   sizeof(NetSegmentHeader)) / sizeof(Vec3);
+    const std::size_t segments = (MAX_VEHICLES + 1u) * (MAX_STEPS / per_frame + 2u);
+    headers_.reserve(segments);
+    segments_.reserve(segments);
+    payloads_.reserve(segments);
+    pieces_.reserve(3u * segments);
+    frames_.reserve(segments);
+}
+
+void SnapshotDeltaEncoder::open_frame_()
+{
+    Frame f{};
+    f.first_segment = segments_.size();
+    f.bytes = sizeof(NetDatagramHeader);
+    frames_.push_back(f);
+    room_ = config_.max_datagram_bytes - sizeof(NetDatagramHeader);
+}
+
+void SnapshotDeltaEncoder::add_segment_(NetSegmentHeader seg,
+                                        const unsigned char* data,
+                                        std::size_t base,
+                                        std::size_t count,
+                                        std::size_t elem)
+{
+    std::size_t first = 0;
+    do
+    {
+        const std::size_t need = sizeof(NetSegmentHeader) + ((count > first) ? elem : 0u);
+        if (room_ < need)
+        {
+            open_frame_();
+        }
+        const std::size_t n =
+            std::min(count - first, (room_ - sizeof(NetSegmentHeader)) / elem);
+        seg.first_step = static_cast<std::uint16_t>(base + first);
+        seg.count = static_cast<std::uint16_t>(n);
+        segments_.push_back(seg);
+        payloads_.push_back(NetFramePiece{data + first * elem, n * elem});
+        Frame& f = frames_.back();
+        ++f.segments;
+        f.bytes += sizeof(NetSegmentHeader) + n * elem;
+        room_ -= sizeof(NetSegmentHeader) + n * elem;
+        first += n;
+    } while (first < count);
+}
+
+std::size_t SnapshotDeltaEncoder::encode(const PredictionBuffer& buf, bool keyframe)
+{
+    const std::size_t steps = std::min(buf.steps, MAX_STEPS);
+    const SubscriptionFilter& filter = config_.filter;
+    const std::size_t lo = std::min(filter.first_step, steps);
+    const std::size_t hi = lo + std::min(steps - lo, filter.max_steps);
+    keyframe = keyframe || base_seqno_ == 0u || since_keyframe_ >= config_.keyframe_interval;
+
+    // Reduced precision only where the publisher already holds the plane.
+    NetPrecision precision = config_.precision;
+    if ((precision == NetPrecision::kFloat32 && buf.positions_f32 == nullptr) ||
+        (precision == NetPrecision::kFixed32 && buf.positions_q32 == nullptr))
+    {
+        precision = NetPrecision::kFloat64;
+    }
+    const std::size_t elem = sample_bytes(precision);
+
+    headers_.clear();
+    segments_.clear();
+    payloads_.clear();
+    pieces_.clear();
+    frames_.clear();
+    open_frame_();
+
+    if (keyframe || steps != last_steps_ ||
+        std::memcmp(last_tau_.data(), buf.tau.data(), steps * sizeof(double)) != 0)
+    {
+        NetSegmentHeader seg{};
+        seg.kind = static_cast<std::uint8_t>(NetSegmentKind::kTau);
+        add_segment_(seg, reinterpret_cast<const unsigned char*>(buf.tau.data() + lo), lo,
+                     hi - lo, sizeof(double));
+        std::memcpy(last_tau_.data(), buf.tau.data(), steps * sizeof(double));
+        last_steps_ = steps;
+    }
+
+    const RowMask changed = keyframe ? RowMask{0} : buf.rows_changed_since(base_seqno_);
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        const bool send = keyframe ? (buf.row_valid(i) || buf.row_status[i] != RowStatus::kEmpty)
+                                   : ((changed >> i) & 1u) != 0u;
+        if (!send || ((filter.rows >> i) & 1u) == 0u)
+        {
+            continue;
+        }
+        NetSegmentHeader seg{};
+        seg.kind = static_cast<std::uint8_t>(NetSegmentKind::kRow);
+        seg.status = static_cast<std::uint8_t>(buf.row_status[i]);
+        seg.row = static_cast<std::uint16_t>(i);
+        seg.row_seqno = buf.row_seqno[i];
+        seg.row_t0 = buf.row_t0[i];
+
+        const void* samples = buf.positions[i].data() + lo;
+        if (precision == NetPrecision::kFloat32)
+        {
+            samples = (*buf.positions_f32)[i].data() + lo;
+        }
+        else if (precision == NetPrecision::kFixed32)
+        {
+            samples = (*buf.positions_q32)[i].data() + lo;
+        }
+        add_segment_(seg, static_cast<const unsigned char*>(samples), lo,
+                     buf.row_valid(i) ? hi - lo : 0u, elem);
+    }
+
+    // Headers last: every datagram names the fragment count.
+    for (std::size_t d = 0; d < frames_.size(); ++d)
+    {
+        NetDatagramHeader h{};
+        h.magic = kNetMagic;
+        h.version = kNetFormatVersion;
+        h.kind = static_cast<std::uint8_t>(keyframe ? NetDatagramKind::kKeyframe
+                                                    : NetDatagramKind::kDelta);
+        h.precision = static_cast<std::uint8_t>(precision);
+        h.packet_seq = ++packet_seq_;
+        h.seqno = buf.seqno;
+        h.base_seqno = keyframe ? 0u : base_seqno_;
+        h.t0 = buf.t0;
+        h.valid_rows = buf.valid_rows & filter.rows;
+        h.fragment = static_cast<std::uint16_t>(d);
+        h.fragments = static_cast<std::uint16_t>(frames_.size());
+        h.segments = static_cast<std::uint16_t>(frames_[d].segments);
+        h.steps = static_cast<std::uint16_t>(hi);
+        h.q32_scale_m = (precision == NetPrecision::kFixed32) ? buf.q32_scale_m : 0.0;
+        headers_.push_back(h);
+    }
+    for (std::size_t d = 0; d < frames_.size(); ++d)
+    {
+        Frame& f = frames_[d];
+        f.first_piece = pieces_.size();
+        pieces_.push_back(NetFramePiece{&headers_[d], sizeof(NetDatagramHeader)});
+        for (std::size_t s = f.first_segment; s < f.first_segment + f.segments; ++s)
+        {
+            pieces_.push_back(NetFramePiece{&segments_[s], sizeof(NetSegmentHeader)});
+            if (payloads_[s].bytes > 0u)
+            {
+                pieces_.push_back(payloads_[s]);
+            }
+        }
+        f.pieces = pieces_.size() - f.first_piece;
+    }
+
+    last_keyframe_ = keyframe;
+    since_keyframe_ = keyframe ? 1u : since_keyframe_ + 1u;
+    base_seqno_ = buf.seqno;
+    return frames_.size();
+}
+
+SnapshotDeltaDecoder::SnapshotDeltaDecoder() : mirror_(std::make_unique<PredictionBuffer>())
+{
+}
+
+bool SnapshotDeltaDecoder::begin_(const NetDatagramHeader& h) noexcept
+{
+    if (assembling_ != 0u && synced_)
+    {
+        // The previous snapshot never completed: the mirror holds part of it.
+        synced_ = false;
+        ++stats_.resyncs;
+    }
+    assembling_ = 0;
+    const bool key = h.kind == static_cast<std::uint8_t>(NetDatagramKind::kKeyframe);
+    if (!key && (!synced_ || h.base_seqno != complete_seqno_))
+    {
+        if (synced_)
+        {
+            synced_ = false;
+            ++stats_.resyncs;
+        }
+        return false;
+    }
+
+    PredictionBuffer& m = *mirror_;
+    if (key)
+    {
+        m.row_status.fill(RowStatus::kEmpty);
+        m.row_seqno.fill(0u);
+        m.row_t0.fill(0.0);
+    }
+    m.seqno = h.seqno;
+    m.t0 = h.t0;
+    m.steps = h.steps;
+    m.valid_rows = h.valid_rows;
+    m.dirty_rows = 0;
+    got_.assign(h.fragments, 0u);
+    got_count_ = 0;
+    assembling_ = h.seqno;
+    assembling_kind_ = h.kind;
+    assembling_base_ = h.base_seqno;
+    return true;
+}
+
+NetDecodeResult SnapshotDeltaDecoder::apply(const void* datagram, std::size_t bytes) noexcept
+{
+    const auto* p = static_cast<const unsigned char*>(datagram);
+    NetDatagramHeader h{};
+    if (p == nullptr || bytes < sizeof(h))
+    {
+        ++stats_.malformed;
+        return NetDecodeResult::kMalformed;
+    }
+    std::memcpy(&h, p, sizeof(h));
+    if (h.magic != kNetMagic || h.version != kNetFormatVersion ||
+        h.kind > static_cast<std::uint8_t>(NetDatagramKind::kKeyframe) ||
+        h.precision > static_cast<std::uint8_t>(NetPrecision::kFixed32) || h.fragments == 0u ||
+        h.fragment >= h.fragments || h.steps > MAX_STEPS || h.seqno == 0u)
+    {
+        ++stats_.malformed;
+        return NetDecodeResult::kMalformed;
+    }
+
+    // Validate every segment before touching the mirror.
+    const std::size_t elem = sample_bytes(static_cast<NetPrecision>(h.precision));
+    std::size_t off = sizeof(h);
+    for (std::size_t s = 0; s < h.segments; ++s)
+    {
+        NetSegmentHeader seg{};
+        if (bytes - off < sizeof(seg))
+        {
+            ++stats_.malformed;
+            return NetDecodeResult::kMalformed;
+        }
+        std::memcpy(&seg, p + off, sizeof(seg));
+        off += sizeof(seg);
+        const bool tau = seg.kind == static_cast<std::uint8_t>(NetSegmentKind::kTau);
+        const std::size_t payload = seg.count * (tau ? sizeof(double) : elem);
+        if ((!tau && (seg.kind != static_cast<std::uint8_t>(NetSegmentKind::kRow) ||
+                      seg.row >= MAX_VEHICLES ||
+                      seg.status > static_cast<std::uint8_t>(RowStatus::kModelError))) ||
+            std::size_t{seg.first_step} + seg.count > MAX_STEPS || bytes - off < payload)
+        {
+            ++stats_.malformed;
+            return NetDecodeResult::kMalformed;
+        }
+        off += payload;
+    }
+
+    // Later fragments must describe the snapshot begin_() sized the assembly for.
+    if (h.seqno == assembling_ &&
+        (h.fragments != got_.size() || h.kind != assembling_kind_ ||
+         h.base_seqno != assembling_base_ || h.steps != mirror_->steps))
+    {
+        ++stats_.malformed;
+        return NetDecodeResult::kMalformed;
+    }
+
+    // Sender datagram counter: gaps are losses (resets when the sender restarts).
+    if (next_packet_ != 0u && h.packet_seq > next_packet_)
+    {
+        stats_.lost_datagrams += h.packet_seq - next_packet_;
+    }
+    next_packet_ = h.packet_seq + 1u;
+
+    if (h.seqno != assembling_)
+    {
+        const bool stale = (synced_ && h.seqno <= complete_seqno_) ||
+                           (assembling_ != 0u && h.seqno < assembling_);
+        if (stale || !begin_(h))
+        {
+            ++stats_.ignored;
+            return NetDecodeResult::kIgnored;
+        }
+    }
+    else if (got_[h.fragment] != 0u)
+    {
+        ++stats_.ignored;
+        return NetDecodeResult::kIgnored;
+    }
+
+    PredictionBuffer& m = *mirror_;
+    const auto precision = static_cast<NetPrecision>(h.precision);
+    off = sizeof(h);
+    for (std::size_t s = 0; s < h.segments; ++s)
+    {
+        NetSegmentHeader seg{};
+        std::memcpy(&seg, p + off, sizeof(seg));
+        off += sizeof(seg);
+        const unsigned char* src = p + off;
+        if (seg.kind == static_cast<std::uint8_t>(NetSegmentKind::kTau))
+        {
+            std::memcpy(m.tau.data() + seg.first_step, src, seg.count * sizeof(double));
+            off += seg.count * sizeof(double);
+            continue;
+        }
+
+        const std::size_t i = seg.row;
+        m.row_status[i] = static_cast<RowStatus>(seg.status);
+        m.row_seqno[i] = seg.row_seqno;
+        m.row_t0[i] = seg.row_t0;
+        if (seg.row_seqno == h.seqno)
+        {
+            m.dirty_rows |= RowMask{1} << i;
+        }
+        Vec3* dst = m.positions[i].data() + seg.first_step;
+        for (std::size_t k = 0; k < seg.count; ++k)
+        {
+            if (precision == NetPrecision::kFloat64)
+            {
+                std::memcpy(&dst[k], src + k * elem, sizeof(Vec3));
+            }
+            else if (precision == NetPrecision::kFloat32)
+            {
+                Vec3f f{};
+                std::memcpy(&f, src + k * elem, sizeof(f));
+                dst[k] = Vec3{f.x, f.y, f.z};
+            }
+            else
+            {
+                Vec3q q{};
+                std::memcpy(&q, src + k * elem, sizeof(q));
+                dst[k] = Vec3{dequantize_fixed32(q.x, h.q32_scale_m),
+                              dequantize_fixed32(q.y, h.q32_scale_m),
+                              dequantize_fixed32(q.z, h.q32_scale_m)};
+            }
+        }
+        off += seg.count * elem;
+    }
+
+    got_[h.fragment] = 1u;
+    if (++got_count_ < got_.size())
+    {
+        return NetDecodeResult::kPartial;
+    }
+    complete_seqno_ = assembling_;
+    assembling_ = 0;
+    synced_ = true;
+    ++stats_.snapshots;
+    if (h.kind == static_cast<std::uint8_t>(NetDatagramKind::kKeyframe))
+    {
+        ++stats_.keyframes;
+    }
+    return NetDecodeResult::kComplete;
+}
+
+MulticastPublisher::MulticastPublisher(const Publisher& publisher, const MulticastConfig& config)
+    : pub_(publisher), config_(config), encoder_(config.encoder)
+{
+}
+
+MulticastPublisher::~MulticastPublisher()
+{
+    stop();
+}
+
+bool MulticastPublisher::wait_caught_up(double timeout_sec) const noexcept
+{
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout_sec);
+    while (done_seqno_.load(std::memory_order_acquire) < pub_.published_seqno())
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return true;
+}
+
+MulticastPublisherStats MulticastPublisher::stats() const noexcept
+{
+    MulticastPublisherStats s{};
+    s.snapshots = snapshots_.load(std::memory_order_relaxed);
+    s.keyframes = keyframes_.load(std::memory_order_relaxed);
+    s.datagrams = datagrams_.load(std::memory_order_relaxed);
+    s.bytes = bytes_.load(std::memory_order_relaxed);
+    s.send_errors = send_errors_.load(std::memory_order_relaxed);
+    s.torn = torn_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void MulticastPublisher::thread_main_() noexcept
+{
+    std::uint64_t done = done_seqno_.load(std::memory_order_relaxed);
+    while (!stop_.load(std::memory_order_acquire))
+    {
+        if (pub_.wait_for_seqno(done, config_.poll_sec) <= done)
+        {
+            continue;
+        }
+        // Newest snapshot only: rows changed in skipped ones are in its delta.
+        SnapshotLease lease = pub_.acquire();
+        if (!lease.held() || lease->seqno <= done)
+        {
+            continue;
+        }
+        encoder_.encode(*lease);
+        const bool sent = send_frames_();
+        if (!lease.valid())
+        {
+            torn_.fetch_add(1u, std::memory_order_relaxed);
+            encoder_.reset();
+        }
+        else if (!sent)
+        {
+            send_errors_.fetch_add(1u, std::memory_order_relaxed);
+            encoder_.reset();
+        }
+        else
+        {
+            snapshots_.fetch_add(1u, std::memory_order_relaxed);
+            if (encoder_.last_was_keyframe())
+            {
+                keyframes_.fetch_add(1u, std::memory_order_relaxed);
+            }
+        }
+        done = lease->seqno;
+        lease.release();
+        done_seqno_.store(done, std::memory_order_release);
+    }
+}
+
+#if defined(BULLSEYE_HAVE_SOCKETS)
+
+namespace
+{
+
+bool parse_ipv4(const char* text, in_addr& out) noexcept
+{
+    return text != nullptr && ::inet_pton(AF_INET, text, &out) == 1;
+}
+
+bool is_multicast(const in_addr& a) noexcept
+{
+    return (ntohl(a.s_addr) & 0xF0000000u) == 0xE0000000u;
+}
+
+} // namespace
+
+NetCode MulticastPublisher::start()
+{
+    in_addr group{};
+    in_addr iface{};
+    if (running_ || !parse_ipv4(config_.address, group) || config_.port == 0u ||
+        (config_.interface_address != nullptr && !parse_ipv4(config_.interface_address, iface)))
+    {
+        return NetCode::kInvalidInput;
+    }
+
+    fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd_ < 0)
+    {
+        return NetCode::kSocketFailed;
+    }
+    bool ok = true;
+    if (is_multicast(group))
+    {
+        const unsigned char ttl = static_cast<unsigned char>(std::clamp(config_.ttl, 0, 255));
+        const unsigned char loop = config_.loopback ? 1u : 0u;
+        ok = ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) == 0 &&
+             ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) == 0 &&
+             (config_.interface_address == nullptr ||
+              ::setsockopt(fd_, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface)) == 0);
+    }
+    // A connected socket needs no destination per datagram.
+    sockaddr_in dest{};
+    dest.sin_family = AF_INET;
+    dest.sin_port = htons(config_.port);
+    dest.sin_addr = group;
+    ok = ok && ::connect(fd_, reinterpret_cast<const sockaddr*>(&dest), sizeof(dest)) == 0;
+    if (!ok)
+    {
+        ::close(fd_);
+        fd_ = -1;
+        return NetCode::kSocketFailed;
+    }
+
+    encoder_.reset();
+    const std::uint64_t front = pub_.published_seqno();
+    done_seqno_.store(front > 0u ? front - 1u : 0u, std::memory_order_release);
+    stop_.store(false, std::memory_order_relaxed);
+    running_ = true;
+    thread_ = std::thread([this] { thread_main_(); });
+    return NetCode::kOk;
+}
+
+void MulticastPublisher::stop() noexcept
+{
+    if (!running_)
+    {
+        return;
+    }
+    stop_.store(true, std::memory_order_release);
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+    ::close(fd_);
+    fd_ = -1;
+    running_ = false;
+}
+
+bool MulticastPublisher::send_frames_() noexcept
+{
+    constexpr std::size_t kBatch = 32;
+    constexpr std::size_t kMaxIov = 1024;
+    iovec iov[kMaxIov];
+
+    const std::size_t frames = encoder_.frame_count();
+    std::size_t next = 0;
+    while (next < frames)
+    {
+#if defined(__linux__)
+        // One sendmmsg() per batch; each datagram gathers headers and payload in place.
+        mmsghdr msgs[kBatch]{};
+        std::size_t n = 0;
+        std::size_t used = 0;
+        while (n < kBatch && next + n < frames)
+        {
+            const Span<const NetFramePiece> pieces = encoder_.frame(next + n);
+            if (used + pieces.size > kMaxIov)
+            {
+                break;
+            }
+            for (std::size_t j = 0; j < pieces.size; ++j)
+            {
+                iov[used + j].iov_base = const_cast<void*>(pieces[j].data);
+                iov[used + j].iov_len = pieces[j].bytes;
+            }
+            msgs[n].msg_hdr.msg_iov = iov + used;
+            msgs[n].msg_hdr.msg_iovlen = pieces.size;
+            used += pieces.size;
+            ++n;
+        }
+        std::size_t sent = 0;
+        while (sent < n)
+        {
+            const int r = ::sendmmsg(fd_, msgs + sent, static_cast<unsigned>(n - sent), 0);
+            if (r < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+            sent += static_cast<std::size_t>(r);
+        }
+#else
+        const Span<const NetFramePiece> pieces = encoder_.frame(next);
+        for (std::size_t j = 0; j < pieces.size && j < kMaxIov; ++j)
+        {
+            iov[j].iov_base = const_cast<void*>(pieces[j].data);
+            iov[j].iov_len = pieces[j].bytes;
+        }
+        msghdr msg{};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = static_cast<int>(std::min(pieces.size, kMaxIov));
+        ssize_t r = -1;
+        do
+        {
+            r = ::sendmsg(fd_, &msg, 0);
+        } while (r < 0 && errno == EINTR);
+        if (r < 0)
+        {
+            return false;
+        }
+        const std::size_t n = 1;
+#endif
+        for (std::size_t d = next; d < next + n; ++d)
+        {
+            bytes_.fetch_add(encoder_.frame_bytes(d), std::memory_order_relaxed);
+        }
+        datagrams_.fetch_add(n, std::memory_order_relaxed);
+        next += n;
+    }
+    return true;
+}
+
+MulticastReceiver::~MulticastReceiver()
+{
+    close();
+}
+
+NetCode MulticastReceiver::open(const MulticastConfig& config)
+{
+    close();
+    in_addr group{};
+    in_addr iface{};
+    iface.s_addr = htonl(INADDR_ANY);
+    if (!parse_ipv4(config.address, group) || config.port == 0u ||
+        (config.interface_address != nullptr && !parse_ipv4(config.interface_address, iface)))
+    {
+        return NetCode::kInvalidInput;
+    }
+
+    fd_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd_ < 0)
+    {
+        return NetCode::kSocketFailed;
+    }
+    // Several receivers on one host share the port.
+    const int one = 1;
+    sockaddr_in local{};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(config.port);
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    bool ok = ::setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) == 0 &&
+              ::bind(fd_, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) == 0;
+    if (ok && is_multicast(group))
+    {
+        ip_mreq mreq{};
+        mreq.imr_multiaddr = group;
+        mreq.imr_interface = iface;
+        ok = ::setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) == 0;
+    }
+    if (!ok)
+    {
+        close();
+        return NetCode::kSocketFailed;
+    }
+    buffer_.resize(kMaxDatagramBytes);
+    return NetCode::kOk;
+}
+
+void MulticastReceiver::close() noexcept
+{
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+    }
+    fd_ = -1;
+}
+
+bool MulticastReceiver::receive(SnapshotDeltaDecoder& decoder, double timeout_sec)
+{
+    if (fd_ < 0)
+    {
+        return false;
+    }
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout_sec);
+    for (;;)
+    {
+        for (;;)
+        {
+            const ssize_t r = ::recv(fd_, buffer_.data(), buffer_.size(), MSG_DONTWAIT);
+            if (r < 0)
+            {
+                break;
+            }
+            if (decoder.apply(buffer_.data(), static_cast<std::size_t>(r)) ==
+                NetDecodeResult::kComplete)
+            {
+                return true;
+            }
+        }
+        const double left =
+            std::chrono::duration<double>(deadline - std::chrono::steady_clock::now()).count();
+        if (left <= 0.0)
+        {
+            return false;
+        }
+        pollfd pfd{};
+        pfd.fd = fd_;
+        pfd.events = POLLIN;
+        (void)::poll(&pfd, 1, static_cast<int>(std::ceil(left * 1000.0)));
+    }
+}
+
+#else
+
+NetCode MulticastPublisher::start()
+{
+    return NetCode::kUnsupported;
+}
+
+void MulticastPublisher::stop() noexcept
+{
+    running_ = false;
+}
+
+bool MulticastPublisher::send_frames_() noexcept
+{
+    return false;
+}
+
+MulticastReceiver::~MulticastReceiver()
+{
+    close();
+}
+
+NetCode MulticastReceiver::open(const MulticastConfig&)
+{
+    return NetCode::kUnsupported;
+}
+
+void MulticastReceiver::close() noexcept
+{
+    fd_ = -1;
+}
+
+bool MulticastReceiver::receive(SnapshotDeltaDecoder&, double)
+{
+    return false;
+}
+
+#endif
+
+} // namespace bullseye_pred
@@ -0,0 +1,451 @@
+#pragma once
+/**
+ * @file net_publisher.hpp
+ * @brief UDP (multicast) publication of delta-encoded snapshots, and the matching decoder.
+ *
+ * @details
+ * SnapshotDeltaEncoder turns one PredictionBuffer into datagrams that carry only the rows that
+ * changed since the previous encoded snapshot (PredictionBuffer::rows_changed_since()), or
+ * every row for a keyframe. Each datagram is a list of pieces pointing into the snapshot
+ * itself (the sample payload is never copied), so MulticastPublisher hands them straight to
+ * sendmmsg() as scatter-gather vectors. One send to a multicast group reaches every
+ * subscriber: the CPU cost is per snapshot, not per client.
+ *
+ * Datagram (native byte order, max NetEncoderConfig::max_datagram_bytes):
+ *
+ *   NetDatagramHeader   snapshot seqno, delta base, fragment i of n, t0, valid_rows, ...
+ *   repeated:
+ *     NetSegmentHeader  tau block, or one row's samples [first_step, first_step + count)
+ *     payload           count x double (tau), or count x Vec3 / Vec3f / Vec3q (row)
+ *
+ * A delta names the snapshot it applies on top of (base_seqno). A receiver that missed a
+ * datagram drops everything until the next keyframe, sent every
+ * NetEncoderConfig::keyframe_interval snapshots, so late joiners also sync within one
+ * interval. Only positions are sent (profile-0 grid); velocities stay local.
+ * NetEncoderConfig::filter narrows that further to the rows and steps the group subscribes to.
+ *
+ * Reduced precision reuses the publisher's own planes: with NetPrecision::kFloat32 or
+ * kFixed32 the encoder points at PredictionBuffer::positions_f32 / positions_q32, so configure
+ * the Publisher with the matching OutputPrecision. A snapshot without that plane goes out as
+ * doubles (the datagram header names the precision actually used).
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "core/constants.hpp"
+#include "core/prediction_buffer.hpp"
+#include "core/publisher.hpp"
+#include "core/snapshot_view.hpp"
+
+namespace bullseye_pred
+{
+
+/// "BEYN" as a little-endian integer.
+inline constexpr std::uint32_t kNetMagic = 0x4E594542u;
+
+/// Bumped whenever a wire header or the segment encoding changes shape.
+inline constexpr std::uint16_t kNetFormatVersion = 1;
+
+/// Sample encoding on the wire (matches OutputPrecision).
+enum class NetPrecision : std::uint8_t
+{
+    kFloat64 = 0,
+    kFloat32,
+
+    /** @brief int32 counts of NetDatagramHeader::q32_scale_m metres. */
+    kFixed32,
+};
+
+enum class NetDatagramKind : std::uint8_t
+{
+    /** @brief Rows changed since base_seqno. */
+    kDelta = 0,
+
+    /** @brief Every row with a status; no base. */
+    kKeyframe,
+};
+
+enum class NetSegmentKind : std::uint8_t
+{
+    /** @brief Grid offsets tau[first_step, first_step + count). */
+    kTau = 0,
+
+    /** @brief Row samples; count 0 carries the status (and epoch) of a row without samples. */
+    kRow,
+};
+
+struct NetDatagramHeader final
+{
+    std::uint32_t magic{0};
+    std::uint16_t version{0};
+
+    /// NetDatagramKind.
+    std::uint8_t kind{0};
+
+    /// NetPrecision of every row payload in this datagram.
+    std::uint8_t precision{0};
+
+    /// Per-sender datagram counter (receivers count gaps as lost datagrams).
+    std::uint64_t packet_seq{0};
+
+    std::uint64_t seqno{0};
+
+    /// Snapshot this delta applies to; 0 for a keyframe.
+    std::uint64_t base_seqno{0};
+
+    double t0{0.0};
+    RowMask valid_rows{0};
+    std::uint16_t fragment{0};
+    std::uint16_t fragments{0};
+    std::uint16_t segments{0};
+    std::uint16_t steps{0};
+    double q32_scale_m{0.0};
+};
+
+struct NetSegmentHeader final
+{
+    /// NetSegmentKind.
+    std::uint8_t kind{0};
+
+    /// RowStatus (rows only).
+    std::uint8_t status{0};
+
+    std::uint16_t row{0};
+    std::uint16_t first_step{0};
+    std::uint16_t count{0};
+    std::uint64_t row_seqno{0};
+    double row_t0{0.0};
+};
+
+enum class NetCode : std::uint8_t
+{
+    kOk = 0,
+
+    /** @brief Bad address, port or datagram size, or the publisher is already running. */
+    kInvalidInput,
+
+    /** @brief No BSD sockets on this platform. */
+    kUnsupported,
+
+    /** @brief socket(), setsockopt(), bind() or connect() failed. */
+    kSocketFailed,
+};
+
+/**
+ * @brief Encoder options.
+ */
+struct NetEncoderConfig final
+{
+    /** @brief Datagram size cap, headers included (>= 256; 1400 stays under a 1500 MTU). */
+    std::size_t max_datagram_bytes{1400};
+
+    NetPrecision precision{NetPrecision::kFloat64};
+
+    /** @brief Send a keyframe at least every this many encoded snapshots (>= 1). */
+    std::size_t keyframe_interval{50};
+
+    /**
+     * @brief Rows and steps to send; everything else stays local.
+     *
+     * For a group whose subscribers share one Subscription filter (see snapshot_view.hpp).
+     * The mirror then holds only those rows (valid_rows is masked) and samples
+     * [first_step, steps); rows outside the filter read as RowStatus::kEmpty.
+     */
+    SubscriptionFilter filter{};
+};
+
+/** @brief One scatter-gather piece of a datagram. */
+struct NetFramePiece final
+{
+    const void* data{nullptr};
+    std::size_t bytes{0};
+};
+
+/**
+ * @brief Splits snapshots into delta or keyframe datagrams that reference the snapshot memory.
+ *
+ * The pieces of the last encode() stay valid until the next encode() and only while the
+ * encoded snapshot is unchanged (hold its lease until the datagrams are sent).
+ */
+class SnapshotDeltaEncoder final
+{
+  public:
+    explicit SnapshotDeltaEncoder(const NetEncoderConfig& config = NetEncoderConfig{});
+
+    /**
+     * @brief Encode @p buf as a delta against the previous encode(), or as a keyframe when
+     *        @p keyframe is set, none was encoded yet, the interval is due, or after reset().
+     *
+     * @return Number of datagrams (>= 1).
+     */
+    std::size_t encode(const PredictionBuffer& buf, bool keyframe = false);
+
+    /** @brief Make the next encode() a keyframe (e.g. the last datagrams were not sent). */
+    void reset() noexcept { base_seqno_ = 0; }
+
+    [[nodiscard]] std::size_t frame_count() const noexcept { return frames_.size(); }
+
+    /** @brief Pieces of datagram @p i of the last encode(). */
+    [[nodiscard]] Span<const NetFramePiece> frame(std::size_t i) const noexcept
+    {
+        return {pieces_.data() + frames_[i].first_piece, frames_[i].pieces};
+    }
+
+    /** @brief Size of datagram @p i [bytes]. */
+    [[nodiscard]] std::size_t frame_bytes(std::size_t i) const noexcept
+    {
+        return frames_[i].bytes;
+    }
+
+    /** @brief True if the last encode() produced a keyframe. */
+    [[nodiscard]] bool last_was_keyframe() const noexcept { return last_keyframe_; }
+
+    [[nodiscard]] const NetEncoderConfig& config() const noexcept { return config_; }
+
+  private:
+    struct Frame final
+    {
+        std::size_t first_segment{0};
+        std::size_t segments{0};
+        std::size_t first_piece{0};
+        std::size_t pieces{0};
+        std::size_t bytes{0};
+    };
+
+    // Split @p count elements of @p elem bytes at @p data (sample @p base of the row) over the
+    // open and new datagrams.
+    void add_segment_(NetSegmentHeader seg,
+                      const unsigned char* data,
+                      std::size_t base,
+                      std::size_t count,
+                      std::size_t elem);
+    void open_frame_();
+
+    NetEncoderConfig config_;
+
+    std::uint64_t base_seqno_{0};
+    std::size_t since_keyframe_{0};
+    std::uint64_t packet_seq_{0};
+    bool last_keyframe_{false};
+
+    // Grid of the previous encode(): tau is only resent when it changes.
+    std::size_t last_steps_{0};
+    std::vector<double> last_tau_{};
+
+    std::vector<NetDatagramHeader> headers_{};
+    std::vector<NetSegmentHeader> segments_{};
+    std::vector<NetFramePiece> payloads_{};
+    std::vector<NetFramePiece> pieces_{};
+    std::vector<Frame> frames_{};
+    std::size_t room_{0};
+};
+
+enum class NetDecodeResult : std::uint8_t
+{
+    /** @brief Accepted; the snapshot is not complete yet. */
+    kPartial = 0,
+
+    /** @brief Accepted and completed a snapshot: snapshot() holds it. */
+    kComplete,
+
+    /** @brief Dropped: duplicate, stale, or waiting for a keyframe after a loss. */
+    kIgnored,
+
+    /** @brief Not a datagram of this format, or inconsistent sizes. */
+    kMalformed,
+};
+
+struct NetDecoderStats final
+{
+    std::uint64_t snapshots{0};
+    std::uint64_t keyframes{0};
+
+    /** @brief Datagrams missing from the sender's packet_seq sequence. */
+    std::uint64_t lost_datagrams{0};
+
+    /** @brief Times the mirror lost sync and waited for a keyframe. */
+    std::uint64_t resyncs{0};
+
+    std::uint64_t ignored{0};
+    std::uint64_t malformed{0};
+};
+
+/**
+ * @brief Rebuilds snapshots from datagrams into a local mirror (positions in doubles).
+ *
+ * Datagrams are applied to the mirror as they arrive. snapshot() is consistent after apply()
+ * returned kComplete and until the next apply(); copy it out (or republish it) if it must
+ * outlive that. Single-threaded.
+ */
+class SnapshotDeltaDecoder final
+{
+  public:
+    SnapshotDeltaDecoder();
+
+    NetDecodeResult apply(const void* datagram, std::size_t bytes) noexcept;
+
+    /** @brief Last completed snapshot (velocities and reduced-precision planes detached). */
+    [[nodiscard]] const PredictionBuffer& snapshot() const noexcept { return *mirror_; }
+
+    /** @brief True while deltas can be applied (a keyframe arrived and nothing was lost). */
+    [[nodiscard]] bool synced() const noexcept { return synced_; }
+
+    /** @brief Seqno of the last completed snapshot (0 before the first). */
+    [[nodiscard]] std::uint64_t seqno() const noexcept { return complete_seqno_; }
+
+    [[nodiscard]] const NetDecoderStats& stats() const noexcept { return stats_; }
+
+  private:
+    bool begin_(const NetDatagramHeader& h) noexcept;
+
+    std::unique_ptr<PredictionBuffer> mirror_{};
+    bool synced_{false};
+    std::uint64_t complete_seqno_{0};
+
+    // Snapshot being assembled (0 = none) and the fragments received so far.
+    std::uint64_t assembling_{0};
+    std::uint8_t assembling_kind_{0};
+    std::uint64_t assembling_base_{0};
+    std::vector<std::uint8_t> got_{};
+    std::size_t got_count_{0};
+
+    std::uint64_t next_packet_{0};
+    NetDecoderStats stats_{};
+};
+
+/**
+ * @brief Destination and socket options.
+ */
+struct MulticastConfig final
+{
+    /** @brief IPv4 group (e.g. "239.255.42.1"); a unicast address sends to one host. */
+    const char* address{"239.255.42.1"};
+    std::uint16_t port{47001};
+
+    /** @brief Outgoing interface address for multicast (nullptr: the routing default). */
+    const char* interface_address{nullptr};
+
+    /** @brief Multicast hop limit (1 = local subnet). */
+    int ttl{1};
+
+    /** @brief Deliver to receivers on this host as well. */
+    bool loopback{true};
+
+    NetEncoderConfig encoder{};
+
+    /** @brief Longest wait for a publish before the thread re-checks stop() [s]. */
+    double poll_sec{0.05};
+};
+
+struct MulticastPublisherStats final
+{
+    std::uint64_t snapshots{0};
+    std::uint64_t keyframes{0};
+    std::uint64_t datagrams{0};
+    std::uint64_t bytes{0};
+
+    /** @brief Snapshots not sent in full (socket error); the next one is a keyframe. */
+    std::uint64_t send_errors{0};
+
+    /** @brief Snapshots rewritten by the producer while being sent; the next is a keyframe. */
+    std::uint64_t torn{0};
+};
+
+/**
+ * @brief Sends a Publisher's snapshots to a UDP (multicast) destination from its own thread.
+ *
+ * The thread wakes on each publish, leases the newest snapshot (intermediate ones are folded
+ * into the delta, so a slow network never makes it queue), encodes and sends it with one
+ * sendmmsg() per batch. The producer never waits. Give the publisher PublisherConfig::slots
+ * >= 3 so the leased snapshot is not rewritten during the send.
+ */
+class MulticastPublisher final
+{
+  public:
+    explicit MulticastPublisher(const Publisher& publisher,
+                                const MulticastConfig& config = MulticastConfig{});
+    ~MulticastPublisher();
+
+    MulticastPublisher(const MulticastPublisher&) = delete;
+    MulticastPublisher& operator=(const MulticastPublisher&) = delete;
+
+    /** @brief Open the socket and start the thread. */
+    [[nodiscard]] NetCode start();
+
+    /** @brief Stop the thread and close the socket (idempotent). */
+    void stop() noexcept;
+
+    [[nodiscard]] bool running() const noexcept { return running_; }
+
+    /** @brief Wait until the newest published snapshot was handled; false on timeout. */
+    bool wait_caught_up(double timeout_sec) const noexcept;
+
+    [[nodiscard]] MulticastPublisherStats stats() const noexcept;
+
+  private:
+    void thread_main_() noexcept;
+
+    // Send every datagram of the last encode(); false on a short or failed send.
+    bool send_frames_() noexcept;
+
+    const Publisher& pub_;
+    MulticastConfig config_;
+    SnapshotDeltaEncoder encoder_;
+
+    int fd_{-1};
+    std::thread thread_{};
+    bool running_{false};
+    std::atomic<bool> stop_{false};
+    std::atomic<std::uint64_t> done_seqno_{0};
+
+    std::atomic<std::uint64_t> snapshots_{0};
+    std::atomic<std::uint64_t> keyframes_{0};
+    std::atomic<std::uint64_t> datagrams_{0};
+    std::atomic<std::uint64_t> bytes_{0};
+    std::atomic<std::uint64_t> send_errors_{0};
+    std::atomic<std::uint64_t> torn_{0};
+};
+
+/**
+ * @brief Receives datagrams for one (multicast) address and port into a decoder.
+ */
+class MulticastReceiver final
+{
+  public:
+    MulticastReceiver() = default;
+    ~MulticastReceiver();
+
+    MulticastReceiver(const MulticastReceiver&) = delete;
+    MulticastReceiver& operator=(const MulticastReceiver&) = delete;
+
+    /**
+     * @brief Bind config.port and, for a multicast config.address, join the group (on
+     *        config.interface_address when set).
+     */
+    [[nodiscard]] NetCode open(const MulticastConfig& config);
+
+    void close() noexcept;
+
+    [[nodiscard]] bool is_open() const noexcept { return fd_ >= 0; }
+
+    /**
+     * @brief Feed every datagram that arrives within @p timeout_sec to @p decoder.
+     *
+     * Returns at the first completed snapshot (so the caller can read decoder.snapshot()
+     * before the next datagram is applied) or at the timeout.
+     *
+     * @return true if a snapshot was completed.
+     */
+    bool receive(SnapshotDeltaDecoder& decoder, double timeout_sec);
+
+  private:
+    int fd_{-1};
+    std::vector<unsigned char> buffer_{};
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,245 @@
+#include "core/page_placement.hpp"
+
+#include <cstdint>
+
+#if defined(__linux__)
+#define BULLSEYE_HAVE_PAGE_PLACEMENT 1
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bullseye_pred
+{
+
+#if defined(BULLSEYE_HAVE_PAGE_PLACEMENT)
+
+namespace
+{
+
+// <numaif.h> values; spelled out so the build does not need libnuma headers.
+constexpr int kMpolBind = 2;
+constexpr unsigned kMpolMfMove = 1u << 1;
+constexpr int kMaxNumaNode = 63;
+
+std::size_t base_page_bytes() noexcept
+{
+    const long page = ::sysconf(_SC_PAGESIZE);
+    return (page > 0) ? static_cast<std::size_t>(page) : std::size_t{4096};
+}
+
+std::size_t round_up(std::size_t bytes, std::size_t unit) noexcept
+{
+    return (bytes + unit - 1u) / unit * unit;
+}
+
+int resolve_node(int node) noexcept
+{
+    return (node == kNumaLocal) ? current_numa_node() : node;
+}
+
+// mbind() through the raw syscall (no libnuma dependency); MPOL_MF_MOVE migrates pages that
+// are already resident.
+bool bind_node(void* base, std::size_t bytes, int node) noexcept
+{
+    if (node < 0 || node > kMaxNumaNode)
+    {
+        return false;
+    }
+    const unsigned long mask = 1ul << static_cast<unsigned>(node);
+    return ::syscall(SYS_mbind, base, bytes, kMpolBind, &mask,
+                     static_cast<unsigned long>(kMaxNumaNode + 2), kMpolMfMove) == 0;
+}
+
+// Read and write back one byte per page: faults the page in (on the bound node) without
+// changing its contents.
+void touch_pages(void* base, std::size_t bytes, std::size_t page) noexcept
+{
+    auto* const p = static_cast<volatile unsigned char*>(base);
+    for (std::size_t off = 0; off < bytes; off += page)
+    {
+        p[off] = p[off];
+    }
+}
+
+} // namespace
+
+int current_numa_node() noexcept
+{
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) != 0)
+    {
+        return 0;
+    }
+    return static_cast<int>(node);
+}
+
+PlacementReport apply_page_placement(void* base,
+                                     std::size_t bytes,
+                                     const PagePlacement& placement) noexcept
+{
+    PlacementReport report{};
+    if (base == nullptr || bytes == 0u)
+    {
+        return report;
+    }
+#if defined(MADV_HUGEPAGE)
+    if (placement.huge_pages)
+    {
+        report.thp_hint = ::madvise(base, bytes, MADV_HUGEPAGE) == 0;
+    }
+#endif
+    if (placement.numa_node != kNumaAny)
+    {
+        const int node = resolve_node(placement.numa_node);
+        if (bind_node(base, bytes, node))
+        {
+            report.numa_node = node;
+        }
+    }
+    if (placement.prefault)
+    {
+        touch_pages(base, bytes, base_page_bytes());
+        report.prefaulted = true;
+    }
+    return report;
+}
+
+PlacedMapping::~PlacedMapping()
+{
+    reset();
+}
+
+bool PlacedMapping::map(std::size_t bytes, const PagePlacement& placement) noexcept
+{
+    reset();
+    if (bytes == 0u)
+    {
+        return false;
+    }
+
+    constexpr int kProt = PROT_READ | PROT_WRITE;
+    constexpr int kFlags = MAP_PRIVATE | MAP_ANONYMOUS;
+    void* p = MAP_FAILED;
+    std::size_t len = 0;
+    bool hugetlb = false;
+
+#if defined(MAP_HUGETLB)
+    // Explicit 2 MB pages come from the reserved pool; fails cleanly when none are reserved.
+    if (placement.huge_pages)
+    {
+        len = round_up(bytes, kHugePageBytes);
+        p = ::mmap(nullptr, len, kProt, kFlags | MAP_HUGETLB, -1, 0);
+        hugetlb = (p != MAP_FAILED);
+    }
+#endif
+
+    if (p == MAP_FAILED && placement.huge_pages)
+    {
+        // Base pages, 2 MB-aligned so the THP hint can back the whole range: over-map by one
+        // huge page and trim both ends.
+        len = round_up(bytes, kHugePageBytes);
+        void* const raw = ::mmap(nullptr, len + kHugePageBytes, kProt, kFlags, -1, 0);
+        if (raw != MAP_FAILED)
+        {
+            const auto addr = reinterpret_cast<std::uintptr_t>(raw);
+            const std::uintptr_t aligned = round_up(addr, kHugePageBytes);
+            const std::size_t head = aligned - addr;
+            if (head != 0u)
+            {
+                (void)::munmap(raw, head);
+            }
+            const std::size_t tail = kHugePageBytes - head;
+            if (tail != 0u)
+            {
+                (void)::munmap(reinterpret_cast<void*>(aligned + len), tail);
+            }
+            p = reinterpret_cast<void*>(aligned);
+        }
+    }
+
+    if (p == MAP_FAILED)
+    {
+        len = round_up(bytes, base_page_bytes());
+        p = ::mmap(nullptr, len, kProt, kFlags, -1, 0);
+        if (p == MAP_FAILED)
+        {
+            return false;
+        }
+    }
+
+    base_ = p;
+    bytes_ = len;
+
+    // Bind before the first touch so pre-fault allocates on the chosen node.
+    PagePlacement rest = placement;
+    rest.huge_pages = placement.huge_pages && !hugetlb;
+    rest.prefault = false;
+    report_ = apply_page_placement(base_, bytes_, rest);
+    report_.huge_pages = hugetlb;
+    if (placement.prefault)
+    {
+        touch_pages(base_, bytes_, hugetlb ? kHugePageBytes : base_page_bytes());
+        report_.prefaulted = true;
+    }
+    return true;
+}
+
+void PlacedMapping::reset() noexcept
+{
+    if (base_ != nullptr)
+    {
+        (void)::munmap(base_, bytes_);
+    }
+    base_ = nullptr;
+    bytes_ = 0;
+    report_ = PlacementReport{};
+}
+
+#else
+
+int current_numa_node() noexcept
+{
+    return 0;
+}
+
+PlacementReport apply_page_placement(void* base,
+                                     std::size_t bytes,
+                                     const PagePlacement& placement) noexcept
+{
+    PlacementReport report{};
+    if (base != nullptr && placement.prefault)
+    {
+        // Without page-size queries, touch at the smallest common page size.
+        auto* const p = static_cast<volatile unsigned char*>(base);
+        for (std::size_t off = 0; off < bytes; off += 4096u)
+        {
+            p[off] = p[off];
+        }
+        report.prefaulted = true;
+    }
+    return report;
+}
+
+PlacedMapping::~PlacedMapping()
+{
+    reset();
+}
+
+bool PlacedMapping::map(std::size_t, const PagePlacement&) noexcept
+{
+    // No anonymous mappings here; the Publisher keeps its heap buffers.
+    return false;
+}
+
+void PlacedMapping::reset() noexcept
+{
+    base_ = nullptr;
+    bytes_ = 0;
+    report_ = PlacementReport{};
+}
+
+#endif
+
+} // namespace bullseye_pred
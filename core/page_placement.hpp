@@ -0,0 +1,136 @@
+#pragma once
+/**
+ * @file page_placement.hpp
+ * @brief Init-time page placement for large snapshot storage (huge pages, pre-fault, NUMA).
+ *
+ * @details
+ * A Publisher buffer is ~460 KB and every slot and optional plane adds more. Left to the
+ * kernel, those pages are faulted in on the first begin_write() of a live tick and land on
+ * whichever NUMA node that first touch ran on. PagePlacement moves both decisions to init:
+ * PlacedMapping maps anonymous storage (2 MB pages where available), binds it to a node and
+ * touches every page before the first tick; apply_page_placement() does the same for a region
+ * mapped elsewhere (a shared-memory segment).
+ *
+ * Every option degrades instead of failing: without hugetlb pages the mapping falls back to
+ * base pages (with a transparent-huge-page hint), and a binding the kernel rejects leaves the
+ * default policy. PlacementReport records what was actually applied. Nothing here is called
+ * on the publish path.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace bullseye_pred
+{
+
+/** @brief PagePlacement::numa_node value: leave the kernel's default policy. */
+inline constexpr int kNumaAny = -1;
+
+/** @brief PagePlacement::numa_node value: the node of the CPU running the constructor. */
+inline constexpr int kNumaLocal = -2;
+
+/**
+ * @brief Where and how init-time storage is backed.
+ */
+struct PagePlacement final
+{
+    /**
+     * @brief Back the storage with 2 MB pages.
+     *
+     * Tries explicit hugetlb pages first, then base pages with a transparent-huge-page hint.
+     */
+    bool huge_pages{false};
+
+    /** @brief Touch every page at init so no page fault lands in a tick. */
+    bool prefault{false};
+
+    /**
+     * @brief NUMA node to bind the pages to (>= 0), kNumaLocal, or kNumaAny (default).
+     *
+     * Bind to the producer's node when the predictor thread writes most, or to the consumers'
+     * node when readers dominate; kNumaLocal picks the node the constructing thread runs on.
+     */
+    int numa_node{kNumaAny};
+
+    /// @return true if any option differs from the default heap placement.
+    [[nodiscard]] bool requested() const noexcept
+    {
+        return huge_pages || prefault || numa_node != kNumaAny;
+    }
+};
+
+/**
+ * @brief What apply_page_placement() / PlacedMapping::map() actually applied.
+ */
+struct PlacementReport final
+{
+    /** @brief Backed by explicit hugetlb pages. */
+    bool huge_pages{false};
+
+    /** @brief Transparent huge pages were requested (MADV_HUGEPAGE accepted). */
+    bool thp_hint{false};
+
+    /** @brief Every page was touched at init. */
+    bool prefaulted{false};
+
+    /** @brief Node the pages are bound to, or kNumaAny if no binding was applied. */
+    int numa_node{kNumaAny};
+};
+
+/** @brief Hugetlb page size used by PagePlacement::huge_pages [bytes]. */
+inline constexpr std::size_t kHugePageBytes = std::size_t{2} << 20;
+
+/**
+ * @brief NUMA node of the calling thread's current CPU (0 if unknown or not NUMA).
+ */
+[[nodiscard]] int current_numa_node() noexcept;
+
+/**
+ * @brief Apply the THP hint, binding and pre-fault of @p placement to a mapped region.
+ *
+ * For storage mapped by someone else (e.g. ShmMapping). Explicit hugetlb pages need the
+ * region to be mapped that way up front, so huge_pages only sets the THP hint here. Pre-fault
+ * writes every page without changing its contents, so it is safe on initialized storage that
+ * no other thread is writing yet.
+ */
+PlacementReport apply_page_placement(void* base,
+                                     std::size_t bytes,
+                                     const PagePlacement& placement) noexcept;
+
+/**
+ * @brief RAII anonymous mapping placed according to a PagePlacement.
+ */
+class PlacedMapping final
+{
+  public:
+    PlacedMapping() = default;
+    ~PlacedMapping();
+
+    PlacedMapping(const PlacedMapping&) = delete;
+    PlacedMapping& operator=(const PlacedMapping&) = delete;
+
+    /**
+     * @brief Map @p bytes of zeroed, private storage and place it.
+     *
+     * @return false if no storage could be mapped at all (mapped() stays false).
+     */
+    [[nodiscard]] bool map(std::size_t bytes, const PagePlacement& placement) noexcept;
+
+    /// @brief Unmap; idempotent.
+    void reset() noexcept;
+
+    [[nodiscard]] bool mapped() const noexcept { return base_ != nullptr; }
+    [[nodiscard]] void* data() const noexcept { return base_; }
+
+    /// @return mapped length (rounded up to the page size used).
+    [[nodiscard]] std::size_t size() const noexcept { return bytes_; }
+
+    [[nodiscard]] const PlacementReport& report() const noexcept { return report_; }
+
+  private:
+    void* base_{nullptr};
+    std::size_t bytes_{0};
+    PlacementReport report_{};
+};
+
+} // namespace bullseye_pred
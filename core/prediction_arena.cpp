@@ -0,0 +1,39 @@
+#include "core/prediction_arena.hpp"
+
+#include <cstring>
+
+namespace bullseye_pred
+{
+
+PredictionArena::PredictionArena(std::size_t bytes) noexcept
+{
+    // Over-allocate by one alignment unit so the usable region starts on a kAlign boundary.
+    if (bytes == 0u || bytes > static_cast<std::size_t>(-1) - kAlign)
+    {
+        return;
+    }
+    storage_.reset(new (std::nothrow) unsigned char[bytes + kAlign]);
+    if (!storage_)
+    {
+        return;
+    }
+    const auto addr = reinterpret_cast<std::uintptr_t>(storage_.get());
+    const std::size_t pad = (kAlign - (addr % kAlign)) % kAlign;
+    base_ = storage_.get() + pad;
+    capacity_ = bytes;
+}
+
+void* PredictionArena::allocate(std::size_t bytes) noexcept
+{
+    const std::size_t size = block_bytes(bytes);
+    if (base_ == nullptr || size < bytes || size > capacity_ - used_)
+    {
+        return nullptr;
+    }
+    unsigned char* p = base_ + used_;
+    used_ += size;
+    std::memset(p, 0, size);
+    return p;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,86 @@
+#pragma once
+/**
+ * @file prediction_arena.hpp
+ * @brief Fixed-size bump arena for init-time output storage.
+ *
+ * @details
+ * One allocation is made at construction; allocate() carves aligned blocks from it and never
+ * frees individually. Intended for storage whose size is chosen at init (e.g. SizedPublisher
+ * planes), so steady-state code never touches the heap.
+ *
+ * Not thread-safe; allocate during initialization only.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace bullseye_pred
+{
+
+class PredictionArena final
+{
+  public:
+    /// Alignment of every block (cache line).
+    static constexpr std::size_t kAlign = 64;
+
+    PredictionArena() = default;
+
+    /**
+     * @brief Reserve @p bytes of zeroed storage.
+     *
+     * On allocation failure the arena is empty (valid() == false, capacity() == 0).
+     */
+    explicit PredictionArena(std::size_t bytes) noexcept;
+
+    PredictionArena(const PredictionArena&) = delete;
+    PredictionArena& operator=(const PredictionArena&) = delete;
+
+    /**
+     * @brief Carve a zeroed, kAlign-aligned block.
+     *
+     * @return nullptr if the arena cannot hold @p bytes more (nothing is consumed).
+     */
+    [[nodiscard]] void* allocate(std::size_t bytes) noexcept;
+
+    /**
+     * @brief Carve a zeroed array of @p count trivially-copyable elements.
+     *
+     * @return nullptr if the arena is exhausted.
+     */
+    template <typename T>
+    [[nodiscard]] T* allocate_array(std::size_t count) noexcept
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "arena arrays are not destroyed");
+        static_assert(alignof(T) <= kAlign, "arena alignment too small");
+        if (count > static_cast<std::size_t>(-1) / sizeof(T))
+        {
+            return nullptr;
+        }
+        void* p = allocate(count * sizeof(T));
+        return (p != nullptr) ? new (p) T[count]() : nullptr;
+    }
+
+    /// @brief Bytes that allocate(@p bytes) consumes (rounded up to kAlign).
+    [[nodiscard]] static constexpr std::size_t block_bytes(std::size_t bytes) noexcept
+    {
+        return (bytes + kAlign - 1u) / kAlign * kAlign;
+    }
+
+    /// @brief Drop every block (storage is kept and re-zeroed on the next allocate()).
+    void reset() noexcept { used_ = 0; }
+
+    [[nodiscard]] bool valid() const noexcept { return base_ != nullptr; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] std::size_t used() const noexcept { return used_; }
+
+  private:
+    std::unique_ptr<unsigned char[]> storage_{};
+    unsigned char* base_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t used_{0};
+};
+
+} // namespace bullseye_pred
@@ -1,20 +1,452 @@
 #pragma once
 
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 
+#include "core/closest_approach.hpp"
+#include "core/state_covariance.hpp"
+#include "core/trajectory_coefficients.hpp"
 #include "core/types.hpp"
 #include "core/constants.hpp"
+#include "models/model_selector.hpp"
+#include "models/relative_model.hpp"
 
 namespace bullseye_pred
 {
 
+/** @brief One Vec3 per (vehicle index, grid step); vehicle-major. */
+using TrajectoryPlane = std::array<std::array<Vec3, MAX_STEPS>, MAX_VEHICLES>;
+
+/** @brief One PositionCovariance per (vehicle index, grid step); vehicle-major. */
+using CovariancePlane = std::array<std::array<PositionCovariance, MAX_STEPS>, MAX_VEHICLES>;
+
+/** @brief One bit per vehicle row (bit i = row i). */
+using RowMask = std::uint64_t;
+static_assert(MAX_VEHICLES <= 64, "RowMask holds one bit per vehicle row");
+
+/** @brief Mask with a bit set for every row index [0, MAX_VEHICLES). */
+inline constexpr RowMask kAllRows =
+    (MAX_VEHICLES == 64) ? ~RowMask{0} : ((RowMask{1} << (MAX_VEHICLES % 64)) - 1u);
+
+/**
+ * @brief Outcome of one vehicle row in a snapshot.
+ */
+enum class RowStatus : std::uint8_t
+{
+    /** @brief No vehicle at this index, or the row was not produced (default). */
+    kEmpty = 0,
+
+    /** @brief Predicted in full this tick. */
+    kOk,
+
+    /** @brief Shifted from the previous snapshot plus a new tail (sliding-window reuse). */
+    kReused,
+
+    /** @brief Deputy state provider failed; row holds stale data. */
+    kProviderError,
+
+    /** @brief Deputy frame_id differs from the chief's; row holds stale data. */
+    kFrameMismatch,
+
+    /** @brief The model rejected or failed the row; row holds stale data. */
+    kModelError,
+};
+
+/**
+ * @brief Component-plane (structure-of-arrays) layout of the positions.
+ */
+enum class SoaLayout : std::uint8_t
+{
+    /** @brief No SoA planes (positions only; default). */
+    kNone = 0,
+
+    /** @brief plane[a][vehicle][step]: contiguous time series per vehicle and axis. */
+    kVehicleMajor,
+
+    /** @brief plane[a][step][vehicle]: contiguous cross-vehicle slice per step and axis. */
+    kStepMajor,
+};
+
+/** @brief RIC position component (SoaPositionPlanes plane index). */
+enum class RicAxis : std::uint8_t
+{
+    kR = 0,
+    kI = 1,
+    kC = 2,
+};
+
+/**
+ * @brief Positions split into one plane of doubles per RIC axis.
+ *
+ * Same data as PredictionBuffer::positions, laid out for consumers (range checks, plotting)
+ * and vector-width kernels that want contiguous components. view() hides the layout behind a
+ * Span2D whose rows are vehicles (kVehicleMajor) or steps (kStepMajor).
+ */
+struct SoaPositionPlanes final
+{
+    static constexpr std::size_t kPlaneSize = MAX_VEHICLES * MAX_STEPS;
+
+    SoaLayout layout{SoaLayout::kVehicleMajor};
+    std::array<std::array<double, kPlaneSize>, 3> planes{};
+
+    /** @brief Offset of (vehicle i, step k) within a plane. */
+    [[nodiscard]] std::size_t index(std::size_t i, std::size_t k) const noexcept
+    {
+        return (layout == SoaLayout::kStepMajor) ? k * MAX_VEHICLES + i : i * MAX_STEPS + k;
+    }
+
+    [[nodiscard]] double at(RicAxis a, std::size_t i, std::size_t k) const noexcept
+    {
+        return planes[static_cast<std::size_t>(a)][index(i, k)];
+    }
+
+    /** @brief Write (vehicle i, step k) to all three planes. */
+    void set(std::size_t i, std::size_t k, const Vec3& r) noexcept
+    {
+        const std::size_t j = index(i, k);
+        planes[0][j] = r.x;
+        planes[1][j] = r.y;
+        planes[2][j] = r.z;
+    }
+
+    /**
+     * @brief Plane @p a over @p vehicles x @p steps.
+     *
+     * kVehicleMajor: row(i) is vehicle i's series over [0, steps).
+     * kStepMajor: row(k) is step k's slice over vehicles [0, vehicles).
+     */
+    [[nodiscard]] Span2D<const double> view(RicAxis a,
+                                            std::size_t vehicles,
+                                            std::size_t steps) const noexcept
+    {
+        const double* p = planes[static_cast<std::size_t>(a)].data();
+        return (layout == SoaLayout::kStepMajor)
+                   ? Span2D<const double>{p, steps, vehicles, MAX_VEHICLES}
+                   : Span2D<const double>{p, vehicles, steps, MAX_STEPS};
+    }
+
+    /** @brief Mutable view() for producer kernels writing the planes directly. */
+    [[nodiscard]] Span2D<double> view(RicAxis a, std::size_t vehicles, std::size_t steps) noexcept
+    {
+        double* p = planes[static_cast<std::size_t>(a)].data();
+        return (layout == SoaLayout::kStepMajor) ? Span2D<double>{p, steps, vehicles, MAX_VEHICLES}
+                                                 : Span2D<double>{p, vehicles, steps, MAX_STEPS};
+    }
+};
+
+/**
+ * @brief Reduced-precision copy of the published positions (PublisherConfig::precision).
+ */
+enum class OutputPrecision : std::uint8_t
+{
+    /** @brief Doubles only (default). */
+    kFloat64 = 0,
+
+    /** @brief Additional float32 plane (positions_f32). */
+    kFloat32,
+
+    /** @brief Additional fixed-point int32 plane (positions_q32, q32_scale_m metres per count). */
+    kFixed32,
+};
+
+using Vec3f = BasicVec3<float>;
+
+struct Vec3q final
+{
+    std::int32_t x{0};
+    std::int32_t y{0};
+    std::int32_t z{0};
+};
+
+using Float32Plane = std::array<std::array<Vec3f, MAX_STEPS>, MAX_VEHICLES>;
+using Fixed32Plane = std::array<std::array<Vec3q, MAX_STEPS>, MAX_VEHICLES>;
+
+/// Fixed-point code of a non-finite component; finite values saturate to +/-INT32_MAX.
+inline constexpr std::int32_t kFixed32Invalid = INT32_MIN;
+
+/**
+ * @brief Round @p v [m] to counts of @p scale_m, saturating (flagged via @p saturated).
+ */
+[[nodiscard]] inline std::int32_t quantize_fixed32(double v, double scale_m,
+                                                   bool& saturated) noexcept
+{
+    if (!std::isfinite(v))
+    {
+        return kFixed32Invalid;
+    }
+    constexpr double kMax = static_cast<double>(INT32_MAX);
+    const double q = std::nearbyint(v / scale_m);
+    if (q > kMax || q < -kMax)
+    {
+        saturated = true;
+        return (q > 0.0) ? INT32_MAX : -INT32_MAX;
+    }
+    return static_cast<std::int32_t>(q);
+}
+
+/** @brief Metres of a fixed-point component (NaN for kFixed32Invalid). */
+[[nodiscard]] inline double dequantize_fixed32(std::int32_t q, double scale_m) noexcept
+{
+    return (q == kFixed32Invalid) ? std::numeric_limits<double>::quiet_NaN()
+                                  : static_cast<double>(q) * scale_m;
+}
+
 struct PredictionBuffer final
 {
     std::uint64_t seqno{0};
     double t0{0.0};
-    std::array<std::array<Vec3, MAX_STEPS>, MAX_VEHICLES> positions{};
+
+    /** @brief Grid samples written per row (<= MAX_STEPS); entries [0, steps) are meaningful. */
+    std::size_t steps{0};
+
+    /** @brief Grid offsets from t0 [s] of the samples; tau[k] pairs with positions[i][k]. */
+    std::array<double, MAX_STEPS> tau{};
+
+    /**
+     * @brief Samples and offsets of grid profiles 1.. (entry p - 1 is profile p); steps and
+     *        tau above are profile 0. A profile no row used this tick has 0 steps.
+     */
+    std::array<std::size_t, MAX_GRID_PROFILES - 1> profile_steps{};
+    std::array<std::array<double, MAX_STEPS>, MAX_GRID_PROFILES - 1> profile_tau{};
+
+    /** @brief Rows the producer considered this tick ([0, vehicles) carry a row_status). */
+    std::size_t vehicles{0};
+
+    /**
+     * @brief Bit i set iff row i holds data (kOk or kReused): this snapshot's, or for a row in
+     *        deferred_rows, that of snapshot row_seqno[i].
+     */
+    RowMask valid_rows{0};
+
+    /** @brief Per-row outcome; rows >= vehicles are kEmpty. */
+    std::array<RowStatus, MAX_VEHICLES> row_status{};
+
+    /**
+     * @brief Grid profile each row is sampled on (0: steps / tau); see row_steps(), row_tau().
+     *
+     * Rows on a coarser or shorter profile fill only the first row_steps(i) samples.
+     */
+    std::array<std::uint8_t, MAX_VEHICLES> row_grid{};
+
+    /**
+     * @brief Bit i set iff row i changed from the previous snapshot (seqno - 1).
+     *
+     * Stamped by Publisher::publish(); rows published clean were carried over unchanged.
+     */
+    RowMask dirty_rows{0};
+
+    /** @brief Seqno of the snapshot in which each row last changed (0 = never written). */
+    std::array<std::uint64_t, MAX_VEHICLES> row_seqno{};
+
+    /**
+     * @brief t0 of snapshot row_seqno[i]: the epoch row i's samples are offset from.
+     *
+     * Equals t0 for rows changed in this snapshot; older for rows carried over. Stamped by
+     * Publisher::publish().
+     */
+    std::array<double, MAX_VEHICLES> row_t0{};
+
+    /**
+     * @brief Bit i set iff row i was due this tick but deferred by the producer's tick budget.
+     *
+     * Its samples, status and valid bit are carried over from snapshot row_seqno[i] (epoch
+     * row_t0[i]). Set by the producer (TickBudgetConfig); 0 otherwise.
+     */
+    RowMask deferred_rows{0};
+
+    /**
+     * @brief Bit i set iff the producer skipped row i because its new initial state matched
+     *        the carried trajectory (change detection, TrajectoryReuseConfig::skip_unchanged).
+     *
+     * Carried over like deferred_rows, but the samples are current to the declared tolerance.
+     */
+    RowMask unchanged_rows{0};
+
+    TrajectoryPlane positions{};
+
+    /**
+     * @brief Optional RIC velocity plane, same indexing as positions.
+     *
+     * Storage is owned by the Publisher and attached only when it is configured with
+     * PublisherConfig::velocities; nullptr otherwise (the buffer does not grow).
+     */
+    TrajectoryPlane* velocities{nullptr};
+
+    /**
+     * @brief Optional inertial position plane, same indexing as positions.
+     *
+     * (*positions_i)[i][k] is vehicle i's predicted position at t0 + tau[k] in the chief's
+     * inertial frame, computed once by the predictor from the per-tick chief ephemeris.
+     * Owned by the Publisher and attached only with PublisherConfig::inertial_positions;
+     * nullptr otherwise.
+     */
+    TrajectoryPlane* positions_i{nullptr};
+
+    /**
+     * @brief Optional RIC position covariance plane, same indexing as positions.
+     *
+     * (*position_cov)[i][k] is Phi_k P0 Phi_k^T for the initial covariance the vehicle
+     * provider reported for row i (IVehicleStateProvider::get_covariance()). Owned by the
+     * Publisher and attached only with PublisherConfig::position_covariance; nullptr otherwise.
+     */
+    CovariancePlane* position_cov{nullptr};
+
+    /** @brief Rows whose position_cov entries are meaningful (a subset of valid_rows). */
+    RowMask cov_rows{0};
+
+    /**
+     * @brief Rows whose samples include planned impulsive burns inside the horizon
+     *        (BasicRelativePredictor::set_planned_burns()); a subset of valid_rows.
+     */
+    RowMask maneuver_rows{0};
+
+    /**
+     * @brief CONTROL_ACTIVE_UNMODELED: rows with planned burns inside the horizon that their
+     *        model could not compose; their samples are the coasting trajectory.
+     */
+    RowMask control_unmodeled_rows{0};
+
+    /**
+     * @brief Optional SoA copy of positions (PublisherConfig::soa_layout), or nullptr.
+     *
+     * Owned by the Publisher, which fills it from positions for every changed row at publish.
+     */
+    SoaPositionPlanes* soa{nullptr};
+
+    /**
+     * @brief Optional float32 copy of positions (OutputPrecision::kFloat32), or nullptr.
+     *
+     * Like soa, owned by the Publisher and filled from positions at publish; all model math
+     * stays double.
+     */
+    Float32Plane* positions_f32{nullptr};
+
+    /** @brief Optional fixed-point copy of positions (OutputPrecision::kFixed32), or nullptr. */
+    Fixed32Plane* positions_q32{nullptr};
+
+    /** @brief Metres per positions_q32 count (e.g. 1e-3 = mm); 0 without a fixed-point plane. */
+    double q32_scale_m{0.0};
+
+    /** @brief Rows with at least one positions_q32 component saturated to +/-INT32_MAX. */
+    RowMask q32_saturated{0};
+
+    /**
+     * @brief Per-row model decision for this snapshot (model, cause, estimated cost).
+     *
+     * Written by predictors whose model policy reports it (see has_row_selection); rows that
+     * were not predicted this tick hold a default entry.
+     */
+    std::array<ModelSelection, MAX_VEHICLES> row_model{};
+
+    /** @brief Sum of row_model[i].est_cost over the predicted rows. */
+    double est_cost_total{0.0};
+
+    /**
+     * @brief Per-row closest-approach summary (ApproachSummaryConfig); valid == false when
+     *        not computed. Travels with its row, so offsets are from row_t0[i].
+     */
+    std::array<ClosestApproach, MAX_VEHICLES> approach{};
+
+    /** @brief Keep-out radii [m] behind approach[i].keep_out_entry_tau[j], j < keep_out_count. */
+    std::size_t keep_out_count{0};
+    std::array<double, MAX_KEEP_OUT_SPHERES> keep_out_radius_m{};
+
+    /**
+     * @brief Per-row model coefficients (BasicRelativePredictor::configure_coefficients()).
+     *
+     * coefficients[i] reproduces row i at any offset from row_t0[i] through
+     * evaluate_coefficients(); meaningful for rows in coeff_rows. Travels with its row.
+     */
+    std::array<TrajectoryCoefficients, MAX_VEHICLES> coefficients{};
+
+    /** @brief Rows whose coefficients entries are meaningful (a subset of valid_rows). */
+    RowMask coeff_rows{0};
+
+    /**
+     * @brief Rows published as coefficients only (a subset of coeff_rows): their positions,
+     *        velocities, positions_i and approach entries are not written.
+     */
+    RowMask coeff_only_rows{0};
+
+    /** @brief True if a velocity plane is attached. */
+    [[nodiscard]] bool has_velocities() const noexcept { return velocities != nullptr; }
+
+    /** @brief True if an inertial position plane is attached. */
+    [[nodiscard]] bool has_inertial_positions() const noexcept { return positions_i != nullptr; }
+
+    /** @brief True if a position covariance plane is attached. */
+    [[nodiscard]] bool has_position_covariance() const noexcept { return position_cov != nullptr; }
+
+    /** @brief Position of (i, k) decoded from positions_q32 [m] (requires a fixed-point plane). */
+    [[nodiscard]] Vec3 q32_position(std::size_t i, std::size_t k) const noexcept
+    {
+        const Vec3q& q = (*positions_q32)[i][k];
+        return Vec3{dequantize_fixed32(q.x, q32_scale_m), dequantize_fixed32(q.y, q32_scale_m),
+                    dequantize_fixed32(q.z, q32_scale_m)};
+    }
+
+    /** @brief Samples of grid profile @p profile (0 for an unknown profile). */
+    [[nodiscard]] std::size_t grid_steps(std::size_t profile) const noexcept
+    {
+        if (profile == 0)
+        {
+            return steps;
+        }
+        return (profile < MAX_GRID_PROFILES) ? profile_steps[profile - 1] : 0;
+    }
+
+    /** @brief Offsets from t0 [s] of grid profile @p profile. */
+    [[nodiscard]] Span<const double> grid_tau(std::size_t profile) const noexcept
+    {
+        const double* const t = (profile == 0)                   ? tau.data()
+                                : (profile < MAX_GRID_PROFILES) ? profile_tau[profile - 1].data()
+                                                                : nullptr;
+        return Span<const double>{t, grid_steps(profile)};
+    }
+
+    /** @brief Samples written for row @p i (its grid profile's steps). */
+    [[nodiscard]] std::size_t row_steps(std::size_t i) const noexcept
+    {
+        return (i < MAX_VEHICLES) ? grid_steps(row_grid[i]) : 0;
+    }
+
+    /** @brief Offsets of row @p i's samples; tau[k] pairs with positions[i][k]. */
+    [[nodiscard]] Span<const double> row_tau(std::size_t i) const noexcept
+    {
+        return grid_tau((i < MAX_VEHICLES) ? row_grid[i] : MAX_GRID_PROFILES);
+    }
+
+    /** @brief True if SoA position planes are attached. */
+    [[nodiscard]] bool has_soa() const noexcept { return soa != nullptr; }
+
+    /** @brief True if row @p i holds this snapshot's data. */
+    [[nodiscard]] bool row_valid(std::size_t i) const noexcept
+    {
+        return i < MAX_VEHICLES && ((valid_rows >> i) & 1u) != 0u;
+    }
+
+    /**
+     * @brief Rows that changed after snapshot @p since, up to and including this one.
+     *
+     * A mirror holding snapshot @p since becomes identical to this one by copying these rows
+     * (plus the buffer-wide fields). 0 yields every row ever written.
+     */
+    [[nodiscard]] RowMask rows_changed_since(std::uint64_t since) const noexcept
+    {
+        RowMask changed = 0;
+        for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+        {
+            if (row_seqno[i] > since)
+            {
+                changed |= RowMask{1} << i;
+            }
+        }
+        return changed;
+    }
+
     bool write_positions(std::size_t count,
                          const Vec3* r_ric_in) noexcept;
     void reset(double t0_in) noexcept;
@@ -1,60 +1,205 @@
 // core/provider_cartesian.cpp
 #include "core/provider_cartesian.hpp"
 
+#include "core/checkpoint.hpp"
 #include "core/logging.hpp"
+#include "core/frame_id_registry.hpp"
 #include "core/log_names.hpp"
-#include "logger/log_macros.hpp"
+#include "core/time_series_cursor.hpp"
+#include "core/log_macros.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
 
 namespace bullseye_pred
 {
 
 CartesianChiefProvider::CartesianChiefProvider(const char* inertial_frame_id, Mode mode,
-                                               double warn_period_sec)
-    : inertial_frame_id_(inertial_frame_id), mode_(mode), warn_period_sec_(warn_period_sec)
+                                               double warn_period_sec,
+                                               std::pmr::memory_resource* memory)
+    : inertial_frame_id_(inertial_frame_id),
+      inertial_frame_(intern_frame_id(inertial_frame_id)),
+      mode_(mode),
+      warn_period_sec_(warn_period_sec),
+      samples_(memory),
+      ring_(memory)
 {
-    static auto log = bullseye_pred::logging::get(bullseye_pred::logname::kCoreProviderCartesian);
-
     // Initialize current_ to a sentinel time that should never match a real t0.
     current_.t = std::numeric_limits<double>::quiet_NaN();
 
-    LOG_INFOF(log, "init: mode=%s frame_id=%s warn_period_sec=%.17g",
-              (mode_ == Mode::kCurrent) ? "current" : "timeseries",
-              inertial_frame_id_ ? inertial_frame_id_ : "(null)", warn_period_sec_);
+    BULLSEYE_LOG_INFOF(
+        logname::kCoreProviderCartesian, "init: mode=%s frame_id=%s warn_period_sec=%.17g",
+        (mode_ == Mode::kCurrent)      ? "current"
+        : (mode_ == Mode::kTimeSeries) ? "timeseries"
+                                       : "streaming",
+        inertial_frame_id_ ? inertial_frame_id_ : "(null)", warn_period_sec_);
 }
 
 void CartesianChiefProvider::set_current(double t, const Vec3& r_i, const Vec3& v_i) noexcept
 {
-    static auto log = bullseye_pred::logging::get(bullseye_pred::logname::kCoreProviderCartesian);
-
     current_.t = t;
     current_.r_i = r_i;
     current_.v_i = v_i;
 
-    LOG_DEBUGF(log, "set_current: t=%.17g", t);
+    BULLSEYE_LOG_DEBUGF(logname::kCoreProviderCartesian, "set_current: t=%.17g", t);
 }
 
 void CartesianChiefProvider::add_sample(double t, const Vec3& r_i, const Vec3& v_i)
 {
-    static auto log = bullseye_pred::logging::get(bullseye_pred::logname::kCoreProviderCartesian);
-
+    // In-order appends keep the series sorted, so streaming ingestion never triggers a sort.
+    sorted_ = sorted_ && (samples_.empty() || samples_.back().t < t);
     samples_.push_back(Sample{t, r_i, v_i});
-    sorted_ = false;
 
-    LOG_DEBUGF(log, "add_sample: t=%.17g count=%zu", t, samples_.size());
+    BULLSEYE_LOG_DEBUGF(logname::kCoreProviderCartesian, "add_sample: t=%.17g count=%zu", t,
+                        samples_.size());
+}
+
+bool CartesianChiefProvider::load_presorted(Span<const Sample> samples)
+{
+    if (!detail::strictly_increasing_times(samples.data, samples.size))
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreProviderCartesian,
+                           "load_presorted: rejected, times not strictly increasing count=%zu",
+                           samples.size);
+        return false;
+    }
+    samples_.assign(samples.data, samples.data + samples.size);
+    sorted_ = true;
+    cursor_ = 0;
+
+    BULLSEYE_LOG_DEBUGF(logname::kCoreProviderCartesian, "load_presorted: count=%zu",
+                        samples_.size());
+    return true;
 }
 
 void CartesianChiefProvider::clear_samples() noexcept
 {
-    static auto log = bullseye_pred::logging::get(bullseye_pred::logname::kCoreProviderCartesian);
     samples_.clear();
     // Configuration-time operation; acceptable. Avoid calling during steady-state ticks.
     samples_.shrink_to_fit();
     sorted_ = true;
+    cursor_ = 0;
+
+    BULLSEYE_LOG_DEBUGF(logname::kCoreProviderCartesian, "clear_samples");
+}
+
+bool CartesianChiefProvider::configure_streaming(std::size_t capacity, double retention_sec)
+{
+    if (mode_ != Mode::kStreaming || !std::isfinite(retention_sec) || retention_sec < 0.0 ||
+        !ring_.init(capacity))
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreProviderCartesian,
+                           "configure_streaming: rejected capacity=%zu retention_sec=%.17g",
+                           capacity, retention_sec);
+        return false;
+    }
+    retention_sec_ = retention_sec;
+    cursor_ = 0;
+
+    BULLSEYE_LOG_DEBUGF(logname::kCoreProviderCartesian,
+                        "configure_streaming: capacity=%zu retention_sec=%.17g", capacity,
+                        retention_sec);
+    return true;
+}
 
-    LOG_DEBUGF(log, "clear_samples");
+bool CartesianChiefProvider::push_sample(double t, const Vec3& r_i, const Vec3& v_i) noexcept
+{
+    // Producer thread: no logging here; rejections are counted by the ring.
+    return ring_.push(Sample{t, r_i, v_i});
+}
+
+namespace
+{
+
+// Fixed prefix of a kChiefSamples section; `count` samples follow.
+struct ChiefSamplesCheckpoint final
+{
+    std::uint32_t mode{0};
+    std::uint32_t sorted{0};
+    std::uint64_t count{0};
+    std::uint64_t cursor{0};
+    std::uint64_t lookup_fallbacks{0};
+    double last_warn_t0{0.0};
+    CartesianChiefProvider::Sample current{};
+};
+
+} // namespace
+
+void CartesianChiefProvider::save_checkpoint(CheckpointWriter& out, std::uint32_t instance) const
+{
+    ChiefSamplesCheckpoint hdr{};
+    hdr.mode = static_cast<std::uint32_t>(mode_);
+    hdr.sorted = sorted_ ? 1u : 0u;
+    hdr.count = sample_count();
+    hdr.cursor = cursor_;
+    hdr.lookup_fallbacks = lookup_fallbacks_;
+    hdr.last_warn_t0 = last_warn_t0_;
+    hdr.current = current_;
+
+    out.begin_section(CheckpointSection::kChiefSamples, instance);
+    out.append_value(hdr);
+    if (mode_ == Mode::kStreaming)
+    {
+        const auto window = ring_.view();
+        for (std::size_t i = 0; i < ring_.size(); ++i)
+        {
+            out.append_value(window[i]);
+        }
+    }
+    else
+    {
+        out.append_array(samples_.data(), samples_.size());
+    }
+}
+
+CheckpointCode CartesianChiefProvider::restore_checkpoint(const CheckpointFile& in,
+                                                          std::uint32_t instance)
+{
+    if (!in.has_section(CheckpointSection::kChiefSamples, instance))
+    {
+        return CheckpointCode::kMissingSection;
+    }
+    CheckpointCursor cur = in.cursor(CheckpointSection::kChiefSamples, instance);
+    ChiefSamplesCheckpoint hdr{};
+    if (!cur.read_value(hdr) || hdr.mode != static_cast<std::uint32_t>(mode_) ||
+        hdr.count > cur.remaining() / sizeof(Sample) ||
+        cur.remaining() != hdr.count * sizeof(Sample) ||
+        (mode_ == Mode::kStreaming && hdr.count > ring_.capacity()))
+    {
+        return CheckpointCode::kLayoutMismatch;
+    }
+    const auto* samples = reinterpret_cast<const Sample*>(cur.take(hdr.count * sizeof(Sample)));
+    const auto count = static_cast<std::size_t>(hdr.count);
+
+    if (mode_ == Mode::kStreaming)
+    {
+        ring_.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Sample s{};
+            std::memcpy(&s, samples + i, sizeof(Sample));
+            (void)ring_.push(s);
+        }
+        (void)ring_.refresh();
+    }
+    else
+    {
+        samples_.resize(count);
+        if (count > 0u)
+        {
+            std::memcpy(samples_.data(), samples, count * sizeof(Sample));
+        }
+    }
+    sorted_ = (hdr.sorted != 0u);
+    cursor_ = static_cast<std::size_t>(hdr.cursor);
+    lookup_fallbacks_ = hdr.lookup_fallbacks;
+    last_warn_t0_ = hdr.last_warn_t0;
+    current_ = hdr.current;
+
+    BULLSEYE_LOG_DEBUGF(logname::kCoreProviderCartesian, "restore_checkpoint: count=%zu", count);
+    return CheckpointCode::kOk;
 }
 
 void CartesianChiefProvider::ensure_sorted_() noexcept
@@ -66,6 +211,7 @@ void CartesianChiefProvider::ensure_sorted_() noexcept
     std::sort(samples_.begin(), samples_.end(),
               [](const Sample& a, const Sample& b) { return a.t < b.t; });
     sorted_ = true;
+    cursor_ = 0;
 }
 
 bool CartesianChiefProvider::should_warn_time_missing_(double t0) noexcept
@@ -89,14 +235,15 @@ void CartesianChiefProvider::log_invalid_input_once_() noexcept
         return;
     }
     invalid_logged_ = true;
-    static auto log = bullseye_pred::logging::get(bullseye_pred::logname::kCoreProviderCartesian);
-    LOG_ERRORF(log, "invalid configuration: inertial_frame_id is null");
+    BULLSEYE_LOG_ERRORF(logname::kCoreProviderCartesian,
+                        "invalid configuration: inertial_frame_id is null");
 }
 
 ChiefState CartesianChiefProvider::get(double t0) noexcept
 {
     ChiefState out{};
     out.frame_id = inertial_frame_id_;
+    out.frame = inertial_frame_;
 
     if (inertial_frame_id_ == nullptr)
     {
@@ -114,10 +261,9 @@ ChiefState CartesianChiefProvider::get(double t0) noexcept
 
             if (should_warn_time_missing_(t0))
             {
-                static auto log =
-                    bullseye_pred::logging::get(bullseye_pred::logname::kCoreProviderCartesian);
-                LOG_WARNF(log, "get: time missing (mode=current) t0=%.17g current_t=%.17g", t0,
-                          current_.t);
+                BULLSEYE_LOG_WARNF(logname::kCoreProviderCartesian,
+                                   "get: time missing (mode=current) t0=%.17g current_t=%.17g", t0,
+                                   current_.t);
             }
             return out;
         }
@@ -129,11 +275,17 @@ ChiefState CartesianChiefProvider::get(double t0) noexcept
         return out;
     }
 
-    // TimeSeries mode: exact match lookup in sorted samples.
+    if (mode_ == Mode::kStreaming)
+    {
+        return get_streaming_(t0, out);
+    }
+
+    // TimeSeries mode: exact match lookup in sorted samples, continuing from the last tick.
     ensure_sorted_();
 
-    auto it = std::lower_bound(samples_.begin(), samples_.end(), t0,
-                               [](const Sample& s, double t) { return s.t < t; });
+    const std::size_t idx = detail::cursor_lower_bound(samples_.data(), samples_.size(), t0,
+                                                       cursor_, lookup_fallbacks_);
+    const auto it = samples_.begin() + static_cast<std::ptrdiff_t>(idx);
 
     if (it == samples_.end() || !(it->t == t0))
     { // exact compare by contract
@@ -141,13 +293,12 @@ ChiefState CartesianChiefProvider::get(double t0) noexcept
 
         if (should_warn_time_missing_(t0))
         {
-            static auto log =
-                bullseye_pred::logging::get(bullseye_pred::logname::kCoreProviderCartesian);
             const double found_t =
                 (it == samples_.end()) ? std::numeric_limits<double>::quiet_NaN() : it->t;
-            LOG_WARNF(log,
-                      "get: time missing (mode=timeseries) t0=%.17g next_sample_t=%.17g count=%zu",
-                      t0, found_t, samples_.size());
+            BULLSEYE_LOG_WARNF(
+                logname::kCoreProviderCartesian,
+                "get: time missing (mode=timeseries) t0=%.17g next_sample_t=%.17g count=%zu", t0,
+                found_t, samples_.size());
         }
         return out;
     }
@@ -159,4 +310,41 @@ ChiefState CartesianChiefProvider::get(double t0) noexcept
     return out;
 }
 
+ChiefState CartesianChiefProvider::get_streaming_(double t0, ChiefState out) noexcept
+{
+    // Take in everything pushed so far, then drop what fell out of the retention window.
+    ring_.refresh();
+    const std::size_t evicted = ring_.evict_before(t0 - retention_sec_);
+    cursor_ -= std::min(cursor_, evicted);
+
+    const auto window = ring_.view();
+    const std::size_t n = ring_.size();
+    const std::size_t idx =
+        detail::cursor_lower_bound(window, n, t0, cursor_, lookup_fallbacks_);
+
+    if (idx == n || !(window[idx].t == t0))
+    { // exact compare by contract
+        out.status.code = ProviderCode::kTimeMissing;
+
+        if (should_warn_time_missing_(t0))
+        {
+            const double found_t =
+                (idx == n) ? std::numeric_limits<double>::quiet_NaN() : window[idx].t;
+            BULLSEYE_LOG_WARNF(
+                logname::kCoreProviderCartesian,
+                "get: time missing (mode=streaming) t0=%.17g next_sample_t=%.17g "
+                "count=%zu dropped=%llu",
+                t0, found_t, n, static_cast<unsigned long long>(ring_.dropped()));
+        }
+        return out;
+    }
+
+    const Sample& s = window[idx];
+    out.time_tag = s.t;
+    out.r_i = s.r_i;
+    out.v_i = s.v_i;
+    out.status.code = ProviderCode::kOk;
+    return out;
+}
+
 } // namespace bullseye_pred
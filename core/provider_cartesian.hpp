@@ -13,34 +13,58 @@
  *   - WARN on missing time (kTimeMissing), rate-limited by tick time
  *
  * FR-14: Exact-time only. No interpolation or nearest-time behavior.
+ *
+ * Mode::kStreaming keeps a bounded window instead of the whole series: configure_streaming()
+ * preallocates a ring, a producer thread appends with push_sample(), and get(t0) evicts samples
+ * older than t0 - retention_sec. Memory is constant and nothing reallocates after configuration.
+ *
+ * Series and streaming storage come from the memory resource given at construction (see
+ * memory_resource.hpp); the default is the global heap.
  */
 
 #include <cstddef>
 #include <cstdint>
+#include <memory_resource>
 #include <vector>
 
 #include "core/chief_state_provider.hpp"
+#include "core/sample_ring.hpp"
 #include "core/types.hpp"
+#include "models/relative_model.hpp"
 
 namespace bullseye_pred
 {
 
+class CheckpointFile;
+class CheckpointWriter;
+enum class CheckpointCode : std::uint8_t;
+
 class CartesianChiefProvider final : public IChiefStateProvider
 {
   public:
     enum class Mode : std::uint8_t
     {
         kCurrent = 0,
-        kTimeSeries
+        kTimeSeries,
+        kStreaming
+    };
+
+    struct Sample final
+    {
+        double t{0.0};
+        Vec3 r_i{};
+        Vec3 v_i{};
     };
 
     /**
      * @param inertial_frame_id Must outlive this provider (string literal or config storage).
-     * @param mode Current vs TimeSeries.
+     * @param mode Current, TimeSeries, or Streaming.
      * @param warn_period_sec Rate-limit period for repeated kTimeMissing warnings (based on t0).
+     * @param memory Source of the sample storage; must outlive this provider.
      */
-    explicit CartesianChiefProvider(const char* inertial_frame_id, Mode mode = Mode::kCurrent,
-                                    double warn_period_sec = 1.0);
+    explicit CartesianChiefProvider(
+        const char* inertial_frame_id, Mode mode = Mode::kCurrent, double warn_period_sec = 1.0,
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource());
 
     /** Set the current sample (Mode::kCurrent). Caller must set t == t0 for FR-14 exact match. */
     void set_current(double t, const Vec3& r_i, const Vec3& v_i) noexcept;
@@ -51,32 +75,85 @@ class CartesianChiefProvider final : public IChiefStateProvider
      */
     void add_sample(double t, const Vec3& r_i, const Vec3& v_i);
 
+    /**
+     * Replace all samples with an already sorted series (Mode::kTimeSeries); no sort is done.
+     *
+     * @return false (samples unchanged) unless times are finite and strictly increasing.
+     */
+    [[nodiscard]] bool load_presorted(Span<const Sample> samples);
+
     /** Clear stored samples (Mode::kTimeSeries). */
     void clear_samples() noexcept;
 
+    /**
+     * Preallocate the streaming window (Mode::kStreaming; configuration-time, drops samples).
+     *
+     * @param capacity Samples retained at most; size it for the producer's lead over the
+     *        simulation plus the retention window.
+     * @param retention_sec Samples with t < t0 - retention_sec are evicted by get(t0).
+     * @return false if not in Mode::kStreaming, capacity is 0, retention_sec is negative or not
+     *         finite, or allocation fails.
+     */
+    [[nodiscard]] bool configure_streaming(std::size_t capacity, double retention_sec = 0.0);
+
+    /**
+     * Append a sample from the (single) producer thread (Mode::kStreaming).
+     *
+     * @return false (sample dropped, see streaming_dropped()) if the window is full, streaming
+     *         is not configured, or t is not finite or not after the previous pushed sample.
+     */
+    [[nodiscard]] bool push_sample(double t, const Vec3& r_i, const Vec3& v_i) noexcept;
+
+    /** Samples rejected by push_sample() (any thread). */
+    [[nodiscard]] std::uint64_t streaming_dropped() const noexcept
+    {
+        return ring_.dropped();
+    }
+
+    /** Stored samples; in Mode::kStreaming, the window as of the last get(). */
     [[nodiscard]] std::size_t sample_count() const noexcept
     {
-        return samples_.size();
+        return (mode_ == Mode::kStreaming) ? ring_.size() : samples_.size();
+    }
+
+    /**
+     * Time-series lookups that could not continue from the previous position and used a binary
+     * search (backward jumps, long forward gaps). Monotone ticks keep this near zero.
+     */
+    [[nodiscard]] std::uint64_t lookup_fallbacks() const noexcept
+    {
+        return lookup_fallbacks_;
     }
 
+    /**
+     * Append the stored samples (current sample, series, or streaming window as of the last
+     * get()), lookup cursor and warning state as section CheckpointSection::kChiefSamples.
+     * Configuration-time; see checkpoint.hpp.
+     */
+    void save_checkpoint(CheckpointWriter& out, std::uint32_t instance = 0) const;
+
+    /**
+     * Restore the state saved by save_checkpoint() (same mode; a streaming provider must be
+     * configured with room for the saved window and its producer not yet pushing).
+     *
+     * @return kOk, kMissingSection, or kLayoutMismatch (mode or window capacity differ;
+     *         provider unchanged).
+     */
+    CheckpointCode restore_checkpoint(const CheckpointFile& in, std::uint32_t instance = 0);
+
     /**
      * Propagates ChiefState to time t0.
      */
     [[nodiscard]] ChiefState get(double t0) noexcept override;
 
   private:
-    struct Sample final
-    {
-        double t{0.0};
-        Vec3 r_i{};
-        Vec3 v_i{};
-    };
-
     void ensure_sorted_() noexcept;
+    [[nodiscard]] ChiefState get_streaming_(double t0, ChiefState out) noexcept;
     bool should_warn_time_missing_(double t0) noexcept;
     void log_invalid_input_once_() noexcept;
 
     const char* inertial_frame_id_{nullptr};
+    FrameHandle inertial_frame_{FrameHandle::kNone};
     Mode mode_{Mode::kCurrent};
 
     // Rate limiting for repeated WARN in get(t0).
@@ -90,8 +167,16 @@ class CartesianChiefProvider final : public IChiefStateProvider
     Sample current_{};
 
     // Time series storage (sorted by t, deterministically)
-    std::vector<Sample> samples_{};
+    std::pmr::vector<Sample> samples_;
     bool sorted_{true};
+
+    // Lookup position of the previous get(t0) (see time_series_cursor.hpp).
+    std::size_t cursor_{0};
+    std::uint64_t lookup_fallbacks_{0};
+
+    // Streaming window (Mode::kStreaming); cursor_ indexes its retained samples.
+    detail::SampleRing<Sample> ring_;
+    double retention_sec_{0.0};
 };
 
 } // namespace bullseye_pred
@@ -0,0 +1,221 @@
+// core/provider_ephemeris.cpp
+#include "core/provider_ephemeris.hpp"
+
+#include "core/frame_id_registry.hpp"
+#include "core/log_names.hpp"
+#include "core/logging.hpp"
+#include "core/time_series_cursor.hpp"
+#include "core/log_macros.hpp"
+
+#include <limits>
+#include <new>
+
+namespace bullseye_pred
+{
+
+// ------------------------------
+// EphemerisChiefProvider
+// ------------------------------
+
+EphemerisChiefProvider::EphemerisChiefProvider(const char* inertial_frame_id,
+                                               double warn_period_sec)
+    : inertial_frame_id_(inertial_frame_id), inertial_frame_(intern_frame_id(inertial_frame_id)),
+      warn_period_sec_(warn_period_sec)
+{
+}
+
+EphemerisCode EphemerisChiefProvider::open(const char* path, bool verify_times) noexcept
+{
+    cursor_ = 0;
+    const EphemerisCode code = file_.open(path, EphemerisKind::kChief, verify_times);
+    if (code != EphemerisCode::kOk)
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreProviderEphemeris, "open(chief): failed path=%s code=%u",
+                           path ? path : "(null)", static_cast<unsigned>(code));
+        return code;
+    }
+    BULLSEYE_LOG_INFOF(logname::kCoreProviderEphemeris,
+                       "open(chief): path=%s frame_id=%s samples=%zu", path,
+                       inertial_frame_id_ ? inertial_frame_id_ : "(null)", file_.record_count());
+    return code;
+}
+
+bool EphemerisChiefProvider::should_warn_time_missing_(double t0) noexcept
+{
+    if (warn_period_sec_ <= 0.0)
+    {
+        return true;
+    }
+    if ((t0 - last_warn_t0_) >= warn_period_sec_)
+    {
+        last_warn_t0_ = t0;
+        return true;
+    }
+    return false;
+}
+
+void EphemerisChiefProvider::log_invalid_input_once_(const char* why) noexcept
+{
+    if (invalid_logged_)
+    {
+        return;
+    }
+    invalid_logged_ = true;
+    BULLSEYE_LOG_ERRORF(logname::kCoreProviderEphemeris, "invalid configuration (chief): %s", why);
+}
+
+ChiefState EphemerisChiefProvider::get(double t0) noexcept
+{
+    ChiefState out{};
+    out.frame_id = inertial_frame_id_;
+    out.frame = inertial_frame_;
+
+    if (inertial_frame_id_ == nullptr)
+    {
+        out.status.code = ProviderCode::kInvalidInput;
+        log_invalid_input_once_("inertial_frame_id is null");
+        return out;
+    }
+    if (!file_.is_open())
+    {
+        out.status.code = ProviderCode::kNotAvailable;
+        log_invalid_input_once_("no ephemeris file open");
+        return out;
+    }
+
+    const Span<const ChiefEphemerisRecord> r = file_.records<ChiefEphemerisRecord>(0);
+    const std::size_t i = detail::cursor_lower_bound(r.data, r.size, t0, cursor_,
+                                                     lookup_fallbacks_);
+    if (i == r.size || !(r[i].t == t0))
+    { // exact compare by contract
+        out.status.code = ProviderCode::kTimeMissing;
+        if (should_warn_time_missing_(t0))
+        {
+            const double found_t =
+                (i == r.size) ? std::numeric_limits<double>::quiet_NaN() : r[i].t;
+            BULLSEYE_LOG_WARNF(logname::kCoreProviderEphemeris,
+                               "get(chief): time missing t0=%.17g next_sample_t=%.17g count=%zu",
+                               t0, found_t, r.size);
+        }
+        return out;
+    }
+
+    out.time_tag = r[i].t;
+    out.r_i = r[i].r_i;
+    out.v_i = r[i].v_i;
+    out.status.code = ProviderCode::kOk;
+    return out;
+}
+
+// ------------------------------
+// EphemerisVehicleProvider
+// ------------------------------
+
+EphemerisVehicleProvider::EphemerisVehicleProvider(const char* inertial_frame_id,
+                                                   double warn_period_sec)
+    : inertial_frame_id_(inertial_frame_id), inertial_frame_(intern_frame_id(inertial_frame_id)),
+      warn_period_sec_(warn_period_sec)
+{
+}
+
+EphemerisCode EphemerisVehicleProvider::open(const char* path, bool verify_times) noexcept
+{
+    cursors_.reset();
+    EphemerisCode code = file_.open(path, EphemerisKind::kVehicle, verify_times);
+    if (code == EphemerisCode::kOk && file_.series_count() > 0u)
+    {
+        cursors_.reset(new (std::nothrow) std::size_t[file_.series_count()]());
+        if (!cursors_)
+        {
+            file_.close();
+            code = EphemerisCode::kMapFailed;
+        }
+    }
+    if (code != EphemerisCode::kOk)
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreProviderEphemeris,
+                           "open(vehicles): failed path=%s code=%u", path ? path : "(null)",
+                           static_cast<unsigned>(code));
+        return code;
+    }
+    BULLSEYE_LOG_INFOF(logname::kCoreProviderEphemeris,
+                       "open(vehicles): path=%s frame_id=%s vehicles=%zu samples=%zu", path,
+                       inertial_frame_id_ ? inertial_frame_id_ : "(null)", file_.series_count(),
+                       file_.record_count());
+    return code;
+}
+
+bool EphemerisVehicleProvider::should_warn_time_missing_(double t0) noexcept
+{
+    if (warn_period_sec_ <= 0.0)
+    {
+        return true;
+    }
+    if ((t0 - last_warn_t0_) >= warn_period_sec_)
+    {
+        last_warn_t0_ = t0;
+        return true;
+    }
+    return false;
+}
+
+void EphemerisVehicleProvider::log_invalid_input_once_(const char* why) noexcept
+{
+    if (invalid_logged_)
+    {
+        return;
+    }
+    invalid_logged_ = true;
+    BULLSEYE_LOG_ERRORF(logname::kCoreProviderEphemeris, "invalid configuration (vehicles): %s",
+                        why);
+}
+
+VehicleState EphemerisVehicleProvider::get(VehicleIndexMap::VehicleId id, double t0) noexcept
+{
+    VehicleState out{};
+    out.frame_id = inertial_frame_id_;
+    out.frame = inertial_frame_;
+
+    if (inertial_frame_id_ == nullptr)
+    {
+        out.status.code = ProviderCode::kInvalidInput;
+        log_invalid_input_once_("inertial_frame_id is null");
+        return out;
+    }
+    if (!file_.is_open())
+    {
+        out.status.code = ProviderCode::kNotAvailable;
+        log_invalid_input_once_("no ephemeris file open");
+        return out;
+    }
+
+    const std::size_t s = file_.find_series(id);
+    if (s == file_.series_count())
+    {
+        out.status.code = ProviderCode::kNotAvailable;
+        return out;
+    }
+
+    const Span<const VehicleEphemerisRecord> r = file_.records<VehicleEphemerisRecord>(s);
+    const std::size_t i = detail::cursor_lower_bound(r.data, r.size, t0, cursors_[s],
+                                                     lookup_fallbacks_);
+    if (i == r.size || !(r[i].t == t0))
+    { // exact compare by contract
+        out.status.code = ProviderCode::kTimeMissing;
+        if (should_warn_time_missing_(t0))
+        {
+            BULLSEYE_LOG_WARNF(logname::kCoreProviderEphemeris,
+                               "get(vehicles): time missing id=%llu t0=%.17g count=%zu",
+                               static_cast<unsigned long long>(id), t0, r.size);
+        }
+        return out;
+    }
+
+    out.time_tag = r[i].t;
+    out.r_i = r[i].r_i;
+    out.v_i = r[i].v_i;
+    out.status.code = ProviderCode::kOk;
+    return out;
+}
+
+} // namespace bullseye_pred
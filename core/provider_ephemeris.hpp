@@ -0,0 +1,125 @@
+// core/provider_ephemeris.hpp
+#pragma once
+
+/**
+ * @file provider_ephemeris.hpp
+ * @brief Chief and deputy state providers backed by memory-mapped ephemeris files.
+ *
+ * Intent
+ * - Serve long, high-rate ephemerides without loading them: open() maps the file
+ *   (ephemeris_file.hpp) and checks its header, so startup is independent of the file length,
+ *   pages fault in as ticks reach them, and concurrent runs share the page cache.
+ *
+ * Policy
+ * - FR-14 exact-time only, as CartesianChiefProvider in Mode::kTimeSeries; lookups continue
+ *   from the previous tick (time_series_cursor.hpp).
+ * - No allocations in get(); the vehicle provider allocates one cursor per series in open().
+ *
+ * Logging (sim-logger)
+ * - INFO on open (path, counts); WARN on a failed open
+ * - get(t0): no log on success
+ *   - ERROR on invalid configuration or no open file (logged once)
+ *   - WARN on missing time, rate-limited by tick time
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "core/chief_state_provider.hpp"
+#include "core/ephemeris_file.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/types.hpp"
+
+namespace bullseye_pred
+{
+
+class EphemerisChiefProvider final : public IChiefStateProvider
+{
+  public:
+    /**
+     * @param inertial_frame_id Must outlive this provider (string literal or config storage).
+     * @param warn_period_sec Rate-limit period for repeated kTimeMissing warnings (based on t0).
+     */
+    explicit EphemerisChiefProvider(const char* inertial_frame_id, double warn_period_sec = 1.0);
+
+    /**
+     * @brief Map a chief ephemeris file, replacing any file opened before.
+     *
+     * @param verify_times See EphemerisFile::open().
+     */
+    [[nodiscard]] EphemerisCode open(const char* path, bool verify_times = false) noexcept;
+
+    [[nodiscard]] std::size_t sample_count() const noexcept { return file_.record_count(); }
+
+    /// Lookups that fell back to a binary search (see time_series_cursor.hpp).
+    [[nodiscard]] std::uint64_t lookup_fallbacks() const noexcept
+    {
+        return lookup_fallbacks_;
+    }
+
+    [[nodiscard]] ChiefState get(double t0) noexcept override;
+
+  private:
+    bool should_warn_time_missing_(double t0) noexcept;
+    void log_invalid_input_once_(const char* why) noexcept;
+
+    const char* inertial_frame_id_{nullptr};
+    FrameHandle inertial_frame_{FrameHandle::kNone};
+    double warn_period_sec_{1.0};
+    double last_warn_t0_{-1.0e300};
+    bool invalid_logged_{false};
+
+    EphemerisFile file_{};
+    std::size_t cursor_{0};
+    std::uint64_t lookup_fallbacks_{0};
+};
+
+class EphemerisVehicleProvider final : public IVehicleStateProvider
+{
+  public:
+    /**
+     * @param inertial_frame_id Must outlive this provider (string literal or config storage).
+     * @param warn_period_sec Rate-limit period for repeated kTimeMissing warnings (based on t0).
+     */
+    explicit EphemerisVehicleProvider(const char* inertial_frame_id,
+                                      double warn_period_sec = 1.0);
+
+    /**
+     * @brief Map a vehicle ephemeris file, replacing any file opened before.
+     *
+     * @return kOk, an EphemerisFile::open() failure, or kMapFailed if the cursor table cannot
+     *         be allocated.
+     */
+    [[nodiscard]] EphemerisCode open(const char* path, bool verify_times = false) noexcept;
+
+    /// @return number of vehicles in the open file.
+    [[nodiscard]] std::size_t vehicle_count() const noexcept { return file_.series_count(); }
+
+    /// Lookups that fell back to a binary search (see time_series_cursor.hpp).
+    [[nodiscard]] std::uint64_t lookup_fallbacks() const noexcept
+    {
+        return lookup_fallbacks_;
+    }
+
+    /// kNotAvailable for ids without a series in the file.
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override;
+
+  private:
+    bool should_warn_time_missing_(double t0) noexcept;
+    void log_invalid_input_once_(const char* why) noexcept;
+
+    const char* inertial_frame_id_{nullptr};
+    FrameHandle inertial_frame_{FrameHandle::kNone};
+    double warn_period_sec_{1.0};
+    double last_warn_t0_{-1.0e300};
+    bool invalid_logged_{false};
+
+    EphemerisFile file_{};
+
+    // One lookup cursor per series (vehicle).
+    std::unique_ptr<std::size_t[]> cursors_{};
+    std::uint64_t lookup_fallbacks_{0};
+};
+
+} // namespace bullseye_pred
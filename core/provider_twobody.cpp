@@ -1,36 +1,92 @@
 // core/provider_twobody.cpp
 #include "core/provider_twobody.hpp"
 
+#include "core/frame_id_registry.hpp"
 #include "core/log_names.hpp"
 #include "core/logging.hpp"
-#include "core/math/stumpff.hpp"
-#include "logger/log_macros.hpp"
+#include "core/math/kepler.hpp"
+#include "core/math/universal_kepler.hpp"
+#include "core/log_macros.hpp"
 
 #include <cmath>
 #include <limits>
 
 namespace bullseye_pred
 {
-using math::stumpff_C;
-using math::stumpff_S;
-
-inline bool is_finite_vec(const Vec3& v) noexcept
-{
-    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
-}
-
 TwoBodyChiefProvider::TwoBodyChiefProvider(const char* inertial_frame_id, double mu, double t_epoch,
                                            const Vec3& r_epoch_i, const Vec3& v_epoch_i)
-    : inertial_frame_id_(inertial_frame_id), mu_(mu), t_epoch_(t_epoch), r0_(r_epoch_i),
+    : inertial_frame_id_(inertial_frame_id), inertial_frame_(intern_frame_id(inertial_frame_id)),
+      mu_(mu), t_epoch_(t_epoch), r0_(r_epoch_i),
       v0_(v_epoch_i)
 {
-    static auto log = bullseye_pred::logging::get(bullseye_pred::logname::kCoreProviderTwoBody);
-
-    LOG_INFOF(log, "init: frame_id=%s mu=%.17g t_epoch=%.17g",
-              inertial_frame_id_ ? inertial_frame_id_ : "(null)", mu_, t_epoch_);
+    BULLSEYE_LOG_INFOF(logname::kCoreProviderTwoBody, "init: frame_id=%s mu=%.17g t_epoch=%.17g",
+                       inertial_frame_id_ ? inertial_frame_id_ : "(null)", mu_, t_epoch_);
 
     // Configuration validation is deferred to get() for status reporting, but we can
     // latch obvious issues now (still log once there).
+
+    init_elements_();
+}
+
+void TwoBodyChiefProvider::init_elements_() noexcept
+{
+    elements_valid_ = false;
+    if (!(mu_ > 0.0) || !std::isfinite(mu_) || !finite3(r0_) || !finite3(v0_))
+    {
+        return;
+    }
+    const double r0n = norm(r0_);
+    const Vec3 h = cross(r0_, v0_);
+    const double hn = norm(h);
+    const double v2 = dot(v0_, v0_);
+    const double alpha = 2.0 / r0n - v2 / mu_;
+    if (!(r0n > 0.0) || !(hn > 0.0) || !(alpha > 0.0) || !std::isfinite(alpha))
+    {
+        return; // degenerate, parabolic or hyperbolic: universal variables
+    }
+
+    const Vec3 e_vec = ((v2 - mu_ / r0n) * r0_ - dot(r0_, v0_) * v0_) * (1.0 / mu_);
+    const double e = norm(e_vec);
+    if (!(e < kMaxEllipticEccentricity))
+    {
+        return;
+    }
+
+    a_ = 1.0 / alpha;
+    e_ = e;
+    sqrt_mu_a_ = std::sqrt(mu_ * a_);
+    // sqrt(1 - e^2) from the angular momentum: well conditioned as e -> 0.
+    sqrt_1me2_ = hn / sqrt_mu_a_;
+    b_ = a_ * sqrt_1me2_;
+    n_ = std::sqrt(mu_ / (a_ * a_ * a_));
+    p_hat_ = (e > 0.0) ? e_vec * (1.0 / e) : r0_ * (1.0 / r0n);
+    q_hat_ = cross(h * (1.0 / hn), p_hat_);
+
+    // Epoch eccentric anomaly from the perifocal coordinates (self-consistent with p_hat_ even
+    // where e is at round-off level and its direction is noise).
+    const double cos_e0 = dot(r0_, p_hat_) / a_ + e_;
+    const double sin_e0 = dot(r0_, q_hat_) / b_;
+    m0_ = std::atan2(sin_e0, cos_e0) - e_ * sin_e0;
+
+    elements_valid_ = std::isfinite(m0_) && std::isfinite(n_) && std::isfinite(b_) &&
+                      finite3(p_hat_) && finite3(q_hat_);
+}
+
+void TwoBodyChiefProvider::propagate_elliptic_(double dt, Vec3& r_out, Vec3& v_out) const noexcept
+{
+    // Reduce M to [-pi, pi]: E is only needed modulo 2 pi, and the solve stays well conditioned
+    // however many orbits dt spans.
+    constexpr double kTwoPi = 6.283185307179586476925286766559;
+    const double M = std::remainder(m0_ + n_ * dt, kTwoPi);
+    const math::EllipticAnomaly an = math::solve_kepler_elliptic_quartic(M, e_, kEllipticIters);
+    const double sE = an.sin_E;
+    const double cE = an.cos_E;
+
+    const double x = a_ * (cE - e_);
+    const double y = b_ * sE;
+    const double vk = sqrt_mu_a_ / (a_ * (1.0 - e_ * cE));
+    r_out = x * p_hat_ + y * q_hat_;
+    v_out = (-vk * sE) * p_hat_ + (vk * sqrt_1me2_ * cE) * q_hat_;
 }
 
 void TwoBodyChiefProvider::log_invalid_config_once_(const char* why) noexcept
@@ -40,14 +96,14 @@ void TwoBodyChiefProvider::log_invalid_config_once_(const char* why) noexcept
         return;
     }
     invalid_logged_ = true;
-    static auto log = bullseye_pred::logging::get(bullseye_pred::logname::kCoreProviderTwoBody);
-    LOG_ERRORF(log, "invalid configuration: %s", why);
+    BULLSEYE_LOG_ERRORF(logname::kCoreProviderTwoBody, "invalid configuration: %s", why);
 }
 
 ChiefState TwoBodyChiefProvider::get(double t0) noexcept
 {
     ChiefState out{};
     out.frame_id = inertial_frame_id_;
+    out.frame = inertial_frame_;
 
     // Validate configuration.
     if (inertial_frame_id_ == nullptr)
@@ -62,8 +118,8 @@ ChiefState TwoBodyChiefProvider::get(double t0) noexcept
         log_invalid_config_once_("mu must be finite and > 0");
         return out;
     }
-    if (!std::isfinite(t0) || !std::isfinite(t_epoch_) || !is_finite_vec(r0_) ||
-        !is_finite_vec(v0_))
+    if (!std::isfinite(t0) || !std::isfinite(t_epoch_) || !finite3(r0_) ||
+        !finite3(v0_))
     {
         out.status.code = ProviderCode::kInvalidInput;
         log_invalid_config_once_("non-finite input(s)");
@@ -79,96 +135,124 @@ ChiefState TwoBodyChiefProvider::get(double t0) noexcept
     }
 
     const double dt = t0 - t_epoch_;
-    const double sqrt_mu = std::sqrt(mu_);
-    const double v0n2 = dot(v0_, v0_);
-    const double alpha = 2.0 / r0n - v0n2 / mu_; // reciprocal semi-major axis
 
-    // Initial guess for universal anomaly x (deterministic heuristic).
+    Vec3 r{};
+    Vec3 v{};
     double x = 0.0;
-    const double abs_alpha = std::fabs(alpha);
-    if (abs_alpha > 1e-8)
+    ProviderCode code = ProviderCode::kOk;
+
+    if (elliptic_fast_path())
     {
-        x = sqrt_mu * abs_alpha * dt;
+        propagate_elliptic_(dt, r, v);
+        ++elliptic_solves_;
     }
-    else
+    else if (!incremental_.enabled)
     {
-        // Near-parabolic fallback.
-        x = sqrt_mu * dt / r0n;
+        code = propagate_(r0_, v0_, dt, /*warm=*/false, x, r, v);
+        ++epoch_solves_;
     }
-
-    // Fixed-iteration Newton solve of Kepler's universal equation.
-    const double r0dotv0 = dot(r0_, v0_);
-    const double r0dotv0_over_sqrtmu = r0dotv0 / sqrt_mu;
-
-    for (int iter = 0; iter < kKeplerIters; ++iter)
+    else
     {
-        const double x2 = x * x;
-        const double z = alpha * x2;
-        const double C = stumpff_C(z);
-        const double S = stumpff_S(z);
-
-        // F(x) = r0·v0/sqrt(mu) * x^2*C + (1 - alpha*r0) * x^3*S + r0*x - sqrt(mu)*dt
-        const double x3 = x2 * x;
-        const double one_minus_alpha_r0 = 1.0 - alpha * r0n;
-        const double F =
-            r0dotv0_over_sqrtmu * x2 * C + one_minus_alpha_r0 * x3 * S + r0n * x - sqrt_mu * dt;
-
-        // F'(x) = r0·v0/sqrt(mu) * x*(1 - z*S) + (1 - alpha*r0) * x^2*C + r0
-        const double dF =
-            r0dotv0_over_sqrtmu * x * (1.0 - z * S) + one_minus_alpha_r0 * x2 * C + r0n;
+        const double sqrt_mu = std::sqrt(mu_);
+        const double dt_cache = t0 - t_cache_;
+        const bool cache_nearer = cache_valid_ && (std::fabs(dt_cache) < std::fabs(dt));
 
-        // Guard against pathological dF ~ 0 (deterministic fallback: no update).
-        if (!(dF != 0.0) || !std::isfinite(dF) || !std::isfinite(F))
+        if (cache_nearer && since_anchor_ + 1U < incremental_.reanchor_interval)
         {
-            // Leave x unchanged; loop continues fixed-count for determinism.
-            continue;
+            // Short arc from the cached state; first-order guess dchi/dt = sqrt(mu) / r.
+            x = sqrt_mu * dt_cache / norm(r_cache_);
+            code = propagate_(r_cache_, v_cache_, dt_cache, /*warm=*/true, x, r, v);
+            x += chi_cache_;
+            ++since_anchor_;
+            ++cached_solves_;
+        }
+        else
+        {
+            // Epoch re-anchor, warm-started from the cached anomaly when that is the nearer one.
+            if (cache_nearer)
+            {
+                x = chi_cache_ + sqrt_mu * dt_cache / norm(r_cache_);
+            }
+            code = propagate_(r0_, v0_, dt, /*warm=*/cache_nearer, x, r, v);
+            since_anchor_ = 0;
+            ++epoch_solves_;
         }
 
-        x = x - F / dF;
+        cache_valid_ = (code == ProviderCode::kOk);
+        if (cache_valid_)
+        {
+            t_cache_ = t0;
+            r_cache_ = r;
+            v_cache_ = v;
+            chi_cache_ = x;
+        }
     }
 
-    // Compute f, g and propagate.
-    const double x2 = x * x;
-    const double z = alpha * x2;
-    const double C = stumpff_C(z);
-    const double S = stumpff_S(z);
+    if (code != ProviderCode::kOk)
+    {
+        out.status.code = code;
+        return out;
+    }
 
-    const double f = 1.0 - (x2 / r0n) * C;
-    const double g = dt - (x2 * x / sqrt_mu) * S;
+    out.time_tag = t0; // exact by definition
+    out.r_i = r;
+    out.v_i = v;
+    out.status.code = ProviderCode::kOk;
+    return out;
+}
 
-    const Vec3 r = f * r0_ + g * v0_;
-    const double rn = norm(r);
+ProviderCode TwoBodyChiefProvider::get_many(Span<const double> t0s, Span<ChiefState> out) noexcept
+{
+    if (out.size < t0s.size || (t0s.size > 0 && (t0s.data == nullptr || out.data == nullptr)))
+    {
+        return ProviderCode::kInvalidInput;
+    }
 
-    // Compute fdot, gdot
-    // fdot = sqrt(mu)/(r0*rn) * (z*S - 1) * x
-    // gdot = 1 - x^2/rn * C
-    double fdot = 0.0;
-    double gdot = 0.0;
-    if (rn > 0.0 && std::isfinite(rn))
+    ProviderCode first_error = ProviderCode::kOk;
+    for (std::size_t i = 0; i < t0s.size; ++i)
     {
-        fdot = (sqrt_mu / (r0n * rn)) * (z * S - 1.0) * x;
-        gdot = 1.0 - (x2 / rn) * C;
+        out[i] = get(t0s[i]);
+        if (first_error == ProviderCode::kOk && out[i].status.code != ProviderCode::kOk)
+        {
+            first_error = out[i].status.code;
+        }
     }
-    else
+    return first_error;
+}
+
+bool TwoBodyChiefProvider::configure_incremental(const TwoBodyIncrementalConfig& config) noexcept
+{
+    if (config.reanchor_interval == 0)
     {
-        out.status.code = ProviderCode::kInternalError;
-        return out;
+        return false;
     }
+    incremental_ = config;
+    cache_valid_ = false;
+    since_anchor_ = 0;
+    return true;
+}
 
-    const Vec3 v = fdot * r0_ + gdot * v0_;
+ProviderCode TwoBodyChiefProvider::propagate_(const Vec3& ra, const Vec3& va, double dt, bool warm,
+                                              double& x, Vec3& r_out, Vec3& v_out) noexcept
+{
+    if (!warm)
+    {
+        const double r0n = norm(ra);
+        const double alpha = 2.0 / r0n - dot(va, va) / mu_;
+        x = math::universal_initial_guess(alpha, std::sqrt(mu_), r0n, dt);
+    }
 
-    // Final sanity: finite outputs.
-    if (!is_finite_vec(r) || !is_finite_vec(v) || !std::isfinite(rn))
+    math::UniversalPropagation prop{};
+    if (!math::universal_propagate(ra, va, mu_, dt, x, kKeplerIters, prop))
     {
-        out.status.code = ProviderCode::kInternalError;
-        return out;
+        return ProviderCode::kInternalError;
     }
+    newton_iterations_ += static_cast<std::uint64_t>(prop.iterations);
 
-    out.time_tag = t0; // exact by definition
-    out.r_i = r;
-    out.v_i = v;
-    out.status.code = ProviderCode::kOk;
-    return out;
+    x = prop.chi;
+    r_out = prop.r_i;
+    v_out = prop.v_i;
+    return ProviderCode::kOk;
 }
 
 } // namespace bullseye_pred
@@ -3,15 +3,32 @@
 
 /**
  * @file provider_twobody.hpp
- * @brief Deterministic two-body chief state provider (universal-variable f-g propagation).
+ * @brief Deterministic two-body chief state provider (elements or universal-variable f-g).
  *
  * Intent
  * - Provide a chief source that can always return a state for any requested `t0`
  *   (satisfies FR-14 exact-time by construction).
  *
  * Determinism policy
- * - Fixed iteration count for Kepler solve (no early exit).
- * - No allocations in `get()`.
+ * - Elliptic fast path (epoch eccentricity < kMaxEllipticEccentricity): the epoch state is
+ *   converted once, at construction, to elements and a perifocal basis. get() then solves the
+ *   scalar Kepler equation for the eccentric anomaly (math::solve_kepler_elliptic_quartic(),
+ *   a fixed kEllipticIters quartic iterations from Danby's starter, mean anomaly reduced to
+ *   [-pi, pi]) and maps the perifocal state back through the cached basis. Cost and accuracy
+ *   no longer depend on |t0 - t_epoch|, and there is no iteration cap to stop short on.
+ * - Otherwise (near-parabolic, hyperbolic, or the fast path disabled): universal-variable
+ *   solve via math::universal_propagate(): input-defined step tolerance with a fixed
+ *   iteration cap (kKeplerIters).
+ * - No allocations in `get()` / `get_many()`.
+ *
+ * Incremental mode (opt-in, TwoBodyIncrementalConfig; universal variables only)
+ * - A cold solve from `t_epoch` needs every Newton iteration once |t0 - t_epoch| spans many
+ *   orbits, and its precision degrades with the size of the universal anomaly.
+ * - In incremental mode the provider caches the last solved (t, r, v, chi) and propagates from
+ *   whichever of {epoch, cached state} is nearer in time, so each solve covers a short arc.
+ * - Every `reanchor_interval` solves the state is re-propagated from the epoch (warm-started
+ *   from the cached chi; the universal anomaly is additive along the orbit), which bounds
+ *   drift and makes the result a function of the epoch state and the request sequence only.
  *
  * Logging policy (sim-logger)
  * - INFO on init (frame_id, mu, t_epoch)
@@ -19,12 +36,32 @@
  * - No logging on successful `get()`
  */
 
+#include <cstddef>
+#include <cstdint>
+
 #include "core/chief_state_provider.hpp"
 #include "core/types.hpp"
+#include "models/relative_model.hpp"
 
 namespace bullseye_pred
 {
 
+/**
+ * @brief Incremental (warm-started) propagation settings for TwoBodyChiefProvider.
+ */
+struct TwoBodyIncrementalConfig final
+{
+    /** @brief Propagate from the last solved state when it is nearer than the epoch. */
+    bool enabled{false};
+
+    /**
+     * @brief Re-propagate from the epoch every reanchor_interval solves (>= 1).
+     *
+     * 1 re-anchors every call (warm guess only, epoch-referenced result).
+     */
+    std::uint32_t reanchor_interval{64};
+};
+
 class TwoBodyChiefProvider final : public IChiefStateProvider
 {
   public:
@@ -40,10 +77,73 @@ class TwoBodyChiefProvider final : public IChiefStateProvider
 
     [[nodiscard]] ChiefState get(double t0) noexcept override;
 
+    /**
+     * @brief Get chief states for several times, in order (same per-entry contract as get()).
+     *
+     * In incremental mode each entry warm-starts from the previous one, so monotonic epochs
+     * are cheapest.
+     *
+     * @param t0s Requested times.
+     * @param out Output states (>= t0s.size elements).
+     * @return kOk if every entry succeeded; otherwise the first non-OK entry code, or
+     *         kInvalidInput (nothing written) if out is too small.
+     */
+    [[nodiscard]] ProviderCode get_many(Span<const double> t0s, Span<ChiefState> out) noexcept;
+
+    /**
+     * @brief Enable/disable incremental propagation. Clears the cached state.
+     *
+     * @return false (config unchanged) if reanchor_interval == 0.
+     */
+    bool configure_incremental(const TwoBodyIncrementalConfig& config) noexcept;
+
+    /**
+     * @brief Allow the elliptic fast path (default on). Incremental mode, when enabled, keeps
+     *        universal variables either way.
+     */
+    void set_elliptic_fast_path(bool enabled) noexcept { elliptic_enabled_ = enabled; }
+
+    /** @brief True if get() solves Kepler's equation on the cached elements. */
+    [[nodiscard]] bool elliptic_fast_path() const noexcept
+    {
+        return elliptic_enabled_ && elements_valid_ && !incremental_.enabled;
+    }
+
+    /** @brief Current incremental configuration. */
+    [[nodiscard]] const TwoBodyIncrementalConfig& incremental() const noexcept
+    {
+        return incremental_;
+    }
+
+    /** @brief Number of solves propagated from the epoch (cold or re-anchored). */
+    [[nodiscard]] std::uint64_t epoch_solves() const noexcept { return epoch_solves_; }
+
+    /** @brief Number of solves propagated from the cached state. */
+    [[nodiscard]] std::uint64_t cached_solves() const noexcept { return cached_solves_; }
+
+    /** @brief Number of solves on the elliptic fast path. */
+    [[nodiscard]] std::uint64_t elliptic_solves() const noexcept { return elliptic_solves_; }
+
+    /** @brief Total Newton iterations across all universal-variable solves. */
+    [[nodiscard]] std::uint64_t newton_iterations() const noexcept { return newton_iterations_; }
+
   private:
     void log_invalid_config_once_(const char* why) noexcept;
 
+    // Epoch elements and perifocal basis (elements_valid_ if the epoch state is elliptic and
+    // below kMaxEllipticEccentricity).
+    void init_elements_() noexcept;
+
+    // Elliptic fast path: position and velocity dt after the epoch.
+    void propagate_elliptic_(double dt, Vec3& r_out, Vec3& v_out) const noexcept;
+
+    // Universal-variable propagation of (ra, va) by dt from the initial guess x. On kOk, x holds
+    // the solved universal anomaly of the arc.
+    [[nodiscard]] ProviderCode propagate_(const Vec3& ra, const Vec3& va, double dt, bool warm,
+                                          double& x, Vec3& r_out, Vec3& v_out) noexcept;
+
     const char* inertial_frame_id_{nullptr};
+    FrameHandle inertial_frame_{FrameHandle::kNone};
     double mu_{0.0};
     double t_epoch_{0.0};
     Vec3 r0_{};
@@ -51,8 +151,45 @@ class TwoBodyChiefProvider final : public IChiefStateProvider
 
     bool invalid_logged_{false};
 
-    // Fixed iteration count for universal-variable solve (deterministic control flow).
+    bool elliptic_enabled_{true};
+
+    // Epoch elements. p_hat is the periapsis direction (the epoch position when e == 0), q_hat
+    // = h_hat x p_hat, b the semi-minor axis, n the mean motion and m0 the mean anomaly at the
+    // epoch.
+    bool elements_valid_{false};
+    Vec3 p_hat_{};
+    Vec3 q_hat_{};
+    double a_{0.0};
+    double e_{0.0};
+    double b_{0.0};
+    double n_{0.0};
+    double m0_{0.0};
+    double sqrt_mu_a_{0.0};
+    double sqrt_1me2_{0.0};
+
+    TwoBodyIncrementalConfig incremental_{};
+
+    // Last solved state (incremental mode). chi is the universal anomaly from the epoch.
+    bool cache_valid_{false};
+    double t_cache_{0.0};
+    Vec3 r_cache_{};
+    Vec3 v_cache_{};
+    double chi_cache_{0.0};
+    std::uint32_t since_anchor_{0};
+
+    std::uint64_t epoch_solves_{0};
+    std::uint64_t cached_solves_{0};
+    std::uint64_t elliptic_solves_{0};
+    std::uint64_t newton_iterations_{0};
+
+    // Newton iteration cap for the universal-variable solve.
     static constexpr int kKeplerIters = 12;
+
+    // Fixed quartic iterations of the elliptic solve: a few ulp of M for e <= 0.95.
+    static constexpr int kEllipticIters = 3;
+
+    // Above this eccentricity the universal-variable solve is used (near-parabolic orbits).
+    static constexpr double kMaxEllipticEccentricity = 0.95;
 };
 
 } // namespace bullseye_pred
@@ -0,0 +1,235 @@
+// core/provider_twobody_fleet.cpp
+#include "core/provider_twobody_fleet.hpp"
+
+#include "core/frame_id_registry.hpp"
+#include "core/log_names.hpp"
+#include "core/logging.hpp"
+#include "core/math/universal_kepler.hpp"
+#include "core/log_macros.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bullseye_pred
+{
+
+TwoBodyVehicleProvider::TwoBodyVehicleProvider(const char* inertial_frame_id, double mu) noexcept
+    : inertial_frame_id_(inertial_frame_id), inertial_frame_(intern_frame_id(inertial_frame_id)),
+      mu_(mu), sqrt_mu_(std::sqrt(mu))
+{
+    BULLSEYE_LOG_INFOF(logname::kCoreProviderTwoBody,
+                       "init(fleet): frame_id=%s mu=%.17g capacity=%zu",
+                       inertial_frame_id_ ? inertial_frame_id_ : "(null)", mu_, kCapacity);
+}
+
+void TwoBodyVehicleProvider::log_invalid_config_once_(const char* why) noexcept
+{
+    if (invalid_logged_)
+    {
+        return;
+    }
+    invalid_logged_ = true;
+    BULLSEYE_LOG_ERRORF(logname::kCoreProviderTwoBody, "invalid configuration (fleet): %s", why);
+}
+
+bool TwoBodyVehicleProvider::add_vehicle(VehicleIndexMap::VehicleId id, double t_epoch,
+                                         const Vec3& r_epoch_i, const Vec3& v_epoch_i) noexcept
+{
+    const double r0n = norm(r_epoch_i);
+    if (!std::isfinite(t_epoch) || !finite3(r_epoch_i) || !finite3(v_epoch_i) ||
+        !(r0n > 0.0) || !std::isfinite(r0n))
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreProviderTwoBody,
+                           "add_vehicle: rejected id=%llu (non-finite or zero epoch state)",
+                           static_cast<unsigned long long>(id));
+        return false;
+    }
+    const auto col = index_.register_vehicle(id);
+    if (!col.has_value())
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreProviderTwoBody,
+                           "add_vehicle: rejected id=%llu (capacity %zu)",
+                           static_cast<unsigned long long>(id), kCapacity);
+        return false;
+    }
+
+    // Same expressions as math::universal_propagate(), so the constants are bit-identical.
+    const std::size_t c = *col;
+    cols_.t_epoch[c] = t_epoch;
+    cols_.rx[c] = r_epoch_i.x;
+    cols_.ry[c] = r_epoch_i.y;
+    cols_.rz[c] = r_epoch_i.z;
+    cols_.vx[c] = v_epoch_i.x;
+    cols_.vy[c] = v_epoch_i.y;
+    cols_.vz[c] = v_epoch_i.z;
+    cols_.r0n[c] = r0n;
+    cols_.alpha[c] = 2.0 / r0n - dot(v_epoch_i, v_epoch_i) / mu_;
+    cols_.rv_over_sqrt_mu[c] = dot(r_epoch_i, v_epoch_i) / sqrt_mu_;
+    cols_.one_minus_alpha_r0[c] = 1.0 - cols_.alpha[c] * r0n;
+
+    BULLSEYE_LOG_INFOF(logname::kCoreProviderTwoBody, "add_vehicle: id=%llu col=%zu t_epoch=%.17g",
+                       static_cast<unsigned long long>(id), c, t_epoch);
+    return true;
+}
+
+VehicleState TwoBodyVehicleProvider::get(VehicleIndexMap::VehicleId id, double t0) noexcept
+{
+    VehicleState out{};
+    (void)get_many(Span<const VehicleIndexMap::VehicleId>{&id, 1}, t0, Span<VehicleState>{&out, 1},
+                   Span<Vec3>{}, Span<Vec3>{});
+    return out;
+}
+
+ProviderCode TwoBodyVehicleProvider::get_many(Span<const VehicleIndexMap::VehicleId> ids,
+                                              double t0, Span<VehicleState> out,
+                                              Span<Vec3> out_r_i, Span<Vec3> out_v_i) noexcept
+{
+    const std::size_t n = ids.size;
+    if (out.size < n || (out_r_i.size != 0 && out_r_i.size < n) ||
+        (out_v_i.size != 0 && out_v_i.size < n))
+    {
+        return ProviderCode::kInvalidInput;
+    }
+
+    ProviderCode config = ProviderCode::kOk;
+    if (inertial_frame_id_ == nullptr)
+    {
+        config = ProviderCode::kInvalidInput;
+        log_invalid_config_once_("inertial_frame_id is null");
+    }
+    else if (!(mu_ > 0.0) || !std::isfinite(mu_))
+    {
+        config = ProviderCode::kInvalidInput;
+        log_invalid_config_once_("mu must be finite and > 0");
+    }
+    else if (!std::isfinite(t0))
+    {
+        config = ProviderCode::kInvalidInput;
+    }
+
+    // Lanes are filled in chunks of kCapacity requests.
+    for (std::size_t base = 0; base < n; base += kCapacity)
+    {
+        const std::size_t m = std::min(kCapacity, n - base);
+        for (std::size_t j = 0; j < m; ++j)
+        {
+            const auto col = index_.index_of(ids[base + j]);
+            lanes_.col[j] = col.value_or(0u);
+            lanes_.code[j] = (config != ProviderCode::kOk) ? config
+                             : col.has_value()             ? ProviderCode::kOk
+                                                           : ProviderCode::kNotAvailable;
+        }
+        solve_lanes_(m, t0, base, out, out_r_i, out_v_i);
+    }
+
+    ProviderCode first = ProviderCode::kOk;
+    for (std::size_t i = 0; i < n && first == ProviderCode::kOk; ++i)
+    {
+        first = out[i].status.code;
+    }
+    return first;
+}
+
+void TwoBodyVehicleProvider::solve_lanes_(std::size_t m, double t0, std::size_t base,
+                                          Span<VehicleState> out, Span<Vec3> out_r_i,
+                                          Span<Vec3> out_v_i) noexcept
+{
+    const Columns& c = cols_;
+    Lanes& L = lanes_;
+
+    // Cold initial guess per lane (math::universal_initial_guess()).
+    for (std::size_t j = 0; j < m; ++j)
+    {
+        const std::size_t k = L.col[j];
+        L.dt[j] = t0 - c.t_epoch[k];
+        L.x[j] = math::universal_initial_guess(c.alpha[k], sqrt_mu_, c.r0n[k], L.dt[j]);
+        L.done[j] = (L.code[j] != ProviderCode::kOk) ? 1u : 0u;
+        if (L.code[j] == ProviderCode::kOk && !std::isfinite(L.x[j]))
+        {
+            L.code[j] = ProviderCode::kInternalError;
+            L.done[j] = 1u;
+        }
+    }
+
+    // Fixed-count Newton passes over all lanes; a lane that converged (or failed) keeps its x.
+    for (int it = 0; it < kKeplerIters; ++it)
+    {
+        for (std::size_t j = 0; j < m; ++j)
+        {
+            const std::size_t k = L.col[j];
+            const double x = L.x[j];
+            const double x2 = x * x;
+            const double z = c.alpha[k] * x2;
+            const math::StumpffCS cs = math::stumpff_CS(z);
+
+            const double F = c.rv_over_sqrt_mu[k] * x2 * cs.C +
+                             c.one_minus_alpha_r0[k] * x2 * x * cs.S + c.r0n[k] * x -
+                             sqrt_mu_ * L.dt[j];
+            const double dF = c.rv_over_sqrt_mu[k] * x * (1.0 - z * cs.S) +
+                              c.one_minus_alpha_r0[k] * x2 * cs.C + c.r0n[k];
+
+            // A vanishing or non-finite derivative skips the update, as in the scalar solve.
+            const bool step = (dF != 0.0) && std::isfinite(dF) && std::isfinite(F) &&
+                              L.done[j] == 0u;
+            const double dx = step ? F / dF : 0.0;
+            const double xn = x - dx;
+            L.x[j] = step ? xn : x;
+            L.done[j] = (step && std::fabs(dx) <= math::kUniversalChiRelTol * (1.0 + std::fabs(xn)))
+                            ? 1u
+                            : L.done[j];
+        }
+    }
+
+    // f-g evaluation per lane.
+    for (std::size_t j = 0; j < m; ++j)
+    {
+        VehicleState& s = out[base + j];
+        s = VehicleState{};
+        s.frame_id = inertial_frame_id_;
+        s.frame = inertial_frame_;
+        s.status.code = L.code[j];
+
+        if (L.code[j] == ProviderCode::kOk)
+        {
+            const std::size_t k = L.col[j];
+            const Vec3 r0{c.rx[k], c.ry[k], c.rz[k]};
+            const Vec3 v0{c.vx[k], c.vy[k], c.vz[k]};
+            const double x = L.x[j];
+            const double x2 = x * x;
+            const double z = c.alpha[k] * x2;
+            const math::StumpffCS cs = math::stumpff_CS(z);
+
+            const double f = 1.0 - (x2 / c.r0n[k]) * cs.C;
+            const double g = L.dt[j] - (x2 * x / sqrt_mu_) * cs.S;
+            const Vec3 r = f * r0 + g * v0;
+            const double rn = norm(r);
+
+            const double fdot = (sqrt_mu_ / (c.r0n[k] * rn)) * (z * cs.S - 1.0) * x;
+            const double gdot = 1.0 - (x2 / rn) * cs.C;
+            const Vec3 v = fdot * r0 + gdot * v0;
+
+            if (!(rn > 0.0) || !std::isfinite(rn) || !finite3(r) || !finite3(v) ||
+                !std::isfinite(x))
+            {
+                s.status.code = ProviderCode::kInternalError;
+            }
+            else
+            {
+                s.time_tag = t0;
+                s.r_i = r;
+                s.v_i = v;
+            }
+        }
+
+        if (out_r_i.size != 0)
+        {
+            out_r_i[base + j] = s.r_i;
+        }
+        if (out_v_i.size != 0)
+        {
+            out_v_i[base + j] = s.v_i;
+        }
+    }
+}
+
+} // namespace bullseye_pred
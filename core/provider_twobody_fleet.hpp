@@ -0,0 +1,120 @@
+// core/provider_twobody_fleet.hpp
+#pragma once
+
+/**
+ * @file provider_twobody_fleet.hpp
+ * @brief Two-body deputy state provider: every vehicle propagated in one batched solve.
+ *
+ * Intent
+ * - Keplerian deputies for offline studies without one TwoBodyChiefProvider (and one virtual
+ *   call and scalar Newton solve) per vehicle.
+ * - Epoch states and their per-orbit constants live in structure-of-arrays columns. get_many()
+ *   gathers the requested vehicles into lanes and runs the universal-variable Newton solve
+ *   for all lanes together: a fixed kKeplerIters passes, each lane frozen (branch-free select)
+ *   once it meets the step tolerance.
+ *
+ * Determinism policy
+ * - Each lane performs exactly the arithmetic of math::universal_propagate() from the cold
+ *   initial guess, so a vehicle's state is bit-identical to TwoBodyChiefProvider on its
+ *   universal-variable path (incremental mode and the elliptic fast path off) with the same
+ *   epoch state, regardless of which other vehicles share the batch.
+ * - No allocations in get() / get_many().
+ *
+ * Logging policy (sim-logger)
+ * - INFO on init and per add_vehicle(); WARN on a rejected add_vehicle()
+ * - ERROR on invalid configuration (logged once)
+ * - No logging on successful get() / get_many()
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/constants.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+class TwoBodyVehicleProvider final : public IVehicleStateProvider
+{
+  public:
+    /// Vehicles held at most.
+    static constexpr std::size_t kCapacity = MAX_VEHICLES;
+
+    /**
+     * @param inertial_frame_id Must outlive this provider (string literal or config storage).
+     * @param mu Gravitational parameter (m^3/s^2). Must be > 0.
+     */
+    TwoBodyVehicleProvider(const char* inertial_frame_id, double mu) noexcept;
+
+    /**
+     * @brief Add (or replace) the epoch state of vehicle @p id (configuration-time).
+     *
+     * @return false if the epoch state is not finite, |r_epoch_i| is 0, or the provider is
+     *         full.
+     */
+    bool add_vehicle(VehicleIndexMap::VehicleId id, double t_epoch, const Vec3& r_epoch_i,
+                     const Vec3& v_epoch_i) noexcept;
+
+    /** @return number of vehicles held. */
+    [[nodiscard]] std::size_t size() const noexcept { return index_.size(); }
+
+    /** kNotAvailable for ids that were never added. */
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override;
+
+    /** One batched solve for all @p ids (see the file comment). */
+    [[nodiscard]] ProviderCode get_many(Span<const VehicleIndexMap::VehicleId> ids, double t0,
+                                        Span<VehicleState> out, Span<Vec3> out_r_i,
+                                        Span<Vec3> out_v_i) noexcept override;
+
+  private:
+    void log_invalid_config_once_(const char* why) noexcept;
+
+    // Solve lanes [0, m) of lanes_ for t0 and write out[base + j] (and the optional planes).
+    void solve_lanes_(std::size_t m, double t0, std::size_t base, Span<VehicleState> out,
+                      Span<Vec3> out_r_i, Span<Vec3> out_v_i) noexcept;
+
+    const char* inertial_frame_id_{nullptr};
+    FrameHandle inertial_frame_{FrameHandle::kNone};
+    double mu_{0.0};
+    double sqrt_mu_{0.0};
+    bool invalid_logged_{false};
+
+    // id -> column index.
+    VehicleIndexMap index_{kCapacity};
+
+    // Epoch states and per-orbit constants, one column entry per vehicle.
+    struct Columns final
+    {
+        std::array<double, kCapacity> t_epoch{};
+        std::array<double, kCapacity> rx{}, ry{}, rz{};
+        std::array<double, kCapacity> vx{}, vy{}, vz{};
+
+        // |r0|, reciprocal semi-major axis, r0.v0/sqrt(mu), 1 - alpha*|r0|.
+        std::array<double, kCapacity> r0n{};
+        std::array<double, kCapacity> alpha{};
+        std::array<double, kCapacity> rv_over_sqrt_mu{};
+        std::array<double, kCapacity> one_minus_alpha_r0{};
+    };
+    Columns cols_{};
+
+    // Per-call lanes: column index, propagation interval, universal anomaly, done flag.
+    struct Lanes final
+    {
+        std::array<std::size_t, kCapacity> col{};
+        std::array<double, kCapacity> dt{};
+        std::array<double, kCapacity> x{};
+        std::array<unsigned char, kCapacity> done{};
+        std::array<ProviderCode, kCapacity> code{};
+    };
+    Lanes lanes_{};
+
+    // Newton iteration cap; same as TwoBodyChiefProvider.
+    static constexpr int kKeplerIters = 12;
+};
+
+} // namespace bullseye_pred
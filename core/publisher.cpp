@@ -1,53 +1,852 @@
 #include "core/publisher.hpp"
 
+#include "core/checkpoint.hpp"
 #include "core/log_names.hpp"
 #include "core/logging.hpp"
-#include "logger/log_macros.hpp"
+#include "core/shm_snapshot.hpp"
+#include "core/wait_notify.hpp"
+#include "core/log_macros.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <new>
+#include <type_traits>
 
 namespace bullseye_pred
 {
 
+namespace
+{
+
+// Configured compact precision, or kFloat64 if the fixed-point scale is unusable.
+OutputPrecision resolved_precision(const PublisherConfig& config) noexcept
+{
+    if (config.precision == OutputPrecision::kFixed32 &&
+        !(config.fixed32_scale_m > 0.0 && std::isfinite(config.fixed32_scale_m)))
+    {
+        return OutputPrecision::kFloat64;
+    }
+    return config.precision;
+}
+
+// Fixed prefix of a kPublisher section; one PublisherSlotCheckpoint, the buffer and its
+// velocity / inertial / covariance planes follow per slot.
+struct PublisherCheckpoint final
+{
+    std::uint64_t seqno{0};
+    std::uint64_t front_index{0};
+    std::uint64_t slots{0};
+    std::uint32_t velocities{0};
+    std::uint32_t inertial_positions{0};
+    std::uint32_t position_covariance{0};
+};
+
+struct PublisherSlotCheckpoint final
+{
+    std::uint64_t seqno{0};
+    double t0{0.0};
+};
+
+static_assert(std::is_trivially_copyable<PredictionBuffer>::value,
+              "publisher slots are checkpointed by raw copy");
+
+} // namespace
+
+Publisher::Publisher(const PublisherConfig& config) noexcept
+{
+    std::size_t slots = config.slots;
+    if (config.history > 0u)
+    {
+        const std::size_t want = (config.history < kMaxSlots) ? config.history + kInlineBuffers
+                                                              : kMaxSlots;
+        slots = std::min(std::max(slots, want), kMaxSlots);
+    }
+    if (slots < kInlineBuffers || slots > kMaxSlots)
+    {
+        slots = kInlineBuffers;
+    }
+
+    if (config.shm_name != nullptr)
+    {
+        if (init_shared_(config, slots))
+        {
+            return;
+        }
+        BULLSEYE_LOG_WARNF(logname::kCorePublisher,
+                           "shared-memory segment %s unavailable (code=%d); using local buffers",
+                           config.shm_name, static_cast<int>(shm_status_));
+    }
+
+    if (config.placement.requested())
+    {
+        if (init_placed_(config, slots))
+        {
+            return;
+        }
+        BULLSEYE_LOG_WARNF(logname::kCorePublisher,
+                           "placed buffer mapping unavailable; using heap buffers");
+    }
+
+    if (slots > kInlineBuffers)
+    {
+        extra_buffers_.reset(new (std::nothrow) PredictionBuffer[slots - kInlineBuffers]());
+        if (extra_buffers_)
+        {
+            for (std::size_t i = kInlineBuffers; i < slots; ++i)
+            {
+                slot_ptr_[i] = &extra_buffers_[i - kInlineBuffers];
+            }
+            num_slots_ = slots;
+        }
+    }
+
+    if (config.velocities)
+    {
+        velocity_storage_.reset(new (std::nothrow) TrajectoryPlane[num_slots_]());
+        if (velocity_storage_)
+        {
+            for (std::size_t i = 0; i < num_slots_; ++i)
+            {
+                slot(i).velocities = &velocity_storage_[i];
+            }
+            has_velocities_ = true;
+        }
+    }
+
+    if (config.inertial_positions)
+    {
+        inertial_storage_.reset(new (std::nothrow) TrajectoryPlane[num_slots_]());
+        if (inertial_storage_)
+        {
+            for (std::size_t i = 0; i < num_slots_; ++i)
+            {
+                slot(i).positions_i = &inertial_storage_[i];
+            }
+            has_inertial_ = true;
+        }
+    }
+
+    if (config.position_covariance)
+    {
+        covariance_storage_.reset(new (std::nothrow) CovariancePlane[num_slots_]());
+        if (covariance_storage_)
+        {
+            for (std::size_t i = 0; i < num_slots_; ++i)
+            {
+                slot(i).position_cov = &covariance_storage_[i];
+            }
+            has_covariance_ = true;
+        }
+    }
+
+    if (config.soa_layout != SoaLayout::kNone)
+    {
+        soa_storage_.reset(new (std::nothrow) SoaPositionPlanes[num_slots_]());
+        if (soa_storage_)
+        {
+            for (std::size_t i = 0; i < num_slots_; ++i)
+            {
+                soa_storage_[i].layout = config.soa_layout;
+                slot(i).soa = &soa_storage_[i];
+            }
+            soa_layout_ = config.soa_layout;
+        }
+    }
+
+    if (config.precision == OutputPrecision::kFloat32)
+    {
+        f32_storage_.reset(new (std::nothrow) Float32Plane[num_slots_]());
+        if (f32_storage_)
+        {
+            for (std::size_t i = 0; i < num_slots_; ++i)
+            {
+                slot(i).positions_f32 = &f32_storage_[i];
+            }
+            precision_ = OutputPrecision::kFloat32;
+        }
+    }
+    else if (config.precision == OutputPrecision::kFixed32 && config.fixed32_scale_m > 0.0 &&
+             std::isfinite(config.fixed32_scale_m))
+    {
+        q32_storage_.reset(new (std::nothrow) Fixed32Plane[num_slots_]());
+        if (q32_storage_)
+        {
+            for (std::size_t i = 0; i < num_slots_; ++i)
+            {
+                slot(i).positions_q32 = &q32_storage_[i];
+                slot(i).q32_scale_m = config.fixed32_scale_m;
+            }
+            precision_ = OutputPrecision::kFixed32;
+        }
+    }
+}
+
+Publisher::~Publisher()
+{
+    if (is_shared())
+    {
+        // Tell mapped readers the producer is gone before the name is unlinked.
+        static_cast<ShmSegmentHeader*>(shm_.data())->magic.store(0u, std::memory_order_release);
+    }
+}
+
+bool Publisher::init_shared_(const PublisherConfig& config, std::size_t slots) noexcept
+{
+    const bool velocities = config.velocities;
+    const bool inertial = config.inertial_positions;
+    const bool covariance = config.position_covariance;
+    const SoaLayout soa = config.soa_layout;
+    const OutputPrecision precision = resolved_precision(config);
+
+    const ShmLayout layout =
+        shm_layout(slots, velocities, soa != SoaLayout::kNone,
+                   precision != OutputPrecision::kFloat64, inertial, covariance);
+    shm_status_ = shm_.create(config.shm_name, layout.segment_bytes);
+    if (shm_status_ != ShmCode::kOk)
+    {
+        return false;
+    }
+
+    // The object is zero-filled; construct the header and buffers in place.
+    auto* const base = static_cast<unsigned char*>(shm_.data());
+    auto* const hdr = new (base) ShmSegmentHeader{};
+    hdr->layout_version = kShmLayoutVersion;
+    hdr->header_bytes = static_cast<std::uint32_t>(sizeof(ShmSegmentHeader));
+    hdr->max_vehicles = static_cast<std::uint32_t>(MAX_VEHICLES);
+    hdr->max_steps = static_cast<std::uint32_t>(MAX_STEPS);
+    hdr->slots = static_cast<std::uint32_t>(slots);
+    hdr->has_velocities = velocities ? 1u : 0u;
+    hdr->buffer_bytes = sizeof(PredictionBuffer);
+    hdr->buffers_offset = layout.buffers_offset;
+    hdr->buffer_stride = layout.buffer_stride;
+    hdr->velocities_offset = layout.velocities_offset;
+    hdr->plane_stride = layout.plane_stride;
+    hdr->has_inertial_positions = inertial ? 1u : 0u;
+    hdr->inertial_offset = layout.inertial_offset;
+    hdr->has_position_covariance = covariance ? 1u : 0u;
+    hdr->covariance_offset = layout.covariance_offset;
+    hdr->covariance_stride = layout.covariance_stride;
+    hdr->soa_layout = static_cast<std::uint32_t>(soa);
+    hdr->soa_offset = layout.soa_offset;
+    hdr->soa_stride = layout.soa_stride;
+    hdr->precision = static_cast<std::uint32_t>(precision);
+    hdr->compact_offset = layout.compact_offset;
+    hdr->compact_stride = layout.compact_stride;
+    hdr->q32_scale_m = (precision == OutputPrecision::kFixed32) ? config.fixed32_scale_m : 0.0;
+    hdr->segment_bytes = layout.segment_bytes;
+
+    if (config.placement.requested())
+    {
+        placement_ = apply_page_placement(base, layout.segment_bytes, config.placement);
+    }
+    construct_slots_(base, slots, config, precision);
+    num_slots_ = slots;
+    has_velocities_ = velocities;
+    has_inertial_ = inertial;
+    has_covariance_ = covariance;
+    soa_layout_ = soa;
+    precision_ = precision;
+    shared_ = &hdr->shared;
+
+    // Readers accept the segment only once the header is complete.
+    hdr->magic.store(kShmMagic, std::memory_order_release);
+    return true;
+}
+
+bool Publisher::init_placed_(const PublisherConfig& config, std::size_t slots) noexcept
+{
+    const OutputPrecision precision = resolved_precision(config);
+
+    // Same offsets as a shared segment; the header block stays unused.
+    const ShmLayout layout =
+        shm_layout(slots, config.velocities, config.soa_layout != SoaLayout::kNone,
+                   precision != OutputPrecision::kFloat64, config.inertial_positions,
+                   config.position_covariance);
+    if (!placed_.map(layout.segment_bytes, config.placement))
+    {
+        return false;
+    }
+    placement_ = placed_.report();
+    construct_slots_(static_cast<unsigned char*>(placed_.data()), slots, config, precision);
+    num_slots_ = slots;
+    has_velocities_ = config.velocities;
+    has_inertial_ = config.inertial_positions;
+    has_covariance_ = config.position_covariance;
+    soa_layout_ = config.soa_layout;
+    precision_ = precision;
+    return true;
+}
+
+void Publisher::construct_slots_(unsigned char* base,
+                                 std::size_t slots,
+                                 const PublisherConfig& config,
+                                 OutputPrecision precision) noexcept
+{
+    const bool velocities = config.velocities;
+    const bool inertial = config.inertial_positions;
+    const bool covariance = config.position_covariance;
+    const SoaLayout soa = config.soa_layout;
+    const ShmLayout layout =
+        shm_layout(slots, velocities, soa != SoaLayout::kNone,
+                   precision != OutputPrecision::kFloat64, inertial, covariance);
+
+    for (std::size_t i = 0; i < slots; ++i)
+    {
+        PredictionBuffer* const buf =
+            new (base + layout.buffers_offset + i * layout.buffer_stride) PredictionBuffer{};
+        if (velocities)
+        {
+            buf->velocities = new (base + layout.velocities_offset + i * layout.plane_stride)
+                TrajectoryPlane{};
+        }
+        if (inertial)
+        {
+            buf->positions_i = new (base + layout.inertial_offset + i * layout.plane_stride)
+                TrajectoryPlane{};
+        }
+        if (covariance)
+        {
+            buf->position_cov =
+                new (base + layout.covariance_offset + i * layout.covariance_stride)
+                    CovariancePlane{};
+        }
+        if (soa != SoaLayout::kNone)
+        {
+            buf->soa = new (base + layout.soa_offset + i * layout.soa_stride) SoaPositionPlanes{};
+            buf->soa->layout = soa;
+        }
+        unsigned char* const compact = base + layout.compact_offset + i * layout.compact_stride;
+        if (precision == OutputPrecision::kFloat32)
+        {
+            buf->positions_f32 = new (compact) Float32Plane{};
+        }
+        else if (precision == OutputPrecision::kFixed32)
+        {
+            buf->positions_q32 = new (compact) Fixed32Plane{};
+            buf->q32_scale_m = config.fixed32_scale_m;
+        }
+        slot_ptr_[i] = buf;
+    }
+}
+
+std::size_t Publisher::pick_back_() noexcept
+{
+    const std::size_t front = shared_->front_index.load(std::memory_order_acquire);
+    if (num_slots_ == kInlineBuffers)
+    {
+        return 1u - front;
+    }
+
+    // Oldest published slot that is neither front nor leased; if every candidate is leased,
+    // the oldest candidate (never block; its leases fail validation).
+    std::size_t best_free = kNoSlot;
+    std::size_t best_any = kNoSlot;
+    for (std::size_t i = 0; i < num_slots_; ++i)
+    {
+        if (i == front)
+        {
+            continue;
+        }
+        const std::uint64_t seq = shared_->slots[i].seqno.load(std::memory_order_relaxed);
+        if (best_any == kNoSlot || seq < shared_->slots[best_any].seqno.load(std::memory_order_relaxed))
+        {
+            best_any = i;
+        }
+        if (shared_->slots[i].readers.load() == 0u &&
+            (best_free == kNoSlot ||
+             seq < shared_->slots[best_free].seqno.load(std::memory_order_relaxed)))
+        {
+            best_free = i;
+        }
+    }
+    if (best_free == kNoSlot)
+    {
+        ++lease_overruns_;
+        return best_any;
+    }
+    return best_free;
+}
+
 PredictionBuffer& Publisher::begin_write() noexcept
 {
-    const std::size_t front = front_index_.load(std::memory_order_acquire);
-    const std::size_t back = 1u - front;
-    return buffers_[back];
+    if (back_ == kNoSlot)
+    {
+        back_ = pick_back_();
+        // Seqlock: odd while the buffer is being written; drop it from history lookups.
+        shared_->slots[back_].version.fetch_add(1u);
+        shared_->slots[back_].seqno.store(0u);
+    }
+    return slot(back_);
+}
+
+void Publisher::abandon_write() noexcept
+{
+    if (back_ == kNoSlot)
+    {
+        return;
+    }
+    slot(back_).seqno = 0;
+    shared_->slots[back_].version.fetch_add(1u);
+    back_ = kNoSlot;
 }
 
 std::uint64_t Publisher::publish(double t0) noexcept
 {
-    static auto log = bullseye_pred::logging::get(bullseye_pred::logname::kCorePublisher);
+    return publish(t0, kAllRows);
+}
+
+std::uint64_t Publisher::publish(double t0, RowMask dirty) noexcept
+{
+    return publish(t0, dirty, 0u);
+}
 
-    // Determine back buffer (the one not currently visible).
-    const std::size_t front = front_index_.load(std::memory_order_acquire);
-    const std::size_t back = 1u - front;
+std::uint64_t Publisher::publish(double t0, RowMask dirty, RowMask own_epoch) noexcept
+{
+    // Back buffer (the one not currently visible).
+    PredictionBuffer& buf = begin_write();
+    const std::size_t back = back_;
 
     // Increment seqno and stamp into the buffer before publishing.
-    const std::uint64_t new_seq = seqno_.fetch_add(1u, std::memory_order_relaxed) + 1u;
-    buffers_[back].seqno = new_seq;
-    buffers_[back].t0 = t0;
+    const std::uint64_t new_seq = shared_->seqno.fetch_add(1u, std::memory_order_relaxed) + 1u;
+
+    // Carry clean rows over from the front. The back buffer still holds the snapshot it last
+    // published (buf.seqno), so only rows the front changed after that need their samples.
+    dirty &= kAllRows;
+    RowMask rewritten = dirty;
+    const PredictionBuffer& prev = slot(shared_->front_index.load(std::memory_order_relaxed));
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        const RowMask bit = RowMask{1} << i;
+        if ((dirty & bit) != 0u)
+        {
+            buf.row_seqno[i] = new_seq;
+            if ((own_epoch & bit) == 0u)
+            {
+                buf.row_t0[i] = t0;
+            }
+            continue;
+        }
+        if (prev.row_seqno[i] > buf.seqno)
+        {
+            const std::size_t n = std::min(prev.row_steps(i), MAX_STEPS);
+            std::copy_n(prev.positions[i].data(), n, buf.positions[i].data());
+            if (buf.velocities != nullptr && prev.velocities != nullptr)
+            {
+                std::copy_n((*prev.velocities)[i].data(), n, (*buf.velocities)[i].data());
+            }
+            if (buf.positions_i != nullptr && prev.positions_i != nullptr)
+            {
+                std::copy_n((*prev.positions_i)[i].data(), n, (*buf.positions_i)[i].data());
+            }
+            if (buf.position_cov != nullptr && prev.position_cov != nullptr &&
+                ((prev.cov_rows >> i) & 1u) != 0u)
+            {
+                std::copy_n((*prev.position_cov)[i].data(), n, (*buf.position_cov)[i].data());
+            }
+            rewritten |= bit;
+            ++carried_row_copies_;
+        }
+        buf.row_seqno[i] = prev.row_seqno[i];
+        buf.row_t0[i] = prev.row_t0[i];
+        buf.row_status[i] = prev.row_status[i];
+        buf.row_grid[i] = prev.row_grid[i];
+        buf.row_model[i] = prev.row_model[i];
+        buf.approach[i] = prev.approach[i];
+        buf.coefficients[i] = prev.coefficients[i];
+    }
+    buf.valid_rows = (buf.valid_rows & dirty) | (prev.valid_rows & ~dirty & kAllRows);
+    buf.cov_rows = (buf.cov_rows & dirty) | (prev.cov_rows & ~dirty & kAllRows);
+    buf.maneuver_rows = (buf.maneuver_rows & dirty) | (prev.maneuver_rows & ~dirty & kAllRows);
+    buf.control_unmodeled_rows =
+        (buf.control_unmodeled_rows & dirty) | (prev.control_unmodeled_rows & ~dirty & kAllRows);
+    buf.coeff_rows = (buf.coeff_rows & dirty) | (prev.coeff_rows & ~dirty & kAllRows);
+    buf.coeff_only_rows =
+        (buf.coeff_only_rows & dirty) | (prev.coeff_only_rows & ~dirty & kAllRows);
+    buf.dirty_rows = dirty;
 
-    // Publish: release so all writes to buffers_[back] become visible to readers.
-    front_index_.store(back, std::memory_order_release);
+    fill_derived_(buf, rewritten);
 
-    LOG_INFOF(log, "publish seqno=%llu t0=%.17g front=%zu",
-              static_cast<unsigned long long>(new_seq), t0, back);
+    buf.seqno = new_seq;
+    buf.t0 = t0;
+    shared_->slots[back].t0.store(t0, std::memory_order_relaxed);
+
+    // Close the write (version even again), then publish: release so all writes to the buffer
+    // become visible to readers.
+    shared_->slots[back].version.fetch_add(1u, std::memory_order_release);
+    shared_->slots[back].seqno.store(new_seq, std::memory_order_release);
+    shared_->front_index.store(back, std::memory_order_release);
+    back_ = kNoSlot;
+
+    // Wake blocked readers. Waiters register before re-checking the word, so a zero count
+    // here means none can sleep through this publish. Readers of a shared segment cannot
+    // register (read-only mapping) and are always woken.
+    shared_->publish_word.store(static_cast<std::uint32_t>(new_seq));
+    if (shared_->waiters.load() != 0u || is_shared())
+    {
+        detail::wake_word_all(shared_->publish_word);
+    }
 
     return new_seq;
 }
 
+bool Publisher::save_checkpoint(CheckpointWriter& out, std::uint32_t instance) const
+{
+    if (back_ != kNoSlot)
+    {
+        return false;
+    }
+    PublisherCheckpoint hdr{};
+    hdr.seqno = shared_->seqno.load(std::memory_order_relaxed);
+    hdr.front_index = shared_->front_index.load(std::memory_order_relaxed);
+    hdr.slots = num_slots_;
+    hdr.velocities = has_velocities_ ? 1u : 0u;
+    hdr.inertial_positions = has_inertial_ ? 1u : 0u;
+    hdr.position_covariance = has_covariance_ ? 1u : 0u;
+
+    out.begin_section(CheckpointSection::kPublisher, instance);
+    out.append_value(hdr);
+    for (std::size_t i = 0; i < num_slots_; ++i)
+    {
+        PublisherSlotCheckpoint sc{};
+        sc.seqno = shared_->slots[i].seqno.load(std::memory_order_relaxed);
+        sc.t0 = shared_->slots[i].t0.load(std::memory_order_relaxed);
+        out.append_value(sc);
+        out.append_value(slot(i));
+        if (has_velocities_)
+        {
+            out.append_value(*slot(i).velocities);
+        }
+        if (has_inertial_)
+        {
+            out.append_value(*slot(i).positions_i);
+        }
+        if (has_covariance_)
+        {
+            out.append_value(*slot(i).position_cov);
+        }
+    }
+    return true;
+}
+
+CheckpointCode Publisher::restore_checkpoint(const CheckpointFile& in,
+                                             std::uint32_t instance) noexcept
+{
+    if (!in.has_section(CheckpointSection::kPublisher, instance))
+    {
+        return CheckpointCode::kMissingSection;
+    }
+    if (back_ != kNoSlot)
+    {
+        return CheckpointCode::kInvalidInput;
+    }
+    CheckpointCursor cur = in.cursor(CheckpointSection::kPublisher, instance);
+    PublisherCheckpoint hdr{};
+    const std::size_t per_slot = sizeof(PublisherSlotCheckpoint) + sizeof(PredictionBuffer) +
+                                 (has_velocities_ ? sizeof(TrajectoryPlane) : 0u) +
+                                 (has_inertial_ ? sizeof(TrajectoryPlane) : 0u) +
+                                 (has_covariance_ ? sizeof(CovariancePlane) : 0u);
+    if (!cur.read_value(hdr) || hdr.slots != num_slots_ || hdr.front_index >= num_slots_ ||
+        hdr.velocities != (has_velocities_ ? 1u : 0u) ||
+        hdr.inertial_positions != (has_inertial_ ? 1u : 0u) ||
+        hdr.position_covariance != (has_covariance_ ? 1u : 0u) ||
+        cur.remaining() != num_slots_ * per_slot)
+    {
+        return CheckpointCode::kLayoutMismatch;
+    }
+
+    for (std::size_t i = 0; i < num_slots_; ++i)
+    {
+        PublisherSlotCheckpoint sc{};
+        (void)cur.read_value(sc);
+
+        // The saved buffer carries the saving process's plane pointers; keep ours.
+        PredictionBuffer& buf = slot(i);
+        TrajectoryPlane* const velocities = buf.velocities;
+        TrajectoryPlane* const positions_i = buf.positions_i;
+        CovariancePlane* const position_cov = buf.position_cov;
+        SoaPositionPlanes* const soa = buf.soa;
+        Float32Plane* const positions_f32 = buf.positions_f32;
+        Fixed32Plane* const positions_q32 = buf.positions_q32;
+        const double q32_scale_m = buf.q32_scale_m;
+        (void)cur.read_value(buf);
+        buf.velocities = velocities;
+        buf.positions_i = positions_i;
+        buf.position_cov = position_cov;
+        buf.soa = soa;
+        buf.positions_f32 = positions_f32;
+        buf.positions_q32 = positions_q32;
+        buf.q32_scale_m = q32_scale_m;
+        if (velocities != nullptr)
+        {
+            (void)cur.read_value(*velocities);
+        }
+        if (positions_i != nullptr)
+        {
+            (void)cur.read_value(*positions_i);
+        }
+        if (position_cov != nullptr)
+        {
+            (void)cur.read_value(*position_cov);
+        }
+        fill_derived_(buf, kAllRows);
+
+        // Two version steps keep the seqlock even and fail every lease taken before.
+        shared_->slots[i].version.fetch_add(2u);
+        shared_->slots[i].t0.store(sc.t0, std::memory_order_relaxed);
+        shared_->slots[i].seqno.store(sc.seqno, std::memory_order_release);
+    }
+    shared_->seqno.store(hdr.seqno, std::memory_order_relaxed);
+    shared_->front_index.store(static_cast<std::size_t>(hdr.front_index),
+                               std::memory_order_release);
+    shared_->publish_word.store(static_cast<std::uint32_t>(hdr.seqno));
+    return CheckpointCode::kOk;
+}
+
 const PredictionBuffer& Publisher::read() const noexcept
 {
-    const std::size_t front = front_index_.load(std::memory_order_acquire);
-    return buffers_[front];
+    const std::size_t front = shared_->front_index.load(std::memory_order_acquire);
+    return slot(front);
 }
 
 std::uint64_t Publisher::published_seqno() const noexcept
 {
     // The authoritative seqno is the seqno stamped into the currently-front buffer.
-    // Using front buffer avoids any ambiguity about ordering of seqno_ vs front_index_.
+    // Using front buffer avoids any ambiguity about ordering of seqno_ vs shared_->front_index.
     const auto& front = read();
     return front.seqno;
 }
 
+void Publisher::fill_derived_(PredictionBuffer& buf, RowMask rows) noexcept
+{
+    if (buf.soa == nullptr && buf.positions_f32 == nullptr && buf.positions_q32 == nullptr)
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        const RowMask bit = RowMask{1} << i;
+        if ((rows & bit) == 0u)
+        {
+            continue;
+        }
+        const std::size_t steps = std::min(buf.row_steps(i), MAX_STEPS);
+        const Vec3* const r = buf.positions[i].data();
+        if (buf.soa != nullptr)
+        {
+            for (std::size_t k = 0; k < steps; ++k)
+            {
+                buf.soa->set(i, k, r[k]);
+            }
+        }
+        if (buf.positions_f32 != nullptr)
+        {
+            Vec3f* const out = (*buf.positions_f32)[i].data();
+            for (std::size_t k = 0; k < steps; ++k)
+            {
+                out[k] = Vec3f{static_cast<float>(r[k].x), static_cast<float>(r[k].y),
+                               static_cast<float>(r[k].z)};
+            }
+        }
+        if (buf.positions_q32 != nullptr)
+        {
+            const double scale = buf.q32_scale_m;
+            Vec3q* const out = (*buf.positions_q32)[i].data();
+            bool saturated = false;
+            for (std::size_t k = 0; k < steps; ++k)
+            {
+                out[k] = Vec3q{quantize_fixed32(r[k].x, scale, saturated),
+                               quantize_fixed32(r[k].y, scale, saturated),
+                               quantize_fixed32(r[k].z, scale, saturated)};
+            }
+            buf.q32_saturated = saturated ? (buf.q32_saturated | bit) : (buf.q32_saturated & ~bit);
+        }
+    }
+}
+
+std::uint64_t Publisher::wait_for_seqno(std::uint64_t after, double timeout_sec) const noexcept
+{
+    return detail::wait_published(*shared_, after, timeout_sec, true);
+}
+
+std::uint64_t detail::wait_published(const PublisherShared& shared,
+                                     std::uint64_t after,
+                                     double timeout_sec,
+                                     bool register_waiter) noexcept
+{
+    const auto front_seqno = [&shared]() noexcept -> std::uint64_t {
+        const std::size_t f = shared.front_index.load(std::memory_order_acquire);
+        return (f < kPublisherMaxSlots) ? shared.slots[f].seqno.load(std::memory_order_acquire)
+                                        : 0u;
+    };
+
+    const bool bounded = std::isfinite(timeout_sec);
+    const auto deadline =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(bounded ? std::fmax(timeout_sec, 0.0) : 0.0));
+
+    for (;;)
+    {
+        const std::uint32_t word = shared.publish_word.load();
+        const std::uint64_t seq = front_seqno();
+        if (seq > after)
+        {
+            return seq;
+        }
+        double remaining = std::numeric_limits<double>::infinity();
+        if (bounded)
+        {
+            remaining = std::chrono::duration<double>(deadline - std::chrono::steady_clock::now())
+                            .count();
+            if (!(remaining > 0.0))
+            {
+                return seq;
+            }
+        }
+
+        // Register, then sleep only if no publish has happened since `word` was read.
+        if (register_waiter)
+        {
+            shared.waiters.fetch_add(1u);
+        }
+        wait_word(shared.publish_word, word, remaining);
+        if (register_waiter)
+        {
+            shared.waiters.fetch_sub(1u);
+        }
+    }
+}
+
+bool Publisher::pin_(std::size_t i, std::uint64_t expect_seqno, SnapshotLease& out) const noexcept
+{
+    shared_->slots[i].readers.fetch_add(1u);
+    const std::uint64_t v = shared_->slots[i].version.load();
+    const std::uint64_t seq = shared_->slots[i].seqno.load();
+
+    // A write in progress, or a completed rewrite since the caller chose i, fails the pin; the
+    // producer skips leased slots from here on.
+    if ((v & 1u) == 0u && seq != 0u && (expect_seqno == 0u || seq == expect_seqno))
+    {
+        out.release();
+        out.pub_ = this;
+        out.buf_ = &slot(i);
+        out.slot_ = i;
+        out.version_ = v;
+        return true;
+    }
+    shared_->slots[i].readers.fetch_sub(1u);
+    return false;
+}
+
+SnapshotLease Publisher::acquire() const noexcept
+{
+    constexpr int kMaxAttempts = 16;
+
+    SnapshotLease lease{};
+    for (int attempt = 0; attempt < kMaxAttempts; ++attempt)
+    {
+        const std::size_t f = shared_->front_index.load();
+        // Pinned iff f is still front after the pin: the producer never writes the front slot.
+        if (pin_(f, 0u, lease))
+        {
+            if (shared_->front_index.load() == f)
+            {
+                return lease;
+            }
+            lease.release();
+        }
+    }
+    return lease;
+}
+
+SnapshotLease Publisher::acquire_seqno(std::uint64_t seqno) const noexcept
+{
+    SnapshotLease lease{};
+    if (seqno == 0u)
+    {
+        return lease;
+    }
+    for (std::size_t i = 0; i < num_slots_; ++i)
+    {
+        if (shared_->slots[i].seqno.load() == seqno)
+        {
+            (void)pin_(i, seqno, lease);
+            break;
+        }
+    }
+    return lease;
+}
+
+SnapshotLease Publisher::acquire_time(double t0) const noexcept
+{
+    SnapshotLease lease{};
+    std::size_t best = kNoSlot;
+    std::uint64_t best_seq = 0u;
+    for (std::size_t i = 0; i < num_slots_; ++i)
+    {
+        const std::uint64_t seq = shared_->slots[i].seqno.load();
+        if (seq > best_seq && shared_->slots[i].t0.load() <= t0)
+        {
+            best = i;
+            best_seq = seq;
+        }
+    }
+    if (best != kNoSlot)
+    {
+        (void)pin_(best, best_seq, lease);
+    }
+    return lease;
+}
+
+SnapshotLease::SnapshotLease(SnapshotLease&& other) noexcept
+    : pub_(other.pub_), buf_(other.buf_), slot_(other.slot_), version_(other.version_)
+{
+    other.pub_ = nullptr;
+    other.buf_ = nullptr;
+}
+
+SnapshotLease& SnapshotLease::operator=(SnapshotLease&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        pub_ = other.pub_;
+        buf_ = other.buf_;
+        slot_ = other.slot_;
+        version_ = other.version_;
+        other.pub_ = nullptr;
+        other.buf_ = nullptr;
+    }
+    return *this;
+}
+
+SnapshotLease::~SnapshotLease()
+{
+    release();
+}
+
+bool SnapshotLease::valid() const noexcept
+{
+    if (pub_ == nullptr)
+    {
+        return false;
+    }
+    // Order the caller's reads of the buffer before the version re-check (seqlock read side).
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return pub_->shared_->slots[slot_].version.load(std::memory_order_relaxed) == version_;
+}
+
+void SnapshotLease::release() noexcept
+{
+    if (pub_ != nullptr)
+    {
+        pub_->shared_->slots[slot_].readers.fetch_sub(1u);
+        pub_ = nullptr;
+        buf_ = nullptr;
+    }
+}
+
 } // namespace bullseye_pred
@@ -1,14 +1,215 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
+#include "core/page_placement.hpp"
 #include "core/prediction_buffer.hpp"
+#include "core/shm_mapping.hpp"
 
 namespace bullseye_pred
 {
 
+namespace detail
+{
+
+/// Upper bound for PublisherConfig::slots (Publisher::kMaxSlots).
+inline constexpr std::size_t kPublisherMaxSlots = 16;
+
+/**
+ * @brief Publication state that readers synchronize on.
+ *
+ * Lives inside the Publisher, or in the segment header of a shared-memory Publisher so readers
+ * in other processes observe the same atomics (see shm_snapshot.hpp). Kept outside
+ * PredictionBuffer so the buffer stays a plain struct.
+ */
+struct PublisherShared final
+{
+    struct Slot final
+    {
+        // Seqlock version: odd while the producer writes the buffer.
+        std::atomic<std::uint64_t> version{0};
+
+        // Outstanding in-process reader leases.
+        mutable std::atomic<std::uint32_t> readers{0};
+
+        // Seqno / t0 last published from the slot (seqno 0 = never, or being rewritten).
+        std::atomic<std::uint64_t> seqno{0};
+        std::atomic<double> t0{0.0};
+    };
+
+    // Index of the front buffer.
+    std::atomic<std::size_t> front_index{0};
+
+    // Monotonic publish sequence number.
+    std::atomic<std::uint64_t> seqno{0};
+
+    // Low 32 bits of the latest published seqno; the word wait_for_seqno() blocks on.
+    std::atomic<std::uint32_t> publish_word{0};
+
+    // In-process threads blocked in Publisher::wait_for_seqno().
+    mutable std::atomic<std::uint32_t> waiters{0};
+
+    std::array<Slot, kPublisherMaxSlots> slots{};
+};
+
+/**
+ * @brief Block until the front snapshot's seqno exceeds @p after or @p timeout_sec passes.
+ *
+ * @param register_waiter Count the caller in PublisherShared::waiters (requires write access;
+ *                        readers of a read-only mapping rely on the producer always waking).
+ * @return Front seqno at return.
+ */
+[[nodiscard]] std::uint64_t wait_published(const PublisherShared& shared,
+                                           std::uint64_t after,
+                                           double timeout_sec,
+                                           bool register_waiter) noexcept;
+
+} // namespace detail
+
+/**
+ * @brief Publisher construction options.
+ */
+struct PublisherConfig final
+{
+    /**
+     * @brief Attach a velocity plane to every buffer (PredictionBuffer::velocities).
+     *
+     * Allocated once at construction; off by default so the snapshot stays positions-only.
+     */
+    bool velocities{false};
+
+    /**
+     * @brief Attach an inertial position plane to every buffer (PredictionBuffer::positions_i).
+     *
+     * Filled by the predictor, so consumers that want inertial trajectories do not re-derive
+     * the chief ephemeris themselves. Allocated once at construction; off by default.
+     */
+    bool inertial_positions{false};
+
+    /**
+     * @brief Attach a position covariance plane to every buffer (PredictionBuffer::position_cov).
+     *
+     * Filled by the predictor for rows whose vehicle provider reports an initial covariance
+     * (IVehicleStateProvider::get_covariance()). Allocated once at construction; off by default.
+     */
+    bool position_covariance{false};
+
+    /**
+     * @brief Number of snapshot buffers (2..Publisher::kMaxSlots).
+     *
+     * 2 is the classic double buffer. With 3 or more, begin_write() never hands out the front
+     * buffer or a buffer held by a SnapshotLease while another is free, so every concurrent
+     * reader lease beyond the first costs one extra slot. Extra slots are allocated once at
+     * construction.
+     */
+    std::size_t slots{2};
+
+    /**
+     * @brief Published snapshots retained behind the front for acquire_seqno()/acquire_time().
+     *
+     * Raises the slot count to at least history + 2 (the front and the buffer being written),
+     * capped at Publisher::kMaxSlots. 0 keeps only what the slot count implies.
+     */
+    std::size_t history{0};
+
+    /**
+     * @brief POSIX shared-memory object name (e.g. "/bullseye_pred"); nullptr = process-local.
+     *
+     * When set, every buffer, velocity plane and the publication state live in one segment
+     * with the fixed layout of shm_snapshot.hpp, created at construction and unlinked on
+     * destruction. Readers in other processes map it with ShmSnapshotReader and read
+     * snapshots in place. If the segment cannot be created the buffers stay process-local
+     * (see is_shared()).
+     */
+    const char* shm_name{nullptr};
+
+    /**
+     * @brief Attach SoA position planes (PredictionBuffer::soa) in this layout.
+     *
+     * publish() fills them from positions for every changed row, so consumers get contiguous
+     * per-axis series without a transpose of their own. kNone (default) attaches nothing.
+     */
+    SoaLayout soa_layout{SoaLayout::kNone};
+
+    /**
+     * @brief Attach a reduced-precision position plane (positions_f32 or positions_q32).
+     *
+     * Filled from positions for every changed row at publish, for consumers that ship or map
+     * the compact plane instead of the doubles. kFloat64 (default) attaches nothing.
+     */
+    OutputPrecision precision{OutputPrecision::kFloat64};
+
+    /** @brief Metres per count for OutputPrecision::kFixed32 (> 0; 1e-3 = mm, +/-2147 km). */
+    double fixed32_scale_m{1.0e-3};
+
+    /**
+     * @brief Page placement of every buffer and plane (huge pages, pre-fault, NUMA node).
+     *
+     * When requested, a process-local publisher carves all slots and planes from one
+     * PlacedMapping instead of the heap, so the first begin_write() of a live tick takes no
+     * page faults and the pages sit on the producer's or consumers' node. A shared-memory
+     * publisher applies the same placement to its segment (THP hint only; hugetlb needs a
+     * hugetlbfs mount). Default: heap placement.
+     */
+    PagePlacement placement{};
+};
+
+class Publisher;
+class CheckpointFile;
+class CheckpointWriter;
+enum class CheckpointCode : std::uint8_t;
+
+/**
+ * @brief Zero-copy reader lease on one published snapshot (see Publisher::acquire()).
+ *
+ * While a lease is held, a ring-mode producer does not reuse its buffer if any other buffer is
+ * free. Every buffer also carries a seqlock-style version that the producer bumps around each
+ * write, so valid() detects the remaining case (all buffers leased, producer went ahead rather
+ * than block): a lease whose valid() is still true after use read an untorn snapshot.
+ *
+ * Move-only; releases the buffer on destruction.
+ */
+class SnapshotLease final
+{
+  public:
+    SnapshotLease() = default;
+    SnapshotLease(SnapshotLease&& other) noexcept;
+    SnapshotLease& operator=(SnapshotLease&& other) noexcept;
+    SnapshotLease(const SnapshotLease&) = delete;
+    SnapshotLease& operator=(const SnapshotLease&) = delete;
+    ~SnapshotLease();
+
+    /// @return true if the lease holds a buffer (whatever its validity).
+    [[nodiscard]] bool held() const noexcept { return pub_ != nullptr; }
+
+    /**
+     * @brief Seqlock validation: true iff the buffer has not been rewritten since acquire().
+     *
+     * Call after reading; data read under a lease that fails validation must be discarded.
+     */
+    [[nodiscard]] bool valid() const noexcept;
+
+    /// @return the leased snapshot (requires held()).
+    [[nodiscard]] const PredictionBuffer& get() const noexcept { return *buf_; }
+    [[nodiscard]] const PredictionBuffer* operator->() const noexcept { return buf_; }
+    [[nodiscard]] const PredictionBuffer& operator*() const noexcept { return *buf_; }
+
+    /// @brief Release early (idempotent).
+    void release() noexcept;
+
+  private:
+    friend class Publisher;
+
+    const Publisher* pub_{nullptr};
+    const PredictionBuffer* buf_{nullptr};
+    std::size_t slot_{0};
+    std::uint64_t version_{0};
+};
+
 /**
  * @brief Double-buffer publisher for PredictionBuffer snapshots.
  *
@@ -25,15 +226,44 @@ namespace bullseye_pred
  * Threading:
  * - This supports a single producer with any number of readers.
  * - Publication uses release/acquire semantics so readers see a fully-written snapshot.
+ * - read() returns the front buffer by reference; with 2 slots the producer rewrites it two
+ *   publishes later, so readers that may lag should take an acquire() lease instead (and use
+ *   PublisherConfig::slots >= 3 so the lease keeps its buffer).
+ *
+ * Memory:
+ * - Optional planes (PublisherConfig) are allocated in the constructor; begin_write()/publish()
+ *   never allocate.
  */
 class Publisher final
 {
   public:
     Publisher() = default;
 
+    /**
+     * @brief Construct with optional output planes.
+     *
+     * If the velocity, inertial or covariance plane cannot be allocated, buffers go without it
+     * (see has_velocities(), has_inertial_positions(), has_position_covariance()).
+     */
+    explicit Publisher(const PublisherConfig& config) noexcept;
+
+    ~Publisher();
+
+    Publisher(const Publisher&) = delete;
+    Publisher& operator=(const Publisher&) = delete;
+
     /// @return reference to the writable back buffer.
     PredictionBuffer& begin_write() noexcept;
 
+    /**
+     * @brief Drop the open begin_write() without publishing (no-op if none is open).
+     *
+     * The back buffer no longer holds the snapshot it last published, so the next publish()
+     * carries every clean row over from the front in full. Leases on its old contents fail
+     * validation.
+     */
+    void abandon_write() noexcept;
+
     /**
      * @brief Publish the back buffer as the new front snapshot.
      *
@@ -42,23 +272,221 @@ class Publisher final
      */
     std::uint64_t publish(double t0) noexcept;
 
+    /**
+     * @brief Publish the back buffer, carrying rows outside @p dirty over from the front.
+     *
+     * Only the rows in @p dirty need to have been written since begin_write(). Every other
+     * row (positions, velocities, positions_i, position_cov, row_status, row_grid, row_model,
+     * approach, coefficients, and its valid_rows, cov_rows, maneuver_rows,
+     * control_unmodeled_rows, coeff_rows and coeff_only_rows bits) is made equal to the
+     * current front; its samples are copied only if the back buffer's copy is older than the
+     * front's, so a row unchanged over several publishes is not rewritten at all. Buffer-wide
+     * fields (steps, tau, profile grids, vehicles, est_cost_total, deferred_rows, unchanged_rows,
+     * keep-out radii) remain the producer's responsibility.
+     *
+     * Stamps PredictionBuffer::dirty_rows, row_seqno and row_t0, so readers can ship deltas with
+     * PredictionBuffer::rows_changed_since().
+     *
+     * @param t0 Epoch time for this prediction snapshot.
+     * @param dirty Rows written for this snapshot (publish(t0) is publish(t0, kAllRows)).
+     * @return The new published seqno.
+     */
+    std::uint64_t publish(double t0, RowMask dirty) noexcept;
+
+    /**
+     * @brief As publish(t0, dirty), but rows in @p own_epoch keep the row_t0 written into the
+     *        back buffer (samples predicted at an earlier epoch, e.g. relayed from another
+     *        publisher); they are still stamped with the new row_seqno.
+     *
+     * @param own_epoch Subset of @p dirty (other bits are ignored).
+     */
+    std::uint64_t publish(double t0, RowMask dirty, RowMask own_epoch) noexcept;
+
     /// @return current immutable front snapshot (acquire).
     const PredictionBuffer& read() const noexcept;
 
     /// @return most recently published seqno (acquire).
     std::uint64_t published_seqno() const noexcept;
 
+    /**
+     * @brief Block until a snapshot with seqno > @p after is published.
+     *
+     * The caller sleeps in the kernel (futex on Linux) instead of polling published_seqno().
+     * publish() stays lock-free: it issues a wake only while some thread is waiting, so with
+     * no waiter it costs one extra atomic store and load.
+     *
+     * @param after Seqno the caller already has (0 = wait for the first publish).
+     * @param timeout_sec Longest wait [s]; <= 0 only checks, non-finite waits indefinitely.
+     * @return The published seqno at return: > after on success, <= after on timeout.
+     */
+    [[nodiscard]] std::uint64_t wait_for_seqno(std::uint64_t after,
+                                               double timeout_sec) const noexcept;
+
+    /**
+     * @brief Lease the current front snapshot (lock-free; retries only while a publish races).
+     *
+     * @return A held lease, or an empty one if nothing has been published yet or the front
+     *         could not be pinned within a bounded number of attempts (the producer
+     *         publishing continuously).
+     */
+    [[nodiscard]] SnapshotLease acquire() const noexcept;
+
+    /**
+     * @brief Lease the retained snapshot with exactly this seqno.
+     *
+     * In ring mode the producer rewrites the oldest unleased buffer first, so the front and
+     * the slots() - 2 snapshots before it are retained (more while older ones are leased).
+     *
+     * @return An empty lease if @p seqno is not retained (too old, not yet published, or being
+     *         rewritten at this moment).
+     */
+    [[nodiscard]] SnapshotLease acquire_seqno(std::uint64_t seqno) const noexcept;
+
+    /**
+     * @brief Lease the newest retained snapshot with snapshot.t0 <= @p t0.
+     *
+     * @return An empty lease if every retained snapshot is later than t0 (or none exists).
+     */
+    [[nodiscard]] SnapshotLease acquire_time(double t0) const noexcept;
+
+    /**
+     * @brief Append every slot (buffer and velocity / inertial / covariance planes), its seqno
+     *        and t0, the front index and the publish seqno as section
+     *        CheckpointSection::kPublisher.
+     *
+     * Producer thread, between publishes (see checkpoint.hpp).
+     *
+     * @return false (nothing appended) while a begin_write() is open.
+     */
+    bool save_checkpoint(CheckpointWriter& out, std::uint32_t instance = 0) const;
+
+    /**
+     * @brief Restore the slots and publication state saved by save_checkpoint().
+     *
+     * Snapshots, history lookups and the next seqno continue exactly where the saved run
+     * stopped; SoA and reduced-precision planes are re-derived from the restored positions.
+     * Outstanding leases fail validation afterwards. Producer thread, between publishes.
+     *
+     * @return kOk, kMissingSection, kInvalidInput (a begin_write() is open) or kLayoutMismatch
+     *         (slot count or velocity / inertial / covariance planes differ; publisher unchanged).
+     */
+    CheckpointCode restore_checkpoint(const CheckpointFile& in,
+                                      std::uint32_t instance = 0) noexcept;
+
+    /// @return snapshots retained behind the front (slots() - 2).
+    std::size_t history_depth() const noexcept { return num_slots_ - kInlineBuffers; }
+
+    /// @return true if every buffer carries a velocity plane.
+    bool has_velocities() const noexcept { return has_velocities_; }
+
+    /// @return true if every buffer carries an inertial position plane.
+    bool has_inertial_positions() const noexcept { return has_inertial_; }
+
+    /// @return true if every buffer carries a position covariance plane.
+    bool has_position_covariance() const noexcept { return has_covariance_; }
+
+    /// @return layout of the attached SoA planes (kNone if none, or allocation failed).
+    SoaLayout soa_layout() const noexcept { return soa_layout_; }
+
+    /// @return precision of the attached compact plane (kFloat64 if none).
+    OutputPrecision precision() const noexcept { return precision_; }
+
+    /// @return true if the buffers live in a shared-memory segment (PublisherConfig::shm_name).
+    bool is_shared() const noexcept { return shared_ != &local_; }
+
+    /// @return placement applied to the buffers (all defaults if none was requested or mapped).
+    const PlacementReport& placement() const noexcept { return placement_; }
+
+    /// @return true if the buffers live in a placed mapping (PublisherConfig::placement).
+    bool is_placed() const noexcept { return placed_.mapped(); }
+
+    /// @return outcome of creating the shared-memory segment (kOk if none was requested).
+    ShmCode shm_status() const noexcept { return shm_status_; }
+
+    /// @return number of snapshot buffers in use (PublisherConfig::slots, or 2 on failure).
+    std::size_t slots() const noexcept { return num_slots_; }
+
+    /// @return begin_write() calls that had to reuse a leased buffer (no free slot).
+    std::uint64_t lease_overruns() const noexcept { return lease_overruns_; }
+
+    /// @return clean rows whose samples publish() had to copy from the front (stale back copy).
+    std::uint64_t carried_row_copies() const noexcept { return carried_row_copies_; }
+
+    /// Upper bound for PublisherConfig::slots.
+    static constexpr std::size_t kMaxSlots = detail::kPublisherMaxSlots;
+
   private:
-    static constexpr std::size_t kNumBuffers = 2;
+    friend class SnapshotLease;
 
-    // Two buffers: one is front (visible), one is back (writable).
-    PredictionBuffer buffers_[kNumBuffers]{};
+    static constexpr std::size_t kInlineBuffers = 2;
+    static constexpr std::size_t kNoSlot = static_cast<std::size_t>(-1);
 
-    // Index of the front buffer (0 or 1).
-    std::atomic<std::size_t> front_index_{0};
+    PredictionBuffer& slot(std::size_t i) noexcept { return *slot_ptr_[i]; }
+    const PredictionBuffer& slot(std::size_t i) const noexcept { return *slot_ptr_[i]; }
+    std::size_t pick_back_() noexcept;
 
-    // Monotonic publish sequence number.
-    std::atomic<std::uint64_t> seqno_{0};
+    // Place buffers, planes and shared state in a new segment; false leaves everything local.
+    bool init_shared_(const PublisherConfig& config, std::size_t slots) noexcept;
+
+    // Place buffers and planes in a PlacedMapping; false leaves everything on the heap.
+    bool init_placed_(const PublisherConfig& config, std::size_t slots) noexcept;
+
+    // Construct slots buffers and their planes at the shm_layout() offsets from base.
+    void construct_slots_(unsigned char* base,
+                          std::size_t slots,
+                          const PublisherConfig& config,
+                          OutputPrecision precision) noexcept;
+
+    // Refresh the SoA / reduced-precision planes of @p rows from positions.
+    void fill_derived_(PredictionBuffer& buf, RowMask rows) noexcept;
+
+    // Pin slot i if it is not being written and holds expect_seqno (0 = any published).
+    bool pin_(std::size_t i, std::uint64_t expect_seqno, SnapshotLease& out) const noexcept;
+
+    // Two inline buffers (the default double buffer); slots beyond 2 live in extra_buffers_,
+    // or every slot lives in shm_ (shared-memory publisher) or placed_ (PagePlacement).
+    PredictionBuffer buffers_[kInlineBuffers]{};
+    std::unique_ptr<PredictionBuffer[]> extra_buffers_{};
+    std::array<PredictionBuffer*, kMaxSlots> slot_ptr_{{&buffers_[0], &buffers_[1]}};
+    std::size_t num_slots_{kInlineBuffers};
+
+    // Seqlock versions, lease counts, per-slot seqno/t0, front index and seqno; shared_ points
+    // at local_ or into the shared-memory segment header.
+    detail::PublisherShared local_{};
+    detail::PublisherShared* shared_{&local_};
+
+    // Slot handed out by begin_write() and not yet published.
+    std::size_t back_{kNoSlot};
+
+    std::uint64_t lease_overruns_{0};
+    std::uint64_t carried_row_copies_{0};
+
+    // Velocity planes, one per buffer (nullptr unless configured, or in shm_).
+    std::unique_ptr<TrajectoryPlane[]> velocity_storage_{};
+    bool has_velocities_{false};
+
+    // Inertial position planes, one per buffer (PublisherConfig::inertial_positions).
+    std::unique_ptr<TrajectoryPlane[]> inertial_storage_{};
+    bool has_inertial_{false};
+
+    // Position covariance planes, one per buffer (PublisherConfig::position_covariance).
+    std::unique_ptr<CovariancePlane[]> covariance_storage_{};
+    bool has_covariance_{false};
+
+    // SoA position planes, one per buffer (PublisherConfig::soa_layout).
+    std::unique_ptr<SoaPositionPlanes[]> soa_storage_{};
+    SoaLayout soa_layout_{SoaLayout::kNone};
+
+    // Reduced-precision planes, one per buffer (PublisherConfig::precision).
+    std::unique_ptr<Float32Plane[]> f32_storage_{};
+    std::unique_ptr<Fixed32Plane[]> q32_storage_{};
+    OutputPrecision precision_{OutputPrecision::kFloat64};
+
+    ShmMapping shm_{};
+    ShmCode shm_status_{ShmCode::kOk};
+
+    PlacedMapping placed_{};
+    PlacementReport placement_{};
 };
 
 } // namespace bullseye_pred
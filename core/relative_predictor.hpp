@@ -9,7 +9,7 @@
  * - updates BullseyeFrame snapshot at t0
  * - retrieves deputy inertial state(s) at exactly t0
  * - computes initial relative state in RIC using Option-B semantics
- * - runs HCW model and writes results into PredictionBuffer
+ * - runs the model policy (HCW, YA/TH, injected) and writes results into PredictionBuffer
  * - publishes via Publisher (double-buffer atomic publish)
  *
  * Design constraints:
@@ -18,15 +18,28 @@
  * - fail-fast: do not publish on invalid inputs
  */
 
+#include <array>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
 
 #include "core/bullseye_frame.hpp"
 #include "core/chief_state_provider.hpp"
 #include "core/constants.hpp"
+#include "core/contracts.hpp"
+#include "core/dispersion.hpp"
 #include "core/publisher.hpp"
+#include "core/relative_predictor_policies.hpp"
+#include "core/source_transition.hpp"
+#include "core/state_covariance.hpp"
+#include "core/tick_telemetry.hpp"
 #include "core/time_grid.hpp"
 #include "core/types.hpp"
 #include "core/vehicle_index_map.hpp"
+#include "core/worker_pool.hpp"
 
 namespace bullseye_pred
 {
@@ -44,6 +57,10 @@ struct VehicleState final
     Vec3 r_i{};
     Vec3 v_i{};
     const char* frame_id{nullptr};
+
+    /** @brief Interned frame_id (FrameHandle::kNone: not interned, compared by name). */
+    FrameHandle frame{FrameHandle::kNone};
+
     ProviderStatus status{};
 };
 
@@ -65,20 +82,332 @@ class IVehicleStateProvider
      * @return VehicleState for exactly t0 on success; non-OK status otherwise.
      */
     [[nodiscard]] virtual VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept = 0;
+
+    /**
+     * @brief Get the states of several vehicles for the same tick time in one call.
+     *
+     * Providers backed by a remote feed or a simulation framework override this to serve the
+     * whole batch in one round trip; the default loops over get(). Entry i of every output
+     * corresponds to ids[i]; each out[i] carries its own status.
+     *
+     * @param ids Vehicle identifiers (from VehicleIndexMap).
+     * @param t0 Requested predictor tick time (seconds).
+     * @param out One state per id (required; >= ids.size elements).
+     * @param out_r_i Optional inertial positions per id (empty, or >= ids.size elements).
+     * @param out_v_i Optional inertial velocities per id (empty, or >= ids.size elements).
+     * @return kOk if every entry succeeded; otherwise the first non-OK entry code, or
+     *         kInvalidInput (nothing written) if an output is too small.
+     */
+    [[nodiscard]] virtual ProviderCode get_many(Span<const VehicleIndexMap::VehicleId> ids,
+                                                double t0,
+                                                Span<VehicleState> out,
+                                                Span<Vec3> out_r_i,
+                                                Span<Vec3> out_v_i) noexcept;
+
+    /**
+     * @brief Optional 6x6 covariance of the vehicle's inertial state [r_i; v_i] at t0.
+     *
+     * Consulted only when the publisher carries a covariance plane, for rows predicted this
+     * tick. The default reports none.
+     *
+     * @return true if @p out was filled.
+     */
+    [[nodiscard]] virtual bool get_covariance(VehicleIndexMap::VehicleId id,
+                                              double t0,
+                                              StateCovariance& out) noexcept
+    {
+        (void)id;
+        (void)t0;
+        (void)out;
+        return false;
+    }
+};
+
+/**
+ * @brief Per-tick inputs shared by the frame, transform and model stages.
+ *
+ * The predictor fills this once at the start of each tick: one chief query, one frame
+ * snapshot (including adopted-frame validation), and the derived rotation/mean motion. Every
+ * later stage reads from here instead of asking the providers again.
+ */
+struct TickContext final
+{
+    /// True once every field below was computed for t0 (false if the tick failed early).
+    bool valid{false};
+    double t0{0.0};
+
+    ChiefState chief{};
+    BullseyeFrameSnapshot frame{};
+
+    double n_radps{0.0};
+    Mat3 C_r2i{Mat3::identity()};
+    Mat3 C_i2r{Mat3::identity()};
 };
 
 /**
- * @brief Relative predictor that produces HCW trajectories in the Bullseye RIC frame.
+ * @brief Sliding-window trajectory reuse between consecutive ticks.
+ *
+ * When a tick advances the same grid by an integer number of samples m, a vehicle whose new
+ * initial state agrees with the previous prediction at tau_m (within the tolerances) keeps the
+ * previous trajectory shifted by m samples; only the last m samples are evaluated, from the new
+ * initial state. Requires a model policy with predict_tail() (HCW with a cached STM table);
+ * other rows are predicted in full.
+ */
+struct TrajectoryReuseConfig final
+{
+    /** @brief Enable reuse (off by default: every tick is a full prediction). */
+    bool enabled{false};
+
+    /** @brief Position residual tolerance against the previous prediction [m]. */
+    double pos_tol_m{1.0e-3};
+
+    /**
+     * @brief Velocity residual tolerance [m/s], checked when velocities are published
+     *        (PublisherConfig::velocities); otherwise only the position residual is checked.
+     */
+    double vel_tol_mps{1.0e-6};
+
+    /** @brief Every vehicle gets a full prediction at least once every N ticks (N <= 1: never
+     *         reuse). */
+    std::uint32_t full_refresh_ticks{20};
+
+    /**
+     * @brief Change detection: skip rows whose new initial state lies on their published
+     *        trajectory (independent of enabled and of the model policy).
+     *
+     * When the tick offset t0 - PredictionBuffer::row_t0[i] falls on a grid sample k of the
+     * row's published trajectory (same grid as the last tick) and x0 matches sample k within
+     * pos_tol_m / vel_tol_mps, the row is not evaluated at all: the publisher carries it over
+     * with its old epoch and PredictionBuffer::unchanged_rows flags it. Passive deputies then
+     * cost one residual check per tick. Rows with planned burns ahead, coefficient-only rows
+     * and rows on other grid profiles are always predicted. Skips count towards
+     * full_refresh_ticks like sliding-window reuse, and are checked first.
+     */
+    bool skip_unchanged{false};
+
+    /**
+     * @brief Longest a skipped row's epoch may trail t0 [s]; its carried samples end this much
+     *        short of the tick's horizon.
+     */
+    double max_unchanged_sec{std::numeric_limits<double>::infinity()};
+};
+
+/**
+ * @brief Per-tick reuse counters (last step() that published).
+ */
+struct TrajectoryReuseStats final
+{
+    /** @brief Rows produced by shifting the previous trajectory plus a new tail. */
+    std::size_t rows_reused{0};
+
+    /** @brief Rows predicted in full. */
+    std::size_t rows_full{0};
+
+    /** @brief Rows skipped by change detection (carried over; skip_unchanged). */
+    std::size_t rows_unchanged{0};
+};
+
+/**
+ * @brief Per-row coefficient publication (BasicRelativePredictor::configure_coefficients()).
+ */
+enum class CoefficientOutput : std::uint8_t
+{
+    kOff,         ///< Dense samples only (default).
+    kWithSamples, ///< Dense samples, plus coefficients for rows with a closed form.
+    kOnly,        ///< Coefficients instead of samples for rows with a closed form.
+};
+
+/**
+ * @brief Planned impulsive maneuver of a deputy (BasicRelativePredictor::set_planned_burns()).
+ */
+struct ImpulsiveBurn final
+{
+    /** @brief Burn epoch on the step() clock (same time base as t0) [s]. */
+    double t{0.0};
+
+    /** @brief Velocity change in the chief's RIC frame [m/s]. */
+    Vec3 dv_ric{};
+};
+
+/**
+ * @brief Planned-maneuver counters (last step() that published).
+ */
+struct ManeuverStats final
+{
+    /** @brief Rows whose samples include their burns (PredictionBuffer::maneuver_rows). */
+    RowMask rows{0};
+
+    /** @brief Rows whose burns the model could not compose (control_unmodeled_rows). */
+    RowMask unmodeled_rows{0};
+
+    /** @brief Burns composed into rows this tick. */
+    std::size_t burns_applied{0};
+};
+
+/**
+ * @brief Closest-approach summary per published row (PredictionBuffer::approach).
+ *
+ * Computed by the predictor for every row it writes, right after the model pass while the row
+ * is still in cache, so consumers read one record per vehicle instead of scanning samples.
+ * TCA is refined on the model velocities when the publisher carries a velocity plane
+ * (PublisherConfig::velocities), otherwise on a parabola through the nearest samples; see
+ * summarize_closest_approach().
+ */
+struct ApproachSummaryConfig final
+{
+    /** @brief Compute summaries (off by default). */
+    bool enabled{false};
+
+    /** @brief Keep-out sphere radii around the chief [m]; the first keep_out_count are used. */
+    std::size_t keep_out_count{0};
+    std::array<double, MAX_KEEP_OUT_SPHERES> keep_out_radius_m{};
+};
+
+/**
+ * @brief Order in which a budgeted tick predicts its rows (TickBudgetConfig::priority).
+ *
+ * Keys are taken from the RIC initial state at t0; ties keep row order.
+ */
+enum class RowPriority : std::uint8_t
+{
+    kRowOrder,     ///< Row index order.
+    kRange,        ///< Smallest |r_ric| first.
+    kClosingRate,  ///< Fastest closing first (most negative range rate).
+    kUserAssigned, ///< Largest set_vehicle_priority() value first (unset: 0).
+};
+
+/**
+ * @brief Deadline-aware tick: predict rows in priority order until the budget is spent.
+ *
+ * Rows still waiting when the budget runs out are deferred: the publisher carries their
+ * previous trajectory over unchanged, PredictionBuffer::deferred_rows flags them, and
+ * PredictionBuffer::row_t0 gives the epoch their tau offsets refer to. A deferred row is
+ * predicted in full (no sliding-window reuse) the next time it gets its turn. A row whose
+ * vehicle is new to it is always predicted (nothing of its own to carry over) and does not
+ * count against the budget.
+ *
+ * Deferring needs the previous snapshot on the same grid; a tick whose grid differs from the
+ * last one (or the first tick) predicts every row. The wall-clock budget makes the set of
+ * predicted rows timing dependent; max_rows alone is deterministic. Budgeted ticks run the
+ * model serially (an attached worker pool is not used).
+ */
+struct TickBudgetConfig final
+{
+    /** @brief Enable the budget (off by default: every row is predicted every tick). */
+    bool enabled{false};
+
+    /** @brief Prediction order. */
+    RowPriority priority{RowPriority::kRange};
+
+    /** @brief Wall-clock budget for the model stage, measured from the start of step() [s]. */
+    double budget_sec{std::numeric_limits<double>::infinity()};
+
+    /** @brief Rows predicted in full per tick at most (deterministic cap). */
+    std::size_t max_rows{MAX_VEHICLES};
+
+    /** @brief Highest-priority rows predicted regardless of budget_sec (still <= max_rows). */
+    std::size_t min_rows{1};
+
+    /** @brief A row deferred this many ticks in a row moves to the front (0: no aging). */
+    std::uint32_t max_deferred_ticks{10};
+};
+
+/**
+ * @brief Budget counters (last step() that published).
+ */
+struct TickBudgetStats final
+{
+    /** @brief Rows predicted in full in priority order. */
+    std::size_t rows_predicted{0};
+
+    /** @brief Rows deferred to a later tick (carried over). */
+    std::size_t rows_deferred{0};
+};
+
+/**
+ * @brief Inertial position output (PublisherConfig::inertial_positions).
+ *
+ * When the publisher carries an inertial plane, the predictor propagates the chief once per
+ * tick over the grid (two-body, universal variables) and maps every published RIC row to
+ * inertial coordinates with it, so subscribers never transform trajectories themselves. The
+ * RIC frame at tau_k is the frame constructed from the propagated chief, offset by the tick
+ * frame's misalignment from the constructed frame at t0 (zero for a constructed Bullseye).
+ */
+struct InertialOutputConfig final
+{
+    /** @brief Gravitational parameter of the chief ephemeris [m^3/s^2]. */
+    double mu{contracts::Grav::kMuM3PerS2};
+};
+
+/**
+ * @brief Relative predictor that produces model trajectories in the Bullseye RIC frame.
+ *
+ * @tparam ModelPolicy Per-vehicle model kernel (see relative_predictor_policies.hpp). Calls are
+ *         statically dispatched so the model, the RIC transform and the buffer write share one
+ *         loop. Use VirtualModelPolicy / DynamicModelPolicy for plugin-style IRelativeModel use.
  *
  * Output:
  * - Writes predicted relative positions into PredictionBuffer::positions:
  *   positions[i][k] = predicted RIC position for vehicle index i at grid.tau[k].
+ * - If the publisher carries a velocity plane (PublisherConfig::velocities), the model
+ *   velocities are written to (*velocities)[i][k] in the same pass.
+ * - If the publisher carries an inertial plane (PublisherConfig::inertial_positions),
+ *   (*positions_i)[i][k] is the inertial position of every predicted row (see
+ *   InertialOutputConfig).
+ * - If the publisher carries a covariance plane (PublisherConfig::position_covariance), every
+ *   predicted row whose provider reports an initial covariance
+ *   (IVehicleStateProvider::get_covariance()) gets (*position_cov)[i][k] = Phi_k P0 Phi_k^T
+ *   and its PredictionBuffer::cov_rows bit. Phi_k comes from the policy's response to the six
+ *   unit initial states, computed once per grid per tick, so the cost per row is one small
+ *   kernel pass (see state_covariance.hpp). kAuto uses its single-row model (YA/TH) for the
+ *   basis, and injected models are assumed linear in the initial state.
+ * - With configure_dispersion(), every predicted row also gets K Monte Carlo samples around
+ *   its initial state, evaluated on the same tick context and grid (see dispersion.hpp).
+ * - Planned impulsive burns (set_planned_burns()) inside a row's horizon are superposed on its
+ *   coasting trajectory through the policy's STM (predict_impulse() hook): for HCW one
+ *   closed-form segment to the next grid sample, then the cached STM table, so a maneuvering
+ *   row costs about one extra kernel pass per burn. The row is flagged in
+ *   PredictionBuffer::maneuver_rows; rows whose model cannot compose burns (YA/TH, injected)
+ *   keep the coasting trajectory and are flagged in control_unmodeled_rows.
+ * - With configure_coefficients(), rows whose model has a closed form (HCW, SS-J2) also carry
+ *   PredictionBuffer::coefficients[i] (x0, model id, parameters, burns) for consumers to
+ *   evaluate at any offset (trajectory_coefficients.hpp). In CoefficientOutput::kOnly such
+ *   rows skip the dense pass and their sample planes, inertial positions and approach
+ *   summaries are not written (PredictionBuffer::coeff_only_rows).
+ * - PredictionBuffer::steps and PredictionBuffer::tau carry the grid actually used, so
+ *   consumers need not know the horizon/cadence (or a piecewise schedule) out of band.
+ * - With configure_approach_summary(), PredictionBuffer::approach[i] summarizes each written
+ *   row (minimum range, TCA, keep-out entries).
+ *
+ * Grid profiles:
+ * - A vehicle registered on grid profile p > 0 (VehicleIndexMap::set_grid_profile()) is
+ *   sampled on the grid set with set_grid_profile(p, ...), e.g. coarse and long for far-field
+ *   vehicles. Each profile in use costs one extra model pass (begin_tick() on its grid); rows
+ *   record their profile in PredictionBuffer::row_grid and readers use row_steps(i) /
+ *   row_tau(i). Sliding-window reuse and the tick budget apply to profile-0 rows only; rows
+ *   on other profiles are predicted in full every tick.
+ *
+ * Parallelism:
+ * - With a worker pool attached (attach_worker_pool()) and a policy whose concurrent_rows()
+ *   is true, the model runs on contiguous row ranges across the pool; each thread writes only
+ *   its own rows of the back buffer. Outputs are bitwise identical to the serial path, and the
+ *   snapshot is published after every range has finished.
+ *
+ * Budget:
+ * - With a tick budget (configure_budget()), rows are predicted in priority order and the rest
+ *   are deferred to a later tick; see TickBudgetConfig.
+ *
+ * Telemetry:
+ * - With a ring attached (attach_telemetry()), every step() pushes one TickTelemetryRecord
+ *   (published or not) with its outcome, per-row status and model, and stage durations; see
+ *   tick_telemetry.hpp.
  *
  * Notes:
- * - Current PredictionBuffer has no explicit step count. Consumers must know the configured
- *   horizon/cadence or use a separately-shared TimeGrid.
+ * - step() is defined in relative_predictor_impl.hpp and explicitly instantiated for the
+ *   provided policies; include that header to instantiate a custom policy.
  */
-class RelativePredictor final
+template <typename ModelPolicy>
+class BasicRelativePredictor final
 {
   public:
     /**
@@ -89,22 +418,26 @@ class RelativePredictor final
      * @param chief_provider Chief state provider.
      * @param vehicle_provider Deputy state provider.
      * @param bullseye Bullseye frame product (constructed/adopted policy).
+     * @param policy_args Forwarded to the ModelPolicy constructor (e.g. config or injected model).
      */
-    RelativePredictor(Publisher& publisher,
-                      VehicleIndexMap& vehicle_map,
-                      IChiefStateProvider& chief_provider,
-                      IVehicleStateProvider& vehicle_provider,
-                      BullseyeFrame& bullseye) noexcept
+    template <typename... PolicyArgs>
+    BasicRelativePredictor(Publisher& publisher,
+                           VehicleIndexMap& vehicle_map,
+                           IChiefStateProvider& chief_provider,
+                           IVehicleStateProvider& vehicle_provider,
+                           BullseyeFrame& bullseye,
+                           PolicyArgs&&... policy_args) noexcept
         : pub_(publisher),
           map_(vehicle_map),
           chief_(chief_provider),
           veh_(vehicle_provider),
-          bullseye_(bullseye)
+          bullseye_(bullseye),
+          policy_(std::forward<PolicyArgs>(policy_args)...)
     {
     }
 
     /**
-     * @brief Compute and publish HCW predictions for registered vehicles.
+     * @brief Compute and publish predictions for registered vehicles.
      *
      * @param t0 Epoch time for this prediction snapshot.
      * @param horizon_sec Prediction horizon (seconds).
@@ -112,12 +445,553 @@ class RelativePredictor final
      */
     void step(double t0, double horizon_sec, double cadence_sec) noexcept;
 
+    /**
+     * @brief Compute and publish predictions on a caller-supplied grid.
+     *
+     * Use for non-uniform (e.g. piecewise, make_piecewise_time_grid()) schedules; build the grid
+     * once and pass it every tick. Samples beyond MAX_STEPS are dropped as in step(). Sliding-
+     * window reuse applies only when the grid is uniform.
+     *
+     * @param t0 Epoch time for this prediction snapshot.
+     * @param grid Offsets from t0 (must stay unchanged while step() runs).
+     */
+    void step(double t0, const TimeGrid& grid) noexcept;
+
+    /**
+     * @brief Run one tick at @p t0 without publishing, so the first step() pays none of the
+     *        first-call costs.
+     *
+     * Call after configuration and before the first step(), with the grid the live ticks will
+     * use. The dry tick queries the providers (their lazy sorting and cursors), builds the grid
+     * and the model caches, runs the worker pool, writes the back buffer (first touch of its
+     * pages) and resolves every component logger (logging::preload()). Its output is dropped
+     * (Publisher::abandon_write()); cross-tick state (reuse, budget, burns, source transition),
+     * tick_context() and the counters are restored, and no telemetry record is pushed. kAuto
+     * model selectors are not advanced (the policy's set_dry_run() hook), so the first live
+     * tick is an initial selection. A configured dispersion writes its caller-owned samples as
+     * usual.
+     *
+     * @return true if the dry tick reached the publish stage (the providers, frame and model
+     *         accepted @p t0); false leaves the stages past the failure cold.
+     */
+    bool warm_up(double t0, double horizon_sec, double cadence_sec) noexcept;
+
+    /** @brief warm_up() on a caller-supplied grid (see step(double, const TimeGrid&)). */
+    bool warm_up(double t0, const TimeGrid& grid) noexcept;
+
+    /** @brief Model policy (for inspection). */
+    [[nodiscard]] const ModelPolicy& policy() const noexcept { return policy_; }
+
+    /** @brief Configure sliding-window reuse (takes effect on the next step()). */
+    void configure_reuse(const TrajectoryReuseConfig& config) noexcept { reuse_ = config; }
+
+    /** @brief Configure inertial position output (takes effect on the next step()). */
+    void configure_inertial_output(const InertialOutputConfig& config) noexcept
+    {
+        inertial_ = config;
+    }
+
+    /**
+     * @brief Run the per-vehicle model on @p pool (nullptr: serial, the default).
+     *
+     * The pool must outlive the predictor or be detached first, and must not be running
+     * another job during step(). Ignored for policies without concurrent_rows() == true.
+     */
+    void attach_worker_pool(WorkerPool* pool) noexcept { pool_ = pool; }
+
+    /**
+     * @brief Push one record per step() into @p ring (nullptr: no telemetry, the default).
+     *
+     * The thread calling step() is the ring's producer; the ring must outlive the predictor
+     * or be detached first. Record tick counts restart at 1.
+     */
+    void attach_telemetry(TickTelemetryRing* ring) noexcept
+    {
+        telemetry_ = ring;
+        telemetry_ticks_ = 0;
+    }
+
+    /**
+     * @brief Sample vehicles on grid profile @p profile (VehicleIndexMap::set_grid_profile())
+     *        on a uniform grid of their own (configuration-time: builds the grid).
+     *
+     * Profile 0 is always the grid passed to step(); vehicles on a profile that is not set
+     * use it too. Takes effect on the next step().
+     *
+     * @return false for profile 0, a profile >= MAX_GRID_PROFILES or an invalid grid.
+     */
+    bool set_grid_profile(std::uint8_t profile, double horizon_sec, double cadence_sec) noexcept
+    {
+        if (profile == 0 || profile >= MAX_GRID_PROFILES)
+        {
+            return false;
+        }
+        const TimeGrid& g = profile_cache_[profile - 1].get(horizon_sec, cadence_sec);
+        return set_grid_profile(profile, g) && !g.tau.empty();
+    }
+
+    /**
+     * @brief As above on a caller-supplied grid (e.g. piecewise); it must outlive its use and
+     *        stay unchanged while step() runs.
+     */
+    bool set_grid_profile(std::uint8_t profile, const TimeGrid& grid) noexcept
+    {
+        if (profile == 0 || profile >= MAX_GRID_PROFILES)
+        {
+            return false;
+        }
+        profile_grid_[profile] = &grid;
+        profiles_changed_ = true;
+        return true;
+    }
+
+    /** @brief Remove grid profile @p profile; its vehicles fall back to profile 0. */
+    void clear_grid_profile(std::uint8_t profile) noexcept
+    {
+        if (profile > 0 && profile < MAX_GRID_PROFILES)
+        {
+            profile_grid_[profile] = nullptr;
+            profiles_changed_ = true;
+        }
+    }
+
+    /** @brief Configure closest-approach summaries (takes effect on the next step()). */
+    void configure_approach_summary(const ApproachSummaryConfig& config) noexcept
+    {
+        approach_ = config;
+    }
+
+    /**
+     * @brief Run a Monte Carlo dispersion after every step() (config.samples == 0: off).
+     *
+     * Sample s of row i is written to out_r.row(i * K + s) (its first row_steps(i) entries,
+     * RIC positions on the row's grid) and out_ok[i * K + s]; K = config.samples. Rows whose
+     * block does not fit out_r / out_ok, or whose grid has more than out_r.cols samples, are
+     * skipped. Samples of one row go through the model in batched calls on the tick's
+     * prepared policy, split across the worker pool when the policy allows concurrent rows;
+     * the values do not depend on the split. kAuto rows use the policy's single-row model.
+     * The storage must outlive its use; takes effect on the next step().
+     *
+     * @return false (dispersion off) if the covariance is not PSD or out_r / out_ok are empty.
+     */
+    bool configure_dispersion(const DispersionConfig& config,
+                              Span2D<Vec3> out_r,
+                              Span<bool> out_ok) noexcept
+    {
+        dispersion_ = DispersionConfig{};
+        dispersion_stats_ = DispersionStats{};
+        if (config.samples == 0)
+        {
+            return true;
+        }
+        if (out_r.data == nullptr || out_ok.data == nullptr ||
+            !covariance_factor(config.covariance, dispersion_L_))
+        {
+            return false;
+        }
+        dispersion_ = config;
+        dispersion_out_ = out_r;
+        dispersion_ok_ = out_ok;
+        return true;
+    }
+
+    /** @brief Dispersion counters of the last tick. */
+    [[nodiscard]] const DispersionStats& dispersion_stats() const noexcept
+    {
+        return dispersion_stats_;
+    }
+
+    /** @brief Configure the tick budget (takes effect on the next step()). */
+    void configure_budget(const TickBudgetConfig& config) noexcept { budget_ = config; }
+
+    /**
+     * @brief Assign vehicle @p id's priority for RowPriority::kUserAssigned (larger first).
+     *
+     * Kept until the vehicle's row is re-registered to another id.
+     *
+     * @return false if @p id is not registered.
+     */
+    bool set_vehicle_priority(VehicleIndexMap::VehicleId id, double priority) noexcept
+    {
+        const auto idx = map_.index_of(id);
+        if (!idx.has_value() || *idx >= MAX_VEHICLES)
+        {
+            return false;
+        }
+        user_priority_[*idx] = priority;
+        user_priority_id_[*idx] = id;
+        user_priority_set_[*idx] = true;
+        return true;
+    }
+
+    /**
+     * @brief Publish per-row model coefficients (takes effect on the next step()).
+     *
+     * Rows whose policy reports no closed form (YA/TH, injected models, kAuto rows before
+     * their selection) stay dense in every mode; kAuto rows are therefore always sampled
+     * and get coefficients after their model pass. Rows with burns the model cannot compose
+     * get none.
+     */
+    void configure_coefficients(CoefficientOutput mode) noexcept { coeff_mode_ = mode; }
+
+    /**
+     * @brief Configure Bullseye source transitions (FR-9; see source_transition.hpp).
+     *
+     * On a blended tick the rows are predicted in the new source's frame and corrected to the
+     * published frame in one pass, unless the correction could exceed
+     * config.max_correction_error_m over the rows' reach (|r0| + |v0| * horizon; see
+     * frame_correction_error_bound()), or
+     * coefficients or dispersions are published (they describe the prediction frame); such
+     * ticks are predicted in the published frame. Ticks that move the frame predict every row
+     * in full (no reuse, change detection or budget deferral). tick_context().frame is the
+     * published frame.
+     */
+    void configure_source_transition(const SourceTransitionConfig& config) noexcept
+    {
+        transition_.configure(config);
+    }
+
+    /** @brief Source transition state of the last step() that reached the frame stage. */
+    [[nodiscard]] const SourceTransitionTick& source_transition() const noexcept
+    {
+        return transition_.last();
+    }
+
+    /**
+     * @brief Replace vehicle @p id's planned impulsive burns (empty: clear).
+     *
+     * Every step() composes the burns with t0 < t <= t0 + horizon into the row's trajectory;
+     * burns at or before t0 are taken to be reflected in the provider's state already. The
+     * schedule is kept until replaced or the vehicle's row is re-registered to another id.
+     * Dispersion samples of the row get the same burns. A row with burns inside its horizon
+     * is always predicted in full (no sliding-window reuse).
+     *
+     * @return false (schedule unchanged) if @p id is not registered, more than
+     *         MAX_PLANNED_BURNS burns are given, or a burn is non-finite.
+     */
+    bool set_planned_burns(VehicleIndexMap::VehicleId id, Span<const ImpulsiveBurn> burns) noexcept
+    {
+        const auto idx = map_.index_of(id);
+        if (!idx.has_value() || *idx >= MAX_VEHICLES || burns.size > MAX_PLANNED_BURNS)
+        {
+            return false;
+        }
+        for (std::size_t j = 0; j < burns.size; ++j)
+        {
+            if (!std::isfinite(burns[j].t) || !finite3(burns[j].dv_ric))
+            {
+                return false;
+            }
+        }
+        // Stable insertion sort by epoch.
+        auto& dst = burns_[*idx];
+        for (std::size_t j = 0; j < burns.size; ++j)
+        {
+            std::size_t k = j;
+            for (; k > 0 && dst[k - 1].t > burns[j].t; --k)
+            {
+                dst[k] = dst[k - 1];
+            }
+            dst[k] = burns[j];
+        }
+        burn_count_[*idx] = burns.size;
+        burns_id_[*idx] = id;
+        return true;
+    }
+
+    /** @brief Planned-maneuver counters of the last published tick. */
+    [[nodiscard]] const ManeuverStats& maneuver_stats() const noexcept
+    {
+        return maneuver_stats_;
+    }
+
+    /** @brief Budget counters of the last published tick. */
+    [[nodiscard]] const TickBudgetStats& budget_stats() const noexcept { return budget_stats_; }
+
+    /** @brief Reuse counters of the last published tick. */
+    [[nodiscard]] const TrajectoryReuseStats& reuse_stats() const noexcept { return stats_; }
+
+    /** @brief Shared inputs of the last step() (valid == false if it failed before the model). */
+    [[nodiscard]] const TickContext& tick_context() const noexcept { return tick_; }
+
+    /**
+     * @brief Append the run state as checkpoint sections (see checkpoint.hpp): the vehicle map,
+     *        the publisher, the predictor's reuse and budget history, and the model policy's
+     *        cross-tick state (if it has the checkpoint hooks), all under @p instance.
+     *
+     * Call between step()s, on the thread that runs them. Providers are checkpointed
+     * separately (e.g. CartesianChiefProvider::save_checkpoint()).
+     *
+     * @return false if the publisher has an open begin_write() (nothing usable written).
+     */
+    bool save_checkpoint(CheckpointWriter& out, std::uint32_t instance = 0) const;
+
+    /**
+     * @brief Restore the state saved by save_checkpoint() into this (identically configured)
+     *        predictor, its map and its publisher.
+     *
+     * The next step() then produces the same snapshot, bit for bit, as the saved run's next
+     * step() would have. Sections are checked before anything is copied; if the map or
+     * publisher still rejects its section, restore again or rebuild.
+     *
+     * @return kOk or the first failing section's code.
+     */
+    CheckpointCode restore_checkpoint(const CheckpointFile& in, std::uint32_t instance = 0) noexcept;
+
   private:
+    // Visit every cross-tick member that save_checkpoint() stores, in file order.
+    template <typename Self, typename F>
+    static void for_each_checkpoint_field_(Self& self, F&& f)
+    {
+        f(self.last_);
+        f(self.stats_);
+        f(self.row_id_);
+        f(self.row_ok_);
+        f(self.row_reused_);
+        f(self.row_reuse_count_);
+        f(self.budget_stats_);
+        f(self.deferred_rows_);
+        f(self.budget_new_rows_);
+        f(self.row_deferred_ticks_);
+        f(self.user_priority_);
+        f(self.user_priority_id_);
+        f(self.user_priority_set_);
+        f(self.burns_);
+        f(self.burns_id_);
+        f(self.burn_count_);
+        f(self.transition_);
+    }
+
+    // Shared tick body; cadence_sec > 0 iff grid is uniform with that cadence (enables reuse).
+    void step_on_grid_(double t0, const TimeGrid& grid, double cadence_sec) noexcept;
+
+    // step_on_grid_() with dry_run_ set, restoring the state a tick leaves behind.
+    bool warm_up_(double t0, const TimeGrid& grid, double cadence_sec) noexcept;
+
+    // Model over the rows gathered in x0_block_/active_block_, split across pool_.
+    void predict_parallel_(std::size_t nveh, std::size_t steps, PredictionBuffer& buf) noexcept;
+
+    // Grid profile row i is sampled on this tick (0 unless its profile is set).
+    [[nodiscard]] std::uint8_t grid_profile_(std::size_t i) const noexcept
+    {
+        const std::uint8_t p = map_.grid_profile_at(i);
+        return (p < MAX_GRID_PROFILES && profile_grid_[p] != nullptr) ? p : std::uint8_t{0};
+    }
+
+    // Model over @p rows (profile_x0_), one pass per grid profile 1.., after the profile-0 pass.
+    void predict_profiles_(RowMask rows,
+                           std::size_t nveh,
+                           bool parallel,
+                           PredictionBuffer& buf) noexcept;
+
+    // Model over the rows gathered in x0_block_/active_block_ in priority order until the
+    // budget is spent; the rest are deferred (deferred_rows_).
+    TickBudgetStats predict_budgeted_(std::size_t nveh,
+                                      std::size_t steps,
+                                      PredictionBuffer& buf,
+                                      const PredictionBuffer& prev,
+                                      std::chrono::steady_clock::time_point start) noexcept;
+
+    // Change detection: x0 matches row i's published trajectory (prev) at the tick offset.
+    [[nodiscard]] bool matches_published_(std::size_t i,
+                                          const RelStateRic& x0,
+                                          const PredictionBuffer& prev,
+                                          std::size_t steps) const noexcept;
+
+    // Chief position and RIC->inertial DCM at the first `steps` grid samples (NaN on failure).
+    void fill_inertial_ephemeris_(const TimeGrid& grid, std::size_t steps) noexcept;
+
+    // Re-run begin_tick() on @p g unless the policy was last prepared for it.
+    bool prepare_policy_(const TimeGrid& g) noexcept;
+
+    // Burns of row i with t0 < t <= t0 + tau_end, as [first, last) indices into burns_[i].
+    [[nodiscard]] std::pair<std::size_t, std::size_t> pending_burns_(std::size_t i,
+                                                                     double tau_end) const noexcept
+    {
+        if (burn_count_[i] == 0 || burns_id_[i] != row_id_[i])
+        {
+            return {0, 0};
+        }
+        std::size_t first = 0;
+        while (first < burn_count_[i] && !(burns_[i][first].t > tick_.t0))
+        {
+            ++first;
+        }
+        std::size_t last = first;
+        while (last < burn_count_[i] && burns_[i][last].t - tick_.t0 <= tau_end)
+        {
+            ++last;
+        }
+        return {first, last};
+    }
+
+    // Compose the pending burns of every predicted row into its samples (buf.maneuver_rows).
+    void apply_maneuvers_(const TimeGrid& grid,
+                          std::size_t steps,
+                          std::size_t nveh,
+                          PredictionBuffer& buf) noexcept;
+
+    // Add row i's pending burns to one trajectory on the grid the policy is prepared for.
+    bool add_burns_(std::size_t i,
+                    double tau_end,
+                    Span<Vec3> out_r,
+                    Span<Vec3> out_v) noexcept;
+
+    // Coefficients of every predicted row with a closed form (buf.coeff_rows); coeff-only
+    // rows already hold their model part from the row loop.
+    void fill_coefficients_(const TimeGrid& grid,
+                            std::size_t steps,
+                            std::size_t nveh,
+                            PredictionBuffer& buf) noexcept;
+
+    // K dispersion samples of every predicted row selected by dispersion_.rows.
+    void disperse_(const TimeGrid& grid,
+                   std::size_t steps,
+                   std::size_t nveh,
+                   const PredictionBuffer& buf) noexcept;
+
+    // Samples [0, K) of row i on a grid of n samples the policy is prepared for, with the
+    // row's pending burns up to tau_end when @p burns.
+    void disperse_row_(std::size_t i, std::size_t n, bool burns, double tau_end) noexcept;
+
+    // Position covariance of every predicted row whose provider reports one (buf.cov_rows).
+    void predict_covariance_(const TimeGrid& grid,
+                             std::size_t steps,
+                             std::size_t nveh,
+                             PredictionBuffer& buf) noexcept;
+
     Publisher& pub_;
     VehicleIndexMap& map_;
     IChiefStateProvider& chief_;
     IVehicleStateProvider& veh_;
     BullseyeFrame& bullseye_;
+    ModelPolicy policy_;
+
+    // Chief, frame and derived transforms of the current tick (computed once).
+    TickContext tick_{};
+
+    // Grid for the current (horizon, cadence); rebuilt only when either changes.
+    TimeGridCache grid_cache_{MAX_STEPS};
+
+    // Per-tick batched deputy request: ids of the occupied rows in row order, their states,
+    // the position/velocity planes, and their RIC initial conditions (one batch transform).
+    std::array<VehicleIndexMap::VehicleId, MAX_VEHICLES> req_ids_{};
+    std::array<VehicleState, MAX_VEHICLES> dep_states_{};
+    std::array<Vec3, MAX_VEHICLES> dep_r_i_{};
+    std::array<Vec3, MAX_VEHICLES> dep_v_i_{};
+    std::array<RelStateRic, MAX_VEHICLES> dep_x0_{};
+
+    // Optional worker pool for the model stage (not owned).
+    WorkerPool* pool_{nullptr};
+
+    // Per-tick gather for policies with predict_block() (see has_predict_block), and for the
+    // parallel path.
+    std::array<RelStateRic, MAX_VEHICLES> x0_block_{};
+    std::array<bool, MAX_VEHICLES> active_block_{};
+
+    // Sliding-window reuse: the last published tick and per-row history.
+    struct LastTick final
+    {
+        bool valid{false};
+        std::uint64_t seqno{0};
+        double t0{0.0};
+        double tau_last{0.0};
+        double cadence_sec{0.0};
+        std::size_t steps{0};
+    };
+    TrajectoryReuseConfig reuse_{};
+    TrajectoryReuseStats stats_{};
+    LastTick last_{};
+    std::array<VehicleIndexMap::VehicleId, MAX_VEHICLES> row_id_{};
+    std::array<bool, MAX_VEHICLES> row_ok_{};
+    std::array<bool, MAX_VEHICLES> row_reused_{};
+    std::array<std::uint32_t, MAX_VEHICLES> row_reuse_count_{};
+
+    // Rows skipped by change detection this tick (PredictionBuffer::unchanged_rows).
+    RowMask unchanged_rows_{0};
+
+    ApproachSummaryConfig approach_{};
+
+    // Grid profiles 1.. (index 0 unused: profile 0 is the step() grid), uniform grids built by
+    // set_grid_profile(), and the initial states of rows on them.
+    std::array<const TimeGrid*, MAX_GRID_PROFILES> profile_grid_{};
+    std::array<TimeGridCache, MAX_GRID_PROFILES - 1> profile_cache_;
+    std::array<RelStateRic, MAX_VEHICLES> profile_x0_{};
+    bool profiles_changed_{false};
+
+    // Tick budget: priority order scratch, user priorities, deferred rows and their ages.
+    TickBudgetConfig budget_{};
+    TickBudgetStats budget_stats_{};
+    std::array<std::size_t, MAX_VEHICLES> budget_order_{};
+    std::array<double, MAX_VEHICLES> budget_key_{};
+    std::array<RelStateRic, MAX_VEHICLES> budget_x0_{};
+    std::array<bool, MAX_VEHICLES> budget_active_{};
+    RowMask deferred_rows_{0};
+    RowMask budget_new_rows_{0};
+    std::array<std::uint32_t, MAX_VEHICLES> row_deferred_ticks_{};
+    std::array<double, MAX_VEHICLES> user_priority_{};
+    std::array<VehicleIndexMap::VehicleId, MAX_VEHICLES> user_priority_id_{};
+    std::array<bool, MAX_VEHICLES> user_priority_set_{};
+
+    // Telemetry: the attached ring (not owned) and the record of the current tick.
+    TickTelemetryRing* telemetry_{nullptr};
+    TickTelemetryRecord telemetry_record_{};
+    std::uint64_t telemetry_ticks_{0};
+
+    // Inertial output: per-tick chief ephemeris over the grid.
+    InertialOutputConfig inertial_{};
+    std::array<Vec3, MAX_STEPS> inertial_chief_r_{};
+    std::array<Mat3, MAX_STEPS> inertial_C_{};
+
+    // Covariance output: the grid the policy was last prepared for, the policy's response to
+    // the six unit initial states on one grid (rows of Phi_k), and each row's RIC P0.
+    const TimeGrid* policy_grid_{nullptr};
+    std::array<std::array<Vec3, MAX_STEPS>, 6> cov_basis_{};
+    std::array<StateCovariance, MAX_VEHICLES> cov_p0_{};
+
+    // Dispersion: configuration, factor of its covariance, caller-owned output, counters,
+    // and each row's nominal initial state of the current tick.
+    DispersionConfig dispersion_{};
+    CovarianceFactor dispersion_L_{};
+    Span2D<Vec3> dispersion_out_{};
+    Span<bool> dispersion_ok_{};
+    DispersionStats dispersion_stats_{};
+    std::array<RelStateRic, MAX_VEHICLES> row_x0_{};
+
+    // Planned maneuvers: each row's schedule sorted by epoch, its length and the vehicle id
+    // it was set for, and the counters of the last tick.
+    std::array<std::array<ImpulsiveBurn, MAX_PLANNED_BURNS>, MAX_VEHICLES> burns_{};
+    std::array<std::size_t, MAX_VEHICLES> burn_count_{};
+    std::array<VehicleIndexMap::VehicleId, MAX_VEHICLES> burns_id_{};
+    ManeuverStats maneuver_stats_{};
+
+    CoefficientOutput coeff_mode_{CoefficientOutput::kOff};
+
+    // Bullseye source transitions: previous source, blend in progress, last tick's outcome.
+    SourceTransitionTracker transition_{};
+
+    // warm_up(): the tick in progress abandons its write instead of publishing, and whether it
+    // got that far.
+    bool dry_run_{false};
+    bool dry_reached_publish_{false};
 };
 
+/** @brief Runtime-configured predictor (HCW, YA/TH, or injected IRelativeModel). */
+using RelativePredictor = BasicRelativePredictor<DynamicModelPolicy>;
+
+/** @brief Statically dispatched HCW predictor. */
+using HcwRelativePredictor = BasicRelativePredictor<HcwPolicy>;
+
+/** @brief Statically dispatched YA/TH predictor. */
+using YaRelativePredictor = BasicRelativePredictor<YaStmPolicy>;
+
+/** @brief Predictor whose rows are applied by an IStmBatchBackend (CPU or device). */
+using StmBatchRelativePredictor = BasicRelativePredictor<StmBatchPolicy>;
+
+extern template class BasicRelativePredictor<DynamicModelPolicy>;
+extern template class BasicRelativePredictor<HcwPolicy>;
+extern template class BasicRelativePredictor<YaStmPolicy>;
+extern template class BasicRelativePredictor<VirtualModelPolicy>;
+extern template class BasicRelativePredictor<StmBatchPolicy>;
+
 } // namespace bullseye_pred
@@ -0,0 +1,1528 @@
+// core/relative_predictor_impl.hpp
+#pragma once
+/**
+ * @file relative_predictor_impl.hpp
+ * @brief BasicRelativePredictor<ModelPolicy>::step() definition.
+ *
+ * Included by relative_predictor.cpp for the provided policies; include it in one translation
+ * unit (with an explicit instantiation) to use a custom model policy.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+
+#include "core/bullseye_frame_math.hpp"
+#include "core/closest_approach.hpp"
+#include "core/frame_id_registry.hpp"
+#include "core/frame_transforms.hpp"
+#include "core/logging.hpp"
+#include "core/math/universal_kepler.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/tick_trace.hpp"
+
+namespace bullseye_pred
+{
+namespace detail
+{
+
+// Tick summary of a snapshot just written (buf is read before the next begin_write()).
+inline void fill_tick_telemetry(TickTelemetryRecord& rec,
+                                const PredictionBuffer& buf,
+                                std::size_t nveh,
+                                RowMask dirty) noexcept
+{
+    rec.vehicles = static_cast<std::uint16_t>(nveh);
+    rec.steps = static_cast<std::uint16_t>(buf.steps);
+    rec.valid_rows = buf.valid_rows;
+    rec.deferred_rows = buf.deferred_rows;
+    rec.unchanged_rows = buf.unchanged_rows;
+    rec.dirty_rows = dirty;
+    rec.est_cost_total = buf.est_cost_total;
+    rec.row_status = buf.row_status;
+    rec.row_model.fill(kTelemetryNoModel);
+    for (std::size_t i = 0; i < nveh; ++i)
+    {
+        if (((buf.deferred_rows >> i) & 1u) != 0u)
+        {
+            ++rec.rows_deferred; // status carried over from an earlier snapshot
+            continue;
+        }
+        if (((buf.unchanged_rows >> i) & 1u) != 0u)
+        {
+            ++rec.rows_unchanged; // skipped by change detection, likewise carried over
+            continue;
+        }
+        switch (buf.row_status[i])
+        {
+        case RowStatus::kOk:
+            ++rec.rows_ok;
+            break;
+        case RowStatus::kReused:
+            ++rec.rows_reused;
+            break;
+        case RowStatus::kProviderError:
+            ++rec.rows_provider_error;
+            continue;
+        case RowStatus::kFrameMismatch:
+            ++rec.rows_frame_mismatch;
+            continue;
+        case RowStatus::kModelError:
+            ++rec.rows_model_error;
+            break;
+        case RowStatus::kEmpty:
+            continue;
+        }
+        // Rows with a model decision this tick carry a non-zero estimated cost.
+        if (buf.row_model[i].est_cost > 0.0)
+        {
+            rec.row_model[i] = static_cast<std::uint8_t>(buf.row_model[i].model);
+            rec.row_cause[i] = buf.row_model[i].cause;
+        }
+    }
+}
+
+/**
+ * @brief Compute mean motion n [rad/s] for HCW.
+ *
+ * Priority:
+ * 1) Use frame omega if present and in RIC coordinates.
+ * 2) Fallback to n = |r×v| / |r|^2 from chief state.
+ */
+inline bool compute_mean_motion(const ChiefState& chief,
+                                       const BullseyeFrameSnapshot& frame,
+                                       double& out_n) noexcept
+{
+    if (frame.has_omega && frame.omega_coords == OmegaCoords::kOmegaRIC && std::isfinite(frame.omega_ric.z) &&
+        frame.omega_ric.z > 0.0)
+    {
+        out_n = frame.omega_ric.z;
+        return true;
+    }
+
+    if (!finite3(chief.r_i) || !finite3(chief.v_i))
+    {
+        return false;
+    }
+    const double r_norm = norm(chief.r_i);
+    if (!(r_norm > 0.0) || !std::isfinite(r_norm))
+    {
+        return false;
+    }
+    const Vec3 h = cross(chief.r_i, chief.v_i);
+    const double h_norm = norm(h);
+    const double n = h_norm / (r_norm * r_norm);
+    if (!(n > 0.0) || !std::isfinite(n))
+    {
+        return false;
+    }
+    out_n = n;
+    return true;
+}
+
+} // namespace detail
+
+template <typename ModelPolicy>
+void BasicRelativePredictor<ModelPolicy>::step(double t0,
+                                               double horizon_sec,
+                                               double cadence_sec) noexcept
+{
+    step_on_grid_(t0, grid_cache_.get(horizon_sec, cadence_sec), cadence_sec);
+}
+
+template <typename ModelPolicy>
+bool BasicRelativePredictor<ModelPolicy>::save_checkpoint(CheckpointWriter& out,
+                                                         std::uint32_t instance) const
+{
+    if (!pub_.save_checkpoint(out, instance))
+    {
+        return false;
+    }
+    map_.save_checkpoint(out, instance);
+    out.begin_section(CheckpointSection::kPredictor, instance);
+    for_each_checkpoint_field_(*this, [&out](const auto& field) { out.append_value(field); });
+    if constexpr (has_checkpoint<ModelPolicy>::value)
+    {
+        out.begin_section(CheckpointSection::kModelCache, instance);
+        policy_.save_checkpoint(out);
+    }
+    return true;
+}
+
+template <typename ModelPolicy>
+CheckpointCode BasicRelativePredictor<ModelPolicy>::restore_checkpoint(
+    const CheckpointFile& in, std::uint32_t instance) noexcept
+{
+    for (const CheckpointSection tag : {CheckpointSection::kVehicleMap,
+                                        CheckpointSection::kPublisher,
+                                        CheckpointSection::kPredictor})
+    {
+        if (!in.has_section(tag, instance))
+        {
+            return CheckpointCode::kMissingSection;
+        }
+    }
+    CheckpointCursor own = in.cursor(CheckpointSection::kPredictor, instance);
+    std::size_t own_bytes = 0;
+    for_each_checkpoint_field_(*this, [&own_bytes](const auto& field) { own_bytes += sizeof(field); });
+    if (own.remaining() != own_bytes)
+    {
+        return CheckpointCode::kLayoutMismatch;
+    }
+    CheckpointCursor model{};
+    if constexpr (has_checkpoint<ModelPolicy>::value)
+    {
+        if (!in.has_section(CheckpointSection::kModelCache, instance))
+        {
+            return CheckpointCode::kMissingSection;
+        }
+        model = in.cursor(CheckpointSection::kModelCache, instance);
+        if (model.remaining() != policy_.checkpoint_bytes())
+        {
+            return CheckpointCode::kLayoutMismatch;
+        }
+    }
+
+    CheckpointCode code = map_.restore_checkpoint(in, instance);
+    if (code == CheckpointCode::kOk)
+    {
+        code = pub_.restore_checkpoint(in, instance);
+    }
+    if (code != CheckpointCode::kOk)
+    {
+        return code;
+    }
+    for_each_checkpoint_field_(*this, [&own](auto& field) { (void)own.read_value(field); });
+    if constexpr (has_checkpoint<ModelPolicy>::value)
+    {
+        (void)policy_.restore_checkpoint(model);
+    }
+    return CheckpointCode::kOk;
+}
+
+template <typename ModelPolicy>
+void BasicRelativePredictor<ModelPolicy>::step(double t0, const TimeGrid& grid) noexcept
+{
+    double cadence_sec = 0.0;
+    if (!uniform_cadence(grid, cadence_sec))
+    {
+        cadence_sec = 0.0; // non-uniform: no sliding-window reuse
+    }
+    step_on_grid_(t0, grid, cadence_sec);
+}
+
+template <typename ModelPolicy>
+bool BasicRelativePredictor<ModelPolicy>::warm_up(double t0,
+                                                  double horizon_sec,
+                                                  double cadence_sec) noexcept
+{
+    return warm_up_(t0, grid_cache_.get(horizon_sec, cadence_sec), cadence_sec);
+}
+
+template <typename ModelPolicy>
+bool BasicRelativePredictor<ModelPolicy>::warm_up(double t0, const TimeGrid& grid) noexcept
+{
+    double cadence_sec = 0.0;
+    if (!uniform_cadence(grid, cadence_sec))
+    {
+        cadence_sec = 0.0;
+    }
+    return warm_up_(t0, grid, cadence_sec);
+}
+
+template <typename ModelPolicy>
+bool BasicRelativePredictor<ModelPolicy>::warm_up_(double t0,
+                                                   const TimeGrid& grid,
+                                                   double cadence_sec) noexcept
+{
+    logging::preload();
+
+    // The checkpointed members are exactly the state one tick hands to the next.
+    std::size_t bytes = 0;
+    for_each_checkpoint_field_(*this, [&bytes](const auto& field) { bytes += sizeof(field); });
+    const std::unique_ptr<unsigned char[]> saved(new (std::nothrow) unsigned char[bytes]);
+    if (saved == nullptr)
+    {
+        return false;
+    }
+    std::size_t off = 0;
+    for_each_checkpoint_field_(*this, [&saved, &off](const auto& field) {
+        std::memcpy(saved.get() + off, &field, sizeof(field));
+        off += sizeof(field);
+    });
+    const TickContext tick = tick_;
+    const RowMask unchanged_rows = unchanged_rows_;
+    const ManeuverStats maneuver_stats = maneuver_stats_;
+    const DispersionStats dispersion_stats = dispersion_stats_;
+    TickTelemetryRing* const telemetry = telemetry_;
+
+    telemetry_ = nullptr;
+    dry_run_ = true;
+    dry_reached_publish_ = false;
+    if constexpr (has_dry_run<ModelPolicy>::value)
+    {
+        policy_.set_dry_run(true);
+    }
+    step_on_grid_(t0, grid, cadence_sec);
+    if constexpr (has_dry_run<ModelPolicy>::value)
+    {
+        policy_.set_dry_run(false);
+    }
+    dry_run_ = false;
+    telemetry_ = telemetry;
+
+    off = 0;
+    for_each_checkpoint_field_(*this, [&saved, &off](auto& field) {
+        std::memcpy(&field, saved.get() + off, sizeof(field));
+        off += sizeof(field);
+    });
+    tick_ = tick;
+    unchanged_rows_ = unchanged_rows;
+    maneuver_stats_ = maneuver_stats;
+    dispersion_stats_ = dispersion_stats;
+    return dry_reached_publish_;
+}
+
+template <typename ModelPolicy>
+void BasicRelativePredictor<ModelPolicy>::predict_parallel_(std::size_t nveh,
+                                                            std::size_t steps,
+                                                            PredictionBuffer& buf) noexcept
+{
+    // One contiguous row range per thread. Rows are independent, so the split only decides
+    // which thread computes a row, never its value.
+    const std::size_t chunks = std::min(nveh, pool_->workers() + 1);
+    TrajectoryPlane* const vel = buf.velocities;
+    auto task = [this, nveh, steps, chunks, vel, &buf](std::size_t c) noexcept
+    {
+        const std::size_t lo = c * nveh / chunks;
+        const std::size_t hi = (c + 1) * nveh / chunks;
+        if constexpr (has_predict_block<ModelPolicy>::value)
+        {
+            const Span2D<Vec3> out_v =
+                (vel != nullptr) ? Span2D<Vec3>{(*vel)[lo].data(), hi - lo, steps, MAX_STEPS}
+                                 : Span2D<Vec3>{};
+            policy_.predict_block(Span<const RelStateRic>{x0_block_.data() + lo, hi - lo},
+                                  Span<const bool>{active_block_.data() + lo, hi - lo},
+                                  Span2D<Vec3>{buf.positions[lo].data(), hi - lo, steps,
+                                               MAX_STEPS},
+                                  out_v, Span<bool>{row_ok_.data() + lo, hi - lo});
+        }
+        else
+        {
+            for (std::size_t i = lo; i < hi; ++i)
+            {
+                if (active_block_[i])
+                {
+                    StageTrace trace_row(TraceStage::kVehicle, static_cast<std::uint32_t>(i));
+                    row_ok_[i] = policy_.predict(
+                        x0_block_[i], Span<Vec3>{buf.positions[i].data(), steps},
+                        (vel != nullptr) ? Span<Vec3>{(*vel)[i].data(), steps}
+                                         : Span<Vec3>{nullptr, 0});
+                }
+            }
+        }
+    };
+    pool_->run(chunks, task);
+}
+
+template <typename ModelPolicy>
+bool BasicRelativePredictor<ModelPolicy>::prepare_policy_(const TimeGrid& g) noexcept
+{
+    if (policy_grid_ == &g)
+    {
+        return true;
+    }
+    const bool ok = policy_.begin_tick(tick_.chief, tick_.n_radps, g);
+    policy_grid_ = ok ? &g : nullptr;
+    return ok;
+}
+
+template <typename ModelPolicy>
+void BasicRelativePredictor<ModelPolicy>::disperse_(const TimeGrid& grid,
+                                                    std::size_t steps,
+                                                    std::size_t nveh,
+                                                    const PredictionBuffer& buf) noexcept
+{
+    const std::size_t K = dispersion_.samples;
+    const std::size_t capacity = std::min(dispersion_out_.rows, dispersion_ok_.size);
+    for (std::size_t p = 0; p < MAX_GRID_PROFILES; ++p)
+    {
+        const TimeGrid* const g = (p == 0) ? &grid : profile_grid_[p];
+        const std::size_t n = (p == 0) ? steps : buf.profile_steps[p - 1];
+        if (g == nullptr || n == 0 || n > dispersion_out_.cols)
+        {
+            continue;
+        }
+        bool prepared = false;
+        for (std::size_t i = 0; i < nveh; ++i)
+        {
+            if (!row_ok_[i] || buf.row_grid[i] != p || ((dispersion_.rows >> i) & 1u) == 0u ||
+                (i + 1) * K > capacity)
+            {
+                continue;
+            }
+            if (!prepared && !prepare_policy_(*g))
+            {
+                break;
+            }
+            prepared = true;
+            disperse_row_(i, n, ((buf.maneuver_rows >> i) & 1u) != 0u, g->tau[n - 1]);
+            dispersion_stats_.rows |= RowMask{1} << i;
+            for (std::size_t s = 0; s < K; ++s)
+            {
+                if (dispersion_ok_[i * K + s])
+                {
+                    ++dispersion_stats_.samples_ok;
+                }
+                else
+                {
+                    ++dispersion_stats_.samples_failed;
+                }
+            }
+        }
+    }
+}
+
+template <typename ModelPolicy>
+void BasicRelativePredictor<ModelPolicy>::disperse_row_(std::size_t i,
+                                                        std::size_t n,
+                                                        bool burns,
+                                                        double tau_end) noexcept
+{
+    const std::size_t K = dispersion_.samples;
+    bool concurrent = false;
+    if constexpr (has_concurrent_rows<ModelPolicy>::value)
+    {
+        concurrent = policy_.concurrent_rows();
+    }
+    const bool parallel = concurrent && pool_ != nullptr && pool_->workers() > 0;
+
+    // Chunks of at most MAX_VEHICLES samples (one predict_block() each). Every sample is a
+    // pure function of (seed, vehicle id, sample index), so the split never changes a value.
+    const std::size_t threads = parallel ? pool_->workers() + 1 : 1;
+    const std::size_t chunk = std::max<std::size_t>(
+        1, std::min<std::size_t>(MAX_VEHICLES, (K + threads - 1) / threads));
+    const std::size_t chunks = (K + chunk - 1) / chunk;
+    const std::uint64_t stream = static_cast<std::uint64_t>(row_id_[i]);
+
+    auto task = [this, i, n, K, chunk, stream, concurrent, burns, tau_end](std::size_t c) noexcept
+    {
+        const std::size_t lo = c * chunk;
+        const std::size_t cnt = std::min(chunk, K - lo);
+        std::array<RelStateRic, MAX_VEHICLES> x0{};
+        dispersion_states(row_x0_[i], dispersion_L_, dispersion_.seed, stream, lo,
+                          Span<RelStateRic>{x0.data(), cnt});
+        const std::size_t stride = dispersion_out_.row_stride;
+        const Span2D<Vec3> out_r{dispersion_out_.data + (i * K + lo) * stride, cnt, n, stride};
+        const Span<bool> out_ok{dispersion_ok_.data + i * K + lo, cnt};
+        bool blocked = false;
+        if constexpr (has_predict_block<ModelPolicy>::value)
+        {
+            // predict_block() rows may carry per-vehicle state unless rows are independent.
+            if (concurrent)
+            {
+                std::array<bool, MAX_VEHICLES> active{};
+                std::fill_n(active.data(), cnt, true);
+                std::fill_n(out_ok.data, cnt, false);
+                policy_.predict_block(Span<const RelStateRic>{x0.data(), cnt},
+                                      Span<const bool>{active.data(), cnt}, out_r,
+                                      Span2D<Vec3>{}, out_ok);
+                blocked = true;
+            }
+        }
+        for (std::size_t s = 0; s < cnt && !blocked; ++s)
+        {
+            out_ok.data[s] = policy_.predict(x0[s], out_r.row(s), Span<Vec3>{nullptr, 0});
+        }
+        // Burns are deterministic, so every sample gets the nominal row's.
+        for (std::size_t s = 0; s < cnt && burns; ++s)
+        {
+            out_ok.data[s] =
+                out_ok[s] && add_burns_(i, tau_end, out_r.row(s), Span<Vec3>{nullptr, 0});
+        }
+    };
+    if (parallel && chunks > 1)
+    {
+        pool_->run(chunks, task);
+    }
+    else
+    {
+        for (std::size_t c = 0; c < chunks; ++c)
+        {
+            task(c);
+        }
+    }
+}
+
+template <typename ModelPolicy>
+bool BasicRelativePredictor<ModelPolicy>::add_burns_(std::size_t i,
+                                                     double tau_end,
+                                                     Span<Vec3> out_r,
+                                                     Span<Vec3> out_v) noexcept
+{
+    const auto range = pending_burns_(i, tau_end);
+    bool ok = true;
+    for (std::size_t j = range.first; j < range.second && ok; ++j)
+    {
+        if constexpr (has_predict_impulse<ModelPolicy>::value)
+        {
+            const ImpulsiveBurn& b = burns_[i][j];
+            ok = policy_.predict_impulse(i, b.dv_ric, b.t - tick_.t0, out_r, out_v);
+        }
+        else
+        {
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+template <typename ModelPolicy>
+void BasicRelativePredictor<ModelPolicy>::apply_maneuvers_(const TimeGrid& grid,
+                                                           std::size_t steps,
+                                                           std::size_t nveh,
+                                                           PredictionBuffer& buf) noexcept
+{
+    maneuver_stats_ = ManeuverStats{};
+    buf.maneuver_rows = 0;
+    buf.control_unmodeled_rows = 0;
+    TrajectoryPlane* const vel = buf.velocities;
+    for (std::size_t p = 0; p < MAX_GRID_PROFILES; ++p)
+    {
+        const TimeGrid* const g = (p == 0) ? &grid : profile_grid_[p];
+        const std::size_t n = (p == 0) ? steps : buf.profile_steps[p - 1];
+        if (g == nullptr || n == 0)
+        {
+            continue;
+        }
+        const double tau_end = g->tau[n - 1];
+        bool prepared = false;
+        bool ready = false;
+        for (std::size_t i = 0; i < nveh; ++i)
+        {
+            const auto range = pending_burns_(i, tau_end);
+            if (!row_ok_[i] || buf.row_grid[i] != p || range.first == range.second)
+            {
+                continue;
+            }
+            const RowMask bit = RowMask{1} << i;
+            if ((buf.coeff_only_rows & bit) != 0u)
+            {
+                // No samples to update; the burns travel in the row's coefficients.
+                buf.maneuver_rows |= bit;
+                maneuver_stats_.burns_applied += range.second - range.first;
+                continue;
+            }
+            if (!prepared)
+            {
+                ready = prepare_policy_(*g);
+                prepared = true;
+            }
+            const Span<Vec3> out_v =
+                (vel != nullptr) ? Span<Vec3>{(*vel)[i].data(), n} : Span<Vec3>{nullptr, 0};
+            if (ready && add_burns_(i, tau_end, Span<Vec3>{buf.positions[i].data(), n}, out_v))
+            {
+                buf.maneuver_rows |= bit;
+                maneuver_stats_.burns_applied += range.second - range.first;
+            }
+            else
+            {
+                buf.control_unmodeled_rows |= bit;
+            }
+        }
+    }
+    maneuver_stats_.rows = buf.maneuver_rows;
+    maneuver_stats_.unmodeled_rows = buf.control_unmodeled_rows;
+}
+
+template <typename ModelPolicy>
+void BasicRelativePredictor<ModelPolicy>::fill_coefficients_(const TimeGrid& grid,
+                                                             std::size_t steps,
+                                                             std::size_t nveh,
+                                                             PredictionBuffer& buf) noexcept
+{
+    buf.coeff_rows = 0;
+    if (coeff_mode_ == CoefficientOutput::kOff)
+    {
+        return;
+    }
+    for (std::size_t i = 0; i < nveh; ++i)
+    {
+        const RowMask bit = RowMask{1} << i;
+        if (!row_ok_[i] || (buf.control_unmodeled_rows & bit) != 0u)
+        {
+            continue;
+        }
+        TrajectoryCoefficients& c = buf.coefficients[i];
+        if ((buf.coeff_only_rows & bit) == 0u)
+        {
+            bool ok = false;
+            if constexpr (has_row_coefficients<ModelPolicy>::value)
+            {
+                ok = policy_.row_coefficients(i, row_x0_[i], true, c);
+            }
+            if (!ok)
+            {
+                continue;
+            }
+        }
+
+        // The burns composed into the row, as offsets from its epoch.
+        c.burn_count = 0;
+        const std::uint8_t p = buf.row_grid[i];
+        const std::size_t n = (p == 0) ? steps : buf.profile_steps[p - 1];
+        if ((buf.maneuver_rows & bit) != 0u && n > 0)
+        {
+            const double tau_end = (p == 0) ? grid.tau[n - 1] : buf.profile_tau[p - 1][n - 1];
+            const auto range = pending_burns_(i, tau_end);
+            for (std::size_t j = range.first; j < range.second; ++j)
+            {
+                c.burns[c.burn_count++] =
+                    CoefficientBurn{burns_[i][j].t - tick_.t0, burns_[i][j].dv_ric};
+            }
+        }
+        buf.coeff_rows |= bit;
+    }
+}
+
+template <typename ModelPolicy>
+void BasicRelativePredictor<ModelPolicy>::predict_covariance_(const TimeGrid& grid,
+                                                              std::size_t steps,
+                                                              std::size_t nveh,
+                                                              PredictionBuffer& buf) noexcept
+{
+    const Vec3 axes[3] = {Vec3{1.0, 0.0, 0.0}, Vec3{0.0, 1.0, 0.0}, Vec3{0.0, 0.0, 1.0}};
+    buf.cov_rows = 0;
+    RowMask want = 0;
+    for (std::size_t i = 0; i < nveh; ++i)
+    {
+        StateCovariance P_i{};
+        if (row_ok_[i] && veh_.get_covariance(row_id_[i], tick_.t0, P_i) &&
+            inertial_to_ric_covariance(P_i, tick_.C_i2r, tick_.frame.omega_ric, cov_p0_[i]))
+        {
+            want |= RowMask{1} << i;
+        }
+    }
+
+    for (std::size_t p = 0; p < MAX_GRID_PROFILES && want != 0u; ++p)
+    {
+        const TimeGrid* const g = (p == 0) ? &grid : profile_grid_[p];
+        const std::size_t n = (p == 0) ? steps : buf.profile_steps[p - 1];
+        RowMask mine = 0;
+        for (std::size_t i = 0; i < nveh; ++i)
+        {
+            if (((want >> i) & 1u) != 0u && buf.row_grid[i] == p)
+            {
+                mine |= RowMask{1} << i;
+            }
+        }
+        if (mine == 0u || g == nullptr || n == 0)
+        {
+            continue;
+        }
+
+        // Phi_k e_j for the six unit initial states, on the grid the policy is prepared for.
+        bool ok = prepare_policy_(*g);
+        for (std::size_t j = 0; j < 6 && ok; ++j)
+        {
+            RelStateRic e{};
+            (j < 3 ? e.r_ric : e.v_ric) = axes[j % 3];
+            ok = policy_.predict(e, Span<Vec3>{cov_basis_[j].data(), n}, Span<Vec3>{nullptr, 0});
+        }
+        if (!ok)
+        {
+            continue;
+        }
+
+        const Span2D<const Vec3> basis{cov_basis_[0].data(), 6, n, MAX_STEPS};
+        for (std::size_t i = 0; i < nveh; ++i)
+        {
+            if (((mine >> i) & 1u) != 0u)
+            {
+                propagate_position_covariance(
+                    cov_p0_[i], basis, Span<PositionCovariance>{(*buf.position_cov)[i].data(), n});
+                buf.cov_rows |= RowMask{1} << i;
+            }
+        }
+    }
+}
+
+template <typename ModelPolicy>
+void BasicRelativePredictor<ModelPolicy>::fill_inertial_ephemeris_(const TimeGrid& grid,
+                                                                   std::size_t steps) noexcept
+{
+    constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+    const ChiefState& chief = tick_.chief;
+    const double mu = inertial_.mu;
+    Mat3 nan_C{};
+    for (auto& row : nan_C.m)
+    {
+        row.fill(kNaN);
+    }
+
+    // Tick frame relative to the frame constructed from the chief at t0 (identity for a
+    // constructed Bullseye, the adopted misalignment otherwise); held fixed over the grid.
+    const ConstructedRicFrame con0 = construct_ric_from_chief(chief);
+    const bool ok0 = con0.status.ok() && std::isfinite(mu) && mu > 0.0;
+    const Mat3 D = mul_transpose(con0.C_from_ric_to_inertial, tick_.C_r2i);
+
+    const double r0n = norm(chief.r_i);
+    const double alpha = 2.0 / r0n - dot(chief.v_i, chief.v_i) / mu;
+    const double sqrt_mu = std::sqrt(mu);
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        const double tau = grid.tau[k];
+        if (tau == 0.0)
+        {
+            inertial_chief_r_[k] = chief.r_i;
+            inertial_C_[k] = tick_.C_r2i;
+            continue;
+        }
+        math::UniversalPropagation prop{};
+        ChiefState at_k = chief;
+        at_k.time_tag = chief.time_tag + tau;
+        const bool ok = ok0 &&
+                        math::universal_propagate(
+                            chief.r_i, chief.v_i, mu, tau,
+                            math::universal_initial_guess(alpha, sqrt_mu, r0n, tau),
+                            contracts::Det::kKeplerIters, prop);
+        at_k.r_i = prop.r_i;
+        at_k.v_i = prop.v_i;
+        const ConstructedRicFrame con =
+            ok ? construct_ric_from_chief(at_k) : ConstructedRicFrame{};
+        if (!ok || !con.status.ok())
+        {
+            inertial_chief_r_[k] = Vec3{kNaN, kNaN, kNaN};
+            inertial_C_[k] = nan_C;
+            continue;
+        }
+        inertial_chief_r_[k] = prop.r_i;
+        inertial_C_[k] = mul(con.C_from_ric_to_inertial, D);
+    }
+}
+
+template <typename ModelPolicy>
+void BasicRelativePredictor<ModelPolicy>::predict_profiles_(RowMask rows,
+                                                            std::size_t nveh,
+                                                            bool parallel,
+                                                            PredictionBuffer& buf) noexcept
+{
+    constexpr bool kBlock = has_predict_block<ModelPolicy>::value;
+    constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+    const RelStateRic inactive{Vec3{kNaN, kNaN, kNaN}, Vec3{kNaN, kNaN, kNaN}};
+    TrajectoryPlane* const vel = buf.velocities;
+
+    for (std::size_t p = 1; p < MAX_GRID_PROFILES; ++p)
+    {
+        // Every configured profile is published, whether or not a row uses it this tick.
+        const TimeGrid* const g = profile_grid_[p];
+        const std::size_t steps = (g != nullptr) ? std::min(g->tau.size(), MAX_STEPS) : 0;
+        buf.profile_steps[p - 1] = steps;
+        std::copy_n(g != nullptr ? g->tau.data() : nullptr, steps, buf.profile_tau[p - 1].data());
+
+        RowMask mine = 0;
+        for (std::size_t i = 0; i < nveh; ++i)
+        {
+            if (((rows >> i) & 1u) != 0u && buf.row_grid[i] == p)
+            {
+                mine |= RowMask{1} << i;
+            }
+        }
+        if (mine == 0u)
+        {
+            continue;
+        }
+
+        // The policy's per-tick state (STM table, chief ephemeris) follows this grid now.
+        if (steps > 0)
+        {
+            policy_grid_ = g;
+        }
+        const bool ready =
+            steps > 0 && policy_.begin_tick(tick_.chief, tick_.n_radps, *g);
+        if (kBlock || parallel)
+        {
+            x0_block_.fill(inactive);
+            active_block_.fill(false);
+        }
+        for (std::size_t i = 0; i < nveh; ++i)
+        {
+            if (((mine >> i) & 1u) == 0u)
+            {
+                continue;
+            }
+            if (!ready)
+            {
+                buf.row_status[i] = RowStatus::kModelError;
+            }
+            else if (kBlock || parallel)
+            {
+                x0_block_[i] = profile_x0_[i];
+                active_block_[i] = true;
+            }
+            else
+            {
+                const Span<Vec3> out_v = (vel != nullptr) ? Span<Vec3>{(*vel)[i].data(), steps}
+                                                          : Span<Vec3>{nullptr, 0};
+                row_ok_[i] = policy_.predict(
+                    profile_x0_[i], Span<Vec3>{buf.positions[i].data(), steps}, out_v);
+                buf.row_status[i] = row_ok_[i] ? RowStatus::kOk : RowStatus::kModelError;
+            }
+        }
+        if (!ready || !(kBlock || parallel))
+        {
+            continue;
+        }
+
+        if (parallel)
+        {
+            predict_parallel_(nveh, steps, buf);
+        }
+        else if constexpr (kBlock)
+        {
+            const Span2D<Vec3> out_v =
+                (vel != nullptr) ? Span2D<Vec3>{(*vel)[0].data(), nveh, steps, MAX_STEPS}
+                                 : Span2D<Vec3>{};
+            policy_.predict_block(Span<const RelStateRic>{x0_block_.data(), nveh},
+                                  Span<const bool>{active_block_.data(), nveh},
+                                  Span2D<Vec3>{buf.positions[0].data(), nveh, steps, MAX_STEPS},
+                                  out_v, Span<bool>{row_ok_.data(), nveh});
+        }
+        for (std::size_t i = 0; i < nveh; ++i)
+        {
+            if (active_block_[i])
+            {
+                buf.row_status[i] = row_ok_[i] ? RowStatus::kOk : RowStatus::kModelError;
+            }
+        }
+    }
+}
+
+template <typename ModelPolicy>
+TickBudgetStats BasicRelativePredictor<ModelPolicy>::predict_budgeted_(
+    std::size_t nveh,
+    std::size_t steps,
+    PredictionBuffer& buf,
+    const PredictionBuffer& prev,
+    std::chrono::steady_clock::time_point start) noexcept
+{
+    // Priority keys (smaller first) of the gathered rows; stable insertion sort, so ties keep
+    // row order and nothing is allocated. Rows new to their vehicle, then rows deferred too
+    // long, go first.
+    constexpr double kInf = std::numeric_limits<double>::infinity();
+    std::fill(row_deferred_ticks_.begin() + static_cast<std::ptrdiff_t>(nveh),
+              row_deferred_ticks_.end(), 0u);
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < nveh; ++i)
+    {
+        if (!active_block_[i])
+        {
+            row_deferred_ticks_[i] = 0; // not due (failed or reused)
+            continue;
+        }
+        const RelStateRic& x0 = x0_block_[i];
+        double key = 0.0;
+        switch (budget_.priority)
+        {
+        case RowPriority::kRowOrder:
+            break;
+        case RowPriority::kRange:
+            key = norm(x0.r_ric);
+            break;
+        case RowPriority::kClosingRate:
+        {
+            const double range = norm(x0.r_ric);
+            key = (range > 0.0) ? dot(x0.r_ric, x0.v_ric) / range : 0.0; // range rate
+            break;
+        }
+        case RowPriority::kUserAssigned:
+            if (user_priority_set_[i] && user_priority_id_[i] == row_id_[i])
+            {
+                key = -user_priority_[i];
+            }
+            break;
+        }
+        if (std::isnan(key))
+        {
+            key = kInf; // unusable state: last
+        }
+        if (((budget_new_rows_ >> i) & 1u) != 0u)
+        {
+            key = -kInf;
+        }
+        else if (budget_.max_deferred_ticks > 0 &&
+                 row_deferred_ticks_[i] >= budget_.max_deferred_ticks)
+        {
+            key = -std::numeric_limits<double>::max();
+        }
+        std::size_t k = n++;
+        for (; k > 0 && budget_key_[k - 1] > key; --k)
+        {
+            budget_order_[k] = budget_order_[k - 1];
+            budget_key_[k] = budget_key_[k - 1];
+        }
+        budget_order_[k] = i;
+        budget_key_[k] = key;
+    }
+
+    constexpr bool kBlock = has_predict_block<ModelPolicy>::value;
+    constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+    const RelStateRic inactive{Vec3{kNaN, kNaN, kNaN}, Vec3{kNaN, kNaN, kNaN}};
+    if constexpr (kBlock)
+    {
+        budget_x0_.fill(inactive);
+        budget_active_.fill(false);
+    }
+    TrajectoryPlane* const vel = buf.velocities;
+
+    // Rows new to their vehicle are outside the budget; the others count against it in order.
+    TickBudgetStats out{};
+    std::size_t ranked = 0;
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        const std::size_t i = budget_order_[k];
+        bool due = true;
+        if (((budget_new_rows_ >> i) & 1u) == 0u)
+        {
+            due = ranked < budget_.max_rows;
+            if (due && ranked >= budget_.min_rows)
+            {
+                const double elapsed =
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                        .count();
+                due = elapsed < budget_.budget_sec;
+            }
+            ++ranked;
+        }
+        if (!due)
+        {
+            active_block_[i] = false;
+            buf.row_status[i] = prev.row_status[i];
+            deferred_rows_ |= RowMask{1} << i;
+            ++row_deferred_ticks_[i];
+            ++out.rows_deferred;
+            continue;
+        }
+        row_deferred_ticks_[i] = 0;
+
+        if constexpr (kBlock)
+        {
+            // One active row per call, so the deadline is checked between rows.
+            budget_x0_[i] = x0_block_[i];
+            budget_active_[i] = true;
+            const Span2D<Vec3> out_v =
+                (vel != nullptr) ? Span2D<Vec3>{(*vel)[0].data(), nveh, steps, MAX_STEPS}
+                                 : Span2D<Vec3>{};
+            policy_.predict_block(Span<const RelStateRic>{budget_x0_.data(), nveh},
+                                  Span<const bool>{budget_active_.data(), nveh},
+                                  Span2D<Vec3>{buf.positions[0].data(), nveh, steps, MAX_STEPS},
+                                  out_v, Span<bool>{row_ok_.data(), nveh});
+            budget_x0_[i] = inactive;
+            budget_active_[i] = false;
+        }
+        else
+        {
+            const Span<Vec3> out_v = (vel != nullptr) ? Span<Vec3>{(*vel)[i].data(), steps}
+                                                      : Span<Vec3>{nullptr, 0};
+            row_ok_[i] = policy_.predict(x0_block_[i], Span<Vec3>{buf.positions[i].data(), steps},
+                                         out_v);
+        }
+        ++out.rows_predicted;
+    }
+    return out;
+}
+
+template <typename ModelPolicy>
+bool BasicRelativePredictor<ModelPolicy>::matches_published_(std::size_t i,
+                                                             const RelStateRic& x0,
+                                                             const PredictionBuffer& prev,
+                                                             std::size_t steps) const noexcept
+{
+    if (((prev.valid_rows >> i) & 1u) == 0u)
+    {
+        return false;
+    }
+    // The row's samples are offsets from its own epoch, which trails t0 once it is carried.
+    const double offset = tick_.t0 - prev.row_t0[i];
+    if (!(offset > 0.0) || !(offset <= reuse_.max_unchanged_sec))
+    {
+        return false;
+    }
+    const double tol = 1.0e-9 * offset;
+    const double* const tau = prev.tau.data();
+    const double* const hit = std::lower_bound(tau, tau + steps, offset - tol);
+    if (hit == tau + steps || std::fabs(*hit - offset) > tol)
+    {
+        return false; // off the grid, or past the end of the carried horizon
+    }
+    const auto k = static_cast<std::size_t>(hit - tau);
+    return norm(x0.r_ric - prev.positions[i][k]) <= reuse_.pos_tol_m &&
+           (prev.velocities == nullptr ||
+            norm(x0.v_ric - (*prev.velocities)[i][k]) <= reuse_.vel_tol_mps);
+}
+
+template <typename ModelPolicy>
+void BasicRelativePredictor<ModelPolicy>::step_on_grid_(double t0,
+                                                        const TimeGrid& grid,
+                                                        double cadence_sec) noexcept
+{
+    // Telemetry record of this tick, pushed on every exit once a ring is attached.
+    TickTelemetryRecord* const rec = (telemetry_ != nullptr) ? &telemetry_record_ : nullptr;
+    if (rec != nullptr)
+    {
+        *rec = TickTelemetryRecord{};
+        rec->tick = ++telemetry_ticks_;
+        rec->t0 = t0;
+    }
+    const TickTelemetryPush telemetry_push(telemetry_, telemetry_record_);
+
+    if (grid.tau.empty())
+    {
+        telemetry_record_.outcome = TickOutcome::kEmptyGrid;
+        return; // fail-fast: no publish
+    }
+
+    // The tick budget counts from here (provider queries included).
+    const auto tick_start = std::chrono::steady_clock::now();
+    TickStageScope trace_tick(rec, TraceStage::kTick);
+
+    // Per-tick context: the chief is queried once and shared with the frame and later stages.
+    tick_.valid = false;
+    tick_.t0 = t0;
+
+    // Query chief (exact-time semantics enforced by provider).
+    TickStageScope trace_chief(rec, TraceStage::kChief);
+    tick_.chief = chief_.get(t0);
+    trace_chief.end();
+    const ChiefState& chief = tick_.chief;
+    telemetry_record_.chief_status = chief.status.code;
+    if (!chief.status.ok() || chief.frame_id == nullptr)
+    {
+        telemetry_record_.outcome = TickOutcome::kChiefError;
+        return; // fail-fast: no publish
+    }
+
+    // Update bullseye frame snapshot at t0 from the same chief state.
+    TickStageScope trace_frame(rec, TraceStage::kFrame);
+    tick_.frame = bullseye_.update(t0, chief);
+    trace_frame.end();
+    const BullseyeFrameSnapshot& frame = tick_.frame;
+    telemetry_record_.frame_status = frame.status.code;
+    telemetry_record_.used_adopted = frame.used_adopted ? 1u : 0u;
+    telemetry_record_.degraded = static_cast<std::uint32_t>(frame.degraded);
+    if (!frame.status.ok())
+    {
+        telemetry_record_.outcome = TickOutcome::kFrameError;
+        return; // fail-fast: no publish
+    }
+
+    // Source transitions (FR-9): the published frame may be a blend of the previous source and
+    // this one; rows are corrected to it after the model pass (see below).
+    const SourceTransitionTick& transition = transition_.update(t0, chief, frame);
+    if (transition.degraded)
+    {
+        tick_.frame.degraded |= contracts::Adopted::DegradeReason::kSourceTransition;
+        telemetry_record_.degraded = static_cast<std::uint32_t>(frame.degraded);
+    }
+    telemetry_record_.source_switched = transition.switched ? 1u : 0u;
+    telemetry_record_.transition_blend = transition.blend;
+
+    if (!detail::compute_mean_motion(chief, frame, tick_.n_radps))
+    {
+        telemetry_record_.outcome = TickOutcome::kMeanMotionError;
+        return; // fail-fast: no publish
+    }
+    const double n_radps = tick_.n_radps;
+
+    // Build transform pieces.
+    tick_.C_r2i = frame.C_from_ric_to_inertial;
+    tick_.C_i2r = transpose(tick_.C_r2i);
+    tick_.valid = true;
+    const Mat3& C_i2r = tick_.C_i2r;
+
+    // Per-tick model preparation (STM cache refresh, chief ephemeris, ...).
+    TickStageScope trace_setup(rec, TraceStage::kModelSetup);
+    policy_grid_ = &grid;
+    if (!policy_.begin_tick(chief, n_radps, grid))
+    {
+        telemetry_record_.outcome = TickOutcome::kModelSetupError;
+        return; // fail-fast: no publish
+    }
+    trace_setup.end();
+
+    // Write output.
+    auto& buf = pub_.begin_write();
+
+    const std::size_t steps = std::min<std::size_t>(grid.tau.size(), MAX_STEPS);
+    const std::size_t nveh = std::min<std::size_t>(map_.slot_count(), MAX_VEHICLES);
+
+    // Velocities are published only when the publisher carries a velocity plane.
+    TrajectoryPlane* const vel = buf.velocities;
+
+    // Sliding-window reuse: the previous snapshot (ours, same grid) shifted by `shift` samples.
+    constexpr bool kTail = has_predict_tail<ModelPolicy>::value;
+    const PredictionBuffer& prev = pub_.read();
+    std::size_t shift = 0;
+    const double tau_last = grid.tau[steps - 1];
+    if (kTail && reuse_.enabled && reuse_.full_refresh_ticks > 1 && last_.valid &&
+        !transition.moved && cadence_sec > 0.0 && prev.seqno == last_.seqno &&
+        tau_last == last_.tau_last && cadence_sec == last_.cadence_sec && steps == last_.steps)
+    {
+        const double elapsed = t0 - last_.t0;
+        const double m = std::round(elapsed / cadence_sec);
+        if (m >= 1.0 && m < static_cast<double>(steps) &&
+            std::fabs(elapsed - m * cadence_sec) <= 1.0e-9 * cadence_sec)
+        {
+            shift = static_cast<std::size_t>(m);
+        }
+    }
+    TrajectoryReuseStats stats{};
+
+    // A budgeted tick may defer rows only if the previous snapshot (ours) is on the same grid.
+    const bool budgeted = budget_.enabled && last_.valid && !transition.moved &&
+                          prev.seqno == last_.seqno && steps == last_.steps &&
+                          tau_last == last_.tau_last &&
+                          cadence_sec == last_.cadence_sec && !profiles_changed_;
+    deferred_rows_ = 0;
+    budget_new_rows_ = 0;
+
+    // Change detection compares against the previous snapshot, so it needs it on this grid.
+    const bool detect = reuse_.skip_unchanged && reuse_.full_refresh_ticks > 1 && last_.valid &&
+                        !transition.moved && prev.seqno == last_.seqno && steps == last_.steps &&
+                        tau_last == last_.tau_last && cadence_sec == last_.cadence_sec &&
+                        !profiles_changed_;
+    unchanged_rows_ = 0;
+    if (!budgeted)
+    {
+        row_deferred_ticks_.fill(0);
+    }
+
+    constexpr bool kBlock = has_predict_block<ModelPolicy>::value;
+    bool parallel = false;
+    if constexpr (has_concurrent_rows<ModelPolicy>::value)
+    {
+        parallel = !budgeted && pool_ != nullptr && pool_->workers() > 0 &&
+                   policy_.concurrent_rows();
+    }
+    if (kBlock || parallel || budgeted)
+    {
+        constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+        const RelStateRic inactive{Vec3{kNaN, kNaN, kNaN}, Vec3{kNaN, kNaN, kNaN}};
+        x0_block_.fill(inactive);
+        active_block_.fill(false);
+    }
+
+    // Deputy states for every occupied row in one provider call (row order).
+    TickStageScope trace_deputies(rec, TraceStage::kDeputies);
+    std::size_t nreq = 0;
+    for (std::size_t i = 0; i < nveh; ++i)
+    {
+        if (const auto vid = map_.id_at(i))
+        {
+            req_ids_[nreq++] = *vid;
+        }
+    }
+    (void)veh_.get_many(Span<const VehicleIndexMap::VehicleId>{req_ids_.data(), nreq}, t0,
+                        Span<VehicleState>{dep_states_.data(), nreq}, Span<Vec3>{},
+                        Span<Vec3>{});
+
+    // Initial relative states in RIC (Option B) for all of them in one batch transform; rows
+    // whose state turns out unusable below simply ignore their entry. The planes are gathered
+    // here rather than requested from get_many(), whose overrides may leave them unfilled.
+    for (std::size_t k = 0; k < nreq; ++k)
+    {
+        dep_r_i_[k] = dep_states_[k].r_i;
+        dep_v_i_[k] = dep_states_[k].v_i;
+    }
+    inertial_to_ric_relative_batch(Span<const Vec3>{dep_r_i_.data(), nreq},
+                                   Span<const Vec3>{dep_v_i_.data(), nreq}, chief.r_i, chief.v_i,
+                                   C_i2r, frame.omega_ric,
+                                   Span<RelStateRic>{dep_x0_.data(), nreq});
+
+    // Blended tick: correct the rows after the model pass if the correction stays within its
+    // bound over the rows' reach; otherwise predict in the published frame directly.
+    bool correct = false;
+    if (transition.blending)
+    {
+        double reach = 0.0;
+        for (std::size_t k = 0; k < nreq; ++k)
+        {
+            reach = std::fmax(reach, norm(dep_x0_[k].r_ric) +
+                                         norm(dep_x0_[k].v_ric) * std::fabs(tau_last));
+        }
+        const double n_tau = n_radps * std::fabs(tau_last);
+        correct = coeff_mode_ == CoefficientOutput::kOff && dispersion_.samples == 0 &&
+                  frame_correction_error_bound(transition.correction, reach, n_tau) <=
+                      transition_.config().max_correction_error_m;
+        if (!correct)
+        {
+            tick_.C_r2i = transition.C_from_ric_to_inertial;
+            tick_.C_i2r = transpose(tick_.C_r2i);
+            inertial_to_ric_relative_batch(Span<const Vec3>{dep_r_i_.data(), nreq},
+                                           Span<const Vec3>{dep_v_i_.data(), nreq}, chief.r_i,
+                                           chief.v_i, C_i2r, frame.omega_ric,
+                                           Span<RelStateRic>{dep_x0_.data(), nreq});
+        }
+        tick_.frame.C_from_ric_to_inertial = transition.C_from_ric_to_inertial;
+        tick_.frame.origin_i = transition.origin_i;
+        telemetry_record_.transition_path = correct ? 1u : 2u;
+    }
+    trace_deputies.end();
+    TickStageScope trace_model(rec, TraceStage::kModel);
+    std::size_t next_req = 0;
+    RowMask profile_rows = 0;
+    RowMask coeff_only = 0;
+
+    for (std::size_t i = 0; i < nveh; ++i)
+    {
+        const bool had_row = row_ok_[i];
+        row_ok_[i] = false;
+        row_reused_[i] = false;
+        buf.row_status[i] = RowStatus::kEmpty;
+        buf.row_grid[i] = grid_profile_(i);
+        const bool same_grid = (prev.row_grid[i] == buf.row_grid[i]);
+
+        const auto vid = map_.id_at(i);
+        if (!vid.has_value())
+            continue;
+        const std::size_t req = next_req++;
+        const VehicleState& dep = dep_states_[req];
+        if (rec != nullptr)
+        {
+            rec->row_provider[i] = dep.status.code;
+        }
+        if (!dep.status.ok() || dep.frame_id == nullptr)
+        {
+            buf.row_status[i] = RowStatus::kProviderError;
+            continue; // skip vehicle; still can publish others deterministically
+        }
+
+        // Require same inertial frame as chief for v1.
+        // (If you later support cross-frame inputs, this becomes a conversion hook.)
+        // Interned handles make this one integer compare; names are compared only for states
+        // from providers that do not intern.
+        if (!same_frame(dep.frame, dep.frame_id, chief.frame, chief.frame_id))
+        {
+            buf.row_status[i] = RowStatus::kFrameMismatch;
+            continue;
+        }
+
+        const RelStateRic& x0 = dep_x0_[req];
+        row_x0_[i] = x0;
+
+        if constexpr (has_row_coefficients<ModelPolicy>::value)
+        {
+            // Coefficient-only rows skip the dense pass (and reuse, budget and profile passes).
+            if (coeff_mode_ == CoefficientOutput::kOnly &&
+                policy_.row_coefficients(i, x0, false, buf.coefficients[i]))
+            {
+                row_id_[i] = *vid;
+                row_reuse_count_[i] = 0;
+                row_ok_[i] = true;
+                buf.row_status[i] = RowStatus::kOk;
+                coeff_only |= RowMask{1} << i;
+                continue;
+            }
+        }
+
+        if (buf.row_grid[i] != 0u)
+        {
+            // Predicted on its own grid after this pass (predict_profiles_()).
+            row_id_[i] = *vid;
+            row_reuse_count_[i] = 0;
+            ++stats.rows_full;
+            profile_x0_[i] = x0;
+            profile_rows |= RowMask{1} << i;
+            continue;
+        }
+
+        const Span<Vec3> out_r{buf.positions[i].data(), steps};
+        const Span<Vec3> out_v =
+            (vel != nullptr) ? Span<Vec3>{(*vel)[i].data(), steps} : Span<Vec3>{nullptr, 0};
+
+        if (detect && same_grid && row_id_[i] == *vid &&
+            row_reuse_count_[i] + 1 < reuse_.full_refresh_ticks)
+        {
+            // Unchanged: the row keeps its published trajectory (same status, so it is clean
+            // and the publisher carries it over with its epoch).
+            const auto burns = pending_burns_(i, tau_last);
+            const RowMask bit = RowMask{1} << i;
+            if (burns.first == burns.second &&
+                ((prev.coeff_only_rows | prev.maneuver_rows | prev.control_unmodeled_rows) &
+                 bit) == 0u &&
+                matches_published_(i, x0, prev, steps))
+            {
+                buf.row_status[i] = prev.row_status[i];
+                unchanged_rows_ |= bit;
+                ++row_reuse_count_[i];
+                ++stats.rows_unchanged;
+                continue;
+            }
+        }
+
+        if constexpr (kTail)
+        {
+            // The tail comes from x0 alone, so rows with burns ahead are predicted in full.
+            const auto burns = pending_burns_(i, tau_last);
+            if (shift > 0 && had_row && same_grid && row_id_[i] == *vid &&
+                burns.first == burns.second && ((prev.coeff_only_rows >> i) & 1u) == 0u &&
+                row_reuse_count_[i] + 1 < reuse_.full_refresh_ticks &&
+                norm(x0.r_ric - prev.positions[i][shift]) <= reuse_.pos_tol_m &&
+                (vel == nullptr || prev.velocities == nullptr ||
+                 norm(x0.v_ric - (*prev.velocities)[i][shift]) <= reuse_.vel_tol_mps))
+            {
+                // Shift the previous trajectory; evaluate only the new tail.
+                const std::size_t head = steps - shift;
+                std::copy_n(prev.positions[i].data() + shift, head, buf.positions[i].data());
+                if (vel != nullptr && prev.velocities != nullptr)
+                {
+                    std::copy_n((*prev.velocities)[i].data() + shift, head, (*vel)[i].data());
+                }
+                if (policy_.predict_tail(i, x0, head, out_r, out_v))
+                {
+                    row_ok_[i] = true;
+                    row_reused_[i] = true;
+                    buf.row_status[i] = RowStatus::kReused;
+                    ++row_reuse_count_[i];
+                    ++stats.rows_reused;
+                    continue;
+                }
+            }
+        }
+
+        if (budgeted && (row_id_[i] != *vid || !same_grid))
+        {
+            budget_new_rows_ |= RowMask{1} << i; // previous row data is not this row's
+        }
+        row_id_[i] = *vid;
+        row_reuse_count_[i] = 0;
+        ++stats.rows_full;
+
+        if (kBlock || parallel || budgeted)
+        {
+            x0_block_[i] = x0;
+            active_block_[i] = true; // outcome reported into row_ok_ after the loop
+        }
+        else
+        {
+            // Predict into buf.positions[i][k] (and velocities[i][k] when attached).
+            // PredictionBuffer has fixed storage; use a Span over the first `steps` elements.
+            // On failure the row is left as-is (deterministic skip).
+            StageTrace trace_row(TraceStage::kVehicle, static_cast<std::uint32_t>(i));
+            row_ok_[i] = policy_.predict(x0, out_r, out_v);
+            trace_row.end();
+            buf.row_status[i] = row_ok_[i] ? RowStatus::kOk : RowStatus::kModelError;
+        }
+    }
+
+    TickBudgetStats budget_stats{};
+    if (budgeted)
+    {
+        // Deferred rows leave active_block_ and keep their previous status (published clean).
+        budget_stats = predict_budgeted_(nveh, steps, buf, prev, tick_start);
+        stats.rows_full -= budget_stats.rows_deferred;
+    }
+    else if (parallel)
+    {
+        // Returns once every row range is done; nothing is published before that.
+        predict_parallel_(nveh, steps, buf);
+    }
+    else if constexpr (kBlock)
+    {
+        // Whole tick in one call; rows are PredictionBuffer::positions[i] / velocities[i].
+        const Span2D<Vec3> out_v = (vel != nullptr)
+                                       ? Span2D<Vec3>{(*vel)[0].data(), nveh, steps, MAX_STEPS}
+                                       : Span2D<Vec3>{};
+        policy_.predict_block(Span<const RelStateRic>{x0_block_.data(), nveh},
+                              Span<const bool>{active_block_.data(), nveh},
+                              Span2D<Vec3>{buf.positions[0].data(), nveh, steps, MAX_STEPS},
+                              out_v, Span<bool>{row_ok_.data(), nveh});
+    }
+    if (kBlock || parallel || budgeted)
+    {
+        for (std::size_t i = 0; i < nveh; ++i)
+        {
+            if (active_block_[i])
+            {
+                buf.row_status[i] = row_ok_[i] ? RowStatus::kOk : RowStatus::kModelError;
+            }
+        }
+    }
+
+    // Rows on other grid profiles: one model pass per profile, on that profile's grid.
+    RowMask modelled = profile_rows | coeff_only;
+    for (std::size_t i = 0; i < nveh; ++i)
+    {
+        if (active_block_[i] || row_reused_[i])
+        {
+            modelled |= RowMask{1} << i;
+        }
+    }
+    predict_profiles_(profile_rows, nveh, parallel, buf);
+
+    // Planned burns superposed on the coasting rows through the prepared STM, then the
+    // closed-form description of every row that has one.
+    buf.coeff_only_rows = coeff_only;
+    apply_maneuvers_(grid, steps, nveh, buf);
+    fill_coefficients_(grid, steps, nveh, buf);
+
+    // Blended tick: one correction pass re-expresses the rows in the published frame, which
+    // the later stages (inertial plane, covariance) then use.
+    if (correct)
+    {
+        for (std::size_t i = 0; i < nveh; ++i)
+        {
+            if (!row_ok_[i] || ((coeff_only >> i) & 1u) != 0u)
+            {
+                continue;
+            }
+            const std::size_t n = (buf.row_grid[i] == 0u) ? steps : buf.row_steps(i);
+            apply_frame_correction(
+                transition.correction, Span<Vec3>{buf.positions[i].data(), n},
+                (vel != nullptr) ? Span<Vec3>{(*vel)[i].data(), n} : Span<Vec3>{});
+        }
+        tick_.C_r2i = transition.C_from_ric_to_inertial;
+        tick_.C_i2r = transpose(tick_.C_r2i);
+    }
+    trace_model.end();
+
+    // Inertial plane: one chief ephemeris per grid in use, then one batched transform per row.
+    if (buf.positions_i != nullptr)
+    {
+        TickStageScope trace_inertial(rec, TraceStage::kInertial);
+        for (std::size_t p = 0; p < MAX_GRID_PROFILES; ++p)
+        {
+            const TimeGrid* const g = (p == 0) ? &grid : profile_grid_[p];
+            const std::size_t n = (p == 0) ? steps : buf.profile_steps[p - 1];
+            bool filled = false;
+            for (std::size_t i = 0; i < nveh && g != nullptr; ++i)
+            {
+                if (!row_ok_[i] || buf.row_grid[i] != p || ((coeff_only >> i) & 1u) != 0u)
+                {
+                    continue;
+                }
+                if (!filled)
+                {
+                    fill_inertial_ephemeris_(*g, n);
+                    filled = true;
+                }
+                ric_to_inertial_positions_series(
+                    Span<const Vec3>{buf.positions[i].data(), n},
+                    Span<const Vec3>{inertial_chief_r_.data(), n},
+                    Span<const Mat3>{inertial_C_.data(), n},
+                    Span<Vec3>{(*buf.positions_i)[i].data(), n});
+            }
+        }
+    }
+
+    // Position covariance: one unit-state basis per grid in use, then one kernel pass per row.
+    if (buf.position_cov != nullptr)
+    {
+        TickStageScope trace_covariance(rec, TraceStage::kCovariance);
+        predict_covariance_(grid, steps, nveh, buf);
+    }
+
+    // Monte Carlo dispersion around each row's initial state on the same tick context.
+    dispersion_stats_ = DispersionStats{};
+    if (dispersion_.samples > 0)
+    {
+        TickStageScope trace_dispersion(rec, TraceStage::kDispersion);
+        disperse_(grid, steps, nveh, buf);
+    }
+
+    // Closest-approach summaries of the rows written this tick (carried rows keep theirs).
+    TickStageScope trace_approach(rec, TraceStage::kApproach);
+    const std::size_t spheres = std::min(approach_.keep_out_count, MAX_KEEP_OUT_SPHERES);
+    buf.keep_out_count = approach_.enabled ? spheres : 0;
+    buf.keep_out_radius_m = approach_.keep_out_radius_m;
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        if (!approach_.enabled || i >= nveh || !row_ok_[i] || ((coeff_only >> i) & 1u) != 0u)
+        {
+            buf.approach[i] = ClosestApproach{};
+            continue;
+        }
+        const std::uint8_t p = buf.row_grid[i];
+        const Span<const double> tau = (p == 0) ? Span<const double>{grid.tau.data(), steps}
+                                                : buf.grid_tau(p);
+        buf.approach[i] = summarize_closest_approach(
+            tau, Span<const Vec3>{buf.positions[i].data(), tau.size},
+            (vel != nullptr) ? Span<const Vec3>{(*vel)[i].data(), tau.size} : Span<const Vec3>{},
+            Span<const double>{approach_.keep_out_radius_m.data(), spheres});
+    }
+    trace_approach.end();
+
+    // Row validity for readers; rows beyond the map are empty.
+    RowMask valid = 0;
+    for (std::size_t i = 0; i < nveh; ++i)
+    {
+        if (row_ok_[i])
+        {
+            valid |= RowMask{1} << i;
+        }
+    }
+    std::fill(buf.row_status.begin() + static_cast<std::ptrdiff_t>(nveh), buf.row_status.end(),
+              RowStatus::kEmpty);
+    std::fill(buf.row_grid.begin() + static_cast<std::ptrdiff_t>(nveh), buf.row_grid.end(),
+              std::uint8_t{0});
+    buf.vehicles = nveh;
+    buf.valid_rows = valid;
+    buf.deferred_rows = deferred_rows_;
+    buf.unchanged_rows = unchanged_rows_;
+
+    if constexpr (has_row_selection<ModelPolicy>::value)
+    {
+        buf.est_cost_total = 0.0;
+        for (std::size_t i = 0; i < nveh; ++i)
+        {
+            const bool predicted = !kBlock || ((modelled >> i) & 1u) != 0u;
+            buf.row_model[i] = predicted ? policy_.row_selection(i) : ModelSelection{};
+            buf.est_cost_total += buf.row_model[i].est_cost;
+        }
+    }
+
+    buf.steps = steps;
+    std::copy_n(grid.tau.data(), steps, buf.tau.data());
+
+    // Rows rewritten this tick, or whose outcome or grid changed, are dirty; the rest (e.g. a
+    // row that keeps failing) are carried over from the previous snapshot by the publisher.
+    RowMask dirty = valid;
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        if (buf.row_status[i] != prev.row_status[i] || buf.row_grid[i] != prev.row_grid[i])
+        {
+            dirty |= RowMask{1} << i;
+        }
+    }
+
+    if (dry_run_)
+    {
+        pub_.abandon_write();
+        dry_reached_publish_ = true;
+        return;
+    }
+
+    // Publish snapshot (sets seqno and t0).
+    TickStageScope trace_publish(rec, TraceStage::kPublish);
+    last_.seqno = pub_.publish(t0, dirty);
+    trace_publish.end();
+    if (rec != nullptr)
+    {
+        detail::fill_tick_telemetry(*rec, buf, nveh, dirty);
+        rec->seqno = last_.seqno;
+    }
+    last_.valid = true;
+    last_.t0 = t0;
+    last_.tau_last = tau_last;
+    last_.cadence_sec = cadence_sec;
+    last_.steps = steps;
+    profiles_changed_ = false;
+    stats_ = stats;
+    budget_stats_ = budget_stats;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,1116 @@
+// core/relative_predictor_policies.hpp
+#pragma once
+/**
+ * @file relative_predictor_policies.hpp
+ * @brief Model policies for BasicRelativePredictor (static dispatch of the per-vehicle kernel).
+ *
+ * A model policy is any type providing:
+ *
+ *   bool begin_tick(const ChiefState& chief, double n_radps, const TimeGrid& grid) noexcept;
+ *   bool predict(const RelStateRic& x0, Span<Vec3> out_r, Span<Vec3> out_v) noexcept;
+ *
+ * begin_tick() runs once per tick after the chief, frame and mean motion are known; returning
+ * false aborts the tick (no publish). predict() fills one vehicle row (out_v may be empty when
+ * velocities are not published); returning false leaves the row as-is. Both are called directly (no virtual dispatch) so the kernel inlines into the
+ * predictor's vehicle loop.
+ *
+ * A policy may additionally provide
+ *
+ *   void predict_block(Span<const RelStateRic> x0, Span<const bool> active, Span2D<Vec3> out_r,
+ *                      Span2D<Vec3> out_v, Span<bool> out_ok) noexcept;
+ *
+ * in which case the predictor gathers every vehicle's initial state first and hands the whole
+ * tick over in one call (row i of out_r / out_v is vehicle index i; out_v may be empty). Inactive
+ * rows carry NaN states and must be left as-is (out_ok untouched); active rows follow predict()
+ * semantics and report its result in out_ok[i].
+ *
+ * Provided policies:
+ * - HcwPolicy: cached HCW STM (falls back to ModelHCW when the grid does not fit the cache).
+ * - YaStmPolicy: YA/TH with the shared per-tick chief ephemeris.
+ * - SsJ2Policy: Schweighart-Sedwick J2-linearized closed form.
+ * - VirtualModelPolicy: plugin-style IRelativeModel (one virtual call per vehicle).
+ * - DynamicModelPolicy: model chosen at construction (HCW, YA/TH, SS-J2, per-vehicle
+ *   ModelSelector, or an injected model).
+ * - StmBatchPolicy: built-in model's per-tick STM basis applied by an IStmBatchBackend.
+ *
+ * A policy may also provide
+ *
+ *   ModelSelection row_selection(std::size_t row) const noexcept;
+ *
+ * to report the model used for each row; the predictor publishes it as buffer metadata, and
+ *
+ *   bool predict_tail(std::size_t row, const RelStateRic& x0, std::size_t first,
+ *                     Span<Vec3> out_r, Span<Vec3> out_v) noexcept;
+ *
+ * to fill only steps [first, steps) of a row (sliding-window reuse; see TrajectoryReuseConfig).
+ * Returning false means the tail cannot be produced cheaply; the row is then predicted in full.
+ *
+ *   bool predict_impulse(std::size_t row, const Vec3& dv_ric, double tau_burn, Span<Vec3> out_r,
+ *                        Span<Vec3> out_v) noexcept;
+ *
+ * to add the response to an impulsive burn dv_ric at grid offset tau_burn to a predicted row
+ * (planned maneuvers; see BasicRelativePredictor::set_planned_burns()). Returning false means
+ * the row's model cannot compose the burn; the row is left as predicted (coasting).
+ *
+ *   bool row_coefficients(std::size_t row, const RelStateRic& x0, bool predicted,
+ *                         TrajectoryCoefficients& out) const noexcept;
+ *
+ * to describe the row's trajectory from x0 in closed form (model id and parameters; burns are
+ * filled in by the predictor). predicted tells whether the row already went through the model
+ * this tick; returning false means the row has no closed form and is published densely only
+ * (see BasicRelativePredictor::configure_coefficients()).
+ *
+ *   bool concurrent_rows() const noexcept;
+ *
+ * returning true promises that, between begin_tick() calls, predict() (and predict_block() on
+ * disjoint row ranges) may run concurrently for different rows and give the same results as
+ * serial calls. Only such policies use the predictor's worker pool (attach_worker_pool()).
+ *
+ *   void save_checkpoint(CheckpointWriter& out) const;
+ *   std::size_t checkpoint_bytes() const noexcept;
+ *   bool restore_checkpoint(CheckpointCursor& in) noexcept;
+ *
+ * persist state the policy carries across ticks (STM tables, selector hysteresis) so a restored
+ * predictor continues bitwise identically (see checkpoint.hpp).
+ *
+ *   void set_dry_run(bool dry) noexcept;
+ *
+ * brackets a dry tick (BasicRelativePredictor::warm_up()): while set, the policy may fill its
+ * caches but must not advance cross-tick decisions (selector hysteresis), so the first live
+ * tick decides as if no dry tick had run.
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "core/checkpoint.hpp"
+#include "core/chief_state_provider.hpp"
+#include "core/constants.hpp"
+#include "core/contracts.hpp"
+#include "core/time_grid.hpp"
+#include "core/trajectory_coefficients.hpp"
+#include "core/types.hpp"
+#include "models/hcw_stm_cache.hpp"
+#include "models/model_hcw.hpp"
+#include "models/model_selector.hpp"
+#include "models/model_ss_j2.hpp"
+#include "models/model_ya_stm.hpp"
+#include "models/relative_model.hpp"
+#include "models/stm_batch_backend.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Static predictor configuration (set at construction; not changed per tick).
+ */
+struct RelativePredictorConfig final
+{
+    /** @brief Model applied to every vehicle, or kAuto for per-vehicle selection. */
+    PredictorModel model{PredictorModel::kHcw};
+
+    /** @brief HCW/YA selection thresholds, hold time and cost model (kAuto; cost always). */
+    ModelSelectorConfig selector{};
+
+    /**
+     * @brief HCW STM reuse tolerance: the cached Phi(tau) is kept while the tick's mean motion
+     *        stays within this relative distance of the cached n (0 = rebuild on any change).
+     */
+    double hcw_stm_n_rel_tol{1.0e-9};
+
+    /** @brief HCW uniform-grid trig recurrence re-anchor interval (0 = libm; HcwParams). */
+    std::uint32_t hcw_trig_reanchor_interval{0};
+
+    /** @brief Central-body gravitational parameter for YA/TH [m^3/s^2] (DM-6). */
+    double mu{contracts::Grav::kMuM3PerS2};
+
+    /** @brief YA/TH propagation backend. */
+    YaStmBackend ya_backend{YaStmBackend::kRk4Reference};
+
+    /** @brief YA/TH RK4 maximum substep / adaptive initial step [s]. */
+    double ya_max_dt_sec{0.25};
+
+    /** @brief YA/TH adaptive relative / absolute tolerances (kDormandPrince54 only). */
+    double ya_rel_tol{1.0e-10};
+    double ya_abs_tol{1.0e-9};
+
+    /** @brief Central-body J2 and equatorial radius [m] for the SS-J2 model. */
+    double j2{contracts::Grav::kJ2};
+    double r_eq_m{contracts::Grav::kREqM};
+};
+
+/**
+ * @brief HCW policy backed by the cross-tick STM cache.
+ */
+class HcwPolicy final
+{
+  public:
+    explicit HcwPolicy(const RelativePredictorConfig& config = RelativePredictorConfig{}) noexcept
+        : reanchor_(config.hcw_trig_reanchor_interval), cache_(config.hcw_stm_n_rel_tol)
+    {
+    }
+
+    bool begin_tick(const ChiefState& /*chief*/, double n_radps, const TimeGrid& grid) noexcept
+    {
+        params_.n_radps = n_radps;
+        params_.trig_reanchor_interval = reanchor_;
+        grid_ = &grid;
+        cached_ = (cache_.refresh(params_, grid) == ModelCode::kOk);
+        return true;
+    }
+
+    bool predict(const RelStateRic& x0, Span<Vec3> out_r, Span<Vec3> out_v) noexcept
+    {
+        if (cached_)
+        {
+            return cache_.predict(x0, out_r, out_v).code == ModelCode::kOk;
+        }
+        return model_.predict_hcw(x0, params_, *grid_, out_r, out_v).code == ModelCode::kOk;
+    }
+
+    /** @brief Tail from the cached STM table (no tail without a cache hit). */
+    bool predict_tail(std::size_t /*row*/,
+                      const RelStateRic& x0,
+                      std::size_t first,
+                      Span<Vec3> out_r,
+                      Span<Vec3> out_v) noexcept
+    {
+        return cached_ && cache_.predict_tail(x0, first, out_r, out_v).code == ModelCode::kOk;
+    }
+
+    /** @brief Burn composed with the cached STM table (closed form without a cache hit). */
+    bool predict_impulse(std::size_t /*row*/,
+                         const Vec3& dv_ric,
+                         double tau_burn,
+                         Span<Vec3> out_r,
+                         Span<Vec3> out_v) noexcept
+    {
+        if (cached_)
+        {
+            return cache_.accumulate_impulse(dv_ric, tau_burn, out_r, out_v).code ==
+                   ModelCode::kOk;
+        }
+        if (!(params_.n_radps > 0.0) || !std::isfinite(params_.n_radps) || !finite3(dv_ric) ||
+            !std::isfinite(tau_burn))
+        {
+            return false;
+        }
+        const double inv_n = 1.0 / params_.n_radps;
+        const std::size_t steps = std::min(grid_->tau.size(), out_r.size);
+        const bool want_vel = (out_v.data != nullptr && out_v.size >= steps);
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            const double dt = grid_->tau[k] - tau_burn;
+            if (dt < 0.0)
+            {
+                continue;
+            }
+            Vec3 r{};
+            Vec3 v{};
+            hcw_stm_apply(hcw_stm_at(params_.n_radps, inv_n, dt), Vec3{}, dv_ric, want_vel, r, v);
+            out_r.data[k] = out_r.data[k] + r;
+            if (want_vel)
+            {
+                out_v.data[k] = out_v.data[k] + v;
+            }
+        }
+        return true;
+    }
+
+    /** @brief Closed form for the mean motion the dense rows use (the cached n on a hit). */
+    bool row_coefficients(std::size_t /*row*/,
+                          const RelStateRic& x0,
+                          bool /*predicted*/,
+                          TrajectoryCoefficients& out) const noexcept
+    {
+        const double n = cached_ ? cache_.n_radps() : params_.n_radps;
+        if (!(n > 0.0) || !std::isfinite(n))
+        {
+            return false;
+        }
+        out.model = PredictorModel::kHcw;
+        out.burn_count = 0;
+        out.x0 = x0;
+        out.n_radps = n;
+        return true;
+    }
+
+    /** @brief predict() only reads the cache and the model (see concurrent_rows hook). */
+    [[nodiscard]] bool concurrent_rows() const noexcept { return true; }
+
+    /** @brief STM cache (for inspection). */
+    [[nodiscard]] const HcwStmCache& cache() const noexcept { return cache_; }
+
+    /** @brief Cross-tick state: the STM table (see has_checkpoint hook). */
+    void save_checkpoint(CheckpointWriter& out) const { cache_.save_checkpoint(out); }
+    [[nodiscard]] std::size_t checkpoint_bytes() const noexcept
+    {
+        return HcwStmCache::checkpoint_bytes();
+    }
+    bool restore_checkpoint(CheckpointCursor& in) noexcept { return cache_.restore_checkpoint(in); }
+
+  private:
+    std::uint32_t reanchor_{0};
+    HcwStmCache cache_{};
+    ModelHCW model_{};
+    HcwParams params_{};
+    const TimeGrid* grid_{nullptr};
+    bool cached_{false};
+};
+
+/**
+ * @brief YA/TH policy; the RK4 backend shares one chief ephemeris per tick across vehicles.
+ *
+ * If the stage schedule exceeds MAX_CHIEF_EPHEMERIS_SAMPLES, each vehicle propagates the chief
+ * itself (same results, higher cost).
+ */
+class YaStmPolicy final
+{
+  public:
+    explicit YaStmPolicy(const RelativePredictorConfig& config = RelativePredictorConfig{}) noexcept
+    {
+        params_.mu = config.mu;
+        params_.max_dt_sec = config.ya_max_dt_sec;
+        params_.backend = config.ya_backend;
+        params_.rel_tol = config.ya_rel_tol;
+        params_.abs_tol = config.ya_abs_tol;
+    }
+
+    bool begin_tick(const ChiefState& chief, double /*n_radps*/, const TimeGrid& grid) noexcept
+    {
+        params_.chief_r0_i = chief.r_i;
+        params_.chief_v0_i = chief.v_i;
+        grid_ = &grid;
+        have_eph_ = false;
+
+        if (params_.backend == YaStmBackend::kRk4Reference)
+        {
+            const auto eph = model_.build_chief_ephemeris(
+                params_, grid, Span<YaChiefSample>{eph_storage_.data(), eph_storage_.size()},
+                eph_);
+            if (eph.code == ModelCode::kInvalidInput)
+            {
+                return false; // chief cannot be propagated over the grid
+            }
+            // kInsufficientOutputCapacity: deputies propagate the chief themselves.
+            have_eph_ = (eph.code == ModelCode::kOk);
+        }
+        return true;
+    }
+
+    bool predict(const RelStateRic& x0, Span<Vec3> out_r, Span<Vec3> out_v) noexcept
+    {
+        if (have_eph_)
+        {
+            return model_.predict_ya_stm(x0, params_, *grid_, eph_, out_r, out_v).code ==
+                   ModelCode::kOk;
+        }
+        return model_.predict_ya_stm(x0, params_, *grid_, out_r, out_v).code == ModelCode::kOk;
+    }
+
+    /** @brief All vehicles in lockstep (one chief evaluation per RK4 stage per block). */
+    void predict_block(Span<const RelStateRic> x0,
+                       Span<const bool> active,
+                       Span2D<Vec3> out_r,
+                       Span2D<Vec3> out_v,
+                       Span<bool> out_ok) noexcept
+    {
+        // Inactive rows are NaN, which the batch skips without writing. Row outcomes stay on
+        // the stack so disjoint row ranges can run concurrently.
+        const std::size_t rows = std::min<std::size_t>(x0.size, MAX_VEHICLES);
+        std::array<ModelCode, MAX_VEHICLES> row_codes{};
+        const Span<ModelCode> codes{row_codes.data(), rows};
+        const ModelCode batch =
+            have_eph_
+                ? model_.predict_ya_stm_batch(x0, params_, *grid_, eph_, out_r, out_v, codes).code
+                : model_.predict_ya_stm_batch(x0, params_, *grid_, out_r, out_v, codes).code;
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            if (active[i])
+            {
+                out_ok[i] = (batch == ModelCode::kOk) && (row_codes[i] == ModelCode::kOk);
+            }
+        }
+    }
+
+    /** @brief Rows only read the per-tick ephemeris (see concurrent_rows hook). */
+    [[nodiscard]] bool concurrent_rows() const noexcept { return true; }
+
+  private:
+    ModelYA_STM model_{};
+    YaStmParams params_{};
+    const TimeGrid* grid_{nullptr};
+    YaChiefEphemeris eph_{};
+    bool have_eph_{false};
+
+    // Per-tick chief ephemeris storage (preallocated; rebuilt every tick).
+    std::array<YaChiefSample, MAX_CHIEF_EPHEMERIS_SAMPLES> eph_storage_{};
+};
+
+/**
+ * @brief Schweighart-Sedwick policy: reference orbit (radius, inclination) from the tick's chief,
+ *        mean motion from the predictor; the STM is evaluated once per grid point per block.
+ */
+class SsJ2Policy final
+{
+  public:
+    explicit SsJ2Policy(const RelativePredictorConfig& config = RelativePredictorConfig{}) noexcept
+    {
+        params_.j2 = config.j2;
+        params_.r_eq_m = config.r_eq_m;
+    }
+
+    bool begin_tick(const ChiefState& chief, double n_radps, const TimeGrid& grid) noexcept
+    {
+        grid_ = &grid;
+        return ss_j2_params_from_chief(chief.r_i, chief.v_i, n_radps, params_) &&
+               ss_j2_rates(params_, rates_);
+    }
+
+    bool predict(const RelStateRic& x0, Span<Vec3> out_r, Span<Vec3> out_v) noexcept
+    {
+        return model_.predict_ss(x0, params_, *grid_, out_r, out_v).code == ModelCode::kOk;
+    }
+
+    /** @brief All rows through one STM evaluation per grid point. */
+    void predict_block(Span<const RelStateRic> x0,
+                       Span<const bool> active,
+                       Span2D<Vec3> out_r,
+                       Span2D<Vec3> out_v,
+                       Span<bool> out_ok) noexcept
+    {
+        const std::size_t rows = std::min<std::size_t>(x0.size, MAX_VEHICLES);
+        std::array<ModelCode, MAX_VEHICLES> row_codes{};
+        const ModelCode batch =
+            model_
+                .predict_ss_batch(x0, params_, *grid_, out_r, out_v,
+                                  Span<ModelCode>{row_codes.data(), rows})
+                .code;
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            if (active[i])
+            {
+                out_ok[i] = (batch == ModelCode::kOk) && (row_codes[i] == ModelCode::kOk);
+            }
+        }
+    }
+
+    /** @brief Burn through the closed-form STM over tau_k - tau_burn (time-invariant model). */
+    bool predict_impulse(std::size_t /*row*/,
+                         const Vec3& dv_ric,
+                         double tau_burn,
+                         Span<Vec3> out_r,
+                         Span<Vec3> out_v) noexcept
+    {
+        if (!finite3(dv_ric) || !std::isfinite(tau_burn))
+        {
+            return false;
+        }
+        const RelStateRic kick{Vec3{}, dv_ric};
+        const std::size_t steps = std::min(grid_->tau.size(), out_r.size);
+        const bool want_vel = (out_v.data != nullptr && out_v.size >= steps);
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            const double dt = grid_->tau[k] - tau_burn;
+            if (dt < 0.0)
+            {
+                continue;
+            }
+            Vec3 r{};
+            Vec3 v{};
+            ss_j2_stm_apply(ss_j2_stm_at(rates_, dt), kick, want_vel, r, v);
+            out_r.data[k] = out_r.data[k] + r;
+            if (want_vel)
+            {
+                out_v.data[k] = out_v.data[k] + v;
+            }
+        }
+        return true;
+    }
+
+    /** @brief Closed form for the tick's SS rates. */
+    bool row_coefficients(std::size_t /*row*/,
+                          const RelStateRic& x0,
+                          bool /*predicted*/,
+                          TrajectoryCoefficients& out) const noexcept
+    {
+        if (!(rates_.w > 0.0) || !(rates_.q > 0.0))
+        {
+            return false;
+        }
+        out.model = PredictorModel::kSsJ2;
+        out.burn_count = 0;
+        out.x0 = x0;
+        out.n_radps = params_.n_radps;
+        out.rates = rates_;
+        return true;
+    }
+
+    /** @brief Rows only read the per-tick parameters (see concurrent_rows hook). */
+    [[nodiscard]] bool concurrent_rows() const noexcept { return true; }
+
+    /** @brief Parameters of the current tick (for inspection). */
+    [[nodiscard]] const SsJ2Params& params() const noexcept { return params_; }
+
+  private:
+    ModelSS_J2 model_{};
+    SsJ2Params params_{};
+    SsJ2Rates rates_{};
+    const TimeGrid* grid_{nullptr};
+};
+
+/**
+ * @brief Plugin-style policy: calls IRelativeModel::predict_hcw() through the vtable.
+ */
+class VirtualModelPolicy final
+{
+  public:
+    explicit VirtualModelPolicy(const IRelativeModel& model) noexcept : model_(&model) {}
+
+    bool begin_tick(const ChiefState& /*chief*/, double n_radps, const TimeGrid& grid) noexcept
+    {
+        params_.n_radps = n_radps;
+        grid_ = &grid;
+        return true;
+    }
+
+    bool predict(const RelStateRic& x0, Span<Vec3> out_r, Span<Vec3> out_v) noexcept
+    {
+        return model_->predict_hcw(x0, params_, *grid_, out_r, out_v).code == ModelCode::kOk;
+    }
+
+  private:
+    const IRelativeModel* model_{nullptr};
+    HcwParams params_{};
+    const TimeGrid* grid_{nullptr};
+};
+
+/**
+ * @brief Policy selected at construction: built-in HCW / YA/TH / SS-J2 (from config),
+ *        per-vehicle selection between them (PredictorModel::kAuto), or an injected
+ *        IRelativeModel. One predictable branch per vehicle; no virtual call for built-ins.
+ *
+ * kAuto keeps one ModelSelector per vehicle index. Vehicles inside the HCW validity region run
+ * the selector's circular model (HCW or SS-J2); the rest run YA/TH in one lockstep block. The
+ * YA and SS per-tick preparations run only on ticks where at least one vehicle needs them; if
+ * one fails, its rows are skipped.
+ */
+class DynamicModelPolicy final
+{
+  public:
+    explicit DynamicModelPolicy(
+        const RelativePredictorConfig& config = RelativePredictorConfig{}) noexcept
+        : model_(config.model), mu_(config.mu), hcw_(config), ya_(config), ss_(config)
+    {
+        // A loop rather than fill(): GCC 12 reports a bogus -Wstringop-overflow for fill().
+        for (ModelSelector& s : selectors_)
+        {
+            s = ModelSelector{config.selector};
+        }
+    }
+
+    /**
+     * @param injected Model used for every vehicle (must outlive the predictor).
+     * @param config Remaining configuration (model field ignored).
+     */
+    explicit DynamicModelPolicy(
+        const IRelativeModel& injected,
+        const RelativePredictorConfig& config = RelativePredictorConfig{}) noexcept
+        : model_(config.model), mu_(config.mu), hcw_(config), ya_(config), ss_(config),
+          injected_(VirtualModelPolicy{injected})
+    {
+        for (ModelSelector& s : selectors_)
+        {
+            s = ModelSelector{config.selector};
+        }
+    }
+
+    bool begin_tick(const ChiefState& chief, double n_radps, const TimeGrid& grid) noexcept
+    {
+        steps_ = grid.tau.size();
+        if (injected_.has_value())
+        {
+            return injected_->begin_tick(chief, n_radps, grid);
+        }
+        if (model_ == PredictorModel::kYaStm)
+        {
+            return ya_.begin_tick(chief, n_radps, grid);
+        }
+        if (model_ == PredictorModel::kSsJ2)
+        {
+            return ss_.begin_tick(chief, n_radps, grid);
+        }
+        if (model_ == PredictorModel::kAuto)
+        {
+            chief_ = chief;
+            n_radps_ = n_radps;
+            grid_ = &grid;
+            ya_state_ = PrepState::kPending;
+            ss_state_ = PrepState::kPending;
+            chief_e_ = chief_eccentricity(chief.r_i, chief.v_i, mu_);
+            horizon_sec_ = grid.tau.empty() ? 0.0 : grid.tau[grid.tau.size() - 1];
+        }
+        return hcw_.begin_tick(chief, n_radps, grid);
+    }
+
+    /** @brief One row. kAuto has no per-vehicle context here and uses YA/TH. */
+    bool predict(const RelStateRic& x0, Span<Vec3> out_r, Span<Vec3> out_v) noexcept
+    {
+        if (injected_.has_value())
+        {
+            return injected_->predict(x0, out_r, out_v);
+        }
+        if (model_ == PredictorModel::kYaStm)
+        {
+            return ya_.predict(x0, out_r, out_v);
+        }
+        if (model_ == PredictorModel::kSsJ2)
+        {
+            return ss_.predict(x0, out_r, out_v);
+        }
+        if (model_ == PredictorModel::kAuto)
+        {
+            return ensure_ya() && ya_.predict(x0, out_r, out_v);
+        }
+        return hcw_.predict(x0, out_r, out_v);
+    }
+
+    void predict_block(Span<const RelStateRic> x0,
+                       Span<const bool> active,
+                       Span2D<Vec3> out_r,
+                       Span2D<Vec3> out_v,
+                       Span<bool> out_ok) noexcept
+    {
+        if (!injected_.has_value() && model_ == PredictorModel::kYaStm)
+        {
+            ya_.predict_block(x0, active, out_r, out_v, out_ok);
+            return;
+        }
+        if (!injected_.has_value() && model_ == PredictorModel::kSsJ2)
+        {
+            ss_.predict_block(x0, active, out_r, out_v, out_ok);
+            return;
+        }
+        if (!injected_.has_value() && model_ == PredictorModel::kAuto)
+        {
+            predict_block_auto(x0, active, out_r, out_v, out_ok);
+            return;
+        }
+        const bool want_v = (out_v.data != nullptr);
+        for (std::size_t i = 0; i < x0.size; ++i)
+        {
+            if (active[i])
+            {
+                out_ok[i] = predict(x0[i], out_r.row(i),
+                                    want_v ? out_v.row(i) : Span<Vec3>{nullptr, 0});
+            }
+        }
+    }
+
+    /** @brief HCW rows only (fixed HCW, or kAuto rows currently on HCW). */
+    bool predict_tail(std::size_t row,
+                      const RelStateRic& x0,
+                      std::size_t first,
+                      Span<Vec3> out_r,
+                      Span<Vec3> out_v) noexcept
+    {
+        if (injected_.has_value())
+        {
+            return false;
+        }
+        const bool hcw_row =
+            (model_ == PredictorModel::kHcw) ||
+            (model_ == PredictorModel::kAuto && row < MAX_VEHICLES &&
+             selections_[row].model == PredictorModel::kHcw);
+        return hcw_row && hcw_.predict_tail(row, x0, first, out_r, out_v);
+    }
+
+    /**
+     * @brief Burns on HCW and SS-J2 rows (fixed, or the kAuto row's current model). YA/TH is
+     *        time varying and injected models are opaque, so their rows report false.
+     */
+    bool predict_impulse(std::size_t row,
+                         const Vec3& dv_ric,
+                         double tau_burn,
+                         Span<Vec3> out_r,
+                         Span<Vec3> out_v) noexcept
+    {
+        if (injected_.has_value())
+        {
+            return false;
+        }
+        PredictorModel model = model_;
+        if (model_ == PredictorModel::kAuto)
+        {
+            model = (row < MAX_VEHICLES) ? selections_[row].model : PredictorModel::kYaStm;
+        }
+        if (model == PredictorModel::kHcw)
+        {
+            return hcw_.predict_impulse(row, dv_ric, tau_burn, out_r, out_v);
+        }
+        if (model == PredictorModel::kSsJ2)
+        {
+            return (model_ != PredictorModel::kAuto || ensure_ss()) &&
+                   ss_.predict_impulse(row, dv_ric, tau_burn, out_r, out_v);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Closed forms for HCW and SS-J2 rows. kAuto rows have one only once predicted this
+     *        tick (the selector decides the model); YA/TH and injected models have none.
+     */
+    bool row_coefficients(std::size_t row,
+                          const RelStateRic& x0,
+                          bool predicted,
+                          TrajectoryCoefficients& out) const noexcept
+    {
+        if (injected_.has_value())
+        {
+            return false;
+        }
+        PredictorModel model = model_;
+        if (model_ == PredictorModel::kAuto)
+        {
+            if (!predicted || row >= MAX_VEHICLES)
+            {
+                return false;
+            }
+            model = selections_[row].model;
+            if (model == PredictorModel::kSsJ2 && ss_state_ != PrepState::kReady)
+            {
+                return false;
+            }
+        }
+        if (model == PredictorModel::kHcw)
+        {
+            return hcw_.row_coefficients(row, x0, predicted, out);
+        }
+        if (model == PredictorModel::kSsJ2)
+        {
+            return ss_.row_coefficients(row, x0, predicted, out);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Fixed HCW, YA/TH or SS-J2 rows are independent. kAuto (per-row selector updates
+     *        and the lazy YA/SS preparation) and injected models (unknown internal state) stay
+     *        serial.
+     */
+    [[nodiscard]] bool concurrent_rows() const noexcept
+    {
+        return !injected_.has_value() && model_ != PredictorModel::kAuto;
+    }
+
+    /** @brief Model used for @p row on the last tick, with its cause and estimated cost. */
+    [[nodiscard]] ModelSelection row_selection(std::size_t row) const noexcept
+    {
+        if (!injected_.has_value() && model_ == PredictorModel::kAuto && row < MAX_VEHICLES)
+        {
+            return selections_[row];
+        }
+        ModelSelection sel{};
+        sel.model = (!injected_.has_value() && (model_ == PredictorModel::kYaStm ||
+                                                model_ == PredictorModel::kSsJ2))
+                        ? model_
+                        : PredictorModel::kHcw;
+        sel.cause = ModelSelectCause::kFixed;
+        sel.est_cost = selectors_[0].estimated_cost(sel.model, steps_);
+        return sel;
+    }
+
+    /** @brief Cross-tick state: the HCW STM table and the kAuto selectors (has_checkpoint). */
+    void save_checkpoint(CheckpointWriter& out) const
+    {
+        hcw_.save_checkpoint(out);
+        out.append_array(selectors_.data(), selectors_.size());
+        out.append_array(selections_.data(), selections_.size());
+    }
+    [[nodiscard]] std::size_t checkpoint_bytes() const noexcept
+    {
+        return hcw_.checkpoint_bytes() + sizeof(selectors_) + sizeof(selections_);
+    }
+    bool restore_checkpoint(CheckpointCursor& in) noexcept
+    {
+        return in.remaining() >= checkpoint_bytes() && hcw_.restore_checkpoint(in) &&
+               in.read_array(selectors_.data(), selectors_.size()) &&
+               in.read_array(selections_.data(), selections_.size());
+    }
+
+    /** @brief Dry tick bracket (has_dry_run): selectors not advanced, selections restored. */
+    void set_dry_run(bool dry) noexcept
+    {
+        if (dry && !dry_run_)
+        {
+            saved_selections_ = selections_;
+        }
+        else if (!dry && dry_run_)
+        {
+            selections_ = saved_selections_;
+        }
+        dry_run_ = dry;
+    }
+
+  private:
+    enum class PrepState : std::uint8_t
+    {
+        kPending,
+        kReady,
+        kFailed,
+    };
+
+    // Lazily prepare YA/TH for this tick (kAuto).
+    bool ensure_ya() noexcept
+    {
+        if (ya_state_ == PrepState::kPending)
+        {
+            ya_state_ = ya_.begin_tick(chief_, n_radps_, *grid_) ? PrepState::kReady
+                                                                 : PrepState::kFailed;
+        }
+        return ya_state_ == PrepState::kReady;
+    }
+
+    // Lazily prepare SS-J2 for this tick (kAuto with circular_model = kSsJ2).
+    bool ensure_ss() noexcept
+    {
+        if (ss_state_ == PrepState::kPending)
+        {
+            ss_state_ = ss_.begin_tick(chief_, n_radps_, *grid_) ? PrepState::kReady
+                                                                 : PrepState::kFailed;
+        }
+        return ss_state_ == PrepState::kReady;
+    }
+
+    void predict_block_auto(Span<const RelStateRic> x0,
+                            Span<const bool> active,
+                            Span2D<Vec3> out_r,
+                            Span2D<Vec3> out_v,
+                            Span<bool> out_ok) noexcept
+    {
+        const bool want_v = (out_v.data != nullptr);
+        const std::size_t rows = std::min<std::size_t>(x0.size, MAX_VEHICLES);
+
+        bool any_ya = false;
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            if (!active[i])
+            {
+                continue;
+            }
+            const double range_m = norm(x0[i].r_ric);
+            // A dry tick evaluates a copy: the live selector's history stays untouched.
+            selections_[i] =
+                dry_run_ ? ModelSelector{selectors_[i]}.update(chief_.time_tag, chief_e_, range_m,
+                                                               horizon_sec_, steps_)
+                         : selectors_[i].update(chief_.time_tag, chief_e_, range_m,
+                                                horizon_sec_, steps_);
+            if (selections_[i].model == PredictorModel::kHcw)
+            {
+                out_ok[i] = hcw_.predict(x0[i], out_r.row(i),
+                                         want_v ? out_v.row(i) : Span<Vec3>{nullptr, 0});
+            }
+            else if (selections_[i].model == PredictorModel::kSsJ2)
+            {
+                out_ok[i] = ensure_ss() &&
+                            ss_.predict(x0[i], out_r.row(i),
+                                        want_v ? out_v.row(i) : Span<Vec3>{nullptr, 0});
+            }
+            else
+            {
+                out_ok[i] = false; // until the YA block reports
+                any_ya = true;
+            }
+        }
+
+        if (!any_ya || !ensure_ya())
+        {
+            return;
+        }
+
+        // YA rows in one lockstep block; every other row is NaN (skipped, left as-is).
+        constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+        const RelStateRic skip{Vec3{kNaN, kNaN, kNaN}, Vec3{kNaN, kNaN, kNaN}};
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            ya_active_[i] = active[i] && selections_[i].model == PredictorModel::kYaStm;
+            ya_x0_[i] = ya_active_[i] ? x0[i] : skip;
+        }
+        ya_.predict_block(Span<const RelStateRic>{ya_x0_.data(), rows},
+                          Span<const bool>{ya_active_.data(), rows}, out_r, out_v, out_ok);
+    }
+
+    PredictorModel model_{PredictorModel::kHcw};
+    double mu_{0.0};
+    HcwPolicy hcw_;
+    YaStmPolicy ya_;
+    SsJ2Policy ss_;
+    std::optional<VirtualModelPolicy> injected_{};
+    std::size_t steps_{0};
+
+    // kAuto per-tick context.
+    ChiefState chief_{};
+    double n_radps_{0.0};
+    const TimeGrid* grid_{nullptr};
+    double chief_e_{0.0};
+    double horizon_sec_{0.0};
+    PrepState ya_state_{PrepState::kPending};
+    PrepState ss_state_{PrepState::kPending};
+
+    // kAuto per-vehicle state (indexed like PredictionBuffer rows).
+    std::array<ModelSelector, MAX_VEHICLES> selectors_{};
+    std::array<ModelSelection, MAX_VEHICLES> selections_{};
+    std::array<RelStateRic, MAX_VEHICLES> ya_x0_{};
+    std::array<bool, MAX_VEHICLES> ya_active_{};
+
+    // Dry tick (set_dry_run()): selections_ as they were before it.
+    bool dry_run_{false};
+    std::array<ModelSelection, MAX_VEHICLES> saved_selections_{};
+};
+
+/**
+ * @brief Policy that hands the tick's rows to an IStmBatchBackend (e.g. a CUDA device).
+ *
+ * begin_tick() prepares the configured built-in model (HCW, YA/TH or SS-J2; kAuto uses YA/TH
+ * for every row) and predicts the six unit-state basis rows with it; the backend then applies
+ * the basis to the whole tick in predict_block(), writing into the Publisher back buffer.
+ * Single rows (predict()) apply the same basis on the calling thread. Results equal the inner
+ * model's up to rounding (up to its tolerance for the adaptive YA backend, whose steps depend
+ * on the state).
+ */
+class StmBatchPolicy final
+{
+  public:
+    /**
+     * @param backend Batch backend (must outlive the predictor).
+     * @param config Model configuration (injected models are not supported).
+     */
+    explicit StmBatchPolicy(
+        IStmBatchBackend& backend,
+        const RelativePredictorConfig& config = RelativePredictorConfig{}) noexcept
+        : backend_(&backend), inner_(config)
+    {
+    }
+
+    bool begin_tick(const ChiefState& chief, double n_radps, const TimeGrid& grid) noexcept
+    {
+        basis_ok_ = false;
+        steps_ = std::min<std::size_t>(grid.tau.size(), MAX_STEPS);
+        if (!inner_.begin_tick(chief, n_radps, grid))
+        {
+            return false;
+        }
+        bool ok = true;
+        for (std::size_t j = 0; j < 6 && ok; ++j)
+        {
+            double x[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+            x[j] = 1.0;
+            const RelStateRic e{Vec3{x[0], x[1], x[2]}, Vec3{x[3], x[4], x[5]}};
+            ok = inner_.predict(e, Span<Vec3>{basis_r_.data() + j * MAX_STEPS, steps_},
+                                Span<Vec3>{basis_v_.data() + j * MAX_STEPS, steps_});
+        }
+        // Rows fail individually (kModelError) when the basis cannot be built or loaded.
+        basis_ok_ = ok && backend_->load_basis(
+                              Span2D<const Vec3>{basis_r_.data(), 6, steps_, MAX_STEPS},
+                              Span2D<const Vec3>{basis_v_.data(), 6, steps_, MAX_STEPS}) ==
+                              ModelCode::kOk;
+        return true;
+    }
+
+    /** @brief One row from the basis on the calling thread. */
+    bool predict(const RelStateRic& x0, Span<Vec3> out_r, Span<Vec3> out_v) noexcept
+    {
+        if (!basis_ok_ || out_r.size < steps_ || !finite3(x0.r_ric) || !finite3(x0.v_ric))
+        {
+            return false;
+        }
+        const bool want_vel = (out_v.data != nullptr && out_v.size >= steps_);
+        for (std::size_t k = 0; k < steps_; ++k)
+        {
+            out_r.data[k] = stm_basis_apply(basis_r_.data(), MAX_STEPS, x0, k);
+            if (want_vel)
+            {
+                out_v.data[k] = stm_basis_apply(basis_v_.data(), MAX_STEPS, x0, k);
+            }
+        }
+        return true;
+    }
+
+    /** @brief Whole tick through the backend (submit, then collect into the rows). */
+    void predict_block(Span<const RelStateRic> x0,
+                       Span<const bool> active,
+                       Span2D<Vec3> out_r,
+                       Span2D<Vec3> out_v,
+                       Span<bool> out_ok) noexcept
+    {
+        const bool want_vel = (out_v.data != nullptr);
+        const bool done =
+            basis_ok_ && backend_->submit(x0, active, want_vel) == ModelCode::kOk &&
+            backend_->collect(out_r, out_v, out_ok) == ModelCode::kOk;
+        for (std::size_t i = 0; i < x0.size && !done; ++i)
+        {
+            if (active[i])
+            {
+                out_ok[i] = false;
+            }
+        }
+    }
+
+    // No concurrent_rows hook: one backend submission is in flight at a time.
+
+    [[nodiscard]] const IStmBatchBackend& backend() const noexcept { return *backend_; }
+
+  private:
+    IStmBatchBackend* backend_{nullptr};
+    DynamicModelPolicy inner_;
+    std::size_t steps_{0};
+    bool basis_ok_{false};
+
+    // Per-tick basis: row j (stride MAX_STEPS) is the trajectory from unit initial state e_j.
+    std::array<Vec3, 6 * MAX_STEPS> basis_r_{};
+    std::array<Vec3, 6 * MAX_STEPS> basis_v_{};
+};
+
+/**
+ * @brief True if ModelPolicy provides the optional predict_block() hook.
+ */
+template <typename ModelPolicy, typename = void>
+struct has_predict_block : std::false_type
+{
+};
+
+template <typename ModelPolicy>
+struct has_predict_block<
+    ModelPolicy,
+    std::void_t<decltype(std::declval<ModelPolicy&>().predict_block(
+        std::declval<Span<const RelStateRic>>(), std::declval<Span<const bool>>(),
+        std::declval<Span2D<Vec3>>(), std::declval<Span2D<Vec3>>(),
+        std::declval<Span<bool>>()))>> : std::true_type
+{
+};
+
+/**
+ * @brief True if ModelPolicy provides the optional row_selection() hook.
+ */
+template <typename ModelPolicy, typename = void>
+struct has_row_selection : std::false_type
+{
+};
+
+template <typename ModelPolicy>
+struct has_row_selection<ModelPolicy,
+                         std::void_t<decltype(std::declval<const ModelPolicy&>().row_selection(
+                             std::declval<std::size_t>()))>> : std::true_type
+{
+};
+
+/**
+ * @brief True if ModelPolicy provides the optional predict_tail() hook.
+ */
+template <typename ModelPolicy, typename = void>
+struct has_predict_tail : std::false_type
+{
+};
+
+template <typename ModelPolicy>
+struct has_predict_tail<ModelPolicy,
+                        std::void_t<decltype(std::declval<ModelPolicy&>().predict_tail(
+                            std::declval<std::size_t>(), std::declval<const RelStateRic&>(),
+                            std::declval<std::size_t>(), std::declval<Span<Vec3>>(),
+                            std::declval<Span<Vec3>>()))>> : std::true_type
+{
+};
+
+/**
+ * @brief True if ModelPolicy provides the optional predict_impulse() hook.
+ */
+template <typename ModelPolicy, typename = void>
+struct has_predict_impulse : std::false_type
+{
+};
+
+template <typename ModelPolicy>
+struct has_predict_impulse<ModelPolicy,
+                           std::void_t<decltype(std::declval<ModelPolicy&>().predict_impulse(
+                               std::declval<std::size_t>(), std::declval<const Vec3&>(),
+                               std::declval<double>(), std::declval<Span<Vec3>>(),
+                               std::declval<Span<Vec3>>()))>> : std::true_type
+{
+};
+
+/**
+ * @brief True if ModelPolicy provides the optional row_coefficients() hook.
+ */
+template <typename ModelPolicy, typename = void>
+struct has_row_coefficients : std::false_type
+{
+};
+
+template <typename ModelPolicy>
+struct has_row_coefficients<
+    ModelPolicy,
+    std::void_t<decltype(std::declval<const ModelPolicy&>().row_coefficients(
+        std::declval<std::size_t>(), std::declval<const RelStateRic&>(), std::declval<bool>(),
+        std::declval<TrajectoryCoefficients&>()))>> : std::true_type
+{
+};
+
+/**
+ * @brief True if ModelPolicy provides the optional checkpoint hooks (save_checkpoint(),
+ *        checkpoint_bytes(), restore_checkpoint()) for state it carries across ticks.
+ */
+template <typename ModelPolicy, typename = void>
+struct has_checkpoint : std::false_type
+{
+};
+
+template <typename ModelPolicy>
+struct has_checkpoint<
+    ModelPolicy,
+    std::void_t<decltype(std::declval<const ModelPolicy&>().save_checkpoint(
+                    std::declval<CheckpointWriter&>())),
+                decltype(std::declval<const ModelPolicy&>().checkpoint_bytes()),
+                decltype(std::declval<ModelPolicy&>().restore_checkpoint(
+                    std::declval<CheckpointCursor&>()))>> : std::true_type
+{
+};
+
+/**
+ * @brief True if ModelPolicy provides the optional set_dry_run() hook.
+ */
+template <typename ModelPolicy, typename = void>
+struct has_dry_run : std::false_type
+{
+};
+
+template <typename ModelPolicy>
+struct has_dry_run<
+    ModelPolicy,
+    std::void_t<decltype(std::declval<ModelPolicy&>().set_dry_run(std::declval<bool>()))>>
+    : std::true_type
+{
+};
+
+/**
+ * @brief True if ModelPolicy provides the optional concurrent_rows() hook.
+ */
+template <typename ModelPolicy, typename = void>
+struct has_concurrent_rows : std::false_type
+{
+};
+
+template <typename ModelPolicy>
+struct has_concurrent_rows<
+    ModelPolicy, std::void_t<decltype(std::declval<const ModelPolicy&>().concurrent_rows())>>
+    : std::true_type
+{
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,125 @@
+// core/replay_driver.cpp
+#include "core/replay_driver.hpp"
+
+#include <algorithm>
+
+namespace bullseye_pred
+{
+
+ChiefState ReplayTickProviders::Chief::get(double t0) noexcept
+{
+    const ReplayTickInput* in = p_.in_;
+    if (in == nullptr || !(in->t0 == t0))
+    {
+        ChiefState out{};
+        out.status.code = ProviderCode::kTimeMissing;
+        return out;
+    }
+    return in->chief;
+}
+
+VehicleState ReplayTickProviders::Vehicles::get(VehicleIndexMap::VehicleId id, double t0) noexcept
+{
+    VehicleState out{};
+    const ReplayTickInput* in = p_.in_;
+    if (in == nullptr || !(in->t0 == t0))
+    {
+        out.status.code = ProviderCode::kTimeMissing;
+        return out;
+    }
+    // Requests arrive in capture (row) order, so the hint almost always hits first.
+    for (std::size_t n = 0; n < in->count; ++n)
+    {
+        const std::size_t k = (hint_ + n) % in->count;
+        if (in->ids[k] == id)
+        {
+            hint_ = k + 1;
+            return in->states[k];
+        }
+    }
+    out.status.code = ProviderCode::kNotAvailable;
+    return out;
+}
+
+AdoptedRicFrame ReplayTickProviders::Frame::get(double t0) noexcept
+{
+    const ReplayTickInput* in = p_.in_;
+    if (in == nullptr || !in->has_adopted || !(in->t0 == t0))
+    {
+        AdoptedRicFrame out{};
+        out.status.code = ProviderCode::kTimeMissing;
+        return out;
+    }
+    return in->adopted;
+}
+
+void capture_replay_tick(double t0,
+                         const VehicleIndexMap& map,
+                         IChiefStateProvider& chief_provider,
+                         IVehicleStateProvider& vehicle_provider,
+                         IBullseyeFrameProvider* adopted_provider,
+                         ReplayTickInput& out) noexcept
+{
+    out.t0 = t0;
+    out.chief = chief_provider.get(t0);
+    out.has_adopted = (adopted_provider != nullptr);
+    if (out.has_adopted)
+    {
+        out.adopted = adopted_provider->get(t0);
+    }
+
+    const std::size_t rows = std::min<std::size_t>(map.slot_count(), MAX_VEHICLES);
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        if (const auto vid = map.id_at(i))
+        {
+            out.ids[n++] = *vid;
+        }
+    }
+    out.count = n;
+    (void)vehicle_provider.get_many(Span<const VehicleIndexMap::VehicleId>{out.ids.data(), n}, t0,
+                                    Span<VehicleState>{out.states.data(), n}, Span<Vec3>{},
+                                    Span<Vec3>{});
+}
+
+void copy_snapshot(const PredictionBuffer& src, PredictionBuffer& dst) noexcept
+{
+    // The planes and their settings belong to dst's publisher.
+    TrajectoryPlane* const velocities = dst.velocities;
+    TrajectoryPlane* const positions_i = dst.positions_i;
+    CovariancePlane* const position_cov = dst.position_cov;
+    SoaPositionPlanes* const soa = dst.soa;
+    Float32Plane* const positions_f32 = dst.positions_f32;
+    Fixed32Plane* const positions_q32 = dst.positions_q32;
+    const double q32_scale_m = dst.q32_scale_m;
+
+    dst = src;
+
+    dst.velocities = velocities;
+    dst.positions_i = positions_i;
+    dst.position_cov = position_cov;
+    dst.soa = soa;
+    dst.positions_f32 = positions_f32;
+    dst.positions_q32 = positions_q32;
+    dst.q32_scale_m = q32_scale_m;
+    dst.q32_saturated = 0;
+    if (velocities != nullptr && src.velocities != nullptr)
+    {
+        *velocities = *src.velocities;
+    }
+    if (positions_i != nullptr && src.positions_i != nullptr)
+    {
+        *positions_i = *src.positions_i;
+    }
+    if (position_cov != nullptr && src.position_cov != nullptr)
+    {
+        *position_cov = *src.position_cov;
+    }
+    else
+    {
+        dst.cov_rows = 0;
+    }
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,402 @@
+// core/replay_driver.hpp
+#pragma once
+/**
+ * @file replay_driver.hpp
+ * @brief Time-parallel offline replay: many t0 ticks predicted at once, published in t0 order.
+ *
+ * @details
+ * Given exact-time providers (FR-14) a tick depends only on the provider data at its t0, so a
+ * post-mission replay does not have to run its ticks one after another. run() takes a list of
+ * t0 values and processes them in batches of context_count() ticks:
+ *
+ * 1. Capture (caller's thread): the chief, the adopted frame (if any) and every registered
+ *    deputy at each t0 of the batch are queried from the shared providers, in t0 order. The
+ *    providers are never called concurrently, so they need not be thread-safe, and their
+ *    lookup cursors advance exactly as in a serial replay.
+ * 2. Predict (pool): every context (own replay providers, BullseyeFrame, predictor and
+ *    Publisher, allocated at construction) predicts one tick of the batch as one task.
+ * 3. Publish (caller's thread): the context snapshots are copied into the output Publisher and
+ *    published in t0 order, so a SnapshotRecorder on it records them as a serial replay would.
+ *
+ * Snapshots match a serial predictor configured the same way, provided the configuration
+ * keeps no state across ticks: leave sliding-window reuse, change detection, tick budgets and
+ * source-transition blending off (the default), and register no planned burns. Model caches
+ * reused across ticks within a tolerance (the HCW STM table, hcw_stm_n_rel_tol) agree with a
+ * serial run to that tolerance, and bit for bit with a tolerance of 0. Context k always
+ * predicts ticks k, k + n, k + 2n, ... (n = context_count()), so the output is deterministic
+ * regardless of the pool.
+ *
+ * Ticks that fail fast (a provider has no data at t0, ...) publish nothing; they are counted
+ * in ReplayStats::failed. The registration (vehicle map) is fixed for the whole run().
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "core/bullseye_frame.hpp"
+#include "core/bullseye_frame_provider.hpp"
+#include "core/chief_state_provider.hpp"
+#include "core/constants.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/snapshot_recorder.hpp"
+#include "core/time_grid.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "core/worker_pool.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Provider data of one replayed tick (captured on the caller's thread).
+ */
+struct ReplayTickInput final
+{
+    double t0{0.0};
+    ChiefState chief{};
+    bool has_adopted{false};
+    AdoptedRicFrame adopted{};
+
+    // Deputy states in registration (row) order.
+    std::size_t count{0};
+    std::array<VehicleIndexMap::VehicleId, MAX_VEHICLES> ids{};
+    std::array<VehicleState, MAX_VEHICLES> states{};
+};
+
+/**
+ * @brief Chief, deputy and adopted frame providers serving one captured ReplayTickInput.
+ *
+ * Queries for any other t0 return kTimeMissing (the tick fails fast).
+ */
+class ReplayTickProviders final
+{
+  public:
+    ReplayTickProviders() noexcept = default;
+
+    ReplayTickProviders(const ReplayTickProviders&) = delete;
+    ReplayTickProviders& operator=(const ReplayTickProviders&) = delete;
+
+    /** @brief Serve @p in (must stay unchanged until the next set_input()). */
+    void set_input(const ReplayTickInput* in) noexcept { in_ = in; }
+
+    [[nodiscard]] IChiefStateProvider& chief() noexcept { return chief_; }
+    [[nodiscard]] IVehicleStateProvider& vehicles() noexcept { return veh_; }
+    [[nodiscard]] IBullseyeFrameProvider& frame() noexcept { return frame_; }
+
+  private:
+    class Chief final : public IChiefStateProvider
+    {
+      public:
+        explicit Chief(const ReplayTickProviders& p) noexcept : p_(p) {}
+        [[nodiscard]] ChiefState get(double t0) noexcept override;
+
+      private:
+        const ReplayTickProviders& p_;
+    };
+
+    class Vehicles final : public IVehicleStateProvider
+    {
+      public:
+        explicit Vehicles(const ReplayTickProviders& p) noexcept : p_(p) {}
+        [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override;
+
+      private:
+        const ReplayTickProviders& p_;
+        std::size_t hint_{0};
+    };
+
+    class Frame final : public IBullseyeFrameProvider
+    {
+      public:
+        explicit Frame(const ReplayTickProviders& p) noexcept : p_(p) {}
+        [[nodiscard]] AdoptedRicFrame get(double t0) noexcept override;
+
+      private:
+        const ReplayTickProviders& p_;
+    };
+
+    const ReplayTickInput* in_{nullptr};
+    Chief chief_{*this};
+    Vehicles veh_{*this};
+    Frame frame_{*this};
+};
+
+/**
+ * @brief Query the providers at @p t0 for every vehicle registered in @p map, into @p out.
+ */
+void capture_replay_tick(double t0,
+                         const VehicleIndexMap& map,
+                         IChiefStateProvider& chief_provider,
+                         IVehicleStateProvider& vehicle_provider,
+                         IBullseyeFrameProvider* adopted_provider,
+                         ReplayTickInput& out) noexcept;
+
+/**
+ * @brief Copy snapshot @p src into the back buffer @p dst of another Publisher.
+ *
+ * Every field and every plane both buffers carry is copied; @p dst keeps its own plane
+ * storage (and publisher-owned settings such as q32_scale_m). Planes only @p src carries are
+ * dropped; derived planes (SoA, reduced precision) are refilled by the next publish().
+ */
+void copy_snapshot(const PredictionBuffer& src, PredictionBuffer& dst) noexcept;
+
+/**
+ * @brief Outcome of one BasicReplayDriver::run().
+ */
+struct ReplayStats final
+{
+    /** @brief t0 values processed. */
+    std::size_t ticks{0};
+
+    /** @brief Snapshots published to the output, in t0 order. */
+    std::size_t published{0};
+
+    /** @brief Ticks that failed fast (published nothing). */
+    std::size_t failed{0};
+
+    /** @brief Batches run on the pool. */
+    std::size_t batches{0};
+
+    /** @brief False if the recorder fell behind for longer than record_timeout_sec. */
+    bool recorded{true};
+};
+
+/**
+ * @brief Replay driver options.
+ */
+struct ReplayDriverConfig final
+{
+    /** @brief Contexts (ticks per batch); 0: the pool's workers plus the caller. */
+    std::size_t contexts{0};
+
+    /** @brief Longest wait for the recorder to catch up with the output [s]. */
+    double record_timeout_sec{10.0};
+};
+
+/**
+ * @brief Time-parallel replay through one BasicRelativePredictor per context.
+ */
+template <typename ModelPolicy>
+class BasicReplayDriver final
+{
+  public:
+    /// Contexts held at most.
+    static constexpr std::size_t kMaxContexts = WorkerPool::kMaxWorkers + 1;
+
+    /**
+     * @param output Publisher receiving the snapshots in t0 order (written by run() only).
+     * @param vehicle_map Registration replayed (read by run(); unchanged while it runs).
+     * @param chief_provider Shared chief provider (queried on the caller's thread only).
+     * @param vehicle_provider Shared deputy provider (likewise).
+     * @param adopted_provider Shared adopted frame provider, or nullptr.
+     * @param mode Bullseye frame policy (as BullseyeFrame).
+     * @param pool Pool running the contexts (nullptr: serially on the caller).
+     * @param config Context count and recorder wait.
+     * @param policy_args Passed to every context's ModelPolicy constructor (copied).
+     *
+     * Contexts that cannot be allocated are left out (context_count() reports the rest).
+     */
+    template <typename... PolicyArgs>
+    BasicReplayDriver(Publisher& output,
+                      const VehicleIndexMap& vehicle_map,
+                      IChiefStateProvider& chief_provider,
+                      IVehicleStateProvider& vehicle_provider,
+                      IBullseyeFrameProvider* adopted_provider,
+                      BullseyeFrameMode mode,
+                      WorkerPool* pool,
+                      const ReplayDriverConfig& config,
+                      const PolicyArgs&... policy_args) noexcept
+        : out_(output), map_(vehicle_map), chief_(chief_provider), veh_(vehicle_provider),
+          adopted_(adopted_provider), pool_(pool), config_(config)
+    {
+        std::size_t want = (config.contexts != 0u)
+                               ? config.contexts
+                               : ((pool != nullptr) ? pool->workers() + 1u : 1u);
+        want = (want < kMaxContexts) ? want : kMaxContexts;
+        PublisherConfig pc{};
+        pc.velocities = output.has_velocities();
+        pc.inertial_positions = output.has_inertial_positions();
+        pc.position_covariance = output.has_position_covariance();
+        for (; count_ < want; ++count_)
+        {
+            contexts_[count_].reset(new (std::nothrow) Context(pc, vehicle_map.capacity(),
+                                                                 adopted_provider != nullptr,
+                                                                 mode, policy_args...));
+            if (!contexts_[count_] ||
+                contexts_[count_]->map.capacity() != vehicle_map.capacity())
+            {
+                contexts_[count_].reset();
+                break;
+            }
+        }
+    }
+
+    BasicReplayDriver(const BasicReplayDriver&) = delete;
+    BasicReplayDriver& operator=(const BasicReplayDriver&) = delete;
+
+    [[nodiscard]] std::size_t context_count() const noexcept { return count_; }
+
+    /** @brief Context @p k's predictor; configure every context the same, before run(). */
+    [[nodiscard]] BasicRelativePredictor<ModelPolicy>& context(std::size_t k) noexcept
+    {
+        return contexts_[k]->predictor;
+    }
+
+    /**
+     * @brief Replay every t0 of @p t0s on a uniform grid.
+     *
+     * @param recorder Recorder of the output Publisher, or nullptr. Before the output would
+     *                 overwrite a snapshot the recorder has not reached (history exhausted),
+     *                 run() waits for it to catch up.
+     */
+    ReplayStats run(Span<const double> t0s,
+                    double horizon_sec,
+                    double cadence_sec,
+                    const SnapshotRecorder* recorder = nullptr) noexcept
+    {
+        return run_(t0s, nullptr, horizon_sec, cadence_sec, recorder);
+    }
+
+    /** @brief Replay every t0 of @p t0s on @p grid (shared, read-only). */
+    ReplayStats run(Span<const double> t0s,
+                    const TimeGrid& grid,
+                    const SnapshotRecorder* recorder = nullptr) noexcept
+    {
+        return run_(t0s, &grid, 0.0, 0.0, recorder);
+    }
+
+  private:
+    struct Context final
+    {
+        template <typename... PolicyArgs>
+        Context(const PublisherConfig& pc,
+                std::size_t map_capacity,
+                bool adopted,
+                BullseyeFrameMode mode,
+                const PolicyArgs&... policy_args) noexcept
+            : pub(pc), map(map_capacity),
+              bullseye(providers.chief(), adopted ? &providers.frame() : nullptr, mode),
+              predictor(pub, map, providers.chief(), providers.vehicles(), bullseye,
+                        policy_args...)
+        {
+        }
+
+        ReplayTickInput input{};
+        ReplayTickProviders providers{};
+        Publisher pub;
+        VehicleIndexMap map;
+        BullseyeFrame bullseye;
+        BasicRelativePredictor<ModelPolicy> predictor;
+        bool published{false};
+    };
+
+    ReplayStats run_(Span<const double> t0s,
+                     const TimeGrid* grid,
+                     double horizon_sec,
+                     double cadence_sec,
+                     const SnapshotRecorder* recorder) noexcept
+    {
+        ReplayStats stats{};
+        if (count_ == 0u)
+        {
+            return stats;
+        }
+        for (std::size_t k = 0; k < count_; ++k)
+        {
+            (void)contexts_[k]->map.copy_from(map_);
+        }
+        // Snapshots the output retains behind its front: the recorder may lag by that many.
+        const std::size_t retained = (out_.slots() > 2u) ? out_.slots() - 2u : 0u;
+        std::size_t unrecorded = 0;
+
+        for (std::size_t first = 0; first < t0s.size; first += count_)
+        {
+            const std::size_t n = (t0s.size - first < count_) ? t0s.size - first : count_;
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                Context& c = *contexts_[k];
+                capture_replay_tick(t0s[first + k], map_, chief_, veh_, adopted_, c.input);
+                c.providers.set_input(&c.input);
+            }
+
+            auto task = [this, grid, horizon_sec, cadence_sec](std::size_t k) noexcept
+            {
+                Context& c = *contexts_[k];
+                const std::uint64_t before = c.pub.published_seqno();
+                if (grid != nullptr)
+                {
+                    c.predictor.step(c.input.t0, *grid);
+                }
+                else
+                {
+                    c.predictor.step(c.input.t0, horizon_sec, cadence_sec);
+                }
+                c.published = c.pub.published_seqno() != before;
+            };
+            if (pool_ != nullptr && n > 1u)
+            {
+                pool_->run(n, task);
+            }
+            else
+            {
+                for (std::size_t k = 0; k < n; ++k)
+                {
+                    task(k);
+                }
+            }
+            ++stats.batches;
+
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                Context& c = *contexts_[k];
+                ++stats.ticks;
+                if (!c.published)
+                {
+                    ++stats.failed;
+                    continue;
+                }
+                if (recorder != nullptr && unrecorded > retained)
+                {
+                    stats.recorded =
+                        recorder->wait_caught_up(config_.record_timeout_sec) && stats.recorded;
+                    unrecorded = 0;
+                }
+                copy_snapshot(c.pub.read(), out_.begin_write());
+                (void)out_.publish(c.input.t0);
+                ++stats.published;
+                ++unrecorded;
+            }
+        }
+        if (recorder != nullptr && unrecorded > 0u)
+        {
+            stats.recorded = recorder->wait_caught_up(config_.record_timeout_sec) && stats.recorded;
+        }
+        return stats;
+    }
+
+    Publisher& out_;
+    const VehicleIndexMap& map_;
+    IChiefStateProvider& chief_;
+    IVehicleStateProvider& veh_;
+    IBullseyeFrameProvider* adopted_{nullptr};
+    WorkerPool* pool_{nullptr};
+    ReplayDriverConfig config_{};
+
+    std::array<std::unique_ptr<Context>, kMaxContexts> contexts_{};
+    std::size_t count_{0};
+};
+
+/** @brief Runtime-configured replay driver. */
+using ReplayDriver = BasicReplayDriver<DynamicModelPolicy>;
+
+/** @brief Statically dispatched HCW / YA/TH replay drivers. */
+using HcwReplayDriver = BasicReplayDriver<HcwPolicy>;
+using YaReplayDriver = BasicReplayDriver<YaStmPolicy>;
+
+} // namespace bullseye_pred
@@ -0,0 +1,206 @@
+// core/sample_ring.hpp
+#pragma once
+
+/**
+ * @file sample_ring.hpp
+ * @brief Fixed-capacity single-producer/single-consumer ring of time-tagged samples.
+ *
+ * Backs the streaming mode of the Cartesian providers: a producer thread appends samples in
+ * strictly increasing time order, the simulation thread looks them up and evicts the ones that
+ * fell out of the retention window. Storage is allocated once by init(); push() and the
+ * consumer calls never allocate, never block, and never copy the window.
+ *
+ * Threading
+ * - push() is called by exactly one producer thread.
+ * - refresh(), evict_before(), view() and the View accessors are called by exactly one
+ *   consumer thread (the provider's get()).
+ * - init()/clear() are configuration-time: no concurrent producer or consumer.
+ *
+ * The slots come from the memory resource given at construction (the global heap by default).
+ */
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+namespace bullseye_pred::detail
+{
+
+template <class Sample>
+class SampleRing final
+{
+  public:
+    /// Consumer-side view of the retained samples, oldest first (index 0).
+    class View final
+    {
+      public:
+        [[nodiscard]] const Sample& operator[](std::size_t i) const noexcept
+        {
+            return ring_->slots_[(first_ + i) % ring_->capacity_];
+        }
+
+      private:
+        friend class SampleRing;
+        View(const SampleRing* ring, std::uint64_t first) noexcept : ring_(ring), first_(first) {}
+
+        const SampleRing* ring_;
+        std::uint64_t first_;
+    };
+
+    /// @param memory Source of the slots; must outlive the ring.
+    explicit SampleRing(
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource()) noexcept
+        : memory_(memory)
+    {
+    }
+
+    ~SampleRing() { release_(); }
+
+    SampleRing(const SampleRing&) = delete;
+    SampleRing& operator=(const SampleRing&) = delete;
+
+    /// @brief Allocate room for @p capacity samples (drops any contents).
+    [[nodiscard]] bool init(std::size_t capacity) noexcept
+    {
+        release_();
+        if (capacity > 0u && capacity <= std::numeric_limits<std::size_t>::max() / sizeof(Sample))
+        {
+            try
+            {
+                slots_ = static_cast<Sample*>(
+                    memory_->allocate(capacity * sizeof(Sample), alignof(Sample)));
+            }
+            catch (const std::bad_alloc&)
+            {
+                slots_ = nullptr;
+            }
+        }
+        if (slots_ != nullptr)
+        {
+            std::uninitialized_value_construct_n(slots_, capacity);
+            capacity_ = capacity;
+        }
+        clear();
+        return capacity_ > 0u;
+    }
+
+    /// @brief Drop all samples and forget the producer's last time.
+    void clear() noexcept
+    {
+        head_.store(0u, std::memory_order_relaxed);
+        tail_.store(0u, std::memory_order_relaxed);
+        seen_tail_ = 0u;
+        last_push_t_ = 0.0;
+        have_last_push_ = false;
+        dropped_.store(0u, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+    // ------------------------------
+    // Producer
+    // ------------------------------
+
+    /**
+     * @brief Append @p s.
+     *
+     * @return false (sample dropped and counted) if the ring is not initialised or full, or
+     *         if s.t is not finite or not after the previously pushed sample.
+     */
+    [[nodiscard]] bool push(const Sample& s) noexcept
+    {
+        const std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        const bool in_order = !have_last_push_ || last_push_t_ < s.t;
+        if (capacity_ == 0u || !std::isfinite(s.t) || !in_order ||
+            tail - head_.load(std::memory_order_acquire) >= capacity_)
+        {
+            dropped_.fetch_add(1u, std::memory_order_relaxed);
+            return false;
+        }
+        slots_[tail % capacity_] = s;
+        last_push_t_ = s.t;
+        have_last_push_ = true;
+        tail_.store(tail + 1u, std::memory_order_release);
+        return true;
+    }
+
+    /// @return samples rejected by push() (readable from any thread).
+    [[nodiscard]] std::uint64_t dropped() const noexcept
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    // ------------------------------
+    // Consumer
+    // ------------------------------
+
+    /// @brief Make samples pushed so far visible to view(); @return retained count.
+    std::size_t refresh() noexcept
+    {
+        seen_tail_ = tail_.load(std::memory_order_acquire);
+        return size();
+    }
+
+    /// @return retained samples as of the last refresh().
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return static_cast<std::size_t>(seen_tail_ - head_.load(std::memory_order_relaxed));
+    }
+
+    /// @brief Evict retained samples with t < @p t; @return number evicted.
+    std::size_t evict_before(double t) noexcept
+    {
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        const std::uint64_t first = head;
+        while (head < seen_tail_ && slots_[head % capacity_].t < t)
+        {
+            ++head;
+        }
+        if (head != first)
+        {
+            // Release: the producer may reuse the slots only after this thread stopped reading.
+            head_.store(head, std::memory_order_release);
+        }
+        return static_cast<std::size_t>(head - first);
+    }
+
+    [[nodiscard]] View view() const noexcept
+    {
+        return View{this, head_.load(std::memory_order_relaxed)};
+    }
+
+  private:
+    void release_() noexcept
+    {
+        if (slots_ != nullptr)
+        {
+            std::destroy_n(slots_, capacity_);
+            memory_->deallocate(slots_, capacity_ * sizeof(Sample), alignof(Sample));
+        }
+        slots_ = nullptr;
+        capacity_ = 0u;
+    }
+
+    std::pmr::memory_resource* memory_;
+    Sample* slots_{nullptr};
+    std::size_t capacity_{0};
+
+    // Monotonic sample counters; slot = counter % capacity_.
+    alignas(64) std::atomic<std::uint64_t> head_{0};
+    alignas(64) std::atomic<std::uint64_t> tail_{0};
+
+    // Producer-only.
+    alignas(64) double last_push_t_{0.0};
+    bool have_last_push_{false};
+    std::atomic<std::uint64_t> dropped_{0};
+
+    // Consumer-only.
+    alignas(64) std::uint64_t seen_tail_{0};
+};
+
+} // namespace bullseye_pred::detail
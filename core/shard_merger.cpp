@@ -0,0 +1,333 @@
+// core/shard_merger.cpp
+#include "core/shard_merger.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+namespace bullseye_pred
+{
+
+static_assert(std::is_trivially_copyable<ChiefBroadcast>::value,
+              "ChiefBroadcast is encoded by memcpy");
+
+namespace
+{
+
+// Same dense grid and grid profiles: rows of the two buffers line up sample for sample.
+bool same_grid(const PredictionBuffer& a, const PredictionBuffer& b) noexcept
+{
+    if (a.steps != b.steps || a.profile_steps != b.profile_steps ||
+        !std::equal(a.tau.begin(), a.tau.begin() + std::min(a.steps, MAX_STEPS), b.tau.begin()))
+    {
+        return false;
+    }
+    for (std::size_t p = 0; p + 1 < MAX_GRID_PROFILES; ++p)
+    {
+        const std::size_t n = std::min(a.profile_steps[p], MAX_STEPS);
+        if (!std::equal(a.profile_tau[p].begin(), a.profile_tau[p].begin() + n,
+                        b.profile_tau[p].begin()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+RowMask take_rows(RowMask into, RowMask from, RowMask rows) noexcept
+{
+    return (into & ~rows) | (from & rows);
+}
+
+} // namespace
+
+RowMask ShardRange::mask() const noexcept
+{
+    RowMask m = 0;
+    for (std::size_t i = first; i < first + count && i < MAX_VEHICLES; ++i)
+    {
+        m |= RowMask{1} << i;
+    }
+    return m;
+}
+
+bool split_shard_ranges(std::size_t rows, std::size_t shards, ShardRange* out) noexcept
+{
+    if (out == nullptr || shards == 0u || shards > rows || rows > MAX_VEHICLES)
+    {
+        return false;
+    }
+    const std::size_t base = rows / shards;
+    const std::size_t extra = rows % shards;
+    std::size_t first = 0;
+    for (std::size_t s = 0; s < shards; ++s)
+    {
+        const std::size_t n = base + ((s < extra) ? 1u : 0u);
+        out[s] = ShardRange{first, n};
+        first += n;
+    }
+    return true;
+}
+
+bool make_shard_map(const VehicleIndexMap& shared, ShardRange range, VehicleIndexMap& out) noexcept
+{
+    if (!out.copy_from(shared))
+    {
+        return false;
+    }
+    const std::size_t slots = out.slot_count();
+    for (std::size_t i = 0; i < slots; ++i)
+    {
+        if (i >= range.first && i - range.first < range.count)
+        {
+            continue;
+        }
+        const std::optional<VehicleIndexMap::VehicleId> id = out.id_at(i);
+        if (id.has_value())
+        {
+            (void)out.unregister_vehicle(*id);
+        }
+    }
+    return true;
+}
+
+std::optional<ChiefBroadcast> make_chief_broadcast(std::uint64_t tick,
+                                                   const ChiefState& chief,
+                                                   double horizon_sec,
+                                                   double cadence_sec) noexcept
+{
+    if (!chief.status.ok())
+    {
+        return std::nullopt;
+    }
+    ChiefBroadcast b{};
+    b.tick = tick;
+    b.t0 = chief.time_tag;
+    b.horizon_sec = horizon_sec;
+    b.cadence_sec = cadence_sec;
+    b.r_i = chief.r_i;
+    b.v_i = chief.v_i;
+    return b;
+}
+
+std::size_t encode_chief_broadcast(const ChiefBroadcast& b,
+                                   std::uint8_t* out,
+                                   std::size_t capacity) noexcept
+{
+    if (out == nullptr || capacity < kChiefBroadcastBytes)
+    {
+        return 0;
+    }
+    std::memcpy(out, &b, kChiefBroadcastBytes);
+    return kChiefBroadcastBytes;
+}
+
+bool decode_chief_broadcast(const std::uint8_t* data,
+                            std::size_t size,
+                            ChiefBroadcast& out) noexcept
+{
+    if (data == nullptr || size < kChiefBroadcastBytes)
+    {
+        return false;
+    }
+    ChiefBroadcast b{};
+    std::memcpy(&b, data, kChiefBroadcastBytes);
+    if (b.magic != ChiefBroadcast::kMagic)
+    {
+        return false;
+    }
+    out = b;
+    return true;
+}
+
+SnapshotMerger::SnapshotMerger(Publisher& output,
+                               const ShardRange* shards,
+                               std::size_t count) noexcept
+    : out_(output)
+{
+    count_ = (shards != nullptr) ? std::min(count, kMaxShards) : 0u;
+    for (std::size_t s = 0; s < count_; ++s)
+    {
+        ranges_[s] = shards[s];
+        masks_[s] = shards[s].mask();
+        all_ |= std::uint64_t{1} << s;
+    }
+}
+
+ShardSubmit SnapshotMerger::submit(std::size_t shard, const PredictionBuffer& partial) noexcept
+{
+    if (shard >= count_)
+    {
+        ++stats_.dropped;
+        return ShardSubmit::kInvalidShard;
+    }
+    const double t0 = partial.t0;
+    if ((published_any_ && !(t0 > last_t0_)) || (pending_ && t0 < pending_t0_))
+    {
+        ++stats_.dropped;
+        return ShardSubmit::kStale;
+    }
+    if (pending_ && t0 > pending_t0_)
+    {
+        (void)publish_();
+    }
+
+    // Stage straight into the back buffer; it stays reserved until publish_().
+    PredictionBuffer& buf = out_.begin_write();
+    if (!pending_)
+    {
+        buf.steps = partial.steps;
+        buf.tau = partial.tau;
+        buf.profile_steps = partial.profile_steps;
+        buf.profile_tau = partial.profile_tau;
+        buf.vehicles = 0;
+        buf.est_cost_total = 0.0;
+        buf.keep_out_count = partial.keep_out_count;
+        buf.keep_out_radius_m = partial.keep_out_radius_m;
+        pending_ = true;
+        pending_t0_ = t0;
+        arrived_ = 0;
+        staged_rows_ = 0;
+        staged_dirty_ = 0;
+        staged_own_epoch_ = 0;
+        staged_deferred_ = 0;
+    }
+    else if (!same_grid(buf, partial))
+    {
+        ++stats_.dropped;
+        return ShardSubmit::kGridMismatch;
+    }
+
+    // Rows the node predicted at t0 are new. Rows it carried (deferred by its budget, skipped
+    // as unchanged) keep their epoch: publish() carries them if the front already holds that
+    // epoch, otherwise they are relayed with their own row_t0.
+    const std::uint64_t bit = std::uint64_t{1} << shard;
+    const RowMask rows = masks_[shard];
+    const PredictionBuffer& front = out_.read();
+    RowMask fresh = 0;
+    RowMask relayed = 0;
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        const RowMask row = RowMask{1} << i;
+        if ((rows & row) == 0u)
+        {
+            continue;
+        }
+        if (partial.row_t0[i] == t0)
+        {
+            fresh |= row;
+        }
+        else if (front.row_seqno[i] != 0u && front.row_t0[i] == partial.row_t0[i] &&
+                 (staged_dirty_ & row) == 0u)
+        {
+            continue;
+        }
+        else
+        {
+            relayed |= row;
+            buf.row_t0[i] = partial.row_t0[i];
+        }
+        const std::size_t n = std::min(partial.row_steps(i), MAX_STEPS);
+        std::copy_n(partial.positions[i].data(), n, buf.positions[i].data());
+        if (buf.velocities != nullptr && partial.velocities != nullptr)
+        {
+            std::copy_n((*partial.velocities)[i].data(), n, (*buf.velocities)[i].data());
+        }
+        if (buf.positions_i != nullptr && partial.positions_i != nullptr)
+        {
+            std::copy_n((*partial.positions_i)[i].data(), n, (*buf.positions_i)[i].data());
+        }
+        if (buf.position_cov != nullptr && partial.position_cov != nullptr &&
+            ((partial.cov_rows >> i) & 1u) != 0u)
+        {
+            std::copy_n((*partial.position_cov)[i].data(), n, (*buf.position_cov)[i].data());
+        }
+        buf.row_status[i] = partial.row_status[i];
+        buf.row_grid[i] = partial.row_grid[i];
+        buf.row_model[i] = partial.row_model[i];
+        buf.approach[i] = partial.approach[i];
+        buf.coefficients[i] = partial.coefficients[i];
+    }
+    const RowMask cov = (buf.position_cov != nullptr) ? partial.cov_rows : RowMask{0};
+    buf.valid_rows = take_rows(buf.valid_rows, partial.valid_rows, rows);
+    buf.cov_rows = take_rows(buf.cov_rows, cov, rows);
+    buf.maneuver_rows = take_rows(buf.maneuver_rows, partial.maneuver_rows, rows);
+    buf.control_unmodeled_rows =
+        take_rows(buf.control_unmodeled_rows, partial.control_unmodeled_rows, rows);
+    buf.coeff_rows = take_rows(buf.coeff_rows, partial.coeff_rows, rows);
+    buf.coeff_only_rows = take_rows(buf.coeff_only_rows, partial.coeff_only_rows, rows);
+    buf.unchanged_rows = take_rows(buf.unchanged_rows, partial.unchanged_rows, rows);
+    buf.vehicles = std::max(buf.vehicles, partial.vehicles);
+    if ((arrived_ & bit) == 0u)
+    {
+        buf.est_cost_total += partial.est_cost_total;
+    }
+
+    arrived_ |= bit;
+    staged_rows_ |= rows;
+    staged_dirty_ = take_rows(staged_dirty_, fresh | relayed, rows);
+    staged_own_epoch_ = take_rows(staged_own_epoch_, relayed, rows);
+    staged_deferred_ = take_rows(staged_deferred_, partial.deferred_rows, rows);
+    staged_seqno_[shard] = partial.seqno;
+    if (arrived_ == all_)
+    {
+        (void)publish_();
+        return ShardSubmit::kPublished;
+    }
+    return ShardSubmit::kMerged;
+}
+
+std::uint64_t SnapshotMerger::flush() noexcept
+{
+    return pending_ ? publish_() : 0u;
+}
+
+std::uint64_t SnapshotMerger::publish_() noexcept
+{
+    // Rows of missing shards are carried from the front by publish(); flag the ones it has.
+    RowMask missing = 0;
+    for (std::size_t s = 0; s < count_; ++s)
+    {
+        if (((arrived_ >> s) & 1u) == 0u)
+        {
+            missing |= masks_[s] & ~staged_rows_;
+        }
+    }
+    const RowMask deferred = (missing & out_.read().valid_rows) | staged_deferred_;
+    PredictionBuffer& buf = out_.begin_write();
+    buf.deferred_rows = deferred;
+    buf.unchanged_rows &= staged_rows_;
+    const std::uint64_t seq = out_.publish(pending_t0_, staged_dirty_, staged_own_epoch_);
+
+    for (std::size_t s = 0; s < count_; ++s)
+    {
+        ShardFreshness& f = fresh_[s];
+        if (((arrived_ >> s) & 1u) != 0u)
+        {
+            f.source_seqno = staged_seqno_[s];
+            f.t0 = pending_t0_;
+            f.merged_seqno = seq;
+            f.missed = 0;
+        }
+        else
+        {
+            ++f.missed;
+        }
+    }
+    if (arrived_ == all_)
+    {
+        ++stats_.complete;
+    }
+    else
+    {
+        ++stats_.partial;
+    }
+    published_any_ = true;
+    last_t0_ = pending_t0_;
+    pending_ = false;
+    arrived_ = 0;
+    staged_rows_ = 0;
+    return seq;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,337 @@
+// core/shard_merger.hpp
+#pragma once
+/**
+ * @file shard_merger.hpp
+ * @brief Vehicle sharding: nodes predict disjoint row ranges, a merger publishes one snapshot.
+ *
+ * @details
+ * A formation too large for one node's tick budget is split by published row. Every node
+ * holds the same VehicleIndexMap (make_shard_map() frees the slots outside its ShardRange,
+ * indices unchanged), so a plain predictor on the node writes only its own rows:
+ *
+ * 1. Broadcast (leader, once per tick): the chief state at t0 and the grid go out as one
+ *    ChiefBroadcast. Every node feeds it to a CartesianChiefProvider in Mode::kCurrent and
+ *    builds its BullseyeFrame from it (constructed-only), so the chief and the frame are
+ *    bit for bit the same on every node.
+ * 2. Predict (each node): BasicShardNode steps its predictor on the broadcast tick and
+ *    publishes a partial snapshot (rows of its range only).
+ * 3. Merge (merger host): SnapshotMerger::submit() copies each partial's rows straight into
+ *    the output Publisher's back buffer, keyed by t0, and publishes once every shard of the
+ *    tick arrived, or on flush() when the tick's deadline passes.
+ *
+ * A shard missing from a merge keeps its rows from the last snapshot that had them: they are
+ * carried clean (row_seqno/row_t0 unchanged) and flagged in deferred_rows. ShardFreshness
+ * reports per shard the last tick merged and how many merges it has missed.
+ *
+ * Rows a node did not predict at t0 (deferred by its tick budget, skipped as unchanged) keep
+ * their epoch: the merged row_t0 is the partial's, and deferred_rows / unchanged_rows follow
+ * the partial. Such a row is carried clean if the merged front already holds it, else it is
+ * written with its own row_t0 (Publisher::publish(t0, dirty, own_epoch)).
+ *
+ * Partials can reach the merger in process (BasicShardNode::partial()) or over the network
+ * (a SnapshotDeltaEncoder filtered to the shard's rows on the node, a decoder's Publisher on
+ * the merger host). Nodes must use the same grid and model configuration.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "core/bullseye_frame.hpp"
+#include "core/constants.hpp"
+#include "core/prediction_buffer.hpp"
+#include "core/provider_cartesian.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Contiguous published rows [first, first + count) predicted by one shard.
+ */
+struct ShardRange final
+{
+    std::size_t first{0};
+    std::size_t count{0};
+
+    /** @brief Rows of the range (rows past MAX_VEHICLES dropped). */
+    [[nodiscard]] RowMask mask() const noexcept;
+};
+
+/**
+ * @brief Split rows [0, @p rows) into @p shards contiguous ranges, sizes differing by at most 1.
+ *
+ * @param out Receives @p shards ranges (the first rows % shards get one row more).
+ * @return false (out unchanged) if @p shards is 0, exceeds @p rows, or @p rows exceeds
+ *         MAX_VEHICLES.
+ */
+[[nodiscard]] bool split_shard_ranges(std::size_t rows,
+                                      std::size_t shards,
+                                      ShardRange* out) noexcept;
+
+/**
+ * @brief Copy @p shared into @p out, then unregister every vehicle outside @p range.
+ *
+ * Vehicles in the range keep their indices (rows). Call again after every registration
+ * change of the shared map.
+ *
+ * @return false if the capacities differ (out unchanged).
+ */
+[[nodiscard]] bool make_shard_map(const VehicleIndexMap& shared,
+                                  ShardRange range,
+                                  VehicleIndexMap& out) noexcept;
+
+/**
+ * @brief Chief context of one tick, broadcast by the leader to every shard node.
+ *
+ * Trivially copyable with a fixed layout: encode_chief_broadcast() writes it as is (nodes
+ * and leader share the byte order).
+ */
+struct ChiefBroadcast final
+{
+    static constexpr std::uint32_t kMagic = 0x42534331u; // "BSC1"
+
+    std::uint32_t magic{kMagic};
+    std::uint32_t reserved{0};
+
+    /** @brief Leader's tick counter (increasing). */
+    std::uint64_t tick{0};
+
+    double t0{0.0};
+    double horizon_sec{0.0};
+    double cadence_sec{0.0};
+
+    /** @brief Chief state at t0, in the nodes' configured inertial frame. */
+    Vec3 r_i{};
+    Vec3 v_i{};
+};
+
+/** @brief Encoded size of a ChiefBroadcast [bytes]. */
+inline constexpr std::size_t kChiefBroadcastBytes = sizeof(ChiefBroadcast);
+
+/**
+ * @brief Broadcast of tick @p tick from the leader's chief state @p chief (t0 = its time_tag).
+ * @return std::nullopt if @p chief is not kOk.
+ */
+[[nodiscard]] std::optional<ChiefBroadcast> make_chief_broadcast(std::uint64_t tick,
+                                                                 const ChiefState& chief,
+                                                                 double horizon_sec,
+                                                                 double cadence_sec) noexcept;
+
+/**
+ * @brief Write @p b into @p out.
+ * @return bytes written (kChiefBroadcastBytes), or 0 if @p capacity is too small.
+ */
+std::size_t encode_chief_broadcast(const ChiefBroadcast& b,
+                                   std::uint8_t* out,
+                                   std::size_t capacity) noexcept;
+
+/**
+ * @brief Read a broadcast written by encode_chief_broadcast().
+ * @return false (out unchanged) on a short datagram or a bad magic.
+ */
+[[nodiscard]] bool decode_chief_broadcast(const std::uint8_t* data,
+                                          std::size_t size,
+                                          ChiefBroadcast& out) noexcept;
+
+/**
+ * @brief One shard node: broadcast chief, shard map, predictor and partial-snapshot Publisher.
+ */
+template <typename ModelPolicy>
+class BasicShardNode final
+{
+  public:
+    /**
+     * @param inertial_frame_id Chief inertial frame (as CartesianChiefProvider; static string).
+     * @param vehicle_provider This node's deputy provider.
+     * @param map_capacity Capacity of the shared VehicleIndexMap.
+     * @param pc Partial-snapshot planes (match the merger's output Publisher).
+     * @param policy_args Passed to the ModelPolicy constructor.
+     */
+    template <typename... PolicyArgs>
+    BasicShardNode(const char* inertial_frame_id,
+                   IVehicleStateProvider& vehicle_provider,
+                   std::size_t map_capacity,
+                   const PublisherConfig& pc,
+                   const PolicyArgs&... policy_args) noexcept
+        : chief_(inertial_frame_id), pub_(pc), map_(map_capacity),
+          bullseye_(chief_, nullptr, BullseyeFrameMode::kConstructedOnly),
+          predictor_(pub_, map_, chief_, vehicle_provider, bullseye_, policy_args...)
+    {
+    }
+
+    BasicShardNode(const BasicShardNode&) = delete;
+    BasicShardNode& operator=(const BasicShardNode&) = delete;
+
+    /** @brief Predict @p range of @p shared (see make_shard_map()); false if it failed. */
+    [[nodiscard]] bool set_range(const VehicleIndexMap& shared, ShardRange range) noexcept
+    {
+        if (!make_shard_map(shared, range, map_))
+        {
+            return false;
+        }
+        range_ = range;
+        return true;
+    }
+
+    /**
+     * @brief Predict the broadcast tick.
+     * @return true if a partial snapshot was published (partial() holds it).
+     */
+    bool step(const ChiefBroadcast& b) noexcept
+    {
+        chief_.set_current(b.t0, b.r_i, b.v_i);
+        const std::uint64_t before = pub_.published_seqno();
+        predictor_.step(b.t0, b.horizon_sec, b.cadence_sec);
+        return pub_.published_seqno() != before;
+    }
+
+    [[nodiscard]] ShardRange range() const noexcept { return range_; }
+    [[nodiscard]] const PredictionBuffer& partial() const noexcept { return pub_.read(); }
+    [[nodiscard]] Publisher& publisher() noexcept { return pub_; }
+    [[nodiscard]] BasicRelativePredictor<ModelPolicy>& predictor() noexcept { return predictor_; }
+
+  private:
+    CartesianChiefProvider chief_;
+    Publisher pub_;
+    VehicleIndexMap map_;
+    BullseyeFrame bullseye_;
+    BasicRelativePredictor<ModelPolicy> predictor_;
+    ShardRange range_{};
+};
+
+/** @brief Runtime-configured shard node. */
+using ShardNode = BasicShardNode<DynamicModelPolicy>;
+
+/** @brief Statically dispatched HCW / YA/TH shard nodes. */
+using HcwShardNode = BasicShardNode<HcwPolicy>;
+using YaShardNode = BasicShardNode<YaStmPolicy>;
+
+/** @brief Outcome of SnapshotMerger::submit(). */
+enum class ShardSubmit : std::uint8_t
+{
+    kMerged = 0,    // rows staged; the tick still waits for other shards
+    kPublished,     // rows staged and the tick published (every shard arrived)
+    kStale,         // t0 not after the last published tick; dropped
+    kGridMismatch,  // steps/tau differ from the shards already staged for the tick; dropped
+    kInvalidShard,  // shard index out of range; dropped
+};
+
+/**
+ * @brief Freshness of one shard's rows in the merged snapshots.
+ */
+struct ShardFreshness final
+{
+    /** @brief Partial snapshot seqno (the node's own publisher) last merged; 0: none yet. */
+    std::uint64_t source_seqno{0};
+
+    /** @brief t0 of the last merge with this shard's rows. */
+    double t0{0.0};
+
+    /** @brief Output seqno of the last merge with this shard's rows; 0: none yet. */
+    std::uint64_t merged_seqno{0};
+
+    /** @brief Merges published since without this shard (0: fresh in the latest snapshot). */
+    std::uint64_t missed{0};
+};
+
+/**
+ * @brief Merger counters.
+ */
+struct MergerStats final
+{
+    /** @brief Ticks published with every shard. */
+    std::uint64_t complete{0};
+
+    /** @brief Ticks published by flush() or a newer tick with shards missing. */
+    std::uint64_t partial{0};
+
+    /** @brief Submissions dropped (kStale, kGridMismatch, kInvalidShard). */
+    std::uint64_t dropped{0};
+};
+
+/**
+ * @brief Assembles shard partial snapshots into one published snapshot per tick.
+ *
+ * Single writer: submit() and flush() are called from one thread (the output Publisher's
+ * producer). Readers use the output Publisher as usual.
+ */
+class SnapshotMerger final
+{
+  public:
+    /// Shards held at most (one row each).
+    static constexpr std::size_t kMaxShards = MAX_VEHICLES;
+
+    /**
+     * @param output Publisher receiving the merged snapshots (written by the merger only).
+     * @param shards Row ranges, one per shard (copied; at most kMaxShards, extra ignored).
+     *               Ranges should not overlap; a row in two ranges takes the later submit.
+     */
+    SnapshotMerger(Publisher& output, const ShardRange* shards, std::size_t count) noexcept;
+
+    SnapshotMerger(const SnapshotMerger&) = delete;
+    SnapshotMerger& operator=(const SnapshotMerger&) = delete;
+
+    /**
+     * @brief Merge @p partial (shard @p shard's snapshot at partial.t0).
+     *
+     * A partial for a later t0 than the pending tick publishes the pending tick first (its
+     * missing shards carried), as flush() would.
+     */
+    ShardSubmit submit(std::size_t shard, const PredictionBuffer& partial) noexcept;
+
+    /**
+     * @brief Publish the pending tick with the shards that arrived (deadline passed).
+     * @return the published seqno, or 0 if no tick was pending.
+     */
+    std::uint64_t flush() noexcept;
+
+    [[nodiscard]] std::size_t shard_count() const noexcept { return count_; }
+    [[nodiscard]] ShardRange shard(std::size_t s) const noexcept { return ranges_[s]; }
+
+    /** @brief True while a tick has staged rows but is not published. */
+    [[nodiscard]] bool pending() const noexcept { return pending_; }
+
+    /** @brief t0 of the pending tick (valid while pending()). */
+    [[nodiscard]] double pending_t0() const noexcept { return pending_t0_; }
+
+    /** @brief Bit s set if shard s arrived for the pending tick. */
+    [[nodiscard]] std::uint64_t arrived() const noexcept { return arrived_; }
+
+    [[nodiscard]] const ShardFreshness& freshness(std::size_t s) const noexcept
+    {
+        return fresh_[s];
+    }
+
+    [[nodiscard]] const MergerStats& stats() const noexcept { return stats_; }
+
+  private:
+    std::uint64_t publish_() noexcept;
+
+    Publisher& out_;
+    std::array<ShardRange, kMaxShards> ranges_{};
+    std::array<RowMask, kMaxShards> masks_{};
+    std::size_t count_{0};
+    std::uint64_t all_{0};
+
+    bool pending_{false};
+    double pending_t0_{0.0};
+    std::uint64_t arrived_{0};
+    RowMask staged_rows_{0};      // rows of the arrived shards
+    RowMask staged_dirty_{0};     // rows written into the back buffer
+    RowMask staged_own_epoch_{0}; // written rows predicted before the tick (own row_t0)
+    RowMask staged_deferred_{0};  // rows the nodes deferred
+    std::array<std::uint64_t, kMaxShards> staged_seqno_{};
+
+    bool published_any_{false};
+    double last_t0_{0.0};
+
+    std::array<ShardFreshness, kMaxShards> fresh_{};
+    MergerStats stats_{};
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,137 @@
+#include "core/shm_mapping.hpp"
+
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BULLSEYE_HAVE_POSIX_SHM 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bullseye_pred
+{
+
+ShmMapping::~ShmMapping()
+{
+    reset();
+}
+
+bool ShmMapping::set_name_(const char* name) noexcept
+{
+    if (name == nullptr || name[0] != '/')
+    {
+        return false;
+    }
+    const std::size_t len = std::strlen(name);
+    if (len < 2u || len > kMaxNameLength || std::strchr(name + 1, '/') != nullptr)
+    {
+        return false;
+    }
+    std::memcpy(name_.data(), name, len + 1u);
+    return true;
+}
+
+#if defined(BULLSEYE_HAVE_POSIX_SHM)
+
+ShmCode ShmMapping::create(const char* name, std::size_t bytes) noexcept
+{
+    reset();
+    if (!set_name_(name))
+    {
+        return ShmCode::kInvalidName;
+    }
+
+    // A stale object from a crashed producer would keep its old size and contents.
+    (void)::shm_unlink(name_.data());
+    const int fd = ::shm_open(name_.data(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        return ShmCode::kOpenFailed;
+    }
+    if (bytes == 0u || ::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+    {
+        ::close(fd);
+        (void)::shm_unlink(name_.data());
+        return ShmCode::kResizeFailed;
+    }
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+    {
+        (void)::shm_unlink(name_.data());
+        return ShmCode::kMapFailed;
+    }
+
+    base_ = p;
+    bytes_ = bytes;
+    owner_ = true;
+    return ShmCode::kOk;
+}
+
+ShmCode ShmMapping::open_read_only(const char* name) noexcept
+{
+    reset();
+    if (!set_name_(name))
+    {
+        return ShmCode::kInvalidName;
+    }
+
+    const int fd = ::shm_open(name_.data(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return ShmCode::kOpenFailed;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        ::close(fd);
+        return ShmCode::kResizeFailed;
+    }
+    const auto bytes = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+    {
+        return ShmCode::kMapFailed;
+    }
+
+    base_ = p;
+    bytes_ = bytes;
+    owner_ = false;
+    return ShmCode::kOk;
+}
+
+void ShmMapping::reset() noexcept
+{
+    if (base_ != nullptr)
+    {
+        (void)::munmap(base_, bytes_);
+        if (owner_)
+        {
+            (void)::shm_unlink(name_.data());
+        }
+    }
+    base_ = nullptr;
+    bytes_ = 0;
+    owner_ = false;
+}
+
+#else
+
+ShmCode ShmMapping::create(const char* name, std::size_t) noexcept
+{
+    return set_name_(name) ? ShmCode::kUnsupported : ShmCode::kInvalidName;
+}
+
+ShmCode ShmMapping::open_read_only(const char* name) noexcept
+{
+    return set_name_(name) ? ShmCode::kUnsupported : ShmCode::kInvalidName;
+}
+
+void ShmMapping::reset() noexcept {}
+
+#endif
+
+} // namespace bullseye_pred
@@ -0,0 +1,91 @@
+#pragma once
+/**
+ * @file shm_mapping.hpp
+ * @brief RAII mapping of a named POSIX shared-memory object.
+ *
+ * @details
+ * The producer create()s an object of a fixed size (the owner unlinks it on destruction);
+ * readers in other processes open_read_only() the same name. Mapping happens once at init;
+ * nothing here is called on the publish path.
+ *
+ * On platforms without POSIX shared memory every call fails with ShmCode::kUnsupported.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace bullseye_pred
+{
+
+enum class ShmCode : std::uint8_t
+{
+    kOk = 0,
+
+    /** @brief Name is null, not "/"-prefixed, or too long. */
+    kInvalidName,
+
+    /** @brief No POSIX shared memory on this platform. */
+    kUnsupported,
+
+    /** @brief shm_open() failed (permissions, object missing for a reader). */
+    kOpenFailed,
+
+    /** @brief The object could not be sized (producer) or is smaller than required (reader). */
+    kResizeFailed,
+
+    /** @brief mmap() failed. */
+    kMapFailed,
+
+    /** @brief The segment does not carry a published Bullseye header (yet). */
+    kBadMagic,
+
+    /** @brief Header layout version differs from this build. */
+    kVersionMismatch,
+
+    /** @brief Capacities or struct sizes differ from this build. */
+    kLayoutMismatch,
+};
+
+class ShmMapping final
+{
+  public:
+    /// Longest accepted object name, including the leading '/'.
+    static constexpr std::size_t kMaxNameLength = 255;
+
+    ShmMapping() = default;
+    ~ShmMapping();
+
+    ShmMapping(const ShmMapping&) = delete;
+    ShmMapping& operator=(const ShmMapping&) = delete;
+
+    /**
+     * @brief Create (replacing any stale object of the same name) and map read-write.
+     *
+     * The object is zero-filled and unlinked again when this mapping is reset or destroyed.
+     */
+    [[nodiscard]] ShmCode create(const char* name, std::size_t bytes) noexcept;
+
+    /** @brief Map an existing object read-only, at its current size. */
+    [[nodiscard]] ShmCode open_read_only(const char* name) noexcept;
+
+    /// @brief Unmap (and unlink if created here); idempotent.
+    void reset() noexcept;
+
+    [[nodiscard]] bool mapped() const noexcept { return base_ != nullptr; }
+    [[nodiscard]] void* data() const noexcept { return base_; }
+    [[nodiscard]] std::size_t size() const noexcept { return bytes_; }
+
+    /// @return true if this mapping created the object (and will unlink it).
+    [[nodiscard]] bool owner() const noexcept { return owner_; }
+
+  private:
+    [[nodiscard]] bool set_name_(const char* name) noexcept;
+
+    void* base_{nullptr};
+    std::size_t bytes_{0};
+    bool owner_{false};
+    std::array<char, kMaxNameLength + 1> name_{};
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,163 @@
+#include "core/shm_snapshot.hpp"
+
+namespace bullseye_pred
+{
+
+ShmCode ShmSnapshotReader::open(const char* name) noexcept
+{
+    close();
+    const ShmCode code = map_.open_read_only(name);
+    if (code != ShmCode::kOk)
+    {
+        return code;
+    }
+    if (map_.size() < sizeof(ShmSegmentHeader))
+    {
+        map_.reset();
+        return ShmCode::kResizeFailed;
+    }
+
+    const auto* hdr = static_cast<const ShmSegmentHeader*>(map_.data());
+    if (hdr->magic.load(std::memory_order_acquire) != kShmMagic)
+    {
+        map_.reset();
+        return ShmCode::kBadMagic;
+    }
+    if (hdr->layout_version != kShmLayoutVersion)
+    {
+        map_.reset();
+        return ShmCode::kVersionMismatch;
+    }
+
+    const ShmLayout expect =
+        shm_layout(hdr->slots, hdr->has_velocities != 0u, hdr->soa_layout != 0u,
+                   hdr->precision != 0u, hdr->has_inertial_positions != 0u,
+                   hdr->has_position_covariance != 0u);
+    if (hdr->header_bytes != sizeof(ShmSegmentHeader) || hdr->max_vehicles != MAX_VEHICLES ||
+        hdr->max_steps != MAX_STEPS || hdr->buffer_bytes != sizeof(PredictionBuffer) ||
+        hdr->slots < 2u || hdr->slots > detail::kPublisherMaxSlots ||
+        hdr->buffers_offset != expect.buffers_offset ||
+        hdr->buffer_stride != expect.buffer_stride ||
+        hdr->velocities_offset != expect.velocities_offset ||
+        hdr->plane_stride != expect.plane_stride ||
+        hdr->inertial_offset != expect.inertial_offset ||
+        hdr->covariance_offset != expect.covariance_offset ||
+        hdr->covariance_stride != expect.covariance_stride ||
+        hdr->soa_layout > static_cast<std::uint32_t>(SoaLayout::kStepMajor) ||
+        hdr->soa_offset != expect.soa_offset || hdr->soa_stride != expect.soa_stride ||
+        hdr->precision > static_cast<std::uint32_t>(OutputPrecision::kFixed32) ||
+        hdr->compact_offset != expect.compact_offset ||
+        hdr->compact_stride != expect.compact_stride ||
+        hdr->segment_bytes != expect.segment_bytes)
+    {
+        map_.reset();
+        return ShmCode::kLayoutMismatch;
+    }
+    if (map_.size() < expect.segment_bytes)
+    {
+        map_.reset();
+        return ShmCode::kResizeFailed;
+    }
+
+    hdr_ = hdr;
+    base_ = static_cast<const unsigned char*>(map_.data());
+    return ShmCode::kOk;
+}
+
+void ShmSnapshotReader::close() noexcept
+{
+    map_.reset();
+    hdr_ = nullptr;
+    base_ = nullptr;
+}
+
+bool ShmSnapshotReader::begin_read(ShmReadView& out) const noexcept
+{
+    constexpr int kMaxAttempts = 16;
+
+    if (hdr_ == nullptr || hdr_->magic.load(std::memory_order_acquire) != kShmMagic)
+    {
+        return false;
+    }
+    for (int attempt = 0; attempt < kMaxAttempts; ++attempt)
+    {
+        const std::size_t f = hdr_->shared.front_index.load(std::memory_order_acquire);
+        if (f >= hdr_->slots)
+        {
+            return false;
+        }
+        const auto& st = hdr_->shared.slots[f];
+        const std::uint64_t v = st.version.load(std::memory_order_acquire);
+        if ((v & 1u) != 0u)
+        {
+            continue; // the front moved on and this slot is being rewritten
+        }
+        if (st.seqno.load(std::memory_order_acquire) == 0u)
+        {
+            return false; // nothing published yet
+        }
+
+        out.snapshot = reinterpret_cast<const PredictionBuffer*>(
+            base_ + hdr_->buffers_offset + f * hdr_->buffer_stride);
+        out.velocities = (hdr_->has_velocities != 0u)
+                             ? reinterpret_cast<const TrajectoryPlane*>(
+                                   base_ + hdr_->velocities_offset + f * hdr_->plane_stride)
+                             : nullptr;
+        out.positions_i = (hdr_->has_inertial_positions != 0u)
+                              ? reinterpret_cast<const TrajectoryPlane*>(
+                                    base_ + hdr_->inertial_offset + f * hdr_->plane_stride)
+                              : nullptr;
+        out.position_cov = (hdr_->has_position_covariance != 0u)
+                               ? reinterpret_cast<const CovariancePlane*>(
+                                     base_ + hdr_->covariance_offset + f * hdr_->covariance_stride)
+                               : nullptr;
+        out.soa = (hdr_->soa_offset != 0u)
+                      ? reinterpret_cast<const SoaPositionPlanes*>(
+                            base_ + hdr_->soa_offset + f * hdr_->soa_stride)
+                      : nullptr;
+        const unsigned char* const compact =
+            base_ + hdr_->compact_offset + f * hdr_->compact_stride;
+        const auto precision = static_cast<OutputPrecision>(hdr_->precision);
+        out.positions_f32 = (precision == OutputPrecision::kFloat32)
+                                ? reinterpret_cast<const Float32Plane*>(compact)
+                                : nullptr;
+        out.positions_q32 = (precision == OutputPrecision::kFixed32)
+                                ? reinterpret_cast<const Fixed32Plane*>(compact)
+                                : nullptr;
+        out.slot = f;
+        out.version = v;
+        return true;
+    }
+    return false;
+}
+
+bool ShmSnapshotReader::validate(const ShmReadView& view) const noexcept
+{
+    if (hdr_ == nullptr || view.snapshot == nullptr || view.slot >= hdr_->slots)
+    {
+        return false;
+    }
+    // Order the caller's reads of the snapshot before the version re-check (seqlock read side).
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return hdr_->shared.slots[view.slot].version.load(std::memory_order_relaxed) == view.version;
+}
+
+std::uint64_t ShmSnapshotReader::published_seqno() const noexcept
+{
+    if (hdr_ == nullptr)
+    {
+        return 0u;
+    }
+    const std::size_t f = hdr_->shared.front_index.load(std::memory_order_acquire);
+    return (f < hdr_->slots) ? hdr_->shared.slots[f].seqno.load(std::memory_order_acquire) : 0u;
+}
+
+std::uint64_t ShmSnapshotReader::wait_for_seqno(std::uint64_t after,
+                                                double timeout_sec) const noexcept
+{
+    // Read-only mapping: cannot register as a waiter; the producer wakes unconditionally.
+    return (hdr_ != nullptr) ? detail::wait_published(hdr_->shared, after, timeout_sec, false)
+                             : 0u;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,272 @@
+#pragma once
+/**
+ * @file shm_snapshot.hpp
+ * @brief Fixed binary layout of a shared-memory Publisher segment, and its reader.
+ *
+ * @details
+ * Segment layout (all offsets from the segment base, every block 64-byte aligned):
+ *
+ *   [0]                  ShmSegmentHeader: magic, layout version, capacities, offsets, and the
+ *                        publication state (front index, seqno, per-slot seqlock versions)
+ *   [buffers_offset]     slots x PredictionBuffer, buffer_stride apart
+ *   [velocities_offset]  slots x TrajectoryPlane, plane_stride apart (only if has_velocities)
+ *   [inertial_offset]    slots x TrajectoryPlane, plane_stride apart (only if
+ *                        has_inertial_positions)
+ *   [covariance_offset]  slots x CovariancePlane, covariance_stride apart (only if
+ *                        has_position_covariance)
+ *   [soa_offset]         slots x SoaPositionPlanes, soa_stride apart (only if soa_layout)
+ *   [compact_offset]     slots x Float32Plane or Fixed32Plane, compact_stride apart (only if
+ *                        precision != kFloat64)
+ *
+ * A reader in another process maps the segment read-only and reads the front snapshot in
+ * place: begin_read() records the slot's seqlock version, validate() re-checks it after the
+ * reader is done. There is no copy and no serialization; the producer never waits for readers.
+ *
+ * PredictionBuffer's plane pointers (velocities, positions_i, soa, positions_f32/q32) hold
+ * producer-process addresses; readers must use the ShmReadView members of the same names
+ * instead.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "core/prediction_buffer.hpp"
+#include "core/publisher.hpp"
+#include "core/shm_mapping.hpp"
+
+namespace bullseye_pred
+{
+
+/// "BEYESHM1" as a little-endian integer; stored last by the producer, cleared on exit.
+inline constexpr std::uint64_t kShmMagic = 0x314D485345594542ull;
+
+/// Bumped whenever ShmSegmentHeader or PredictionBuffer changes shape.
+inline constexpr std::uint32_t kShmLayoutVersion = 12;
+
+static_assert(std::is_trivially_copyable<PredictionBuffer>::value,
+              "PredictionBuffer is read in place from shared memory");
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free &&
+                  std::atomic<std::uint32_t>::is_always_lock_free &&
+                  std::atomic<std::size_t>::is_always_lock_free &&
+                  std::atomic<double>::is_always_lock_free,
+              "cross-process publication state requires address-free atomics");
+
+struct ShmSegmentHeader final
+{
+    std::atomic<std::uint64_t> magic{0};
+    std::uint32_t layout_version{0};
+    std::uint32_t header_bytes{0};
+    std::uint32_t max_vehicles{0};
+    std::uint32_t max_steps{0};
+    std::uint32_t slots{0};
+    std::uint32_t has_velocities{0};
+
+    /// sizeof(PredictionBuffer) in the producer.
+    std::uint64_t buffer_bytes{0};
+    std::uint64_t buffers_offset{0};
+    std::uint64_t buffer_stride{0};
+
+    /// 0 if no velocity planes are attached.
+    std::uint64_t velocities_offset{0};
+    std::uint64_t plane_stride{0};
+
+    /// Inertial position planes (plane_stride apart); inertial_offset is 0 if none.
+    std::uint32_t has_inertial_positions{0};
+    std::uint64_t inertial_offset{0};
+
+    /// Position covariance planes; covariance_offset is 0 if none.
+    std::uint32_t has_position_covariance{0};
+    std::uint64_t covariance_offset{0};
+    std::uint64_t covariance_stride{0};
+
+    /// SoaLayout of the attached planes; soa_offset is 0 if none.
+    std::uint32_t soa_layout{0};
+    std::uint64_t soa_offset{0};
+    std::uint64_t soa_stride{0};
+
+    /// OutputPrecision of the compact plane; compact_offset is 0 if none.
+    std::uint32_t precision{0};
+    std::uint64_t compact_offset{0};
+    std::uint64_t compact_stride{0};
+
+    /// Metres per count of a Fixed32Plane (0 otherwise).
+    double q32_scale_m{0.0};
+    std::uint64_t segment_bytes{0};
+
+    alignas(64) detail::PublisherShared shared{};
+};
+
+/**
+ * @brief Offsets of a segment with @p slots buffers (see the layout above).
+ */
+struct ShmLayout final
+{
+    std::size_t buffers_offset{0};
+    std::size_t buffer_stride{0};
+    std::size_t velocities_offset{0};
+    std::size_t plane_stride{0};
+    std::size_t inertial_offset{0};
+    std::size_t covariance_offset{0};
+    std::size_t covariance_stride{0};
+    std::size_t soa_offset{0};
+    std::size_t soa_stride{0};
+    std::size_t compact_offset{0};
+    std::size_t compact_stride{0};
+    std::size_t segment_bytes{0};
+};
+
+static_assert(sizeof(Float32Plane) == sizeof(Fixed32Plane),
+              "both compact planes share one block per slot");
+
+[[nodiscard]] constexpr std::size_t shm_align(std::size_t bytes) noexcept
+{
+    return (bytes + 63u) / 64u * 64u;
+}
+
+[[nodiscard]] constexpr ShmLayout shm_layout(std::size_t slots,
+                                             bool velocities,
+                                             bool soa,
+                                             bool compact,
+                                             bool inertial = false,
+                                             bool covariance = false) noexcept
+{
+    ShmLayout l{};
+    l.buffers_offset = shm_align(sizeof(ShmSegmentHeader));
+    l.buffer_stride = shm_align(sizeof(PredictionBuffer));
+    l.segment_bytes = l.buffers_offset + slots * l.buffer_stride;
+    if (velocities || inertial)
+    {
+        l.plane_stride = shm_align(sizeof(TrajectoryPlane));
+    }
+    if (velocities)
+    {
+        l.velocities_offset = l.segment_bytes;
+        l.segment_bytes += slots * l.plane_stride;
+    }
+    if (inertial)
+    {
+        l.inertial_offset = l.segment_bytes;
+        l.segment_bytes += slots * l.plane_stride;
+    }
+    if (covariance)
+    {
+        l.covariance_offset = l.segment_bytes;
+        l.covariance_stride = shm_align(sizeof(CovariancePlane));
+        l.segment_bytes += slots * l.covariance_stride;
+    }
+    if (soa)
+    {
+        l.soa_offset = l.segment_bytes;
+        l.soa_stride = shm_align(sizeof(SoaPositionPlanes));
+        l.segment_bytes += slots * l.soa_stride;
+    }
+    if (compact)
+    {
+        l.compact_offset = l.segment_bytes;
+        l.compact_stride = shm_align(sizeof(Float32Plane));
+        l.segment_bytes += slots * l.compact_stride;
+    }
+    return l;
+}
+
+/**
+ * @brief One in-place read of a shared-memory snapshot (see ShmSnapshotReader::begin_read()).
+ */
+struct ShmReadView final
+{
+    const PredictionBuffer* snapshot{nullptr};
+
+    /// Velocity plane of the snapshot, or nullptr if the segment has none.
+    const TrajectoryPlane* velocities{nullptr};
+
+    /// Inertial position plane of the snapshot, or nullptr if the segment has none.
+    const TrajectoryPlane* positions_i{nullptr};
+
+    /// Position covariance plane of the snapshot, or nullptr if the segment has none.
+    const CovariancePlane* position_cov{nullptr};
+
+    /// SoA planes of the snapshot, or nullptr if the segment has none.
+    const SoaPositionPlanes* soa{nullptr};
+
+    /// Reduced-precision plane of the snapshot (at most one is non-null).
+    const Float32Plane* positions_f32{nullptr};
+    const Fixed32Plane* positions_q32{nullptr};
+
+    std::size_t slot{0};
+    std::uint64_t version{0};
+};
+
+/**
+ * @brief Read-only view of a shared-memory Publisher segment from any process.
+ *
+ * Readers do not register leases (the mapping is read-only), so run the producer with
+ * PublisherConfig::slots >= 3 to give readers at least one full publish period before their
+ * buffer is rewritten; validate() reports the remaining case.
+ */
+class ShmSnapshotReader final
+{
+  public:
+    ShmSnapshotReader() = default;
+
+    /**
+     * @brief Map segment @p name and check its header against this build.
+     *
+     * @return kOk, a mapping error, kBadMagic (no live producer), kVersionMismatch, or
+     *         kLayoutMismatch; on failure the reader is closed.
+     */
+    [[nodiscard]] ShmCode open(const char* name) noexcept;
+
+    /// @brief Unmap (idempotent).
+    void close() noexcept;
+
+    [[nodiscard]] bool is_open() const noexcept { return hdr_ != nullptr; }
+
+    /**
+     * @brief Start reading the current front snapshot in place.
+     *
+     * @return false if not open, nothing is published yet, or the producer has exited.
+     */
+    [[nodiscard]] bool begin_read(ShmReadView& out) const noexcept;
+
+    /**
+     * @brief Seqlock validation: true iff the snapshot was not rewritten since begin_read().
+     *
+     * Call after reading; data read through a view that fails validation must be discarded.
+     */
+    [[nodiscard]] bool validate(const ShmReadView& view) const noexcept;
+
+    /// @return most recently published seqno (0 if none, or not open).
+    [[nodiscard]] std::uint64_t published_seqno() const noexcept;
+
+    /**
+     * @brief Block until the producer publishes a seqno > @p after (see
+     *        Publisher::wait_for_seqno()); a shared-memory producer wakes on every publish.
+     *
+     * @return The published seqno at return (0 if not open).
+     */
+    [[nodiscard]] std::uint64_t wait_for_seqno(std::uint64_t after,
+                                               double timeout_sec) const noexcept;
+
+    [[nodiscard]] std::size_t slots() const noexcept { return hdr_ ? hdr_->slots : 0u; }
+    [[nodiscard]] bool has_velocities() const noexcept
+    {
+        return hdr_ != nullptr && hdr_->has_velocities != 0u;
+    }
+    [[nodiscard]] bool has_inertial_positions() const noexcept
+    {
+        return hdr_ != nullptr && hdr_->has_inertial_positions != 0u;
+    }
+    [[nodiscard]] bool has_position_covariance() const noexcept
+    {
+        return hdr_ != nullptr && hdr_->has_position_covariance != 0u;
+    }
+
+  private:
+    ShmMapping map_{};
+    const ShmSegmentHeader* hdr_{nullptr};
+    const unsigned char* base_{nullptr};
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,86 @@
+#include "core/sized_publisher.hpp"
+
+namespace bullseye_pred
+{
+
+namespace
+{
+
+bool dims_valid(const PredictionDims& dims) noexcept
+{
+    return dims.vehicles > 0u && dims.steps > 0u &&
+           dims.vehicles <= static_cast<std::size_t>(-1) / sizeof(Vec3) / dims.steps;
+}
+
+} // namespace
+
+std::size_t SizedPublisher::required_bytes(const PredictionDims& dims) noexcept
+{
+    if (!dims_valid(dims))
+    {
+        return 0u;
+    }
+    const std::size_t plane = PredictionArena::block_bytes(dims.vehicles * dims.steps * sizeof(Vec3));
+    const std::size_t tau = PredictionArena::block_bytes(dims.steps * sizeof(double));
+    const std::size_t planes = dims.velocities ? 2u : 1u;
+    return kNumBuffers * (tau + planes * plane);
+}
+
+bool SizedPublisher::init(PredictionArena& arena, const PredictionDims& dims) noexcept
+{
+    if (ready_ || !dims_valid(dims) || !arena.valid() ||
+        arena.capacity() - arena.used() < required_bytes(dims))
+    {
+        return false;
+    }
+
+    const std::size_t cells = dims.vehicles * dims.steps;
+    for (std::size_t b = 0; b < kNumBuffers; ++b)
+    {
+        SizedPredictionBuffer& buf = buffers_[b];
+        buf.tau = Span<double>{arena.allocate_array<double>(dims.steps), dims.steps};
+        buf.positions =
+            Span2D<Vec3>{arena.allocate_array<Vec3>(cells), dims.vehicles, dims.steps, dims.steps};
+        if (dims.velocities)
+        {
+            buf.velocities = Span2D<Vec3>{arena.allocate_array<Vec3>(cells), dims.vehicles,
+                                          dims.steps, dims.steps};
+        }
+    }
+
+    dims_ = dims;
+    ready_ = true;
+    return true;
+}
+
+SizedPredictionBuffer& SizedPublisher::begin_write() noexcept
+{
+    const std::size_t front = front_index_.load(std::memory_order_acquire);
+    return buffers_[1u - front];
+}
+
+std::uint64_t SizedPublisher::publish(double t0) noexcept
+{
+    const std::size_t front = front_index_.load(std::memory_order_acquire);
+    const std::size_t back = 1u - front;
+
+    const std::uint64_t new_seq = seqno_.fetch_add(1u, std::memory_order_relaxed) + 1u;
+    buffers_[back].seqno = new_seq;
+    buffers_[back].t0 = t0;
+
+    // Release so all writes to buffers_[back] become visible to readers.
+    front_index_.store(back, std::memory_order_release);
+    return new_seq;
+}
+
+const SizedPredictionBuffer& SizedPublisher::read() const noexcept
+{
+    return buffers_[front_index_.load(std::memory_order_acquire)];
+}
+
+std::uint64_t SizedPublisher::published_seqno() const noexcept
+{
+    return read().seqno;
+}
+
+} // namespace bullseye_pred
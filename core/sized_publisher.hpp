@@ -0,0 +1,125 @@
+#pragma once
+/**
+ * @file sized_publisher.hpp
+ * @brief Double-buffer publisher whose snapshot dimensions are chosen at init.
+ *
+ * @details
+ * PredictionBuffer embeds MAX_VEHICLES x MAX_STEPS planes, so every Publisher buffer has the
+ * same footprint regardless of the scenario. SizedPublisher carves its buffers from a
+ * caller-provided PredictionArena with the dimensions the scenario actually needs (a few
+ * vehicles and steps, or more than MAX_VEHICLES rows). The fixed-size Publisher remains the
+ * default; this is opt-in.
+ *
+ * Publication semantics are the same as Publisher: single producer, begin_write() / fill /
+ * publish(t0), readers take read() with acquire ordering. No allocation after init().
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/prediction_arena.hpp"
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Snapshot dimensions for SizedPublisher.
+ */
+struct PredictionDims final
+{
+    /// Rows (vehicle indices) per snapshot. Must be > 0.
+    std::size_t vehicles{0};
+
+    /// Grid samples per row. Must be > 0.
+    std::size_t steps{0};
+
+    /// Also carve a velocity plane per buffer.
+    bool velocities{false};
+};
+
+/**
+ * @brief Runtime-sized prediction snapshot (views into arena storage).
+ *
+ * positions.row(i)[k] pairs with tau[k], as PredictionBuffer::positions[i][k]. The views span
+ * the full capacity; steps tells how many samples of each row the producer wrote.
+ */
+struct SizedPredictionBuffer final
+{
+    std::uint64_t seqno{0};
+    double t0{0.0};
+
+    /** @brief Grid samples written per row (<= positions.cols). */
+    std::size_t steps{0};
+
+    /** @brief Grid offsets from t0 [s] (capacity = dims.steps). */
+    Span<double> tau{};
+
+    /** @brief RIC positions [vehicle][step] (dims.vehicles x dims.steps). */
+    Span2D<Vec3> positions{};
+
+    /** @brief RIC velocities, same shape as positions; empty unless configured. */
+    Span2D<Vec3> velocities{};
+
+    [[nodiscard]] bool has_velocities() const noexcept { return velocities.data != nullptr; }
+};
+
+class SizedPublisher final
+{
+  public:
+    SizedPublisher() = default;
+
+    SizedPublisher(const SizedPublisher&) = delete;
+    SizedPublisher& operator=(const SizedPublisher&) = delete;
+
+    /**
+     * @brief Arena bytes init() consumes for @p dims.
+     */
+    [[nodiscard]] static std::size_t required_bytes(const PredictionDims& dims) noexcept;
+
+    /**
+     * @brief Carve both buffers from @p arena.
+     *
+     * The arena must outlive the publisher. May be called once.
+     *
+     * @return false (publisher unusable) if dims are invalid, init() already succeeded, or the
+     *         arena is too small; nothing is consumed from the arena in that case.
+     */
+    bool init(PredictionArena& arena, const PredictionDims& dims) noexcept;
+
+    /// @return true after a successful init().
+    [[nodiscard]] bool ready() const noexcept { return ready_; }
+
+    /// @return configured dimensions.
+    [[nodiscard]] const PredictionDims& dims() const noexcept { return dims_; }
+
+    /// @return reference to the writable back buffer (requires ready()).
+    SizedPredictionBuffer& begin_write() noexcept;
+
+    /**
+     * @brief Publish the back buffer as the new front snapshot.
+     *
+     * @param t0 Epoch time for this prediction snapshot.
+     * @return The new published seqno.
+     */
+    std::uint64_t publish(double t0) noexcept;
+
+    /// @return current immutable front snapshot (acquire).
+    const SizedPredictionBuffer& read() const noexcept;
+
+    /// @return most recently published seqno (acquire).
+    std::uint64_t published_seqno() const noexcept;
+
+  private:
+    static constexpr std::size_t kNumBuffers = 2;
+
+    SizedPredictionBuffer buffers_[kNumBuffers]{};
+    std::atomic<std::size_t> front_index_{0};
+    std::atomic<std::uint64_t> seqno_{0};
+    PredictionDims dims_{};
+    bool ready_{false};
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,895 @@
+#include "core/snapshot_recorder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BULLSEYE_HAVE_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace bullseye_pred
+{
+
+namespace
+{
+
+constexpr std::uint64_t align8(std::uint64_t bytes) noexcept
+{
+    return (bytes + 7u) / 8u * 8u;
+}
+
+std::size_t popcount(RowMask m) noexcept
+{
+    std::size_t n = 0;
+    for (; m != 0u; m &= m - 1u)
+    {
+        ++n;
+    }
+    return n;
+}
+
+// Bytes of the columns before the planes (tau through row_status).
+std::uint64_t prefix_bytes(std::uint64_t snapshots, std::uint64_t steps) noexcept
+{
+    return steps * sizeof(double) + snapshots * 5u * sizeof(std::uint64_t) +
+           snapshots * kRecordingStatusBytes;
+}
+
+// Raw (uncompressed) body size of a chunk; see the column order in snapshot_recorder.hpp.
+std::uint64_t body_bytes(std::uint64_t snapshots,
+                         std::uint64_t steps,
+                         std::uint64_t rows,
+                         bool velocities) noexcept
+{
+    const std::uint64_t planes = rows * (velocities ? 6u : 3u);
+    return prefix_bytes(snapshots, steps) + planes * snapshots * steps * sizeof(double);
+}
+
+// kXorShuffle: XOR each 8-byte word with its predecessor, split into 8 byte planes, then code
+// runs. Token t < 0x80: t + 1 literal bytes follow; t >= 0x80: t - 0x7F zero bytes.
+void xor_shuffle_encode(const unsigned char* raw,
+                        std::size_t bytes,
+                        std::vector<unsigned char>& shuffled,
+                        std::vector<unsigned char>& out)
+{
+    const std::size_t words = bytes / 8u;
+    shuffled.resize(bytes);
+    std::uint64_t prev = 0;
+    for (std::size_t w = 0; w < words; ++w)
+    {
+        std::uint64_t v = 0;
+        std::memcpy(&v, raw + w * 8u, 8u);
+        const std::uint64_t d = v ^ prev;
+        prev = v;
+        for (std::size_t b = 0; b < 8u; ++b)
+        {
+            shuffled[b * words + w] = static_cast<unsigned char>(d >> (8u * b));
+        }
+    }
+
+    out.clear();
+    out.reserve(bytes / 2u + 16u);
+    std::size_t i = 0;
+    while (i < bytes)
+    {
+        if (shuffled[i] == 0u)
+        {
+            std::size_t run = 1;
+            while (run < 128u && i + run < bytes && shuffled[i + run] == 0u)
+            {
+                ++run;
+            }
+            out.push_back(static_cast<unsigned char>(0x7Fu + run));
+            i += run;
+            continue;
+        }
+        // Literals up to the next pair of zeros (a lone zero is cheaper inline).
+        std::size_t run = 1;
+        while (run < 128u && i + run < bytes &&
+               !(shuffled[i + run] == 0u && i + run + 1u < bytes && shuffled[i + run + 1u] == 0u))
+        {
+            ++run;
+        }
+        out.push_back(static_cast<unsigned char>(run - 1u));
+        out.insert(out.end(), shuffled.begin() + static_cast<std::ptrdiff_t>(i),
+                   shuffled.begin() + static_cast<std::ptrdiff_t>(i + run));
+        i += run;
+    }
+}
+
+bool xor_shuffle_decode(const unsigned char* in,
+                        std::size_t in_bytes,
+                        std::size_t bytes,
+                        std::vector<unsigned char>& shuffled,
+                        std::vector<unsigned char>& out)
+{
+    shuffled.resize(bytes);
+    std::size_t o = 0;
+    std::size_t i = 0;
+    while (i < in_bytes && o < bytes)
+    {
+        const unsigned char t = in[i++];
+        if (t >= 0x80u)
+        {
+            const std::size_t run = t - 0x7Fu;
+            if (run > bytes - o)
+            {
+                return false;
+            }
+            std::memset(shuffled.data() + o, 0, run);
+            o += run;
+        }
+        else
+        {
+            const std::size_t run = t + 1u;
+            if (run > bytes - o || run > in_bytes - i)
+            {
+                return false;
+            }
+            std::memcpy(shuffled.data() + o, in + i, run);
+            o += run;
+            i += run;
+        }
+    }
+    if (o != bytes)
+    {
+        return false;
+    }
+
+    const std::size_t words = bytes / 8u;
+    out.resize(bytes);
+    std::uint64_t prev = 0;
+    for (std::size_t w = 0; w < words; ++w)
+    {
+        std::uint64_t d = 0;
+        for (std::size_t b = 0; b < 8u; ++b)
+        {
+            d |= static_cast<std::uint64_t>(shuffled[b * words + w]) << (8u * b);
+        }
+        prev ^= d;
+        std::memcpy(out.data() + w * 8u, &prev, 8u);
+    }
+    return true;
+}
+
+bool write_all(std::FILE* f, const void* data, std::size_t bytes) noexcept
+{
+    return bytes == 0u || std::fwrite(data, 1, bytes, f) == bytes;
+}
+
+} // namespace
+
+SnapshotRecorder::SnapshotRecorder(const Publisher& publisher, const SnapshotRecorderConfig& config)
+    : pub_(publisher), config_(config)
+{
+}
+
+SnapshotRecorder::~SnapshotRecorder()
+{
+    stop();
+}
+
+RecordingCode SnapshotRecorder::start(const char* path)
+{
+    if (path == nullptr || running_ || config_.chunk_snapshots == 0u ||
+        (config_.compression == RecordingCompression::kChebyshev &&
+         (!(config_.chebyshev_tolerance_m >= 0.0) || !(config_.chebyshev_tolerance_mps >= 0.0))))
+    {
+        return RecordingCode::kInvalidInput;
+    }
+
+    velocities_ = config_.velocities && pub_.has_velocities();
+    axes_ = velocities_ ? 6u : 3u;
+    const std::size_t n = config_.chunk_snapshots;
+    try
+    {
+        plane_len_ = n * MAX_STEPS;
+        planes_.assign(MAX_VEHICLES * axes_ * plane_len_, 0.0);
+        tau_.assign(MAX_STEPS, 0.0);
+        seqno_.assign(n, 0u);
+        t0_.assign(n, 0.0);
+        valid_.assign(n, 0u);
+        dirty_.assign(n, 0u);
+        deferred_.assign(n, 0u);
+        status_.assign(n * kRecordingStatusBytes, 0u);
+        if (config_.compression == RecordingCompression::kXorShuffle)
+        {
+            const std::size_t most =
+                static_cast<std::size_t>(body_bytes(n, MAX_STEPS, MAX_VEHICLES, velocities_));
+            raw_.reserve(most);
+            shuffled_.reserve(most);
+            packed_.reserve(most / 2u);
+        }
+        else if (config_.compression == RecordingCompression::kChebyshev)
+        {
+            packed_.reserve(static_cast<std::size_t>(
+                body_bytes(n, MAX_STEPS, MAX_VEHICLES, velocities_) / 8u));
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        return RecordingCode::kAllocFailed;
+    }
+
+    file_ = std::fopen(path, "wb");
+    if (file_ == nullptr)
+    {
+        return RecordingCode::kOpenFailed;
+    }
+    RecordingFileHeader hdr{};
+    hdr.magic = kRecordingMagic;
+    hdr.format_version = kRecordingFormatVersion;
+    hdr.header_bytes = sizeof(RecordingFileHeader);
+    hdr.chunk_header_bytes = sizeof(RecordingChunkHeader);
+    hdr.max_vehicles = static_cast<std::uint32_t>(MAX_VEHICLES);
+    hdr.max_steps = static_cast<std::uint32_t>(MAX_STEPS);
+    hdr.status_bytes = static_cast<std::uint32_t>(kRecordingStatusBytes);
+    if (!write_all(file_, &hdr, sizeof(hdr)) || std::fflush(file_) != 0)
+    {
+        std::fclose(file_);
+        file_ = nullptr;
+        return RecordingCode::kOpenFailed;
+    }
+
+    n_ = 0;
+    row_mask_ = 0;
+    recorded_.store(0, std::memory_order_relaxed);
+    missed_.store(0, std::memory_order_relaxed);
+    torn_.store(0, std::memory_order_relaxed);
+    chunks_.store(0, std::memory_order_relaxed);
+    bytes_written_.store(sizeof(hdr), std::memory_order_relaxed);
+    write_errors_.store(0, std::memory_order_relaxed);
+
+    // Start at the current front so the first recorded snapshot is the one consumers see now.
+    const std::uint64_t front = pub_.published_seqno();
+    done_seqno_.store(front > 0u ? front - 1u : 0u, std::memory_order_release);
+
+    stop_.store(false, std::memory_order_relaxed);
+    running_ = true;
+    thread_ = std::thread([this] { thread_main_(); });
+    return RecordingCode::kOk;
+}
+
+void SnapshotRecorder::stop() noexcept
+{
+    if (!running_)
+    {
+        return;
+    }
+    stop_.store(true, std::memory_order_release);
+    if (thread_.joinable())
+    {
+        thread_.join();
+    }
+    flush_chunk_();
+    std::fclose(file_);
+    file_ = nullptr;
+    running_ = false;
+}
+
+bool SnapshotRecorder::wait_caught_up(double timeout_sec) const noexcept
+{
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::duration<double>(timeout_sec);
+    while (done_seqno_.load(std::memory_order_acquire) < pub_.published_seqno())
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return true;
+}
+
+SnapshotRecorderStats SnapshotRecorder::stats() const noexcept
+{
+    SnapshotRecorderStats s{};
+    s.recorded = recorded_.load(std::memory_order_relaxed);
+    s.missed = missed_.load(std::memory_order_relaxed);
+    s.torn = torn_.load(std::memory_order_relaxed);
+    s.chunks = chunks_.load(std::memory_order_relaxed);
+    s.bytes_written = bytes_written_.load(std::memory_order_relaxed);
+    s.write_errors = write_errors_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void SnapshotRecorder::thread_main_() noexcept
+{
+    std::uint64_t done = done_seqno_.load(std::memory_order_relaxed);
+    bool last_pass = false;
+    while (!last_pass)
+    {
+        // One more sweep after stop() so everything published before it is recorded.
+        last_pass = stop_.load(std::memory_order_acquire);
+        const std::uint64_t latest =
+            last_pass ? pub_.published_seqno() : pub_.wait_for_seqno(done, config_.poll_sec);
+
+        for (std::uint64_t s = done + 1u; s <= latest; ++s)
+        {
+            SnapshotLease lease = pub_.acquire_seqno(s);
+            if (!lease.held())
+            {
+                missed_.fetch_add(1u, std::memory_order_relaxed);
+            }
+            else
+            {
+                if (!fits_chunk_(*lease))
+                {
+                    flush_chunk_();
+                }
+                stage_(*lease);
+                if (lease.valid())
+                {
+                    valid_[n_] = lease->valid_rows;
+                    row_mask_ |= lease->valid_rows;
+                    if (n_ == 0u)
+                    {
+                        steps_ = std::min(lease->steps, MAX_STEPS);
+                    }
+                    ++n_;
+                    recorded_.fetch_add(1u, std::memory_order_relaxed);
+                }
+                else
+                {
+                    torn_.fetch_add(1u, std::memory_order_relaxed);
+                }
+            }
+            lease.release();
+            done = s;
+            done_seqno_.store(s, std::memory_order_release);
+            if (n_ == config_.chunk_snapshots)
+            {
+                flush_chunk_();
+            }
+        }
+    }
+}
+
+bool SnapshotRecorder::fits_chunk_(const PredictionBuffer& buf) const noexcept
+{
+    return n_ == 0u ||
+           (std::min(buf.steps, MAX_STEPS) == steps_ &&
+            std::memcmp(tau_.data(), buf.tau.data(), steps_ * sizeof(double)) == 0);
+}
+
+void SnapshotRecorder::stage_(const PredictionBuffer& buf) noexcept
+{
+    const std::size_t steps = std::min(buf.steps, MAX_STEPS);
+    const std::size_t j = n_;
+    if (j == 0u)
+    {
+        std::memcpy(tau_.data(), buf.tau.data(), steps * sizeof(double));
+    }
+    seqno_[j] = buf.seqno;
+    t0_[j] = buf.t0;
+    dirty_[j] = buf.dirty_rows;
+    deferred_[j] = buf.deferred_rows;
+    std::memcpy(status_.data() + j * kRecordingStatusBytes, buf.row_status.data(),
+                MAX_VEHICLES * sizeof(RowStatus));
+
+    // Transpose valid rows into the chunk's column planes, straight from the leased slot.
+    const std::size_t off = j * steps;
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        if ((buf.valid_rows & (RowMask{1} << i)) == 0u)
+        {
+            continue;
+        }
+        const Vec3* p = buf.positions[i].data();
+        double* x = plane_(i, 0) + off;
+        double* y = plane_(i, 1) + off;
+        double* z = plane_(i, 2) + off;
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            x[k] = p[k].x;
+            y[k] = p[k].y;
+            z[k] = p[k].z;
+        }
+        if (velocities_ && buf.velocities != nullptr)
+        {
+            const Vec3* v = (*buf.velocities)[i].data();
+            double* vx = plane_(i, 3) + off;
+            double* vy = plane_(i, 4) + off;
+            double* vz = plane_(i, 5) + off;
+            for (std::size_t k = 0; k < steps; ++k)
+            {
+                vx[k] = v[k].x;
+                vy[k] = v[k].y;
+                vz[k] = v[k].z;
+            }
+        }
+    }
+}
+
+void SnapshotRecorder::flush_chunk_() noexcept
+{
+    if (n_ == 0u || file_ == nullptr)
+    {
+        n_ = 0;
+        row_mask_ = 0;
+        return;
+    }
+
+    const std::size_t n = n_;
+    const std::size_t steps = steps_;
+    const std::size_t rows = popcount(row_mask_);
+
+    // Rows stored for the chunk but not valid in a snapshot read as NaN, not stale samples.
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        const RowMask stale = row_mask_ & ~valid_[j];
+        for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+        {
+            if ((stale & (RowMask{1} << i)) == 0u)
+            {
+                continue;
+            }
+            for (std::size_t a = 0; a < axes_; ++a)
+            {
+                std::fill_n(plane_(i, a) + j * steps, steps, nan);
+            }
+        }
+    }
+
+    RecordingChunkHeader hdr{};
+    hdr.magic = kRecordingChunkMagic;
+    hdr.snapshots = static_cast<std::uint32_t>(n);
+    hdr.steps = static_cast<std::uint32_t>(steps);
+    hdr.row_mask = row_mask_;
+    hdr.velocities = velocities_ ? 1u : 0u;
+    hdr.compression = static_cast<std::uint32_t>(config_.compression);
+    hdr.first_seqno = seqno_[0];
+    hdr.last_seqno = seqno_[n - 1u];
+    hdr.first_t0 = t0_[0];
+    hdr.last_t0 = t0_[n - 1u];
+    hdr.body_bytes = body_bytes(n, steps, rows, velocities_);
+
+    // Column pieces in body order: the uncompressed path writes them straight from staging.
+    struct Piece final
+    {
+        const void* data;
+        std::size_t bytes;
+    };
+    std::vector<Piece> pieces;
+    try
+    {
+        pieces.reserve(8u + rows * axes_);
+        pieces.push_back({tau_.data(), steps * sizeof(double)});
+        pieces.push_back({seqno_.data(), n * sizeof(std::uint64_t)});
+        pieces.push_back({t0_.data(), n * sizeof(double)});
+        pieces.push_back({valid_.data(), n * sizeof(std::uint64_t)});
+        pieces.push_back({dirty_.data(), n * sizeof(std::uint64_t)});
+        pieces.push_back({deferred_.data(), n * sizeof(std::uint64_t)});
+        pieces.push_back({status_.data(), n * kRecordingStatusBytes});
+        for (std::size_t a0 = 0; a0 < axes_; a0 += 3u)
+        {
+            for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+            {
+                if ((row_mask_ & (RowMask{1} << i)) == 0u)
+                {
+                    continue;
+                }
+                for (std::size_t a = a0; a < a0 + 3u; ++a)
+                {
+                    pieces.push_back({plane_(i, a), n * steps * sizeof(double)});
+                }
+            }
+        }
+
+        if (config_.compression == RecordingCompression::kXorShuffle)
+        {
+            raw_.clear();
+            for (const Piece& p : pieces)
+            {
+                const auto* b = static_cast<const unsigned char*>(p.data);
+                raw_.insert(raw_.end(), b, b + p.bytes);
+            }
+            xor_shuffle_encode(raw_.data(), raw_.size(), shuffled_, packed_);
+            pieces.assign(1u, Piece{packed_.data(), packed_.size()});
+            hdr.stored_bytes = align8(packed_.size());
+        }
+        else if (config_.compression == RecordingCompression::kChebyshev)
+        {
+            // Leading columns as is, then the series table and one series per plane triple.
+            const std::size_t groups = axes_ / 3u;
+            const std::size_t series = groups * rows * n;
+            packed_.clear();
+            for (std::size_t p = 0; p < 7u; ++p)
+            {
+                const auto* b = static_cast<const unsigned char*>(pieces[p].data);
+                packed_.insert(packed_.end(), b, b + pieces[p].bytes);
+            }
+            const std::size_t table = packed_.size();
+            packed_.resize(table + (series + 1u) * sizeof(std::uint64_t));
+            const std::size_t first = packed_.size();
+            const Span<const double> tau{tau_.data(), steps};
+            std::size_t s = 0;
+            for (std::size_t g = 0; g < groups; ++g)
+            {
+                ChebyshevFitConfig fit{};
+                fit.tolerance =
+                    (g == 0u) ? config_.chebyshev_tolerance_m : config_.chebyshev_tolerance_mps;
+                fit.max_degree = config_.chebyshev_max_degree;
+                for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+                {
+                    if ((row_mask_ & (RowMask{1} << i)) == 0u)
+                    {
+                        continue;
+                    }
+                    for (std::size_t j = 0; j < n; ++j, ++s)
+                    {
+                        const std::uint64_t at = packed_.size() - first;
+                        std::memcpy(packed_.data() + table + s * sizeof(at), &at, sizeof(at));
+                        const double* axes[3] = {plane_(i, 3u * g) + j * steps,
+                                                 plane_(i, 3u * g + 1u) + j * steps,
+                                                 plane_(i, 3u * g + 2u) + j * steps};
+                        (void)chebyshev_.encode(tau, axes, 3u, fit, packed_);
+                    }
+                }
+            }
+            const std::uint64_t end = packed_.size() - first;
+            std::memcpy(packed_.data() + table + series * sizeof(end), &end, sizeof(end));
+            pieces.assign(1u, Piece{packed_.data(), packed_.size()});
+            hdr.stored_bytes = align8(packed_.size());
+            hdr.position_tolerance = config_.chebyshev_tolerance_m;
+            hdr.velocity_tolerance = velocities_ ? config_.chebyshev_tolerance_mps : 0.0;
+        }
+        else
+        {
+            hdr.stored_bytes = hdr.body_bytes;
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        write_errors_.fetch_add(1u, std::memory_order_relaxed);
+        n_ = 0;
+        row_mask_ = 0;
+        return;
+    }
+
+    std::uint64_t payload = 0;
+    bool ok = write_all(file_, &hdr, sizeof(hdr));
+    for (const Piece& p : pieces)
+    {
+        ok = ok && write_all(file_, p.data, p.bytes);
+        payload += p.bytes;
+    }
+    static const unsigned char zeros[8] = {};
+    ok = ok && write_all(file_, zeros, static_cast<std::size_t>(hdr.stored_bytes - payload));
+    // Make the chunk visible to readers mapping the file while recording continues.
+    ok = (std::fflush(file_) == 0) && ok;
+    if (ok)
+    {
+        chunks_.fetch_add(1u, std::memory_order_relaxed);
+        bytes_written_.fetch_add(sizeof(hdr) + hdr.stored_bytes, std::memory_order_relaxed);
+    }
+    else
+    {
+        write_errors_.fetch_add(1u, std::memory_order_relaxed);
+    }
+    n_ = 0;
+    row_mask_ = 0;
+}
+
+Span<const double> RecordedSnapshot::series_(std::size_t i, std::size_t plane) const noexcept
+{
+    if (i >= MAX_VEHICLES || (row_mask & (RowMask{1} << i)) == 0u ||
+        (plane >= 3u && !has_velocities))
+    {
+        return {};
+    }
+    const std::size_t rank = popcount(row_mask & ((RowMask{1} << i) - 1u));
+    const std::size_t index = (plane < 3u) ? rank * 3u + plane
+                                           : popcount(row_mask) * 3u + rank * 3u + (plane - 3u);
+    return {planes_ + (index * chunk_snapshots_ + index_) * steps, steps};
+}
+
+Span<const double> RecordedSnapshot::positions(std::size_t i, RicAxis axis) const noexcept
+{
+    return series_(i, static_cast<std::size_t>(axis));
+}
+
+Span<const double> RecordedSnapshot::velocities(std::size_t i, RicAxis axis) const noexcept
+{
+    return series_(i, 3u + static_cast<std::size_t>(axis));
+}
+
+RecordingReader::~RecordingReader()
+{
+    close();
+}
+
+#if defined(BULLSEYE_HAVE_MMAP)
+
+RecordingCode RecordingReader::open(const char* path)
+{
+    close();
+    if (path == nullptr)
+    {
+        return RecordingCode::kInvalidInput;
+    }
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return RecordingCode::kOpenFailed;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(RecordingFileHeader)))
+    {
+        ::close(fd);
+        return RecordingCode::kLayoutMismatch;
+    }
+    const auto bytes = static_cast<std::size_t>(st.st_size);
+    void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+    {
+        return RecordingCode::kMapFailed;
+    }
+    base_ = p;
+    bytes_ = bytes;
+
+    const auto* hdr = static_cast<const RecordingFileHeader*>(p);
+    RecordingCode code = RecordingCode::kOk;
+    if (hdr->magic != kRecordingMagic)
+    {
+        code = RecordingCode::kBadMagic;
+    }
+    else if (hdr->format_version != kRecordingFormatVersion)
+    {
+        code = RecordingCode::kVersionMismatch;
+    }
+    else if (hdr->header_bytes != sizeof(RecordingFileHeader) ||
+             hdr->chunk_header_bytes != sizeof(RecordingChunkHeader) ||
+             hdr->max_vehicles != MAX_VEHICLES || hdr->max_steps != MAX_STEPS ||
+             hdr->status_bytes != kRecordingStatusBytes)
+    {
+        code = RecordingCode::kLayoutMismatch;
+    }
+    if (code != RecordingCode::kOk)
+    {
+        close();
+        return code;
+    }
+
+    // Index complete chunks; stop at the first one that is torn or still being written.
+    const auto* base = static_cast<const unsigned char*>(p);
+    std::size_t off = sizeof(RecordingFileHeader);
+    while (bytes - off >= sizeof(RecordingChunkHeader))
+    {
+        const auto* ch = reinterpret_cast<const RecordingChunkHeader*>(base + off);
+        const std::size_t left = bytes - off - sizeof(RecordingChunkHeader);
+        const bool velocities = ch->velocities != 0u;
+        if (ch->magic != kRecordingChunkMagic || ch->snapshots == 0u || ch->steps > MAX_STEPS ||
+            (ch->row_mask & ~kAllRows) != 0u || ch->stored_bytes > left ||
+            ch->stored_bytes % 8u != 0u ||
+            ch->body_bytes !=
+                body_bytes(ch->snapshots, ch->steps, popcount(ch->row_mask), velocities) ||
+            (ch->compression == static_cast<std::uint32_t>(RecordingCompression::kNone) &&
+             ch->stored_bytes != ch->body_bytes) ||
+            ch->compression > static_cast<std::uint32_t>(RecordingCompression::kChebyshev))
+        {
+            break;
+        }
+        chunks_.push_back(Chunk{ch, base + off + sizeof(RecordingChunkHeader), snapshots_});
+        snapshots_ += ch->snapshots;
+        off += sizeof(RecordingChunkHeader) + static_cast<std::size_t>(ch->stored_bytes);
+    }
+    return RecordingCode::kOk;
+}
+
+void RecordingReader::close() noexcept
+{
+    if (base_ != nullptr)
+    {
+        (void)::munmap(base_, bytes_);
+    }
+    base_ = nullptr;
+    bytes_ = 0;
+    chunks_.clear();
+    snapshots_ = 0;
+    cached_chunk_ = static_cast<std::size_t>(-1);
+}
+
+#else
+
+RecordingCode RecordingReader::open(const char*)
+{
+    close();
+    return RecordingCode::kUnsupported;
+}
+
+void RecordingReader::close() noexcept
+{
+    base_ = nullptr;
+    bytes_ = 0;
+    chunks_.clear();
+    snapshots_ = 0;
+    cached_chunk_ = static_cast<std::size_t>(-1);
+}
+
+#endif
+
+const unsigned char* RecordingReader::body_(std::size_t c)
+{
+    const Chunk& ch = chunks_[c];
+    if (ch.hdr->compression == static_cast<std::uint32_t>(RecordingCompression::kNone))
+    {
+        return ch.stored;
+    }
+    if (cached_chunk_ != c)
+    {
+        cached_chunk_ = static_cast<std::size_t>(-1);
+        const bool ok =
+            (ch.hdr->compression == static_cast<std::uint32_t>(RecordingCompression::kChebyshev))
+                ? decode_chebyshev_(ch)
+                : xor_shuffle_decode(ch.stored, static_cast<std::size_t>(ch.hdr->stored_bytes),
+                                     static_cast<std::size_t>(ch.hdr->body_bytes), scratch_,
+                                     cache_);
+        if (!ok)
+        {
+            return nullptr;
+        }
+        cached_chunk_ = c;
+    }
+    return cache_.data();
+}
+
+bool RecordingReader::decode_chebyshev_(const Chunk& ch)
+{
+    const RecordingChunkHeader& h = *ch.hdr;
+    const std::size_t n = h.snapshots;
+    const std::size_t steps = h.steps;
+    const std::size_t rows = popcount(h.row_mask);
+    const std::size_t groups = (h.velocities != 0u) ? 2u : 1u;
+    const std::size_t series = groups * rows * n;
+    const auto prefix = static_cast<std::size_t>(prefix_bytes(n, steps));
+    const auto stored = static_cast<std::size_t>(h.stored_bytes);
+    const std::size_t table_bytes = (series + 1u) * sizeof(std::uint64_t);
+    if (stored < prefix + table_bytes)
+    {
+        return false;
+    }
+    const unsigned char* table = ch.stored + prefix;
+    const unsigned char* first = table + table_bytes;
+    const std::size_t avail = stored - prefix - table_bytes;
+
+    cache_.resize(static_cast<std::size_t>(h.body_bytes));
+    std::memcpy(cache_.data(), ch.stored, prefix);
+    const Span<const double> tau{reinterpret_cast<const double*>(cache_.data()), steps};
+    auto* planes = reinterpret_cast<double*>(cache_.data() + prefix);
+
+    // Series s = (group * rows + rank) * n + j fills planes (group * rows + rank) * 3 + axis.
+    for (std::size_t s = 0; s < series; ++s)
+    {
+        std::uint64_t lo = 0;
+        std::uint64_t hi = 0;
+        std::memcpy(&lo, table + s * sizeof(lo), sizeof(lo));
+        std::memcpy(&hi, table + (s + 1u) * sizeof(hi), sizeof(hi));
+        if (lo > hi || hi > avail || lo % 8u != 0u)
+        {
+            return false;
+        }
+        const std::size_t triple = s / n;
+        const std::size_t j = s % n;
+        double* out[3];
+        for (std::size_t a = 0; a < 3u; ++a)
+        {
+            out[a] = planes + ((triple * 3u + a) * n + j) * steps;
+        }
+        if (!chebyshev_series_decode(first + lo, static_cast<std::size_t>(hi - lo), tau, out, 3u))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RecordingReader::view_(std::size_t c, std::size_t j, RecordedSnapshot& out)
+{
+    const unsigned char* body = body_(c);
+    if (body == nullptr)
+    {
+        return false;
+    }
+    const RecordingChunkHeader& h = *chunks_[c].hdr;
+    const std::size_t n = h.snapshots;
+    const std::size_t steps = h.steps;
+
+    const auto* tau = reinterpret_cast<const double*>(body);
+    const auto* seqno = reinterpret_cast<const std::uint64_t*>(tau + steps);
+    const auto* t0 = reinterpret_cast<const double*>(seqno + n);
+    const auto* valid = reinterpret_cast<const std::uint64_t*>(t0 + n);
+    const auto* dirty = valid + n;
+    const auto* deferred = dirty + n;
+    const auto* status = reinterpret_cast<const std::uint8_t*>(deferred + n);
+
+    out = RecordedSnapshot{};
+    out.seqno = seqno[j];
+    out.t0 = t0[j];
+    out.steps = steps;
+    out.valid_rows = valid[j];
+    out.dirty_rows = dirty[j];
+    out.deferred_rows = deferred[j];
+    out.tau = {tau, steps};
+    out.row_status = status + j * kRecordingStatusBytes;
+    out.row_mask = h.row_mask;
+    out.has_velocities = h.velocities != 0u;
+    out.position_tolerance = h.position_tolerance;
+    out.velocity_tolerance = h.velocity_tolerance;
+    out.planes_ = reinterpret_cast<const double*>(status + n * kRecordingStatusBytes);
+    out.chunk_snapshots_ = n;
+    out.index_ = j;
+    return true;
+}
+
+bool RecordingReader::at(std::size_t index, RecordedSnapshot& out)
+{
+    if (index >= snapshots_)
+    {
+        return false;
+    }
+    const auto it = std::upper_bound(chunks_.begin(), chunks_.end(), index,
+                                     [](std::size_t v, const Chunk& c) { return v < c.first_index; });
+    const auto c = static_cast<std::size_t>(it - chunks_.begin()) - 1u;
+    return view_(c, index - chunks_[c].first_index, out);
+}
+
+bool RecordingReader::find_seqno(std::uint64_t seqno, RecordedSnapshot& out)
+{
+    // Seqnos increase through the file; gaps (missed or torn snapshots) are not recorded.
+    const auto it = std::lower_bound(
+        chunks_.begin(), chunks_.end(), seqno,
+        [](const Chunk& c, std::uint64_t v) { return c.hdr->last_seqno < v; });
+    if (it == chunks_.end() || it->hdr->first_seqno > seqno)
+    {
+        return false;
+    }
+    const auto c = static_cast<std::size_t>(it - chunks_.begin());
+    if (!view_(c, 0u, out))
+    {
+        return false;
+    }
+    const std::size_t steps = it->hdr->steps;
+    const auto* col = reinterpret_cast<const std::uint64_t*>(out.tau.data + steps);
+    const auto* end = col + it->hdr->snapshots;
+    const auto* hit = std::lower_bound(col, end, seqno);
+    return hit != end && *hit == seqno && view_(c, static_cast<std::size_t>(hit - col), out);
+}
+
+bool RecordingReader::find_time(double t0, RecordedSnapshot& out)
+{
+    if (std::isnan(t0))
+    {
+        return false;
+    }
+    // Last chunk starting at or before t0, then the last snapshot in it with t0 <= t0.
+    const auto it = std::upper_bound(chunks_.begin(), chunks_.end(), t0,
+                                     [](double v, const Chunk& c) { return v < c.hdr->first_t0; });
+    if (it == chunks_.begin())
+    {
+        return false;
+    }
+    const auto c = static_cast<std::size_t>(it - chunks_.begin()) - 1u;
+    if (!view_(c, 0u, out))
+    {
+        return false;
+    }
+    const std::size_t n = chunks_[c].hdr->snapshots;
+    const auto* col = reinterpret_cast<const double*>(
+        reinterpret_cast<const std::uint64_t*>(out.tau.data + chunks_[c].hdr->steps) + n);
+    const auto* hit = std::upper_bound(col, col + n, t0);
+    return view_(c, static_cast<std::size_t>(hit - col) - 1u, out);
+}
+
+} // namespace bullseye_pred
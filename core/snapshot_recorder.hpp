@@ -0,0 +1,417 @@
+#pragma once
+/**
+ * @file snapshot_recorder.hpp
+ * @brief Background recorder of published snapshots into a chunked, columnar binary file,
+ *        and a memory-mapped reader with random access by seqno or t0.
+ *
+ * @details
+ * SnapshotRecorder subscribes to a Publisher from its own thread: it blocks in
+ * wait_for_seqno(), leases each new snapshot in place (Publisher::acquire_seqno(), so nothing
+ * is copied on the producer side and publish() never waits), and transposes it into a staged
+ * chunk. A lease that fails validation (the producer lapped the recorder) drops that snapshot
+ * and counts it as torn; seqnos the history ring no longer holds are counted as missed. Give
+ * the publisher PublisherConfig::history >= 2 so the recorder can catch up after a chunk write.
+ *
+ * File layout (append-only, native byte order, 8-byte aligned):
+ *
+ *   [0]   RecordingFileHeader
+ *   then  chunks: RecordingChunkHeader, body (stored_bytes, possibly compressed)
+ *
+ * A chunk holds up to SnapshotRecorderConfig::chunk_snapshots snapshots that share one grid
+ * (steps and tau). Its raw body is columnar:
+ *
+ *   tau[steps]
+ *   seqno[n], t0[n], valid_rows[n], dirty_rows[n], deferred_rows[n]
+ *   row_status[n][kRecordingStatusBytes]
+ *   for each row in row_mask (ascending): x[n][steps], y[n][steps], z[n][steps]
+ *   (with velocities) for each row in row_mask: vx[n][steps], vy[n][steps], vz[n][steps]
+ *
+ * so one vehicle axis over a whole chunk is one contiguous run of doubles. row_mask is the
+ * union of valid_rows over the chunk; rows outside it are not stored. Rows are recorded on the
+ * snapshot's profile-0 grid (steps, tau).
+ *
+ * RecordingCompression::kXorShuffle XORs every 8-byte word of the body with its predecessor,
+ * splits the result into byte planes and run-length encodes zero bytes. Smooth trajectories
+ * leave mostly zero high bytes, so this typically halves the file without a codec dependency.
+ *
+ * RecordingCompression::kChebyshev is lossy: the planes are replaced by one encoded series per
+ * (velocity group, row, snapshot) in the same order, piecewise Chebyshev polynomials that
+ * reproduce every sample within the chunk's declared position_tolerance / velocity_tolerance
+ * (chebyshev_series.hpp). After row_status the body then holds
+ *
+ *   series_offset[series + 1]   byte offsets of each series from the first one
+ *   the encoded series
+ *
+ * Smooth rows shrink 10-50x at millimetre tolerance. The reader rebuilds the planes, and
+ * consumers that only need a few offsets can evaluate the series in place instead.
+ *
+ * The reader maps the file once; uncompressed chunks are read in place, compressed ones are
+ * decoded into a one-chunk cache on first access. A file still being recorded can be opened at
+ * any time: a partially written last chunk is ignored.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "core/chebyshev_series.hpp"
+#include "core/constants.hpp"
+#include "core/prediction_buffer.hpp"
+#include "core/publisher.hpp"
+
+namespace bullseye_pred
+{
+
+/// "BEYREC01" as a little-endian integer.
+inline constexpr std::uint64_t kRecordingMagic = 0x3130434552594542ull;
+
+/// "BEYCHNK1": marks the start of every chunk.
+inline constexpr std::uint64_t kRecordingChunkMagic = 0x314B4E4843594542ull;
+
+/// Bumped whenever the file header, chunk header or column order changes shape.
+inline constexpr std::uint32_t kRecordingFormatVersion = 2;
+
+/// Bytes of one snapshot's row_status column entry (MAX_VEHICLES, padded to 8).
+inline constexpr std::size_t kRecordingStatusBytes = (MAX_VEHICLES + 7u) / 8u * 8u;
+
+enum class RecordingCompression : std::uint32_t
+{
+    kNone = 0,
+
+    /** @brief XOR-delta of 8-byte words, byte planes, zero-run-length coding. */
+    kXorShuffle,
+
+    /** @brief Lossy: piecewise Chebyshev series within a declared error bound. */
+    kChebyshev,
+};
+
+enum class RecordingCode : std::uint8_t
+{
+    kOk = 0,
+
+    /** @brief Null path, chunk_snapshots == 0, or the recorder is already running. */
+    kInvalidInput,
+
+    /** @brief No mmap() on this platform (reader). */
+    kUnsupported,
+
+    /** @brief The file could not be opened (reader) or created (recorder). */
+    kOpenFailed,
+
+    /** @brief mmap() failed. */
+    kMapFailed,
+
+    /** @brief Not a recording. */
+    kBadMagic,
+
+    /** @brief Format version differs from this build. */
+    kVersionMismatch,
+
+    /** @brief Capacities differ from this build, or a chunk header is inconsistent. */
+    kLayoutMismatch,
+
+    /** @brief Staging storage could not be allocated. */
+    kAllocFailed,
+};
+
+struct RecordingFileHeader final
+{
+    std::uint64_t magic{0};
+    std::uint32_t format_version{0};
+    std::uint32_t header_bytes{0};
+    std::uint32_t chunk_header_bytes{0};
+    std::uint32_t max_vehicles{0};
+    std::uint32_t max_steps{0};
+    std::uint32_t status_bytes{0};
+};
+
+struct RecordingChunkHeader final
+{
+    std::uint64_t magic{0};
+    std::uint32_t snapshots{0};
+    std::uint32_t steps{0};
+
+    /// Rows stored in the chunk (union of valid_rows).
+    RowMask row_mask{0};
+
+    std::uint32_t velocities{0};
+
+    /// RecordingCompression of the body.
+    std::uint32_t compression{0};
+
+    std::uint64_t first_seqno{0};
+    std::uint64_t last_seqno{0};
+    double first_t0{0.0};
+    double last_t0{0.0};
+
+    /// Declared max abs error of stored positions [m] / velocities [m/s] (0: exact).
+    double position_tolerance{0.0};
+    double velocity_tolerance{0.0};
+
+    /// Size of the columnar body before compression.
+    std::uint64_t body_bytes{0};
+
+    /// Bytes that follow this header (padded to 8).
+    std::uint64_t stored_bytes{0};
+};
+
+/**
+ * @brief Recorder options.
+ */
+struct SnapshotRecorderConfig final
+{
+    /** @brief Snapshots per chunk (> 0); staging holds one chunk of every row. */
+    std::size_t chunk_snapshots{16};
+
+    RecordingCompression compression{RecordingCompression::kNone};
+
+    /** @brief Also record the velocity plane when the publisher carries one. */
+    bool velocities{true};
+
+    /** @brief kChebyshev: max abs error of every recorded position [m] / velocity [m/s]. */
+    double chebyshev_tolerance_m{1.0e-3};
+    double chebyshev_tolerance_mps{1.0e-6};
+
+    /** @brief kChebyshev: highest degree before a segment is split (ChebyshevFitConfig). */
+    std::size_t chebyshev_max_degree{12};
+
+    /** @brief Longest wait for a publish before the thread re-checks stop() [s]. */
+    double poll_sec{0.05};
+};
+
+/**
+ * @brief Recorder counters (each value individually atomic; read from any thread).
+ */
+struct SnapshotRecorderStats final
+{
+    /** @brief Snapshots written (or staged for the current chunk). */
+    std::uint64_t recorded{0};
+
+    /** @brief Seqnos the recorder never saw (no longer retained when it got to them). */
+    std::uint64_t missed{0};
+
+    /** @brief Snapshots dropped because the producer rewrote them while they were staged. */
+    std::uint64_t torn{0};
+
+    std::uint64_t chunks{0};
+    std::uint64_t bytes_written{0};
+
+    /** @brief Chunk writes that failed (file system full, ...). */
+    std::uint64_t write_errors{0};
+};
+
+/**
+ * @brief Background thread recording every snapshot of one Publisher.
+ *
+ * start() opens the file and allocates the staging chunk; the thread then runs until stop(),
+ * which writes the partial last chunk. The publisher must outlive the recorder.
+ */
+class SnapshotRecorder final
+{
+  public:
+    explicit SnapshotRecorder(const Publisher& publisher,
+                              const SnapshotRecorderConfig& config = SnapshotRecorderConfig{});
+    ~SnapshotRecorder();
+
+    SnapshotRecorder(const SnapshotRecorder&) = delete;
+    SnapshotRecorder& operator=(const SnapshotRecorder&) = delete;
+
+    /**
+     * @brief Create @p path and start recording from the current front snapshot on.
+     *
+     * @return kOk, kInvalidInput, kOpenFailed or kAllocFailed (not running).
+     */
+    [[nodiscard]] RecordingCode start(const char* path);
+
+    /** @brief Stop the thread, write the staged chunk and close the file (idempotent). */
+    void stop() noexcept;
+
+    [[nodiscard]] bool running() const noexcept { return running_; }
+
+    /**
+     * @brief Wait until every snapshot published so far was recorded, missed or torn.
+     * @return false on timeout.
+     */
+    bool wait_caught_up(double timeout_sec) const noexcept;
+
+    [[nodiscard]] SnapshotRecorderStats stats() const noexcept;
+
+  private:
+    void thread_main_() noexcept;
+
+    // Transpose one leased snapshot into staging slot n_; false if it must start a new chunk.
+    [[nodiscard]] bool fits_chunk_(const PredictionBuffer& buf) const noexcept;
+    void stage_(const PredictionBuffer& buf) noexcept;
+    void flush_chunk_() noexcept;
+
+    // Staged plane of (row, axis); axes 3..5 are velocities.
+    [[nodiscard]] double* plane_(std::size_t row, std::size_t axis) noexcept
+    {
+        return planes_.data() + (row * axes_ + axis) * plane_len_;
+    }
+
+    const Publisher& pub_;
+    SnapshotRecorderConfig config_;
+    bool velocities_{false};
+    std::size_t axes_{3};
+
+    std::FILE* file_{nullptr};
+    std::thread thread_{};
+    bool running_{false};
+    std::atomic<bool> stop_{false};
+
+    // Staging chunk (recorder thread only).
+    std::size_t plane_len_{0};
+    std::vector<double> planes_{};
+    std::vector<double> tau_{};
+    std::vector<std::uint64_t> seqno_{};
+    std::vector<double> t0_{};
+    std::vector<std::uint64_t> valid_{};
+    std::vector<std::uint64_t> dirty_{};
+    std::vector<std::uint64_t> deferred_{};
+    std::vector<std::uint8_t> status_{};
+    std::size_t n_{0};
+    std::size_t steps_{0};
+    RowMask row_mask_{0};
+
+    // Compression scratch (kXorShuffle, kChebyshev).
+    std::vector<unsigned char> raw_{};
+    std::vector<unsigned char> shuffled_{};
+    std::vector<unsigned char> packed_{};
+    ChebyshevEncoder chebyshev_{};
+
+    // Last seqno accounted for (recorded, missed or torn).
+    std::atomic<std::uint64_t> done_seqno_{0};
+
+    std::atomic<std::uint64_t> recorded_{0};
+    std::atomic<std::uint64_t> missed_{0};
+    std::atomic<std::uint64_t> torn_{0};
+    std::atomic<std::uint64_t> chunks_{0};
+    std::atomic<std::uint64_t> bytes_written_{0};
+    std::atomic<std::uint64_t> write_errors_{0};
+};
+
+/**
+ * @brief One recorded snapshot, viewed in place (see RecordingReader).
+ *
+ * Valid until the reader is closed, or, for compressed recordings, until a lookup lands in a
+ * different chunk.
+ */
+struct RecordedSnapshot final
+{
+    std::uint64_t seqno{0};
+    double t0{0.0};
+    std::size_t steps{0};
+    RowMask valid_rows{0};
+    RowMask dirty_rows{0};
+    RowMask deferred_rows{0};
+
+    /// Grid offsets [s] (steps entries).
+    Span<const double> tau{};
+
+    /// RowStatus per row (MAX_VEHICLES entries).
+    const std::uint8_t* row_status{nullptr};
+
+    /// Rows stored in this snapshot's chunk; the others have no series.
+    RowMask row_mask{0};
+    bool has_velocities{false};
+
+    /// Declared max abs error of positions [m] / velocities [m/s] (kChebyshev; 0: exact).
+    double position_tolerance{0.0};
+    double velocity_tolerance{0.0};
+
+    /** @brief Status of row @p i. */
+    [[nodiscard]] RowStatus status(std::size_t i) const noexcept
+    {
+        return (row_status != nullptr && i < MAX_VEHICLES) ? static_cast<RowStatus>(row_status[i])
+                                                            : RowStatus::kEmpty;
+    }
+
+    /** @brief Row @p i's positions along @p axis (empty if the row is not stored). */
+    [[nodiscard]] Span<const double> positions(std::size_t i, RicAxis axis) const noexcept;
+
+    /** @brief Row @p i's velocities along @p axis (empty without velocities). */
+    [[nodiscard]] Span<const double> velocities(std::size_t i, RicAxis axis) const noexcept;
+
+    /** @brief Position of row @p i at step @p k (requires a stored row and k < steps). */
+    [[nodiscard]] Vec3 position(std::size_t i, std::size_t k) const noexcept
+    {
+        return Vec3{positions(i, RicAxis::kR)[k], positions(i, RicAxis::kI)[k],
+                    positions(i, RicAxis::kC)[k]};
+    }
+
+  private:
+    friend class RecordingReader;
+
+    [[nodiscard]] Span<const double> series_(std::size_t i, std::size_t plane) const noexcept;
+
+    // First position plane of the chunk, snapshots in the chunk, this snapshot's index.
+    const double* planes_{nullptr};
+    std::size_t chunk_snapshots_{0};
+    std::size_t index_{0};
+};
+
+/**
+ * @brief Read-only mapping of one recording with lookups by index, seqno and t0.
+ *
+ * Not thread-safe (compressed chunks share one decode cache).
+ */
+class RecordingReader final
+{
+  public:
+    RecordingReader() = default;
+    ~RecordingReader();
+
+    RecordingReader(const RecordingReader&) = delete;
+    RecordingReader& operator=(const RecordingReader&) = delete;
+
+    /**
+     * @brief Map @p path and index its complete chunks (one header read per chunk).
+     *
+     * Reopen to see chunks appended since.
+     */
+    [[nodiscard]] RecordingCode open(const char* path);
+
+    /// @brief Unmap (idempotent).
+    void close() noexcept;
+
+    [[nodiscard]] bool is_open() const noexcept { return base_ != nullptr; }
+    [[nodiscard]] std::size_t chunk_count() const noexcept { return chunks_.size(); }
+    [[nodiscard]] std::size_t snapshot_count() const noexcept { return snapshots_; }
+
+    /** @brief Snapshot number @p index in file order (false if out of range). */
+    [[nodiscard]] bool at(std::size_t index, RecordedSnapshot& out);
+
+    /** @brief Snapshot with exactly @p seqno (false if not recorded). */
+    [[nodiscard]] bool find_seqno(std::uint64_t seqno, RecordedSnapshot& out);
+
+    /** @brief Newest snapshot with t0 <= @p t0 (false if every snapshot is later). */
+    [[nodiscard]] bool find_time(double t0, RecordedSnapshot& out);
+
+  private:
+    struct Chunk final
+    {
+        const RecordingChunkHeader* hdr{nullptr};
+        const unsigned char* stored{nullptr};
+        std::size_t first_index{0};
+    };
+
+    // Body of chunk @p c (in place, or decoded into cache_); nullptr if it does not decode.
+    [[nodiscard]] const unsigned char* body_(std::size_t c);
+    [[nodiscard]] bool decode_chebyshev_(const Chunk& ch);
+    [[nodiscard]] bool view_(std::size_t c, std::size_t j, RecordedSnapshot& out);
+
+    void* base_{nullptr};
+    std::size_t bytes_{0};
+    std::vector<Chunk> chunks_{};
+    std::size_t snapshots_{0};
+
+    std::vector<unsigned char> cache_{};
+    std::vector<unsigned char> scratch_{};
+    std::size_t cached_chunk_{static_cast<std::size_t>(-1)};
+};
+
+} // namespace bullseye_pred
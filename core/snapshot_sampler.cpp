@@ -0,0 +1,235 @@
+// core/snapshot_sampler.cpp
+#include "core/snapshot_sampler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "core/trajectory_coefficients.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Cached interpolant of one row: on segment k, p(s) = c[k][0] + c[k][1] s + c[k][2] s^2
+ *        + c[k][3] s^3 with s = tau - tau[k].
+ */
+struct SnapshotSampler::Row final
+{
+    /// row_seqno the coefficients were built from (0: nothing cached).
+    std::uint64_t seqno{0};
+    double row_t0{0.0};
+    std::uint8_t grid{0};
+    bool hermite{false};
+    std::size_t steps{0};
+    std::array<double, MAX_STEPS> tau{};
+    std::array<std::array<Vec3, 4>, MAX_STEPS> c{};
+};
+
+SnapshotSampler::SnapshotSampler() : rows_(std::make_unique<Row[]>(MAX_VEHICLES)) {}
+
+SnapshotSampler::~SnapshotSampler() = default;
+
+void SnapshotSampler::bind(const PredictionBuffer& snap) noexcept
+{
+    if (snap.seqno < bound_seqno_)
+    {
+        invalidate();
+    }
+    snap_ = &snap;
+    vel_ = snap.velocities;
+    bound_seqno_ = snap.seqno;
+}
+
+void SnapshotSampler::bind(const ShmReadView& view) noexcept
+{
+    if (view.snapshot == nullptr)
+    {
+        snap_ = nullptr;
+        vel_ = nullptr;
+        return;
+    }
+    bind(*view.snapshot);
+    vel_ = view.velocities;
+}
+
+void SnapshotSampler::invalidate() noexcept
+{
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        rows_[i].seqno = 0;
+    }
+}
+
+const SnapshotSampler::Row* SnapshotSampler::row_(std::size_t i) noexcept
+{
+    const PredictionBuffer& s = *snap_;
+    const std::size_t n = s.row_steps(i);
+    if (!s.row_valid(i) || n == 0u)
+    {
+        return nullptr;
+    }
+    Row& c = rows_[i];
+    const bool hermite = (vel_ != nullptr);
+    if (c.seqno == s.row_seqno[i] && c.seqno != 0u && c.hermite == hermite)
+    {
+        return &c;
+    }
+
+    const Span<const double> tau = s.row_tau(i);
+    const auto& p = s.positions[i];
+    std::copy(tau.data, tau.data + n, c.tau.begin());
+    for (std::size_t k = 0; k + 1u < n; ++k)
+    {
+        const double h = tau[k + 1u] - tau[k];
+        std::array<Vec3, 4>& seg = c.c[k];
+        seg[0] = p[k];
+        if (!(h > 0.0))
+        {
+            // Repeated offset: hold the first sample.
+            seg[1] = seg[2] = seg[3] = Vec3{};
+            continue;
+        }
+        const double inv_h = 1.0 / h;
+        const Vec3 d = (p[k + 1u] - p[k]) * inv_h;
+        if (!hermite)
+        {
+            seg[1] = d;
+            seg[2] = seg[3] = Vec3{};
+            continue;
+        }
+        const Vec3& v0 = (*vel_)[i][k];
+        const Vec3& v1 = (*vel_)[i][k + 1u];
+        seg[1] = v0;
+        seg[2] = (d * 3.0 - v0 * 2.0 - v1) * inv_h;
+        seg[3] = (v0 + v1 - d * 2.0) * (inv_h * inv_h);
+    }
+    // Last sample: reached only by single-sample rows (s = 0 at the end of a segment otherwise).
+    c.c[n - 1u] = {p[n - 1u], hermite ? (*vel_)[i][n - 1u] : Vec3{}, Vec3{}, Vec3{}};
+
+    c.seqno = s.row_seqno[i];
+    c.row_t0 = s.row_t0[i];
+    c.grid = s.row_grid[i];
+    c.hermite = hermite;
+    c.steps = n;
+    ++rows_built_;
+    return &c;
+}
+
+std::size_t SnapshotSampler::segment_(const double* grid, std::size_t n, double tau) noexcept
+{
+    if (n < 2u)
+    {
+        return 0;
+    }
+    const auto k = static_cast<std::size_t>(std::upper_bound(grid, grid + n, tau) - grid);
+    return std::min((k == 0u) ? std::size_t{0} : k - 1u, n - 2u);
+}
+
+void SnapshotSampler::eval_(const Row& c,
+                            std::size_t k,
+                            double tau,
+                            Vec3& out_r,
+                            Vec3* out_v) noexcept
+{
+    const std::array<Vec3, 4>& seg = c.c[k];
+    const double s = tau - c.tau[k];
+    out_r = seg[0] + (seg[1] + (seg[2] + seg[3] * s) * s) * s;
+    if (out_v != nullptr)
+    {
+        *out_v = seg[1] + (seg[2] * 2.0 + seg[3] * (3.0 * s)) * s;
+    }
+}
+
+SampleCode SnapshotSampler::sample(std::size_t row, double t, Vec3& out_r, Vec3* out_v) noexcept
+{
+    if (snap_ == nullptr)
+    {
+        return SampleCode::kNotBound;
+    }
+    if (row >= MAX_VEHICLES || !snap_->row_valid(row) || snap_->row_steps(row) == 0u)
+    {
+        return SampleCode::kNoRow;
+    }
+    const double tau = t - snap_->row_t0[row];
+    const Span<const double> grid = snap_->row_tau(row);
+    if (!(tau >= grid[0] && tau <= grid[grid.size - 1u]))
+    {
+        return SampleCode::kOutOfRange;
+    }
+
+    if (((snap_->coeff_only_rows >> row) & 1u) != 0u)
+    {
+        // No samples were written; the closed form is exact.
+        return evaluate_coefficients(snap_->coefficients[row], tau, out_r, out_v)
+                   ? SampleCode::kOk
+                   : SampleCode::kNoRow;
+    }
+    const Row* c = row_(row);
+    if (c == nullptr)
+    {
+        return SampleCode::kNoRow;
+    }
+    eval_(*c, segment_(c->tau.data(), c->steps, tau), tau, out_r, out_v);
+    return SampleCode::kOk;
+}
+
+RowMask SnapshotSampler::sample_many(RowMask rows,
+                                     double t,
+                                     Span<Vec3> out_r,
+                                     Span<Vec3> out_v) noexcept
+{
+    RowMask done = 0;
+    if (snap_ == nullptr)
+    {
+        return done;
+    }
+    const bool want_vel = (out_v.size != 0u);
+
+    // Segment of the previous row; rows sharing its grid, epoch and length share it too.
+    const Row* last = nullptr;
+    std::size_t last_k = 0;
+    for (std::size_t i = 0; i < MAX_VEHICLES && rows != 0u; ++i)
+    {
+        const RowMask bit = RowMask{1} << i;
+        if ((rows & bit) == 0u)
+        {
+            continue;
+        }
+        rows &= ~bit;
+        if (i >= out_r.size || (want_vel && i >= out_v.size))
+        {
+            break;
+        }
+        Vec3* v = want_vel ? &out_v.data[i] : nullptr;
+        if (((snap_->coeff_only_rows & bit) != 0u) || !snap_->row_valid(i))
+        {
+            if (sample(i, t, out_r.data[i], v) == SampleCode::kOk)
+            {
+                done |= bit;
+            }
+            continue;
+        }
+        const Row* c = row_(i);
+        if (c == nullptr)
+        {
+            continue;
+        }
+        const double tau = t - c->row_t0;
+        if (!(tau >= c->tau[0] && tau <= c->tau[c->steps - 1u]))
+        {
+            continue;
+        }
+        if (last == nullptr || last->grid != c->grid || last->row_t0 != c->row_t0 ||
+            last->steps != c->steps)
+        {
+            last_k = segment_(c->tau.data(), c->steps, tau);
+            last = c;
+        }
+        eval_(*c, last_k, tau, out_r.data[i], v);
+        done |= bit;
+    }
+    return done;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,132 @@
+// core/snapshot_sampler.hpp
+#pragma once
+
+/**
+ * @file snapshot_sampler.hpp
+ * @brief Reader-side queries of a published snapshot at arbitrary times.
+ *
+ * Consumers often need positions at their own timestamps (e.g. 30 Hz sensor frames) rather
+ * than on the predictor's grid. SnapshotSampler answers sample(row, t) on the piecewise cubic
+ * Hermite interpolant of row's samples: exact positions and velocities at every sample, C1 in
+ * between (the interpolant closest_approach.hpp refines on). Without a velocity plane it falls
+ * back to linear interpolation of the positions.
+ *
+ * Per-segment polynomial coefficients are built once per row version (row_seqno) on first use
+ * and reused across queries and across snapshots in which the row is carried over clean, so a
+ * query is a segment lookup and one cubic per axis. Coefficient-only rows
+ * (PredictionBuffer::coeff_only_rows) are evaluated from their closed form instead.
+ *
+ * - Times are absolute (the timebase of PredictionBuffer::t0); row i covers
+ *   [row_t0[i] + row_tau(i)[0], row_t0[i] + row_tau(i)[row_steps(i) - 1]] and is not
+ *   extrapolated.
+ * - Rows are buffer rows (VehicleIndexMap::index_of() maps a vehicle id to its row).
+ * - One sampler per reader thread; bind it to one snapshot stream. The cache (~4 MB) is
+ *   allocated at construction; queries never allocate.
+ * - Shared-memory readers bind the ShmReadView and call invalidate() if validate() fails
+ *   afterwards, since coefficients built from a torn read would otherwise be reused.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "core/constants.hpp"
+#include "core/prediction_buffer.hpp"
+#include "core/shm_snapshot.hpp"
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Outcome of one SnapshotSampler query.
+ */
+enum class SampleCode : std::uint8_t
+{
+    kOk = 0,
+    /** @brief No snapshot bound. */
+    kNotBound = 1,
+    /** @brief Row out of range or without data in the bound snapshot. */
+    kNoRow = 2,
+    /** @brief t is outside the row's grid span, or not finite. */
+    kOutOfRange = 3,
+};
+
+/**
+ * @brief Hermite queries over a published snapshot, with per-row coefficients cached.
+ */
+class SnapshotSampler final
+{
+  public:
+    /** @throws std::bad_alloc if the coefficient cache cannot be allocated. */
+    SnapshotSampler();
+    ~SnapshotSampler();
+
+    SnapshotSampler(const SnapshotSampler&) = delete;
+    SnapshotSampler& operator=(const SnapshotSampler&) = delete;
+
+    /**
+     * @brief Query @p snap (velocities from snap.velocities) until the next bind().
+     *
+     * The snapshot must stay readable while bound (e.g. a Publisher::read() lease). A seqno
+     * below the previous one (a restarted stream) drops the cache.
+     */
+    void bind(const PredictionBuffer& snap) noexcept;
+
+    /** @brief Query an in-place shared-memory snapshot (velocities from @p view). */
+    void bind(const ShmReadView& view) noexcept;
+
+    /** @brief Drop every cached row (rebuilt on next use). */
+    void invalidate() noexcept;
+
+    /**
+     * @brief RIC position (and velocity) of @p row at absolute time @p t.
+     *
+     * @param out_v Velocity in RIC, or nullptr.
+     * @return kOk, or the reason the outputs were left unchanged.
+     */
+    [[nodiscard]] SampleCode sample(std::size_t row,
+                                    double t,
+                                    Vec3& out_r,
+                                    Vec3* out_v = nullptr) noexcept;
+
+    /**
+     * @brief sample() every row of @p rows at @p t; rows on the same grid and epoch share one
+     *        segment lookup.
+     *
+     * @param out_r Indexed by row; must cover the highest row in @p rows.
+     * @param out_v Indexed by row, or empty.
+     * @return Rows sampled (kOk); the other entries are unchanged.
+     */
+    [[nodiscard]] RowMask sample_many(RowMask rows,
+                                      double t,
+                                      Span<Vec3> out_r,
+                                      Span<Vec3> out_v) noexcept;
+
+    /** @brief True if queries of the bound snapshot interpolate with velocities. */
+    [[nodiscard]] bool hermite() const noexcept { return vel_ != nullptr; }
+
+    /** @brief Rows whose coefficients were (re)built since construction. */
+    [[nodiscard]] std::uint64_t rows_built() const noexcept { return rows_built_; }
+
+  private:
+    struct Row;
+
+    // Row i's coefficients for the bound snapshot, built if stale; nullptr if no data.
+    const Row* row_(std::size_t i) noexcept;
+
+    // Evaluate c at offset tau on segment k.
+    static void eval_(const Row& c, std::size_t k, double tau, Vec3& out_r, Vec3* out_v) noexcept;
+
+    // Segment [k, k + 1] of the n offsets at grid holding tau (the last one past the end).
+    static std::size_t segment_(const double* grid, std::size_t n, double tau) noexcept;
+
+    std::unique_ptr<Row[]> rows_;
+    const PredictionBuffer* snap_{nullptr};
+    const TrajectoryPlane* vel_{nullptr};
+    std::uint64_t bound_seqno_{0};
+    std::uint64_t rows_built_{0};
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,109 @@
+// core/snapshot_view.cpp
+#include "core/snapshot_view.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace bullseye_pred
+{
+
+static_assert(sizeof(Vec3) == 3u * sizeof(double), "axis views stride over packed Vec3 samples");
+
+SnapshotView::SnapshotView(const PredictionBuffer& snap,
+                           const TrajectoryPlane* velocities,
+                           const SoaPositionPlanes* soa,
+                           const SubscriptionFilter& filter) noexcept
+    : snap_(&snap), vel_(velocities), soa_(soa), rows_(filter.rows & snap.valid_rows),
+      first_(filter.first_step), max_steps_(filter.max_steps)
+{
+}
+
+std::size_t SnapshotView::count_(std::size_t i) const noexcept
+{
+    if (snap_ == nullptr || i >= MAX_VEHICLES || ((rows_ >> i) & 1u) == 0u)
+    {
+        return 0;
+    }
+    const std::size_t n = snap_->row_steps(i);
+    return (first_ < n) ? std::min(n - first_, max_steps_) : 0u;
+}
+
+RowMask SnapshotView::changed_since(std::uint64_t since) const noexcept
+{
+    return (snap_ != nullptr) ? (snap_->rows_changed_since(since) & rows_) : 0u;
+}
+
+RowStatus SnapshotView::status(std::size_t i) const noexcept
+{
+    return (snap_ != nullptr && i < MAX_VEHICLES && ((rows_ >> i) & 1u) != 0u)
+               ? snap_->row_status[i]
+               : RowStatus::kEmpty;
+}
+
+Span<const double> SnapshotView::tau(std::size_t i) const noexcept
+{
+    const std::size_t n = count_(i);
+    return (n > 0u) ? Span<const double>{snap_->row_tau(i).data + first_, n}
+                    : Span<const double>{};
+}
+
+Span<const Vec3> SnapshotView::positions(std::size_t i) const noexcept
+{
+    const std::size_t n = count_(i);
+    return (n > 0u) ? Span<const Vec3>{snap_->positions[i].data() + first_, n}
+                    : Span<const Vec3>{};
+}
+
+Span<const Vec3> SnapshotView::velocities(std::size_t i) const noexcept
+{
+    const std::size_t n = (vel_ != nullptr) ? count_(i) : 0u;
+    return (n > 0u) ? Span<const Vec3>{(*vel_)[i].data() + first_, n} : Span<const Vec3>{};
+}
+
+StridedSpan<const double> SnapshotView::positions(std::size_t i, RicAxis axis) const noexcept
+{
+    const std::size_t n = count_(i);
+    if (n == 0u)
+    {
+        return StridedSpan<const double>{};
+    }
+    const std::size_t a = static_cast<std::size_t>(axis);
+    if (soa_ != nullptr)
+    {
+        const std::size_t stride = (soa_->layout == SoaLayout::kStepMajor) ? MAX_VEHICLES : 1u;
+        return StridedSpan<const double>{soa_->planes[a].data() + soa_->index(i, first_), n,
+                                         stride};
+    }
+    const double* p = reinterpret_cast<const double*>(snap_->positions[i].data() + first_);
+    return StridedSpan<const double>{p + a, n, 3u};
+}
+
+SubscribedSnapshot Subscription::acquire() const noexcept
+{
+    SubscribedSnapshot out{};
+    if (pub_ != nullptr)
+    {
+        out.lease = pub_->acquire();
+        if (out.lease.held())
+        {
+            out.view = view(out.lease.get());
+        }
+    }
+    return out;
+}
+
+SubscribedSnapshot Subscription::acquire_seqno(std::uint64_t seqno) const noexcept
+{
+    SubscribedSnapshot out{};
+    if (pub_ != nullptr)
+    {
+        out.lease = pub_->acquire_seqno(seqno);
+        if (out.lease.held())
+        {
+            out.view = view(out.lease.get());
+        }
+    }
+    return out;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,196 @@
+// core/snapshot_view.hpp
+#pragma once
+
+/**
+ * @file snapshot_view.hpp
+ * @brief Filtered, zero-copy subscriber views of published snapshots.
+ *
+ * Most consumers use a few vehicles, or only the first part of the horizon. A Subscription
+ * declares that subset up front (SubscriptionFilter: a row mask and a step window) and hands
+ * out SnapshotViews: a handful of pointers into the snapshot, never a copy. Whatever the
+ * backend, a consumer then touches only the cache lines (or shared-memory pages) of the rows
+ * and steps it declared:
+ *
+ * - in process: Subscription::acquire() leases the front snapshot (Publisher::acquire());
+ * - shared memory: Subscription::view(ShmReadView) reads the mapped slot in place;
+ * - network: give the sending MulticastPublisher the same filter (NetEncoderConfig::filter)
+ *   so only the matching rows and steps are sent, and view the decoder's mirror.
+ *
+ * The window is in sample indices: [first_step, first_step + max_steps) of each row's own
+ * grid (row_steps(i) samples), so rows on a coarser profile are clipped to their own length.
+ * Axis views (positions(i, axis)) read the publisher's SoA planes when it has them (stride 1
+ * for kVehicleMajor) and stride over the Vec3 samples otherwise.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/constants.hpp"
+#include "core/prediction_buffer.hpp"
+#include "core/publisher.hpp"
+#include "core/shm_snapshot.hpp"
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Rows and steps a subscriber uses.
+ */
+struct SubscriptionFilter final
+{
+    /** @brief Rows of interest (VehicleIndexMap::index_of() maps vehicle ids to rows). */
+    RowMask rows{kAllRows};
+
+    /** @brief First sample of the window. */
+    std::size_t first_step{0};
+
+    /** @brief Samples in the window (clipped to each row's samples). */
+    std::size_t max_steps{MAX_STEPS};
+
+    /** @brief True if nothing is filtered out. */
+    [[nodiscard]] bool all() const noexcept
+    {
+        return (rows & kAllRows) == kAllRows && first_step == 0u && max_steps >= MAX_STEPS;
+    }
+};
+
+/**
+ * @brief Read-only view of @p size elements @p stride apart.
+ */
+template <typename T>
+struct StridedSpan final
+{
+    T* data{nullptr};
+    std::size_t size{0};
+    std::size_t stride{1};
+
+    [[nodiscard]] T& operator[](std::size_t k) const noexcept { return data[k * stride]; }
+    [[nodiscard]] bool empty() const noexcept { return size == 0u; }
+};
+
+/**
+ * @brief One snapshot seen through a SubscriptionFilter.
+ *
+ * Valid while the snapshot it points into is (the lease, the shared-memory read, or the
+ * decoder mirror until its next apply()). Rows outside the filter read as empty.
+ */
+class SnapshotView final
+{
+  public:
+    SnapshotView() = default;
+
+    /**
+     * @brief View @p snap with its planes passed explicitly (either may be nullptr); the
+     *        snapshot's own pointers are process-local and not used.
+     */
+    SnapshotView(const PredictionBuffer& snap,
+                 const TrajectoryPlane* velocities,
+                 const SoaPositionPlanes* soa,
+                 const SubscriptionFilter& filter) noexcept;
+
+    /** @brief True if no snapshot is viewed. */
+    [[nodiscard]] bool empty() const noexcept { return snap_ == nullptr; }
+
+    [[nodiscard]] std::uint64_t seqno() const noexcept
+    {
+        return (snap_ != nullptr) ? snap_->seqno : 0u;
+    }
+    [[nodiscard]] double t0() const noexcept { return (snap_ != nullptr) ? snap_->t0 : 0.0; }
+
+    /** @brief Filtered rows holding data (filter rows & valid_rows). */
+    [[nodiscard]] RowMask rows() const noexcept { return rows_; }
+
+    /** @brief Filtered rows that changed after snapshot @p since (see rows_changed_since()). */
+    [[nodiscard]] RowMask changed_since(std::uint64_t since) const noexcept;
+
+    [[nodiscard]] RowStatus status(std::size_t i) const noexcept;
+
+    /** @brief First sample of the window. */
+    [[nodiscard]] std::size_t first_step() const noexcept { return first_; }
+
+    /** @brief Window of row @p i's grid offsets (empty outside the filter). */
+    [[nodiscard]] Span<const double> tau(std::size_t i) const noexcept;
+
+    /** @brief Window of row @p i's positions (empty outside the filter or without data). */
+    [[nodiscard]] Span<const Vec3> positions(std::size_t i) const noexcept;
+
+    /** @brief Window of row @p i's velocities (empty also without a velocity plane). */
+    [[nodiscard]] Span<const Vec3> velocities(std::size_t i) const noexcept;
+
+    /** @brief Window of one position component of row @p i. */
+    [[nodiscard]] StridedSpan<const double> positions(std::size_t i, RicAxis axis) const noexcept;
+
+    /** @brief Viewed snapshot (requires !empty()); unfiltered, for buffer-wide fields. */
+    [[nodiscard]] const PredictionBuffer& snapshot() const noexcept { return *snap_; }
+
+  private:
+    // Samples of row i inside the window (0 outside the filter).
+    [[nodiscard]] std::size_t count_(std::size_t i) const noexcept;
+
+    const PredictionBuffer* snap_{nullptr};
+    const TrajectoryPlane* vel_{nullptr};
+    const SoaPositionPlanes* soa_{nullptr};
+    RowMask rows_{0};
+    std::size_t first_{0};
+    std::size_t max_steps_{0};
+};
+
+/**
+ * @brief A leased snapshot and its filtered view (see Subscription::acquire()).
+ */
+struct SubscribedSnapshot final
+{
+    SnapshotLease lease{};
+    SnapshotView view{};
+
+    /** @brief Seqlock check after reading (SnapshotLease::valid()). */
+    [[nodiscard]] bool valid() const noexcept { return lease.held() && lease.valid(); }
+};
+
+/**
+ * @brief Subscriber handle: a filter declared once, applied to every snapshot it views.
+ */
+class Subscription final
+{
+  public:
+    explicit Subscription(const SubscriptionFilter& filter) noexcept : filter_(filter) {}
+
+    /** @brief Subscribe to an in-process publisher (it must outlive the handle). */
+    Subscription(const Publisher& publisher, const SubscriptionFilter& filter) noexcept
+        : pub_(&publisher), filter_(filter)
+    {
+    }
+
+    [[nodiscard]] const SubscriptionFilter& filter() const noexcept { return filter_; }
+
+    /**
+     * @brief Lease the publisher's front snapshot and view it (empty without a publisher or
+     *        before the first publish).
+     */
+    [[nodiscard]] SubscribedSnapshot acquire() const noexcept;
+
+    /** @brief Lease snapshot @p seqno if it is still retained. */
+    [[nodiscard]] SubscribedSnapshot acquire_seqno(std::uint64_t seqno) const noexcept;
+
+    /** @brief View @p snap (with its attached velocity and SoA planes). */
+    [[nodiscard]] SnapshotView view(const PredictionBuffer& snap) const noexcept
+    {
+        return SnapshotView(snap, snap.velocities, snap.soa, filter_);
+    }
+
+    /** @brief View a shared-memory snapshot in place (validate the read afterwards). */
+    [[nodiscard]] SnapshotView view(const ShmReadView& read) const noexcept
+    {
+        return (read.snapshot != nullptr)
+                   ? SnapshotView(*read.snapshot, read.velocities, read.soa, filter_)
+                   : SnapshotView{};
+    }
+
+  private:
+    const Publisher* pub_{nullptr};
+    SubscriptionFilter filter_{};
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,141 @@
+// core/source_transition.cpp
+#include "core/source_transition.hpp"
+
+#include <cmath>
+
+#include "core/bullseye_frame_math.hpp"
+#include "core/contracts.hpp"
+
+namespace bullseye_pred
+{
+
+namespace
+{
+
+// Source identity that survives a checkpoint (FNV-1a of the adopted source id; 0 for none).
+std::uint64_t source_key(const char* id) noexcept
+{
+    std::uint64_t h = 14695981039346656037ull;
+    for (const char* p = id; p != nullptr && *p != '\0'; ++p)
+    {
+        h = (h ^ static_cast<unsigned char>(*p)) * 1099511628211ull;
+    }
+    return (id != nullptr) ? h : 0u;
+}
+
+} // namespace
+
+void SourceTransitionTracker::reset() noexcept
+{
+    have_prev_ = false;
+    blending_ = false;
+    degraded_left_ = 0;
+}
+
+const SourceTransitionTick& SourceTransitionTracker::update(double t0,
+                                                            const ChiefState& chief,
+                                                            const BullseyeFrameSnapshot& frame)
+    noexcept
+{
+    SourceTransitionTick out{};
+    out.C_from_ric_to_inertial = frame.C_from_ric_to_inertial;
+    out.origin_i = frame.origin_i;
+    out.origin_jump_m = last_.origin_jump_m;
+    out.attitude_jump_rad = last_.attitude_jump_rad;
+    out.omega_jump_radps = last_.omega_jump_radps;
+    out.moved = last_.blending;
+
+    const ConstructedRicFrame con = construct_ric_from_chief(chief);
+    if (!con.status.ok())
+    {
+        reset();
+        last_ = out;
+        return last_;
+    }
+    const Mat3& C_con = con.C_from_ric_to_inertial;
+    Misalignment cur{};
+    cur.q = math::quat_from_dcm(mul_transpose(C_con, frame.C_from_ric_to_inertial));
+    cur.d = mul_transpose(C_con, frame.origin_i - chief.r_i);
+    const bool adopted = frame.used_adopted;
+    const std::uint64_t source = adopted ? source_key(frame.adopted_frame_source_id) : 0u;
+    const bool has_omega = frame.has_omega && frame.omega_coords == OmegaCoords::kOmegaRIC;
+
+    if (have_prev_ && (adopted != prev_adopted_ || source != prev_source_))
+    {
+        out.switched = true;
+        out.moved = true;
+        out.attitude_jump_rad = math::quat_angle_between(prev_.q, cur.q);
+        out.origin_jump_m = norm(cur.d - prev_.d);
+        out.omega_jump_radps = (has_omega && prev_has_omega_)
+                                   ? norm(frame.omega_ric - prev_omega_)
+                                   : std::numeric_limits<double>::quiet_NaN();
+        if (out.attitude_jump_rad > contracts::Tol::kTransitionAttitudeJump_rad ||
+            out.origin_jump_m > contracts::Tol::kTransitionOriginJump_m ||
+            out.omega_jump_radps > contracts::Tol::kTransitionOmegaJump_radps)
+        {
+            degraded_left_ = contracts::Tol::kTransitionDegradedTicks;
+        }
+
+        // A switch during a blend starts the next blend from what was last published.
+        blending_ = config_.mode != SourceTransitionMode::kHardSwitch &&
+                    std::isfinite(config_.blend_sec) && config_.blend_sec > 0.0;
+        blend_mode_ = config_.mode;
+        blend_sec_ = config_.blend_sec;
+        t_switch_ = t0;
+        from_ = published_;
+    }
+
+    Misalignment pub = cur;
+    if (blending_)
+    {
+        const double s = std::fmax(0.0, (t0 - t_switch_) / blend_sec_);
+        if (!(s < 1.0))
+        {
+            blending_ = false;
+        }
+        else
+        {
+            if (blend_mode_ != SourceTransitionMode::kBlendOrigin)
+            {
+                pub.q = math::quat_slerp(from_.q, cur.q, s);
+            }
+            if (blend_mode_ != SourceTransitionMode::kBlendOrientation)
+            {
+                pub.d = from_.d + (cur.d - from_.d) * s;
+            }
+            out.blend = s;
+        }
+    }
+
+    if (blending_)
+    {
+        // R_x: x axes -> constructed axes; rows go from source axes to published axes
+        // (dR = R_pub^T R_src, first order: I + [phi]x).
+        const Mat3 R_pub = math::dcm_from_quat(pub.q);
+        const Mat3 dR = mul_transpose(R_pub, math::dcm_from_quat(cur.q));
+        out.correction.phi = Vec3{0.5 * (dR.m[2][1] - dR.m[1][2]), 0.5 * (dR.m[0][2] - dR.m[2][0]),
+                                  0.5 * (dR.m[1][0] - dR.m[0][1])};
+        out.C_from_ric_to_inertial = mul(C_con, R_pub);
+        out.origin_i = chief.r_i + mul(C_con, pub.d);
+        out.blending = true;
+        out.moved = true;
+    }
+
+    if (degraded_left_ > 0)
+    {
+        out.degraded = true;
+        --degraded_left_;
+    }
+
+    have_prev_ = true;
+    prev_adopted_ = adopted;
+    prev_source_ = source;
+    prev_ = cur;
+    prev_has_omega_ = has_omega;
+    prev_omega_ = frame.omega_ric;
+    published_ = pub;
+    last_ = out;
+    return last_;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,232 @@
+// core/source_transition.hpp
+#pragma once
+
+/**
+ * @file source_transition.hpp
+ * @brief Bullseye source transitions (FR-9) as a rigid correction of computed trajectories.
+ *
+ * A transition starts when the tick frame changes source: constructed <-> adopted (a
+ * BullseyeFrameMode switch, or an adopted frame that falls back), or a different
+ * adopted_frame_source_id. The two sources disagree by a slowly varying misalignment (a small
+ * rotation and an origin offset relative to the frame constructed from the chief), so a hard
+ * switch jumps every published row by the rotation.
+ *
+ * SourceTransitionTracker measures the jump (FR-9c metrics) and, in the blend modes, moves the
+ * published frame from the old source's misalignment to the new one over blend_sec. Rows are
+ * still predicted in the new source's frame, so the models, their per-tick caches and the
+ * initial-state transform are untouched; the published rows are then re-expressed in the
+ * blended axes by one small-rotation correction per sample (apply_frame_correction()):
+ *
+ *   r_pub = r + phi x r,   v_pub = v + phi x v
+ *
+ * Rows are relative to the chief in every source (the predictor never uses the frame origin),
+ * so blending the origin only moves the published origin_i.
+ *
+ * The correction is first order in the rotation, and the relative-motion models are not
+ * rotation invariant (in-track and cross-track dynamics differ), so it carries two errors:
+ * (1 - cos theta) * range from the dropped rotation term and about theta * (n tau)^2 * range
+ * from the dynamics applied in the wrong axes (frame_correction_error_bound()). When their sum
+ * exceeds the configured bound, the predictor predicts the tick directly in the blended frame
+ * instead.
+ *
+ * Like the inertial output, the misalignment is held fixed over the grid.
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "core/bullseye_frame.hpp"
+#include "core/math/quaternion.hpp"
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief FR-9 transition modes.
+ */
+enum class SourceTransitionMode : std::uint8_t
+{
+    /** @brief Publish the new source from the switch tick on. */
+    kHardSwitch = 0,
+    /** @brief Blend the origin; the orientation switches immediately. */
+    kBlendOrigin = 1,
+    /** @brief Blend the orientation; the origin switches immediately. */
+    kBlendOrientation = 2,
+    kBlendBoth = 3,
+};
+
+/**
+ * @brief Transition configuration (BasicRelativePredictor::configure_source_transition()).
+ */
+struct SourceTransitionConfig final
+{
+    SourceTransitionMode mode{SourceTransitionMode::kHardSwitch};
+
+    /** @brief Blend duration [s] from the switch tick (> 0; otherwise a hard switch). */
+    double blend_sec{10.0};
+
+    /**
+     * @brief Largest error [m] accepted from the first-order correction; ticks above it are
+     *        predicted in the blended frame.
+     */
+    double max_correction_error_m{1.0e-3};
+};
+
+/**
+ * @brief Small rotation from the axes rows were predicted in to the published axes.
+ */
+struct FrameCorrection final
+{
+    /** @brief Rotation vector (sin(angle) * axis), published axes. */
+    Vec3 phi{};
+
+    [[nodiscard]] bool identity() const noexcept
+    {
+        return phi.x == 0.0 && phi.y == 0.0 && phi.z == 0.0;
+    }
+};
+
+/**
+ * @brief Apply @p c to a row in place (velocities optional: empty span).
+ */
+inline void apply_frame_correction(const FrameCorrection& c, Span<Vec3> r, Span<Vec3> v) noexcept
+{
+    const double px = c.phi.x;
+    const double py = c.phi.y;
+    const double pz = c.phi.z;
+    for (std::size_t k = 0; k < r.size; ++k)
+    {
+        const Vec3 a = r.data[k];
+        r.data[k] = Vec3{a.x + (py * a.z - pz * a.y), a.y + (pz * a.x - px * a.z),
+                         a.z + (px * a.y - py * a.x)};
+    }
+    for (std::size_t k = 0; k < v.size; ++k)
+    {
+        const Vec3 a = v.data[k];
+        v.data[k] = Vec3{a.x + (py * a.z - pz * a.y), a.y + (pz * a.x - px * a.z),
+                         a.z + (px * a.y - py * a.x)};
+    }
+}
+
+/**
+ * @brief Error estimate of apply_frame_correction() on rows reaching @p range_m [m] over a
+ *        horizon of @p n_tau radians of chief motion (infinite for 90 degrees or more).
+ *
+ * The rotation term is a bound; the dynamics term is the order of magnitude of the part of
+ * the motion that is not ballistic (n_tau = 0: the rotation term alone).
+ */
+[[nodiscard]] inline double frame_correction_error_bound(const FrameCorrection& c,
+                                                         double range_m,
+                                                         double n_tau = 0.0) noexcept
+{
+    const double s2 = dot(c.phi, c.phi);
+    if (!(s2 < 1.0))
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+    // |R r - (r + phi x r)| = (1 - cos) |K^2 r| <= (1 - cos) |r|, cos = sqrt(1 - sin^2).
+    const double rotation = s2 / (1.0 + std::sqrt(1.0 - s2));
+    const double dynamics = std::sqrt(s2) * std::fmin(n_tau * n_tau, 2.0);
+    return (rotation + dynamics) * range_m;
+}
+
+/**
+ * @brief Outcome of SourceTransitionTracker::update() for one tick.
+ */
+struct SourceTransitionTick final
+{
+    /** @brief The tick frame changed source this tick (BULLSEYE_SOURCE_SWITCHED). */
+    bool switched{false};
+
+    /** @brief The published frame is a blend (correction is not the identity). */
+    bool blending{false};
+
+    /**
+     * @brief The published frame moved relative to the source between the previous tick and
+     *        this one (switch, blend, or the tick after one): trajectories published last tick
+     *        are not comparable with this tick's initial states.
+     */
+    bool moved{false};
+
+    /** @brief Within kTransitionDegradedTicks ticks of a switch whose jump exceeded a bound. */
+    bool degraded{false};
+
+    /** @brief Fraction of the blend completed (1 outside a blend). */
+    double blend{1.0};
+
+    /** @brief Jumps measured at the last switch (FR-9c); omega NaN unless both had one. */
+    double origin_jump_m{0.0};
+    double attitude_jump_rad{0.0};
+    double omega_jump_radps{std::numeric_limits<double>::quiet_NaN()};
+
+    /** @brief From the tick (source) frame to the published frame. */
+    FrameCorrection correction{};
+
+    /** @brief Published frame (the source frame unless blending). */
+    Mat3 C_from_ric_to_inertial{Mat3::identity()};
+    Vec3 origin_i{};
+};
+
+/**
+ * @brief Per-predictor transition state across ticks (trivially copyable: checkpointed).
+ */
+class SourceTransitionTracker final
+{
+  public:
+    /** @brief Takes effect at the next switch; a blend in progress keeps its schedule. */
+    void configure(const SourceTransitionConfig& config) noexcept { config_ = config; }
+
+    [[nodiscard]] const SourceTransitionConfig& config() const noexcept { return config_; }
+
+    /**
+     * @brief Track the tick frame @p frame of @p t0 built from @p chief.
+     *
+     * A frame whose misalignment cannot be measured (chief too degenerate to construct RIC)
+     * publishes as is and restarts tracking.
+     */
+    const SourceTransitionTick& update(double t0,
+                                       const ChiefState& chief,
+                                       const BullseyeFrameSnapshot& frame) noexcept;
+
+    /** @brief Result of the last update(). */
+    [[nodiscard]] const SourceTransitionTick& last() const noexcept { return last_; }
+
+    /** @brief Forget the previous source (the next tick cannot switch). */
+    void reset() noexcept;
+
+  private:
+    // Tick frame relative to the constructed frame: rotation (constructed <- frame) and origin
+    // offset from the chief, constructed axes.
+    struct Misalignment final
+    {
+        math::Quat q{};
+        Vec3 d{};
+    };
+
+    SourceTransitionConfig config_{};
+    SourceTransitionTick last_{};
+
+    // Source of the previous tick.
+    bool have_prev_{false};
+    bool prev_adopted_{false};
+    std::uint64_t prev_source_{0};
+    Misalignment prev_{};
+    bool prev_has_omega_{false};
+    Vec3 prev_omega_{};
+
+    // Published misalignment of the previous tick, and the blend in progress (its mode and
+    // duration are fixed at the switch).
+    Misalignment published_{};
+    bool blending_{false};
+    SourceTransitionMode blend_mode_{SourceTransitionMode::kHardSwitch};
+    double blend_sec_{0.0};
+    double t_switch_{0.0};
+    Misalignment from_{};
+    std::int32_t degraded_left_{0};
+};
+
+} // namespace bullseye_pred
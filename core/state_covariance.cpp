@@ -0,0 +1,118 @@
+// core/state_covariance.cpp
+
+#include "core/state_covariance.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bullseye_pred
+{
+
+bool inertial_to_ric_covariance(const StateCovariance& P_i,
+                                const Mat3& C_from_inertial_to_ric,
+                                const Vec3& omega_ric,
+                                StateCovariance& out) noexcept
+{
+    double acc = 0.0;
+    for (int r = 0; r < 6; ++r)
+    {
+        for (int c = 0; c < 6; ++c)
+        {
+            acc += P_i.m[r][c] - P_i.m[r][c];
+        }
+    }
+    for (int r = 0; r < 3; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            acc += C_from_inertial_to_ric(r, c) - C_from_inertial_to_ric(r, c);
+        }
+    }
+    if (!(acc == 0.0) || !finite3(omega_ric))
+    {
+        return false;
+    }
+
+    // J = [C 0; -[w x]C C]; the lower-left block is -(w x c) for each column c of C.
+    const Mat3& C = C_from_inertial_to_ric;
+    std::array<std::array<double, 6>, 6> J{};
+    for (int c = 0; c < 3; ++c)
+    {
+        const Vec3 col{C(0, c), C(1, c), C(2, c)};
+        const Vec3 wc = cross(omega_ric, col);
+        for (int r = 0; r < 3; ++r)
+        {
+            J[r][c] = C(r, c);
+            J[r + 3][c + 3] = C(r, c);
+        }
+        J[3][c] = -wc.x;
+        J[4][c] = -wc.y;
+        J[5][c] = -wc.z;
+    }
+
+    // JP = J P, then out = JP J^T.
+    std::array<std::array<double, 6>, 6> JP{};
+    for (int r = 0; r < 6; ++r)
+    {
+        for (int c = 0; c < 6; ++c)
+        {
+            double s = 0.0;
+            for (int k = 0; k < 6; ++k)
+            {
+                s += J[r][k] * P_i.m[k][c];
+            }
+            JP[r][c] = s;
+        }
+    }
+    for (int r = 0; r < 6; ++r)
+    {
+        for (int c = 0; c < 6; ++c)
+        {
+            double s = 0.0;
+            for (int k = 0; k < 6; ++k)
+            {
+                s += JP[r][k] * J[c][k];
+            }
+            out.m[r][c] = s;
+        }
+    }
+    return true;
+}
+
+void propagate_position_covariance(const StateCovariance& P0_ric,
+                                   Span2D<const Vec3> basis,
+                                   Span<PositionCovariance> out) noexcept
+{
+    if (basis.data == nullptr || basis.rows < 6u)
+    {
+        return;
+    }
+    const std::size_t n = std::min(basis.cols, out.size);
+    const Vec3* const a = basis.data;
+    const std::size_t s = basis.row_stride;
+    const auto& P = P0_ric.m;
+
+    for (std::size_t k = 0; k < n; ++k)
+    {
+        // Sigma = sum_j a_j b_j^T with a_j = Phi e_j and b_j = sum_l P[j][l] a_l.
+        PositionCovariance o{};
+        for (std::size_t j = 0; j < 6; ++j)
+        {
+            const Vec3& aj = a[j * s + k];
+            Vec3 b{};
+            for (std::size_t l = 0; l < 6; ++l)
+            {
+                b = b + P[j][l] * a[l * s + k];
+            }
+            o.rr += aj.x * b.x;
+            o.ri += aj.x * b.y;
+            o.rc += aj.x * b.z;
+            o.ii += aj.y * b.y;
+            o.ic += aj.y * b.z;
+            o.cc += aj.z * b.z;
+        }
+        out[k] = o;
+    }
+}
+
+} // namespace bullseye_pred
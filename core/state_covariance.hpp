@@ -0,0 +1,87 @@
+// core/state_covariance.hpp
+#pragma once
+
+/**
+ * @file state_covariance.hpp
+ * @brief Linear covariance propagation through the relative-motion STMs.
+ *
+ * Every built-in model is linear in the initial RIC state, so the position at grid time k is
+ * r_k = Phi_k x0 with Phi_k the 3x6 position rows of the model's state-transition matrix. A
+ * deputy's initial covariance P0 then maps to
+ *
+ *   Sigma_k = Phi_k P0 Phi_k^T
+ *
+ * without sampling. The predictor obtains Phi_k once per tick and grid as the model's response
+ * to the six unit initial states (column j of Phi_k is the trajectory from e_j), which reuses
+ * the cached STM tables of HCW / YA / SS-J2, and then applies the kernel below to every row
+ * that supplied a covariance.
+ *
+ * Design constraints:
+ * - No logging.
+ * - No heap allocations.
+ * - Deterministic iteration order.
+ */
+
+#include <array>
+#include <cstddef>
+
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief 6x6 covariance of a state [r; v] (m^2, m^2/s, m^2/s^2 blocks).
+ *
+ * Row/column order is r.x, r.y, r.z, v.x, v.y, v.z. Expected symmetric positive semidefinite.
+ */
+struct StateCovariance final
+{
+    std::array<std::array<double, 6>, 6> m{};
+};
+
+/**
+ * @brief Symmetric 3x3 position covariance in RIC [m^2], stored by its upper triangle.
+ */
+struct PositionCovariance final
+{
+    double rr{0.0};
+    double ri{0.0};
+    double rc{0.0};
+    double ii{0.0};
+    double ic{0.0};
+    double cc{0.0};
+};
+
+/**
+ * @brief Map an inertial relative-state covariance into RIC (Option B velocities).
+ *
+ * The Jacobian of inertial_to_ric_relative() with respect to [dr_i; dv_i] is
+ *
+ *   J = [ C        0 ]      C = C_from_inertial_to_ric
+ *       [ -[w x] C  C ]     w = omega_ric
+ *
+ * and out = J P J^T. The chief is treated as exact, so @p P_i is the deputy's own covariance.
+ *
+ * @return false (out unchanged) if any input entry is non-finite.
+ */
+[[nodiscard]] bool inertial_to_ric_covariance(const StateCovariance& P_i,
+                                              const Mat3& C_from_inertial_to_ric,
+                                              const Vec3& omega_ric,
+                                              StateCovariance& out) noexcept;
+
+/**
+ * @brief Sigma_k = Phi_k P0 Phi_k^T for every grid sample.
+ *
+ * @param P0_ric Initial RIC state covariance.
+ * @param basis  Six rows; basis.row(j)[k] is the position at sample k predicted from the unit
+ *               initial state e_j, i.e. column j of Phi_k.
+ * @param out    One entry per sample; min(basis.cols, out.size) entries are written (none if
+ *               basis has fewer than six rows).
+ */
+void propagate_position_covariance(const StateCovariance& P0_ric,
+                                   Span2D<const Vec3> basis,
+                                   Span<PositionCovariance> out) noexcept;
+
+} // namespace bullseye_pred
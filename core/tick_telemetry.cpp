@@ -0,0 +1,235 @@
+#include "core/tick_telemetry.hpp"
+
+#include <new>
+
+#include "core/shm_snapshot.hpp"
+
+namespace bullseye_pred
+{
+namespace
+{
+
+// Records moved per ring pop while draining (kept on the drain thread's stack).
+constexpr std::size_t kDrainChunk = 16;
+
+[[nodiscard]] constexpr bool power_of_two(std::size_t n) noexcept
+{
+    return n != 0u && (n & (n - 1u)) == 0u;
+}
+
+} // namespace
+
+bool write_tick_telemetry_header(std::FILE* f) noexcept
+{
+    if (f == nullptr)
+    {
+        return false;
+    }
+    TickTelemetryFileHeader hdr{};
+    hdr.ns_per_tick = trace_ns_per_tick();
+    return std::fwrite(&hdr, sizeof(hdr), 1, f) == 1u;
+}
+
+bool read_tick_telemetry_header(std::FILE* f, TickTelemetryFileHeader& out) noexcept
+{
+    if (f == nullptr || std::fread(&out, sizeof(out), 1, f) != 1u)
+    {
+        return false;
+    }
+    return out.magic == kTelemetryMagic && out.layout_version == kTelemetryLayoutVersion &&
+           out.record_bytes == sizeof(TickTelemetryRecord) && out.max_vehicles == MAX_VEHICLES &&
+           out.stage_count == kTraceStageCount;
+}
+
+std::size_t read_tick_telemetry(std::FILE* f, Span<TickTelemetryRecord> out) noexcept
+{
+    if (f == nullptr || out.size == 0u)
+    {
+        return 0u;
+    }
+    return std::fread(out.data, sizeof(TickTelemetryRecord), out.size, f);
+}
+
+ShmCode TickTelemetryShmWriter::create(const char* name, std::size_t capacity) noexcept
+{
+    close();
+    if (!power_of_two(capacity))
+    {
+        return ShmCode::kResizeFailed;
+    }
+    const std::size_t offset = shm_align(sizeof(TickTelemetryShmHeader));
+    const ShmCode code = map_.create(name, offset + capacity * sizeof(TickTelemetryRecord));
+    if (code != ShmCode::kOk)
+    {
+        return code;
+    }
+
+    // The object is zero-filled; construct the header in place and publish the magic last.
+    auto* const base = static_cast<unsigned char*>(map_.data());
+    hdr_ = new (base) TickTelemetryShmHeader{};
+    hdr_->layout_version = kTelemetryLayoutVersion;
+    hdr_->record_bytes = static_cast<std::uint32_t>(sizeof(TickTelemetryRecord));
+    hdr_->max_vehicles = static_cast<std::uint32_t>(MAX_VEHICLES);
+    hdr_->stage_count = static_cast<std::uint32_t>(kTraceStageCount);
+    hdr_->capacity = capacity;
+    hdr_->records_offset = offset;
+    hdr_->ns_per_tick = trace_ns_per_tick();
+    records_ = reinterpret_cast<TickTelemetryRecord*>(base + offset);
+    hdr_->magic.store(kTelemetryMagic, std::memory_order_release);
+    return ShmCode::kOk;
+}
+
+void TickTelemetryShmWriter::close() noexcept
+{
+    if (hdr_ != nullptr)
+    {
+        hdr_->magic.store(0u, std::memory_order_release);
+    }
+    map_.reset();
+    hdr_ = nullptr;
+    records_ = nullptr;
+}
+
+bool TickTelemetryShmWriter::append(Span<const TickTelemetryRecord> records) noexcept
+{
+    if (hdr_ == nullptr)
+    {
+        return false;
+    }
+    const std::uint64_t mask = hdr_->capacity - 1u;
+    std::uint64_t w = hdr_->written.load(std::memory_order_relaxed);
+    for (std::size_t k = 0; k < records.size; ++k, ++w)
+    {
+        records_[w & mask] = records[k];
+        hdr_->written.store(w + 1u, std::memory_order_release);
+    }
+    return true;
+}
+
+ShmCode TickTelemetryShmReader::open(const char* name) noexcept
+{
+    close();
+    const ShmCode code = map_.open_read_only(name);
+    if (code != ShmCode::kOk)
+    {
+        return code;
+    }
+    if (map_.size() < sizeof(TickTelemetryShmHeader))
+    {
+        map_.reset();
+        return ShmCode::kResizeFailed;
+    }
+
+    const auto* hdr = static_cast<const TickTelemetryShmHeader*>(map_.data());
+    if (hdr->magic.load(std::memory_order_acquire) != kTelemetryMagic)
+    {
+        map_.reset();
+        return ShmCode::kBadMagic;
+    }
+    if (hdr->layout_version != kTelemetryLayoutVersion)
+    {
+        map_.reset();
+        return ShmCode::kVersionMismatch;
+    }
+    if (hdr->record_bytes != sizeof(TickTelemetryRecord) || hdr->max_vehicles != MAX_VEHICLES ||
+        hdr->stage_count != kTraceStageCount || !power_of_two(hdr->capacity) ||
+        hdr->records_offset != shm_align(sizeof(TickTelemetryShmHeader)))
+    {
+        map_.reset();
+        return ShmCode::kLayoutMismatch;
+    }
+    if (map_.size() < hdr->records_offset + hdr->capacity * sizeof(TickTelemetryRecord))
+    {
+        map_.reset();
+        return ShmCode::kResizeFailed;
+    }
+
+    hdr_ = hdr;
+    records_ = reinterpret_cast<const TickTelemetryRecord*>(
+        static_cast<const unsigned char*>(map_.data()) + hdr->records_offset);
+    return ShmCode::kOk;
+}
+
+void TickTelemetryShmReader::close() noexcept
+{
+    map_.reset();
+    hdr_ = nullptr;
+    records_ = nullptr;
+}
+
+std::uint64_t TickTelemetryShmReader::written() const noexcept
+{
+    return (hdr_ != nullptr) ? hdr_->written.load(std::memory_order_acquire) : 0u;
+}
+
+std::size_t TickTelemetryShmReader::copy_since(std::uint64_t* next,
+                                               Span<TickTelemetryRecord> out) const noexcept
+{
+    if (hdr_ == nullptr || next == nullptr)
+    {
+        return 0u;
+    }
+    const std::uint64_t cap = hdr_->capacity;
+    const std::uint64_t w = written();
+    // Record w may be half written over record w - cap; start past it.
+    std::uint64_t first = std::max(*next, (w >= cap) ? w - cap + 1u : 0u);
+    const std::uint64_t n = std::min<std::uint64_t>((w > first) ? w - first : 0u, out.size);
+    for (std::uint64_t k = 0; k < n; ++k)
+    {
+        out[k] = records_[(first + k) & (cap - 1u)];
+    }
+
+    // Drop the records the writer may have overwritten while we copied.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const std::uint64_t w2 = written();
+    const std::uint64_t oldest = (w2 >= cap) ? w2 - cap + 1u : 0u;
+    const std::uint64_t lost = (oldest > first) ? std::min(oldest - first, n) : 0u;
+    for (std::uint64_t k = lost; k < n; ++k)
+    {
+        out[k - lost] = out[k];
+    }
+    first += lost;
+    *next = first + (n - lost);
+    return static_cast<std::size_t>(n - lost);
+}
+
+std::size_t drain_tick_telemetry(TickTelemetryRing& ring, std::FILE* f) noexcept
+{
+    if (f == nullptr)
+    {
+        return 0u;
+    }
+    std::array<TickTelemetryRecord, kDrainChunk> chunk;
+    std::size_t total = 0;
+    for (;;)
+    {
+        const std::size_t n = ring.pop(Span<TickTelemetryRecord>{chunk.data(), chunk.size()});
+        if (n == 0u)
+        {
+            return total;
+        }
+        total += std::fwrite(chunk.data(), sizeof(TickTelemetryRecord), n, f);
+    }
+}
+
+std::size_t drain_tick_telemetry(TickTelemetryRing& ring, TickTelemetryShmWriter& out) noexcept
+{
+    if (!out.is_open())
+    {
+        return 0u;
+    }
+    std::array<TickTelemetryRecord, kDrainChunk> chunk;
+    std::size_t total = 0;
+    for (;;)
+    {
+        const std::size_t n = ring.pop(Span<TickTelemetryRecord>{chunk.data(), chunk.size()});
+        if (n == 0u)
+        {
+            return total;
+        }
+        (void)out.append(Span<const TickTelemetryRecord>{chunk.data(), n});
+        total += n;
+    }
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,420 @@
+// core/tick_telemetry.hpp
+#pragma once
+/**
+ * @file tick_telemetry.hpp
+ * @brief Binary per-tick telemetry: fixed-size tick records, an SPSC ring, file and shm sinks.
+ *
+ * @details
+ * A predictor with a ring attached (attach_telemetry()) fills one TickTelemetryRecord per
+ * step() and pushes it on the way out, published or not: seqno, t0, outcome, chief and frame
+ * status, degrade reasons, per-row status / provider code / model, row counts and stage
+ * durations. Filling a record is a few stores per row plus two clock reads per stage; nothing
+ * is formatted and nothing allocates. Without a ring the predictor stamps no clocks.
+ *
+ * The ring is single-producer / single-consumer and lock-free. The producer is the thread
+ * calling step() (one ring per predictor); a full ring drops the new record and counts it.
+ * The consumer drains it at its own pace with drain_tick_telemetry() into:
+ * - a file: a TickTelemetryFileHeader followed by raw records (read_tick_telemetry()), or
+ * - a shared-memory log (TickTelemetryShmWriter): a fixed ring of records that readers in
+ *   other processes copy from in place (TickTelemetryShmReader).
+ *
+ * Stage durations are raw trace clock ticks (see trace_clock()); the file and shm headers
+ * carry trace_ns_per_tick() of the producer. kValidate (inside kFrame) and kVehicle (per
+ * row, any thread) are not broken out and stay 0.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+
+#include "core/prediction_buffer.hpp"
+#include "core/shm_mapping.hpp"
+#include "core/tick_trace.hpp"
+#include "core/types.hpp"
+#include "models/model_selector.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/** @brief How a tick ended (TickTelemetryRecord::outcome). */
+enum class TickOutcome : std::uint8_t
+{
+    kPublished = 0,   ///< Snapshot published (seqno != 0).
+    kEmptyGrid,       ///< Grid had no samples.
+    kChiefError,      ///< Chief provider failed or returned no frame id (chief_status).
+    kFrameError,      ///< BullseyeFrame::update() failed (frame_status).
+    kMeanMotionError, ///< Chief state gave no usable mean motion.
+    kModelSetupError, ///< Model policy begin_tick() failed.
+};
+
+/** @brief TickTelemetryRecord::row_model of rows without a model decision this tick. */
+inline constexpr std::uint8_t kTelemetryNoModel = 0xFFu;
+
+/**
+ * @brief One tick of one predictor (fixed size, trivially copyable).
+ */
+struct TickTelemetryRecord final
+{
+    /** @brief step() calls on this predictor since attach_telemetry(), 1-based. */
+    std::uint64_t tick{0};
+
+    /** @brief Published seqno; 0 unless outcome == kPublished. */
+    std::uint64_t seqno{0};
+    double t0{0.0};
+
+    /** @brief Duration of each stage [trace clock ticks]; stages not run are 0. */
+    std::array<std::uint64_t, kTraceStageCount> stage_ticks{};
+
+    /** @brief PredictionBuffer masks of the published snapshot (0 when not published). */
+    RowMask valid_rows{0};
+    RowMask deferred_rows{0};
+    RowMask unchanged_rows{0};
+    RowMask dirty_rows{0};
+
+    /** @brief PredictionBuffer::est_cost_total (policies with a per-row model decision). */
+    double est_cost_total{0.0};
+
+    /** @brief SourceTransitionTick::blend of the tick (1 outside a source blend). */
+    double transition_blend{1.0};
+
+    /** @brief contracts::Adopted::DegradeReason bits of the tick frame. */
+    std::uint32_t degraded{0};
+
+    /** @brief Rows considered (PredictionBuffer::vehicles) and profile-0 samples. */
+    std::uint16_t vehicles{0};
+    std::uint16_t steps{0};
+
+    /**
+     * @brief Row counts by outcome; rows_deferred and rows_unchanged rows keep their previous
+     *        status.
+     */
+    std::uint16_t rows_ok{0};
+    std::uint16_t rows_reused{0};
+    std::uint16_t rows_deferred{0};
+    std::uint16_t rows_unchanged{0};
+    std::uint16_t rows_provider_error{0};
+    std::uint16_t rows_frame_mismatch{0};
+    std::uint16_t rows_model_error{0};
+
+    TickOutcome outcome{TickOutcome::kPublished};
+    ProviderCode chief_status{ProviderCode::kOk};
+    ProviderCode frame_status{ProviderCode::kOk};
+
+    /** @brief 1 if the tick frame is the adopted one. */
+    std::uint8_t used_adopted{0};
+
+    /** @brief 1 on the tick the frame source switched (BULLSEYE_SOURCE_SWITCHED). */
+    std::uint8_t source_switched{0};
+
+    /**
+     * @brief Blended tick: 1 if the rows were corrected to the published frame, 2 if they were
+     *        predicted in it (correction bound exceeded); 0 otherwise.
+     */
+    std::uint8_t transition_path{0};
+
+    /** @brief Per-row outcome (PredictionBuffer::row_status); rows >= vehicles are kEmpty. */
+    std::array<RowStatus, MAX_VEHICLES> row_status{};
+
+    /** @brief Deputy provider code of each occupied row (kOk for empty rows). */
+    std::array<ProviderCode, MAX_VEHICLES> row_provider{};
+
+    /** @brief PredictorModel of each predicted row, or kTelemetryNoModel. */
+    std::array<std::uint8_t, MAX_VEHICLES> row_model{};
+
+    /** @brief ModelSelectCause of each predicted row (kFixed otherwise). */
+    std::array<ModelSelectCause, MAX_VEHICLES> row_cause{};
+
+    /** @brief Occupied rows that produced no data this tick (errors and deferrals). */
+    [[nodiscard]] std::size_t rows_skipped() const noexcept
+    {
+        return std::size_t{rows_deferred} + rows_provider_error + rows_frame_mismatch +
+               rows_model_error;
+    }
+
+    [[nodiscard]] std::uint64_t stage(TraceStage s) const noexcept
+    {
+        return stage_ticks[static_cast<std::size_t>(s)];
+    }
+};
+
+static_assert(std::is_trivially_copyable<TickTelemetryRecord>::value,
+              "telemetry records are written and read as raw bytes");
+
+/**
+ * @brief Single-producer / single-consumer ring of tick records.
+ *
+ * push() never blocks: a full ring drops the record (dropped()). Both sides are wait-free;
+ * the indices sit on their own cache lines.
+ */
+class TickTelemetryRing final
+{
+  public:
+    /** @brief Records held (power of two). */
+    static constexpr std::size_t kCapacity = 256;
+
+    /** @brief Append a record (producer thread); false if the ring is full (dropped). */
+    bool push(const TickTelemetryRecord& r) noexcept
+    {
+        const std::uint64_t h = head_.load(std::memory_order_relaxed);
+        if (h - tail_.load(std::memory_order_acquire) >= kCapacity)
+        {
+            dropped_.store(dropped_.load(std::memory_order_relaxed) + 1u,
+                           std::memory_order_relaxed);
+            return false;
+        }
+        records_[h & (kCapacity - 1)] = r;
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Move the oldest records into @p out (consumer thread).
+     *
+     * @return records moved (at most out.size).
+     */
+    std::size_t pop(Span<TickTelemetryRecord> out) noexcept
+    {
+        const std::uint64_t t = tail_.load(std::memory_order_relaxed);
+        const std::uint64_t n =
+            std::min<std::uint64_t>(head_.load(std::memory_order_acquire) - t, out.size);
+        for (std::uint64_t k = 0; k < n; ++k)
+        {
+            out[k] = records_[(t + k) & (kCapacity - 1)];
+        }
+        tail_.store(t + n, std::memory_order_release);
+        return static_cast<std::size_t>(n);
+    }
+
+    /** @brief Records waiting for the consumer. */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return static_cast<std::size_t>(head_.load(std::memory_order_acquire) -
+                                        tail_.load(std::memory_order_acquire));
+    }
+
+    /** @brief Records pushed since construction. */
+    [[nodiscard]] std::uint64_t pushed() const noexcept
+    {
+        return head_.load(std::memory_order_acquire);
+    }
+
+    /** @brief Records dropped because the ring was full. */
+    [[nodiscard]] std::uint64_t dropped() const noexcept
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    alignas(64) std::atomic<std::uint64_t> head_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    alignas(64) std::atomic<std::uint64_t> tail_{0};
+    alignas(64) std::array<TickTelemetryRecord, kCapacity> records_{};
+};
+
+/**
+ * @brief Stage interval of a tick: a StageTrace, plus the record's stage duration when a
+ *        record is given (nullptr: the trace point only, no clock reads).
+ */
+class TickStageScope final
+{
+  public:
+    TickStageScope(TickTelemetryRecord* rec, TraceStage stage) noexcept
+        : trace_(stage), rec_(rec), stage_(stage), begin_((rec != nullptr) ? trace_clock() : 0)
+    {
+    }
+
+    ~TickStageScope() { end(); }
+
+    TickStageScope(const TickStageScope&) = delete;
+    TickStageScope& operator=(const TickStageScope&) = delete;
+
+    /** @brief Close the interval now (later calls do nothing). */
+    void end() noexcept
+    {
+        trace_.end();
+        if (rec_ != nullptr)
+        {
+            rec_->stage_ticks[static_cast<std::size_t>(stage_)] = trace_clock() - begin_;
+            rec_ = nullptr;
+        }
+    }
+
+  private:
+    StageTrace trace_;
+    TickTelemetryRecord* rec_;
+    TraceStage stage_;
+    std::uint64_t begin_;
+};
+
+/**
+ * @brief Pushes a tick's record into a ring when it goes out of scope (nullptr: no-op).
+ *
+ * Declared before the tick's stage scopes, so the record is complete when it is pushed.
+ */
+class TickTelemetryPush final
+{
+  public:
+    TickTelemetryPush(TickTelemetryRing* ring, const TickTelemetryRecord& rec) noexcept
+        : ring_(ring), rec_(rec)
+    {
+    }
+
+    ~TickTelemetryPush()
+    {
+        if (ring_ != nullptr)
+        {
+            (void)ring_->push(rec_);
+        }
+    }
+
+    TickTelemetryPush(const TickTelemetryPush&) = delete;
+    TickTelemetryPush& operator=(const TickTelemetryPush&) = delete;
+
+  private:
+    TickTelemetryRing* ring_;
+    const TickTelemetryRecord& rec_;
+};
+
+// -----------------------------
+// File sink
+// -----------------------------
+
+/// "BEYETLM1" as a little-endian integer.
+inline constexpr std::uint64_t kTelemetryMagic = 0x314D4C5445594542ull;
+
+/// Bumped whenever TickTelemetryRecord or the headers change shape.
+inline constexpr std::uint32_t kTelemetryLayoutVersion = 2;
+
+/**
+ * @brief Leading block of a telemetry file; records follow back to back.
+ */
+struct TickTelemetryFileHeader final
+{
+    std::uint64_t magic{kTelemetryMagic};
+    std::uint32_t layout_version{kTelemetryLayoutVersion};
+    std::uint32_t record_bytes{sizeof(TickTelemetryRecord)};
+    std::uint32_t max_vehicles{MAX_VEHICLES};
+    std::uint32_t stage_count{kTraceStageCount};
+
+    /** @brief Nanoseconds per stage_ticks count in the producer (trace_ns_per_tick()). */
+    double ns_per_tick{0.0};
+};
+
+/** @brief Write a header (with this process's trace_ns_per_tick()); false on a write error. */
+bool write_tick_telemetry_header(std::FILE* f) noexcept;
+
+/**
+ * @brief Read and check a header against this build.
+ *
+ * @return false on a read error or when magic, version, record size, MAX_VEHICLES or the
+ *         stage count differ.
+ */
+bool read_tick_telemetry_header(std::FILE* f, TickTelemetryFileHeader& out) noexcept;
+
+/** @brief Read up to out.size records following the header; returns records read. */
+std::size_t read_tick_telemetry(std::FILE* f, Span<TickTelemetryRecord> out) noexcept;
+
+// -----------------------------
+// Shared-memory sink
+// -----------------------------
+
+/**
+ * @brief Leading block of a shared-memory telemetry log; records follow at records_offset.
+ */
+struct TickTelemetryShmHeader final
+{
+    /// kTelemetryMagic once the log is initialized; cleared when the writer goes away.
+    std::atomic<std::uint64_t> magic{0};
+    std::uint32_t layout_version{0};
+    std::uint32_t record_bytes{0};
+    std::uint32_t max_vehicles{0};
+    std::uint32_t stage_count{0};
+    std::uint64_t capacity{0};
+    std::uint64_t records_offset{0};
+    double ns_per_tick{0.0};
+
+    /// Records appended so far; record k lives in slot k % capacity.
+    alignas(64) std::atomic<std::uint64_t> written{0};
+};
+
+/**
+ * @brief Producer side of a shared-memory telemetry log (fixed capacity, oldest overwritten).
+ *
+ * Created once at init; append() is a copy and one release store.
+ */
+class TickTelemetryShmWriter final
+{
+  public:
+    TickTelemetryShmWriter() = default;
+    ~TickTelemetryShmWriter() { close(); }
+
+    TickTelemetryShmWriter(const TickTelemetryShmWriter&) = delete;
+    TickTelemetryShmWriter& operator=(const TickTelemetryShmWriter&) = delete;
+
+    /** @brief Create segment @p name holding @p capacity records (a power of two). */
+    [[nodiscard]] ShmCode create(const char* name, std::size_t capacity) noexcept;
+
+    /** @brief Clear the magic and unmap (the segment is unlinked); idempotent. */
+    void close() noexcept;
+
+    /** @brief Append @p records; false if the log is not open. */
+    bool append(Span<const TickTelemetryRecord> records) noexcept;
+
+    [[nodiscard]] bool is_open() const noexcept { return hdr_ != nullptr; }
+
+  private:
+    ShmMapping map_{};
+    TickTelemetryShmHeader* hdr_{nullptr};
+    TickTelemetryRecord* records_{nullptr};
+};
+
+/**
+ * @brief Read-only view of a shared-memory telemetry log from any process.
+ */
+class TickTelemetryShmReader final
+{
+  public:
+    /** @brief Map segment @p name and check its header (kBadMagic: no live writer). */
+    [[nodiscard]] ShmCode open(const char* name) noexcept;
+
+    void close() noexcept;
+
+    /** @brief Records appended so far (0 if closed). */
+    [[nodiscard]] std::uint64_t written() const noexcept;
+
+    /**
+     * @brief Copy records from index @p *next on into @p out, oldest first, and advance
+     *        @p *next past them.
+     *
+     * Records already overwritten (or possibly being overwritten) are skipped: *next jumps
+     * forward and the gap is the reader's loss.
+     *
+     * @return records copied.
+     */
+    std::size_t copy_since(std::uint64_t* next, Span<TickTelemetryRecord> out) const noexcept;
+
+  private:
+    ShmMapping map_{};
+    const TickTelemetryShmHeader* hdr_{nullptr};
+    const TickTelemetryRecord* records_{nullptr};
+};
+
+// -----------------------------
+// Draining
+// -----------------------------
+
+/**
+ * @brief Drain @p ring into @p f, which already holds a header
+ *        (write_tick_telemetry_header()); returns records written.
+ */
+std::size_t drain_tick_telemetry(TickTelemetryRing& ring, std::FILE* f) noexcept;
+
+/** @brief Drain @p ring into a shared-memory log; returns records appended. */
+std::size_t drain_tick_telemetry(TickTelemetryRing& ring, TickTelemetryShmWriter& out) noexcept;
+
+} // namespace bullseye_pred
@@ -0,0 +1,331 @@
+// core/tick_trace.cpp
+#include "core/tick_trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <new>
+
+namespace bullseye_pred
+{
+namespace
+{
+
+// Rings are claimed once per thread and live until process exit, so events of finished
+// threads can still be collected.
+struct RingRegistry final
+{
+    std::array<std::atomic<TraceRing*>, kMaxTraceThreads> rings{};
+    std::atomic<std::size_t> claimed{0};
+
+    ~RingRegistry()
+    {
+        for (auto& r : rings)
+        {
+            delete r.load();
+        }
+    }
+};
+
+RingRegistry& registry() noexcept
+{
+    static RingRegistry r;
+    return r;
+}
+
+thread_local TraceRing* t_ring = nullptr;
+thread_local bool t_ring_unavailable = false;
+
+} // namespace
+
+const char* trace_stage_name(TraceStage stage) noexcept
+{
+    switch (stage)
+    {
+    case TraceStage::kTick:
+        return "tick";
+    case TraceStage::kChief:
+        return "chief";
+    case TraceStage::kFrame:
+        return "frame";
+    case TraceStage::kValidate:
+        return "validate";
+    case TraceStage::kModelSetup:
+        return "model_setup";
+    case TraceStage::kDeputies:
+        return "deputies";
+    case TraceStage::kModel:
+        return "model";
+    case TraceStage::kVehicle:
+        return "vehicle";
+    case TraceStage::kInertial:
+        return "inertial";
+    case TraceStage::kCovariance:
+        return "covariance";
+    case TraceStage::kDispersion:
+        return "dispersion";
+    case TraceStage::kApproach:
+        return "approach";
+    case TraceStage::kPublish:
+        return "publish";
+    case TraceStage::kCount:
+        break;
+    }
+    return "unknown";
+}
+
+double trace_ns_per_tick() noexcept
+{
+#ifdef BULLSEYE_TRACE_HAVE_TSC
+    static const double ns_per_tick = []() noexcept
+    {
+        using clock = std::chrono::steady_clock;
+        const auto t0 = clock::now();
+        const std::uint64_t c0 = trace_clock();
+        auto t1 = t0;
+        while (t1 - t0 < std::chrono::milliseconds(10))
+        {
+            t1 = clock::now();
+        }
+        const std::uint64_t c1 = trace_clock();
+        const double ns = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+        return (c1 > c0) ? ns / static_cast<double>(c1 - c0) : 1.0;
+    }();
+    return ns_per_tick;
+#else
+    return 1.0;
+#endif
+}
+
+TraceRing* this_thread_trace_ring() noexcept
+{
+    if (t_ring != nullptr || t_ring_unavailable)
+    {
+        return t_ring;
+    }
+    RingRegistry& reg = registry();
+    const std::size_t slot = reg.claimed.fetch_add(1);
+    if (slot >= kMaxTraceThreads)
+    {
+        t_ring_unavailable = true;
+        return nullptr;
+    }
+    t_ring = new (std::nothrow) TraceRing();
+    t_ring_unavailable = (t_ring == nullptr);
+    reg.rings[slot].store(t_ring, std::memory_order_release);
+    return t_ring;
+}
+
+void record_trace_event(const TraceEvent& e) noexcept
+{
+    if (TraceRing* r = this_thread_trace_ring())
+    {
+        r->push(e);
+    }
+}
+
+std::size_t collect_trace_events(Span<TraceRecord> out) noexcept
+{
+    RingRegistry& reg = registry();
+    std::size_t total = 0;
+    for (std::size_t t = 0; t < kMaxTraceThreads; ++t)
+    {
+        const TraceRing* r = reg.rings[t].load(std::memory_order_acquire);
+        if (r == nullptr)
+        {
+            continue;
+        }
+        const auto avail =
+            static_cast<std::size_t>(std::min<std::uint64_t>(r->pushed(), TraceRing::kCapacity));
+        if (total >= out.size)
+        {
+            total += avail;
+            continue;
+        }
+        const auto thread = static_cast<std::uint32_t>(t);
+        const std::size_t got =
+            r->copy_to(Span<TraceRecord>{out.data + total, out.size - total},
+                       [thread](const TraceEvent& e) noexcept { return TraceRecord{e, thread}; });
+        total += (got < out.size - total) ? got : std::max(got, avail);
+    }
+    return total;
+}
+
+std::uint64_t trace_events_overwritten() noexcept
+{
+    RingRegistry& reg = registry();
+    std::uint64_t lost = 0;
+    for (auto& slot : reg.rings)
+    {
+        const TraceRing* r = slot.load(std::memory_order_acquire);
+        if (r != nullptr && r->pushed() > TraceRing::kCapacity)
+        {
+            lost += r->pushed() - TraceRing::kCapacity;
+        }
+    }
+    return lost;
+}
+
+void clear_trace_events() noexcept
+{
+    RingRegistry& reg = registry();
+    for (auto& slot : reg.rings)
+    {
+        if (TraceRing* r = slot.load(std::memory_order_acquire))
+        {
+            r->clear();
+        }
+    }
+}
+
+bool write_chrome_trace(std::FILE* f, Span<const TraceRecord> records, double ns_per_tick)
+{
+    std::uint64_t origin = ~std::uint64_t{0};
+    for (std::size_t k = 0; k < records.size; ++k)
+    {
+        origin = std::min(origin, records[k].event.begin);
+    }
+    bool ok = std::fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[") >= 0;
+    for (std::size_t k = 0; k < records.size && ok; ++k)
+    {
+        const TraceEvent& e = records[k].event;
+        const double ts_us = static_cast<double>(e.begin - origin) * ns_per_tick * 1.0e-3;
+        const double dur_us =
+            static_cast<double>(e.end >= e.begin ? e.end - e.begin : 0) * ns_per_tick * 1.0e-3;
+        ok = std::fprintf(f,
+                          "%s\n{\"name\":\"%s\",\"cat\":\"bullseye\",\"ph\":\"X\",\"pid\":1,"
+                          "\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f",
+                          (k == 0) ? "" : ",", trace_stage_name(e.stage), records[k].thread,
+                          ts_us, dur_us) >= 0;
+        if (ok && e.vehicle != kTraceNoVehicle)
+        {
+            ok = std::fprintf(f, ",\"args\":{\"vehicle\":%u}", e.vehicle) >= 0;
+        }
+        ok = ok && std::fputc('}', f) != EOF;
+    }
+    ok = ok && std::fprintf(f, "\n]}\n") >= 0;
+    return ok && std::ferror(f) == 0;
+}
+
+// ------------------------------
+// LatencyHistogram
+// ------------------------------
+
+std::size_t LatencyHistogram::bucket_(std::uint64_t value) noexcept
+{
+    if (value < kSubBuckets)
+    {
+        return static_cast<std::size_t>(value);
+    }
+    unsigned msb = 63;
+    while (((value >> msb) & 1u) == 0u)
+    {
+        --msb;
+    }
+    const unsigned octave = msb - kSubBucketBits; // 0 for [2^S, 2^(S+1))
+    const std::uint64_t sub = (value >> octave) & (kSubBuckets - 1);
+    return kSubBuckets + octave * kSubBuckets + static_cast<std::size_t>(sub);
+}
+
+std::uint64_t LatencyHistogram::bucket_high_(std::size_t bucket) noexcept
+{
+    if (bucket < kSubBuckets)
+    {
+        return bucket;
+    }
+    const std::size_t octave = (bucket - kSubBuckets) / kSubBuckets;
+    const std::uint64_t sub = (bucket - kSubBuckets) % kSubBuckets;
+    const std::uint64_t low = (kSubBuckets + sub) << octave;
+    return low + ((std::uint64_t{1} << octave) - 1);
+}
+
+void LatencyHistogram::record(std::uint64_t value) noexcept
+{
+    ++counts_[bucket_(value)];
+    min_ = (count_ == 0) ? value : std::min(min_, value);
+    max_ = std::max(max_, value);
+    sum_ += static_cast<double>(value);
+    ++count_;
+}
+
+void LatencyHistogram::reset() noexcept
+{
+    counts_.fill(0);
+    count_ = 0;
+    min_ = 0;
+    max_ = 0;
+    sum_ = 0.0;
+}
+
+std::uint64_t LatencyHistogram::value_at_percentile(double percentile) const noexcept
+{
+    if (count_ == 0)
+    {
+        return 0;
+    }
+    const double p = std::min(std::max(percentile, 0.0), 100.0);
+    const auto rank = static_cast<std::uint64_t>(
+        std::max(1.0, std::ceil(p * 0.01 * static_cast<double>(count_))));
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < kBuckets; ++b)
+    {
+        seen += counts_[b];
+        if (seen >= rank)
+        {
+            return std::min(bucket_high_(b), max_);
+        }
+    }
+    return max_;
+}
+
+// ------------------------------
+// TraceStageHistograms
+// ------------------------------
+
+void TraceStageHistograms::add(Span<const TraceRecord> records, double ns_per_tick) noexcept
+{
+    for (std::size_t k = 0; k < records.size; ++k)
+    {
+        const TraceEvent& e = records[k].event;
+        const auto s = static_cast<std::size_t>(e.stage);
+        if (s >= kTraceStageCount || e.end < e.begin)
+        {
+            continue;
+        }
+        hist_[s].record(static_cast<std::uint64_t>(
+            std::llround(static_cast<double>(e.end - e.begin) * ns_per_tick)));
+    }
+}
+
+void TraceStageHistograms::reset() noexcept
+{
+    for (LatencyHistogram& h : hist_)
+    {
+        h.reset();
+    }
+}
+
+bool TraceStageHistograms::write_summary(std::FILE* f) const
+{
+    bool ok = std::fprintf(f, "%-12s %10s %12s %12s %12s %12s %12s %12s\n", "stage", "count",
+                           "mean_ns", "p50_ns", "p90_ns", "p99_ns", "p99.9_ns", "max_ns") >= 0;
+    for (std::size_t s = 0; s < kTraceStageCount && ok; ++s)
+    {
+        const LatencyHistogram& h = hist_[s];
+        if (h.count() == 0)
+        {
+            continue;
+        }
+        ok = std::fprintf(f, "%-12s %10llu %12.0f %12llu %12llu %12llu %12llu %12llu\n",
+                          trace_stage_name(static_cast<TraceStage>(s)),
+                          static_cast<unsigned long long>(h.count()), h.mean(),
+                          static_cast<unsigned long long>(h.value_at_percentile(50.0)),
+                          static_cast<unsigned long long>(h.value_at_percentile(90.0)),
+                          static_cast<unsigned long long>(h.value_at_percentile(99.0)),
+                          static_cast<unsigned long long>(h.value_at_percentile(99.9)),
+                          static_cast<unsigned long long>(h.max())) >= 0;
+    }
+    return ok;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,325 @@
+// core/tick_trace.hpp
+#pragma once
+/**
+ * @file tick_trace.hpp
+ * @brief Per-stage tick trace points: per-thread event rings, Chrome trace export, histograms.
+ *
+ * @details
+ * The predictor brackets each stage of a tick (chief query, frame update, adopted-frame
+ * validation, model preparation, deputy query, model, inertial output, approach summary,
+ * publish) and each per-vehicle model call with a StageTrace. With BULLSEYE_ENABLE_TRACING
+ * (CMake option of the same name) a StageTrace is a TraceScope, which stamps the trace clock
+ * on entry and on end() / destruction and pushes one TraceEvent into the calling thread's
+ * ring. Without it, StageTrace is an empty type and the trace points compile to nothing.
+ *
+ * Rings are single-writer and lock-free: a push is two plain stores and one release store.
+ * Each thread's ring is allocated on its first event (at most kMaxTraceThreads rings per
+ * process). Later events do not allocate; a full ring overwrites its oldest events.
+ * collect_trace_events() copies every ring into a caller buffer. A reader racing a writer
+ * drops the events the writer may have overwritten meanwhile.
+ *
+ * Events carry raw trace clock ticks (TSC on x86-64, steady-clock nanoseconds elsewhere).
+ * Convert them with trace_ns_per_tick(). write_chrome_trace() emits the Chrome trace event
+ * format (chrome://tracing, ui.perfetto.dev). TraceStageHistograms keeps log-linear (HDR-style)
+ * latency histograms per stage.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#define BULLSEYE_TRACE_HAVE_TSC 1
+#endif
+
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+#ifdef BULLSEYE_ENABLE_TRACING
+inline constexpr bool kTracingEnabled = true;
+#else
+inline constexpr bool kTracingEnabled = false;
+#endif
+
+/** @brief Traced stages of a predictor tick. */
+enum class TraceStage : std::uint8_t
+{
+    kTick = 0,   ///< Whole step(), from grid lookup to publish.
+    kChief,      ///< Chief provider query.
+    kFrame,      ///< BullseyeFrame::update().
+    kValidate,   ///< Adopted-frame validation (inside kFrame).
+    kModelSetup, ///< Model policy begin_tick() (STM cache, chief ephemeris).
+    kDeputies,   ///< Deputy provider query and batch RIC transform.
+    kModel,      ///< Model stage (serial, block, parallel or budgeted rows; grid profiles).
+    kVehicle,    ///< One vehicle row's model call (inside kModel; any thread).
+    kInertial,   ///< Inertial position plane.
+    kCovariance, ///< Position covariance plane.
+    kDispersion, ///< Monte Carlo dispersion samples.
+    kApproach,   ///< Closest-approach summaries.
+    kPublish,    ///< Publisher::publish().
+    kCount
+};
+
+inline constexpr std::size_t kTraceStageCount = static_cast<std::size_t>(TraceStage::kCount);
+
+/** @brief Stable lower-case stage name ("tick", "chief", ...). */
+const char* trace_stage_name(TraceStage stage) noexcept;
+
+/** @brief TraceEvent::vehicle of stage-level events. */
+inline constexpr std::uint32_t kTraceNoVehicle = 0xFFFFFFFFu;
+
+/** @brief One traced interval, in trace clock ticks. */
+struct TraceEvent final
+{
+    std::uint64_t begin{0};
+    std::uint64_t end{0};
+    std::uint32_t vehicle{kTraceNoVehicle};
+    TraceStage stage{TraceStage::kTick};
+};
+
+/** @brief A collected event and the ring (thread) it came from. */
+struct TraceRecord final
+{
+    TraceEvent event{};
+    std::uint32_t thread{0};
+};
+
+/** @brief Trace clock: TSC on x86-64, steady-clock nanoseconds elsewhere. */
+inline std::uint64_t trace_clock() noexcept
+{
+#ifdef BULLSEYE_TRACE_HAVE_TSC
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now().time_since_epoch())
+                                          .count());
+#endif
+}
+
+/**
+ * @brief Nanoseconds per trace clock tick.
+ *
+ * The TSC rate is measured against the steady clock on the first call (about 10 ms), then
+ * cached. Returns 1 without a TSC.
+ */
+double trace_ns_per_tick() noexcept;
+
+/**
+ * @brief Single-writer event ring of one thread.
+ */
+class TraceRing final
+{
+  public:
+    /** @brief Events held (power of two); older events are overwritten. */
+    static constexpr std::size_t kCapacity = 8192;
+
+    /** @brief Append an event (owning thread only). */
+    void push(const TraceEvent& e) noexcept
+    {
+        const std::uint64_t h = head_.load(std::memory_order_relaxed);
+        events_[h & (kCapacity - 1)] = e;
+        head_.store(h + 1, std::memory_order_release);
+    }
+
+    /** @brief Events pushed since construction or the last clear(). */
+    [[nodiscard]] std::uint64_t pushed() const noexcept
+    {
+        return head_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Copy the retained events, oldest first, into @p out as make(event).
+     *
+     * @return events written (at most out.size; the newest are kept when it is short).
+     */
+    template <typename T, typename Make>
+    std::size_t copy_to(Span<T> out, Make&& make) const noexcept
+    {
+        const std::uint64_t h = pushed();
+        const std::uint64_t n = std::min<std::uint64_t>(std::min<std::uint64_t>(h, kCapacity),
+                                                        out.size);
+        const std::uint64_t first = h - n;
+        for (std::uint64_t k = 0; k < n; ++k)
+        {
+            out[k] = make(events_[(first + k) & (kCapacity - 1)]);
+        }
+
+        // Drop the events the writer may have overwritten while we copied.
+        const std::uint64_t h2 = pushed();
+        const std::uint64_t oldest = (h2 > kCapacity) ? h2 - kCapacity : 0;
+        const std::uint64_t lost = (oldest > first) ? std::min(oldest - first, n) : 0;
+        for (std::uint64_t k = lost; k < n; ++k)
+        {
+            out[k - lost] = out[k];
+        }
+        return static_cast<std::size_t>(n - lost);
+    }
+
+    std::size_t copy_to(Span<TraceEvent> out) const noexcept
+    {
+        return copy_to(out, [](const TraceEvent& e) noexcept { return e; });
+    }
+
+    /** @brief Forget every event (only while the owning thread is not tracing). */
+    void clear() noexcept { head_.store(0, std::memory_order_release); }
+
+  private:
+    std::atomic<std::uint64_t> head_{0};
+    std::array<TraceEvent, kCapacity> events_{};
+};
+
+/** @brief Rings per process; threads beyond this count do not trace. */
+inline constexpr std::size_t kMaxTraceThreads = 64;
+
+/** @brief Calling thread's ring (allocated on first use; nullptr if none is available). */
+TraceRing* this_thread_trace_ring() noexcept;
+
+/** @brief Push an event into the calling thread's ring. */
+void record_trace_event(const TraceEvent& e) noexcept;
+
+/**
+ * @brief Copy every thread's retained events into @p out (ring by ring, oldest first).
+ *
+ * @return events available. When out is short, the ring that overflows it contributes its
+ *         newest events and later rings are only counted.
+ */
+std::size_t collect_trace_events(Span<TraceRecord> out) noexcept;
+
+/** @brief Events lost to ring overwrite, summed over rings (pushed - capacity). */
+std::uint64_t trace_events_overwritten() noexcept;
+
+/** @brief Clear every ring (only while no thread is tracing). */
+void clear_trace_events() noexcept;
+
+/**
+ * @brief Traced interval: stamps the clock now and records on end() or destruction.
+ */
+class TraceScope final
+{
+  public:
+    explicit TraceScope(TraceStage stage, std::uint32_t vehicle = kTraceNoVehicle) noexcept
+        : begin_(trace_clock()), vehicle_(vehicle), stage_(stage)
+    {
+    }
+
+    ~TraceScope() { end(); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    /** @brief Record the interval now (later calls do nothing). */
+    void end() noexcept
+    {
+        if (!done_)
+        {
+            done_ = true;
+            record_trace_event(TraceEvent{begin_, trace_clock(), vehicle_, stage_});
+        }
+    }
+
+  private:
+    std::uint64_t begin_;
+    std::uint32_t vehicle_;
+    TraceStage stage_;
+    bool done_{false};
+};
+
+/** @brief Trace point when tracing is compiled out. */
+class NullTraceScope final
+{
+  public:
+    explicit NullTraceScope(TraceStage /*stage*/,
+                            std::uint32_t /*vehicle*/ = kTraceNoVehicle) noexcept
+    {
+    }
+
+    void end() noexcept {}
+};
+
+/** @brief Trace point type used by the predictor (see BULLSEYE_ENABLE_TRACING). */
+using StageTrace = std::conditional_t<kTracingEnabled, TraceScope, NullTraceScope>;
+
+/**
+ * @brief Write @p records as Chrome trace events ("X" complete events, microseconds).
+ *
+ * Timestamps are relative to the earliest event; each ring is one tid and vehicle events
+ * carry args.vehicle.
+ *
+ * @return false on a write error.
+ */
+bool write_chrome_trace(std::FILE* f, Span<const TraceRecord> records, double ns_per_tick);
+
+/**
+ * @brief Log-linear latency histogram (HDR-style): 2^kSubBucketBits buckets per octave.
+ *
+ * Values below 2^kSubBucketBits are exact; larger values fall in buckets of relative width
+ * 2^-kSubBucketBits (about 3 %). Covers the full uint64 range in fixed storage.
+ */
+class LatencyHistogram final
+{
+  public:
+    static constexpr unsigned kSubBucketBits = 5;
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+    static constexpr std::size_t kBuckets = kSubBuckets * (64 - kSubBucketBits + 1);
+
+    void record(std::uint64_t value) noexcept;
+
+    void reset() noexcept;
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return count_; }
+    [[nodiscard]] std::uint64_t min() const noexcept { return count_ ? min_ : 0; }
+    [[nodiscard]] std::uint64_t max() const noexcept { return max_; }
+    [[nodiscard]] double mean() const noexcept
+    {
+        return count_ ? sum_ / static_cast<double>(count_) : 0.0;
+    }
+
+    /**
+     * @brief Smallest bucket upper bound with at least @p percentile % of the values at or
+     *        below it (clamped to max()); 0 when empty.
+     */
+    [[nodiscard]] std::uint64_t value_at_percentile(double percentile) const noexcept;
+
+  private:
+    static std::size_t bucket_(std::uint64_t value) noexcept;
+    static std::uint64_t bucket_high_(std::size_t bucket) noexcept;
+
+    std::array<std::uint64_t, kBuckets> counts_{};
+    std::uint64_t count_{0};
+    std::uint64_t min_{0};
+    std::uint64_t max_{0};
+    double sum_{0.0};
+};
+
+/**
+ * @brief One latency histogram [ns] per stage.
+ */
+class TraceStageHistograms final
+{
+  public:
+    /** @brief Add every record's duration to its stage's histogram. */
+    void add(Span<const TraceRecord> records, double ns_per_tick) noexcept;
+
+    void reset() noexcept;
+
+    [[nodiscard]] const LatencyHistogram& stage(TraceStage s) const noexcept
+    {
+        return hist_[static_cast<std::size_t>(s)];
+    }
+
+    /** @brief One line per non-empty stage: count, mean, p50, p90, p99, p99.9, max [ns]. */
+    bool write_summary(std::FILE* f) const;
+
+  private:
+    std::array<LatencyHistogram, kTraceStageCount> hist_{};
+};
+
+} // namespace bullseye_pred
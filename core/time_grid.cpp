@@ -2,7 +2,7 @@
 
 #include "core/logging.hpp"
 #include "core/log_names.hpp"
-#include "logger/log_macros.hpp"
+#include "core/log_macros.hpp"
 
 #include <cmath>   // std::floor
 #include <cstddef> // std::size_t
@@ -10,33 +10,142 @@
 namespace bullseye_pred
 {
 
-TimeGrid make_time_grid(double horizon_sec, double cadence_sec)
+bool fill_time_grid(double horizon_sec, double cadence_sec, TimeGrid& out)
 {
-    static auto log = bullseye_pred::logging::get(bullseye_pred::logname::kCoreTimeGrid);
-
-    TimeGrid grid{};
+    out.tau.clear();
 
     // Invalid inputs => empty schedule.
     if (horizon_sec < 0.0 || cadence_sec <= 0.0)
     {
-        LOG_WARNF(log, "invalid_inputs horizon=%.17g cadence=%.17g", horizon_sec, cadence_sec);
-        return grid;
+        BULLSEYE_LOG_WARNF(logname::kCoreTimeGrid, "invalid_inputs horizon=%.17g cadence=%.17g",
+                           horizon_sec, cadence_sec);
+        return false;
     }
 
     const double k_max_d = std::floor(horizon_sec / cadence_sec);
     const std::size_t k_max = (k_max_d > 0.0) ? static_cast<std::size_t>(k_max_d) : 0u;
 
-    grid.tau.reserve(k_max + 1u);
+    out.tau.reserve(k_max + 1u);
     for (std::size_t k = 0; k <= k_max; ++k)
     {
-        grid.tau.push_back(static_cast<double>(k) * cadence_sec);
+        out.tau.push_back(static_cast<double>(k) * cadence_sec);
     }
 
     // DEBUG-only: useful while bringing up predictors; typically disable at runtime.
-    LOG_DEBUGF(log, "grid horizon=%.17g cadence=%.17g steps=%zu last=%.17g", horizon_sec,
-               cadence_sec, grid.tau.size(), grid.tau.empty() ? 0.0 : grid.tau.back());
+    BULLSEYE_LOG_DEBUGF(logname::kCoreTimeGrid,
+                        "grid horizon=%.17g cadence=%.17g steps=%zu last=%.17g", horizon_sec,
+                        cadence_sec, out.tau.size(), out.tau.empty() ? 0.0 : out.tau.back());
+
+    return !out.tau.empty();
+}
+
+TimeGrid make_time_grid(double horizon_sec, double cadence_sec, std::pmr::memory_resource* memory)
+{
+    TimeGrid grid{std::pmr::vector<double>(memory)};
+    (void)fill_time_grid(horizon_sec, cadence_sec, grid);
+    return grid;
+}
+
+bool fill_piecewise_time_grid(const TimeGridSegment* segments, std::size_t count, TimeGrid& out)
+{
+    out.tau.clear();
+    if (segments == nullptr || count == 0u)
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreTimeGrid, "invalid_segments count=%zu", count);
+        return false;
+    }
 
+    // Validate all segments and size the grid before writing anything.
+    std::size_t total = 1u;
+    double start = 0.0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const TimeGridSegment& seg = segments[i];
+        if (!std::isfinite(seg.end_sec) || !(seg.end_sec > start) ||
+            !std::isfinite(seg.cadence_sec) || !(seg.cadence_sec > 0.0))
+        {
+            BULLSEYE_LOG_WARNF(logname::kCoreTimeGrid,
+                               "invalid_segment index=%zu end=%.17g cadence=%.17g", i, seg.end_sec,
+                               seg.cadence_sec);
+            return false;
+        }
+        total += static_cast<std::size_t>(std::floor((seg.end_sec - start) / seg.cadence_sec));
+        start = seg.end_sec;
+    }
+
+    out.tau.reserve(total);
+    out.tau.push_back(0.0);
+    start = 0.0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const TimeGridSegment& seg = segments[i];
+        const std::size_t k_max =
+            static_cast<std::size_t>(std::floor((seg.end_sec - start) / seg.cadence_sec));
+        for (std::size_t k = 1; k <= k_max; ++k)
+        {
+            out.tau.push_back(start + static_cast<double>(k) * seg.cadence_sec);
+        }
+        start = seg.end_sec;
+    }
+
+    BULLSEYE_LOG_DEBUGF(logname::kCoreTimeGrid, "piecewise grid segments=%zu steps=%zu last=%.17g",
+                        count, out.tau.size(), out.tau.back());
+
+    return true;
+}
+
+TimeGrid make_piecewise_time_grid(const TimeGridSegment* segments,
+                                  std::size_t count,
+                                  std::pmr::memory_resource* memory)
+{
+    TimeGrid grid{std::pmr::vector<double>(memory)};
+    (void)fill_piecewise_time_grid(segments, count, grid);
     return grid;
 }
 
+const TimeGrid& TimeGridCache::get(double horizon_sec, double cadence_sec)
+{
+    if (valid_ && horizon_sec == horizon_sec_ && cadence_sec == cadence_sec_)
+    {
+        return grid_;
+    }
+
+    if (rebuilds_ == 0 && reserve_steps_ > 0)
+    {
+        grid_.tau.reserve(reserve_steps_);
+    }
+    (void)fill_time_grid(horizon_sec, cadence_sec, grid_);
+    horizon_sec_ = horizon_sec;
+    cadence_sec_ = cadence_sec;
+    valid_ = true;
+    ++rebuilds_;
+    return grid_;
+}
+
+bool uniform_cadence(const TimeGrid& grid, double& out_cadence) noexcept
+{
+    const std::size_t steps = grid.tau.size();
+    if (steps < 2u || grid.tau[0] != 0.0)
+    {
+        return false;
+    }
+
+    const double cadence = grid.tau[1];
+    if (!(cadence > 0.0) || !std::isfinite(cadence))
+    {
+        return false;
+    }
+
+    for (std::size_t k = 2; k < steps; ++k)
+    {
+        if (grid.tau[k] != static_cast<double>(k) * cadence)
+        {
+            return false;
+        }
+    }
+
+    out_cadence = cadence;
+    return true;
+}
+
 } // namespace bullseye_pred
@@ -20,6 +20,9 @@
  * This is not a propagator. It does not compute states, only the sampling times.
  */
 
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <vector>
 
 namespace bullseye_pred
@@ -38,11 +41,15 @@ namespace bullseye_pred
  * @note
  * Using offsets (rather than absolute times) avoids accidental dependence on time systems
  * and makes tests simpler and more deterministic.
+ *
+ * The offsets live in tau's memory resource (the global heap unless constructed as
+ * TimeGrid{std::pmr::vector<double>(memory)}; see memory_resource.hpp). Copies use the
+ * default resource; assignment keeps the target's.
  */
 struct TimeGrid
 {
     /// Offsets (seconds) from epoch t0. The first element is always 0.0 for valid inputs.
-    std::vector<double> tau;
+    std::pmr::vector<double> tau;
 };
 
 /**
@@ -51,6 +58,8 @@ struct TimeGrid
  * @param horizon_sec Prediction horizon (seconds). Must be >= 0.
  * @param cadence_sec Sampling cadence (seconds). Must be > 0.
  *
+ * @param memory Storage of the returned grid's offsets.
+ *
  * @return A TimeGrid containing offsets in seconds from t0.
  *
  * @details
@@ -69,6 +78,117 @@ struct TimeGrid
  * is usually acceptable, but if you require strict numerical properties, consider
  * computing tau_k as (k * cadence) using integer k and a computed step count.
  */
-TimeGrid make_time_grid(double horizon_sec, double cadence_sec);
+TimeGrid make_time_grid(double horizon_sec,
+                        double cadence_sec,
+                        std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+/**
+ * @brief Detect a uniform grid as produced by make_time_grid().
+ *
+ * @param grid Grid to inspect.
+ * @param out_cadence Receives the cadence tau[1] when the grid is uniform.
+ *
+ * @return true if grid has at least two samples, tau[1] > 0, and tau[k] == k * tau[1] bitwise
+ *         for every k; false otherwise (out_cadence untouched).
+ */
+bool uniform_cadence(const TimeGrid& grid, double& out_cadence) noexcept;
+
+/**
+ * @brief Fill @p out with the grid make_time_grid(horizon_sec, cadence_sec) would return.
+ *
+ * @details
+ * Reuses the existing capacity of out.tau, so refilling a grid that already holds enough
+ * capacity does not allocate. Invalid inputs leave out empty.
+ *
+ * @return true if the resulting grid is non-empty.
+ */
+bool fill_time_grid(double horizon_sec, double cadence_sec, TimeGrid& out);
+
+/**
+ * @brief One piece of a multi-resolution grid: samples every cadence_sec up to end_sec.
+ *
+ * A segment starts where the previous one ends (the first at 0).
+ */
+struct TimeGridSegment
+{
+    /// Segment end offset (seconds). Must exceed the previous segment's end.
+    double end_sec{0.0};
+
+    /// Sampling cadence within the segment (seconds). Must be > 0.
+    double cadence_sec{0.0};
+};
+
+/**
+ * @brief Fill @p out with a piecewise-uniform grid, e.g. {60 @0.5, 600 @5, 5400 @30}.
+ *
+ * @param segments Segments in increasing end_sec order.
+ * @param count Number of segments (>= 1).
+ * @param out Receives the grid (capacity reused, as fill_time_grid()).
+ *
+ * @return true if the resulting grid is non-empty.
+ *
+ * @details
+ * Semantics:
+ * - \f$\tau_0 = 0\f$.
+ * - Segment i with start s (previous end) contributes \f$s + k \cdot c_i\f$ for
+ *   k = 1 .. floor((end_i - s) / c_i); a segment boundary is sampled only if its cadence
+ *   divides the segment length.
+ * - Offsets are strictly increasing and never exceed the last end_sec.
+ *
+ * Invalid inputs (no segments, non-increasing or non-finite ends, cadence <= 0) leave out
+ * empty.
+ */
+bool fill_piecewise_time_grid(const TimeGridSegment* segments, std::size_t count, TimeGrid& out);
+
+/**
+ * @brief Piecewise-uniform grid (see fill_piecewise_time_grid()), stored in @p memory.
+ */
+TimeGrid make_piecewise_time_grid(
+    const TimeGridSegment* segments,
+    std::size_t count,
+    std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+/**
+ * @brief Memoized time grid, rebuilt only when (horizon, cadence) change.
+ *
+ * @details
+ * Predictors call get() every tick with the configured horizon and cadence; in steady state
+ * this is a comparison and a reference return. The first build reserves capacity for
+ * reserve_steps samples, so later rebuilds up to that size do not allocate either.
+ *
+ * The returned reference stays valid until the next get() with different arguments.
+ */
+class TimeGridCache final
+{
+  public:
+    /**
+     * @param reserve_steps Capacity reserved on the first build (typically MAX_STEPS).
+     * @param memory Storage of the grid; must outlive the cache.
+     */
+    explicit TimeGridCache(
+        std::size_t reserve_steps = 0,
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource()) noexcept
+        : grid_{std::pmr::vector<double>(memory)}, reserve_steps_(reserve_steps)
+    {
+    }
+
+    /**
+     * @brief Grid for (horizon_sec, cadence_sec).
+     *
+     * Inputs are compared bitwise with the last call; the grid is empty for invalid inputs.
+     */
+    [[nodiscard]] const TimeGrid& get(double horizon_sec, double cadence_sec);
+
+    /** @brief Number of grid builds since construction. */
+    [[nodiscard]] std::uint64_t rebuilds() const noexcept { return rebuilds_; }
+
+  private:
+    TimeGrid grid_{};
+    std::size_t reserve_steps_{0};
+    double horizon_sec_{0.0};
+    double cadence_sec_{0.0};
+    bool valid_{false};
+    std::uint64_t rebuilds_{0};
+};
 
 } // namespace bullseye_pred
@@ -0,0 +1,85 @@
+// core/time_series_cursor.hpp
+#pragma once
+
+/**
+ * @file time_series_cursor.hpp
+ * @brief Remembered-position lower_bound for exact-time lookups in sorted sample series.
+ *
+ * Ticks query nondecreasing t0, so the answer is almost always at or just after the previous
+ * one. The cursor walks forward a few samples from there and falls back to a binary search only
+ * for backward jumps or long forward gaps; results are identical to std::lower_bound.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace bullseye_pred::detail
+{
+
+/// Forward steps tried from the cursor before falling back to a binary search.
+inline constexpr std::size_t kTimeSeriesCursorWalk = 8;
+
+/**
+ * @brief Index of the first sample with t >= @p t0 (@p n if none).
+ *
+ * @param samples  @p n samples sorted by t: a pointer, or any view whose operator[] yields a
+ *                 type with a `double t` member (e.g. SampleRing::View).
+ * @param cursor   Remembered position; updated to the returned index.
+ * @param fallbacks Incremented each time the binary search is used.
+ */
+template <class Samples>
+[[nodiscard]] std::size_t cursor_lower_bound(const Samples& samples, std::size_t n, double t0,
+                                             std::size_t& cursor,
+                                             std::uint64_t& fallbacks) noexcept
+{
+    std::size_t i = std::min(cursor, n);
+
+    // The hint is usable iff every sample before it lies strictly before t0.
+    if (i == 0u || samples[i - 1u].t < t0)
+    {
+        for (std::size_t k = 0; k <= kTimeSeriesCursorWalk; ++k, ++i)
+        {
+            if (i == n || !(samples[i].t < t0))
+            {
+                cursor = i;
+                return i;
+            }
+        }
+    }
+
+    ++fallbacks;
+    std::size_t lo = 0;
+    std::size_t hi = n;
+    while (lo < hi)
+    {
+        const std::size_t mid = lo + (hi - lo) / 2u;
+        if (samples[mid].t < t0)
+        {
+            lo = mid + 1u;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    cursor = lo;
+    return lo;
+}
+
+/// @return true if sample times are finite and strictly increasing.
+template <class Sample>
+[[nodiscard]] bool strictly_increasing_times(const Sample* samples, std::size_t n) noexcept
+{
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!std::isfinite(samples[i].t) || (i > 0u && !(samples[i - 1u].t < samples[i].t)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace bullseye_pred::detail
@@ -0,0 +1,241 @@
+// core/trajectory_box_index.cpp
+#include "core/trajectory_box_index.hpp"
+
+#include "core/closest_approach.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace bullseye_pred
+{
+namespace
+{
+
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+bool finite(const Vec3& v) noexcept
+{
+    return std::isfinite(v.x + v.y + v.z);
+}
+
+Vec3 min3(const Vec3& a, const Vec3& b) noexcept
+{
+    return Vec3{std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)};
+}
+
+Vec3 max3(const Vec3& a, const Vec3& b) noexcept
+{
+    return Vec3{std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)};
+}
+
+bool overlaps(const AabbRegion& q, const Vec3& lo, const Vec3& hi) noexcept
+{
+    return lo.x <= q.hi.x && q.lo.x <= hi.x && lo.y <= q.hi.y && q.lo.y <= hi.y &&
+           lo.z <= q.hi.z && q.lo.z <= hi.z;
+}
+
+bool overlaps(const SphereRegion& q, const Vec3& lo, const Vec3& hi) noexcept
+{
+    if (!(lo.x <= hi.x))
+    {
+        return false; // empty box
+    }
+    const Vec3 c{std::min(std::max(q.center.x, lo.x), hi.x),
+                 std::min(std::max(q.center.y, lo.y), hi.y),
+                 std::min(std::max(q.center.z, lo.z), hi.z)};
+    const Vec3 d = c - q.center;
+    return dot(d, d) <= q.radius_m * q.radius_m;
+}
+
+} // namespace
+
+void TrajectoryBoxIndex::build(const PredictionBuffer& buf) noexcept
+{
+    seqno_ = buf.seqno;
+    rows_ = 0;
+    const bool hermite = buf.has_velocities();
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        leaf_base_[i] = 0;
+        const std::size_t n = buf.row_steps(i);
+        if (!buf.row_valid(i) || n == 0)
+        {
+            continue;
+        }
+        const double* tau = buf.row_tau(i).data;
+        const Vec3* r = buf.positions[i].data();
+        const Vec3* v = hermite ? (*buf.velocities)[i].data() : nullptr;
+        const std::size_t leaves = (n > 1) ? (n - 2) / kLeafSteps + 1 : 1;
+        std::size_t base = 1;
+        while (base < leaves)
+        {
+            base *= 2;
+        }
+        auto& nodes = nodes_[i];
+
+        // Leaves: sample hull of each segment (plus the Hermite bulge), absolute time span.
+        for (std::size_t j = 0; j < base; ++j)
+        {
+            Node& leaf = nodes[base + j];
+            leaf = Node{Vec3{kInf, kInf, kInf}, Vec3{-kInf, -kInf, -kInf}, kInf, -kInf};
+            if (j >= leaves)
+            {
+                continue;
+            }
+            const std::size_t k0 = j * kLeafSteps;
+            const std::size_t k1 = std::min(k0 + kLeafSteps, n - 1);
+            Vec3 lo = r[k0];
+            Vec3 hi = r[k0];
+            bool ok = finite(r[k0]);
+            double bulge = 0.0;
+            for (std::size_t k = k0 + 1; k <= k1; ++k)
+            {
+                lo = min3(lo, r[k]);
+                hi = max3(hi, r[k]);
+                ok = ok && finite(r[k]);
+                if (hermite)
+                {
+                    bulge = std::max(bulge, hermite_chord_bulge(tau[k] - tau[k - 1], r[k - 1],
+                                                                r[k], v[k - 1], v[k]));
+                }
+            }
+            if (ok && std::isfinite(bulge))
+            {
+                leaf.lo = lo - Vec3{bulge, bulge, bulge};
+                leaf.hi = hi + Vec3{bulge, bulge, bulge};
+                leaf.t_begin = buf.row_t0[i] + tau[k0];
+                leaf.t_end = buf.row_t0[i] + tau[k1];
+            }
+        }
+
+        // Parents: union of their children, bottom up.
+        for (std::size_t node = base - 1; node >= 1; --node)
+        {
+            const Node& a = nodes[2 * node];
+            const Node& b = nodes[2 * node + 1];
+            nodes[node] = Node{min3(a.lo, b.lo), max3(a.hi, b.hi), std::min(a.t_begin, b.t_begin),
+                               std::max(a.t_end, b.t_end)};
+        }
+
+        leaf_base_[i] = base;
+        samples_[i] = n;
+        rows_ |= RowMask{1} << i;
+    }
+}
+
+template <typename Region>
+std::size_t TrajectoryBoxIndex::descend_(std::size_t row,
+                                         const Region& region,
+                                         double t_begin,
+                                         double t_end,
+                                         Span<TrajectorySegmentHit> out,
+                                         std::size_t written,
+                                         bool first_only) const noexcept
+{
+    const std::size_t base = leaf_base_[row];
+    const auto& nodes = nodes_[row];
+
+    // Depth-first, left child first (hits come out in time order); depth <= log2(kMaxLeaves).
+    std::array<std::size_t, 64> stack{};
+    std::size_t top = 0;
+    stack[top++] = 1;
+    std::size_t hits = 0;
+    while (top > 0)
+    {
+        const std::size_t node = stack[--top];
+        const Node& nd = nodes[node];
+        if (!(nd.t_begin <= t_end && t_begin <= nd.t_end) || !overlaps(region, nd.lo, nd.hi))
+        {
+            continue;
+        }
+        if (node < base)
+        {
+            stack[top++] = 2 * node + 1;
+            stack[top++] = 2 * node;
+            continue;
+        }
+        const std::size_t j = node - base;
+        if (written + hits < out.size)
+        {
+            const std::size_t k0 = j * kLeafSteps;
+            const std::size_t k1 = std::min(k0 + kLeafSteps, samples_[row] - 1);
+            out[written + hits] = TrajectorySegmentHit{static_cast<std::uint32_t>(row),
+                                                       static_cast<std::uint32_t>(k0),
+                                                       static_cast<std::uint32_t>(k1), nd.t_begin,
+                                                       nd.t_end};
+        }
+        ++hits;
+        if (first_only)
+        {
+            break;
+        }
+    }
+    return hits;
+}
+
+template <typename Region>
+std::size_t TrajectoryBoxIndex::query_(const Region& region,
+                                       double t_begin,
+                                       double t_end,
+                                       Span<TrajectorySegmentHit> out) const noexcept
+{
+    std::size_t hits = 0;
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        if (((rows_ >> i) & 1u) != 0u)
+        {
+            hits += descend_(i, region, t_begin, t_end, out, hits, false);
+        }
+    }
+    return hits;
+}
+
+template <typename Region>
+RowMask TrajectoryBoxIndex::rows_in_(const Region& region,
+                                     double t_begin,
+                                     double t_end) const noexcept
+{
+    RowMask in = 0;
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        if (((rows_ >> i) & 1u) != 0u &&
+            descend_(i, region, t_begin, t_end, Span<TrajectorySegmentHit>{}, 0, true) != 0u)
+        {
+            in |= RowMask{1} << i;
+        }
+    }
+    return in;
+}
+
+std::size_t TrajectoryBoxIndex::query(const AabbRegion& region,
+                                      double t_begin,
+                                      double t_end,
+                                      Span<TrajectorySegmentHit> out) const noexcept
+{
+    return query_(region, t_begin, t_end, out);
+}
+
+std::size_t TrajectoryBoxIndex::query(const SphereRegion& region,
+                                      double t_begin,
+                                      double t_end,
+                                      Span<TrajectorySegmentHit> out) const noexcept
+{
+    return query_(region, t_begin, t_end, out);
+}
+
+RowMask TrajectoryBoxIndex::rows_in(const AabbRegion& region,
+                                    double t_begin,
+                                    double t_end) const noexcept
+{
+    return rows_in_(region, t_begin, t_end);
+}
+
+RowMask TrajectoryBoxIndex::rows_in(const SphereRegion& region,
+                                    double t_begin,
+                                    double t_end) const noexcept
+{
+    return rows_in_(region, t_begin, t_end);
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,157 @@
+// core/trajectory_box_index.hpp
+#pragma once
+/**
+ * @file trajectory_box_index.hpp
+ * @brief Per-vehicle hierarchy of time-segment bounding boxes over a published snapshot.
+ *
+ * @details
+ * Answers "which vehicles may be inside region X during [t_begin, t_end]" (keep-out zones,
+ * sensor fields of view) without scanning every sample. build() cuts each valid row into leaf
+ * segments of kLeafSteps sample intervals and gives each an axis-aligned box and time span;
+ * parents are the union of their two children (implicit binary tree, root at node 1). A
+ * query descends only nodes whose time span and box overlap the query, so it visits
+ * O(log(segments)) nodes per vehicle plus the hits.
+ *
+ * Boxes cover the samples of a segment; when the snapshot carries velocities they are grown
+ * by the Hermite bulge (hermite_chord_bulge()) so they also cover the interpolant. Hits are
+ * therefore conservative: a hit segment may be inside the region, a segment that is not hit
+ * is certainly outside.
+ *
+ * Times are absolute (row_t0[i] + tau), so rows carried from an older tick are indexed on
+ * their own grid. build() is linear in the samples and uses only the index's own storage;
+ * queries are const and may run concurrently with each other.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/constants.hpp"
+#include "core/prediction_buffer.hpp"
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/** @brief Axis-aligned query region (RIC) [m]. */
+struct AabbRegion final
+{
+    Vec3 lo{};
+    Vec3 hi{};
+};
+
+/** @brief Spherical query region (RIC) [m]. */
+struct SphereRegion final
+{
+    Vec3 center{};
+    double radius_m{0.0};
+};
+
+/**
+ * @brief One leaf segment whose box overlaps the query region and window.
+ */
+struct TrajectorySegmentHit final
+{
+    /** @brief Vehicle row. */
+    std::uint32_t row{0};
+
+    /** @brief Sample range positions[row][k_begin..k_end] (inclusive). */
+    std::uint32_t k_begin{0};
+    std::uint32_t k_end{0};
+
+    /** @brief Absolute times of k_begin and k_end [s]. */
+    double t_begin{0.0};
+    double t_end{0.0};
+};
+
+class TrajectoryBoxIndex final
+{
+  public:
+    /** @brief Sample intervals per leaf segment. */
+    static constexpr std::size_t kLeafSteps = 4;
+
+    /** @brief Leaf slots per row (power of two >= the segments of a MAX_STEPS row). */
+    static constexpr std::size_t kMaxLeaves = []() constexpr
+    {
+        std::size_t n = 1;
+        while (n * kLeafSteps < MAX_STEPS - 1)
+        {
+            n *= 2;
+        }
+        return n;
+    }();
+
+    TrajectoryBoxIndex() = default;
+
+    /** @brief Index the valid rows of @p buf (replaces the previous index). */
+    void build(const PredictionBuffer& buf) noexcept;
+
+    /** @brief Snapshot the index was built from (0 before the first build()). */
+    [[nodiscard]] std::uint64_t seqno() const noexcept { return seqno_; }
+
+    /** @brief Rows indexed by the last build(). */
+    [[nodiscard]] RowMask rows() const noexcept { return rows_; }
+
+    /**
+     * @brief Leaf segments of any vehicle overlapping @p region during [t_begin, t_end].
+     *
+     * Hits are ordered by row, then time.
+     *
+     * @return total hits; only the first out.size are written.
+     */
+    std::size_t query(const AabbRegion& region,
+                      double t_begin,
+                      double t_end,
+                      Span<TrajectorySegmentHit> out) const noexcept;
+    std::size_t query(const SphereRegion& region,
+                      double t_begin,
+                      double t_end,
+                      Span<TrajectorySegmentHit> out) const noexcept;
+
+    /** @brief Rows with at least one hit (each row's descent stops at its first hit). */
+    [[nodiscard]] RowMask rows_in(const AabbRegion& region,
+                                  double t_begin,
+                                  double t_end) const noexcept;
+    [[nodiscard]] RowMask rows_in(const SphereRegion& region,
+                                  double t_begin,
+                                  double t_end) const noexcept;
+
+  private:
+    struct Node final
+    {
+        Vec3 lo{};
+        Vec3 hi{};
+        double t_begin{0.0};
+        double t_end{0.0};
+    };
+
+    template <typename Region>
+    std::size_t descend_(std::size_t row,
+                         const Region& region,
+                         double t_begin,
+                         double t_end,
+                         Span<TrajectorySegmentHit> out,
+                         std::size_t written,
+                         bool first_only) const noexcept;
+
+    template <typename Region>
+    std::size_t query_(const Region& region,
+                       double t_begin,
+                       double t_end,
+                       Span<TrajectorySegmentHit> out) const noexcept;
+
+    template <typename Region>
+    RowMask rows_in_(const Region& region, double t_begin, double t_end) const noexcept;
+
+    std::uint64_t seqno_{0};
+    RowMask rows_{0};
+
+    // Per row: leaf slots (power of two; leaves at [leaf_base, 2 * leaf_base)) and samples.
+    std::array<std::size_t, MAX_VEHICLES> leaf_base_{};
+    std::array<std::size_t, MAX_VEHICLES> samples_{};
+
+    std::array<std::array<Node, 2 * kMaxLeaves>, MAX_VEHICLES> nodes_{};
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,177 @@
+// core/trajectory_coefficients.hpp
+#pragma once
+
+/**
+ * @file trajectory_coefficients.hpp
+ * @brief Per-row model coefficients and their header-only evaluator.
+ *
+ * HCW and SS-J2 trajectories are closed forms of the initial RIC state, so a row is fully
+ * described by x0, the model id and its few parameters (plus any planned burns). In
+ * coefficient mode (BasicRelativePredictor::configure_coefficients()) the predictor publishes
+ * these per row in PredictionBuffer::coefficients, and consumers evaluate the row at whatever
+ * offsets they need:
+ *
+ *   Vec3 r{};
+ *   evaluate_coefficients(buf.coefficients[i], t - buf.row_t0[i], r, nullptr);
+ *
+ * A consumer that samples a few times per tick then does a few STM evaluations instead of
+ * reading a MAX_STEPS-sample row, and the producer skips the dense pass entirely for
+ * coefficient-only rows.
+ *
+ * Design constraints:
+ * - Header-only (inline closed forms from hcw_stm.hpp / model_ss_j2.hpp); no allocations.
+ * - Trivially copyable (lives inside PredictionBuffer and shared memory).
+ */
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/constants.hpp"
+#include "core/types.hpp"
+#include "models/hcw_stm.hpp"
+#include "models/model_selector.hpp"
+#include "models/model_ss_j2.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Impulsive burn inside a row's coefficients.
+ */
+struct CoefficientBurn final
+{
+    /** @brief Burn time as an offset from the row's epoch (PredictionBuffer::row_t0) [s]. */
+    double tau{0.0};
+
+    /** @brief Velocity change in RIC [m/s]. */
+    Vec3 dv_ric{};
+};
+
+/**
+ * @brief Closed-form description of one predicted row.
+ *
+ * The state at offset tau is Phi(tau) x0 plus Phi(tau - tau_b) [0; dv_b] for every burn with
+ * tau_b <= tau, where Phi is the HCW STM for n_radps (model kHcw) or the SS-J2 STM for rates
+ * (model kSsJ2).
+ */
+struct TrajectoryCoefficients final
+{
+    /** @brief kHcw or kSsJ2. */
+    PredictorModel model{PredictorModel::kHcw};
+
+    /** @brief Burns in use (<= MAX_PLANNED_BURNS), sorted by tau. */
+    std::uint8_t burn_count{0};
+
+    /** @brief Initial relative state at the row's epoch. */
+    RelStateRic x0{};
+
+    /** @brief HCW mean motion [rad/s] (kHcw). */
+    double n_radps{0.0};
+
+    /** @brief SS-J2 rates (kSsJ2). */
+    SsJ2Rates rates{};
+
+    std::array<CoefficientBurn, MAX_PLANNED_BURNS> burns{};
+};
+
+/**
+ * @brief Evaluate a row at offset @p tau from its epoch.
+ *
+ * @param c Row coefficients.
+ * @param tau Offset [s] (any finite value; the closed forms are not limited to the grid).
+ * @param out_r Position in RIC.
+ * @param out_v Velocity in RIC, or nullptr.
+ * @return false (outputs unchanged) for an unknown model, invalid parameters or non-finite tau.
+ */
+inline bool evaluate_coefficients(const TrajectoryCoefficients& c,
+                                  double tau,
+                                  Vec3& out_r,
+                                  Vec3* out_v) noexcept
+{
+    if (!std::isfinite(tau) || c.burn_count > MAX_PLANNED_BURNS)
+    {
+        return false;
+    }
+    const bool want_vel = (out_v != nullptr);
+    Vec3 r{};
+    Vec3 v{};
+    if (c.model == PredictorModel::kHcw)
+    {
+        const double n = c.n_radps;
+        if (!(n > 0.0) || !std::isfinite(n))
+        {
+            return false;
+        }
+        const double inv_n = 1.0 / n;
+        hcw_stm_apply(hcw_stm_at(n, inv_n, tau), c.x0, want_vel, r, v);
+        for (std::size_t j = 0; j < c.burn_count && c.burns[j].tau <= tau; ++j)
+        {
+            Vec3 br{};
+            Vec3 bv{};
+            hcw_stm_apply(hcw_stm_at(n, inv_n, tau - c.burns[j].tau), Vec3{}, c.burns[j].dv_ric,
+                          want_vel, br, bv);
+            r = r + br;
+            v = v + bv;
+        }
+    }
+    else if (c.model == PredictorModel::kSsJ2)
+    {
+        if (!(c.rates.w > 0.0) || !(c.rates.q > 0.0))
+        {
+            return false;
+        }
+        ss_j2_stm_apply(ss_j2_stm_at(c.rates, tau), c.x0, want_vel, r, v);
+        for (std::size_t j = 0; j < c.burn_count && c.burns[j].tau <= tau; ++j)
+        {
+            Vec3 br{};
+            Vec3 bv{};
+            ss_j2_stm_apply(ss_j2_stm_at(c.rates, tau - c.burns[j].tau),
+                            RelStateRic{Vec3{}, c.burns[j].dv_ric}, want_vel, br, bv);
+            r = r + br;
+            v = v + bv;
+        }
+    }
+    else
+    {
+        return false;
+    }
+    out_r = r;
+    if (want_vel)
+    {
+        *out_v = v;
+    }
+    return true;
+}
+
+/**
+ * @brief Evaluate a row at several offsets.
+ *
+ * @param tau Offsets [s].
+ * @param out_r Positions (>= tau.size elements).
+ * @param out_v Velocities (optional; may be {nullptr,0}).
+ * @return Offsets evaluated (0 if out_r is too small or the coefficients are invalid).
+ */
+inline std::size_t evaluate_coefficients(const TrajectoryCoefficients& c,
+                                         Span<const double> tau,
+                                         Span<Vec3> out_r,
+                                         Span<Vec3> out_v) noexcept
+{
+    if (out_r.data == nullptr || out_r.size < tau.size)
+    {
+        return 0;
+    }
+    const bool want_vel = (out_v.data != nullptr && out_v.size >= tau.size);
+    for (std::size_t k = 0; k < tau.size; ++k)
+    {
+        if (!evaluate_coefficients(c, tau[k], out_r.data[k], want_vel ? &out_v.data[k] : nullptr))
+        {
+            return 0;
+        }
+    }
+    return tau.size;
+}
+
+} // namespace bullseye_pred
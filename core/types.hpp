@@ -28,87 +28,135 @@ namespace bullseye_pred
 // Basic math types (minimal)
 // -----------------------------
 
-struct Vec3 final
+// BasicVec3 / BasicMat3 are templated on the scalar so reduced-precision consumers and kernels
+// (float planes, BasicHcwStm<float>) share one implementation; Vec3 / Mat3 are the double
+// instantiations used throughout the predictor.
+
+namespace detail
+{
+// Keeps a scalar argument out of template deduction (s * v with a literal s).
+template <class T>
+struct NonDeduced
+{
+    using type = T;
+};
+} // namespace detail
+
+template <class T>
+struct BasicVec3 final
 {
-    double x{0.0};
-    double y{0.0};
-    double z{0.0};
+    using Scalar = T;
+
+    T x{0};
+    T y{0};
+    T z{0};
 
-    constexpr Vec3() = default;
-    constexpr Vec3(double x_, double y_, double z_) : x(x_), y(y_), z(z_) {}
+    constexpr BasicVec3() = default;
+    constexpr BasicVec3(T x_, T y_, T z_) : x(x_), y(y_), z(z_) {}
 };
 
-[[nodiscard]] inline constexpr Vec3 operator+(const Vec3& a, const Vec3& b) noexcept
+using Vec3 = BasicVec3<double>;
+
+template <class T>
+[[nodiscard]] inline constexpr BasicVec3<T> operator+(const BasicVec3<T>& a,
+                                                      const BasicVec3<T>& b) noexcept
 {
-    return Vec3{a.x + b.x, a.y + b.y, a.z + b.z};
+    return BasicVec3<T>{a.x + b.x, a.y + b.y, a.z + b.z};
 }
-[[nodiscard]] inline constexpr Vec3 operator-(const Vec3& a, const Vec3& b) noexcept
+template <class T>
+[[nodiscard]] inline constexpr BasicVec3<T> operator-(const BasicVec3<T>& a,
+                                                      const BasicVec3<T>& b) noexcept
 {
-    return Vec3{a.x - b.x, a.y - b.y, a.z - b.z};
+    return BasicVec3<T>{a.x - b.x, a.y - b.y, a.z - b.z};
 }
-[[nodiscard]] inline constexpr Vec3 operator*(double s, const Vec3& v) noexcept
+template <class T>
+[[nodiscard]] inline constexpr BasicVec3<T> operator*(typename detail::NonDeduced<T>::type s,
+                                                      const BasicVec3<T>& v) noexcept
 {
-    return Vec3{s * v.x, s * v.y, s * v.z};
+    return BasicVec3<T>{s * v.x, s * v.y, s * v.z};
 }
-[[nodiscard]] inline constexpr Vec3 operator*(const Vec3& v, double s) noexcept
+template <class T>
+[[nodiscard]] inline constexpr BasicVec3<T> operator*(const BasicVec3<T>& v,
+                                                      typename detail::NonDeduced<T>::type s) noexcept
 {
     return s * v;
 }
 
-[[nodiscard]] inline constexpr double dot(const Vec3& a, const Vec3& b) noexcept
+template <class T>
+[[nodiscard]] inline constexpr T dot(const BasicVec3<T>& a, const BasicVec3<T>& b) noexcept
 {
     return a.x * b.x + a.y * b.y + a.z * b.z;
 }
-[[nodiscard]] inline constexpr Vec3 cross(const Vec3& a, const Vec3& b) noexcept
+template <class T>
+[[nodiscard]] inline constexpr BasicVec3<T> cross(const BasicVec3<T>& a,
+                                                  const BasicVec3<T>& b) noexcept
 {
-    return Vec3{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    return BasicVec3<T>{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
 }
-[[nodiscard]] inline double norm(const Vec3& v) noexcept
+template <class T>
+[[nodiscard]] inline T norm(const BasicVec3<T>& v) noexcept
 {
     return std::sqrt(dot(v, v));
 }
 
+/**
+ * @brief true if every component of @p v is finite. The three tests are combined without
+ * short-circuit branches so batched validity checks stay straight-line code.
+ */
+template <class T>
+[[nodiscard]] inline bool finite3(const BasicVec3<T>& v) noexcept
+{
+    return static_cast<bool>(std::isfinite(v.x) & std::isfinite(v.y) & std::isfinite(v.z));
+}
+
 // 3x3 matrix stored row-major: m[r][c]
-struct Mat3 final
+template <class T>
+struct BasicMat3 final
 {
-    std::array<std::array<double, 3>, 3> m{{
-        std::array<double, 3>{{1.0, 0.0, 0.0}},
-        std::array<double, 3>{{0.0, 1.0, 0.0}},
-        std::array<double, 3>{{0.0, 0.0, 1.0}},
+    using Scalar = T;
+
+    std::array<std::array<T, 3>, 3> m{{
+        std::array<T, 3>{{T(1), T(0), T(0)}},
+        std::array<T, 3>{{T(0), T(1), T(0)}},
+        std::array<T, 3>{{T(0), T(0), T(1)}},
     }};
 
-    constexpr Mat3() = default;
+    constexpr BasicMat3() = default;
 
-    static constexpr Mat3 identity() noexcept
+    static constexpr BasicMat3 identity() noexcept
     {
-        return Mat3{};
+        return BasicMat3{};
     }
 
-    [[nodiscard]] constexpr double operator()(int r, int c) const noexcept
+    [[nodiscard]] constexpr T operator()(int r, int c) const noexcept
     {
         return m[r][c];
     }
-    constexpr double& operator()(int r, int c) noexcept
+    constexpr T& operator()(int r, int c) noexcept
     {
         return m[r][c];
     }
 };
 
-[[nodiscard]] inline Vec3 mul(const Mat3& A, const Vec3& v) noexcept
+using Mat3 = BasicMat3<double>;
+
+template <class T>
+[[nodiscard]] inline BasicVec3<T> mul(const BasicMat3<T>& A, const BasicVec3<T>& v) noexcept
 {
-    return Vec3{A(0, 0) * v.x + A(0, 1) * v.y + A(0, 2) * v.z,
-                A(1, 0) * v.x + A(1, 1) * v.y + A(1, 2) * v.z,
-                A(2, 0) * v.x + A(2, 1) * v.y + A(2, 2) * v.z};
+    return BasicVec3<T>{A(0, 0) * v.x + A(0, 1) * v.y + A(0, 2) * v.z,
+                        A(1, 0) * v.x + A(1, 1) * v.y + A(1, 2) * v.z,
+                        A(2, 0) * v.x + A(2, 1) * v.y + A(2, 2) * v.z};
 }
 
-[[nodiscard]] inline Mat3 mul(const Mat3& A, const Mat3& B) noexcept
+template <class T>
+[[nodiscard]] inline BasicMat3<T> mul(const BasicMat3<T>& A, const BasicMat3<T>& B) noexcept
 {
-    Mat3 C;
+    BasicMat3<T> C;
     for (int r = 0; r < 3; ++r)
     {
         for (int c = 0; c < 3; ++c)
         {
-            double s = 0.0;
+            T s = T(0);
             for (int k = 0; k < 3; ++k)
             {
                 s += A(r, k) * B(k, c);
@@ -119,28 +167,87 @@ struct Mat3 final
     return C;
 }
 
-[[nodiscard]] inline Mat3 transpose(const Mat3& A) noexcept
+template <class T>
+[[nodiscard]] inline BasicMat3<T> transpose(const BasicMat3<T>& A) noexcept
 {
-    Mat3 T;
+    BasicMat3<T> R;
     for (int r = 0; r < 3; ++r)
     {
         for (int c = 0; c < 3; ++c)
         {
-            T(r, c) = A(c, r);
+            R(r, c) = A(c, r);
         }
     }
-    return T;
+    return R;
 }
 
-[[nodiscard]] inline double det(const Mat3& A) noexcept
+/**
+ * @brief A^T * v without forming the transpose. Same summation order as mul(transpose(A), v),
+ * so results are bitwise identical.
+ */
+template <class T>
+[[nodiscard]] inline BasicVec3<T> mul_transpose(const BasicMat3<T>& A, const BasicVec3<T>& v) noexcept
+{
+    return BasicVec3<T>{A(0, 0) * v.x + A(1, 0) * v.y + A(2, 0) * v.z,
+                        A(0, 1) * v.x + A(1, 1) * v.y + A(2, 1) * v.z,
+                        A(0, 2) * v.x + A(1, 2) * v.y + A(2, 2) * v.z};
+}
+
+/**
+ * @brief A^T * B without forming the transpose; bitwise identical to mul(transpose(A), B).
+ */
+template <class T>
+[[nodiscard]] inline BasicMat3<T> mul_transpose(const BasicMat3<T>& A, const BasicMat3<T>& B) noexcept
+{
+    BasicMat3<T> C;
+    for (int r = 0; r < 3; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            T s = T(0);
+            for (int k = 0; k < 3; ++k)
+            {
+                s += A(k, r) * B(k, c);
+            }
+            C(r, c) = s;
+        }
+    }
+    return C;
+}
+
+template <class T>
+[[nodiscard]] inline T det(const BasicMat3<T>& A) noexcept
 {
     // Row-major determinant.
-    const double a = A(0, 0), b = A(0, 1), c = A(0, 2);
-    const double d = A(1, 0), e = A(1, 1), f = A(1, 2);
-    const double g = A(2, 0), h = A(2, 1), i = A(2, 2);
+    const T a = A(0, 0), b = A(0, 1), c = A(0, 2);
+    const T d = A(1, 0), e = A(1, 1), f = A(1, 2);
+    const T g = A(2, 0), h = A(2, 1), i = A(2, 2);
     return a * (e * i - f * h) - b * (d * i - f * g) + c * (d * h - e * g);
 }
 
+/**
+ * @brief Convert a vector or matrix to another scalar (e.g. double to float for a consumer).
+ */
+template <class To, class From>
+[[nodiscard]] inline constexpr BasicVec3<To> vec3_cast(const BasicVec3<From>& v) noexcept
+{
+    return BasicVec3<To>{static_cast<To>(v.x), static_cast<To>(v.y), static_cast<To>(v.z)};
+}
+
+template <class To, class From>
+[[nodiscard]] inline BasicMat3<To> mat3_cast(const BasicMat3<From>& A) noexcept
+{
+    BasicMat3<To> R;
+    for (int r = 0; r < 3; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            R(r, c) = static_cast<To>(A(r, c));
+        }
+    }
+    return R;
+}
+
 // -----------------------------
 // Core enums / status
 // -----------------------------
@@ -188,6 +295,17 @@ struct ProviderStatus final
 // Common payloads (Sprint 2)
 // -----------------------------
 
+/**
+ * @brief Interned inertial frame identity (see core/frame_id_registry.hpp).
+ *
+ * Handles are small process-local integers assigned at configuration time; equal handles mean
+ * equal frame names. kNone: the producer did not intern its frame (compare frame_id names).
+ */
+enum class FrameHandle : std::uint16_t
+{
+    kNone = 0,
+};
+
 struct ChiefState final
 {
     double time_tag{0.0};
@@ -197,9 +315,23 @@ struct ChiefState final
     // Keep this header dependency-free; use string_view to avoid owning memory.
     // NOTE: providers must ensure the view outlives the use site (usually static/config strings).
     const char* frame_id{nullptr};
+    // Interned frame_id; providers intern it once at construction.
+    FrameHandle frame{FrameHandle::kNone};
     ProviderStatus status{};
 };
 
+/**
+ * Adopted-frame checks that depend only on the DCM, precomputed by a provider when a sample is
+ * ingested (see compute_adopted_pose_metrics()). The validator then compares these against its
+ * tolerances instead of recomputing C*C^T and det(C) on every tick.
+ */
+struct AdoptedPoseMetrics final
+{
+    bool valid{false};         // false: not precomputed; the validator computes them itself
+    double ortho_max_abs{0.0}; // max|C*C^T - I|
+    double det{0.0};           // det(C)
+};
+
 struct AdoptedRicFrame final
 {
     double time_tag{0.0};
@@ -216,6 +348,9 @@ struct AdoptedRicFrame final
     FrameKind frame_kind{FrameKind::kUnspecified};
     AxisOrder axis_order{AxisOrder::kUnspecified};
 
+    // Optional; must describe C_from_ric_to_inertial exactly when valid.
+    AdoptedPoseMetrics pose_metrics{};
+
     const char* frame_source_id{nullptr}; // Optional provenance (string view style).
     ProviderStatus status{};
 };
@@ -1,58 +1,338 @@
 #include "core/vehicle_index_map.hpp"
+#include "core/checkpoint.hpp"
 #include "core/logging.hpp"
-#include "logger/log_macros.hpp"
+#include "core/log_macros.hpp"
 #include "core/log_names.hpp"
 
+#include <algorithm>
+#include <new>
+
 namespace bullseye_pred
 {
 
-std::optional<std::size_t> VehicleIndexMap::index_of(VehicleId id) const noexcept
+namespace
+{
+
+constexpr std::size_t kNotFound = static_cast<std::size_t>(-1);
+
+// splitmix64 finalizer: fixed, platform-independent mix so probe order is deterministic.
+constexpr std::uint64_t mix_id(std::uint64_t x) noexcept
+{
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBull;
+    x ^= x >> 31;
+    return x;
+}
+
+} // namespace
+
+VehicleIndexMap::VehicleIndexMap(std::size_t capacity) noexcept
+{
+    if (capacity == 0u || capacity > 0xFFFFFFFEu)
+    {
+        return;
+    }
+    std::size_t table_size = 8;
+    while (table_size < 2u * capacity)
+    {
+        table_size *= 2u;
+    }
+    const std::size_t words = (capacity + 63u) / 64u;
+
+    ids_.reset(new (std::nothrow) VehicleId[capacity]());
+    profiles_.reset(new (std::nothrow) std::uint8_t[capacity]());
+    used_.reset(new (std::nothrow) std::uint64_t[words]());
+    table_.reset(new (std::nothrow) Entry[table_size]());
+    if (!ids_ || !profiles_ || !used_ || !table_)
+    {
+        ids_.reset();
+        profiles_.reset();
+        used_.reset();
+        table_.reset();
+        return;
+    }
+    capacity_ = capacity;
+    table_mask_ = table_size - 1u;
+}
+
+void VehicleIndexMap::clear() noexcept
 {
-    for (std::size_t i = 0; i < size_; ++i)
+    for (std::size_t i = 0; i < (capacity_ + 63u) / 64u; ++i)
     {
-        if (ids_[i] == id)
+        used_[i] = 0u;
+    }
+    for (std::size_t i = 0; capacity_ > 0u && i <= table_mask_; ++i)
+    {
+        table_[i] = Entry{};
+    }
+    size_ = 0;
+    slot_count_ = 0;
+}
+
+bool VehicleIndexMap::copy_from(const VehicleIndexMap& other) noexcept
+{
+    if (other.capacity_ != capacity_ || other.table_mask_ != table_mask_)
+    {
+        return false;
+    }
+    if (capacity_ > 0u)
+    {
+        std::copy_n(other.ids_.get(), capacity_, ids_.get());
+        std::copy_n(other.profiles_.get(), capacity_, profiles_.get());
+        std::copy_n(other.used_.get(), (capacity_ + 63u) / 64u, used_.get());
+        std::copy_n(other.table_.get(), table_mask_ + 1u, table_.get());
+    }
+    size_ = other.size_;
+    slot_count_ = other.slot_count_;
+    return true;
+}
+
+namespace
+{
+
+// Fixed prefix of a kVehicleMap section; the arrays follow in declaration order.
+struct VehicleMapCheckpoint final
+{
+    std::uint64_t capacity{0};
+    std::uint64_t table_size{0};
+    std::uint64_t size{0};
+    std::uint64_t slot_count{0};
+};
+
+} // namespace
+
+void VehicleIndexMap::save_checkpoint(CheckpointWriter& out, std::uint32_t instance) const
+{
+    VehicleMapCheckpoint hdr{};
+    hdr.capacity = capacity_;
+    hdr.table_size = (capacity_ > 0u) ? table_mask_ + 1u : 0u;
+    hdr.size = size_;
+    hdr.slot_count = slot_count_;
+
+    out.begin_section(CheckpointSection::kVehicleMap, instance);
+    out.append_value(hdr);
+    if (capacity_ > 0u)
+    {
+        out.append_array(ids_.get(), capacity_);
+        out.append_array(profiles_.get(), capacity_);
+        out.append_array(used_.get(), (capacity_ + 63u) / 64u);
+        out.append_array(table_.get(), table_mask_ + 1u);
+    }
+}
+
+CheckpointCode VehicleIndexMap::restore_checkpoint(const CheckpointFile& in,
+                                                   std::uint32_t instance) noexcept
+{
+    if (!in.has_section(CheckpointSection::kVehicleMap, instance))
+    {
+        return CheckpointCode::kMissingSection;
+    }
+    CheckpointCursor cur = in.cursor(CheckpointSection::kVehicleMap, instance);
+    VehicleMapCheckpoint hdr{};
+    const std::size_t table_size = (capacity_ > 0u) ? table_mask_ + 1u : 0u;
+    const std::size_t words = (capacity_ + 63u) / 64u;
+    const std::size_t body = capacity_ * (sizeof(VehicleId) + sizeof(std::uint8_t)) +
+                             words * sizeof(std::uint64_t) + table_size * sizeof(Entry);
+    if (!cur.read_value(hdr) || hdr.capacity != capacity_ || hdr.table_size != table_size ||
+        hdr.size > capacity_ || hdr.slot_count > capacity_ || cur.remaining() != body)
+    {
+        return CheckpointCode::kLayoutMismatch;
+    }
+    if (capacity_ > 0u)
+    {
+        (void)cur.read_array(ids_.get(), capacity_);
+        (void)cur.read_array(profiles_.get(), capacity_);
+        (void)cur.read_array(used_.get(), words);
+        (void)cur.read_array(table_.get(), table_size);
+    }
+    size_ = static_cast<std::size_t>(hdr.size);
+    slot_count_ = static_cast<std::size_t>(hdr.slot_count);
+    return CheckpointCode::kOk;
+}
+
+std::size_t VehicleIndexMap::home_(VehicleId id) const noexcept
+{
+    return static_cast<std::size_t>(mix_id(id)) & table_mask_;
+}
+
+std::size_t VehicleIndexMap::find_(VehicleId id) const noexcept
+{
+    if (capacity_ == 0u)
+    {
+        return kNotFound;
+    }
+    // Load factor <= 1/2 keeps probe sequences short; an empty entry ends the search.
+    for (std::size_t pos = home_(id);; pos = (pos + 1u) & table_mask_)
+    {
+        const Entry& e = table_[pos];
+        if (e.slot_plus1 == 0u)
         {
-            return i;
+            return kNotFound;
+        }
+        if (e.id == id)
+        {
+            return pos;
         }
     }
-    return std::nullopt;
 }
 
-std::optional<std::size_t> VehicleIndexMap::register_vehicle(VehicleId id) noexcept
+bool VehicleIndexMap::slot_used_(std::size_t i) const noexcept
+{
+    return ((used_[i / 64u] >> (i % 64u)) & 1u) != 0u;
+}
+
+void VehicleIndexMap::set_slot_used_(std::size_t i, bool used) noexcept
 {
-    static auto log = bullseye_pred::logging::get(bullseye_pred::logname::kCoreVehicleIndexMap);
+    const std::uint64_t bit = std::uint64_t{1} << (i % 64u);
+    used_[i / 64u] = used ? (used_[i / 64u] | bit) : (used_[i / 64u] & ~bit);
+}
 
+std::optional<std::size_t> VehicleIndexMap::index_of(VehicleId id) const noexcept
+{
+    const std::size_t pos = find_(id);
+    if (pos == kNotFound)
+    {
+        return std::nullopt;
+    }
+    return static_cast<std::size_t>(table_[pos].slot_plus1 - 1u);
+}
+
+std::optional<std::size_t> VehicleIndexMap::register_vehicle(VehicleId id) noexcept
+{
     if (auto idx = index_of(id))
     {
-        LOG_DEBUGF(log, "duplicate_register id=%llu idx=%zu", static_cast<unsigned long long>(id),
-                   *idx);
+        BULLSEYE_LOG_DEBUGF(logname::kCoreVehicleIndexMap, "duplicate_register id=%llu idx=%zu",
+                            static_cast<unsigned long long>(id), *idx);
         return idx;
     }
 
-    if (size_ >= MAX_VEHICLES)
+    if (size_ >= capacity_)
     {
-        LOG_WARNF(log, "capacity_reject id=%llu size=%zu cap=%zu",
-                  static_cast<unsigned long long>(id), size_, MAX_VEHICLES);
+        BULLSEYE_LOG_WARNF(logname::kCoreVehicleIndexMap,
+                           "capacity_reject id=%llu size=%zu cap=%zu",
+                           static_cast<unsigned long long>(id), size_, capacity_);
         return std::nullopt;
     }
 
-    ids_[size_] = id;
-    const std::size_t assigned = size_;
+    // Lowest free index (deterministic reuse).
+    std::size_t assigned = 0;
+    for (std::size_t w = 0;; ++w)
+    {
+        const std::uint64_t free_bits = ~used_[w];
+        if (free_bits != 0u)
+        {
+            std::size_t b = 0;
+            while (((free_bits >> b) & 1u) == 0u)
+            {
+                ++b;
+            }
+            assigned = w * 64u + b;
+            break;
+        }
+    }
+
+    std::size_t pos = home_(id);
+    while (table_[pos].slot_plus1 != 0u)
+    {
+        pos = (pos + 1u) & table_mask_;
+    }
+    table_[pos] = Entry{id, static_cast<std::uint32_t>(assigned + 1u)};
+    ids_[assigned] = id;
+    profiles_[assigned] = 0u;
+    set_slot_used_(assigned, true);
     ++size_;
+    if (assigned >= slot_count_)
+    {
+        slot_count_ = assigned + 1u;
+    }
 
-    LOG_INFOF(log, "register id=%llu idx=%zu size=%zu", static_cast<unsigned long long>(id),
-              assigned, size_);
+    BULLSEYE_LOG_INFOF(logname::kCoreVehicleIndexMap, "register id=%llu idx=%zu size=%zu",
+                       static_cast<unsigned long long>(id), assigned, size_);
 
     return assigned;
 }
 
+std::optional<std::size_t> VehicleIndexMap::register_vehicle(VehicleId id,
+                                                             std::uint8_t grid_profile) noexcept
+{
+    if (grid_profile >= MAX_GRID_PROFILES)
+    {
+        return std::nullopt;
+    }
+    const auto idx = register_vehicle(id);
+    if (idx.has_value())
+    {
+        profiles_[*idx] = grid_profile;
+    }
+    return idx;
+}
+
+std::optional<std::size_t> VehicleIndexMap::unregister_vehicle(VehicleId id) noexcept
+{
+    std::size_t hole = find_(id);
+    if (hole == kNotFound)
+    {
+        return std::nullopt;
+    }
+    const std::size_t freed = table_[hole].slot_plus1 - 1u;
+
+    // Backward-shift deletion: pull later entries of the probe run into the hole whenever
+    // their home position does not lie cyclically in (hole, j].
+    for (std::size_t j = (hole + 1u) & table_mask_; table_[j].slot_plus1 != 0u;
+         j = (j + 1u) & table_mask_)
+    {
+        const std::size_t home = home_(table_[j].id);
+        const bool stays = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+        if (!stays)
+        {
+            table_[hole] = table_[j];
+            hole = j;
+        }
+    }
+    table_[hole] = Entry{};
+
+    set_slot_used_(freed, false);
+    --size_;
+    while (slot_count_ > 0u && !slot_used_(slot_count_ - 1u))
+    {
+        --slot_count_;
+    }
+
+    BULLSEYE_LOG_INFOF(logname::kCoreVehicleIndexMap, "unregister id=%llu idx=%zu size=%zu",
+                       static_cast<unsigned long long>(id), freed, size_);
+
+    return freed;
+}
+
 std::optional<VehicleIndexMap::VehicleId> VehicleIndexMap::id_at(std::size_t index) const noexcept
 {
-    if (index >= size_)
+    if (index >= slot_count_ || !slot_used_(index))
     {
         return std::nullopt;
     }
     return ids_[index];
 }
 
+bool VehicleIndexMap::set_grid_profile(VehicleId id, std::uint8_t grid_profile) noexcept
+{
+    const auto idx = index_of(id);
+    if (!idx.has_value() || grid_profile >= MAX_GRID_PROFILES)
+    {
+        return false;
+    }
+    profiles_[*idx] = grid_profile;
+    return true;
+}
+
+std::uint8_t VehicleIndexMap::grid_profile_at(std::size_t index) const noexcept
+{
+    if (index >= slot_count_ || !slot_used_(index))
+    {
+        return 0u;
+    }
+    return profiles_[index];
+}
+
 } // namespace bullseye_pred
@@ -1,8 +1,8 @@
 #pragma once
 
-#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
 
 #include "core/constants.hpp"
@@ -10,41 +10,74 @@
 namespace bullseye_pred
 {
 
+class CheckpointFile;
+class CheckpointWriter;
+enum class CheckpointCode : std::uint8_t;
+
 /**
- * @brief Fixed-capacity, deterministic mapping from VehicleId -> stable index [0..MAX_VEHICLES).
+ * @brief Fixed-capacity, deterministic mapping from VehicleId -> stable index [0..capacity()).
  *
  * @details
- * - Indices are assigned in insertion order and never change (until clear()).
- * - Lookup is O(N) linear search (N <= MAX_VEHICLES). This is acceptable for Sprint 1.
+ * - An index never changes while its vehicle stays registered. Registration takes the lowest
+ *   free index, so a vehicle removed with unregister_vehicle() frees its slot for the next
+ *   registration; the same register/unregister sequence always yields the same indices.
+ * - Lookup is O(1): an open-addressing (linear probing, backward-shift deletion) table with a
+ *   fixed mix of the id as hash, sized to at least twice the capacity.
+ * - Storage is allocated once at construction; no heap use afterwards.
+ *
+ * Published rows are indexed by slot, so predictors cover [0, slot_count()) and skip free
+ * slots (id_at() returns nullopt); only the first MAX_VEHICLES slots are published.
  *
- * @note
- * This container intentionally avoids hashing for determinism and simplicity.
+ * Each registered vehicle also carries a grid profile (0 by default): the predictor samples
+ * its row on that profile's grid (see BasicRelativePredictor::set_grid_profile()).
  */
 class VehicleIndexMap final
 {
   public:
     using VehicleId = std::uint64_t;
 
-    /// @param capacity Maximum number of vehicles supported by this map.
-    static constexpr std::size_t capacity() noexcept
-    {
-        return MAX_VEHICLES;
-    }
+    /// @brief Map for MAX_VEHICLES vehicles.
+    VehicleIndexMap() noexcept : VehicleIndexMap(MAX_VEHICLES) {}
+
+    /**
+     * @brief Map for up to @p capacity vehicles (capacity 0 if allocation fails).
+     */
+    explicit VehicleIndexMap(std::size_t capacity) noexcept;
 
-    VehicleIndexMap() = default;
+    VehicleIndexMap(const VehicleIndexMap&) = delete;
+    VehicleIndexMap& operator=(const VehicleIndexMap&) = delete;
 
-    /// Remove all entries and reset size to zero.
-    void clear() noexcept
+    /// @return maximum number of vehicles supported by this map.
+    std::size_t capacity() const noexcept
     {
-        size_ = 0;
+        return capacity_;
     }
 
+    /// Remove all entries and reset size to zero.
+    void clear() noexcept;
+
+    /**
+     * @brief Make this map an exact copy of @p other (same ids at the same indices).
+     *
+     * No allocation: copies into the existing storage. Used to hand a consistent snapshot of
+     * the registration to another thread (see AsyncTickPipeline).
+     *
+     * @return false (map unchanged) if the capacities differ.
+     */
+    bool copy_from(const VehicleIndexMap& other) noexcept;
+
     /// @return number of registered vehicles.
     std::size_t size() const noexcept
     {
         return size_;
     }
 
+    /// @return one past the highest index in use (== size() unless slots were freed).
+    std::size_t slot_count() const noexcept
+    {
+        return slot_count_;
+    }
+
     /// @return true if no vehicles are registered.
     bool empty() const noexcept
     {
@@ -53,10 +86,24 @@ class VehicleIndexMap final
 
     /**
      * @brief Register a vehicle id if not present.
-     * @return index if already present or newly registered; std::nullopt if capacity full.
+     * @return index if already present or newly registered (lowest free index);
+     *         std::nullopt if capacity full.
      */
     std::optional<std::size_t> register_vehicle(VehicleId id) noexcept;
 
+    /**
+     * @brief Register a vehicle id (if not present) and set its grid profile.
+     * @return as register_vehicle(id); std::nullopt also if @p grid_profile >=
+     *         MAX_GRID_PROFILES (nothing registered).
+     */
+    std::optional<std::size_t> register_vehicle(VehicleId id, std::uint8_t grid_profile) noexcept;
+
+    /**
+     * @brief Remove a vehicle; its index becomes free for the next registration.
+     * @return the index it held, or std::nullopt if it was not registered.
+     */
+    std::optional<std::size_t> unregister_vehicle(VehicleId id) noexcept;
+
     /**
      * @brief Lookup the stable index for an id.
      * @return index if present, std::nullopt otherwise.
@@ -71,13 +118,61 @@ class VehicleIndexMap final
 
     /**
      * @brief Get the id at a given stable index.
-     * @return id if index < size(); std::nullopt otherwise.
+     * @return id if the index is in use; std::nullopt for free or out-of-range indices.
      */
     std::optional<VehicleId> id_at(std::size_t index) const noexcept;
 
+    /**
+     * @brief Set the grid profile of a registered vehicle (kept until it is unregistered).
+     * @return false if @p id is not registered or @p grid_profile >= MAX_GRID_PROFILES.
+     */
+    bool set_grid_profile(VehicleId id, std::uint8_t grid_profile) noexcept;
+
+    /// @return grid profile of the vehicle at @p index; 0 for free or out-of-range indices.
+    std::uint8_t grid_profile_at(std::size_t index) const noexcept;
+
+    /**
+     * @brief Append the registration (ids, profiles, occupancy, hash table) as section
+     *        CheckpointSection::kVehicleMap (see checkpoint.hpp).
+     */
+    void save_checkpoint(CheckpointWriter& out, std::uint32_t instance = 0) const;
+
+    /**
+     * @brief Restore the registration saved by save_checkpoint() (same ids at the same indices).
+     *
+     * No allocation: copies into the existing storage, like copy_from().
+     *
+     * @return kOk, kMissingSection, or kLayoutMismatch (capacity differs; map unchanged).
+     */
+    CheckpointCode restore_checkpoint(const CheckpointFile& in,
+                                      std::uint32_t instance = 0) noexcept;
+
   private:
-    std::array<VehicleId, MAX_VEHICLES> ids_{};
+    struct Entry final
+    {
+        VehicleId id{0};
+
+        // Index + 1; 0 marks an empty table entry.
+        std::uint32_t slot_plus1{0};
+    };
+
+    std::size_t home_(VehicleId id) const noexcept;
+    std::size_t find_(VehicleId id) const noexcept;
+    bool slot_used_(std::size_t i) const noexcept;
+    void set_slot_used_(std::size_t i, bool used) noexcept;
+
+    std::size_t capacity_{0};
     std::size_t size_{0};
+    std::size_t slot_count_{0};
+
+    // Id and grid profile per index, and one occupancy bit per index.
+    std::unique_ptr<VehicleId[]> ids_{};
+    std::unique_ptr<std::uint8_t[]> profiles_{};
+    std::unique_ptr<std::uint64_t[]> used_{};
+
+    // Hash table: power-of-two size, table_mask_ = size - 1.
+    std::unique_ptr<Entry[]> table_{};
+    std::size_t table_mask_{0};
 };
 
 } // namespace bullseye_pred
@@ -0,0 +1,74 @@
+#include "core/wait_notify.hpp"
+
+#include <cmath>
+
+#if defined(__linux__)
+#include <climits>
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+namespace bullseye_pred::detail
+{
+
+#if defined(__linux__)
+
+void wait_word(const std::atomic<std::uint32_t>& word, std::uint32_t expected,
+               double timeout_sec) noexcept
+{
+    // Shared (non-private) futex so waiters in other processes mapping the word also wake.
+    auto* const addr = const_cast<std::uint32_t*>(reinterpret_cast<const std::uint32_t*>(&word));
+    if (!std::isfinite(timeout_sec))
+    {
+        (void)::syscall(SYS_futex, addr, FUTEX_WAIT, expected, nullptr, nullptr, 0);
+        return;
+    }
+    if (!(timeout_sec > 0.0))
+    {
+        return;
+    }
+    const double whole = std::floor(timeout_sec);
+    struct timespec ts{};
+    ts.tv_sec = static_cast<time_t>(whole);
+    ts.tv_nsec = static_cast<long>((timeout_sec - whole) * 1.0e9);
+    (void)::syscall(SYS_futex, addr, FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void wake_word_all(const std::atomic<std::uint32_t>& word) noexcept
+{
+    auto* const addr = const_cast<std::uint32_t*>(reinterpret_cast<const std::uint32_t*>(&word));
+    (void)::syscall(SYS_futex, addr, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+#else
+
+void wait_word(const std::atomic<std::uint32_t>& word, std::uint32_t expected,
+               double timeout_sec) noexcept
+{
+    // No futex: sleep in short slices until the word changes or the timeout expires.
+    constexpr double kSliceSec = 1.0e-3;
+    const auto start = std::chrono::steady_clock::now();
+    while (word.load(std::memory_order_acquire) == expected)
+    {
+        const double elapsed =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (std::isfinite(timeout_sec) && elapsed >= timeout_sec)
+        {
+            return;
+        }
+        const double slice =
+            std::isfinite(timeout_sec) ? std::fmin(kSliceSec, timeout_sec - elapsed) : kSliceSec;
+        std::this_thread::sleep_for(std::chrono::duration<double>(slice));
+    }
+}
+
+void wake_word_all(const std::atomic<std::uint32_t>&) noexcept {}
+
+#endif
+
+} // namespace bullseye_pred::detail
@@ -0,0 +1,32 @@
+#pragma once
+/**
+ * @file wait_notify.hpp
+ * @brief Block on / wake a 32-bit atomic word (futex on Linux, bounded sleep elsewhere).
+ *
+ * @details
+ * Equivalent to C++20 std::atomic::wait()/notify_all() for one word, usable from C++17 and
+ * across processes when the word lives in shared memory. Waiters may return spuriously;
+ * callers re-check their condition in a loop.
+ */
+
+#include <atomic>
+#include <cstdint>
+
+namespace bullseye_pred::detail
+{
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+              "futex word must be a plain 32-bit integer");
+
+/**
+ * @brief Block while @p word == @p expected, for at most @p timeout_sec.
+ *
+ * Returns immediately if the word already differs; a non-finite timeout waits indefinitely.
+ */
+void wait_word(const std::atomic<std::uint32_t>& word, std::uint32_t expected,
+               double timeout_sec) noexcept;
+
+/** @brief Wake every thread blocked in wait_word() on @p word (any process). */
+void wake_word_all(const std::atomic<std::uint32_t>& word) noexcept;
+
+} // namespace bullseye_pred::detail
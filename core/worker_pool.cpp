@@ -0,0 +1,128 @@
+// core/worker_pool.cpp
+#include "core/worker_pool.hpp"
+
+#include "core/log_names.hpp"
+#include "core/logging.hpp"
+#include "core/wait_notify.hpp"
+#include "core/log_macros.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <system_error>
+
+namespace bullseye_pred
+{
+
+WorkerPool::WorkerPool(std::size_t workers) noexcept
+{
+    const std::size_t want = std::min(workers, kMaxWorkers);
+    if (want > 0)
+    {
+        threads_.reset(new (std::nothrow) std::thread[want]);
+    }
+    if (threads_)
+    {
+        for (std::size_t i = 0; i < want; ++i)
+        {
+            try
+            {
+                threads_[i] = std::thread(&WorkerPool::worker_main_, this);
+            }
+            catch (const std::system_error&)
+            {
+                break;
+            }
+            ++count_;
+        }
+    }
+    if (count_ != want)
+    {
+        BULLSEYE_LOG_WARNF(logname::kCoreWorkerPool, "init: started %zu of %zu workers", count_,
+                           want);
+    }
+    BULLSEYE_LOG_INFOF(logname::kCoreWorkerPool, "init: workers=%zu", count_);
+}
+
+WorkerPool::~WorkerPool()
+{
+    stop_.store(true, std::memory_order_release);
+    generation_.fetch_add(1u, std::memory_order_release);
+    detail::wake_word_all(generation_);
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+        threads_[i].join();
+    }
+}
+
+void WorkerPool::drain_() noexcept
+{
+    for (;;)
+    {
+        const std::size_t k = next_.fetch_add(1, std::memory_order_relaxed);
+        if (k >= tasks_)
+        {
+            return;
+        }
+        fn_(ctx_, k);
+    }
+}
+
+void WorkerPool::worker_main_() noexcept
+{
+    std::uint32_t seen = 0;
+    for (;;)
+    {
+        std::uint32_t gen = generation_.load(std::memory_order_acquire);
+        while (gen == seen)
+        {
+            detail::wait_word(generation_, gen, std::numeric_limits<double>::infinity());
+            gen = generation_.load(std::memory_order_acquire);
+        }
+        seen = gen;
+        if (stop_.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        drain_();
+        if (busy_.fetch_sub(1u, std::memory_order_acq_rel) == 1u)
+        {
+            detail::wake_word_all(busy_);
+        }
+    }
+}
+
+void WorkerPool::run(std::size_t tasks, TaskFn fn, void* ctx) noexcept
+{
+    if (tasks == 0 || fn == nullptr)
+    {
+        return;
+    }
+    if (count_ == 0 || tasks == 1)
+    {
+        for (std::size_t k = 0; k < tasks; ++k)
+        {
+            fn(ctx, k);
+        }
+        return;
+    }
+
+    fn_ = fn;
+    ctx_ = ctx;
+    tasks_ = tasks;
+    next_.store(0, std::memory_order_relaxed);
+    busy_.store(static_cast<std::uint32_t>(count_), std::memory_order_relaxed);
+    generation_.fetch_add(1u, std::memory_order_release);
+    detail::wake_word_all(generation_);
+
+    drain_();
+
+    // Every worker reports in once per generation, so no task is still running after this.
+    for (std::uint32_t b = busy_.load(std::memory_order_acquire); b != 0u;
+         b = busy_.load(std::memory_order_acquire))
+    {
+        detail::wait_word(busy_, b, std::numeric_limits<double>::infinity());
+    }
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,91 @@
+// core/worker_pool.hpp
+#pragma once
+/**
+ * @file worker_pool.hpp
+ * @brief Fixed set of worker threads running index-addressed tasks (init-time threads only).
+ *
+ * @details
+ * run(tasks, fn, ctx) calls fn(ctx, k) exactly once for every k in [0, tasks) and returns when
+ * all calls have finished. Tasks are claimed from one shared atomic counter, so an idle thread
+ * simply takes the next unclaimed index (the caller's thread works too). Which thread runs a
+ * task is not deterministic; results are, as long as tasks write disjoint outputs and read
+ * only state that does not change during run().
+ *
+ * Threads are started once at construction and sleep on a futex word between runs
+ * (wait_notify.hpp); run() does no heap allocation. One run() at a time per pool.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+namespace bullseye_pred
+{
+
+class WorkerPool final
+{
+  public:
+    /** @brief Task entry point: called once per index with the caller's context. */
+    using TaskFn = void (*)(void* ctx, std::size_t task) noexcept;
+
+    /** @brief Largest worker count accepted by the constructor. */
+    static constexpr std::size_t kMaxWorkers = 64;
+
+    /**
+     * @brief Start @p workers threads (clamped to kMaxWorkers).
+     *
+     * The calling thread of run() works alongside them, so workers = hardware threads - 1 uses
+     * every core. If a thread cannot be started the pool keeps the ones that did (workers()
+     * reports the count); a pool with no workers runs every task on the caller.
+     */
+    explicit WorkerPool(std::size_t workers) noexcept;
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /** @brief Worker threads actually running (excluding the caller of run()). */
+    [[nodiscard]] std::size_t workers() const noexcept { return count_; }
+
+    /**
+     * @brief Call fn(ctx, k) for every k in [0, tasks); returns after the last call finished.
+     *
+     * Everything written by the tasks is visible to the caller when run() returns.
+     */
+    void run(std::size_t tasks, TaskFn fn, void* ctx) noexcept;
+
+    /** @brief run() with a callable taking the task index (invoked through a trampoline). */
+    template <typename F>
+    void run(std::size_t tasks, F& f) noexcept
+    {
+        run(tasks, &trampoline_<F>, &f);
+    }
+
+  private:
+    template <typename F>
+    static void trampoline_(void* ctx, std::size_t task) noexcept
+    {
+        (*static_cast<F*>(ctx))(task);
+    }
+
+    void worker_main_() noexcept;
+    void drain_() noexcept;
+
+    std::unique_ptr<std::thread[]> threads_{};
+    std::size_t count_{0};
+
+    // Current job (written before generation_ is bumped, read after it is observed).
+    TaskFn fn_{nullptr};
+    void* ctx_{nullptr};
+    std::size_t tasks_{0};
+    std::atomic<std::size_t> next_{0};
+
+    // Futex words: job generation (workers wait on it) and workers still busy (run() waits).
+    std::atomic<std::uint32_t> generation_{0};
+    std::atomic<std::uint32_t> busy_{0};
+    std::atomic<bool> stop_{false};
+};
+
+} // namespace bullseye_pred
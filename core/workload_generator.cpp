@@ -0,0 +1,493 @@
+// core/workload_generator.cpp
+#include "core/workload_generator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <new>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "core/bullseye_frame.hpp"
+#include "core/dummy_predictor.hpp"
+#include "core/fleet_predictor.hpp"
+#include "core/provider_twobody.hpp"
+#include "core/provider_twobody_fleet.hpp"
+#include "core/worker_pool.hpp"
+
+namespace bullseye_pred
+{
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kMu = 3.986004418e14;
+const char* const kFrame = "INERTIAL";
+
+// splitmix64 step mapped to [0, 1).
+double next_uniform(std::uint64_t& state) noexcept
+{
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    z ^= z >> 31;
+    return static_cast<double>(z >> 11) * 0x1.0p-53;
+}
+
+void inject_latency(double sec) noexcept
+{
+    if (sec > 0.0)
+    {
+        std::this_thread::sleep_for(std::chrono::duration<double>(sec));
+    }
+}
+
+bool valid_config(const WorkloadConfig& c) noexcept
+{
+    const WorkloadModelMix& m = c.mix;
+    const double weights = m.placeholder + m.hcw + m.ya_stm + m.ss_j2;
+    const auto rate = [](double p) { return p >= 0.0 && p <= 1.0; };
+    return c.vehicles >= 1u &&
+           c.vehicles <= MAX_VEHICLES * FleetRelativePredictor::kMaxFormations &&
+           std::isfinite(c.horizon_sec) && c.horizon_sec > 0.0 && std::isfinite(c.cadence_sec) &&
+           c.cadence_sec > 0.0 && !std::isnan(c.tick_hz) && m.placeholder >= 0.0 &&
+           m.hcw >= 0.0 && m.ya_stm >= 0.0 && m.ss_j2 >= 0.0 && std::isfinite(weights) &&
+           weights > 0.0 && std::isfinite(c.faults.latency_sec) && c.faults.latency_sec >= 0.0 &&
+           rate(c.faults.deputy_failure_rate) && rate(c.faults.chief_failure_rate) &&
+           c.publisher_slots >= 2u && c.threads >= 1u;
+}
+
+// Formations per model: largest remainder over the weights, ties to the earlier model.
+std::array<std::size_t, 4> split_formations(const WorkloadModelMix& m, std::size_t formations)
+{
+    const double w[4] = {m.placeholder, m.hcw, m.ya_stm, m.ss_j2};
+    const double total = w[0] + w[1] + w[2] + w[3];
+    std::array<std::size_t, 4> n{};
+    std::array<double, 4> rem{};
+    std::size_t given = 0;
+    for (std::size_t j = 0; j < 4u; ++j)
+    {
+        const double exact = w[j] / total * static_cast<double>(formations);
+        n[j] = static_cast<std::size_t>(std::floor(exact));
+        rem[j] = exact - static_cast<double>(n[j]);
+        given += n[j];
+    }
+    for (; given < formations; ++given)
+    {
+        std::size_t best = 0;
+        for (std::size_t j = 1; j < 4u; ++j)
+        {
+            if (rem[j] > rem[best])
+            {
+                best = j;
+            }
+        }
+        ++n[best];
+        rem[best] = -1.0;
+    }
+    return n;
+}
+
+PredictorModel predictor_model(WorkloadModel m) noexcept
+{
+    switch (m)
+    {
+    case WorkloadModel::kYaStm:
+        return PredictorModel::kYaStm;
+    case WorkloadModel::kSsJ2:
+        return PredictorModel::kSsJ2;
+    case WorkloadModel::kHcw:
+    case WorkloadModel::kPlaceholder:
+    default:
+        return PredictorModel::kHcw;
+    }
+}
+
+} // namespace
+
+ChiefState FaultInjectingChiefProvider::get(double t0) noexcept
+{
+    inject_latency(faults_.latency_sec);
+    ChiefState s = inner_.get(t0);
+    if (faults_.chief_failure_rate > 0.0 && next_uniform(state_) < faults_.chief_failure_rate)
+    {
+        s.status.code = ProviderCode::kNotAvailable;
+        ++failures_;
+    }
+    return s;
+}
+
+void FaultInjectingVehicleProvider::maybe_fail_(VehicleState& s) noexcept
+{
+    if (faults_.deputy_failure_rate > 0.0 && next_uniform(state_) < faults_.deputy_failure_rate)
+    {
+        s.status.code = ProviderCode::kNotAvailable;
+        ++failures_;
+    }
+}
+
+VehicleState FaultInjectingVehicleProvider::get(VehicleIndexMap::VehicleId id, double t0) noexcept
+{
+    inject_latency(faults_.latency_sec);
+    VehicleState s = inner_.get(id, t0);
+    maybe_fail_(s);
+    return s;
+}
+
+ProviderCode FaultInjectingVehicleProvider::get_many(Span<const VehicleIndexMap::VehicleId> ids,
+                                                     double t0,
+                                                     Span<VehicleState> out,
+                                                     Span<Vec3> out_r_i,
+                                                     Span<Vec3> out_v_i) noexcept
+{
+    inject_latency(faults_.latency_sec);
+    ProviderCode code = inner_.get_many(ids, t0, out, out_r_i, out_v_i);
+    if (code == ProviderCode::kInvalidInput)
+    {
+        return code;
+    }
+    for (std::size_t j = 0; j < ids.size; ++j)
+    {
+        maybe_fail_(out[j]);
+        if (code == ProviderCode::kOk && !out[j].status.ok())
+        {
+            code = out[j].status.code;
+        }
+    }
+    return code;
+}
+
+// One formation: a LEO chief with its deputies, both behind fault injection.
+struct WorkloadGenerator::Formation final
+{
+    WorkloadModel model{WorkloadModel::kHcw};
+    VehicleIndexMap map{MAX_VEHICLES};
+    TwoBodyChiefProvider chief;
+    TwoBodyVehicleProvider deputies{kFrame, kMu};
+    FaultInjectingChiefProvider faulty_chief;
+    FaultInjectingVehicleProvider faulty_deputies;
+    Publisher pub;
+    std::unique_ptr<DummyPredictor> placeholder{};
+    bool ok{true};
+
+    static Vec3 chief_r(std::size_t f) noexcept
+    {
+        return Vec3{6778e3 + 1e3 * static_cast<double>(f), 0.0, 0.0};
+    }
+
+    static Vec3 chief_v(std::size_t f) noexcept
+    {
+        const double v = std::sqrt(kMu / norm(chief_r(f)));
+        const double inc = 0.9 + 0.01 * static_cast<double>(f);
+        return Vec3{0.0, v * std::cos(inc), v * std::sin(inc)};
+    }
+
+    static PublisherConfig publisher_config(const WorkloadConfig& c) noexcept
+    {
+        PublisherConfig pc{};
+        pc.slots = c.publisher_slots;
+        return pc;
+    }
+
+    Formation(const WorkloadConfig& c, std::size_t f, std::size_t vehicles, WorkloadModel m)
+        : model(m), chief(kFrame, kMu, 0.0, chief_r(f), chief_v(f)),
+          faulty_chief(chief, c.faults, f), faulty_deputies(deputies, c.faults, f),
+          pub(publisher_config(c))
+    {
+        for (std::size_t d = 0; d < vehicles; ++d)
+        {
+            const auto id = static_cast<VehicleIndexMap::VehicleId>(d + 1);
+            const double k = static_cast<double>(d + 1);
+            const bool added = deputies.add_vehicle(
+                id, 0.0, chief_r(f) + Vec3{40.0 * k, -90.0 * k, 15.0 * k},
+                chief_v(f) + Vec3{0.01 * k, -0.02 * k, 0.005 * k});
+            ok = ok && added && map.register_vehicle(id).has_value();
+        }
+    }
+};
+
+// The pool and the fleet stepping the model formations.
+struct WorkloadGenerator::Runtime final
+{
+    std::unique_ptr<WorkerPool> pool{};
+    FleetRelativePredictor fleet;
+    std::vector<double> latencies{};
+
+    explicit Runtime(WorkerPool* p) noexcept : fleet(p) {}
+};
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadConfig& config) noexcept : config_(config)
+{
+    if (!valid_config(config_))
+    {
+        return;
+    }
+    try
+    {
+        const std::size_t count = (config_.vehicles + MAX_VEHICLES - 1u) / MAX_VEHICLES;
+        const std::array<std::size_t, 4> per_model = split_formations(config_.mix, count);
+        std::unique_ptr<WorkerPool> pool;
+        if (config_.threads > 1u)
+        {
+            pool = std::make_unique<WorkerPool>(config_.threads - 1u);
+        }
+        rt_ = std::make_unique<Runtime>(pool.get());
+        rt_->pool = std::move(pool);
+        rt_->latencies.reserve(config_.ticks);
+
+        std::size_t f = 0;
+        std::size_t left = config_.vehicles;
+        for (std::size_t m = 0; m < per_model.size(); ++m)
+        {
+            for (std::size_t j = 0; j < per_model[m]; ++j, ++f)
+            {
+                const std::size_t vehicles = std::min(left, MAX_VEHICLES);
+                left -= vehicles;
+                formations_.push_back(std::make_unique<Formation>(
+                    config_, f, vehicles, static_cast<WorkloadModel>(m)));
+            }
+        }
+
+        ok_ = true;
+        for (const auto& fm : formations_)
+        {
+            if (fm->model == WorkloadModel::kPlaceholder)
+            {
+                fm->placeholder = std::make_unique<DummyPredictor>(fm->pub, fm->map);
+                continue;
+            }
+            RelativePredictorConfig pc{};
+            pc.model = predictor_model(fm->model);
+            const std::optional<std::size_t> index =
+                rt_->fleet.add_formation(fm->pub, fm->map, fm->faulty_chief, fm->faulty_deputies,
+                                         nullptr, BullseyeFrameMode::kConstructedOnly, pc);
+            ok_ = ok_ && fm->ok && index.has_value();
+            if (index.has_value())
+            {
+                (void)rt_->fleet.formation(*index).warm_up(0.0, config_.horizon_sec,
+                                                           config_.cadence_sec);
+            }
+        }
+    }
+    catch (const std::bad_alloc&)
+    {
+        ok_ = false;
+    }
+}
+
+WorkloadGenerator::~WorkloadGenerator() = default;
+
+WorkloadModel WorkloadGenerator::formation_model(std::size_t f) const noexcept
+{
+    return formations_[f]->model;
+}
+
+const Publisher& WorkloadGenerator::publisher(std::size_t f) const noexcept
+{
+    return formations_[f]->pub;
+}
+
+std::uint64_t WorkloadGenerator::tick_(double t0) noexcept
+{
+    std::array<std::uint64_t, FleetRelativePredictor::kMaxFormations> before{};
+    for (std::size_t f = 0; f < formations_.size(); ++f)
+    {
+        before[f] = formations_[f]->pub.published_seqno();
+    }
+    if (rt_->fleet.formation_count() > 0u)
+    {
+        rt_->fleet.step(t0, config_.horizon_sec, config_.cadence_sec);
+    }
+    std::uint64_t published = 0;
+    for (std::size_t f = 0; f < formations_.size(); ++f)
+    {
+        Formation& fm = *formations_[f];
+        if (fm.placeholder)
+        {
+            fm.placeholder->step(t0, config_.horizon_sec, config_.cadence_sec);
+        }
+        published += (fm.pub.published_seqno() != before[f]) ? 1u : 0u;
+    }
+    return published;
+}
+
+WorkloadReport WorkloadGenerator::run() noexcept
+{
+    WorkloadReport rep{};
+    if (!ok_)
+    {
+        return rep;
+    }
+    rep.formations = formations_.size();
+    rep.vehicles = config_.vehicles;
+    std::uint64_t chief_failures = 0;
+    std::uint64_t deputy_failures = 0;
+    for (const auto& fm : formations_)
+    {
+        chief_failures += fm->faulty_chief.failures();
+        deputy_failures += fm->faulty_deputies.failures();
+    }
+
+    // Readers: lease the front of their formation, read every valid sample, validate.
+    struct ReaderStats final
+    {
+        std::uint64_t reads{0};
+        std::uint64_t torn{0};
+        std::uint64_t skipped{0};
+    };
+    std::atomic<bool> stop{false};
+    std::vector<ReaderStats> reader_stats(config_.readers.count);
+    std::vector<std::thread> readers;
+    readers.reserve(config_.readers.count);
+    const double read_period = (config_.readers.read_hz > 0.0) ? 1.0 / config_.readers.read_hz
+                                                               : 0.0;
+    for (std::size_t r = 0; r < config_.readers.count; ++r)
+    {
+        const Publisher& pub = formations_[r % formations_.size()]->pub;
+        ReaderStats& st = reader_stats[r];
+        try
+        {
+            readers.emplace_back([&pub, &st, &stop, read_period]() {
+                std::uint64_t last = 0;
+                double sink = 0.0;
+                auto next = Clock::now();
+                while (!stop.load(std::memory_order_acquire))
+                {
+                    const SnapshotLease lease = pub.acquire();
+                    if (lease.held() && lease->seqno != last)
+                    {
+                        const PredictionBuffer& b = lease.get();
+                        for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+                        {
+                            const std::size_t n = b.row_valid(i) ? b.row_steps(i) : 0u;
+                            for (std::size_t k = 0; k < n; ++k)
+                            {
+                                sink += b.positions[i][k].x;
+                            }
+                        }
+                        ++st.reads;
+                        if (!lease.valid())
+                        {
+                            ++st.torn;
+                        }
+                        else
+                        {
+                            st.skipped += (last != 0u && b.seqno > last + 1u)
+                                              ? b.seqno - last - 1u
+                                              : 0u;
+                            last = b.seqno;
+                        }
+                    }
+                    if (read_period > 0.0)
+                    {
+                        next += std::chrono::duration_cast<Clock::duration>(
+                            std::chrono::duration<double>(read_period));
+                        std::this_thread::sleep_until(next);
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                const volatile double keep = sink; // the reads must not be optimized out
+                (void)keep;
+            });
+        }
+        catch (const std::system_error&)
+        {
+            break; // run with the readers that started
+        }
+    }
+
+    // Fixed schedule: tick s is due at start + s * period.
+    const double period = (config_.tick_hz > 0.0) ? 1.0 / config_.tick_hz : 0.0;
+    const double t0_step = (period > 0.0) ? period : config_.cadence_sec;
+    const auto to_clock = [](double sec) {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(sec));
+    };
+    std::vector<double>& lat = rt_->latencies;
+    lat.clear();
+    double samples = 0.0;
+    const auto start = Clock::now();
+    for (std::size_t s = 0; s < config_.ticks; ++s)
+    {
+        const double t0 = static_cast<double>(next_tick_ + s) * t0_step;
+        const auto due = start + to_clock(static_cast<double>(s) * period);
+        if (period > 0.0)
+        {
+            if (Clock::now() >= due + to_clock(period))
+            {
+                ++rep.dropped_ticks;
+                continue;
+            }
+            std::this_thread::sleep_until(due);
+        }
+        const auto begin = Clock::now();
+        const std::uint64_t published = tick_(t0);
+        const auto end = Clock::now();
+        lat.push_back(std::chrono::duration<double>(end - begin).count());
+        ++rep.ticks;
+        rep.published += published;
+        rep.failed += formations_.size() - published;
+        if (period > 0.0 && end > due + to_clock(period))
+        {
+            ++rep.late_ticks;
+        }
+        for (const auto& fm : formations_)
+        {
+            const PredictionBuffer& b = fm->pub.read();
+            if (b.t0 == t0)
+            {
+                for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+                {
+                    samples += b.row_valid(i) ? static_cast<double>(b.row_steps(i)) : 0.0;
+                }
+            }
+        }
+    }
+    rep.wall_sec = std::chrono::duration<double>(Clock::now() - start).count();
+    next_tick_ += config_.ticks;
+
+    stop.store(true, std::memory_order_release);
+    for (std::thread& t : readers)
+    {
+        t.join();
+    }
+    for (const ReaderStats& st : reader_stats)
+    {
+        rep.reads += st.reads;
+        rep.torn_reads += st.torn;
+        rep.skipped_snapshots += st.skipped;
+    }
+
+    for (const auto& fm : formations_)
+    {
+        rep.chief_failures += fm->faulty_chief.failures();
+        rep.deputy_failures += fm->faulty_deputies.failures();
+    }
+    rep.chief_failures -= chief_failures;
+    rep.deputy_failures -= deputy_failures;
+
+    if (!lat.empty())
+    {
+        std::sort(lat.begin(), lat.end());
+        const auto pct = [&lat](double p) {
+            const auto rank =
+                static_cast<std::size_t>(std::ceil(p * static_cast<double>(lat.size())));
+            return lat[std::min(lat.size(), std::max<std::size_t>(rank, 1u)) - 1u];
+        };
+        rep.tick_p50_sec = pct(0.5);
+        rep.tick_p99_sec = pct(0.99);
+        rep.tick_max_sec = lat.back();
+    }
+    rep.samples_per_sec = (rep.wall_sec > 0.0) ? samples / rep.wall_sec : 0.0;
+    return rep;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,268 @@
+// core/workload_generator.hpp
+#pragma once
+/**
+ * @file workload_generator.hpp
+ * @brief Synthetic load generator for capacity validation (grown from DummyPredictor).
+ *
+ * @details
+ * A WorkloadGenerator builds a deployment-shaped workload from a WorkloadConfig and drives the
+ * real Publisher with it at a target tick rate:
+ *
+ * - vehicles are split into formations of up to MAX_VEHICLES deputies, each with its own
+ *   two-body chief and deputies, BullseyeFrame and Publisher (as a FleetRelativePredictor
+ *   deployment has);
+ * - the model mix assigns each formation a model (largest remainder over the weights, in
+ *   WorkloadModel order). Model formations are stepped together by one FleetRelativePredictor
+ *   on a WorkerPool; kPlaceholder formations run a DummyPredictor (publication cost only);
+ * - provider faults wrap every model formation's chief and deputy providers: a fixed latency
+ *   per call (sleep, as a remote feed would block) and deterministic failure rates
+ *   (FaultInjectingChiefProvider, FaultInjectingVehicleProvider);
+ * - reader threads, spread round-robin over the formations, lease the front snapshot at a
+ *   fixed rate, read every valid sample and validate the lease.
+ *
+ * run() ticks on a fixed schedule (tick k is due at k / tick_hz after the start and predicts
+ * t0 = k / tick_hz). A tick that ends after the next one was due is late; a tick whose whole
+ * period has passed before it could start is dropped (skipped, as a real-time loop would).
+ * Every predictor is warmed up (BasicRelativePredictor::warm_up()) before the first tick.
+ *
+ * The constructor allocates every formation; run() allocates only its reader threads.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/chief_state_provider.hpp"
+#include "core/constants.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Model of one synthetic formation.
+ */
+enum class WorkloadModel : std::uint8_t
+{
+    /** @brief DummyPredictor placeholder rows: publication and reader load only. */
+    kPlaceholder = 0,
+    kHcw,
+    kYaStm,
+    kSsJ2,
+};
+
+/**
+ * @brief Relative weights of the models over the formations (>= 0, not all 0).
+ */
+struct WorkloadModelMix final
+{
+    double placeholder{0.0};
+    double hcw{1.0};
+    double ya_stm{0.0};
+    double ss_j2{0.0};
+};
+
+/**
+ * @brief Injected provider behaviour (model formations only).
+ */
+struct ProviderFaultConfig final
+{
+    /** @brief Added to every chief get() and every deputy batch (get_many()) [s]. */
+    double latency_sec{0.0};
+
+    /** @brief Probability that a deputy state comes back kNotAvailable, per vehicle per tick. */
+    double deputy_failure_rate{0.0};
+
+    /** @brief Probability that the chief comes back kNotAvailable (the tick fails fast). */
+    double chief_failure_rate{0.0};
+
+    /** @brief Seed of the failure draws (formation f uses its own stream). */
+    std::uint64_t seed{1};
+};
+
+/**
+ * @brief Consumer side of the workload.
+ */
+struct WorkloadReaderConfig final
+{
+    /** @brief Reader threads (0: none). */
+    std::size_t count{0};
+
+    /** @brief Reads per second per reader (<= 0: back to back). */
+    double read_hz{50.0};
+};
+
+struct WorkloadConfig final
+{
+    /** @brief Deputies in total, in [1, MAX_VEHICLES * FleetRelativePredictor::kMaxFormations]. */
+    std::size_t vehicles{MAX_VEHICLES};
+
+    double horizon_sec{600.0};
+    double cadence_sec{1.0};
+
+    /** @brief Target tick rate [Hz] (<= 0: free-running, t0 advancing by cadence_sec). */
+    double tick_hz{2.0};
+
+    /** @brief Scheduled ticks per run() (dropped ticks included). */
+    std::size_t ticks{20};
+
+    WorkloadModelMix mix{};
+    ProviderFaultConfig faults{};
+    WorkloadReaderConfig readers{};
+
+    /** @brief Threads predicting, the caller included (the pool gets threads - 1). */
+    std::size_t threads{1};
+
+    /** @brief PublisherConfig::slots of every formation (>= 2; 3 lets leases hold). */
+    std::size_t publisher_slots{3};
+};
+
+/**
+ * @brief Outcome of one run().
+ */
+struct WorkloadReport final
+{
+    std::size_t formations{0};
+    std::size_t vehicles{0};
+
+    /** @brief Ticks run (ticks - dropped). */
+    std::uint64_t ticks{0};
+
+    /** @brief Ticks skipped because their period had passed before they could start. */
+    std::uint64_t dropped_ticks{0};
+
+    /** @brief Ticks that ended after the next tick was due. */
+    std::uint64_t late_ticks{0};
+
+    /** @brief Formation snapshots published, and formation ticks that published nothing. */
+    std::uint64_t published{0};
+    std::uint64_t failed{0};
+
+    /** @brief Injected failures (chief calls, deputy states). */
+    std::uint64_t chief_failures{0};
+    std::uint64_t deputy_failures{0};
+
+    /** @brief Tick wall time over the ticks run [s]. */
+    double tick_p50_sec{0.0};
+    double tick_p99_sec{0.0};
+    double tick_max_sec{0.0};
+
+    /** @brief Published vehicle samples per second of run() wall time. */
+    double samples_per_sec{0.0};
+    double wall_sec{0.0};
+
+    /** @brief Reader leases taken, those that failed validation, and snapshots skipped over. */
+    std::uint64_t reads{0};
+    std::uint64_t torn_reads{0};
+    std::uint64_t skipped_snapshots{0};
+};
+
+/**
+ * @brief Chief provider adding latency and deterministic failures to another one.
+ */
+class FaultInjectingChiefProvider final : public IChiefStateProvider
+{
+  public:
+    FaultInjectingChiefProvider(IChiefStateProvider& inner,
+                                const ProviderFaultConfig& faults,
+                                std::uint64_t stream) noexcept
+        : inner_(inner), faults_(faults), state_(faults.seed ^ (stream * 0x9E3779B97F4A7C15ull))
+    {
+    }
+
+    [[nodiscard]] ChiefState get(double t0) noexcept override;
+
+    /** @brief Failures injected so far. */
+    [[nodiscard]] std::uint64_t failures() const noexcept { return failures_; }
+
+  private:
+    IChiefStateProvider& inner_;
+    ProviderFaultConfig faults_;
+    std::uint64_t state_;
+    std::uint64_t failures_{0};
+};
+
+/**
+ * @brief Deputy provider adding latency (once per batch) and per-vehicle failures.
+ */
+class FaultInjectingVehicleProvider final : public IVehicleStateProvider
+{
+  public:
+    FaultInjectingVehicleProvider(IVehicleStateProvider& inner,
+                                  const ProviderFaultConfig& faults,
+                                  std::uint64_t stream) noexcept
+        : inner_(inner), faults_(faults), state_(faults.seed ^ (stream * 0xC2B2AE3D27D4EB4Full))
+    {
+    }
+
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override;
+
+    [[nodiscard]] ProviderCode get_many(Span<const VehicleIndexMap::VehicleId> ids,
+                                        double t0,
+                                        Span<VehicleState> out,
+                                        Span<Vec3> out_r_i,
+                                        Span<Vec3> out_v_i) noexcept override;
+
+    [[nodiscard]] std::uint64_t failures() const noexcept { return failures_; }
+
+  private:
+    // Fail @p s with probability deputy_failure_rate.
+    void maybe_fail_(VehicleState& s) noexcept;
+
+    IVehicleStateProvider& inner_;
+    ProviderFaultConfig faults_;
+    std::uint64_t state_;
+    std::uint64_t failures_{0};
+};
+
+/**
+ * @brief Synthetic workload over real predictors and publishers (see the file comment).
+ */
+class WorkloadGenerator final
+{
+  public:
+    explicit WorkloadGenerator(const WorkloadConfig& config) noexcept;
+    ~WorkloadGenerator();
+
+    WorkloadGenerator(const WorkloadGenerator&) = delete;
+    WorkloadGenerator& operator=(const WorkloadGenerator&) = delete;
+
+    /** @brief False if the configuration is invalid or its storage could not be allocated. */
+    [[nodiscard]] bool ok() const noexcept { return ok_; }
+
+    [[nodiscard]] const WorkloadConfig& config() const noexcept { return config_; }
+
+    [[nodiscard]] std::size_t formation_count() const noexcept { return formations_.size(); }
+
+    [[nodiscard]] WorkloadModel formation_model(std::size_t f) const noexcept;
+
+    /** @brief Formation @p f's publisher (e.g. to attach a SnapshotRecorder). */
+    [[nodiscard]] const Publisher& publisher(std::size_t f) const noexcept;
+
+    /**
+     * @brief Run config().ticks scheduled ticks with the readers attached (blocking).
+     *
+     * Returns an all-zero report if !ok(). Later calls continue the simulated clock.
+     */
+    WorkloadReport run() noexcept;
+
+  private:
+    struct Formation;
+    struct Runtime;
+
+    // One tick of every formation at t0; returns the formation ticks that published.
+    std::uint64_t tick_(double t0) noexcept;
+
+    WorkloadConfig config_;
+    bool ok_{false};
+    std::vector<std::unique_ptr<Formation>> formations_;
+    std::unique_ptr<Runtime> rt_;
+    std::uint64_t next_tick_{0};
+};
+
+} // namespace bullseye_pred
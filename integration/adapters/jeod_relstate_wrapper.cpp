@@ -0,0 +1,63 @@
+// integration/adapters/jeod_relstate_wrapper.cpp
+
+/**
+ * @file jeod_relstate_wrapper.cpp
+ * @brief JEOD bindings of JeodStateView (compiled only with BULLSEYE_WITH_JEOD).
+ */
+
+#include "integration/adapters/jeod_relstate_wrapper.hpp"
+
+#ifdef BULLSEYE_WITH_JEOD
+
+#include <string_view>
+
+#include "dynamics/derived_state/include/relative_derived_state.hh"
+#include "dynamics/dyn_body/include/dyn_body.hh"
+#include "utils/ref_frames/include/ref_frame.hh"
+#include "utils/ref_frames/include/ref_frame_manager.hh"
+#include "utils/ref_frames/include/ref_frame_state.hh"
+
+namespace bullseye_pred
+{
+
+JeodStateView jeod_state_view(const jeod::RefFrameState& state) noexcept
+{
+    JeodStateView v{};
+    v.position = state.trans.position;
+    v.velocity = state.trans.velocity;
+    v.T_parent_this = state.rot.T_parent_this;
+    v.ang_vel_this = state.rot.ang_vel_this;
+    return v;
+}
+
+JeodStateView jeod_state_view(const jeod::DynBody& body) noexcept
+{
+    return jeod_state_view(body.composite_body.state);
+}
+
+JeodStateView jeod_state_view(const jeod::RelativeDerivedState& rel) noexcept
+{
+    return jeod_state_view(rel.rel_state);
+}
+
+bool jeod_frame_named(const jeod::RefFrame& frame, const char* name) noexcept
+{
+    // get_name() is const char* or const std::string& depending on the JEOD release.
+    const std::string_view have = frame.get_name();
+    return name != nullptr && have == std::string_view{name};
+}
+
+const jeod::RefFrame* jeod_find_frame(const jeod::RefFrameManager& manager,
+                                      const char* name) noexcept
+{
+    return (name != nullptr) ? manager.find_ref_frame(name) : nullptr;
+}
+
+const jeod::RefFrame* jeod_parent_frame(const jeod::DynBody& body) noexcept
+{
+    return body.composite_body.get_parent();
+}
+
+} // namespace bullseye_pred
+
+#endif
@@ -0,0 +1,113 @@
+// integration/adapters/jeod_relstate_wrapper.hpp
+#pragma once
+
+/**
+ * @file jeod_relstate_wrapper.hpp
+ * @brief Non-owning views of JEOD RefFrameState storage, resolved once at initialization.
+ *
+ * JEOD keeps every reference frame's state relative to its parent in a RefFrameState:
+ *
+ *   trans.position[3], trans.velocity[3]      parent-frame components [m], [m/s]
+ *   rot.T_parent_this[3][3]                   x_this = T_parent_this * x_parent
+ *   rot.ang_vel_this[3]                       this frame wrt parent, this-frame components
+ *
+ * A DynBody's composite_body and a RelativeDerivedState's rel_state are both RefFrameStates.
+ * The JEOD providers (provider_jeod.hpp, frame_provider_jeod.hpp) hold a JeodStateView into
+ * that storage, so a tick reads the current state with plain loads: no frame-name lookups, no
+ * copies through JEOD accessors, no per-vehicle virtual calls.
+ *
+ * Without BULLSEYE_WITH_JEOD only the dependency-free view is available; views may then point
+ * at any storage with the RefFrameState layout (e.g. a Trick-exported mirror or a test
+ * fixture).
+ *
+ * Design constraints:
+ * - Views are plain pointers: JEOD must not reallocate the referenced objects while bound
+ *   (true for sim-lifetime DynBody / RelativeDerivedState / RefFrame instances).
+ * - No logging; no allocations.
+ */
+
+#include "core/types.hpp"
+
+#ifdef BULLSEYE_WITH_JEOD
+namespace jeod
+{
+class DynBody;
+class RefFrame;
+class RefFrameManager;
+class RefFrameState;
+class RelativeDerivedState;
+} // namespace jeod
+#endif
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief View of one JEOD RefFrameState (any member may be null when not needed).
+ */
+struct JeodStateView final
+{
+    /** @brief trans.position (3 doubles, parent-frame components) [m]. */
+    const double* position{nullptr};
+
+    /** @brief trans.velocity (3 doubles, parent-frame components) [m/s]. */
+    const double* velocity{nullptr};
+
+    /** @brief rot.T_parent_this (3x3, row-major; x_this = T x_parent). */
+    const double (*T_parent_this)[3]{nullptr};
+
+    /** @brief rot.ang_vel_this (3 doubles, this-frame components) [rad/s]. */
+    const double* ang_vel_this{nullptr};
+
+    [[nodiscard]] bool has_trans() const noexcept
+    {
+        return position != nullptr && velocity != nullptr;
+    }
+
+    [[nodiscard]] bool has_rot() const noexcept { return T_parent_this != nullptr; }
+};
+
+/** @brief Load three contiguous doubles. */
+[[nodiscard]] inline Vec3 jeod_load3(const double* p) noexcept
+{
+    return Vec3{p[0], p[1], p[2]};
+}
+
+/** @brief Load a JEOD row-major 3x3 matrix. */
+[[nodiscard]] inline Mat3 jeod_load33(const double (*T)[3]) noexcept
+{
+    Mat3 out{};
+    for (int r = 0; r < 3; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            out.m[r][c] = T[r][c];
+        }
+    }
+    return out;
+}
+
+#ifdef BULLSEYE_WITH_JEOD
+
+/** @brief View of a RefFrameState (all four members). */
+[[nodiscard]] JeodStateView jeod_state_view(const jeod::RefFrameState& state) noexcept;
+
+/** @brief View of a DynBody's composite-body state (relative to its integration frame). */
+[[nodiscard]] JeodStateView jeod_state_view(const jeod::DynBody& body) noexcept;
+
+/** @brief View of a RelativeDerivedState's rel_state (subject relative to target frame). */
+[[nodiscard]] JeodStateView jeod_state_view(const jeod::RelativeDerivedState& rel) noexcept;
+
+/** @brief true if @p frame is named @p name (init-time check; never per tick). */
+[[nodiscard]] bool jeod_frame_named(const jeod::RefFrame& frame, const char* name) noexcept;
+
+/** @brief Frame named @p name, or nullptr (init-time lookup). */
+[[nodiscard]] const jeod::RefFrame* jeod_find_frame(const jeod::RefFrameManager& manager,
+                                                    const char* name) noexcept;
+
+/** @brief Parent of a DynBody's composite body (its integration frame), or nullptr. */
+[[nodiscard]] const jeod::RefFrame* jeod_parent_frame(const jeod::DynBody& body) noexcept;
+
+#endif
+
+} // namespace bullseye_pred
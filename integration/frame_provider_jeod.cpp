@@ -0,0 +1,98 @@
+// integration/frame_provider_jeod.cpp
+#include "integration/frame_provider_jeod.hpp"
+
+#include "core/log_macros.hpp"
+#include "core/log_names.hpp"
+#include "core/logging.hpp"
+
+#include <cmath>
+
+namespace bullseye_pred
+{
+
+JeodBullseyeFrameProvider::JeodBullseyeFrameProvider(const char* frame_source_id,
+                                                     JeodStateView frame,
+                                                     JeodFrameAxes axes,
+                                                     const double* time_sec,
+                                                     double warn_period_sec) noexcept
+    : frame_source_id_(frame_source_id),
+      frame_(frame),
+      axes_(axes),
+      time_sec_(time_sec),
+      warn_period_sec_(warn_period_sec)
+{
+    BULLSEYE_LOG_INFOF(logname::kIntegrationFrameProviderJeod,
+                       "init: frame_source_id=%s axes=%s omega=%s time_source=%s",
+                       frame_source_id_ ? frame_source_id_ : "(null)",
+                       (axes_ == JeodFrameAxes::kRic) ? "ric" : "lvlh",
+                       frame_.ang_vel_this ? "bound" : "none", time_sec_ ? "bound" : "tick");
+}
+
+AdoptedRicFrame JeodBullseyeFrameProvider::get(double t0) noexcept
+{
+    AdoptedRicFrame out{};
+    out.frame_source_id = frame_source_id_;
+
+    if (frame_source_id_ == nullptr || frame_.position == nullptr || !frame_.has_rot() ||
+        !std::isfinite(t0))
+    {
+        out.status.code = ProviderCode::kInvalidInput;
+        if (!invalid_logged_ && std::isfinite(t0))
+        {
+            invalid_logged_ = true;
+            BULLSEYE_LOG_ERRORF(logname::kIntegrationFrameProviderJeod,
+                                "invalid configuration: %s",
+                                frame_source_id_ ? "frame view has no position/attitude"
+                                                 : "frame_source_id is null");
+        }
+        return out;
+    }
+    if (time_sec_ != nullptr && *time_sec_ != t0)
+    {
+        out.status.code = ProviderCode::kTimeMissing;
+        if (warn_period_sec_ <= 0.0 || (t0 - last_warn_t0_) >= warn_period_sec_)
+        {
+            last_warn_t0_ = t0;
+            BULLSEYE_LOG_WARNF(logname::kIntegrationFrameProviderJeod,
+                               "get: time missing t0=%.17g jeod_t=%.17g", t0, *time_sec_);
+        }
+        return out;
+    }
+
+    out.time_tag = t0;
+    out.frame_kind = FrameKind::kBullseyeRIC;
+    out.axis_order = AxisOrder::kRIC;
+    out.origin_i = jeod_load3(frame_.position);
+
+    // x_parent = T^T x_this; for LVLH, x_lvlh = (I, -C, -R) of x_ric.
+    const double (*T)[3] = frame_.T_parent_this;
+    Mat3& C = out.C_from_ric_to_inertial;
+    for (int i = 0; i < 3; ++i)
+    {
+        if (axes_ == JeodFrameAxes::kRic)
+        {
+            C.m[i][0] = T[0][i];
+            C.m[i][1] = T[1][i];
+            C.m[i][2] = T[2][i];
+        }
+        else
+        {
+            C.m[i][0] = -T[2][i];
+            C.m[i][1] = T[0][i];
+            C.m[i][2] = -T[1][i];
+        }
+    }
+
+    if (frame_.ang_vel_this != nullptr)
+    {
+        const Vec3 w = jeod_load3(frame_.ang_vel_this);
+        out.has_omega = true;
+        out.omega_coords = OmegaCoords::kOmegaRIC;
+        out.omega_ric = (axes_ == JeodFrameAxes::kRic) ? w : Vec3{-w.z, w.x, -w.y};
+    }
+
+    out.status.code = ProviderCode::kOk;
+    return out;
+}
+
+} // namespace bullseye_pred
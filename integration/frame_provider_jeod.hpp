@@ -0,0 +1,73 @@
+// integration/frame_provider_jeod.hpp
+#pragma once
+
+/**
+ * @file frame_provider_jeod.hpp
+ * @brief Adopted RIC frame provider bound to a JEOD reference frame's state.
+ *
+ * Policy
+ * - The frame (e.g. a JEOD LVLH frame of the chief, or an RIC frame maintained by the sim) is
+ *   bound once at initialization to a JeodStateView of its RefFrameState relative to the
+ *   integration frame (adapters/jeod_relstate_wrapper.hpp). get(t0) reads origin, attitude and
+ *   angular velocity from that storage in place; no frame lookup happens per tick.
+ * - Axes are declared at construction: kRic frames map directly; kLvlh frames use the JEOD /
+ *   NASA LVLH convention (x along-track, y opposite the orbit normal, z nadir), so
+ *   R = -z, I = x, C = -y.
+ * - ang_vel_this (frame wrt integration frame, frame components) is published as ω_RIC when
+ *   bound; otherwise the frame carries no ω.
+ * - FR-14a: with a time source the frame must be tagged exactly t0 (as JeodChiefProvider).
+ *
+ * Logging (sim-logger)
+ * - INFO on init
+ * - get(t0): no log on success
+ *   - ERROR on invalid configuration (logged once)
+ *   - WARN on missing time, rate-limited by tick time
+ */
+
+#include <cstdint>
+
+#include "core/bullseye_frame_provider.hpp"
+#include "core/types.hpp"
+#include "integration/adapters/jeod_relstate_wrapper.hpp"
+
+namespace bullseye_pred
+{
+
+/** @brief Axis convention of the bound JEOD frame. */
+enum class JeodFrameAxes : std::uint8_t
+{
+    kRic = 0, // x radial, y in-track, z cross-track
+    kLvlh,    // x along-track, y -orbit normal, z nadir
+};
+
+class JeodBullseyeFrameProvider final : public IBullseyeFrameProvider
+{
+  public:
+    /**
+     * @param frame_source_id Provenance string, e.g. the JEOD frame name (must outlive this
+     *        provider).
+     * @param frame State of the frame relative to the integration frame (position and
+     *        T_parent_this required; velocity unused; ang_vel_this optional).
+     * @param axes Axis convention of the frame.
+     * @param time_sec Time the JEOD state is valid at, or nullptr (current at t0).
+     * @param warn_period_sec Rate-limit period for repeated kTimeMissing warnings.
+     */
+    JeodBullseyeFrameProvider(const char* frame_source_id,
+                              JeodStateView frame,
+                              JeodFrameAxes axes = JeodFrameAxes::kLvlh,
+                              const double* time_sec = nullptr,
+                              double warn_period_sec = 1.0) noexcept;
+
+    [[nodiscard]] AdoptedRicFrame get(double t0) noexcept override;
+
+  private:
+    const char* frame_source_id_{nullptr};
+    JeodStateView frame_{};
+    JeodFrameAxes axes_{JeodFrameAxes::kLvlh};
+    const double* time_sec_{nullptr};
+    double warn_period_sec_{1.0};
+    double last_warn_t0_{-1.0e300};
+    bool invalid_logged_{false};
+};
+
+} // namespace bullseye_pred
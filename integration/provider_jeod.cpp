@@ -0,0 +1,230 @@
+// integration/provider_jeod.cpp
+#include "integration/provider_jeod.hpp"
+
+#include "core/log_macros.hpp"
+#include "core/frame_id_registry.hpp"
+#include "core/log_names.hpp"
+#include "core/logging.hpp"
+
+#include <optional>
+
+#ifdef BULLSEYE_WITH_JEOD
+#include "dynamics/dyn_body/include/dyn_body.hh"
+#endif
+
+namespace bullseye_pred
+{
+
+namespace
+{
+
+// Rate limit for repeated kTimeMissing warnings (tick time based, as the core providers).
+bool should_warn(double t0, double period, double& last) noexcept
+{
+    if (period <= 0.0)
+    {
+        return true;
+    }
+    if ((t0 - last) >= period)
+    {
+        last = t0;
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+// -----------------------------
+// JeodChiefProvider
+// -----------------------------
+
+JeodChiefProvider::JeodChiefProvider(const char* inertial_frame_id,
+                                     JeodStateView state,
+                                     const double* time_sec,
+                                     double warn_period_sec) noexcept
+    : inertial_frame_id_(inertial_frame_id),
+      inertial_frame_(intern_frame_id(inertial_frame_id)),
+      state_(state),
+      time_sec_(time_sec),
+      warn_period_sec_(warn_period_sec)
+{
+    BULLSEYE_LOG_INFOF(logname::kIntegrationProviderJeod,
+                       "init(chief): frame_id=%s time_source=%s warn_period_sec=%.17g",
+                       inertial_frame_id_ ? inertial_frame_id_ : "(null)",
+                       time_sec_ ? "bound" : "tick", warn_period_sec_);
+}
+
+ChiefState JeodChiefProvider::get(double t0) noexcept
+{
+    ChiefState out{};
+    out.frame_id = inertial_frame_id_;
+    out.frame = inertial_frame_;
+    if (inertial_frame_id_ == nullptr || !state_.has_trans())
+    {
+        out.status.code = ProviderCode::kInvalidInput;
+        if (!invalid_logged_)
+        {
+            invalid_logged_ = true;
+            BULLSEYE_LOG_ERRORF(logname::kIntegrationProviderJeod,
+                                "invalid configuration (chief): %s",
+                                inertial_frame_id_ ? "state view has no position/velocity"
+                                                   : "inertial_frame_id is null");
+        }
+        return out;
+    }
+    if (time_sec_ != nullptr && *time_sec_ != t0)
+    {
+        out.status.code = ProviderCode::kTimeMissing;
+        if (should_warn(t0, warn_period_sec_, last_warn_t0_))
+        {
+            BULLSEYE_LOG_WARNF(logname::kIntegrationProviderJeod,
+                               "get(chief): time missing t0=%.17g jeod_t=%.17g", t0, *time_sec_);
+        }
+        return out;
+    }
+    out.time_tag = t0;
+    out.r_i = jeod_load3(state_.position);
+    out.v_i = jeod_load3(state_.velocity);
+    out.status.code = ProviderCode::kOk;
+    return out;
+}
+
+// -----------------------------
+// JeodVehicleProvider
+// -----------------------------
+
+JeodVehicleProvider::JeodVehicleProvider(const char* inertial_frame_id,
+                                         const double* time_sec,
+                                         double warn_period_sec) noexcept
+    : inertial_frame_id_(inertial_frame_id), inertial_frame_(intern_frame_id(inertial_frame_id)),
+      time_sec_(time_sec), warn_period_sec_(warn_period_sec)
+{
+    BULLSEYE_LOG_INFOF(logname::kIntegrationProviderJeod,
+                       "init(vehicles): frame_id=%s time_source=%s capacity=%zu",
+                       inertial_frame_id_ ? inertial_frame_id_ : "(null)",
+                       time_sec_ ? "bound" : "tick", kCapacity);
+}
+
+bool JeodVehicleProvider::bind_vehicle(VehicleIndexMap::VehicleId id, JeodStateView state) noexcept
+{
+    if (!state.has_trans())
+    {
+        BULLSEYE_LOG_WARNF(logname::kIntegrationProviderJeod,
+                           "bind_vehicle: rejected id=%llu (no position/velocity storage)",
+                           static_cast<unsigned long long>(id));
+        return false;
+    }
+    const auto slot = index_.register_vehicle(id);
+    if (!slot.has_value())
+    {
+        BULLSEYE_LOG_WARNF(logname::kIntegrationProviderJeod,
+                           "bind_vehicle: rejected id=%llu (capacity %zu)",
+                           static_cast<unsigned long long>(id), kCapacity);
+        return false;
+    }
+    position_[*slot] = state.position;
+    velocity_[*slot] = state.velocity;
+    BULLSEYE_LOG_INFOF(logname::kIntegrationProviderJeod, "bind_vehicle: id=%llu slot=%zu",
+                       static_cast<unsigned long long>(id), *slot);
+    return true;
+}
+
+#ifdef BULLSEYE_WITH_JEOD
+bool JeodVehicleProvider::bind_vehicle(VehicleIndexMap::VehicleId id,
+                                       const jeod::DynBody& body) noexcept
+{
+    const jeod::RefFrame* const parent = jeod_parent_frame(body);
+    if (parent == nullptr || !jeod_frame_named(*parent, inertial_frame_id_))
+    {
+        BULLSEYE_LOG_WARNF(logname::kIntegrationProviderJeod,
+                           "bind_vehicle: rejected id=%llu (integration frame is not %s)",
+                           static_cast<unsigned long long>(id),
+                           inertial_frame_id_ ? inertial_frame_id_ : "(null)");
+        return false;
+    }
+    return bind_vehicle(id, jeod_state_view(body));
+}
+#endif
+
+ProviderCode JeodVehicleProvider::check_tick_(double t0) noexcept
+{
+    if (inertial_frame_id_ == nullptr)
+    {
+        if (!invalid_logged_)
+        {
+            invalid_logged_ = true;
+            BULLSEYE_LOG_ERRORF(logname::kIntegrationProviderJeod,
+                                "invalid configuration (vehicles): inertial_frame_id is null");
+        }
+        return ProviderCode::kInvalidInput;
+    }
+    if (time_sec_ != nullptr && *time_sec_ != t0)
+    {
+        if (should_warn(t0, warn_period_sec_, last_warn_t0_))
+        {
+            BULLSEYE_LOG_WARNF(logname::kIntegrationProviderJeod,
+                               "get_many: time missing t0=%.17g jeod_t=%.17g", t0, *time_sec_);
+        }
+        return ProviderCode::kTimeMissing;
+    }
+    return ProviderCode::kOk;
+}
+
+VehicleState JeodVehicleProvider::get(VehicleIndexMap::VehicleId id, double t0) noexcept
+{
+    VehicleState out{};
+    (void)get_many(Span<const VehicleIndexMap::VehicleId>{&id, 1}, t0, Span<VehicleState>{&out, 1},
+                   Span<Vec3>{}, Span<Vec3>{});
+    return out;
+}
+
+ProviderCode JeodVehicleProvider::get_many(Span<const VehicleIndexMap::VehicleId> ids,
+                                           double t0,
+                                           Span<VehicleState> out,
+                                           Span<Vec3> out_r_i,
+                                           Span<Vec3> out_v_i) noexcept
+{
+    const std::size_t n = ids.size;
+    if (out.size < n || (out_r_i.size != 0 && out_r_i.size < n) ||
+        (out_v_i.size != 0 && out_v_i.size < n))
+    {
+        return ProviderCode::kInvalidInput;
+    }
+
+    // One time / configuration check per tick, then one walk over the bound storage.
+    const ProviderCode tick = check_tick_(t0);
+    ProviderCode first = ProviderCode::kOk;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        VehicleState& s = out[i];
+        s = VehicleState{};
+        s.frame_id = inertial_frame_id_;
+        s.frame = inertial_frame_;
+        const auto slot = (tick == ProviderCode::kOk) ? index_.index_of(ids[i]) : std::nullopt;
+        if (!slot.has_value())
+        {
+            s.status.code = (tick != ProviderCode::kOk) ? tick : ProviderCode::kNotAvailable;
+            if (first == ProviderCode::kOk)
+            {
+                first = s.status.code;
+            }
+            continue;
+        }
+        s.time_tag = t0;
+        s.r_i = jeod_load3(position_[*slot]);
+        s.v_i = jeod_load3(velocity_[*slot]);
+        s.status.code = ProviderCode::kOk;
+        if (out_r_i.size != 0)
+        {
+            out_r_i[i] = s.r_i;
+        }
+        if (out_v_i.size != 0)
+        {
+            out_v_i[i] = s.v_i;
+        }
+    }
+    return first;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,132 @@
+// integration/provider_jeod.hpp
+#pragma once
+
+/**
+ * @file provider_jeod.hpp
+ * @brief Chief and deputy state providers reading JEOD RefFrameState storage in place.
+ *
+ * Intent
+ * - JEOD is the production source. Every state is bound once at initialization to a
+ *   JeodStateView (adapters/jeod_relstate_wrapper.hpp); a tick then reads the chief and all
+ *   deputies with plain loads from JEOD's storage. JeodVehicleProvider::get_many() serves the
+ *   whole fleet in one pass: one id lookup and six loads per vehicle, no virtual call or string
+ *   compare per vehicle.
+ * - GCR-3: bound states must be expressed in the integration frame named inertial_frame_id.
+ *   With BULLSEYE_WITH_JEOD, the DynBody overloads check the body's parent frame by name at
+ *   bind time (the only string compare); raw views are the caller's declaration.
+ *
+ * Time policy (FR-14)
+ * - With a time source (e.g. &time_manager.dyn_time.seconds, same time scale as t0) a request
+ *   succeeds only when the source reads exactly t0; otherwise kTimeMissing.
+ * - Without one (nullptr) the bound state is taken as current at t0, which holds when the
+ *   predictor runs as a Trick job scheduled after JEOD's derivative/integration jobs.
+ *
+ * Logging policy (sim-logger)
+ * - INFO on init and per bind; WARN on a rejected bind
+ * - ERROR on invalid configuration (logged once)
+ * - WARN on missing time, rate-limited by tick time
+ * - No logging on success
+ */
+
+#include <array>
+#include <cstddef>
+
+#include "core/chief_state_provider.hpp"
+#include "core/constants.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "integration/adapters/jeod_relstate_wrapper.hpp"
+
+namespace bullseye_pred
+{
+
+class JeodChiefProvider final : public IChiefStateProvider
+{
+  public:
+    /**
+     * @param inertial_frame_id Integration frame the state is expressed in (must outlive this
+     *        provider).
+     * @param state Chief translational state (position and velocity required).
+     * @param time_sec Time the JEOD state is valid at, or nullptr (see file comment).
+     * @param warn_period_sec Rate-limit period for repeated kTimeMissing warnings.
+     */
+    JeodChiefProvider(const char* inertial_frame_id,
+                      JeodStateView state,
+                      const double* time_sec = nullptr,
+                      double warn_period_sec = 1.0) noexcept;
+
+    [[nodiscard]] ChiefState get(double t0) noexcept override;
+
+  private:
+    const char* inertial_frame_id_{nullptr};
+    FrameHandle inertial_frame_{FrameHandle::kNone};
+    JeodStateView state_{};
+    const double* time_sec_{nullptr};
+    double warn_period_sec_{1.0};
+    double last_warn_t0_{-1.0e300};
+    bool invalid_logged_{false};
+};
+
+class JeodVehicleProvider final : public IVehicleStateProvider
+{
+  public:
+    /// Vehicles bound at most.
+    static constexpr std::size_t kCapacity = MAX_VEHICLES;
+
+    /**
+     * @param inertial_frame_id Integration frame every bound state is expressed in (must
+     *        outlive this provider).
+     * @param time_sec Time the JEOD states are valid at, or nullptr (see file comment).
+     * @param warn_period_sec Rate-limit period for repeated kTimeMissing warnings.
+     */
+    explicit JeodVehicleProvider(const char* inertial_frame_id,
+                                 const double* time_sec = nullptr,
+                                 double warn_period_sec = 1.0) noexcept;
+
+    /**
+     * @brief Bind (or rebind) vehicle @p id to JEOD storage (configuration-time).
+     *
+     * @return false if the view has no position or velocity, or the provider is full.
+     */
+    bool bind_vehicle(VehicleIndexMap::VehicleId id, JeodStateView state) noexcept;
+
+#ifdef BULLSEYE_WITH_JEOD
+    /**
+     * @brief Bind vehicle @p id to a DynBody's composite-body state.
+     *
+     * @return false if the body's integration frame is not inertial_frame_id, or as above.
+     */
+    bool bind_vehicle(VehicleIndexMap::VehicleId id, const jeod::DynBody& body) noexcept;
+#endif
+
+    /** @return number of vehicles bound. */
+    [[nodiscard]] std::size_t size() const noexcept { return index_.size(); }
+
+    /** kNotAvailable for ids that were never bound. */
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override;
+
+    /** One pass over JEOD storage for all @p ids (see the file comment). */
+    [[nodiscard]] ProviderCode get_many(Span<const VehicleIndexMap::VehicleId> ids,
+                                        double t0,
+                                        Span<VehicleState> out,
+                                        Span<Vec3> out_r_i,
+                                        Span<Vec3> out_v_i) noexcept override;
+
+  private:
+    [[nodiscard]] ProviderCode check_tick_(double t0) noexcept;
+
+    const char* inertial_frame_id_{nullptr};
+    FrameHandle inertial_frame_{FrameHandle::kNone};
+    const double* time_sec_{nullptr};
+    double warn_period_sec_{1.0};
+    double last_warn_t0_{-1.0e300};
+    bool invalid_logged_{false};
+
+    // id -> slot; slot -> bound position / velocity storage.
+    VehicleIndexMap index_{kCapacity};
+    std::array<const double*, kCapacity> position_{};
+    std::array<const double*, kCapacity> velocity_{};
+};
+
+} // namespace bullseye_pred
@@ -0,0 +1,149 @@
+// models/hcw_soa_kernel.cpp
+
+/**
+ * @file hcw_soa_kernel.cpp
+ * @brief SoA HCW kernel with load-time ISA dispatch.
+ */
+
+#include "models/hcw_soa_kernel.hpp"
+
+#include <algorithm>
+
+// Load-time dispatch via compiler-generated clones (x86-64 Linux, ifunc-capable toolchains).
+#if !defined(BULLSEYE_DISABLE_SIMD_DISPATCH) && defined(__x86_64__) && defined(__linux__) && \
+    defined(__has_attribute)
+#if __has_attribute(target_clones)
+#define BULLSEYE_HCW_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#endif
+#endif
+
+#ifndef BULLSEYE_HCW_TARGET_CLONES
+#define BULLSEYE_HCW_TARGET_CLONES
+#endif
+
+namespace bullseye_pred
+{
+
+HcwKernelIsa hcw_soa_kernel_isa() noexcept
+{
+#if defined(__x86_64__) && defined(__linux__) && !defined(BULLSEYE_DISABLE_SIMD_DISPATCH) && \
+    defined(__has_attribute)
+#if __has_attribute(target_clones)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return HcwKernelIsa::kAvx512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return HcwKernelIsa::kAvx2;
+    }
+#endif
+#endif
+    return HcwKernelIsa::kBaseline;
+}
+
+BULLSEYE_HCW_TARGET_CLONES
+void hcw_soa_apply_range(const HcwStmSoa& stm,
+                         std::size_t begin,
+                         std::size_t end,
+                         const RelStateRic& x0,
+                         Vec3* out_r,
+                         Vec3* out_v) noexcept
+{
+    // Blocked so the SoA results stay in registers/L1 before interleaving into Vec3 rows.
+    constexpr std::size_t kBlock = 64;
+
+    const double rx = x0.r_ric.x;
+    const double ry = x0.r_ric.y;
+    const double rz = x0.r_ric.z;
+    const double vx = x0.v_ric.x;
+    const double vy = x0.v_ric.y;
+    const double vz = x0.v_ric.z;
+
+    double a[kBlock];
+    double b[kBlock];
+    double d[kBlock];
+
+    for (std::size_t k0 = begin; k0 < end; k0 += kBlock)
+    {
+        const std::size_t n = std::min(kBlock, end - k0);
+
+        const double* pos_xx = stm.pos_xx.data() + k0;
+        const double* sin_n = stm.sin_n.data() + k0;
+        const double* cos1_2n = stm.cos1_2n.data() + k0;
+        const double* pos_yx = stm.pos_yx.data() + k0;
+        const double* pos_yy = stm.pos_yy.data() + k0;
+        const double* c = stm.c.data() + k0;
+
+        // Position (same operation order as hcw_stm_apply).
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            a[j] = pos_xx[j] * rx + sin_n[j] * vx + cos1_2n[j] * vy;
+            b[j] = pos_yx[j] * rx + ry - cos1_2n[j] * vx + pos_yy[j] * vy;
+            d[j] = c[j] * rz + sin_n[j] * vz;
+        }
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            out_r[k0 + j] = Vec3{a[j], b[j], d[j]};
+        }
+
+        if (out_v != nullptr)
+        {
+            const double* vel_xx = stm.vel_xx.data() + k0;
+            const double* sin_2 = stm.sin_2.data() + k0;
+            const double* vel_yx = stm.vel_yx.data() + k0;
+            const double* vel_yy = stm.vel_yy.data() + k0;
+            const double* vel_zz = stm.vel_zz.data() + k0;
+
+            // Velocity
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                a[j] = vel_xx[j] * rx + c[j] * vx + sin_2[j] * vy;
+                b[j] = vel_yx[j] * rx - sin_2[j] * vx + vel_yy[j] * vy;
+                d[j] = vel_zz[j] * rz + c[j] * vz;
+            }
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                out_v[k0 + j] = Vec3{a[j], b[j], d[j]};
+            }
+        }
+    }
+}
+
+void hcw_soa_apply(const HcwStmSoa& stm,
+                   std::size_t steps,
+                   const RelStateRic& x0,
+                   Vec3* out_r,
+                   Vec3* out_v) noexcept
+{
+    hcw_soa_apply_range(stm, 0, steps, x0, out_r, out_v);
+}
+
+void hcw_soa_apply_scalar(const HcwStmSoa& stm,
+                          std::size_t steps,
+                          const RelStateRic& x0,
+                          Vec3* out_r,
+                          Vec3* out_v) noexcept
+{
+    const bool want_vel = (out_v != nullptr);
+    Vec3 v_unused{};
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        HcwStm m{};
+        m.pos_xx = stm.pos_xx[k];
+        m.sin_n = stm.sin_n[k];
+        m.cos1_2n = stm.cos1_2n[k];
+        m.pos_yx = stm.pos_yx[k];
+        m.pos_yy = stm.pos_yy[k];
+        m.c = stm.c[k];
+        m.vel_xx = stm.vel_xx[k];
+        m.sin_2 = stm.sin_2[k];
+        m.vel_yx = stm.vel_yx[k];
+        m.vel_yy = stm.vel_yy[k];
+        m.vel_zz = stm.vel_zz[k];
+        hcw_stm_apply(m, x0, want_vel, out_r[k], want_vel ? out_v[k] : v_unused);
+    }
+}
+
+} // namespace bullseye_pred
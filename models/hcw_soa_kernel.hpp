@@ -0,0 +1,126 @@
+// models/hcw_soa_kernel.hpp
+#pragma once
+
+/**
+ * @file hcw_soa_kernel.hpp
+ * @brief Structure-of-arrays HCW STM table and its vectorizable apply kernel.
+ *
+ * The STM entries are stored as one array per entry, so evaluating one vehicle over many time
+ * steps is a straight multiply-add over contiguous lanes. The kernel is built for several ISAs
+ * (AVX-512, AVX2, baseline) and selected at load time on x86-64 Linux; elsewhere only the
+ * baseline build exists.
+ *
+ * Determinism:
+ * - Every variant performs the same IEEE operations in the same order as hcw_stm_apply()
+ *   (no FMA contraction; the kernel TU is built with -ffp-contract=off), so all variants and
+ *   the scalar reference are bit-identical.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/constants.hpp"
+#include "models/hcw_stm.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief HCW STM entries over a grid, one array per entry (see HcwStm).
+ */
+struct HcwStmSoa final
+{
+    alignas(64) std::array<double, MAX_STEPS> pos_xx{};
+    alignas(64) std::array<double, MAX_STEPS> sin_n{};
+    alignas(64) std::array<double, MAX_STEPS> cos1_2n{};
+    alignas(64) std::array<double, MAX_STEPS> pos_yx{};
+    alignas(64) std::array<double, MAX_STEPS> pos_yy{};
+    alignas(64) std::array<double, MAX_STEPS> c{};
+    alignas(64) std::array<double, MAX_STEPS> vel_xx{};
+    alignas(64) std::array<double, MAX_STEPS> sin_2{};
+    alignas(64) std::array<double, MAX_STEPS> vel_yx{};
+    alignas(64) std::array<double, MAX_STEPS> vel_yy{};
+    alignas(64) std::array<double, MAX_STEPS> vel_zz{};
+
+    /**
+     * @brief Store the STM of one grid point.
+     *
+     * @param k Step index (< MAX_STEPS).
+     * @param m STM entries at tau_k.
+     */
+    void set(std::size_t k, const HcwStm& m) noexcept
+    {
+        pos_xx[k] = m.pos_xx;
+        sin_n[k] = m.sin_n;
+        cos1_2n[k] = m.cos1_2n;
+        pos_yx[k] = m.pos_yx;
+        pos_yy[k] = m.pos_yy;
+        c[k] = m.c;
+        vel_xx[k] = m.vel_xx;
+        sin_2[k] = m.sin_2;
+        vel_yx[k] = m.vel_yx;
+        vel_yy[k] = m.vel_yy;
+        vel_zz[k] = m.vel_zz;
+    }
+};
+
+/**
+ * @brief Instruction set selected for hcw_soa_apply().
+ */
+enum class HcwKernelIsa : std::uint8_t
+{
+    kBaseline = 0,
+    kAvx2 = 1,
+    kAvx512 = 2,
+};
+
+/**
+ * @brief Report the ISA variant hcw_soa_apply() dispatches to on this CPU.
+ */
+[[nodiscard]] HcwKernelIsa hcw_soa_kernel_isa() noexcept;
+
+/**
+ * @brief Evaluate one vehicle over the first `steps` grid points (dispatched kernel).
+ *
+ * @param stm STM table.
+ * @param steps Number of steps (<= MAX_STEPS).
+ * @param x0 Initial relative state.
+ * @param out_r Output positions (steps elements, required).
+ * @param out_v Output velocities (steps elements) or nullptr.
+ */
+void hcw_soa_apply(const HcwStmSoa& stm,
+                   std::size_t steps,
+                   const RelStateRic& x0,
+                   Vec3* out_r,
+                   Vec3* out_v) noexcept;
+
+/**
+ * @brief Evaluate one vehicle over grid points [begin, end) only (dispatched kernel).
+ *
+ * Bit-identical to the corresponding entries of hcw_soa_apply(); out_r / out_v are indexed by
+ * absolute step (entries outside [begin, end) are not touched).
+ *
+ * @param begin First step.
+ * @param end One past the last step (<= MAX_STEPS).
+ */
+void hcw_soa_apply_range(const HcwStmSoa& stm,
+                         std::size_t begin,
+                         std::size_t end,
+                         const RelStateRic& x0,
+                         Vec3* out_r,
+                         Vec3* out_v) noexcept;
+
+/**
+ * @brief Scalar reference for hcw_soa_apply() (one hcw_stm_apply() per step).
+ *
+ * Same parameters and bit-identical results; used for verification.
+ */
+void hcw_soa_apply_scalar(const HcwStmSoa& stm,
+                          std::size_t steps,
+                          const RelStateRic& x0,
+                          Vec3* out_r,
+                          Vec3* out_v) noexcept;
+
+} // namespace bullseye_pred
@@ -0,0 +1,202 @@
+// models/hcw_stm.hpp
+#pragma once
+
+/**
+ * @file hcw_stm.hpp
+ * @brief HCW state-transition matrix at one grid time, stored by its nonzero entries.
+ *
+ * The HCW STM Phi(tau) depends only on (n, tau). Storing its 11 distinct nonzero entries lets
+ * batched and cached evaluation apply Phi to many states without transcendentals. Products are
+ * grouped exactly as in the closed-form expressions, so every path (single, batched, cached)
+ * produces bit-identical results for the same n and tau.
+ */
+
+#include <cmath>
+
+#include "core/math/sincos_recurrence.hpp"
+#include "core/time_grid.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Nonzero entries of the HCW STM Phi(tau), RIC axes x=R, y=I, z=C.
+ *
+ * With s = sin(n tau), c = cos(n tau):
+ *
+ *   [x ]   [4-3c       0  0  s/n        (2/n)(1-c)       0  ] [x0 ]
+ *   [y ]   [6(s-nt)    1  0  -(2/n)(1-c) (1/n)(4s-3nt)   0  ] [y0 ]
+ *   [z ] = [0          0  c  0          0                s/n] [z0 ]
+ *   [xd]   [3ns        0  0  c          2s               0  ] [xd0]
+ *   [yd]   [6n(c-1)    0  0  -2s        4c-3             0  ] [yd0]
+ *   [zd]   [0          0 -ns 0          0                c  ] [zd0]
+ */
+template <class T>
+struct BasicHcwStm final
+{
+    T pos_xx;  // 4 - 3c
+    T sin_n;   // s / n
+    T cos1_2n; // (2/n)(1 - c)
+    T pos_yx;  // 6 (s - nt)
+    T pos_yy;  // (1/n)(4s - 3nt)
+    T c;       // cos nt
+    T vel_xx;  // 3 n s
+    T sin_2;   // 2 s
+    T vel_yx;  // 6 n (c - 1)
+    T vel_yy;  // 4c - 3
+    T vel_zz;  // -n s
+};
+
+/// The predictor's STM; BasicHcwStm<float> serves float-precision consumer builds.
+using HcwStm = BasicHcwStm<double>;
+
+/**
+ * @brief Assemble the HCW STM from nt and its sine/cosine.
+ *
+ * @param n Mean motion [rad/s].
+ * @param inv_n 1 / n.
+ * @param nt n * tau [rad].
+ * @param s sin(nt).
+ * @param c cos(nt).
+ * @return STM entries at tau.
+ */
+template <class T>
+[[nodiscard]] inline BasicHcwStm<T> hcw_stm_from(T n, T inv_n, T nt, T s, T c) noexcept
+{
+    BasicHcwStm<T> k{};
+    k.pos_xx = T(4) - T(3) * c;
+    k.sin_n = inv_n * s;
+    k.cos1_2n = (T(2) * inv_n) * (T(1) - c);
+    k.pos_yx = T(6) * (s - nt);
+    k.pos_yy = inv_n * (T(4) * s - T(3) * nt);
+    k.c = c;
+    k.vel_xx = T(3) * n * s;
+    k.sin_2 = T(2) * s;
+    k.vel_yx = T(6) * n * (c - T(1));
+    k.vel_yy = T(4) * c - T(3);
+    k.vel_zz = -n * s;
+    return k;
+}
+
+/**
+ * @brief Evaluate the HCW STM at grid offset t (libm trig).
+ *
+ * @param n Mean motion [rad/s].
+ * @param inv_n 1 / n.
+ * @param t Grid offset [s].
+ * @return STM entries at t.
+ */
+template <class T>
+[[nodiscard]] inline BasicHcwStm<T> hcw_stm_at(T n, T inv_n, T t) noexcept
+{
+    const T nt = n * t;
+    return hcw_stm_from<T>(n, inv_n, nt, std::sin(nt), std::cos(nt));
+}
+
+/**
+ * @brief Sequential HCW STM evaluation over a grid (k = 0, 1, 2, ... in order).
+ *
+ * Uses the uniform-grid sin/cos recurrence when HcwParams::trig_reanchor_interval > 0 and the
+ * grid is uniform; otherwise identical to hcw_stm_at() at every step.
+ */
+class HcwStmSequence final
+{
+  public:
+    /**
+     * @param params HCW parameters (n must already be validated).
+     * @param grid Grid that next() will walk.
+     */
+    HcwStmSequence(const HcwParams& params, const TimeGrid& grid) noexcept
+        : n_(params.n_radps), inv_n_(1.0 / params.n_radps), trig_(0.0, 1)
+    {
+        double cadence = 0.0;
+        if (params.trig_reanchor_interval > 0 && uniform_cadence(grid, cadence))
+        {
+            trig_ = math::UniformSinCos(n_ * cadence, params.trig_reanchor_interval);
+            recurrence_ = true;
+        }
+    }
+
+    /**
+     * @brief STM at the next grid offset.
+     *
+     * @param t Grid offset tau_k [s] (must be the next element of the grid).
+     */
+    [[nodiscard]] HcwStm next(double t) noexcept
+    {
+        if (!recurrence_)
+        {
+            return hcw_stm_at(n_, inv_n_, t);
+        }
+        const double nt = n_ * t;
+        trig_.next(nt);
+        return hcw_stm_from(n_, inv_n_, nt, trig_.sin(), trig_.cos());
+    }
+
+    /** @brief True if the recurrence fast path is active. */
+    [[nodiscard]] bool uses_recurrence() const noexcept { return recurrence_; }
+
+  private:
+    double n_{0.0};
+    double inv_n_{0.0};
+    math::UniformSinCos trig_;
+    bool recurrence_{false};
+};
+
+/**
+ * @brief Apply the HCW STM to one initial state (position @p r, velocity @p v).
+ *
+ * @param k STM entries at the target time.
+ * @param r Initial relative position.
+ * @param v Initial relative velocity.
+ * @param want_vel Whether to evaluate the velocity.
+ * @param out_r Output position.
+ * @param out_v Output velocity (written only if want_vel).
+ */
+template <class T>
+inline void hcw_stm_apply(const BasicHcwStm<T>& k,
+                          const BasicVec3<T>& r,
+                          const BasicVec3<T>& v,
+                          bool want_vel,
+                          BasicVec3<T>& out_r,
+                          BasicVec3<T>& out_v) noexcept
+{
+    // Position
+    const T x = k.pos_xx * r.x
+              + k.sin_n * v.x
+              + k.cos1_2n * v.y;
+
+    const T y = k.pos_yx * r.x
+              + r.y
+              - k.cos1_2n * v.x
+              + k.pos_yy * v.y;
+
+    const T z = k.c * r.z + k.sin_n * v.z;
+
+    out_r = BasicVec3<T>{x, y, z};
+
+    if (want_vel)
+    {
+        // Velocity
+        const T xd = k.vel_xx * r.x + k.c * v.x + k.sin_2 * v.y;
+        const T yd = k.vel_yx * r.x - k.sin_2 * v.x + k.vel_yy * v.y;
+        const T zd = k.vel_zz * r.z + k.c * v.z;
+
+        out_v = BasicVec3<T>{xd, yd, zd};
+    }
+}
+
+/**
+ * @brief Apply the HCW STM to one initial relative state.
+ */
+inline void hcw_stm_apply(const HcwStm& k,
+                          const RelStateRic& x0,
+                          bool want_vel,
+                          Vec3& out_r,
+                          Vec3& out_v) noexcept
+{
+    hcw_stm_apply(k, x0.r_ric, x0.v_ric, want_vel, out_r, out_v);
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,262 @@
+// models/hcw_stm_cache.cpp
+
+/**
+ * @file hcw_stm_cache.cpp
+ * @brief HCW STM cache implementation.
+ */
+
+#include "models/hcw_stm_cache.hpp"
+
+#include "core/checkpoint.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace bullseye_pred
+{
+
+ModelCode HcwStmCache::refresh(const HcwParams& params, const TimeGrid& grid) noexcept
+{
+    const double n = params.n_radps;
+    if (!(n > 0.0) || !std::isfinite(n))
+    {
+        valid_ = false;
+        return ModelCode::kInvalidInput;
+    }
+
+    const std::size_t steps = grid.tau.size();
+    if (steps > MAX_STEPS)
+    {
+        valid_ = false;
+        return ModelCode::kInsufficientOutputCapacity;
+    }
+
+    // Reuse check: same grid (bitwise), same trig path, n within tolerance of the cached value.
+    if (valid_ && steps == steps_ && params.trig_reanchor_interval == reanchor_ &&
+        (steps == 0 || std::memcmp(tau_.data(), grid.tau.data(), steps * sizeof(double)) == 0) &&
+        std::fabs(n - n_) <= n_rel_tol_ * n_)
+    {
+        return ModelCode::kOk;
+    }
+
+    valid_ = false;
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        const double t = grid.tau[k];
+        if (!(t >= 0.0) || !std::isfinite(t))
+        {
+            return ModelCode::kInvalidInput;
+        }
+    }
+
+    HcwStmSequence seq(params, grid);
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        tau_[k] = grid.tau[k];
+        stm_.set(k, seq.next(grid.tau[k]));
+    }
+
+    double cadence = 0.0;
+    uniform_ = uniform_cadence(grid, cadence);
+    n_ = n;
+    reanchor_ = params.trig_reanchor_interval;
+    steps_ = steps;
+    valid_ = true;
+    ++rebuilds_;
+    return ModelCode::kOk;
+}
+
+HcwStmCache::Result HcwStmCache::predict(const RelStateRic& x0_ric,
+                                         Span<Vec3> out_r_ric,
+                                         Span<Vec3> out_v_ric) const noexcept
+{
+    Result res{};
+    if (!valid_ || !finite3(x0_ric.r_ric) || !finite3(x0_ric.v_ric))
+    {
+        res.code = ModelCode::kInvalidInput;
+        return res;
+    }
+    if (steps_ == 0)
+    {
+        return res;
+    }
+    if (out_r_ric.data == nullptr || out_r_ric.size < steps_)
+    {
+        res.code = ModelCode::kInsufficientOutputCapacity;
+        return res;
+    }
+
+    const bool want_vel = (out_v_ric.data != nullptr && out_v_ric.size >= steps_);
+    hcw_soa_apply(stm_, steps_, x0_ric, out_r_ric.data, want_vel ? out_v_ric.data : nullptr);
+
+    res.code = ModelCode::kOk;
+    res.steps_written = steps_;
+    return res;
+}
+
+HcwStmCache::Result HcwStmCache::accumulate_impulse(const Vec3& dv_ric,
+                                                    double tau_burn,
+                                                    Span<Vec3> out_r_ric,
+                                                    Span<Vec3> out_v_ric) const noexcept
+{
+    Result res{};
+    if (!valid_ || !finite3(dv_ric) || !std::isfinite(tau_burn))
+    {
+        res.code = ModelCode::kInvalidInput;
+        return res;
+    }
+    if (out_r_ric.data == nullptr || out_r_ric.size < steps_)
+    {
+        res.code = ModelCode::kInsufficientOutputCapacity;
+        return res;
+    }
+
+    const bool want_vel = (out_v_ric.data != nullptr && out_v_ric.size >= steps_);
+    const std::size_t first = static_cast<std::size_t>(
+        std::lower_bound(tau_.data(), tau_.data() + steps_, tau_burn) - tau_.data());
+    const double inv_n = 1.0 / n_;
+    const Vec3 zero{};
+
+    if (uniform_ && first < steps_)
+    {
+        // Phi(tau_k - t_b) = Phi(tau_{k - first}) Phi(tau_first - t_b): one closed-form segment
+        // up to the first sample, then the cached table from there.
+        RelStateRic x{};
+        hcw_stm_apply(hcw_stm_at(n_, inv_n, tau_[first] - tau_burn), zero, dv_ric, true, x.r_ric,
+                      x.v_ric);
+        const std::size_t m = steps_ - first;
+        std::array<Vec3, MAX_STEPS> dr;
+        std::array<Vec3, MAX_STEPS> dv;
+        hcw_soa_apply(stm_, m, x, dr.data(), want_vel ? dv.data() : nullptr);
+        for (std::size_t k = 0; k < m; ++k)
+        {
+            out_r_ric.data[first + k] = out_r_ric.data[first + k] + dr[k];
+        }
+        for (std::size_t k = 0; want_vel && k < m; ++k)
+        {
+            out_v_ric.data[first + k] = out_v_ric.data[first + k] + dv[k];
+        }
+    }
+    else
+    {
+        for (std::size_t k = first; k < steps_; ++k)
+        {
+            Vec3 r{};
+            Vec3 v{};
+            hcw_stm_apply(hcw_stm_at(n_, inv_n, tau_[k] - tau_burn), zero, dv_ric, want_vel, r, v);
+            out_r_ric.data[k] = out_r_ric.data[k] + r;
+            if (want_vel)
+            {
+                out_v_ric.data[k] = out_v_ric.data[k] + v;
+            }
+        }
+    }
+
+    res.code = ModelCode::kOk;
+    res.steps_written = steps_;
+    return res;
+}
+
+HcwStmCache::Result HcwStmCache::predict_tail(const RelStateRic& x0_ric,
+                                              std::size_t first,
+                                              Span<Vec3> out_r_ric,
+                                              Span<Vec3> out_v_ric) const noexcept
+{
+    Result res{};
+    if (!valid_ || first > steps_ || !finite3(x0_ric.r_ric) || !finite3(x0_ric.v_ric))
+    {
+        res.code = ModelCode::kInvalidInput;
+        return res;
+    }
+    if (out_r_ric.data == nullptr || out_r_ric.size < steps_)
+    {
+        res.code = ModelCode::kInsufficientOutputCapacity;
+        return res;
+    }
+
+    const bool want_vel = (out_v_ric.data != nullptr && out_v_ric.size >= steps_);
+    hcw_soa_apply_range(stm_, first, steps_, x0_ric, out_r_ric.data,
+                        want_vel ? out_v_ric.data : nullptr);
+
+    res.code = ModelCode::kOk;
+    res.steps_written = steps_;
+    return res;
+}
+
+HcwStmCache::Result HcwStmCache::predict_batch(Span<const RelStateRic> x0_ric,
+                                               Span2D<Vec3> out_r_ric,
+                                               Span2D<Vec3> out_v_ric,
+                                               Span<ModelCode> out_row_codes) const noexcept
+{
+    Result res{};
+    if (!valid_)
+    {
+        res.code = ModelCode::kInvalidInput;
+        return res;
+    }
+
+    const std::size_t count = x0_ric.size;
+    const std::size_t steps = steps_;
+    if (count == 0 || steps == 0)
+    {
+        res.code = ModelCode::kOk;
+        res.steps_written = 0;
+        return res;
+    }
+
+    if (out_r_ric.data == nullptr || out_r_ric.rows < count || out_r_ric.cols < steps)
+    {
+        res.code = ModelCode::kInsufficientOutputCapacity;
+        return res;
+    }
+
+    const bool want_vel =
+        (out_v_ric.data != nullptr && out_v_ric.rows >= count && out_v_ric.cols >= steps);
+    const bool want_codes = (out_row_codes.data != nullptr && out_row_codes.size >= count);
+
+    // Row-major here: the table is shared, so each row streams through it once.
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const RelStateRic& x0 = x0_ric[i];
+        const bool ok = finite3(x0.r_ric) && finite3(x0.v_ric);
+        if (want_codes)
+        {
+            out_row_codes[i] = ok ? ModelCode::kOk : ModelCode::kInvalidInput;
+        }
+        if (!ok)
+        {
+            continue; // row left untouched
+        }
+
+        hcw_soa_apply(stm_, steps, x0, out_r_ric.row(i).data,
+                      want_vel ? out_v_ric.row(i).data : nullptr);
+    }
+
+    res.code = ModelCode::kOk;
+    res.steps_written = steps;
+    return res;
+}
+
+static_assert(std::is_trivially_copyable<HcwStmCache>::value,
+              "the STM cache is checkpointed by raw copy");
+
+void HcwStmCache::save_checkpoint(CheckpointWriter& out) const
+{
+    out.append_value(*this);
+}
+
+bool HcwStmCache::restore_checkpoint(CheckpointCursor& in) noexcept
+{
+    if (in.remaining() < checkpoint_bytes())
+    {
+        return false;
+    }
+    const double n_rel_tol = n_rel_tol_;
+    (void)in.read_value(*this);
+    n_rel_tol_ = n_rel_tol;
+    return true;
+}
+
+} // namespace bullseye_pred
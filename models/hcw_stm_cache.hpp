@@ -0,0 +1,175 @@
+// models/hcw_stm_cache.hpp
+#pragma once
+
+/**
+ * @file hcw_stm_cache.hpp
+ * @brief HCW STM table cached across ticks, keyed on (n, grid, trig re-anchor interval).
+ *
+ * HCW is linear: for fixed mean motion n and TimeGrid, the trajectory is Phi(tau_k) x0. A
+ * near-circular chief yields nearly the same n every tick, so the table is rebuilt only when
+ * the grid changes or n moves beyond a relative tolerance; otherwise prediction is a
+ * transcendental-free multiply-add kernel (SoA layout, ISA-dispatched; see hcw_soa_kernel.hpp).
+ *
+ * Design constraints:
+ * - Fixed capacity (MAX_STEPS); no heap allocations.
+ * - No logging.
+ * - Deterministic: reuse decisions depend only on the sequence of (n, grid) presented.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/constants.hpp"
+#include "models/hcw_soa_kernel.hpp"
+#include "models/hcw_stm.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+class CheckpointCursor;
+class CheckpointWriter;
+
+class HcwStmCache final
+{
+  public:
+    using Result = IRelativeModel::Result;
+
+    /**
+     * @brief Construct an empty cache.
+     *
+     * @param n_rel_tol Reuse the table while |n - n_cached| <= n_rel_tol * n_cached.
+     *                  0 rebuilds on any change of n (results identical to ModelHCW).
+     */
+    explicit HcwStmCache(double n_rel_tol = 0.0) noexcept : n_rel_tol_(n_rel_tol) {}
+
+    /**
+     * @brief Make the table valid for (params, grid), rebuilding only if needed.
+     *
+     * A grid is considered unchanged if it has the same size and bitwise-equal offsets.
+     * On failure the cache is left empty.
+     *
+     * @param params HCW parameters (n must be finite and > 0).
+     * @param grid Time grid (tau finite, >= 0, at most MAX_STEPS points).
+     * @return kOk, kInvalidInput, or kInsufficientOutputCapacity (grid exceeds MAX_STEPS).
+     */
+    [[nodiscard]] ModelCode refresh(const HcwParams& params, const TimeGrid& grid) noexcept;
+
+    /**
+     * @brief Apply the cached table to a batch of initial states.
+     *
+     * Same output and per-row semantics as IRelativeModel::predict_hcw_batch(), evaluated with
+     * the cached n.
+     *
+     * @param x0_ric Initial relative states at t0 in RIC, one per row.
+     * @param out_r_ric Output positions [row][step] (required).
+     * @param out_v_ric Output velocities [row][step] (optional; may be empty).
+     * @param out_row_codes Per-row status (optional; may be {nullptr,0}).
+     * @return Batch code (kInvalidInput if the cache is empty) and steps written per row.
+     */
+    [[nodiscard]] Result predict_batch(Span<const RelStateRic> x0_ric,
+                                       Span2D<Vec3> out_r_ric,
+                                       Span2D<Vec3> out_v_ric,
+                                       Span<ModelCode> out_row_codes) const noexcept;
+
+    /**
+     * @brief Apply the cached table to one initial state.
+     *
+     * Same output semantics as IRelativeModel::predict_hcw(), evaluated with the cached n.
+     *
+     * @param x0_ric Initial relative state at t0 in RIC.
+     * @param out_r_ric Output positions (required; >= steps() elements).
+     * @param out_v_ric Output velocities (optional; may be {nullptr,0}).
+     * @return kInvalidInput if the cache is empty or x0 is non-finite.
+     */
+    [[nodiscard]] Result predict(const RelStateRic& x0_ric,
+                                 Span<Vec3> out_r_ric,
+                                 Span<Vec3> out_v_ric) const noexcept;
+
+    /**
+     * @brief Apply the cached table to one initial state over steps [first, steps()) only.
+     *
+     * Bit-identical to the same entries of predict(); earlier entries are not touched. Used to
+     * extend a reused (shifted) trajectory by its new tail.
+     *
+     * @param first First step to evaluate (<= steps()).
+     * @param out_r_ric Output positions indexed by absolute step (>= steps() elements).
+     * @param out_v_ric Output velocities (optional; may be {nullptr,0}).
+     * @return kInvalidInput if the cache is empty, x0 is non-finite, or first > steps().
+     */
+    [[nodiscard]] Result predict_tail(const RelStateRic& x0_ric,
+                                      std::size_t first,
+                                      Span<Vec3> out_r_ric,
+                                      Span<Vec3> out_v_ric) const noexcept;
+
+    /**
+     * @brief Add the response to an impulsive velocity change to a predicted trajectory.
+     *
+     * HCW is linear and time invariant, so a burn dv at grid offset t_b adds
+     * Phi(tau_k - t_b) [0; dv] to every sample with tau_k >= t_b (velocities there are
+     * post-burn). On a uniform grid this is one closed-form STM evaluation to the first sample
+     * at or after t_b, then the cached table shifted to that sample; otherwise one closed-form
+     * evaluation per affected sample.
+     *
+     * @param dv_ric Velocity change in RIC [m/s].
+     * @param tau_burn Burn time as a grid offset [s].
+     * @param out_r_ric Positions to update (>= steps() elements).
+     * @param out_v_ric Velocities to update (optional; may be {nullptr,0}).
+     * @return kInvalidInput if the cache is empty or an input is non-finite.
+     */
+    [[nodiscard]] Result accumulate_impulse(const Vec3& dv_ric,
+                                            double tau_burn,
+                                            Span<Vec3> out_r_ric,
+                                            Span<Vec3> out_v_ric) const noexcept;
+
+    /** @brief True once refresh() has succeeded. */
+    [[nodiscard]] bool valid() const noexcept { return valid_; }
+
+    /** @brief Mean motion the table was built with [rad/s]. */
+    [[nodiscard]] double n_radps() const noexcept { return n_; }
+
+    /** @brief Number of grid points in the table. */
+    [[nodiscard]] std::size_t steps() const noexcept { return steps_; }
+
+    /** @brief Number of table rebuilds since construction. */
+    [[nodiscard]] std::uint64_t rebuilds() const noexcept { return rebuilds_; }
+
+    /** @brief Drop the table; the next refresh() rebuilds. */
+    void invalidate() noexcept { valid_ = false; }
+
+    /**
+     * @brief Append the table to the current checkpoint section (see checkpoint.hpp).
+     *
+     * With n_rel_tol > 0 the table in use may have been built for an earlier tick's n, so a
+     * restart that rebuilt it instead would not be bitwise identical.
+     */
+    void save_checkpoint(CheckpointWriter& out) const;
+
+    /// @brief Bytes save_checkpoint() appends.
+    [[nodiscard]] static constexpr std::size_t checkpoint_bytes() noexcept
+    {
+        return sizeof(HcwStmCache);
+    }
+
+    /**
+     * @brief Restore the table saved by save_checkpoint() (the reuse tolerance is kept).
+     *
+     * @return false (cache unchanged) if fewer than checkpoint_bytes() remain.
+     */
+    bool restore_checkpoint(CheckpointCursor& in) noexcept;
+
+  private:
+    double n_rel_tol_{0.0};
+    double n_{0.0};
+    std::uint32_t reanchor_{0};
+    std::size_t steps_{0};
+    bool valid_{false};
+    bool uniform_{false};
+    std::uint64_t rebuilds_{0};
+
+    std::array<double, MAX_STEPS> tau_{};
+    HcwStmSoa stm_{};
+};
+
+} // namespace bullseye_pred
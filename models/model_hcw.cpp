@@ -9,19 +9,10 @@
 
 #include <cmath>
 
-namespace bullseye_pred
-{
+#include "models/hcw_stm.hpp"
 
-/**
- * @brief Check if all components of a vector are finite.
- *
- * @param v Vector to check.
- * @return true if all components are finite; false otherwise.
- */
-static inline bool finite3(const Vec3& v) noexcept
+namespace bullseye_pred
 {
-    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
-}
 
 IRelativeModel::Result ModelHCW::predict_hcw(const RelStateRic& x0_ric,
                                             const HcwParams& params,
@@ -64,19 +55,8 @@ IRelativeModel::Result ModelHCW::predict_hcw(const RelStateRic& x0_ric,
     // Velocities are optional; compute only if storage is present and large enough.
     const bool want_vel = (out_v_ric.data != nullptr && out_v_ric.size >= steps);
 
-    // Unpack initial conditions in RIC axes: x=R, y=I, z=C.
-    const double x0  = x0_ric.r_ric.x;
-    const double y0  = x0_ric.r_ric.y;
-    const double z0  = x0_ric.r_ric.z;
-
-    const double xd0 = x0_ric.v_ric.x;
-    const double yd0 = x0_ric.v_ric.y;
-    const double zd0 = x0_ric.v_ric.z;
-
-    const double inv_n = 1.0 / n;
-
     /**
-     * HCW closed-form solution (one standard form):
+     * HCW closed-form solution (one standard form), RIC axes x=R, y=I, z=C:
      *
      * x(t) = (4 - 3 cos nt) x0 + (1/n) sin nt * xd0 + (2/n)(1 - cos nt) * yd0
      * y(t) = y0 + 6(sin nt - nt) x0 - (2/n)(1 - cos nt) xd0 + (1/n)(4 sin nt - 3 nt) yd0
@@ -88,6 +68,8 @@ IRelativeModel::Result ModelHCW::predict_hcw(const RelStateRic& x0_ric,
      * zd(t) = -n sin nt * z0 + cos nt * zd0
      */
 
+    HcwStmSequence stm(params, grid);
+    Vec3 v_unused{};
     for (std::size_t k = 0; k < steps; ++k)
     {
         const double t = grid.tau[k];
@@ -99,32 +81,92 @@ IRelativeModel::Result ModelHCW::predict_hcw(const RelStateRic& x0_ric,
             return res;
         }
 
-        const double nt = n * t;
-        const double s  = std::sin(nt);
-        const double c  = std::cos(nt);
+        hcw_stm_apply(stm.next(t), x0_ric, want_vel, out_r_ric[k],
+                  want_vel ? out_v_ric[k] : v_unused);
+    }
 
-        // Position
-        const double x = (4.0 - 3.0 * c) * x0
-                       + inv_n * s * xd0
-                       + (2.0 * inv_n) * (1.0 - c) * yd0;
+    res.code = ModelCode::kOk;
+    res.steps_written = steps;
+    return res;
+}
 
-        const double y = 6.0 * (s - nt) * x0
-                       + y0
-                       - (2.0 * inv_n) * (1.0 - c) * xd0
-                       + inv_n * (4.0 * s - 3.0 * nt) * yd0;
 
-        const double z = c * z0 + inv_n * s * zd0;
+IRelativeModel::Result ModelHCW::predict_hcw_batch(Span<const RelStateRic> x0_ric,
+                                                  const HcwParams& params,
+                                                  const TimeGrid& grid,
+                                                  Span2D<Vec3> out_r_ric,
+                                                  Span2D<Vec3> out_v_ric,
+                                                  Span<ModelCode> out_row_codes) const noexcept
+{
+    Result res{};
 
-        out_r_ric[k] = Vec3{x, y, z};
+    const double n = params.n_radps;
 
-        if (want_vel)
+    // Validate parameters.
+    if (!(n > 0.0) || !std::isfinite(n))
+    {
+        res.code = ModelCode::kInvalidInput;
+        return res;
+    }
+
+    // Validate the whole grid up front so a bad tau never leaves partially written rows.
+    const std::size_t steps = grid.tau.size();
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        const double t = grid.tau[k];
+        if (!(t >= 0.0) || !std::isfinite(t))
+        {
+            res.code = ModelCode::kInvalidInput;
+            return res;
+        }
+    }
+
+    const std::size_t count = x0_ric.size;
+    if (count == 0 || steps == 0)
+    {
+        res.code = ModelCode::kOk;
+        res.steps_written = 0;
+        return res;
+    }
+
+    // Validate output capacity.
+    if (out_r_ric.data == nullptr || out_r_ric.rows < count || out_r_ric.cols < steps)
+    {
+        res.code = ModelCode::kInsufficientOutputCapacity;
+        return res;
+    }
+
+    const bool want_vel =
+        (out_v_ric.data != nullptr && out_v_ric.rows >= count && out_v_ric.cols >= steps);
+    const bool want_codes = (out_row_codes.data != nullptr && out_row_codes.size >= count);
+
+    // Per-row state validation; rejected rows are skipped below and left untouched.
+    bool any_valid = false;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const bool ok = finite3(x0_ric[i].r_ric) && finite3(x0_ric[i].v_ric);
+        any_valid = any_valid || ok;
+        if (want_codes)
         {
-            // Velocity
-            const double xd = 3.0 * n * s * x0 + c * xd0 + 2.0 * s * yd0;
-            const double yd = 6.0 * n * (c - 1.0) * x0 - 2.0 * s * xd0 + (4.0 * c - 3.0) * yd0;
-            const double zd = -n * s * z0 + c * zd0;
+            out_row_codes[i] = ok ? ModelCode::kOk : ModelCode::kInvalidInput;
+        }
+    }
 
-            out_v_ric[k] = Vec3{xd, yd, zd};
+    // Time-major: one sin/cos evaluation per grid point, applied to every vehicle.
+    HcwStmSequence stm(params, grid);
+    Vec3 v_unused{};
+    for (std::size_t k = 0; any_valid && k < steps; ++k)
+    {
+        const HcwStm c = stm.next(grid.tau[k]);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const RelStateRic& x0 = x0_ric[i];
+            if (!finite3(x0.r_ric) || !finite3(x0.v_ric))
+            {
+                continue;
+            }
+            hcw_stm_apply(c, x0, want_vel, out_r_ric.row(i)[k],
+                      want_vel ? out_v_ric.row(i)[k] : v_unused);
         }
     }
 
@@ -14,6 +14,17 @@ class ModelHCW final : public IRelativeModel
                                     const TimeGrid& grid,
                                     Span<Vec3> out_r_ric,
                                     Span<Vec3> out_v_ric) const noexcept override;
+
+    /**
+     * @brief Batched HCW: sin/cos and the other state-independent coefficients are evaluated
+     *        once per grid point and applied to every row (bit-identical to predict_hcw()).
+     */
+    [[nodiscard]] Result predict_hcw_batch(Span<const RelStateRic> x0_ric,
+                                          const HcwParams& params,
+                                          const TimeGrid& grid,
+                                          Span2D<Vec3> out_r_ric,
+                                          Span2D<Vec3> out_v_ric,
+                                          Span<ModelCode> out_row_codes) const noexcept override;
 };
 
 } // namespace bullseye_pred
@@ -0,0 +1,126 @@
+// models/model_selector.cpp
+
+/**
+ * @file model_selector.cpp
+ * @brief Per-vehicle HCW / YA model selection with hysteresis and hold time.
+ */
+
+#include "models/model_selector.hpp"
+
+#include <cmath>
+#include <limits>
+
+namespace bullseye_pred
+{
+
+double chief_eccentricity(const Vec3& r_i, const Vec3& v_i, double mu) noexcept
+{
+    const double r = norm(r_i);
+    if (!(r > 0.0) || !(mu > 0.0) || !std::isfinite(r) || !std::isfinite(mu))
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // e_vec = ((v^2 - mu/r) r - (r.v) v) / mu
+    const double a = dot(v_i, v_i) - mu / r;
+    const double b = dot(r_i, v_i);
+    const Vec3 e_vec{(a * r_i.x - b * v_i.x) / mu, (a * r_i.y - b * v_i.y) / mu,
+                     (a * r_i.z - b * v_i.z) / mu};
+    return norm(e_vec);
+}
+
+ModelSelection ModelSelector::update(double t,
+                                     double chief_e,
+                                     double range_m,
+                                     double horizon_sec,
+                                     std::size_t steps) noexcept
+{
+    // Desired model from the thresholds of the current state (hysteresis).
+    PredictorModel desired = model_;
+    ModelSelectCause cause = ModelSelectCause::kUnchanged;
+
+    const bool horizon_bounded = (config_.t_hcw_max_sec > 0.0);
+    if (!std::isfinite(chief_e) || !std::isfinite(range_m) || !std::isfinite(horizon_sec))
+    {
+        desired = PredictorModel::kYaStm;
+        cause = ModelSelectCause::kInvalidInput;
+    }
+    else if (model_ != PredictorModel::kYaStm)
+    {
+        if (chief_e > config_.e_hcw_exit)
+        {
+            desired = PredictorModel::kYaStm;
+            cause = ModelSelectCause::kEccentricityExit;
+        }
+        else if (range_m > config_.rho_hcw_exit_m)
+        {
+            desired = PredictorModel::kYaStm;
+            cause = ModelSelectCause::kRangeExit;
+        }
+        else if (horizon_bounded && horizon_sec > config_.t_hcw_max_sec)
+        {
+            desired = PredictorModel::kYaStm;
+            cause = ModelSelectCause::kHorizonExit;
+        }
+    }
+    else if (chief_e <= config_.e_hcw_enter && range_m <= config_.rho_hcw_enter_m &&
+             (!horizon_bounded || horizon_sec <= config_.t_hcw_max_sec))
+    {
+        desired = config_.circular_model;
+        cause = ModelSelectCause::kHcwValid;
+    }
+
+    ModelSelection sel{};
+    if (!initialized_)
+    {
+        initialized_ = true;
+        model_ = desired;
+        t_switch_ = t;
+        sel.cause = (cause == ModelSelectCause::kInvalidInput) ? cause : ModelSelectCause::kInitial;
+    }
+    else if (desired != model_)
+    {
+        if (t - t_switch_ < config_.model_hold_sec)
+        {
+            sel.cause = ModelSelectCause::kHoldTime;
+        }
+        else
+        {
+            model_ = desired;
+            t_switch_ = t;
+            sel.switched = true;
+            sel.cause = cause;
+        }
+    }
+    else
+    {
+        sel.cause = cause;
+    }
+
+    sel.model = model_;
+    sel.est_cost = estimated_cost(model_, steps);
+    return sel;
+}
+
+void ModelSelector::reset() noexcept
+{
+    model_ = PredictorModel::kYaStm;
+    initialized_ = false;
+    t_switch_ = 0.0;
+}
+
+double ModelSelector::estimated_cost(PredictorModel model, std::size_t steps) const noexcept
+{
+    double per_step = config_.cost_ya_per_step;
+    if (model == PredictorModel::kHcw)
+    {
+        per_step = config_.cost_hcw_per_step;
+    }
+    else if (model == PredictorModel::kSsJ2)
+    {
+        per_step = config_.cost_ss_per_step;
+    }
+    return per_step * static_cast<double>(steps);
+}
+
+} // namespace bullseye_pred
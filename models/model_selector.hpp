@@ -0,0 +1,181 @@
+// models/model_selector.hpp
+#pragma once
+
+/**
+ * @file model_selector.hpp
+ * @brief Per-vehicle HCW / YA model selection with hysteresis and hold time (FR-12a..d).
+ *
+ * HCW is valid for a near-circular chief and a deputy close to it; YA/TH covers the eccentric
+ * case at a much higher per-sample cost. The selector keeps each vehicle on HCW while it stays
+ * inside the HCW validity region and moves it to YA only when it leaves. With
+ * circular_model = kSsJ2 the same region runs the Schweighart-Sedwick J2 model instead of HCW
+ * (J2 drift at HCW-like cost); "HCW" below means whichever circular model is configured.
+ *
+ * - Hysteresis: separate enter/exit thresholds for chief eccentricity and deputy range
+ *   (enter <= exit), plus an optional horizon bound T_hcw_max.
+ * - Hold time: after a switch, the choice is held for model_hold_sec before switching again.
+ * - Cause codes: every tick reports why the current model was chosen.
+ *
+ * Design constraints:
+ * - Deterministic: the choice depends only on the sequence of inputs presented.
+ * - No heap allocations; no logging.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "core/types.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Relative dynamics model run by RelativePredictor for a vehicle.
+ */
+enum class PredictorModel : std::uint8_t
+{
+    kHcw = 0,
+    kYaStm = 1,
+
+    /** @brief Per-vehicle choice by ModelSelector (RelativePredictorConfig only). */
+    kAuto = 2,
+
+    /** @brief Schweighart-Sedwick J2-linearized closed form (near-circular LEO). */
+    kSsJ2 = 3,
+};
+
+/**
+ * @brief Reason for a vehicle's model on a given tick.
+ */
+enum class ModelSelectCause : std::uint8_t
+{
+    /** @brief Model fixed by configuration (no selector). */
+    kFixed = 0,
+
+    /** @brief First evaluation for this vehicle. */
+    kInitial,
+
+    /** @brief No threshold crossed; model unchanged. */
+    kUnchanged,
+
+    /** @brief Inside the HCW enter region; switched to the circular model. */
+    kHcwValid,
+
+    /** @brief Chief eccentricity above e_hcw_exit; switched to YA. */
+    kEccentricityExit,
+
+    /** @brief Deputy range above rho_hcw_exit_m; switched to YA. */
+    kRangeExit,
+
+    /** @brief Horizon above t_hcw_max_sec; switched to YA. */
+    kHorizonExit,
+
+    /** @brief A switch was requested but suppressed by the hold time. */
+    kHoldTime,
+
+    /** @brief Non-finite inputs; YA kept/selected as the conservative choice. */
+    kInvalidInput,
+};
+
+/**
+ * @brief Selector thresholds, hold time, and cost model.
+ */
+struct ModelSelectorConfig final
+{
+    /** @brief Switch to HCW when chief e <= e_hcw_enter (and the other bounds allow). */
+    double e_hcw_enter{1.0e-3};
+
+    /** @brief Leave HCW when chief e > e_hcw_exit. Must be >= e_hcw_enter. */
+    double e_hcw_exit{2.0e-3};
+
+    /** @brief Switch to HCW when deputy range <= rho_hcw_enter_m [m]. */
+    double rho_hcw_enter_m{20.0e3};
+
+    /** @brief Leave HCW when deputy range > rho_hcw_exit_m [m]. Must be >= rho_hcw_enter_m. */
+    double rho_hcw_exit_m{30.0e3};
+
+    /** @brief HCW only for horizons <= t_hcw_max_sec [s] (0 = no horizon bound). */
+    double t_hcw_max_sec{0.0};
+
+    /** @brief Model run inside the HCW validity region: kHcw, or kSsJ2 for J2 fidelity. */
+    PredictorModel circular_model{PredictorModel::kHcw};
+
+    /** @brief Minimum time between switches for one vehicle [s] (MODEL_HOLD_SEC). */
+    double model_hold_sec{10.0};
+
+    /** @brief Estimated cost per grid sample, HCW (relative units; 1 = one HCW sample). */
+    double cost_hcw_per_step{1.0};
+
+    /** @brief Estimated cost per grid sample, YA/TH (same units as cost_hcw_per_step). */
+    double cost_ya_per_step{50.0};
+
+    /** @brief Estimated cost per grid sample, Schweighart-Sedwick (two sin/cos pairs). */
+    double cost_ss_per_step{2.0};
+};
+
+/**
+ * @brief Model decision for one vehicle on one tick.
+ */
+struct ModelSelection final
+{
+    PredictorModel model{PredictorModel::kHcw};
+    ModelSelectCause cause{ModelSelectCause::kFixed};
+
+    /** @brief True if the model differs from the previous tick. */
+    bool switched{false};
+
+    /** @brief Estimated cost of this row (steps * cost per step). */
+    double est_cost{0.0};
+};
+
+/**
+ * @brief Osculating eccentricity of the chief orbit.
+ *
+ * @return e >= 0, or NaN if the state is degenerate (r = 0 or mu <= 0).
+ */
+[[nodiscard]] double chief_eccentricity(const Vec3& r_i, const Vec3& v_i, double mu) noexcept;
+
+/**
+ * @brief Hysteresis/hold-time state machine for one vehicle.
+ */
+class ModelSelector final
+{
+  public:
+    ModelSelector() noexcept = default;
+
+    explicit ModelSelector(const ModelSelectorConfig& config) noexcept : config_(config)
+    {
+    }
+
+    /**
+     * @brief Choose the model for this tick.
+     *
+     * @param t Tick time [s] (nondecreasing across calls).
+     * @param chief_e Chief eccentricity.
+     * @param range_m Deputy range from the chief [m].
+     * @param horizon_sec Prediction horizon [s].
+     * @param steps Grid samples this tick (for the cost estimate).
+     */
+    [[nodiscard]] ModelSelection update(double t,
+                                        double chief_e,
+                                        double range_m,
+                                        double horizon_sec,
+                                        std::size_t steps) noexcept;
+
+    /** @brief Current model (YA before the first update). */
+    [[nodiscard]] PredictorModel current() const noexcept { return model_; }
+
+    /** @brief Forget history; the next update() is an initial evaluation. */
+    void reset() noexcept;
+
+    /** @brief Estimated cost of @p model over @p steps samples. */
+    [[nodiscard]] double estimated_cost(PredictorModel model, std::size_t steps) const noexcept;
+
+  private:
+    ModelSelectorConfig config_{};
+    PredictorModel model_{PredictorModel::kYaStm};
+    bool initialized_{false};
+    double t_switch_{0.0};
+};
+
+} // namespace bullseye_pred
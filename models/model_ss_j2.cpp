@@ -0,0 +1,160 @@
+// models/model_ss_j2.cpp
+
+/**
+ * @file model_ss_j2.cpp
+ * @brief Schweighart-Sedwick closed-form solution implementation.
+ */
+
+#include "models/model_ss_j2.hpp"
+
+#include <cmath>
+
+namespace bullseye_pred
+{
+
+bool ss_j2_params_from_chief(const Vec3& chief_r_i,
+                             const Vec3& chief_v_i,
+                             double n_radps,
+                             SsJ2Params& out) noexcept
+{
+    const double r = norm(chief_r_i);
+    const Vec3 h = cross(chief_r_i, chief_v_i);
+    const double hn = norm(h);
+    if (!finite3(chief_r_i) || !finite3(chief_v_i) || !(r > 0.0) || !(hn > 0.0) ||
+        !std::isfinite(hn))
+    {
+        return false;
+    }
+    out.n_radps = n_radps;
+    out.r_ref_m = r;
+    out.inc_rad = std::acos(std::fmin(1.0, std::fmax(-1.0, h.z / hn)));
+    return true;
+}
+
+bool ss_j2_rates(const SsJ2Params& params, SsJ2Rates& out) noexcept
+{
+    const double n = params.n_radps;
+    const double r = params.r_ref_m;
+    if (!(n > 0.0) || !std::isfinite(n) || !(r > 0.0) || !std::isfinite(r) ||
+        !std::isfinite(params.inc_rad) || !std::isfinite(params.j2) ||
+        !std::isfinite(params.r_eq_m))
+    {
+        return false;
+    }
+
+    const double j2_re2_r2 = params.j2 * (params.r_eq_m * params.r_eq_m) / (r * r);
+    const double s = 3.0 * j2_re2_r2 / 8.0 * (1.0 + 3.0 * std::cos(2.0 * params.inc_rad));
+    const double c2 = 1.0 + s;
+    if (!(c2 > 0.0) || !(c2 < 2.0))
+    {
+        return false;
+    }
+    const double ci = std::cos(params.inc_rad);
+
+    out.a = n * std::sqrt(c2);
+    out.w = n * std::sqrt(2.0 - c2);
+    out.q = out.a + 1.5 * n * j2_re2_r2 * (ci * ci);
+    out.a2_w2 = 4.0 * out.a * out.a / (out.w * out.w);
+    return out.q > 0.0;
+}
+
+IRelativeModel::Result ModelSS_J2::predict_ss(const RelStateRic& x0_ric,
+                                              const SsJ2Params& params,
+                                              const TimeGrid& grid,
+                                              Span<Vec3> out_r_ric,
+                                              Span<Vec3> out_v_ric) const noexcept
+{
+    const Span<const RelStateRic> x0{&x0_ric, 1};
+    const std::size_t steps = grid.tau.size();
+    const bool want_vel = (out_v_ric.data != nullptr && out_v_ric.size >= steps);
+    ModelCode row = ModelCode::kOk;
+    IRelativeModel::Result res =
+        predict_ss_batch(x0, params, grid, Span2D<Vec3>{out_r_ric.data, 1, out_r_ric.size, 0},
+                         want_vel ? Span2D<Vec3>{out_v_ric.data, 1, out_v_ric.size, 0}
+                                  : Span2D<Vec3>{},
+                         Span<ModelCode>{&row, 1});
+    if (res.code == ModelCode::kOk && row != ModelCode::kOk)
+    {
+        res.code = row;
+        res.steps_written = 0;
+    }
+    return res;
+}
+
+IRelativeModel::Result ModelSS_J2::predict_ss_batch(Span<const RelStateRic> x0_ric,
+                                                    const SsJ2Params& params,
+                                                    const TimeGrid& grid,
+                                                    Span2D<Vec3> out_r_ric,
+                                                    Span2D<Vec3> out_v_ric,
+                                                    Span<ModelCode> out_row_codes) const noexcept
+{
+    IRelativeModel::Result res{};
+
+    SsJ2Rates rates{};
+    if (!ss_j2_rates(params, rates))
+    {
+        res.code = ModelCode::kInvalidInput;
+        return res;
+    }
+
+    // Validate the whole grid up front so a bad tau never leaves partially written rows.
+    const std::size_t steps = grid.tau.size();
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        const double t = grid.tau[k];
+        if (!(t >= 0.0) || !std::isfinite(t))
+        {
+            res.code = ModelCode::kInvalidInput;
+            return res;
+        }
+    }
+
+    const std::size_t count = x0_ric.size;
+    if (count == 0 || steps == 0)
+    {
+        return res;
+    }
+    if (out_r_ric.data == nullptr || out_r_ric.rows < count || out_r_ric.cols < steps)
+    {
+        res.code = ModelCode::kInsufficientOutputCapacity;
+        return res;
+    }
+
+    const bool want_vel =
+        (out_v_ric.data != nullptr && out_v_ric.rows >= count && out_v_ric.cols >= steps);
+    const bool want_codes = (out_row_codes.data != nullptr && out_row_codes.size >= count);
+
+    // Per-row state validation; rejected rows are skipped below and left untouched.
+    bool any_valid = false;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const bool ok = finite3(x0_ric[i].r_ric) && finite3(x0_ric[i].v_ric);
+        any_valid = any_valid || ok;
+        if (want_codes)
+        {
+            out_row_codes[i] = ok ? ModelCode::kOk : ModelCode::kInvalidInput;
+        }
+    }
+
+    // Time-major: two sin/cos pairs per grid point, applied to every vehicle.
+    Vec3 v_unused{};
+    for (std::size_t k = 0; any_valid && k < steps; ++k)
+    {
+        const SsJ2Stm stm = ss_j2_stm_at(rates, grid.tau[k]);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const RelStateRic& x0 = x0_ric[i];
+            if (!finite3(x0.r_ric) || !finite3(x0.v_ric))
+            {
+                continue;
+            }
+            ss_j2_stm_apply(stm, x0, want_vel, out_r_ric.row(i)[k],
+                            want_vel ? out_v_ric.row(i)[k] : v_unused);
+        }
+    }
+
+    res.steps_written = steps;
+    return res;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,214 @@
+// models/model_ss_j2.hpp
+#pragma once
+
+/**
+ * @file model_ss_j2.hpp
+ * @brief Closed-form J2-linearized relative motion (Schweighart-Sedwick).
+ *
+ * HCW and YA/TH ignore J2, so LEO formations drift away from them within a few orbits. The
+ * Schweighart-Sedwick (SS) equations linearize the orbit-averaged J2 perturbation about a
+ * circular reference orbit of radius r_ref and inclination i_ref:
+ *
+ *   s = 3 J2 Re^2 / (8 r_ref^2) * (1 + 3 cos 2 i_ref),   c = sqrt(1 + s)
+ *
+ *   xdd = 2 (n c) yd + (5 c^2 - 2) n^2 x
+ *   ydd = -2 (n c) xd
+ *   zdd = -q^2 z,    q = n c + 3 n J2 Re^2 / (2 r_ref^2) cos^2 i_ref
+ *
+ * (RIC axes x=R, y=I, z=C). The in-plane pair is an oscillator at w = n sqrt(2 - c^2) with a
+ * constant forcing and the cross-track axis an oscillator at q, so the trajectory has a closed
+ * form with two sin/cos pairs per grid time: HCW-like cost with the secular J2 drift. With
+ * J2 = 0 it reduces to HCW (c = 1, w = q = n).
+ *
+ * The cross-track equation is the homogeneous SS form, i.e. it assumes the deputy shares the
+ * chief's nodal precession (small relative inclination); the differential-precession forcing
+ * term is not modelled.
+ *
+ * Design constraints:
+ * - No logging.
+ * - No heap allocations.
+ * - Deterministic iteration order; single, batched and repeated calls are bitwise identical.
+ */
+
+#include <cmath>
+#include <cstddef>
+
+#include "core/time_grid.hpp"
+#include "core/types.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Parameter block for the Schweighart-Sedwick model.
+ */
+struct SsJ2Params final
+{
+    /** @brief Reference mean motion n [rad/s]. Must be finite and > 0. */
+    double n_radps{0.0};
+
+    /** @brief Reference orbit radius [m]. Must be finite and > 0. */
+    double r_ref_m{0.0};
+
+    /** @brief Reference orbit inclination to the central body's equator [rad]. */
+    double inc_rad{0.0};
+
+    /** @brief Central-body J2 (dimensionless). 0 reduces the model to HCW. */
+    double j2{0.0};
+
+    /** @brief Central-body equatorial radius [m]. */
+    double r_eq_m{0.0};
+};
+
+/**
+ * @brief Reference orbit from a chief inertial state (equatorial inertial frame).
+ *
+ * @param out Filled with n_radps, r_ref_m = |r| and inc_rad = acos(h_z / |h|); j2 and r_eq_m
+ *            are left as provided.
+ * @return false (out unchanged) if the state is non-finite or has no angular momentum.
+ */
+[[nodiscard]] bool ss_j2_params_from_chief(const Vec3& chief_r_i,
+                                           const Vec3& chief_v_i,
+                                           double n_radps,
+                                           SsJ2Params& out) noexcept;
+
+/**
+ * @brief Grid-independent SS frequencies derived from SsJ2Params.
+ */
+struct SsJ2Rates final
+{
+    double a{0.0};     // n c: Coriolis coupling [rad/s]
+    double w{0.0};     // n sqrt(2 - c^2): in-plane frequency [rad/s]
+    double q{0.0};     // cross-track frequency [rad/s]
+    double a2_w2{0.0}; // 4 a^2 / w^2
+};
+
+/**
+ * @brief Compute the SS rates.
+ *
+ * @return false if the parameters are invalid (non-finite, n or r_ref <= 0, or c^2 >= 2).
+ */
+[[nodiscard]] bool ss_j2_rates(const SsJ2Params& params, SsJ2Rates& out) noexcept;
+
+/**
+ * @brief SS state-transition matrix at one grid time, stored by its nonzero entries.
+ *
+ *   x  = pos_xx x0 + pos_xxd xd0 + pos_xyd yd0
+ *   y  = y0 + pos_yx x0 + pos_yxd xd0 + pos_yyd yd0
+ *   z  = cq z0 + sq_q zd0
+ *   xd = vel_xx x0 + cw xd0 + vel_xyd yd0
+ *   yd = vel_yx x0 + vel_yxd xd0 + vel_yyd yd0
+ *   zd = vel_zz z0 + cq zd0
+ */
+struct SsJ2Stm final
+{
+    double pos_xx, pos_xxd, pos_xyd;
+    double pos_yx, pos_yxd, pos_yyd;
+    double cq, sq_q;
+    double vel_xx, cw, vel_xyd;
+    double vel_yx, vel_yxd, vel_yyd;
+    double vel_zz;
+};
+
+/**
+ * @brief Evaluate the SS STM at grid offset @p t (libm trig).
+ */
+[[nodiscard]] inline SsJ2Stm ss_j2_stm_at(const SsJ2Rates& rates, double t) noexcept
+{
+    /**
+     * In-plane: with yd = yd0 - 2a (x - x0), x obeys xdd + w^2 x = F, F = 2a yd0 + 4a^2 x0:
+     *
+     *   x(t) = x0 C + (xd0/w) S + (F/w^2)(1 - C),   C = cos wt, S = sin wt
+     *   y(t) = y0 + (yd0 + 2a x0) t - 2a * integral_0^t x
+     *
+     * Cross-track: z(t) = z0 cos qt + (zd0/q) sin qt.
+     */
+    const double a = rates.a;
+    const double w = rates.w;
+    const double g = rates.a2_w2; // 4a^2 / w^2
+    const double wt = w * t;
+    const double S = std::sin(wt);
+    const double C = std::cos(wt);
+    const double qt = rates.q * t;
+    const double Sq = std::sin(qt);
+    const double Cq = std::cos(qt);
+
+    const double inv_w = 1.0 / w;
+    const double S_w = S * inv_w;                        // sin(wt) / w
+    const double one_C_w2 = (1.0 - C) * (inv_w * inv_w); // (1 - cos wt) / w^2
+    const double t_S_w = t - S_w;                        // t - sin(wt) / w
+    const double two_a = 2.0 * a;
+
+    SsJ2Stm k{};
+    k.pos_xx = C + g * (1.0 - C);
+    k.pos_xxd = S_w;
+    k.pos_xyd = two_a * one_C_w2;
+    k.pos_yx = two_a * t - two_a * (g * t_S_w + S_w);
+    k.pos_yxd = -two_a * one_C_w2;
+    k.pos_yyd = t - g * t_S_w;
+    k.cq = Cq;
+    k.sq_q = Sq / rates.q;
+    k.vel_xx = (g - 1.0) * w * S;
+    k.cw = C;
+    k.vel_xyd = two_a * S_w;
+    k.vel_yx = -two_a * (k.pos_xx - 1.0);
+    k.vel_yxd = -two_a * S_w;
+    k.vel_yyd = 1.0 - two_a * k.pos_xyd;
+    k.vel_zz = -rates.q * Sq;
+    return k;
+}
+
+/**
+ * @brief Apply the SS STM to one initial state.
+ */
+inline void ss_j2_stm_apply(const SsJ2Stm& k,
+                            const RelStateRic& x0,
+                            bool want_vel,
+                            Vec3& out_r,
+                            Vec3& out_v) noexcept
+{
+    const Vec3& r = x0.r_ric;
+    const Vec3& v = x0.v_ric;
+    out_r = Vec3{k.pos_xx * r.x + k.pos_xxd * v.x + k.pos_xyd * v.y,
+                 r.y + k.pos_yx * r.x + k.pos_yxd * v.x + k.pos_yyd * v.y,
+                 k.cq * r.z + k.sq_q * v.z};
+    if (want_vel)
+    {
+        out_v = Vec3{k.vel_xx * r.x + k.cw * v.x + k.vel_xyd * v.y,
+                     k.vel_yx * r.x + k.vel_yxd * v.x + k.vel_yyd * v.y,
+                     k.vel_zz * r.z + k.cq * v.z};
+    }
+}
+
+class ModelSS_J2 final
+{
+  public:
+    /**
+     * @brief Predict one relative trajectory under the SS J2-linearized dynamics.
+     *
+     * Semantics follow IRelativeModel::predict_hcw(): out_r_ric is required and must hold
+     * grid.tau.size() elements, out_v_ric is optional, and grid offsets must be finite and
+     * >= 0.
+     */
+    [[nodiscard]] IRelativeModel::Result predict_ss(const RelStateRic& x0_ric,
+                                                    const SsJ2Params& params,
+                                                    const TimeGrid& grid,
+                                                    Span<Vec3> out_r_ric,
+                                                    Span<Vec3> out_v_ric) const noexcept;
+
+    /**
+     * @brief Batched SS: the STM is evaluated once per grid point and applied to every row
+     *        (bit-identical to predict_ss()). Row semantics follow
+     *        IRelativeModel::predict_hcw_batch().
+     */
+    [[nodiscard]] IRelativeModel::Result predict_ss_batch(Span<const RelStateRic> x0_ric,
+                                                          const SsJ2Params& params,
+                                                          const TimeGrid& grid,
+                                                          Span2D<Vec3> out_r_ric,
+                                                          Span2D<Vec3> out_v_ric,
+                                                          Span<ModelCode> out_row_codes) const
+        noexcept;
+};
+
+} // namespace bullseye_pred
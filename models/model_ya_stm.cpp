@@ -6,26 +6,23 @@
  */
 
 #include "models/model_ya_stm.hpp"
-#include "core/math/stumpff.hpp"
+#include "core/contracts.hpp"
+#include "core/math/kepler.hpp"
+#include "core/math/universal_kepler.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 
 namespace bullseye_pred
 {
-using math::stumpff_C;
-using math::stumpff_S;
 namespace
 {
 // ------------------------------
 // Helpers (deterministic, no heap)
 // ------------------------------
 
-static inline bool finite3(const Vec3& v) noexcept
-{
-    return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z);
-}
-
 
 struct ChiefPv final
 {
@@ -33,8 +30,8 @@ struct ChiefPv final
     Vec3 v_i{};
 };
 
-// Deterministic universal-variable propagation from (r0,v0) at t0 to t0+dt.
-// Fixed iteration count keeps control flow deterministic.
+// Deterministic universal-variable propagation from (r0,v0) at t0 to t0+dt (shared solver;
+// tolerance-terminated, capped at Det::kKeplerIters).
 inline bool propagate_two_body_universal(const Vec3& r0_i,
                                         const Vec3& v0_i,
                                         double mu,
@@ -52,77 +49,17 @@ inline bool propagate_two_body_universal(const Vec3& r0_i,
         return false;
     }
 
-    const double sqrt_mu = std::sqrt(mu);
-    const double v0n2 = dot(v0_i, v0_i);
-    const double alpha = 2.0 / r0n - v0n2 / mu; // reciprocal semi-major axis
-
-    // Deterministic initial guess.
-    double x = 0.0;
-    const double abs_alpha = std::fabs(alpha);
-    if (abs_alpha > 1e-8)
-    {
-        x = sqrt_mu * abs_alpha * dt;
-    }
-    else
-    {
-        x = sqrt_mu * dt / r0n;
-    }
-
-    const double r0dotv0 = dot(r0_i, v0_i);
-    const double r0dotv0_over_sqrtmu = r0dotv0 / sqrt_mu;
-
-    constexpr int kKeplerIters = 8;
-    for (int iter = 0; iter < kKeplerIters; ++iter)
-    {
-        const double x2 = x * x;
-        const double z = alpha * x2;
-        const double C = stumpff_C(z);
-        const double S = stumpff_S(z);
-
-        const double x3 = x2 * x;
-        const double one_minus_alpha_r0 = 1.0 - alpha * r0n;
-
-        const double F =
-            r0dotv0_over_sqrtmu * x2 * C + one_minus_alpha_r0 * x3 * S + r0n * x - sqrt_mu * dt;
-
-        const double dF =
-            r0dotv0_over_sqrtmu * x * (1.0 - z * S) + one_minus_alpha_r0 * x2 * C + r0n;
-
-        if (!(dF != 0.0) || !std::isfinite(dF) || !std::isfinite(F))
-        {
-            continue;
-        }
-
-        x = x - F / dF;
-    }
-
-    const double x2 = x * x;
-    const double z = alpha * x2;
-    const double C = stumpff_C(z);
-    const double S = stumpff_S(z);
-
-    const double f = 1.0 - (x2 / r0n) * C;
-    const double g = dt - (x2 * x / sqrt_mu) * S;
-
-    const Vec3 r = f * r0_i + g * v0_i;
-    const double rn = norm(r);
-    if (!(rn > 0.0) || !std::isfinite(rn))
-    {
-        return false;
-    }
-
-    const double fdot = (sqrt_mu / (r0n * rn)) * (z * S - 1.0) * x;
-    const double gdot = 1.0 - (x2 / rn) * C;
+    const double alpha = 2.0 / r0n - dot(v0_i, v0_i) / mu; // reciprocal semi-major axis
+    const double chi0 = math::universal_initial_guess(alpha, std::sqrt(mu), r0n, dt);
 
-    const Vec3 v = fdot * r0_i + gdot * v0_i;
-
-    if (!finite3(r) || !finite3(v))
+    math::UniversalPropagation prop{};
+    if (!math::universal_propagate(r0_i, v0_i, mu, dt, chi0, contracts::Det::kKeplerIters, prop))
     {
         return false;
     }
 
-    out.r_i = r;
-    out.v_i = v;
+    out.r_i = prop.r_i;
+    out.v_i = prop.v_i;
     return true;
 }
 
@@ -146,11 +83,8 @@ inline State6 add(const State6& a, const State6& b, double scale_b) noexcept
                   a.zd + scale_b * b.zd};
 }
 
-// LTV dynamics in chief RIC with omega aligned with +C.
-inline bool deriv_th_ltv(double t,
-                         const YaStmParams& p,
-                         const State6& s,
-                         State6& dsdt) noexcept
+// Chief TH coefficients at stage time t (offset from t0).
+inline bool chief_sample_at(double t, const YaStmParams& p, YaChiefSample& out) noexcept
 {
     ChiefPv chief{};
     if (!propagate_two_body_universal(p.chief_r0_i, p.chief_v0_i, p.mu, t, chief))
@@ -177,13 +111,26 @@ inline bool deriv_th_ltv(double t,
     const double omegadot = -2.0 * omega * rdot / r;
 
     const double inv_r3 = 1.0 / (r * r * r);
-    const double mu_over_r3 = p.mu * inv_r3;
 
+    out.tau = t;
+    out.r_norm = r;
+    out.omega = omega;
+    out.omega_dot = omegadot;
+    out.mu_over_r3 = p.mu * inv_r3;
+    return true;
+}
+
+// LTV dynamics in chief RIC with omega aligned with +C.
+inline void deriv_th_ltv(const YaChiefSample& c, const State6& s, State6& dsdt) noexcept
+{
     // Gravity gradient in RIC:
     // a_x = +2 mu/r^3 * x
     // a_y = -1 mu/r^3 * y
     // a_z = -1 mu/r^3 * z
 
+    const double omega = c.omega;
+    const double omegadot = c.omega_dot;
+    const double mu_over_r3 = c.mu_over_r3;
     const double omega2 = omega * omega;
 
     const double xdd = (2.0 * mu_over_r3 + omega2) * s.x + 2.0 * omega * s.yd + omegadot * s.y;
@@ -196,39 +143,27 @@ inline bool deriv_th_ltv(double t,
     dsdt.xd = xdd;
     dsdt.yd = ydd;
     dsdt.zd = zdd;
-
-    return true;
 }
 
-inline bool rk4_step(double t,
-                     double h,
-                     const YaStmParams& p,
+// One RK4 substep of size h. k2 and k3 share the midpoint chief sample.
+inline bool rk4_step(double h,
+                     const YaChiefSample& c_start,
+                     const YaChiefSample& c_mid,
+                     const YaChiefSample& c_end,
                      State6& s) noexcept
 {
     State6 k1{}, k2{}, k3{}, k4{};
 
-    if (!deriv_th_ltv(t, p, s, k1))
-    {
-        return false;
-    }
+    deriv_th_ltv(c_start, s, k1);
 
     State6 s2 = add(s, k1, 0.5 * h);
-    if (!deriv_th_ltv(t + 0.5 * h, p, s2, k2))
-    {
-        return false;
-    }
+    deriv_th_ltv(c_mid, s2, k2);
 
     State6 s3 = add(s, k2, 0.5 * h);
-    if (!deriv_th_ltv(t + 0.5 * h, p, s3, k3))
-    {
-        return false;
-    }
+    deriv_th_ltv(c_mid, s3, k3);
 
     State6 s4 = add(s, k3, h);
-    if (!deriv_th_ltv(t + h, p, s4, k4))
-    {
-        return false;
-    }
+    deriv_th_ltv(c_end, s4, k4);
 
     s.x += (h / 6.0) * (k1.x + 2.0 * k2.x + 2.0 * k3.x + k4.x);
     s.y += (h / 6.0) * (k1.y + 2.0 * k2.y + 2.0 * k3.y + k4.y);
@@ -242,56 +177,105 @@ inline bool rk4_step(double t,
            std::isfinite(s.yd) && std::isfinite(s.zd);
 }
 
-} // namespace
-
-ModelYA_STM::Result ModelYA_STM::predict_ya_stm(const RelStateRic& x0_ric,
-                                               const YaStmParams& params,
-                                               const TimeGrid& grid,
-                                               Span<Vec3> out_r_ric,
-                                               Span<Vec3> out_v_ric) const noexcept
+/**
+ * Deterministic RK4 stage schedule over the grid.
+ *
+ * For each grid interval with dt > 0: begin(t_prev), then step(t, h) for each of the
+ * N = ceil(dt / max_h) substeps. node(k) is called after grid sample k is reached.
+ * The chief ephemeris table and every consumer of it walk this same schedule, which is what
+ * makes table-driven propagation bitwise identical to on-the-fly chief propagation.
+ */
+template <typename Begin, typename Step, typename Node>
+inline ModelCode walk_rk4_schedule(const TimeGrid& grid, double max_h, Begin&& begin, Step&& step,
+                                   Node&& node) noexcept
 {
-    Result res{};
+    double t_prev = 0.0;
+    const std::size_t steps = grid.tau.size();
 
-    // Validate parameters.
-    if (!(params.mu > 0.0) || !std::isfinite(params.mu))
-    {
-        res.code = ModelCode::kInvalidInput;
-        return res;
-    }
-    if (!(params.max_dt_sec > 0.0) || !std::isfinite(params.max_dt_sec))
-    {
-        res.code = ModelCode::kInvalidInput;
-        return res;
-    }
-    if (!finite3(params.chief_r0_i) || !finite3(params.chief_v0_i))
+    for (std::size_t k = 0; k < steps; ++k)
     {
-        res.code = ModelCode::kInvalidInput;
-        return res;
-    }
+        const double t_target = grid.tau[k];
+        if (!(t_target >= 0.0) || !std::isfinite(t_target))
+        {
+            return ModelCode::kInvalidInput;
+        }
+        if (t_target < t_prev)
+        {
+            // Not supported: grid must be nondecreasing.
+            return ModelCode::kInvalidInput;
+        }
 
-    // Validate state.
-    if (!finite3(x0_ric.r_ric) || !finite3(x0_ric.v_ric))
-    {
-        res.code = ModelCode::kInvalidInput;
-        return res;
+        const double dt = t_target - t_prev;
+        if (dt > 0.0)
+        {
+            // Deterministic subdivision count: N = ceil(dt/max_h).
+            const std::uint64_t n_steps = static_cast<std::uint64_t>(std::ceil(dt / max_h));
+            const double h = dt / static_cast<double>(n_steps);
+
+            if (!begin(t_prev))
+            {
+                return ModelCode::kInvalidInput;
+            }
+            double t = t_prev;
+            for (std::uint64_t i = 0; i < n_steps; ++i)
+            {
+                if (!step(t, h))
+                {
+                    return ModelCode::kInvalidInput;
+                }
+                t += h;
+            }
+        }
+
+        node(k);
+        t_prev = t_target;
     }
 
-    const std::size_t steps = grid.tau.size();
-    if (steps == 0)
+    return ModelCode::kOk;
+}
+
+// Chief source that propagates the two-body chief at each stage time.
+struct DirectChiefSource final
+{
+    const YaStmParams& params;
+
+    bool at(double t, YaChiefSample& out) noexcept
     {
-        res.code = ModelCode::kOk;
-        res.steps_written = 0;
-        return res;
+        return chief_sample_at(t, params, out);
     }
+};
 
-    if (out_r_ric.data == nullptr || out_r_ric.size < steps)
+// Chief source that reads a prebuilt per-tick ephemeris in schedule order.
+struct TableChiefSource final
+{
+    const YaChiefEphemeris& eph;
+    std::size_t next{0};
+
+    bool at(double t, YaChiefSample& out) noexcept
     {
-        res.code = ModelCode::kInsufficientOutputCapacity;
-        return res;
+        // Stage times must match bitwise; anything else means the table was built for a
+        // different grid or step policy.
+        if (next >= eph.samples.size || !(eph.samples[next].tau == t))
+        {
+            return false;
+        }
+        out = eph.samples[next];
+        ++next;
+        return true;
     }
+};
 
-    const bool want_vel = (out_v_ric.data != nullptr && out_v_ric.size >= steps);
-
+template <typename ChiefSource>
+inline ModelCode predict_rk4(const RelStateRic& x0_ric,
+                             const YaStmParams& params,
+                             const TimeGrid& grid,
+                             ChiefSource& chief,
+                             Span<Vec3> out_r_ric,
+                             Span<Vec3> out_v_ric,
+                             bool want_vel,
+                             std::size_t& steps_written,
+                             std::size_t& substeps) noexcept
+{
     // Initial state in RIC.
     State6 s{};
     s.x  = x0_ric.r_ric.x;
@@ -301,42 +285,266 @@ ModelYA_STM::Result ModelYA_STM::predict_ya_stm(const RelStateRic& x0_ric,
     s.yd = x0_ric.v_ric.y;
     s.zd = x0_ric.v_ric.z;
 
-    // Integrate sequentially across tau.
-    double t_prev = 0.0;
+    // The end-of-substep chief sample is reused as the next substep's start sample
+    // (identical stage time within an interval).
+    YaChiefSample c_start{};
+    YaChiefSample c_mid{};
+    YaChiefSample c_end{};
+
+    return walk_rk4_schedule(
+        grid, params.max_dt_sec,
+        [&](double t) { return chief.at(t, c_start); },
+        [&](double t, double h)
+        {
+            if (!chief.at(t + 0.5 * h, c_mid) || !chief.at(t + h, c_end))
+            {
+                return false;
+            }
+            if (!rk4_step(h, c_start, c_mid, c_end, s))
+            {
+                return false;
+            }
+            c_start = c_end;
+            ++substeps;
+            return true;
+        },
+        [&](std::size_t k)
+        {
+            out_r_ric[k] = Vec3{s.x, s.y, s.z};
+            if (want_vel)
+            {
+                out_v_ric[k] = Vec3{s.xd, s.yd, s.zd};
+            }
+            steps_written = k + 1;
+        });
+}
+
+// ------------------------------
+// Adaptive Dormand-Prince 5(4)
+// ------------------------------
+//
+// Embedded RK 5(4) pair (FSAL: the last stage of an accepted step is the first stage of the
+// next). Local error is controlled per component against abs_tol + rel_tol * |y|; the step
+// size controller is the fixed h_new = h * clamp(0.9 * err^(-1/5), 0.2, 5). The chief is
+// propagated at each stage time (stage times depend on the deputy's step sizes, so a shared
+// per-tick table does not apply).
+
+inline void axpy(State6& acc, double a, const State6& k) noexcept
+{
+    acc.x += a * k.x;
+    acc.y += a * k.y;
+    acc.z += a * k.z;
+    acc.xd += a * k.xd;
+    acc.yd += a * k.yd;
+    acc.zd += a * k.zd;
+}
+
+inline bool finite6(const State6& s) noexcept
+{
+    return std::isfinite(s.x) && std::isfinite(s.y) && std::isfinite(s.z) &&
+           std::isfinite(s.xd) && std::isfinite(s.yd) && std::isfinite(s.zd);
+}
+
+// Component error ratio |e| / (abs_tol + rel_tol * max(|y0|, |y1|)).
+inline double err_ratio(double e, double y0, double y1, double abs_tol, double rel_tol) noexcept
+{
+    return std::fabs(e) / (abs_tol + rel_tol * std::max(std::fabs(y0), std::fabs(y1)));
+}
+
+struct DopriStep final
+{
+    State6 y{};      // 5th-order solution at t + h
+    State6 k7{};     // derivative at (t + h, y) (next step's k1 if accepted)
+    YaChiefSample c_end{};
+    double err{0.0}; // max-norm scaled error estimate (accept if <= 1)
+};
+
+// One Dormand-Prince attempt from (t, s) with k1 = f(t, s). Returns false on chief failure or
+// non-finite results.
+inline bool dopri_attempt(double t,
+                          double h,
+                          const State6& s,
+                          const State6& k1,
+                          const YaStmParams& params,
+                          DopriStep& out) noexcept
+{
+    constexpr double a21 = 1.0 / 5.0;
+    constexpr double a31 = 3.0 / 40.0, a32 = 9.0 / 40.0;
+    constexpr double a41 = 44.0 / 45.0, a42 = -56.0 / 15.0, a43 = 32.0 / 9.0;
+    constexpr double a51 = 19372.0 / 6561.0, a52 = -25360.0 / 2187.0, a53 = 64448.0 / 6561.0,
+                     a54 = -212.0 / 729.0;
+    constexpr double a61 = 9017.0 / 3168.0, a62 = -355.0 / 33.0, a63 = 46732.0 / 5247.0,
+                     a64 = 49.0 / 176.0, a65 = -5103.0 / 18656.0;
+    constexpr double b1 = 35.0 / 384.0, b3 = 500.0 / 1113.0, b4 = 125.0 / 192.0,
+                     b5 = -2187.0 / 6784.0, b6 = 11.0 / 84.0;
+    // e = b(5th) - b(4th)
+    constexpr double e1 = 71.0 / 57600.0, e3 = -71.0 / 16695.0, e4 = 71.0 / 1920.0,
+                     e5 = -17253.0 / 339200.0, e6 = 22.0 / 525.0, e7 = -1.0 / 40.0;
+
+    YaChiefSample c{};
+    State6 k2{}, k3{}, k4{}, k5{}, k6{};
+
+    State6 y = s;
+    axpy(y, h * a21, k1);
+    if (!chief_sample_at(t + h / 5.0, params, c))
+    {
+        return false;
+    }
+    deriv_th_ltv(c, y, k2);
+
+    y = s;
+    axpy(y, h * a31, k1);
+    axpy(y, h * a32, k2);
+    if (!chief_sample_at(t + 3.0 * h / 10.0, params, c))
+    {
+        return false;
+    }
+    deriv_th_ltv(c, y, k3);
+
+    y = s;
+    axpy(y, h * a41, k1);
+    axpy(y, h * a42, k2);
+    axpy(y, h * a43, k3);
+    if (!chief_sample_at(t + 4.0 * h / 5.0, params, c))
+    {
+        return false;
+    }
+    deriv_th_ltv(c, y, k4);
+
+    y = s;
+    axpy(y, h * a51, k1);
+    axpy(y, h * a52, k2);
+    axpy(y, h * a53, k3);
+    axpy(y, h * a54, k4);
+    if (!chief_sample_at(t + 8.0 * h / 9.0, params, c))
+    {
+        return false;
+    }
+    deriv_th_ltv(c, y, k5);
+
+    y = s;
+    axpy(y, h * a61, k1);
+    axpy(y, h * a62, k2);
+    axpy(y, h * a63, k3);
+    axpy(y, h * a64, k4);
+    axpy(y, h * a65, k5);
+    if (!chief_sample_at(t + h, params, out.c_end))
+    {
+        return false;
+    }
+    deriv_th_ltv(out.c_end, y, k6);
+
+    // 5th-order solution (b7 = 0), then k7 at the same stage time as k6.
+    y = s;
+    axpy(y, h * b1, k1);
+    axpy(y, h * b3, k3);
+    axpy(y, h * b4, k4);
+    axpy(y, h * b5, k5);
+    axpy(y, h * b6, k6);
+    deriv_th_ltv(out.c_end, y, out.k7);
+    out.y = y;
+
+    State6 e{};
+    axpy(e, h * e1, k1);
+    axpy(e, h * e3, k3);
+    axpy(e, h * e4, k4);
+    axpy(e, h * e5, k5);
+    axpy(e, h * e6, k6);
+    axpy(e, h * e7, out.k7);
+
+    const double at = params.abs_tol;
+    const double rt = params.rel_tol;
+    double err = err_ratio(e.x, s.x, y.x, at, rt);
+    err = std::max(err, err_ratio(e.y, s.y, y.y, at, rt));
+    err = std::max(err, err_ratio(e.z, s.z, y.z, at, rt));
+    err = std::max(err, err_ratio(e.xd, s.xd, y.xd, at, rt));
+    err = std::max(err, err_ratio(e.yd, s.yd, y.yd, at, rt));
+    err = std::max(err, err_ratio(e.zd, s.zd, y.zd, at, rt));
+    out.err = err;
+
+    return finite6(y) && finite6(out.k7) && std::isfinite(err);
+}
+
+// Fixed step-size controller.
+inline double dopri_step_factor(double err) noexcept
+{
+    constexpr double kSafety = 0.9;
+    constexpr double kMinFactor = 0.2;
+    constexpr double kMaxFactor = 5.0;
+    if (!(err > 0.0))
+    {
+        return kMaxFactor;
+    }
+    return std::clamp(kSafety * std::pow(err, -0.2), kMinFactor, kMaxFactor);
+}
+
+inline ModelCode predict_dopri(const RelStateRic& x0_ric,
+                               const YaStmParams& params,
+                               const TimeGrid& grid,
+                               Span<Vec3> out_r_ric,
+                               Span<Vec3> out_v_ric,
+                               bool want_vel,
+                               ModelYA_STM::Result& res) noexcept
+{
+    State6 s{x0_ric.r_ric.x, x0_ric.r_ric.y, x0_ric.r_ric.z,
+             x0_ric.v_ric.x, x0_ric.v_ric.y, x0_ric.v_ric.z};
+
+    YaChiefSample c0{};
+    if (!chief_sample_at(0.0, params, c0))
+    {
+        return ModelCode::kInvalidInput;
+    }
+    State6 k1{};
+    deriv_th_ltv(c0, s, k1);
+    res.derivative_evals = 1;
+
+    double t = 0.0;
+    double h = params.max_dt_sec;
+    std::uint32_t attempts = 0;
+    const std::size_t steps = grid.tau.size();
 
     for (std::size_t k = 0; k < steps; ++k)
     {
         const double t_target = grid.tau[k];
-        if (!(t_target >= 0.0) || !std::isfinite(t_target))
+        if (!(t_target >= 0.0) || !std::isfinite(t_target) || t_target < t)
         {
-            res.code = ModelCode::kInvalidInput;
-            return res;
-        }
-        if (t_target < t_prev)
-        {
-            // Not supported: grid must be nondecreasing.
-            res.code = ModelCode::kInvalidInput;
-            return res;
+            return ModelCode::kInvalidInput;
         }
 
-        double dt = t_target - t_prev;
-        if (dt > 0.0)
+        while (t < t_target)
         {
-            const double max_h = params.max_dt_sec;
+            if (attempts >= params.max_step_attempts)
+            {
+                return ModelCode::kInvalidInput; // work cap reached
+            }
+            ++attempts;
 
-            // Deterministic subdivision count: N = ceil(dt/max_h).
-            const std::uint64_t n_steps = static_cast<std::uint64_t>(std::ceil(dt / max_h));
-            const double h = dt / static_cast<double>(n_steps);
+            // Land exactly on the grid time on the last step of the interval.
+            const bool last = !(t + h < t_target);
+            const double h_try = last ? (t_target - t) : h;
 
-            double t = t_prev;
-            for (std::uint64_t i = 0; i < n_steps; ++i)
+            DopriStep st{};
+            if (!dopri_attempt(t, h_try, s, k1, params, st))
             {
-                if (!rk4_step(t, h, params, s))
-                {
-                    res.code = ModelCode::kInvalidInput;
-                    return res;
-                }
-                t += h;
+                return ModelCode::kInvalidInput;
+            }
+            res.derivative_evals += 6;
+
+            const double factor = dopri_step_factor(st.err);
+            if (st.err <= 1.0)
+            {
+                t = last ? t_target : (t + h_try);
+                s = st.y;
+                k1 = st.k7;
+                ++res.integrator_steps;
+                // A step shortened to hit the grid says little about the next one; keep the
+                // larger of the previous proposal and the new one.
+                h = last ? std::max(h, h_try * factor) : (h_try * factor);
+            }
+            else
+            {
+                ++res.rejected_steps;
+                h = h_try * factor;
             }
         }
 
@@ -345,12 +553,777 @@ ModelYA_STM::Result ModelYA_STM::predict_ya_stm(const RelStateRic& x0_ric,
         {
             out_v_ric[k] = Vec3{s.xd, s.yd, s.zd};
         }
-
-        t_prev = t_target;
         res.steps_written = k + 1;
     }
 
-    res.code = ModelCode::kOk;
+    return ModelCode::kOk;
+}
+
+// ------------------------------
+// Lockstep batch RK4 (SoA over deputies)
+// ------------------------------
+//
+// The TH dynamics depend only on the chief; deputies enter linearly. A block of deputies is
+// advanced through the same stage schedule with one chief sample per stage. Per-lane arithmetic
+// matches deriv_th_ltv / add / rk4_step exactly, so every lane is bitwise identical to the
+// single-deputy path.
+
+struct State6Block final
+{
+    std::array<double, ModelYA_STM::kBatchLanes> x{};
+    std::array<double, ModelYA_STM::kBatchLanes> y{};
+    std::array<double, ModelYA_STM::kBatchLanes> z{};
+    std::array<double, ModelYA_STM::kBatchLanes> xd{};
+    std::array<double, ModelYA_STM::kBatchLanes> yd{};
+    std::array<double, ModelYA_STM::kBatchLanes> zd{};
+};
+
+inline void deriv_th_ltv_block(const YaChiefSample& c,
+                               const State6Block& s,
+                               std::size_t lanes,
+                               State6Block& dsdt) noexcept
+{
+    const double omega = c.omega;
+    const double omegadot = c.omega_dot;
+    const double mu_over_r3 = c.mu_over_r3;
+    const double omega2 = omega * omega;
+
+    for (std::size_t j = 0; j < lanes; ++j)
+    {
+        const double xdd =
+            (2.0 * mu_over_r3 + omega2) * s.x[j] + 2.0 * omega * s.yd[j] + omegadot * s.y[j];
+        const double ydd =
+            (omega2 - mu_over_r3) * s.y[j] - 2.0 * omega * s.xd[j] - omegadot * s.x[j];
+        const double zdd = (-mu_over_r3) * s.z[j];
+
+        dsdt.x[j] = s.xd[j];
+        dsdt.y[j] = s.yd[j];
+        dsdt.z[j] = s.zd[j];
+        dsdt.xd[j] = xdd;
+        dsdt.yd[j] = ydd;
+        dsdt.zd[j] = zdd;
+    }
+}
+
+inline void add_block(const State6Block& a,
+                      const State6Block& b,
+                      double scale_b,
+                      std::size_t lanes,
+                      State6Block& out) noexcept
+{
+    for (std::size_t j = 0; j < lanes; ++j)
+    {
+        out.x[j] = a.x[j] + scale_b * b.x[j];
+        out.y[j] = a.y[j] + scale_b * b.y[j];
+        out.z[j] = a.z[j] + scale_b * b.z[j];
+        out.xd[j] = a.xd[j] + scale_b * b.xd[j];
+        out.yd[j] = a.yd[j] + scale_b * b.yd[j];
+        out.zd[j] = a.zd[j] + scale_b * b.zd[j];
+    }
+}
+
+// Scratch for one block substep (kept out of the hot loop's stack frame churn).
+struct Rk4BlockScratch final
+{
+    State6Block k1{};
+    State6Block k2{};
+    State6Block k3{};
+    State6Block k4{};
+    State6Block tmp{};
+};
+
+inline void rk4_step_block(double h,
+                           const YaChiefSample& c_start,
+                           const YaChiefSample& c_mid,
+                           const YaChiefSample& c_end,
+                           std::size_t lanes,
+                           Rk4BlockScratch& w,
+                           State6Block& s,
+                           bool* lane_ok) noexcept
+{
+    deriv_th_ltv_block(c_start, s, lanes, w.k1);
+
+    add_block(s, w.k1, 0.5 * h, lanes, w.tmp);
+    deriv_th_ltv_block(c_mid, w.tmp, lanes, w.k2);
+
+    add_block(s, w.k2, 0.5 * h, lanes, w.tmp);
+    deriv_th_ltv_block(c_mid, w.tmp, lanes, w.k3);
+
+    add_block(s, w.k3, h, lanes, w.tmp);
+    deriv_th_ltv_block(c_end, w.tmp, lanes, w.k4);
+
+    for (std::size_t j = 0; j < lanes; ++j)
+    {
+        s.x[j] += (h / 6.0) * (w.k1.x[j] + 2.0 * w.k2.x[j] + 2.0 * w.k3.x[j] + w.k4.x[j]);
+        s.y[j] += (h / 6.0) * (w.k1.y[j] + 2.0 * w.k2.y[j] + 2.0 * w.k3.y[j] + w.k4.y[j]);
+        s.z[j] += (h / 6.0) * (w.k1.z[j] + 2.0 * w.k2.z[j] + 2.0 * w.k3.z[j] + w.k4.z[j]);
+
+        s.xd[j] += (h / 6.0) * (w.k1.xd[j] + 2.0 * w.k2.xd[j] + 2.0 * w.k3.xd[j] + w.k4.xd[j]);
+        s.yd[j] += (h / 6.0) * (w.k1.yd[j] + 2.0 * w.k2.yd[j] + 2.0 * w.k3.yd[j] + w.k4.yd[j]);
+        s.zd[j] += (h / 6.0) * (w.k1.zd[j] + 2.0 * w.k2.zd[j] + 2.0 * w.k3.zd[j] + w.k4.zd[j]);
+    }
+
+    for (std::size_t j = 0; j < lanes; ++j)
+    {
+        lane_ok[j] = lane_ok[j] && std::isfinite(s.x[j]) && std::isfinite(s.y[j]) &&
+                     std::isfinite(s.z[j]) && std::isfinite(s.xd[j]) && std::isfinite(s.yd[j]) &&
+                     std::isfinite(s.zd[j]);
+    }
+}
+
+// Advance rows [row0, row0 + lanes) in lockstep. lane_ok[j] is true on entry for rows to
+// predict; rows that turn non-finite are dropped (outputs stop, like the single-deputy early
+// return). Returns kInvalidInput if the chief source fails (all rows fail).
+template <typename ChiefSource>
+inline ModelCode predict_rk4_block(Span<const RelStateRic> x0_ric,
+                                   std::size_t row0,
+                                   std::size_t lanes,
+                                   const YaStmParams& params,
+                                   const TimeGrid& grid,
+                                   ChiefSource& chief,
+                                   Span2D<Vec3> out_r_ric,
+                                   Span2D<Vec3> out_v_ric,
+                                   bool want_vel,
+                                   bool* lane_ok) noexcept
+{
+    State6Block s{};
+    for (std::size_t j = 0; j < lanes; ++j)
+    {
+        const RelStateRic& x0 = x0_ric[row0 + j];
+        // Inactive lanes are zero-filled so they stay finite and cheap.
+        s.x[j]  = lane_ok[j] ? x0.r_ric.x : 0.0;
+        s.y[j]  = lane_ok[j] ? x0.r_ric.y : 0.0;
+        s.z[j]  = lane_ok[j] ? x0.r_ric.z : 0.0;
+        s.xd[j] = lane_ok[j] ? x0.v_ric.x : 0.0;
+        s.yd[j] = lane_ok[j] ? x0.v_ric.y : 0.0;
+        s.zd[j] = lane_ok[j] ? x0.v_ric.z : 0.0;
+    }
+
+    Rk4BlockScratch w{};
+    YaChiefSample c_start{};
+    YaChiefSample c_mid{};
+    YaChiefSample c_end{};
+
+    return walk_rk4_schedule(
+        grid, params.max_dt_sec,
+        [&](double t) { return chief.at(t, c_start); },
+        [&](double t, double h)
+        {
+            if (!chief.at(t + 0.5 * h, c_mid) || !chief.at(t + h, c_end))
+            {
+                return false;
+            }
+            rk4_step_block(h, c_start, c_mid, c_end, lanes, w, s, lane_ok);
+            c_start = c_end;
+            return true;
+        },
+        [&](std::size_t k)
+        {
+            for (std::size_t j = 0; j < lanes; ++j)
+            {
+                if (!lane_ok[j])
+                {
+                    continue;
+                }
+                out_r_ric.row(row0 + j)[k] = Vec3{s.x[j], s.y[j], s.z[j]};
+                if (want_vel)
+                {
+                    out_v_ric.row(row0 + j)[k] = Vec3{s.xd[j], s.yd[j], s.zd[j]};
+                }
+            }
+        });
+}
+
+inline bool params_valid(const YaStmParams& params) noexcept
+{
+    const bool common = (params.mu > 0.0) && std::isfinite(params.mu) &&
+                        (params.max_dt_sec > 0.0) && std::isfinite(params.max_dt_sec) &&
+                        finite3(params.chief_r0_i) && finite3(params.chief_v0_i);
+    if (!common || params.backend != YaStmBackend::kDormandPrince54)
+    {
+        return common;
+    }
+    return (params.rel_tol > 0.0) && std::isfinite(params.rel_tol) && (params.abs_tol > 0.0) &&
+           std::isfinite(params.abs_tol) && (params.max_step_attempts > 0);
+}
+
+// ------------------------------
+// Closed-form Yamanaka-Ankersen STM
+// ------------------------------
+//
+// TH equations with true anomaly f as the independent variable and the transformed state
+// x~ = rho * x (rho = 1 + e cos f), ' = d/df:
+//
+//   x~'' = 3 x~ / rho + 2 y~'
+//   y~'' = -2 x~'
+//   z~'' = -z~
+//
+// In-plane fundamental solutions (columns), rows [x~, y~, x~', y~'], with
+// s = rho sin f, c = rho cos f and J = integral(df / rho^2) = (h / p^2) * tau:
+//
+//   A: [ s,          c (1 + 1/rho),  s',                 -2 s         ]
+//   B: [ c,         -s (1 + 1/rho),  c',                 -2 c + e     ]
+//   D: [ 2 - 3esJ,  -3 rho^2 J,      -3e (s' J + s/rho^2), -3 + 6esJ ]
+//   E: [ 0,          1,              0,                   0           ]
+//
+// Out-of-plane: z~ = z~0 cos(f - f0) + z~0' sin(f - f0).
+//
+// Time/anomaly-domain mapping (f_dot = (h / p^2) rho^2):
+//   x~  = rho x
+//   x~' = (p^2 / (h rho)) x_dot - e sin f x
+//   x_dot = (h / p^2) (rho x~' + e sin f x~)
+
+struct YaChiefElements final
+{
+    double e{0.0};
+    double h_over_p2{0.0}; // h / p^2 (true-anomaly rate scale)
+    double n{0.0};         // mean motion
+    double sqrt_1me2{1.0}; // sqrt(1 - e^2)
+    double M0{0.0};        // mean anomaly at tau = 0
+    double sin_f0{0.0};
+    double cos_f0{1.0};
+};
+
+struct YaAnomaly final
+{
+    double sin_f{0.0};
+    double cos_f{1.0};
+};
+
+inline bool make_chief_elements(const YaStmParams& p, YaChiefElements& out) noexcept
+{
+    const double r = norm(p.chief_r0_i);
+    if (!(r > 0.0) || !std::isfinite(r))
+    {
+        return false;
+    }
+
+    const double h = norm(cross(p.chief_r0_i, p.chief_v0_i));
+    if (!(h > 0.0) || !std::isfinite(h))
+    {
+        return false;
+    }
+
+    const double semi_latus = h * h / p.mu;
+    const double e_cos_f0 = semi_latus / r - 1.0;
+    const double e_sin_f0 = h * dot(p.chief_r0_i, p.chief_v0_i) / (p.mu * r);
+    const double e = std::hypot(e_cos_f0, e_sin_f0);
+    if (!(e < 1.0) || !std::isfinite(e))
+    {
+        return false; // closed form covers bound (elliptic) chiefs only
+    }
+
+    out.e = e;
+    out.h_over_p2 = h / (semi_latus * semi_latus);
+    out.sqrt_1me2 = std::sqrt((1.0 - e) * (1.0 + e));
+
+    const double a = semi_latus / ((1.0 - e) * (1.0 + e));
+    out.n = std::sqrt(p.mu / (a * a * a));
+
+    // Circular chief: anomalies are measured from the chief position at t0.
+    out.sin_f0 = (e > 0.0) ? (e_sin_f0 / e) : 0.0;
+    out.cos_f0 = (e > 0.0) ? (e_cos_f0 / e) : 1.0;
+
+    const double rho0 = 1.0 + e * out.cos_f0;
+    const double sin_E0 = out.sqrt_1me2 * out.sin_f0 / rho0;
+    const double cos_E0 = (e + out.cos_f0) / rho0;
+    out.M0 = std::atan2(sin_E0, cos_E0) - e * sin_E0;
+
+    return std::isfinite(out.M0) && std::isfinite(out.n) && std::isfinite(out.h_over_p2);
+}
+
+inline YaAnomaly anomaly_at(const YaChiefElements& el, double tau) noexcept
+{
+    const double M = el.M0 + el.n * tau;
+    const double E = math::solve_kepler_elliptic(M, el.e, contracts::Det::kKeplerIters);
+    const double sE = std::sin(E);
+    const double cE = std::cos(E);
+    const double denom = 1.0 - el.e * cE;
+
+    YaAnomaly a{};
+    a.sin_f = el.sqrt_1me2 * sE / denom;
+    a.cos_f = (cE - el.e) / denom;
+    return a;
+}
+
+// In-plane fundamental matrix Psi(f) with rows [x~, y~, x~', y~'] and columns [A, B, D, E].
+inline void ya_fundamental_inplane(double e, const YaAnomaly& a, double J,
+                                   double (&Psi)[4][4]) noexcept
+{
+    const double rho = 1.0 + e * a.cos_f;
+    const double s = rho * a.sin_f;
+    const double c = rho * a.cos_f;
+    const double ds = a.cos_f + e * (a.cos_f * a.cos_f - a.sin_f * a.sin_f);
+    const double dc = -(a.sin_f + 2.0 * e * a.sin_f * a.cos_f);
+    const double one_plus_inv_rho = 1.0 + 1.0 / rho;
+    const double esJ = e * s * J;
+
+    Psi[0][0] = s;
+    Psi[0][1] = c;
+    Psi[0][2] = 2.0 - 3.0 * esJ;
+    Psi[0][3] = 0.0;
+
+    Psi[1][0] = c * one_plus_inv_rho;
+    Psi[1][1] = -s * one_plus_inv_rho;
+    Psi[1][2] = -3.0 * rho * rho * J;
+    Psi[1][3] = 1.0;
+
+    Psi[2][0] = ds;
+    Psi[2][1] = dc;
+    Psi[2][2] = -3.0 * e * (ds * J + s / (rho * rho));
+    Psi[2][3] = 0.0;
+
+    Psi[3][0] = -2.0 * s;
+    Psi[3][1] = -2.0 * c + e;
+    Psi[3][2] = -3.0 + 6.0 * esJ;
+    Psi[3][3] = 0.0;
+}
+
+// Solve A x = b (4x4) by Gaussian elimination with partial pivoting.
+// Deterministic: fixed loop structure, first-max pivot tie-break.
+inline bool solve4(double (&A)[4][4], double (&b)[4]) noexcept
+{
+    for (int col = 0; col < 4; ++col)
+    {
+        int piv = col;
+        double best = std::fabs(A[col][col]);
+        for (int r = col + 1; r < 4; ++r)
+        {
+            const double v = std::fabs(A[r][col]);
+            if (v > best)
+            {
+                best = v;
+                piv = r;
+            }
+        }
+        if (!(best > 0.0) || !std::isfinite(best))
+        {
+            return false;
+        }
+        if (piv != col)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                const double t = A[col][c];
+                A[col][c] = A[piv][c];
+                A[piv][c] = t;
+            }
+            const double t = b[col];
+            b[col] = b[piv];
+            b[piv] = t;
+        }
+        for (int r = col + 1; r < 4; ++r)
+        {
+            const double m = A[r][col] / A[col][col];
+            for (int c = col; c < 4; ++c)
+            {
+                A[r][c] -= m * A[col][c];
+            }
+            b[r] -= m * b[col];
+        }
+    }
+    for (int r = 3; r >= 0; --r)
+    {
+        double acc = b[r];
+        for (int c = r + 1; c < 4; ++c)
+        {
+            acc -= A[r][c] * b[c];
+        }
+        b[r] = acc / A[r][r];
+    }
+    return std::isfinite(b[0]) && std::isfinite(b[1]) && std::isfinite(b[2]) &&
+           std::isfinite(b[3]);
+}
+
+inline ModelCode predict_closed_form(const RelStateRic& x0_ric,
+                                     const YaStmParams& params,
+                                     const TimeGrid& grid,
+                                     Span<Vec3> out_r_ric,
+                                     Span<Vec3> out_v_ric,
+                                     bool want_vel,
+                                     std::size_t& steps_written) noexcept
+{
+    YaChiefElements el{};
+    if (!make_chief_elements(params, el))
+    {
+        return ModelCode::kInvalidInput;
+    }
+
+    const double e = el.e;
+    const double p2_over_h = 1.0 / el.h_over_p2;
+
+    // Map the initial physical state into the anomaly domain at f0.
+    const double rho0 = 1.0 + e * el.cos_f0;
+    const double esf0 = e * el.sin_f0;
+    const double vel_scale0 = p2_over_h / rho0;
+
+    double w[4] = {rho0 * x0_ric.r_ric.x, rho0 * x0_ric.r_ric.y,
+                   vel_scale0 * x0_ric.v_ric.x - esf0 * x0_ric.r_ric.x,
+                   vel_scale0 * x0_ric.v_ric.y - esf0 * x0_ric.r_ric.y};
+    const double zt0 = rho0 * x0_ric.r_ric.z;
+    const double dzt0 = vel_scale0 * x0_ric.v_ric.z - esf0 * x0_ric.r_ric.z;
+
+    // Integration constants: Psi(f0) * k = w0 (J = 0 at tau = 0).
+    double Psi[4][4];
+    const YaAnomaly a0{el.sin_f0, el.cos_f0};
+    ya_fundamental_inplane(e, a0, 0.0, Psi);
+    if (!solve4(Psi, w))
+    {
+        return ModelCode::kInvalidInput;
+    }
+
+    double t_prev = 0.0;
+    const std::size_t steps = grid.tau.size();
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        const double tau = grid.tau[k];
+        if (!(tau >= 0.0) || !std::isfinite(tau) || tau < t_prev)
+        {
+            return ModelCode::kInvalidInput;
+        }
+
+        const YaAnomaly a = anomaly_at(el, tau);
+        const double J = el.h_over_p2 * tau;
+        ya_fundamental_inplane(e, a, J, Psi);
+
+        double xt[4];
+        for (int r = 0; r < 4; ++r)
+        {
+            xt[r] = Psi[r][0] * w[0] + Psi[r][1] * w[1] + Psi[r][2] * w[2] + Psi[r][3] * w[3];
+        }
+
+        const double cos_df = a.cos_f * el.cos_f0 + a.sin_f * el.sin_f0;
+        const double sin_df = a.sin_f * el.cos_f0 - a.cos_f * el.sin_f0;
+        const double zt = zt0 * cos_df + dzt0 * sin_df;
+        const double dzt = -zt0 * sin_df + dzt0 * cos_df;
+
+        const double rho = 1.0 + e * a.cos_f;
+        const double inv_rho = 1.0 / rho;
+        const Vec3 r{xt[0] * inv_rho, xt[1] * inv_rho, zt * inv_rho};
+        if (!finite3(r))
+        {
+            return ModelCode::kInvalidInput;
+        }
+        out_r_ric[k] = r;
+
+        if (want_vel)
+        {
+            const double esf = e * a.sin_f;
+            out_v_ric[k] = Vec3{el.h_over_p2 * (rho * xt[2] + esf * xt[0]),
+                                el.h_over_p2 * (rho * xt[3] + esf * xt[1]),
+                                el.h_over_p2 * (rho * dzt + esf * zt)};
+        }
+
+        t_prev = tau;
+        steps_written = k + 1;
+    }
+
+    return ModelCode::kOk;
+}
+
+// Shared validation for both predict overloads. Returns false with res filled on early exit.
+inline bool validate_predict(const RelStateRic& x0_ric,
+                             const YaStmParams& params,
+                             const TimeGrid& grid,
+                             Span<Vec3> out_r_ric,
+                             ModelYA_STM::Result& res) noexcept
+{
+    // Validate parameters.
+    if (!params_valid(params))
+    {
+        res.code = ModelCode::kInvalidInput;
+        return false;
+    }
+
+    // Validate state.
+    if (!finite3(x0_ric.r_ric) || !finite3(x0_ric.v_ric))
+    {
+        res.code = ModelCode::kInvalidInput;
+        return false;
+    }
+
+    const std::size_t steps = grid.tau.size();
+    if (steps == 0)
+    {
+        res.code = ModelCode::kOk;
+        res.steps_written = 0;
+        return false;
+    }
+
+    if (out_r_ric.data == nullptr || out_r_ric.size < steps)
+    {
+        res.code = ModelCode::kInsufficientOutputCapacity;
+        return false;
+    }
+    return true;
+}
+
+// Table inputs must match the params bitwise (same chief, same step policy).
+inline bool ephemeris_matches(const YaChiefEphemeris& chief, const YaStmParams& params) noexcept
+{
+    return (chief.mu == params.mu) && (chief.max_dt_sec == params.max_dt_sec) &&
+           (chief.chief_r0_i.x == params.chief_r0_i.x) &&
+           (chief.chief_r0_i.y == params.chief_r0_i.y) &&
+           (chief.chief_r0_i.z == params.chief_r0_i.z) &&
+           (chief.chief_v0_i.x == params.chief_v0_i.x) &&
+           (chief.chief_v0_i.y == params.chief_v0_i.y) &&
+           (chief.chief_v0_i.z == params.chief_v0_i.z);
+}
+
+// Shared batch driver. make_source() returns a fresh chief source per block.
+template <typename MakeSource>
+inline ModelYA_STM::Result predict_batch_impl(const ModelYA_STM& model,
+                                              Span<const RelStateRic> x0_ric,
+                                              const YaStmParams& params,
+                                              const TimeGrid& grid,
+                                              Span2D<Vec3> out_r_ric,
+                                              Span2D<Vec3> out_v_ric,
+                                              Span<ModelCode> out_row_codes,
+                                              MakeSource&& make_source) noexcept
+{
+    ModelYA_STM::Result res{};
+    if (!params_valid(params))
+    {
+        res.code = ModelCode::kInvalidInput;
+        return res;
+    }
+
+    const std::size_t count = x0_ric.size;
+    const std::size_t steps = grid.tau.size();
+    if (count == 0 || steps == 0)
+    {
+        return res;
+    }
+    if (out_r_ric.data == nullptr || out_r_ric.rows < count || out_r_ric.cols < steps)
+    {
+        res.code = ModelCode::kInsufficientOutputCapacity;
+        return res;
+    }
+
+    const bool want_vel =
+        (out_v_ric.data != nullptr && out_v_ric.rows >= count && out_v_ric.cols >= steps);
+    const bool want_codes = (out_row_codes.data != nullptr && out_row_codes.size >= count);
+
+    if (params.backend != YaStmBackend::kRk4Reference)
+    {
+        // Per-deputy sampling (closed form) or step sizes (adaptive); no shared schedule.
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const auto row = model.predict_ya_stm(
+                x0_ric[i], params, grid, out_r_ric.row(i),
+                want_vel ? out_v_ric.row(i) : Span<Vec3>{nullptr, 0});
+            if (want_codes)
+            {
+                out_row_codes[i] = row.code;
+            }
+        }
+        res.steps_written = steps;
+        return res;
+    }
+
+    for (std::size_t row0 = 0; row0 < count; row0 += ModelYA_STM::kBatchLanes)
+    {
+        const std::size_t lanes = std::min(ModelYA_STM::kBatchLanes, count - row0);
+
+        bool lane_ok[ModelYA_STM::kBatchLanes]{};
+        for (std::size_t j = 0; j < lanes; ++j)
+        {
+            const RelStateRic& x0 = x0_ric[row0 + j];
+            lane_ok[j] = finite3(x0.r_ric) && finite3(x0.v_ric);
+        }
+
+        auto source = make_source();
+        res.code = predict_rk4_block(x0_ric, row0, lanes, params, grid, source, out_r_ric,
+                                     out_v_ric, want_vel, lane_ok);
+        if (res.code != ModelCode::kOk)
+        {
+            return res; // chief failure: the whole batch fails
+        }
+
+        if (want_codes)
+        {
+            for (std::size_t j = 0; j < lanes; ++j)
+            {
+                out_row_codes[row0 + j] = lane_ok[j] ? ModelCode::kOk : ModelCode::kInvalidInput;
+            }
+        }
+    }
+
+    res.steps_written = steps;
+    return res;
+}
+
+} // namespace
+
+ModelYA_STM::Result ModelYA_STM::predict_ya_stm(const RelStateRic& x0_ric,
+                                               const YaStmParams& params,
+                                               const TimeGrid& grid,
+                                               Span<Vec3> out_r_ric,
+                                               Span<Vec3> out_v_ric) const noexcept
+{
+    Result res{};
+    if (!validate_predict(x0_ric, params, grid, out_r_ric, res))
+    {
+        return res;
+    }
+
+    const std::size_t steps = grid.tau.size();
+    const bool want_vel = (out_v_ric.data != nullptr && out_v_ric.size >= steps);
+
+    if (params.backend == YaStmBackend::kClosedForm)
+    {
+        res.code = predict_closed_form(x0_ric, params, grid, out_r_ric, out_v_ric, want_vel,
+                                       res.steps_written);
+        return res;
+    }
+
+    if (params.backend == YaStmBackend::kDormandPrince54)
+    {
+        res.code = predict_dopri(x0_ric, params, grid, out_r_ric, out_v_ric, want_vel, res);
+        return res;
+    }
+
+    DirectChiefSource chief{params};
+    res.code = predict_rk4(x0_ric, params, grid, chief, out_r_ric, out_v_ric, want_vel,
+                           res.steps_written, res.integrator_steps);
+    res.derivative_evals = 4 * res.integrator_steps;
+    return res;
+}
+
+ModelYA_STM::Result ModelYA_STM::predict_ya_stm(const RelStateRic& x0_ric,
+                                               const YaStmParams& params,
+                                               const TimeGrid& grid,
+                                               const YaChiefEphemeris& chief,
+                                               Span<Vec3> out_r_ric,
+                                               Span<Vec3> out_v_ric) const noexcept
+{
+    if (params.backend != YaStmBackend::kRk4Reference)
+    {
+        // Only the RK4 path walks the tabulated stage schedule.
+        return predict_ya_stm(x0_ric, params, grid, out_r_ric, out_v_ric);
+    }
+
+    Result res{};
+    if (!validate_predict(x0_ric, params, grid, out_r_ric, res))
+    {
+        return res;
+    }
+
+    // The table must have been built for exactly these chief inputs.
+    if (!ephemeris_matches(chief, params))
+    {
+        res.code = ModelCode::kInvalidInput;
+        return res;
+    }
+
+    const std::size_t steps = grid.tau.size();
+    const bool want_vel = (out_v_ric.data != nullptr && out_v_ric.size >= steps);
+
+    TableChiefSource source{chief};
+    res.code = predict_rk4(x0_ric, params, grid, source, out_r_ric, out_v_ric, want_vel,
+                           res.steps_written, res.integrator_steps);
+    res.derivative_evals = 4 * res.integrator_steps;
+    return res;
+}
+
+ModelYA_STM::Result ModelYA_STM::predict_ya_stm_batch(Span<const RelStateRic> x0_ric,
+                                                     const YaStmParams& params,
+                                                     const TimeGrid& grid,
+                                                     Span2D<Vec3> out_r_ric,
+                                                     Span2D<Vec3> out_v_ric,
+                                                     Span<ModelCode> out_row_codes) const noexcept
+{
+    return predict_batch_impl(*this, x0_ric, params, grid, out_r_ric, out_v_ric, out_row_codes,
+                              [&]() { return DirectChiefSource{params}; });
+}
+
+ModelYA_STM::Result ModelYA_STM::predict_ya_stm_batch(Span<const RelStateRic> x0_ric,
+                                                     const YaStmParams& params,
+                                                     const TimeGrid& grid,
+                                                     const YaChiefEphemeris& chief,
+                                                     Span2D<Vec3> out_r_ric,
+                                                     Span2D<Vec3> out_v_ric,
+                                                     Span<ModelCode> out_row_codes) const noexcept
+{
+    if (params.backend == YaStmBackend::kRk4Reference && !ephemeris_matches(chief, params))
+    {
+        Result res{};
+        res.code = ModelCode::kInvalidInput;
+        return res;
+    }
+    return predict_batch_impl(*this, x0_ric, params, grid, out_r_ric, out_v_ric, out_row_codes,
+                              [&]() { return TableChiefSource{chief}; });
+}
+
+std::size_t ModelYA_STM::chief_ephemeris_size(const YaStmParams& params,
+                                              const TimeGrid& grid) noexcept
+{
+    if (!(params.max_dt_sec > 0.0) || !std::isfinite(params.max_dt_sec))
+    {
+        return 0;
+    }
+
+    std::size_t count = 0;
+    const ModelCode code = walk_rk4_schedule(
+        grid, params.max_dt_sec,
+        [&](double) {
+            ++count;
+            return true;
+        },
+        [&](double, double) {
+            count += 2;
+            return true;
+        },
+        [](std::size_t) {});
+    return (code == ModelCode::kOk) ? count : 0;
+}
+
+ModelYA_STM::Result ModelYA_STM::build_chief_ephemeris(const YaStmParams& params,
+                                                      const TimeGrid& grid,
+                                                      Span<YaChiefSample> storage,
+                                                      YaChiefEphemeris& out) const noexcept
+{
+    Result res{};
+    out = YaChiefEphemeris{};
+
+    if (!params_valid(params))
+    {
+        res.code = ModelCode::kInvalidInput;
+        return res;
+    }
+
+    const std::size_t needed = chief_ephemeris_size(params, grid);
+    if (needed > storage.size || (needed > 0 && storage.data == nullptr))
+    {
+        res.code = ModelCode::kInsufficientOutputCapacity;
+        return res;
+    }
+
+    std::size_t count = 0;
+    auto record = [&](double t) {
+        if (!chief_sample_at(t, params, storage[count]))
+        {
+            return false;
+        }
+        ++count;
+        return true;
+    };
+
+    res.code = walk_rk4_schedule(
+        grid, params.max_dt_sec, record,
+        [&](double t, double h) { return record(t + 0.5 * h) && record(t + h); },
+        [](std::size_t) {});
+    if (res.code != ModelCode::kOk)
+    {
+        return res;
+    }
+
+    out.samples = Span<const YaChiefSample>{storage.data, count};
+    out.mu = params.mu;
+    out.chief_r0_i = params.chief_r0_i;
+    out.chief_v0_i = params.chief_v0_i;
+    out.max_dt_sec = params.max_dt_sec;
+    res.steps_written = count;
     return res;
 }
 
@@ -6,19 +6,25 @@
  * @brief Deterministic eccentric-reference relative dynamics model (TH/YA-family).
  *
  * Notes:
- * - This implementation propagates the Tschauner-Hempel (TH) linear time-varying (LTV)
- *   relative dynamics using a fixed-step RK4 integrator.
- * - The classical Yamanaka-Ankersen (YA) solution provides a closed-form STM for TH.
- *   This module is structured so the RK4 core can be replaced by a closed-form STM
- *   later without changing the caller-facing API.
+ * - Two backends propagate the Tschauner-Hempel (TH) linear time-varying (LTV) relative
+ *   dynamics (selected by YaStmParams::backend):
+ *   - kRk4Reference: fixed-step RK4 integration of the time-domain TH equations. Kept as the
+ *     numerical reference for the closed-form path.
+ *   - kClosedForm: the Yamanaka-Ankersen (YA) closed-form STM. Each grid sample costs one
+ *     Kepler solve for the chief true anomaly plus a 6x6 fundamental-matrix product.
+ *   - kDormandPrince54: embedded Dormand-Prince 5(4) integration of the TH equations with
+ *     error control, so steps stretch near apogee and shrink near perigee.
+ * - All backends share the caller-facing API; outputs agree to integrator truncation error.
  *
  * Design constraints:
- * - Deterministic control flow (fixed Kepler iterations; fixed RK4 stepping policy).
+ * - Deterministic control flow (input-defined Kepler termination; fixed RK4 stepping policy; fixed
+ *   step-acceptance policy and attempt cap for the adaptive integrator).
  * - No logging.
  * - No heap allocations in steady-state.
  */
 
 #include <cstddef>
+#include <cstdint>
 
 #include "core/time_grid.hpp"
 #include "core/types.hpp"
@@ -27,6 +33,21 @@
 namespace bullseye_pred
 {
 
+/**
+ * @brief Propagation backend for ModelYA_STM.
+ */
+enum class YaStmBackend : std::uint8_t
+{
+    /** @brief Fixed-step RK4 integration of TH dynamics (numerical reference). */
+    kRk4Reference = 0,
+
+    /** @brief Closed-form Yamanaka-Ankersen STM. Requires a bound chief orbit (e < 1). */
+    kClosedForm = 1,
+
+    /** @brief Adaptive Dormand-Prince 5(4) integration of TH dynamics (error-controlled). */
+    kDormandPrince54 = 2,
+};
+
 /**
  * @brief Parameter block for eccentric-reference (TH/YA-family) model.
  */
@@ -45,9 +66,79 @@ struct YaStmParams final
      * @brief Maximum RK4 substep size [s].
      *
      * The integrator will subdivide each requested dt into N = ceil(dt / max_dt_sec)
-     * substeps. Must be finite and > 0.
+     * substeps. Must be finite and > 0. kRk4Reference uses it as the substep bound;
+     * kDormandPrince54 uses it as the initial step size.
      */
     double max_dt_sec{0.25};
+
+    /** @brief Propagation backend (RK4 reference by default). */
+    YaStmBackend backend{YaStmBackend::kRk4Reference};
+
+    /**
+     * @brief Relative local error tolerance (kDormandPrince54 only). Must be finite and > 0.
+     *
+     * A step is accepted when, for every state component i,
+     * |err_i| <= abs_tol + rel_tol * max(|y_i|, |y_new_i|).
+     */
+    double rel_tol{1.0e-10};
+
+    /** @brief Absolute local error tolerance [m, m/s] (kDormandPrince54 only). Finite, > 0. */
+    double abs_tol{1.0e-9};
+
+    /**
+     * @brief Cap on step attempts (accepted + rejected) per call (kDormandPrince54 only).
+     *
+     * Bounds the work per call; exceeding it yields kInvalidInput. Must be > 0.
+     */
+    std::uint32_t max_step_attempts{100000};
+};
+
+/**
+ * @brief Chief TH coefficients at one RK4 stage time (one per-tick chief ephemeris entry).
+ */
+struct YaChiefSample final
+{
+    /** @brief Stage time offset from t0 [s]. */
+    double tau{0.0};
+
+    /** @brief Chief radius |r| [m]. */
+    double r_norm{0.0};
+
+    /** @brief Chief orbit rate omega = |h| / r^2 [rad/s]. */
+    double omega{0.0};
+
+    /** @brief Chief orbit rate derivative omega_dot = -2 omega r_dot / r [rad/s^2]. */
+    double omega_dot{0.0};
+
+    /** @brief Gravity-gradient scale mu / r^3 [1/s^2]. */
+    double mu_over_r3{0.0};
+};
+
+/**
+ * @brief Per-tick chief ephemeris shared by all deputies (kRk4Reference backend).
+ *
+ * The chief trajectory is the same for every deputy, so the TH coefficients are computed once
+ * per tick by ModelYA_STM::build_chief_ephemeris() and each deputy propagation only reads them.
+ *
+ * Layout:
+ * - Entries follow the RK4 stage schedule: for each grid interval with dt > 0, the interval
+ *   start, then (midpoint, end) for each substep.
+ * - Storage is caller-owned (non-owning view); the table is valid while the storage is.
+ *
+ * Determinism:
+ * - Table-driven propagation is bitwise identical to on-the-fly chief propagation. Stage times
+ *   are checked bitwise on use; a mismatch (table built for another grid) yields kInvalidInput.
+ */
+struct YaChiefEphemeris final
+{
+    /** @brief Chief samples in stage-schedule order. */
+    Span<const YaChiefSample> samples{};
+
+    /** @brief Inputs the table was built for (checked against YaStmParams on use). */
+    double mu{0.0};
+    Vec3 chief_r0_i{};
+    Vec3 chief_v0_i{};
+    double max_dt_sec{0.0};
 };
 
 /**
@@ -63,6 +154,15 @@ class ModelYA_STM final
     {
         ModelCode code{ModelCode::kOk};
         std::size_t steps_written{0};
+
+        /** @brief Integrator steps taken (RK4 substeps, or accepted adaptive steps). */
+        std::size_t integrator_steps{0};
+
+        /** @brief Rejected adaptive step attempts (kDormandPrince54 only). */
+        std::size_t rejected_steps{0};
+
+        /** @brief Deputy derivative evaluations (integrating backends; single-deputy calls). */
+        std::size_t derivative_evals{0};
     };
 
     /**
@@ -80,14 +180,97 @@ class ModelYA_STM final
      * - out_v_ric is optional; if provided, it must also hold grid.tau.size().
      *
      * Determinism:
-     * - Chief propagation uses fixed-iteration universal-variable solve.
+     * - Chief propagation uses the shared universal-variable solver (RK4; tolerance-terminated,
+     *   capped) or a fixed-iteration elliptic Kepler solve (closed form).
      * - RK4 uses a deterministic ceil-based subdivision per interval.
+     * - Dormand-Prince carries its step size across grid intervals and shortens the last step
+     *   of each interval to land on the grid time; acceptance depends only on the inputs.
+     *
+     * Closed form:
+     * - Returns kInvalidInput if the chief orbit is not bound (e >= 1) or has no angular momentum.
+     * - Grid samples are evaluated independently (no sequential accumulation error).
+     */
+    [[nodiscard]] Result predict_ya_stm(const RelStateRic& x0_ric,
+                                       const YaStmParams& params,
+                                       const TimeGrid& grid,
+                                       Span<Vec3> out_r_ric,
+                                       Span<Vec3> out_v_ric) const noexcept;
+
+    /**
+     * @brief Predict using a prebuilt per-tick chief ephemeris (no Kepler solves per deputy).
+     *
+     * Results are bitwise identical to the overload without @p chief. The closed-form and
+     * Dormand-Prince backends ignore the table (their stage times are not on the RK4 schedule).
+     *
+     * @param chief Table from build_chief_ephemeris() for the same params and grid.
      */
     [[nodiscard]] Result predict_ya_stm(const RelStateRic& x0_ric,
                                        const YaStmParams& params,
                                        const TimeGrid& grid,
+                                       const YaChiefEphemeris& chief,
                                        Span<Vec3> out_r_ric,
                                        Span<Vec3> out_v_ric) const noexcept;
+
+    /** @brief Deputies advanced in lockstep per block by predict_ya_stm_batch(). */
+    static constexpr std::size_t kBatchLanes = 32;
+
+    /**
+     * @brief Predict several deputies sharing one chief and one grid, in lockstep.
+     *
+     * RK4: deputies are advanced in SoA blocks of kBatchLanes through one stage schedule, with
+     * one chief sample per stage for the whole block. Closed form and Dormand-Prince (whose
+     * step sizes depend on each deputy's state): one call per row.
+     * Per-row results are bitwise identical to predict_ya_stm().
+     *
+     * Row semantics follow IRelativeModel::predict_hcw_batch(): parameter/capacity errors and
+     * chief propagation failures reject the batch; a non-finite initial state (or a row that
+     * diverges) fails only its own row, reported via out_row_codes when provided.
+     *
+     * @param x0_ric Initial relative states at t0 in RIC, one per row.
+     * @param out_r_ric Output positions [row][step] (required).
+     * @param out_v_ric Output velocities [row][step] (optional; may be empty).
+     * @param out_row_codes Per-row status (optional; may be {nullptr,0}).
+     */
+    [[nodiscard]] Result predict_ya_stm_batch(Span<const RelStateRic> x0_ric,
+                                             const YaStmParams& params,
+                                             const TimeGrid& grid,
+                                             Span2D<Vec3> out_r_ric,
+                                             Span2D<Vec3> out_v_ric,
+                                             Span<ModelCode> out_row_codes) const noexcept;
+
+    /**
+     * @brief Batched prediction reading a prebuilt per-tick chief ephemeris.
+     *
+     * @param chief Table from build_chief_ephemeris() for the same params and grid.
+     */
+    [[nodiscard]] Result predict_ya_stm_batch(Span<const RelStateRic> x0_ric,
+                                             const YaStmParams& params,
+                                             const TimeGrid& grid,
+                                             const YaChiefEphemeris& chief,
+                                             Span2D<Vec3> out_r_ric,
+                                             Span2D<Vec3> out_v_ric,
+                                             Span<ModelCode> out_row_codes) const noexcept;
+
+    /**
+     * @brief Number of chief ephemeris entries required for (params, grid).
+     *
+     * @return Entry count, or 0 if the grid/step policy is invalid.
+     */
+    [[nodiscard]] static std::size_t chief_ephemeris_size(const YaStmParams& params,
+                                                          const TimeGrid& grid) noexcept;
+
+    /**
+     * @brief Build the per-tick chief ephemeris into caller-owned storage.
+     *
+     * @param storage Output storage; must hold chief_ephemeris_size(params, grid) entries.
+     * @param out View over the written entries plus the inputs it was built for.
+     * @return kOk with steps_written = entries written; kInsufficientOutputCapacity if storage is
+     *         too small; kInvalidInput on invalid parameters or chief propagation failure.
+     */
+    [[nodiscard]] Result build_chief_ephemeris(const YaStmParams& params,
+                                              const TimeGrid& grid,
+                                              Span<YaChiefSample> storage,
+                                              YaChiefEphemeris& out) const noexcept;
 };
 
 } // namespace bullseye_pred
@@ -6,7 +6,8 @@
  * @brief Interfaces and POD types for relative dynamics models (pure math layer).
  *
  * This module defines:
- * - Minimal span-like views (non-owning) for deterministic, allocation-free output.
+ * - Minimal span-like views (non-owning, 1-D and row-strided 2-D) for deterministic,
+ *   allocation-free output.
  * - Relative state representation in the Bullseye RIC frame.
  * - A model interface suitable for HCW/YA-style predictors.
  *
@@ -16,6 +17,7 @@
  * - Deterministic iteration order.
  */
 
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 
@@ -70,6 +72,57 @@ struct Span final
     [[nodiscard]] constexpr const T& operator[](std::size_t i) const noexcept { return data[i]; }
 };
 
+/**
+ * @brief Minimal row-strided 2-D view (non-owning), e.g. [vehicle][step].
+ *
+ * @tparam T Element type.
+ *
+ * Row i starts at data + i * row_stride and holds cols elements. row_stride >= cols allows
+ * viewing the leading part of wider fixed-capacity storage. No bounds checking is performed.
+ */
+template <typename T>
+struct Span2D final
+{
+    /** @brief Pointer to element (0, 0) (may be nullptr if rows==0). */
+    T* data{nullptr};
+
+    /** @brief Number of rows in the view. */
+    std::size_t rows{0};
+
+    /** @brief Number of usable elements per row. */
+    std::size_t cols{0};
+
+    /** @brief Distance between consecutive rows, in elements. */
+    std::size_t row_stride{0};
+
+    /** @brief Default constructor (empty view). */
+    constexpr Span2D() = default;
+
+    /**
+     * @brief Construct a view from pointer + shape.
+     *
+     * @param p Pointer to element (0, 0).
+     * @param r Number of rows.
+     * @param c Number of elements per row.
+     * @param stride Row stride in elements.
+     */
+    constexpr Span2D(T* p, std::size_t r, std::size_t c, std::size_t stride)
+        : data(p), rows(r), cols(c), row_stride(stride)
+    {
+    }
+
+    /**
+     * @brief Row view (unchecked).
+     *
+     * @param i Row index.
+     * @return Span over the cols elements of row i.
+     */
+    [[nodiscard]] constexpr Span<T> row(std::size_t i) const noexcept
+    {
+        return Span<T>{data + i * row_stride, cols};
+    }
+};
+
 /**
  * @brief Relative state expressed in the Bullseye RIC frame.
  *
@@ -119,6 +172,16 @@ struct HcwParams final
      * Must be finite and strictly > 0.
      */
     double n_radps{0.0};
+
+    /**
+     * @brief Opt-in uniform-grid trig fast path: re-anchor interval in steps.
+     *
+     * 0 (default) evaluates sin/cos(n tau) with libm at every step. N > 0 uses a rotation
+     * recurrence on uniform grids (see uniform_cadence()), re-anchored with libm every N steps;
+     * non-uniform grids always use libm. Trig error is bounded by
+     * math::sincos_recurrence_error_bound(N).
+     */
+    std::uint32_t trig_reanchor_interval{0};
 };
 
 /**
@@ -175,6 +238,82 @@ class IRelativeModel
                                             const TimeGrid& grid,
                                             Span<Vec3> out_r_ric,
                                             Span<Vec3> out_v_ric) const noexcept = 0;
+
+    /**
+     * @brief Predict HCW trajectories for several vehicles sharing one chief and one grid.
+     *
+     * Row i of the outputs receives the trajectory of x0_ric[i]. Grid, parameter and capacity
+     * errors apply to the whole batch and are reported in the returned code. A non-finite
+     * initial state only fails its own row: the row is left untouched and, if out_row_codes
+     * is provided, out_row_codes[i] is set to kInvalidInput (kOk otherwise).
+     *
+     * Outputs:
+     * - out_r_ric is required: rows >= x0_ric.size, cols >= grid.tau.size().
+     * - out_v_ric is optional; used only if it has the same minimum shape.
+     * - out_row_codes is optional; used only if it holds x0_ric.size entries.
+     *
+     * The default implementation calls predict_hcw() once per row. Results must be identical
+     * to per-vehicle predict_hcw() calls.
+     *
+     * @param x0_ric Initial relative states at t0 in RIC, one per row.
+     * @param params HCW parameters (shared by all rows).
+     * @param grid Time grid of offsets tau from t0 (shared by all rows).
+     * @param out_r_ric Output positions [row][step] (required).
+     * @param out_v_ric Output velocities [row][step] (optional; may be empty).
+     * @param out_row_codes Per-row status (optional; may be {nullptr,0}).
+     * @return Batch code and number of steps written per successful row.
+     */
+    [[nodiscard]] virtual Result predict_hcw_batch(Span<const RelStateRic> x0_ric,
+                                                  const HcwParams& params,
+                                                  const TimeGrid& grid,
+                                                  Span2D<Vec3> out_r_ric,
+                                                  Span2D<Vec3> out_v_ric,
+                                                  Span<ModelCode> out_row_codes) const noexcept
+    {
+        Result res{};
+        const std::size_t count = x0_ric.size;
+        const std::size_t steps = grid.tau.size();
+
+        if (!(params.n_radps > 0.0) || !std::isfinite(params.n_radps))
+        {
+            res.code = ModelCode::kInvalidInput;
+            return res;
+        }
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            if (!(grid.tau[k] >= 0.0) || !std::isfinite(grid.tau[k]))
+            {
+                res.code = ModelCode::kInvalidInput;
+                return res;
+            }
+        }
+        if (count == 0 || steps == 0)
+        {
+            return res;
+        }
+        if (out_r_ric.data == nullptr || out_r_ric.rows < count || out_r_ric.cols < steps)
+        {
+            res.code = ModelCode::kInsufficientOutputCapacity;
+            return res;
+        }
+
+        const bool want_vel = (out_v_ric.data != nullptr && out_v_ric.rows >= count &&
+                               out_v_ric.cols >= steps);
+        const bool want_codes = (out_row_codes.data != nullptr && out_row_codes.size >= count);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Result row =
+                predict_hcw(x0_ric[i], params, grid, out_r_ric.row(i),
+                            want_vel ? out_v_ric.row(i) : Span<Vec3>{nullptr, 0});
+            if (want_codes)
+            {
+                out_row_codes[i] = row.code;
+            }
+        }
+        res.steps_written = steps;
+        return res;
+    }
 };
 
 } // namespace bullseye_pred
@@ -0,0 +1,130 @@
+// models/stm_batch_backend.cpp
+
+/**
+ * @file stm_batch_backend.cpp
+ * @brief CPU reference STM batch backend (and the CUDA factory stub for non-CUDA builds).
+ */
+
+#include "models/stm_batch_backend.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace bullseye_pred
+{
+
+namespace
+{
+
+bool finite_state(const RelStateRic& x) noexcept
+{
+    return std::isfinite(x.r_ric.x) && std::isfinite(x.r_ric.y) && std::isfinite(x.r_ric.z) &&
+           std::isfinite(x.v_ric.x) && std::isfinite(x.v_ric.y) && std::isfinite(x.v_ric.z);
+}
+
+} // namespace
+
+ModelCode CpuStmBatchBackend::load_basis(Span2D<const Vec3> basis_r,
+                                         Span2D<const Vec3> basis_v) noexcept
+{
+    const std::size_t steps = basis_r.cols;
+    const bool has_vel = (basis_v.data != nullptr);
+    if (basis_r.data == nullptr || basis_r.rows != 6 ||
+        (has_vel && (basis_v.rows != 6 || basis_v.cols != steps)))
+    {
+        loaded_ = false;
+        return ModelCode::kInvalidInput;
+    }
+    if (steps > MAX_STEPS)
+    {
+        loaded_ = false;
+        return ModelCode::kInsufficientOutputCapacity;
+    }
+    for (std::size_t j = 0; j < 6; ++j)
+    {
+        std::copy_n(basis_r.row(j).data, steps, basis_r_.data() + j * MAX_STEPS);
+        if (has_vel)
+        {
+            std::copy_n(basis_v.row(j).data, steps, basis_v_.data() + j * MAX_STEPS);
+        }
+    }
+    steps_ = steps;
+    has_vel_ = has_vel;
+    loaded_ = true;
+    pending_ = false;
+    return ModelCode::kOk;
+}
+
+ModelCode CpuStmBatchBackend::submit(Span<const RelStateRic> x0,
+                                     Span<const bool> active,
+                                     bool want_vel) noexcept
+{
+    if (!loaded_ || active.size < x0.size || (want_vel && !has_vel_))
+    {
+        return ModelCode::kInvalidInput;
+    }
+    if (x0.size > MAX_VEHICLES)
+    {
+        return ModelCode::kInsufficientOutputCapacity;
+    }
+    std::copy_n(x0.data, x0.size, x0_.data());
+    std::copy_n(active.data, x0.size, active_.data());
+    rows_ = x0.size;
+    want_vel_ = want_vel;
+    pending_ = true;
+    return ModelCode::kOk;
+}
+
+ModelCode CpuStmBatchBackend::collect(Span2D<Vec3> out_r,
+                                      Span2D<Vec3> out_v,
+                                      Span<bool> out_ok) noexcept
+{
+    if (!pending_)
+    {
+        return ModelCode::kInvalidInput;
+    }
+    if (out_r.rows < rows_ || out_r.cols < steps_ || out_ok.size < rows_ ||
+        (want_vel_ && (out_v.rows < rows_ || out_v.cols < steps_)))
+    {
+        return ModelCode::kInsufficientOutputCapacity;
+    }
+    pending_ = false;
+    for (std::size_t i = 0; i < rows_; ++i)
+    {
+        if (!active_[i])
+        {
+            continue;
+        }
+        if (!finite_state(x0_[i]))
+        {
+            out_ok.data[i] = false;
+            continue;
+        }
+        const Span<Vec3> r = out_r.row(i);
+        for (std::size_t k = 0; k < steps_; ++k)
+        {
+            r.data[k] = stm_basis_apply(basis_r_.data(), MAX_STEPS, x0_[i], k);
+        }
+        if (want_vel_)
+        {
+            const Span<Vec3> v = out_v.row(i);
+            for (std::size_t k = 0; k < steps_; ++k)
+            {
+                v.data[k] = stm_basis_apply(basis_v_.data(), MAX_STEPS, x0_[i], k);
+            }
+        }
+        out_ok.data[i] = true;
+    }
+    return ModelCode::kOk;
+}
+
+#ifndef BULLSEYE_ENABLE_CUDA
+std::unique_ptr<IStmBatchBackend> make_cuda_stm_batch_backend(std::size_t /*max_rows*/,
+                                                              std::size_t /*max_steps*/,
+                                                              int /*device*/) noexcept
+{
+    return nullptr;
+}
+#endif
+
+} // namespace bullseye_pred
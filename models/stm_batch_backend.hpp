@@ -0,0 +1,159 @@
+// models/stm_batch_backend.hpp
+#pragma once
+
+/**
+ * @file stm_batch_backend.hpp
+ * @brief Batched state-transition backends: apply one tick's shared STM basis to many rows.
+ *
+ * Every built-in relative model is linear in the initial RIC state for a given chief and grid,
+ * x(tau_k) = Phi(tau_k) x0, and Phi is shared by all rows of a tick. The tick's model is
+ * therefore fully described by its basis: the six trajectories from the unit initial states
+ * e_0 .. e_5 (position then velocity components). Building the basis costs six model rows on
+ * the CPU; applying it to N rows is an O(N x steps) multiply-add that a backend may run
+ * elsewhere:
+ *
+ *   backend.load_basis(basis_r, basis_v);      // once per tick
+ *   backend.submit(x0, active, want_vel);      // stage + launch (asynchronous on devices)
+ *   backend.collect(out_r, out_v, out_ok);     // wait + copy into the caller's rows
+ *
+ * CpuStmBatchBackend is the reference. With BULLSEYE_ENABLE_CUDA the CUDA backend
+ * (make_cuda_stm_batch_backend()) stages through pinned host buffers on its own stream; the
+ * device-to-host copy lands in pinned memory and collect() copies it into the caller's rows
+ * (the Publisher back buffer when driven by StmBatchPolicy). Run under AsyncTickPipeline, the
+ * sim thread captures the next tick's inputs while the predictor thread waits on the device.
+ *
+ * Design constraints:
+ * - No allocations after construction; no logging.
+ * - Deterministic: every backend sums the six basis terms in the order of stm_basis_apply(),
+ *   without contraction, so backends agree bitwise.
+ */
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+#include "core/constants.hpp"
+#include "models/relative_model.hpp"
+
+namespace bullseye_pred
+{
+
+/**
+ * @brief Row k of a tick from its basis: sum_j x0_j * basis[j * stride + k] (j = r.x .. v.z).
+ *
+ * @param basis Basis row 0 (rows j = 0..5 are stride elements apart).
+ */
+inline Vec3 stm_basis_apply(const Vec3* basis,
+                            std::size_t stride,
+                            const RelStateRic& x0,
+                            std::size_t k) noexcept
+{
+    const double x[6] = {x0.r_ric.x, x0.r_ric.y, x0.r_ric.z, x0.v_ric.x, x0.v_ric.y, x0.v_ric.z};
+    Vec3 out{};
+    for (std::size_t j = 0; j < 6; ++j)
+    {
+        const Vec3& b = basis[j * stride + k];
+        out.x += x[j] * b.x;
+        out.y += x[j] * b.y;
+        out.z += x[j] * b.z;
+    }
+    return out;
+}
+
+/**
+ * @brief Backend applying a tick's STM basis to a batch of initial states.
+ *
+ * Calls for one backend are serial (one submission in flight). A failed call leaves outputs
+ * unchanged.
+ */
+class IStmBatchBackend
+{
+  public:
+    virtual ~IStmBatchBackend() = default;
+
+    /** @brief Short backend name for telemetry ("cpu", "cuda"). */
+    [[nodiscard]] virtual const char* name() const noexcept = 0;
+
+    /**
+     * @brief Load the tick's basis.
+     *
+     * @param basis_r Six rows: positions from unit initial states e_0 .. e_5 (cols = steps).
+     * @param basis_v Six rows of velocities, or empty when velocities are not needed.
+     * @return kOk, kInvalidInput (shape), or kInsufficientOutputCapacity (steps too large).
+     */
+    [[nodiscard]] virtual ModelCode load_basis(Span2D<const Vec3> basis_r,
+                                               Span2D<const Vec3> basis_v) noexcept = 0;
+
+    /**
+     * @brief Stage a batch and start applying the basis (returns before device completion).
+     *
+     * Inactive rows are skipped; active rows with non-finite states fail in collect().
+     *
+     * @return kOk, kInvalidInput (no basis, velocities requested without a velocity basis, or
+     *         a backend error), or kInsufficientOutputCapacity (too many rows).
+     */
+    [[nodiscard]] virtual ModelCode submit(Span<const RelStateRic> x0,
+                                           Span<const bool> active,
+                                           bool want_vel) noexcept = 0;
+
+    /**
+     * @brief Wait for the last submission and write its rows.
+     *
+     * Row i of out_r (out_v when velocities were submitted) receives the submitted row i;
+     * out_ok[i] is set for active rows only.
+     *
+     * @return kOk, kInvalidInput (nothing submitted or a backend error), or
+     *         kInsufficientOutputCapacity (outputs smaller than the submission).
+     */
+    [[nodiscard]] virtual ModelCode collect(Span2D<Vec3> out_r,
+                                            Span2D<Vec3> out_v,
+                                            Span<bool> out_ok) noexcept = 0;
+};
+
+/**
+ * @brief Reference backend: applies the basis on the calling thread in collect().
+ *
+ * Fixed capacity: MAX_VEHICLES rows of MAX_STEPS samples.
+ */
+class CpuStmBatchBackend final : public IStmBatchBackend
+{
+  public:
+    [[nodiscard]] const char* name() const noexcept override { return "cpu"; }
+
+    [[nodiscard]] ModelCode load_basis(Span2D<const Vec3> basis_r,
+                                       Span2D<const Vec3> basis_v) noexcept override;
+
+    [[nodiscard]] ModelCode submit(Span<const RelStateRic> x0,
+                                   Span<const bool> active,
+                                   bool want_vel) noexcept override;
+
+    [[nodiscard]] ModelCode collect(Span2D<Vec3> out_r,
+                                    Span2D<Vec3> out_v,
+                                    Span<bool> out_ok) noexcept override;
+
+  private:
+    std::array<Vec3, 6 * MAX_STEPS> basis_r_{};
+    std::array<Vec3, 6 * MAX_STEPS> basis_v_{};
+    std::size_t steps_{0};
+    bool loaded_{false};
+    bool has_vel_{false};
+
+    std::array<RelStateRic, MAX_VEHICLES> x0_{};
+    std::array<bool, MAX_VEHICLES> active_{};
+    std::size_t rows_{0};
+    bool want_vel_{false};
+    bool pending_{false};
+};
+
+/**
+ * @brief CUDA backend with pinned staging buffers for up to max_rows x max_steps.
+ *
+ * @param device CUDA device ordinal.
+ * @return nullptr when the library was built without BULLSEYE_ENABLE_CUDA, no device is
+ *         available, or device / pinned allocation fails.
+ */
+[[nodiscard]] std::unique_ptr<IStmBatchBackend> make_cuda_stm_batch_backend(std::size_t max_rows,
+                                                                          std::size_t max_steps,
+                                                                          int device = 0) noexcept;
+
+} // namespace bullseye_pred
@@ -0,0 +1,347 @@
+// models/stm_batch_backend_cuda.cu
+
+/**
+ * @file stm_batch_backend_cuda.cu
+ * @brief CUDA STM batch backend (built only with BULLSEYE_ENABLE_CUDA).
+ *
+ * One stream per backend. load_basis() and submit() pack their inputs into pinned host
+ * buffers and enqueue H2D copy, kernel and D2H copy without blocking; collect() waits on the
+ * stream's event and copies the pinned results into the caller's rows. Compiled with
+ * --fmad=false so the kernel's sums match stm_basis_apply() bitwise.
+ */
+
+#include "models/stm_batch_backend.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include <cuda_runtime.h>
+
+namespace bullseye_pred
+{
+
+namespace
+{
+
+static_assert(sizeof(Vec3) == 3 * sizeof(double) && std::is_trivially_copyable<Vec3>::value,
+              "Vec3 is staged as three packed doubles");
+
+constexpr unsigned kThreads = 128;
+constexpr std::size_t kMaxGridRows = 65535; // gridDim.y limit
+
+// One thread per (row, sample); basis layout [j][k][xyz], velocities after the 6 position rows.
+__global__ void stm_basis_apply_kernel(const double* __restrict__ basis,
+                                       const double* __restrict__ x0,
+                                       const unsigned char* __restrict__ ok,
+                                       double* __restrict__ out_r,
+                                       double* __restrict__ out_v,
+                                       unsigned steps,
+                                       int want_vel)
+{
+    const unsigned k = blockIdx.x * blockDim.x + threadIdx.x;
+    const unsigned i = blockIdx.y;
+    if (k >= steps || ok[i] == 0)
+    {
+        return;
+    }
+    const double* x = x0 + 6u * i;
+    const std::size_t out = (static_cast<std::size_t>(i) * steps + k) * 3u;
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        double s = 0.0;
+        for (unsigned j = 0; j < 6; ++j)
+        {
+            s += x[j] * basis[(j * steps + k) * 3u + c];
+        }
+        out_r[out + c] = s;
+    }
+    if (want_vel != 0)
+    {
+        const double* bv = basis + 6u * steps * 3u;
+        for (unsigned c = 0; c < 3; ++c)
+        {
+            double s = 0.0;
+            for (unsigned j = 0; j < 6; ++j)
+            {
+                s += x[j] * bv[(j * steps + k) * 3u + c];
+            }
+            out_v[out + c] = s;
+        }
+    }
+}
+
+bool finite_state(const RelStateRic& x) noexcept
+{
+    return std::isfinite(x.r_ric.x) && std::isfinite(x.r_ric.y) && std::isfinite(x.r_ric.z) &&
+           std::isfinite(x.v_ric.x) && std::isfinite(x.v_ric.y) && std::isfinite(x.v_ric.z);
+}
+
+class CudaStmBatchBackend final : public IStmBatchBackend
+{
+  public:
+    CudaStmBatchBackend(std::size_t max_rows, std::size_t max_steps, int device) noexcept
+        : max_rows_(max_rows), max_steps_(max_steps), device_(device)
+    {
+        const std::size_t basis = 2u * 6u * max_steps * 3u * sizeof(double);
+        const std::size_t rows = max_rows * max_steps * 3u * sizeof(double);
+        active_.reset(new (std::nothrow) bool[max_rows]());
+        ready_ = active_ != nullptr && cudaSetDevice(device_) == cudaSuccess &&
+                 cudaStreamCreateWithFlags(&stream_, cudaStreamNonBlocking) == cudaSuccess &&
+                 cudaEventCreateWithFlags(&done_, cudaEventDisableTiming) == cudaSuccess &&
+                 cudaMalloc(reinterpret_cast<void**>(&d_basis_), basis) == cudaSuccess &&
+                 cudaMalloc(reinterpret_cast<void**>(&d_x0_), max_rows * 6u * sizeof(double)) ==
+                     cudaSuccess &&
+                 cudaMalloc(reinterpret_cast<void**>(&d_ok_), max_rows) == cudaSuccess &&
+                 cudaMalloc(reinterpret_cast<void**>(&d_out_r_), rows) == cudaSuccess &&
+                 cudaMalloc(reinterpret_cast<void**>(&d_out_v_), rows) == cudaSuccess &&
+                 cudaHostAlloc(reinterpret_cast<void**>(&h_basis_), basis,
+                               cudaHostAllocWriteCombined) == cudaSuccess &&
+                 cudaHostAlloc(reinterpret_cast<void**>(&h_x0_), max_rows * 6u * sizeof(double),
+                               cudaHostAllocWriteCombined) == cudaSuccess &&
+                 cudaHostAlloc(reinterpret_cast<void**>(&h_ok_), max_rows,
+                               cudaHostAllocDefault) == cudaSuccess &&
+                 cudaHostAlloc(reinterpret_cast<void**>(&h_out_r_), rows, cudaHostAllocDefault) ==
+                     cudaSuccess &&
+                 cudaHostAlloc(reinterpret_cast<void**>(&h_out_v_), rows, cudaHostAllocDefault) ==
+                     cudaSuccess;
+    }
+
+    ~CudaStmBatchBackend() override
+    {
+        if (stream_ != nullptr)
+        {
+            (void)cudaStreamSynchronize(stream_);
+        }
+        (void)cudaFreeHost(h_out_v_);
+        (void)cudaFreeHost(h_out_r_);
+        (void)cudaFreeHost(h_ok_);
+        (void)cudaFreeHost(h_x0_);
+        (void)cudaFreeHost(h_basis_);
+        (void)cudaFree(d_out_v_);
+        (void)cudaFree(d_out_r_);
+        (void)cudaFree(d_ok_);
+        (void)cudaFree(d_x0_);
+        (void)cudaFree(d_basis_);
+        if (done_ != nullptr)
+        {
+            (void)cudaEventDestroy(done_);
+        }
+        if (stream_ != nullptr)
+        {
+            (void)cudaStreamDestroy(stream_);
+        }
+    }
+
+    CudaStmBatchBackend(const CudaStmBatchBackend&) = delete;
+    CudaStmBatchBackend& operator=(const CudaStmBatchBackend&) = delete;
+
+    [[nodiscard]] bool ready() const noexcept { return ready_; }
+
+    [[nodiscard]] const char* name() const noexcept override { return "cuda"; }
+
+    [[nodiscard]] ModelCode load_basis(Span2D<const Vec3> basis_r,
+                                       Span2D<const Vec3> basis_v) noexcept override
+    {
+        const std::size_t steps = basis_r.cols;
+        const bool has_vel = (basis_v.data != nullptr);
+        loaded_ = false;
+        pending_ = false;
+        if (basis_r.data == nullptr || basis_r.rows != 6 ||
+            (has_vel && (basis_v.rows != 6 || basis_v.cols != steps)))
+        {
+            return ModelCode::kInvalidInput;
+        }
+        if (steps > max_steps_)
+        {
+            return ModelCode::kInsufficientOutputCapacity;
+        }
+        // The staging buffer may still feed the previous tick's copy.
+        if (cudaStreamSynchronize(stream_) != cudaSuccess)
+        {
+            return ModelCode::kInvalidInput;
+        }
+        Vec3* const staged = reinterpret_cast<Vec3*>(h_basis_);
+        for (std::size_t j = 0; j < 6; ++j)
+        {
+            std::memcpy(staged + j * steps, basis_r.row(j).data, steps * sizeof(Vec3));
+            if (has_vel)
+            {
+                std::memcpy(staged + (6u + j) * steps, basis_v.row(j).data, steps * sizeof(Vec3));
+            }
+        }
+        const std::size_t bytes = (has_vel ? 12u : 6u) * steps * sizeof(Vec3);
+        if (cudaMemcpyAsync(d_basis_, h_basis_, bytes, cudaMemcpyHostToDevice, stream_) !=
+            cudaSuccess)
+        {
+            return ModelCode::kInvalidInput;
+        }
+        steps_ = steps;
+        has_vel_ = has_vel;
+        loaded_ = true;
+        return ModelCode::kOk;
+    }
+
+    [[nodiscard]] ModelCode submit(Span<const RelStateRic> x0,
+                                   Span<const bool> active,
+                                   bool want_vel) noexcept override
+    {
+        if (!loaded_ || active.size < x0.size || (want_vel && !has_vel_))
+        {
+            return ModelCode::kInvalidInput;
+        }
+        if (x0.size > max_rows_)
+        {
+            return ModelCode::kInsufficientOutputCapacity;
+        }
+        // An uncollected submission may still read the staging buffers.
+        if (pending_ && cudaStreamSynchronize(stream_) != cudaSuccess)
+        {
+            return ModelCode::kInvalidInput;
+        }
+        const std::size_t rows = x0.size;
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            const RelStateRic& x = x0[i];
+            active_[i] = active[i];
+            h_ok_[i] = (active[i] && finite_state(x)) ? 1u : 0u;
+            double* const dst = h_x0_ + 6u * i;
+            dst[0] = x.r_ric.x;
+            dst[1] = x.r_ric.y;
+            dst[2] = x.r_ric.z;
+            dst[3] = x.v_ric.x;
+            dst[4] = x.v_ric.y;
+            dst[5] = x.v_ric.z;
+        }
+        rows_ = rows;
+        want_vel_ = want_vel;
+        pending_ = false;
+        if (rows == 0 || steps_ == 0)
+        {
+            pending_ = true;
+            return ModelCode::kOk;
+        }
+
+        const std::size_t out_bytes = rows * steps_ * sizeof(Vec3);
+        const dim3 grid(static_cast<unsigned>((steps_ + kThreads - 1) / kThreads),
+                        static_cast<unsigned>(rows));
+        const bool queued =
+            cudaMemcpyAsync(d_x0_, h_x0_, rows * 6u * sizeof(double), cudaMemcpyHostToDevice,
+                            stream_) == cudaSuccess &&
+            cudaMemcpyAsync(d_ok_, h_ok_, rows, cudaMemcpyHostToDevice, stream_) == cudaSuccess;
+        if (!queued)
+        {
+            return ModelCode::kInvalidInput;
+        }
+        stm_basis_apply_kernel<<<grid, kThreads, 0, stream_>>>(
+            d_basis_, d_x0_, d_ok_, d_out_r_, d_out_v_, static_cast<unsigned>(steps_),
+            want_vel ? 1 : 0);
+        const bool done =
+            cudaGetLastError() == cudaSuccess &&
+            cudaMemcpyAsync(h_out_r_, d_out_r_, out_bytes, cudaMemcpyDeviceToHost, stream_) ==
+                cudaSuccess &&
+            (!want_vel || cudaMemcpyAsync(h_out_v_, d_out_v_, out_bytes, cudaMemcpyDeviceToHost,
+                                          stream_) == cudaSuccess) &&
+            cudaEventRecord(done_, stream_) == cudaSuccess;
+        if (!done)
+        {
+            return ModelCode::kInvalidInput;
+        }
+        pending_ = true;
+        return ModelCode::kOk;
+    }
+
+    [[nodiscard]] ModelCode collect(Span2D<Vec3> out_r,
+                                    Span2D<Vec3> out_v,
+                                    Span<bool> out_ok) noexcept override
+    {
+        if (!pending_)
+        {
+            return ModelCode::kInvalidInput;
+        }
+        if (out_r.rows < rows_ || out_r.cols < steps_ || out_ok.size < rows_ ||
+            (want_vel_ && (out_v.rows < rows_ || out_v.cols < steps_)))
+        {
+            return ModelCode::kInsufficientOutputCapacity;
+        }
+        pending_ = false;
+        if (rows_ != 0 && steps_ != 0 && cudaEventSynchronize(done_) != cudaSuccess)
+        {
+            return ModelCode::kInvalidInput;
+        }
+        const Vec3* const r = reinterpret_cast<const Vec3*>(h_out_r_);
+        const Vec3* const v = reinterpret_cast<const Vec3*>(h_out_v_);
+        for (std::size_t i = 0; i < rows_; ++i)
+        {
+            if (!active_[i])
+            {
+                continue;
+            }
+            if (h_ok_[i] != 0)
+            {
+                std::memcpy(out_r.row(i).data, r + i * steps_, steps_ * sizeof(Vec3));
+                if (want_vel_)
+                {
+                    std::memcpy(out_v.row(i).data, v + i * steps_, steps_ * sizeof(Vec3));
+                }
+            }
+            out_ok.data[i] = (h_ok_[i] != 0);
+        }
+        return ModelCode::kOk;
+    }
+
+  private:
+    std::size_t max_rows_{0};
+    std::size_t max_steps_{0};
+    int device_{0};
+    bool ready_{false};
+
+    cudaStream_t stream_{nullptr};
+    cudaEvent_t done_{nullptr};
+
+    // Device buffers.
+    double* d_basis_{nullptr};
+    double* d_x0_{nullptr};
+    unsigned char* d_ok_{nullptr};
+    double* d_out_r_{nullptr};
+    double* d_out_v_{nullptr};
+
+    // Pinned staging buffers (inputs write-combined: the host only writes them).
+    double* h_basis_{nullptr};
+    double* h_x0_{nullptr};
+    unsigned char* h_ok_{nullptr};
+    double* h_out_r_{nullptr};
+    double* h_out_v_{nullptr};
+
+    std::unique_ptr<bool[]> active_{};
+    std::size_t steps_{0};
+    std::size_t rows_{0};
+    bool loaded_{false};
+    bool has_vel_{false};
+    bool want_vel_{false};
+    bool pending_{false};
+};
+
+} // namespace
+
+std::unique_ptr<IStmBatchBackend> make_cuda_stm_batch_backend(std::size_t max_rows,
+                                                              std::size_t max_steps,
+                                                              int device) noexcept
+{
+    int count = 0;
+    if (max_rows == 0 || max_rows > kMaxGridRows || max_steps == 0 ||
+        cudaGetDeviceCount(&count) != cudaSuccess || device < 0 || device >= count)
+    {
+        return nullptr;
+    }
+    std::unique_ptr<CudaStmBatchBackend> backend(
+        new (std::nothrow) CudaStmBatchBackend(max_rows, max_steps, device));
+    if (backend == nullptr || !backend->ready())
+    {
+        return nullptr;
+    }
+    return backend;
+}
+
+} // namespace bullseye_pred
@@ -0,0 +1,1444 @@
+// tests/harness/determinism_harness.cpp
+
+/**
+ * @file determinism_harness.cpp
+ * @brief Differential runner: every optimized path against its scalar reference.
+ *
+ * @details
+ * Each check feeds the same inputs to a fast path and to the reference it must reproduce: a
+ * fixed set of edge cases (zero state, sub-millimetre and 10^4 km offsets, n near 0, tau = 0
+ * only and single-sample grids, full MAX_STEPS grids, near-parabolic and hyperbolic orbits,
+ * Stumpff arguments at the series threshold) followed by --trials randomized cases drawn from
+ * a seeded SplitMix64 stream. Every output component is compared, and each output (position,
+ * velocity, ...) reports its sample count, max absolute error, max relative error (against the
+ * larger magnitude of the pair) and max ULP distance.
+ *
+ * Contracts:
+ * - bitwise: the documented contract is bit-identical results; any differing bit pattern is a
+ *   mismatch (SoA kernel, STM cache, batched models and transforms, stumpff_CS, fleet
+ *   provider, worker-pool predictor).
+ * - tolerance: the fast path is an approximation; a sample fails when
+ *   |fast - ref| > abs_tol + rel_tol * |ref| (trig recurrence, YA closed form and
+ *   Dormand-Prince vs RK4, warm-started, incremental and elliptic Kepler solves).
+ * - report: no contract applies (a reference that ended on its iteration cap); errors are
+ *   reported but never fail the run.
+ *
+ * Usage:
+ *   bullseye_determinism_harness [--seed <n>] [--trials <n>] [--quick] [--filter <substr>]
+ *                                [--json <path|->]
+ *
+ * Exit status: 0 if every check holds its contract, 1 on any violation (or a reference that
+ * could not be evaluated), 2 on a usage or file error. See docs/determinism.md.
+ */
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/bullseye_frame.hpp"
+#include "core/bullseye_frame_math.hpp"
+#include "core/frame_transforms.hpp"
+#include "core/math/sincos_recurrence.hpp"
+#include "core/math/stumpff.hpp"
+#include "core/math/universal_kepler.hpp"
+#include "core/provider_twobody.hpp"
+#include "core/provider_twobody_fleet.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/time_grid.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "core/worker_pool.hpp"
+#include "models/hcw_soa_kernel.hpp"
+#include "models/hcw_stm.hpp"
+#include "models/hcw_stm_cache.hpp"
+#include "models/model_hcw.hpp"
+#include "models/model_ya_stm.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+// ------------------------------
+// Inputs
+// ------------------------------
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kEarthRadius = 6378.137e3;
+constexpr double kPi = 3.14159265358979323846;
+const char* const kFrame = "INERTIAL";
+
+// SplitMix64: a fixed, platform-independent stream for a given seed.
+class Rng final
+{
+  public:
+    explicit Rng(std::uint64_t seed) noexcept : s_(seed) {}
+
+    std::uint64_t next() noexcept
+    {
+        std::uint64_t z = (s_ += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // [0, 1)
+    double uniform() noexcept { return static_cast<double>(next() >> 11) * 0x1.0p-53; }
+
+    double range(double lo, double hi) noexcept { return lo + (hi - lo) * uniform(); }
+
+    // Magnitude log-uniform in [lo, hi], random sign.
+    double signed_log(double lo, double hi) noexcept
+    {
+        const double m = std::exp(range(std::log(lo), std::log(hi)));
+        return (next() & 1u) ? m : -m;
+    }
+
+    std::size_t index(std::size_t n) noexcept { return static_cast<std::size_t>(next() % n); }
+
+  private:
+    std::uint64_t s_;
+};
+
+Vec3 random_vec(Rng& rng, double lo, double hi) noexcept
+{
+    return Vec3{rng.signed_log(lo, hi), rng.signed_log(lo, hi), rng.signed_log(lo, hi)};
+}
+
+RelStateRic random_rel_state(Rng& rng) noexcept
+{
+    RelStateRic x{};
+    x.r_ric = random_vec(rng, 1e-6, 1e5);
+    x.v_ric = random_vec(rng, 1e-8, 10.0);
+    return x;
+}
+
+std::vector<RelStateRic> edge_rel_states()
+{
+    std::vector<RelStateRic> s(6);
+    s[1].r_ric = Vec3{1.0, 0.0, 0.0};
+    s[2].r_ric = Vec3{1e-9, -1e-9, 1e-9};
+    s[2].v_ric = Vec3{-1e-12, 1e-12, 0.0};
+    s[3].r_ric = Vec3{1e7, -2e7, 5e6}; // far outside the linear regime, still well defined
+    s[3].v_ric = Vec3{10.0, -20.0, 5.0};
+    s[4].r_ric = Vec3{-0.0, 0.0, -0.0};
+    s[4].v_ric = Vec3{0.0, -0.0, 0.0};
+    s[5].r_ric = Vec3{100.0, -50.0, 10.0};
+    s[5].v_ric = Vec3{0.01, -0.2, 0.005};
+    return s;
+}
+
+double mean_motion(double radius) noexcept
+{
+    return std::sqrt(kMu / (radius * radius * radius));
+}
+
+// Intervals of a full MAX_STEPS grid.
+constexpr double kFullIntervals = static_cast<double>(MAX_STEPS - 1u);
+
+// Grids: tau = 0 only, one step, short / full uniform at several cadences, piecewise.
+std::vector<TimeGrid> edge_grids()
+{
+    std::vector<TimeGrid> g;
+    g.push_back(make_time_grid(0.0, 1.0));
+    g.push_back(make_time_grid(1.0, 1.0));
+    g.push_back(make_time_grid(kFullIntervals, 1.0));
+    g.push_back(make_time_grid(10.0 * kFullIntervals, 10.0));
+    g.push_back(make_time_grid(0.05 * kFullIntervals, 0.05));
+    const TimeGridSegment seg[] = {{60.0, 0.5}, {600.0, 5.0}, {5400.0, 30.0}};
+    g.push_back(make_piecewise_time_grid(seg, 3));
+    return g;
+}
+
+TimeGrid random_grid(Rng& rng)
+{
+    const double cadence = std::exp(rng.range(std::log(0.01), std::log(60.0)));
+    const auto steps = 1 + rng.index(MAX_STEPS);
+    return make_time_grid(cadence * static_cast<double>(steps - 1), cadence);
+}
+
+// Chief on a bound orbit: perigee radius, eccentricity, true anomaly and inclination.
+ChiefState chief_on_orbit(double rp, double e, double f, double inc) noexcept
+{
+    const double p = rp * (1.0 + e);
+    const double r = p / (1.0 + e * std::cos(f));
+    const double vs = std::sqrt(kMu / p);
+    const Vec3 r_pf{r * std::cos(f), r * std::sin(f), 0.0};
+    const Vec3 v_pf{-vs * std::sin(f), vs * (e + std::cos(f)), 0.0};
+    ChiefState c{};
+    c.r_i = Vec3{r_pf.x, r_pf.y * std::cos(inc), r_pf.y * std::sin(inc)};
+    c.v_i = Vec3{v_pf.x, v_pf.y * std::cos(inc), v_pf.y * std::sin(inc)};
+    c.frame_id = kFrame;
+    return c;
+}
+
+// ------------------------------
+// Comparison
+// ------------------------------
+
+enum class ContractKind : std::uint8_t
+{
+    kBitwise = 0, ///< Bit-identical results required.
+    kTolerance,   ///< |fast - ref| <= abs_tol + rel_tol * |ref| required.
+    kReport,      ///< No contract applies (e.g. the reference hit its iteration cap); report only.
+};
+
+struct Contract final
+{
+    ContractKind kind{ContractKind::kBitwise};
+    double abs_tol{0.0};
+    double rel_tol{0.0};
+};
+
+constexpr Contract kBitwise{};
+constexpr Contract kReportOnly{ContractKind::kReport, 0.0, 0.0};
+
+constexpr Contract tolerance(double abs_tol, double rel_tol) noexcept
+{
+    return Contract{ContractKind::kTolerance, abs_tol, rel_tol};
+}
+
+const char* contract_name(ContractKind kind) noexcept
+{
+    switch (kind)
+    {
+    case ContractKind::kTolerance:
+        return "tolerance";
+    case ContractKind::kReport:
+        return "report";
+    case ContractKind::kBitwise:
+        break;
+    }
+    return "bitwise";
+}
+
+// Monotonic integer image of a double: adjacent doubles differ by 1 (+0 and -0 coincide).
+std::uint64_t ordered_bits(double x) noexcept
+{
+    std::uint64_t b = 0;
+    std::memcpy(&b, &x, sizeof(b));
+    constexpr std::uint64_t kSign = std::uint64_t{1} << 63;
+    return (b & kSign) ? kSign - (b & ~kSign) : kSign + b;
+}
+
+// Error statistics of one output of one check.
+struct OutputStats final
+{
+    std::string check;
+    std::string output;
+    Contract contract{};
+    std::uint64_t samples{0};
+    std::uint64_t violations{0};
+    std::uint64_t setup_failures{0};
+    double max_abs{0.0};
+    double max_rel{0.0};
+    std::uint64_t max_ulp{0};
+
+    [[nodiscard]] bool passed() const noexcept
+    {
+        return violations == 0 && setup_failures == 0;
+    }
+
+    void compare(double got, double ref) noexcept
+    {
+        ++samples;
+        const bool got_nan = std::isnan(got);
+        const bool ref_nan = std::isnan(ref);
+        if (got_nan || ref_nan)
+        {
+            const bool bitwise = contract.kind == ContractKind::kBitwise;
+            const bool ok = (got_nan == ref_nan) &&
+                            (!bitwise || std::memcmp(&got, &ref, sizeof(double)) == 0);
+            max_ulp = (got_nan != ref_nan) ? std::numeric_limits<std::uint64_t>::max() : max_ulp;
+            violations += (ok || contract.kind == ContractKind::kReport) ? 0u : 1u;
+            return;
+        }
+
+        const double abs_err = std::fabs(got - ref);
+        const double mag = std::max(std::fabs(got), std::fabs(ref));
+        const std::uint64_t a = ordered_bits(got);
+        const std::uint64_t b = ordered_bits(ref);
+        max_abs = std::max(max_abs, abs_err);
+        max_rel = std::max(max_rel, (mag > 0.0) ? abs_err / mag : 0.0);
+        max_ulp = std::max(max_ulp, (a > b) ? a - b : b - a);
+
+        bool ok = true;
+        switch (contract.kind)
+        {
+        case ContractKind::kBitwise:
+            ok = std::memcmp(&got, &ref, sizeof(double)) == 0;
+            break;
+        case ContractKind::kTolerance:
+            ok = abs_err <= contract.abs_tol + contract.rel_tol * std::fabs(ref);
+            break;
+        case ContractKind::kReport:
+            break;
+        }
+        violations += ok ? 0u : 1u;
+    }
+
+    void compare(const Vec3& got, const Vec3& ref) noexcept
+    {
+        compare(got.x, ref.x);
+        compare(got.y, ref.y);
+        compare(got.z, ref.z);
+    }
+
+    void compare(const Vec3* got, const Vec3* ref, std::size_t n) noexcept
+    {
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            compare(got[k], ref[k]);
+        }
+    }
+
+    // Both sides compared after dividing by a case scale (errors reported in those units).
+    void compare_scaled(const Vec3* got, const Vec3* ref, std::size_t n, double scale) noexcept
+    {
+        const double inv = 1.0 / scale;
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            compare(inv * got[k], inv * ref[k]);
+        }
+    }
+
+    // The fast path or the reference failed on inputs both must accept, or they disagreed on
+    // a status code.
+    void setup_failure() noexcept { ++setup_failures; }
+};
+
+class Report final
+{
+  public:
+    explicit Report(const char* filter) noexcept : filter_(filter) {}
+
+    [[nodiscard]] bool selected(const char* check) const noexcept
+    {
+        return filter_ == nullptr || std::strstr(check, filter_) != nullptr;
+    }
+
+    // New output of a check; the reference stays valid for the lifetime of the report.
+    OutputStats& add(const char* check, const char* output, const Contract& contract)
+    {
+        auto s = std::make_unique<OutputStats>();
+        s->check = check;
+        s->output = output;
+        s->contract = contract;
+        outputs_.push_back(std::move(s));
+        return *outputs_.back();
+    }
+
+    [[nodiscard]] const std::vector<std::unique_ptr<OutputStats>>& outputs() const noexcept
+    {
+        return outputs_;
+    }
+
+    [[nodiscard]] bool passed() const noexcept
+    {
+        return std::all_of(outputs_.begin(), outputs_.end(),
+                           [](const std::unique_ptr<OutputStats>& s) { return s->passed(); });
+    }
+
+  private:
+    const char* filter_{nullptr};
+    std::vector<std::unique_ptr<OutputStats>> outputs_;
+};
+
+struct Options final
+{
+    std::uint64_t seed{20240601};
+    std::size_t trials{200};
+    const char* filter{nullptr};
+    const char* json_path{nullptr};
+};
+
+// ------------------------------
+// HCW
+// ------------------------------
+
+void check_hcw_soa_kernel(const Options& opt, Report& rep)
+{
+    const char* name = "hcw.soa_kernel";
+    if (!rep.selected(name))
+    {
+        return;
+    }
+    OutputStats& out_r = rep.add(name, "r", kBitwise);
+    OutputStats& out_v = rep.add(name, "v", kBitwise);
+    OutputStats& range_r = rep.add(name, "range.r", kBitwise);
+    OutputStats& range_v = rep.add(name, "range.v", kBitwise);
+
+    const auto stm = std::make_unique<HcwStmSoa>();
+    std::vector<Vec3> r_fast(MAX_STEPS), v_fast(MAX_STEPS), r_ref(MAX_STEPS), v_ref(MAX_STEPS);
+    Rng rng(opt.seed ^ 0x01);
+    auto run = [&](double n, const TimeGrid& grid, const RelStateRic& x0)
+    {
+        const std::size_t steps = grid.tau.size();
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            stm->set(k, hcw_stm_at(n, 1.0 / n, grid.tau[k]));
+        }
+        hcw_soa_apply(*stm, steps, x0, r_fast.data(), v_fast.data());
+        hcw_soa_apply_scalar(*stm, steps, x0, r_ref.data(), v_ref.data());
+        out_r.compare(r_fast.data(), r_ref.data(), steps);
+        out_v.compare(v_fast.data(), v_ref.data(), steps);
+
+        // A sub-range writes exactly those entries of the full call; the rest stays poisoned.
+        const std::size_t begin = rng.index(steps + 1);
+        const std::size_t end = begin + rng.index(steps - begin + 1);
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        std::fill(r_fast.begin(), r_fast.end(), Vec3{nan, nan, nan});
+        std::fill(v_fast.begin(), v_fast.end(), Vec3{nan, nan, nan});
+        hcw_soa_apply_range(*stm, begin, end, x0, r_fast.data(), v_fast.data());
+        range_r.compare(r_fast.data() + begin, r_ref.data() + begin, end - begin);
+        range_v.compare(v_fast.data() + begin, v_ref.data() + begin, end - begin);
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            if ((k < begin || k >= end) && !(std::isnan(r_fast[k].x) && std::isnan(v_fast[k].x)))
+            {
+                range_r.setup_failure();
+            }
+        }
+    };
+
+    for (const double n : {1e-9, mean_motion(kEarthRadius + 400e3), mean_motion(42164e3), 1e-2})
+    {
+        for (const TimeGrid& g : edge_grids())
+        {
+            for (const RelStateRic& x0 : edge_rel_states())
+            {
+                if (g.tau.size() <= MAX_STEPS)
+                {
+                    run(n, g, x0);
+                }
+            }
+        }
+    }
+    for (std::size_t t = 0; t < opt.trials; ++t)
+    {
+        const double n = mean_motion(rng.range(kEarthRadius + 200e3, 50000e3));
+        const TimeGrid g = random_grid(rng);
+        run(n, g, random_rel_state(rng));
+    }
+}
+
+// STM cache (n_rel_tol = 0), predict_tail and predict_hcw_batch against ModelHCW::predict_hcw.
+void check_hcw_models(const Options& opt, Report& rep)
+{
+    const bool cache_on = rep.selected("hcw.stm_cache");
+    const bool batch_on = rep.selected("hcw.batch");
+    if (!cache_on && !batch_on)
+    {
+        return;
+    }
+    OutputStats* cache_r = cache_on ? &rep.add("hcw.stm_cache", "r", kBitwise) : nullptr;
+    OutputStats* cache_v = cache_on ? &rep.add("hcw.stm_cache", "v", kBitwise) : nullptr;
+    OutputStats* tail_r = cache_on ? &rep.add("hcw.stm_cache", "tail.r", kBitwise) : nullptr;
+    OutputStats* tail_v = cache_on ? &rep.add("hcw.stm_cache", "tail.v", kBitwise) : nullptr;
+    OutputStats* batch_r = batch_on ? &rep.add("hcw.batch", "r", kBitwise) : nullptr;
+    OutputStats* batch_v = batch_on ? &rep.add("hcw.batch", "v", kBitwise) : nullptr;
+
+    constexpr std::size_t kRows = 6;
+    const ModelHCW hcw;
+    const auto cache = std::make_unique<HcwStmCache>(0.0);
+    std::vector<Vec3> r_ref(kRows * MAX_STEPS), v_ref(kRows * MAX_STEPS);
+    std::vector<Vec3> r_fast(kRows * MAX_STEPS), v_fast(kRows * MAX_STEPS);
+    std::vector<ModelCode> codes(kRows);
+    Rng rng(opt.seed ^ 0x02);
+
+    auto run = [&](const HcwParams& p, const TimeGrid& grid, const RelStateRic* x0)
+    {
+        const std::size_t steps = grid.tau.size();
+        for (std::size_t i = 0; i < kRows; ++i)
+        {
+            const auto res = hcw.predict_hcw(x0[i], p, grid,
+                                             Span<Vec3>{&r_ref[i * MAX_STEPS], steps},
+                                             Span<Vec3>{&v_ref[i * MAX_STEPS], steps});
+            if (res.code != ModelCode::kOk)
+            {
+                (cache_on ? cache_r : batch_r)->setup_failure();
+                return;
+            }
+        }
+
+        if (cache_on)
+        {
+            if (cache->refresh(p, grid) != ModelCode::kOk)
+            {
+                cache_r->setup_failure();
+                return;
+            }
+            const std::size_t first = rng.index(steps + 1);
+            for (std::size_t i = 0; i < kRows; ++i)
+            {
+                const Vec3* ref_r = &r_ref[i * MAX_STEPS];
+                const Vec3* ref_v = &v_ref[i * MAX_STEPS];
+                const Span<Vec3> fr{r_fast.data(), steps};
+                const Span<Vec3> fv{v_fast.data(), steps};
+                if (cache->predict(x0[i], fr, fv).code != ModelCode::kOk)
+                {
+                    cache_r->setup_failure();
+                    continue;
+                }
+                cache_r->compare(fr.data, ref_r, steps);
+                cache_v->compare(fv.data, ref_v, steps);
+                if (cache->predict_tail(x0[i], first, fr, fv).code != ModelCode::kOk)
+                {
+                    tail_r->setup_failure();
+                    continue;
+                }
+                tail_r->compare(fr.data + first, ref_r + first, steps - first);
+                tail_v->compare(fv.data + first, ref_v + first, steps - first);
+            }
+        }
+
+        if (batch_on)
+        {
+            const auto res =
+                hcw.predict_hcw_batch(Span<const RelStateRic>{x0, kRows}, p, grid,
+                                      Span2D<Vec3>{r_fast.data(), kRows, steps, MAX_STEPS},
+                                      Span2D<Vec3>{v_fast.data(), kRows, steps, MAX_STEPS},
+                                      Span<ModelCode>{codes.data(), kRows});
+            if (res.code != ModelCode::kOk)
+            {
+                batch_r->setup_failure();
+                return;
+            }
+            for (std::size_t i = 0; i < kRows; ++i)
+            {
+                batch_r->compare(&r_fast[i * MAX_STEPS], &r_ref[i * MAX_STEPS], steps);
+                batch_v->compare(&v_fast[i * MAX_STEPS], &v_ref[i * MAX_STEPS], steps);
+            }
+        }
+    };
+
+    const std::vector<RelStateRic> edges = edge_rel_states();
+    for (const double n : {1e-9, mean_motion(kEarthRadius + 400e3), 1e-2})
+    {
+        for (const TimeGrid& g : edge_grids())
+        {
+            for (const std::uint32_t reanchor : {0u, 1u, 16u})
+            {
+                HcwParams p{};
+                p.n_radps = n;
+                p.trig_reanchor_interval = reanchor;
+                if (g.tau.size() <= MAX_STEPS)
+                {
+                    run(p, g, edges.data());
+                }
+            }
+        }
+    }
+    RelStateRic x0[kRows];
+    for (std::size_t t = 0; t < opt.trials; ++t)
+    {
+        HcwParams p{};
+        p.n_radps = mean_motion(rng.range(kEarthRadius + 200e3, 50000e3));
+        p.trig_reanchor_interval = static_cast<std::uint32_t>(rng.index(2) * (1 + rng.index(128)));
+        for (RelStateRic& x : x0)
+        {
+            x = random_rel_state(rng);
+        }
+        const TimeGrid g = random_grid(rng);
+        run(p, g, x0);
+    }
+}
+
+// UniformSinCos against libm, and HCW trajectories with the recurrence against libm ones.
+void check_trig_recurrence(const Options& opt, Report& rep)
+{
+    Rng rng(opt.seed ^ 0x03);
+    if (rep.selected("trig.uniform_sincos"))
+    {
+        const std::size_t intervals[] = {1, 2, 8, 64, 256, MAX_STEPS};
+        for (const std::size_t interval : intervals)
+        {
+            char label[32];
+            std::snprintf(label, sizeof(label), "sin_cos.N%zu", interval);
+            const double bound = math::sincos_recurrence_error_bound(interval);
+            OutputStats& s = rep.add("trig.uniform_sincos", label, tolerance(bound, 0.0));
+            for (std::size_t c = 0; c < 8 + opt.trials / 8; ++c)
+            {
+                // Angles as an HCW grid produces them: k * n * cadence, up to 2 rad.
+                const double dtheta = (c == 0) ? 0.0 : rng.range(1e-7, 2.0 / MAX_STEPS);
+                math::UniformSinCos sc(dtheta, interval);
+                for (std::size_t k = 0; k < MAX_STEPS; ++k)
+                {
+                    const double theta = static_cast<double>(k) * dtheta;
+                    sc.next(theta);
+                    s.compare(sc.sin(), std::sin(theta));
+                    s.compare(sc.cos(), std::cos(theta));
+                }
+            }
+        }
+    }
+
+    if (rep.selected("hcw.trig_recurrence"))
+    {
+        // Each HCW entry combines sin/cos with coefficients of at most (4 + 3 n tau) times the
+        // state scale |r0| + |v0| / n (times n for velocities). Errors are reported in units
+        // of that scale, against 8x the trig bound.
+        const ModelHCW hcw;
+        std::vector<Vec3> r_fast(MAX_STEPS), v_fast(MAX_STEPS), r_ref(MAX_STEPS), v_ref(MAX_STEPS);
+        for (const std::uint32_t interval : {8u, 64u})
+        {
+            const double tol = 8.0 * math::sincos_recurrence_error_bound(interval);
+            char label[32];
+            std::snprintf(label, sizeof(label), "r_scaled.N%u", interval);
+            OutputStats& sr = rep.add("hcw.trig_recurrence", label, tolerance(tol, 0.0));
+            std::snprintf(label, sizeof(label), "v_scaled.N%u", interval);
+            OutputStats& sv = rep.add("hcw.trig_recurrence", label, tolerance(tol, 0.0));
+            for (std::size_t t = 0; t < 8 + opt.trials / 4; ++t)
+            {
+                HcwParams p{};
+                p.n_radps = mean_motion(rng.range(kEarthRadius + 200e3, 50000e3));
+                const double n = p.n_radps;
+                const double cadence = rng.range(0.05, 2.0 / (n * MAX_STEPS));
+                const TimeGrid g = make_time_grid(cadence * (MAX_STEPS - 1), cadence);
+                const std::size_t steps = g.tau.size();
+                const RelStateRic x0 = random_rel_state(rng);
+                const bool ref_ok = hcw.predict_hcw(x0, p, g, Span<Vec3>{r_ref.data(), steps},
+                                                    Span<Vec3>{v_ref.data(), steps})
+                                        .code == ModelCode::kOk;
+                p.trig_reanchor_interval = interval;
+                const bool fast_ok = hcw.predict_hcw(x0, p, g, Span<Vec3>{r_fast.data(), steps},
+                                                     Span<Vec3>{v_fast.data(), steps})
+                                         .code == ModelCode::kOk;
+                if (!ref_ok || !fast_ok)
+                {
+                    sr.setup_failure();
+                    continue;
+                }
+                const double scale =
+                    (norm(x0.r_ric) + norm(x0.v_ric) / n) * (4.0 + 3.0 * n * g.tau[steps - 1]);
+                sr.compare_scaled(r_fast.data(), r_ref.data(), steps, scale);
+                sv.compare_scaled(v_fast.data(), v_ref.data(), steps, scale * n);
+            }
+        }
+    }
+}
+
+// ------------------------------
+// Two-body math and providers
+// ------------------------------
+
+void check_stumpff(const Options& opt, Report& rep)
+{
+    if (!rep.selected("math.stumpff_cs"))
+    {
+        return;
+    }
+    OutputStats& sc = rep.add("math.stumpff_cs", "C", kBitwise);
+    OutputStats& ss = rep.add("math.stumpff_cs", "S", kBitwise);
+    auto run = [&](double z)
+    {
+        const math::StumpffCS cs = math::stumpff_CS(z);
+        sc.compare(cs.C, math::stumpff_C(z));
+        ss.compare(cs.S, math::stumpff_S(z));
+    };
+
+    // Series threshold from both sides, zero, whole turns and cosh overflow.
+    const double th = math::kStumpffSeriesThreshold;
+    const double turn = 4.0 * kPi * kPi;
+    for (const double z : {0.0, -0.0, th, -th, std::nextafter(th, 0.0), std::nextafter(-th, 0.0),
+                           std::nextafter(th, 1.0), std::nextafter(-th, -1.0), 1e-300, -1e-300,
+                           turn, 4.0 * turn, 100.0 * turn, -1.0, -1e3, -5.0e5, -1e6})
+    {
+        run(z);
+    }
+    Rng rng(opt.seed ^ 0x04);
+    for (std::size_t t = 0; t < 50 * opt.trials; ++t)
+    {
+        run(rng.signed_log(1e-12, 4000.0));
+    }
+}
+
+// Universal-variable solve warm-started from a nearby arc (as the incremental chief provider
+// does) against the cold starter. Both stop on the same step tolerance, so pairs whose
+// references converged agree to a few ulp of the state scale. A reference that ends on its
+// iteration cap has no contract: near-parabolic arcs stall a few ulp above the step tolerance,
+// and the cold starter can cycle on multi-revolution arcs of highly eccentric orbits. Those
+// pairs are reported as separate outputs only.
+void check_kepler_warm_start(const Options& opt, Report& rep)
+{
+    if (!rep.selected("kepler.warm_start"))
+    {
+        return;
+    }
+    const Contract tight = tolerance(1e-12, 0.0);
+    OutputStats& sr = rep.add("kepler.warm_start", "r_scaled", tight);
+    OutputStats& sv = rep.add("kepler.warm_start", "v_scaled", tight);
+    OutputStats& cap_r = rep.add("kepler.warm_start", "capped.r_scaled", kReportOnly);
+    OutputStats& cap_v = rep.add("kepler.warm_start", "capped.v_scaled", kReportOnly);
+    // The cold starter is poor on long eccentric arcs: give the references ample iterations.
+    constexpr int kRefIters = 1000;
+    constexpr int kIters = 64;
+    const double sqrt_mu = std::sqrt(kMu);
+
+    auto run = [&](const Vec3& r0, const Vec3& v0, double dt, double lead)
+    {
+        const double r0n = norm(r0);
+        const double alpha = 2.0 / r0n - dot(v0, v0) / kMu;
+        math::UniversalPropagation cold{};
+        math::UniversalPropagation prev{};
+        math::UniversalPropagation warm{};
+        const bool cold_ok = math::universal_propagate(
+            r0, v0, kMu, dt, math::universal_initial_guess(alpha, sqrt_mu, r0n, dt), kRefIters,
+            cold);
+        const double dt_prev = dt - lead;
+        const bool prev_ok = math::universal_propagate(
+            r0, v0, kMu, dt_prev, math::universal_initial_guess(alpha, sqrt_mu, r0n, dt_prev),
+            kRefIters, prev);
+        if (!cold_ok || !prev_ok)
+        {
+            sr.setup_failure();
+            return;
+        }
+        const double chi0 = prev.chi + sqrt_mu * lead / norm(prev.r_i);
+        if (!math::universal_propagate(r0, v0, kMu, dt, chi0, kIters, warm))
+        {
+            sr.setup_failure();
+            return;
+        }
+        const double r_scale = std::max(r0n, norm(cold.r_i));
+        const double v_scale = std::max(norm(v0), norm(cold.v_i));
+        const bool capped = !cold.converged || !prev.converged;
+        (capped ? cap_r : sr).compare_scaled(&warm.r_i, &cold.r_i, 1, r_scale);
+        (capped ? cap_v : sv).compare_scaled(&warm.v_i, &cold.v_i, 1, v_scale);
+    };
+
+    const Vec3 r0{kEarthRadius + 500e3, 0.0, 0.0};
+    const double v_circ = std::sqrt(kMu / r0.x);
+    const double v_esc = std::sqrt(2.0) * v_circ;
+    // Circular, eccentric, near-parabolic both sides, hyperbolic; zero and negative dt.
+    for (const double v : {v_circ, 1.3 * v_circ, v_esc * (1.0 - 1e-9), v_esc * (1.0 + 1e-9),
+                           2.0 * v_circ})
+    {
+        for (const double dt : {0.0, 1.0, -60.0, 600.0, 5400.0})
+        {
+            run(r0, Vec3{0.0, v * std::cos(0.3), v * std::sin(0.3)}, dt, 1.0);
+        }
+    }
+    Rng rng(opt.seed ^ 0x05);
+    for (std::size_t t = 0; t < 4 * opt.trials; ++t)
+    {
+        const double e = rng.range(0.0, 0.9);
+        const ChiefState c0 = chief_on_orbit(rng.range(kEarthRadius + 200e3, 42164e3), e,
+                                             rng.range(-kPi, kPi), rng.range(0.0, kPi));
+        const double a = norm(c0.r_i) / (2.0 - norm(c0.r_i) * dot(c0.v_i, c0.v_i) / kMu);
+        const double period = 2.0 * kPi * std::sqrt(a * a * a / kMu);
+        run(c0.r_i, c0.v_i, rng.range(-2.0, 2.0) * period, rng.range(0.01, 60.0));
+    }
+}
+
+// Incremental chief provider (warm-started short arcs, periodic re-anchor) against cold
+// epoch-referenced solves over a run of ticks.
+void check_twobody_incremental(const Options& opt, Report& rep)
+{
+    if (!rep.selected("provider.twobody_incremental"))
+    {
+        return;
+    }
+    const Contract c = tolerance(1e-12, 0.0);
+    OutputStats& sr = rep.add("provider.twobody_incremental", "r_scaled", c);
+    OutputStats& sv = rep.add("provider.twobody_incremental", "v_scaled", c);
+    Rng rng(opt.seed ^ 0x06);
+    const std::size_t orbits = 4 + opt.trials / 25;
+    for (std::size_t o = 0; o < orbits; ++o)
+    {
+        const double e = (o == 0) ? 0.0 : rng.range(0.0, 0.8);
+        const ChiefState c0 = chief_on_orbit(rng.range(kEarthRadius + 200e3, 42164e3), e,
+                                             rng.range(-kPi, kPi), rng.range(0.0, kPi));
+        TwoBodyChiefProvider cold(kFrame, kMu, 0.0, c0.r_i, c0.v_i);
+        TwoBodyChiefProvider inc(kFrame, kMu, 0.0, c0.r_i, c0.v_i);
+        TwoBodyIncrementalConfig cfg{};
+        cfg.enabled = true;
+        cfg.reanchor_interval = static_cast<std::uint32_t>(1 + rng.index(128));
+        (void)inc.configure_incremental(cfg);
+
+        // Monotonic ticks with an occasional backwards jump (re-anchor from the epoch).
+        double t = 0.0;
+        for (std::size_t k = 0; k < 400; ++k)
+        {
+            t = (rng.index(50) == 0) ? rng.range(0.0, t) : t + rng.range(0.1, 30.0);
+            const ChiefState a = inc.get(t);
+            const ChiefState b = cold.get(t);
+            if (a.status.code != ProviderCode::kOk || b.status.code != ProviderCode::kOk)
+            {
+                sr.setup_failure();
+                continue;
+            }
+            sr.compare_scaled(&a.r_i, &b.r_i, 1, norm(b.r_i));
+            sv.compare_scaled(&a.v_i, &b.v_i, 1, norm(b.v_i));
+        }
+    }
+}
+
+// Elliptic fast path (cached elements, eccentric-anomaly Kepler solve) against a converged
+// universal-variable solve over +-2 periods. As in kepler.warm_start, references that end on
+// their iteration cap are reported only. The provider's own universal path (kKeplerIters) is
+// not the reference: on long eccentric arcs it stops on its cap far from the solution, which
+// is what the fast path avoids.
+void check_twobody_elliptic(const Options& opt, Report& rep)
+{
+    if (!rep.selected("provider.twobody_elliptic"))
+    {
+        return;
+    }
+    const Contract c = tolerance(1e-12, 0.0);
+    OutputStats& sr = rep.add("provider.twobody_elliptic", "r_scaled", c);
+    OutputStats& sv = rep.add("provider.twobody_elliptic", "v_scaled", c);
+    OutputStats& cap_r = rep.add("provider.twobody_elliptic", "capped.r_scaled", kReportOnly);
+    OutputStats& cap_v = rep.add("provider.twobody_elliptic", "capped.v_scaled", kReportOnly);
+    constexpr int kRefIters = 1000;
+    const double sqrt_mu = std::sqrt(kMu);
+    Rng rng(opt.seed ^ 0x0A);
+    const std::size_t orbits = 8 + opt.trials / 10;
+    for (std::size_t o = 0; o < orbits; ++o)
+    {
+        const double e = (o == 0) ? 0.0 : rng.range(0.0, 0.9);
+        const ChiefState c0 = chief_on_orbit(rng.range(kEarthRadius + 200e3, 42164e3), e,
+                                             rng.range(-kPi, kPi), rng.range(0.0, kPi));
+        TwoBodyChiefProvider fast(kFrame, kMu, 0.0, c0.r_i, c0.v_i);
+        if (!fast.elliptic_fast_path())
+        {
+            sr.setup_failure();
+            continue;
+        }
+        const double r0n = norm(c0.r_i);
+        const double alpha = 2.0 / r0n - dot(c0.v_i, c0.v_i) / kMu;
+        const double period = 2.0 * kPi / (sqrt_mu * alpha * std::sqrt(alpha));
+        for (std::size_t k = 0; k < 100; ++k)
+        {
+            const double t = (k == 0) ? 0.0 : rng.range(-2.0, 2.0) * period;
+            const ChiefState x = fast.get(t);
+            math::UniversalPropagation ref{};
+            if (x.status.code != ProviderCode::kOk ||
+                !math::universal_propagate(c0.r_i, c0.v_i, kMu, t,
+                                           math::universal_initial_guess(alpha, sqrt_mu, r0n, t),
+                                           kRefIters, ref))
+            {
+                sr.setup_failure();
+                continue;
+            }
+            const double r_scale = std::max(r0n, norm(ref.r_i));
+            const double v_scale = std::max(norm(c0.v_i), norm(ref.v_i));
+            (ref.converged ? sr : cap_r).compare_scaled(&x.r_i, &ref.r_i, 1, r_scale);
+            (ref.converged ? sv : cap_v).compare_scaled(&x.v_i, &ref.v_i, 1, v_scale);
+        }
+    }
+}
+
+// Batched fleet provider against one TwoBodyChiefProvider per vehicle.
+void check_twobody_fleet(const Options& opt, Report& rep)
+{
+    if (!rep.selected("provider.twobody_fleet"))
+    {
+        return;
+    }
+    OutputStats& sr = rep.add("provider.twobody_fleet", "r", kBitwise);
+    OutputStats& sv = rep.add("provider.twobody_fleet", "v", kBitwise);
+    Rng rng(opt.seed ^ 0x07);
+
+    constexpr std::size_t kVehicles = TwoBodyVehicleProvider::kCapacity;
+    TwoBodyVehicleProvider fleet(kFrame, kMu);
+    std::vector<std::unique_ptr<TwoBodyChiefProvider>> refs;
+    std::vector<VehicleIndexMap::VehicleId> ids;
+    for (std::size_t i = 0; i < kVehicles; ++i)
+    {
+        // Mostly bound orbits, a few near-parabolic and hyperbolic ones.
+        const double e = (i % 10 == 9) ? rng.range(0.999, 1.5) : rng.range(0.0, 0.9);
+        const ChiefState c0 = chief_on_orbit(rng.range(kEarthRadius + 200e3, 42164e3),
+                                             std::min(e, 0.9999), rng.range(-kPi, kPi),
+                                             rng.range(0.0, kPi));
+        const Vec3 v0 = (e > 1.0) ? e * c0.v_i : c0.v_i;
+        const double t_epoch = rng.range(-1000.0, 1000.0);
+        const auto id = static_cast<VehicleIndexMap::VehicleId>(100 + 7 * i);
+        if (!fleet.add_vehicle(id, t_epoch, c0.r_i, v0))
+        {
+            sr.setup_failure();
+            continue;
+        }
+        refs.push_back(std::make_unique<TwoBodyChiefProvider>(kFrame, kMu, t_epoch, c0.r_i, v0));
+        refs.back()->set_elliptic_fast_path(false); // the fleet matches the universal path
+        ids.push_back(id);
+    }
+
+    std::vector<VehicleState> out(ids.size());
+    for (std::size_t t = 0; t < 1 + opt.trials / 4; ++t)
+    {
+        const double t0 = (t == 0) ? 0.0 : rng.range(-7200.0, 7200.0);
+        const ProviderCode code =
+            fleet.get_many(Span<const VehicleIndexMap::VehicleId>{ids.data(), ids.size()}, t0,
+                           Span<VehicleState>{out.data(), out.size()}, Span<Vec3>{},
+                           Span<Vec3>{});
+        (void)code; // per-vehicle codes are compared below
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            const ChiefState ref = refs[i]->get(t0);
+            if (out[i].status.code != ref.status.code)
+            {
+                sr.setup_failure();
+                continue;
+            }
+            if (ref.status.code == ProviderCode::kOk)
+            {
+                sr.compare(out[i].r_i, ref.r_i);
+                sv.compare(out[i].v_i, ref.v_i);
+            }
+        }
+    }
+}
+
+// ------------------------------
+// Frame transforms
+// ------------------------------
+
+void check_transforms(const Options& opt, Report& rep)
+{
+    Rng rng(opt.seed ^ 0x08);
+    const std::size_t snapshots = 8 + opt.trials / 4;
+
+    if (rep.selected("transform.inertial_to_ric_batch"))
+    {
+        OutputStats& sr = rep.add("transform.inertial_to_ric_batch", "r", kBitwise);
+        OutputStats& sv = rep.add("transform.inertial_to_ric_batch", "v", kBitwise);
+        std::vector<Vec3> vr(MAX_VEHICLES), vv(MAX_VEHICLES);
+        std::vector<RelStateRic> rel(MAX_VEHICLES);
+        for (std::size_t s = 0; s < snapshots; ++s)
+        {
+            const ChiefState c = chief_on_orbit(rng.range(kEarthRadius + 200e3, 42164e3),
+                                                rng.range(0.0, 0.8), rng.range(-kPi, kPi),
+                                                rng.range(0.0, kPi));
+            const ConstructedRicFrame f = construct_ric_from_chief(c);
+            const Mat3 C_i2r = transpose(f.C_from_ric_to_inertial);
+            const std::size_t n = (s == 0) ? 0 : 1 + rng.index(MAX_VEHICLES);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                // Co-located, metre-scale and 10^4 km separations.
+                const double reach = (i % 3 == 0) ? 0.0 : ((i % 3 == 1) ? 1e3 : 1e7);
+                vr[i] = c.r_i + ((reach > 0.0) ? random_vec(rng, 1e-3, reach) : Vec3{});
+                vv[i] = c.v_i + ((reach > 0.0) ? random_vec(rng, 1e-6, 1e-3 * reach) : Vec3{});
+            }
+            inertial_to_ric_relative_batch(Span<const Vec3>{vr.data(), n},
+                                           Span<const Vec3>{vv.data(), n}, c.r_i, c.v_i, C_i2r,
+                                           f.omega_ric, Span<RelStateRic>{rel.data(), n});
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const RelState ref =
+                    inertial_to_ric_relative(vr[i], vv[i], c.r_i, c.v_i, C_i2r, f.omega_ric);
+                sr.compare(rel[i].r_ric, ref.r);
+                sv.compare(rel[i].v_ric, ref.v);
+            }
+        }
+    }
+
+    if (rep.selected("transform.ric_to_inertial_series"))
+    {
+        OutputStats& sr = rep.add("transform.ric_to_inertial_series", "r", kBitwise);
+        std::vector<Vec3> rel(MAX_STEPS), chief_r(MAX_STEPS), chief_v(MAX_STEPS), out(MAX_STEPS);
+        std::vector<Mat3> C(MAX_STEPS);
+        std::vector<Vec3> omega(MAX_STEPS);
+        for (std::size_t s = 0; s < snapshots; ++s)
+        {
+            const std::size_t n = (s == 0) ? 0 : 1 + rng.index(MAX_STEPS);
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                const ChiefState c = chief_on_orbit(rng.range(kEarthRadius + 200e3, 42164e3),
+                                                    rng.range(0.0, 0.8), rng.range(-kPi, kPi),
+                                                    rng.range(0.0, kPi));
+                const ConstructedRicFrame f = construct_ric_from_chief(c);
+                rel[k] = random_vec(rng, 1e-6, 1e7);
+                chief_r[k] = c.r_i;
+                chief_v[k] = c.v_i;
+                C[k] = f.C_from_ric_to_inertial;
+                omega[k] = f.omega_ric;
+            }
+            ric_to_inertial_positions_series(Span<const Vec3>{rel.data(), n},
+                                             Span<const Vec3>{chief_r.data(), n},
+                                             Span<const Mat3>{C.data(), n},
+                                             Span<Vec3>{out.data(), n});
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                const RelState ref = ric_to_inertial_relative(rel[k], Vec3{}, chief_r[k],
+                                                              chief_v[k], C[k], omega[k]);
+                sr.compare(out[k], ref.r);
+            }
+        }
+    }
+}
+
+// ------------------------------
+// YA / TH
+// ------------------------------
+
+struct YaCase final
+{
+    YaStmParams params{};
+    TimeGrid grid{};
+    double n{0.0}; // chief mean motion (error scale)
+};
+
+std::vector<YaCase> ya_cases(Rng& rng, std::size_t random_cases)
+{
+    std::vector<YaCase> cases;
+    auto add = [&cases](const ChiefState& c, TimeGrid grid)
+    {
+        YaCase yc{};
+        yc.params.mu = kMu;
+        yc.params.chief_r0_i = c.r_i;
+        yc.params.chief_v0_i = c.v_i;
+        const double a = norm(c.r_i) / (2.0 - norm(c.r_i) * dot(c.v_i, c.v_i) / kMu);
+        yc.n = std::sqrt(kMu / (a * a * a));
+        yc.grid = std::move(grid);
+        if (yc.grid.tau.size() <= MAX_STEPS)
+        {
+            cases.push_back(std::move(yc));
+        }
+    };
+    const double rp = kEarthRadius + 400e3;
+    add(chief_on_orbit(rp, 0.0, 0.0, 0.9), make_time_grid(0.0, 1.0));
+    add(chief_on_orbit(rp, 0.0, 0.0, 0.9), make_time_grid(1.0, 1.0));
+    add(chief_on_orbit(rp, 0.0, 0.0, 0.9), make_time_grid(kFullIntervals, 1.0));
+    add(chief_on_orbit(rp, 0.3, 1.0, 0.5), make_time_grid(10.0 * kFullIntervals, 10.0));
+    add(chief_on_orbit(rp, 0.7, -0.2, 1.2), make_time_grid(10.0 * kFullIntervals, 10.0));
+    const TimeGridSegment seg[] = {{60.0, 0.5}, {600.0, 5.0}, {5400.0, 30.0}};
+    add(chief_on_orbit(rp, 0.1, 2.5, 0.1), make_piecewise_time_grid(seg, 3));
+    for (std::size_t t = 0; t < random_cases; ++t)
+    {
+        const ChiefState c = chief_on_orbit(rng.range(kEarthRadius + 200e3, 42164e3),
+                                            rng.range(0.0, 0.7), rng.range(-kPi, kPi),
+                                            rng.range(0.0, kPi));
+        const double cadence = rng.range(1.0, 30.0);
+        add(c, make_time_grid(cadence * static_cast<double>(rng.index(MAX_STEPS)), cadence));
+    }
+    return cases;
+}
+
+// Lockstep batches and the per-tick chief ephemeris against single-deputy on-the-fly calls.
+void check_ya_bitwise(const Options& opt, Report& rep)
+{
+    const bool batch_on = rep.selected("ya.batch");
+    const bool eph_on = rep.selected("ya.chief_ephemeris");
+    if (!batch_on && !eph_on)
+    {
+        return;
+    }
+    OutputStats* batch_r = batch_on ? &rep.add("ya.batch", "r", kBitwise) : nullptr;
+    OutputStats* batch_v = batch_on ? &rep.add("ya.batch", "v", kBitwise) : nullptr;
+    OutputStats* eph_r = eph_on ? &rep.add("ya.chief_ephemeris", "r", kBitwise) : nullptr;
+    OutputStats* eph_v = eph_on ? &rep.add("ya.chief_ephemeris", "v", kBitwise) : nullptr;
+
+    // More rows than one lane block, so a partial block is exercised too.
+    constexpr std::size_t kRows = ModelYA_STM::kBatchLanes + 5;
+    const ModelYA_STM ya;
+    Rng rng(opt.seed ^ 0x09);
+    std::vector<RelStateRic> x0(kRows);
+    std::vector<Vec3> r_ref(kRows * MAX_STEPS), v_ref(kRows * MAX_STEPS);
+    std::vector<Vec3> r_fast(kRows * MAX_STEPS), v_fast(kRows * MAX_STEPS);
+    std::vector<ModelCode> codes(kRows);
+    std::vector<YaChiefSample> eph_storage;
+
+    for (YaCase& yc : ya_cases(rng, 2 + opt.trials / 50))
+    {
+        const std::size_t steps = yc.grid.tau.size();
+        const std::vector<RelStateRic> edges = edge_rel_states();
+        for (std::size_t i = 0; i < kRows; ++i)
+        {
+            x0[i] = (i < edges.size()) ? edges[i] : random_rel_state(rng);
+        }
+        for (const YaStmBackend backend : {YaStmBackend::kRk4Reference, YaStmBackend::kClosedForm})
+        {
+            YaStmParams& p = yc.params;
+            p.backend = backend;
+            p.max_dt_sec = 1.0;
+            bool ok = true;
+            for (std::size_t i = 0; i < kRows; ++i)
+            {
+                ok = ok && ya.predict_ya_stm(x0[i], p, yc.grid,
+                                             Span<Vec3>{&r_ref[i * MAX_STEPS], steps},
+                                             Span<Vec3>{&v_ref[i * MAX_STEPS], steps})
+                                   .code == ModelCode::kOk;
+            }
+            if (!ok)
+            {
+                (batch_on ? batch_r : eph_r)->setup_failure();
+                continue;
+            }
+
+            YaChiefEphemeris eph{};
+            const bool use_eph = eph_on && backend == YaStmBackend::kRk4Reference;
+            if (use_eph)
+            {
+                eph_storage.resize(ModelYA_STM::chief_ephemeris_size(p, yc.grid));
+                const auto built = ya.build_chief_ephemeris(
+                    p, yc.grid, Span<YaChiefSample>{eph_storage.data(), eph_storage.size()},
+                    eph);
+                if (built.code != ModelCode::kOk)
+                {
+                    eph_r->setup_failure();
+                    continue;
+                }
+                for (std::size_t i = 0; i < kRows; ++i)
+                {
+                    const Span<Vec3> fr{r_fast.data(), steps};
+                    const Span<Vec3> fv{v_fast.data(), steps};
+                    if (ya.predict_ya_stm(x0[i], p, yc.grid, eph, fr, fv).code != ModelCode::kOk)
+                    {
+                        eph_r->setup_failure();
+                        continue;
+                    }
+                    eph_r->compare(fr.data, &r_ref[i * MAX_STEPS], steps);
+                    eph_v->compare(fv.data, &v_ref[i * MAX_STEPS], steps);
+                }
+            }
+
+            if (batch_on)
+            {
+                const Span2D<Vec3> fr{r_fast.data(), kRows, steps, MAX_STEPS};
+                const Span2D<Vec3> fv{v_fast.data(), kRows, steps, MAX_STEPS};
+                const Span<const RelStateRic> rows{x0.data(), kRows};
+                const Span<ModelCode> rc{codes.data(), kRows};
+                const auto res =
+                    use_eph ? ya.predict_ya_stm_batch(rows, p, yc.grid, eph, fr, fv, rc)
+                            : ya.predict_ya_stm_batch(rows, p, yc.grid, fr, fv, rc);
+                if (res.code != ModelCode::kOk)
+                {
+                    batch_r->setup_failure();
+                    continue;
+                }
+                for (std::size_t i = 0; i < kRows; ++i)
+                {
+                    batch_r->compare(&r_fast[i * MAX_STEPS], &r_ref[i * MAX_STEPS], steps);
+                    batch_v->compare(&v_fast[i * MAX_STEPS], &v_ref[i * MAX_STEPS], steps);
+                }
+            }
+        }
+    }
+}
+
+// Closed form and Dormand-Prince against the fine-step RK4 reference. Errors are reported in
+// units of the state scale |r0| + |v0| / n (times n for velocities).
+void check_ya_backends(const Options& opt, Report& rep)
+{
+    const bool cf_on = rep.selected("ya.closed_form");
+    const bool dp_on = rep.selected("ya.dormand_prince");
+    if (!cf_on && !dp_on)
+    {
+        return;
+    }
+    const Contract cf_tol = tolerance(1e-11, 0.0);
+    const Contract dp_tol = tolerance(1e-8, 0.0);
+    OutputStats* cf_r = cf_on ? &rep.add("ya.closed_form", "r_scaled", cf_tol) : nullptr;
+    OutputStats* cf_v = cf_on ? &rep.add("ya.closed_form", "v_scaled", cf_tol) : nullptr;
+    OutputStats* dp_r = dp_on ? &rep.add("ya.dormand_prince", "r_scaled", dp_tol) : nullptr;
+    OutputStats* dp_v = dp_on ? &rep.add("ya.dormand_prince", "v_scaled", dp_tol) : nullptr;
+
+    const ModelYA_STM ya;
+    Rng rng(opt.seed ^ 0x0A);
+    std::vector<Vec3> r_ref(MAX_STEPS), v_ref(MAX_STEPS), r_fast(MAX_STEPS), v_fast(MAX_STEPS);
+    const std::vector<RelStateRic> edges = edge_rel_states();
+    for (YaCase& yc : ya_cases(rng, 2 + opt.trials / 50))
+    {
+        const std::size_t steps = yc.grid.tau.size();
+        for (std::size_t s = 0; s < 4; ++s)
+        {
+            // Zero state, metre-scale and kilometre-scale offsets (linear regime).
+            const RelStateRic x0 =
+                (s == 0) ? edges[0] : ((s == 1) ? edges[5] : random_rel_state(rng));
+            YaStmParams p = yc.params;
+            p.backend = YaStmBackend::kRk4Reference;
+            p.max_dt_sec = 0.25;
+            if (ya.predict_ya_stm(x0, p, yc.grid, Span<Vec3>{r_ref.data(), steps},
+                                  Span<Vec3>{v_ref.data(), steps})
+                    .code != ModelCode::kOk)
+            {
+                (cf_on ? cf_r : dp_r)->setup_failure();
+                continue;
+            }
+            const double scale = std::max(norm(x0.r_ric) + norm(x0.v_ric) / yc.n, 1e-300);
+            auto compare = [&](YaStmBackend backend, OutputStats* sr, OutputStats* sv)
+            {
+                p.backend = backend;
+                p.max_dt_sec = 1.0;
+                if (ya.predict_ya_stm(x0, p, yc.grid, Span<Vec3>{r_fast.data(), steps},
+                                      Span<Vec3>{v_fast.data(), steps})
+                        .code != ModelCode::kOk)
+                {
+                    sr->setup_failure();
+                    return;
+                }
+                sr->compare_scaled(r_fast.data(), r_ref.data(), steps, scale);
+                sv->compare_scaled(v_fast.data(), v_ref.data(), steps, scale * yc.n);
+            };
+            if (cf_on)
+            {
+                compare(YaStmBackend::kClosedForm, cf_r, cf_v);
+            }
+            if (dp_on)
+            {
+                compare(YaStmBackend::kDormandPrince54, dp_r, dp_v);
+            }
+        }
+    }
+}
+
+// ------------------------------
+// Predictor
+// ------------------------------
+
+// A two-body formation behind one predictor, serial or on a worker pool.
+struct PredictorRig final
+{
+    static constexpr std::size_t kDeputies = MAX_VEHICLES;
+
+    VehicleIndexMap map{kDeputies};
+    TwoBodyChiefProvider chief;
+    TwoBodyVehicleProvider deputies{kFrame, kMu};
+    BullseyeFrame bullseye{chief, nullptr, BullseyeFrameMode::kConstructedOnly};
+    Publisher pub;
+    RelativePredictor pred;
+
+    PredictorRig(const ChiefState& c0, std::uint64_t seed, const RelativePredictorConfig& cfg,
+                 const PublisherConfig& pub_cfg)
+        : chief(kFrame, kMu, 0.0, c0.r_i, c0.v_i),
+          pub(pub_cfg),
+          pred(pub, map, chief, deputies, bullseye, cfg)
+    {
+        Rng rng(seed);
+        for (VehicleIndexMap::VehicleId id = 1; id <= kDeputies; ++id)
+        {
+            (void)deputies.add_vehicle(id, 0.0, c0.r_i + random_vec(rng, 1.0, 5e3),
+                                       c0.v_i + random_vec(rng, 1e-4, 5.0));
+            (void)map.register_vehicle(id);
+        }
+    }
+};
+
+void check_worker_pool(const Options& opt, Report& rep)
+{
+    struct Variant final
+    {
+        const char* name;
+        PredictorModel model;
+        YaStmBackend backend;
+    };
+    const Variant variants[] = {
+        {"predictor.worker_pool.hcw", PredictorModel::kHcw, YaStmBackend::kRk4Reference},
+        {"predictor.worker_pool.ya_rk4", PredictorModel::kYaStm, YaStmBackend::kRk4Reference},
+        {"predictor.worker_pool.ya_closed_form", PredictorModel::kYaStm,
+         YaStmBackend::kClosedForm},
+    };
+    WorkerPool pool(3);
+    Rng rng(opt.seed ^ 0x0B);
+    PublisherConfig pub_cfg{};
+    pub_cfg.velocities = true;
+    for (const Variant& var : variants)
+    {
+        if (!rep.selected(var.name))
+        {
+            continue;
+        }
+        OutputStats& sr = rep.add(var.name, "r", kBitwise);
+        OutputStats& sv = rep.add(var.name, "v", kBitwise);
+        RelativePredictorConfig cfg{};
+        cfg.model = var.model;
+        cfg.ya_backend = var.backend;
+        cfg.ya_max_dt_sec = 1.0;
+        const ChiefState c0 = chief_on_orbit(rng.range(kEarthRadius + 300e3, 12000e3),
+                                             rng.range(0.0, 0.3), rng.range(-kPi, kPi),
+                                             rng.range(0.0, kPi));
+        const std::uint64_t seed = rng.next();
+        const auto serial = std::make_unique<PredictorRig>(c0, seed, cfg, pub_cfg);
+        const auto pooled = std::make_unique<PredictorRig>(c0, seed, cfg, pub_cfg);
+        pooled->pred.attach_worker_pool(&pool);
+
+        for (std::size_t tick = 0; tick < 2 + opt.trials / 100; ++tick)
+        {
+            const double t0 = 10.0 * static_cast<double>(tick);
+            serial->pred.step(t0, kFullIntervals, 1.0);
+            pooled->pred.step(t0, kFullIntervals, 1.0);
+            const PredictionBuffer& a = serial->pub.read();
+            const PredictionBuffer& b = pooled->pub.read();
+            if (a.valid_rows == 0 || a.valid_rows != b.valid_rows || a.steps != b.steps ||
+                a.velocities == nullptr || b.velocities == nullptr)
+            {
+                sr.setup_failure();
+                continue;
+            }
+            for (std::size_t i = 0; i < PredictorRig::kDeputies; ++i)
+            {
+                if (!(a.row_status[i] == b.row_status[i]))
+                {
+                    sr.setup_failure();
+                }
+                if (a.row_valid(i))
+                {
+                    sr.compare(b.positions[i].data(), a.positions[i].data(), a.steps);
+                    sv.compare((*b.velocities)[i].data(), (*a.velocities)[i].data(), a.steps);
+                }
+            }
+        }
+    }
+}
+
+// ------------------------------
+// Reporting
+// ------------------------------
+
+const char* isa_name(HcwKernelIsa isa) noexcept
+{
+    switch (isa)
+    {
+    case HcwKernelIsa::kAvx512:
+        return "avx512";
+    case HcwKernelIsa::kAvx2:
+        return "avx2";
+    case HcwKernelIsa::kBaseline:
+        break;
+    }
+    return "baseline";
+}
+
+void print_table(const Report& rep)
+{
+    std::printf("%-38s %-16s %-9s %10s %11s %11s %11s %6s\n", "check", "output", "contract",
+                "samples", "max_abs", "max_rel", "max_ulp", "result");
+    for (const auto& s : rep.outputs())
+    {
+        std::printf("%-38s %-16s %-9s %10llu %11.3e %11.3e %11llu %6s\n", s->check.c_str(),
+                    s->output.c_str(), contract_name(s->contract.kind),
+                    static_cast<unsigned long long>(s->samples), s->max_abs, s->max_rel,
+                    static_cast<unsigned long long>(s->max_ulp),
+                    !s->passed() ? "FAIL"
+                                 : ((s->contract.kind == ContractKind::kReport) ? "-" : "ok"));
+        if (!s->passed())
+        {
+            std::printf("    %llu violation(s), %llu setup failure(s)",
+                        static_cast<unsigned long long>(s->violations),
+                        static_cast<unsigned long long>(s->setup_failures));
+            if (s->contract.kind == ContractKind::kTolerance)
+            {
+                std::printf(" (abs_tol %.3e, rel_tol %.3e)", s->contract.abs_tol,
+                            s->contract.rel_tol);
+            }
+            std::printf("\n");
+        }
+    }
+}
+
+bool write_json(const char* path, const Options& opt, const Report& rep)
+{
+    std::FILE* f = (std::strcmp(path, "-") == 0) ? stdout : std::fopen(path, "w");
+    if (f == nullptr)
+    {
+        std::fprintf(stderr, "determinism: cannot write %s\n", path);
+        return false;
+    }
+    std::fprintf(f,
+                 "{\n  \"schema\": \"bullseye-determinism-1\",\n  \"seed\": %llu,\n"
+                 "  \"trials\": %zu,\n  \"hcw_kernel_isa\": \"%s\",\n  \"passed\": %s,\n"
+                 "  \"outputs\": [\n",
+                 static_cast<unsigned long long>(opt.seed), opt.trials,
+                 isa_name(hcw_soa_kernel_isa()), rep.passed() ? "true" : "false");
+    const auto& outputs = rep.outputs();
+    for (std::size_t i = 0; i < outputs.size(); ++i)
+    {
+        const OutputStats& s = *outputs[i];
+        std::fprintf(f,
+                     "    {\"check\": \"%s\", \"output\": \"%s\", \"contract\": \"%s\", "
+                     "\"abs_tol\": %.6e, \"rel_tol\": %.6e, \"samples\": %llu, "
+                     "\"violations\": %llu, \"setup_failures\": %llu, \"max_abs\": %.6e, "
+                     "\"max_rel\": %.6e, \"max_ulp\": %llu, \"passed\": %s}%s\n",
+                     s.check.c_str(), s.output.c_str(), contract_name(s.contract.kind),
+                     s.contract.abs_tol, s.contract.rel_tol,
+                     static_cast<unsigned long long>(s.samples),
+                     static_cast<unsigned long long>(s.violations),
+                     static_cast<unsigned long long>(s.setup_failures), s.max_abs, s.max_rel,
+                     static_cast<unsigned long long>(s.max_ulp), s.passed() ? "true" : "false",
+                     (i + 1 < outputs.size()) ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    if (f != stdout)
+    {
+        std::fclose(f);
+    }
+    return true;
+}
+
+int usage()
+{
+    std::fprintf(stderr,
+                 "usage: bullseye_determinism_harness [--seed <n>] [--trials <n>] [--quick] "
+                 "[--filter <substr>] [--json <path|->]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt{};
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* a = argv[i];
+        const bool has_value = (i + 1 < argc);
+        if (std::strcmp(a, "--quick") == 0)
+        {
+            opt.trials = 20;
+        }
+        else if (std::strcmp(a, "--seed") == 0 && has_value)
+        {
+            opt.seed = std::strtoull(argv[++i], nullptr, 0);
+        }
+        else if (std::strcmp(a, "--trials") == 0 && has_value)
+        {
+            opt.trials = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 0));
+        }
+        else if (std::strcmp(a, "--filter") == 0 && has_value)
+        {
+            opt.filter = argv[++i];
+        }
+        else if (std::strcmp(a, "--json") == 0 && has_value)
+        {
+            opt.json_path = argv[++i];
+        }
+        else
+        {
+            return usage();
+        }
+    }
+
+    Report rep(opt.filter);
+    check_hcw_soa_kernel(opt, rep);
+    check_hcw_models(opt, rep);
+    check_trig_recurrence(opt, rep);
+    check_stumpff(opt, rep);
+    check_kepler_warm_start(opt, rep);
+    check_twobody_incremental(opt, rep);
+    check_twobody_elliptic(opt, rep);
+    check_twobody_fleet(opt, rep);
+    check_transforms(opt, rep);
+    check_ya_bitwise(opt, rep);
+    check_ya_backends(opt, rep);
+    check_worker_pool(opt, rep);
+
+    std::printf("seed %llu, %zu trials, HCW kernel %s\n",
+                static_cast<unsigned long long>(opt.seed), opt.trials,
+                isa_name(hcw_soa_kernel_isa()));
+    print_table(rep);
+    if (opt.json_path != nullptr && !write_json(opt.json_path, opt, rep))
+    {
+        return 2;
+    }
+    return rep.passed() ? 0 : 1;
+}
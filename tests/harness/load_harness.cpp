@@ -0,0 +1,277 @@
+// tests/harness/load_harness.cpp
+
+/**
+ * @file load_harness.cpp
+ * @brief Capacity run of a synthetic deployment (WorkloadGenerator) at a target tick rate.
+ *
+ * @details
+ * One run: --vehicles deputies split into formations by the --mix weights, ticked --ticks
+ * times at --tick-hz with --readers reader threads leasing snapshots at --read-hz each, and
+ * the providers delayed by --latency and failing at the --fail rates. The harness prints the
+ * WorkloadReport: ticks run, dropped and late, publications and failed formation ticks,
+ * injected failures, tick latency percentiles, published samples per second and the reader
+ * counts (reads, torn reads, snapshots skipped).
+ *
+ * Usage:
+ *   bullseye_load_harness [--vehicles <n>] [--horizon <s>] [--cadence <s>] [--tick-hz <hz>]
+ *                         [--ticks <n>] [--mix <placeholder,hcw,ya,ssj2>]
+ *                         [--latency <s>] [--fail <deputy,chief>] [--seed <n>]
+ *                         [--readers <n>] [--read-hz <hz>] [--threads <n>] [--slots <n>]
+ *                         [--quick] [--json <path|->]
+ *
+ * Exit status 0; 1 if any tick was dropped or late or any read was torn (--tolerate-late
+ * ignores dropped and late ticks); 2 on a usage, setup or file error.
+ * See docs/performance_budget.md.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "core/workload_generator.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+struct Options final
+{
+    WorkloadConfig config{};
+    bool tolerate_late{false};
+    const char* json_path{nullptr};
+};
+
+bool parse_double(const char* s, double& out)
+{
+    char* end = nullptr;
+    out = std::strtod(s, &end);
+    return end != s && *end == '\0';
+}
+
+bool parse_size(const char* s, std::size_t& out)
+{
+    char* end = nullptr;
+    const unsigned long long v = std::strtoull(s, &end, 10);
+    out = static_cast<std::size_t>(v);
+    return end != s && *end == '\0';
+}
+
+// Comma-separated doubles, exactly @p n of them.
+bool parse_doubles(const char* s, double* out, std::size_t n)
+{
+    for (std::size_t j = 0; j < n; ++j)
+    {
+        char* end = nullptr;
+        out[j] = std::strtod(s, &end);
+        if (end == s || *end != ((j + 1 < n) ? ',' : '\0'))
+        {
+            return false;
+        }
+        s = end + ((j + 1 < n) ? 1 : 0);
+    }
+    return true;
+}
+
+void print_report(const WorkloadReport& r)
+{
+    std::printf("formations %zu, vehicles %zu\n", r.formations, r.vehicles);
+    std::printf("ticks %llu run, %llu dropped, %llu late\n",
+                static_cast<unsigned long long>(r.ticks),
+                static_cast<unsigned long long>(r.dropped_ticks),
+                static_cast<unsigned long long>(r.late_ticks));
+    std::printf("published %llu, failed %llu (injected: %llu chief, %llu deputy)\n",
+                static_cast<unsigned long long>(r.published),
+                static_cast<unsigned long long>(r.failed),
+                static_cast<unsigned long long>(r.chief_failures),
+                static_cast<unsigned long long>(r.deputy_failures));
+    std::printf("tick p50 %.1f us, p99 %.1f us, max %.1f us\n", r.tick_p50_sec * 1e6,
+                r.tick_p99_sec * 1e6, r.tick_max_sec * 1e6);
+    std::printf("samples/s %.4e over %.3f s\n", r.samples_per_sec, r.wall_sec);
+    std::printf("reads %llu, torn %llu, skipped snapshots %llu\n",
+                static_cast<unsigned long long>(r.reads),
+                static_cast<unsigned long long>(r.torn_reads),
+                static_cast<unsigned long long>(r.skipped_snapshots));
+}
+
+bool write_json(const char* path, const WorkloadConfig& c, const WorkloadReport& r)
+{
+    std::FILE* f = (std::strcmp(path, "-") == 0) ? stdout : std::fopen(path, "w");
+    if (f == nullptr)
+    {
+        std::fprintf(stderr, "load: cannot write %s\n", path);
+        return false;
+    }
+    std::fprintf(f,
+                 "{\n  \"schema\": \"bullseye-load-1\",\n"
+                 "  \"config\": {\"vehicles\": %zu, \"horizon_sec\": %g, \"cadence_sec\": %g, "
+                 "\"tick_hz\": %g, \"ticks\": %zu, \"mix\": [%g, %g, %g, %g], "
+                 "\"latency_sec\": %g, \"deputy_failure_rate\": %g, "
+                 "\"chief_failure_rate\": %g, \"readers\": %zu, \"read_hz\": %g, "
+                 "\"threads\": %zu, \"publisher_slots\": %zu},\n",
+                 c.vehicles, c.horizon_sec, c.cadence_sec, c.tick_hz, c.ticks, c.mix.placeholder,
+                 c.mix.hcw, c.mix.ya_stm, c.mix.ss_j2, c.faults.latency_sec,
+                 c.faults.deputy_failure_rate, c.faults.chief_failure_rate, c.readers.count,
+                 c.readers.read_hz, c.threads, c.publisher_slots);
+    std::fprintf(f,
+                 "  \"report\": {\"formations\": %zu, \"ticks\": %llu, \"dropped_ticks\": %llu, "
+                 "\"late_ticks\": %llu, \"published\": %llu, \"failed\": %llu, "
+                 "\"chief_failures\": %llu, \"deputy_failures\": %llu, "
+                 "\"tick_p50_sec\": %.9f, \"tick_p99_sec\": %.9f, \"tick_max_sec\": %.9f, "
+                 "\"samples_per_sec\": %.6e, \"wall_sec\": %.6f, \"reads\": %llu, "
+                 "\"torn_reads\": %llu, \"skipped_snapshots\": %llu}\n}\n",
+                 r.formations, static_cast<unsigned long long>(r.ticks),
+                 static_cast<unsigned long long>(r.dropped_ticks),
+                 static_cast<unsigned long long>(r.late_ticks),
+                 static_cast<unsigned long long>(r.published),
+                 static_cast<unsigned long long>(r.failed),
+                 static_cast<unsigned long long>(r.chief_failures),
+                 static_cast<unsigned long long>(r.deputy_failures), r.tick_p50_sec,
+                 r.tick_p99_sec, r.tick_max_sec, r.samples_per_sec, r.wall_sec,
+                 static_cast<unsigned long long>(r.reads),
+                 static_cast<unsigned long long>(r.torn_reads),
+                 static_cast<unsigned long long>(r.skipped_snapshots));
+    if (f != stdout)
+    {
+        std::fclose(f);
+    }
+    return true;
+}
+
+int usage()
+{
+    std::fprintf(stderr,
+                 "usage: bullseye_load_harness [--vehicles <n>] [--horizon <s>] "
+                 "[--cadence <s>] [--tick-hz <hz>] [--ticks <n>] "
+                 "[--mix <placeholder,hcw,ya,ssj2>] [--latency <s>] [--fail <deputy,chief>] "
+                 "[--seed <n>] [--readers <n>] [--read-hz <hz>] [--threads <n>] "
+                 "[--slots <n>] [--tolerate-late] [--quick] [--json <path|->]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt{};
+    WorkloadConfig& c = opt.config;
+    c.vehicles = 256;
+    c.tick_hz = 1.0;
+    c.ticks = 30;
+    c.readers.count = 4;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* a = argv[i];
+        const bool has_value = (i + 1 < argc);
+        bool ok = true;
+        if (std::strcmp(a, "--quick") == 0)
+        {
+            c.vehicles = 40;
+            c.horizon_sec = 60.0;
+            c.tick_hz = 20.0;
+            c.ticks = 10;
+            c.mix = WorkloadModelMix{1.0, 1.0, 0.0, 0.0};
+            c.readers.count = 2;
+            opt.tolerate_late = true; // shared CI machines miss deadlines
+        }
+        else if (std::strcmp(a, "--tolerate-late") == 0)
+        {
+            opt.tolerate_late = true;
+        }
+        else if (!has_value)
+        {
+            return usage();
+        }
+        else if (std::strcmp(a, "--vehicles") == 0)
+        {
+            ok = parse_size(argv[++i], c.vehicles);
+        }
+        else if (std::strcmp(a, "--horizon") == 0)
+        {
+            ok = parse_double(argv[++i], c.horizon_sec);
+        }
+        else if (std::strcmp(a, "--cadence") == 0)
+        {
+            ok = parse_double(argv[++i], c.cadence_sec);
+        }
+        else if (std::strcmp(a, "--tick-hz") == 0)
+        {
+            ok = parse_double(argv[++i], c.tick_hz);
+        }
+        else if (std::strcmp(a, "--ticks") == 0)
+        {
+            ok = parse_size(argv[++i], c.ticks);
+        }
+        else if (std::strcmp(a, "--mix") == 0)
+        {
+            double w[4] = {};
+            ok = parse_doubles(argv[++i], w, 4);
+            c.mix = WorkloadModelMix{w[0], w[1], w[2], w[3]};
+        }
+        else if (std::strcmp(a, "--latency") == 0)
+        {
+            ok = parse_double(argv[++i], c.faults.latency_sec);
+        }
+        else if (std::strcmp(a, "--fail") == 0)
+        {
+            double p[2] = {};
+            ok = parse_doubles(argv[++i], p, 2);
+            c.faults.deputy_failure_rate = p[0];
+            c.faults.chief_failure_rate = p[1];
+        }
+        else if (std::strcmp(a, "--seed") == 0)
+        {
+            std::size_t seed = 0;
+            ok = parse_size(argv[++i], seed);
+            c.faults.seed = seed;
+        }
+        else if (std::strcmp(a, "--readers") == 0)
+        {
+            ok = parse_size(argv[++i], c.readers.count);
+        }
+        else if (std::strcmp(a, "--read-hz") == 0)
+        {
+            ok = parse_double(argv[++i], c.readers.read_hz);
+        }
+        else if (std::strcmp(a, "--threads") == 0)
+        {
+            ok = parse_size(argv[++i], c.threads);
+        }
+        else if (std::strcmp(a, "--slots") == 0)
+        {
+            ok = parse_size(argv[++i], c.publisher_slots);
+        }
+        else if (std::strcmp(a, "--json") == 0)
+        {
+            opt.json_path = argv[++i];
+        }
+        else
+        {
+            ok = false;
+        }
+        if (!ok)
+        {
+            return usage();
+        }
+    }
+
+    WorkloadGenerator gen(c);
+    if (!gen.ok())
+    {
+        std::fprintf(stderr, "load: invalid configuration or out of memory\n");
+        return 2;
+    }
+    std::printf("%zu vehicles, horizon %g s, cadence %g s, %g Hz x %zu ticks, %zu readers, "
+                "%zu threads\n",
+                c.vehicles, c.horizon_sec, c.cadence_sec, c.tick_hz, c.ticks, c.readers.count,
+                c.threads);
+    const WorkloadReport rep = gen.run();
+    print_report(rep);
+    if (opt.json_path != nullptr && !write_json(opt.json_path, c, rep))
+    {
+        return 2;
+    }
+    const bool missed = rep.dropped_ticks > 0u || rep.late_ticks > 0u;
+    return (rep.torn_reads > 0u || (missed && !opt.tolerate_late)) ? 1 : 0;
+}
@@ -0,0 +1,641 @@
+// tests/harness/performance_harness.cpp
+
+/**
+ * @file performance_harness.cpp
+ * @brief Microbenchmarks of the hot paths, with JSON output and checked-in budgets.
+ *
+ * @details
+ * Each case runs its operation in a timed loop until at least --min-time seconds have passed,
+ * repeated --reps times; the median repetition is reported as ns/op, samples/s (grid samples
+ * or states produced per second) and cycles/op (time-stamp counter ticks on x86-64, -1
+ * elsewhere). Cases are fixed, deterministic workloads: a MAX_STEPS (600) sample uniform grid
+ * at 1 s, 32 deputies in a LEO formation. A case whose setup does not produce valid output
+ * (e.g. every row failing) aborts the run instead of timing an error path.
+ *
+ * Usage:
+ *   bullseye_perf_harness [--filter <substr>] [--min-time <sec>] [--reps <n>] [--quick]
+ *                         [--json <path|->] [--budget <path>] [--trace <path>]
+ *
+ * With --budget, every case listed in the budget file must stay at or below its ns/op limit;
+ * the exit status is 1 if any case exceeds it (or is missing from the run), 2 on a usage or
+ * file error, 0 otherwise. See docs/performance_budget.md.
+ *
+ * With --trace (builds with BULLSEYE_ENABLE_TRACING), the predictor stage events retained in
+ * the trace rings are written to <path> as a Chrome trace and summarized as per-stage latency
+ * percentiles on stdout.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <x86intrin.h>
+#define BULLSEYE_PERF_HAVE_TSC 1
+#endif
+
+#include "core/bullseye_frame.hpp"
+#include "core/bullseye_frame_math.hpp"
+#include "core/chief_state_provider.hpp"
+#include "core/frame_transforms.hpp"
+#include "core/provider_twobody.hpp"
+#include "core/publisher.hpp"
+#include "core/tick_trace.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/time_grid.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "models/model_hcw.hpp"
+#include "models/model_ya_stm.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+// ------------------------------
+// Timing
+// ------------------------------
+
+// Keeps the compiler from discarding a result or hoisting work out of the timed loop.
+template <typename T>
+inline void keep(const T& value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+inline std::uint64_t cycles_now() noexcept
+{
+#ifdef BULLSEYE_PERF_HAVE_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct CaseResult final
+{
+    std::string name;
+    std::size_t samples_per_op{0};
+    std::uint64_t iterations{0};
+    double ns_per_op{0.0};
+    double samples_per_sec{0.0};
+    double cycles_per_op{-1.0};
+};
+
+struct Options final
+{
+    const char* filter{nullptr};
+    double min_time_sec{0.2};
+    int reps{5};
+    const char* json_path{nullptr};
+    const char* budget_path{nullptr};
+    const char* trace_path{nullptr};
+};
+
+// Time op() (one operation per call); median of opt.reps repetitions of >= min_time each.
+template <typename Op>
+CaseResult run_case(const Options& opt, const char* name, std::size_t samples_per_op, Op&& op)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Warm-up, then size the batch so one repetition lasts about min_time.
+    for (int i = 0; i < 3; ++i)
+    {
+        op();
+    }
+    std::uint64_t batch = 1;
+    for (;;)
+    {
+        const auto t0 = Clock::now();
+        for (std::uint64_t i = 0; i < batch; ++i)
+        {
+            op();
+        }
+        const double sec = std::chrono::duration<double>(Clock::now() - t0).count();
+        if (sec >= 0.25 * opt.min_time_sec || batch >= (std::uint64_t{1} << 40))
+        {
+            const double scale = (sec > 0.0) ? opt.min_time_sec / sec : 2.0;
+            batch = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(batch * scale));
+            break;
+        }
+        batch *= 4;
+    }
+
+    std::vector<double> ns(static_cast<std::size_t>(opt.reps));
+    std::vector<double> cyc(static_cast<std::size_t>(opt.reps));
+    for (int r = 0; r < opt.reps; ++r)
+    {
+        const std::uint64_t c0 = cycles_now();
+        const auto t0 = Clock::now();
+        for (std::uint64_t i = 0; i < batch; ++i)
+        {
+            op();
+        }
+        const auto t1 = Clock::now();
+        const std::uint64_t c1 = cycles_now();
+        ns[r] = std::chrono::duration<double, std::nano>(t1 - t0).count() / batch;
+        cyc[r] = static_cast<double>(c1 - c0) / batch;
+    }
+    std::vector<double> sorted = ns;
+    std::sort(sorted.begin(), sorted.end());
+    const double median = sorted[sorted.size() / 2];
+    const std::size_t at = static_cast<std::size_t>(
+        std::find(ns.begin(), ns.end(), median) - ns.begin());
+
+    CaseResult res{};
+    res.name = name;
+    res.samples_per_op = samples_per_op;
+    res.iterations = batch * static_cast<std::uint64_t>(opt.reps);
+    res.ns_per_op = median;
+    res.samples_per_sec = (median > 0.0) ? 1.0e9 * samples_per_op / median : 0.0;
+#ifdef BULLSEYE_PERF_HAVE_TSC
+    res.cycles_per_op = cyc[at];
+#else
+    (void)at;
+#endif
+    return res;
+}
+
+// ------------------------------
+// Workload
+// ------------------------------
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kChiefRadius = 7000e3;
+constexpr std::size_t kDeputies = (MAX_VEHICLES < 32u) ? MAX_VEHICLES : 32u;
+constexpr double kCadenceSec = 1.0;
+constexpr double kHorizonSec = static_cast<double>(MAX_STEPS - 1u) * kCadenceSec;
+constexpr std::size_t kSamples = MAX_STEPS;
+
+const char* const kFrame = "INERTIAL";
+
+ChiefState leo_chief(double t0) noexcept
+{
+    ChiefState s{};
+    s.time_tag = t0;
+    s.r_i = Vec3{kChiefRadius, 0.0, 0.0};
+    s.v_i = Vec3{0.0, std::sqrt(kMu / kChiefRadius), 0.0};
+    s.frame_id = kFrame;
+    s.status.code = ProviderCode::kOk;
+    return s;
+}
+
+class FixedChief final : public IChiefStateProvider
+{
+  public:
+    [[nodiscard]] ChiefState get(double t0) noexcept override { return leo_chief(t0); }
+};
+
+// Deputy id k on its own small offset from the chief.
+class Formation final : public IVehicleStateProvider
+{
+  public:
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override
+    {
+        const ChiefState c = leo_chief(t0);
+        const double k = static_cast<double>(id);
+        VehicleState s{};
+        s.time_tag = t0;
+        s.r_i = c.r_i + Vec3{20.0 * k, -35.0 * k, 3.0 * k};
+        s.v_i = c.v_i + Vec3{0.01 * k, -0.02 * k, 0.005 * k};
+        s.frame_id = kFrame;
+        s.status.code = ProviderCode::kOk;
+        return s;
+    }
+};
+
+RelStateRic deputy_x0() noexcept
+{
+    RelStateRic x0{};
+    x0.r_ric = Vec3{100.0, -50.0, 10.0};
+    x0.v_ric = Vec3{0.01, -0.2, 0.005};
+    return x0;
+}
+
+// A formation predictor with everything it needs (heap-held: the publisher is large).
+template <typename Predictor>
+struct PredictorRig final
+{
+    VehicleIndexMap map{kDeputies};
+    FixedChief chief;
+    Formation veh;
+    BullseyeFrame bullseye{chief, nullptr, BullseyeFrameMode::kConstructedOnly};
+    Publisher pub;
+    Predictor pred;
+
+    explicit PredictorRig(const RelativePredictorConfig& cfg)
+        : pred(pub, map, chief, veh, bullseye, cfg)
+    {
+        for (VehicleIndexMap::VehicleId id = 1; id <= kDeputies; ++id)
+        {
+            (void)map.register_vehicle(id);
+        }
+    }
+
+    // One tick must publish every row, or the case would time the failure path.
+    bool ready()
+    {
+        pred.step(0.0, kHorizonSec, kCadenceSec);
+        const PredictionBuffer& b = pub.read();
+        const bool ok = b.steps == kSamples && b.valid_rows == (RowMask{1} << kDeputies) - 1u;
+        if (!ok)
+        {
+            std::fprintf(stderr, "perf: predictor setup failed (valid_rows=%llx)\n",
+                         static_cast<unsigned long long>(b.valid_rows));
+        }
+        return ok;
+    }
+};
+
+// ------------------------------
+// Cases
+// ------------------------------
+
+bool run_all(const Options& opt, std::vector<CaseResult>& out)
+{
+    auto selected = [&opt](const char* name)
+    { return opt.filter == nullptr || std::strstr(name, opt.filter) != nullptr; };
+    auto add = [&](const char* name, std::size_t samples, auto&& op)
+    {
+        if (selected(name))
+        {
+            out.push_back(run_case(opt, name, samples, op));
+        }
+    };
+
+    const TimeGrid grid = make_time_grid(kHorizonSec, kCadenceSec);
+    std::vector<Vec3> r(kSamples);
+    std::vector<Vec3> v(kSamples);
+    const Span<Vec3> out_r{r.data(), r.size()};
+    const Span<Vec3> out_v{v.data(), v.size()};
+    const RelStateRic x0 = deputy_x0();
+    const ChiefState chief = leo_chief(0.0);
+
+    // Models.
+    {
+        const ModelHCW hcw;
+        HcwParams p{};
+        p.n_radps = std::sqrt(kMu / (kChiefRadius * kChiefRadius * kChiefRadius));
+        add("model.hcw.predict", kSamples,
+            [&]()
+            {
+                const auto res = hcw.predict_hcw(x0, p, grid, out_r, out_v);
+                keep(res);
+                keep(r[kSamples - 1]);
+            });
+    }
+    {
+        const ModelYA_STM ya;
+        YaStmParams p{};
+        p.mu = kMu;
+        p.chief_r0_i = chief.r_i;
+        p.chief_v0_i = chief.v_i;
+        p.max_dt_sec = 1.0;
+        add("model.ya.predict_rk4", kSamples,
+            [&]()
+            {
+                const auto res = ya.predict_ya_stm(x0, p, grid, out_r, out_v);
+                keep(res);
+                keep(r[kSamples - 1]);
+            });
+        p.backend = YaStmBackend::kClosedForm;
+        add("model.ya.predict_closed_form", kSamples,
+            [&]()
+            {
+                const auto res = ya.predict_ya_stm(x0, p, grid, out_r, out_v);
+                keep(res);
+                keep(r[kSamples - 1]);
+            });
+    }
+
+    // Chief provider and frame construction.
+    {
+        TwoBodyChiefProvider twobody(kFrame, kMu, 0.0, chief.r_i, chief.v_i);
+        double t = 0.0;
+        add("provider.twobody.get", 1,
+            [&]()
+            {
+                t += kCadenceSec;
+                const ChiefState s = twobody.get(t);
+                keep(s);
+            });
+        add("frame.construct_ric_from_chief", 1,
+            [&]()
+            {
+                const ConstructedRicFrame f = construct_ric_from_chief(chief);
+                keep(f);
+            });
+    }
+
+    // Transforms.
+    {
+        const ConstructedRicFrame f = construct_ric_from_chief(chief);
+        const Mat3 C_i2r = transpose(f.C_from_ric_to_inertial);
+        const Vec3 w = f.omega_ric;
+        Formation veh;
+        std::vector<Vec3> vr(kDeputies);
+        std::vector<Vec3> vv(kDeputies);
+        std::vector<RelStateRic> rel(kDeputies);
+        for (std::size_t k = 0; k < kDeputies; ++k)
+        {
+            const VehicleState s = veh.get(k + 1, 0.0);
+            vr[k] = s.r_i;
+            vv[k] = s.v_i;
+        }
+        add("transform.inertial_to_ric", 1,
+            [&]()
+            {
+                const RelState s =
+                    inertial_to_ric_relative(vr[3], vv[3], chief.r_i, chief.v_i, C_i2r, w);
+                keep(s);
+            });
+        add("transform.inertial_to_ric_batch32", kDeputies,
+            [&]()
+            {
+                inertial_to_ric_relative_batch(Span<const Vec3>{vr.data(), kDeputies},
+                                               Span<const Vec3>{vv.data(), kDeputies},
+                                               chief.r_i, chief.v_i, C_i2r, w,
+                                               Span<RelStateRic>{rel.data(), kDeputies});
+                keep(rel[kDeputies - 1]);
+            });
+        add("transform.ric_to_inertial", 1,
+            [&]()
+            {
+                const RelState s = ric_to_inertial_relative(x0.r_ric, x0.v_ric, chief.r_i,
+                                                            chief.v_i, f.C_from_ric_to_inertial, w);
+                keep(s);
+            });
+    }
+
+    // Publisher.
+    {
+        const auto pub = std::make_unique<Publisher>();
+        double t = 0.0;
+        add("publisher.publish", 1,
+            [&]()
+            {
+                PredictionBuffer& buf = pub->begin_write();
+                buf.steps = kSamples;
+                t += kCadenceSec;
+                keep(pub->publish(t));
+            });
+        add("publisher.read", 1,
+            [&]()
+            {
+                const PredictionBuffer& buf = pub->read();
+                keep(buf.seqno);
+            });
+    }
+
+    // Full predictor ticks (32 deputies x 601 samples).
+    {
+        RelativePredictorConfig cfg{};
+        const auto rig = std::make_unique<PredictorRig<HcwRelativePredictor>>(cfg);
+        if (!rig->ready())
+        {
+            return false;
+        }
+        double t = 0.0;
+        add("predictor.step.hcw32", kDeputies * kSamples,
+            [&]()
+            {
+                t += kCadenceSec;
+                rig->pred.step(t, kHorizonSec, kCadenceSec);
+                keep(rig->pub.read().seqno);
+            });
+    }
+    {
+        RelativePredictorConfig cfg{};
+        cfg.model = PredictorModel::kYaStm;
+        cfg.ya_max_dt_sec = 1.0;
+        const auto rig = std::make_unique<PredictorRig<YaRelativePredictor>>(cfg);
+        if (!rig->ready())
+        {
+            return false;
+        }
+        double t = 0.0;
+        add("predictor.step.ya32", kDeputies * kSamples,
+            [&]()
+            {
+                t += kCadenceSec;
+                rig->pred.step(t, kHorizonSec, kCadenceSec);
+                keep(rig->pub.read().seqno);
+            });
+    }
+    return true;
+}
+
+// ------------------------------
+// Reporting and budgets
+// ------------------------------
+
+void print_table(const std::vector<CaseResult>& results)
+{
+    std::printf("%-34s %14s %16s %14s %12s\n", "case", "ns/op", "samples/s", "cycles/op",
+                "iterations");
+    for (const CaseResult& r : results)
+    {
+        std::printf("%-34s %14.1f %16.4g %14.1f %12llu\n", r.name.c_str(), r.ns_per_op,
+                    r.samples_per_sec, r.cycles_per_op,
+                    static_cast<unsigned long long>(r.iterations));
+    }
+}
+
+bool write_json(const char* path, const std::vector<CaseResult>& results)
+{
+    std::FILE* f = (std::strcmp(path, "-") == 0) ? stdout : std::fopen(path, "w");
+    if (f == nullptr)
+    {
+        std::fprintf(stderr, "perf: cannot write %s\n", path);
+        return false;
+    }
+    std::fprintf(f, "{\n  \"schema\": \"bullseye-perf-1\",\n");
+#ifdef BULLSEYE_PERF_HAVE_TSC
+    std::fprintf(f, "  \"cycles\": \"tsc\",\n");
+#else
+    std::fprintf(f, "  \"cycles\": \"unavailable\",\n");
+#endif
+    std::fprintf(f, "  \"cases\": [\n");
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const CaseResult& r = results[i];
+        std::fprintf(f,
+                     "    {\"name\": \"%s\", \"ns_per_op\": %.3f, \"samples_per_op\": %zu, "
+                     "\"samples_per_sec\": %.6g, \"cycles_per_op\": %.1f, "
+                     "\"iterations\": %llu}%s\n",
+                     r.name.c_str(), r.ns_per_op, r.samples_per_op, r.samples_per_sec,
+                     r.cycles_per_op, static_cast<unsigned long long>(r.iterations),
+                     (i + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    if (f != stdout)
+    {
+        std::fclose(f);
+    }
+    return true;
+}
+
+// Budget file: one "<case> <max ns/op>" per line; '#' starts a comment.
+int check_budgets(const char* path, const std::vector<CaseResult>& results, bool filtered)
+{
+    std::FILE* f = std::fopen(path, "r");
+    if (f == nullptr)
+    {
+        std::fprintf(stderr, "perf: cannot read budget file %s\n", path);
+        return 2;
+    }
+    int failures = 0;
+    char line[256];
+    while (std::fgets(line, sizeof(line), f) != nullptr)
+    {
+        char* hash = std::strchr(line, '#');
+        if (hash != nullptr)
+        {
+            *hash = '\0';
+        }
+        char name[128];
+        double limit = 0.0;
+        if (std::sscanf(line, "%127s %lf", name, &limit) != 2)
+        {
+            continue;
+        }
+        const auto it = std::find_if(results.begin(), results.end(),
+                                     [&name](const CaseResult& r) { return r.name == name; });
+        if (it == results.end())
+        {
+            if (!filtered)
+            {
+                std::printf("BUDGET MISSING %-34s (not run)\n", name);
+                ++failures;
+            }
+            continue;
+        }
+        const bool ok = it->ns_per_op <= limit;
+        std::printf("BUDGET %-4s %-34s %12.1f ns/op (limit %.1f)\n", ok ? "ok" : "FAIL", name,
+                    it->ns_per_op, limit);
+        failures += ok ? 0 : 1;
+    }
+    std::fclose(f);
+    return (failures == 0) ? 0 : 1;
+}
+
+// Chrome trace of the retained stage events plus per-stage latency percentiles.
+bool write_trace(const char* path)
+{
+    if (!kTracingEnabled)
+    {
+        std::fprintf(stderr, "perf: --trace needs a BULLSEYE_ENABLE_TRACING build\n");
+        return false;
+    }
+    std::vector<TraceRecord> records(kMaxTraceThreads * TraceRing::kCapacity);
+    const std::size_t n =
+        collect_trace_events(Span<TraceRecord>{records.data(), records.size()});
+    records.resize(std::min(n, records.size()));
+    std::FILE* f = std::fopen(path, "w");
+    if (f == nullptr)
+    {
+        std::fprintf(stderr, "perf: cannot write %s\n", path);
+        return false;
+    }
+    const double ns_per_tick = trace_ns_per_tick();
+    const Span<const TraceRecord> view{records.data(), records.size()};
+    const bool ok = write_chrome_trace(f, view, ns_per_tick);
+    std::fclose(f);
+
+    const auto hist = std::make_unique<TraceStageHistograms>();
+    hist->add(view, ns_per_tick);
+    std::printf("\ntrace: %zu events -> %s\n", records.size(), path);
+    return hist->write_summary(stdout) && ok;
+}
+
+int usage()
+{
+    std::fprintf(stderr,
+                 "usage: bullseye_perf_harness [--filter <substr>] [--min-time <sec>] "
+                 "[--reps <n>] [--quick] [--json <path|->] [--budget <path>] "
+                 "[--trace <path>]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt{};
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* a = argv[i];
+        const bool has_value = (i + 1 < argc);
+        if (std::strcmp(a, "--quick") == 0)
+        {
+            opt.min_time_sec = 0.005;
+            opt.reps = 1;
+        }
+        else if (std::strcmp(a, "--filter") == 0 && has_value)
+        {
+            opt.filter = argv[++i];
+        }
+        else if (std::strcmp(a, "--min-time") == 0 && has_value)
+        {
+            opt.min_time_sec = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(a, "--reps") == 0 && has_value)
+        {
+            opt.reps = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(a, "--json") == 0 && has_value)
+        {
+            opt.json_path = argv[++i];
+        }
+        else if (std::strcmp(a, "--budget") == 0 && has_value)
+        {
+            opt.budget_path = argv[++i];
+        }
+        else if (std::strcmp(a, "--trace") == 0 && has_value)
+        {
+            opt.trace_path = argv[++i];
+        }
+        else
+        {
+            return usage();
+        }
+    }
+    if (!(opt.min_time_sec > 0.0))
+    {
+        return usage();
+    }
+
+    std::vector<CaseResult> results;
+    if (!run_all(opt, results))
+    {
+        return 2;
+    }
+    print_table(results);
+
+    if (opt.json_path != nullptr && !write_json(opt.json_path, results))
+    {
+        return 2;
+    }
+    if (opt.trace_path != nullptr && !write_trace(opt.trace_path))
+    {
+        return 2;
+    }
+    if (opt.budget_path != nullptr)
+    {
+        return check_budgets(opt.budget_path, results, opt.filter != nullptr);
+    }
+    return 0;
+}
@@ -0,0 +1,637 @@
+// tests/harness/scaling_harness.cpp
+
+/**
+ * @file scaling_harness.cpp
+ * @brief Throughput, tail latency, memory and cache-miss scaling over vehicles, steps, threads.
+ *
+ * @details
+ * One point of the sweep is a (vehicles, steps, threads) triple. The vehicles are split into
+ * formations of up to MAX_VEHICLES deputies, each with its own chief, deputy provider,
+ * BullseyeFrame and Publisher:
+ * - one formation runs as a standalone RelativePredictor with a WorkerPool attached (rows
+ *   spread across the pool);
+ * - several run as a FleetRelativePredictor on the pool (formations spread across the pool).
+ * threads counts the caller, so the pool has threads - 1 workers.
+ *
+ * A grid longer than MAX_STEPS samples is covered by consecutive windows of at most
+ * MAX_STEPS samples, one step() each, so a "tick" of 10000 steps is 17 chained steps. This
+ * is what a consumer of longer horizons would do today; the cost is reported per tick.
+ *
+ * Per point the harness reports:
+ * - throughput: vehicle samples per second at the median tick;
+ * - tick latency percentiles (p50, p90, p99, max) over --ticks timed ticks;
+ * - memory: the static footprint of the rigs and predictors (sizeof) and the resident set
+ *   growth across setup and the warm-up tick (/proc/self/statm; 0 where unavailable);
+ * - hardware counters per tick (cycles, instructions, cache references and misses) via
+ *   perf_event_open on Linux, counting the caller and every pool thread. Counters the kernel
+ *   refuses (no PMU, perf_event_paranoid) are reported as unavailable (-1).
+ *
+ * Usage:
+ *   bullseye_scaling_harness [--vehicles <list>] [--steps <list>] [--threads <list>]
+ *                            [--model hcw|ya] [--ticks <n>] [--quick] [--json <path|->]
+ *
+ * Lists are comma-separated. Defaults: vehicles 1,8,32,128,512,2048; steps 61,600,2400,10000;
+ * threads 1,2,4,... up to the hardware thread count. Exit status 0, or 2 on a usage, setup or
+ * file error. See docs/performance_budget.md.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define BULLSEYE_SCALING_HAVE_PERF_EVENT 1
+#endif
+
+#include "core/bullseye_frame.hpp"
+#include "core/fleet_predictor.hpp"
+#include "core/provider_twobody.hpp"
+#include "core/provider_twobody_fleet.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "core/worker_pool.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kCadenceSec = 1.0;
+constexpr std::size_t kMaxScalingVehicles =
+    MAX_VEHICLES * FleetRelativePredictor::kMaxFormations;
+const char* const kFrame = "INERTIAL";
+
+// ------------------------------
+// Hardware counters
+// ------------------------------
+
+enum Counter : std::size_t
+{
+    kCycles = 0,
+    kInstructions,
+    kCacheReferences,
+    kCacheMisses,
+    kCounterCount
+};
+
+const char* const kCounterNames[kCounterCount] = {"cycles", "instructions", "cache_references",
+                                                  "cache_misses"};
+
+// Counters of the calling thread and of every thread it starts afterwards (inherit), so open
+// them before the worker pool is constructed.
+class HwCounters final
+{
+  public:
+    HwCounters() noexcept
+    {
+#ifdef BULLSEYE_SCALING_HAVE_PERF_EVENT
+        const std::uint64_t configs[kCounterCount] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES};
+        for (std::size_t c = 0; c < kCounterCount; ++c)
+        {
+            perf_event_attr attr{};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof(attr);
+            attr.config = configs[c];
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_[c] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~HwCounters()
+    {
+#ifdef BULLSEYE_SCALING_HAVE_PERF_EVENT
+        for (const int fd : fd_)
+        {
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    HwCounters(const HwCounters&) = delete;
+    HwCounters& operator=(const HwCounters&) = delete;
+
+    void start() noexcept
+    {
+#ifdef BULLSEYE_SCALING_HAVE_PERF_EVENT
+        for (const int fd : fd_)
+        {
+            if (fd >= 0)
+            {
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    // Counts since start(), or -1 per counter that is unavailable.
+    void stop(double (&out)[kCounterCount]) noexcept
+    {
+        for (std::size_t c = 0; c < kCounterCount; ++c)
+        {
+            out[c] = -1.0;
+#ifdef BULLSEYE_SCALING_HAVE_PERF_EVENT
+            std::uint64_t value = 0;
+            if (fd_[c] >= 0)
+            {
+                ioctl(fd_[c], PERF_EVENT_IOC_DISABLE, 0);
+                if (read(fd_[c], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)))
+                {
+                    out[c] = static_cast<double>(value);
+                }
+            }
+#endif
+        }
+    }
+
+  private:
+    int fd_[kCounterCount]{-1, -1, -1, -1};
+};
+
+// Resident set size [bytes], or 0 where /proc/self/statm is unavailable.
+std::uint64_t resident_bytes() noexcept
+{
+#ifdef BULLSEYE_SCALING_HAVE_PERF_EVENT
+    std::FILE* f = std::fopen("/proc/self/statm", "r");
+    if (f == nullptr)
+    {
+        return 0;
+    }
+    unsigned long long size = 0;
+    unsigned long long resident = 0;
+    const int n = std::fscanf(f, "%llu %llu", &size, &resident);
+    std::fclose(f);
+    return (n == 2) ? resident * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE)) : 0;
+#else
+    return 0;
+#endif
+}
+
+// ------------------------------
+// Rigs
+// ------------------------------
+
+// One formation: a LEO chief with up to MAX_VEHICLES deputies within a few km.
+struct FormationRig final
+{
+    VehicleIndexMap map{MAX_VEHICLES};
+    TwoBodyChiefProvider chief;
+    TwoBodyVehicleProvider deputies{kFrame, kMu};
+    BullseyeFrame bullseye{chief, nullptr, BullseyeFrameMode::kConstructedOnly};
+    Publisher pub;
+
+    static Vec3 chief_r(std::size_t f) noexcept
+    {
+        return Vec3{6778e3 + 1e3 * static_cast<double>(f), 0.0, 0.0};
+    }
+
+    static Vec3 chief_v(std::size_t f) noexcept
+    {
+        const double v = std::sqrt(kMu / norm(chief_r(f)));
+        const double inc = 0.9 + 0.01 * static_cast<double>(f);
+        return Vec3{0.0, v * std::cos(inc), v * std::sin(inc)};
+    }
+
+    FormationRig(std::size_t f, std::size_t vehicles)
+        : chief(kFrame, kMu, 0.0, chief_r(f), chief_v(f))
+    {
+        for (std::size_t d = 0; d < vehicles; ++d)
+        {
+            const auto id = static_cast<VehicleIndexMap::VehicleId>(d + 1);
+            const double k = static_cast<double>(d + 1);
+            const bool added = deputies.add_vehicle(
+                id, 0.0, chief_r(f) + Vec3{40.0 * k, -90.0 * k, 15.0 * k},
+                chief_v(f) + Vec3{0.01 * k, -0.02 * k, 0.005 * k});
+            ok = ok && added && map.register_vehicle(id).has_value();
+        }
+    }
+
+    bool ok{true};
+};
+
+// Every formation of one point, plus what steps them.
+struct ScalingRig final
+{
+    std::vector<std::unique_ptr<FormationRig>> formations;
+    std::unique_ptr<RelativePredictor> single; // one formation
+    std::unique_ptr<FleetRelativePredictor> fleet; // several formations
+
+    void step(double t0, double horizon_sec) noexcept
+    {
+        if (single)
+        {
+            single->step(t0, horizon_sec, kCadenceSec);
+        }
+        else
+        {
+            fleet->step(t0, horizon_sec, kCadenceSec);
+        }
+    }
+
+    // Every formation published every row of its last step.
+    [[nodiscard]] bool all_valid() const noexcept
+    {
+        for (const auto& f : formations)
+        {
+            if (f->pub.read().valid_rows != (RowMask{1} << f->map.size()) - 1u)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// ------------------------------
+// Sweep
+// ------------------------------
+
+struct Options final
+{
+    std::vector<std::size_t> vehicles{1, 8, 32, 128, 512, 2048};
+    std::vector<std::size_t> steps{61, 600, 2400, 10000};
+    std::vector<std::size_t> threads{};
+    PredictorModel model{PredictorModel::kHcw};
+    int ticks{20};
+    const char* json_path{nullptr};
+};
+
+struct Point final
+{
+    std::size_t vehicles{0};
+    std::size_t steps{0};
+    std::size_t threads{0};
+    std::size_t formations{0};
+    std::size_t windows{0};
+    double p50_ns{0.0};
+    double p90_ns{0.0};
+    double p99_ns{0.0};
+    double max_ns{0.0};
+    double samples_per_sec{0.0};
+    std::uint64_t footprint_bytes{0};
+    std::int64_t rss_growth_bytes{0};
+    double counters_per_tick[kCounterCount]{};
+};
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+    const auto rank =
+        static_cast<std::size_t>(std::ceil(p * 0.01 * static_cast<double>(sorted.size())));
+    return sorted[std::min(sorted.size(), std::max<std::size_t>(rank, 1)) - 1];
+}
+
+// Chained step() windows covering steps samples from t0 (each at most MAX_STEPS samples).
+template <typename Rig>
+void tick(Rig& rig, double t0, std::size_t steps) noexcept
+{
+    const std::size_t span = MAX_STEPS - 1;
+    const std::size_t intervals = steps - 1;
+    std::size_t done = 0;
+    do
+    {
+        const std::size_t len = std::min(span, intervals - done);
+        rig.step(t0 + static_cast<double>(done) * kCadenceSec,
+                 static_cast<double>(len) * kCadenceSec);
+        done += len;
+    } while (done < intervals);
+}
+
+bool run_point(const Options& opt, std::size_t vehicles, std::size_t steps, std::size_t threads,
+               Point& out)
+{
+    using Clock = std::chrono::steady_clock;
+    out.vehicles = vehicles;
+    out.steps = steps;
+    out.threads = threads;
+    out.formations = (vehicles + MAX_VEHICLES - 1) / MAX_VEHICLES;
+    out.windows = std::max<std::size_t>(1, (steps - 1 + MAX_STEPS - 2) / (MAX_STEPS - 1));
+
+    RelativePredictorConfig cfg{};
+    cfg.model = opt.model;
+
+    const std::uint64_t rss_before = resident_bytes();
+    HwCounters counters; // before the pool, so its threads inherit the counters
+    WorkerPool pool(threads - 1);
+
+    ScalingRig rig;
+    for (std::size_t f = 0; f < out.formations; ++f)
+    {
+        const std::size_t n = std::min<std::size_t>(MAX_VEHICLES, vehicles - f * MAX_VEHICLES);
+        rig.formations.push_back(std::make_unique<FormationRig>(f, n));
+        if (!rig.formations.back()->ok)
+        {
+            std::fprintf(stderr, "scaling: formation setup failed\n");
+            return false;
+        }
+    }
+    if (out.formations == 1)
+    {
+        FormationRig& f = *rig.formations.front();
+        rig.single = std::make_unique<RelativePredictor>(f.pub, f.map, f.chief, f.deputies,
+                                                         f.bullseye, cfg);
+        rig.single->attach_worker_pool(&pool);
+    }
+    else
+    {
+        rig.fleet = std::make_unique<FleetRelativePredictor>(&pool);
+        for (const auto& f : rig.formations)
+        {
+            if (!rig.fleet->add_formation(f->pub, f->map, f->chief, f->deputies, nullptr,
+                                          BullseyeFrameMode::kConstructedOnly, cfg))
+            {
+                std::fprintf(stderr, "scaling: add_formation failed\n");
+                return false;
+            }
+        }
+    }
+    out.footprint_bytes = out.formations * (sizeof(FormationRig) + sizeof(RelativePredictor));
+
+    tick(rig, 0.0, steps); // warm-up: first-touch of every buffer, grid caches
+    if (!rig.all_valid())
+    {
+        std::fprintf(stderr, "scaling: warm-up tick did not publish every row\n");
+        return false;
+    }
+    out.rss_growth_bytes = static_cast<std::int64_t>(resident_bytes()) -
+                           static_cast<std::int64_t>(rss_before);
+
+    std::vector<double> ns(static_cast<std::size_t>(opt.ticks));
+    counters.start();
+    for (int k = 0; k < opt.ticks; ++k)
+    {
+        const auto t_begin = Clock::now();
+        tick(rig, static_cast<double>(k + 1) * kCadenceSec, steps);
+        ns[static_cast<std::size_t>(k)] =
+            std::chrono::duration<double, std::nano>(Clock::now() - t_begin).count();
+    }
+    double counts[kCounterCount];
+    counters.stop(counts);
+    for (std::size_t c = 0; c < kCounterCount; ++c)
+    {
+        out.counters_per_tick[c] =
+            (counts[c] < 0.0) ? -1.0 : counts[c] / static_cast<double>(opt.ticks);
+    }
+
+    std::sort(ns.begin(), ns.end());
+    out.p50_ns = percentile(ns, 50.0);
+    out.p90_ns = percentile(ns, 90.0);
+    out.p99_ns = percentile(ns, 99.0);
+    out.max_ns = ns.back();
+    out.samples_per_sec =
+        static_cast<double>(vehicles) * static_cast<double>(steps) / (out.p50_ns * 1e-9);
+    return true;
+}
+
+// ------------------------------
+// Reporting
+// ------------------------------
+
+void print_header()
+{
+    std::printf("%8s %6s %4s %4s %4s %12s %12s %12s %12s %12s %10s %10s %12s %10s\n", "vehicles",
+                "steps", "thr", "form", "win", "samples/s", "p50_us", "p90_us", "p99_us",
+                "max_us", "static_MiB", "rss_MiB", "miss/tick", "miss_rate");
+}
+
+void print_point(const Point& p)
+{
+    const double refs = p.counters_per_tick[kCacheReferences];
+    const double misses = p.counters_per_tick[kCacheMisses];
+    char miss[32] = "n/a";
+    char rate[32] = "n/a";
+    if (misses >= 0.0)
+    {
+        std::snprintf(miss, sizeof(miss), "%.0f", misses);
+    }
+    if (misses >= 0.0 && refs > 0.0)
+    {
+        std::snprintf(rate, sizeof(rate), "%.3f", misses / refs);
+    }
+    std::printf("%8zu %6zu %4zu %4zu %4zu %12.4e %12.1f %12.1f %12.1f %12.1f %10.2f %10.2f "
+                "%12s %10s\n",
+                p.vehicles, p.steps, p.threads, p.formations, p.windows, p.samples_per_sec,
+                p.p50_ns * 1e-3, p.p90_ns * 1e-3, p.p99_ns * 1e-3, p.max_ns * 1e-3,
+                static_cast<double>(p.footprint_bytes) / (1024.0 * 1024.0),
+                static_cast<double>(p.rss_growth_bytes) / (1024.0 * 1024.0), miss, rate);
+}
+
+bool write_json(const char* path, const Options& opt, const std::vector<Point>& points)
+{
+    std::FILE* f = (std::strcmp(path, "-") == 0) ? stdout : std::fopen(path, "w");
+    if (f == nullptr)
+    {
+        std::fprintf(stderr, "scaling: cannot write %s\n", path);
+        return false;
+    }
+    std::fprintf(f,
+                 "{\n  \"schema\": \"bullseye-scaling-1\",\n  \"model\": \"%s\",\n"
+                 "  \"cadence_sec\": %g,\n  \"ticks\": %d,\n  \"hardware_threads\": %u,\n"
+                 "  \"points\": [\n",
+                 (opt.model == PredictorModel::kHcw) ? "hcw" : "ya", kCadenceSec, opt.ticks,
+                 std::thread::hardware_concurrency());
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        const Point& p = points[i];
+        std::fprintf(f,
+                     "    {\"vehicles\": %zu, \"steps\": %zu, \"threads\": %zu, "
+                     "\"formations\": %zu, \"windows\": %zu, \"samples_per_sec\": %.6e, "
+                     "\"p50_ns\": %.1f, \"p90_ns\": %.1f, \"p99_ns\": %.1f, \"max_ns\": %.1f, "
+                     "\"footprint_bytes\": %llu, \"rss_growth_bytes\": %lld",
+                     p.vehicles, p.steps, p.threads, p.formations, p.windows, p.samples_per_sec,
+                     p.p50_ns, p.p90_ns, p.p99_ns, p.max_ns,
+                     static_cast<unsigned long long>(p.footprint_bytes),
+                     static_cast<long long>(p.rss_growth_bytes));
+        for (std::size_t c = 0; c < kCounterCount; ++c)
+        {
+            std::fprintf(f, ", \"%s_per_tick\": %.1f", kCounterNames[c], p.counters_per_tick[c]);
+        }
+        std::fprintf(f, "}%s\n", (i + 1 < points.size()) ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    if (f != stdout)
+    {
+        std::fclose(f);
+    }
+    return true;
+}
+
+bool parse_list(const char* s, std::vector<std::size_t>& out)
+{
+    out.clear();
+    while (*s != '\0')
+    {
+        char* end = nullptr;
+        const unsigned long long v = std::strtoull(s, &end, 10);
+        if (end == s || v == 0 || (*end != ',' && *end != '\0'))
+        {
+            return false;
+        }
+        out.push_back(static_cast<std::size_t>(v));
+        s = (*end == ',') ? end + 1 : end;
+    }
+    return !out.empty();
+}
+
+int usage()
+{
+    std::fprintf(stderr,
+                 "usage: bullseye_scaling_harness [--vehicles <list>] [--steps <list>] "
+                 "[--threads <list>] [--model hcw|ya] [--ticks <n>] [--quick] "
+                 "[--json <path|->]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt{};
+    bool threads_given = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* a = argv[i];
+        const bool has_value = (i + 1 < argc);
+        if (std::strcmp(a, "--quick") == 0)
+        {
+            opt.vehicles = {1, 40};
+            opt.steps = {61, 700};
+            opt.threads = {1, 2};
+            threads_given = true;
+            opt.ticks = 3;
+        }
+        else if (std::strcmp(a, "--vehicles") == 0 && has_value)
+        {
+            if (!parse_list(argv[++i], opt.vehicles))
+            {
+                return usage();
+            }
+        }
+        else if (std::strcmp(a, "--steps") == 0 && has_value)
+        {
+            if (!parse_list(argv[++i], opt.steps))
+            {
+                return usage();
+            }
+        }
+        else if (std::strcmp(a, "--threads") == 0 && has_value)
+        {
+            if (!parse_list(argv[++i], opt.threads))
+            {
+                return usage();
+            }
+            threads_given = true;
+        }
+        else if (std::strcmp(a, "--model") == 0 && has_value)
+        {
+            const char* m = argv[++i];
+            if (std::strcmp(m, "hcw") == 0)
+            {
+                opt.model = PredictorModel::kHcw;
+            }
+            else if (std::strcmp(m, "ya") == 0)
+            {
+                opt.model = PredictorModel::kYaStm;
+            }
+            else
+            {
+                return usage();
+            }
+        }
+        else if (std::strcmp(a, "--ticks") == 0 && has_value)
+        {
+            opt.ticks = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(a, "--json") == 0 && has_value)
+        {
+            opt.json_path = argv[++i];
+        }
+        else
+        {
+            return usage();
+        }
+    }
+    if (!threads_given)
+    {
+        const std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t t = 1; t < hw; t *= 2)
+        {
+            opt.threads.push_back(t);
+        }
+        opt.threads.push_back(hw);
+    }
+    for (const std::size_t v : opt.vehicles)
+    {
+        if (v > kMaxScalingVehicles)
+        {
+            std::fprintf(stderr, "scaling: at most %zu vehicles (%zu formations of %zu)\n",
+                         kMaxScalingVehicles, FleetRelativePredictor::kMaxFormations,
+                         MAX_VEHICLES);
+            return 2;
+        }
+    }
+    for (const std::size_t s : opt.steps)
+    {
+        if (s < 2)
+        {
+            return usage();
+        }
+    }
+    for (const std::size_t t : opt.threads)
+    {
+        if (t > WorkerPool::kMaxWorkers + 1)
+        {
+            return usage();
+        }
+    }
+
+    std::printf("model %s, cadence %g s, %d timed ticks per point\n",
+                (opt.model == PredictorModel::kHcw) ? "hcw" : "ya", kCadenceSec, opt.ticks);
+    print_header();
+    std::vector<Point> points;
+    for (const std::size_t v : opt.vehicles)
+    {
+        for (const std::size_t s : opt.steps)
+        {
+            for (const std::size_t t : opt.threads)
+            {
+                Point p{};
+                if (!run_point(opt, v, s, t, p))
+                {
+                    return 2;
+                }
+                print_point(p);
+                std::fflush(stdout);
+                points.push_back(p);
+            }
+        }
+    }
+    if (opt.json_path != nullptr && !write_json(opt.json_path, opt, points))
+    {
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,646 @@
+// tests/harness/truth_comparison_harness.cpp
+
+/**
+ * @file truth_comparison_harness.cpp
+ * @brief Cost-versus-accuracy sweep of predictor configurations against two-body truth.
+ *
+ * @details
+ * Truth is the nonlinear two-body motion of the chief and of every deputy, each propagated
+ * from its t0 state with the universal-variable solver, differenced and rotated into the
+ * chief's RIC frame at each sample (the frame the predictor publishes in). The models'
+ * linearization, eccentricity and integration errors are therefore all measured; perturbations
+ * the predictor does not model (J2, drag) are not.
+ *
+ * For every (grid, configuration) pair the harness runs one predictor tick per scenario at
+ * t0 = 0 and compares the published RIC positions of all deputies with truth (RMS, P95, P99
+ * and max of |r_pred - r_truth| over all deputies and samples); then times --reps further
+ * ticks and reports the median wall time per tick (single thread, so CPU time). A
+ * configuration's accuracy on a grid is its worst scenario.
+ *
+ * The output is one Pareto table per grid: configurations sorted by time per tick, with '*'
+ * on those no other configuration beats on both time and worst-scenario P99 (by 0.1 %). With
+ * --max-p99 <m> the cheapest configuration meeting the requirement is named per grid.
+ *
+ * Usage:
+ *   bullseye_truth_harness [--filter <substr>] [--scenario <substr>] [--reps <n>] [--quick]
+ *                          [--max-p99 <m>] [--json <path|->]
+ *
+ * --filter selects configurations and --scenario the scenarios a grid's accuracy is taken
+ * over, so the sweep can be restricted to the operating envelope being tuned for.
+ *
+ * Exit status: 0, 1 if --max-p99 is given and some grid has no configuration meeting it,
+ * 2 on a usage, setup or file error. See docs/truth_comparison.md.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/bullseye_frame.hpp"
+#include "core/bullseye_frame_math.hpp"
+#include "core/frame_transforms.hpp"
+#include "core/math/universal_kepler.hpp"
+#include "core/provider_twobody.hpp"
+#include "core/provider_twobody_fleet.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/time_grid.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kEarthRadius = 6378.137e3;
+constexpr double kPi = 3.14159265358979323846;
+constexpr std::size_t kDeputies = (MAX_VEHICLES < 8u) ? MAX_VEHICLES : 8u;
+const char* const kFrame = "INERTIAL";
+
+// ------------------------------
+// Scenarios and truth
+// ------------------------------
+
+struct Scenario final
+{
+    const char* name;
+    double perigee_radius_m;
+    double eccentricity;
+    double true_anomaly_rad;
+    double inclination_rad;
+    double formation_scale_m; // deputy offsets up to this size (velocities ~ scale * n)
+};
+
+const Scenario kScenarios[] = {
+    {"leo_circular_1km", kEarthRadius + 400e3, 0.0005, 0.0, 0.9, 1e3},
+    {"leo_circular_20km", kEarthRadius + 400e3, 0.0005, 0.0, 0.9, 20e3},
+    {"leo_e0.05_1km", kEarthRadius + 400e3, 0.05, 1.0, 1.7, 1e3},
+    {"heo_e0.3_1km", kEarthRadius + 600e3, 0.3, -0.5, 0.5, 1e3},
+    {"gto_e0.7_1km", kEarthRadius + 300e3, 0.7, 0.3, 0.1, 1e3},
+};
+
+struct TwoBodyState final
+{
+    Vec3 r{};
+    Vec3 v{};
+};
+
+TwoBodyState chief_at_epoch(const Scenario& s) noexcept
+{
+    const double e = s.eccentricity;
+    const double f = s.true_anomaly_rad;
+    const double i = s.inclination_rad;
+    const double p = s.perigee_radius_m * (1.0 + e);
+    const double r = p / (1.0 + e * std::cos(f));
+    const double vs = std::sqrt(kMu / p);
+    const Vec3 r_pf{r * std::cos(f), r * std::sin(f), 0.0};
+    const Vec3 v_pf{-vs * std::sin(f), vs * (e + std::cos(f)), 0.0};
+    return TwoBodyState{Vec3{r_pf.x, r_pf.y * std::cos(i), r_pf.y * std::sin(i)},
+                        Vec3{v_pf.x, v_pf.y * std::cos(i), v_pf.y * std::sin(i)}};
+}
+
+ChiefState as_chief(const TwoBodyState& s, double t) noexcept
+{
+    ChiefState c{};
+    c.time_tag = t;
+    c.r_i = s.r;
+    c.v_i = s.v;
+    c.frame_id = kFrame;
+    c.status.code = ProviderCode::kOk;
+    return c;
+}
+
+// Converged two-body propagation (generous iteration cap; truth is computed once).
+bool propagate(const TwoBodyState& s0, double dt, TwoBodyState& out) noexcept
+{
+    if (dt == 0.0)
+    {
+        out = s0;
+        return true;
+    }
+    const double r0n = norm(s0.r);
+    const double alpha = 2.0 / r0n - dot(s0.v, s0.v) / kMu;
+    math::UniversalPropagation prop{};
+    if (!math::universal_propagate(s0.r, s0.v, kMu, dt,
+                                   math::universal_initial_guess(alpha, std::sqrt(kMu), r0n, dt),
+                                   200, prop))
+    {
+        return false;
+    }
+    out = TwoBodyState{prop.r_i, prop.v_i};
+    return true;
+}
+
+// Deterministic formation: RIC offsets in [-scale, scale], velocities in [-scale, scale] * n.
+std::vector<TwoBodyState> formation(const Scenario& s, const TwoBodyState& chief)
+{
+    std::uint64_t lcg = 0x9E3779B97F4A7C15ull;
+    auto unit = [&lcg]() noexcept
+    {
+        lcg = lcg * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<double>(lcg >> 11) * 0x1.0p-52 - 1.0;
+    };
+    const ConstructedRicFrame f = construct_ric_from_chief(as_chief(chief, 0.0));
+    const double r0n = norm(chief.r);
+    const double n = std::sqrt(kMu / (r0n * r0n * r0n));
+    std::vector<TwoBodyState> out(kDeputies);
+    for (TwoBodyState& d : out)
+    {
+        const Vec3 r_ric{s.formation_scale_m * unit(), s.formation_scale_m * unit(),
+                         s.formation_scale_m * unit()};
+        const Vec3 v_ric{s.formation_scale_m * n * unit(), s.formation_scale_m * n * unit(),
+                         s.formation_scale_m * n * unit()};
+        const RelState in = ric_to_inertial_relative(r_ric, v_ric, chief.r, chief.v,
+                                                     f.C_from_ric_to_inertial, f.omega_ric);
+        d = TwoBodyState{in.r, in.v};
+    }
+    return out;
+}
+
+struct GridSpec final
+{
+    const char* name;
+    double horizon_sec;
+    double cadence_sec;
+};
+
+// Horizon of @p intervals cadences, cut to what MAX_STEPS holds.
+constexpr double capped_horizon(double cadence_sec, std::size_t intervals) noexcept
+{
+    return cadence_sec * static_cast<double>((intervals < MAX_STEPS) ? intervals : MAX_STEPS - 1u);
+}
+
+// At most MAX_STEPS samples each; names give the horizon at the default capacity.
+const GridSpec kGrids[] = {
+    {"120s@1s", capped_horizon(1.0, 120u), 1.0},
+    {"599s@1s", capped_horizon(1.0, 599u), 1.0},
+    {"1797s@3s", capped_horizon(3.0, 599u), 3.0},
+    {"5391s@9s", capped_horizon(9.0, 599u), 9.0},
+};
+
+// Truth RIC positions [deputy][step] of one scenario on one grid.
+bool truth_positions(const TwoBodyState& chief, const std::vector<TwoBodyState>& deputies,
+                     const TimeGrid& grid, std::vector<Vec3>& out)
+{
+    const std::size_t steps = grid.tau.size();
+    out.assign(deputies.size() * steps, Vec3{});
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        TwoBodyState c{};
+        if (!propagate(chief, grid.tau[k], c))
+        {
+            return false;
+        }
+        const ConstructedRicFrame f = construct_ric_from_chief(as_chief(c, grid.tau[k]));
+        const Mat3 C_i2r = transpose(f.C_from_ric_to_inertial);
+        for (std::size_t i = 0; i < deputies.size(); ++i)
+        {
+            TwoBodyState d{};
+            if (!propagate(deputies[i], grid.tau[k], d))
+            {
+                return false;
+            }
+            out[i * steps + k] = mul(C_i2r, d.r - c.r);
+        }
+    }
+    return true;
+}
+
+// ------------------------------
+// Configurations
+// ------------------------------
+
+struct ConfigSpec final
+{
+    std::string name;
+    RelativePredictorConfig cfg{};
+};
+
+std::vector<ConfigSpec> sweep_configs()
+{
+    std::vector<ConfigSpec> out;
+    auto add = [&out](std::string name, const RelativePredictorConfig& cfg)
+    { out.push_back(ConfigSpec{std::move(name), cfg}); };
+
+    RelativePredictorConfig hcw{};
+    hcw.model = PredictorModel::kHcw;
+    add("hcw", hcw);
+    hcw.hcw_trig_reanchor_interval = 64;
+    add("hcw.trig64", hcw);
+
+    RelativePredictorConfig ya{};
+    ya.model = PredictorModel::kYaStm;
+    ya.ya_backend = YaStmBackend::kClosedForm;
+    add("ya.closed_form", ya);
+
+    ya.ya_backend = YaStmBackend::kRk4Reference;
+    for (const double dt : {0.25, 1.0, 3.0, 9.0, 30.0})
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "ya.rk4.dt%g", dt);
+        ya.ya_max_dt_sec = dt;
+        add(name, ya);
+    }
+
+    ya.ya_backend = YaStmBackend::kDormandPrince54;
+    ya.ya_max_dt_sec = 1.0;
+    for (const double tol : {1e-6, 1e-8, 1e-10})
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "ya.dp54.tol%g", tol);
+        ya.ya_rel_tol = tol;
+        ya.ya_abs_tol = 10.0 * tol;
+        add(name, ya);
+    }
+
+    RelativePredictorConfig autosel{};
+    autosel.model = PredictorModel::kAuto;
+    add("auto", autosel);
+    return out;
+}
+
+// ------------------------------
+// Runs
+// ------------------------------
+
+struct ErrorStats final
+{
+    double rms{0.0};
+    double p95{0.0};
+    double p99{0.0};
+    double max{0.0};
+};
+
+ErrorStats error_stats(std::vector<double>& err)
+{
+    ErrorStats s{};
+    if (err.empty())
+    {
+        return s;
+    }
+    double sum2 = 0.0;
+    for (const double e : err)
+    {
+        sum2 += e * e;
+    }
+    std::sort(err.begin(), err.end());
+    auto pct = [&err](double p)
+    {
+        const auto rank = static_cast<std::size_t>(
+            std::ceil(p * 0.01 * static_cast<double>(err.size())));
+        return err[std::min(err.size(), std::max<std::size_t>(rank, 1)) - 1];
+    };
+    s.rms = std::sqrt(sum2 / static_cast<double>(err.size()));
+    s.p95 = pct(95.0);
+    s.p99 = pct(99.0);
+    s.max = err.back();
+    return s;
+}
+
+// One scenario behind one predictor (heap-held: the publisher is large).
+struct PredictorRig final
+{
+    VehicleIndexMap map{kDeputies};
+    TwoBodyChiefProvider chief;
+    TwoBodyVehicleProvider deputies{kFrame, kMu};
+    BullseyeFrame bullseye{chief, nullptr, BullseyeFrameMode::kConstructedOnly};
+    Publisher pub;
+    RelativePredictor pred;
+
+    PredictorRig(const TwoBodyState& c0, const std::vector<TwoBodyState>& deps,
+                 const RelativePredictorConfig& cfg)
+        : chief(kFrame, kMu, 0.0, c0.r, c0.v), pred(pub, map, chief, deputies, bullseye, cfg)
+    {
+        for (std::size_t i = 0; i < deps.size(); ++i)
+        {
+            const auto id = static_cast<VehicleIndexMap::VehicleId>(i + 1);
+            (void)deputies.add_vehicle(id, 0.0, deps[i].r, deps[i].v);
+            (void)map.register_vehicle(id);
+        }
+    }
+};
+
+struct ScenarioResult final
+{
+    const char* scenario{nullptr};
+    ErrorStats err{};
+    double ns_per_tick{0.0};
+};
+
+struct SweepRow final
+{
+    const GridSpec* grid{nullptr};
+    std::string config;
+    std::vector<ScenarioResult> scenarios;
+    ErrorStats worst{}; // component-wise worst scenario
+    const char* worst_p99_scenario{nullptr};
+    double ns_per_tick{0.0}; // mean over scenarios
+    bool pareto{false};
+};
+
+struct Options final
+{
+    const char* filter{nullptr};
+    const char* scenario{nullptr};
+    int reps{15};
+    double max_p99_m{-1.0};
+    const char* json_path{nullptr};
+    bool quick{false};
+};
+
+// Accuracy tick at t0 = 0, then the median of opt.reps timed ticks.
+bool run_scenario(const Options& opt, const RelativePredictorConfig& cfg, const GridSpec& g,
+                  const TwoBodyState& chief, const std::vector<TwoBodyState>& deps,
+                  const std::vector<Vec3>& truth, ScenarioResult& out)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto rig = std::make_unique<PredictorRig>(chief, deps, cfg);
+    rig->pred.step(0.0, g.horizon_sec, g.cadence_sec);
+    const PredictionBuffer& b = rig->pub.read();
+    const std::size_t steps = truth.size() / deps.size();
+    if (b.steps != steps || b.valid_rows != (RowMask{1} << deps.size()) - 1u)
+    {
+        std::fprintf(stderr, "truth: tick failed (steps=%zu valid_rows=%llx)\n", b.steps,
+                     static_cast<unsigned long long>(b.valid_rows));
+        return false;
+    }
+    std::vector<double> err;
+    err.reserve(truth.size());
+    for (std::size_t i = 0; i < deps.size(); ++i)
+    {
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            err.push_back(norm(b.positions[i][k] - truth[i * steps + k]));
+        }
+    }
+    out.err = error_stats(err);
+
+    std::vector<double> ns(static_cast<std::size_t>(opt.reps));
+    for (int r = 0; r < opt.reps; ++r)
+    {
+        const double t0 = g.cadence_sec * static_cast<double>(r + 1);
+        const auto t_begin = Clock::now();
+        rig->pred.step(t0, g.horizon_sec, g.cadence_sec);
+        ns[static_cast<std::size_t>(r)] =
+            std::chrono::duration<double, std::nano>(Clock::now() - t_begin).count();
+    }
+    std::sort(ns.begin(), ns.end());
+    out.ns_per_tick = ns[ns.size() / 2];
+    return true;
+}
+
+bool run_sweep(const Options& opt, std::vector<SweepRow>& rows)
+{
+    const std::vector<ConfigSpec> configs = sweep_configs();
+    for (const GridSpec& g : kGrids)
+    {
+        if (opt.quick && g.horizon_sec > 600.0)
+        {
+            continue;
+        }
+        const TimeGrid grid = make_time_grid(g.horizon_sec, g.cadence_sec);
+        std::vector<TwoBodyState> chiefs;
+        std::vector<std::vector<TwoBodyState>> deps;
+        std::vector<std::vector<Vec3>> truth;
+        std::vector<const Scenario*> used;
+        for (const Scenario& s : kScenarios)
+        {
+            if (opt.scenario != nullptr && std::strstr(s.name, opt.scenario) == nullptr)
+            {
+                continue;
+            }
+            used.push_back(&s);
+            chiefs.push_back(chief_at_epoch(s));
+            deps.push_back(formation(s, chiefs.back()));
+            truth.emplace_back();
+            if (!truth_positions(chiefs.back(), deps.back(), grid, truth.back()))
+            {
+                std::fprintf(stderr, "truth: propagation failed (%s)\n", s.name);
+                return false;
+            }
+        }
+        if (used.empty())
+        {
+            std::fprintf(stderr, "truth: no scenario matches '%s'\n", opt.scenario);
+            return false;
+        }
+
+        const std::size_t first = rows.size();
+        for (const ConfigSpec& c : configs)
+        {
+            if (opt.filter != nullptr && std::strstr(c.name.c_str(), opt.filter) == nullptr)
+            {
+                continue;
+            }
+            SweepRow row{};
+            row.grid = &g;
+            row.config = c.name;
+            for (std::size_t s = 0; s < chiefs.size(); ++s)
+            {
+                ScenarioResult res{};
+                res.scenario = used[s]->name;
+                if (!run_scenario(opt, c.cfg, g, chiefs[s], deps[s], truth[s], res))
+                {
+                    std::fprintf(stderr, "truth: %s failed on %s / %s\n", c.name.c_str(),
+                                 used[s]->name, g.name);
+                    return false;
+                }
+                row.worst.rms = std::max(row.worst.rms, res.err.rms);
+                row.worst.p95 = std::max(row.worst.p95, res.err.p95);
+                if (row.worst_p99_scenario == nullptr || res.err.p99 > row.worst.p99)
+                {
+                    row.worst.p99 = res.err.p99;
+                    row.worst_p99_scenario = res.scenario;
+                }
+                row.worst.max = std::max(row.worst.max, res.err.max);
+                row.ns_per_tick += res.ns_per_tick / static_cast<double>(chiefs.size());
+                row.scenarios.push_back(res);
+            }
+            rows.push_back(std::move(row));
+        }
+
+        // Pareto front on (time per tick, worst P99), cheapest first. A P99 less than 0.1 %
+        // below a cheaper row's is integration noise, not an improvement.
+        std::sort(rows.begin() + static_cast<std::ptrdiff_t>(first), rows.end(),
+                  [](const SweepRow& a, const SweepRow& b)
+                  { return a.ns_per_tick < b.ns_per_tick; });
+        double best_p99 = HUGE_VAL;
+        for (std::size_t i = first; i < rows.size(); ++i)
+        {
+            rows[i].pareto = rows[i].worst.p99 < best_p99 * (1.0 - 1e-3);
+            best_p99 = std::min(best_p99, rows[i].worst.p99);
+        }
+    }
+    return true;
+}
+
+// ------------------------------
+// Reporting
+// ------------------------------
+
+// Cheapest row of grid g meeting the requirement, or nullptr.
+const SweepRow* cheapest_meeting(const std::vector<SweepRow>& rows, const GridSpec& g,
+                                 double max_p99_m)
+{
+    for (const SweepRow& r : rows)
+    {
+        if (r.grid == &g && r.worst.p99 <= max_p99_m)
+        {
+            return &r; // rows of a grid are sorted by time
+        }
+    }
+    return nullptr;
+}
+
+void print_tables(const std::vector<SweepRow>& rows)
+{
+    const GridSpec* current = nullptr;
+    for (const SweepRow& r : rows)
+    {
+        if (r.grid != current)
+        {
+            current = r.grid;
+            std::printf("\ngrid %s (worst of %zu scenarios, %zu deputies each)\n", current->name,
+                        r.scenarios.size(), kDeputies);
+            std::printf("  %-18s %14s %12s %12s %12s %12s  %s\n", "config", "ns/tick", "rms_m",
+                        "p95_m", "p99_m", "max_m", "p99 scenario");
+        }
+        std::printf("%c %-18s %14.0f %12.4e %12.4e %12.4e %12.4e  %s\n", r.pareto ? '*' : ' ',
+                    r.config.c_str(), r.ns_per_tick, r.worst.rms, r.worst.p95, r.worst.p99,
+                    r.worst.max, r.worst_p99_scenario);
+    }
+}
+
+bool write_json(const char* path, const std::vector<SweepRow>& rows)
+{
+    std::FILE* f = (std::strcmp(path, "-") == 0) ? stdout : std::fopen(path, "w");
+    if (f == nullptr)
+    {
+        std::fprintf(stderr, "truth: cannot write %s\n", path);
+        return false;
+    }
+    std::fprintf(f, "{\n  \"schema\": \"bullseye-truth-1\",\n  \"deputies\": %zu,\n"
+                    "  \"rows\": [\n",
+                 kDeputies);
+    for (std::size_t i = 0; i < rows.size(); ++i)
+    {
+        const SweepRow& r = rows[i];
+        std::fprintf(f,
+                     "    {\"grid\": \"%s\", \"horizon_sec\": %g, \"cadence_sec\": %g, "
+                     "\"config\": \"%s\", \"ns_per_tick\": %.1f, \"pareto\": %s, "
+                     "\"worst\": {\"rms_m\": %.6e, \"p95_m\": %.6e, \"p99_m\": %.6e, "
+                     "\"max_m\": %.6e}, \"worst_p99_scenario\": \"%s\", \"scenarios\": [",
+                     r.grid->name, r.grid->horizon_sec, r.grid->cadence_sec, r.config.c_str(),
+                     r.ns_per_tick, r.pareto ? "true" : "false", r.worst.rms, r.worst.p95,
+                     r.worst.p99, r.worst.max, r.worst_p99_scenario);
+        for (std::size_t s = 0; s < r.scenarios.size(); ++s)
+        {
+            const ScenarioResult& sc = r.scenarios[s];
+            std::fprintf(f,
+                         "%s{\"name\": \"%s\", \"ns_per_tick\": %.1f, \"rms_m\": %.6e, "
+                         "\"p95_m\": %.6e, \"p99_m\": %.6e, \"max_m\": %.6e}",
+                         (s == 0) ? "" : ", ", sc.scenario, sc.ns_per_tick, sc.err.rms,
+                         sc.err.p95, sc.err.p99, sc.err.max);
+        }
+        std::fprintf(f, "]}%s\n", (i + 1 < rows.size()) ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    if (f != stdout)
+    {
+        std::fclose(f);
+    }
+    return true;
+}
+
+int usage()
+{
+    std::fprintf(stderr,
+                 "usage: bullseye_truth_harness [--filter <substr>] [--scenario <substr>] "
+                 "[--reps <n>] [--quick] [--max-p99 <m>] [--json <path|->]\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt{};
+    for (int i = 1; i < argc; ++i)
+    {
+        const char* a = argv[i];
+        const bool has_value = (i + 1 < argc);
+        if (std::strcmp(a, "--quick") == 0)
+        {
+            opt.quick = true;
+            opt.reps = 1;
+        }
+        else if (std::strcmp(a, "--filter") == 0 && has_value)
+        {
+            opt.filter = argv[++i];
+        }
+        else if (std::strcmp(a, "--scenario") == 0 && has_value)
+        {
+            opt.scenario = argv[++i];
+        }
+        else if (std::strcmp(a, "--reps") == 0 && has_value)
+        {
+            opt.reps = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(a, "--max-p99") == 0 && has_value)
+        {
+            opt.max_p99_m = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(a, "--json") == 0 && has_value)
+        {
+            opt.json_path = argv[++i];
+        }
+        else
+        {
+            return usage();
+        }
+    }
+
+    std::vector<SweepRow> rows;
+    if (!run_sweep(opt, rows))
+    {
+        return 2;
+    }
+    print_tables(rows);
+    if (opt.json_path != nullptr && !write_json(opt.json_path, rows))
+    {
+        return 2;
+    }
+    if (!(opt.max_p99_m >= 0.0))
+    {
+        return 0;
+    }
+
+    int missing = 0;
+    std::printf("\ncheapest configuration with worst-scenario P99 <= %g m:\n", opt.max_p99_m);
+    for (const GridSpec& g : kGrids)
+    {
+        if (opt.quick && g.horizon_sec > 600.0)
+        {
+            continue;
+        }
+        const SweepRow* best = cheapest_meeting(rows, g, opt.max_p99_m);
+        if (best == nullptr)
+        {
+            std::printf("  %-10s none\n", g.name);
+            ++missing;
+            continue;
+        }
+        std::printf("  %-10s %-18s %12.0f ns/tick, p99 %.4e m\n", g.name, best->config.c_str(),
+                    best->ns_per_tick, best->worst.p99);
+    }
+    return (missing == 0) ? 0 : 1;
+}
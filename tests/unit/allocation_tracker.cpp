@@ -0,0 +1,187 @@
+// tests/unit/allocation_tracker.cpp
+#include "allocation_tracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace bullseye_pred::testing
+{
+namespace
+{
+
+// Constant-initialized, so they are usable from the first allocation of any thread.
+thread_local AllocationCounts t_counts{};
+std::atomic<std::uint64_t> g_allocations{0};
+std::atomic<std::uint64_t> g_deallocations{0};
+std::atomic<std::uint64_t> g_bytes{0};
+
+void note_allocation(std::size_t bytes) noexcept
+{
+    ++t_counts.allocations;
+    t_counts.bytes += bytes;
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void note_deallocation() noexcept
+{
+    ++t_counts.deallocations;
+    g_deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* allocate(std::size_t bytes) noexcept
+{
+    note_allocation(bytes);
+    return std::malloc(bytes != 0 ? bytes : 1);
+}
+
+void* allocate_aligned(std::size_t bytes, std::align_val_t align) noexcept
+{
+    note_allocation(bytes);
+    const std::size_t a = std::max(static_cast<std::size_t>(align), sizeof(void*));
+    void* p = nullptr;
+    return (posix_memalign(&p, a, bytes != 0 ? bytes : 1) == 0) ? p : nullptr;
+}
+
+void release(void* p) noexcept
+{
+    if (p != nullptr)
+    {
+        note_deallocation();
+        std::free(p);
+    }
+}
+
+void* checked(void* p)
+{
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+} // namespace
+
+AllocationCounts thread_allocation_counts() noexcept
+{
+    return t_counts;
+}
+
+AllocationCounts process_allocation_counts() noexcept
+{
+    return AllocationCounts{g_allocations.load(std::memory_order_relaxed),
+                            g_deallocations.load(std::memory_order_relaxed),
+                            g_bytes.load(std::memory_order_relaxed)};
+}
+
+} // namespace bullseye_pred::testing
+
+namespace at = bullseye_pred::testing;
+
+// ------------------------------
+// Replaceable global allocation functions
+// ------------------------------
+
+void* operator new(std::size_t n)
+{
+    return at::checked(at::allocate(n));
+}
+
+void* operator new[](std::size_t n)
+{
+    return at::checked(at::allocate(n));
+}
+
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept
+{
+    return at::allocate(n);
+}
+
+void* operator new[](std::size_t n, const std::nothrow_t&) noexcept
+{
+    return at::allocate(n);
+}
+
+void* operator new(std::size_t n, std::align_val_t a)
+{
+    return at::checked(at::allocate_aligned(n, a));
+}
+
+void* operator new[](std::size_t n, std::align_val_t a)
+{
+    return at::checked(at::allocate_aligned(n, a));
+}
+
+void* operator new(std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept
+{
+    return at::allocate_aligned(n, a);
+}
+
+void* operator new[](std::size_t n, std::align_val_t a, const std::nothrow_t&) noexcept
+{
+    return at::allocate_aligned(n, a);
+}
+
+void operator delete(void* p) noexcept
+{
+    at::release(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    at::release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    at::release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+    at::release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+    at::release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+    at::release(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+    at::release(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept
+{
+    at::release(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+    at::release(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept
+{
+    at::release(p);
+}
+
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    at::release(p);
+}
+
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    at::release(p);
+}
@@ -0,0 +1,83 @@
+// tests/unit/allocation_tracker.hpp
+#pragma once
+/**
+ * @file allocation_tracker.hpp
+ * @brief Heap-allocation counters for the unit tests (replaceable global operator new/delete).
+ *
+ * @details
+ * allocation_tracker.cpp replaces every global operator new / delete of the test binary with
+ * versions that count calls and bytes before forwarding to malloc / free. Counters are kept
+ * per thread (no contention, unaffected by other threads) and process-wide (catches work
+ * handed to worker or predictor threads).
+ *
+ * Tests wrap the code under test in a ScopedAllocationCounter and assert on its delta:
+ *
+ *   ScopedAllocationCounter allocs(AllocationScope::kProcess);
+ *   pred.step(t, 599.0, 1.0);
+ *   REQUIRE(allocs.allocations() == 0u);
+ *
+ * Keep Catch2 assertions outside a kProcess scope where possible: the framework allocates
+ * while recording results. A kThread scope only sees the current thread.
+ */
+
+#include <cstdint>
+
+namespace bullseye_pred::testing
+{
+
+/** @brief Cumulative counters since process (or thread) start. */
+struct AllocationCounts final
+{
+    std::uint64_t allocations{0};
+    std::uint64_t deallocations{0};
+    std::uint64_t bytes{0};
+};
+
+/** @brief Counters of the calling thread. */
+AllocationCounts thread_allocation_counts() noexcept;
+
+/** @brief Counters summed over every thread. */
+AllocationCounts process_allocation_counts() noexcept;
+
+enum class AllocationScope : std::uint8_t
+{
+    kThread,  ///< Calling thread only.
+    kProcess, ///< Every thread.
+};
+
+/**
+ * @brief Counts allocations made between construction and the query.
+ */
+class ScopedAllocationCounter final
+{
+  public:
+    explicit ScopedAllocationCounter(AllocationScope scope = AllocationScope::kThread) noexcept
+        : scope_(scope), start_(now_())
+    {
+    }
+
+    ScopedAllocationCounter(const ScopedAllocationCounter&) = delete;
+    ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+
+    /** @brief Deltas since construction. */
+    [[nodiscard]] AllocationCounts counts() const noexcept
+    {
+        const AllocationCounts n = now_();
+        return AllocationCounts{n.allocations - start_.allocations,
+                                n.deallocations - start_.deallocations, n.bytes - start_.bytes};
+    }
+
+    [[nodiscard]] std::uint64_t allocations() const noexcept { return counts().allocations; }
+
+  private:
+    [[nodiscard]] AllocationCounts now_() const noexcept
+    {
+        return (scope_ == AllocationScope::kThread) ? thread_allocation_counts()
+                                                    : process_allocation_counts();
+    }
+
+    AllocationScope scope_;
+    AllocationCounts start_;
+};
+
+} // namespace bullseye_pred::testing
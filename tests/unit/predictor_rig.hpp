@@ -0,0 +1,137 @@
+// tests/unit/predictor_rig.hpp
+#pragma once
+/**
+ * @file predictor_rig.hpp
+ * @brief Fixed chief and deputy providers and a predictor rig for the unit tests.
+ *
+ * @details
+ * FixedChief reports one state at every t0. FixedVehicles puts deputy @c id at the chief plus
+ * id times a per-id offset, so every deputy sits on its own relative orbit. A Rig wires both
+ * to a VehicleIndexMap, Publisher, BullseyeFrame and predictor:
+ *
+ *   RigOptions opt;
+ *   opt.publisher.velocities = true;
+ *   static Rig<HcwRelativePredictor> rig(opt); // the publisher is large: static or heap
+ *   rig.pred.step(0.0, 600.0, 10.0);
+ *
+ * Extra constructor arguments go to the predictor's policy (see BasicRelativePredictor).
+ */
+
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "core/bullseye_frame.hpp"
+#include "core/chief_state_provider.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/state_covariance.hpp"
+#include "core/vehicle_index_map.hpp"
+
+namespace bullseye_pred::testing
+{
+
+/** @brief The chief provider: s, re-tagged with each t0. */
+class FixedChief final : public IChiefStateProvider
+{
+  public:
+    ChiefState s{};
+
+    [[nodiscard]] ChiefState get(double t0) noexcept override
+    {
+        s.time_tag = t0;
+        return s;
+    }
+};
+
+/**
+ * @brief Deputy @c id at chief + (id * dr_per_id, dv + id * dv_per_id), inertial.
+ *
+ * Vehicle covariance_id (0 = none) also reports @c covariance.
+ */
+class FixedVehicles final : public IVehicleStateProvider
+{
+  public:
+    ChiefState chief{};
+    Vec3 dr_per_id{50.0, -100.0, 25.0};
+    Vec3 dv{};
+    Vec3 dv_per_id{0.0, 0.01, 0.0};
+    VehicleIndexMap::VehicleId covariance_id{0};
+    StateCovariance covariance{};
+
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override
+    {
+        const double k = static_cast<double>(id);
+        VehicleState s{};
+        s.r_i = chief.r_i + dr_per_id * k;
+        s.v_i = chief.v_i + dv + dv_per_id * k;
+        s.frame_id = chief.frame_id;
+        s.time_tag = t0;
+        s.status.code = ProviderCode::kOk;
+        return s;
+    }
+
+    [[nodiscard]] bool get_covariance(VehicleIndexMap::VehicleId id,
+                                      double /*t0*/,
+                                      StateCovariance& out) noexcept override
+    {
+        if (covariance_id == 0u || id != covariance_id)
+        {
+            return false;
+        }
+        out = covariance;
+        return true;
+    }
+};
+
+/** @brief Chief orbit, deputies, publisher and frame source of a Rig. */
+struct RigOptions final
+{
+    double mu{3.986004418e14};
+
+    /** @brief Chief at (r, 0, 0) with speed speed_scale * sqrt(mu / r) (1 = circular). */
+    double chief_radius_m{7000e3};
+    double chief_speed_scale{1.0};
+    double chief_inclination_rad{0.0};
+
+    std::vector<VehicleIndexMap::VehicleId> vehicles{1u, 2u};
+    PublisherConfig publisher{};
+    BullseyeFrameMode frame_mode{BullseyeFrameMode::kConstructedOnly};
+
+    /** @brief Adopted frame source (only stored by the BullseyeFrame; must outlive the rig). */
+    IBullseyeFrameProvider* adopted{nullptr};
+};
+
+template <typename Predictor>
+struct Rig
+{
+    FixedChief chief;
+    FixedVehicles veh;
+    VehicleIndexMap map;
+    Publisher pub;
+    BullseyeFrame bullseye;
+    Predictor pred;
+
+    Rig() : Rig(RigOptions{}) {}
+
+    template <typename... PolicyArgs>
+    explicit Rig(const RigOptions& opt, PolicyArgs&&... args)
+        : pub(opt.publisher), bullseye(chief, opt.adopted, opt.frame_mode),
+          pred(pub, map, chief, veh, bullseye, std::forward<PolicyArgs>(args)...)
+    {
+        const double r = opt.chief_radius_m;
+        const double v = opt.chief_speed_scale * std::sqrt(opt.mu / r);
+        chief.s.r_i = Vec3{r, 0.0, 0.0};
+        chief.s.v_i = Vec3{0.0, v * std::cos(opt.chief_inclination_rad),
+                           v * std::sin(opt.chief_inclination_rad)};
+        chief.s.frame_id = "INERTIAL";
+        chief.s.status.code = ProviderCode::kOk;
+        veh.chief = chief.s;
+        for (const VehicleIndexMap::VehicleId id : opt.vehicles)
+        {
+            (void)map.register_vehicle(id);
+        }
+    }
+};
+
+} // namespace bullseye_pred::testing
@@ -0,0 +1,200 @@
+// tests/unit/test_async_predictor.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <thread>
+
+#include "core/async_predictor.hpp"
+#include "core/bullseye_frame.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/types.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "models/relative_model.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+class FixedChief final : public IChiefStateProvider
+{
+  public:
+    ChiefState s{};
+    [[nodiscard]] ChiefState get(double t0) noexcept override
+    {
+        ChiefState out = s;
+        out.time_tag = t0;
+        return out;
+    }
+};
+
+// Deputy id k sits k * 50 m radially out; state moves with t0 so every tick differs.
+class OffsetVehicles final : public IVehicleStateProvider
+{
+  public:
+    VehicleState nominal{};
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override
+    {
+        VehicleState s = nominal;
+        s.time_tag = t0;
+        s.r_i.x += 50.0 * static_cast<double>(id) + 0.1 * t0;
+        s.v_i.y += 0.01 * static_cast<double>(id);
+        return s;
+    }
+};
+
+struct AsyncRig
+{
+    VehicleIndexMap map;
+    FixedChief chief;
+    OffsetVehicles veh;
+
+    AsyncRig()
+    {
+        const double mu = 3.986004418e14;
+        const double r0 = 7000e3;
+        chief.s.r_i = Vec3{r0, 0.0, 0.0};
+        chief.s.v_i = Vec3{0.0, std::sqrt(mu / r0), 0.0};
+        chief.s.frame_id = "INERTIAL";
+        chief.s.status.code = ProviderCode::kOk;
+        veh.nominal.r_i = chief.s.r_i;
+        veh.nominal.v_i = chief.s.v_i;
+        veh.nominal.frame_id = chief.s.frame_id;
+        veh.nominal.status.code = ProviderCode::kOk;
+        for (VehicleIndexMap::VehicleId id = 1; id <= 4; ++id)
+        {
+            (void)map.register_vehicle(id);
+        }
+    }
+};
+
+// HCW-shaped output that blocks the first call until released.
+class GateModel final : public IRelativeModel
+{
+  public:
+    mutable std::atomic<bool> entered{false};
+    std::atomic<bool> release{false};
+
+    Result predict_hcw(const RelStateRic& x0,
+                       const HcwParams& /*params*/,
+                       const TimeGrid& grid,
+                       Span<Vec3> out_r,
+                       Span<Vec3> /*out_v*/) const noexcept override
+    {
+        entered.store(true);
+        while (!release.load())
+        {
+            std::this_thread::yield();
+        }
+        for (std::size_t k = 0; k < grid.tau.size(); ++k)
+        {
+            out_r[k] = x0.r_ric;
+        }
+        return Result{ModelCode::kOk, grid.tau.size()};
+    }
+};
+
+} // namespace
+
+TEST_CASE("Async predictor publishes the same snapshot as a synchronous step", "[async]")
+{
+    const auto rig_sync = std::make_unique<AsyncRig>();
+    const auto rig_async = std::make_unique<AsyncRig>();
+    BullseyeFrame be_sync(rig_sync->chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    const auto pub_sync = std::make_unique<Publisher>();
+    const auto pub_async = std::make_unique<Publisher>();
+    const auto sync = std::make_unique<HcwRelativePredictor>(
+        *pub_sync, rig_sync->map, rig_sync->chief, rig_sync->veh, be_sync);
+    const auto async = std::make_unique<AsyncHcwRelativePredictor>(
+        *pub_async, rig_async->map, rig_async->chief, rig_async->veh, nullptr,
+        BullseyeFrameMode::kConstructedOnly);
+    REQUIRE(async->running());
+
+    for (int tick = 0; tick < 4; ++tick)
+    {
+        const double t0 = 5.0 * tick;
+        if (tick == 2)
+        {
+            // Registration changes on the sim side are picked up by the next capture.
+            REQUIRE(rig_sync->map.unregister_vehicle(2u).has_value());
+            REQUIRE(rig_async->map.unregister_vehicle(2u).has_value());
+        }
+        sync->step(t0, 60.0, 1.0);
+        REQUIRE(async->submit(t0, 60.0, 1.0));
+        REQUIRE(async->wait_idle(30.0));
+
+        const PredictionBuffer& a = pub_sync->read();
+        const PredictionBuffer& b = pub_async->read();
+        const AsyncPredictorStats st = async->stats();
+        REQUIRE(b.t0 == a.t0);
+        REQUIRE(b.valid_rows == a.valid_rows);
+        REQUIRE(b.steps == a.steps);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            REQUIRE(b.row_status[i] == a.row_status[i]);
+            REQUIRE(std::memcmp(b.positions[i].data(), a.positions[i].data(),
+                                a.steps * sizeof(Vec3)) == 0);
+        }
+        REQUIRE(st.processed + st.superseded == st.submitted);
+        REQUIRE(st.last_latency_sec >= 0.0);
+    }
+    REQUIRE(pub_async->read().valid_rows == 0xDu);
+}
+
+TEST_CASE("Async predictor keeps the latest input and counts superseded ones", "[async]")
+{
+    const auto rig = std::make_unique<AsyncRig>();
+    const auto pub = std::make_unique<Publisher>();
+    GateModel model;
+    const auto async = std::make_unique<AsyncRelativePredictor>(
+        *pub, rig->map, rig->chief, rig->veh, nullptr, BullseyeFrameMode::kConstructedOnly,
+        static_cast<const IRelativeModel&>(model));
+
+    // The first tick blocks inside the model; later submits return without waiting.
+    REQUIRE(async->submit(0.0, 10.0, 1.0));
+    while (!model.entered.load())
+    {
+        std::this_thread::yield();
+    }
+    REQUIRE(async->submit(1.0, 10.0, 1.0));
+    REQUIRE(async->submit(2.0, 10.0, 1.0));
+    REQUIRE(async->submit(3.0, 10.0, 1.0));
+    REQUIRE_FALSE(async->wait_idle(0.01));
+    REQUIRE(pub->published_seqno() == 0);
+
+    AsyncPredictorStats st = async->stats();
+    REQUIRE(st.submitted == 4);
+    REQUIRE(st.superseded == 2);
+
+    model.release.store(true);
+    REQUIRE(async->wait_idle(30.0));
+    st = async->stats();
+    REQUIRE(st.processed == 2);
+    REQUIRE(st.max_latency_sec >= st.last_latency_sec);
+    REQUIRE(pub->published_seqno() == 2);
+    REQUIRE(pub->read().t0 == 3.0);
+}
+
+TEST_CASE("Async predictor does not publish a tick whose chief capture failed", "[async]")
+{
+    const auto rig = std::make_unique<AsyncRig>();
+    const auto pub = std::make_unique<Publisher>();
+    const auto async = std::make_unique<AsyncHcwRelativePredictor>(
+        *pub, rig->map, rig->chief, rig->veh, nullptr, BullseyeFrameMode::kConstructedOnly);
+
+    REQUIRE(async->submit(0.0, 10.0, 1.0));
+    REQUIRE(async->wait_idle(30.0));
+    REQUIRE(pub->published_seqno() == 1);
+
+    rig->chief.s.status.code = ProviderCode::kTimeMissing;
+    REQUIRE(async->submit(1.0, 10.0, 1.0));
+    REQUIRE(async->wait_idle(30.0));
+    REQUIRE(async->stats().processed == 2);
+    REQUIRE(pub->published_seqno() == 1);
+    REQUIRE(pub->read().t0 == 0.0);
+}
@@ -6,6 +6,7 @@
 #include <cmath>
 
 #include "core/bullseye_frame_math.hpp"
+#include "core/math/quaternion.hpp"
 #include "core/types.hpp"
 
 using bullseye_pred::ChiefState;
@@ -111,3 +112,81 @@ TEST_CASE("Constructed RIC: in-track aligns with transverse direction (h x r)",
     // Align up to sign? In this construction we enforce right-handedness, so it should be +1.
     REQUIRE(dot(eI, eI_expected) == Catch::Approx(1.0).epsilon(1e-12));
 }
+
+TEST_CASE("Quaternion <-> DCM round trip on constructed RIC frames", "[bullseye_math][quat]")
+{
+    namespace m = bullseye_pred::math;
+
+    // Chiefs chosen so every Shepperd branch (trace, x, y, z largest) is exercised.
+    const Vec3 rs[] = {Vec3{7000e3, 0.0, 0.0}, Vec3{0.0, 7000e3, 0.0}, Vec3{-7000e3, 10e3, 0.0},
+                       Vec3{0.0, 0.0, 7000e3}, Vec3{4000e3, -3000e3, 5000e3}};
+    const Vec3 vs[] = {Vec3{0.0, 7.5e3, 0.0}, Vec3{0.0, 0.0, 7.5e3}, Vec3{0.0, -7.5e3, 0.0},
+                       Vec3{7.5e3, 0.0, 0.0}, Vec3{-3.0e3, 1.0e3, 4.0e3}};
+    for (int k = 0; k < 5; ++k)
+    {
+        ChiefState chief{};
+        chief.r_i = rs[k];
+        chief.v_i = vs[k];
+        chief.status.code = ProviderCode::kOk;
+        const auto ric = construct_ric_from_chief(chief);
+        REQUIRE(ric.status.code == ProviderCode::kOk);
+        const Mat3& C = ric.C_from_ric_to_inertial;
+
+        const m::Quat q = m::quat_from_dcm(C);
+        REQUIRE(q.w >= 0.0);
+        REQUIRE(m::quat_dot(q, q) == Catch::Approx(1.0).epsilon(1e-15));
+
+        const Mat3 C2 = m::dcm_from_quat(q);
+        for (int r = 0; r < 3; ++r)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                REQUIRE(C2(r, c) == Catch::Approx(C(r, c)).margin(1e-14));
+            }
+        }
+        require_orthonormal_right_handed(C2);
+
+        const Vec3 v{1.0, -2.0, 3.0};
+        const Vec3 a = mul(C2, v);
+        const Vec3 b = m::quat_rotate(q, v);
+        REQUIRE(norm(a - b) <= 1e-14);
+    }
+}
+
+TEST_CASE("Quaternion slerp blends at constant rate along the shorter arc", "[bullseye_math][quat]")
+{
+    namespace m = bullseye_pred::math;
+
+    // 90 deg about z; b is given in the opposite hemisphere to exercise the sign flip.
+    const m::Quat a{};
+    const double h = std::sqrt(0.5);
+    const m::Quat b{-h, 0.0, 0.0, -h};
+    REQUIRE(m::quat_angle_between(a, b) == Catch::Approx(M_PI / 2.0).epsilon(1e-14));
+
+    double prev = -1.0;
+    for (int i = 0; i <= 10; ++i)
+    {
+        const double s = 0.1 * i;
+        const m::Quat q = m::quat_slerp(a, b, s);
+        REQUIRE(m::quat_dot(q, q) == Catch::Approx(1.0).epsilon(1e-15));
+        const double ang = m::quat_angle_between(a, q);
+        REQUIRE(ang == Catch::Approx(s * M_PI / 2.0).margin(1e-12));
+        REQUIRE(ang > prev);
+        prev = ang;
+
+        // nlerp stays on the same great circle, monotone but not at a uniform rate.
+        const m::Quat n = m::quat_nlerp(a, b, s);
+        REQUIRE(m::quat_dot(n, n) == Catch::Approx(1.0).epsilon(1e-15));
+        REQUIRE(m::quat_angle_between(a, n) + m::quat_angle_between(n, b) ==
+                Catch::Approx(M_PI / 2.0).epsilon(1e-12));
+    }
+
+    // Near-identical rotations take the nlerp branch and stay finite.
+    const m::Quat c{std::cos(1e-9), 0.0, std::sin(1e-9), 0.0};
+    const m::Quat mid = m::quat_slerp(a, c, 0.5);
+    REQUIRE(m::quat_finite(mid));
+    REQUIRE(m::quat_angle_between(a, mid) == Catch::Approx(1e-9).epsilon(1e-6));
+
+    m::Quat zero{0.0, 0.0, 0.0, 0.0};
+    REQUIRE_FALSE(m::quat_normalize(zero));
+}
@@ -0,0 +1,29 @@
+// tests/unit/test_capacity.hpp
+#pragma once
+/**
+ * @file test_capacity.hpp
+ * @brief Skips tests that need more rows or samples than the build's capacity.
+ *
+ * @details
+ * MAX_VEHICLES and MAX_STEPS are build options (BULLSEYE_MAX_VEHICLES / BULLSEYE_MAX_STEPS).
+ * Tests size themselves from them where they can; a test whose scenario only makes sense at
+ * a given size (a 32-vehicle fleet, a 121-sample grid) ends early with a warning instead:
+ *
+ *   BULLSEYE_SKIP_BELOW_CAPACITY(32u, 121u);
+ *
+ * Use it at the top of a TEST_CASE or of a void helper it calls.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/constants.hpp"
+
+#define BULLSEYE_SKIP_BELOW_CAPACITY(vehicles, steps)                                           \
+    do                                                                                           \
+    {                                                                                            \
+        if (::bullseye_pred::MAX_VEHICLES < (vehicles) || ::bullseye_pred::MAX_STEPS < (steps)) \
+        {                                                                                        \
+            WARN("skipped: needs " << (vehicles) << " rows of " << (steps) << " samples");      \
+            return;                                                                              \
+        }                                                                                        \
+    } while (false)
@@ -0,0 +1,140 @@
+// tests/unit/test_chebyshev_series.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/chebyshev_series.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+// Count the segments of an encoded series and the largest degree used.
+std::size_t segments(const std::vector<unsigned char>& enc, std::size_t& max_degree)
+{
+    std::size_t count = 0;
+    max_degree = 0;
+    std::size_t off = 0;
+    while (const ChebyshevSegment* s = chebyshev_segment_at(enc.data(), enc.size(), off))
+    {
+        ++count;
+        max_degree = std::max<std::size_t>(max_degree, s->degree);
+        off += chebyshev_segment_bytes(s->degree, s->components);
+    }
+    return off == enc.size() ? count : 0u;
+}
+
+} // namespace
+
+TEST_CASE("Chebyshev encoder meets its error bound on a smooth relative orbit", "[chebyshev]")
+{
+    // 600 steps of 1 s of an HCW-like ellipse with drift (LEO mean motion).
+    const std::size_t steps = 600;
+    const double n = 1.1e-3;
+    std::vector<double> tau(steps);
+    std::vector<double> x(steps);
+    std::vector<double> y(steps);
+    std::vector<double> z(steps);
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        const double t = static_cast<double>(k);
+        tau[k] = t;
+        x[k] = 250.0 * std::cos(n * t) + 40.0;
+        y[k] = -500.0 * std::sin(n * t) - 60.0 * n * t + 1200.0;
+        z[k] = 80.0 * std::sin(n * t + 0.3);
+    }
+    const double* series[3] = {x.data(), y.data(), z.data()};
+
+    ChebyshevEncoder enc;
+    for (const double tol : {1.0e-3, 1.0e-6})
+    {
+        ChebyshevFitConfig cfg{};
+        cfg.tolerance = tol;
+        std::vector<unsigned char> out;
+        REQUIRE(enc.encode(Span<const double>{tau.data(), steps}, series, 3u, cfg, out) >= 1u);
+        std::size_t degree = 0;
+        REQUIRE(segments(out, degree) >= 1u);
+        REQUIRE(degree <= cfg.max_degree);
+        // 3 x 600 doubles raw.
+        REQUIRE(out.size() * 10u <= steps * 3u * sizeof(double));
+
+        std::vector<double> dx(steps);
+        std::vector<double> dy(steps);
+        std::vector<double> dz(steps);
+        double* dec[3] = {dx.data(), dy.data(), dz.data()};
+        REQUIRE(chebyshev_series_decode(out.data(), out.size(),
+                                        Span<const double>{tau.data(), steps}, dec, 3u));
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            REQUIRE(std::fabs(dx[k] - x[k]) <= tol);
+            REQUIRE(std::fabs(dy[k] - y[k]) <= tol);
+            REQUIRE(std::fabs(dz[k] - z[k]) <= tol);
+        }
+
+        // Off-grid evaluation between samples stays close to the underlying curve.
+        Vec3 r{};
+        REQUIRE(chebyshev_series_eval(out.data(), out.size(), 123.5, r));
+        REQUIRE(std::fabs(r.x - (250.0 * std::cos(n * 123.5) + 40.0)) <= 2.0 * tol);
+    }
+    std::vector<unsigned char> out;
+    REQUIRE(enc.encode(Span<const double>{}, series, 3u, ChebyshevFitConfig{}, out) == 0u);
+    REQUIRE(enc.encode(Span<const double>{tau.data(), steps}, series, 4u, ChebyshevFitConfig{},
+                       out) == 0u);
+    REQUIRE(out.empty());
+}
+
+TEST_CASE("Chebyshev encoder splits at a burn and reproduces non-finite rows", "[chebyshev]")
+{
+    const std::size_t steps = 200;
+    std::vector<double> tau(steps);
+    std::vector<double> x(steps);
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        tau[k] = 2.0 * static_cast<double>(k);
+        // Velocity kink at step 77 (an impulsive burn).
+        x[k] = 10.0 + 0.5 * tau[k] + (k > 77u ? 0.3 * (tau[k] - 154.0) : 0.0);
+    }
+    const double* series[1] = {x.data()};
+    ChebyshevFitConfig cfg{};
+    cfg.tolerance = 1.0e-4;
+    ChebyshevEncoder enc;
+    std::vector<unsigned char> out;
+    REQUIRE(enc.encode(Span<const double>{tau.data(), steps}, series, 1u, cfg, out) > 1u);
+    std::vector<double> dx(steps);
+    double* dec[1] = {dx.data()};
+    REQUIRE(chebyshev_series_decode(out.data(), out.size(), Span<const double>{tau.data(), steps},
+                                    dec, 1u));
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        REQUIRE(std::fabs(dx[k] - x[k]) <= cfg.tolerance);
+    }
+    // Wrong component count or grid is rejected.
+    REQUIRE_FALSE(chebyshev_series_decode(out.data(), out.size(),
+                                          Span<const double>{tau.data(), steps - 1u}, dec, 1u));
+    double v = 0.0;
+    REQUIRE_FALSE(chebyshev_series_eval(out.data(), out.size(), 1.0, &v, 3u));
+
+    // A stale (all-NaN) row is one constant segment; an isolated NaN splits down around it.
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> stale(steps, nan);
+    series[0] = stale.data();
+    out.clear();
+    REQUIRE(enc.encode(Span<const double>{tau.data(), steps}, series, 1u, cfg, out) == 1u);
+    REQUIRE(chebyshev_series_eval(out.data(), out.size(), 50.0, &v, 1u));
+    REQUIRE(std::isnan(v));
+
+    x[40] = nan;
+    series[0] = x.data();
+    out.clear();
+    REQUIRE(enc.encode(Span<const double>{tau.data(), steps}, series, 1u, cfg, out) > 2u);
+    REQUIRE(chebyshev_series_decode(out.data(), out.size(), Span<const double>{tau.data(), steps},
+                                    dec, 1u));
+    REQUIRE(std::isnan(dx[40]));
+    REQUIRE(std::fabs(dx[39] - x[39]) <= cfg.tolerance);
+    REQUIRE(std::fabs(dx[41] - x[41]) <= cfg.tolerance);
+}
@@ -0,0 +1,226 @@
+// tests/unit/test_checkpoint.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/bullseye_frame.hpp"
+#include "core/checkpoint.hpp"
+#include "core/provider_cartesian.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/vehicle_index_map.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+std::string temp_path(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kR0 = 7000e3;
+
+// Deputies on a slowly drifting inertial offset from the chief's circular orbit.
+class DriftingVehicles final : public IVehicleStateProvider
+{
+  public:
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override
+    {
+        const double n = std::sqrt(kMu / (kR0 * kR0 * kR0));
+        VehicleState s{};
+        s.time_tag = t0;
+        s.r_i = Vec3{kR0 * std::cos(n * t0) + 50.0 * static_cast<double>(id),
+                     kR0 * std::sin(n * t0) + 0.01 * t0, 0.0};
+        s.v_i = Vec3{-kR0 * n * std::sin(n * t0), kR0 * n * std::cos(n * t0) + 0.01, 0.0};
+        s.frame_id = "INERTIAL";
+        s.status.code = ProviderCode::kOk;
+        return s;
+    }
+};
+
+PublisherConfig rig_publisher_config()
+{
+    PublisherConfig cfg{};
+    cfg.velocities = true;
+    cfg.history = 2;
+    return cfg;
+}
+
+RelativePredictorConfig rig_model_config()
+{
+    RelativePredictorConfig cfg{};
+    cfg.hcw_stm_n_rel_tol = 1.0e-6;
+    return cfg;
+}
+
+struct CheckpointRig
+{
+    VehicleIndexMap map;
+    CartesianChiefProvider chief{"INERTIAL", CartesianChiefProvider::Mode::kTimeSeries};
+    DriftingVehicles veh;
+    BullseyeFrame bullseye{chief, nullptr, BullseyeFrameMode::kConstructedOnly};
+    Publisher pub{rig_publisher_config()};
+    HcwRelativePredictor pred{pub, map, chief, veh, bullseye, rig_model_config()};
+
+    CheckpointRig()
+    {
+        TrajectoryReuseConfig reuse{};
+        reuse.enabled = true;
+        reuse.pos_tol_m = 1.0;
+        reuse.vel_tol_mps = 1.0;
+        reuse.full_refresh_ticks = 3;
+        pred.configure_reuse(reuse);
+    }
+
+    void load_chief()
+    {
+        const double n = std::sqrt(kMu / (kR0 * kR0 * kR0));
+        for (int k = 0; k < 20; ++k)
+        {
+            const double t = static_cast<double>(k);
+            chief.add_sample(t, Vec3{kR0 * std::cos(n * t), kR0 * std::sin(n * t), 0.0},
+                             Vec3{-kR0 * n * std::sin(n * t), kR0 * n * std::cos(n * t), 0.0});
+        }
+    }
+
+    void step(int k) { pred.step(static_cast<double>(k), 30.0, 1.0); }
+};
+
+bool same_snapshot(const PredictionBuffer& a, const PredictionBuffer& b)
+{
+    return a.seqno == b.seqno && a.t0 == b.t0 && a.steps == b.steps &&
+           a.valid_rows == b.valid_rows &&
+           std::memcmp(&a.positions, &b.positions, sizeof(a.positions)) == 0 &&
+           std::memcmp(a.velocities, b.velocities, sizeof(TrajectoryPlane)) == 0 &&
+           a.row_status == b.row_status && a.row_seqno == b.row_seqno;
+}
+
+} // namespace
+
+TEST_CASE("Checkpoint restores a predictor run bit for bit", "[checkpoint]")
+{
+    const std::string path = temp_path("bullseye_test_restart.ckpt");
+
+    auto a = std::make_unique<CheckpointRig>();
+    a->load_chief();
+    (void)a->map.register_vehicle(10u);
+    (void)a->map.register_vehicle(20u);
+    (void)a->map.register_vehicle(30u);
+    (void)a->map.unregister_vehicle(20u);
+    for (int k = 0; k < 5; ++k)
+    {
+        a->step(k);
+    }
+
+    CheckpointWriter out;
+    REQUIRE(a->pred.save_checkpoint(out));
+    a->chief.save_checkpoint(out);
+    REQUIRE(out.write(path.c_str()) == CheckpointCode::kOk);
+
+    // Reference: the uninterrupted run's next ticks.
+    std::vector<std::unique_ptr<PredictionBuffer>> expected;
+    std::vector<std::unique_ptr<TrajectoryPlane>> expected_v;
+    std::vector<std::size_t> expected_reused;
+    for (int k = 5; k < 10; ++k)
+    {
+        a->step(k);
+        expected.push_back(std::make_unique<PredictionBuffer>(a->pub.read()));
+        expected_v.push_back(std::make_unique<TrajectoryPlane>(*a->pub.read().velocities));
+        expected.back()->velocities = expected_v.back().get();
+        expected_reused.push_back(a->pred.reuse_stats().rows_reused);
+    }
+
+    REQUIRE(std::count_if(expected_reused.begin(), expected_reused.end(),
+                          [](std::size_t n) { return n > 0u; }) > 0);
+
+    // Restart: a fresh, identically configured rig with no history.
+    auto b = std::make_unique<CheckpointRig>();
+    CheckpointFile in;
+    REQUIRE(in.open(path.c_str()) == CheckpointCode::kOk);
+    REQUIRE(b->pred.restore_checkpoint(in) == CheckpointCode::kOk);
+    REQUIRE(b->chief.restore_checkpoint(in) == CheckpointCode::kOk);
+
+    REQUIRE(b->map.size() == 2u);
+    REQUIRE(b->map.index_of(30u) == std::optional<std::size_t>{2u});
+    REQUIRE_FALSE(b->map.id_at(1u).has_value());
+    REQUIRE(b->map.register_vehicle(40u) == std::optional<std::size_t>{1u});
+    REQUIRE(b->map.unregister_vehicle(40u).has_value());
+    REQUIRE(b->pub.published_seqno() == 5u);
+    REQUIRE(b->pub.acquire_seqno(4u).held());
+    REQUIRE(b->chief.sample_count() == 20u);
+
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        b->step(static_cast<int>(i) + 5);
+        REQUIRE(same_snapshot(b->pub.read(), *expected[i]));
+        REQUIRE(b->pred.reuse_stats().rows_reused == expected_reused[i]);
+    }
+    REQUIRE(b->chief.lookup_fallbacks() == a->chief.lookup_fallbacks());
+    (void)std::remove(path.c_str());
+}
+
+TEST_CASE("Checkpoint file rejects foreign or mismatched state", "[checkpoint]")
+{
+    const std::string path = temp_path("bullseye_test_mismatch.ckpt");
+
+    Publisher pub(rig_publisher_config());
+    pub.begin_write().positions[0][0] = Vec3{1.0, 2.0, 3.0};
+    pub.publish(1.0);
+    VehicleIndexMap map(8);
+    (void)map.register_vehicle(7u);
+
+    CheckpointWriter out;
+    REQUIRE(pub.save_checkpoint(out, 3u));
+    map.save_checkpoint(out, 3u);
+    REQUIRE(out.section_count() == 2u);
+    REQUIRE(out.write(path.c_str()) == CheckpointCode::kOk);
+
+    CheckpointFile in;
+    REQUIRE(in.open(path.c_str()) == CheckpointCode::kOk);
+    REQUIRE(in.has_section(CheckpointSection::kPublisher, 3u));
+    REQUIRE_FALSE(in.has_section(CheckpointSection::kPublisher, 0u));
+
+    // Wrong instance, wrong capacity, wrong slot count: nothing changes.
+    Publisher same(rig_publisher_config());
+    REQUIRE(same.restore_checkpoint(in) == CheckpointCode::kMissingSection);
+    Publisher plain;
+    REQUIRE(plain.restore_checkpoint(in, 3u) == CheckpointCode::kLayoutMismatch);
+    REQUIRE(plain.published_seqno() == 0u);
+    VehicleIndexMap small(4);
+    REQUIRE(small.restore_checkpoint(in, 3u) == CheckpointCode::kLayoutMismatch);
+    REQUIRE(small.empty());
+
+    REQUIRE(same.restore_checkpoint(in, 3u) == CheckpointCode::kOk);
+    REQUIRE(same.published_seqno() == 1u);
+    REQUIRE(same.read().positions[0][0].y == 2.0);
+    REQUIRE(same.read().velocities != pub.read().velocities);
+    REQUIRE(same.publish(2.0) == 2u);
+
+    // An open write cannot be checkpointed.
+    (void)pub.begin_write();
+    CheckpointWriter busy;
+    REQUIRE_FALSE(pub.save_checkpoint(busy));
+    in.close();
+
+    // Corrupt the magic.
+    std::FILE* f = std::fopen(path.c_str(), "r+b");
+    REQUIRE(f != nullptr);
+    const std::uint64_t bad = 0;
+    REQUIRE(std::fwrite(&bad, sizeof(bad), 1, f) == 1u);
+    std::fclose(f);
+    REQUIRE(in.open(path.c_str()) == CheckpointCode::kBadMagic);
+    REQUIRE_FALSE(in.is_open());
+    REQUIRE(in.open(temp_path("bullseye_test_missing.ckpt").c_str()) == CheckpointCode::kOpenFailed);
+    (void)std::remove(path.c_str());
+}
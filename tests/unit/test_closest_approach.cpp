@@ -0,0 +1,114 @@
+/**
+ * @file test_closest_approach.cpp
+ * @brief Unit tests for the per-row closest-approach summary.
+ */
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "core/closest_approach.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+// Straight-line flyby r(t) = r0 + u t sampled every h seconds over [0, horizon].
+struct Flyby
+{
+    Vec3 r0{1030.0, -2000.0, -100.0};
+    Vec3 u{-5.0, 10.0, 0.5};
+    std::vector<double> tau;
+    std::vector<Vec3> r;
+    std::vector<Vec3> v;
+
+    Flyby(double h, double horizon)
+    {
+        for (double t = 0.0; t <= horizon; t += h)
+        {
+            tau.push_back(t);
+            r.push_back(r0 + u * t);
+            v.push_back(u);
+        }
+    }
+
+    [[nodiscard]] double tca() const { return -dot(r0, u) / dot(u, u); }
+    [[nodiscard]] double dmin() const { return norm(r0 + u * tca()); }
+
+    // First time |r| = R (R > dmin).
+    [[nodiscard]] double entry(double R) const
+    {
+        return tca() - std::sqrt(R * R - dmin() * dmin()) / norm(u);
+    }
+
+    [[nodiscard]] ClosestApproach summarize(bool with_v, const std::vector<double>& radii) const
+    {
+        return summarize_closest_approach(
+            Span<const double>{tau.data(), tau.size()}, Span<const Vec3>{r.data(), r.size()},
+            with_v ? Span<const Vec3>{v.data(), v.size()} : Span<const Vec3>{},
+            Span<const double>{radii.data(), radii.size()});
+    }
+};
+
+} // namespace
+
+TEST_CASE("Closest approach is refined between samples")
+{
+    const Flyby f(10.0, 600.0);
+    const std::vector<double> radii{500.0, 100.0, 1.0};
+
+    for (const bool with_v : {true, false})
+    {
+        const ClosestApproach ca = f.summarize(with_v, radii);
+        REQUIRE(ca.valid);
+        REQUIRE(ca.hermite == with_v);
+        REQUIRE(ca.tca_tau == Catch::Approx(f.tca()).epsilon(1e-12));
+        REQUIRE(ca.min_range_m == Catch::Approx(f.dmin()).epsilon(1e-9));
+        REQUIRE(norm(ca.r_tca - (f.r0 + f.u * f.tca())) <= 1e-6);
+        REQUIRE(ca.keep_out_entry_tau[0] == Catch::Approx(f.entry(500.0)).epsilon(1e-12));
+        REQUIRE(ca.keep_out_entry_tau[1] == Catch::Approx(f.entry(100.0)).epsilon(1e-12));
+        REQUIRE(std::isnan(ca.keep_out_entry_tau[2])); // never that close
+        REQUIRE(std::isnan(ca.keep_out_entry_tau[3])); // no such sphere
+    }
+}
+
+TEST_CASE("Keep-out entry between samples is found from the refined minimum")
+{
+    // Sampled every 100 s: no sample falls inside a sphere just above the true minimum.
+    const Flyby f(100.0, 600.0);
+    const double R = f.dmin() + 1.0;
+    const std::vector<double> radii{R};
+    for (std::size_t k = 0; k < f.r.size(); ++k)
+    {
+        REQUIRE(norm(f.r[k]) > R);
+    }
+    const ClosestApproach ca = f.summarize(true, radii);
+    REQUIRE(ca.keep_out_entry_tau[0] == Catch::Approx(f.entry(R)).epsilon(1e-9));
+    REQUIRE(ca.keep_out_entry_tau[0] < ca.tca_tau);
+}
+
+TEST_CASE("Closest approach edge cases")
+{
+    const Flyby f(10.0, 600.0);
+    const std::vector<double> radii{1.0e6};
+
+    // Inside from the first sample.
+    REQUIRE(f.summarize(true, radii).keep_out_entry_tau[0] == 0.0);
+
+    // No samples, or velocities shorter than positions.
+    const ClosestApproach none = summarize_closest_approach(
+        Span<const double>{}, Span<const Vec3>{}, Span<const Vec3>{}, Span<const double>{});
+    REQUIRE_FALSE(none.valid);
+    const ClosestApproach short_v = summarize_closest_approach(
+        Span<const double>{f.tau.data(), f.tau.size()}, Span<const Vec3>{f.r.data(), f.r.size()},
+        Span<const Vec3>{f.v.data(), 3}, Span<const double>{});
+    REQUIRE_FALSE(short_v.valid);
+
+    // Minimum at the end of the grid: the last sample.
+    const Flyby early(10.0, 100.0);
+    const ClosestApproach ca = early.summarize(true, {});
+    REQUIRE(ca.tca_tau == 100.0);
+    REQUIRE(ca.min_range_m == norm(early.r.back()));
+}
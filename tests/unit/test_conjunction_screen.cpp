@@ -0,0 +1,212 @@
+/**
+ * @file test_conjunction_screen.cpp
+ * @brief Unit tests for deputy-to-deputy conjunction screening.
+ */
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include "core/conjunction_screen.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+// Straight-line deputies r_i(t) = p_i + u_i t on a uniform grid (pairwise TCA is analytic).
+struct LinearSet
+{
+    std::size_t rows{0};
+    std::size_t steps{0};
+    std::vector<double> tau;
+    std::vector<Vec3> p;
+    std::vector<Vec3> u;
+    std::vector<Vec3> r;
+    std::vector<Vec3> v;
+
+    LinearSet(std::size_t n_rows, std::size_t n_steps, double h) : rows(n_rows), steps(n_steps)
+    {
+        std::uint64_t s = 12345u;
+        auto next = [&s]()
+        {
+            s = s * 6364136223846793005ull + 1442695040888963407ull;
+            return static_cast<double>(s >> 11) * (1.0 / 9007199254740992.0) - 0.5;
+        };
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            p.push_back(Vec3{5000.0 * next(), 5000.0 * next(), 1000.0 * next()});
+            u.push_back(Vec3{10.0 * next(), 10.0 * next(), 2.0 * next()});
+        }
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            tau.push_back(h * static_cast<double>(k));
+        }
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            for (std::size_t k = 0; k < steps; ++k)
+            {
+                r.push_back(p[i] + u[i] * tau[k]);
+                v.push_back(u[i]);
+            }
+        }
+    }
+
+    [[nodiscard]] Span2D<const Vec3> pos() const { return {r.data(), rows, steps, steps}; }
+    [[nodiscard]] Span2D<const Vec3> vel() const { return {v.data(), rows, steps, steps}; }
+
+    // Exact TCA of rows a < b over [0, tau.back()].
+    [[nodiscard]] double tca(std::size_t a, std::size_t b) const
+    {
+        const Vec3 dp = p[b] - p[a];
+        const Vec3 du = u[b] - u[a];
+        const double t = -dot(dp, du) / dot(du, du);
+        return std::min(std::max(t, 0.0), tau.back());
+    }
+
+    [[nodiscard]] double miss(std::size_t a, std::size_t b) const
+    {
+        return norm((p[b] - p[a]) + (u[b] - u[a]) * tca(a, b));
+    }
+};
+
+} // namespace
+
+TEST_CASE("Conjunction screening finds exactly the pairs a brute-force search finds",
+          "[conjunction]")
+{
+    // More rows than a PredictionBuffer holds: the generic entry point has no row limit.
+    const std::size_t rows = 48;
+    const LinearSet set(rows, 121, 5.0);
+    std::vector<std::uint32_t> ids(rows);
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        ids[i] = static_cast<std::uint32_t>(i);
+    }
+    ConjunctionScreenConfig cfg{};
+    cfg.screen_distance_m = 400.0;
+    ConjunctionScreener screener(rows, cfg);
+    REQUIRE(screener.valid());
+
+    std::size_t expected = 0;
+    for (std::size_t a = 0; a < rows; ++a)
+    {
+        for (std::size_t b = a + 1; b < rows; ++b)
+        {
+            expected += (set.miss(a, b) < cfg.screen_distance_m) ? 1u : 0u;
+        }
+    }
+    REQUIRE(expected > 0u);
+
+    for (const bool with_v : {true, false})
+    {
+        std::vector<ConjunctionCandidate> out(rows * rows);
+        const std::size_t n =
+            screener.screen(Span<const double>{set.tau.data(), set.tau.size()}, set.pos(),
+                            with_v ? set.vel() : Span2D<const Vec3>{},
+                            Span<const std::uint32_t>{ids.data(), ids.size()},
+                            Span<ConjunctionCandidate>{out.data(), out.size()});
+        REQUIRE(n == expected);
+        REQUIRE(screener.stats().candidates == expected);
+        REQUIRE(screener.stats().dropped == 0u);
+        REQUIRE(screener.stats().rows == rows);
+        REQUIRE(screener.stats().slices == 15u);
+
+        // The broad phase culls most pair-slices.
+        REQUIRE(screener.stats().pair_tests < rows * (rows - 1) / 2 * 15 / 4);
+
+        for (std::size_t c = 0; c < n; ++c)
+        {
+            const ConjunctionCandidate& cand = out[c];
+            REQUIRE(cand.row_a < cand.row_b);
+            REQUIRE(cand.miss_m == Catch::Approx(set.miss(cand.row_a, cand.row_b)).margin(1e-6));
+            REQUIRE(cand.tca_tau == Catch::Approx(set.tca(cand.row_a, cand.row_b)).margin(1e-6));
+            REQUIRE(norm(cand.dr_tca) == Catch::Approx(cand.miss_m).margin(1e-9));
+            if (c > 0)
+            {
+                REQUIRE(out[c - 1].miss_m <= cand.miss_m);
+            }
+        }
+    }
+}
+
+TEST_CASE("Conjunction screening keeps the closest pairs when the output is short",
+          "[conjunction]")
+{
+    const LinearSet set(32, 121, 5.0);
+    std::vector<std::uint32_t> ids(32);
+    for (std::size_t i = 0; i < 32; ++i)
+    {
+        ids[i] = static_cast<std::uint32_t>(i);
+    }
+    ConjunctionScreenConfig cfg{};
+    cfg.screen_distance_m = 800.0;
+    ConjunctionScreener screener(32, cfg);
+    std::vector<ConjunctionCandidate> all(1024);
+    const std::size_t n = screener.screen(
+        Span<const double>{set.tau.data(), set.tau.size()}, set.pos(), set.vel(),
+        Span<const std::uint32_t>{ids.data(), ids.size()},
+        Span<ConjunctionCandidate>{all.data(), all.size()});
+    REQUIRE(n > 2u);
+
+    ConjunctionCandidate top[2]{};
+    REQUIRE(screener.screen(Span<const double>{set.tau.data(), set.tau.size()}, set.pos(),
+                            set.vel(), Span<const std::uint32_t>{ids.data(), ids.size()},
+                            Span<ConjunctionCandidate>{top, 2}) == 2u);
+    REQUIRE(screener.stats().dropped == n - 2u);
+    for (std::size_t c = 0; c < 2; ++c)
+    {
+        REQUIRE(top[c].row_a == all[c].row_a);
+        REQUIRE(top[c].row_b == all[c].row_b);
+        REQUIRE(top[c].miss_m == all[c].miss_m);
+    }
+}
+
+TEST_CASE("Conjunction screening of a snapshot pairs rows sampled at the same times",
+          "[conjunction]")
+{
+    const auto buf = std::make_unique<PredictionBuffer>();
+    buf->steps = 61;
+    buf->profile_steps[0] = 31;
+    for (std::size_t k = 0; k < 61; ++k)
+    {
+        buf->tau[k] = static_cast<double>(k);
+    }
+    for (std::size_t k = 0; k < 31; ++k)
+    {
+        buf->profile_tau[0][k] = 2.0 * static_cast<double>(k);
+    }
+    // Rows 0..4 all pass within 10 m of each other at the origin around tau = 30.
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+        const Vec3 u{(i % 2 == 0) ? 1.0 : -1.0, 0.0, 0.0};
+        const Vec3 off{0.0, 2.0 * static_cast<double>(i), 0.0};
+        for (std::size_t k = 0; k < 61; ++k)
+        {
+            buf->positions[i][k] = off + u * (static_cast<double>(k) - 30.0);
+        }
+        buf->row_t0[i] = buf->t0;
+    }
+    buf->valid_rows = 0x0Fu; // row 4 not valid
+    buf->row_grid[2] = 1u;   // row 2 on the coarse profile
+    buf->row_t0[3] = -1.0;   // row 3 carried from an older tick
+    for (std::size_t k = 0; k < 31; ++k)
+    {
+        buf->positions[2][k] = Vec3{-(2.0 * static_cast<double>(k) - 30.0), 4.0, 0.0};
+    }
+
+    ConjunctionScreenConfig cfg{};
+    cfg.screen_distance_m = 50.0;
+    ConjunctionScreener screener(MAX_VEHICLES, cfg);
+    ConjunctionCandidate out[8]{};
+    REQUIRE(screener.screen(*buf, Span<ConjunctionCandidate>{out, 8}) == 1u);
+    REQUIRE(out[0].row_a == 0u);
+    REQUIRE(out[0].row_b == 1u);
+    REQUIRE(out[0].miss_m == Catch::Approx(2.0));
+    REQUIRE(out[0].tca_tau == Catch::Approx(30.0));
+    REQUIRE(screener.stats().rows == 2u); // rows 2 and 3 are alone in their groups
+}
@@ -0,0 +1,196 @@
+// tests/unit/test_dispersion.cpp
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/dispersion.hpp"
+#include "core/frame_transforms.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "core/worker_pool.hpp"
+#include "models/model_hcw.hpp"
+#include "predictor_rig.hpp"
+
+using namespace bullseye_pred;
+using bullseye_pred::testing::Rig;
+using bullseye_pred::testing::RigOptions;
+
+namespace
+{
+
+// Deputies 3 and 7 of the shared rig.
+RigOptions dispersion_rig()
+{
+    RigOptions opt;
+    opt.vehicles = {3u, 7u};
+    return opt;
+}
+
+StateCovariance diag_covariance()
+{
+    StateCovariance P{};
+    const double var[6] = {25.0, 100.0, 4.0, 1e-4, 4e-4, 1e-6};
+    for (int j = 0; j < 6; ++j)
+    {
+        P.m[j][j] = var[j];
+    }
+    P.m[0][4] = P.m[4][0] = 0.05; // correlated radial position / in-track velocity
+    return P;
+}
+
+} // namespace
+
+TEST_CASE("Counter-based normals are reproducible and standard", "[dispersion]")
+{
+    CHECK(counter_hash(1u, 2u, 3u) == counter_hash(1u, 2u, 3u));
+    CHECK(counter_hash(1u, 2u, 3u) != counter_hash(1u, 2u, 4u));
+    CHECK(counter_hash(1u, 2u, 3u) != counter_hash(1u, 3u, 3u));
+    CHECK(counter_hash(1u, 2u, 3u) != counter_hash(2u, 2u, 3u));
+
+    const std::size_t n = 40000;
+    double sum = 0.0;
+    double sum2 = 0.0;
+    for (std::size_t c = 0; c < n; ++c)
+    {
+        const double z = counter_normal(42u, 9u, c);
+        REQUIRE(std::isfinite(z));
+        sum += z;
+        sum2 += z * z;
+    }
+    const double mean = sum / static_cast<double>(n);
+    CHECK(std::fabs(mean) < 0.03);
+    CHECK(sum2 / static_cast<double>(n) - mean * mean == Catch::Approx(1.0).margin(0.03));
+}
+
+TEST_CASE("Covariance factor reproduces P and accepts singular covariances", "[dispersion]")
+{
+    const StateCovariance P = diag_covariance();
+    CovarianceFactor L{};
+    REQUIRE(covariance_factor(P, L));
+    for (int r = 0; r < 6; ++r)
+    {
+        for (int c = 0; c < 6; ++c)
+        {
+            double s = 0.0;
+            for (int k = 0; k < 6; ++k)
+            {
+                s += L[r][k] * L[c][k];
+            }
+            CHECK(s == Catch::Approx(P.m[r][c]).margin(1e-15));
+        }
+    }
+
+    StateCovariance pos_only{};
+    pos_only.m[0][0] = 1.0;
+    pos_only.m[1][1] = 4.0;
+    REQUIRE(covariance_factor(pos_only, L));
+    CHECK(L[1][1] == 2.0);
+    CHECK(L[3][3] == 0.0);
+
+    StateCovariance indefinite = pos_only;
+    indefinite.m[0][1] = indefinite.m[1][0] = 5.0;
+    CHECK_FALSE(covariance_factor(indefinite, L));
+    CHECK(L[1][1] == 2.0); // unchanged
+}
+
+TEST_CASE("Dispersion samples go through the tick's model, independent of threads",
+          "[dispersion]")
+{
+    constexpr std::size_t K = 70; // more than one predict chunk
+    const std::size_t steps = 61;
+    static Rig<HcwRelativePredictor> serial(dispersion_rig());
+    static Rig<HcwRelativePredictor> pooled(dispersion_rig());
+    static WorkerPool pool(3);
+    pooled.pred.attach_worker_pool(&pool);
+
+    std::vector<Vec3> out_a(2 * K * steps);
+    std::vector<Vec3> out_b(2 * K * steps);
+    std::unique_ptr<bool[]> ok_a(new bool[2 * K]());
+    std::unique_ptr<bool[]> ok_b(new bool[2 * K]());
+    DispersionConfig cfg{};
+    cfg.samples = K;
+    cfg.seed = 1234u;
+    cfg.covariance = diag_covariance();
+    REQUIRE(serial.pred.configure_dispersion(
+        cfg, Span2D<Vec3>{out_a.data(), 2 * K, steps, steps}, Span<bool>{ok_a.get(), 2 * K}));
+    REQUIRE(pooled.pred.configure_dispersion(
+        cfg, Span2D<Vec3>{out_b.data(), 2 * K, steps, steps}, Span<bool>{ok_b.get(), 2 * K}));
+
+    serial.pred.step(0.0, 600.0, 10.0);
+    pooled.pred.step(0.0, 600.0, 10.0);
+    REQUIRE(serial.pred.dispersion_stats().rows == 0x3u);
+    REQUIRE(serial.pred.dispersion_stats().samples_ok == 2 * K);
+    REQUIRE(serial.pred.dispersion_stats().samples_failed == 0u);
+    REQUIRE(pooled.pred.dispersion_stats().samples_ok == 2 * K);
+    CHECK(std::memcmp(out_a.data(), out_b.data(), out_a.size() * sizeof(Vec3)) == 0);
+
+    // Each sample is the model trajectory from x0 + L z with z from the vehicle's stream.
+    const TickContext& tick = serial.pred.tick_context();
+    CovarianceFactor L{};
+    REQUIRE(covariance_factor(cfg.covariance, L));
+    TimeGrid grid;
+    grid.tau.resize(steps);
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        grid.tau[k] = 10.0 * static_cast<double>(k);
+    }
+    ModelHCW hcw;
+    HcwParams params{};
+    params.n_radps = tick.n_radps;
+    for (std::size_t row = 0; row < 2; ++row)
+    {
+        const VehicleIndexMap::VehicleId id = (row == 0) ? 3u : 7u;
+        const VehicleState dep = serial.veh.get(id, 0.0);
+        const RelState x = inertial_to_ric_relative(dep.r_i, dep.v_i, tick.chief.r_i,
+                                                    tick.chief.v_i, tick.C_i2r,
+                                                    tick.frame.omega_ric);
+        const RelStateRic x0{x.r, x.v};
+        for (std::size_t s : {std::size_t{0}, std::size_t{33}, K - 1})
+        {
+            RelStateRic xs{};
+            dispersion_states(x0, L, cfg.seed, id, s, Span<RelStateRic>{&xs, 1});
+            std::vector<Vec3> expect(steps);
+            REQUIRE(hcw.predict_hcw(xs, params, grid, Span<Vec3>{expect.data(), steps},
+                                    Span<Vec3>{})
+                        .code == ModelCode::kOk);
+            const Vec3* const got = out_a.data() + (row * K + s) * steps;
+            for (std::size_t k = 0; k < steps; ++k)
+            {
+                CHECK(got[k].x == Catch::Approx(expect[k].x).margin(1e-6));
+                CHECK(got[k].y == Catch::Approx(expect[k].y).margin(1e-6));
+                CHECK(got[k].z == Catch::Approx(expect[k].z).margin(1e-6));
+            }
+        }
+    }
+
+    // Zero covariance: every sample is the nominal row.
+    cfg.covariance = StateCovariance{};
+    REQUIRE(serial.pred.configure_dispersion(
+        cfg, Span2D<Vec3>{out_a.data(), 2 * K, steps, steps}, Span<bool>{ok_a.get(), 2 * K}));
+    serial.pred.step(10.0, 600.0, 10.0);
+    const PredictionBuffer& next = serial.pub.read();
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        CHECK(out_a[(K + 5) * steps + k].x == next.positions[1][k].x);
+        CHECK(out_a[(K + 5) * steps + k].y == next.positions[1][k].y);
+    }
+
+    // Output too small for row 1: only row 0 is dispersed.
+    REQUIRE(serial.pred.configure_dispersion(cfg, Span2D<Vec3>{out_a.data(), K, steps, steps},
+                                             Span<bool>{ok_a.get(), K}));
+    serial.pred.step(20.0, 600.0, 10.0);
+    CHECK(serial.pred.dispersion_stats().rows == 0x1u);
+
+    StateCovariance bad{};
+    bad.m[0][0] = -1.0;
+    cfg.covariance = bad;
+    CHECK_FALSE(serial.pred.configure_dispersion(
+        cfg, Span2D<Vec3>{out_a.data(), K, steps, steps}, Span<bool>{ok_a.get(), K}));
+    serial.pred.step(30.0, 600.0, 10.0);
+    CHECK(serial.pred.dispersion_stats().rows == 0u);
+}
@@ -38,6 +38,23 @@ TEST_CASE("DummyPredictor publishes deterministic content")
     REQUIRE(snap.positions[1][2].x == Catch::Approx(1.002));
     REQUIRE(snap.positions[1][2].y == Catch::Approx(2.01));
     REQUIRE(snap.positions[1][2].z == Catch::Approx(1.0));
+
+    // Metadata: grid and row validity travel with the snapshot.
+    REQUIRE(snap.steps == 3);
+    REQUIRE(snap.tau[2] == 1.0);
+    REQUIRE(snap.vehicles == 2);
+    REQUIRE(snap.valid_rows == 0x3u);
+    REQUIRE(snap.row_status[1] == bullseye_pred::RowStatus::kOk);
+    REQUIRE(snap.row_status[2] == bullseye_pred::RowStatus::kEmpty);
+
+    // A freed slot inside [0, slot_count()) publishes as an empty row.
+    REQUIRE(map.register_vehicle(300).has_value());
+    REQUIRE(map.unregister_vehicle(200).has_value());
+    pred.step(/*t0=*/11.0, /*horizon=*/1.0, /*cadence=*/0.5);
+    const auto& next = pub.read();
+    REQUIRE(next.vehicles == 3);
+    REQUIRE(next.valid_rows == 0x5u);
+    REQUIRE(next.row_status[1] == bullseye_pred::RowStatus::kEmpty);
 }
 
 TEST_CASE("DummyPredictor does not publish on empty grid")
@@ -0,0 +1,198 @@
+// tests/unit/test_ephemeris_providers.cpp
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/ephemeris_file.hpp"
+#include "core/frame_provider_ephemeris.hpp"
+#include "core/provider_ephemeris.hpp"
+
+using bullseye_pred::AdoptedRicFrame;
+using bullseye_pred::ChiefEphemerisRecord;
+using bullseye_pred::ChiefState;
+using bullseye_pred::EphemerisBullseyeFrameProvider;
+using bullseye_pred::EphemerisChiefProvider;
+using bullseye_pred::EphemerisCode;
+using bullseye_pred::EphemerisFile;
+using bullseye_pred::EphemerisKind;
+using bullseye_pred::EphemerisVehicleProvider;
+using bullseye_pred::FrameEphemerisRecord;
+using bullseye_pred::OmegaCoords;
+using bullseye_pred::ProviderCode;
+using bullseye_pred::Vec3;
+using bullseye_pred::VehicleEphemerisRecord;
+using bullseye_pred::VehicleState;
+
+namespace
+{
+
+std::string temp_path(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+TEST_CASE("EphemerisChiefProvider serves exact-time samples from a mapped file",
+          "[providers][ephemeris]")
+{
+    const std::string path = temp_path("bullseye_test_chief.eph");
+    std::vector<ChiefEphemerisRecord> recs;
+    for (int k = 0; k < 1000; ++k)
+    {
+        const double t = 0.1 * k;
+        recs.push_back(
+            ChiefEphemerisRecord{t, Vec3{7.0e6 + k, 0.0, 0.0}, Vec3{0.0, 7.5e3, 1.0 * k}});
+    }
+    REQUIRE(bullseye_pred::write_chief_ephemeris(path.c_str(), {recs.data(), recs.size()}) ==
+            EphemerisCode::kOk);
+
+    constexpr const char* kFrameId = "INERTIAL";
+    EphemerisChiefProvider p{kFrameId, /*warn_period_sec=*/0.0};
+    REQUIRE(p.get(0.0).status.code == ProviderCode::kNotAvailable);
+    REQUIRE(p.open(path.c_str(), /*verify_times=*/true) == EphemerisCode::kOk);
+    REQUIRE(p.sample_count() == 1000u);
+
+    for (int k = 0; k < 1000; ++k)
+    {
+        const ChiefState s = p.get(recs[k].t);
+        REQUIRE(s.status.code == ProviderCode::kOk);
+        REQUIRE(s.time_tag == recs[k].t);
+        REQUIRE(s.frame_id == kFrameId);
+        REQUIRE(s.r_i.x == recs[k].r_i.x);
+        REQUIRE(s.v_i.z == recs[k].v_i.z);
+    }
+    REQUIRE(p.lookup_fallbacks() == 0u);
+
+    REQUIRE(p.get(0.05).status.code == ProviderCode::kTimeMissing);
+    REQUIRE(p.get(recs[10].t).r_i.x == recs[10].r_i.x);
+    REQUIRE(p.get(1.0e6).status.code == ProviderCode::kTimeMissing);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("EphemerisVehicleProvider keeps one series and cursor per vehicle",
+          "[providers][ephemeris]")
+{
+    const std::string path = temp_path("bullseye_test_vehicles.eph");
+    std::vector<VehicleEphemerisRecord> recs;
+    const std::uint64_t ids[] = {3u, 17u, 42u};
+    for (std::uint64_t id : ids)
+    {
+        for (int k = 0; k < 50; ++k)
+        {
+            recs.push_back(VehicleEphemerisRecord{id, 1.0 * k, Vec3{1.0 * id, 1.0 * k, 0.0},
+                                                  Vec3{0.0, 0.0, 1.0 * id}});
+        }
+    }
+    REQUIRE(bullseye_pred::write_vehicle_ephemeris(path.c_str(), {recs.data(), recs.size()}) ==
+            EphemerisCode::kOk);
+
+    EphemerisVehicleProvider p{"INERTIAL", 0.0};
+    REQUIRE(p.open(path.c_str(), true) == EphemerisCode::kOk);
+    REQUIRE(p.vehicle_count() == 3u);
+
+    // Interleaved per-tick queries stay on their own cursors.
+    for (int k = 0; k < 50; ++k)
+    {
+        for (std::uint64_t id : ids)
+        {
+            const VehicleState s = p.get(id, 1.0 * k);
+            REQUIRE(s.status.code == ProviderCode::kOk);
+            REQUIRE(s.r_i.x == 1.0 * id);
+            REQUIRE(s.r_i.y == 1.0 * k);
+            REQUIRE(s.v_i.z == 1.0 * id);
+        }
+    }
+    REQUIRE(p.lookup_fallbacks() == 0u);
+    REQUIRE(p.get(5u, 1.0).status.code == ProviderCode::kNotAvailable);
+    REQUIRE(p.get(17u, 0.5).status.code == ProviderCode::kTimeMissing);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("EphemerisBullseyeFrameProvider returns declared frames and omega",
+          "[frame_providers][ephemeris]")
+{
+    const std::string path = temp_path("bullseye_test_frame.eph");
+    std::vector<FrameEphemerisRecord> recs(20);
+    for (int k = 0; k < 20; ++k)
+    {
+        recs[k].t = 2.0 * k;
+        recs[k].origin_i = Vec3{1.0 * k, 0.0, 0.0};
+        recs[k].has_omega = (k % 2 == 0) ? 1u : 0u;
+        recs[k].omega_ric = Vec3{0.0, 0.0, 1.0e-3};
+    }
+    REQUIRE(bullseye_pred::write_frame_ephemeris(path.c_str(), {recs.data(), recs.size()}) ==
+            EphemerisCode::kOk);
+
+    EphemerisBullseyeFrameProvider p{"EPHEMERIS_FRAME", 0.0};
+    REQUIRE(p.open(path.c_str()) == EphemerisCode::kOk);
+    for (int k = 0; k < 20; ++k)
+    {
+        const AdoptedRicFrame f = p.get(2.0 * k);
+        REQUIRE(f.status.code == ProviderCode::kOk);
+        REQUIRE(f.origin_i.x == 1.0 * k);
+        REQUIRE(f.has_omega == (k % 2 == 0));
+        REQUIRE(f.omega_coords ==
+                ((k % 2 == 0) ? OmegaCoords::kOmegaRIC : OmegaCoords::kUnspecified));
+    }
+    REQUIRE(p.get(1.0).status.code == ProviderCode::kTimeMissing);
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Ephemeris files reject unsorted input, wrong kinds, and corrupt headers",
+          "[ephemeris]")
+{
+    const std::string path = temp_path("bullseye_test_bad.eph");
+
+    const ChiefEphemerisRecord unsorted[] = {{2.0, Vec3{}, Vec3{}}, {1.0, Vec3{}, Vec3{}}};
+    REQUIRE(bullseye_pred::write_chief_ephemeris(path.c_str(), {unsorted, 2}) ==
+            EphemerisCode::kInvalidInput);
+    const VehicleEphemerisRecord ids_down[] = {{2u, 0.0, Vec3{}, Vec3{}},
+                                               {1u, 1.0, Vec3{}, Vec3{}}};
+    REQUIRE(bullseye_pred::write_vehicle_ephemeris(path.c_str(), {ids_down, 2}) ==
+            EphemerisCode::kInvalidInput);
+
+    const ChiefEphemerisRecord good[] = {{1.0, Vec3{}, Vec3{}}, {2.0, Vec3{}, Vec3{}}};
+    REQUIRE(bullseye_pred::write_chief_ephemeris(path.c_str(), {good, 2}) == EphemerisCode::kOk);
+
+    EphemerisFile f;
+    REQUIRE(f.open(path.c_str(), EphemerisKind::kVehicle) == EphemerisCode::kLayoutMismatch);
+    REQUIRE_FALSE(f.is_open());
+    REQUIRE(f.open(path.c_str(), EphemerisKind::kChief) == EphemerisCode::kOk);
+    REQUIRE(f.record_count() == 2u);
+    f.close();
+
+    // Truncated file: header promises more records than the file holds.
+    {
+        std::FILE* fp = std::fopen(path.c_str(), "r+b");
+        REQUIRE(fp != nullptr);
+        std::FILE* tmp = std::fopen((path + ".short").c_str(), "wb");
+        REQUIRE(tmp != nullptr);
+        char buf[256];
+        const std::size_t n = std::fread(buf, 1, sizeof(buf), fp);
+        std::fwrite(buf, 1, n - 8u, tmp);
+        std::fclose(tmp);
+        std::fclose(fp);
+    }
+    REQUIRE(f.open((path + ".short").c_str(), EphemerisKind::kChief) ==
+            EphemerisCode::kLayoutMismatch);
+
+    const char junk[128] = "not an ephemeris";
+    std::FILE* fp = std::fopen(path.c_str(), "wb");
+    REQUIRE(fp != nullptr);
+    std::fwrite(junk, 1, sizeof(junk), fp);
+    std::fclose(fp);
+    REQUIRE(f.open(path.c_str(), EphemerisKind::kChief) == EphemerisCode::kBadMagic);
+    REQUIRE(f.open(temp_path("bullseye_test_missing.eph").c_str(), EphemerisKind::kChief) ==
+            EphemerisCode::kOpenFailed);
+
+    std::remove(path.c_str());
+    std::remove((path + ".short").c_str());
+}
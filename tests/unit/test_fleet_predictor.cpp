@@ -0,0 +1,148 @@
+// tests/unit/test_fleet_predictor.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+#include "core/bullseye_frame.hpp"
+#include "core/fleet_predictor.hpp"
+#include "core/provider_twobody.hpp"
+#include "core/provider_twobody_fleet.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "core/worker_pool.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+constexpr const char* kFrame = "INERTIAL";
+constexpr double kMu = 3.986004418e14;
+constexpr std::size_t kFormations = 6;
+
+Vec3 chief_r(std::size_t f)
+{
+    return Vec3{6800e3 + 100e3 * static_cast<double>(f), 0.0, 0.0};
+}
+
+Vec3 chief_v(std::size_t f)
+{
+    const double r = norm(chief_r(f));
+    return Vec3{0.0, std::sqrt(kMu / r) * (1.0 + 0.01 * static_cast<double>(f)), 50.0};
+}
+
+// Formation f carries f + 1 deputies around its chief.
+struct FormationRig
+{
+    VehicleIndexMap map;
+    TwoBodyVehicleProvider deputies{kFrame, kMu};
+    Publisher pub;
+
+    explicit FormationRig(std::size_t f)
+    {
+        for (std::size_t d = 0; d <= f; ++d)
+        {
+            const auto id = static_cast<VehicleIndexMap::VehicleId>(100 + d);
+            const double k = static_cast<double>(d + 1);
+            REQUIRE(deputies.add_vehicle(id, 0.0, chief_r(f) + Vec3{10.0 * k, -30.0 * k, k},
+                                         chief_v(f) + Vec3{0.0, 0.02 * k, -0.01 * k}));
+            REQUIRE(map.register_vehicle(id).has_value());
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("Fleet predictor matches standalone predictors per formation", "[fleet]")
+{
+    WorkerPool pool(3);
+    TwoBodyVehicleProvider chiefs(kFrame, kMu);
+    for (std::size_t f = 0; f < kFormations; ++f)
+    {
+        REQUIRE(chiefs.add_vehicle(f, 0.0, chief_r(f), chief_v(f)));
+    }
+
+    std::unique_ptr<FormationRig> fleet_rigs[kFormations];
+    std::unique_ptr<FormationRig> solo_rigs[kFormations];
+    std::unique_ptr<TwoBodyChiefProvider> solo_chiefs[kFormations];
+    std::unique_ptr<BullseyeFrame> solo_frames[kFormations];
+    std::unique_ptr<HcwRelativePredictor> solo[kFormations];
+
+    const auto fleet = std::make_unique<HcwFleetPredictor>(&pool, &chiefs);
+    for (std::size_t f = 0; f < kFormations; ++f)
+    {
+        fleet_rigs[f] = std::make_unique<FormationRig>(f);
+        solo_rigs[f] = std::make_unique<FormationRig>(f);
+        solo_chiefs[f] =
+            std::make_unique<TwoBodyChiefProvider>(kFrame, kMu, 0.0, chief_r(f), chief_v(f));
+        solo_chiefs[f]->set_elliptic_fast_path(false); // bit-identical to the batched chiefs
+        solo_frames[f] = std::make_unique<BullseyeFrame>(*solo_chiefs[f], nullptr,
+                                                         BullseyeFrameMode::kConstructedOnly);
+        solo[f] = std::make_unique<HcwRelativePredictor>(solo_rigs[f]->pub, solo_rigs[f]->map,
+                                                         *solo_chiefs[f], solo_rigs[f]->deputies,
+                                                         *solo_frames[f]);
+
+        // The last formation keeps its own chief provider; the rest are batched.
+        IChiefStateProvider& own = *solo_chiefs[f];
+        const auto idx = fleet->add_formation(fleet_rigs[f]->pub, fleet_rigs[f]->map, own,
+                                              fleet_rigs[f]->deputies, nullptr,
+                                              BullseyeFrameMode::kConstructedOnly);
+        REQUIRE(idx == std::optional<std::size_t>{f});
+        if (f + 1 < kFormations)
+        {
+            REQUIRE(fleet->batch_chief(f, f));
+        }
+    }
+    REQUIRE(fleet->formation_count() == kFormations);
+
+    for (int tick = 0; tick < 3; ++tick)
+    {
+        const double t0 = 30.0 * tick;
+        fleet->step(t0, 120.0, 2.0);
+        for (std::size_t f = 0; f < kFormations; ++f)
+        {
+            solo[f]->step(t0, 120.0, 2.0);
+
+            const PredictionBuffer& a = solo_rigs[f]->pub.read();
+            const PredictionBuffer& b = fleet_rigs[f]->pub.read();
+            REQUIRE(b.seqno == static_cast<std::uint64_t>(tick + 1));
+            REQUIRE(b.t0 == t0);
+            REQUIRE(b.valid_rows == a.valid_rows);
+            REQUIRE(b.valid_rows == (RowMask{1} << (f + 1)) - 1);
+            for (std::size_t i = 0; i <= f; ++i)
+            {
+                REQUIRE(std::memcmp(b.positions[i].data(), a.positions[i].data(),
+                                    a.steps * sizeof(Vec3)) == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("Fleet predictor fails a formation whose batched chief is unavailable", "[fleet]")
+{
+    TwoBodyVehicleProvider chiefs(kFrame, kMu);
+    REQUIRE(chiefs.add_vehicle(0, 0.0, chief_r(0), chief_v(0)));
+
+    const auto good = std::make_unique<FormationRig>(0);
+    const auto bad = std::make_unique<FormationRig>(1);
+    TwoBodyChiefProvider unused(kFrame, kMu, 0.0, chief_r(0), chief_v(0));
+
+    HcwFleetPredictor serial(nullptr, &chiefs);
+    REQUIRE(serial.add_formation(good->pub, good->map, unused, good->deputies, nullptr,
+                                 BullseyeFrameMode::kConstructedOnly)
+                .has_value());
+    REQUIRE(serial.add_formation(bad->pub, bad->map, unused, bad->deputies, nullptr,
+                                 BullseyeFrameMode::kConstructedOnly)
+                .has_value());
+    REQUIRE(serial.batch_chief(0, 0));
+    REQUIRE(serial.batch_chief(1, 77)); // not in the chief source
+    REQUIRE_FALSE(serial.batch_chief(2, 0));
+
+    serial.step(0.0, 10.0, 1.0);
+    REQUIRE(good->pub.published_seqno() == 1);
+    REQUIRE(bad->pub.published_seqno() == 0);
+}
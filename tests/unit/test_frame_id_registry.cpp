@@ -0,0 +1,110 @@
+// tests/unit/test_frame_id_registry.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+
+#include "core/bullseye_frame.hpp"
+#include "core/frame_id_registry.hpp"
+#include "core/provider_twobody.hpp"
+#include "core/provider_twobody_fleet.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/vehicle_index_map.hpp"
+
+using namespace bullseye_pred;
+
+TEST_CASE("Frame registry interns names to stable handles", "[frame_id]")
+{
+    FrameIdRegistry reg;
+    REQUIRE(reg.intern(nullptr) == FrameHandle::kNone);
+    REQUIRE(reg.intern("") == FrameHandle::kNone);
+    REQUIRE(reg.size() == 0u);
+
+    std::string a = "GCRF";
+    const FrameHandle h = reg.intern(a.c_str());
+    REQUIRE(h != FrameHandle::kNone);
+    REQUIRE(reg.intern("GCRF") == h); // equal name, different pointer
+    REQUIRE(reg.find("GCRF") == h);
+    REQUIRE(reg.find("ITRF") == FrameHandle::kNone);
+    REQUIRE(reg.size() == 1u);
+
+    // The registry owns its copy.
+    a = "mutated";
+    REQUIRE(std::string(reg.name(h)) == "GCRF");
+    REQUIRE(reg.name(FrameHandle::kNone) == nullptr);
+
+    const FrameHandle other = reg.intern("ITRF");
+    REQUIRE(other != h);
+    REQUIRE(reg.name(other) != nullptr);
+
+    // Fill to capacity: further names are not interned, known ones still are.
+    for (std::size_t k = reg.size(); k < FrameIdRegistry::kCapacity; ++k)
+    {
+        REQUIRE(reg.intern(("F" + std::to_string(k)).c_str()) != FrameHandle::kNone);
+    }
+    REQUIRE(reg.intern("one too many") == FrameHandle::kNone);
+    REQUIRE(reg.intern("GCRF") == h);
+}
+
+TEST_CASE("same_frame compares handles, falling back to names", "[frame_id]")
+{
+    const std::string x = "EME2000";
+    const std::string y = "EME2000";
+    const FrameHandle h = intern_frame_id(x.c_str());
+    REQUIRE(intern_frame_id(y.c_str()) == h);
+
+    REQUIRE(same_frame(h, x.c_str(), h, y.c_str()));
+    REQUIRE_FALSE(same_frame(h, x.c_str(), intern_frame_id("MOD"), "MOD"));
+    // One side not interned: names decide.
+    REQUIRE(same_frame(h, x.c_str(), FrameHandle::kNone, y.c_str()));
+    REQUIRE_FALSE(same_frame(FrameHandle::kNone, "TOD", h, y.c_str()));
+    REQUIRE_FALSE(same_frame(FrameHandle::kNone, nullptr, FrameHandle::kNone, "TOD"));
+    REQUIRE(same_frame(FrameHandle::kNone, nullptr, FrameHandle::kNone, nullptr));
+}
+
+TEST_CASE("Providers configured from distinct strings of one frame are not mismatched",
+          "[frame_id][predictor]")
+{
+    constexpr double kMu = 3.986004418e14;
+    const Vec3 r0{6878e3, 0.0, 0.0};
+    const Vec3 v0{0.0, 7612.0, 10.0};
+
+    // Separate config storage per provider: equal names, distinct pointers.
+    const std::string chief_frame = "J2000_TEST";
+    const std::string deputy_frame = "J2000_TEST";
+    const std::string foreign_frame = "TEME_TEST";
+
+    TwoBodyChiefProvider chief(chief_frame.c_str(), kMu, 0.0, r0, v0);
+    TwoBodyVehicleProvider deputies(deputy_frame.c_str(), kMu);
+    TwoBodyVehicleProvider foreign(foreign_frame.c_str(), kMu);
+    REQUIRE(deputies.add_vehicle(1u, 0.0, r0 + Vec3{30.0, -50.0, 1.0}, v0));
+    REQUIRE(foreign.add_vehicle(1u, 0.0, r0 + Vec3{30.0, -50.0, 1.0}, v0));
+
+    const ChiefState c = chief.get(0.0);
+    const VehicleState d = deputies.get(1u, 0.0);
+    REQUIRE(c.frame != FrameHandle::kNone);
+    REQUIRE(d.frame == c.frame);
+    REQUIRE(d.frame_id != c.frame_id);
+
+    VehicleIndexMap map{4};
+    REQUIRE(map.register_vehicle(1u).has_value());
+    BullseyeFrame bullseye{chief, nullptr, BullseyeFrameMode::kConstructedOnly};
+    REQUIRE(bullseye.update(0.0).inertial_frame == c.frame);
+
+    {
+        const auto pub = std::make_unique<Publisher>();
+        const auto pred =
+            std::make_unique<RelativePredictor>(*pub, map, chief, deputies, bullseye);
+        pred->step(0.0, 60.0, 1.0);
+        REQUIRE(pub->read().row_status[0] == RowStatus::kOk);
+        REQUIRE(pub->read().row_valid(0));
+    }
+    {
+        const auto pub = std::make_unique<Publisher>();
+        const auto pred = std::make_unique<RelativePredictor>(*pub, map, chief, foreign, bullseye);
+        pred->step(0.0, 60.0, 1.0);
+        REQUIRE(pub->read().row_status[0] == RowStatus::kFrameMismatch);
+    }
+}
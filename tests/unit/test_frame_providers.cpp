@@ -1,8 +1,11 @@
 // tests/unit/test_frame_providers.cpp  (new file)
 
+#include <cmath>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include "core/frame_provider_cartesian.hpp"
+#include "core/frame_provider_quat.hpp"
 
 using bullseye_pred::AdoptedRicFrame;
 using bullseye_pred::AxisOrder;
@@ -95,6 +98,66 @@ TEST_CASE("CartesianBullseyeFrameProvider (timeseries) fails fast if time missin
     REQUIRE(f.status.code == ProviderCode::kTimeMissing);
 }
 
+TEST_CASE("CartesianBullseyeFrameProvider (timeseries) presorted load and cursor lookup",
+          "[frame_providers]")
+{
+    using Sample = CartesianBullseyeFrameProvider::Sample;
+    constexpr const char* kSrc = "USER_CARTESIAN_FRAME";
+    CartesianBullseyeFrameProvider p{kSrc, CartesianBullseyeFrameProvider::Mode::kTimeSeries, 0.0};
+
+    Sample samples[32]{};
+    for (int k = 0; k < 32; ++k)
+    {
+        samples[k].t = 10.0 + k;
+        samples[k].origin_i = Vec3{static_cast<double>(k), 0.0, 0.0};
+    }
+    samples[5].has_omega = true;
+    samples[5].omega_ric = Vec3{0.0, 0.0, 0.01};
+    REQUIRE(p.load_presorted({samples, 32}));
+
+    for (int k = 0; k < 32; ++k)
+    {
+        const AdoptedRicFrame f = p.get(10.0 + k);
+        REQUIRE(f.status.code == ProviderCode::kOk);
+        REQUIRE(f.origin_i.x == static_cast<double>(k));
+        REQUIRE(f.has_omega == (k == 5));
+    }
+    REQUIRE(p.lookup_fallbacks() == 0u);
+
+    REQUIRE(p.get(12.0).origin_i.x == 2.0);
+    REQUIRE(p.lookup_fallbacks() == 1u);
+
+    samples[3].t = samples[2].t;
+    REQUIRE_FALSE(p.load_presorted({samples, 32}));
+    REQUIRE(p.sample_count() == 32u);
+}
+
+TEST_CASE("CartesianBullseyeFrameProvider (streaming) serves the retained window",
+          "[frame_providers][streaming]")
+{
+    constexpr const char* kSrc = "USER_CARTESIAN_FRAME";
+    CartesianBullseyeFrameProvider p{kSrc, CartesianBullseyeFrameProvider::Mode::kStreaming, 0.0};
+    REQUIRE(p.configure_streaming(4u));
+
+    REQUIRE(p.push_sample(1.0, Vec3{1.0, 0.0, 0.0}, Mat3::identity()));
+    REQUIRE(p.push_sample(2.0, Vec3{2.0, 0.0, 0.0}, Mat3::identity(), true,
+                          Vec3{0.0, 0.0, 0.01}));
+
+    const AdoptedRicFrame f1 = p.get(1.0);
+    REQUIRE(f1.status.code == ProviderCode::kOk);
+    REQUIRE(f1.has_omega == false);
+    REQUIRE(f1.frame_kind == FrameKind::kBullseyeRIC);
+
+    const AdoptedRicFrame f2 = p.get(2.0);
+    REQUIRE(f2.status.code == ProviderCode::kOk);
+    REQUIRE(f2.origin_i.x == 2.0);
+    REQUIRE(f2.omega_coords == OmegaCoords::kOmegaRIC);
+
+    // Zero retention: the t=1 sample was evicted by get(2.0).
+    REQUIRE(p.get(1.0).status.code == ProviderCode::kTimeMissing);
+    REQUIRE(p.sample_count() == 1u);
+}
+
 TEST_CASE("CartesianBullseyeFrameProvider returns kInvalidInput when frame_source_id is null",
           "[frame_providers]")
 {
@@ -103,3 +166,85 @@ TEST_CASE("CartesianBullseyeFrameProvider returns kInvalidInput when frame_sourc
     REQUIRE(f.status.code == ProviderCode::kInvalidInput);
     REQUIRE(f.frame_source_id == nullptr);
 }
+
+TEST_CASE("CartesianBullseyeFrameProvider computes pose metrics once at ingest",
+          "[frame_providers]")
+{
+    using bullseye_pred::AdoptedPoseMetrics;
+
+    CartesianBullseyeFrameProvider p{"SRC", CartesianBullseyeFrameProvider::Mode::kTimeSeries,
+                                     0.0};
+    Mat3 flipped = Mat3::identity();
+    flipped(2, 2) = -1.0;
+    p.add_sample(1.0, Vec3{}, Mat3::identity());
+    p.add_sample(2.0, Vec3{}, flipped);
+
+    const AdoptedRicFrame a = p.get(1.0);
+    REQUIRE(a.pose_metrics.valid);
+    REQUIRE(a.pose_metrics.ortho_max_abs == 0.0);
+    REQUIRE(a.pose_metrics.det == 1.0);
+    const AdoptedRicFrame b = p.get(2.0);
+    REQUIRE(b.pose_metrics.valid);
+    REQUIRE(b.pose_metrics.det == -1.0);
+
+    // Caller-supplied metrics are not trusted by load_presorted().
+    CartesianBullseyeFrameProvider::Sample s{};
+    s.t = 5.0;
+    s.C_from_ric_to_inertial = flipped;
+    s.pose = AdoptedPoseMetrics{true, 0.0, 1.0};
+    REQUIRE(p.load_presorted({&s, 1}));
+    REQUIRE(p.get(5.0).pose_metrics.det == -1.0);
+
+    CartesianBullseyeFrameProvider cur{"SRC", CartesianBullseyeFrameProvider::Mode::kCurrent, 0.0};
+    cur.set_current(3.0, Vec3{}, Mat3::identity());
+    REQUIRE(cur.get(3.0).pose_metrics.valid);
+}
+
+TEST_CASE("QuaternionBullseyeFrameProvider stores quaternions and serves DCMs",
+          "[frame_providers][quat]")
+{
+    using bullseye_pred::QuaternionBullseyeFrameProvider;
+    namespace m = bullseye_pred::math;
+
+    QuaternionBullseyeFrameProvider p{"QUAT_FRAME", 0.0};
+    REQUIRE(sizeof(QuaternionBullseyeFrameProvider::Sample) <
+            sizeof(CartesianBullseyeFrameProvider::Sample));
+
+    const double h = std::sqrt(0.5);
+    REQUIRE(p.add_sample(2.0, Vec3{2.0, 0.0, 0.0}, m::Quat{h, 0.0, 0.0, h})); // 90 deg about z
+    REQUIRE(p.add_sample(1.0, Vec3{1.0, 0.0, 0.0}, m::Quat{}));
+    p.set_last_sample_omega_ric(Vec3{0.0, 0.0, 1e-3}); // applies to t=1.0
+    REQUIRE_FALSE(p.add_sample(3.0, Vec3{}, m::Quat{2.0, 0.0, 0.0, 0.0}));
+    REQUIRE_FALSE(p.add_sample(3.0, Vec3{}, m::Quat{std::nan(""), 0.0, 0.0, 0.0}));
+    REQUIRE(p.sample_count() == 2u);
+
+    const AdoptedRicFrame a = p.get(1.0);
+    REQUIRE(a.status.code == ProviderCode::kOk);
+    REQUIRE(a.origin_i.x == 1.0);
+    REQUIRE(a.has_omega);
+    REQUIRE(a.omega_coords == OmegaCoords::kOmegaRIC);
+    REQUIRE(a.C_from_ric_to_inertial(0, 0) == 1.0);
+    REQUIRE(a.pose_metrics.valid);
+
+    const AdoptedRicFrame b = p.get(2.0);
+    REQUIRE(b.status.code == ProviderCode::kOk);
+    REQUIRE_FALSE(b.has_omega);
+    REQUIRE(b.frame_kind == FrameKind::kBullseyeRIC);
+    REQUIRE(b.axis_order == AxisOrder::kRIC);
+    // RIC x axis maps to inertial +y.
+    REQUIRE(std::fabs(b.C_from_ric_to_inertial(1, 0) - 1.0) <= 1e-15);
+    REQUIRE(std::fabs(b.C_from_ric_to_inertial(0, 0)) <= 1e-15);
+    REQUIRE(std::fabs(b.pose_metrics.det - 1.0) <= 1e-15);
+
+    REQUIRE(p.get(1.5).status.code == ProviderCode::kTimeMissing);
+
+    QuaternionBullseyeFrameProvider::Sample bad[2]{};
+    bad[0].t = 0.0;
+    bad[1].t = 1.0;
+    bad[1].q_from_ric_to_inertial = m::Quat{0.0, 0.0, 0.0, 0.0};
+    REQUIRE_FALSE(p.load_presorted({bad, 2}));
+    REQUIRE(p.sample_count() == 2u);
+    bad[1].q_from_ric_to_inertial = m::Quat{0.0, 1.0, 0.0, 0.0};
+    REQUIRE(p.load_presorted({bad, 2}));
+    REQUIRE(p.get(1.0).C_from_ric_to_inertial(1, 1) == -1.0);
+}
@@ -1,5 +1,7 @@
 // tests/unit/test_frame_validator.cpp
 
+#include <cmath>
+
 #include <catch2/catch_test_macros.hpp>
 
 #include "core/bullseye_frame_validator.hpp"
@@ -163,3 +165,37 @@ TEST_CASE("Adopted frame validator: omega present but wrong coords rejected", "[
     REQUIRE(res.status.code == ProviderCode::kInvalidInput);
     REQUIRE(res.reason == FrameValidationReason::kOmegaBadDeclaration);
 }
+
+TEST_CASE("Adopted frame validator: precomputed pose metrics give the same verdicts",
+          "[validator]")
+{
+    const double t0 = 100.0;
+    const Vec3 rc{1.0, 0.0, 0.0};
+    const ChiefState chief = make_ok_chief(t0, rc);
+
+    FrameValidationTolerances tol{};
+    tol.ortho_max_abs = 1e-12;
+    tol.det_one_abs = 1e-12;
+
+    Mat3 skewed = Mat3::identity();
+    skewed(0, 1) = 1e-6;
+    Mat3 flipped = Mat3::identity();
+    flipped(2, 2) = -1.0;
+
+    for (const Mat3& C : {Mat3::identity(), skewed, flipped})
+    {
+        AdoptedRicFrame frame = make_ok_frame(t0, rc);
+        frame.C_from_ric_to_inertial = C;
+        const auto direct = validate_adopted_bullseye_ric_frame(t0, chief, frame, tol);
+
+        frame.pose_metrics = bullseye_pred::compute_adopted_pose_metrics(C);
+        REQUIRE(frame.pose_metrics.valid);
+        const auto cached = validate_adopted_bullseye_ric_frame(t0, chief, frame, tol);
+        REQUIRE(cached.status.code == direct.status.code);
+        REQUIRE(cached.reason == direct.reason);
+    }
+
+    Mat3 bad = Mat3::identity();
+    bad(1, 1) = std::nan("");
+    REQUIRE_FALSE(bullseye_pred::compute_adopted_pose_metrics(bad).valid);
+}
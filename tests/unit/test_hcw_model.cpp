@@ -1,8 +1,15 @@
 // tests/unit/test_hcw_model.cpp
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#include "core/math/sincos_recurrence.hpp"
+#include "core/time_grid.hpp"
+#include "models/hcw_stm.hpp"
 #include "models/model_hcw.hpp"
 
 using bullseye_pred::HcwParams;
@@ -10,6 +17,7 @@ using bullseye_pred::ModelCode;
 using bullseye_pred::ModelHCW;
 using bullseye_pred::RelStateRic;
 using bullseye_pred::Span;
+using bullseye_pred::Span2D;
 using bullseye_pred::TimeGrid;
 using bullseye_pred::Vec3;
 
@@ -90,3 +98,186 @@ TEST_CASE("HCW: simple x0-only case matches closed-form at selected times", "[hc
         REQUIRE(r_out[k].z == Catch::Approx(e.z).epsilon(1e-12));
     }
 }
+
+TEST_CASE("HCW batch: bit-identical to per-vehicle predict_hcw", "[hcw][batch]")
+{
+    ModelHCW m;
+
+    HcwParams p{};
+    p.n_radps = 0.0011;
+
+    TimeGrid g;
+    g.tau = {0.0, 1.0, 10.0, 60.0, 600.0, 3000.0};
+    constexpr std::size_t kSteps = 6;
+    constexpr std::size_t kStride = 8; // wider than kSteps, like PredictionBuffer rows
+    constexpr std::size_t kRows = 3;
+
+    const RelStateRic x0[kRows]{
+        RelStateRic{Vec3{100.0, -50.0, 25.0}, Vec3{0.10, -0.20, 0.05}},
+        RelStateRic{Vec3{-300.0, 400.0, -10.0}, Vec3{-0.05, 0.30, 0.02}},
+        RelStateRic{Vec3{0.0, 1000.0, 0.0}, Vec3{0.0, 0.0, 0.0}},
+    };
+
+    Vec3 r_batch[kRows * kStride]{};
+    Vec3 v_batch[kRows * kStride]{};
+    ModelCode codes[kRows]{};
+
+    const auto res = m.predict_hcw_batch(Span<const RelStateRic>{x0, kRows}, p, g,
+                                         Span2D<Vec3>{r_batch, kRows, kSteps, kStride},
+                                         Span2D<Vec3>{v_batch, kRows, kSteps, kStride},
+                                         Span<ModelCode>{codes, kRows});
+    REQUIRE(res.code == ModelCode::kOk);
+    REQUIRE(res.steps_written == kSteps);
+
+    for (std::size_t i = 0; i < kRows; ++i)
+    {
+        REQUIRE(codes[i] == ModelCode::kOk);
+
+        Vec3 r_one[kSteps]{};
+        Vec3 v_one[kSteps]{};
+        REQUIRE(m.predict_hcw(x0[i], p, g, Span<Vec3>{r_one, kSteps}, Span<Vec3>{v_one, kSteps})
+                    .code == ModelCode::kOk);
+
+        for (std::size_t k = 0; k < kSteps; ++k)
+        {
+            const Vec3& rb = r_batch[i * kStride + k];
+            const Vec3& vb = v_batch[i * kStride + k];
+            REQUIRE(rb.x == r_one[k].x);
+            REQUIRE(rb.y == r_one[k].y);
+            REQUIRE(rb.z == r_one[k].z);
+            REQUIRE(vb.x == v_one[k].x);
+            REQUIRE(vb.y == v_one[k].y);
+            REQUIRE(vb.z == v_one[k].z);
+        }
+    }
+}
+
+TEST_CASE("HCW batch: invalid row is skipped, batch errors reject all", "[hcw][batch]")
+{
+    ModelHCW m;
+
+    HcwParams p{};
+    p.n_radps = 0.001;
+
+    TimeGrid g;
+    g.tau = {0.0, 10.0};
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const RelStateRic x0[2]{
+        RelStateRic{Vec3{nan, 0.0, 0.0}, Vec3{}},
+        RelStateRic{Vec3{100.0, 0.0, 0.0}, Vec3{}},
+    };
+
+    const Vec3 sentinel{-1.0, -2.0, -3.0};
+    Vec3 r_out[4]{sentinel, sentinel, sentinel, sentinel};
+    ModelCode codes[2]{};
+
+    SECTION("non-finite state fails only its row")
+    {
+        const auto res =
+            m.predict_hcw_batch(Span<const RelStateRic>{x0, 2}, p, g,
+                                Span2D<Vec3>{r_out, 2, 2, 2}, Span2D<Vec3>{},
+                                Span<ModelCode>{codes, 2});
+        REQUIRE(res.code == ModelCode::kOk);
+        REQUIRE(codes[0] == ModelCode::kInvalidInput);
+        REQUIRE(codes[1] == ModelCode::kOk);
+        REQUIRE(r_out[0].x == sentinel.x);
+        REQUIRE(r_out[1].x == sentinel.x);
+        REQUIRE(r_out[2].x == Catch::Approx(100.0));
+    }
+
+    SECTION("negative tau rejects the batch without writing")
+    {
+        g.tau = {0.0, -1.0};
+        const auto res =
+            m.predict_hcw_batch(Span<const RelStateRic>{x0 + 1, 1}, p, g,
+                                Span2D<Vec3>{r_out, 1, 2, 2}, Span2D<Vec3>{},
+                                Span<ModelCode>{nullptr, 0});
+        REQUIRE(res.code == ModelCode::kInvalidInput);
+        REQUIRE(r_out[0].x == sentinel.x);
+    }
+
+    SECTION("too few output rows")
+    {
+        const auto res =
+            m.predict_hcw_batch(Span<const RelStateRic>{x0, 2}, p, g,
+                                Span2D<Vec3>{r_out, 1, 2, 2}, Span2D<Vec3>{},
+                                Span<ModelCode>{nullptr, 0});
+        REQUIRE(res.code == ModelCode::kInsufficientOutputCapacity);
+    }
+}
+
+TEST_CASE("HCW trig recurrence: uniform grid stays within the documented bound", "[hcw][trig]")
+{
+    ModelHCW m;
+
+    HcwParams exact{};
+    exact.n_radps = 0.0011;
+
+    HcwParams fast = exact;
+    fast.trig_reanchor_interval = 64;
+
+    const TimeGrid g = bullseye_pred::make_time_grid(599.0 * 0.5, 0.5);
+    REQUIRE(g.tau.size() == 600);
+
+    const RelStateRic x0{Vec3{100.0, -50.0, 25.0}, Vec3{0.10, -0.20, 0.05}};
+
+    std::vector<Vec3> r_exact(g.tau.size()), r_fast(g.tau.size());
+    REQUIRE(m.predict_hcw(x0, exact, g, Span<Vec3>{r_exact.data(), r_exact.size()},
+                          Span<Vec3>{nullptr, 0})
+                .code == ModelCode::kOk);
+    REQUIRE(m.predict_hcw(x0, fast, g, Span<Vec3>{r_fast.data(), r_fast.size()},
+                          Span<Vec3>{nullptr, 0})
+                .code == ModelCode::kOk);
+
+    // Position error <= trig bound times the largest coefficient magnitude acting on a trig term.
+    const double n = exact.n_radps;
+    const double scale = 6.0 * 100.0 + 4.0 * 0.3 / n + 2.0 * 0.3 / n + 25.0 + 0.05 / n;
+    const double tol = bullseye_pred::math::sincos_recurrence_error_bound(64) * scale;
+
+    bool any_diff = false;
+    for (std::size_t k = 0; k < g.tau.size(); ++k)
+    {
+        REQUIRE(std::fabs(r_fast[k].x - r_exact[k].x) <= tol);
+        REQUIRE(std::fabs(r_fast[k].y - r_exact[k].y) <= tol);
+        REQUIRE(std::fabs(r_fast[k].z - r_exact[k].z) <= tol);
+        any_diff = any_diff || (r_fast[k].y != r_exact[k].y);
+
+        // Anchors are evaluated with libm and therefore exact.
+        if (k % 64 == 0)
+        {
+            REQUIRE(r_fast[k].x == r_exact[k].x);
+        }
+    }
+    REQUIRE(any_diff);
+}
+
+TEST_CASE("HCW STM: float instantiation tracks the double kernel", "[hcw][precision]")
+{
+    using bullseye_pred::BasicHcwStm;
+    using bullseye_pred::BasicVec3;
+    using bullseye_pred::HcwStm;
+
+    const double n = 0.0011;
+    const Vec3 r0{120.0, -40.0, 15.0};
+    const Vec3 v0{0.05, -0.2, 0.01};
+
+    for (const double t : {0.0, 30.0, 600.0, 2400.0})
+    {
+        const HcwStm kd = bullseye_pred::hcw_stm_at(n, 1.0 / n, t);
+        const BasicHcwStm<float> kf = bullseye_pred::hcw_stm_at<float>(
+            static_cast<float>(n), static_cast<float>(1.0 / n), static_cast<float>(t));
+
+        Vec3 rd{};
+        Vec3 vd{};
+        bullseye_pred::hcw_stm_apply(kd, r0, v0, true, rd, vd);
+        BasicVec3<float> rf{};
+        BasicVec3<float> vf{};
+        bullseye_pred::hcw_stm_apply(kf, bullseye_pred::vec3_cast<float>(r0),
+                                     bullseye_pred::vec3_cast<float>(v0), true, rf, vf);
+
+        const Vec3 err = bullseye_pred::vec3_cast<double>(rf) - rd;
+        REQUIRE(bullseye_pred::norm(err) < 1e-3 * (1.0 + bullseye_pred::norm(rd)));
+        REQUIRE(std::abs(static_cast<double>(vf.y) - vd.y) < 1e-4);
+    }
+}
@@ -0,0 +1,58 @@
+// tests/unit/test_hcw_soa_kernel.cpp
+
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "models/hcw_soa_kernel.hpp"
+#include "models/hcw_stm.hpp"
+
+using bullseye_pred::HcwKernelIsa;
+using bullseye_pred::HcwStmSoa;
+using bullseye_pred::MAX_STEPS;
+using bullseye_pred::RelStateRic;
+using bullseye_pred::Vec3;
+
+TEST_CASE("HCW SoA kernel: dispatched variant is bit-identical to scalar", "[hcw][simd]")
+{
+    const HcwKernelIsa isa = bullseye_pred::hcw_soa_kernel_isa();
+    INFO("dispatched ISA = " << static_cast<int>(isa));
+
+    const double n = 0.0011;
+    auto stm = std::make_unique<HcwStmSoa>();
+    for (std::size_t k = 0; k < MAX_STEPS; ++k)
+    {
+        stm->set(k, bullseye_pred::hcw_stm_at(n, 1.0 / n, 0.5 * static_cast<double>(k)));
+    }
+
+    const RelStateRic x0{Vec3{123.0, -456.0, 78.9}, Vec3{0.12, -0.034, 0.0056}};
+
+    // Include sizes that are not multiples of the block or vector width.
+    for (const std::size_t steps : {std::size_t{1}, std::size_t{7}, std::size_t{64},
+                                    std::size_t{65}, std::size_t{599}, MAX_STEPS})
+    {
+        if (steps > MAX_STEPS)
+        {
+            continue;
+        }
+        std::vector<Vec3> r_simd(steps), v_simd(steps), r_ref(steps), v_ref(steps);
+        bullseye_pred::hcw_soa_apply(*stm, steps, x0, r_simd.data(), v_simd.data());
+        bullseye_pred::hcw_soa_apply_scalar(*stm, steps, x0, r_ref.data(), v_ref.data());
+
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            REQUIRE(r_simd[k].x == r_ref[k].x);
+            REQUIRE(r_simd[k].y == r_ref[k].y);
+            REQUIRE(r_simd[k].z == r_ref[k].z);
+            REQUIRE(v_simd[k].x == v_ref[k].x);
+            REQUIRE(v_simd[k].y == v_ref[k].y);
+            REQUIRE(v_simd[k].z == v_ref[k].z);
+        }
+    }
+
+    // Positions-only call must not touch velocities.
+    std::vector<Vec3> r_only(5);
+    bullseye_pred::hcw_soa_apply(*stm, 5, x0, r_only.data(), nullptr);
+    REQUIRE(r_only[4].x != 0.0);
+}
@@ -0,0 +1,163 @@
+// tests/unit/test_hcw_stm_cache.cpp
+
+#include <algorithm>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "models/hcw_stm_cache.hpp"
+#include "models/model_hcw.hpp"
+
+using bullseye_pred::HcwParams;
+using bullseye_pred::HcwStmCache;
+using bullseye_pred::MAX_STEPS;
+using bullseye_pred::ModelCode;
+using bullseye_pred::ModelHCW;
+using bullseye_pred::RelStateRic;
+using bullseye_pred::Span;
+using bullseye_pred::Span2D;
+using bullseye_pred::TimeGrid;
+using bullseye_pred::Vec3;
+
+TEST_CASE("HCW STM cache: matches ModelHCW bit-for-bit", "[hcw][stm_cache]")
+{
+    HcwStmCache cache;
+    ModelHCW m;
+
+    HcwParams p{};
+    p.n_radps = 0.0011;
+
+    TimeGrid g;
+    g.tau = {0.0, 1.0, 10.0, 60.0, 600.0};
+    constexpr std::size_t kSteps = 5;
+
+    REQUIRE(cache.refresh(p, g) == ModelCode::kOk);
+    REQUIRE(cache.valid());
+    REQUIRE(cache.steps() == kSteps);
+
+    const RelStateRic x0[2]{
+        RelStateRic{Vec3{100.0, -50.0, 25.0}, Vec3{0.10, -0.20, 0.05}},
+        RelStateRic{Vec3{-300.0, 400.0, -10.0}, Vec3{-0.05, 0.30, 0.02}},
+    };
+
+    Vec3 r_cache[2 * kSteps]{};
+    Vec3 v_cache[2 * kSteps]{};
+    const auto res = cache.predict_batch(Span<const RelStateRic>{x0, 2},
+                                         Span2D<Vec3>{r_cache, 2, kSteps, kSteps},
+                                         Span2D<Vec3>{v_cache, 2, kSteps, kSteps},
+                                         Span<ModelCode>{nullptr, 0});
+    REQUIRE(res.code == ModelCode::kOk);
+    REQUIRE(res.steps_written == kSteps);
+
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        Vec3 r_one[kSteps]{};
+        Vec3 v_one[kSteps]{};
+        REQUIRE(m.predict_hcw(x0[i], p, g, Span<Vec3>{r_one, kSteps}, Span<Vec3>{v_one, kSteps})
+                    .code == ModelCode::kOk);
+        for (std::size_t k = 0; k < kSteps; ++k)
+        {
+            REQUIRE(r_cache[i * kSteps + k].x == r_one[k].x);
+            REQUIRE(r_cache[i * kSteps + k].y == r_one[k].y);
+            REQUIRE(r_cache[i * kSteps + k].z == r_one[k].z);
+            REQUIRE(v_cache[i * kSteps + k].x == v_one[k].x);
+            REQUIRE(v_cache[i * kSteps + k].y == v_one[k].y);
+            REQUIRE(v_cache[i * kSteps + k].z == v_one[k].z);
+        }
+    }
+}
+
+TEST_CASE("HCW STM cache: rebuilds only on grid change or n drift", "[hcw][stm_cache]")
+{
+    HcwStmCache cache(1.0e-6);
+
+    HcwParams p{};
+    p.n_radps = 0.001;
+
+    TimeGrid g;
+    g.tau = {0.0, 10.0, 20.0};
+
+    REQUIRE(cache.refresh(p, g) == ModelCode::kOk);
+    REQUIRE(cache.rebuilds() == 1);
+
+    // Within tolerance: reused, cached n retained.
+    p.n_radps = 0.001 * (1.0 + 5.0e-7);
+    REQUIRE(cache.refresh(p, g) == ModelCode::kOk);
+    REQUIRE(cache.rebuilds() == 1);
+    REQUIRE(cache.n_radps() == 0.001);
+
+    // Beyond tolerance: rebuilt with the new n.
+    p.n_radps = 0.001 * (1.0 + 2.0e-6);
+    REQUIRE(cache.refresh(p, g) == ModelCode::kOk);
+    REQUIRE(cache.rebuilds() == 2);
+    REQUIRE(cache.n_radps() == p.n_radps);
+
+    // Grid change: rebuilt.
+    g.tau = {0.0, 10.0, 30.0};
+    REQUIRE(cache.refresh(p, g) == ModelCode::kOk);
+    REQUIRE(cache.rebuilds() == 3);
+
+    // Invalid input empties the cache.
+    g.tau = {0.0, -1.0};
+    REQUIRE(cache.refresh(p, g) == ModelCode::kInvalidInput);
+    REQUIRE_FALSE(cache.valid());
+
+    Vec3 r_out[2]{};
+    const RelStateRic x0{};
+    REQUIRE(cache.predict_batch(Span<const RelStateRic>{&x0, 1}, Span2D<Vec3>{r_out, 1, 2, 2},
+                                Span2D<Vec3>{}, Span<ModelCode>{nullptr, 0})
+                .code == ModelCode::kInvalidInput);
+}
+
+TEST_CASE("HCW STM cache: tail evaluation matches the full trajectory", "[hcw][stm_cache]")
+{
+    HcwStmCache cache;
+
+    HcwParams p{};
+    p.n_radps = 0.0011;
+
+    TimeGrid g;
+    for (std::size_t k = 0; k < std::min<std::size_t>(150u, MAX_STEPS); ++k)
+    {
+        g.tau.push_back(static_cast<double>(k) * 2.0);
+    }
+    const std::size_t steps = g.tau.size();
+    REQUIRE(cache.refresh(p, g) == ModelCode::kOk);
+
+    const RelStateRic x0{Vec3{120.0, -40.0, 15.0}, Vec3{0.02, -0.1, 0.01}};
+    std::vector<Vec3> r_full(steps);
+    std::vector<Vec3> v_full(steps);
+    REQUIRE(cache.predict(x0, Span<Vec3>{r_full.data(), steps}, Span<Vec3>{v_full.data(), steps})
+                .code == ModelCode::kOk);
+
+    const Vec3 sentinel{-7.0, -7.0, -7.0};
+    for (const std::size_t first : {std::size_t{0}, std::size_t{1}, steps / 2u + 2u, steps})
+    {
+        std::vector<Vec3> r_tail(steps, sentinel);
+        std::vector<Vec3> v_tail(steps, sentinel);
+        REQUIRE(cache
+                    .predict_tail(x0, first, Span<Vec3>{r_tail.data(), steps},
+                                  Span<Vec3>{v_tail.data(), steps})
+                    .code == ModelCode::kOk);
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            if (k < first)
+            {
+                REQUIRE(r_tail[k].x == sentinel.x); // head untouched
+                continue;
+            }
+            REQUIRE(r_tail[k].x == r_full[k].x);
+            REQUIRE(r_tail[k].y == r_full[k].y);
+            REQUIRE(r_tail[k].z == r_full[k].z);
+            REQUIRE(v_tail[k].x == v_full[k].x);
+            REQUIRE(v_tail[k].y == v_full[k].y);
+            REQUIRE(v_tail[k].z == v_full[k].z);
+        }
+    }
+
+    std::vector<Vec3> r_out(steps);
+    REQUIRE(cache.predict_tail(x0, steps + 1, Span<Vec3>{r_out.data(), steps},
+                               Span<Vec3>{nullptr, 0})
+                .code == ModelCode::kInvalidInput);
+}
@@ -0,0 +1,170 @@
+// tests/unit/test_jeod_providers.cpp
+
+#include <cmath>
+#include <string_view>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/relative_predictor.hpp"
+#include "integration/adapters/jeod_relstate_wrapper.hpp"
+#include "integration/frame_provider_jeod.hpp"
+#include "integration/provider_jeod.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+// Same member layout as jeod::RefFrameState (trans, then rot).
+struct RefFrameStateFixture final
+{
+    struct
+    {
+        double position[3]{};
+        double velocity[3]{};
+    } trans;
+    struct
+    {
+        double T_parent_this[3][3]{};
+        double ang_vel_this[3]{};
+    } rot;
+
+    JeodStateView view() const noexcept
+    {
+        JeodStateView v{};
+        v.position = trans.position;
+        v.velocity = trans.velocity;
+        v.T_parent_this = rot.T_parent_this;
+        v.ang_vel_this = rot.ang_vel_this;
+        return v;
+    }
+};
+
+void set_trans(RefFrameStateFixture& s, const Vec3& r, const Vec3& v)
+{
+    s.trans.position[0] = r.x;
+    s.trans.position[1] = r.y;
+    s.trans.position[2] = r.z;
+    s.trans.velocity[0] = v.x;
+    s.trans.velocity[1] = v.y;
+    s.trans.velocity[2] = v.z;
+}
+
+} // namespace
+
+TEST_CASE("JEOD vehicle provider reads bound storage in one pass", "[jeod]")
+{
+    RefFrameStateFixture bodies[3]{};
+    for (int b = 0; b < 3; ++b)
+    {
+        set_trans(bodies[b], Vec3{7000e3 + b, 10.0 * b, -1.0 * b}, Vec3{0.0, 7500.0 + b, 1.0});
+    }
+    double jeod_t = 25.0;
+    JeodVehicleProvider provider("INERTIAL", &jeod_t);
+    REQUIRE(provider.bind_vehicle(11u, bodies[0].view()));
+    REQUIRE(provider.bind_vehicle(42u, bodies[1].view()));
+    REQUIRE(provider.bind_vehicle(7u, bodies[2].view()));
+    CHECK_FALSE(provider.bind_vehicle(8u, JeodStateView{}));
+    CHECK(provider.size() == 3u);
+
+    const VehicleIndexMap::VehicleId ids[4] = {42u, 7u, 99u, 11u};
+    VehicleState out[4]{};
+    Vec3 r[4]{};
+    Vec3 v[4]{};
+    CHECK(provider.get_many(Span<const VehicleIndexMap::VehicleId>{ids, 4}, 25.0,
+                            Span<VehicleState>{out, 4}, Span<Vec3>{r, 4},
+                            Span<Vec3>{v, 4}) == ProviderCode::kNotAvailable);
+    CHECK(out[0].status.ok());
+    CHECK(out[0].r_i.x == 7000e3 + 1);
+    CHECK(out[1].v_i.y == 7500.0 + 2);
+    CHECK(out[2].status.code == ProviderCode::kNotAvailable);
+    CHECK(out[3].time_tag == 25.0);
+    CHECK(std::string_view{out[3].frame_id} == "INERTIAL");
+    CHECK(r[3].y == 0.0);
+    CHECK(v[0].z == 1.0);
+
+    // Zero-copy: the next tick sees JEOD's updated storage without rebinding.
+    jeod_t = 26.0;
+    bodies[1].trans.position[0] = 123.0;
+    CHECK(provider.get(42u, 26.0).r_i.x == 123.0);
+
+    // FR-14: the JEOD clock must read exactly t0.
+    CHECK(provider.get_many(Span<const VehicleIndexMap::VehicleId>{ids, 2}, 26.5,
+                            Span<VehicleState>{out, 2}, Span<Vec3>{},
+                            Span<Vec3>{}) == ProviderCode::kTimeMissing);
+    CHECK(out[1].status.code == ProviderCode::kTimeMissing);
+    CHECK(provider.get_many(Span<const VehicleIndexMap::VehicleId>{ids, 2}, 26.0,
+                            Span<VehicleState>{out, 1}, Span<Vec3>{},
+                            Span<Vec3>{}) == ProviderCode::kInvalidInput);
+
+    JeodChiefProvider chief("INERTIAL", bodies[0].view(), &jeod_t);
+    const ChiefState c = chief.get(26.0);
+    REQUIRE(c.status.ok());
+    CHECK(c.r_i.x == 7000e3);
+    CHECK(chief.get(27.0).status.code == ProviderCode::kTimeMissing);
+    CHECK(JeodChiefProvider("INERTIAL", JeodStateView{}).get(0.0).status.code ==
+          ProviderCode::kInvalidInput);
+}
+
+TEST_CASE("JEOD frame provider maps LVLH and RIC axes", "[jeod]")
+{
+    // Chief on a circular equatorial orbit at the +x axis: R = +x, I = +y, C = +z (inertial).
+    const double w = 1.1e-3;
+    RefFrameStateFixture ric{};
+    set_trans(ric, Vec3{7000e3, 0.0, 0.0}, Vec3{0.0, 7.7e3, 0.0});
+    for (int i = 0; i < 3; ++i)
+    {
+        ric.rot.T_parent_this[i][i] = 1.0;
+    }
+    ric.rot.ang_vel_this[2] = w;
+
+    // Same frame with LVLH axes: x = I, y = -C, z = -R (rows of T are the axes in inertial).
+    RefFrameStateFixture lvlh = ric;
+    const double T_lvlh[3][3] = {{0.0, 1.0, 0.0}, {0.0, 0.0, -1.0}, {-1.0, 0.0, 0.0}};
+    for (int r = 0; r < 3; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            lvlh.rot.T_parent_this[r][c] = T_lvlh[r][c];
+        }
+    }
+    lvlh.rot.ang_vel_this[0] = 0.0;
+    lvlh.rot.ang_vel_this[1] = -w;
+    lvlh.rot.ang_vel_this[2] = 0.0;
+
+    JeodBullseyeFrameProvider as_ric("chief.ric", ric.view(), JeodFrameAxes::kRic);
+    JeodBullseyeFrameProvider as_lvlh("chief.lvlh", lvlh.view(), JeodFrameAxes::kLvlh);
+    for (JeodBullseyeFrameProvider* p : {&as_ric, &as_lvlh})
+    {
+        const AdoptedRicFrame f = p->get(5.0);
+        REQUIRE(f.status.ok());
+        CHECK(f.time_tag == 5.0);
+        CHECK(f.frame_kind == FrameKind::kBullseyeRIC);
+        CHECK(f.axis_order == AxisOrder::kRIC);
+        CHECK(f.origin_i.x == 7000e3);
+        for (int r = 0; r < 3; ++r)
+        {
+            for (int c = 0; c < 3; ++c)
+            {
+                CHECK(f.C_from_ric_to_inertial.m[r][c] == (r == c ? 1.0 : 0.0));
+            }
+        }
+        REQUIRE(f.has_omega);
+        CHECK(f.omega_coords == OmegaCoords::kOmegaRIC);
+        CHECK(f.omega_ric.x == 0.0);
+        CHECK(f.omega_ric.y == 0.0);
+        CHECK(f.omega_ric.z == Catch::Approx(w));
+    }
+
+    double jeod_t = 1.0;
+    JeodStateView no_rate = ric.view();
+    no_rate.ang_vel_this = nullptr;
+    JeodBullseyeFrameProvider timed("chief.ric", no_rate, JeodFrameAxes::kRic, &jeod_t);
+    CHECK(timed.get(2.0).status.code == ProviderCode::kTimeMissing);
+    CHECK_FALSE(timed.get(1.0).has_omega);
+    JeodStateView no_rot = ric.view();
+    no_rot.T_parent_this = nullptr;
+    CHECK(JeodBullseyeFrameProvider("x", no_rot).get(1.0).status.code ==
+          ProviderCode::kInvalidInput);
+}
@@ -0,0 +1,169 @@
+// tests/unit/test_log_macros.cpp
+
+// Compile this file at INFO: DEBUG call sites must vanish, INFO and above stay.
+#undef BULLSEYE_LOG_COMPILE_LEVEL
+#define BULLSEYE_LOG_COMPILE_LEVEL BULLSEYE_LOG_LEVEL_INFO
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "allocation_tracker.hpp"
+#include "core/log_macros.hpp"
+#include "core/logging.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+constexpr const char* kComponent = "tests.log_macros";
+
+struct Captured
+{
+    std::mutex m;
+    std::vector<std::string> lines;
+    std::vector<sim_logger::Level> levels;
+    std::thread::id writer_thread{};
+    std::atomic<bool> hold{false};
+    std::atomic<bool> entered{false};
+};
+
+void capture(void* ctx, sim_logger::Level level, sim_logger::Logger& /*logger*/,
+             const char* line) noexcept
+{
+    auto& c = *static_cast<Captured*>(ctx);
+    c.entered.store(true);
+    while (c.hold.load())
+    {
+        std::this_thread::yield();
+    }
+    const std::lock_guard<std::mutex> lock(c.m);
+    c.lines.emplace_back(line);
+    c.levels.push_back(level);
+    c.writer_thread = std::this_thread::get_id();
+}
+
+void init_info_level()
+{
+    logging::Config cfg;
+    cfg.level = sim_logger::Level::Info;
+    logging::init(cfg);
+}
+
+void log_tick(int k)
+{
+    BULLSEYE_LOG_INFOF(kComponent, "tick k=%d t=%.3f", k, 0.5 * k);
+}
+
+} // namespace
+
+TEST_CASE("Deferred log records are formatted on the drain thread", "[logging]")
+{
+    init_info_level();
+    Captured c;
+    logging::DeferredConfig cfg;
+    cfg.writer = &capture;
+    cfg.writer_ctx = &c;
+    REQUIRE(logging::start_deferred(cfg));
+    REQUIRE_FALSE(logging::start_deferred(cfg)); // already running
+
+    {
+        // C strings are copied at the call site, so temporaries are fine.
+        const std::string name = "chief-" + std::to_string(7);
+        BULLSEYE_LOG_INFOF(kComponent, "id=%llu name=%s x=%.17g null=%s",
+                           static_cast<unsigned long long>(42), name.c_str(), 0.1,
+                           static_cast<const char*>(nullptr));
+    }
+    BULLSEYE_LOG_WARNF(kComponent, "no arguments");
+    const std::string long_text(400, 'a');
+    BULLSEYE_LOG_ERRORF(kComponent, "n=%d s=%s", 3, long_text.c_str());
+
+    // Once a call site's logger is resolved, the calling thread does not allocate.
+    log_tick(0);
+    {
+        testing::ScopedAllocationCounter allocs(testing::AllocationScope::kThread);
+        log_tick(1);
+        REQUIRE(allocs.allocations() == 0u);
+    }
+
+    logging::flush_deferred();
+    logging::stop_deferred();
+
+    const std::lock_guard<std::mutex> lock(c.m);
+    REQUIRE(c.lines.size() == 5u);
+    REQUIRE(c.lines[0] == "id=42 name=chief-7 x=0.10000000000000001 null=(null)");
+    REQUIRE(c.levels[0] == sim_logger::Level::Info);
+    REQUIRE(c.lines[1] == "no arguments");
+    REQUIRE(c.levels[1] == sim_logger::Level::Warn);
+    // The string is truncated to the slot's argument space (the int is kept).
+    REQUIRE(c.lines[2].rfind("n=3 s=aaaa", 0) == 0u);
+    REQUIRE(c.lines[2].size() == std::string("n=3 s=").size() + logging::kDeferredArgBytes -
+                                     sizeof(int) - 1u);
+    REQUIRE(c.lines[4] == "tick k=1 t=0.500");
+    REQUIRE(c.writer_thread != std::this_thread::get_id());
+}
+
+TEST_CASE("A full deferred ring drops records instead of blocking", "[logging]")
+{
+    init_info_level();
+    Captured c;
+    c.hold.store(true);
+    logging::DeferredConfig cfg;
+    cfg.writer = &capture;
+    cfg.writer_ctx = &c;
+    REQUIRE(logging::start_deferred(cfg));
+
+    // The drain thread takes the first record and blocks in the writer.
+    log_tick(-1);
+    while (!c.entered.load())
+    {
+        std::this_thread::yield();
+    }
+    const std::uint64_t dropped_before = logging::deferred_dropped();
+    const int flood = static_cast<int>(cfg.capacity) + 100;
+    for (int k = 0; k < flood; ++k)
+    {
+        log_tick(k);
+    }
+    const std::uint64_t dropped = logging::deferred_dropped() - dropped_before;
+    c.hold.store(false);
+    logging::stop_deferred();
+
+    REQUIRE(dropped == 100u + 1u); // the blocked record still holds its slot
+    const std::lock_guard<std::mutex> lock(c.m);
+    REQUIRE(c.lines.size() == static_cast<std::size_t>(flood) + 1u - dropped);
+    REQUIRE(c.lines[1] == "tick k=0 t=0.000");
+}
+
+TEST_CASE("Log call sites follow the run-time and compile-time levels", "[logging]")
+{
+    init_info_level();
+    int evaluated = 0;
+    BULLSEYE_LOG_DEBUGF(kComponent, "elided %d", ++evaluated);
+    REQUIRE(evaluated == 0); // compiled out: arguments are not evaluated
+    BULLSEYE_LOG_INFOF(kComponent, "kept %d", ++evaluated);
+    REQUIRE(evaluated == 1);
+
+    // Records below the logger level are filtered before they reach the ring.
+    Captured c;
+    logging::DeferredConfig cfg;
+    cfg.writer = &capture;
+    cfg.writer_ctx = &c;
+    REQUIRE(logging::start_deferred(cfg));
+    logging::get(kComponent)->set_level(sim_logger::Level::Warn);
+    BULLSEYE_LOG_INFOF(kComponent, "filtered");
+    BULLSEYE_LOG_WARNF(kComponent, "written");
+    logging::get(kComponent)->set_level(sim_logger::Level::Info);
+    logging::stop_deferred();
+
+    const std::lock_guard<std::mutex> lock(c.m);
+    REQUIRE(c.lines == std::vector<std::string>{"written"});
+
+    cfg.capacity = 1000; // not a power of two
+    REQUIRE_FALSE(logging::start_deferred(cfg));
+}
@@ -0,0 +1,197 @@
+// tests/unit/test_maneuvers.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/frame_transforms.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/time_grid.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "models/hcw_stm.hpp"
+#include "models/hcw_stm_cache.hpp"
+#include "predictor_rig.hpp"
+
+using namespace bullseye_pred;
+using bullseye_pred::testing::Rig;
+
+namespace
+{
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kR0 = 7000e3;
+
+// Piecewise reference: coast from x0 to the burn, add dv, coast on (one STM per segment).
+Vec3 piecewise(double n, const RelStateRic& x0, double t_b, const Vec3& dv, double t)
+{
+    Vec3 r{};
+    Vec3 v{};
+    if (t < t_b)
+    {
+        hcw_stm_apply(hcw_stm_at(n, 1.0 / n, t), x0, false, r, v);
+        return r;
+    }
+    hcw_stm_apply(hcw_stm_at(n, 1.0 / n, t_b), x0, true, r, v);
+    const RelStateRic after{r, v + dv};
+    hcw_stm_apply(hcw_stm_at(n, 1.0 / n, t - t_b), after, false, r, v);
+    return r;
+}
+
+void require_near(const Vec3& a, const Vec3& b)
+{
+    CHECK(a.x == Catch::Approx(b.x).margin(1e-6));
+    CHECK(a.y == Catch::Approx(b.y).margin(1e-6));
+    CHECK(a.z == Catch::Approx(b.z).margin(1e-6));
+}
+
+// Deputy id at the chief plus (40, 80, -20) m * id, (0.01, 0, 0.002 * id) m/s.
+template <typename Predictor>
+void place_deputies(Rig<Predictor>& rig)
+{
+    rig.veh.dr_per_id = Vec3{40.0, 80.0, -20.0};
+    rig.veh.dv = Vec3{0.01, 0.0, 0.0};
+    rig.veh.dv_per_id = Vec3{0.0, 0.0, 0.002};
+}
+
+// RIC state of deputy id at t0 against the chief of the rig's last tick.
+template <typename Predictor>
+RelStateRic deputy_x0(Rig<Predictor>& rig, VehicleIndexMap::VehicleId id, double t0)
+{
+    const TickContext& tick = rig.pred.tick_context();
+    const VehicleState dep = rig.veh.get(id, t0);
+    const RelState x = inertial_to_ric_relative(dep.r_i, dep.v_i, tick.chief.r_i, tick.chief.v_i,
+                                                tick.C_i2r, tick.frame.omega_ric);
+    return RelStateRic{x.r, x.v};
+}
+
+} // namespace
+
+TEST_CASE("Cached HCW table composes impulses at and between grid samples", "[maneuver]")
+{
+    const double n = std::sqrt(kMu / (kR0 * kR0 * kR0));
+    HcwParams params{};
+    params.n_radps = n;
+    const RelStateRic x0{Vec3{100.0, -250.0, 30.0}, Vec3{0.05, -0.2, 0.01}};
+    const Vec3 dv{0.02, -0.05, 0.03};
+
+    // One hour: 20 s samples, or 10 s to 600 s then 60 s (coarser when MAX_STEPS is small).
+    const std::size_t samples = std::min<std::size_t>(181u, MAX_STEPS);
+    TimeGrid uniform;
+    uniform.tau.resize(samples);
+    for (std::size_t k = 0; k < samples; ++k)
+    {
+        uniform.tau[k] = 3600.0 * static_cast<double>(k) / static_cast<double>(samples - 1u);
+    }
+    const std::size_t fine = std::min<std::size_t>(60u, MAX_STEPS / 2u);
+    const std::size_t coarse = std::min<std::size_t>(51u, MAX_STEPS - fine);
+    TimeGrid piecewise_grid;
+    for (std::size_t k = 0; k < fine; ++k)
+    {
+        piecewise_grid.tau.push_back(600.0 * static_cast<double>(k) / static_cast<double>(fine));
+    }
+    for (std::size_t k = 0; k < coarse; ++k)
+    {
+        piecewise_grid.tau.push_back(600.0 + 3000.0 * static_cast<double>(k) /
+                                                 static_cast<double>(coarse - 1u));
+    }
+
+    for (const TimeGrid* grid : {&uniform, &piecewise_grid})
+    {
+        HcwStmCache cache;
+        REQUIRE(cache.refresh(params, *grid) == ModelCode::kOk);
+        const std::size_t steps = grid->tau.size();
+        for (const double t_b : {400.0, 913.7, 0.0})
+        {
+            std::vector<Vec3> r(steps);
+            std::vector<Vec3> v(steps);
+            REQUIRE(cache.predict(x0, Span<Vec3>{r.data(), steps}, Span<Vec3>{v.data(), steps})
+                        .code == ModelCode::kOk);
+            REQUIRE(cache
+                        .accumulate_impulse(dv, t_b, Span<Vec3>{r.data(), steps},
+                                            Span<Vec3>{v.data(), steps})
+                        .code == ModelCode::kOk);
+            for (std::size_t k = 0; k < steps; ++k)
+            {
+                require_near(r[k], piecewise(n, x0, t_b, dv, grid->tau[k]));
+            }
+
+            // Velocity just after the burn jumps by dv.
+            std::size_t at = 0;
+            while (grid->tau[at] < t_b)
+            {
+                ++at;
+            }
+            if (grid->tau[at] == t_b)
+            {
+                Vec3 rb{};
+                Vec3 vb{};
+                hcw_stm_apply(hcw_stm_at(n, 1.0 / n, t_b), x0, true, rb, vb);
+                CHECK(v[at].y == Catch::Approx(vb.y + dv.y).margin(1e-12));
+            }
+        }
+    }
+
+    HcwStmCache empty;
+    Vec3 r{};
+    CHECK(empty.accumulate_impulse(dv, 0.0, Span<Vec3>{&r, 1}, Span<Vec3>{}).code ==
+          ModelCode::kInvalidInput);
+}
+
+TEST_CASE("Predictor composes planned burns inside the horizon", "[maneuver]")
+{
+    static Rig<HcwRelativePredictor> rig;
+    place_deputies(rig);
+    const ImpulsiveBurn plan[] = {
+        ImpulsiveBurn{1000.0 + 1800.0, Vec3{0.0, 0.1, 0.0}}, // beyond the horizon
+        ImpulsiveBurn{1000.0 + 95.0, Vec3{0.03, -0.02, 0.01}},
+        ImpulsiveBurn{1000.0 - 5.0, Vec3{1.0, 1.0, 1.0}}, // already flown
+    };
+    REQUIRE(rig.pred.set_planned_burns(2u, Span<const ImpulsiveBurn>{plan, 3}));
+    CHECK_FALSE(rig.pred.set_planned_burns(9u, Span<const ImpulsiveBurn>{plan, 1}));
+    ImpulsiveBurn bad = plan[0];
+    bad.dv_ric.x = std::nan("");
+    CHECK_FALSE(rig.pred.set_planned_burns(2u, Span<const ImpulsiveBurn>{&bad, 1}));
+
+    rig.pred.step(1000.0, 600.0, 10.0);
+    const PredictionBuffer& snap = rig.pub.read();
+    REQUIRE(snap.valid_rows == 0x3u);
+    CHECK(snap.maneuver_rows == 0x2u);
+    CHECK(snap.control_unmodeled_rows == 0u);
+    CHECK(rig.pred.maneuver_stats().burns_applied == 1u);
+
+    const double n = rig.pred.tick_context().n_radps;
+    const RelStateRic x1 = deputy_x0(rig, 1u, 1000.0);
+    const RelStateRic x2 = deputy_x0(rig, 2u, 1000.0);
+    for (std::size_t k = 0; k < snap.steps; ++k)
+    {
+        Vec3 r{};
+        Vec3 v{};
+        hcw_stm_apply(hcw_stm_at(n, 1.0 / n, snap.tau[k]), x1, false, r, v);
+        require_near(snap.positions[0][k], r);
+        require_near(snap.positions[1][k], piecewise(n, x2, 95.0, plan[1].dv_ric, snap.tau[k]));
+    }
+
+    // Past its epoch the burn no longer applies; clearing the plan leaves plain coasting.
+    rig.pred.step(1100.0, 600.0, 10.0);
+    CHECK(rig.pub.read().maneuver_rows == 0u);
+    REQUIRE(rig.pred.set_planned_burns(2u, Span<const ImpulsiveBurn>{}));
+    rig.pred.step(1200.0, 600.0, 10.0);
+    CHECK(rig.pred.maneuver_stats().rows == 0u);
+}
+
+TEST_CASE("Rows whose model cannot compose burns are flagged unmodeled", "[maneuver]")
+{
+    static Rig<YaRelativePredictor> rig;
+    place_deputies(rig);
+    const ImpulsiveBurn burn{30.0, Vec3{0.01, 0.0, 0.0}};
+    REQUIRE(rig.pred.set_planned_burns(1u, Span<const ImpulsiveBurn>{&burn, 1}));
+    rig.pred.step(0.0, 300.0, 10.0);
+    const PredictionBuffer& snap = rig.pub.read();
+    REQUIRE(snap.valid_rows == 0x3u);
+    CHECK(snap.maneuver_rows == 0u);
+    CHECK(snap.control_unmodeled_rows == 0x1u);
+    CHECK(rig.pred.maneuver_stats().unmodeled_rows == 0x1u);
+}
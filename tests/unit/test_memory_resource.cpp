@@ -0,0 +1,113 @@
+// tests/unit/test_memory_resource.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "allocation_tracker.hpp"
+#include "core/frame_provider_cartesian.hpp"
+#include "core/memory_resource.hpp"
+#include "core/provider_cartesian.hpp"
+#include "core/time_grid.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+// One run's storage: chief and frame series, a streaming window and a grid.
+void fill_run(CartesianChiefProvider& chief, CartesianBullseyeFrameProvider& frames,
+              CartesianChiefProvider& stream, TimeGridCache& grids)
+{
+    for (int k = 0; k < 600; ++k)
+    {
+        const double t = static_cast<double>(k);
+        chief.add_sample(t, Vec3{7.0e6, t, 0.0}, Vec3{0.0, 7.5e3, 0.0});
+        frames.add_sample(t, Vec3{7.0e6, t, 0.0}, Mat3::identity());
+    }
+    REQUIRE(stream.configure_streaming(256u, 10.0));
+    REQUIRE(grids.get(600.0, 1.0).tau.size() == 601u);
+}
+
+} // namespace
+
+TEST_CASE("A run arena holds a whole scenario in one region", "[memory]")
+{
+    using Mode = CartesianChiefProvider::Mode;
+    using FrameMode = CartesianBullseyeFrameProvider::Mode;
+
+    // Warm up the call sites' loggers on the global heap first.
+    {
+        CartesianChiefProvider chief("INERTIAL", Mode::kTimeSeries);
+        CartesianBullseyeFrameProvider frames("ADOPTED", FrameMode::kTimeSeries);
+        CartesianChiefProvider stream("INERTIAL", Mode::kStreaming);
+        TimeGridCache grids(601u);
+        fill_run(chief, frames, stream, grids);
+    }
+
+    RunArena arena(1u << 20);
+    {
+        CartesianChiefProvider chief("INERTIAL", Mode::kTimeSeries, 1.0, &arena);
+        CartesianBullseyeFrameProvider frames("ADOPTED", FrameMode::kTimeSeries, 1.0, &arena);
+        CartesianChiefProvider stream("INERTIAL", Mode::kStreaming, 1.0, &arena);
+        TimeGridCache grids(601u, &arena);
+        {
+            testing::ScopedAllocationCounter allocs(testing::AllocationScope::kThread);
+            fill_run(chief, frames, stream, grids);
+            const TimeGrid g = make_time_grid(60.0, 1.0, &arena);
+            REQUIRE(g.tau.size() == 61u);
+            REQUIRE(allocs.allocations() == 1u); // the arena's region
+        }
+        REQUIRE(arena.regions() == 1u);
+        REQUIRE(arena.bytes_allocated() > 600u * sizeof(CartesianChiefProvider::Sample));
+        REQUIRE(chief.get(42.0).status.ok());
+        REQUIRE(frames.get(42.0).status.ok());
+    }
+
+    // Teardown: everything goes back at once and the arena can host the next run.
+    {
+        testing::ScopedAllocationCounter allocs(testing::AllocationScope::kThread);
+        arena.release();
+        REQUIRE(allocs.counts().deallocations == 1u);
+    }
+    REQUIRE(arena.regions() == 0u);
+    REQUIRE(arena.bytes_allocated() == 0u);
+
+    // An undersized arena grows by further regions instead of failing.
+    RunArena small(256u);
+    const TimeGrid g = make_time_grid(600.0, 1.0, &small);
+    REQUIRE(g.tau.size() == 601u);
+    REQUIRE(small.regions() >= 1u);
+
+    // Copies do not inherit the arena.
+    const TimeGrid copy = g;
+    REQUIRE(copy.tau.get_allocator().resource() == std::pmr::get_default_resource());
+}
+
+TEST_CASE("A pooled resource reuses storage across reloads", "[memory]")
+{
+    RunArena arena(1u << 20);
+    PooledResource pool(&arena);
+    CartesianChiefProvider chief("INERTIAL", CartesianChiefProvider::Mode::kTimeSeries, 1.0,
+                                 &pool);
+
+    std::vector<CartesianChiefProvider::Sample> series(500);
+    for (std::size_t k = 0; k < series.size(); ++k)
+    {
+        series[k].t = static_cast<double>(k);
+    }
+    const Span<const CartesianChiefProvider::Sample> all{series.data(), series.size()};
+
+    REQUIRE(chief.load_presorted(all));
+    chief.clear_samples();
+    REQUIRE(chief.load_presorted(all));
+    const std::size_t used = arena.bytes_allocated();
+    for (int cycle = 0; cycle < 5; ++cycle)
+    {
+        chief.clear_samples();
+        REQUIRE(chief.load_presorted(all));
+    }
+    REQUIRE(chief.sample_count() == 500u);
+    REQUIRE(arena.bytes_allocated() == used); // freed blocks came back to the pool
+}
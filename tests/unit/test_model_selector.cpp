@@ -0,0 +1,145 @@
+// tests/unit/test_model_selector.cpp
+
+#include <cmath>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "models/model_selector.hpp"
+
+using bullseye_pred::ModelSelectCause;
+using bullseye_pred::ModelSelection;
+using bullseye_pred::ModelSelector;
+using bullseye_pred::ModelSelectorConfig;
+using bullseye_pred::PredictorModel;
+using bullseye_pred::Vec3;
+
+namespace
+{
+
+ModelSelectorConfig test_config()
+{
+    ModelSelectorConfig cfg{};
+    cfg.e_hcw_enter = 1e-3;
+    cfg.e_hcw_exit = 2e-3;
+    cfg.rho_hcw_enter_m = 10e3;
+    cfg.rho_hcw_exit_m = 15e3;
+    cfg.model_hold_sec = 5.0;
+    cfg.cost_hcw_per_step = 1.0;
+    cfg.cost_ya_per_step = 40.0;
+    return cfg;
+}
+
+} // namespace
+
+TEST_CASE("Chief eccentricity from state", "[selector]")
+{
+    const double mu = 3.986004418e14;
+    const double rp = 7000e3;
+
+    REQUIRE(bullseye_pred::chief_eccentricity(Vec3{rp, 0.0, 0.0},
+                                              Vec3{0.0, std::sqrt(mu / rp), 0.0}, mu) ==
+            Catch::Approx(0.0).margin(1e-12));
+
+    const double e = 0.3;
+    const double vp = std::sqrt(mu * (1.0 + e) / rp);
+    REQUIRE(bullseye_pred::chief_eccentricity(Vec3{rp, 0.0, 0.0}, Vec3{0.0, vp, 0.0}, mu) ==
+            Catch::Approx(e).epsilon(1e-12));
+
+    REQUIRE(std::isnan(bullseye_pred::chief_eccentricity(Vec3{}, Vec3{0.0, 1.0, 0.0}, mu)));
+}
+
+TEST_CASE("Selector starts on HCW inside the enter region and reports cost", "[selector]")
+{
+    ModelSelector sel(test_config());
+    const ModelSelection s = sel.update(0.0, 1e-4, 1e3, 600.0, 61);
+    REQUIRE(s.model == PredictorModel::kHcw);
+    REQUIRE(s.cause == ModelSelectCause::kInitial);
+    REQUIRE_FALSE(s.switched);
+    REQUIRE(s.est_cost == 61.0);
+
+    ModelSelector far(test_config());
+    const ModelSelection f = far.update(0.0, 1e-4, 12e3, 600.0, 61); // between enter and exit
+    REQUIRE(f.model == PredictorModel::kYaStm);
+    REQUIRE(f.cause == ModelSelectCause::kInitial);
+    REQUIRE(f.est_cost == 40.0 * 61.0);
+}
+
+TEST_CASE("Selector hysteresis keeps HCW between enter and exit thresholds", "[selector]")
+{
+    ModelSelector sel(test_config());
+    REQUIRE(sel.update(0.0, 5e-4, 9e3, 600.0, 10).model == PredictorModel::kHcw);
+
+    // Drift into the hysteresis band: stays HCW.
+    ModelSelection s = sel.update(10.0, 1.5e-3, 14e3, 600.0, 10);
+    REQUIRE(s.model == PredictorModel::kHcw);
+    REQUIRE(s.cause == ModelSelectCause::kUnchanged);
+
+    // Cross the range exit: YA.
+    s = sel.update(20.0, 1.5e-3, 16e3, 600.0, 10);
+    REQUIRE(s.model == PredictorModel::kYaStm);
+    REQUIRE(s.cause == ModelSelectCause::kRangeExit);
+    REQUIRE(s.switched);
+
+    // Back inside the band (not the enter region): stays YA.
+    s = sel.update(30.0, 5e-4, 12e3, 600.0, 10);
+    REQUIRE(s.model == PredictorModel::kYaStm);
+    REQUIRE(s.cause == ModelSelectCause::kUnchanged);
+
+    // Enter region: HCW again.
+    s = sel.update(40.0, 5e-4, 9e3, 600.0, 10);
+    REQUIRE(s.model == PredictorModel::kHcw);
+    REQUIRE(s.cause == ModelSelectCause::kHcwValid);
+    REQUIRE(s.switched);
+
+    // Eccentricity exit.
+    s = sel.update(50.0, 3e-3, 9e3, 600.0, 10);
+    REQUIRE(s.model == PredictorModel::kYaStm);
+    REQUIRE(s.cause == ModelSelectCause::kEccentricityExit);
+}
+
+TEST_CASE("Selector hold time prevents flapping", "[selector]")
+{
+    ModelSelector sel(test_config());
+    REQUIRE(sel.update(0.0, 5e-4, 9e3, 600.0, 10).model == PredictorModel::kHcw);
+
+    // Range oscillates across both thresholds every second.
+    std::size_t switches = 0;
+    for (int k = 1; k <= 20; ++k)
+    {
+        const double range = (k % 2 == 1) ? 20e3 : 5e3;
+        const ModelSelection s = sel.update(static_cast<double>(k), 5e-4, range, 600.0, 10);
+        if (s.switched)
+        {
+            ++switches;
+        }
+        else if (s.cause != ModelSelectCause::kUnchanged)
+        {
+            REQUIRE(s.cause == ModelSelectCause::kHoldTime);
+        }
+    }
+    // At most one switch per hold period (5 s) over 20 s.
+    REQUIRE(switches <= 4);
+    REQUIRE(switches >= 1);
+}
+
+TEST_CASE("Selector horizon bound and invalid inputs", "[selector]")
+{
+    ModelSelectorConfig cfg = test_config();
+    cfg.t_hcw_max_sec = 3600.0;
+
+    ModelSelector sel(cfg);
+    REQUIRE(sel.update(0.0, 5e-4, 1e3, 7200.0, 10).model == PredictorModel::kYaStm);
+    REQUIRE(sel.update(10.0, 5e-4, 1e3, 600.0, 10).model == PredictorModel::kHcw);
+    const ModelSelection s = sel.update(20.0, 5e-4, 1e3, 7200.0, 10);
+    REQUIRE(s.model == PredictorModel::kYaStm);
+    REQUIRE(s.cause == ModelSelectCause::kHorizonExit);
+
+    ModelSelector bad(cfg);
+    const ModelSelection b = bad.update(0.0, std::nan(""), 1e3, 600.0, 10);
+    REQUIRE(b.model == PredictorModel::kYaStm);
+    REQUIRE(b.cause == ModelSelectCause::kInvalidInput);
+
+    bad.reset();
+    REQUIRE(bad.update(0.0, 5e-4, 1e3, 600.0, 10).cause == ModelSelectCause::kInitial);
+}
@@ -0,0 +1,267 @@
+// tests/unit/test_net_publisher.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/net_publisher.hpp"
+#include "core/publisher.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+constexpr std::size_t kSteps = std::min<std::size_t>(100u, MAX_STEPS);
+
+PublisherConfig net_publisher_config(OutputPrecision precision = OutputPrecision::kFloat64)
+{
+    PublisherConfig cfg{};
+    cfg.slots = 3;
+    cfg.precision = precision;
+    return cfg;
+}
+
+// Write rows in @p rows for snapshot s and publish them as dirty.
+void publish_rows(Publisher& pub, std::uint64_t s, RowMask rows, std::size_t steps = kSteps)
+{
+    PredictionBuffer& buf = pub.begin_write();
+    buf.steps = steps;
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        buf.tau[k] = 2.0 * static_cast<double>(k);
+    }
+    buf.valid_rows |= rows;
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        if (((rows >> i) & 1u) == 0u)
+        {
+            continue;
+        }
+        buf.row_status[i] = RowStatus::kOk;
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            buf.positions[i][k] =
+                Vec3{1000.0 * static_cast<double>(i) + static_cast<double>(k), 0.5 * s, -1.0};
+        }
+    }
+    (void)pub.publish(static_cast<double>(s), rows);
+}
+
+std::vector<unsigned char> gather(const SnapshotDeltaEncoder& enc, std::size_t d)
+{
+    std::vector<unsigned char> out;
+    for (const NetFramePiece* p = enc.frame(d).data; p != enc.frame(d).data + enc.frame(d).size;
+         ++p)
+    {
+        const auto* b = static_cast<const unsigned char*>(p->data);
+        out.insert(out.end(), b, b + p->bytes);
+    }
+    return out;
+}
+
+bool same_rows(const PredictionBuffer& a, const PredictionBuffer& b)
+{
+    if (a.seqno != b.seqno || a.t0 != b.t0 || a.steps != b.steps || a.valid_rows != b.valid_rows ||
+        std::memcmp(a.tau.data(), b.tau.data(), a.steps * sizeof(double)) != 0)
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        if (a.row_status[i] != b.row_status[i] || a.row_seqno[i] != b.row_seqno[i] ||
+            (a.row_valid(i) &&
+             std::memcmp(a.positions[i].data(), b.positions[i].data(), a.steps * sizeof(Vec3)) != 0))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("Delta encoder sends changed rows and the decoder mirrors snapshots", "[net]")
+{
+    Publisher pub(net_publisher_config());
+    NetEncoderConfig cfg{};
+    cfg.keyframe_interval = 3;
+    SnapshotDeltaEncoder enc(cfg);
+    SnapshotDeltaDecoder dec;
+
+    std::size_t key_bytes = 0;
+    for (std::uint64_t s = 1; s <= 4; ++s)
+    {
+        publish_rows(pub, s, (s == 1u) ? 0b1111u : 0b0100u);
+        const std::size_t frames = enc.encode(pub.read());
+        std::size_t bytes = 0;
+        for (std::size_t d = 0; d < frames; ++d)
+        {
+            REQUIRE(enc.frame_bytes(d) <= cfg.max_datagram_bytes);
+            bytes += enc.frame_bytes(d);
+            const std::vector<unsigned char> dgram = gather(enc, d);
+            REQUIRE(dgram.size() == enc.frame_bytes(d));
+            REQUIRE(dec.apply(dgram.data(), dgram.size()) ==
+                    ((d + 1u == frames) ? NetDecodeResult::kComplete : NetDecodeResult::kPartial));
+        }
+        REQUIRE(same_rows(dec.snapshot(), pub.read()));
+        if (s == 1u)
+        {
+            key_bytes = bytes;
+            REQUIRE(enc.last_was_keyframe());
+        }
+        else if (s == 2u)
+        {
+            REQUIRE_FALSE(enc.last_was_keyframe());
+            REQUIRE(bytes * 3u < key_bytes);
+            REQUIRE(dec.snapshot().dirty_rows == 0b0100u);
+        }
+    }
+    REQUIRE(enc.last_was_keyframe()); // interval 3: snapshots 1 and 4
+    REQUIRE(dec.stats().keyframes == 2u);
+    REQUIRE(dec.stats().lost_datagrams == 0u);
+
+    // A lost delta datagram: the decoder waits for the next keyframe.
+    publish_rows(pub, 5, 0b0011u);
+    REQUIRE(enc.encode(pub.read()) > 1u);
+    std::vector<unsigned char> first = gather(enc, 0);
+    REQUIRE(dec.apply(first.data(), first.size()) == NetDecodeResult::kPartial);
+    publish_rows(pub, 6, 0b0001u);
+    const std::size_t lost_frames = enc.encode(pub.read());
+    for (std::size_t d = 0; d < lost_frames; ++d)
+    {
+        const std::vector<unsigned char> dgram = gather(enc, d);
+        REQUIRE(dec.apply(dgram.data(), dgram.size()) == NetDecodeResult::kIgnored);
+    }
+    REQUIRE_FALSE(dec.synced());
+    REQUIRE(dec.stats().lost_datagrams > 0u);
+
+    publish_rows(pub, 7, 0b0001u);
+    const std::size_t frames = enc.encode(pub.read(), true);
+    for (std::size_t d = 0; d < frames; ++d)
+    {
+        const std::vector<unsigned char> dgram = gather(enc, d);
+        (void)dec.apply(dgram.data(), dgram.size());
+    }
+    REQUIRE(dec.synced());
+    REQUIRE(dec.seqno() == 7u);
+    REQUIRE(same_rows(dec.snapshot(), pub.read()));
+
+    const unsigned char junk[80] = {1, 2, 3};
+    REQUIRE(dec.apply(junk, sizeof(junk)) == NetDecodeResult::kMalformed);
+}
+
+TEST_CASE("Decoder rejects fragments that disagree with the snapshot being assembled", "[net]")
+{
+    Publisher pub(net_publisher_config());
+    SnapshotDeltaEncoder enc(NetEncoderConfig{});
+    SnapshotDeltaDecoder dec;
+
+    publish_rows(pub, 1, 0b1111u);
+    const std::size_t frames = enc.encode(pub.read());
+    REQUIRE(frames > 1u);
+    const std::vector<unsigned char> first = gather(enc, 0);
+    REQUIRE(dec.apply(first.data(), first.size()) == NetDecodeResult::kPartial);
+
+    // Same seqno, but more fragments than the assembly was sized for.
+    std::vector<unsigned char> forged = gather(enc, 1);
+    NetDatagramHeader h{};
+    std::memcpy(&h, forged.data(), sizeof(h));
+    h.fragments = static_cast<std::uint16_t>(frames + 100u);
+    h.fragment = static_cast<std::uint16_t>(frames + 50u);
+    std::memcpy(forged.data(), &h, sizeof(h));
+    REQUIRE(dec.apply(forged.data(), forged.size()) == NetDecodeResult::kMalformed);
+
+    // Same seqno, but a delta against another base.
+    std::memcpy(&h, gather(enc, 1).data(), sizeof(h));
+    h.kind = static_cast<std::uint8_t>(NetDatagramKind::kDelta);
+    h.base_seqno = 7u;
+    std::memcpy(forged.data(), &h, sizeof(h));
+    REQUIRE(dec.apply(forged.data(), forged.size()) == NetDecodeResult::kMalformed);
+
+    // A row segment with a status outside RowStatus.
+    forged = gather(enc, 1);
+    NetSegmentHeader seg{};
+    std::size_t off = sizeof(h);
+    std::memcpy(&seg, forged.data() + off, sizeof(seg));
+    while (seg.kind == static_cast<std::uint8_t>(NetSegmentKind::kTau))
+    {
+        off += sizeof(seg) + seg.count * sizeof(double);
+        std::memcpy(&seg, forged.data() + off, sizeof(seg));
+    }
+    seg.status = 200u;
+    std::memcpy(forged.data() + off, &seg, sizeof(seg));
+    REQUIRE(dec.apply(forged.data(), forged.size()) == NetDecodeResult::kMalformed);
+    REQUIRE(dec.stats().malformed == 3u);
+
+    // The genuine fragments still complete the snapshot.
+    for (std::size_t d = 1; d < frames; ++d)
+    {
+        const std::vector<unsigned char> dgram = gather(enc, d);
+        REQUIRE(dec.apply(dgram.data(), dgram.size()) ==
+                ((d + 1u == frames) ? NetDecodeResult::kComplete : NetDecodeResult::kPartial));
+    }
+    REQUIRE(same_rows(dec.snapshot(), pub.read()));
+}
+
+TEST_CASE("Delta encoder sends the publisher's reduced-precision plane", "[net]")
+{
+    Publisher pub(net_publisher_config(OutputPrecision::kFloat32));
+    NetEncoderConfig cfg{};
+    cfg.precision = NetPrecision::kFloat32;
+    SnapshotDeltaEncoder enc(cfg);
+    SnapshotDeltaDecoder dec;
+
+    publish_rows(pub, 1, 0b0011u);
+    std::size_t bytes = 0;
+    const std::size_t frames = enc.encode(pub.read());
+    for (std::size_t d = 0; d < frames; ++d)
+    {
+        const std::vector<unsigned char> dgram = gather(enc, d);
+        bytes += dgram.size();
+        (void)dec.apply(dgram.data(), dgram.size());
+    }
+    REQUIRE(dec.seqno() == 1u);
+    REQUIRE(bytes < 2u * kSteps * sizeof(Vec3));
+    const Vec3 r = dec.snapshot().positions[1][7];
+    REQUIRE(r.x == 1007.0);
+    REQUIRE(std::abs(r.y - 0.5) < 1e-6);
+}
+
+TEST_CASE("MulticastPublisher sends snapshots a receiver reassembles", "[net]")
+{
+    Publisher pub(net_publisher_config());
+    MulticastConfig cfg{};
+    cfg.address = "127.0.0.1";
+    cfg.port = 47311;
+    cfg.encoder.max_datagram_bytes = 1200;
+
+    MulticastReceiver rx;
+    REQUIRE(rx.open(cfg) == NetCode::kOk);
+    MulticastPublisher tx(pub, cfg);
+    REQUIRE(tx.start() == NetCode::kOk);
+    REQUIRE(tx.start() == NetCode::kInvalidInput);
+
+    SnapshotDeltaDecoder dec;
+    for (std::uint64_t s = 1; s <= 3; ++s)
+    {
+        publish_rows(pub, s, (s == 1u) ? 0b0111u : 0b0010u);
+        REQUIRE(rx.receive(dec, 5.0));
+        REQUIRE(dec.seqno() == s);
+        REQUIRE(same_rows(dec.snapshot(), pub.read()));
+    }
+    tx.stop();
+    const MulticastPublisherStats st = tx.stats();
+    REQUIRE(st.snapshots == 3u);
+    REQUIRE(st.keyframes == 1u);
+    REQUIRE(st.send_errors == 0u);
+    REQUIRE(st.datagrams > 3u);
+
+    MulticastConfig bad = cfg;
+    bad.address = "not-an-address";
+    MulticastPublisher none(pub, bad);
+    REQUIRE(none.start() == NetCode::kInvalidInput);
+}
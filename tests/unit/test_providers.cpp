@@ -1,12 +1,19 @@
 // tests/unit/test_providers.cpp
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <thread>
 
 #include <catch2/catch_test_macros.hpp>
 
 #include "core/provider_cartesian.hpp"
+#include "core/math/kepler.hpp"
+#include "core/math/universal_kepler.hpp"
 #include "core/provider_twobody.hpp"
+#include "core/provider_twobody_fleet.hpp"
 
 namespace bullseye_pred
 {
@@ -119,6 +126,138 @@ TEST_CASE("CartesianChiefProvider is deterministic for identical inputs",
     REQUIRE(bullseye_pred::bitwise_equal(a, b));
 }
 
+TEST_CASE("CartesianChiefProvider (timeseries) cursor lookup matches a binary search",
+          "[providers]")
+{
+    constexpr const char* kFrameId = "INERTIAL";
+    CartesianChiefProvider p{kFrameId, CartesianChiefProvider::Mode::kTimeSeries,
+                             /*warn_period_sec=*/0.0};
+    for (int k = 0; k < 100; ++k)
+    {
+        const double t = 0.5 * k;
+        p.add_sample(t, Vec3{t, 0.0, 0.0}, Vec3{0.0, t, 0.0});
+    }
+
+    // Monotone ticks, including a repeated t0 and missing times, never need a binary search.
+    for (int k = 0; k < 100; ++k)
+    {
+        const double t = 0.5 * k;
+        REQUIRE(p.get(t).r_i.x == t);
+        REQUIRE(p.get(t).status.code == ProviderCode::kOk);
+        REQUIRE(p.get(t + 0.25).status.code == ProviderCode::kTimeMissing);
+    }
+    REQUIRE(p.lookup_fallbacks() == 0u);
+
+    // Backward jumps and long forward gaps fall back, with the same answers.
+    REQUIRE(p.get(3.0).r_i.x == 3.0);
+    REQUIRE(p.get(40.0).r_i.x == 40.0);
+    REQUIRE(p.get(-1.0).status.code == ProviderCode::kTimeMissing);
+    REQUIRE(p.get(60.0).status.code == ProviderCode::kTimeMissing);
+    REQUIRE(p.lookup_fallbacks() == 4u);
+}
+
+TEST_CASE("CartesianChiefProvider load_presorted replaces samples without sorting",
+          "[providers]")
+{
+    using Sample = CartesianChiefProvider::Sample;
+    constexpr const char* kFrameId = "INERTIAL";
+    CartesianChiefProvider p{kFrameId, CartesianChiefProvider::Mode::kTimeSeries,
+                             /*warn_period_sec=*/0.0};
+    p.add_sample(9.0, Vec3{9.0, 0.0, 0.0}, Vec3{});
+
+    const Sample unsorted[] = {{2.0, Vec3{2.0, 0.0, 0.0}, Vec3{}}, {1.0, Vec3{}, Vec3{}}};
+    REQUIRE_FALSE(p.load_presorted({unsorted, 2}));
+    const Sample dup[] = {{1.0, Vec3{}, Vec3{}}, {1.0, Vec3{}, Vec3{}}};
+    REQUIRE_FALSE(p.load_presorted({dup, 2}));
+    REQUIRE(p.sample_count() == 1u);
+
+    const Sample sorted[] = {{1.0, Vec3{1.0, 0.0, 0.0}, Vec3{0.0, 1.0, 0.0}},
+                             {2.0, Vec3{2.0, 0.0, 0.0}, Vec3{0.0, 2.0, 0.0}},
+                             {3.0, Vec3{3.0, 0.0, 0.0}, Vec3{0.0, 3.0, 0.0}}};
+    REQUIRE(p.load_presorted({sorted, 3}));
+    REQUIRE(p.sample_count() == 3u);
+    REQUIRE(p.get(9.0).status.code == ProviderCode::kTimeMissing);
+
+    const ChiefState s = p.get(2.0);
+    REQUIRE(s.status.code == ProviderCode::kOk);
+    REQUIRE(s.r_i.x == 2.0);
+    REQUIRE(s.v_i.y == 2.0);
+
+    // Appending past the end keeps the series usable without a resort.
+    p.add_sample(4.0, Vec3{4.0, 0.0, 0.0}, Vec3{});
+    REQUIRE(p.get(4.0).r_i.x == 4.0);
+}
+
+TEST_CASE("CartesianChiefProvider (streaming) evicts outside the retention window",
+          "[providers][streaming]")
+{
+    constexpr const char* kFrameId = "INERTIAL";
+    CartesianChiefProvider p{kFrameId, CartesianChiefProvider::Mode::kStreaming,
+                             /*warn_period_sec=*/0.0};
+    REQUIRE_FALSE(p.push_sample(0.0, Vec3{}, Vec3{}));
+    REQUIRE_FALSE(p.configure_streaming(0u));
+    REQUIRE_FALSE(p.configure_streaming(8u, -1.0));
+    REQUIRE(p.configure_streaming(8u, /*retention_sec=*/2.0));
+
+    for (int k = 0; k < 8; ++k)
+    {
+        REQUIRE(p.push_sample(1.0 * k, Vec3{1.0 * k, 0.0, 0.0}, Vec3{}));
+    }
+    REQUIRE_FALSE(p.push_sample(8.0, Vec3{}, Vec3{})); // full
+    REQUIRE_FALSE(p.push_sample(7.0, Vec3{}, Vec3{})); // not after the last push
+    REQUIRE(p.streaming_dropped() == 2u);
+
+    // t0 = 4 evicts t < 2; t = 2..3 stay reachable within the retention window.
+    REQUIRE(p.get(4.0).r_i.x == 4.0);
+    REQUIRE(p.sample_count() == 6u);
+    REQUIRE(p.get(2.0).r_i.x == 2.0);
+    REQUIRE(p.get(1.0).status.code == ProviderCode::kTimeMissing);
+
+    // Eviction made room for the producer again.
+    REQUIRE(p.push_sample(8.0, Vec3{8.0, 0.0, 0.0}, Vec3{}));
+    const ChiefState s = p.get(8.0);
+    REQUIRE(s.status.code == ProviderCode::kOk);
+    REQUIRE(s.time_tag == 8.0);
+    REQUIRE(s.frame_id == kFrameId);
+    REQUIRE(p.sample_count() == 3u);
+}
+
+TEST_CASE("CartesianChiefProvider (streaming) ingests from a producer thread",
+          "[providers][streaming]")
+{
+    CartesianChiefProvider p{"INERTIAL", CartesianChiefProvider::Mode::kStreaming, 0.0};
+    REQUIRE(p.configure_streaming(16u));
+
+    constexpr int kSamples = 5000;
+    std::thread producer([&p] {
+        for (int k = 0; k < kSamples; ++k)
+        {
+            const double t = 0.1 * k;
+            while (!p.push_sample(t, Vec3{t, 2.0 * t, 0.0}, Vec3{0.0, 0.0, t}))
+            {
+                std::this_thread::yield(); // window full: wait for the consumer to evict
+            }
+        }
+    });
+
+    bool all_ok = true;
+    for (int k = 0; k < kSamples; ++k)
+    {
+        const double t = 0.1 * k;
+        ChiefState s = p.get(t);
+        while (s.status.code == ProviderCode::kTimeMissing)
+        {
+            std::this_thread::yield();
+            s = p.get(t);
+        }
+        all_ok = all_ok && s.status.code == ProviderCode::kOk && s.r_i.x == t &&
+                 s.r_i.y == 2.0 * t && s.v_i.z == t;
+    }
+    producer.join();
+    REQUIRE(all_ok);
+    REQUIRE(p.sample_count() <= 16u);
+}
+
 TEST_CASE("CartesianChiefProvider returns kInvalidInput when inertial frame id is null",
           "[providers]")
 {
@@ -203,4 +342,401 @@ TEST_CASE("TwoBodyChiefProvider rejects invalid mu", "[providers][twobody]")
 
     const ChiefState s = p.get(1.0);
     REQUIRE(s.status.code == ProviderCode::kInvalidInput);
-}
\ No newline at end of file
+}
+namespace
+{
+
+// Circular-orbit truth: r = R (cos nt, sin nt, 0), v = R n (-sin nt, cos nt, 0).
+constexpr double kMuEarth = 3.986004418e14;
+constexpr double kCircR = 7000e3;
+
+double circ_pos_err(const ChiefState& s)
+{
+    const double n = std::sqrt(kMuEarth / (kCircR * kCircR * kCircR));
+    const double th = n * s.time_tag;
+    const double dx = s.r_i.x - kCircR * std::cos(th);
+    const double dy = s.r_i.y - kCircR * std::sin(th);
+    return std::sqrt(dx * dx + dy * dy + s.r_i.z * s.r_i.z);
+}
+
+TwoBodyChiefProvider make_circular_provider()
+{
+    const double vc = std::sqrt(kMuEarth / kCircR);
+    return TwoBodyChiefProvider{"INERTIAL", kMuEarth, /*t_epoch=*/0.0, Vec3{kCircR, 0.0, 0.0},
+                                Vec3{0.0, vc, 0.0}};
+}
+
+} // namespace
+
+TEST_CASE("TwoBodyChiefProvider incremental mode tracks the cold solve over long runs",
+          "[providers][twobody][incremental]")
+{
+    TwoBodyChiefProvider cold = make_circular_provider();
+    TwoBodyChiefProvider inc = make_circular_provider();
+
+    bullseye_pred::TwoBodyIncrementalConfig cfg{};
+    cfg.enabled = true;
+    cfg.reanchor_interval = 64;
+    REQUIRE(inc.configure_incremental(cfg));
+
+    double max_cold = 0.0;
+    double max_inc = 0.0;
+    double max_diff = 0.0;
+    for (int k = 0; k < 2000; ++k)
+    {
+        const double t = 30.0 * 86400.0 + 1.0 * k;
+        const ChiefState a = cold.get(t);
+        const ChiefState b = inc.get(t);
+        REQUIRE(a.status.code == ProviderCode::kOk);
+        REQUIRE(b.status.code == ProviderCode::kOk);
+        REQUIRE(b.time_tag == t);
+        max_cold = std::max(max_cold, circ_pos_err(a));
+        max_inc = std::max(max_inc, circ_pos_err(b));
+        max_diff = std::max(max_diff, norm(a.r_i - b.r_i));
+    }
+
+    REQUIRE(max_cold < 1e-3);
+    REQUIRE(max_inc < 1e-3);
+    REQUIRE(max_diff < 1e-3);
+
+    // First call and every 64th solve re-anchor to the epoch; the rest are short arcs.
+    REQUIRE(inc.epoch_solves() == 32U);
+    REQUIRE(inc.cached_solves() == 1968U);
+}
+
+TEST_CASE("TwoBodyChiefProvider incremental results depend only on the request sequence",
+          "[providers][twobody][incremental][determinism]")
+{
+    bullseye_pred::TwoBodyIncrementalConfig cfg{};
+    cfg.enabled = true;
+    cfg.reanchor_interval = 16;
+
+    TwoBodyChiefProvider a = make_circular_provider();
+    TwoBodyChiefProvider b = make_circular_provider();
+    REQUIRE(a.configure_incremental(cfg));
+    REQUIRE(b.configure_incremental(cfg));
+
+    constexpr std::size_t kN = 100;
+    double t[kN];
+    ChiefState many[kN];
+    for (std::size_t k = 0; k < kN; ++k)
+    {
+        // Mostly forward with occasional jumps back toward the epoch.
+        t[k] = (k % 37 == 36) ? 5.0 * k : 1.0e5 + 10.0 * k;
+    }
+
+    REQUIRE(b.get_many(bullseye_pred::Span<const double>{t, kN},
+                       bullseye_pred::Span<ChiefState>{many, kN}) == ProviderCode::kOk);
+    for (std::size_t k = 0; k < kN; ++k)
+    {
+        const ChiefState s = a.get(t[k]);
+        REQUIRE(bullseye_pred::bitwise_equal(s, many[k]));
+    }
+
+    // Reconfiguring drops the cache: the sequence replays bit-identically.
+    REQUIRE(b.configure_incremental(cfg));
+    for (std::size_t k = 0; k < kN; ++k)
+    {
+        REQUIRE(bullseye_pred::bitwise_equal(b.get(t[k]), many[k]));
+    }
+}
+
+TEST_CASE("TwoBodyChiefProvider incremental config and get_many validation",
+          "[providers][twobody][incremental]")
+{
+    TwoBodyChiefProvider p = make_circular_provider();
+
+    bullseye_pred::TwoBodyIncrementalConfig cfg{};
+    cfg.enabled = true;
+    cfg.reanchor_interval = 0;
+    REQUIRE_FALSE(p.configure_incremental(cfg));
+    REQUIRE_FALSE(p.incremental().enabled);
+
+    // Interval 1: every solve is epoch-referenced (warm guess only).
+    cfg.reanchor_interval = 1;
+    REQUIRE(p.configure_incremental(cfg));
+    TwoBodyChiefProvider cold = make_circular_provider();
+    for (int k = 1; k <= 10; ++k)
+    {
+        const ChiefState s = p.get(100.0 * k);
+        const ChiefState c = cold.get(100.0 * k);
+        REQUIRE(s.status.code == ProviderCode::kOk);
+        REQUIRE(norm(s.r_i - c.r_i) < 1e-6);
+    }
+    REQUIRE(p.cached_solves() == 0U);
+    REQUIRE(p.epoch_solves() == 10U);
+
+    double t[2] = {1.0, 2.0};
+    ChiefState out[1];
+    REQUIRE(p.get_many(bullseye_pred::Span<const double>{t, 2},
+                       bullseye_pred::Span<ChiefState>{out, 1}) == ProviderCode::kInvalidInput);
+
+    TwoBodyChiefProvider bad{"INERTIAL", /*mu=*/0.0, /*t_epoch=*/0.0, Vec3{kCircR, 0.0, 0.0},
+                             Vec3{0.0, 7546.0, 0.0}};
+    ChiefState out2[2];
+    REQUIRE(bad.get_many(bullseye_pred::Span<const double>{t, 2},
+                         bullseye_pred::Span<ChiefState>{out2, 2}) == ProviderCode::kInvalidInput);
+    REQUIRE(out2[1].status.code == ProviderCode::kInvalidInput);
+}
+
+TEST_CASE("stumpff_CS matches the separate Stumpff functions bit-for-bit",
+          "[providers][twobody][universal]")
+{
+    const double zs[] = {-40.0, -1.0, -1e-9, 0.0, 1e-9, 1e-3, 0.5, 2.0, 39.4, 1.0e3};
+    for (const double z : zs)
+    {
+        const bullseye_pred::math::StumpffCS cs = bullseye_pred::math::stumpff_CS(z);
+        REQUIRE(cs.C == bullseye_pred::math::stumpff_C(z));
+        REQUIRE(cs.S == bullseye_pred::math::stumpff_S(z));
+    }
+}
+
+TEST_CASE("solve_kepler_elliptic_quartic converges in fixed iterations with sin and cos of E",
+          "[providers][twobody][elliptic]")
+{
+    namespace m = bullseye_pred::math;
+    constexpr double kPi = 3.14159265358979323846;
+
+    double worst = 0.0;
+    double worst_trig = 0.0;
+    for (int j = 0; j <= 19; ++j)
+    {
+        const double e = 0.05 * j; // 0 to 0.95
+        for (int i = 0; i <= 400; ++i)
+        {
+            const double M = -kPi + 2.0 * kPi * i / 400.0;
+            const m::EllipticAnomaly a = m::solve_kepler_elliptic_quartic(M, e, 3);
+            worst = std::max(worst, std::fabs(a.E - e * std::sin(a.E) - M));
+            worst_trig = std::max(worst_trig, std::fabs(a.sin_E - std::sin(a.E)));
+            worst_trig = std::max(worst_trig, std::fabs(a.cos_E - std::cos(a.E)));
+        }
+    }
+    REQUIRE(worst < 1e-14);
+    REQUIRE(worst_trig < 1e-15);
+
+    // Agrees with the Newton solver, and a circular orbit is the identity.
+    const m::EllipticAnomaly a = m::solve_kepler_elliptic_quartic(1.2, 0.3, 3);
+    REQUIRE(std::fabs(a.E - m::solve_kepler_elliptic(1.2, 0.3, 16)) < 1e-14);
+    REQUIRE(m::solve_kepler_elliptic_quartic(0.7, 0.0, 3).E == 0.7);
+}
+
+TEST_CASE("universal_propagate terminates early on the step tolerance",
+          "[providers][twobody][universal]")
+{
+    namespace m = bullseye_pred::math;
+
+    const double vc = std::sqrt(kMuEarth / kCircR);
+    const Vec3 r0{kCircR, 0.0, 0.0};
+    const Vec3 v0{0.0, vc, 0.0};
+    const double alpha = 2.0 / kCircR - vc * vc / kMuEarth;
+
+    double t = 0.0;
+    for (int k = 0; k < 20; ++k)
+    {
+        t = 37.0 + 811.0 * k;
+        const double chi0 = m::universal_initial_guess(alpha, std::sqrt(kMuEarth), kCircR, t);
+
+        m::UniversalPropagation a{};
+        m::UniversalPropagation b{};
+        REQUIRE(m::universal_propagate(r0, v0, kMuEarth, t, chi0, 12, a));
+        REQUIRE(m::universal_propagate(r0, v0, kMuEarth, t, chi0, 12, b));
+        REQUIRE(a.converged);
+        REQUIRE(a.iterations < 12);
+        REQUIRE(a.iterations == b.iterations);
+        REQUIRE(a.chi == b.chi);
+
+        ChiefState s{};
+        s.time_tag = t;
+        s.r_i = a.r_i;
+        REQUIRE(circ_pos_err(s) < 1e-6);
+    }
+
+    // Zero arc converges immediately to the initial state.
+    m::UniversalPropagation z{};
+    REQUIRE(m::universal_propagate(r0, v0, kMuEarth, 0.0, 0.0, 12, z));
+    REQUIRE(z.iterations == 1);
+    REQUIRE(z.r_i.x == r0.x);
+    REQUIRE(z.v_i.y == v0.y);
+
+    // Cap reached: not converged, but still a finite state; invalid inputs are rejected.
+    m::UniversalPropagation c{};
+    REQUIRE(m::universal_propagate(r0, v0, kMuEarth, 5000.0, 0.0, 1, c));
+    REQUIRE_FALSE(c.converged);
+    REQUIRE(c.iterations == 1);
+    REQUIRE_FALSE(m::universal_propagate(r0, v0, -1.0, 10.0, 0.0, 12, c));
+    REQUIRE_FALSE(m::universal_propagate(Vec3{}, v0, kMuEarth, 10.0, 0.0, 12, c));
+}
+
+TEST_CASE("TwoBodyChiefProvider warm starts need fewer Newton iterations",
+          "[providers][twobody][incremental][universal]")
+{
+    // e ~ 0.2: the cold starter is no longer exact (it is for a circular orbit).
+    const Vec3 r0{kCircR, 0.0, 0.0};
+    const Vec3 v0{0.0, 1.1 * std::sqrt(kMuEarth / kCircR), 0.0};
+    TwoBodyChiefProvider cold{"INERTIAL", kMuEarth, /*t_epoch=*/0.0, r0, v0};
+    TwoBodyChiefProvider inc{"INERTIAL", kMuEarth, /*t_epoch=*/0.0, r0, v0};
+    cold.set_elliptic_fast_path(false);
+
+    bullseye_pred::TwoBodyIncrementalConfig cfg{};
+    cfg.enabled = true;
+    REQUIRE(inc.configure_incremental(cfg));
+
+    double max_diff = 0.0;
+    for (int k = 0; k < 500; ++k)
+    {
+        const double t = 86400.0 + 1.0 * k;
+        const ChiefState a = cold.get(t);
+        const ChiefState b = inc.get(t);
+        REQUIRE(a.status.code == ProviderCode::kOk);
+        REQUIRE(b.status.code == ProviderCode::kOk);
+        max_diff = std::max(max_diff, norm(a.r_i - b.r_i));
+    }
+    REQUIRE(max_diff < 1e-3);
+    REQUIRE(cold.newton_iterations() <= 500U * 6U);
+    REQUIRE(inc.newton_iterations() < cold.newton_iterations());
+}
+
+TEST_CASE("TwoBodyChiefProvider elliptic fast path matches the universal-variable solve",
+          "[providers][twobody][elliptic]")
+{
+    // Circular, e ~ 0.2 inclined, e ~ 0.9 (a Molniya-like apogee), and near-parabolic.
+    const double vc = std::sqrt(kMuEarth / kCircR);
+    const Vec3 r0[] = {Vec3{kCircR, 0.0, 0.0}, Vec3{kCircR, 0.0, 0.0},
+                       Vec3{-1.0e6, kCircR, 2.0e5}, Vec3{kCircR, 0.0, 0.0}};
+    const Vec3 v0[] = {Vec3{0.0, vc, 0.0}, Vec3{30.0, 1.05 * vc, 0.35 * vc},
+                       Vec3{-1.376 * vc, 0.0, 0.05 * vc}, Vec3{0.0, 1.405 * vc, 0.0}};
+    const bool fast[] = {true, true, true, false};
+
+    for (std::size_t k = 0; k < 4; ++k)
+    {
+        TwoBodyChiefProvider p{"INERTIAL", kMuEarth, /*t_epoch=*/0.0, r0[k], v0[k]};
+        TwoBodyChiefProvider ref{"INERTIAL", kMuEarth, /*t_epoch=*/0.0, r0[k], v0[k]};
+        ref.set_elliptic_fast_path(false);
+        REQUIRE(p.elliptic_fast_path() == fast[k]);
+        REQUIRE_FALSE(ref.elliptic_fast_path());
+
+        const Vec3 h0 = cross(r0[k], v0[k]);
+        const double energy0 = 0.5 * dot(v0[k], v0[k]) - kMuEarth / norm(r0[k]);
+        for (const double t : {0.0, 1.0, 437.5, 5400.0, -3000.0})
+        {
+            const ChiefState a = p.get(t);
+            const ChiefState b = ref.get(t);
+            REQUIRE(a.status.code == ProviderCode::kOk);
+            REQUIRE(a.time_tag == t);
+            REQUIRE(norm(a.r_i - b.r_i) < 1e-5 * norm(b.r_i));
+            REQUIRE(norm(a.v_i - b.v_i) < 1e-5 * norm(b.v_i));
+
+            // Orbit constants are preserved.
+            REQUIRE(norm(cross(a.r_i, a.v_i) - h0) < 1e-10 * norm(h0));
+            const double energy = 0.5 * dot(a.v_i, a.v_i) - kMuEarth / norm(a.r_i);
+            REQUIRE(std::fabs(energy - energy0) < 1e-10 * std::fabs(energy0));
+        }
+        REQUIRE(p.elliptic_solves() == (fast[k] ? 5U : 0U));
+        REQUIRE(p.newton_iterations() == (fast[k] ? 0U : ref.newton_iterations()));
+    }
+
+    // The epoch is reproduced, and a month out the circular orbit stays on its analytic track.
+    TwoBodyChiefProvider circ = make_circular_provider();
+    const ChiefState s0 = circ.get(0.0);
+    REQUIRE(norm(s0.r_i - Vec3{kCircR, 0.0, 0.0}) < 1e-8);
+    REQUIRE(norm(s0.v_i - Vec3{0.0, vc, 0.0}) < 1e-11);
+    for (int k = 0; k < 200; ++k)
+    {
+        const ChiefState s = circ.get(30.0 * 86400.0 + 7.0 * k);
+        REQUIRE(circ_pos_err(s) < 1e-3);
+        REQUIRE(bullseye_pred::bitwise_equal(s, circ.get(s.time_tag)));
+    }
+
+    // Incremental mode keeps universal variables; hyperbolic chiefs never take the fast path.
+    bullseye_pred::TwoBodyIncrementalConfig cfg{};
+    cfg.enabled = true;
+    REQUIRE(circ.configure_incremental(cfg));
+    REQUIRE_FALSE(circ.elliptic_fast_path());
+    TwoBodyChiefProvider hyper{"INERTIAL", kMuEarth, 0.0, Vec3{kCircR, 0.0, 0.0},
+                               Vec3{0.0, 1.5 * vc, 0.0}};
+    REQUIRE_FALSE(hyper.elliptic_fast_path());
+    REQUIRE(hyper.get(600.0).status.code == ProviderCode::kOk);
+}
+
+TEST_CASE("TwoBodyVehicleProvider batch matches per-vehicle TwoBodyChiefProvider bitwise",
+          "[providers][twobody]")
+{
+    using bullseye_pred::TwoBodyVehicleProvider;
+    using bullseye_pred::VehicleState;
+    using VehicleId = bullseye_pred::VehicleIndexMap::VehicleId;
+
+    constexpr const char* kFrameId = "INERTIAL";
+    const double mu = 3.986004418e14;
+
+    // Circular, eccentric, hyperbolic, and an inclined near-circular deputy.
+    const VehicleId ids[] = {11u, 4u, 29u, 7u};
+    const double t_epoch[] = {0.0, 5.0, -20.0, 100.0};
+    const Vec3 r0[] = {Vec3{7000e3, 0.0, 0.0}, Vec3{6800e3, 100e3, 0.0},
+                       Vec3{7200e3, 0.0, 50e3}, Vec3{0.0, 7010e3, 0.0}};
+    const Vec3 v0[] = {Vec3{0.0, 7546.05329, 0.0}, Vec3{-50.0, 8600.0, 10.0},
+                       Vec3{0.0, 11500.0, 300.0}, Vec3{-7540.0, 0.0, 120.0}};
+
+    TwoBodyVehicleProvider fleet{kFrameId, mu};
+    for (std::size_t k = 0; k < 4; ++k)
+    {
+        REQUIRE(fleet.add_vehicle(ids[k], t_epoch[k], r0[k], v0[k]));
+    }
+    REQUIRE(fleet.size() == 4u);
+
+    VehicleState out[4]{};
+    Vec3 r_plane[4]{};
+    for (double t0 : {0.0, 1.5, 600.0, 5400.0})
+    {
+        REQUIRE(fleet.get_many({ids, 4}, t0, {out, 4}, {r_plane, 4}, {}) == ProviderCode::kOk);
+        for (std::size_t k = 0; k < 4; ++k)
+        {
+            TwoBodyChiefProvider ref{kFrameId, mu, t_epoch[k], r0[k], v0[k]};
+            ref.set_elliptic_fast_path(false);
+            const ChiefState c = ref.get(t0);
+            REQUIRE(c.status.code == ProviderCode::kOk);
+            REQUIRE(out[k].status.code == ProviderCode::kOk);
+            REQUIRE(out[k].frame_id == kFrameId);
+            REQUIRE(out[k].time_tag == t0);
+            REQUIRE(std::memcmp(&out[k].r_i, &c.r_i, sizeof(Vec3)) == 0);
+            REQUIRE(std::memcmp(&out[k].v_i, &c.v_i, sizeof(Vec3)) == 0);
+            REQUIRE(std::memcmp(&r_plane[k], &c.r_i, sizeof(Vec3)) == 0);
+
+            // Single-vehicle get() takes the same lane arithmetic.
+            const VehicleState s = fleet.get(ids[k], t0);
+            REQUIRE(std::memcmp(&s.r_i, &c.r_i, sizeof(Vec3)) == 0);
+            REQUIRE(std::memcmp(&s.v_i, &c.v_i, sizeof(Vec3)) == 0);
+        }
+    }
+}
+
+TEST_CASE("TwoBodyVehicleProvider rejects bad inputs and reports unknown ids",
+          "[providers][twobody]")
+{
+    using bullseye_pred::TwoBodyVehicleProvider;
+    using bullseye_pred::VehicleState;
+    using VehicleId = bullseye_pred::VehicleIndexMap::VehicleId;
+
+    const double mu = 3.986004418e14;
+    TwoBodyVehicleProvider fleet{"INERTIAL", mu};
+    REQUIRE_FALSE(fleet.add_vehicle(1u, 0.0, Vec3{}, Vec3{0.0, 7.5e3, 0.0}));
+    REQUIRE_FALSE(fleet.add_vehicle(1u, std::nan(""), Vec3{7000e3, 0.0, 0.0}, Vec3{}));
+    REQUIRE(fleet.size() == 0u);
+    for (VehicleId id = 0; id < TwoBodyVehicleProvider::kCapacity; ++id)
+    {
+        REQUIRE(fleet.add_vehicle(id, 0.0, Vec3{7000e3 + id, 0.0, 0.0}, Vec3{0.0, 7.5e3, 0.0}));
+    }
+    REQUIRE_FALSE(fleet.add_vehicle(1000u, 0.0, Vec3{7000e3, 0.0, 0.0}, Vec3{0.0, 7.5e3, 0.0}));
+
+    const VehicleId ids[] = {3u, 1000u, 5u};
+    VehicleState out[3]{};
+    REQUIRE(fleet.get_many({ids, 3}, 10.0, {out, 2}, {}, {}) == ProviderCode::kInvalidInput);
+    REQUIRE(fleet.get_many({ids, 3}, 10.0, {out, 3}, {}, {}) == ProviderCode::kNotAvailable);
+    REQUIRE(out[0].status.code == ProviderCode::kOk);
+    REQUIRE(out[1].status.code == ProviderCode::kNotAvailable);
+    REQUIRE(out[2].status.code == ProviderCode::kOk);
+    REQUIRE(fleet.get(1000u, 10.0).status.code == ProviderCode::kNotAvailable);
+
+    TwoBodyVehicleProvider bad{"INERTIAL", /*mu=*/0.0};
+    REQUIRE(bad.add_vehicle(1u, 0.0, Vec3{7000e3, 0.0, 0.0}, Vec3{0.0, 7.5e3, 0.0}));
+    REQUIRE(bad.get(1u, 1.0).status.code == ProviderCode::kInvalidInput);
+}
@@ -1,6 +1,14 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "core/publisher.hpp"
+#include "core/shm_snapshot.hpp"
+#include "core/sized_publisher.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
 
 using bullseye_pred::Publisher;
 
@@ -92,3 +100,590 @@ TEST_CASE("Front snapshot is stable until next publish")
     REQUIRE(front_published.seqno == 2);
     REQUIRE(front_published.positions[0][0].x == 9.0);
 }
+
+TEST_CASE("Velocity plane is attached only when configured")
+{
+    Publisher plain;
+    REQUIRE_FALSE(plain.has_velocities());
+    REQUIRE_FALSE(plain.begin_write().has_velocities());
+    REQUIRE_FALSE(plain.read().has_velocities());
+
+    bullseye_pred::PublisherConfig cfg{};
+    cfg.velocities = true;
+    Publisher pub(cfg);
+    REQUIRE(pub.has_velocities());
+
+    // Each buffer has its own plane; it flips with the snapshot.
+    auto& back = pub.begin_write();
+    REQUIRE(back.has_velocities());
+    REQUIRE(back.velocities != pub.read().velocities);
+    (*back.velocities)[0][0] = {0.1, 0.2, 0.3};
+    pub.publish(10.0);
+
+    const auto& front = pub.read();
+    REQUIRE(front.has_velocities());
+    REQUIRE((*front.velocities)[0][0].x == 0.1);
+    REQUIRE((*front.velocities)[0][0].z == 0.3);
+}
+
+TEST_CASE("Sized publisher carves runtime-sized buffers from an arena")
+{
+    using bullseye_pred::PredictionArena;
+    using bullseye_pred::PredictionDims;
+    using bullseye_pred::SizedPublisher;
+
+    // 4 vehicles x 61 steps with velocities: at the default capacity, a small fraction of one
+    // fixed PredictionBuffer.
+    const PredictionDims dims{4, 61, true};
+    const std::size_t bytes = SizedPublisher::required_bytes(dims);
+    REQUIRE(bytes > 0);
+    if (bullseye_pred::MAX_VEHICLES >= 32u && bullseye_pred::MAX_STEPS >= 600u)
+    {
+        REQUIRE(bytes < sizeof(bullseye_pred::PredictionBuffer) / 10);
+    }
+
+    PredictionArena arena(bytes);
+    REQUIRE(arena.valid());
+
+    SizedPublisher pub;
+    REQUIRE_FALSE(pub.ready());
+    REQUIRE(pub.init(arena, dims));
+    REQUIRE(pub.ready());
+    REQUIRE(arena.used() == bytes);
+    REQUIRE_FALSE(pub.init(arena, dims)); // once only
+
+    auto& back = pub.begin_write();
+    REQUIRE(back.positions.rows == 4);
+    REQUIRE(back.positions.cols == 61);
+    REQUIRE(back.has_velocities());
+    REQUIRE(reinterpret_cast<std::uintptr_t>(back.positions.data) % PredictionArena::kAlign == 0);
+    REQUIRE(back.positions.data != pub.read().positions.data);
+
+    back.steps = 61;
+    back.tau[60] = 60.0;
+    back.positions.row(3)[60] = {1.0, 2.0, 3.0};
+    back.velocities.row(3)[60] = {0.1, 0.2, 0.3};
+    REQUIRE(pub.publish(5.0) == 1);
+
+    const auto& front = pub.read();
+    REQUIRE(front.seqno == 1);
+    REQUIRE(front.t0 == 5.0);
+    REQUIRE(front.steps == 61);
+    REQUIRE(front.tau[60] == 60.0);
+    REQUIRE(front.positions.row(3)[60].z == 3.0);
+    REQUIRE(front.velocities.row(3)[60].x == 0.1);
+
+    // Rows beyond MAX_VEHICLES are just a larger arena.
+    const PredictionDims wide{500, 61, false};
+    PredictionArena big(SizedPublisher::required_bytes(wide));
+    SizedPublisher wide_pub;
+    REQUIRE(wide_pub.init(big, wide));
+    REQUIRE(wide_pub.begin_write().positions.rows == 500);
+    REQUIRE_FALSE(wide_pub.begin_write().has_velocities());
+}
+
+TEST_CASE("Sized publisher rejects invalid dims and undersized arenas")
+{
+    using bullseye_pred::PredictionArena;
+    using bullseye_pred::PredictionDims;
+    using bullseye_pred::SizedPublisher;
+
+    REQUIRE(SizedPublisher::required_bytes(PredictionDims{0, 10, false}) == 0);
+
+    const PredictionDims dims{2, 10, false};
+    PredictionArena small(SizedPublisher::required_bytes(dims) - 1);
+    SizedPublisher pub;
+    REQUIRE_FALSE(pub.init(small, dims));
+    REQUIRE(small.used() == 0);
+
+    PredictionArena empty;
+    REQUIRE_FALSE(empty.valid());
+    REQUIRE_FALSE(pub.init(empty, dims));
+    REQUIRE(empty.allocate(8) == nullptr);
+
+    // Arena blocks are zeroed and aligned; exhaustion returns nullptr without consuming.
+    PredictionArena arena(128);
+    double* a = arena.allocate_array<double>(4);
+    REQUIRE(a != nullptr);
+    REQUIRE(a[3] == 0.0);
+    REQUIRE(arena.used() == PredictionArena::kAlign);
+    REQUIRE(arena.allocate(128) == nullptr);
+    REQUIRE(arena.used() == PredictionArena::kAlign);
+}
+
+TEST_CASE("Ring publisher keeps leased snapshots intact")
+{
+    bullseye_pred::PublisherConfig cfg{};
+    cfg.slots = 3;
+    Publisher pub(cfg);
+    REQUIRE(pub.slots() == 3);
+
+    pub.begin_write().positions[0][0] = {1.0, 0.0, 0.0};
+    pub.publish(10.0);
+
+    bullseye_pred::SnapshotLease lease = pub.acquire();
+    REQUIRE(lease.held());
+    REQUIRE(lease->seqno == 1);
+
+    // The producer cycles through the two unleased slots; the leased one is never rewritten.
+    for (int k = 2; k <= 6; ++k)
+    {
+        auto& back = pub.begin_write();
+        REQUIRE(&back != &lease.get());
+        back.positions[0][0] = {static_cast<double>(k), 0.0, 0.0};
+        pub.publish(10.0 * k);
+        REQUIRE(pub.read().positions[0][0].x == static_cast<double>(k));
+    }
+    REQUIRE(lease->positions[0][0].x == 1.0);
+    REQUIRE(lease.valid());
+    REQUIRE(pub.lease_overruns() == 0);
+
+    lease.release();
+    REQUIRE_FALSE(lease.held());
+    REQUIRE_FALSE(lease.valid());
+}
+
+TEST_CASE("Snapshot lease detects rewrites the producer could not avoid")
+{
+    // Double buffer: the front of tick 1 is rewritten by the write for tick 3.
+    {
+        Publisher pub;
+        pub.begin_write();
+        pub.publish(1.0);
+        bullseye_pred::SnapshotLease lease = pub.acquire();
+        REQUIRE(lease.valid());
+
+        pub.begin_write();
+        pub.publish(2.0);
+        REQUIRE(lease.valid());
+
+        pub.begin_write(); // opens the leased buffer
+        REQUIRE_FALSE(lease.valid());
+        pub.publish(3.0);
+        REQUIRE_FALSE(lease.valid());
+    }
+
+    // Ring with every non-front slot leased: the producer does not block, it overruns one.
+    {
+        bullseye_pred::PublisherConfig cfg{};
+        cfg.slots = 3;
+        Publisher pub(cfg);
+        pub.begin_write();
+        pub.publish(1.0);
+        bullseye_pred::SnapshotLease a = pub.acquire();
+        pub.begin_write();
+        pub.publish(2.0);
+        bullseye_pred::SnapshotLease b = pub.acquire();
+        pub.begin_write();
+        pub.publish(3.0);
+
+        REQUIRE(pub.lease_overruns() == 0);
+        pub.begin_write();
+        REQUIRE(pub.lease_overruns() == 1);
+        REQUIRE(a.valid() != b.valid());
+        pub.publish(4.0);
+
+        // Moving a lease keeps its validity state and releases the source.
+        bullseye_pred::SnapshotLease moved = std::move(b);
+        REQUIRE_FALSE(b.held());
+        REQUIRE(moved.held());
+    }
+
+    // Out-of-range slot counts fall back to the double buffer.
+    bullseye_pred::PublisherConfig bad{};
+    bad.slots = Publisher::kMaxSlots + 1;
+    REQUIRE(Publisher(bad).slots() == 2);
+}
+
+TEST_CASE("History ring retains older snapshots by seqno and time")
+{
+    bullseye_pred::PublisherConfig cfg{};
+    cfg.history = 3;
+    static Publisher pub(cfg);
+    REQUIRE(pub.slots() == 5);
+    REQUIRE(pub.history_depth() == 3);
+
+    REQUIRE_FALSE(pub.acquire().held()); // nothing published yet
+
+    for (int k = 1; k <= 10; ++k)
+    {
+        pub.begin_write().positions[0][0] = {static_cast<double>(k), 0.0, 0.0};
+        pub.publish(100.0 + 10.0 * k);
+    }
+
+    // Front (10) and the four slots behind it are retained; the next write takes the oldest,
+    // leaving history_depth() snapshots behind the front.
+    REQUIRE(pub.acquire_seqno(6).held());
+    pub.begin_write().positions[0][0] = {11.0, 0.0, 0.0};
+    REQUIRE_FALSE(pub.acquire_seqno(6).held());
+    for (std::uint64_t seq = 7; seq <= 10; ++seq)
+    {
+        const bullseye_pred::SnapshotLease lease = pub.acquire_seqno(seq);
+        REQUIRE(lease.held());
+        REQUIRE(lease->seqno == seq);
+        REQUIRE(lease->positions[0][0].x == static_cast<double>(seq));
+        REQUIRE(lease.valid());
+    }
+    REQUIRE_FALSE(pub.acquire_seqno(5).held());
+    REQUIRE_FALSE(pub.acquire_seqno(11).held()); // being written
+    REQUIRE_FALSE(pub.acquire_seqno(0).held());
+    pub.publish(210.0);
+
+    // Newest snapshot at or before t0.
+    REQUIRE(pub.acquire_time(185.0)->seqno == 8);
+    REQUIRE(pub.acquire_time(190.0)->seqno == 9);
+    REQUIRE(pub.acquire_time(205.0)->seqno == 10);
+    REQUIRE(pub.acquire_time(1.0e9)->seqno == 11);
+    REQUIRE_FALSE(pub.acquire_time(150.0).held());
+
+    // A leased history entry outlives the depth while the producer has free slots.
+    bullseye_pred::SnapshotLease old = pub.acquire_seqno(7);
+    for (int k = 12; k <= 20; ++k)
+    {
+        pub.begin_write();
+        pub.publish(100.0 + 10.0 * k);
+    }
+    REQUIRE(old.valid());
+    REQUIRE(old->seqno == 7);
+    REQUIRE(pub.acquire_seqno(7).held());
+    REQUIRE(pub.acquire_seqno(18).held());
+    REQUIRE(pub.lease_overruns() == 0);
+}
+
+TEST_CASE("Clean rows are carried over from the front and reported as deltas")
+{
+    using bullseye_pred::RowMask;
+    using bullseye_pred::RowStatus;
+
+    static Publisher pub;
+    const auto write_row = [](bullseye_pred::PredictionBuffer& buf, std::size_t i, double x) {
+        buf.steps = 1;
+        buf.positions[i][0] = {x, 0.0, 0.0};
+        buf.row_status[i] = RowStatus::kOk;
+        buf.valid_rows |= RowMask{1} << i;
+    };
+
+    // Full publish: every row is dirty.
+    auto& b1 = pub.begin_write();
+    write_row(b1, 0, 1.0);
+    write_row(b1, 1, 1.0);
+    REQUIRE(pub.publish(10.0) == 1);
+    REQUIRE(pub.read().dirty_rows == bullseye_pred::kAllRows);
+
+    // Delta: only row 0 rewritten; row 1 comes from the front.
+    write_row(pub.begin_write(), 0, 2.0);
+    REQUIRE(pub.publish(20.0, RowMask{1}) == 2);
+    const auto& f2 = pub.read();
+    REQUIRE(f2.dirty_rows == RowMask{1});
+    REQUIRE(f2.positions[1][0].x == 1.0);
+    REQUIRE(f2.row_status[1] == RowStatus::kOk);
+    REQUIRE(f2.valid_rows == RowMask{3});
+    REQUIRE(f2.row_seqno[0] == 2);
+    REQUIRE(f2.row_seqno[1] == 1);
+    const std::uint64_t copies = pub.carried_row_copies();
+    REQUIRE(copies == bullseye_pred::MAX_VEHICLES - 1);
+
+    // The back buffer already holds row 1 from snapshot 1: nothing to copy.
+    write_row(pub.begin_write(), 0, 3.0);
+    pub.publish(30.0, RowMask{1});
+    REQUIRE(pub.carried_row_copies() == copies);
+    REQUIRE(pub.read().positions[1][0].x == 1.0);
+    REQUIRE(pub.read().rows_changed_since(2) == RowMask{1});
+    REQUIRE(pub.read().rows_changed_since(3) == 0);
+    REQUIRE(pub.read().rows_changed_since(0) == bullseye_pred::kAllRows);
+
+    // Row 0 in the back buffer is stale (snapshot 2): copied, row 1 rewritten.
+    write_row(pub.begin_write(), 1, 4.0);
+    pub.publish(40.0, RowMask{2});
+    const auto& f4 = pub.read();
+    REQUIRE(pub.carried_row_copies() == copies + 1);
+    REQUIRE(f4.positions[0][0].x == 3.0);
+    REQUIRE(f4.positions[1][0].x == 4.0);
+    REQUIRE(f4.rows_changed_since(2) == RowMask{3});
+    REQUIRE(f4.rows_changed_since(3) == RowMask{2});
+
+    // An abandoned write leaves the back buffer unknown: every clean row is copied in full.
+    auto& scratch = pub.begin_write();
+    write_row(scratch, 0, -1.0);
+    write_row(scratch, 1, -1.0);
+    pub.abandon_write();
+    REQUIRE(pub.published_seqno() == 4);
+    write_row(pub.begin_write(), 1, 5.0);
+    pub.publish(50.0, RowMask{2});
+    REQUIRE(pub.read().positions[0][0].x == 3.0);
+    REQUIRE(pub.read().positions[1][0].x == 5.0);
+
+    // Relayed rows keep the epoch the producer wrote; the others are stamped with t0.
+    auto& b6 = pub.begin_write();
+    write_row(b6, 0, 6.0);
+    write_row(b6, 1, 6.0);
+    b6.row_t0[0] = 45.0;
+    b6.row_t0[1] = 45.0;
+    REQUIRE(pub.publish(60.0, RowMask{3}, RowMask{1} | RowMask{4}) == 6);
+    REQUIRE(pub.read().row_t0[0] == 45.0);
+    REQUIRE(pub.read().row_t0[1] == 60.0);
+    REQUIRE(pub.read().row_seqno[0] == 6);
+    REQUIRE(pub.read().row_t0[2] != 45.0);
+}
+
+TEST_CASE("Shared-memory publisher exposes snapshots to a separate read-only mapping")
+{
+    using bullseye_pred::ShmCode;
+    using bullseye_pred::ShmReadView;
+    using bullseye_pred::ShmSnapshotReader;
+
+    const char* name = "/bullseye_pred_test_publisher";
+    bullseye_pred::PublisherConfig cfg{};
+    cfg.slots = 3;
+    cfg.velocities = true;
+    cfg.inertial_positions = true;
+    cfg.shm_name = name;
+
+    ShmSnapshotReader reader;
+    {
+        static Publisher pub(cfg);
+        REQUIRE(pub.shm_status() == ShmCode::kOk);
+        REQUIRE(pub.is_shared());
+        REQUIRE(pub.slots() == 3);
+        REQUIRE(pub.has_velocities());
+
+        REQUIRE(reader.open(name) == ShmCode::kOk);
+        REQUIRE(reader.slots() == 3);
+        REQUIRE(reader.has_velocities());
+        REQUIRE(reader.has_inertial_positions());
+        ShmReadView view{};
+        REQUIRE_FALSE(reader.begin_read(view)); // nothing published yet
+
+        auto& back = pub.begin_write();
+        back.steps = 2;
+        back.positions[1][1] = {1.0, 2.0, 3.0};
+        (*back.velocities)[1][1] = {4.0, 5.0, 6.0};
+        (*back.positions_i)[1][1] = {7.0e6, 8.0, 9.0};
+        REQUIRE(pub.publish(7.0) == 1);
+
+        // The reader's mapping is at a different address; the data is the same memory.
+        REQUIRE(reader.begin_read(view));
+        REQUIRE(view.snapshot != &pub.read());
+        REQUIRE(view.snapshot->seqno == 1);
+        REQUIRE(view.snapshot->t0 == 7.0);
+        REQUIRE(view.snapshot->positions[1][1].y == 2.0);
+        REQUIRE(view.velocities != nullptr);
+        REQUIRE((*view.velocities)[1][1].z == 6.0);
+        REQUIRE(view.positions_i != nullptr);
+        REQUIRE(view.positions_i != view.velocities);
+        REQUIRE((*view.positions_i)[1][1].x == 7.0e6);
+        REQUIRE(reader.validate(view));
+        REQUIRE(reader.published_seqno() == 1);
+
+        // In-process leases still work on the shared buffers.
+        REQUIRE(pub.acquire()->seqno == 1);
+
+        // The viewed slot is the oldest once the unused slots are filled; rewriting it fails
+        // validation.
+        pub.begin_write();
+        pub.publish(8.0);
+        pub.begin_write();
+        pub.publish(9.0);
+        REQUIRE(reader.validate(view));
+        pub.begin_write();
+        REQUIRE_FALSE(reader.validate(view));
+        pub.publish(10.0);
+        REQUIRE(reader.begin_read(view));
+        REQUIRE(view.snapshot->seqno == 4);
+        REQUIRE(reader.validate(view));
+    }
+
+    ShmSnapshotReader missing;
+    REQUIRE(missing.open("/bullseye_pred_test_missing") == ShmCode::kOpenFailed);
+    REQUIRE(missing.open("no_slash") == ShmCode::kInvalidName);
+    REQUIRE_FALSE(missing.is_open());
+}
+
+TEST_CASE("wait_for_seqno blocks until a newer snapshot is published")
+{
+    static Publisher pub;
+
+    // Nothing newer: returns the current seqno once the timeout expires (or immediately).
+    REQUIRE(pub.wait_for_seqno(0, 0.0) == 0);
+    REQUIRE(pub.wait_for_seqno(0, 0.01) == 0);
+
+    pub.begin_write();
+    pub.publish(1.0);
+    REQUIRE(pub.wait_for_seqno(0, 0.0) == 1);
+
+    // A blocked reader is woken by the next publish.
+    std::uint64_t seen = 0;
+    std::thread reader([&seen] { seen = pub.wait_for_seqno(1, 30.0); });
+    pub.begin_write();
+    pub.publish(2.0);
+    reader.join();
+    REQUIRE(seen == 2);
+
+    // Readers of a shared segment wait on the same word from their own mapping.
+    bullseye_pred::PublisherConfig cfg{};
+    cfg.shm_name = "/bullseye_pred_test_wait";
+    static Publisher shared(cfg);
+    REQUIRE(shared.is_shared());
+    bullseye_pred::ShmSnapshotReader shm;
+    REQUIRE(shm.open(cfg.shm_name) == bullseye_pred::ShmCode::kOk);
+    REQUIRE(shm.wait_for_seqno(0, 0.01) == 0);
+    std::uint64_t shm_seen = 0;
+    std::thread shm_reader([&shm, &shm_seen] { shm_seen = shm.wait_for_seqno(0, 30.0); });
+    shared.begin_write();
+    shared.publish(3.0);
+    shm_reader.join();
+    REQUIRE(shm_seen == 1);
+}
+
+TEST_CASE("SoA position planes mirror positions in the configured layout")
+{
+    using bullseye_pred::RicAxis;
+    using bullseye_pred::SoaLayout;
+
+    bullseye_pred::PublisherConfig vcfg{};
+    vcfg.soa_layout = SoaLayout::kVehicleMajor;
+    bullseye_pred::PublisherConfig scfg{};
+    scfg.soa_layout = SoaLayout::kStepMajor;
+    static Publisher vpub(vcfg);
+    static Publisher spub(scfg);
+    REQUIRE_FALSE(Publisher{}.read().has_soa());
+
+    Publisher* const pubs[] = {&vpub, &spub};
+    for (Publisher* pub : pubs)
+    {
+        REQUIRE(pub->read().has_soa());
+        auto& back = pub->begin_write();
+        back.steps = 4;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            for (std::size_t k = 0; k < 4; ++k)
+            {
+                back.positions[i][k] = {10.0 * i + k, 100.0 + i, -1.0 * k};
+            }
+        }
+        pub->publish(1.0);
+
+        const auto& snap = pub->read();
+        const auto r = snap.soa->view(RicAxis::kR, 3, 4);
+        const auto c = snap.soa->view(RicAxis::kC, 3, 4);
+        if (pub->soa_layout() == SoaLayout::kVehicleMajor)
+        {
+            // Row = vehicle: contiguous time series.
+            REQUIRE(r.rows == 3);
+            REQUIRE(r.row(2)[3] == 23.0);
+            REQUIRE(&r.row(2)[3] == &r.row(2)[2] + 1);
+        }
+        else
+        {
+            // Row = step: contiguous slice across vehicles.
+            REQUIRE(r.rows == 4);
+            REQUIRE(r.row(3)[2] == 23.0);
+            REQUIRE(&r.row(3)[2] == &r.row(3)[1] + 1);
+        }
+        REQUIRE(snap.soa->at(RicAxis::kI, 1, 2) == 101.0);
+        REQUIRE(snap.soa->at(RicAxis::kC, 0, 3) == -3.0);
+        REQUIRE(c.data != nullptr);
+
+        // Rows carried over by a delta publish keep their planes in step with positions.
+        auto& next = pub->begin_write();
+        next.steps = 4;
+        next.positions[0][0] = {-5.0, 0.0, 0.0};
+        pub->publish(2.0, bullseye_pred::RowMask{1});
+        REQUIRE(pub->read().soa->at(RicAxis::kR, 0, 0) == -5.0);
+        REQUIRE(pub->read().soa->at(RicAxis::kR, 2, 3) == 23.0);
+    }
+}
+
+TEST_CASE("Reduced-precision planes carry float32 or scaled int32 positions")
+{
+    using bullseye_pred::OutputPrecision;
+
+    STATIC_REQUIRE(2 * sizeof(bullseye_pred::Float32Plane) ==
+                   sizeof(bullseye_pred::TrajectoryPlane));
+    STATIC_REQUIRE(sizeof(bullseye_pred::Fixed32Plane) == sizeof(bullseye_pred::Float32Plane));
+
+    bullseye_pred::PublisherConfig fcfg{};
+    fcfg.precision = OutputPrecision::kFloat32;
+    static Publisher fpub(fcfg);
+    REQUIRE(fpub.precision() == OutputPrecision::kFloat32);
+    auto& fb = fpub.begin_write();
+    fb.steps = 2;
+    fb.positions[0][1] = {1234.5678, -0.25, 3.0e5};
+    fpub.publish(1.0);
+    const auto& fs = fpub.read();
+    REQUIRE(fs.positions_q32 == nullptr);
+    REQUIRE((*fs.positions_f32)[0][1].x == static_cast<float>(1234.5678));
+    REQUIRE((*fs.positions_f32)[0][1].y == -0.25f);
+
+    // Millimetre fixed point, published through a shared segment.
+    bullseye_pred::PublisherConfig qcfg{};
+    qcfg.precision = OutputPrecision::kFixed32;
+    qcfg.fixed32_scale_m = 1.0e-3;
+    qcfg.shm_name = "/bullseye_pred_test_fixed32";
+    static Publisher qpub(qcfg);
+    REQUIRE(qpub.is_shared());
+    REQUIRE(qpub.precision() == OutputPrecision::kFixed32);
+    auto& qb = qpub.begin_write();
+    qb.steps = 2;
+    qb.positions[0][0] = {1.0004, -2.0006, 0.0};
+    qb.positions[1][1] = {3.0e6, 0.0, 0.0}; // beyond +/-2147 km at mm resolution
+    qb.positions[2][0] = {std::nan(""), 0.0, 0.0};
+    qpub.publish(2.0);
+    const auto& qs = qpub.read();
+    REQUIRE(qs.q32_scale_m == 1.0e-3);
+    REQUIRE((*qs.positions_q32)[0][0].x == 1000);
+    REQUIRE((*qs.positions_q32)[0][0].y == -2001);
+    REQUIRE(qs.q32_position(0, 0).x == 1.0);
+    REQUIRE((*qs.positions_q32)[1][1].x == INT32_MAX);
+    REQUIRE(qs.q32_saturated == bullseye_pred::RowMask{2});
+    REQUIRE((*qs.positions_q32)[2][0].x == bullseye_pred::kFixed32Invalid);
+    REQUIRE(std::isnan(qs.q32_position(2, 0).x));
+
+    bullseye_pred::ShmSnapshotReader reader;
+    REQUIRE(reader.open(qcfg.shm_name) == bullseye_pred::ShmCode::kOk);
+    bullseye_pred::ShmReadView view{};
+    REQUIRE(reader.begin_read(view));
+    REQUIRE(view.positions_f32 == nullptr);
+    REQUIRE(view.positions_q32 != nullptr);
+    REQUIRE((*view.positions_q32)[0][0].y == -2001);
+    REQUIRE(view.snapshot->q32_scale_m == 1.0e-3);
+    REQUIRE(reader.validate(view));
+}
+
+TEST_CASE("Placed publisher carves pre-faulted buffers from one mapping")
+{
+    bullseye_pred::PublisherConfig cfg{};
+    cfg.history = 2;
+    cfg.velocities = true;
+    cfg.placement.huge_pages = true;
+    cfg.placement.prefault = true;
+    cfg.placement.numa_node = bullseye_pred::kNumaLocal;
+    Publisher pub(cfg);
+
+#if defined(__linux__)
+    REQUIRE(pub.is_placed());
+    REQUIRE(pub.placement().prefaulted);
+#endif
+    REQUIRE(pub.slots() == 4u);
+    REQUIRE(pub.has_velocities());
+
+    for (int k = 1; k <= 5; ++k)
+    {
+        auto& back = pub.begin_write();
+        back.positions[0][0] = {static_cast<double>(k), 0.0, 0.0};
+        (*back.velocities)[0][0] = {0.0, static_cast<double>(k), 0.0};
+        pub.publish(static_cast<double>(k));
+    }
+    REQUIRE(pub.read().positions[0][0].x == 5.0);
+    REQUIRE((*pub.read().velocities)[0][0].y == 5.0);
+
+    const auto older = pub.acquire_seqno(3u);
+    REQUIRE(older.held());
+    REQUIRE(older->positions[0][0].x == 3.0);
+    REQUIRE(older.valid());
+
+    // Unrequested placement keeps the heap buffers.
+    Publisher plain;
+    REQUIRE_FALSE(plain.is_placed());
+    REQUIRE_FALSE(plain.placement().prefaulted);
+}
@@ -1,9 +1,16 @@
 // tests/unit/test_relative_predictor_injection.cpp
 
+#include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #include "core/relative_predictor.hpp"
+#include "core/relative_predictor_impl.hpp"
 
 #include "core/bullseye_frame.hpp"
 #include "core/chief_state_provider.hpp"
@@ -12,7 +19,9 @@
 #include "core/time_grid.hpp"
 #include "core/types.hpp"
 #include "core/vehicle_index_map.hpp"
+#include "models/model_hcw.hpp"
 #include "models/relative_model.hpp"
+#include "test_capacity.hpp"
 
 using namespace bullseye_pred;
 
@@ -69,8 +78,8 @@ TEST_CASE("RelativePredictor (injection): writes model outputs into prediction b
 {
     // Vehicle registry
     VehicleIndexMap map;
-    const VehicleIndexMap::VehicleId veh0 = static_cast<std::uint64_t>(0xBEEFu)
-    REQUIRE(map.register_vehicle("veh0").has_value());
+    const VehicleIndexMap::VehicleId veh0 = static_cast<std::uint64_t>(0xBEEFu);
+    REQUIRE(map.register_vehicle(veh0).has_value());
     // Chief and adopted frame providers: simplest path is constructed-only bullseye.
     FixedChief chief;
     chief.s.r_i = Vec3{7000e3, 0.0, 0.0};
@@ -102,13 +111,1219 @@ TEST_CASE("RelativePredictor (injection): writes model outputs into prediction b
     pred.step(t0, /*horizon*/ 2.0, /*cadence*/ 1.0);
 
     // Validate published buffer contents
-    const auto snap = pub.read();
-    REQUIRE(snap != nullptr);
-    REQUIRE(snap->t0 == t0);
+    REQUIRE(pub.published_seqno() == 1);
+    const auto& snap = pub.read();
+    REQUIRE(snap.t0 == t0);
 
     // TimeGrid: {0,1,2} => 3 steps (assuming your make_time_grid includes endpoint).
     // Your time_grid semantics are already tested; use that same expectation:
-    REQUIRE(snap->positions[0][0].x == 0.0);
-    REQUIRE(snap->positions[0][1].x == 1.0);
-    REQUIRE(snap->positions[0][2].x == 2.0);
+    REQUIRE(snap.positions[0][0].x == 0.0);
+    REQUIRE(snap.positions[0][1].x == 1.0);
+    REQUIRE(snap.positions[0][2].x == 2.0);
+}
+
+namespace
+{
+
+struct PredictorRig
+{
+    VehicleIndexMap map;
+    FixedChief chief;
+    FixedVehicle veh;
+
+    PredictorRig()
+    {
+        const double mu = 3.986004418e14;
+        const double r0 = 7000e3;
+        chief.s.r_i = Vec3{r0, 0.0, 0.0};
+        chief.s.v_i = Vec3{0.0, std::sqrt(mu / r0), 0.0};
+        chief.s.frame_id = "INERTIAL";
+        chief.s.status.code = ProviderCode::kOk;
+
+        // Deputy 100 m radially outward with a small in-track drift.
+        veh.s.r_i = Vec3{r0 + 100.0, 0.0, 0.0};
+        veh.s.v_i = Vec3{0.0, chief.s.v_i.y + 0.05, 0.0};
+        veh.s.frame_id = chief.s.frame_id;
+        veh.s.status.code = ProviderCode::kOk;
+
+        (void)map.register_vehicle(1u);
+        (void)map.register_vehicle(2u);
+    }
+};
+
+// YA/TH through the per-row predict() path only (no predict_block hook).
+class RowOnlyYaPolicy final
+{
+  public:
+    explicit RowOnlyYaPolicy(const RelativePredictorConfig& config) noexcept : ya_(config) {}
+
+    bool begin_tick(const ChiefState& chief, double n_radps, const TimeGrid& grid) noexcept
+    {
+        return ya_.begin_tick(chief, n_radps, grid);
+    }
+
+    bool predict(const RelStateRic& x0, Span<Vec3> out_r, Span<Vec3> out_v) noexcept
+    {
+        return ya_.predict(x0, out_r, out_v);
+    }
+
+  private:
+    YaStmPolicy ya_;
+};
+
+} // namespace
+
+TEST_CASE("RelativePredictor: chief is queried once per tick and shared with the frame",
+          "[predictor]")
+{
+    class CountingChief final : public IChiefStateProvider
+    {
+      public:
+        ChiefState s{};
+        int calls{0};
+        [[nodiscard]] ChiefState get(double t0) noexcept override
+        {
+            ++calls;
+            s.time_tag = t0;
+            return s;
+        }
+    };
+
+    VehicleIndexMap map;
+    REQUIRE(map.register_vehicle(7u).has_value());
+    CountingChief chief;
+    chief.s.r_i = Vec3{7000e3, 0.0, 0.0};
+    chief.s.v_i = Vec3{0.0, 7500.0, 0.0};
+    chief.s.frame_id = "INERTIAL";
+    chief.s.status.code = ProviderCode::kOk;
+    BullseyeFrame bullseye(chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+
+    FixedVehicle veh;
+    veh.s.r_i = Vec3{7000e3 + 100.0, 0.0, 0.0};
+    veh.s.v_i = chief.s.v_i;
+    veh.s.frame_id = chief.s.frame_id;
+    veh.s.status.code = ProviderCode::kOk;
+
+    Publisher pub;
+    FakeModel model;
+    RelativePredictor pred(pub, map, chief, veh, bullseye, model);
+    REQUIRE_FALSE(pred.tick_context().valid);
+
+    for (int k = 0; k < 3; ++k)
+    {
+        pred.step(10.0 * k, 2.0, 1.0);
+    }
+    REQUIRE(pub.published_seqno() == 3);
+    REQUIRE(chief.calls == 3);
+
+    const TickContext& ctx = pred.tick_context();
+    REQUIRE(ctx.valid);
+    REQUIRE(ctx.t0 == 20.0);
+    REQUIRE(ctx.chief.time_tag == 20.0);
+    REQUIRE(ctx.frame.status.ok());
+    REQUIRE(ctx.n_radps > 0.0);
+
+    // The shared snapshot equals a standalone update() at the same time.
+    const BullseyeFrameSnapshot ref = bullseye.update(20.0);
+    REQUIRE(chief.calls == 4);
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            REQUIRE(ctx.C_r2i.m[i][j] == ref.C_from_ric_to_inertial.m[i][j]);
+            REQUIRE(ctx.C_i2r.m[j][i] == ref.C_from_ric_to_inertial.m[i][j]);
+        }
+    }
+
+    // A failed chief query invalidates the context.
+    chief.s.status.code = ProviderCode::kTimeMissing;
+    pred.step(30.0, 2.0, 1.0);
+    REQUIRE(pub.published_seqno() == 3);
+    REQUIRE_FALSE(pred.tick_context().valid);
+}
+
+TEST_CASE("RelativePredictor: static HCW policy matches the runtime-configured predictor",
+          "[predictor]")
+{
+    static PredictorRig rig_a;
+    static PredictorRig rig_b;
+
+    static BullseyeFrame bullseye_a(rig_a.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    static BullseyeFrame bullseye_b(rig_b.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+
+    static Publisher pub_a;
+    static Publisher pub_b;
+
+    static RelativePredictor dynamic(pub_a, rig_a.map, rig_a.chief, rig_a.veh, bullseye_a);
+    static HcwRelativePredictor hcw(pub_b, rig_b.map, rig_b.chief, rig_b.veh, bullseye_b);
+
+    dynamic.step(5.0, 60.0, 1.0);
+    hcw.step(5.0, 60.0, 1.0);
+
+    REQUIRE(pub_a.published_seqno() == 1);
+    REQUIRE(pub_b.published_seqno() == 1);
+    const auto& a = pub_a.read();
+    const auto& b = pub_b.read();
+
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        for (std::size_t k = 0; k <= 60; ++k)
+        {
+            REQUIRE(a.positions[i][k].x == b.positions[i][k].x);
+            REQUIRE(a.positions[i][k].y == b.positions[i][k].y);
+            REQUIRE(a.positions[i][k].z == b.positions[i][k].z);
+        }
+    }
+    REQUIRE(a.positions[0][0].x == Catch::Approx(100.0).margin(1e-6));
+    REQUIRE(a.positions[0][60].y != 0.0);
+}
+
+TEST_CASE("RelativePredictor: YA/TH policy agrees with HCW for a circular chief", "[predictor]")
+{
+    static PredictorRig rig_hcw;
+    static PredictorRig rig_ya;
+
+    static BullseyeFrame bullseye_hcw(rig_hcw.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    static BullseyeFrame bullseye_ya(rig_ya.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+
+    static Publisher pub_hcw;
+    static Publisher pub_ya;
+
+    RelativePredictorConfig cfg{};
+    cfg.model = PredictorModel::kYaStm;
+    cfg.ya_max_dt_sec = 0.5;
+
+    static HcwRelativePredictor hcw(pub_hcw, rig_hcw.map, rig_hcw.chief, rig_hcw.veh,
+                                    bullseye_hcw);
+    static RelativePredictor ya(pub_ya, rig_ya.map, rig_ya.chief, rig_ya.veh, bullseye_ya, cfg);
+
+    hcw.step(0.0, 60.0, 5.0);
+    ya.step(0.0, 60.0, 5.0);
+
+    REQUIRE(pub_hcw.published_seqno() == 1);
+    REQUIRE(pub_ya.published_seqno() == 1);
+    const auto& h = pub_hcw.read();
+    const auto& y = pub_ya.read();
+
+    for (std::size_t k = 0; k <= 12; ++k)
+    {
+        REQUIRE(y.positions[0][k].x == Catch::Approx(h.positions[0][k].x).margin(1e-3));
+        REQUIRE(y.positions[0][k].y == Catch::Approx(h.positions[0][k].y).margin(1e-3));
+        REQUIRE(y.positions[0][k].z == Catch::Approx(h.positions[0][k].z).margin(1e-3));
+    }
+}
+
+TEST_CASE("RelativePredictor: lockstep YA/TH block matches the per-row path", "[predictor]")
+{
+    static_assert(has_predict_block<YaStmPolicy>::value, "YA policy is batched");
+    static_assert(!has_predict_block<RowOnlyYaPolicy>::value, "row-only policy");
+
+    static PredictorRig rig_block;
+    static PredictorRig rig_rows;
+
+    static BullseyeFrame bullseye_block(rig_block.chief, nullptr,
+                                        BullseyeFrameMode::kConstructedOnly);
+    static BullseyeFrame bullseye_rows(rig_rows.chief, nullptr,
+                                       BullseyeFrameMode::kConstructedOnly);
+
+    static Publisher pub_block;
+    static Publisher pub_rows;
+
+    RelativePredictorConfig cfg{};
+    cfg.ya_max_dt_sec = 0.5;
+
+    static YaRelativePredictor block(pub_block, rig_block.map, rig_block.chief, rig_block.veh,
+                                     bullseye_block, cfg);
+    static BasicRelativePredictor<RowOnlyYaPolicy> rows(pub_rows, rig_rows.map, rig_rows.chief,
+                                                        rig_rows.veh, bullseye_rows, cfg);
+
+    block.step(0.0, 60.0, 5.0);
+    rows.step(0.0, 60.0, 5.0);
+
+    REQUIRE(pub_block.published_seqno() == 1);
+    REQUIRE(pub_rows.published_seqno() == 1);
+    const auto& a = pub_block.read();
+    const auto& b = pub_rows.read();
+
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        for (std::size_t k = 0; k <= 12; ++k)
+        {
+            REQUIRE(a.positions[i][k].x == b.positions[i][k].x);
+            REQUIRE(a.positions[i][k].y == b.positions[i][k].y);
+            REQUIRE(a.positions[i][k].z == b.positions[i][k].z);
+        }
+    }
+    REQUIRE(a.positions[0][0].x == Catch::Approx(100.0).margin(1e-6));
+}
+
+TEST_CASE("RelativePredictor: velocities are published when the plane is configured",
+          "[predictor]")
+{
+    static PredictorRig rig_plain;
+    static PredictorRig rig_hcw;
+    static PredictorRig rig_ya;
+
+    static BullseyeFrame bullseye_plain(rig_plain.chief, nullptr,
+                                        BullseyeFrameMode::kConstructedOnly);
+    static BullseyeFrame bullseye_hcw(rig_hcw.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    static BullseyeFrame bullseye_ya(rig_ya.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+
+    PublisherConfig pub_cfg{};
+    pub_cfg.velocities = true;
+    static Publisher pub_plain;
+    static Publisher pub_hcw(pub_cfg);
+    static Publisher pub_ya(pub_cfg);
+
+    RelativePredictorConfig ya_cfg{};
+    ya_cfg.model = PredictorModel::kYaStm;
+    ya_cfg.ya_max_dt_sec = 0.5;
+
+    static RelativePredictor plain(pub_plain, rig_plain.map, rig_plain.chief, rig_plain.veh,
+                                   bullseye_plain);
+    static RelativePredictor hcw(pub_hcw, rig_hcw.map, rig_hcw.chief, rig_hcw.veh, bullseye_hcw);
+    static RelativePredictor ya(pub_ya, rig_ya.map, rig_ya.chief, rig_ya.veh, bullseye_ya, ya_cfg);
+
+    plain.step(0.0, 60.0, 1.0);
+    hcw.step(0.0, 60.0, 1.0);
+    ya.step(0.0, 60.0, 1.0);
+
+    const auto& p = pub_plain.read();
+    const auto& h = pub_hcw.read();
+    const auto& y = pub_ya.read();
+    REQUIRE_FALSE(p.has_velocities());
+    REQUIRE(h.has_velocities());
+    REQUIRE(y.has_velocities());
+
+    for (const PredictionBuffer* buf : {&h, &y})
+    {
+        const auto& vel = *buf->velocities;
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            // Central differences of the published positions agree with the model velocity.
+            for (std::size_t k = 1; k < 60; ++k)
+            {
+                const Vec3& rm = buf->positions[i][k - 1];
+                const Vec3& rp = buf->positions[i][k + 1];
+                REQUIRE(vel[i][k].x == Catch::Approx(0.5 * (rp.x - rm.x)).margin(1e-5));
+                REQUIRE(vel[i][k].y == Catch::Approx(0.5 * (rp.y - rm.y)).margin(1e-5));
+                REQUIRE(vel[i][k].z == Catch::Approx(0.5 * (rp.z - rm.z)).margin(1e-5));
+            }
+        }
+    }
+
+    // Positions are unaffected by publishing velocities.
+    for (std::size_t k = 0; k <= 60; ++k)
+    {
+        REQUIRE(h.positions[0][k].x == p.positions[0][k].x);
+        REQUIRE(h.positions[0][k].y == p.positions[0][k].y);
+        REQUIRE(h.positions[0][k].z == p.positions[0][k].z);
+    }
+}
+
+TEST_CASE("RelativePredictor: kAuto runs HCW inside its validity region and YA outside",
+          "[predictor][selector]")
+{
+    static PredictorRig rig_auto;
+    static PredictorRig rig_hcw;
+
+    // Vehicle 1 is 100 m out (HCW); vehicle 2 is 50 km out (YA).
+    class TwoVehicles final : public IVehicleStateProvider
+    {
+      public:
+        VehicleState near{};
+        VehicleState far{};
+        [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override
+        {
+            VehicleState s = (id == 1u) ? near : far;
+            s.time_tag = t0;
+            return s;
+        }
+    };
+    static TwoVehicles veh;
+    veh.near = rig_auto.veh.s;
+    veh.far = rig_auto.veh.s;
+    veh.far.r_i.x += 50e3;
+
+    static BullseyeFrame bullseye_auto(rig_auto.chief, nullptr,
+                                       BullseyeFrameMode::kConstructedOnly);
+    static BullseyeFrame bullseye_hcw(rig_hcw.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    static Publisher pub_auto;
+    static Publisher pub_hcw;
+
+    RelativePredictorConfig cfg{};
+    cfg.model = PredictorModel::kAuto;
+    cfg.ya_max_dt_sec = 0.5;
+
+    static RelativePredictor autosel(pub_auto, rig_auto.map, rig_auto.chief, veh, bullseye_auto,
+                                     cfg);
+    static RelativePredictor hcw(pub_hcw, rig_hcw.map, rig_hcw.chief, rig_hcw.veh, bullseye_hcw);
+
+    autosel.step(0.0, 60.0, 5.0);
+    hcw.step(0.0, 60.0, 5.0);
+
+    const auto& a = pub_auto.read();
+    const auto& h = pub_hcw.read();
+    REQUIRE(a.row_model[0].model == PredictorModel::kHcw);
+    REQUIRE(a.row_model[1].model == PredictorModel::kYaStm);
+    REQUIRE(a.row_model[0].cause == ModelSelectCause::kInitial);
+    REQUIRE(a.est_cost_total == a.row_model[0].est_cost + a.row_model[1].est_cost);
+    REQUIRE(a.row_model[1].est_cost > a.row_model[0].est_cost);
+
+    // The HCW row is exactly what the HCW predictor produces.
+    for (std::size_t k = 0; k <= 12; ++k)
+    {
+        REQUIRE(a.positions[0][k].x == h.positions[0][k].x);
+        REQUIRE(a.positions[0][k].y == h.positions[0][k].y);
+    }
+    REQUIRE(a.positions[1][0].x == Catch::Approx(50100.0).margin(1e-6));
+
+    // Fixed-model predictors report their model with kFixed.
+    REQUIRE(h.row_model[0].model == PredictorModel::kHcw);
+    REQUIRE(h.row_model[0].cause == ModelSelectCause::kFixed);
+}
+
+TEST_CASE("RelativePredictor: sliding-window reuse for quiescent vehicles", "[predictor][reuse]")
+{
+    // Deputy parked 200 m along-track (HCW equilibrium): the prediction is stationary, so the
+    // next tick's initial state matches the previous prediction.
+    static PredictorRig rig;
+    const double n = rig.chief.s.v_i.y / rig.chief.s.r_i.x;
+    const double y_off = 200.0;
+    rig.veh.s.r_i = Vec3{rig.chief.s.r_i.x, y_off, 0.0};
+    rig.veh.s.v_i = Vec3{-n * y_off, rig.chief.s.v_i.y, 0.0};
+
+    static BullseyeFrame bullseye(rig.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    static Publisher pub;
+    static HcwRelativePredictor pred(pub, rig.map, rig.chief, rig.veh, bullseye);
+
+    TrajectoryReuseConfig reuse{};
+    reuse.enabled = true;
+    reuse.pos_tol_m = 1e-3;
+    reuse.full_refresh_ticks = 4;
+    pred.configure_reuse(reuse);
+
+    pred.step(0.0, 60.0, 1.0);
+    REQUIRE(pred.reuse_stats().rows_full == 2);
+    REQUIRE(pred.reuse_stats().rows_reused == 0);
+
+    // Forced full refresh every 4 ticks: reuse, reuse, reuse, full.
+    const std::size_t expected_reused[] = {2, 2, 2, 0, 2};
+    for (std::size_t tick = 0; tick < 5; ++tick)
+    {
+        pred.step(static_cast<double>(tick + 1), 60.0, 1.0);
+        REQUIRE(pred.reuse_stats().rows_reused == expected_reused[tick]);
+        REQUIRE(pred.reuse_stats().rows_full == 2 - expected_reused[tick]);
+
+        const auto& buf = pub.read();
+        for (std::size_t k = 0; k <= 60; ++k)
+        {
+            REQUIRE(buf.positions[0][k].x == Catch::Approx(0.0).margin(1e-6));
+            REQUIRE(buf.positions[0][k].y == Catch::Approx(y_off).margin(1e-6));
+        }
+    }
+
+    // Non-integer advance (or a different grid) disables reuse for the tick.
+    pred.step(6.5, 60.0, 1.0);
+    REQUIRE(pred.reuse_stats().rows_reused == 0);
+    pred.step(7.5, 30.0, 1.0);
+    REQUIRE(pred.reuse_stats().rows_reused == 0);
+
+    // A residual beyond tolerance forces a full prediction.
+    pred.step(8.5, 30.0, 1.0);
+    REQUIRE(pred.reuse_stats().rows_reused == 2);
+    rig.veh.s.r_i.y += 0.01;
+    pred.step(9.5, 30.0, 1.0);
+    REQUIRE(pred.reuse_stats().rows_reused == 0);
+    REQUIRE(pub.read().positions[0][0].y == Catch::Approx(y_off + 0.01).margin(1e-6));
+}
+
+TEST_CASE("RelativePredictor: change detection skips deputies on their published trajectory",
+          "[predictor][reuse]")
+{
+    static PredictorRig rig;
+    const double n = rig.chief.s.v_i.y / rig.chief.s.r_i.x;
+    const double y_off = 200.0;
+    rig.veh.s.r_i = Vec3{rig.chief.s.r_i.x, y_off, 0.0};
+    rig.veh.s.v_i = Vec3{-n * y_off, rig.chief.s.v_i.y, 0.0};
+
+    static BullseyeFrame bullseye(rig.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    static Publisher pub;
+    static HcwRelativePredictor pred(pub, rig.map, rig.chief, rig.veh, bullseye);
+    const auto ring = std::make_unique<TickTelemetryRing>();
+    pred.attach_telemetry(ring.get());
+
+    // Sliding-window reuse stays off: skipping needs no tail hook.
+    TrajectoryReuseConfig reuse{};
+    reuse.skip_unchanged = true;
+    reuse.pos_tol_m = 1e-3;
+    reuse.full_refresh_ticks = 4;
+    pred.configure_reuse(reuse);
+
+    pred.step(0.0, 60.0, 1.0);
+    REQUIRE(pred.reuse_stats().rows_full == 2);
+    REQUIRE(pub.read().unchanged_rows == 0u);
+
+    // Forced full refresh every 4 ticks: unchanged x3, full, unchanged.
+    const std::size_t expected[] = {2, 2, 2, 0, 2};
+    for (std::size_t tick = 0; tick < 5; ++tick)
+    {
+        const double t0 = static_cast<double>(tick + 1);
+        pred.step(t0, 60.0, 1.0);
+        REQUIRE(pred.reuse_stats().rows_unchanged == expected[tick]);
+        REQUIRE(pred.reuse_stats().rows_full == 2 - expected[tick]);
+        REQUIRE(pred.reuse_stats().rows_reused == 0);
+
+        const auto& buf = pub.read();
+        REQUIRE(buf.valid_rows == 0b11u);
+        if (expected[tick] != 0)
+        {
+            // Carried over clean with the epoch of the last full prediction.
+            REQUIRE(buf.unchanged_rows == 0b11u);
+            REQUIRE(buf.dirty_rows == 0u);
+            REQUIRE(buf.row_t0[0] == (tick < 3 ? 0.0 : 4.0));
+        }
+        else
+        {
+            REQUIRE(buf.unchanged_rows == 0u);
+            REQUIRE(buf.row_t0[1] == t0);
+        }
+        REQUIRE(buf.positions[1][10].y == Catch::Approx(y_off).margin(1e-6));
+    }
+    std::vector<TickTelemetryRecord> recs(TickTelemetryRing::kCapacity);
+    REQUIRE(ring->pop(Span<TickTelemetryRecord>{recs.data(), recs.size()}) == 6u);
+    const TickTelemetryRecord& rec = recs[5];
+    REQUIRE(rec.rows_unchanged == 2);
+    REQUIRE(rec.unchanged_rows == 0b11u);
+    REQUIRE(rec.rows_ok == 0);
+
+    // The carried epoch may trail t0 by max_unchanged_sec at most.
+    reuse.max_unchanged_sec = 1.5;
+    pred.configure_reuse(reuse);
+    pred.step(6.0, 60.0, 1.0); // 2 s past the epoch of t0 = 4
+    REQUIRE(pred.reuse_stats().rows_unchanged == 0);
+    pred.step(7.0, 60.0, 1.0);
+    REQUIRE(pred.reuse_stats().rows_unchanged == 2);
+    pred.step(8.0, 60.0, 1.0);
+    REQUIRE(pred.reuse_stats().rows_unchanged == 0);
+
+    // Off-grid offsets and residuals beyond tolerance are predicted.
+    pred.step(8.5, 60.0, 1.0);
+    REQUIRE(pred.reuse_stats().rows_unchanged == 0);
+    rig.veh.s.r_i.y += 0.01;
+    pred.step(9.5, 60.0, 1.0);
+    REQUIRE(pred.reuse_stats().rows_unchanged == 0);
+    REQUIRE(pub.read().positions[0][0].y == Catch::Approx(y_off + 0.01).margin(1e-6));
+    pred.attach_telemetry(nullptr);
+}
+
+TEST_CASE("RelativePredictor: piecewise grid is published with its tau array", "[predictor]")
+{
+    static PredictorRig rig;
+    static BullseyeFrame bullseye(rig.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    static Publisher pub;
+    static HcwRelativePredictor pred(pub, rig.map, rig.chief, rig.veh, bullseye);
+
+    // 389 samples; cadences scale up when MAX_STEPS cannot hold them.
+    const double c = static_cast<double>(389u / (MAX_STEPS - 3u) + 1u);
+    const TimeGridSegment segs[] = {{60.0, 0.5 * c}, {600.0, 5.0 * c}, {5400.0, 30.0 * c}};
+    const TimeGrid grid = make_piecewise_time_grid(segs, 3);
+    REQUIRE(grid.tau.size() == ((c == 1.0) ? 389u : grid.tau.size()));
+    REQUIRE(grid.tau.size() <= MAX_STEPS);
+
+    pred.step(0.0, grid);
+    REQUIRE(pub.published_seqno() == 1);
+    const PredictionBuffer& snap = pub.read();
+    REQUIRE(snap.steps == grid.tau.size());
+    for (std::size_t k = 0; k < snap.steps; ++k)
+    {
+        REQUIRE(snap.tau[k] == grid.tau[k]);
+    }
+
+    // Rows match a direct HCW evaluation at the same offsets.
+    std::vector<Vec3> ref(grid.tau.size());
+    ModelHCW hcw;
+    HcwParams params{};
+    params.n_radps = norm(cross(rig.chief.s.r_i, rig.chief.s.v_i)) /
+                     (norm(rig.chief.s.r_i) * norm(rig.chief.s.r_i));
+    const BullseyeFrameSnapshot frame = bullseye.update(0.0);
+    const RelState rel =
+        inertial_to_ric_relative(rig.veh.s.r_i, rig.veh.s.v_i, rig.chief.s.r_i, rig.chief.s.v_i,
+                                 transpose(frame.C_from_ric_to_inertial), frame.omega_ric);
+    const auto res = hcw.predict_hcw(RelStateRic{rel.r, rel.v}, params, grid,
+                                     Span<Vec3>{ref.data(), ref.size()}, Span<Vec3>{});
+    REQUIRE(res.code == ModelCode::kOk);
+    for (std::size_t k = 0; k < snap.steps; k += 16)
+    {
+        REQUIRE(snap.positions[0][k].x == Catch::Approx(ref[k].x).margin(1e-6));
+        REQUIRE(snap.positions[0][k].y == Catch::Approx(ref[k].y).margin(1e-6));
+    }
+
+    // The uniform overload reports its own grid.
+    pred.step(10.0, 60.0, 1.0);
+    REQUIRE(pub.read().steps == 61);
+    REQUIRE(pub.read().tau[60] == 60.0);
+}
+
+namespace
+{
+
+// Vehicle 1 nominal; 2 provider failure; 3 foreign frame; 4 non-finite state (model rejects).
+class MixedVehicles final : public IVehicleStateProvider
+{
+  public:
+    VehicleState nominal{};
+
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override
+    {
+        VehicleState s = nominal;
+        s.time_tag = t0;
+        if (id == 2u)
+        {
+            s.status.code = ProviderCode::kNotAvailable;
+        }
+        else if (id == 3u)
+        {
+            s.frame_id = "OTHER";
+        }
+        else if (id == 4u)
+        {
+            s.r_i.x = std::numeric_limits<double>::quiet_NaN();
+        }
+        return s;
+    }
+};
+
+template <typename Predictor>
+void check_row_status(Predictor& pred, Publisher& pub)
+{
+    pred.step(0.0, 60.0, 10.0);
+    REQUIRE(pub.published_seqno() == 1);
+    const PredictionBuffer& snap = pub.read();
+
+    REQUIRE(snap.vehicles == 4);
+    REQUIRE(snap.valid_rows == 0x1u);
+    REQUIRE(snap.row_valid(0));
+    REQUIRE_FALSE(snap.row_valid(1));
+    REQUIRE(snap.row_status[0] == RowStatus::kOk);
+    REQUIRE(snap.row_status[1] == RowStatus::kProviderError);
+    REQUIRE(snap.row_status[2] == RowStatus::kFrameMismatch);
+    REQUIRE(snap.row_status[3] == RowStatus::kModelError);
+    REQUIRE(snap.row_status[4] == RowStatus::kEmpty);
+    REQUIRE(snap.dirty_rows == 0xFu); // row 0 written, rows 1..3 changed status
+
+    // Rows that keep failing are carried over clean; only the predicted row is dirty.
+    pred.step(10.0, 60.0, 10.0);
+    const PredictionBuffer& next = pub.read();
+    REQUIRE(next.dirty_rows == 0x1u);
+    REQUIRE(next.rows_changed_since(1) == 0x1u);
+    REQUIRE(next.row_status[1] == RowStatus::kProviderError);
+    REQUIRE(next.row_status[3] == RowStatus::kModelError);
+}
+
+} // namespace
+
+TEST_CASE("RelativePredictor: published rows carry validity and status", "[predictor]")
+{
+    static PredictorRig rig;
+    static MixedVehicles veh;
+    veh.nominal = rig.veh.s;
+    (void)rig.map.register_vehicle(3u);
+    (void)rig.map.register_vehicle(4u);
+
+    // Per-row path.
+    {
+        static BullseyeFrame bullseye(rig.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+        static Publisher pub;
+        static HcwRelativePredictor pred(pub, rig.map, rig.chief, veh, bullseye);
+        check_row_status(pred, pub);
+    }
+
+    // Lockstep block path (outcomes reported by predict_block()).
+    {
+        RelativePredictorConfig cfg{};
+        cfg.model = PredictorModel::kYaStm;
+        static BullseyeFrame bullseye(rig.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+        static Publisher pub;
+        static RelativePredictor pred(pub, rig.map, rig.chief, veh, bullseye, cfg);
+        check_row_status(pred, pub);
+    }
+
+    // Per-vehicle selection (HCW and YA rows mixed in one block).
+    {
+        RelativePredictorConfig cfg{};
+        cfg.model = PredictorModel::kAuto;
+        static BullseyeFrame bullseye(rig.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+        static Publisher pub;
+        static RelativePredictor pred(pub, rig.map, rig.chief, veh, bullseye, cfg);
+        check_row_status(pred, pub);
+    }
+}
+
+namespace
+{
+
+// Serves the whole tick from get_many(); get() must not be reached.
+class BatchVehicles final : public IVehicleStateProvider
+{
+  public:
+    VehicleState nominal{};
+    int batch_calls{0};
+    int single_calls{0};
+    std::size_t last_batch{0};
+
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId /*id*/, double t0) noexcept override
+    {
+        ++single_calls;
+        VehicleState s = nominal;
+        s.time_tag = t0;
+        return s;
+    }
+
+    [[nodiscard]] ProviderCode get_many(Span<const VehicleIndexMap::VehicleId> ids,
+                                        double t0,
+                                        Span<VehicleState> out,
+                                        Span<Vec3> /*out_r_i*/,
+                                        Span<Vec3> /*out_v_i*/) noexcept override
+    {
+        ++batch_calls;
+        last_batch = ids.size;
+        for (std::size_t i = 0; i < ids.size; ++i)
+        {
+            out[i] = nominal;
+            out[i].time_tag = t0;
+            out[i].r_i.y += static_cast<double>(ids[i]); // id-dependent offset
+        }
+        return ProviderCode::kOk;
+    }
+};
+
+} // namespace
+
+TEST_CASE("RelativePredictor: deputy states come from one batched provider call", "[predictor]")
+{
+    static PredictorRig rig;
+
+    // The default get_many() loops over get() and fills the optional r/v arrays.
+    {
+        const VehicleIndexMap::VehicleId ids[] = {1u, 2u};
+        VehicleState states[2];
+        Vec3 r[2];
+        REQUIRE(rig.veh.get_many(Span<const VehicleIndexMap::VehicleId>{ids, 2}, 5.0,
+                                 Span<VehicleState>{states, 2}, Span<Vec3>{r, 2},
+                                 Span<Vec3>{}) == ProviderCode::kOk);
+        REQUIRE(states[1].time_tag == 5.0);
+        REQUIRE(r[1].x == rig.veh.s.r_i.x);
+        REQUIRE(rig.veh.get_many(Span<const VehicleIndexMap::VehicleId>{ids, 2}, 5.0,
+                                 Span<VehicleState>{states, 1}, Span<Vec3>{},
+                                 Span<Vec3>{}) == ProviderCode::kInvalidInput);
+    }
+
+    static BatchVehicles veh;
+    veh.nominal = rig.veh.s;
+    static BullseyeFrame bullseye(rig.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    static Publisher pub;
+    static HcwRelativePredictor pred(pub, rig.map, rig.chief, veh, bullseye);
+
+    // Free slot 0: only the occupied row is requested, and rows keep their own states.
+    REQUIRE(rig.map.unregister_vehicle(1u).has_value());
+    pred.step(0.0, 10.0, 1.0);
+    REQUIRE(veh.batch_calls == 1);
+    REQUIRE(veh.single_calls == 0);
+    REQUIRE(veh.last_batch == 1);
+    const PredictionBuffer& snap = pub.read();
+    REQUIRE(snap.valid_rows == 0x2u);
+    REQUIRE(snap.positions[1][0].y == Catch::Approx(2.0).margin(1e-6));
+}
+
+TEST_CASE("RelativePredictor: inertial positions are published when the plane is configured",
+          "[predictor]")
+{
+    static PredictorRig rig;
+    static PredictorRig rig_plain;
+    static BullseyeFrame bullseye(rig.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    static BullseyeFrame bullseye_plain(rig_plain.chief, nullptr,
+                                        BullseyeFrameMode::kConstructedOnly);
+
+    PublisherConfig pub_cfg{};
+    pub_cfg.inertial_positions = true;
+    static Publisher pub(pub_cfg);
+    static Publisher pub_plain;
+    REQUIRE(pub.has_inertial_positions());
+    REQUIRE_FALSE(pub_plain.has_inertial_positions());
+
+    static HcwRelativePredictor pred(pub, rig.map, rig.chief, rig.veh, bullseye);
+    static HcwRelativePredictor plain(pub_plain, rig_plain.map, rig_plain.chief, rig_plain.veh,
+                                      bullseye_plain);
+    const double mu = 3.986004418e14;
+    InertialOutputConfig icfg{};
+    icfg.mu = mu;
+    pred.configure_inertial_output(icfg);
+
+    pred.step(0.0, 60.0, 1.0);
+    plain.step(0.0, 60.0, 1.0);
+
+    const PredictionBuffer& snap = pub.read();
+    const PredictionBuffer& ref = pub_plain.read();
+    REQUIRE(snap.has_inertial_positions());
+    REQUIRE_FALSE(ref.has_inertial_positions());
+    REQUIRE(snap.valid_rows == 0x3u);
+
+    const ChiefState& chief = rig.chief.s;
+    const double r0n = norm(chief.r_i);
+    const double alpha = 2.0 / r0n - dot(chief.v_i, chief.v_i) / mu;
+    const VehicleState& dep = rig.veh.s;
+    const double d0n = norm(dep.r_i);
+    const double dalpha = 2.0 / d0n - dot(dep.v_i, dep.v_i) / mu;
+    for (std::size_t k = 0; k <= 60; ++k)
+    {
+        // RIC positions are unaffected by publishing the inertial plane.
+        REQUIRE(snap.positions[0][k].x == ref.positions[0][k].x);
+        REQUIRE(snap.positions[0][k].y == ref.positions[0][k].y);
+
+        // Same transform as ric_to_inertial_relative() on the two-body chief at tau_k.
+        const double tau = snap.tau[k];
+        ChiefState at_k = chief;
+        if (tau != 0.0)
+        {
+            math::UniversalPropagation prop{};
+            REQUIRE(math::universal_propagate(
+                chief.r_i, chief.v_i, mu, tau,
+                math::universal_initial_guess(alpha, std::sqrt(mu), r0n, tau),
+                contracts::Det::kKeplerIters, prop));
+            at_k.r_i = prop.r_i;
+            at_k.v_i = prop.v_i;
+        }
+        const ConstructedRicFrame con = construct_ric_from_chief(at_k);
+        const RelState expect =
+            ric_to_inertial_relative(snap.positions[0][k], Vec3{}, at_k.r_i, at_k.v_i,
+                                     con.C_from_ric_to_inertial, con.omega_ric);
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            const Vec3& got = (*snap.positions_i)[i][k];
+            REQUIRE(norm(got - expect.r) <= 1e-6);
+        }
+
+        // HCW over 60 s at 100 m stays within centimetres of the deputy's own two-body arc.
+        Vec3 truth = dep.r_i;
+        if (tau != 0.0)
+        {
+            math::UniversalPropagation prop{};
+            REQUIRE(math::universal_propagate(
+                dep.r_i, dep.v_i, mu, tau,
+                math::universal_initial_guess(dalpha, std::sqrt(mu), d0n, tau),
+                contracts::Det::kKeplerIters, prop));
+            truth = prop.r_i;
+        }
+        REQUIRE(norm((*snap.positions_i)[0][k] - truth) <= 1e-2);
+    }
+}
+
+namespace
+{
+
+// Deputy i (id i + 1) on its own offset; id 5 fails so a failing row sits inside a range.
+class FleetVehicles final : public IVehicleStateProvider
+{
+  public:
+    VehicleState nominal{};
+
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override
+    {
+        VehicleState s = nominal;
+        s.time_tag = t0;
+        const double k = static_cast<double>(id);
+        s.r_i = s.r_i + Vec3{20.0 * k, -35.0 * k, 3.0 * k};
+        s.v_i = s.v_i + Vec3{0.01 * k, -0.02 * k, 0.005 * k};
+        if (id == 5u)
+        {
+            s.r_i.x = std::numeric_limits<double>::quiet_NaN();
+        }
+        return s;
+    }
+};
+
+// The fleet tests run 32 vehicles on a 120 s / 1 s grid.
+constexpr std::size_t kFleetVehicles = 32;
+constexpr std::size_t kFleetSteps = 121;
+
+struct FleetRig
+{
+    VehicleIndexMap map;
+    FixedChief chief;
+    FleetVehicles veh;
+
+    FleetRig()
+    {
+        const PredictorRig base;
+        chief.s = base.chief.s;
+        veh.nominal = base.veh.s;
+        for (VehicleIndexMap::VehicleId id = 1; id <= kFleetVehicles; ++id)
+        {
+            (void)map.register_vehicle(id);
+        }
+    }
+};
+
+template <typename Predictor>
+void check_pool_parity(WorkerPool& pool, const RelativePredictorConfig& cfg)
+{
+    // Heap-allocated: each section needs fresh predictors.
+    const auto rig_serial = std::make_unique<FleetRig>();
+    const auto rig_pool = std::make_unique<FleetRig>();
+    BullseyeFrame be_serial(rig_serial->chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    BullseyeFrame be_pool(rig_pool->chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    PublisherConfig pub_cfg{};
+    pub_cfg.velocities = true;
+    const auto pub_serial = std::make_unique<Publisher>(pub_cfg);
+    const auto pub_pool = std::make_unique<Publisher>(pub_cfg);
+    const auto serial = std::make_unique<Predictor>(*pub_serial, rig_serial->map,
+                                                    rig_serial->chief, rig_serial->veh,
+                                                    be_serial, cfg);
+    const auto pooled = std::make_unique<Predictor>(*pub_pool, rig_pool->map, rig_pool->chief,
+                                                    rig_pool->veh, be_pool, cfg);
+    pooled->attach_worker_pool(&pool);
+
+    for (int tick = 0; tick < 3; ++tick)
+    {
+        const double t0 = 10.0 * tick;
+        serial->step(t0, 120.0, 1.0);
+        pooled->step(t0, 120.0, 1.0);
+
+        const PredictionBuffer& a = pub_serial->read();
+        const PredictionBuffer& b = pub_pool->read();
+        REQUIRE(b.seqno == a.seqno);
+        REQUIRE(b.valid_rows == a.valid_rows);
+        REQUIRE(a.valid_rows == (((RowMask{1} << 32) - 1) & ~RowMask{0x10}));
+        for (std::size_t i = 0; i < 32; ++i)
+        {
+            REQUIRE(b.row_status[i] == a.row_status[i]);
+            for (std::size_t k = 0; k < a.steps; ++k)
+            {
+                REQUIRE(std::memcmp(&b.positions[i][k], &a.positions[i][k], sizeof(Vec3)) == 0);
+                REQUIRE(std::memcmp(&(*b.velocities)[i][k], &(*a.velocities)[i][k],
+                                    sizeof(Vec3)) == 0);
+            }
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("RelativePredictor: worker pool output is bitwise identical to the serial path",
+          "[predictor][pool]")
+{
+    BULLSEYE_SKIP_BELOW_CAPACITY(kFleetVehicles, kFleetSteps);
+    static WorkerPool pool(3);
+    REQUIRE(pool.workers() == 3);
+
+    SECTION("HCW")
+    {
+        check_pool_parity<HcwRelativePredictor>(pool, RelativePredictorConfig{});
+    }
+    SECTION("YA/TH lockstep block split into row ranges")
+    {
+        RelativePredictorConfig cfg{};
+        cfg.ya_max_dt_sec = 1.0;
+        check_pool_parity<YaRelativePredictor>(pool, cfg);
+    }
+    SECTION("runtime-configured YA/TH")
+    {
+        RelativePredictorConfig cfg{};
+        cfg.model = PredictorModel::kYaStm;
+        cfg.ya_max_dt_sec = 1.0;
+        check_pool_parity<RelativePredictor>(pool, cfg);
+    }
+    SECTION("kAuto stays serial with a pool attached")
+    {
+        RelativePredictorConfig cfg{};
+        cfg.model = PredictorModel::kAuto;
+        const DynamicModelPolicy policy(cfg);
+        REQUIRE_FALSE(policy.concurrent_rows());
+        check_pool_parity<RelativePredictor>(pool, cfg);
+    }
+}
+
+TEST_CASE("RelativePredictor: tick budget predicts rows in priority order and defers the rest",
+          "[predictor][budget]")
+{
+    BULLSEYE_SKIP_BELOW_CAPACITY(kFleetVehicles, kFleetSteps);
+    const auto rig = std::make_unique<FleetRig>();
+    const auto ref_rig = std::make_unique<FleetRig>();
+    BullseyeFrame be(rig->chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    BullseyeFrame ref_be(ref_rig->chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    const auto pub = std::make_unique<Publisher>();
+    const auto ref_pub = std::make_unique<Publisher>();
+    const auto pred = std::make_unique<HcwRelativePredictor>(*pub, rig->map, rig->chief, rig->veh,
+                                                             be, RelativePredictorConfig{});
+    const auto ref = std::make_unique<HcwRelativePredictor>(
+        *ref_pub, ref_rig->map, ref_rig->chief, ref_rig->veh, ref_be, RelativePredictorConfig{});
+
+    // Range grows with the vehicle id (FleetVehicles); id 5 has a NaN state, which ranks last
+    // (and fails whenever it is predicted).
+    TickBudgetConfig budget{};
+    budget.enabled = true;
+    budget.max_rows = 8;
+    budget.max_deferred_ticks = 0;
+    RowMask near = 0;
+    for (VehicleIndexMap::VehicleId id : {1u, 2u, 3u, 4u, 6u, 7u, 8u, 9u})
+    {
+        near |= RowMask{1} << *rig->map.index_of(id);
+    }
+    const RowMask failed = RowMask{1} << *rig->map.index_of(5u);
+    const RowMask all = (RowMask{1} << 32) - 1;
+
+    SECTION("range order with a deterministic row cap")
+    {
+        pred->configure_budget(budget);
+
+        // First tick: nothing to carry over yet, so every row is predicted.
+        pred->step(0.0, 120.0, 1.0);
+        ref->step(0.0, 120.0, 1.0);
+        REQUIRE(pub->read().deferred_rows == 0);
+        REQUIRE(pred->budget_stats().rows_deferred == 0);
+        const Vec3 row0_tick0 = pub->read().positions[*rig->map.index_of(32u)][3];
+
+        pred->step(10.0, 120.0, 1.0);
+        ref->step(10.0, 120.0, 1.0);
+        const PredictionBuffer& b = pub->read();
+        const PredictionBuffer& r = ref_pub->read();
+        REQUIRE(pred->budget_stats().rows_predicted == 8);
+        REQUIRE(pred->budget_stats().rows_deferred == 24);
+        REQUIRE(pred->reuse_stats().rows_full == 8);
+        REQUIRE(b.deferred_rows == (all & ~near));
+        REQUIRE(b.dirty_rows == near);
+        REQUIRE(b.valid_rows == (all & ~failed));
+        for (std::size_t i = 0; i < 32; ++i)
+        {
+            const RowMask bit = RowMask{1} << i;
+            if ((near & bit) != 0u)
+            {
+                REQUIRE(b.row_t0[i] == 10.0);
+                REQUIRE(b.row_seqno[i] == b.seqno);
+                for (std::size_t k = 0; k < b.steps; ++k)
+                {
+                    REQUIRE(std::memcmp(&b.positions[i][k], &r.positions[i][k], sizeof(Vec3)) ==
+                            0);
+                }
+            }
+            else if ((failed & bit) == 0u)
+            {
+                REQUIRE(b.row_t0[i] == 0.0);
+                REQUIRE(b.row_seqno[i] == 1);
+                REQUIRE(b.row_status[i] == RowStatus::kOk);
+            }
+        }
+        const Vec3 far = b.positions[*rig->map.index_of(32u)][3];
+        REQUIRE(std::memcmp(&far, &row0_tick0, sizeof(Vec3)) == 0);
+    }
+
+    SECTION("user-assigned priority and a vehicle new to its row")
+    {
+        budget.priority = RowPriority::kUserAssigned;
+        budget.max_rows = 2;
+        pred->configure_budget(budget);
+        REQUIRE(pred->set_vehicle_priority(32u, 5.0));
+        REQUIRE(pred->set_vehicle_priority(20u, 1.0));
+        REQUIRE_FALSE(pred->set_vehicle_priority(99u, 1.0));
+
+        pred->step(0.0, 120.0, 1.0);
+        pred->step(10.0, 120.0, 1.0);
+        const RowMask top = (RowMask{1} << *rig->map.index_of(32u)) |
+                            (RowMask{1} << *rig->map.index_of(20u));
+        REQUIRE(pub->read().dirty_rows == top);
+
+        // Swap vehicle 7 for 40 in the same row: the new vehicle is predicted outside the cap.
+        const std::size_t row7 = *rig->map.index_of(7u);
+        REQUIRE(rig->map.unregister_vehicle(7u).has_value());
+        REQUIRE(rig->map.register_vehicle(40u) == row7);
+        pred->step(20.0, 120.0, 1.0);
+        REQUIRE(pred->budget_stats().rows_predicted == 3);
+        REQUIRE(pub->read().dirty_rows == (top | (RowMask{1} << row7)));
+        REQUIRE(pub->read().row_t0[row7] == 20.0);
+    }
+
+    SECTION("aged rows move to the front")
+    {
+        budget.max_rows = 30;
+        budget.max_deferred_ticks = 2;
+        pred->configure_budget(budget);
+        const RowMask last_two = (RowMask{1} << *rig->map.index_of(32u)) | failed;
+        const RowMask next_two =
+            (RowMask{1} << *rig->map.index_of(30u)) | (RowMask{1} << *rig->map.index_of(31u));
+
+        pred->step(0.0, 120.0, 1.0);
+        pred->step(10.0, 120.0, 1.0); // 32 rows due, 30 predicted
+        REQUIRE(pub->read().deferred_rows == last_two);
+        pred->step(20.0, 120.0, 1.0);
+        REQUIRE(pub->read().deferred_rows == last_two);
+        pred->step(30.0, 120.0, 1.0); // deferred twice: they go first, ids 30 and 31 wait
+        REQUIRE(pub->read().deferred_rows == next_two);
+        REQUIRE(pub->read().row_t0[*rig->map.index_of(32u)] == 30.0);
+    }
+
+    SECTION("an exhausted wall-clock budget still predicts min_rows")
+    {
+        budget.max_rows = MAX_VEHICLES;
+        budget.budget_sec = 0.0;
+        budget.min_rows = 3;
+        pred->configure_budget(budget);
+        pred->step(0.0, 120.0, 1.0);
+        pred->step(10.0, 120.0, 1.0);
+        REQUIRE(pred->budget_stats().rows_predicted == 3);
+        REQUIRE(pred->budget_stats().rows_deferred == 29);
+    }
+}
+
+namespace
+{
+
+template <typename Predictor>
+void check_grid_profiles(const RelativePredictorConfig& cfg, WorkerPool* pool)
+{
+    // Ids 17..32 on a coarse, long profile; each row must match a predictor run on its grid.
+    const auto rig = std::make_unique<FleetRig>();
+    const auto near_rig = std::make_unique<FleetRig>();
+    const auto far_rig = std::make_unique<FleetRig>();
+    for (VehicleIndexMap::VehicleId id = 17; id <= 32; ++id)
+    {
+        REQUIRE(rig->map.set_grid_profile(id, 1u));
+    }
+    BullseyeFrame be(rig->chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    BullseyeFrame near_be(near_rig->chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    BullseyeFrame far_be(far_rig->chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    PublisherConfig pub_cfg{};
+    pub_cfg.velocities = true;
+    const auto pub = std::make_unique<Publisher>(pub_cfg);
+    const auto near_pub = std::make_unique<Publisher>(pub_cfg);
+    const auto far_pub = std::make_unique<Publisher>(pub_cfg);
+    const auto pred =
+        std::make_unique<Predictor>(*pub, rig->map, rig->chief, rig->veh, be, cfg);
+    const auto near_ref = std::make_unique<Predictor>(*near_pub, near_rig->map, near_rig->chief,
+                                                      near_rig->veh, near_be, cfg);
+    const auto far_ref = std::make_unique<Predictor>(*far_pub, far_rig->map, far_rig->chief,
+                                                     far_rig->veh, far_be, cfg);
+    pred->attach_worker_pool(pool);
+    REQUIRE_FALSE(pred->set_grid_profile(0u, 600.0, 10.0));
+    REQUIRE_FALSE(pred->set_grid_profile(static_cast<std::uint8_t>(MAX_GRID_PROFILES), 600.0,
+                                         10.0));
+    REQUIRE(pred->set_grid_profile(1u, 600.0, 10.0));
+
+    for (int tick = 0; tick < 2; ++tick)
+    {
+        const double t0 = 10.0 * tick;
+        pred->step(t0, 120.0, 1.0);
+        near_ref->step(t0, 120.0, 1.0);
+        far_ref->step(t0, 600.0, 10.0);
+
+        const PredictionBuffer& b = pub->read();
+        const PredictionBuffer& n = near_pub->read();
+        const PredictionBuffer& f = far_pub->read();
+        REQUIRE(b.steps == 121);
+        REQUIRE(b.grid_steps(1) == 61);
+        REQUIRE(b.grid_tau(1)[60] == 600.0);
+        REQUIRE(b.grid_steps(2) == 0);
+        REQUIRE(b.valid_rows == n.valid_rows);
+        for (std::size_t i = 0; i < 32; ++i)
+        {
+            const bool coarse = *rig->map.id_at(i) >= 17u;
+            const PredictionBuffer& r = coarse ? f : n;
+            REQUIRE(b.row_grid[i] == (coarse ? 1u : 0u));
+            REQUIRE(b.row_steps(i) == r.steps);
+            REQUIRE(b.row_tau(i)[b.row_steps(i) - 1] == r.tau[r.steps - 1]);
+            REQUIRE(b.row_status[i] == r.row_status[i]);
+            for (std::size_t k = 0; k < r.steps; ++k)
+            {
+                REQUIRE(std::memcmp(&b.positions[i][k], &r.positions[i][k], sizeof(Vec3)) == 0);
+                REQUIRE(std::memcmp(&(*b.velocities)[i][k], &(*r.velocities)[i][k],
+                                    sizeof(Vec3)) == 0);
+            }
+        }
+    }
+
+    // Without the profile its vehicles fall back to the step() grid.
+    pred->clear_grid_profile(1u);
+    pred->step(20.0, 120.0, 1.0);
+    REQUIRE(pub->read().row_grid[*rig->map.index_of(20u)] == 0u);
+    REQUIRE(pub->read().grid_steps(1) == 0);
+}
+
+} // namespace
+
+TEST_CASE("RelativePredictor: vehicles on a grid profile are sampled on their own grid",
+          "[predictor][profiles]")
+{
+    BULLSEYE_SKIP_BELOW_CAPACITY(kFleetVehicles, kFleetSteps);
+    SECTION("HCW")
+    {
+        check_grid_profiles<HcwRelativePredictor>(RelativePredictorConfig{}, nullptr);
+    }
+    SECTION("YA/TH lockstep block")
+    {
+        RelativePredictorConfig cfg{};
+        cfg.ya_max_dt_sec = 1.0;
+        check_grid_profiles<YaRelativePredictor>(cfg, nullptr);
+    }
+    SECTION("HCW on a worker pool")
+    {
+        static WorkerPool pool(2);
+        check_grid_profiles<HcwRelativePredictor>(RelativePredictorConfig{}, &pool);
+    }
+}
+
+TEST_CASE("RelativePredictor: closest-approach summaries are published per row",
+          "[predictor][approach]")
+{
+    BULLSEYE_SKIP_BELOW_CAPACITY(kFleetVehicles, kFleetSteps);
+    for (const bool velocities : {true, false})
+    {
+        const auto rig = std::make_unique<FleetRig>();
+        for (VehicleIndexMap::VehicleId id = 17; id <= 32; ++id)
+        {
+            REQUIRE(rig->map.set_grid_profile(id, 1u));
+        }
+        BullseyeFrame be(rig->chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+        PublisherConfig pub_cfg{};
+        pub_cfg.velocities = velocities;
+        const auto pub = std::make_unique<Publisher>(pub_cfg);
+        const auto pred =
+            std::make_unique<HcwRelativePredictor>(*pub, rig->map, rig->chief, rig->veh, be);
+        REQUIRE(pred->set_grid_profile(1u, 600.0, 10.0));
+
+        pred->step(0.0, 120.0, 1.0);
+        REQUIRE_FALSE(pub->read().approach[0].valid); // off by default
+
+        ApproachSummaryConfig ac{};
+        ac.enabled = true;
+        ac.keep_out_count = 2;
+        ac.keep_out_radius_m = {300.0, 1500.0};
+        pred->configure_approach_summary(ac);
+        pred->step(10.0, 120.0, 1.0);
+
+        const PredictionBuffer& b = pub->read();
+        REQUIRE(b.keep_out_count == 2u);
+        REQUIRE(b.keep_out_radius_m[1] == 1500.0);
+        for (std::size_t i = 0; i < 32; ++i)
+        {
+            const ClosestApproach& ca = b.approach[i];
+            if (!b.row_valid(i))
+            {
+                REQUIRE_FALSE(ca.valid);
+                continue;
+            }
+            const std::size_t n = b.row_steps(i);
+            const ClosestApproach ref = summarize_closest_approach(
+                b.row_tau(i), Span<const Vec3>{b.positions[i].data(), n},
+                velocities ? Span<const Vec3>{(*b.velocities)[i].data(), n} : Span<const Vec3>{},
+                Span<const double>{b.keep_out_radius_m.data(), 2});
+            REQUIRE(ca.valid);
+            REQUIRE(ca.hermite == velocities);
+            REQUIRE(ca.min_range_m == ref.min_range_m);
+            REQUIRE(ca.tca_tau == ref.tca_tau);
+            REQUIRE(std::memcmp(&ca.r_tca, &ref.r_tca, sizeof(Vec3)) == 0);
+            REQUIRE(std::memcmp(ca.keep_out_entry_tau.data(), ref.keep_out_entry_tau.data(),
+                                sizeof(ca.keep_out_entry_tau)) == 0);
+            REQUIRE(ca.tca_tau <= b.row_tau(i)[n - 1]);
+        }
+    }
 }
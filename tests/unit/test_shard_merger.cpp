@@ -0,0 +1,346 @@
+// tests/unit/test_shard_merger.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cmath>
+#include <memory>
+
+#include "core/publisher.hpp"
+#include "core/shard_merger.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "core/worker_pool.hpp"
+#include "models/model_hcw.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kR0 = 7000e3;
+constexpr std::size_t kVehicles = 7;
+constexpr std::size_t kShards = 3;
+
+class CircularChief final : public IChiefStateProvider
+{
+  public:
+    [[nodiscard]] ChiefState get(double t0) noexcept override
+    {
+        ChiefState s{};
+        s.time_tag = t0;
+        s.frame_id = "INERTIAL";
+        const double n = std::sqrt(kMu / (kR0 * kR0 * kR0));
+        s.r_i = Vec3{kR0 * std::cos(n * t0), kR0 * std::sin(n * t0), 0.0};
+        s.v_i = Vec3{-kR0 * n * std::sin(n * t0), kR0 * n * std::cos(n * t0), 0.0};
+        s.status.code = ProviderCode::kOk;
+        return s;
+    }
+};
+
+class OffsetVehicles final : public IVehicleStateProvider
+{
+  public:
+    CircularChief chief;
+
+    [[nodiscard]] VehicleState get(VehicleIndexMap::VehicleId id, double t0) noexcept override
+    {
+        const ChiefState c = chief.get(t0);
+        VehicleState s{};
+        const double d = 25.0 * static_cast<double>(id) + 0.01 * t0;
+        s.r_i = c.r_i + Vec3{d, -1.5 * d, 0.2 * d};
+        s.v_i = c.v_i + Vec3{0.0, 0.01 * static_cast<double>(id), 0.002};
+        s.frame_id = c.frame_id;
+        s.time_tag = t0;
+        s.status.code = ProviderCode::kOk;
+        return s;
+    }
+};
+
+// Leader to node over the wire format.
+ChiefBroadcast broadcast(CircularChief& chief, std::uint64_t tick, double t0)
+{
+    const std::optional<ChiefBroadcast> b = make_chief_broadcast(tick, chief.get(t0), 300.0, 10.0);
+    REQUIRE(b.has_value());
+    std::array<std::uint8_t, kChiefBroadcastBytes> wire{};
+    REQUIRE(encode_chief_broadcast(*b, wire.data(), wire.size()) == kChiefBroadcastBytes);
+    ChiefBroadcast out{};
+    REQUIRE(decode_chief_broadcast(wire.data(), wire.size(), out));
+    return out;
+}
+
+struct ShardedSetup final
+{
+    CircularChief chief;
+    OffsetVehicles veh;
+    VehicleIndexMap map;
+    RelativePredictorConfig model{};
+    PublisherConfig pc{};
+    std::array<ShardRange, kShards> ranges{};
+    std::array<std::unique_ptr<HcwShardNode>, kShards> nodes{};
+
+    ShardedSetup()
+    {
+        for (VehicleIndexMap::VehicleId id = 1; id <= kVehicles; ++id)
+        {
+            REQUIRE(map.register_vehicle(id).has_value());
+        }
+        model.hcw_stm_n_rel_tol = 0.0;
+        pc.velocities = true;
+        REQUIRE(split_shard_ranges(kVehicles, kShards, ranges.data()));
+        for (std::size_t s = 0; s < kShards; ++s)
+        {
+            nodes[s] = std::make_unique<HcwShardNode>("INERTIAL", veh, map.capacity(), pc, model);
+            REQUIRE(nodes[s]->set_range(map, ranges[s]));
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("Shard ranges split rows evenly", "[shard]")
+{
+    std::array<ShardRange, 4> r{};
+    REQUIRE(split_shard_ranges(7, 3, r.data()));
+    REQUIRE(r[0].first == 0u);
+    REQUIRE(r[0].count == 3u);
+    REQUIRE(r[1].first == 3u);
+    REQUIRE(r[1].count == 2u);
+    REQUIRE(r[2].first == 5u);
+    REQUIRE(r[2].count == 2u);
+    REQUIRE(r[1].mask() == RowMask{0x18});
+    REQUIRE((r[0].mask() | r[1].mask() | r[2].mask()) == RowMask{0x7f});
+
+    REQUIRE_FALSE(split_shard_ranges(3, 4, r.data()));
+    REQUIRE_FALSE(split_shard_ranges(3, 0, r.data()));
+    REQUIRE_FALSE(split_shard_ranges(MAX_VEHICLES + 1u, 2, r.data()));
+
+    // The shard map keeps the indices of its own vehicles only.
+    VehicleIndexMap shared;
+    for (VehicleIndexMap::VehicleId id = 10; id < 16; ++id)
+    {
+        REQUIRE(shared.register_vehicle(id).has_value());
+    }
+    VehicleIndexMap shard;
+    REQUIRE(make_shard_map(shared, ShardRange{2, 2}, shard));
+    REQUIRE(shard.size() == 2u);
+    REQUIRE(shard.index_of(12u) == std::optional<std::size_t>{2u});
+    REQUIRE(shard.index_of(13u) == std::optional<std::size_t>{3u});
+    REQUIRE_FALSE(shard.contains(10u));
+    REQUIRE_FALSE(shard.contains(15u));
+
+    ChiefBroadcast b{};
+    std::array<std::uint8_t, kChiefBroadcastBytes> wire{};
+    REQUIRE(encode_chief_broadcast(b, wire.data(), wire.size() - 1u) == 0u);
+    wire[0] ^= 0xffu;
+    REQUIRE_FALSE(decode_chief_broadcast(wire.data(), wire.size(), b));
+}
+
+TEST_CASE("Sharded nodes merge into the single-node snapshot", "[shard]")
+{
+    ShardedSetup s;
+    const auto ref_pub = std::make_unique<Publisher>(s.pc);
+    BullseyeFrame ref_frame(s.chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    HcwRelativePredictor ref(*ref_pub, s.map, s.chief, s.veh, ref_frame, s.model);
+
+    const auto out = std::make_unique<Publisher>(s.pc);
+    SnapshotMerger merger(*out, s.ranges.data(), s.ranges.size());
+    REQUIRE(merger.shard_count() == kShards);
+
+    WorkerPool pool(2);
+    for (std::uint64_t tick = 1; tick <= 3u; ++tick)
+    {
+        const double t0 = 20.0 * static_cast<double>(tick);
+        ref.step(t0, 300.0, 10.0);
+        const ChiefBroadcast b = broadcast(s.chief, tick, t0);
+        auto task = [&s, &b](std::size_t k) noexcept { (void)s.nodes[k]->step(b); };
+        pool.run(kShards, task);
+
+        for (std::size_t k = 0; k < kShards; ++k)
+        {
+            const ShardSubmit want =
+                (k + 1u < kShards) ? ShardSubmit::kMerged : ShardSubmit::kPublished;
+            REQUIRE(merger.submit(k, s.nodes[k]->partial()) == want);
+        }
+        REQUIRE_FALSE(merger.pending());
+
+        const PredictionBuffer& a = ref_pub->read();
+        const PredictionBuffer& m = out->read();
+        REQUIRE(m.seqno == tick);
+        REQUIRE(m.t0 == t0);
+        REQUIRE(m.steps == a.steps);
+        REQUIRE(m.valid_rows == a.valid_rows);
+        REQUIRE(m.dirty_rows == a.valid_rows);
+        REQUIRE(m.deferred_rows == 0u);
+        for (std::size_t i = 0; i < kVehicles; ++i)
+        {
+            REQUIRE(m.row_status[i] == a.row_status[i]);
+            REQUIRE(m.row_t0[i] == t0);
+            for (std::size_t k = 0; k < m.steps; ++k)
+            {
+                REQUIRE(norm(m.positions[i][k] - a.positions[i][k]) == 0.0);
+                REQUIRE(norm((*m.velocities)[i][k] - (*a.velocities)[i][k]) == 0.0);
+            }
+        }
+    }
+    for (std::size_t k = 0; k < kShards; ++k)
+    {
+        REQUIRE(merger.freshness(k).merged_seqno == 3u);
+        REQUIRE(merger.freshness(k).missed == 0u);
+        REQUIRE(merger.freshness(k).source_seqno == s.nodes[k]->partial().seqno);
+    }
+    REQUIRE(merger.stats().complete == 3u);
+    REQUIRE(merger.stats().partial == 0u);
+}
+
+TEST_CASE("Merger carries a late shard's rows and flags them", "[shard]")
+{
+    ShardedSetup s;
+    const auto out = std::make_unique<Publisher>(s.pc);
+    SnapshotMerger merger(*out, s.ranges.data(), s.ranges.size());
+
+    ChiefBroadcast b = broadcast(s.chief, 1u, 10.0);
+    for (std::size_t k = 0; k < kShards; ++k)
+    {
+        REQUIRE(s.nodes[k]->step(b));
+        (void)merger.submit(k, s.nodes[k]->partial());
+    }
+    REQUIRE(out->read().seqno == 1u);
+
+    // Tick 2: shard 1 misses the deadline.
+    b = broadcast(s.chief, 2u, 20.0);
+    for (const std::size_t k : {std::size_t{0}, std::size_t{2}})
+    {
+        REQUIRE(s.nodes[k]->step(b));
+        REQUIRE(merger.submit(k, s.nodes[k]->partial()) == ShardSubmit::kMerged);
+    }
+    REQUIRE(merger.pending());
+    REQUIRE(merger.arrived() == 0x5u);
+    REQUIRE(merger.flush() == 2u);
+    REQUIRE(merger.flush() == 0u);
+
+    const PredictionBuffer& m = out->read();
+    const RowMask late = s.ranges[1].mask();
+    REQUIRE(m.t0 == 20.0);
+    REQUIRE(m.deferred_rows == late);
+    REQUIRE(m.dirty_rows == (s.ranges[0].mask() | s.ranges[2].mask()));
+    REQUIRE(m.valid_rows == (RowMask{1} << kVehicles) - 1u);
+    for (std::size_t i = 0; i < kVehicles; ++i)
+    {
+        const bool carried = ((late >> i) & 1u) != 0u;
+        REQUIRE(m.row_t0[i] == (carried ? 10.0 : 20.0));
+        REQUIRE(m.row_seqno[i] == (carried ? 1u : 2u));
+    }
+    REQUIRE(merger.freshness(1).missed == 1u);
+    REQUIRE(merger.freshness(1).t0 == 10.0);
+    REQUIRE(merger.freshness(1).merged_seqno == 1u);
+    REQUIRE(merger.freshness(0).merged_seqno == 2u);
+    REQUIRE(merger.stats().partial == 1u);
+
+    // The late partial arrives after the merge: dropped.
+    REQUIRE(s.nodes[1]->step(b));
+    REQUIRE(merger.submit(1, s.nodes[1]->partial()) == ShardSubmit::kStale);
+
+    // A newer tick publishes the pending one first.
+    b = broadcast(s.chief, 3u, 30.0);
+    REQUIRE(s.nodes[0]->step(b));
+    REQUIRE(merger.submit(0, s.nodes[0]->partial()) == ShardSubmit::kMerged);
+    b = broadcast(s.chief, 4u, 40.0);
+    REQUIRE(s.nodes[2]->step(b));
+    REQUIRE(merger.submit(2, s.nodes[2]->partial()) == ShardSubmit::kMerged);
+    REQUIRE(out->read().t0 == 30.0);
+    REQUIRE(out->read().deferred_rows == (late | s.ranges[2].mask()));
+    REQUIRE(merger.pending_t0() == 40.0);
+
+    REQUIRE(merger.submit(kShards, s.nodes[0]->partial()) == ShardSubmit::kInvalidShard);
+    REQUIRE(merger.stats().dropped == 2u);
+}
+
+TEST_CASE("Merger keeps the epoch of rows a node carried", "[shard]")
+{
+    ShardedSetup s;
+    TickBudgetConfig budget{};
+    budget.enabled = true;
+    budget.max_rows = 1;
+    s.nodes[1]->predictor().configure_budget(budget);
+    const RowMask budgeted = s.ranges[1].mask();
+
+    const auto out = std::make_unique<Publisher>(s.pc);
+    SnapshotMerger merger(*out, s.ranges.data(), s.ranges.size());
+
+    // Tick 1 (t0 10): shard 1 predicts both rows but misses the merge.
+    ChiefBroadcast b = broadcast(s.chief, 1u, 10.0);
+    for (std::size_t k = 0; k < kShards; ++k)
+    {
+        REQUIRE(s.nodes[k]->step(b));
+    }
+    (void)merger.submit(0, s.nodes[0]->partial());
+    (void)merger.submit(2, s.nodes[2]->partial());
+    REQUIRE(merger.flush() == 1u);
+
+    // Tick 2 (t0 20): shard 1 predicts one row and defers the other (epoch 10). The merged
+    // snapshot never had that row, so it is written with its own epoch.
+    b = broadcast(s.chief, 2u, 20.0);
+    for (std::size_t k = 0; k < kShards; ++k)
+    {
+        REQUIRE(s.nodes[k]->step(b));
+        (void)merger.submit(k, s.nodes[k]->partial());
+    }
+    const PredictionBuffer& p = s.nodes[1]->partial();
+    const RowMask carried = p.deferred_rows & budgeted;
+    REQUIRE(carried != 0u);
+    REQUIRE(carried != budgeted);
+
+    const PredictionBuffer* m = &out->read();
+    REQUIRE(m->seqno == 2u);
+    REQUIRE(m->deferred_rows == carried);
+    REQUIRE(m->dirty_rows == (RowMask{1} << kVehicles) - 1u);
+    for (std::size_t i = 0; i < kVehicles; ++i)
+    {
+        const bool old = ((carried >> i) & 1u) != 0u;
+        REQUIRE(m->row_t0[i] == (old ? 10.0 : 20.0));
+        REQUIRE(m->row_seqno[i] == 2u);
+        if (old)
+        {
+            for (std::size_t k = 0; k < m->steps; ++k)
+            {
+                REQUIRE(norm(m->positions[i][k] - p.positions[i][k]) == 0.0);
+            }
+        }
+    }
+
+    // Tick 3 (t0 30): the same row is deferred again; the merged front already holds its
+    // epoch, so it is carried clean.
+    b = broadcast(s.chief, 3u, 30.0);
+    for (std::size_t k = 0; k < kShards; ++k)
+    {
+        REQUIRE(s.nodes[k]->step(b));
+        (void)merger.submit(k, s.nodes[k]->partial());
+    }
+    REQUIRE((s.nodes[1]->partial().deferred_rows & budgeted) == carried);
+    m = &out->read();
+    REQUIRE(m->seqno == 3u);
+    REQUIRE(m->deferred_rows == carried);
+    REQUIRE(m->dirty_rows == (((RowMask{1} << kVehicles) - 1u) & ~carried));
+    for (std::size_t i = 0; i < kVehicles; ++i)
+    {
+        const bool old = ((carried >> i) & 1u) != 0u;
+        REQUIRE(m->row_t0[i] == (old ? 10.0 : 30.0));
+        REQUIRE(m->row_seqno[i] == (old ? 2u : 3u));
+    }
+}
+
+TEST_CASE("Merger drops a shard on a different grid", "[shard]")
+{
+    ShardedSetup s;
+    const auto out = std::make_unique<Publisher>(s.pc);
+    SnapshotMerger merger(*out, s.ranges.data(), s.ranges.size());
+
+    ChiefBroadcast b = broadcast(s.chief, 1u, 10.0);
+    REQUIRE(s.nodes[0]->step(b));
+    REQUIRE(merger.submit(0, s.nodes[0]->partial()) == ShardSubmit::kMerged);
+    b.cadence_sec = 20.0;
+    REQUIRE(s.nodes[1]->step(b));
+    REQUIRE(merger.submit(1, s.nodes[1]->partial()) == ShardSubmit::kGridMismatch);
+    REQUIRE(merger.arrived() == 0x1u);
+}
@@ -0,0 +1,223 @@
+// tests/unit/test_snapshot_recorder.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/publisher.hpp"
+#include "core/snapshot_recorder.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+std::string temp_path(const char* name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+PublisherConfig recorded_publisher_config()
+{
+    PublisherConfig cfg{};
+    cfg.velocities = true;
+    cfg.history = 4;
+    return cfg;
+}
+
+// Publish snapshot s: rows 0 and 2 always, row 1 on even seqnos; smooth in k and s.
+void publish_tick(Publisher& pub, std::uint64_t s, std::size_t steps)
+{
+    PredictionBuffer& buf = pub.begin_write();
+    buf.steps = steps;
+    buf.valid_rows = 0b101u | ((s % 2u == 0u) ? 0b010u : 0u);
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        buf.tau[k] = static_cast<double>(k);
+    }
+    for (std::size_t i = 0; i < 3u; ++i)
+    {
+        buf.row_status[i] = RowStatus::kOk;
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            const double x = 100.0 * static_cast<double>(i) + std::sin(0.01 * (k + s));
+            buf.positions[i][k] = Vec3{x, 2.0 * x, -x};
+            (*buf.velocities)[i][k] = Vec3{0.5 * x, 0.0, 1.0};
+        }
+    }
+    (void)pub.publish(static_cast<double>(s));
+}
+
+} // namespace
+
+TEST_CASE("SnapshotRecorder writes a chunked recording the reader maps back", "[recorder]")
+{
+    for (const RecordingCompression compression :
+         {RecordingCompression::kNone, RecordingCompression::kXorShuffle})
+    {
+        const std::string path = temp_path("bullseye_test_recording.bin");
+        Publisher pub(recorded_publisher_config());
+
+        SnapshotRecorderConfig cfg{};
+        cfg.chunk_snapshots = 4;
+        cfg.compression = compression;
+        SnapshotRecorder rec(pub, cfg);
+        REQUIRE(rec.start(path.c_str()) == RecordingCode::kOk);
+        REQUIRE(rec.start(path.c_str()) == RecordingCode::kInvalidInput);
+
+        // Ten ticks on a 50-step grid, then a grid change forces a new chunk.
+        for (std::uint64_t s = 1; s <= 12; ++s)
+        {
+            publish_tick(pub, s, s <= 10u ? 50u : 20u);
+            REQUIRE(rec.wait_caught_up(5.0));
+        }
+        rec.stop();
+        REQUIRE_FALSE(rec.running());
+
+        const SnapshotRecorderStats st = rec.stats();
+        REQUIRE(st.recorded == 12u);
+        REQUIRE(st.missed == 0u);
+        REQUIRE(st.write_errors == 0u);
+        REQUIRE(st.chunks == 4u); // 4 + 4 + 2 (grid change) + 2
+
+        RecordingReader reader;
+        REQUIRE(reader.open(path.c_str()) == RecordingCode::kOk);
+        REQUIRE(reader.chunk_count() == 4u);
+        REQUIRE(reader.snapshot_count() == 12u);
+
+        RecordedSnapshot snap{};
+        REQUIRE(reader.find_seqno(7u, snap));
+        REQUIRE(snap.t0 == 7.0);
+        REQUIRE(snap.steps == 50u);
+        REQUIRE(snap.valid_rows == 0b101u);
+        REQUIRE(snap.status(2) == RowStatus::kOk);
+        REQUIRE(snap.tau.size == 50u);
+        REQUIRE(snap.tau[49] == 49.0);
+        const double x = 200.0 + std::sin(0.01 * (13 + 7));
+        REQUIRE(snap.position(2, 13).x == x);
+        REQUIRE(snap.position(2, 13).y == 2.0 * x);
+        REQUIRE(snap.velocities(2, RicAxis::kR)[13] == 0.5 * x);
+        // Row 1 is stored for the chunk but not valid in this snapshot.
+        REQUIRE(snap.positions(1, RicAxis::kR).size == 50u);
+        REQUIRE(std::isnan(snap.positions(1, RicAxis::kR)[0]));
+        REQUIRE(snap.positions(5, RicAxis::kR).size == 0u);
+
+        REQUIRE(reader.find_time(11.5, snap));
+        REQUIRE(snap.seqno == 11u);
+        REQUIRE(snap.steps == 20u);
+        REQUIRE(reader.find_time(100.0, snap));
+        REQUIRE(snap.seqno == 12u);
+        REQUIRE_FALSE(reader.find_time(0.5, snap));
+        REQUIRE_FALSE(reader.find_seqno(13u, snap));
+
+        REQUIRE(reader.at(0u, snap));
+        REQUIRE(snap.seqno == 1u);
+        REQUIRE(std::isnan(snap.position(1, 0).x));
+        REQUIRE(reader.at(1u, snap));
+        REQUIRE(snap.position(1, 0).x == 100.0 + std::sin(0.01 * 2));
+        REQUIRE(reader.at(11u, snap));
+        REQUIRE(snap.seqno == 12u);
+        REQUIRE_FALSE(reader.at(12u, snap));
+        reader.close();
+        (void)std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("RecordingReader ignores a partially written last chunk", "[recorder]")
+{
+    const std::string path = temp_path("bullseye_test_recording_tail.bin");
+    Publisher pub(recorded_publisher_config());
+    SnapshotRecorderConfig cfg{};
+    cfg.chunk_snapshots = 2;
+    {
+        SnapshotRecorder rec(pub, cfg);
+        REQUIRE(rec.start(path.c_str()) == RecordingCode::kOk);
+        for (std::uint64_t s = 1; s <= 4; ++s)
+        {
+            publish_tick(pub, s, 10u);
+            REQUIRE(rec.wait_caught_up(5.0));
+        }
+    }
+
+    const auto full = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, full - 16u);
+    RecordingReader reader;
+    REQUIRE(reader.open(path.c_str()) == RecordingCode::kOk);
+    REQUIRE(reader.chunk_count() == 1u);
+    RecordedSnapshot snap{};
+    REQUIRE(reader.find_seqno(2u, snap));
+    REQUIRE_FALSE(reader.find_seqno(3u, snap));
+    reader.close();
+
+    std::FILE* f = std::fopen(path.c_str(), "r+b");
+    REQUIRE(f != nullptr);
+    const std::uint64_t bad = 0;
+    REQUIRE(std::fwrite(&bad, sizeof(bad), 1, f) == 1u);
+    std::fclose(f);
+    REQUIRE(reader.open(path.c_str()) == RecordingCode::kBadMagic);
+    REQUIRE_FALSE(reader.is_open());
+    (void)std::remove(path.c_str());
+}
+
+TEST_CASE("SnapshotRecorder stores Chebyshev series within the declared bound", "[recorder]")
+{
+    const std::string raw_path = temp_path("bullseye_test_recording_raw.bin");
+    const std::string path = temp_path("bullseye_test_recording_cheb.bin");
+    Publisher pub(recorded_publisher_config());
+
+    SnapshotRecorderConfig raw_cfg{};
+    raw_cfg.chunk_snapshots = 4;
+    SnapshotRecorderConfig cfg = raw_cfg;
+    cfg.compression = RecordingCompression::kChebyshev;
+    cfg.chebyshev_tolerance_m = 1.0e-6;
+    cfg.chebyshev_tolerance_mps = 1.0e-7;
+    SnapshotRecorder raw(pub, raw_cfg);
+    SnapshotRecorder rec(pub, cfg);
+    REQUIRE(raw.start(raw_path.c_str()) == RecordingCode::kOk);
+    REQUIRE(rec.start(path.c_str()) == RecordingCode::kOk);
+    for (std::uint64_t s = 1; s <= 8; ++s)
+    {
+        publish_tick(pub, s, MAX_STEPS);
+        REQUIRE(raw.wait_caught_up(5.0));
+        REQUIRE(rec.wait_caught_up(5.0));
+    }
+    raw.stop();
+    rec.stop();
+    REQUIRE(rec.stats().recorded == 8u);
+    if (MAX_STEPS >= 300u) // a handful of coefficients only pays off on long rows
+    {
+        REQUIRE(rec.stats().bytes_written * 10u < raw.stats().bytes_written);
+    }
+
+    RecordingReader reader;
+    REQUIRE(reader.open(path.c_str()) == RecordingCode::kOk);
+    REQUIRE(reader.snapshot_count() == 8u);
+    RecordedSnapshot snap{};
+    REQUIRE(reader.find_seqno(6u, snap));
+    REQUIRE(snap.position_tolerance == 1.0e-6);
+    REQUIRE(snap.velocity_tolerance == 1.0e-7);
+    REQUIRE(snap.tau[MAX_STEPS - 1u] == static_cast<double>(MAX_STEPS - 1u));
+    for (std::size_t k = 0; k < MAX_STEPS; ++k)
+    {
+        const double x = 200.0 + std::sin(0.01 * static_cast<double>(k + 6u));
+        REQUIRE(std::fabs(snap.position(2, k).x - x) <= 1.0e-6);
+        REQUIRE(std::fabs(snap.position(2, k).z + x) <= 1.0e-6);
+        REQUIRE(std::fabs(snap.velocities(2, RicAxis::kR)[k] - 0.5 * x) <= 1.0e-7);
+    }
+    // Stale rows still read as NaN.
+    REQUIRE(reader.find_seqno(5u, snap));
+    REQUIRE(std::isnan(snap.positions(1, RicAxis::kR)[17]));
+    REQUIRE(reader.at(3u, snap));
+    REQUIRE(snap.seqno == 4u);
+    REQUIRE(std::fabs(snap.position(1, 0).x - (100.0 + std::sin(0.04))) <= 1.0e-6);
+    reader.close();
+    (void)std::remove(path.c_str());
+    (void)std::remove(raw_path.c_str());
+
+    cfg.chebyshev_tolerance_m = -1.0;
+    SnapshotRecorder bad(pub, cfg);
+    REQUIRE(bad.start(path.c_str()) == RecordingCode::kInvalidInput);
+}
@@ -0,0 +1,166 @@
+// tests/unit/test_snapshot_sampler.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <memory>
+
+#include "core/prediction_buffer.hpp"
+#include "core/snapshot_sampler.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+constexpr double kW = 1.1e-3; // LEO mean motion [rad/s]
+
+// Relative ellipse with drift, row i scaled by (i + 1).
+Vec3 pos(std::size_t i, double tau)
+{
+    const double s = static_cast<double>(i + 1u);
+    return Vec3{s * 250.0 * std::cos(kW * tau), -s * 500.0 * std::sin(kW * tau) - 0.06 * tau,
+                s * 80.0};
+}
+
+Vec3 vel(std::size_t i, double tau)
+{
+    const double s = static_cast<double>(i + 1u);
+    return Vec3{-s * 250.0 * kW * std::sin(kW * tau), -s * 500.0 * kW * std::cos(kW * tau) - 0.06,
+                0.0};
+}
+
+// Rows 0..2 valid on a 30 s grid over 600 s, written at seqno 1 with epoch t0.
+void fill(PredictionBuffer& b, TrajectoryPlane* v, double t0)
+{
+    b.seqno = 1;
+    b.t0 = t0;
+    b.steps = 21;
+    for (std::size_t k = 0; k < b.steps; ++k)
+    {
+        b.tau[k] = 30.0 * static_cast<double>(k);
+    }
+    b.vehicles = 4;
+    b.valid_rows = 0x7u;
+    for (std::size_t i = 0; i < 3u; ++i)
+    {
+        b.row_seqno[i] = 1;
+        b.row_t0[i] = t0;
+        for (std::size_t k = 0; k < b.steps; ++k)
+        {
+            b.positions[i][k] = pos(i, b.tau[k]);
+            if (v != nullptr)
+            {
+                (*v)[i][k] = vel(i, b.tau[k]);
+            }
+        }
+    }
+    b.velocities = v;
+}
+
+} // namespace
+
+TEST_CASE("Snapshot sampler interpolates rows between samples", "[sampler]")
+{
+    const auto buf = std::make_unique<PredictionBuffer>();
+    const auto v = std::make_unique<TrajectoryPlane>();
+    fill(*buf, v.get(), 100.0);
+
+    SnapshotSampler sampler;
+    Vec3 r{};
+    Vec3 rv{};
+    REQUIRE(sampler.sample(0, 100.0, r) == SampleCode::kNotBound);
+
+    sampler.bind(*buf);
+    REQUIRE(sampler.hermite());
+
+    // Exact at the samples, including both ends.
+    for (const double tau : {0.0, 30.0, 600.0})
+    {
+        REQUIRE(sampler.sample(1, 100.0 + tau, r, &rv) == SampleCode::kOk);
+        REQUIRE(norm(r - pos(1, tau)) <= 1e-9);
+        REQUIRE(norm(rv - vel(1, tau)) <= 1e-12);
+    }
+
+    // 30 Hz sensor frames across the span: Hermite error O(h^4 w^4 A) ~ mm.
+    double hermite_err = 0.0;
+    for (double tau = 0.0; tau <= 600.0; tau += 1.0 / 30.0)
+    {
+        REQUIRE(sampler.sample(2, 100.0 + tau, r, &rv) == SampleCode::kOk);
+        hermite_err = std::fmax(hermite_err, norm(r - pos(2, tau)));
+        REQUIRE(norm(rv - vel(2, tau)) <= 1e-4);
+    }
+    REQUIRE(hermite_err <= 5e-3);
+    REQUIRE(sampler.rows_built() == 2u); // rows 1 and 2, once each
+    REQUIRE(sampler.sample(0, 123.4, r) == SampleCode::kOk);
+    REQUIRE(sampler.rows_built() == 3u);
+
+    // No extrapolation, no data rows, out-of-range rows.
+    REQUIRE(sampler.sample(0, 99.9, r) == SampleCode::kOutOfRange);
+    REQUIRE(sampler.sample(0, 700.1, r) == SampleCode::kOutOfRange);
+    REQUIRE(sampler.sample(0, std::nan(""), r) == SampleCode::kOutOfRange);
+    REQUIRE(sampler.sample(3, 200.0, r) == SampleCode::kNoRow);
+    REQUIRE(sampler.sample(MAX_VEHICLES, 200.0, r) == SampleCode::kNoRow);
+
+    // sample_many matches sample(); row 3 has no data and is left alone.
+    Vec3 many_r[4]{};
+    Vec3 many_v[4]{};
+    const RowMask got = sampler.sample_many(0xFu, 345.6, Span<Vec3>{many_r, 4},
+                                            Span<Vec3>{many_v, 4});
+    REQUIRE(got == 0x7u);
+    for (std::size_t i = 0; i < 3u; ++i)
+    {
+        REQUIRE(sampler.sample(i, 345.6, r, &rv) == SampleCode::kOk);
+        REQUIRE(norm(many_r[i] - r) == 0.0);
+        REQUIRE(norm(many_v[i] - rv) == 0.0);
+    }
+    REQUIRE(norm(many_r[3]) == 0.0);
+
+    // Next snapshot: row 0 rewritten, rows 1 and 2 carried over clean keep their coefficients.
+    buf->seqno = 2;
+    buf->row_seqno[0] = 2;
+    sampler.bind(*buf);
+    REQUIRE(sampler.sample_many(0x7u, 345.6, Span<Vec3>{many_r, 4}, Span<Vec3>{}) == 0x7u);
+    REQUIRE(sampler.rows_built() == 4u);
+
+    // Without velocities the sampler falls back to linear interpolation.
+    buf->velocities = nullptr;
+    buf->seqno = 3;
+    sampler.bind(*buf);
+    REQUIRE_FALSE(sampler.hermite());
+    double linear_err = 0.0;
+    for (double tau = 0.0; tau <= 600.0; tau += 1.0)
+    {
+        REQUIRE(sampler.sample(2, 100.0 + tau, r) == SampleCode::kOk);
+        linear_err = std::fmax(linear_err, norm(r - pos(2, tau)));
+    }
+    REQUIRE(linear_err > 100.0 * hermite_err);
+    REQUIRE(sampler.rows_built() == 5u);
+}
+
+TEST_CASE("Snapshot sampler evaluates coefficient-only rows in closed form", "[sampler]")
+{
+    const auto buf = std::make_unique<PredictionBuffer>();
+    fill(*buf, nullptr, 0.0);
+
+    TrajectoryCoefficients& c = buf->coefficients[0];
+    c.model = PredictorModel::kHcw;
+    c.n_radps = kW;
+    c.x0.r_ric = Vec3{100.0, -200.0, 10.0};
+    c.x0.v_ric = Vec3{0.01, -0.2, 0.0};
+    buf->coeff_rows = 0x1u;
+    buf->coeff_only_rows = 0x1u;
+
+    SnapshotSampler sampler;
+    sampler.bind(*buf);
+    Vec3 r{};
+    Vec3 rv{};
+    Vec3 want_r{};
+    Vec3 want_v{};
+    REQUIRE(sampler.sample(0, 77.7, r, &rv) == SampleCode::kOk);
+    REQUIRE(evaluate_coefficients(c, 77.7, want_r, &want_v));
+    REQUIRE(norm(r - want_r) == 0.0);
+    REQUIRE(norm(rv - want_v) == 0.0);
+    REQUIRE(sampler.rows_built() == 0u);
+    REQUIRE(sampler.sample(0, 601.0, r) == SampleCode::kOutOfRange);
+}
@@ -0,0 +1,168 @@
+// tests/unit/test_snapshot_view.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "core/net_publisher.hpp"
+#include "core/publisher.hpp"
+#include "core/snapshot_view.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+Vec3 sample(std::size_t i, std::size_t k, std::uint64_t s)
+{
+    return Vec3{1000.0 * static_cast<double>(i) + static_cast<double>(k), 0.5 * s,
+                -static_cast<double>(k)};
+}
+
+// Publish rows [0, rows) over @p steps samples for snapshot s.
+void publish(Publisher& pub, std::uint64_t s, std::size_t rows, std::size_t steps = 50)
+{
+    PredictionBuffer& buf = pub.begin_write();
+    buf.steps = steps;
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        buf.tau[k] = 10.0 * static_cast<double>(k);
+    }
+    RowMask mask = 0;
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        mask |= RowMask{1} << i;
+        buf.row_status[i] = RowStatus::kOk;
+        for (std::size_t k = 0; k < steps; ++k)
+        {
+            buf.positions[i][k] = sample(i, k, s);
+            if (buf.velocities != nullptr)
+            {
+                (*buf.velocities)[i][k] = Vec3{0.0, static_cast<double>(i), 0.0};
+            }
+        }
+    }
+    buf.valid_rows = mask;
+    (void)pub.publish(static_cast<double>(s), mask);
+}
+
+} // namespace
+
+TEST_CASE("Subscription views only its rows and step window", "[snapshot_view]")
+{
+    SoaLayout layout = SoaLayout::kNone;
+    SECTION("AoS positions") {}
+    SECTION("vehicle-major SoA planes") { layout = SoaLayout::kVehicleMajor; }
+    SECTION("step-major SoA planes") { layout = SoaLayout::kStepMajor; }
+
+    PublisherConfig pc{};
+    pc.slots = 3;
+    pc.velocities = true;
+    pc.soa_layout = layout;
+    const auto pub = std::make_unique<Publisher>(pc);
+
+    SubscriptionFilter f{};
+    f.rows = 0b1010u;
+    f.first_step = 10;
+    f.max_steps = 30;
+    const Subscription sub(*pub, f);
+    REQUIRE(sub.acquire().view.empty());
+
+    publish(*pub, 1, 3);
+    SubscribedSnapshot s = sub.acquire();
+    REQUIRE(s.lease.held());
+    const SnapshotView& v = s.view;
+    REQUIRE(v.seqno() == 1u);
+    REQUIRE(v.rows() == 0b0010u); // row 3 has no data
+    REQUIRE(v.status(1) == RowStatus::kOk);
+    REQUIRE(v.status(0) == RowStatus::kEmpty);
+    REQUIRE(v.positions(0).size == 0u);
+    REQUIRE(v.positions(3).size == 0u);
+
+    const Span<const Vec3> r = v.positions(1);
+    const Span<const double> tau = v.tau(1);
+    REQUIRE(r.size == 30u);
+    REQUIRE(tau.size == 30u);
+    REQUIRE(tau[0] == 100.0);
+    REQUIRE(v.velocities(1).size == 30u);
+    REQUIRE(v.velocities(1)[29].y == 1.0);
+    const StridedSpan<const double> y = v.positions(1, RicAxis::kR);
+    const StridedSpan<const double> z = v.positions(1, RicAxis::kC);
+    REQUIRE(y.size == 30u);
+    for (std::size_t k = 0; k < r.size; ++k)
+    {
+        REQUIRE(norm(r[k] - sample(1, 10 + k, 1)) == 0.0);
+        REQUIRE(y[k] == r[k].x);
+        REQUIRE(z[k] == r[k].z);
+    }
+    REQUIRE(y.stride == ((layout == SoaLayout::kNone)         ? 3u
+                         : (layout == SoaLayout::kStepMajor) ? MAX_VEHICLES
+                                                              : 1u));
+    REQUIRE(s.valid());
+    s.lease.release();
+
+    // The window is clipped to the horizon; changes are reported for subscribed rows only.
+    publish(*pub, 2, 4, 25);
+    const SubscribedSnapshot s2 = sub.acquire();
+    REQUIRE(s2.view.rows() == 0b1010u);
+    REQUIRE(s2.view.positions(3).size == 15u);
+    REQUIRE(s2.view.changed_since(1) == 0b1010u);
+    REQUIRE(Subscription(SubscriptionFilter{}).view(s2.lease.get()).rows() == 0b1111u);
+    REQUIRE(s2.valid());
+}
+
+TEST_CASE("Filtered delta encoder sends only subscribed rows and steps", "[snapshot_view]")
+{
+    PublisherConfig pc{};
+    pc.slots = 3;
+    const auto pub = std::make_unique<Publisher>(pc);
+    NetEncoderConfig cfg{};
+    cfg.filter.rows = 0b0110u;
+    cfg.filter.first_step = 20;
+    cfg.filter.max_steps = 10;
+    SnapshotDeltaEncoder filtered(cfg);
+    SnapshotDeltaEncoder full;
+    SnapshotDeltaDecoder dec;
+
+    publish(*pub, 1, 4);
+    std::size_t filtered_bytes = 0;
+    const std::size_t frames = filtered.encode(pub->read());
+    for (std::size_t d = 0; d < frames; ++d)
+    {
+        std::vector<unsigned char> dgram;
+        for (std::size_t j = 0; j < filtered.frame(d).size; ++j)
+        {
+            const NetFramePiece& p = filtered.frame(d)[j];
+            const auto* b = static_cast<const unsigned char*>(p.data);
+            dgram.insert(dgram.end(), b, b + p.bytes);
+        }
+        filtered_bytes += dgram.size();
+        REQUIRE(dec.apply(dgram.data(), dgram.size()) != NetDecodeResult::kMalformed);
+    }
+    std::size_t full_bytes = 0;
+    const std::size_t full_frames = full.encode(pub->read());
+    for (std::size_t d = 0; d < full_frames; ++d)
+    {
+        full_bytes += full.frame_bytes(d);
+    }
+    REQUIRE(filtered_bytes * 5u < full_bytes);
+
+    // The decoder mirror viewed through the same filter matches the source.
+    const PredictionBuffer& m = dec.snapshot();
+    REQUIRE(m.seqno == 1u);
+    REQUIRE(m.valid_rows == 0b0110u);
+    REQUIRE(m.row_status[0] == RowStatus::kEmpty);
+    const Subscription sub(cfg.filter);
+    const SnapshotView got = sub.view(m);
+    const SnapshotView want = sub.view(pub->read());
+    REQUIRE(got.rows() == want.rows());
+    for (const std::size_t i : {1u, 2u})
+    {
+        REQUIRE(got.positions(i).size == 10u);
+        REQUIRE(std::memcmp(got.positions(i).data, want.positions(i).data, 10u * sizeof(Vec3)) ==
+                0);
+        REQUIRE(std::memcmp(got.tau(i).data, want.tau(i).data, 10u * sizeof(double)) == 0);
+    }
+}
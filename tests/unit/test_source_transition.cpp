@@ -0,0 +1,235 @@
+// tests/unit/test_source_transition.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <memory>
+
+#include "core/bullseye_frame.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/source_transition.hpp"
+#include "core/tick_telemetry.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "models/model_hcw.hpp"
+#include "predictor_rig.hpp"
+
+using namespace bullseye_pred;
+using bullseye_pred::testing::FixedChief;
+using bullseye_pred::testing::Rig;
+using bullseye_pred::testing::RigOptions;
+
+namespace
+{
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kR0 = 7000e3;
+
+// Rotation about the radial axis; the constructed frame of the chief below is the identity.
+Mat3 rot_x(double a)
+{
+    Mat3 m = Mat3::identity();
+    m.m[1][1] = std::cos(a);
+    m.m[1][2] = -std::sin(a);
+    m.m[2][1] = std::sin(a);
+    m.m[2][2] = std::cos(a);
+    return m;
+}
+
+// Adopted RIC misaligned from the constructed one by a fixed rotation.
+class TiltedAdopted final : public IBullseyeFrameProvider
+{
+  public:
+    AdoptedRicFrame f{};
+    [[nodiscard]] AdoptedRicFrame get(double t0) noexcept override
+    {
+        f.time_tag = t0;
+        return f;
+    }
+};
+
+struct AdoptedSource
+{
+    TiltedAdopted adopted;
+};
+
+// Shared rig with deputies 3 and 7 and an adopted source tilted by tilt_rad. AdoptedSource is
+// the first base so the source is built before the BullseyeFrame that points at it.
+struct TiltedRig final : AdoptedSource, Rig<HcwRelativePredictor>
+{
+    TiltedRig(BullseyeFrameMode mode, double tilt_rad)
+        : Rig<HcwRelativePredictor>(options(mode, &adopted))
+    {
+        adopted.f.origin_i = chief.s.r_i;
+        adopted.f.C_from_ric_to_inertial = rot_x(tilt_rad);
+        adopted.f.has_omega = true;
+        adopted.f.omega_ric = Vec3{0.0, 0.0, std::sqrt(kMu / kR0) / kR0};
+        adopted.f.omega_coords = OmegaCoords::kOmegaRIC;
+        adopted.f.frame_kind = FrameKind::kBullseyeRIC;
+        adopted.f.axis_order = AxisOrder::kRIC;
+        adopted.f.frame_source_id = "ADOPTED";
+        adopted.f.status.code = ProviderCode::kOk;
+    }
+
+    static RigOptions options(BullseyeFrameMode mode, IBullseyeFrameProvider* source)
+    {
+        RigOptions opt;
+        opt.mu = kMu;
+        opt.chief_radius_m = kR0;
+        opt.vehicles = {3u, 7u};
+        opt.frame_mode = mode;
+        opt.adopted = source;
+        return opt;
+    }
+};
+
+// Largest position difference over rows 0..1 of two snapshots on the same grid.
+double max_diff(const PredictionBuffer& a, const PredictionBuffer& b)
+{
+    double e = 0.0;
+    for (std::size_t i = 0; i < 2u; ++i)
+    {
+        for (std::size_t k = 0; k < a.steps; ++k)
+        {
+            e = std::fmax(e, norm(a.positions[i][k] - b.positions[i][k]));
+        }
+    }
+    return e;
+}
+
+} // namespace
+
+TEST_CASE("Frame correction matches the exact small rotation", "[source_transition]")
+{
+    const double a = 1.0e-3;
+    FrameCorrection c{};
+    c.phi = Vec3{std::sin(a), 0.0, 0.0};
+    Vec3 r[2] = {Vec3{100.0, -400.0, 50.0}, Vec3{0.0, 2000.0, 0.0}};
+    Vec3 v[2] = {Vec3{0.1, 0.2, 0.3}, Vec3{}};
+    apply_frame_correction(c, Span<Vec3>{r, 2}, Span<Vec3>{v, 2});
+
+    const Mat3 R = rot_x(a);
+    const Vec3 exact = mul(R, Vec3{0.0, 2000.0, 0.0});
+    // Tight for a position normal to the rotation axis.
+    const double bound = frame_correction_error_bound(c, 2000.0);
+    REQUIRE(norm(r[1] - exact) <= bound * (1.0 + 1e-9));
+    REQUIRE(norm(r[1] - exact) >= bound * (1.0 - 1e-9));
+    REQUIRE(frame_correction_error_bound(c, 2000.0, 0.5) > bound);
+    REQUIRE(norm(v[0] - mul(R, Vec3{0.1, 0.2, 0.3})) <= 1e-6);
+    REQUIRE(std::isinf(frame_correction_error_bound(FrameCorrection{Vec3{1.0, 0.0, 0.0}}, 1.0)));
+}
+
+TEST_CASE("Tracker measures a source switch and blends the published frame",
+          "[source_transition]")
+{
+    const double tilt = 2.0e-3;
+    FixedChief chief;
+    chief.s.r_i = Vec3{kR0, 0.0, 0.0};
+    chief.s.v_i = Vec3{0.0, std::sqrt(kMu / kR0), 0.0};
+    chief.s.status.code = ProviderCode::kOk;
+
+    BullseyeFrameSnapshot constructed{};
+    constructed.origin_i = chief.s.r_i;
+    constructed.C_from_ric_to_inertial = Mat3::identity();
+    BullseyeFrameSnapshot adopted = constructed;
+    adopted.C_from_ric_to_inertial = rot_x(tilt);
+    adopted.origin_i = chief.s.r_i + Vec3{0.0, 0.0, 3.0};
+    adopted.used_adopted = true;
+    adopted.adopted_frame_source_id = "ADOPTED";
+
+    SourceTransitionTracker tr;
+    tr.configure(SourceTransitionConfig{SourceTransitionMode::kBlendBoth, 100.0, 1.0e-3});
+    REQUIRE_FALSE(tr.update(0.0, chief.s, constructed).switched);
+    REQUIRE_FALSE(tr.update(10.0, chief.s, constructed).moved);
+
+    // Switch tick: the jump is measured and the published frame is still the old source.
+    const SourceTransitionTick& s0 = tr.update(20.0, chief.s, adopted);
+    REQUIRE(s0.switched);
+    REQUIRE(s0.blending);
+    REQUIRE(s0.degraded); // 2 mrad exceeds the attitude bound
+    REQUIRE(std::fabs(s0.attitude_jump_rad - tilt) <= 1e-9);
+    REQUIRE(std::fabs(s0.origin_jump_m - 3.0) <= 1e-9);
+    REQUIRE(s0.blend == 0.0);
+    REQUIRE(norm(s0.origin_i - constructed.origin_i) <= 1e-9);
+    REQUIRE(std::fabs(s0.correction.phi.x - std::sin(tilt)) <= 1e-12);
+
+    // Halfway, then done: the blend is monotone and ends on the new source.
+    double last_phi = std::fabs(s0.correction.phi.x);
+    for (double t = 30.0; t < 120.0; t += 10.0)
+    {
+        const SourceTransitionTick& s = tr.update(t, chief.s, adopted);
+        REQUIRE(s.blending);
+        REQUIRE_FALSE(s.switched);
+        REQUIRE(std::fabs(s.correction.phi.x) < last_phi);
+        last_phi = std::fabs(s.correction.phi.x);
+    }
+    const SourceTransitionTick& end = tr.update(120.0, chief.s, adopted);
+    REQUIRE_FALSE(end.blending);
+    REQUIRE(end.moved); // the tick after the last blended one
+    REQUIRE_FALSE(end.degraded);
+    REQUIRE(end.correction.identity());
+    REQUIRE(norm(end.origin_i - adopted.origin_i) == 0.0);
+    REQUIRE_FALSE(tr.update(130.0, chief.s, adopted).moved);
+
+    // Hard switches publish the new source at once.
+    tr.configure(SourceTransitionConfig{});
+    const SourceTransitionTick& hard = tr.update(140.0, chief.s, constructed);
+    REQUIRE(hard.switched);
+    REQUIRE_FALSE(hard.blending);
+    REQUIRE(hard.blend == 1.0);
+}
+
+TEST_CASE("Predictor publishes blended rows across a source switch", "[source_transition]")
+{
+    const double tilt = 2.0e-3;
+    const auto rig = std::make_unique<TiltedRig>(BullseyeFrameMode::kConstructedOnly, tilt);
+    const auto con = std::make_unique<TiltedRig>(BullseyeFrameMode::kConstructedOnly, tilt);
+    const auto ado = std::make_unique<TiltedRig>(BullseyeFrameMode::kAdoptedPrefer, tilt);
+    const auto ring = std::make_unique<TickTelemetryRing>();
+    rig->pred.attach_telemetry(ring.get());
+
+    std::uint8_t path = 0;
+    double error = 0.0;
+    con->pred.step(10.0, 600.0, 10.0);
+    ado->pred.step(10.0, 600.0, 10.0);
+    // A hard switch would jump the rows by the whole tilt; the blend starts where they were.
+    const double jump = max_diff(con->pub.read(), ado->pub.read());
+    REQUIRE(jump > 0.5);
+    SECTION("predicted in the blended frame when the correction bound is exceeded")
+    {
+        rig->pred.configure_source_transition(
+            SourceTransitionConfig{SourceTransitionMode::kBlendBoth, 100.0, 1.0e-3});
+        path = 2;
+        error = 0.0;
+    }
+    SECTION("corrected after the model pass within the bound")
+    {
+        rig->pred.configure_source_transition(
+            SourceTransitionConfig{SourceTransitionMode::kBlendBoth, 100.0, 2.0});
+        path = 1;
+        error = 0.5 * jump;
+    }
+
+    rig->pred.step(0.0, 600.0, 10.0);
+    rig->bullseye.set_mode(BullseyeFrameMode::kAdoptedPrefer);
+    rig->pred.step(10.0, 600.0, 10.0);
+
+    const SourceTransitionTick& tr = rig->pred.source_transition();
+    REQUIRE(tr.switched);
+    REQUIRE(tr.blend == 0.0);
+    REQUIRE((static_cast<std::uint32_t>(rig->pred.tick_context().frame.degraded) &
+             static_cast<std::uint32_t>(contracts::Adopted::DegradeReason::kSourceTransition)) !=
+            0u);
+
+    REQUIRE(max_diff(rig->pub.read(), con->pub.read()) <= error);
+
+    TickTelemetryRecord recs[4]{};
+    REQUIRE(ring->pop(Span<TickTelemetryRecord>{recs, 4}) == 2u);
+    REQUIRE(recs[1].source_switched == 1u);
+    REQUIRE(recs[1].transition_path == path);
+
+    // After the blend the rows are the new source's.
+    rig->pred.step(120.0, 600.0, 10.0);
+    ado->pred.step(120.0, 600.0, 10.0);
+    REQUIRE_FALSE(rig->pred.source_transition().blending);
+    REQUIRE(max_diff(rig->pub.read(), ado->pub.read()) == 0.0);
+}
@@ -0,0 +1,208 @@
+// tests/unit/test_ss_j2_model.cpp
+
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/contracts.hpp"
+#include "core/relative_predictor_policies.hpp"
+#include "core/time_grid.hpp"
+#include "models/model_hcw.hpp"
+#include "models/model_ss_j2.hpp"
+
+using bullseye_pred::HcwParams;
+using bullseye_pred::ModelCode;
+using bullseye_pred::ModelHCW;
+using bullseye_pred::ModelSS_J2;
+using bullseye_pred::RelStateRic;
+using bullseye_pred::Span;
+using bullseye_pred::Span2D;
+using bullseye_pred::SsJ2Params;
+using bullseye_pred::TimeGrid;
+using bullseye_pred::Vec3;
+
+namespace
+{
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kR = 6778137.0;
+
+SsJ2Params leo_params(double j2)
+{
+    SsJ2Params p{};
+    p.n_radps = std::sqrt(kMu / (kR * kR * kR));
+    p.r_ref_m = kR;
+    p.inc_rad = 51.6 * 3.14159265358979323846 / 180.0;
+    p.j2 = j2;
+    p.r_eq_m = bullseye_pred::contracts::Grav::kREqM;
+    return p;
+}
+
+TimeGrid uniform_grid(std::size_t steps, double dt)
+{
+    TimeGrid g;
+    g.tau.resize(steps);
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        g.tau[k] = dt * static_cast<double>(k);
+    }
+    return g;
+}
+
+const RelStateRic kX0{Vec3{120.0, -350.0, 40.0}, Vec3{0.05, -0.21, 0.03}};
+
+} // namespace
+
+TEST_CASE("SS-J2 with J2 = 0 reduces to HCW", "[ss_j2]")
+{
+    const SsJ2Params p = leo_params(0.0);
+    HcwParams h{};
+    h.n_radps = p.n_radps;
+    const TimeGrid g = uniform_grid(200, 30.0);
+
+    std::vector<Vec3> r_ss(200), v_ss(200), r_hcw(200), v_hcw(200);
+    REQUIRE(ModelSS_J2{}
+                .predict_ss(kX0, p, g, Span<Vec3>{r_ss.data(), 200}, Span<Vec3>{v_ss.data(), 200})
+                .code == ModelCode::kOk);
+    REQUIRE(ModelHCW{}
+                .predict_hcw(kX0, h, g, Span<Vec3>{r_hcw.data(), 200},
+                             Span<Vec3>{v_hcw.data(), 200})
+                .code == ModelCode::kOk);
+    for (std::size_t k = 0; k < 200; ++k)
+    {
+        REQUIRE(r_ss[k].x == Catch::Approx(r_hcw[k].x).margin(1e-6));
+        REQUIRE(r_ss[k].y == Catch::Approx(r_hcw[k].y).margin(1e-6));
+        REQUIRE(r_ss[k].z == Catch::Approx(r_hcw[k].z).margin(1e-6));
+        REQUIRE(v_ss[k].x == Catch::Approx(v_hcw[k].x).margin(1e-9));
+        REQUIRE(v_ss[k].y == Catch::Approx(v_hcw[k].y).margin(1e-9));
+    }
+}
+
+TEST_CASE("SS-J2 closed form matches integrated SS equations", "[ss_j2]")
+{
+    const SsJ2Params p = leo_params(bullseye_pred::contracts::Grav::kJ2);
+    bullseye_pred::SsJ2Rates rates{};
+    REQUIRE(bullseye_pred::ss_j2_rates(p, rates));
+    REQUIRE(rates.a != p.n_radps);
+
+    // RK4 on the SS ODE over three orbits.
+    const double n = p.n_radps;
+    const double c2 = (rates.a / n) * (rates.a / n);
+    const double b = (5.0 * c2 - 2.0) * n * n;
+    auto f = [&](const double* s, double* d) {
+        d[0] = s[3];
+        d[1] = s[4];
+        d[2] = s[5];
+        d[3] = 2.0 * rates.a * s[4] + b * s[0];
+        d[4] = -2.0 * rates.a * s[3];
+        d[5] = -rates.q * rates.q * s[2];
+    };
+    const double T = 3.0 * 2.0 * 3.14159265358979323846 / n;
+    const std::size_t nsub = 60000;
+    const double h = T / static_cast<double>(nsub);
+    double s[6] = {kX0.r_ric.x, kX0.r_ric.y, kX0.r_ric.z, kX0.v_ric.x, kX0.v_ric.y, kX0.v_ric.z};
+    for (std::size_t it = 0; it < nsub; ++it)
+    {
+        double k1[6], k2[6], k3[6], k4[6], t[6];
+        f(s, k1);
+        for (int j = 0; j < 6; ++j) t[j] = s[j] + 0.5 * h * k1[j];
+        f(t, k2);
+        for (int j = 0; j < 6; ++j) t[j] = s[j] + 0.5 * h * k2[j];
+        f(t, k3);
+        for (int j = 0; j < 6; ++j) t[j] = s[j] + h * k3[j];
+        f(t, k4);
+        for (int j = 0; j < 6; ++j) s[j] += h / 6.0 * (k1[j] + 2.0 * k2[j] + 2.0 * k3[j] + k4[j]);
+    }
+
+    TimeGrid g;
+    g.tau = {0.0, T};
+    Vec3 r[2]{};
+    Vec3 v[2]{};
+    REQUIRE(ModelSS_J2{}.predict_ss(kX0, p, g, Span<Vec3>{r, 2}, Span<Vec3>{v, 2}).code ==
+            ModelCode::kOk);
+    REQUIRE(r[0].x == Catch::Approx(kX0.r_ric.x).margin(1e-9));
+    REQUIRE(r[1].x == Catch::Approx(s[0]).margin(1e-5));
+    REQUIRE(r[1].y == Catch::Approx(s[1]).margin(1e-5));
+    REQUIRE(r[1].z == Catch::Approx(s[2]).margin(1e-5));
+    REQUIRE(v[1].x == Catch::Approx(s[3]).margin(1e-8));
+    REQUIRE(v[1].y == Catch::Approx(s[4]).margin(1e-8));
+    REQUIRE(v[1].z == Catch::Approx(s[5]).margin(1e-8));
+}
+
+TEST_CASE("SS-J2 batch is bitwise identical to single rows and rejects bad input", "[ss_j2]")
+{
+    const SsJ2Params p = leo_params(bullseye_pred::contracts::Grav::kJ2);
+    const TimeGrid g = uniform_grid(50, 10.0);
+    const RelStateRic x0[3] = {kX0,
+                               RelStateRic{Vec3{std::nan(""), 0.0, 0.0}, Vec3{}},
+                               RelStateRic{Vec3{-10.0, 5.0, 2.0}, Vec3{0.0, 0.02, -0.001}}};
+    std::vector<Vec3> r(3 * 50), v(3 * 50);
+    ModelCode codes[3]{};
+    const auto res = ModelSS_J2{}.predict_ss_batch(
+        Span<const RelStateRic>{x0, 3}, p, g, Span2D<Vec3>{r.data(), 3, 50, 50},
+        Span2D<Vec3>{v.data(), 3, 50, 50}, Span<ModelCode>{codes, 3});
+    REQUIRE(res.code == ModelCode::kOk);
+    REQUIRE(codes[0] == ModelCode::kOk);
+    REQUIRE(codes[1] == ModelCode::kInvalidInput);
+    REQUIRE(codes[2] == ModelCode::kOk);
+
+    Vec3 r1[50]{};
+    Vec3 v1[50]{};
+    REQUIRE(ModelSS_J2{}.predict_ss(x0[2], p, g, Span<Vec3>{r1, 50}, Span<Vec3>{v1, 50}).code ==
+            ModelCode::kOk);
+    for (std::size_t k = 0; k < 50; ++k)
+    {
+        REQUIRE(r1[k].x == r[100 + k].x);
+        REQUIRE(r1[k].y == r[100 + k].y);
+        REQUIRE(v1[k].z == v[100 + k].z);
+    }
+    REQUIRE(ModelSS_J2{}.predict_ss(x0[1], p, g, Span<Vec3>{r1, 50}, Span<Vec3>{}).code ==
+            ModelCode::kInvalidInput);
+
+    SsJ2Params bad = p;
+    bad.r_ref_m = 0.0;
+    REQUIRE(ModelSS_J2{}.predict_ss(x0[0], bad, g, Span<Vec3>{r1, 50}, Span<Vec3>{}).code ==
+            ModelCode::kInvalidInput);
+}
+
+TEST_CASE("Model selector runs SS-J2 inside the circular region", "[ss_j2]")
+{
+    bullseye_pred::RelativePredictorConfig cfg{};
+    cfg.model = bullseye_pred::PredictorModel::kAuto;
+    cfg.selector.circular_model = bullseye_pred::PredictorModel::kSsJ2;
+    cfg.selector.rho_hcw_enter_m = 1e3;
+    cfg.selector.rho_hcw_exit_m = 2e3;
+    bullseye_pred::DynamicModelPolicy policy(cfg);
+
+    bullseye_pred::ChiefState chief{};
+    chief.r_i = Vec3{kR, 0.0, 0.0};
+    const double vc = std::sqrt(kMu / kR);
+    chief.v_i = Vec3{0.0, vc * std::cos(0.9), vc * std::sin(0.9)};
+    const double n = vc / kR;
+    const TimeGrid g = uniform_grid(20, 10.0);
+    REQUIRE(policy.begin_tick(chief, n, g));
+
+    const RelStateRic x0[2] = {kX0, RelStateRic{Vec3{5e3, 0.0, 0.0}, Vec3{}}};
+    const bool active[2] = {true, true};
+    bool ok[2] = {false, false};
+    std::vector<Vec3> r(2 * 20);
+    policy.predict_block(Span<const RelStateRic>{x0, 2}, Span<const bool>{active, 2},
+                         Span2D<Vec3>{r.data(), 2, 20, 20}, Span2D<Vec3>{}, Span<bool>{ok, 2});
+    REQUIRE(ok[0]);
+    REQUIRE(ok[1]);
+    REQUIRE(policy.row_selection(0).model == bullseye_pred::PredictorModel::kSsJ2);
+    REQUIRE(policy.row_selection(1).model == bullseye_pred::PredictorModel::kYaStm);
+
+    // Row 0 equals the standalone model with the chief-derived reference orbit.
+    SsJ2Params p{};
+    p.j2 = cfg.j2;
+    p.r_eq_m = cfg.r_eq_m;
+    REQUIRE(bullseye_pred::ss_j2_params_from_chief(chief.r_i, chief.v_i, n, p));
+    REQUIRE(p.inc_rad == Catch::Approx(0.9));
+    Vec3 ref[20]{};
+    REQUIRE(ModelSS_J2{}.predict_ss(kX0, p, g, Span<Vec3>{ref, 20}, Span<Vec3>{}).code ==
+            ModelCode::kOk);
+    REQUIRE(ref[19].y == r[19].y);
+}
@@ -0,0 +1,196 @@
+// tests/unit/test_state_covariance.cpp
+
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/bullseye_frame.hpp"
+#include "core/bullseye_frame_math.hpp"
+#include "core/chief_state_provider.hpp"
+#include "core/frame_transforms.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/state_covariance.hpp"
+#include "core/time_grid.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "models/model_hcw.hpp"
+#include "predictor_rig.hpp"
+
+using namespace bullseye_pred;
+using bullseye_pred::testing::Rig;
+using bullseye_pred::testing::RigOptions;
+
+namespace
+{
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kR0 = 7000e3;
+
+// P = d d^T for d = [r; v]: propagates to Sigma_k = x_k x_k^T with x_k the trajectory from d.
+StateCovariance rank_one(const Vec3& r, const Vec3& v)
+{
+    const double d[6] = {r.x, r.y, r.z, v.x, v.y, v.z};
+    StateCovariance P{};
+    for (int i = 0; i < 6; ++i)
+    {
+        for (int j = 0; j < 6; ++j)
+        {
+            P.m[i][j] = d[i] * d[j];
+        }
+    }
+    return P;
+}
+
+void require_outer(const PositionCovariance& s, const Vec3& x)
+{
+    const double scale = dot(x, x) + 1.0;
+    CHECK(s.rr == Catch::Approx(x.x * x.x).margin(1e-9 * scale));
+    CHECK(s.ri == Catch::Approx(x.x * x.y).margin(1e-9 * scale));
+    CHECK(s.rc == Catch::Approx(x.x * x.z).margin(1e-9 * scale));
+    CHECK(s.ii == Catch::Approx(x.y * x.y).margin(1e-9 * scale));
+    CHECK(s.ic == Catch::Approx(x.y * x.z).margin(1e-9 * scale));
+    CHECK(s.cc == Catch::Approx(x.z * x.z).margin(1e-9 * scale));
+}
+
+} // namespace
+
+TEST_CASE("Covariance kernel matches Phi P0 Phi^T of the HCW STM", "[covariance]")
+{
+    const double n = std::sqrt(kMu / (kR0 * kR0 * kR0));
+    TimeGrid grid;
+    grid.tau.resize(121);
+    for (std::size_t k = 0; k < grid.tau.size(); ++k)
+    {
+        grid.tau[k] = 30.0 * static_cast<double>(k);
+    }
+    const std::size_t steps = grid.tau.size();
+
+    ModelHCW hcw;
+    HcwParams params{};
+    params.n_radps = n;
+    std::vector<Vec3> basis(6 * steps);
+    for (std::size_t j = 0; j < 6; ++j)
+    {
+        RelStateRic e{};
+        const Vec3 axis{j % 3 == 0 ? 1.0 : 0.0, j % 3 == 1 ? 1.0 : 0.0, j % 3 == 2 ? 1.0 : 0.0};
+        (j < 3 ? e.r_ric : e.v_ric) = axis;
+        REQUIRE(hcw.predict_hcw(e, params, grid, Span<Vec3>{basis.data() + j * steps, steps},
+                                Span<Vec3>{})
+                    .code == ModelCode::kOk);
+    }
+
+    // Rank one: Sigma_k is the outer product of the trajectory from d.
+    const RelStateRic d{Vec3{12.0, -30.0, 4.0}, Vec3{0.02, -0.01, 0.005}};
+    std::vector<Vec3> traj(steps);
+    REQUIRE(hcw.predict_hcw(d, params, grid, Span<Vec3>{traj.data(), steps}, Span<Vec3>{}).code ==
+            ModelCode::kOk);
+    std::vector<PositionCovariance> sigma(steps);
+    propagate_position_covariance(rank_one(d.r_ric, d.v_ric),
+                                  Span2D<const Vec3>{basis.data(), 6, steps, steps},
+                                  Span<PositionCovariance>{sigma.data(), steps});
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        require_outer(sigma[k], traj[k]);
+    }
+
+    // Diagonal P0: Sigma_k(rr) = sum_j P0_jj Phi_k(0, j)^2.
+    StateCovariance diag{};
+    const double var[6] = {4.0, 9.0, 1.0, 1e-4, 4e-4, 1e-6};
+    for (int j = 0; j < 6; ++j)
+    {
+        diag.m[j][j] = var[j];
+    }
+    propagate_position_covariance(diag, Span2D<const Vec3>{basis.data(), 6, steps, steps},
+                                  Span<PositionCovariance>{sigma.data(), steps});
+    for (std::size_t k = 0; k < steps; k += 20)
+    {
+        double rr = 0.0;
+        double cc = 0.0;
+        for (std::size_t j = 0; j < 6; ++j)
+        {
+            rr += var[j] * basis[j * steps + k].x * basis[j * steps + k].x;
+            cc += var[j] * basis[j * steps + k].z * basis[j * steps + k].z;
+        }
+        CHECK(sigma[k].rr == Catch::Approx(rr));
+        CHECK(sigma[k].cc == Catch::Approx(cc).margin(1e-12));
+    }
+
+    // Fewer than six basis rows: nothing written.
+    PositionCovariance untouched{};
+    untouched.rr = -1.0;
+    propagate_position_covariance(diag, Span2D<const Vec3>{basis.data(), 5, steps, steps},
+                                  Span<PositionCovariance>{&untouched, 1});
+    CHECK(untouched.rr == -1.0);
+}
+
+TEST_CASE("Inertial covariance maps through the RIC transform Jacobian", "[covariance]")
+{
+    ChiefState chief{};
+    chief.r_i = Vec3{kR0, 0.0, 0.0};
+    chief.v_i = Vec3{0.0, std::sqrt(kMu / kR0), 0.0};
+    chief.status.code = ProviderCode::kOk;
+    const ConstructedRicFrame con = construct_ric_from_chief(chief);
+    REQUIRE(con.status.ok());
+    const Mat3 C_i2r = transpose(con.C_from_ric_to_inertial);
+    const Vec3 omega{0.0, 0.0, std::sqrt(kMu / (kR0 * kR0 * kR0))};
+
+    const Vec3 dr{40.0, -15.0, 7.0};
+    const Vec3 dv{0.03, 0.01, -0.02};
+    StateCovariance ric{};
+    REQUIRE(inertial_to_ric_covariance(rank_one(dr, dv), C_i2r, omega, ric));
+
+    const RelState x = inertial_to_ric_relative(chief.r_i + dr, chief.v_i + dv, chief.r_i,
+                                                chief.v_i, C_i2r, omega);
+    const double e[6] = {x.r.x, x.r.y, x.r.z, x.v.x, x.v.y, x.v.z};
+    for (int i = 0; i < 6; ++i)
+    {
+        for (int j = 0; j < 6; ++j)
+        {
+            CHECK(ric.m[i][j] == Catch::Approx(e[i] * e[j]).margin(1e-9));
+        }
+    }
+
+    StateCovariance bad = rank_one(dr, dv);
+    bad.m[2][4] = std::nan("");
+    StateCovariance kept = ric;
+    CHECK_FALSE(inertial_to_ric_covariance(bad, C_i2r, omega, kept));
+    CHECK(kept.m[0][0] == ric.m[0][0]);
+}
+
+TEST_CASE("Predictor publishes position covariance for rows that report one", "[covariance]")
+{
+    // Vehicle 1 is offset from the chief by exactly d, so its predicted row is Phi J d and the
+    // published covariance of P = d d^T must be that row's outer product. Vehicle 2 reports
+    // no covariance.
+    const Vec3 dr{60.0, 25.0, -10.0};
+    const Vec3 dv{0.01, -0.04, 0.02};
+    RigOptions opt;
+    opt.publisher.position_covariance = true;
+    static Rig<HcwRelativePredictor> rig(opt);
+    rig.veh.dr_per_id = dr;
+    rig.veh.dv_per_id = dv;
+    rig.veh.covariance_id = 1u;
+    rig.veh.covariance = rank_one(dr, dv);
+    REQUIRE(rig.pub.has_position_covariance());
+
+    rig.pred.step(0.0, 600.0, 10.0);
+    const PredictionBuffer& snap = rig.pub.read();
+    REQUIRE(snap.has_position_covariance());
+    REQUIRE(snap.valid_rows == 0x3u);
+    REQUIRE(snap.cov_rows == 0x1u);
+    for (std::size_t k = 0; k < snap.steps; ++k)
+    {
+        require_outer((*snap.position_cov)[0][k], snap.positions[0][k]);
+    }
+
+    // A row published clean keeps its covariance and bit.
+    const PositionCovariance before = (*snap.position_cov)[0][snap.steps - 1];
+    (void)rig.pub.begin_write();
+    (void)rig.pub.publish(10.0, RowMask{0x2u});
+    const PredictionBuffer& next = rig.pub.read();
+    REQUIRE(next.cov_rows == 0x1u);
+    CHECK((*next.position_cov)[0][snap.steps - 1].rr == before.rr);
+    CHECK((*next.position_cov)[0][snap.steps - 1].ic == before.ic);
+}
@@ -0,0 +1,417 @@
+// tests/unit/test_steady_state_allocations.cpp
+/**
+ * @file test_steady_state_allocations.cpp
+ * @brief Warm predictor ticks must not touch the heap (DoD: no steady-state allocation).
+ *
+ * Every predictor configuration is constructed and configured, given a few warm-up ticks
+ * (caches, grids and profile tables settle), then stepped kWarmTicks times on advancing t0
+ * under a process-wide allocation counter (allocation_tracker.hpp).
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "allocation_tracker.hpp"
+#include "core/async_predictor.hpp"
+#include "core/bullseye_frame.hpp"
+#include "core/dummy_predictor.hpp"
+#include "core/fleet_predictor.hpp"
+#include "core/provider_twobody.hpp"
+#include "core/provider_twobody_fleet.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/time_grid.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "core/worker_pool.hpp"
+
+using namespace bullseye_pred;
+using bullseye_pred::testing::AllocationScope;
+using bullseye_pred::testing::ScopedAllocationCounter;
+
+namespace
+{
+
+constexpr const char* kFrame = "INERTIAL";
+constexpr double kMu = 3.986004418e14;
+constexpr std::size_t kDeputies = (MAX_VEHICLES < 12u) ? MAX_VEHICLES : 12u;
+constexpr int kWarmUpTicks = 3;
+constexpr int kWarmTicks = 20;
+constexpr double kCadenceSec = 1.0;
+constexpr double kHorizonSec = static_cast<double>(MAX_STEPS - 1u) * kCadenceSec; // full rows
+
+const Vec3 kChiefR{6878e3, 0.0, 0.0};
+
+Vec3 chief_v()
+{
+    return Vec3{0.0, std::sqrt(kMu / kChiefR.x) * 1.001, 75.0};
+}
+
+// A formation with a two-body chief and deputies (heap-held: the publisher is large).
+struct Rig
+{
+    VehicleIndexMap map{kDeputies};
+    TwoBodyChiefProvider chief{kFrame, kMu, 0.0, kChiefR, chief_v()};
+    TwoBodyVehicleProvider deputies{kFrame, kMu};
+    BullseyeFrame bullseye{chief, nullptr, BullseyeFrameMode::kConstructedOnly};
+    Publisher pub;
+
+    explicit Rig(const PublisherConfig& pc = PublisherConfig{}) : pub(pc)
+    {
+        for (std::size_t d = 0; d < kDeputies; ++d)
+        {
+            const auto id = static_cast<VehicleIndexMap::VehicleId>(10 + d);
+            const double k = static_cast<double>(d + 1);
+            REQUIRE(deputies.add_vehicle(id, 0.0, kChiefR + Vec3{25.0 * k, -40.0 * k, 2.0 * k},
+                                         chief_v() + Vec3{0.0, 0.015 * k, -0.004 * k}));
+            REQUIRE(map.register_vehicle(id).has_value());
+        }
+    }
+};
+
+RowMask all_rows()
+{
+    return (RowMask{1} << kDeputies) - 1u;
+}
+
+// Warm up, then count allocations (every thread) over kWarmTicks further ticks.
+template <typename Step>
+std::uint64_t warm_tick_allocations(Step&& step)
+{
+    double t = 0.0;
+    for (int k = 0; k < kWarmUpTicks; ++k, t += 1.0)
+    {
+        step(t);
+    }
+    const ScopedAllocationCounter allocs(AllocationScope::kProcess);
+    for (int k = 0; k < kWarmTicks; ++k, t += 1.0)
+    {
+        step(t);
+    }
+    return allocs.allocations();
+}
+
+template <typename Predictor>
+std::uint64_t predictor_allocations(Predictor& pred)
+{
+    return warm_tick_allocations([&](double t) { pred.step(t, kHorizonSec, kCadenceSec); });
+}
+
+} // namespace
+
+TEST_CASE("Allocation tracker counts per thread and per process", "[alloc]")
+{
+    const ScopedAllocationCounter thread_allocs;
+    {
+        // Direct operator new/delete calls: unlike new-expressions, the optimizer may not
+        // elide them.
+        void* const one = ::operator new(sizeof(int));
+        void* const many = ::operator new(100u * sizeof(double));
+        ::operator delete(many);
+        ::operator delete(one);
+    }
+    const auto c = thread_allocs.counts();
+    REQUIRE(c.allocations == 2u);
+    REQUIRE(c.deallocations == 2u);
+    REQUIRE(c.bytes >= sizeof(int) + 100u * sizeof(double));
+
+    // Another thread's allocations show in the process counter only (std::thread itself
+    // allocates on the creating thread, so start counting once it exists).
+    std::atomic<bool> go{false};
+    std::thread worker(
+        [&go]()
+        {
+            while (!go.load())
+            {
+                std::this_thread::yield();
+            }
+            ::operator delete(::operator new(sizeof(double)));
+        });
+    const ScopedAllocationCounter mine;
+    const ScopedAllocationCounter all(AllocationScope::kProcess);
+    go.store(true);
+    worker.join();
+    REQUIRE(mine.allocations() == 0u);
+    REQUIRE(all.allocations() >= 1u);
+}
+
+TEST_CASE("Time grid caches do not allocate once built", "[alloc][time_grid]")
+{
+    TimeGridCache cache(MAX_STEPS);
+    (void)cache.get(kHorizonSec, kCadenceSec);
+    TimeGrid grid;
+    REQUIRE(fill_time_grid(kHorizonSec, kCadenceSec, grid));
+
+    const ScopedAllocationCounter allocs;
+    for (int k = 0; k < 10; ++k)
+    {
+        (void)cache.get(kHorizonSec, kCadenceSec);
+        (void)cache.get(kHorizonSec * 0.5, kCadenceSec); // rebuild within the reserved capacity
+        (void)fill_time_grid(kHorizonSec * 0.5, kCadenceSec, grid);
+    }
+    REQUIRE(allocs.allocations() == 0u);
+
+    // make_time_grid() returns a fresh vector: never call it per tick.
+    const ScopedAllocationCounter fresh;
+    REQUIRE(make_time_grid(kHorizonSec, kCadenceSec).tau.size() == MAX_STEPS);
+    REQUIRE(fresh.allocations() > 0u);
+}
+
+TEST_CASE("A warmed-up predictor's first tick does not allocate", "[alloc][predictor]")
+{
+    const auto rig = std::make_unique<Rig>();
+    const auto cold = std::make_unique<Rig>();
+    WorkerPool pool(2);
+    const auto pred = std::make_unique<HcwRelativePredictor>(rig->pub, rig->map, rig->chief,
+                                                             rig->deputies, rig->bullseye);
+    const auto ref = std::make_unique<HcwRelativePredictor>(cold->pub, cold->map, cold->chief,
+                                                            cold->deputies, cold->bullseye);
+    pred->attach_worker_pool(&pool);
+    TrajectoryReuseConfig reuse{};
+    reuse.enabled = true;
+    pred->configure_reuse(reuse);
+    ref->configure_reuse(reuse);
+
+    REQUIRE(pred->warm_up(0.0, kHorizonSec, kCadenceSec));
+    REQUIRE(rig->pub.published_seqno() == 0u);
+    REQUIRE_FALSE(pred->tick_context().valid);
+
+    // The first live ticks match a predictor that was never warmed up.
+    for (int k = 0; k < 3; ++k)
+    {
+        const double t = static_cast<double>(k);
+        const ScopedAllocationCounter allocs(AllocationScope::kProcess);
+        pred->step(t, kHorizonSec, kCadenceSec);
+        REQUIRE(allocs.allocations() == 0u);
+        ref->step(t, kHorizonSec, kCadenceSec);
+        REQUIRE(pred->reuse_stats().rows_reused == ref->reuse_stats().rows_reused);
+        const PredictionBuffer& a = rig->pub.read();
+        const PredictionBuffer& b = cold->pub.read();
+        REQUIRE(a.seqno == b.seqno);
+        REQUIRE(a.valid_rows == all_rows());
+        for (std::size_t i = 0; i < kDeputies; ++i)
+        {
+            for (std::size_t s = 0; s < a.steps; ++s)
+            {
+                REQUIRE(norm(a.positions[i][s] - b.positions[i][s]) == 0.0);
+            }
+        }
+    }
+
+    // A tick the providers reject warms nothing past them.
+    REQUIRE_FALSE(pred->warm_up(std::nan(""), kHorizonSec, kCadenceSec));
+    REQUIRE(rig->pub.published_seqno() == 3u);
+}
+
+TEST_CASE("Warming up a kAuto predictor leaves its model selectors fresh", "[alloc][predictor]")
+{
+    const auto rig = std::make_unique<Rig>();
+    const auto cold = std::make_unique<Rig>();
+    RelativePredictorConfig cfg{};
+    cfg.model = PredictorModel::kAuto;
+    const auto pred = std::make_unique<RelativePredictor>(rig->pub, rig->map, rig->chief,
+                                                          rig->deputies, rig->bullseye, cfg);
+    const auto ref = std::make_unique<RelativePredictor>(cold->pub, cold->map, cold->chief,
+                                                         cold->deputies, cold->bullseye, cfg);
+
+    // Warmed at a later t0 than the first live tick: the selectors must not remember it.
+    REQUIRE(pred->warm_up(30.0, kHorizonSec, kCadenceSec));
+    for (int k = 0; k < 3; ++k)
+    {
+        const double t = static_cast<double>(k);
+        pred->step(t, kHorizonSec, kCadenceSec);
+        ref->step(t, kHorizonSec, kCadenceSec);
+        const PredictionBuffer& a = rig->pub.read();
+        const PredictionBuffer& b = cold->pub.read();
+        REQUIRE(a.valid_rows == all_rows());
+        REQUIRE(a.valid_rows == b.valid_rows);
+        for (std::size_t i = 0; i < kDeputies; ++i)
+        {
+            REQUIRE(a.row_model[i].model == b.row_model[i].model);
+            REQUIRE(a.row_model[i].cause == b.row_model[i].cause);
+            REQUIRE(a.row_model[i].switched == b.row_model[i].switched);
+            if (k == 0)
+            {
+                REQUIRE(a.row_model[i].cause == ModelSelectCause::kInitial);
+            }
+            for (std::size_t s = 0; s < a.steps; ++s)
+            {
+                REQUIRE(norm(a.positions[i][s] - b.positions[i][s]) == 0.0);
+            }
+        }
+    }
+}
+
+TEST_CASE("Warm HCW and YA predictor ticks do not allocate", "[alloc][predictor]")
+{
+    const auto rig = std::make_unique<Rig>();
+
+    SECTION("HCW")
+    {
+        const auto pred = std::make_unique<HcwRelativePredictor>(
+            rig->pub, rig->map, rig->chief, rig->deputies, rig->bullseye);
+        REQUIRE(predictor_allocations(*pred) == 0u);
+    }
+    SECTION("YA RK4")
+    {
+        RelativePredictorConfig cfg;
+        cfg.ya_max_dt_sec = 1.0;
+        const auto pred = std::make_unique<YaRelativePredictor>(
+            rig->pub, rig->map, rig->chief, rig->deputies, rig->bullseye, cfg);
+        REQUIRE(predictor_allocations(*pred) == 0u);
+    }
+    SECTION("YA closed form")
+    {
+        RelativePredictorConfig cfg;
+        cfg.ya_backend = YaStmBackend::kClosedForm;
+        const auto pred = std::make_unique<YaRelativePredictor>(
+            rig->pub, rig->map, rig->chief, rig->deputies, rig->bullseye, cfg);
+        REQUIRE(predictor_allocations(*pred) == 0u);
+    }
+    SECTION("YA Dormand-Prince")
+    {
+        RelativePredictorConfig cfg;
+        cfg.ya_backend = YaStmBackend::kDormandPrince54;
+        const auto pred = std::make_unique<YaRelativePredictor>(
+            rig->pub, rig->map, rig->chief, rig->deputies, rig->bullseye, cfg);
+        REQUIRE(predictor_allocations(*pred) == 0u);
+    }
+    SECTION("Per-vehicle selection")
+    {
+        RelativePredictorConfig cfg;
+        cfg.model = PredictorModel::kAuto;
+        const auto pred = std::make_unique<RelativePredictor>(
+            rig->pub, rig->map, rig->chief, rig->deputies, rig->bullseye, cfg);
+        REQUIRE(predictor_allocations(*pred) == 0u);
+    }
+    REQUIRE(rig->pub.read().valid_rows == all_rows());
+}
+
+TEST_CASE("Warm ticks with every optional stage enabled do not allocate", "[alloc][predictor]")
+{
+    PublisherConfig pc;
+    pc.velocities = true;
+    pc.inertial_positions = true;
+    pc.slots = 3;
+    pc.soa_layout = SoaLayout::kVehicleMajor;
+    pc.precision = OutputPrecision::kFloat32;
+    const auto rig = std::make_unique<Rig>(pc);
+    WorkerPool pool(2);
+
+    const auto pred = std::make_unique<HcwRelativePredictor>(
+        rig->pub, rig->map, rig->chief, rig->deputies, rig->bullseye);
+    TrajectoryReuseConfig reuse;
+    reuse.enabled = true;
+    pred->configure_reuse(reuse);
+    pred->configure_inertial_output(InertialOutputConfig{kMu});
+    ApproachSummaryConfig approach;
+    approach.enabled = true;
+    approach.keep_out_count = 2;
+    approach.keep_out_radius_m = {200.0, 1000.0};
+    pred->configure_approach_summary(approach);
+    TickBudgetConfig budget;
+    budget.enabled = true;
+    budget.priority = RowPriority::kClosingRate;
+    pred->configure_budget(budget);
+    pred->attach_worker_pool(&pool);
+
+    // Far deputies on a coarse, long grid.
+    REQUIRE(pred->set_grid_profile(1, 3.0 * kHorizonSec, 3.0 * kCadenceSec));
+    REQUIRE(rig->map.set_grid_profile(10, 1));
+    REQUIRE(rig->map.set_grid_profile(11, 1));
+
+    REQUIRE(predictor_allocations(*pred) == 0u);
+    const PredictionBuffer& b = rig->pub.read();
+    REQUIRE(b.valid_rows == all_rows());
+    REQUIRE(b.has_velocities());
+}
+
+TEST_CASE("Ticks after membership changes do not allocate", "[alloc][predictor]")
+{
+    const auto rig = std::make_unique<Rig>();
+    const auto pred = std::make_unique<HcwRelativePredictor>(rig->pub, rig->map, rig->chief,
+                                                             rig->deputies, rig->bullseye);
+    for (int k = 0; k < kWarmUpTicks; ++k)
+    {
+        pred->step(static_cast<double>(k), kHorizonSec, kCadenceSec);
+    }
+
+    // Drop and re-add one deputy every other tick; only the ticks are counted (registration
+    // is an event path and logs).
+    std::uint64_t allocs = 0;
+    for (int k = 0; k < kWarmTicks; ++k)
+    {
+        const auto id = static_cast<VehicleIndexMap::VehicleId>(10 + (k / 2) % kDeputies);
+        if (k % 2 == 0)
+        {
+            REQUIRE(rig->map.unregister_vehicle(id).has_value());
+        }
+        else
+        {
+            REQUIRE(rig->map.register_vehicle(id).has_value());
+        }
+        const ScopedAllocationCounter tick(AllocationScope::kProcess);
+        pred->step(static_cast<double>(kWarmUpTicks + k), kHorizonSec, kCadenceSec);
+        allocs += tick.allocations();
+    }
+    REQUIRE(allocs == 0u);
+    REQUIRE(rig->pub.read().valid_rows == all_rows());
+}
+
+TEST_CASE("Warm dummy, fleet and async predictor ticks do not allocate", "[alloc][predictor]")
+{
+    SECTION("Dummy")
+    {
+        const auto rig = std::make_unique<Rig>();
+        DummyPredictor pred(rig->pub, rig->map);
+        REQUIRE(predictor_allocations(pred) == 0u);
+        REQUIRE(rig->pub.read().valid_rows == all_rows());
+    }
+    SECTION("Fleet on a worker pool")
+    {
+        WorkerPool pool(2);
+        std::vector<std::unique_ptr<Rig>> rigs;
+        FleetRelativePredictor fleet(&pool);
+        for (int f = 0; f < 3; ++f)
+        {
+            rigs.push_back(std::make_unique<Rig>());
+            Rig& r = *rigs.back();
+            REQUIRE(fleet
+                        .add_formation(r.pub, r.map, r.chief, r.deputies, nullptr,
+                                       BullseyeFrameMode::kConstructedOnly,
+                                       RelativePredictorConfig{})
+                        .has_value());
+        }
+        REQUIRE(warm_tick_allocations([&](double t)
+                                      { fleet.step(t, kHorizonSec, kCadenceSec); }) == 0u);
+        for (const auto& r : rigs)
+        {
+            REQUIRE(r->pub.read().valid_rows == all_rows());
+        }
+    }
+    SECTION("Async")
+    {
+        const auto rig = std::make_unique<Rig>();
+        const auto pub = std::make_unique<Publisher>();
+        const auto async = std::make_unique<AsyncRelativePredictor>(
+            *pub, rig->map, rig->chief, rig->deputies, nullptr,
+            BullseyeFrameMode::kConstructedOnly, RelativePredictorConfig{});
+        REQUIRE(async->running());
+        bool idle = true;
+        const std::uint64_t n = warm_tick_allocations(
+            [&](double t)
+            {
+                idle = async->submit(t, kHorizonSec, kCadenceSec) && async->wait_idle(30.0) &&
+                       idle;
+            });
+        REQUIRE(idle);
+        REQUIRE(n == 0u);
+        REQUIRE(pub->read().valid_rows == all_rows());
+    }
+}
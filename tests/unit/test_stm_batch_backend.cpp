@@ -0,0 +1,162 @@
+// tests/unit/test_stm_batch_backend.cpp
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/relative_predictor.hpp"
+#include "core/time_grid.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "models/model_hcw.hpp"
+#include "models/stm_batch_backend.hpp"
+#include "predictor_rig.hpp"
+
+using namespace bullseye_pred;
+using bullseye_pred::testing::Rig;
+using bullseye_pred::testing::RigOptions;
+
+namespace
+{
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kR0 = 7000e3;
+
+void require_near(const Vec3& a, const Vec3& b, double tol)
+{
+    CHECK(a.x == Catch::Approx(b.x).margin(tol));
+    CHECK(a.y == Catch::Approx(b.y).margin(tol));
+    CHECK(a.z == Catch::Approx(b.z).margin(tol));
+}
+
+// Slightly eccentric chief so YA/TH differs from HCW; deputies 1..5.
+RigOptions eccentric_rig()
+{
+    RigOptions opt;
+    opt.chief_speed_scale = 1.01;
+    opt.vehicles = {1u, 2u, 3u, 4u, 5u};
+    return opt;
+}
+
+// Deputy id at the chief plus (60, -90, 24) m * id, (0.02, -0.01 * id, 0.003) m/s.
+template <typename Predictor>
+void place_deputies(Rig<Predictor>& rig)
+{
+    rig.veh.dr_per_id = Vec3{60.0, -90.0, 24.0};
+    rig.veh.dv = Vec3{0.02, 0.0, 0.003};
+    rig.veh.dv_per_id = Vec3{0.0, -0.01, 0.0};
+}
+
+} // namespace
+
+TEST_CASE("CPU STM batch backend applies the basis to active rows", "[stm_batch]")
+{
+    const double n = std::sqrt(kMu / (kR0 * kR0 * kR0));
+    TimeGrid grid;
+    grid.tau.resize(std::min<std::size_t>(90u, MAX_STEPS));
+    for (std::size_t k = 0; k < grid.tau.size(); ++k)
+    {
+        grid.tau[k] = 20.0 * static_cast<double>(k);
+    }
+    const std::size_t steps = grid.tau.size();
+    HcwParams params{};
+    params.n_radps = n;
+    ModelHCW hcw;
+
+    std::vector<Vec3> basis_r(6 * steps);
+    std::vector<Vec3> basis_v(6 * steps);
+    for (std::size_t j = 0; j < 6; ++j)
+    {
+        double x[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        x[j] = 1.0;
+        const RelStateRic e{Vec3{x[0], x[1], x[2]}, Vec3{x[3], x[4], x[5]}};
+        REQUIRE(hcw.predict_hcw(e, params, grid, Span<Vec3>{basis_r.data() + j * steps, steps},
+                                Span<Vec3>{basis_v.data() + j * steps, steps})
+                    .code == ModelCode::kOk);
+    }
+
+    CpuStmBatchBackend backend;
+    std::vector<Vec3> out_r(3 * steps);
+    std::vector<Vec3> out_v(3 * steps);
+    bool ok[3] = {false, false, true};
+    const Span2D<Vec3> rows_r{out_r.data(), 3, steps, steps};
+    const Span2D<Vec3> rows_v{out_v.data(), 3, steps, steps};
+    CHECK(backend.collect(rows_r, rows_v, Span<bool>{ok, 3}) == ModelCode::kInvalidInput);
+
+    const RelStateRic x0[3] = {
+        RelStateRic{Vec3{150.0, -80.0, 20.0}, Vec3{0.03, -0.2, 0.01}},
+        RelStateRic{Vec3{std::nan(""), 0.0, 0.0}, Vec3{}},
+        RelStateRic{Vec3{1.0, 2.0, 3.0}, Vec3{}},
+    };
+    const bool active[3] = {true, true, false};
+    CHECK(backend.submit(Span<const RelStateRic>{x0, 3}, Span<const bool>{active, 3}, false) ==
+          ModelCode::kInvalidInput); // no basis yet
+    REQUIRE(backend.load_basis(Span2D<const Vec3>{basis_r.data(), 6, steps, steps},
+                               Span2D<const Vec3>{basis_v.data(), 6, steps, steps}) ==
+            ModelCode::kOk);
+    REQUIRE(backend.submit(Span<const RelStateRic>{x0, 3}, Span<const bool>{active, 3}, true) ==
+            ModelCode::kOk);
+    REQUIRE(backend.collect(rows_r, rows_v, Span<bool>{ok, 3}) == ModelCode::kOk);
+    CHECK(ok[0]);
+    CHECK_FALSE(ok[1]);
+    CHECK(ok[2]); // inactive: untouched
+
+    std::vector<Vec3> r(steps);
+    std::vector<Vec3> v(steps);
+    REQUIRE(hcw.predict_hcw(x0[0], params, grid, Span<Vec3>{r.data(), steps},
+                            Span<Vec3>{v.data(), steps})
+                .code == ModelCode::kOk);
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        require_near(out_r[k], r[k], 1e-7);
+        require_near(out_v[k], v[k], 1e-10);
+        CHECK(out_r[k].x == stm_basis_apply(basis_r.data(), steps, x0[0], k).x);
+    }
+    CHECK(backend.collect(rows_r, rows_v, Span<bool>{ok, 3}) == ModelCode::kInvalidInput);
+
+    // Velocities need a velocity basis.
+    REQUIRE(backend.load_basis(Span2D<const Vec3>{basis_r.data(), 6, steps, steps},
+                               Span2D<const Vec3>{}) == ModelCode::kOk);
+    CHECK(backend.submit(Span<const RelStateRic>{x0, 1}, Span<const bool>{active, 1}, true) ==
+          ModelCode::kInvalidInput);
+    CHECK(backend.load_basis(Span2D<const Vec3>{basis_r.data(), 5, steps, steps},
+                             Span2D<const Vec3>{}) == ModelCode::kInvalidInput);
+
+#ifndef BULLSEYE_ENABLE_CUDA
+    CHECK(make_cuda_stm_batch_backend(MAX_VEHICLES, MAX_STEPS) == nullptr);
+#endif
+}
+
+TEST_CASE("Batched-backend predictor matches the inner model", "[stm_batch]")
+{
+    for (const PredictorModel model : {PredictorModel::kHcw, PredictorModel::kYaStm})
+    {
+        RelativePredictorConfig config{};
+        config.model = model;
+        config.ya_backend = YaStmBackend::kClosedForm;
+        static CpuStmBatchBackend backend;
+        const auto batched =
+            std::make_unique<Rig<StmBatchRelativePredictor>>(eccentric_rig(), backend, config);
+        const auto reference = std::make_unique<Rig<RelativePredictor>>(eccentric_rig(), config);
+        place_deputies(*batched);
+        place_deputies(*reference);
+
+        batched->pred.step(100.0, 900.0, 15.0);
+        reference->pred.step(100.0, 900.0, 15.0);
+        const PredictionBuffer& a = batched->pub.read();
+        const PredictionBuffer& b = reference->pub.read();
+        REQUIRE(a.valid_rows == 0x1Fu);
+        REQUIRE(b.valid_rows == 0x1Fu);
+        REQUIRE(a.steps == b.steps);
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            for (std::size_t k = 0; k < a.steps; k += 5)
+            {
+                require_near(a.positions[i][k], b.positions[i][k], 1e-6);
+            }
+        }
+    }
+}
@@ -0,0 +1,206 @@
+// tests/unit/test_tick_telemetry.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "allocation_tracker.hpp"
+#include "core/bullseye_frame.hpp"
+#include "core/provider_twobody.hpp"
+#include "core/provider_twobody_fleet.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/tick_telemetry.hpp"
+#include "core/time_grid.hpp"
+#include "core/vehicle_index_map.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+constexpr double kMu = 3.986004418e14;
+
+struct Rig
+{
+    Vec3 r0{6878e3, 0.0, 0.0};
+    Vec3 v0{0.0, 7612.0, 10.0};
+    VehicleIndexMap map{8};
+    TwoBodyChiefProvider chief{"INERTIAL", kMu, 0.0, r0, v0};
+    TwoBodyVehicleProvider deputies{"INERTIAL", kMu};
+    BullseyeFrame bullseye{chief, nullptr, BullseyeFrameMode::kConstructedOnly};
+    std::unique_ptr<Publisher> pub = std::make_unique<Publisher>();
+
+    // Three deputies at rows 0..2, and row 3 registered without provider data.
+    Rig()
+    {
+        for (VehicleIndexMap::VehicleId id = 1; id <= 3; ++id)
+        {
+            const double k = static_cast<double>(id);
+            REQUIRE(deputies.add_vehicle(id, 0.0, r0 + Vec3{30.0 * k, -50.0 * k, k}, v0));
+            REQUIRE(map.register_vehicle(id).has_value());
+        }
+        REQUIRE(map.register_vehicle(99).has_value());
+    }
+};
+
+std::vector<TickTelemetryRecord> pop_all(TickTelemetryRing& ring)
+{
+    std::vector<TickTelemetryRecord> out(TickTelemetryRing::kCapacity);
+    out.resize(ring.pop(Span<TickTelemetryRecord>{out.data(), out.size()}));
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("The predictor pushes one telemetry record per tick", "[telemetry][predictor]")
+{
+    Rig rig;
+    RelativePredictorConfig cfg;
+    cfg.model = PredictorModel::kAuto;
+    const auto pred = std::make_unique<RelativePredictor>(*rig.pub, rig.map, rig.chief,
+                                                          rig.deputies, rig.bullseye, cfg);
+    const auto ring = std::make_unique<TickTelemetryRing>();
+
+    pred->step(0.0, 60.0, 1.0); // not attached: nothing recorded
+    pred->attach_telemetry(ring.get());
+    pred->step(1.0, 60.0, 1.0);
+    pred->step(2.0, TimeGrid{}); // empty grid: fails before the chief query
+    REQUIRE(rig.pub->published_seqno() == 2u);
+
+    const std::vector<TickTelemetryRecord> recs = pop_all(*ring);
+    REQUIRE(recs.size() == 2u);
+    REQUIRE(ring->size() == 0u);
+
+    const TickTelemetryRecord& r = recs[0];
+    REQUIRE(r.tick == 1u);
+    REQUIRE(r.outcome == TickOutcome::kPublished);
+    REQUIRE(r.seqno == 2u);
+    REQUIRE(r.t0 == 1.0);
+    REQUIRE(r.chief_status == ProviderCode::kOk);
+    REQUIRE(r.frame_status == ProviderCode::kOk);
+    REQUIRE(r.used_adopted == 0u);
+    REQUIRE(r.vehicles == 4u);
+    REQUIRE(r.steps == 61u);
+    REQUIRE(r.valid_rows == 0x7u);
+    REQUIRE(r.rows_ok == 3u);
+    REQUIRE(r.rows_provider_error == 1u);
+    REQUIRE(r.rows_skipped() == 1u);
+    REQUIRE(r.row_status[3] == RowStatus::kProviderError);
+    REQUIRE(r.row_provider[3] != ProviderCode::kOk);
+    REQUIRE(r.row_provider[0] == ProviderCode::kOk);
+    REQUIRE(r.row_model[0] == static_cast<std::uint8_t>(PredictorModel::kHcw));
+    REQUIRE(r.row_model[3] == kTelemetryNoModel);
+    REQUIRE(r.row_model[4] == kTelemetryNoModel);
+    REQUIRE(r.est_cost_total == rig.pub->read().est_cost_total);
+    REQUIRE(r.stage(TraceStage::kTick) > 0u);
+    REQUIRE(r.stage(TraceStage::kModel) > 0u);
+    REQUIRE(r.stage(TraceStage::kTick) >= r.stage(TraceStage::kModel));
+    REQUIRE(r.stage(TraceStage::kVehicle) == 0u);
+
+    const TickTelemetryRecord& e = recs[1];
+    REQUIRE(e.tick == 2u);
+    REQUIRE(e.outcome == TickOutcome::kEmptyGrid);
+    REQUIRE(e.seqno == 0u);
+    REQUIRE(e.stage(TraceStage::kTick) == 0u);
+
+    // Steady-state ticks with telemetry attached do not allocate.
+    {
+        testing::ScopedAllocationCounter allocs(testing::AllocationScope::kThread);
+        pred->step(3.0, 60.0, 1.0);
+        REQUIRE(allocs.allocations() == 0u);
+    }
+
+    // A full ring drops new records and counts them.
+    for (std::size_t k = 0; k < TickTelemetryRing::kCapacity + 5; ++k)
+    {
+        pred->step(4.0 + static_cast<double>(k), 60.0, 1.0);
+    }
+    REQUIRE(ring->size() == TickTelemetryRing::kCapacity);
+    REQUIRE(ring->dropped() == 6u);
+    REQUIRE(pop_all(*ring).front().tick == 3u);
+}
+
+TEST_CASE("Telemetry files round-trip through the drain", "[telemetry]")
+{
+    const auto ring = std::make_unique<TickTelemetryRing>();
+    for (std::uint64_t k = 1; k <= 40; ++k)
+    {
+        TickTelemetryRecord rec{};
+        rec.tick = k;
+        rec.seqno = k + 100;
+        rec.row_status[5] = RowStatus::kModelError;
+        REQUIRE(ring->push(rec));
+    }
+
+    std::FILE* f = std::tmpfile();
+    REQUIRE(f != nullptr);
+    REQUIRE(write_tick_telemetry_header(f));
+    REQUIRE(drain_tick_telemetry(*ring, f) == 40u);
+    REQUIRE(ring->size() == 0u);
+    std::rewind(f);
+
+    TickTelemetryFileHeader hdr{};
+    REQUIRE(read_tick_telemetry_header(f, hdr));
+    REQUIRE(hdr.ns_per_tick > 0.0);
+    std::vector<TickTelemetryRecord> recs(64);
+    REQUIRE(read_tick_telemetry(f, Span<TickTelemetryRecord>{recs.data(), recs.size()}) == 40u);
+    REQUIRE(recs[0].tick == 1u);
+    REQUIRE(recs[39].seqno == 140u);
+    REQUIRE(recs[39].row_status[5] == RowStatus::kModelError);
+
+    // A file from a different layout is rejected.
+    std::rewind(f);
+    hdr.record_bytes += 8u;
+    REQUIRE(std::fwrite(&hdr, sizeof(hdr), 1, f) == 1u);
+    std::rewind(f);
+    REQUIRE_FALSE(read_tick_telemetry_header(f, hdr));
+    std::fclose(f);
+}
+
+TEST_CASE("Shared-memory telemetry logs keep the newest records", "[telemetry][shm]")
+{
+    const char* name = "/bullseye_pred_test_telemetry";
+    TickTelemetryShmWriter writer;
+    REQUIRE(writer.create(name, 1000) == ShmCode::kResizeFailed); // not a power of two
+    REQUIRE(writer.create(name, 64) == ShmCode::kOk);
+
+    TickTelemetryShmReader reader;
+    REQUIRE(reader.open(name) == ShmCode::kOk);
+    std::vector<TickTelemetryRecord> out(128);
+    std::uint64_t next = 0;
+    REQUIRE(reader.copy_since(&next, Span<TickTelemetryRecord>{out.data(), out.size()}) == 0u);
+
+    const auto ring = std::make_unique<TickTelemetryRing>();
+    std::uint64_t tick = 0;
+    const auto fill = [&](std::size_t n)
+    {
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            TickTelemetryRecord rec{};
+            rec.tick = ++tick;
+            REQUIRE(ring->push(rec));
+        }
+        return drain_tick_telemetry(*ring, writer);
+    };
+
+    REQUIRE(fill(10) == 10u);
+    REQUIRE(reader.copy_since(&next, Span<TickTelemetryRecord>{out.data(), out.size()}) == 10u);
+    REQUIRE(out[9].tick == 10u);
+    REQUIRE(next == 10u);
+
+    // A reader that falls more than a capacity behind skips the overwritten records.
+    REQUIRE(fill(100) == 100u);
+    REQUIRE(reader.written() == 110u);
+    const std::size_t n =
+        reader.copy_since(&next, Span<TickTelemetryRecord>{out.data(), out.size()});
+    REQUIRE(n == 63u);
+    REQUIRE(out[0].tick == 48u);
+    REQUIRE(out[n - 1].tick == 110u);
+    REQUIRE(next == 110u);
+
+    writer.close();
+    REQUIRE(reader.open(name) != ShmCode::kOk);
+}
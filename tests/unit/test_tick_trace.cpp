@@ -0,0 +1,220 @@
+// tests/unit/test_tick_trace.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "core/bullseye_frame.hpp"
+#include "core/provider_twobody.hpp"
+#include "core/provider_twobody_fleet.hpp"
+#include "core/publisher.hpp"
+#include "core/relative_predictor.hpp"
+#include "core/tick_trace.hpp"
+#include "core/vehicle_index_map.hpp"
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+std::vector<TraceRecord> collect_all()
+{
+    std::vector<TraceRecord> out(kMaxTraceThreads * TraceRing::kCapacity);
+    const std::size_t n = collect_trace_events(Span<TraceRecord>{out.data(), out.size()});
+    out.resize(n);
+    return out;
+}
+
+std::size_t count_stage(const std::vector<TraceRecord>& recs, TraceStage s)
+{
+    std::size_t n = 0;
+    for (const TraceRecord& r : recs)
+    {
+        n += (r.event.stage == s) ? 1u : 0u;
+    }
+    return n;
+}
+
+} // namespace
+
+TEST_CASE("Trace scopes record into the calling thread's ring", "[trace]")
+{
+    clear_trace_events();
+    {
+        TraceScope outer(TraceStage::kTick);
+        TraceScope row(TraceStage::kVehicle, 7);
+        row.end();
+        row.end(); // recorded once
+    }
+    std::uint32_t main_thread = 0;
+    {
+        const std::vector<TraceRecord> recs = collect_all();
+        REQUIRE(recs.size() == 2u);
+        REQUIRE(recs[0].event.stage == TraceStage::kVehicle);
+        REQUIRE(recs[0].event.vehicle == 7u);
+        REQUIRE(recs[1].event.stage == TraceStage::kTick);
+        REQUIRE(recs[1].event.vehicle == kTraceNoVehicle);
+        REQUIRE(recs[1].event.begin <= recs[0].event.begin);
+        REQUIRE(recs[0].event.end <= recs[1].event.end);
+        main_thread = recs[0].thread;
+    }
+
+    // Another thread writes its own ring.
+    std::thread([]() { TraceScope s(TraceStage::kPublish); }).join();
+    const std::vector<TraceRecord> recs = collect_all();
+    REQUIRE(recs.size() == 3u);
+    REQUIRE(count_stage(recs, TraceStage::kPublish) == 1u);
+    for (const TraceRecord& r : recs)
+    {
+        REQUIRE((r.event.stage == TraceStage::kPublish) == (r.thread != main_thread));
+    }
+}
+
+TEST_CASE("A full trace ring keeps the newest events", "[trace]")
+{
+    clear_trace_events();
+    const std::uint64_t lost_before = trace_events_overwritten();
+    const std::size_t extra = 100;
+    for (std::size_t k = 0; k < TraceRing::kCapacity + extra; ++k)
+    {
+        record_trace_event(TraceEvent{k, k + 1, static_cast<std::uint32_t>(k), TraceStage::kModel});
+    }
+    REQUIRE(trace_events_overwritten() == lost_before + extra);
+
+    TraceRing* ring = this_thread_trace_ring();
+    REQUIRE(ring != nullptr);
+    std::vector<TraceEvent> events(TraceRing::kCapacity);
+    REQUIRE(ring->copy_to(Span<TraceEvent>{events.data(), events.size()}) ==
+            TraceRing::kCapacity);
+    REQUIRE(events.front().vehicle == extra);
+    REQUIRE(events.back().vehicle == TraceRing::kCapacity + extra - 1);
+
+    // A short output keeps the newest events.
+    TraceEvent last[2]{};
+    REQUIRE(ring->copy_to(Span<TraceEvent>{last, 2}) == 2u);
+    REQUIRE(last[1].vehicle == TraceRing::kCapacity + extra - 1);
+    clear_trace_events();
+}
+
+TEST_CASE("Chrome trace export writes complete events in microseconds", "[trace]")
+{
+    const TraceRecord recs[] = {
+        TraceRecord{TraceEvent{1000, 3000, kTraceNoVehicle, TraceStage::kTick}, 0},
+        TraceRecord{TraceEvent{1500, 2000, 4, TraceStage::kVehicle}, 1},
+    };
+    std::FILE* f = std::tmpfile();
+    REQUIRE(f != nullptr);
+    REQUIRE(write_chrome_trace(f, Span<const TraceRecord>{recs, 2}, 2.0));
+    std::rewind(f);
+    std::string json;
+    char buf[256];
+    while (std::fgets(buf, sizeof(buf), f) != nullptr)
+    {
+        json += buf;
+    }
+    std::fclose(f);
+
+    REQUIRE(json.find("\"traceEvents\":[") != std::string::npos);
+    REQUIRE(json.find("{\"name\":\"tick\",\"cat\":\"bullseye\",\"ph\":\"X\",\"pid\":1,\"tid\":0,"
+                      "\"ts\":0.000,\"dur\":4.000}") != std::string::npos);
+    REQUIRE(json.find("{\"name\":\"vehicle\",\"cat\":\"bullseye\",\"ph\":\"X\",\"pid\":1,"
+                      "\"tid\":1,\"ts\":1.000,\"dur\":1.000,\"args\":{\"vehicle\":4}}") !=
+            std::string::npos);
+    REQUIRE(json.substr(json.size() - 4) == "\n]}\n");
+}
+
+TEST_CASE("Latency histogram percentiles stay within the bucket precision", "[trace]")
+{
+    const auto h = std::make_unique<LatencyHistogram>();
+    REQUIRE(h->value_at_percentile(50.0) == 0u);
+
+    // 1..100000 ns uniformly: p-th percentile ~ p * 1000.
+    for (std::uint64_t v = 1; v <= 100000; ++v)
+    {
+        h->record(v);
+    }
+    REQUIRE(h->count() == 100000u);
+    REQUIRE(h->min() == 1u);
+    REQUIRE(h->max() == 100000u);
+    REQUIRE(h->mean() == 50000.5);
+    const double tol = 1.0 / static_cast<double>(LatencyHistogram::kSubBuckets);
+    for (const double p : {1.0, 50.0, 90.0, 99.0, 99.9})
+    {
+        const double want = p * 1000.0;
+        const auto got = static_cast<double>(h->value_at_percentile(p));
+        REQUIRE(got >= want);
+        REQUIRE(got <= want * (1.0 + tol));
+    }
+    REQUIRE(h->value_at_percentile(100.0) == 100000u);
+
+    // Small values are exact; huge ones do not overflow the table.
+    h->reset();
+    h->record(3);
+    h->record(~std::uint64_t{0});
+    REQUIRE(h->value_at_percentile(50.0) == 3u);
+    REQUIRE(h->value_at_percentile(100.0) == ~std::uint64_t{0});
+
+    // Stage histograms bin durations by stage.
+    const auto stages = std::make_unique<TraceStageHistograms>();
+    const TraceRecord recs[] = {
+        TraceRecord{TraceEvent{0, 10, kTraceNoVehicle, TraceStage::kChief}, 0},
+        TraceRecord{TraceEvent{5, 25, kTraceNoVehicle, TraceStage::kChief}, 0},
+        TraceRecord{TraceEvent{0, 7, 2, TraceStage::kVehicle}, 0},
+    };
+    stages->add(Span<const TraceRecord>{recs, 3}, 1.0);
+    REQUIRE(stages->stage(TraceStage::kChief).count() == 2u);
+    REQUIRE(stages->stage(TraceStage::kChief).max() == 20u);
+    REQUIRE(stages->stage(TraceStage::kVehicle).min() == 7u);
+    REQUIRE(stages->stage(TraceStage::kPublish).count() == 0u);
+}
+
+TEST_CASE("Predictor trace points follow BULLSEYE_ENABLE_TRACING", "[trace][predictor]")
+{
+    constexpr double kMu = 3.986004418e14;
+    const Vec3 r0{6878e3, 0.0, 0.0};
+    const Vec3 v0{0.0, 7612.0, 10.0};
+    VehicleIndexMap map(4);
+    TwoBodyChiefProvider chief("INERTIAL", kMu, 0.0, r0, v0);
+    TwoBodyVehicleProvider deputies("INERTIAL", kMu);
+    for (VehicleIndexMap::VehicleId id = 1; id <= 3; ++id)
+    {
+        const double k = static_cast<double>(id);
+        REQUIRE(deputies.add_vehicle(id, 0.0, r0 + Vec3{30.0 * k, -50.0 * k, k}, v0));
+        REQUIRE(map.register_vehicle(id).has_value());
+    }
+    BullseyeFrame bullseye(chief, nullptr, BullseyeFrameMode::kConstructedOnly);
+    const auto pub = std::make_unique<Publisher>();
+    const auto pred =
+        std::make_unique<HcwRelativePredictor>(*pub, map, chief, deputies, bullseye);
+
+    clear_trace_events();
+    pred->step(0.0, 60.0, 1.0);
+    pred->step(1.0, 60.0, 1.0);
+    REQUIRE(pub->read().valid_rows == 0x7u);
+    const std::vector<TraceRecord> recs = collect_all();
+
+    if constexpr (kTracingEnabled)
+    {
+        for (const TraceStage s : {TraceStage::kTick, TraceStage::kChief, TraceStage::kFrame,
+                                   TraceStage::kModelSetup, TraceStage::kDeputies,
+                                   TraceStage::kModel, TraceStage::kApproach,
+                                   TraceStage::kPublish})
+        {
+            REQUIRE(count_stage(recs, s) == 2u);
+        }
+        REQUIRE(count_stage(recs, TraceStage::kVehicle) == 6u);
+        REQUIRE(count_stage(recs, TraceStage::kValidate) == 0u); // constructed frame
+        REQUIRE(count_stage(recs, TraceStage::kInertial) == 0u); // no inertial plane
+    }
+    else
+    {
+        REQUIRE(std::is_empty_v<StageTrace>);
+        REQUIRE(recs.empty());
+    }
+}
@@ -6,6 +6,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include "core/time_grid.hpp"
 
+#include <vector>
+
 using namespace bullseye_pred;
 
 TEST_CASE("Time grid includes t0 and respects horizon")
@@ -36,3 +38,95 @@ TEST_CASE("Time grid never exceeds horizon (tricky FP)")
     REQUIRE(grid.tau.front() == 0.0);
     REQUIRE(grid.tau.back() <= horizon);
 }
+
+TEST_CASE("Uniform cadence is detected for generated grids only")
+{
+    double cadence = -1.0;
+
+    const auto grid = make_time_grid(60.0, 0.1);
+    REQUIRE(uniform_cadence(grid, cadence));
+    REQUIRE(cadence == 0.1);
+
+    TimeGrid custom;
+    custom.tau = {0.0, 1.0, 2.0, 3.5};
+    cadence = -1.0;
+    REQUIRE_FALSE(uniform_cadence(custom, cadence));
+    REQUIRE(cadence == -1.0);
+
+    TimeGrid single;
+    single.tau = {0.0};
+    REQUIRE_FALSE(uniform_cadence(single, cadence));
+}
+
+TEST_CASE("Time grid cache rebuilds only when horizon or cadence change")
+{
+    TimeGridCache cache{600};
+
+    const TimeGrid& a = cache.get(60.0, 0.5);
+    REQUIRE(cache.rebuilds() == 1);
+    REQUIRE(a.tau == make_time_grid(60.0, 0.5).tau);
+    const double* const storage = a.tau.data();
+
+    // Same inputs: no rebuild, same storage.
+    const TimeGrid& b = cache.get(60.0, 0.5);
+    REQUIRE(cache.rebuilds() == 1);
+    REQUIRE(&b == &a);
+    REQUIRE(b.tau.data() == storage);
+
+    // Changed cadence: rebuilt into the reserved capacity (no reallocation).
+    const TimeGrid& c = cache.get(30.0, 0.1);
+    REQUIRE(cache.rebuilds() == 2);
+    REQUIRE(c.tau == make_time_grid(30.0, 0.1).tau);
+    REQUIRE(c.tau.data() == storage);
+
+    // Invalid inputs yield an empty grid (and are memoized as such).
+    REQUIRE(cache.get(60.0, 0.0).tau.empty());
+    REQUIRE(cache.get(60.0, 0.0).tau.empty());
+    REQUIRE(cache.rebuilds() == 3);
+    REQUIRE(cache.get(10.0, 2.0).tau.size() == 6);
+}
+
+TEST_CASE("Piecewise time grid samples each segment at its own cadence")
+{
+    const TimeGridSegment segs[] = {{60.0, 0.5}, {600.0, 5.0}, {5400.0, 30.0}};
+    const TimeGrid grid = make_piecewise_time_grid(segs, 3);
+
+    // 1 + 120 + 108 + 160 samples: a 90-minute horizon in fewer than MAX_STEPS samples.
+    REQUIRE(grid.tau.size() == 389);
+    REQUIRE(grid.tau.front() == 0.0);
+    REQUIRE(grid.tau[120] == 60.0);
+    REQUIRE(grid.tau[121] == 65.0);
+    REQUIRE(grid.tau[228] == 600.0);
+    REQUIRE(grid.tau[229] == 630.0);
+    REQUIRE(grid.tau.back() == 5400.0);
+    for (std::size_t k = 1; k < grid.tau.size(); ++k)
+    {
+        REQUIRE(grid.tau[k] > grid.tau[k - 1]);
+    }
+
+    double cadence = 0.0;
+    REQUIRE_FALSE(uniform_cadence(grid, cadence));
+
+    // A single segment is exactly the uniform grid.
+    const TimeGridSegment one[] = {{10.0, 2.0}};
+    REQUIRE(make_piecewise_time_grid(one, 1).tau == make_time_grid(10.0, 2.0).tau);
+
+    // A segment whose cadence does not divide its length stops short of the boundary.
+    const TimeGridSegment uneven[] = {{10.0, 3.0}, {20.0, 5.0}};
+    const std::pmr::vector<double> expected{0.0, 3.0, 6.0, 9.0, 15.0, 20.0};
+    REQUIRE(make_piecewise_time_grid(uneven, 2).tau == expected);
+}
+
+TEST_CASE("Piecewise time grid rejects invalid segments")
+{
+    const TimeGridSegment decreasing[] = {{60.0, 1.0}, {30.0, 1.0}};
+    REQUIRE(make_piecewise_time_grid(decreasing, 2).tau.empty());
+
+    const TimeGridSegment zero_cadence[] = {{60.0, 0.0}};
+    REQUIRE(make_piecewise_time_grid(zero_cadence, 1).tau.empty());
+
+    const TimeGridSegment zero_end[] = {{0.0, 1.0}};
+    REQUIRE(make_piecewise_time_grid(zero_end, 1).tau.empty());
+
+    REQUIRE(make_piecewise_time_grid(nullptr, 0).tau.empty());
+}
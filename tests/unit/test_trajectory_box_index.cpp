@@ -0,0 +1,173 @@
+/**
+ * @file test_trajectory_box_index.cpp
+ * @brief Unit tests for the time-segment bounding-box index.
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include "core/trajectory_box_index.hpp"
+#include "test_capacity.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace bullseye_pred;
+
+namespace
+{
+
+// Snapshot with rows 0..7 on straight lines (row 5 invalid), t0 = 100, 1 s grid, up to 300 s.
+std::unique_ptr<PredictionBuffer> make_snapshot()
+{
+    auto buf = std::make_unique<PredictionBuffer>();
+    buf->seqno = 7;
+    buf->t0 = 100.0;
+    buf->steps = std::min<std::size_t>(301u, MAX_STEPS);
+    for (std::size_t k = 0; k < buf->steps; ++k)
+    {
+        buf->tau[k] = static_cast<double>(k);
+    }
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        const double s = static_cast<double>(i);
+        const Vec3 p0{-1500.0 + 400.0 * s, 200.0 * s - 700.0, 30.0 * s};
+        const Vec3 u{10.0 - 2.5 * s, 1.5 * s - 4.0, 0.25 * s - 1.0};
+        for (std::size_t k = 0; k < buf->steps; ++k)
+        {
+            buf->positions[i][k] = p0 + u * buf->tau[k];
+        }
+        buf->row_t0[i] = buf->t0;
+        if (i != 5)
+        {
+            buf->valid_rows |= RowMask{1} << i;
+        }
+    }
+    return buf;
+}
+
+// Full scan of every leaf segment (sample hulls, no velocities).
+std::vector<TrajectorySegmentHit> scan(const PredictionBuffer& buf,
+                                       const AabbRegion& q,
+                                       double t_begin,
+                                       double t_end)
+{
+    std::vector<TrajectorySegmentHit> hits;
+    const std::size_t L = TrajectoryBoxIndex::kLeafSteps;
+    for (std::size_t i = 0; i < MAX_VEHICLES; ++i)
+    {
+        if (!buf.row_valid(i))
+        {
+            continue;
+        }
+        for (std::size_t k0 = 0; k0 + 1 < buf.steps; k0 += L)
+        {
+            const std::size_t k1 = std::min(k0 + L, buf.steps - 1);
+            Vec3 lo = buf.positions[i][k0];
+            Vec3 hi = lo;
+            for (std::size_t k = k0; k <= k1; ++k)
+            {
+                const Vec3& p = buf.positions[i][k];
+                lo = Vec3{std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z)};
+                hi = Vec3{std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z)};
+            }
+            const double tb = buf.row_t0[i] + buf.tau[k0];
+            const double te = buf.row_t0[i] + buf.tau[k1];
+            if (tb <= t_end && t_begin <= te && lo.x <= q.hi.x && q.lo.x <= hi.x &&
+                lo.y <= q.hi.y && q.lo.y <= hi.y && lo.z <= q.hi.z && q.lo.z <= hi.z)
+            {
+                hits.push_back(TrajectorySegmentHit{static_cast<std::uint32_t>(i),
+                                                    static_cast<std::uint32_t>(k0),
+                                                    static_cast<std::uint32_t>(k1), tb, te});
+            }
+        }
+    }
+    return hits;
+}
+
+} // namespace
+
+TEST_CASE("Box index queries return exactly the segments a full scan finds", "[box_index]")
+{
+    BULLSEYE_SKIP_BELOW_CAPACITY(8u, 2u);
+    const auto buf = make_snapshot();
+    const auto index = std::make_unique<TrajectoryBoxIndex>();
+    index->build(*buf);
+    REQUIRE(index->seqno() == 7u);
+    REQUIRE(index->rows() == (0xFFu & ~(RowMask{1} << 5)));
+
+    std::uint64_t s = 99u;
+    auto next = [&s]()
+    {
+        s = s * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<double>(s >> 11) * (1.0 / 9007199254740992.0);
+    };
+    std::size_t total = 0;
+    for (int q = 0; q < 200; ++q)
+    {
+        const Vec3 c{4000.0 * next() - 2000.0, 4000.0 * next() - 2000.0, 400.0 * next() - 200.0};
+        const double half = 20.0 + 300.0 * next();
+        const AabbRegion region{c - Vec3{half, half, half}, c + Vec3{half, half, half}};
+        const double tb = 80.0 + 320.0 * next();
+        const double te = tb + 150.0 * next();
+
+        const std::vector<TrajectorySegmentHit> want = scan(*buf, region, tb, te);
+        std::vector<TrajectorySegmentHit> got(want.size() + 4);
+        REQUIRE(index->query(region, tb, te,
+                             Span<TrajectorySegmentHit>{got.data(), got.size()}) == want.size());
+        RowMask rows = 0;
+        for (std::size_t h = 0; h < want.size(); ++h)
+        {
+            REQUIRE(got[h].row == want[h].row);
+            REQUIRE(got[h].k_begin == want[h].k_begin);
+            REQUIRE(got[h].k_end == want[h].k_end);
+            REQUIRE(got[h].t_begin == want[h].t_begin);
+            REQUIRE(got[h].t_end == want[h].t_end);
+            rows |= RowMask{1} << want[h].row;
+        }
+        REQUIRE(index->rows_in(region, tb, te) == rows);
+        total += want.size();
+    }
+    REQUIRE(total > 0u);
+
+    // A short output span still reports the total.
+    const AabbRegion all{Vec3{-1e9, -1e9, -1e9}, Vec3{1e9, 1e9, 1e9}};
+    TrajectorySegmentHit one[1]{};
+    const std::size_t segments = (buf->steps - 2u) / TrajectoryBoxIndex::kLeafSteps + 1u;
+    REQUIRE(index->query(all, 0.0, 1e9, Span<TrajectorySegmentHit>{one, 1}) == 7u * segments);
+    REQUIRE(one[0].row == 0u);
+    REQUIRE(one[0].k_begin == 0u);
+}
+
+TEST_CASE("Box index covers the Hermite interpolant between samples", "[box_index]")
+{
+    // Circular arc about the origin sampled every 18 degrees, straddling the top of the circle
+    // (81 and 99 degrees): the arc rises ~12 m above the samples' box there.
+    const auto buf = std::make_unique<PredictionBuffer>();
+    TrajectoryPlane velocities{};
+    buf->velocities = &velocities;
+    buf->steps = 11;
+    const double R = 1000.0;
+    const double w = 2.0 * 3.14159265358979 / 1200.0;
+    for (std::size_t k = 0; k < buf->steps; ++k)
+    {
+        const double t = 60.0 * static_cast<double>(k);
+        buf->tau[k] = t;
+        const double a = w * (t + 30.0);
+        buf->positions[0][k] = Vec3{R * std::cos(a), R * std::sin(a), 0.0};
+        velocities[0][k] = Vec3{-R * w * std::sin(a), R * w * std::cos(a), 0.0};
+    }
+    buf->valid_rows = 1u;
+
+    const SphereRegion sphere{Vec3{0.0, R, 0.0}, 1.0}; // reached at t = 270 s
+    const auto index = std::make_unique<TrajectoryBoxIndex>();
+    index->build(*buf);
+    REQUIRE(index->rows_in(sphere, 0.0, 600.0) == 1u);
+    REQUIRE(index->rows_in(sphere, 500.0, 600.0) == 0u); // later segment only
+
+    // Without velocities only the sample hull is covered.
+    buf->velocities = nullptr;
+    index->build(*buf);
+    REQUIRE(index->rows_in(sphere, 0.0, 600.0) == 0u);
+}
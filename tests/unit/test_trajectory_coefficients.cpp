@@ -0,0 +1,195 @@
+// tests/unit/test_trajectory_coefficients.cpp
+
+#include <cmath>
+#include <vector>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/relative_predictor.hpp"
+#include "core/time_grid.hpp"
+#include "core/trajectory_coefficients.hpp"
+#include "core/vehicle_index_map.hpp"
+#include "models/model_hcw.hpp"
+#include "models/model_ss_j2.hpp"
+#include "predictor_rig.hpp"
+
+using namespace bullseye_pred;
+using bullseye_pred::testing::Rig;
+using bullseye_pred::testing::RigOptions;
+
+namespace
+{
+
+constexpr double kMu = 3.986004418e14;
+constexpr double kR0 = 6878e3;
+
+void require_near(const Vec3& a, const Vec3& b, double tol)
+{
+    CHECK(a.x == Catch::Approx(b.x).margin(tol));
+    CHECK(a.y == Catch::Approx(b.y).margin(tol));
+    CHECK(a.z == Catch::Approx(b.z).margin(tol));
+}
+
+// Inclined chief so SS-J2 has a non-trivial reference orbit.
+RigOptions inclined_rig()
+{
+    RigOptions opt;
+    opt.chief_radius_m = kR0;
+    opt.chief_inclination_rad = 0.9;
+    return opt;
+}
+
+// Deputy id at the chief plus (75, -75, 22.5) m * id, (0, 0.02, -0.001 * id) m/s.
+template <typename Predictor>
+void place_deputies(Rig<Predictor>& rig)
+{
+    rig.veh.dr_per_id = Vec3{75.0, -75.0, 22.5};
+    rig.veh.dv = Vec3{0.0, 0.02, 0.0};
+    rig.veh.dv_per_id = Vec3{0.0, 0.0, -0.001};
+}
+
+} // namespace
+
+TEST_CASE("Coefficient evaluator reproduces the HCW and SS-J2 models", "[coefficients]")
+{
+    TimeGrid grid;
+    grid.tau.resize(121);
+    for (std::size_t k = 0; k < grid.tau.size(); ++k)
+    {
+        grid.tau[k] = 15.0 * static_cast<double>(k);
+    }
+    const std::size_t steps = grid.tau.size();
+    const RelStateRic x0{Vec3{120.0, -40.0, 15.0}, Vec3{0.01, -0.25, 0.03}};
+    const double n = std::sqrt(kMu / (kR0 * kR0 * kR0));
+
+    TrajectoryCoefficients hcw_c{};
+    hcw_c.model = PredictorModel::kHcw;
+    hcw_c.x0 = x0;
+    hcw_c.n_radps = n;
+    HcwParams hp{};
+    hp.n_radps = n;
+    std::vector<Vec3> r(steps);
+    std::vector<Vec3> v(steps);
+    REQUIRE(ModelHCW{}
+                .predict_hcw(x0, hp, grid, Span<Vec3>{r.data(), steps}, Span<Vec3>{v.data(), steps})
+                .code == ModelCode::kOk);
+    std::vector<Vec3> er(steps);
+    std::vector<Vec3> ev(steps);
+    REQUIRE(evaluate_coefficients(hcw_c, Span<const double>{grid.tau.data(), steps},
+                                  Span<Vec3>{er.data(), steps},
+                                  Span<Vec3>{ev.data(), steps}) == steps);
+    for (std::size_t k = 0; k < steps; ++k)
+    {
+        require_near(er[k], r[k], 1e-9);
+        require_near(ev[k], v[k], 1e-12);
+    }
+
+    SsJ2Params sp{};
+    sp.n_radps = n;
+    sp.r_ref_m = kR0;
+    sp.inc_rad = 0.9;
+    sp.j2 = 1.08262668e-3;
+    sp.r_eq_m = 6378137.0;
+    TrajectoryCoefficients ss_c{};
+    ss_c.model = PredictorModel::kSsJ2;
+    ss_c.x0 = x0;
+    REQUIRE(ss_j2_rates(sp, ss_c.rates));
+    REQUIRE(ModelSS_J2{}
+                .predict_ss(x0, sp, grid, Span<Vec3>{r.data(), steps}, Span<Vec3>{})
+                .code == ModelCode::kOk);
+    for (std::size_t k = 0; k < steps; k += 7)
+    {
+        Vec3 at{};
+        REQUIRE(evaluate_coefficients(ss_c, grid.tau[k], at, nullptr));
+        require_near(at, r[k], 1e-9);
+    }
+
+    // A burn splits the trajectory: before it nothing changes, after it the kick is added.
+    ss_c.burn_count = 1;
+    ss_c.burns[0] = CoefficientBurn{100.0, Vec3{0.0, 0.05, 0.0}};
+    Vec3 before{};
+    Vec3 after{};
+    REQUIRE(evaluate_coefficients(ss_c, 90.0, before, nullptr));
+    REQUIRE(evaluate_coefficients(ss_c, 400.0, after, nullptr));
+    Vec3 coast{};
+    Vec3 unused{};
+    ss_j2_stm_apply(ss_j2_stm_at(ss_c.rates, 90.0), x0, false, coast, unused);
+    CHECK(before.x == coast.x);
+    ss_j2_stm_apply(ss_j2_stm_at(ss_c.rates, 400.0), x0, false, coast, unused);
+    CHECK(after.y != coast.y);
+
+    TrajectoryCoefficients bad = hcw_c;
+    bad.model = PredictorModel::kYaStm;
+    Vec3 kept{1.0, 2.0, 3.0};
+    CHECK_FALSE(evaluate_coefficients(bad, 10.0, kept, nullptr));
+    CHECK(kept.x == 1.0);
+}
+
+TEST_CASE("Predictor publishes coefficients alongside or instead of samples", "[coefficients]")
+{
+    static Rig<HcwRelativePredictor> dense(inclined_rig());
+    static Rig<HcwRelativePredictor> sparse(inclined_rig());
+    place_deputies(dense);
+    place_deputies(sparse);
+    dense.pred.configure_coefficients(CoefficientOutput::kWithSamples);
+    sparse.pred.configure_coefficients(CoefficientOutput::kOnly);
+    ApproachSummaryConfig approach{};
+    approach.enabled = true;
+    sparse.pred.configure_approach_summary(approach);
+    const ImpulsiveBurn burn{50.0 + 123.0, Vec3{0.02, 0.0, -0.01}};
+    REQUIRE(dense.pred.set_planned_burns(2u, Span<const ImpulsiveBurn>{&burn, 1}));
+    REQUIRE(sparse.pred.set_planned_burns(2u, Span<const ImpulsiveBurn>{&burn, 1}));
+
+    dense.pred.step(50.0, 600.0, 10.0);
+    sparse.pred.step(50.0, 600.0, 10.0);
+    const PredictionBuffer& d = dense.pub.read();
+    const PredictionBuffer& s = sparse.pub.read();
+    REQUIRE(d.valid_rows == 0x3u);
+    REQUIRE(d.coeff_rows == 0x3u);
+    CHECK(d.coeff_only_rows == 0u);
+    REQUIRE(s.valid_rows == 0x3u);
+    REQUIRE(s.coeff_rows == 0x3u);
+    CHECK(s.coeff_only_rows == 0x3u);
+    CHECK(s.maneuver_rows == 0x2u);
+    CHECK(s.coefficients[1].burn_count == 1u);
+    CHECK(s.coefficients[1].burns[0].tau == 123.0);
+    CHECK_FALSE(s.approach[0].valid);
+
+    // Coefficients evaluated on the grid match the dense samples (burn included).
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        for (std::size_t k = 0; k < d.steps; ++k)
+        {
+            Vec3 a{};
+            Vec3 b{};
+            REQUIRE(evaluate_coefficients(d.coefficients[i], d.tau[k], a, nullptr));
+            REQUIRE(evaluate_coefficients(s.coefficients[i], d.tau[k], b, nullptr));
+            require_near(a, d.positions[i][k], 1e-6);
+            CHECK(b.x == a.x);
+            CHECK(b.y == a.y);
+        }
+    }
+
+    // Back to dense: rows published as coefficients are not reused as samples.
+    TrajectoryReuseConfig reuse{};
+    reuse.enabled = true;
+    sparse.pred.configure_reuse(reuse);
+    sparse.pred.configure_coefficients(CoefficientOutput::kOff);
+    sparse.pred.step(60.0, 600.0, 10.0);
+    CHECK(sparse.pred.reuse_stats().rows_reused == 0u);
+    CHECK(sparse.pub.read().coeff_rows == 0u);
+    CHECK(sparse.pub.read().approach[0].valid);
+}
+
+TEST_CASE("Models without a closed form stay dense", "[coefficients]")
+{
+    static Rig<YaRelativePredictor> rig(inclined_rig());
+    place_deputies(rig);
+    rig.pred.configure_coefficients(CoefficientOutput::kOnly);
+    rig.pred.step(0.0, 300.0, 10.0);
+    const PredictionBuffer& snap = rig.pub.read();
+    REQUIRE(snap.valid_rows == 0x3u);
+    CHECK(snap.coeff_rows == 0u);
+    CHECK(snap.coeff_only_rows == 0u);
+}
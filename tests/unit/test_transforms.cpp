@@ -5,6 +5,9 @@
 
 #include "core/bullseye_frame_math.hpp"
 #include "core/frame_transforms.hpp"
+#include "core/math/vec3a.hpp"
+
+#include <limits>
 
 using bullseye_pred::ChiefState;
 using bullseye_pred::Mat3;
@@ -48,3 +51,120 @@ TEST_CASE("Inertial<->RIC round-trip (Option B velocity)", "[transforms]")
     REQUIRE(back.v.y == Catch::Approx(dep_v_i.y).epsilon(1e-12));
     REQUIRE(back.v.z == Catch::Approx(dep_v_i.z).epsilon(1e-12));
 }
+
+TEST_CASE("Batched inertial->RIC matches the per-vehicle transform bitwise", "[transforms]")
+{
+    using bullseye_pred::RelStateRic;
+    using bullseye_pred::Span;
+
+    ChiefState chief{};
+    chief.r_i = Vec3{5000e3, -3000e3, 3500e3};
+    chief.v_i = Vec3{2.0e3, 6.0e3, 1.5e3};
+    chief.frame_id = "INERTIAL";
+    chief.status.code = ProviderCode::kOk;
+
+    const auto f = construct_ric_from_chief(chief);
+    REQUIRE(f.status.code == ProviderCode::kOk);
+    const Mat3 C_i2r = transpose(f.C_from_ric_to_inertial);
+
+    constexpr std::size_t kN = 13; // not a multiple of any vector width
+    Vec3 r[kN];
+    Vec3 v[kN];
+    for (std::size_t k = 0; k < kN; ++k)
+    {
+        const double s = static_cast<double>(k);
+        r[k] = chief.r_i + Vec3{10.0 * s - 40.0, 3.0 * s * s, -7.5 * s};
+        v[k] = chief.v_i + Vec3{0.01 * s, -0.2, 0.003 * s * s};
+    }
+
+    RelStateRic out[kN + 1]{};
+    out[kN].r_ric = Vec3{42.0, 42.0, 42.0};
+    bullseye_pred::inertial_to_ric_relative_batch(Span<const Vec3>{r, kN}, Span<const Vec3>{v, kN},
+                                                  chief.r_i, chief.v_i, C_i2r, f.omega_ric,
+                                                  Span<RelStateRic>{out, kN + 1});
+    for (std::size_t k = 0; k < kN; ++k)
+    {
+        const RelState ref =
+            inertial_to_ric_relative(r[k], v[k], chief.r_i, chief.v_i, C_i2r, f.omega_ric);
+        REQUIRE(out[k].r_ric.x == ref.r.x);
+        REQUIRE(out[k].r_ric.y == ref.r.y);
+        REQUIRE(out[k].r_ric.z == ref.r.z);
+        REQUIRE(out[k].v_ric.x == ref.v.x);
+        REQUIRE(out[k].v_ric.y == ref.v.y);
+        REQUIRE(out[k].v_ric.z == ref.v.z);
+    }
+    // Only min(sizes) entries are written.
+    REQUIRE(out[kN].r_ric.x == 42.0);
+}
+
+TEST_CASE("Aligned Vec3a/Mat3a products match the scalar math bitwise", "[transforms]")
+{
+    using bullseye_pred::Span;
+    namespace math = bullseye_pred::math;
+
+    ChiefState chief{};
+    chief.r_i = Vec3{6778137.0, 1234.5, -2.5e5};
+    chief.v_i = Vec3{-12.0, 7668.6, 410.2};
+    chief.frame_id = "INERTIAL";
+    const auto f = construct_ric_from_chief(chief);
+    REQUIRE(f.status.code == ProviderCode::kOk);
+    const Mat3& C = f.C_from_ric_to_inertial;
+    Mat3 B = C;
+    B(0, 1) = 0.3;
+    B(2, 2) = -1.7;
+
+    const Vec3 v{123.456, -7.89e3, 0.001};
+    const Vec3 w{-0.5, 2.25, 1e-3};
+    const math::Mat3a Ca(C);
+    const math::Vec3a va(v);
+
+    const Vec3 Cv = mul(C, v);
+    const Vec3 Ctv = mul(transpose(C), v);
+    const Vec3 m1 = math::mul(Ca, va).vec3();
+    const Vec3 m2 = math::mul_transpose(Ca, va).vec3();
+    const Vec3 m3 = math::mul(math::Mat3a::transposed(C), va).vec3();
+    const Vec3 m4 = bullseye_pred::mul_transpose(C, v);
+    REQUIRE((m1.x == Cv.x && m1.y == Cv.y && m1.z == Cv.z));
+    REQUIRE((m2.x == Ctv.x && m2.y == Ctv.y && m2.z == Ctv.z));
+    REQUIRE((m3.x == Ctv.x && m3.y == Ctv.y && m3.z == Ctv.z));
+    REQUIRE((m4.x == Ctv.x && m4.y == Ctv.y && m4.z == Ctv.z));
+
+    const Mat3 CtB = mul(transpose(C), B);
+    const Mat3 CtB2 = bullseye_pred::mul_transpose(C, B);
+    const Mat3 Cb = Ca.mat3();
+    for (int r = 0; r < 3; ++r)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            REQUIRE(CtB2(r, c) == CtB(r, c));
+            REQUIRE(Cb(r, c) == C(r, c));
+        }
+    }
+
+    REQUIRE(math::dot(va, math::Vec3a(w)) == dot(v, w));
+    const Vec3 cx = math::cross(va, math::Vec3a(w)).vec3();
+    const Vec3 cref = cross(v, w);
+    REQUIRE((cx.x == cref.x && cx.y == cref.y && cx.z == cref.z));
+
+    const Vec3 a[3] = {v, w, Cv};
+    const Vec3 b[3] = {w, Cv, v};
+    double d[3]{};
+    Vec3 x[3]{};
+    math::dot3(Span<const Vec3>{a, 3}, Span<const Vec3>{b, 3}, Span<double>{d, 3});
+    math::cross3(Span<const Vec3>{a, 3}, Span<const Vec3>{b, 3}, Span<Vec3>{x, 3});
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+        REQUIRE(d[k] == dot(a[k], b[k]));
+        REQUIRE(x[k].y == cross(a[k], b[k]).y);
+    }
+
+    REQUIRE(math::all_finite3(Span<const Vec3>{a, 3}));
+    REQUIRE(math::finite3(va));
+    REQUIRE(bullseye_pred::finite3(v));
+    Vec3 bad[3] = {v, w, v};
+    bad[1].z = std::numeric_limits<double>::infinity();
+    REQUIRE_FALSE(math::all_finite3(Span<const Vec3>{bad, 3}));
+    REQUIRE_FALSE(bullseye_pred::finite3(bad[1]));
+    bad[1].z = std::numeric_limits<double>::quiet_NaN();
+    REQUIRE_FALSE(math::finite3(math::Vec3a(bad[1])));
+}
@@ -1,6 +1,9 @@
 #include <catch2/catch_test_macros.hpp>
 #include "core/vehicle_index_map.hpp"
 
+#include <cstddef>
+#include <optional>
+
 using bullseye_pred::VehicleIndexMap;
 
 TEST_CASE("register_vehicle assigns stable indices in insertion order")
@@ -51,16 +54,139 @@ TEST_CASE("capacity enforcement: register_vehicle returns nullopt when full")
     VehicleIndexMap map;
 
     // Fill to capacity.
-    for (std::size_t i = 0; i < VehicleIndexMap::capacity(); ++i)
+    for (std::size_t i = 0; i < map.capacity(); ++i)
     {
         auto idx = map.register_vehicle(1000 + i);
         REQUIRE(idx.has_value());
         REQUIRE(*idx == i);
     }
 
-    REQUIRE(map.size() == VehicleIndexMap::capacity());
+    REQUIRE(map.size() == map.capacity());
 
     // Next insertion should fail.
     auto fail = map.register_vehicle(999999);
     REQUIRE_FALSE(fail.has_value());
 }
+
+TEST_CASE("unregister_vehicle frees the slot for deterministic reuse")
+{
+    VehicleIndexMap map;
+    for (VehicleIndexMap::VehicleId id = 10; id < 15; ++id)
+    {
+        REQUIRE(map.register_vehicle(id).has_value());
+    }
+
+    REQUIRE(map.unregister_vehicle(11) == std::optional<std::size_t>{1});
+    REQUIRE(map.unregister_vehicle(13) == std::optional<std::size_t>{3});
+    REQUIRE_FALSE(map.unregister_vehicle(13).has_value());
+    REQUIRE(map.size() == 3);
+    REQUIRE(map.slot_count() == 5);
+    REQUIRE_FALSE(map.id_at(1).has_value());
+    REQUIRE_FALSE(map.contains(11));
+    REQUIRE(map.index_of(14) == std::optional<std::size_t>{4});
+
+    // Lowest free index first; other indices unchanged.
+    REQUIRE(map.register_vehicle(99) == std::optional<std::size_t>{1});
+    REQUIRE(map.register_vehicle(98) == std::optional<std::size_t>{3});
+    REQUIRE(map.register_vehicle(97) == std::optional<std::size_t>{5});
+    REQUIRE(*map.id_at(3) == 98);
+
+    // Removing the highest slots shrinks slot_count().
+    REQUIRE(map.unregister_vehicle(97).has_value());
+    REQUIRE(map.unregister_vehicle(14).has_value());
+    REQUIRE(map.slot_count() == 4);
+}
+
+TEST_CASE("Large-capacity map keeps lookups consistent under churn")
+{
+    constexpr std::size_t kCap = 1000;
+    static VehicleIndexMap map(kCap);
+    REQUIRE(map.capacity() == kCap);
+
+    // Ids chosen to collide in low bits; remove every third and re-add under new ids.
+    for (std::size_t i = 0; i < kCap; ++i)
+    {
+        REQUIRE(map.register_vehicle(static_cast<VehicleIndexMap::VehicleId>(i) << 20) ==
+                std::optional<std::size_t>{i});
+    }
+    REQUIRE_FALSE(map.register_vehicle(1).has_value());
+    for (std::size_t i = 0; i < kCap; i += 3)
+    {
+        REQUIRE(map.unregister_vehicle(static_cast<VehicleIndexMap::VehicleId>(i) << 20) ==
+                std::optional<std::size_t>{i});
+    }
+    for (std::size_t i = 0; i < kCap; ++i)
+    {
+        const auto id = static_cast<VehicleIndexMap::VehicleId>(i) << 20;
+        REQUIRE(map.contains(id) == (i % 3 != 0));
+        if (i % 3 != 0)
+        {
+            REQUIRE(map.index_of(id) == std::optional<std::size_t>{i});
+        }
+    }
+    for (std::size_t i = 0; i < kCap; i += 3)
+    {
+        REQUIRE(map.register_vehicle(7'000'000 + i) == std::optional<std::size_t>{i});
+    }
+    REQUIRE(map.size() == kCap);
+    REQUIRE(map.index_of(7'000'000 + 999) == std::optional<std::size_t>{999});
+
+    map.clear();
+    REQUIRE(map.empty());
+    REQUIRE(map.slot_count() == 0);
+    REQUIRE(map.register_vehicle(5) == std::optional<std::size_t>{0});
+}
+
+TEST_CASE("copy_from reproduces ids, indices and free slots")
+{
+    VehicleIndexMap src(16);
+    for (VehicleIndexMap::VehicleId id = 10; id < 16; ++id)
+    {
+        REQUIRE(src.register_vehicle(id).has_value());
+    }
+    REQUIRE(src.unregister_vehicle(12).has_value());
+
+    VehicleIndexMap dst(16);
+    REQUIRE(dst.register_vehicle(99).has_value());
+    REQUIRE(dst.copy_from(src));
+    REQUIRE(dst.size() == src.size());
+    REQUIRE(dst.slot_count() == src.slot_count());
+    REQUIRE_FALSE(dst.contains(99));
+    REQUIRE_FALSE(dst.id_at(2).has_value());
+    REQUIRE(dst.index_of(15) == std::optional<std::size_t>{5});
+
+    // The copy is independent; the freed slot is reused as in the source.
+    REQUIRE(dst.register_vehicle(40) == std::optional<std::size_t>{2});
+    REQUIRE_FALSE(src.contains(40));
+
+    VehicleIndexMap other(8);
+    REQUIRE_FALSE(other.copy_from(src));
+    REQUIRE(other.empty());
+}
+
+TEST_CASE("grid profiles follow the vehicle and reset with its slot")
+{
+    VehicleIndexMap map(8);
+    REQUIRE(map.register_vehicle(1) == std::optional<std::size_t>{0});
+    REQUIRE(map.register_vehicle(2, 2) == std::optional<std::size_t>{1});
+    REQUIRE_FALSE(map.register_vehicle(3, bullseye_pred::MAX_GRID_PROFILES).has_value());
+    REQUIRE_FALSE(map.contains(3));
+
+    REQUIRE(map.grid_profile_at(0) == 0);
+    REQUIRE(map.grid_profile_at(1) == 2);
+    REQUIRE(map.set_grid_profile(1, 1));
+    REQUIRE(map.grid_profile_at(0) == 1);
+    REQUIRE_FALSE(map.set_grid_profile(1, bullseye_pred::MAX_GRID_PROFILES));
+    REQUIRE_FALSE(map.set_grid_profile(7, 1));
+    REQUIRE(map.grid_profile_at(5) == 0);
+
+    VehicleIndexMap copy(8);
+    REQUIRE(copy.copy_from(map));
+    REQUIRE(copy.grid_profile_at(1) == 2);
+
+    // A new vehicle in a freed slot starts on profile 0.
+    REQUIRE(map.unregister_vehicle(2).has_value());
+    REQUIRE(map.grid_profile_at(1) == 0);
+    REQUIRE(map.register_vehicle(9) == std::optional<std::size_t>{1});
+    REQUIRE(map.grid_profile_at(1) == 0);
+}
@@ -0,0 +1,60 @@
+// tests/unit/test_worker_pool.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#include "core/worker_pool.hpp"
+
+using bullseye_pred::WorkerPool;
+
+TEST_CASE("WorkerPool runs every task exactly once per run", "[pool]")
+{
+    WorkerPool pool(4);
+    REQUIRE(pool.workers() == 4);
+
+    std::array<std::atomic<int>, 257> hits{};
+    for (int round = 1; round <= 50; ++round)
+    {
+        auto task = [&hits](std::size_t k) noexcept
+        { hits[k].fetch_add(1, std::memory_order_relaxed); };
+        pool.run(hits.size(), task);
+        for (std::size_t k = 0; k < hits.size(); ++k)
+        {
+            REQUIRE(hits[k].load() == round);
+        }
+    }
+
+    // Plain writes of the tasks are visible once run() returns.
+    std::array<double, 64> out{};
+    auto square = [&out](std::size_t k) noexcept { out[k] = static_cast<double>(k * k); };
+    pool.run(out.size(), square);
+    for (std::size_t k = 0; k < out.size(); ++k)
+    {
+        REQUIRE(out[k] == static_cast<double>(k * k));
+    }
+}
+
+TEST_CASE("WorkerPool without workers runs tasks on the caller in order", "[pool]")
+{
+    WorkerPool pool(0);
+    REQUIRE(pool.workers() == 0);
+
+    std::array<std::size_t, 8> order{};
+    std::size_t n = 0;
+    auto task = [&order, &n](std::size_t k) noexcept { order[n++] = k; };
+    pool.run(order.size(), task);
+    REQUIRE(n == order.size());
+    for (std::size_t k = 0; k < order.size(); ++k)
+    {
+        REQUIRE(order[k] == k);
+    }
+
+    pool.run(0, task); // no tasks: no calls
+    REQUIRE(n == order.size());
+
+    WorkerPool clamped(WorkerPool::kMaxWorkers + 10);
+    REQUIRE(clamped.workers() <= WorkerPool::kMaxWorkers);
+}
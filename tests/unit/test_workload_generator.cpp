@@ -0,0 +1,118 @@
+// tests/unit/test_workload_generator.cpp
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/fleet_predictor.hpp"
+#include "core/workload_generator.hpp"
+
+using namespace bullseye_pred;
+
+TEST_CASE("Workload splits vehicles into formations by model mix", "[workload]")
+{
+    // Two full formations and a partial one, whatever the row capacity.
+    const std::size_t tail = (MAX_VEHICLES + 1u) / 2u;
+    WorkloadConfig c{};
+    c.vehicles = 2u * MAX_VEHICLES + tail;
+    c.horizon_sec = 60.0;
+    c.tick_hz = 0.0;
+    c.ticks = 3;
+    c.mix = WorkloadModelMix{1.0, 1.0, 1.0, 0.0};
+    WorkloadGenerator gen(c);
+    REQUIRE(gen.ok());
+    REQUIRE(gen.formation_count() == 3u);
+    REQUIRE(gen.formation_model(0) == WorkloadModel::kPlaceholder);
+    REQUIRE(gen.formation_model(1) == WorkloadModel::kHcw);
+    REQUIRE(gen.formation_model(2) == WorkloadModel::kYaStm);
+
+    const WorkloadReport rep = gen.run();
+    REQUIRE(rep.formations == 3u);
+    REQUIRE(rep.vehicles == c.vehicles);
+    REQUIRE(rep.ticks == 3u);
+    REQUIRE(rep.dropped_ticks == 0u);
+    REQUIRE(rep.published == 9u);
+    REQUIRE(rep.failed == 0u);
+    REQUIRE(rep.samples_per_sec > 0.0);
+    REQUIRE(rep.tick_p50_sec <= rep.tick_p99_sec);
+    REQUIRE(rep.tick_p99_sec <= rep.tick_max_sec);
+
+    // The last formation holds the remainder; later runs continue the clock.
+    REQUIRE(gen.publisher(2).read().valid_rows == (RowMask{1} << tail) - 1u);
+    REQUIRE(gen.publisher(1).read().t0 == 2.0);
+    (void)gen.run();
+    REQUIRE(gen.publisher(1).read().t0 == 5.0);
+}
+
+TEST_CASE("Workload injects deterministic provider failures", "[workload]")
+{
+    WorkloadConfig c{};
+    c.vehicles = 8;
+    c.horizon_sec = 30.0;
+    c.tick_hz = 0.0;
+    c.ticks = 4;
+
+    SECTION("chief always unavailable: no model formation publishes")
+    {
+        c.faults.chief_failure_rate = 1.0;
+        WorkloadGenerator gen(c);
+        REQUIRE(gen.ok());
+        const WorkloadReport rep = gen.run();
+        REQUIRE(rep.published == 0u);
+        REQUIRE(rep.failed == 4u);
+        REQUIRE(rep.chief_failures >= 4u);
+    }
+
+    SECTION("deputy failures repeat with the seed")
+    {
+        c.faults.deputy_failure_rate = 0.5;
+        WorkloadGenerator a(c);
+        WorkloadGenerator b(c);
+        REQUIRE(a.ok());
+        REQUIRE(b.ok());
+        const WorkloadReport ra = a.run();
+        const WorkloadReport rb = b.run();
+        REQUIRE(ra.deputy_failures > 0u);
+        REQUIRE(ra.deputy_failures == rb.deputy_failures);
+        REQUIRE(ra.chief_failures == 0u);
+    }
+}
+
+TEST_CASE("Workload readers lease snapshots while the publisher ticks", "[workload]")
+{
+    WorkloadConfig c{};
+    c.vehicles = 4;
+    c.horizon_sec = 60.0;
+    c.tick_hz = 200.0;
+    c.ticks = 40;
+    c.readers.count = 2;
+    c.readers.read_hz = 0.0;
+    WorkloadGenerator gen(c);
+    REQUIRE(gen.ok());
+
+    const WorkloadReport rep = gen.run();
+    REQUIRE(rep.ticks + rep.dropped_ticks == 40u);
+    REQUIRE(rep.published == rep.ticks);
+    REQUIRE(rep.reads > 0u);
+    REQUIRE(rep.torn_reads == 0u); // 3 slots: a held lease is never overwritten
+    REQUIRE(rep.wall_sec > 0.0);
+}
+
+TEST_CASE("Workload rejects invalid configurations", "[workload]")
+{
+    WorkloadConfig c{};
+    c.vehicles = 0;
+    REQUIRE_FALSE(WorkloadGenerator(c).ok());
+
+    c = WorkloadConfig{};
+    c.mix = WorkloadModelMix{0.0, 0.0, 0.0, 0.0};
+    REQUIRE_FALSE(WorkloadGenerator(c).ok());
+
+    c = WorkloadConfig{};
+    c.faults.deputy_failure_rate = 1.5;
+    REQUIRE_FALSE(WorkloadGenerator(c).ok());
+
+    c = WorkloadConfig{};
+    c.vehicles = MAX_VEHICLES * FleetRelativePredictor::kMaxFormations + 1u;
+    WorkloadGenerator gen(c);
+    REQUIRE_FALSE(gen.ok());
+    REQUIRE(gen.run().ticks == 0u);
+}
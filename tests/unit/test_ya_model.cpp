@@ -1,5 +1,9 @@
 // tests/unit/test_ya_model.cpp
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
 
@@ -12,10 +16,27 @@ using bullseye_pred::ModelHCW;
 using bullseye_pred::ModelYA_STM;
 using bullseye_pred::RelStateRic;
 using bullseye_pred::Span;
+using bullseye_pred::Span2D;
 using bullseye_pred::TimeGrid;
 using bullseye_pred::Vec3;
 using bullseye_pred::YaStmParams;
 
+namespace
+{
+
+bool ya_build(const YaStmParams& p,
+              const TimeGrid& g,
+              std::vector<bullseye_pred::YaChiefSample>& storage,
+              bullseye_pred::YaChiefEphemeris& eph)
+{
+    const ModelYA_STM ya;
+    return ya.build_chief_ephemeris(
+                 p, g, Span<bullseye_pred::YaChiefSample>{storage.data(), storage.size()}, eph)
+               .code == ModelCode::kOk;
+}
+
+} // namespace
+
 TEST_CASE("YA/TH: zero initial state remains zero", "[ya]")
 {
     ModelYA_STM m;
@@ -114,3 +135,492 @@ TEST_CASE("YA/TH: reduces to HCW for circular chief (numerical RK4)", "[ya][hcw]
         REQUIRE(v_ya[i].z == Catch::Approx(v_hcw[i].z).margin(vel_tol_mps));
     }
 }
+
+TEST_CASE("YA closed form: reduces to HCW for circular chief", "[ya][hcw][closed_form]")
+{
+    const double mu = 3.986004418e14;
+    const double r0 = 7000e3;
+    const double v0 = std::sqrt(mu / r0);
+
+    const double n = std::sqrt(mu / (r0 * r0 * r0));
+
+    RelStateRic x0{};
+    x0.r_ric = Vec3{100.0, -50.0, 25.0};
+    x0.v_ric = Vec3{0.10, -0.20, 0.05};
+
+    TimeGrid g;
+    g.tau = {0.0, 5.0, 10.0, 30.0, 60.0, 600.0, 3000.0};
+    constexpr std::size_t N = 7;
+
+    Vec3 r_hcw[N]{};
+    Vec3 v_hcw[N]{};
+    Vec3 r_ya[N]{};
+    Vec3 v_ya[N]{};
+
+    ModelHCW hcw;
+    HcwParams hp{};
+    hp.n_radps = n;
+    REQUIRE(hcw.predict_hcw(x0, hp, g, Span<Vec3>{r_hcw, N}, Span<Vec3>{v_hcw, N}).code ==
+            ModelCode::kOk);
+
+    ModelYA_STM ya;
+    YaStmParams yp{};
+    yp.mu = mu;
+    yp.chief_r0_i = Vec3{r0, 0.0, 0.0};
+    yp.chief_v0_i = Vec3{0.0, v0, 0.0};
+    yp.backend = bullseye_pred::YaStmBackend::kClosedForm;
+
+    const auto ry = ya.predict_ya_stm(x0, yp, g, Span<Vec3>{r_ya, N}, Span<Vec3>{v_ya, N});
+    REQUIRE(ry.code == ModelCode::kOk);
+    REQUIRE(ry.steps_written == N);
+
+    // Both are exact solutions of the same linear ODE; only round-off separates them.
+    const double pos_tol_m = 1e-6;
+    const double vel_tol_mps = 1e-9;
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        REQUIRE(r_ya[i].x == Catch::Approx(r_hcw[i].x).margin(pos_tol_m));
+        REQUIRE(r_ya[i].y == Catch::Approx(r_hcw[i].y).margin(pos_tol_m));
+        REQUIRE(r_ya[i].z == Catch::Approx(r_hcw[i].z).margin(pos_tol_m));
+
+        REQUIRE(v_ya[i].x == Catch::Approx(v_hcw[i].x).margin(vel_tol_mps));
+        REQUIRE(v_ya[i].y == Catch::Approx(v_hcw[i].y).margin(vel_tol_mps));
+        REQUIRE(v_ya[i].z == Catch::Approx(v_hcw[i].z).margin(vel_tol_mps));
+    }
+}
+
+TEST_CASE("YA closed form: matches RK4 reference for eccentric chief", "[ya][closed_form]")
+{
+    // Chief on an inclined e = 0.3 orbit, starting 1 rad past perigee (f0 != 0).
+    const double mu = 3.986004418e14;
+    const double e = 0.3;
+    const double p_m = 7000e3 * (1.0 + e);
+    const double f0 = 1.0;
+    const double inc = 0.5;
+
+    const double r_f0 = p_m / (1.0 + e * std::cos(f0));
+    const double v_scale = std::sqrt(mu / p_m);
+    const Vec3 r_pf{r_f0 * std::cos(f0), r_f0 * std::sin(f0), 0.0};
+    const Vec3 v_pf{-v_scale * std::sin(f0), v_scale * (e + std::cos(f0)), 0.0};
+
+    RelStateRic x0{};
+    x0.r_ric = Vec3{200.0, -300.0, 50.0};
+    x0.v_ric = Vec3{0.15, -0.25, 0.08};
+
+    TimeGrid g;
+    g.tau = {0.0, 10.0, 60.0, 120.0, 300.0, 900.0};
+    constexpr std::size_t N = 6;
+
+    YaStmParams base{};
+    base.mu = mu;
+    base.chief_r0_i = Vec3{r_pf.x, r_pf.y * std::cos(inc), r_pf.y * std::sin(inc)};
+    base.chief_v0_i = Vec3{v_pf.x, v_pf.y * std::cos(inc), v_pf.y * std::sin(inc)};
+
+    YaStmParams rk = base;
+    rk.backend = bullseye_pred::YaStmBackend::kRk4Reference;
+    rk.max_dt_sec = 0.05;
+
+    YaStmParams cf = base;
+    cf.backend = bullseye_pred::YaStmBackend::kClosedForm;
+
+    Vec3 r_rk[N]{};
+    Vec3 v_rk[N]{};
+    Vec3 r_cf[N]{};
+    Vec3 v_cf[N]{};
+
+    ModelYA_STM ya;
+    REQUIRE(ya.predict_ya_stm(x0, rk, g, Span<Vec3>{r_rk, N}, Span<Vec3>{v_rk, N}).code ==
+            ModelCode::kOk);
+    REQUIRE(ya.predict_ya_stm(x0, cf, g, Span<Vec3>{r_cf, N}, Span<Vec3>{v_cf, N}).code ==
+            ModelCode::kOk);
+
+    const double pos_tol_m = 5e-3;
+    const double vel_tol_mps = 5e-6;
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        REQUIRE(r_cf[i].x == Catch::Approx(r_rk[i].x).margin(pos_tol_m));
+        REQUIRE(r_cf[i].y == Catch::Approx(r_rk[i].y).margin(pos_tol_m));
+        REQUIRE(r_cf[i].z == Catch::Approx(r_rk[i].z).margin(pos_tol_m));
+
+        REQUIRE(v_cf[i].x == Catch::Approx(v_rk[i].x).margin(vel_tol_mps));
+        REQUIRE(v_cf[i].y == Catch::Approx(v_rk[i].y).margin(vel_tol_mps));
+        REQUIRE(v_cf[i].z == Catch::Approx(v_rk[i].z).margin(vel_tol_mps));
+    }
+}
+
+TEST_CASE("YA closed form: rejects unbound chief", "[ya][closed_form]")
+{
+    const double mu = 3.986004418e14;
+    const double r0 = 7000e3;
+    const double v_esc = std::sqrt(2.0 * mu / r0);
+
+    YaStmParams p{};
+    p.mu = mu;
+    p.chief_r0_i = Vec3{r0, 0.0, 0.0};
+    p.chief_v0_i = Vec3{0.0, 1.1 * v_esc, 0.0};
+    p.backend = bullseye_pred::YaStmBackend::kClosedForm;
+
+    TimeGrid g;
+    g.tau = {0.0, 1.0};
+    Vec3 r_out[2]{};
+
+    ModelYA_STM ya;
+    const auto res =
+        ya.predict_ya_stm(RelStateRic{}, p, g, Span<Vec3>{r_out, 2}, Span<Vec3>{nullptr, 0});
+    REQUIRE(res.code == ModelCode::kInvalidInput);
+}
+
+TEST_CASE("YA chief ephemeris: shared table reproduces direct RK4 bit-for-bit", "[ya][ephemeris]")
+{
+    const double mu = 3.986004418e14;
+    const double e = 0.1;
+    const double rp = 6900e3;
+    const double vp = std::sqrt(mu * (1.0 + e) / rp);
+
+    YaStmParams p{};
+    p.mu = mu;
+    p.chief_r0_i = Vec3{rp, 0.0, 0.0};
+    p.chief_v0_i = Vec3{0.0, vp, 0.0};
+    p.max_dt_sec = 0.3;
+
+    TimeGrid g;
+    g.tau = {0.0, 0.0, 1.0, 2.5, 10.0, 60.0};
+    constexpr std::size_t N = 6;
+
+    ModelYA_STM ya;
+
+    // 1 sample per nonzero interval start plus 2 per substep (ceil(dt / 0.3) substeps).
+    const std::size_t expected = (1 + 2 * 4) + (1 + 2 * 5) + (1 + 2 * 25) + (1 + 2 * 167);
+    REQUIRE(ModelYA_STM::chief_ephemeris_size(p, g) == expected);
+
+    std::vector<bullseye_pred::YaChiefSample> storage(expected);
+    bullseye_pred::YaChiefEphemeris eph{};
+    REQUIRE(ya.build_chief_ephemeris(
+                p, g, Span<bullseye_pred::YaChiefSample>{storage.data(), storage.size()}, eph)
+                .code == ModelCode::kOk);
+    REQUIRE(eph.samples.size == expected);
+
+    const RelStateRic deputies[2]{
+        RelStateRic{Vec3{100.0, -50.0, 25.0}, Vec3{0.10, -0.20, 0.05}},
+        RelStateRic{Vec3{-300.0, 400.0, -10.0}, Vec3{-0.05, 0.30, 0.02}},
+    };
+
+    for (const auto& x0 : deputies)
+    {
+        Vec3 r_direct[N]{};
+        Vec3 v_direct[N]{};
+        Vec3 r_table[N]{};
+        Vec3 v_table[N]{};
+
+        REQUIRE(ya.predict_ya_stm(x0, p, g, Span<Vec3>{r_direct, N}, Span<Vec3>{v_direct, N})
+                    .code == ModelCode::kOk);
+        REQUIRE(ya.predict_ya_stm(x0, p, g, eph, Span<Vec3>{r_table, N}, Span<Vec3>{v_table, N})
+                    .code == ModelCode::kOk);
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            REQUIRE(r_table[i].x == r_direct[i].x);
+            REQUIRE(r_table[i].y == r_direct[i].y);
+            REQUIRE(r_table[i].z == r_direct[i].z);
+            REQUIRE(v_table[i].x == v_direct[i].x);
+            REQUIRE(v_table[i].y == v_direct[i].y);
+            REQUIRE(v_table[i].z == v_direct[i].z);
+        }
+    }
+}
+
+TEST_CASE("YA chief ephemeris: capacity and mismatch are reported", "[ya][ephemeris]")
+{
+    const double mu = 3.986004418e14;
+    const double r0 = 7000e3;
+
+    YaStmParams p{};
+    p.mu = mu;
+    p.chief_r0_i = Vec3{r0, 0.0, 0.0};
+    p.chief_v0_i = Vec3{0.0, std::sqrt(mu / r0), 0.0};
+    p.max_dt_sec = 0.5;
+
+    TimeGrid g;
+    g.tau = {0.0, 1.0, 2.0};
+
+    ModelYA_STM ya;
+    const std::size_t needed = ModelYA_STM::chief_ephemeris_size(p, g);
+    REQUIRE(needed == 10);
+
+    std::vector<bullseye_pred::YaChiefSample> storage(needed);
+    bullseye_pred::YaChiefEphemeris eph{};
+
+    SECTION("storage too small")
+    {
+        const auto res = ya.build_chief_ephemeris(
+            p, g, Span<bullseye_pred::YaChiefSample>{storage.data(), needed - 1}, eph);
+        REQUIRE(res.code == ModelCode::kInsufficientOutputCapacity);
+        REQUIRE(eph.samples.size == 0);
+    }
+
+    SECTION("table built for a different grid")
+    {
+        REQUIRE(ya.build_chief_ephemeris(
+                    p, g, Span<bullseye_pred::YaChiefSample>{storage.data(), needed}, eph)
+                    .code == ModelCode::kOk);
+
+        TimeGrid other;
+        other.tau = {0.0, 1.0, 2.5};
+        Vec3 r_out[3]{};
+        const auto res = ya.predict_ya_stm(RelStateRic{}, p, other, eph, Span<Vec3>{r_out, 3},
+                                           Span<Vec3>{nullptr, 0});
+        REQUIRE(res.code == ModelCode::kInvalidInput);
+    }
+}
+
+TEST_CASE("YA batch: lockstep propagation matches per-deputy results", "[ya][batch]")
+{
+    const double mu = 3.986004418e14;
+    const double e = 0.05;
+    const double rp = 6900e3;
+
+    YaStmParams p{};
+    p.mu = mu;
+    p.chief_r0_i = Vec3{rp, 0.0, 0.0};
+    p.chief_v0_i = Vec3{0.0, std::sqrt(mu * (1.0 + e) / rp), 0.0};
+    p.max_dt_sec = 0.5;
+
+    TimeGrid g;
+    g.tau = {0.0, 1.0, 3.0, 7.5, 20.0};
+    constexpr std::size_t kSteps = 5;
+
+    // Spans more than one lane block, with one non-finite row in each block.
+    constexpr std::size_t kRows = ModelYA_STM::kBatchLanes + 5;
+    std::vector<RelStateRic> x0(kRows);
+    for (std::size_t i = 0; i < kRows; ++i)
+    {
+        const double s = static_cast<double>(i) - 17.0;
+        x0[i] = RelStateRic{Vec3{10.0 * s, -4.0 * s + 3.0, 0.5 * s},
+                            Vec3{0.01 * s, -0.02 * s, 0.003 * s + 0.1}};
+    }
+    x0[3].r_ric.y = std::nan("");
+    x0[ModelYA_STM::kBatchLanes + 1].v_ric.z = std::numeric_limits<double>::infinity();
+
+    std::vector<bullseye_pred::YaChiefSample> storage(ModelYA_STM::chief_ephemeris_size(p, g));
+    bullseye_pred::YaChiefEphemeris eph{};
+    REQUIRE(ya_build(p, g, storage, eph));
+
+    ModelYA_STM ya;
+    const Vec3 sentinel{-1.0, -2.0, -3.0};
+
+    for (const bool use_table : {false, true})
+    {
+        std::vector<Vec3> r_batch(kRows * kSteps, sentinel);
+        std::vector<Vec3> v_batch(kRows * kSteps, sentinel);
+        std::vector<ModelCode> codes(kRows, ModelCode::kOk);
+
+        const Span2D<Vec3> out_r{r_batch.data(), kRows, kSteps, kSteps};
+        const Span2D<Vec3> out_v{v_batch.data(), kRows, kSteps, kSteps};
+        const Span<const RelStateRic> in{x0.data(), kRows};
+        const Span<ModelCode> out_codes{codes.data(), kRows};
+        const auto res = use_table
+                             ? ya.predict_ya_stm_batch(in, p, g, eph, out_r, out_v, out_codes)
+                             : ya.predict_ya_stm_batch(in, p, g, out_r, out_v, out_codes);
+        REQUIRE(res.code == ModelCode::kOk);
+        REQUIRE(res.steps_written == kSteps);
+
+        for (std::size_t i = 0; i < kRows; ++i)
+        {
+            Vec3 r_ref[kSteps]{};
+            Vec3 v_ref[kSteps]{};
+            const auto single = ya.predict_ya_stm(x0[i], p, g, Span<Vec3>{r_ref, kSteps},
+                                                  Span<Vec3>{v_ref, kSteps});
+            REQUIRE(codes[i] == single.code);
+
+            for (std::size_t k = 0; k < kSteps; ++k)
+            {
+                const Vec3& r = r_batch[i * kSteps + k];
+                const Vec3& v = v_batch[i * kSteps + k];
+                if (single.code != ModelCode::kOk)
+                {
+                    REQUIRE(r.x == sentinel.x); // failed rows are left untouched
+                    continue;
+                }
+                REQUIRE(r.x == r_ref[k].x);
+                REQUIRE(r.y == r_ref[k].y);
+                REQUIRE(r.z == r_ref[k].z);
+                REQUIRE(v.x == v_ref[k].x);
+                REQUIRE(v.y == v_ref[k].y);
+                REQUIRE(v.z == v_ref[k].z);
+            }
+        }
+        REQUIRE(codes[3] == ModelCode::kInvalidInput);
+        REQUIRE(codes[ModelYA_STM::kBatchLanes + 1] == ModelCode::kInvalidInput);
+    }
+}
+
+TEST_CASE("YA batch: batch-wide errors", "[ya][batch]")
+{
+    const double mu = 3.986004418e14;
+    const double r0 = 7000e3;
+
+    YaStmParams p{};
+    p.mu = mu;
+    p.chief_r0_i = Vec3{r0, 0.0, 0.0};
+    p.chief_v0_i = Vec3{0.0, std::sqrt(mu / r0), 0.0};
+    p.max_dt_sec = 0.5;
+
+    TimeGrid g;
+    g.tau = {0.0, 1.0, 2.0};
+
+    ModelYA_STM ya;
+    const RelStateRic x0[2]{};
+    Vec3 r_out[6]{};
+
+    SECTION("output too small")
+    {
+        const auto res = ya.predict_ya_stm_batch(Span<const RelStateRic>{x0, 2}, p, g,
+                                                 Span2D<Vec3>{r_out, 1, 3, 3}, Span2D<Vec3>{},
+                                                 Span<ModelCode>{nullptr, 0});
+        REQUIRE(res.code == ModelCode::kInsufficientOutputCapacity);
+    }
+
+    SECTION("invalid params")
+    {
+        p.mu = -1.0;
+        const auto res = ya.predict_ya_stm_batch(Span<const RelStateRic>{x0, 2}, p, g,
+                                                 Span2D<Vec3>{r_out, 2, 3, 3}, Span2D<Vec3>{},
+                                                 Span<ModelCode>{nullptr, 0});
+        REQUIRE(res.code == ModelCode::kInvalidInput);
+    }
+
+    SECTION("ephemeris built for other inputs")
+    {
+        std::vector<bullseye_pred::YaChiefSample> storage(
+            ModelYA_STM::chief_ephemeris_size(p, g));
+        bullseye_pred::YaChiefEphemeris eph{};
+        REQUIRE(ya_build(p, g, storage, eph));
+
+        p.chief_v0_i.y *= 1.001;
+        const auto res = ya.predict_ya_stm_batch(Span<const RelStateRic>{x0, 2}, p, g, eph,
+                                                 Span2D<Vec3>{r_out, 2, 3, 3}, Span2D<Vec3>{},
+                                                 Span<ModelCode>{nullptr, 0});
+        REQUIRE(res.code == ModelCode::kInvalidInput);
+    }
+}
+
+TEST_CASE("YA Dormand-Prince: matches closed form with far fewer evaluations than RK4",
+          "[ya][adaptive]")
+{
+    // Highly eccentric chief starting at perigee.
+    const double mu = 3.986004418e14;
+    const double e = 0.7;
+    const double rp = 6800e3;
+    const double vp = std::sqrt(mu * (1.0 + e) / rp);
+
+    YaStmParams base{};
+    base.mu = mu;
+    base.chief_r0_i = Vec3{rp, 0.0, 0.0};
+    base.chief_v0_i = Vec3{0.0, vp, 0.0};
+
+    RelStateRic x0{};
+    x0.r_ric = Vec3{200.0, -300.0, 50.0};
+    x0.v_ric = Vec3{0.15, -0.25, 0.08};
+
+    TimeGrid g;
+    g.tau = {0.0, 60.0, 600.0, 1800.0, 3600.0, 7200.0};
+    constexpr std::size_t N = 6;
+
+    YaStmParams cf = base;
+    cf.backend = bullseye_pred::YaStmBackend::kClosedForm;
+
+    YaStmParams rk = base;
+    rk.backend = bullseye_pred::YaStmBackend::kRk4Reference;
+    rk.max_dt_sec = 0.25;
+
+    YaStmParams dp = base;
+    dp.backend = bullseye_pred::YaStmBackend::kDormandPrince54;
+    dp.rel_tol = 1e-11;
+    dp.abs_tol = 1e-9;
+
+    Vec3 r_cf[N]{};
+    Vec3 v_cf[N]{};
+    Vec3 r_dp[N]{};
+    Vec3 v_dp[N]{};
+    Vec3 r_rk[N]{};
+
+    ModelYA_STM ya;
+    REQUIRE(ya.predict_ya_stm(x0, cf, g, Span<Vec3>{r_cf, N}, Span<Vec3>{v_cf, N}).code ==
+            ModelCode::kOk);
+    const auto res_dp = ya.predict_ya_stm(x0, dp, g, Span<Vec3>{r_dp, N}, Span<Vec3>{v_dp, N});
+    REQUIRE(res_dp.code == ModelCode::kOk);
+    REQUIRE(res_dp.steps_written == N);
+    const auto res_rk =
+        ya.predict_ya_stm(x0, rk, g, Span<Vec3>{r_rk, N}, Span<Vec3>{nullptr, 0});
+    REQUIRE(res_rk.code == ModelCode::kOk);
+
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        REQUIRE(r_dp[i].x == Catch::Approx(r_cf[i].x).margin(5e-3));
+        REQUIRE(r_dp[i].y == Catch::Approx(r_cf[i].y).margin(5e-3));
+        REQUIRE(r_dp[i].z == Catch::Approx(r_cf[i].z).margin(5e-3));
+        REQUIRE(v_dp[i].x == Catch::Approx(v_cf[i].x).margin(5e-6));
+        REQUIRE(v_dp[i].y == Catch::Approx(v_cf[i].y).margin(5e-6));
+        REQUIRE(v_dp[i].z == Catch::Approx(v_cf[i].z).margin(5e-6));
+    }
+
+    // Fixed RK4 pays the perigee step size over the whole span.
+    REQUIRE(res_rk.integrator_steps == 7200 * 4);
+    REQUIRE(res_rk.derivative_evals == 4 * res_rk.integrator_steps);
+    REQUIRE(res_dp.integrator_steps > 0);
+    REQUIRE(res_dp.derivative_evals ==
+            1 + 6 * (res_dp.integrator_steps + res_dp.rejected_steps));
+    REQUIRE(res_dp.derivative_evals * 20 < res_rk.derivative_evals);
+
+    // Deterministic: identical inputs give identical steps and outputs.
+    Vec3 r_again[N]{};
+    const auto again =
+        ya.predict_ya_stm(x0, dp, g, Span<Vec3>{r_again, N}, Span<Vec3>{nullptr, 0});
+    REQUIRE(again.integrator_steps == res_dp.integrator_steps);
+    REQUIRE(again.rejected_steps == res_dp.rejected_steps);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        REQUIRE(r_again[i].x == r_dp[i].x);
+        REQUIRE(r_again[i].y == r_dp[i].y);
+        REQUIRE(r_again[i].z == r_dp[i].z);
+    }
+}
+
+TEST_CASE("YA Dormand-Prince: invalid tolerances and attempt cap", "[ya][adaptive]")
+{
+    const double mu = 3.986004418e14;
+    const double r0 = 7000e3;
+
+    YaStmParams p{};
+    p.mu = mu;
+    p.chief_r0_i = Vec3{r0, 0.0, 0.0};
+    p.chief_v0_i = Vec3{0.0, std::sqrt(mu / r0), 0.0};
+    p.backend = bullseye_pred::YaStmBackend::kDormandPrince54;
+
+    TimeGrid g;
+    g.tau = {0.0, 100.0, 1000.0};
+    constexpr std::size_t N = 3;
+
+    const RelStateRic x0{Vec3{100.0, 0.0, 0.0}, Vec3{0.0, -0.2, 0.0}};
+    Vec3 r_out[N]{};
+    ModelYA_STM ya;
+
+    SECTION("non-positive tolerance")
+    {
+        p.rel_tol = 0.0;
+        REQUIRE(ya.predict_ya_stm(x0, p, g, Span<Vec3>{r_out, N}, Span<Vec3>{nullptr, 0}).code ==
+                ModelCode::kInvalidInput);
+    }
+
+    SECTION("attempt cap")
+    {
+        p.max_step_attempts = 3;
+        const auto res =
+            ya.predict_ya_stm(x0, p, g, Span<Vec3>{r_out, N}, Span<Vec3>{nullptr, 0});
+        REQUIRE(res.code == ModelCode::kInvalidInput);
+        REQUIRE(res.integrator_steps + res.rejected_steps == 3);
+        REQUIRE(res.steps_written == 1);
+    }
+}
@@ -0,0 +1,214 @@
+// tools/ephemeris_convert.cpp
+/**
+ * @file ephemeris_convert.cpp
+ * @brief Convert a text ephemeris into the memory-mapped binary format (ephemeris_file.hpp).
+ *
+ * Usage: bullseye_ephemeris_convert <chief|vehicle|frame> <input.txt> <output.bin>
+ *
+ * One sample per line, values separated by whitespace or commas; blank lines and lines starting
+ * with '#' are skipped. Units and frames are the providers' (SI, inertial):
+ *   chief    t x y z vx vy vz
+ *   vehicle  id t x y z vx vy vz
+ *   frame    t ox oy oz c00 c01 c02 c10 c11 c12 c20 c21 c22 [wx wy wz]
+ * where C = [cRC] maps RIC to inertial and the optional ω is in RIC coordinates.
+ * Samples may appear in any order; duplicate times (per vehicle) are rejected.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "core/ephemeris_file.hpp"
+
+namespace
+{
+
+using bullseye_pred::ChiefEphemerisRecord;
+using bullseye_pred::EphemerisCode;
+using bullseye_pred::FrameEphemerisRecord;
+using bullseye_pred::Vec3;
+using bullseye_pred::VehicleEphemerisRecord;
+
+constexpr std::size_t kMaxFields = 16;
+
+// @return number of fields parsed from @p line (comments/blank lines give 0; -1 on bad text).
+int parse_fields(char* line, double (&v)[kMaxFields])
+{
+    for (char* c = line; *c != '\0'; ++c)
+    {
+        if (*c == ',')
+        {
+            *c = ' ';
+        }
+    }
+    const char* p = line;
+    while (*p == ' ' || *p == '\t')
+    {
+        ++p;
+    }
+    if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0')
+    {
+        return 0;
+    }
+    int n = 0;
+    while (true)
+    {
+        while (*p == ' ' || *p == '\t')
+        {
+            ++p;
+        }
+        if (*p == '\n' || *p == '\r' || *p == '\0')
+        {
+            return n;
+        }
+        if (n == static_cast<int>(kMaxFields))
+        {
+            return -1;
+        }
+        char* end = nullptr;
+        v[n] = std::strtod(p, &end);
+        if (end == p)
+        {
+            return -1;
+        }
+        ++n;
+        p = end;
+    }
+}
+
+Vec3 vec(const double* v)
+{
+    return Vec3{v[0], v[1], v[2]};
+}
+
+const char* code_name(EphemerisCode c)
+{
+    switch (c)
+    {
+    case EphemerisCode::kOk:
+        return "ok";
+    case EphemerisCode::kInvalidInput:
+        return "duplicate or non-finite sample times";
+    case EphemerisCode::kOpenFailed:
+        return "cannot create output";
+    case EphemerisCode::kWriteFailed:
+        return "write failed";
+    default:
+        return "error";
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 4)
+    {
+        std::fprintf(stderr, "usage: %s <chief|vehicle|frame> <input.txt> <output.bin>\n",
+                     argv[0]);
+        return 2;
+    }
+    const char* kind = argv[1];
+    const bool chief = std::strcmp(kind, "chief") == 0;
+    const bool vehicle = std::strcmp(kind, "vehicle") == 0;
+    const bool frame = std::strcmp(kind, "frame") == 0;
+    if (!chief && !vehicle && !frame)
+    {
+        std::fprintf(stderr, "unknown kind '%s'\n", kind);
+        return 2;
+    }
+
+    std::FILE* in = std::fopen(argv[2], "r");
+    if (in == nullptr)
+    {
+        std::fprintf(stderr, "cannot open %s\n", argv[2]);
+        return 1;
+    }
+
+    std::vector<ChiefEphemerisRecord> chiefs;
+    std::vector<VehicleEphemerisRecord> vehicles;
+    std::vector<FrameEphemerisRecord> frames;
+
+    char line[1024];
+    long line_no = 0;
+    while (std::fgets(line, sizeof(line), in) != nullptr)
+    {
+        ++line_no;
+        double v[kMaxFields];
+        const int n = parse_fields(line, v);
+        if (n == 0)
+        {
+            continue;
+        }
+        if (chief && n == 7)
+        {
+            chiefs.push_back(ChiefEphemerisRecord{v[0], vec(v + 1), vec(v + 4)});
+        }
+        else if (vehicle && n == 8 && v[0] >= 0.0)
+        {
+            vehicles.push_back(VehicleEphemerisRecord{static_cast<std::uint64_t>(v[0]), v[1],
+                                                      vec(v + 2), vec(v + 5)});
+        }
+        else if (frame && (n == 13 || n == 16))
+        {
+            FrameEphemerisRecord r{};
+            r.t = v[0];
+            r.origin_i = vec(v + 1);
+            for (int i = 0; i < 3; ++i)
+            {
+                for (int j = 0; j < 3; ++j)
+                {
+                    r.C_from_ric_to_inertial.m[i][j] = v[4 + 3 * i + j];
+                }
+            }
+            if (n == 16)
+            {
+                r.has_omega = 1u;
+                r.omega_ric = vec(v + 13);
+            }
+            frames.push_back(r);
+        }
+        else
+        {
+            std::fprintf(stderr, "%s:%ld: malformed %s sample\n", argv[2], line_no, kind);
+            std::fclose(in);
+            return 1;
+        }
+    }
+    std::fclose(in);
+
+    EphemerisCode code = EphemerisCode::kOk;
+    std::size_t count = 0;
+    if (chief)
+    {
+        std::stable_sort(chiefs.begin(), chiefs.end(),
+                         [](const auto& a, const auto& b) { return a.t < b.t; });
+        code = bullseye_pred::write_chief_ephemeris(argv[3], {chiefs.data(), chiefs.size()});
+        count = chiefs.size();
+    }
+    else if (vehicle)
+    {
+        std::stable_sort(vehicles.begin(), vehicles.end(), [](const auto& a, const auto& b) {
+            return (a.id != b.id) ? (a.id < b.id) : (a.t < b.t);
+        });
+        code = bullseye_pred::write_vehicle_ephemeris(argv[3], {vehicles.data(), vehicles.size()});
+        count = vehicles.size();
+    }
+    else
+    {
+        std::stable_sort(frames.begin(), frames.end(),
+                         [](const auto& a, const auto& b) { return a.t < b.t; });
+        code = bullseye_pred::write_frame_ephemeris(argv[3], {frames.data(), frames.size()});
+        count = frames.size();
+    }
+
+    if (code != EphemerisCode::kOk)
+    {
+        std::fprintf(stderr, "%s: %s\n", argv[3], code_name(code));
+        return 1;
+    }
+    std::printf("wrote %zu %s samples to %s\n", count, kind, argv[3]);
+    return 0;
+}
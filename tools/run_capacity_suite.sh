@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+# tools/run_capacity_suite.sh
+#
+# Builds the tree with a small snapshot capacity and runs every test against it, so tests that
+# assume the default 32 x 600 rows are caught.
+#
+#   tools/run_capacity_suite.sh [ctest args...]    e.g. -L unit
+#
+# Environment: BUILD_DIR (default _capacity_build), MAX_VEHICLES (default 8), MAX_STEPS
+# (default 64). Exit status is ctest's, or 2 on a build error.
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="${BUILD_DIR:-${ROOT}/_capacity_build}"
+MAX_VEHICLES="${MAX_VEHICLES:-8}"
+MAX_STEPS="${MAX_STEPS:-64}"
+
+cmake -S "${ROOT}" -B "${BUILD_DIR}" -DBULLSEYE_MAX_VEHICLES="${MAX_VEHICLES}" \
+    -DBULLSEYE_MAX_STEPS="${MAX_STEPS}" >/dev/null || exit 2
+cmake --build "${BUILD_DIR}" -j"$(nproc)" || exit 2
+
+ctest --test-dir "${BUILD_DIR}" --output-on-failure "$@"
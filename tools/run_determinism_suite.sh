@@ -0,0 +1,32 @@
+#!/usr/bin/env bash
+# tools/run_determinism_suite.sh
+#
+# Builds the differential harness in Release and runs it over several seeds.
+#
+#   tools/run_determinism_suite.sh [harness args...]
+#
+# Environment: BUILD_DIR (default _determinism_build), SEEDS (default "1 2 3 4"),
+# JSON_DIR (default $BUILD_DIR). Exit status is 1 if any seed fails, 2 on a build/usage error.
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="${BUILD_DIR:-${ROOT}/_determinism_build}"
+SEEDS="${SEEDS:-1 2 3 4}"
+JSON_DIR="${JSON_DIR:-${BUILD_DIR}}"
+
+cmake -S "${ROOT}" -B "${BUILD_DIR}" -DCMAKE_BUILD_TYPE=Release >/dev/null || exit 2
+cmake --build "${BUILD_DIR}" --target bullseye_determinism_harness -j"$(nproc)" || exit 2
+
+status=0
+for seed in ${SEEDS}; do
+    rc=0
+    "${BUILD_DIR}/tests/harness/bullseye_determinism_harness" \
+        --seed "${seed}" --json "${JSON_DIR}/determinism_${seed}.json" "$@" || rc=$?
+    if [ "${rc}" -eq 2 ]; then
+        exit 2
+    fi
+    if [ "${rc}" -ne 0 ]; then
+        status=1
+    fi
+done
+exit "${status}"
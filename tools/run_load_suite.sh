@@ -0,0 +1,19 @@
+#!/usr/bin/env bash
+# tools/run_load_suite.sh
+#
+# Builds the load harness in Release and runs one synthetic deployment at its target tick rate.
+#
+#   tools/run_load_suite.sh [harness args...]    e.g. --vehicles 1024 --tick-hz 2 --readers 8
+#
+# Environment: BUILD_DIR (default _load_build), JSON_OUT (default $BUILD_DIR/load.json).
+# Exit status is the harness's: 0, 1 on missed ticks or torn reads, 2 on a usage or setup error.
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="${BUILD_DIR:-${ROOT}/_load_build}"
+JSON_OUT="${JSON_OUT:-${BUILD_DIR}/load.json}"
+
+cmake -S "${ROOT}" -B "${BUILD_DIR}" -DCMAKE_BUILD_TYPE=Release >/dev/null
+cmake --build "${BUILD_DIR}" --target bullseye_load_harness -j"$(nproc)"
+
+"${BUILD_DIR}/tests/harness/bullseye_load_harness" --json "${JSON_OUT}" "$@"
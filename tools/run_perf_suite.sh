@@ -0,0 +1,22 @@
+#!/usr/bin/env bash
+# tools/run_perf_suite.sh
+#
+# Builds the microbenchmark harness in Release and checks it against the checked-in budgets.
+#
+#   tools/run_perf_suite.sh [harness args...]
+#
+# Environment: BUILD_DIR (default _perf_build), JSON_OUT (default $BUILD_DIR/perf.json).
+# Exit status is the harness's: 0 within budget, 1 over budget, 2 usage/file error.
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="${BUILD_DIR:-${ROOT}/_perf_build}"
+JSON_OUT="${JSON_OUT:-${BUILD_DIR}/perf.json}"
+
+cmake -S "${ROOT}" -B "${BUILD_DIR}" -DCMAKE_BUILD_TYPE=Release >/dev/null
+cmake --build "${BUILD_DIR}" --target bullseye_perf_harness -j"$(nproc)"
+
+"${BUILD_DIR}/tests/harness/bullseye_perf_harness" \
+    --json "${JSON_OUT}" \
+    --budget "${ROOT}/tests/harness/performance_budget.txt" \
+    "$@"
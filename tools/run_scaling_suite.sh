@@ -0,0 +1,19 @@
+#!/usr/bin/env bash
+# tools/run_scaling_suite.sh
+#
+# Builds the scaling harness in Release and runs the vehicles x steps x threads sweep.
+#
+#   tools/run_scaling_suite.sh [harness args...]    e.g. --model ya --threads 1,8
+#
+# Environment: BUILD_DIR (default _scaling_build), JSON_OUT (default $BUILD_DIR/scaling.json).
+# Exit status is the harness's: 0, or 2 on a usage, setup or file error.
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="${BUILD_DIR:-${ROOT}/_scaling_build}"
+JSON_OUT="${JSON_OUT:-${BUILD_DIR}/scaling.json}"
+
+cmake -S "${ROOT}" -B "${BUILD_DIR}" -DCMAKE_BUILD_TYPE=Release >/dev/null
+cmake --build "${BUILD_DIR}" --target bullseye_scaling_harness -j"$(nproc)"
+
+"${BUILD_DIR}/tests/harness/bullseye_scaling_harness" --json "${JSON_OUT}" "$@"
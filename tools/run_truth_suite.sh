@@ -0,0 +1,19 @@
+#!/usr/bin/env bash
+# tools/run_truth_suite.sh
+#
+# Builds the truth comparison harness in Release and runs the full cost-versus-accuracy sweep.
+#
+#   tools/run_truth_suite.sh [harness args...]    e.g. --max-p99 1.0 --scenario leo
+#
+# Environment: BUILD_DIR (default _truth_build), JSON_OUT (default $BUILD_DIR/truth.json).
+# Exit status is the harness's: 0, 1 if --max-p99 is not met on some grid, 2 usage/file error.
+set -euo pipefail
+
+ROOT="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="${BUILD_DIR:-${ROOT}/_truth_build}"
+JSON_OUT="${JSON_OUT:-${BUILD_DIR}/truth.json}"
+
+cmake -S "${ROOT}" -B "${BUILD_DIR}" -DCMAKE_BUILD_TYPE=Release >/dev/null
+cmake --build "${BUILD_DIR}" --target bullseye_truth_harness -j"$(nproc)"
+
+"${BUILD_DIR}/tests/harness/bullseye_truth_harness" --json "${JSON_OUT}" "$@"